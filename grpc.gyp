@@ -255,6 +255,7 @@
         'src/core/lib/gpr/log_posix.cc',
         'src/core/lib/gpr/log_windows.cc',
         'src/core/lib/gpr/mpscq.cc',
+        'src/core/lib/gpr/mu_contention.cc',
         'src/core/lib/gpr/murmur_hash.cc',
         'src/core/lib/gpr/string.cc',
         'src/core/lib/gpr/string_posix.cc',
@@ -272,6 +273,7 @@
         'src/core/lib/gpr/tmpfile_posix.cc',
         'src/core/lib/gpr/tmpfile_windows.cc',
         'src/core/lib/gpr/wrap_memcpy.cc',
+        'src/core/lib/gpr/wyhash.cc',
         'src/core/lib/gprpp/arena.cc',
         'src/core/lib/gprpp/fork.cc',
         'src/core/lib/gprpp/global_config_env.cc',
@@ -291,7 +293,9 @@
       'sources': [
         'src/core/lib/surface/init.cc',
         'src/core/lib/avl/avl.cc',
+        'src/core/lib/avl/flat_map.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_latency_breakdown.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -302,6 +306,7 @@
         'src/core/lib/channel/handshaker.cc',
         'src/core/lib/channel/handshaker_registry.cc',
         'src/core/lib/channel/status_util.cc',
+        'src/core/lib/channel/unary_batch.cc',
         'src/core/lib/compression/compression.cc',
         'src/core/lib/compression/compression_args.cc',
         'src/core/lib/compression/compression_internal.cc',
@@ -323,12 +328,14 @@
         'src/core/lib/iomgr/endpoint_pair_posix.cc',
         'src/core/lib/iomgr/endpoint_pair_uv.cc',
         'src/core/lib/iomgr/endpoint_pair_windows.cc',
+        'src/core/lib/iomgr/endpoint_shm_posix.cc',
         'src/core/lib/iomgr/error.cc',
         'src/core/lib/iomgr/error_cfstream.cc',
         'src/core/lib/iomgr/ev_epoll1_linux.cc',
         'src/core/lib/iomgr/ev_epollex_linux.cc',
         'src/core/lib/iomgr/ev_poll_posix.cc',
         'src/core/lib/iomgr/ev_posix.cc',
+        'src/core/lib/iomgr/ev_uring_linux.cc',
         'src/core/lib/iomgr/ev_windows.cc',
         'src/core/lib/iomgr/exec_ctx.cc',
         'src/core/lib/iomgr/executor.cc',
@@ -398,6 +405,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -560,6 +568,7 @@
         'src/core/ext/filters/client_channel/client_channel_factory.cc',
         'src/core/ext/filters/client_channel/client_channel_plugin.cc',
         'src/core/ext/filters/client_channel/connector.cc',
+        'src/core/ext/filters/client_channel/direct_channel.cc',
         'src/core/ext/filters/client_channel/global_subchannel_pool.cc',
         'src/core/ext/filters/client_channel/health/health_check_client.cc',
         'src/core/ext/filters/client_channel/http_connect_handshaker.cc',
@@ -637,6 +646,10 @@
         'src/core/ext/upb-generated/validate/validate.upb.c',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
         'src/core/ext/filters/client_channel/resolver/dns/c_ares/dns_resolver_ares.cc',
         'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver.cc',
         'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver_libuv.cc',
@@ -653,9 +666,12 @@
         'src/core/ext/filters/client_channel/resolver/xds/xds_resolver.cc',
         'src/core/ext/filters/census/grpc_context.cc',
         'src/core/ext/filters/client_idle/client_idle_filter.cc',
+        'src/core/ext/filters/concurrency_limit/concurrency_limit_filter.cc',
         'src/core/ext/filters/max_age/max_age_filter.cc',
         'src/core/ext/filters/message_size/message_size_filter.cc',
         'src/core/ext/filters/http/client_authority_filter.cc',
+        'src/core/ext/filters/unary_coalescing/unary_coalescing_filter.cc',
+        'src/core/ext/filters/response_cache/response_cache_filter.cc',
         'src/core/ext/filters/workarounds/workaround_cronet_compression_filter.cc',
         'src/core/ext/filters/workarounds/workaround_utils.cc',
         'src/core/plugin_registry/grpc_plugin_registry.cc',
@@ -700,7 +716,9 @@
         'test/core/util/trickle_endpoint.cc',
         'test/core/util/cmdline.cc',
         'src/core/lib/avl/avl.cc',
+        'src/core/lib/avl/flat_map.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_latency_breakdown.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -711,6 +729,7 @@
         'src/core/lib/channel/handshaker.cc',
         'src/core/lib/channel/handshaker_registry.cc',
         'src/core/lib/channel/status_util.cc',
+        'src/core/lib/channel/unary_batch.cc',
         'src/core/lib/compression/compression.cc',
         'src/core/lib/compression/compression_args.cc',
         'src/core/lib/compression/compression_internal.cc',
@@ -732,12 +751,14 @@
         'src/core/lib/iomgr/endpoint_pair_posix.cc',
         'src/core/lib/iomgr/endpoint_pair_uv.cc',
         'src/core/lib/iomgr/endpoint_pair_windows.cc',
+        'src/core/lib/iomgr/endpoint_shm_posix.cc',
         'src/core/lib/iomgr/error.cc',
         'src/core/lib/iomgr/error_cfstream.cc',
         'src/core/lib/iomgr/ev_epoll1_linux.cc',
         'src/core/lib/iomgr/ev_epollex_linux.cc',
         'src/core/lib/iomgr/ev_poll_posix.cc',
         'src/core/lib/iomgr/ev_posix.cc',
+        'src/core/lib/iomgr/ev_uring_linux.cc',
         'src/core/lib/iomgr/ev_windows.cc',
         'src/core/lib/iomgr/exec_ctx.cc',
         'src/core/lib/iomgr/executor.cc',
@@ -807,6 +828,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -864,6 +886,7 @@
         'src/core/ext/filters/client_channel/client_channel_factory.cc',
         'src/core/ext/filters/client_channel/client_channel_plugin.cc',
         'src/core/ext/filters/client_channel/connector.cc',
+        'src/core/ext/filters/client_channel/direct_channel.cc',
         'src/core/ext/filters/client_channel/global_subchannel_pool.cc',
         'src/core/ext/filters/client_channel/health/health_check_client.cc',
         'src/core/ext/filters/client_channel/http_connect_handshaker.cc',
@@ -955,7 +978,9 @@
         'test/core/util/trickle_endpoint.cc',
         'test/core/util/cmdline.cc',
         'src/core/lib/avl/avl.cc',
+        'src/core/lib/avl/flat_map.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_latency_breakdown.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -966,6 +991,7 @@
         'src/core/lib/channel/handshaker.cc',
         'src/core/lib/channel/handshaker_registry.cc',
         'src/core/lib/channel/status_util.cc',
+        'src/core/lib/channel/unary_batch.cc',
         'src/core/lib/compression/compression.cc',
         'src/core/lib/compression/compression_args.cc',
         'src/core/lib/compression/compression_internal.cc',
@@ -987,12 +1013,14 @@
         'src/core/lib/iomgr/endpoint_pair_posix.cc',
         'src/core/lib/iomgr/endpoint_pair_uv.cc',
         'src/core/lib/iomgr/endpoint_pair_windows.cc',
+        'src/core/lib/iomgr/endpoint_shm_posix.cc',
         'src/core/lib/iomgr/error.cc',
         'src/core/lib/iomgr/error_cfstream.cc',
         'src/core/lib/iomgr/ev_epoll1_linux.cc',
         'src/core/lib/iomgr/ev_epollex_linux.cc',
         'src/core/lib/iomgr/ev_poll_posix.cc',
         'src/core/lib/iomgr/ev_posix.cc',
+        'src/core/lib/iomgr/ev_uring_linux.cc',
         'src/core/lib/iomgr/ev_windows.cc',
         'src/core/lib/iomgr/exec_ctx.cc',
         'src/core/lib/iomgr/executor.cc',
@@ -1062,6 +1090,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -1119,6 +1148,7 @@
         'src/core/ext/filters/client_channel/client_channel_factory.cc',
         'src/core/ext/filters/client_channel/client_channel_plugin.cc',
         'src/core/ext/filters/client_channel/connector.cc',
+        'src/core/ext/filters/client_channel/direct_channel.cc',
         'src/core/ext/filters/client_channel/global_subchannel_pool.cc',
         'src/core/ext/filters/client_channel/health/health_check_client.cc',
         'src/core/ext/filters/client_channel/http_connect_handshaker.cc',
@@ -1186,7 +1216,9 @@
         'src/core/lib/surface/init.cc',
         'src/core/lib/surface/init_unsecure.cc',
         'src/core/lib/avl/avl.cc',
+        'src/core/lib/avl/flat_map.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_latency_breakdown.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -1197,6 +1229,7 @@
         'src/core/lib/channel/handshaker.cc',
         'src/core/lib/channel/handshaker_registry.cc',
         'src/core/lib/channel/status_util.cc',
+        'src/core/lib/channel/unary_batch.cc',
         'src/core/lib/compression/compression.cc',
         'src/core/lib/compression/compression_args.cc',
         'src/core/lib/compression/compression_internal.cc',
@@ -1218,12 +1251,14 @@
         'src/core/lib/iomgr/endpoint_pair_posix.cc',
         'src/core/lib/iomgr/endpoint_pair_uv.cc',
         'src/core/lib/iomgr/endpoint_pair_windows.cc',
+        'src/core/lib/iomgr/endpoint_shm_posix.cc',
         'src/core/lib/iomgr/error.cc',
         'src/core/lib/iomgr/error_cfstream.cc',
         'src/core/lib/iomgr/ev_epoll1_linux.cc',
         'src/core/lib/iomgr/ev_epollex_linux.cc',
         'src/core/lib/iomgr/ev_poll_posix.cc',
         'src/core/lib/iomgr/ev_posix.cc',
+        'src/core/lib/iomgr/ev_uring_linux.cc',
         'src/core/lib/iomgr/ev_windows.cc',
         'src/core/lib/iomgr/exec_ctx.cc',
         'src/core/lib/iomgr/executor.cc',
@@ -1293,6 +1328,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -1385,6 +1421,7 @@
         'src/core/ext/filters/client_channel/client_channel_factory.cc',
         'src/core/ext/filters/client_channel/client_channel_plugin.cc',
         'src/core/ext/filters/client_channel/connector.cc',
+        'src/core/ext/filters/client_channel/direct_channel.cc',
         'src/core/ext/filters/client_channel/global_subchannel_pool.cc',
         'src/core/ext/filters/client_channel/health/health_check_client.cc',
         'src/core/ext/filters/client_channel/http_connect_handshaker.cc',
@@ -1471,11 +1508,18 @@
         'src/core/ext/upb-generated/validate/validate.upb.c',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
         'src/core/ext/filters/census/grpc_context.cc',
         'src/core/ext/filters/client_idle/client_idle_filter.cc',
+        'src/core/ext/filters/concurrency_limit/concurrency_limit_filter.cc',
         'src/core/ext/filters/max_age/max_age_filter.cc',
         'src/core/ext/filters/message_size/message_size_filter.cc',
         'src/core/ext/filters/http/client_authority_filter.cc',
+        'src/core/ext/filters/unary_coalescing/unary_coalescing_filter.cc',
+        'src/core/ext/filters/response_cache/response_cache_filter.cc',
         'src/core/ext/filters/workarounds/workaround_cronet_compression_filter.cc',
         'src/core/ext/filters/workarounds/workaround_utils.cc',
         'src/core/plugin_registry/grpc_unsecure_plugin_registry.cc',
@@ -1562,6 +1606,7 @@
         'src/cpp/common/channel_filter.cc',
         'src/cpp/common/completion_queue_cc.cc',
         'src/cpp/common/core_codegen.cc',
+        'src/cpp/common/core_stats.cc',
         'src/cpp/common/resource_quota_cc.cc',
         'src/cpp/common/rpc_method.cc',
         'src/cpp/common/validate_service_config.cc',
@@ -1722,6 +1767,7 @@
         'src/cpp/common/channel_filter.cc',
         'src/cpp/common/completion_queue_cc.cc',
         'src/cpp/common/core_codegen.cc',
+        'src/cpp/common/core_stats.cc',
         'src/cpp/common/resource_quota_cc.cc',
         'src/cpp/common/rpc_method.cc',
         'src/cpp/common/validate_service_config.cc',
@@ -31,6 +31,12 @@ extern "C" {
 #define GRPC_X509_PEM_CERT_PROPERTY_NAME "x509_pem_cert"
 #define GRPC_SSL_SESSION_REUSED_PROPERTY "ssl_session_reused"
 
+/** The user, group and process ids of the peer of a unix domain socket
+    connection with local credentials, where the platform reports them. */
+#define GRPC_LOCAL_PEER_UID_PROPERTY_NAME "local_peer_uid"
+#define GRPC_LOCAL_PEER_GID_PROPERTY_NAME "local_peer_gid"
+#define GRPC_LOCAL_PEER_PID_PROPERTY_NAME "local_peer_pid"
+
 /** Environment variable that points to the default SSL roots file. This file
    must be a PEM encoded file with all the roots such as the one that can be
    downloaded from https://pki.google.com/roots.pem.  */
@@ -86,7 +86,10 @@ GRPCAPI int grpc_byte_buffer_reader_next(grpc_byte_buffer_reader* reader,
 GRPCAPI int grpc_byte_buffer_reader_peek(grpc_byte_buffer_reader* reader,
                                          grpc_slice** slice);
 
-/** Merge all data from \a reader into single slice */
+/** Merge all data from \a reader into single slice. If the buffer holds a
+    single slice, a new reference to it is returned rather than a copy: the
+    returned slice then shares its memory with the byte buffer, and callers
+    must not write to it. */
 GRPCAPI grpc_slice
 grpc_byte_buffer_reader_readall(grpc_byte_buffer_reader* reader);
 
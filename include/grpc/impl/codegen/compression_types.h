@@ -50,6 +50,40 @@ extern "C" {
  * be ignored). */
 #define GRPC_COMPRESSION_CHANNEL_ENABLED_ALGORITHMS_BITSET \
   "grpc.compression_enabled_algorithms_bitset"
+/** The effort spent compressing messages with deflate and gzip, as a zlib
+ * level from 1 (fastest) to 9 (smallest). Low levels compress highly
+ * redundant payloads several times faster than the default, which is zlib's
+ * own (6), for a slightly worse ratio. */
+#define GRPC_COMPRESSION_CHANNEL_ZLIB_LEVEL "grpc.compression_zlib_level"
+/** Messages smaller than this many bytes are sent uncompressed, whatever the
+ * call's compression algorithm (default 0). */
+#define GRPC_COMPRESSION_CHANNEL_MIN_MESSAGE_SIZE \
+  "grpc.compression_min_message_size"
+/** If positive, a method's messages stop being compressed once compression has
+ * recently saved less than this percentage of their size; one message in 16
+ * is still compressed to notice when that changes. Ratios are tracked for
+ * each method on clients, and for the whole channel on servers (default 0,
+ * always compress). */
+#define GRPC_COMPRESSION_CHANNEL_ADAPTIVE_MIN_SAVINGS_PERCENT \
+  "grpc.compression_adaptive_min_savings_percent"
+/** Received compressed messages of at least this many bytes are decompressed
+ * on an executor thread before the operation receiving them completes, rather
+ * than wherever the application reads them, which in the callback API is
+ * often a poller thread that other calls are waiting on. At most two per core
+ * are decompressed that way at a time; the application decompresses the rest
+ * itself (default 0, never). */
+#define GRPC_COMPRESSION_CHANNEL_DECOMPRESS_OFFLOAD_THRESHOLD \
+  "grpc.compression_offload_decompression_threshold"
+/** If true, calls compressing with deflate keep a single compression context
+ * for all their messages, so that each can refer back to the ones sent
+ * before it, which helps the small, repetitive messages of streaming calls
+ * most. Messages are still framed individually and are sent with the
+ * "deflate-persistent" grpc-encoding. Clients use it for all such calls, so
+ * only set it when the servers are known to support it; servers only when the
+ * client listed it in grpc-accept-encoding. Each such call holds about 256KB
+ * of zlib state while it lasts (default false). */
+#define GRPC_COMPRESSION_CHANNEL_PERSISTENT_DICTIONARY \
+  "grpc.compression_persistent_dictionary"
 /** \} */
 
 /** The various compression algorithms supported by gRPC (not sorted by
@@ -177,6 +177,12 @@ typedef struct {
 /** Enable/disable support for deadline checking. Defaults to 1, unless
     GRPC_ARG_MINIMAL_STACK is enabled, in which case it defaults to 0 */
 #define GRPC_ARG_ENABLE_DEADLINE_CHECKS "grpc.enable_deadline_checking"
+/** If non-zero, call deadlines on the channel are grouped into buckets of this
+    many milliseconds, with one timer armed per bucket instead of one per call.
+    A call's deadline then fires up to this much late, but never early.
+    Int valued, defaults to 0 (a timer per call). */
+#define GRPC_ARG_DEADLINE_COALESCING_SLACK_MS \
+  "grpc.deadline_coalescing_slack_ms"
 /** Initial stream ID for http2 transports. Int valued. */
 #define GRPC_ARG_HTTP2_INITIAL_SEQUENCE_NUMBER \
   "grpc.http2.initial_sequence_number"
@@ -197,6 +203,21 @@ typedef struct {
 #define GRPC_ARG_HTTP2_MAX_FRAME_SIZE "grpc.http2.max_frame_size"
 /** Should BDP probing be performed? */
 #define GRPC_ARG_HTTP2_BDP_PROBE "grpc.http2.bdp_probe"
+/** If non-zero, the connection and stream windows a transport announces are
+    limited according to the memory pressure of its resource quota: once the
+    quota is half used they shrink, down to 16KiB when it is 90% used, and grow
+    back as memory is freed. The windows are visible in channelz. Boolean;
+    defaults to 0. */
+#define GRPC_ARG_HTTP2_MEMORY_BUDGET_WINDOWS "grpc.http2.memory_budget_windows"
+/** If non-zero, the bdp probe estimates the bandwidth-delay product from the
+    highest recent delivery rate and the lowest recent round trip time (taken
+    from the kernel's TCP_INFO where available as well as from the pings),
+    and grows the windows several times over per round trip until the
+    delivery rate stops growing. This opens the windows of high bandwidth,
+    high latency connections much faster. Has no effect if the bdp probe is
+    disabled. Boolean; defaults to 0. */
+#define GRPC_ARG_HTTP2_BDP_DELIVERY_RATE_ESTIMATION \
+  "grpc.http2.bdp_delivery_rate_estimation"
 /** Minimum time between sending successive ping frames without receiving any
     data frame, Int valued, milliseconds. */
 #define GRPC_ARG_HTTP2_MIN_SENT_PING_INTERVAL_WITHOUT_DATA_MS \
@@ -219,6 +240,38 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** How many bytes of DATA frames a stream may write before the other writable
+    streams of its connection get a turn. Streams are served deficit round
+    robin, a whole frame at a time, so a bulk stream cannot hold back the
+    frames of small calls for a whole write. Int valued, bytes; 0 lets each
+    stream write all it can in one turn. Defaults to 65536. */
+#define GRPC_ARG_HTTP2_WRITE_QUANTUM_BYTES "grpc.http2.write_quantum_bytes"
+/** How long (in microseconds) a write may be held back so that frames from
+    other streams of the same connection can be sent in the same endpoint
+    write. Only writes that follow closely on a previous write are held, so
+    isolated requests are not delayed. The window is timed by the transport's
+    timers and so is rounded up to whole milliseconds. Int valued, defaults to
+    0 (off). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US \
+  "grpc.http2.write_coalescing_window_us"
+/** Once this many message bytes are queued behind a held back write it is
+    sent without waiting for the rest of the coalescing window. Int valued,
+    bytes. */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_MAX_BYTES \
+  "grpc.http2.write_coalescing_max_bytes"
+/** Once a connection has had no streams for this many milliseconds, it
+    drops the header compression state and buffers that only serve active
+    calls, so that idle connections cost less memory. The first headers sent
+    afterwards compress less well. Int valued, milliseconds; 0 disables it.
+    Defaults to 30000. */
+#define GRPC_ARG_HTTP2_IDLE_RELEASE_MS "grpc.http2.idle_release_ms"
+/** Received messages of up to this many bytes that do not arrive in a single
+    read are gathered into one contiguous slice, allocated from the message's
+    length prefix, as their DATA frames are parsed. Larger messages (and all
+    messages by default) are handed up as references to the slices they were
+    read into, without copying. Int valued, bytes; defaults to 0. */
+#define GRPC_ARG_HTTP2_MAX_CONTIGUOUS_RECV_MESSAGE_SIZE \
+  "grpc.http2.max_contiguous_recv_message_size"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -255,6 +308,18 @@ typedef struct {
 /** The timeout used on servers for finishing handshaking on an incoming
     connection.  Defaults to 120 seconds. */
 #define GRPC_ARG_SERVER_HANDSHAKE_TIMEOUT_MS "grpc.server_handshake_timeout_ms"
+/** The maximum number of handshakes a server listener runs at once. Further
+    connections are accepted but wait for a running handshake to finish
+    before starting theirs; the wait counts against the handshake timeout.
+    Int valued, defaults to 0 (no limit). */
+#define GRPC_ARG_SERVER_MAX_CONCURRENT_HANDSHAKES \
+  "grpc.server_max_concurrent_handshakes"
+/** The maximum number of accepted connections a server listener lets wait
+    for a handshake slot when GRPC_ARG_SERVER_MAX_CONCURRENT_HANDSHAKES is
+    set. Connections accepted beyond it are closed right away. Int valued,
+    defaults to 1024. */
+#define GRPC_ARG_SERVER_MAX_QUEUED_HANDSHAKES \
+  "grpc.server_max_queued_handshakes"
 /** This *should* be used for testing only.
     The caller of the secure_channel_create functions may override the target
     name used for SSL host name checking using this channel argument which is of
@@ -267,17 +332,75 @@ typedef struct {
     grpc_ssl_session_cache*). (use grpc_ssl_session_cache_arg_vtable() to fetch
     an appropriate pointer arg vtable) */
 #define GRPC_SSL_SESSION_CACHE_ARG "grpc.ssl_session_cache"
+/** If non-zero, once a TLS 1.2 AES-GCM session is established over a Linux TCP
+    socket, encryption of outgoing records is handed to the kernel (kTLS), so
+    that writes skip the userspace copy through the frame protector. Incoming
+    records are still decrypted in userspace. Has no effect where the SSL
+    library or the kernel cannot do this, or together with
+    GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED. Defaults to 0. */
+#define GRPC_ARG_SSL_KERNEL_TLS_WRITES "grpc.experimental.ssl_kernel_tls_writes"
+/** The maximum size, in bytes, of the frames (records) the frame protector of
+    a secure channel produces, clamped to the limits of its security protocol.
+    For ALTS, which accepts incoming frames of up to 1MB regardless of this
+    setting, this is between 1KB and 1MB and defaults to 16KB; larger frames
+    amortize the per frame encryption overhead on bulk transfers. Int valued,
+    0 (the default) leaves the protocol's own default. */
+#define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
 /** If non-zero, allow the use of SO_REUSEPORT if it's available (default 1) */
 #define GRPC_ARG_ALLOW_REUSEPORT "grpc.so_reuseport"
+/** If non-zero, and SO_REUSEPORT is in use, each of the listeners cloned for a
+    port stays bound to the pollset of one server completion queue, and every
+    connection it accepts is bound to that same pollset for its lifetime rather
+    than being spread across all of them (default 0) */
+#define GRPC_ARG_REUSEPORT_LISTENER_AFFINITY \
+  "grpc.so_reuseport_listener_affinity"
+/** If non-zero, a server places the threads polling each of its completion
+    queues on one NUMA node, spreading the completion queues across the nodes,
+    and implies GRPC_ARG_REUSEPORT_LISTENER_AFFINITY so that a connection is
+    served from a single node. Only threads the server creates itself (such as
+    those of a C++ synchronous server) are placed (default 0) */
+#define GRPC_ARG_NUMA_THREAD_PLACEMENT "grpc.numa_thread_placement"
+/** If non-zero, a C++ callback server runs reactor callbacks and callback
+    unary handlers on the thread that completed the operation, when it can do
+    so without holding any gRPC locks, rather than handing them to the
+    executor. Only suitable for services whose handlers never block
+    (default 0) */
+#define GRPC_ARG_SERVER_INLINE_CALLBACKS "grpc.server_inline_callbacks"
+/** If non-zero, a server sheds load once incoming calls of a method have
+    kept waiting longer than this many milliseconds for the application to
+    request them: following CoDel, once the shortest wait has stayed above
+    this target for a whole GRPC_ARG_SERVER_QUEUE_DELAY_INTERVAL_MS, calls
+    about to be handed to the application are failed with RESOURCE_EXHAUSTED
+    at an increasing rate until the wait drops back below the target
+    (default 0, never shed) */
+#define GRPC_ARG_SERVER_QUEUE_DELAY_TARGET_MS \
+  "grpc.server_queue_delay_target_ms"
+/** The interval, in milliseconds, over which the queueing delay must stay
+    above GRPC_ARG_SERVER_QUEUE_DELAY_TARGET_MS before calls are shed. Should
+    be around the worst-case time a handler takes (default 100) */
+#define GRPC_ARG_SERVER_QUEUE_DELAY_INTERVAL_MS \
+  "grpc.server_queue_delay_interval_ms"
+/** If non-zero, the thread polling for a server's completion queues spins,
+    polling without blocking, for up to this many microseconds before it
+    blocks, trading CPU for the latency of being woken up. The spin shortens
+    on its own while events take longer than that to arrive, so an idle server
+    soon stops spinning. Only the epoll1 polling engine supports it; others
+    ignore it (default 0, never spin) */
+#define GRPC_ARG_SERVER_BUSY_POLL_US "grpc.server_busy_poll_us"
 /** If non-zero, a pointer to a buffer pool (a pointer of type
  * grpc_resource_quota*). (use grpc_resource_quota_arg_vtable() to fetch an
  * appropriate pointer arg vtable) */
 #define GRPC_ARG_RESOURCE_QUOTA "grpc.resource_quota"
 /** If non-zero, expand wildcard addresses to a list of local addresses. */
 #define GRPC_ARG_EXPAND_WILDCARD_ADDRS "grpc.expand_wildcard_addrs"
+/** If non-zero, a server's listeners only accept connections, and set each
+    one up (endpoint creation, pollset binding, the accept callback that
+    starts its handshake) on an executor thread, so that floods of new
+    connections are accepted at the rate accept4 allows. Defaults to 0. */
+#define GRPC_ARG_TCP_SERVER_OFFLOAD_ACCEPT "grpc.tcp_server_offload_accept"
 /** Service config data in JSON form.
     This value will be ignored if the name resolver returns a service config. */
 #define GRPC_ARG_SERVICE_CONFIG "grpc.service_config"
@@ -286,6 +409,27 @@ typedef struct {
   "grpc.service_config_disable_resolution"
 /** LB policy name. */
 #define GRPC_ARG_LB_POLICY_NAME "grpc.lb_policy_name"
+/** Number of connections (between 1 and 16, default 1) LB policies that pick
+    among several subchannels, such as round_robin and least_request, open to
+    each address, spreading calls over them. Each connection shows in channelz
+    as a subchannel with its own socket. pick_first still uses one at a time. */
+#define GRPC_ARG_CONNECTIONS_PER_ADDRESS "grpc.connections_per_address"
+/** If positive, when the resolver returns new addresses, round_robin keeps
+    sending calls to the previous addresses until every new subchannel has
+    connected (or failed to), or for at most this many milliseconds, rather
+    than switching as soon as the first new subchannel is READY. This lets the
+    new connections finish their handshakes (and health checks, if
+    configured) before taking traffic. Default is 0 (switch right away). */
+#define GRPC_ARG_ROUND_ROBIN_WARM_UP_TIMEOUT_MS \
+  "grpc.round_robin_warm_up_timeout_ms"
+/** If positive, pick_first races its connection attempts in the manner of
+    RFC 8305 ("happy eyeballs"): when an attempt has neither succeeded nor
+    failed after this many milliseconds, the next address is attempted
+    alongside it, and the first one to connect is used. The addresses are
+    also reordered to alternate between address families. RFC 8305
+    recommends 250. Default is 0 (one attempt at a time). */
+#define GRPC_ARG_PICK_FIRST_CONNECTION_ATTEMPT_DELAY_MS \
+  "grpc.pick_first_connection_attempt_delay_ms"
 /** The grpc_socket_mutator instance that set the socket options. A pointer. */
 #define GRPC_ARG_SOCKET_MUTATOR "grpc.socket_mutator"
 /** The grpc_socket_factory instance to create and bind sockets. A pointer. */
@@ -304,6 +448,19 @@ typedef struct {
  * when possible. */
 #define GRPC_ARG_USE_CRONET_PACKET_COALESCING \
   "grpc.use_cronet_packet_coalescing"
+/** Channel arg (integer): if set, the size in bytes of the send and receive
+    buffers of unix domain sockets, which the kernel otherwise sizes for
+    loopback-scale messages. A larger send buffer lets a peer write a large
+    message with fewer wakeups of the reader. */
+#define GRPC_ARG_UNIX_SOCKET_BUFFER_SIZE "grpc.unix_socket_buffer_size"
+/** Channel arg (integer, 0 or 1): if 1, use TCP Fast Open where the platform
+    supports it (Linux 4.11 and later). Clients send the first bytes they
+    write (the HTTP/2 preface or TLS ClientHello) in the SYN once they hold a
+    cookie for the server, saving a round trip per reconnect; a failed
+    connect is then only reported by the first read or write. Servers accept
+    such connections, which the kernel may additionally need to allow
+    through the net.ipv4.tcp_fastopen sysctl. Defaults to 0. */
+#define GRPC_ARG_TCP_FAST_OPEN "grpc.tcp_fast_open"
 /** Channel arg (integer) setting how large a slice to try and read from the
    wire each time recvmsg (or equivalent) is called **/
 #define GRPC_ARG_TCP_READ_CHUNK_SIZE "grpc.experimental.tcp_read_chunk_size"
@@ -315,6 +472,26 @@ typedef struct {
   "grpc.experimental.tcp_min_read_chunk_size"
 #define GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE \
   "grpc.experimental.tcp_max_read_chunk_size"
+/** If non-zero, the posix TCP endpoint sends large writes with MSG_ZEROCOPY
+    where the kernel supports it, holding the written slices until the kernel
+    reports completion on the socket error queue. Defaults to 0. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_tx_zerocopy_enabled"
+/** Channel arg (integer): writes of fewer bytes than this are sent with the
+    regular copying sendmsg path even when zerocopy is enabled. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_tx_zerocopy_send_bytes_threshold"
+/** Channel arg (integer): maximum number of zerocopy writes per endpoint that
+    may be awaiting kernel completion at once. Writes beyond this fall back to
+    the copying path. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
+  "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/** If non-zero, the posix TCP endpoint sends with MSG_MORE while the rest of a
+    write, or a following write the transport has announced, is still to
+    come, so that the kernel builds full sized segments instead of sending a
+    short one at the end of each sendmsg. The kernel sends held back data on
+    the next sendmsg without MSG_MORE, or after 200ms. Defaults to 0. */
+#define GRPC_ARG_TCP_CORK_WRITES "grpc.experimental.tcp_cork_writes"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -331,6 +508,11 @@ typedef struct {
    value is 15 minutes. */
 #define GRPC_ARG_LOCALITY_RETENTION_INTERVAL_MS \
   "grpc.xds_locality_retention_interval_ms"
+/* If non-zero, the xds LB policy fetches endpoints with the incremental
+   (delta) xDS protocol, so that the balancer only sends the resources that
+   changed and the client resumes from the versions it already has after a
+   reconnect. Defaults to 0 (state of the world). */
+#define GRPC_ARG_XDS_DELTA_EDS "grpc.experimental.xds_delta_eds"
 /** If non-zero, grpc server's cronet compression workaround will be enabled */
 #define GRPC_ARG_WORKAROUND_CRONET_COMPRESSION \
   "grpc.workaround.cronet_compression"
@@ -350,6 +532,11 @@ typedef struct {
 #define GRPC_ARG_ENABLE_RETRIES "grpc.enable_retries"
 /** Per-RPC retry buffer size, in bytes. Default is 256 KiB. */
 #define GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE "grpc.per_rpc_retry_buffer_size"
+/** Retry buffer size for all RPCs on a channel together, in bytes. An RPC
+    whose buffered data takes the channel over this limit stops being
+    eligible for retries, like one exceeding the per-RPC limit. Default is
+    16 MiB. */
+#define GRPC_ARG_CHANNEL_RETRY_BUFFER_SIZE "grpc.channel_retry_buffer_size"
 /** Channel arg that carries the bridged objective c object for custom metrics
  * logging filter. */
 #define GRPC_ARG_MOBILE_LOG_CONTEXT "grpc.mobile_log_context"
@@ -364,6 +551,13 @@ typedef struct {
 /** If set, inhibits health checking (which may be enabled via the
  *  service config.) */
 #define GRPC_ARG_INHIBIT_HEALTH_CHECKING "grpc.inhibit_health_checking"
+/** If set to non zero, the subchannels of all channels with this arg set
+ *  that connect to the same address share one health check stream per
+ *  health check service name, even when they do not share a subchannel
+ *  (for example because their channel args differ).  The stream runs on the
+ *  connection of one of the subchannels and moves to another when that one
+ *  disconnects.  Defaults to 0. */
+#define GRPC_ARG_SHARE_HEALTH_CHECKS "grpc.share_health_checks"
 /** If set, the channel's resolver is allowed to query for SRV records.
  * For example, this is useful as a way to enable the "grpclb"
  * load balancing policy. Note that this only works with the "ares"
@@ -379,6 +573,34 @@ typedef struct {
 /** If set, uses a local subchannel pool within the channel. Otherwise, uses the
  * global subchannel pool. */
 #define GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL "grpc.use_local_subchannel_pool"
+/** If non-zero, and the target is a single ipv4:, ipv6: or unix: address, the
+ * channel connects to it directly rather than through a resolver and LB
+ * policy: calls are started on its one connection without a pick, and the
+ * service config and proxy mappers are not applied. Defaults to 0. */
+#define GRPC_ARG_DIRECT_CHANNEL "grpc.direct_channel"
+/** If non-zero, the channel's resolver, LB policy and connectivity updates
+ * run on a dedicated control plane executor (sized by
+ * GRPC_CONTROL_PLANE_EXECUTOR_THREADS) instead of on whichever thread is
+ * polling for the channel, such as an application's completion queue thread.
+ * Defaults to 0. */
+#define GRPC_ARG_CONTROL_PLANE_EXECUTOR \
+  "grpc.experimental.control_plane_executor"
+/** If non-zero, a unary call started while an identical one is in flight on
+ * the channel (same method, initial metadata, flags and request bytes) is not
+ * sent: it waits for the first call and gets a copy of its response and
+ * status. Only safe for methods without side effects. If the first call fails
+ * locally (e.g. it is cancelled or its deadline expires), or ends with a
+ * status a local failure could produce (CANCELLED, DEADLINE_EXCEEDED or
+ * UNAVAILABLE), the waiting calls are sent as usual. Defaults to 0. */
+#define GRPC_ARG_COALESCE_UNARY_CALLS "grpc.experimental.coalesce_unary_calls"
+/** Size in bytes of a per-channel cache of responses to unary calls started
+ * with GRPC_INITIAL_METADATA_CACHEABLE_REQUEST, keyed by method and request
+ * bytes. Only OK responses carrying a "cache-control: max-age=N" header or
+ * trailer are cached, for N seconds; a hit completes the call without sending
+ * it. The least recently used responses are evicted to stay within the size.
+ * Defaults to 0, which disables the cache. */
+#define GRPC_ARG_UNARY_RESPONSE_CACHE_SIZE \
+  "grpc.experimental.unary_response_cache_size"
 /** gRPC Objective-C channel pooling domain string. */
 #define GRPC_ARG_CHANNEL_POOL_DOMAIN "grpc.channel_pooling_domain"
 /** gRPC Objective-C channel pooling id. */
@@ -696,7 +918,13 @@ typedef enum {
   GRPC_CQ_PLUCK,
 
   /** EXPERIMENTAL: Events trigger a callback specified as the tag */
-  GRPC_CQ_CALLBACK
+  GRPC_CQ_CALLBACK,
+
+  /** EXPERIMENTAL: Like GRPC_CQ_NEXT, but completed events are queued on a
+      per-core shard and grpc_completion_queue_next() callers steal from other
+      shards only when their own is empty. Intended for completion queues that
+      are polled by many threads. */
+  GRPC_CQ_NEXT_SHARDED
 } grpc_cq_completion_type;
 
 /** EXPERIMENTAL: Specifies an interface class to be used as a tag
@@ -61,6 +61,37 @@ GPRAPI void gpr_set_allocation_functions(gpr_allocation_functions functions);
 /** Return the family of allocation functions currently in effect. */
 GPRAPI gpr_allocation_functions gpr_get_allocation_functions(void);
 
+/** The parts of gRPC whose memory can come from allocation functions of their
+ * own, for instance to give each its own jemalloc arena. */
+typedef enum {
+  /** the bytes of slices gRPC allocates */
+  GPR_ALLOC_SUBSYSTEM_SLICES,
+  /** the arenas holding the per call state */
+  GPR_ALLOC_SUBSYSTEM_ARENAS,
+  /** metadata elements not backed by the application */
+  GPR_ALLOC_SUBSYSTEM_METADATA,
+  GPR_ALLOC_SUBSYSTEM_COUNT
+} gpr_alloc_subsystem;
+
+typedef struct gpr_subsystem_allocation_functions {
+  /** never called with size 0; returning NULL aborts */
+  void* (*malloc_fn)(size_t size, void* user_data);
+  /** size is what malloc_fn was called with for ptr, for sized deallocation */
+  void (*free_fn)(void* ptr, size_t size, void* user_data);
+  void* user_data;
+} gpr_subsystem_allocation_functions;
+
+/** Request that the memory of \a subsystem be allocated with \a functions
+ * rather than gpr_malloc and gpr_free. Must be called before grpc_init(), as
+ * memory is freed with the functions it was allocated with. */
+GPRAPI void gpr_set_subsystem_allocation_functions(
+    gpr_alloc_subsystem subsystem,
+    gpr_subsystem_allocation_functions functions);
+
+/** Return the bytes of memory \a subsystem currently holds, whichever
+ * functions it was allocated with. */
+GPRAPI size_t gpr_subsystem_allocated_bytes(gpr_alloc_subsystem subsystem);
+
 #ifdef __cplusplus
 }
 #endif
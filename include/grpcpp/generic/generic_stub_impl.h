@@ -102,6 +102,19 @@ class GenericStub final {
         grpc_impl::experimental::ClientBidiReactor<grpc::ByteBuffer,
                                                    grpc::ByteBuffer>* reactor);
 
+    /// Make \a count unary calls to a named method \a method at once, the
+    /// i-th using \a contexts[i] to send \a requests[i]. Like a call from
+    /// PrepareUnaryCall that is started and finished, the i-th call delivers
+    /// \a tags[i] to \a cq once it has received \a responses[i] and
+    /// \a statuses[i]. The requests are handed to the channel together, so
+    /// that they can go out in one write rather than one each.
+    void StartUnaryCalls(size_t count,
+                         grpc_impl::ClientContext* const* contexts,
+                         const grpc::string& method,
+                         const grpc::ByteBuffer* requests,
+                         grpc::ByteBuffer* responses, grpc::Status* statuses,
+                         CompletionQueue* cq, void* const* tags);
+
    private:
     GenericStub* stub_;
   };
@@ -129,6 +129,15 @@ class ByteBuffer final {
   /// Dump (read) the buffer contents into \a slices.
   Status Dump(std::vector<Slice>* slices) const;
 
+  /// Get the buffer contents as one slice without copying them. Fails with
+  /// FAILED_PRECONDITION unless the buffer is a single uncompressed slice.
+  Status TrySingleSlice(Slice* slice) const;
+
+  /// Dump (read) the buffer contents into one contiguous \a slice: the
+  /// buffer's own slice when it holds a single uncompressed one, otherwise a
+  /// single copy of the (decompressed) contents.
+  Status DumpToSingleSlice(Slice* slice) const;
+
   /// Remove all data.
   void Clear() {
     if (buffer_) {
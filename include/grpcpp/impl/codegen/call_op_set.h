@@ -212,6 +212,7 @@ class CallNoOp {
       InterceptorBatchMethodsImpl* interceptor_methods) {}
   void SetFinishInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {}
+  void ClearFinishedState() {}
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {}
 };
 
@@ -269,6 +270,8 @@ class CallOpSendInitialMetadata {
   void SetFinishInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {}
 
+  void ClearFinishedState() {}
+
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
     hijacked_ = true;
   }
@@ -355,14 +358,18 @@ class CallOpSendMessage {
       interceptor_methods->AddInterceptionHookPoint(
           experimental::InterceptionHookPoints::POST_SEND_MESSAGE);
     }
-    send_buf_.Clear();
-    msg_ = nullptr;
+    ClearFinishedState();
     // The contents of the SendMessage value that was previously set
     // has had its references stolen by core's operations
     interceptor_methods->SetSendMessage(nullptr, nullptr, &failed_send_,
                                         nullptr);
   }
 
+  void ClearFinishedState() {
+    send_buf_.Clear();
+    msg_ = nullptr;
+  }
+
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
     hijacked_ = true;
   }
@@ -478,6 +485,7 @@ class CallOpRecvMessage {
         experimental::InterceptionHookPoints::POST_RECV_MESSAGE);
     if (!got_message) interceptor_methods->SetRecvMessage(nullptr, nullptr);
   }
+  void ClearFinishedState() {}
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
     hijacked_ = true;
     if (message_ == nullptr) return;
@@ -573,8 +581,9 @@ class CallOpGenericRecvMessage {
     interceptor_methods->AddInterceptionHookPoint(
         experimental::InterceptionHookPoints::POST_RECV_MESSAGE);
     if (!got_message) interceptor_methods->SetRecvMessage(nullptr, nullptr);
-    deserialize_.reset();
+    ClearFinishedState();
   }
+  void ClearFinishedState() { deserialize_.reset(); }
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
     hijacked_ = true;
     if (!deserialize_) return;
@@ -617,6 +626,8 @@ class CallOpClientSendClose {
   void SetFinishInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {}
 
+  void ClearFinishedState() {}
+
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
     hijacked_ = true;
   }
@@ -677,6 +688,8 @@ class CallOpServerSendStatus {
   void SetFinishInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {}
 
+  void ClearFinishedState() {}
+
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
     hijacked_ = true;
   }
@@ -726,9 +739,11 @@ class CallOpRecvInitialMetadata {
     if (metadata_map_ == nullptr) return;
     interceptor_methods->AddInterceptionHookPoint(
         experimental::InterceptionHookPoints::POST_RECV_INITIAL_METADATA);
-    metadata_map_ = nullptr;
+    ClearFinishedState();
   }
 
+  void ClearFinishedState() { metadata_map_ = nullptr; }
+
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
     hijacked_ = true;
     if (metadata_map_ == nullptr) return;
@@ -795,9 +810,11 @@ class CallOpClientRecvStatus {
     if (recv_status_ == nullptr) return;
     interceptor_methods->AddInterceptionHookPoint(
         experimental::InterceptionHookPoints::POST_RECV_STATUS);
-    recv_status_ = nullptr;
+    ClearFinishedState();
   }
 
+  void ClearFinishedState() { recv_status_ = nullptr; }
+
   void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
     hijacked_ = true;
     if (recv_status_ == nullptr) return;
@@ -844,6 +861,7 @@ class CallOpSet : public CallOpSetInterface,
         return_tag_(this),
         call_(other.call_),
         done_intercepting_(false),
+        avalanching_(false),
         interceptor_methods_(InterceptorBatchMethodsImpl()) {}
 
   CallOpSet& operator=(const CallOpSet& other) {
@@ -851,6 +869,7 @@ class CallOpSet : public CallOpSetInterface,
     return_tag_ = this;
     call_ = other.call_;
     done_intercepting_ = false;
+    avalanching_ = false;
     interceptor_methods_ = InterceptorBatchMethodsImpl();
     return *this;
   }
@@ -872,7 +891,7 @@ class CallOpSet : public CallOpSetInterface,
   bool FinalizeResult(void** tag, bool* status) override {
     if (done_intercepting_) {
       // Complete the avalanching since we are done with this batch of ops
-      call_.cq()->CompleteAvalanching();
+      CompleteAvalanching();
       // We have already finished intercepting and filling in the results. This
       // round trip from the core needed to be made because interceptors were
       // run
@@ -948,25 +967,38 @@ class CallOpSet : public CallOpSetInterface,
  private:
   // Returns true if no interceptors need to be run
   bool RunInterceptors() {
+    interceptor_methods_.SetCall(&call_);
+    // Most channels and servers have no interceptors, so check for that before
+    // filling in any of the hooks and batch state they would need.
+    if (interceptor_methods_.InterceptorsListEmpty()) {
+      return true;
+    }
     interceptor_methods_.ClearState();
     interceptor_methods_.SetCallOpSetInterface(this);
-    interceptor_methods_.SetCall(&call_);
     this->Op1::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op2::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op3::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op4::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op5::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op6::SetInterceptionHookPoint(&interceptor_methods_);
-    if (interceptor_methods_.InterceptorsListEmpty()) {
+    if (!interceptor_methods_.InterceptorsWantBatch()) {
       return true;
     }
-    // This call will go through interceptors and would need to
-    // schedule new batches, so delay completion queue shutdown
-    call_.cq()->RegisterAvalanching();
+    RegisterAvalanching();
     return interceptor_methods_.RunInterceptors();
   }
   // Returns true if no interceptors need to be run
   bool RunInterceptorsPostRecv() {
+    if (interceptor_methods_.InterceptorsListEmpty()) {
+      // Only reset the ops' state for their next batch.
+      this->Op1::ClearFinishedState();
+      this->Op2::ClearFinishedState();
+      this->Op3::ClearFinishedState();
+      this->Op4::ClearFinishedState();
+      this->Op5::ClearFinishedState();
+      this->Op6::ClearFinishedState();
+      return true;
+    }
     // Call and OpSet had already been set on the set state.
     // SetReverse also clears previously set hook points
     interceptor_methods_.SetReverse();
@@ -976,13 +1008,34 @@ class CallOpSet : public CallOpSetInterface,
     this->Op4::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op5::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op6::SetFinishInterceptionHookPoint(&interceptor_methods_);
+    if (!interceptor_methods_.InterceptorsWantBatch()) {
+      // The interceptors only wanted the batch's PRE hooks, if any.
+      CompleteAvalanching();
+      return true;
+    }
+    RegisterAvalanching();
     return interceptor_methods_.RunInterceptors();
   }
 
+  // This call will go through interceptors and would need to schedule new
+  // batches, so delay completion queue shutdown until it is done with them.
+  void RegisterAvalanching() {
+    if (avalanching_) return;
+    avalanching_ = true;
+    call_.cq()->RegisterAvalanching();
+  }
+
+  void CompleteAvalanching() {
+    if (!avalanching_) return;
+    avalanching_ = false;
+    call_.cq()->CompleteAvalanching();
+  }
+
   void* core_cq_tag_;
   void* return_tag_;
   Call call_;
   bool done_intercepting_ = false;
+  bool avalanching_ = false;
   InterceptorBatchMethodsImpl interceptor_methods_;
   bool saved_status_;
 };
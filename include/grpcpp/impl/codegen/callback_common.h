@@ -20,6 +20,9 @@
 #define GRPCPP_IMPL_CODEGEN_CALLBACK_COMMON_H
 
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpcpp/impl/codegen/call.h>
@@ -61,6 +64,142 @@ ReturnType* CatchingReactorCreator(Func&& func, Args&&... args) {
 #endif  // GRPC_ALLOW_EXCEPTIONS
 }
 
+template <class Signature>
+class CallbackFunction;
+
+/// A move-only callable for the callback tags. Unlike std::function, whose
+/// small-buffer size is implementation-defined, it guarantees that the
+/// library's own reactions (lambdas capturing a few pointers) and any
+/// std::function handed in by the application are stored inline, so arming a
+/// tag never allocates. Larger callables fall back to the heap.
+template <class R, class... Args>
+class CallbackFunction<R(Args...)> {
+ public:
+  CallbackFunction() : ops_(nullptr) {}
+  CallbackFunction(std::nullptr_t) : ops_(nullptr) {}
+
+  template <class F,
+            class = typename std::enable_if<!std::is_same<
+                typename std::decay<F>::type, CallbackFunction>::value>::type>
+  CallbackFunction(F&& f) : ops_(nullptr) {
+    Emplace(std::forward<F>(f));
+  }
+
+  CallbackFunction(CallbackFunction&& other) : ops_(other.ops_) {
+    if (ops_ != nullptr) {
+      ops_->move(&other.storage_, &storage_);
+      other.ops_ = nullptr;
+    }
+  }
+
+  CallbackFunction& operator=(CallbackFunction&& other) {
+    if (this != &other) {
+      Reset();
+      if (other.ops_ != nullptr) {
+        other.ops_->move(&other.storage_, &storage_);
+        ops_ = other.ops_;
+        other.ops_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  CallbackFunction& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  CallbackFunction(const CallbackFunction&) = delete;
+  CallbackFunction& operator=(const CallbackFunction&) = delete;
+
+  ~CallbackFunction() { Reset(); }
+
+  R operator()(Args... args) const {
+    return ops_->invoke(&storage_, std::forward<Args>(args)...);
+  }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+ private:
+  static constexpr size_t kInlineSize =
+      sizeof(std::function<void()>) > 4 * sizeof(void*)
+          ? sizeof(std::function<void()>)
+          : 4 * sizeof(void*);
+  typedef typename std::aligned_storage<kInlineSize>::type Storage;
+
+  struct Ops {
+    R (*invoke)(const Storage*, Args&&...);
+    void (*move)(Storage* from, Storage* to);
+    void (*destroy)(Storage*);
+  };
+
+  template <class F>
+  struct InlineOps {
+    static F* Get(const Storage* s) {
+      return reinterpret_cast<F*>(const_cast<Storage*>(s));
+    }
+    static R Invoke(const Storage* s, Args&&... args) {
+      return (*Get(s))(std::forward<Args>(args)...);
+    }
+    static void Move(Storage* from, Storage* to) {
+      new (to) F(std::move(*Get(from)));
+      Get(from)->~F();
+    }
+    static void Destroy(Storage* s) { Get(s)->~F(); }
+  };
+
+  template <class F>
+  struct HeapOps {
+    static F* Get(const Storage* s) {
+      return *reinterpret_cast<F* const*>(s);
+    }
+    static R Invoke(const Storage* s, Args&&... args) {
+      return (*Get(s))(std::forward<Args>(args)...);
+    }
+    static void Move(Storage* from, Storage* to) {
+      new (to) F*(Get(from));
+    }
+    static void Destroy(Storage* s) { delete Get(s); }
+  };
+
+  template <class F>
+  void Emplace(F&& f) {
+    typedef typename std::decay<F>::type Func;
+    const bool fits = sizeof(Func) <= sizeof(Storage) &&
+                      alignof(Func) <= alignof(Storage) &&
+                      std::is_nothrow_move_constructible<Func>::value;
+    EmplaceImpl<Func>(std::forward<F>(f),
+                      std::integral_constant<bool, fits>());
+  }
+
+  template <class Func, class F>
+  void EmplaceImpl(F&& f, std::true_type /*inline*/) {
+    static const Ops ops = {&InlineOps<Func>::Invoke, &InlineOps<Func>::Move,
+                            &InlineOps<Func>::Destroy};
+    new (&storage_) Func(std::forward<F>(f));
+    ops_ = &ops;
+  }
+
+  template <class Func, class F>
+  void EmplaceImpl(F&& f, std::false_type /*inline*/) {
+    static const Ops ops = {&HeapOps<Func>::Invoke, &HeapOps<Func>::Move,
+                            &HeapOps<Func>::Destroy};
+    new (&storage_) Func*(new Func(std::forward<F>(f)));
+    ops_ = &ops;
+  }
+
+  void Reset() {
+    if (ops_ != nullptr) {
+      const Ops* ops = ops_;
+      ops_ = nullptr;
+      ops->destroy(&storage_);
+    }
+  }
+
+  const Ops* ops_;
+  Storage storage_;
+};
+
 // The contract on these tags is that they are single-shot. They must be
 // constructed and then fired at exactly one point. There is no expectation
 // that they can be reused without reconstruction.
@@ -80,7 +219,7 @@ class CallbackWithStatusTag
   // there are no tests catching the compiler warning.
   static void operator delete(void*, void*) { assert(0); }
 
-  CallbackWithStatusTag(grpc_call* call, std::function<void(Status)> f,
+  CallbackWithStatusTag(grpc_call* call, CallbackFunction<void(Status)> f,
                         CompletionQueueTag* ops)
       : call_(call), func_(std::move(f)), ops_(ops) {
     g_core_codegen_interface->grpc_call_ref(call);
@@ -99,7 +238,7 @@ class CallbackWithStatusTag
 
  private:
   grpc_call* call_;
-  std::function<void(Status)> func_;
+  CallbackFunction<void(Status)> func_;
   CompletionQueueTag* ops_;
   Status status_;
 
@@ -146,9 +285,9 @@ class CallbackWithSuccessTag
 
   CallbackWithSuccessTag() : call_(nullptr) {}
 
-  CallbackWithSuccessTag(grpc_call* call, std::function<void(bool)> f,
+  CallbackWithSuccessTag(grpc_call* call, CallbackFunction<void(bool)> f,
                          CompletionQueueTag* ops) {
-    Set(call, f, ops);
+    Set(call, std::move(f), ops);
   }
 
   CallbackWithSuccessTag(const CallbackWithSuccessTag&) = delete;
@@ -159,7 +298,7 @@ class CallbackWithSuccessTag
   // Set can only be called on a default-constructed or Clear'ed tag.
   // It should never be called on a tag that was constructed with arguments
   // or on a tag that has been Set before unless the tag has been cleared.
-  void Set(grpc_call* call, std::function<void(bool)> f,
+  void Set(grpc_call* call, CallbackFunction<void(bool)> f,
            CompletionQueueTag* ops) {
     GPR_CODEGEN_ASSERT(call_ == nullptr);
     g_core_codegen_interface->grpc_call_ref(call);
@@ -190,7 +329,7 @@ class CallbackWithSuccessTag
 
  private:
   grpc_call* call_;
-  std::function<void(bool)> func_;
+  CallbackFunction<void(bool)> func_;
   CompletionQueueTag* ops_;
 
   static void StaticRun(grpc_experimental_completion_queue_functor* cb,
@@ -49,7 +49,7 @@ void CallbackUnaryCall(::grpc::ChannelInterface* channel,
                        const InputMessage* request, OutputMessage* result,
                        std::function<void(::grpc::Status)> on_completion) {
   CallbackUnaryCallImpl<InputMessage, OutputMessage> x(
-      channel, method, context, request, result, on_completion);
+      channel, method, context, request, result, std::move(on_completion));
 }
 
 template <class InputMessage, class OutputMessage>
@@ -77,7 +77,8 @@ class CallbackUnaryCallImpl {
 
     auto* tag = new (::grpc::g_core_codegen_interface->grpc_call_arena_alloc(
         call.call(), sizeof(grpc::internal::CallbackWithStatusTag)))
-        grpc::internal::CallbackWithStatusTag(call.call(), on_completion, ops);
+        grpc::internal::CallbackWithStatusTag(call.call(),
+                                              std::move(on_completion), ops);
 
     // TODO(vjpai): Unify code with sync API as much as possible
     ::grpc::Status s = ops->SendMessagePtr(request);
@@ -183,6 +184,13 @@ class ClientCallbackUnary {
 // user class only needs to override those classes that it cares about.
 // The reactor must be passed to the stub invocation before any of the below
 // operations can be called.
+//
+// A reactor is not tied to a single RPC: once OnDone has been called on it,
+// it may be passed to another stub invocation and started again, including
+// from within OnDone itself, since the library has released everything from
+// the previous RPC by then. Applications issuing many RPCs can thus keep a
+// set of reactors and re-arm them rather than creating one per RPC. The
+// ClientContext, on the other hand, must still be a fresh one for each RPC.
 
 /// \a ClientBidiReactor is the interface for a bidirectional streaming RPC.
 template <class Request, class Response>
@@ -149,23 +149,32 @@ class ClientRpcInfo {
          ++it) {
       auto* interceptor = (*it)->CreateClientInterceptor(this);
       if (interceptor != nullptr) {
-        interceptors_.push_back(
-            std::unique_ptr<experimental::Interceptor>(interceptor));
+        AddInterceptor(interceptor);
       }
     }
     if (internal::g_global_client_interceptor_factory != nullptr) {
-      interceptors_.push_back(std::unique_ptr<experimental::Interceptor>(
-          internal::g_global_client_interceptor_factory
-              ->CreateClientInterceptor(this)));
+      AddInterceptor(internal::g_global_client_interceptor_factory
+                         ->CreateClientInterceptor(this));
     }
   }
 
+  void AddInterceptor(experimental::Interceptor* interceptor) {
+    interceptors_.push_back(
+        std::unique_ptr<experimental::Interceptor>(interceptor));
+    interceptor_hook_points_.push_back(
+        internal::InterceptedHookPoints(interceptor));
+    hook_points_ |= interceptor_hook_points_.back();
+  }
+
   grpc_impl::ClientContext* ctx_ = nullptr;
   // TODO(yashykt): make type_ const once move-assignment is deleted
   Type type_{Type::UNKNOWN};
   const char* method_ = nullptr;
   grpc::ChannelInterface* channel_ = nullptr;
   std::vector<std::unique_ptr<experimental::Interceptor>> interceptors_;
+  // The hook points each interceptor intercepts, and all of them together.
+  std::vector<uint32_t> interceptor_hook_points_;
+  uint32_t hook_points_ = 0;
   bool hijacked_ = false;
   size_t hijacked_interceptor_ = 0;
 
@@ -303,6 +303,27 @@ class CompletionQueue : private ::grpc::GrpcLibraryCodegen {
     bool flushed_;
   };
 
+  /// Lends a blocking call the calling thread's pluck completion queue, so
+  /// that blocking calls do not create and destroy one each. The queue is
+  /// created on the thread's first blocking call and destroyed when the thread
+  /// exits or gRPC shuts down, whichever comes first; it does not keep gRPC
+  /// initialized. If it is already lent out further up the stack, a new queue
+  /// is made for this call instead, since a queue has a limited number of
+  /// concurrent pluckers.
+  class BlockingCallQueue {
+   public:
+    BlockingCallQueue();
+    ~BlockingCallQueue();
+
+    CompletionQueue* cq() const { return cq_; }
+
+   private:
+    static CompletionQueue* NewPluckQueue();
+
+    CompletionQueue* cq_;
+    bool owned_;
+  };
+
   NextStatus AsyncNextInternal(void** tag, bool* ok, gpr_timespec deadline);
 
   /// Wraps \a grpc_completion_queue_pluck.
@@ -219,9 +219,45 @@ class Interceptor {
   /// The one public method of an Interceptor interface. Override this to
   /// trigger the desired actions at the hook points described above.
   virtual void Intercept(InterceptorBatchMethods* methods) = 0;
+
+  /// Override this to return false for the hook points this interceptor has
+  /// no use for, such as all but the POST_RECV ones for an interceptor that
+  /// only times RPCs. \a Intercept is then only called for batches with at
+  /// least one hook point this returns true for, and gRPC skips the batches
+  /// no interceptor of the RPC wants; an interceptor that may hijack must
+  /// keep PRE_SEND_INITIAL_METADATA. Once an RPC has been hijacked, and for
+  /// PRE_SEND_CANCEL, every interceptor is called regardless. This is asked
+  /// once for each hook point, just after the interceptor is created.
+  virtual bool InterceptsHookPoint(InterceptionHookPoints type) {
+    return true;
+  }
 };
 
 }  // namespace experimental
+
+namespace internal {
+
+/// Returns the hook points \a interceptor intercepts, as a set of
+/// (1 << hook point) bits.
+inline uint32_t InterceptedHookPoints(experimental::Interceptor* interceptor) {
+  static_assert(
+      static_cast<size_t>(
+          experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS) <= 32,
+      "hook points must fit in a uint32_t");
+  uint32_t hook_points = 0;
+  for (size_t i = 0;
+       i < static_cast<size_t>(
+               experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS);
+       ++i) {
+    if (interceptor->InterceptsHookPoint(
+            static_cast<experimental::InterceptionHookPoints>(i))) {
+      hook_points |= 1u << i;
+    }
+  }
+  return hook_points;
+}
+
+}  // namespace internal
 }  // namespace grpc
 
 #endif  // GRPCPP_IMPL_CODEGEN_INTERCEPTOR_H
@@ -19,7 +19,6 @@
 #ifndef GRPCPP_IMPL_CODEGEN_INTERCEPTOR_COMMON_H
 #define GRPCPP_IMPL_CODEGEN_INTERCEPTOR_COMMON_H
 
-#include <array>
 #include <functional>
 
 #include <grpcpp/impl/codegen/call.h>
@@ -36,20 +35,13 @@ namespace internal {
 class InterceptorBatchMethodsImpl
     : public experimental::InterceptorBatchMethods {
  public:
-  InterceptorBatchMethodsImpl() {
-    for (auto i = static_cast<experimental::InterceptionHookPoints>(0);
-         i < experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS;
-         i = static_cast<experimental::InterceptionHookPoints>(
-             static_cast<size_t>(i) + 1)) {
-      hooks_[static_cast<size_t>(i)] = false;
-    }
-  }
+  InterceptorBatchMethodsImpl() {}
 
   ~InterceptorBatchMethodsImpl() {}
 
   bool QueryInterceptionHookPoint(
       experimental::InterceptionHookPoints type) override {
-    return hooks_[static_cast<size_t>(type)];
+    return (hooks_ & HookPointBit(type)) != 0;
   }
 
   void Proceed() override {
@@ -76,7 +68,7 @@ class InterceptorBatchMethodsImpl
   }
 
   void AddInterceptionHookPoint(experimental::InterceptionHookPoints type) {
-    hooks_[static_cast<size_t>(type)] = true;
+    hooks_ |= HookPointBit(type);
   }
 
   ByteBuffer* GetSerializedSendMessage() override {
@@ -130,8 +122,8 @@ class InterceptorBatchMethodsImpl
   Status* GetRecvStatus() override { return recv_status_; }
 
   void FailHijackedSendMessage() override {
-    GPR_CODEGEN_ASSERT(hooks_[static_cast<size_t>(
-        experimental::InterceptionHookPoints::PRE_SEND_MESSAGE)]);
+    GPR_CODEGEN_ASSERT(QueryInterceptionHookPoint(
+        experimental::InterceptionHookPoints::PRE_SEND_MESSAGE));
     *fail_send_message_ = true;
   }
 
@@ -193,8 +185,8 @@ class InterceptorBatchMethodsImpl
   }
 
   void FailHijackedRecvMessage() override {
-    GPR_CODEGEN_ASSERT(hooks_[static_cast<size_t>(
-        experimental::InterceptionHookPoints::PRE_RECV_MESSAGE)]);
+    GPR_CODEGEN_ASSERT(QueryInterceptionHookPoint(
+        experimental::InterceptionHookPoints::PRE_RECV_MESSAGE));
     *got_message_ = false;
   }
 
@@ -239,6 +231,20 @@ class InterceptorBatchMethodsImpl
     return false;
   }
 
+  // SetCall and the hook points should have been set before this. Returns
+  // whether any interceptor intercepts a hook point of this batch; a
+  // hijacked RPC always goes to its interceptors.
+  bool InterceptorsWantBatch() {
+    auto* client_rpc_info = call_->client_rpc_info();
+    if (client_rpc_info != nullptr) {
+      return client_rpc_info->hijacked_ ||
+             (client_rpc_info->hook_points_ & hooks_) != 0;
+    }
+    auto* server_rpc_info = call_->server_rpc_info();
+    return server_rpc_info != nullptr &&
+           (server_rpc_info->hook_points_ & hooks_) != 0;
+  }
+
   // This should be used only by subclasses of CallOpSetInterface. SetCall and
   // SetCallOpSetInterface should have been called before this. After all the
   // interceptors are done running, either ContinueFillOpsAfterInterception or
@@ -246,20 +252,10 @@ class InterceptorBatchMethodsImpl
   // them is invoked if there were no interceptors registered.
   bool RunInterceptors() {
     GPR_CODEGEN_ASSERT(ops_);
-    auto* client_rpc_info = call_->client_rpc_info();
-    if (client_rpc_info != nullptr) {
-      if (client_rpc_info->interceptors_.size() == 0) {
-        return true;
-      } else {
-        RunClientInterceptors();
-        return false;
-      }
-    }
-
-    auto* server_rpc_info = call_->server_rpc_info();
-    if (server_rpc_info == nullptr ||
-        server_rpc_info->interceptors_.size() == 0) {
-      return true;
+    if (!InterceptorsWantBatch()) return true;
+    if (call_->client_rpc_info() != nullptr) {
+      RunClientInterceptors();
+      return false;
     }
     RunServerInterceptors();
     return false;
@@ -273,11 +269,7 @@ class InterceptorBatchMethodsImpl
     // This is used only by the server for initial call request
     GPR_CODEGEN_ASSERT(reverse_ == true);
     GPR_CODEGEN_ASSERT(call_->client_rpc_info() == nullptr);
-    auto* server_rpc_info = call_->server_rpc_info();
-    if (server_rpc_info == nullptr ||
-        server_rpc_info->interceptors_.size() == 0) {
-      return true;
-    }
+    if (!InterceptorsWantBatch()) return true;
     callback_ = std::move(f);
     RunServerInterceptors();
     return false;
@@ -295,7 +287,7 @@ class InterceptorBatchMethodsImpl
         current_interceptor_index_ = rpc_info->interceptors_.size() - 1;
       }
     }
-    rpc_info->RunInterceptor(this, current_interceptor_index_);
+    RunCurrentClientInterceptor();
   }
 
   void RunServerInterceptors() {
@@ -305,6 +297,29 @@ class InterceptorBatchMethodsImpl
     } else {
       current_interceptor_index_ = rpc_info->interceptors_.size() - 1;
     }
+    RunCurrentServerInterceptor();
+  }
+
+  // Runs the current interceptor, or moves on past it if it does not
+  // intercept any of this batch's hook points.
+  void RunCurrentClientInterceptor() {
+    auto* rpc_info = call_->client_rpc_info();
+    if (!rpc_info->hijacked_ &&
+        (rpc_info->interceptor_hook_points_[current_interceptor_index_] &
+         hooks_) == 0) {
+      ProceedClient();
+      return;
+    }
+    rpc_info->RunInterceptor(this, current_interceptor_index_);
+  }
+
+  void RunCurrentServerInterceptor() {
+    auto* rpc_info = call_->server_rpc_info();
+    if ((rpc_info->interceptor_hook_points_[current_interceptor_index_] &
+         hooks_) == 0) {
+      ProceedServer();
+      return;
+    }
     rpc_info->RunInterceptor(this, current_interceptor_index_);
   }
 
@@ -329,7 +344,7 @@ class InterceptorBatchMethodsImpl
           // This is a hijacked RPC and we are done with hijacking
           ops_->ContinueFillOpsAfterInterception();
         } else {
-          rpc_info->RunInterceptor(this, current_interceptor_index_);
+          RunCurrentClientInterceptor();
         }
       } else {
         // we are done running all the interceptors without any hijacking
@@ -340,7 +355,7 @@ class InterceptorBatchMethodsImpl
       if (current_interceptor_index_ > 0) {
         // Continue running interceptors
         current_interceptor_index_--;
-        rpc_info->RunInterceptor(this, current_interceptor_index_);
+        RunCurrentClientInterceptor();
       } else {
         // we are done running all the interceptors without any hijacking
         ops_->ContinueFinalizeResultAfterInterception();
@@ -353,7 +368,7 @@ class InterceptorBatchMethodsImpl
     if (!reverse_) {
       current_interceptor_index_++;
       if (current_interceptor_index_ < rpc_info->interceptors_.size()) {
-        return rpc_info->RunInterceptor(this, current_interceptor_index_);
+        return RunCurrentServerInterceptor();
       } else if (ops_) {
         return ops_->ContinueFillOpsAfterInterception();
       }
@@ -362,7 +377,7 @@ class InterceptorBatchMethodsImpl
       if (current_interceptor_index_ > 0) {
         // Continue running interceptors
         current_interceptor_index_--;
-        return rpc_info->RunInterceptor(this, current_interceptor_index_);
+        return RunCurrentServerInterceptor();
       } else if (ops_) {
         return ops_->ContinueFinalizeResultAfterInterception();
       }
@@ -371,19 +386,14 @@ class InterceptorBatchMethodsImpl
     callback_();
   }
 
-  void ClearHookPoints() {
-    for (auto i = static_cast<experimental::InterceptionHookPoints>(0);
-         i < experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS;
-         i = static_cast<experimental::InterceptionHookPoints>(
-             static_cast<size_t>(i) + 1)) {
-      hooks_[static_cast<size_t>(i)] = false;
-    }
+  void ClearHookPoints() { hooks_ = 0; }
+
+  static uint32_t HookPointBit(experimental::InterceptionHookPoints type) {
+    return 1u << static_cast<size_t>(type);
   }
 
-  std::array<bool,
-             static_cast<size_t>(
-                 experimental::InterceptionHookPoints::NUM_INTERCEPTION_HOOKS)>
-      hooks_;
+  // The hook points of this batch, as a set of HookPointBit()s.
+  uint32_t hooks_ = 0;
 
   size_t current_interceptor_index_ = 0;  // Current iterator
   bool reverse_ = false;
@@ -37,30 +37,33 @@ class MetadataMap {
   ~MetadataMap() { Destroy(); }
 
   grpc::string GetBinaryErrorDetails() {
-    // if filled_, extract from the multimap for O(log(n))
+    grpc::string_ref value;
+    if (Find(kBinaryErrorDetailsKey, &value)) {
+      return grpc::string(value.begin(), value.length());
+    }
+    return grpc::string();
+  }
+
+  /// Sets \a value to the first value received for \a key and returns true,
+  /// or returns false if there is none. Until map() has been called this
+  /// scans the received array instead of building the multimap, so callers
+  /// after a handful of keys never pay for a node per header.
+  // TODO(ncteisen): plumb the binary error details through core as a first
+  // class object, just like code and message.
+  bool Find(grpc::string_ref key, grpc::string_ref* value) {
     if (filled_) {
-      auto iter = map_.find(kBinaryErrorDetailsKey);
-      if (iter != map_.end()) {
-        return grpc::string(iter->second.begin(), iter->second.length());
-      }
+      auto iter = map_.find(key);
+      if (iter == map_.end()) return false;
+      *value = iter->second;
+      return true;
     }
-    // if not yet filled, take the O(n) lookup to avoid allocating the
-    // multimap until it is requested.
-    // TODO(ncteisen): plumb this through core as a first class object, just
-    // like code and message.
-    else {
-      for (size_t i = 0; i < arr_.count; i++) {
-        if (strncmp(reinterpret_cast<const char*>(
-                        GRPC_SLICE_START_PTR(arr_.metadata[i].key)),
-                    kBinaryErrorDetailsKey,
-                    GRPC_SLICE_LENGTH(arr_.metadata[i].key)) == 0) {
-          return grpc::string(reinterpret_cast<const char*>(
-                                  GRPC_SLICE_START_PTR(arr_.metadata[i].value)),
-                              GRPC_SLICE_LENGTH(arr_.metadata[i].value));
-        }
+    for (size_t i = 0; i < arr_.count; i++) {
+      if (StringRefFromSlice(&arr_.metadata[i].key) == key) {
+        *value = StringRefFromSlice(&arr_.metadata[i].value);
+        return true;
       }
     }
-    return grpc::string();
+    return false;
   }
 
   std::multimap<grpc::string_ref, grpc::string_ref>* map() {
@@ -0,0 +1,137 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_IMPL_CODEGEN_PROTO_ARENA_MESSAGE_ALLOCATOR_H
+#define GRPCPP_IMPL_CODEGEN_PROTO_ARENA_MESSAGE_ALLOCATOR_H
+
+#include <memory>
+#include <vector>
+
+#include <grpcpp/impl/codegen/config_protobuf.h>
+#include <grpcpp/impl/codegen/message_allocator.h>
+#include <grpcpp/impl/codegen/sync.h>
+
+namespace grpc {
+namespace experimental {
+
+// A MessageAllocator that creates the request and response of each rpc on a
+// protobuf Arena, so that they and everything they own are freed at once when
+// the rpc is done. The arenas of finished rpcs are reset and reused, keeping
+// their first block, so that once the server is warm most rpcs whose messages
+// fit in that block allocate nothing. Like any allocator, it needs to be alive
+// for the lifetime of the server.
+template <typename RequestT, typename ResponseT>
+class ProtoArenaMessageAllocator
+    : public MessageAllocator<RequestT, ResponseT> {
+ public:
+  // Each arena starts with (and keeps across reuse) a block of
+  // initial_block_size bytes, and at most max_cached_arenas idle arenas are
+  // kept for reuse.
+  explicit ProtoArenaMessageAllocator(size_t initial_block_size = 1024,
+                                      size_t max_cached_arenas = 64)
+      : initial_block_size_(initial_block_size),
+        max_cached_arenas_(max_cached_arenas) {}
+
+  ~ProtoArenaMessageAllocator() override {
+    for (auto* holder : free_holders_) {
+      delete holder;
+    }
+  }
+
+  // A process-wide allocator for these message types, which the services
+  // generated with the arena_message_allocator option use. It is never
+  // destroyed, so it outlives every server.
+  static ProtoArenaMessageAllocator* Default() {
+    static ProtoArenaMessageAllocator* allocator =
+        new ProtoArenaMessageAllocator;
+    return allocator;
+  }
+
+  MessageHolder<RequestT, ResponseT>* AllocateMessages() override {
+    MessageHolderImpl* holder = nullptr;
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (!free_holders_.empty()) {
+        holder = free_holders_.back();
+        free_holders_.pop_back();
+      }
+    }
+    if (holder == nullptr) {
+      holder = new MessageHolderImpl(this);
+    }
+    holder->CreateMessages();
+    return holder;
+  }
+
+ private:
+  class MessageHolderImpl : public MessageHolder<RequestT, ResponseT> {
+   public:
+    explicit MessageHolderImpl(ProtoArenaMessageAllocator* allocator)
+        : allocator_(allocator),
+          initial_block_(new char[allocator->initial_block_size_]),
+          arena_(Options(initial_block_.get(),
+                         allocator->initial_block_size_)) {}
+
+    void CreateMessages() {
+      this->set_request(protobuf::Arena::CreateMessage<RequestT>(&arena_));
+      this->set_response(protobuf::Arena::CreateMessage<ResponseT>(&arena_));
+    }
+
+    // The request is freed with the rest of the arena, so FreeRequest() is
+    // left a no-op.
+    void Release() override {
+      arena_.Reset();
+      allocator_->Recycle(this);
+    }
+
+   private:
+    static protobuf::ArenaOptions Options(char* initial_block,
+                                          size_t initial_block_size) {
+      protobuf::ArenaOptions options;
+      options.initial_block = initial_block;
+      options.initial_block_size = initial_block_size;
+      return options;
+    }
+
+    ProtoArenaMessageAllocator* const allocator_;
+    // Owned here since the arena does not free a block it was given.
+    std::unique_ptr<char[]> initial_block_;
+    protobuf::Arena arena_;
+  };
+
+  void Recycle(MessageHolderImpl* holder) {
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (free_holders_.size() < max_cached_arenas_) {
+        free_holders_.push_back(holder);
+        return;
+      }
+    }
+    delete holder;
+  }
+
+  const size_t initial_block_size_;
+  const size_t max_cached_arenas_;
+  grpc::internal::Mutex mu_;
+  std::vector<MessageHolderImpl*> free_holders_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_IMPL_CODEGEN_PROTO_ARENA_MESSAGE_ALLOCATOR_H
@@ -95,6 +95,31 @@ class ProtoBufferReader : public ::grpc::protobuf::io::ZeroCopyInputStream {
   /// Returns the status of the buffer reader.
   Status status() const { return status_; }
 
+  /// Returns the number of bytes making up the (decompressed) message.
+  /// Only valid when status() is ok.
+  size_t Length() {
+    return g_core_codegen_interface->grpc_byte_buffer_length(
+        reader_.buffer_out);
+  }
+
+  /// If the message is a single slice and none of it has been read yet,
+  /// points \a data and \a size at that slice, so that it can be parsed in
+  /// place without going through Next().
+  bool PeekContiguous(const void** data, int* size) {
+    if (!status_.ok() || byte_count_ != 0 ||
+        reader_.buffer_out->data.raw.slice_buffer.count != 1) {
+      return false;
+    }
+    const grpc_slice& slice =
+        reader_.buffer_out->data.raw.slice_buffer.slices[0];
+    if (GRPC_SLICE_LENGTH(slice) > INT_MAX) {
+      return false;
+    }
+    *data = GRPC_SLICE_START_PTR(slice);
+    *size = static_cast<int>(GRPC_SLICE_LENGTH(slice));
+    return true;
+  }
+
   /// The proto library calls this to indicate that we should back up \a count
   /// bytes that have already been returned by the last call of Next.
   /// So do the backup and have that ready for a later Next.
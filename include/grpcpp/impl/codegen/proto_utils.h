@@ -49,10 +49,12 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
                 "ProtoBufferWriter must be a subclass of "
                 "::protobuf::io::ZeroCopyOutputStream");
   *own_buffer = true;
-  int byte_size = msg.ByteSize();
-  if ((size_t)byte_size <= GRPC_SLICE_INLINED_SIZE) {
+  const size_t byte_size = msg.ByteSizeLong();
+  if (byte_size <= static_cast<size_t>(kProtoBufferWriterMaxBufferLength)) {
+    // A message that fits in one writer block is serialized straight into a
+    // single slice of exactly its size (inlined when it is small enough),
+    // skipping the stream adapter.
     Slice slice(byte_size);
-    // We serialize directly into the allocated slices memory
     GPR_CODEGEN_ASSERT(slice.end() == msg.SerializeWithCachedSizesToArray(
                                           const_cast<uint8_t*>(slice.begin())));
     ByteBuffer tmp(&slice, 1);
@@ -60,12 +62,44 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
 
     return g_core_codegen_interface->ok();
   }
-  ProtoBufferWriter writer(bb, kProtoBufferWriterMaxBufferLength, byte_size);
+  ProtoBufferWriter writer(bb, kProtoBufferWriterMaxBufferLength,
+                           static_cast<int>(byte_size));
   return msg.SerializeToZeroCopyStream(&writer)
              ? g_core_codegen_interface->ok()
              : Status(StatusCode::INTERNAL, "Failed to serialize message");
 }
 
+namespace internal {
+
+// Parses msg from the whole of reader. With gRPC's own reader, a message held
+// in one slice is parsed in place as a flat array, and any other is parsed
+// with its length known, which lets the parser size each large string or
+// bytes field once rather than growing it as the slices arrive.
+template <class ProtoBufferReader>
+bool ParseFromReader(ProtoBufferReader* reader,
+                     grpc::protobuf::MessageLite* msg) {
+  return msg->ParseFromZeroCopyStream(reader);
+}
+
+inline bool ParseFromReader(ProtoBufferReader* reader,
+                            grpc::protobuf::MessageLite* msg) {
+  const void* data;
+  int size;
+  if (reader->PeekContiguous(&data, &size)) {
+    return msg->ParseFromArray(data, size);
+  }
+  const size_t length = reader->Length();
+  if (length > INT_MAX) {
+    return msg->ParseFromZeroCopyStream(reader);
+  }
+  grpc::protobuf::io::CodedInputStream decoder(reader);
+  decoder.SetTotalBytesLimit(static_cast<int>(length));
+  return msg->ParseFromCodedStream(&decoder) &&
+         decoder.ConsumedEntireMessage();
+}
+
+}  // namespace internal
+
 // BufferReader must be a subclass of ::protobuf::io::ZeroCopyInputStream.
 template <class ProtoBufferReader, class T>
 Status GenericDeserialize(ByteBuffer* buffer,
@@ -83,7 +117,7 @@ Status GenericDeserialize(ByteBuffer* buffer,
     if (!reader.status().ok()) {
       return reader.status();
     }
-    if (!msg->ParseFromZeroCopyStream(&reader)) {
+    if (!internal::ParseFromReader(&reader, msg)) {
       result = Status(StatusCode::INTERNAL, msg->InitializationErrorString());
     }
   }
@@ -116,6 +116,9 @@ class ServerRpcInfo {
       if (interceptor != nullptr) {
         interceptors_.push_back(
             std::unique_ptr<experimental::Interceptor>(interceptor));
+        interceptor_hook_points_.push_back(
+            internal::InterceptedHookPoints(interceptor));
+        hook_points_ |= interceptor_hook_points_.back();
       }
     }
   }
@@ -132,6 +135,9 @@ class ServerRpcInfo {
   const Type type_;
   std::atomic<intptr_t> ref_{1};
   std::vector<std::unique_ptr<experimental::Interceptor>> interceptors_;
+  // The hook points each interceptor intercepts, and all of them together.
+  std::vector<uint32_t> interceptor_hook_points_;
+  uint32_t hook_points_ = 0;
 
   friend class internal::InterceptorBatchMethodsImpl;
   friend class grpc_impl::ServerContext;
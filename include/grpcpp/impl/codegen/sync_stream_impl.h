@@ -122,6 +122,37 @@ class WriterInterface {
   /// \return \a true on success, \a false when the stream has been closed.
   inline bool Write(const W& msg) { return Write(msg, ::grpc::WriteOptions()); }
 
+  /// Block to write each message in [\a first, \a last) to the stream, with
+  /// WriteOptions \a options, in order. Every message but the last is written
+  /// with the buffer hint set, so the batch is flushed once and the transport
+  /// can pack the messages into as few frames as flow control allows; the
+  /// last message is written with \a options as given.
+  /// This is thread-safe with respect to \a ReaderInterface::Read
+  ///
+  /// \param first, last The range of messages to be written to the stream.
+  /// \param options The WriteOptions affecting the write operations.
+  ///
+  /// \return \a true on success, \a false when the stream has been closed; no
+  /// further messages are written after a failed write.
+  template <class InputIterator>
+  bool WriteMany(InputIterator first, InputIterator last,
+                 ::grpc::WriteOptions options) {
+    if (first == last) return true;
+    ::grpc::WriteOptions buffered = options;
+    buffered.set_buffer_hint().clear_last_message();
+    for (InputIterator next = first; ++next != last; first = next) {
+      if (!Write(*first, buffered)) return false;
+    }
+    return Write(*first, options);
+  }
+
+  /// Block to write each message in [\a first, \a last) to the stream with
+  /// default write options, as WriteMany(first, last, options) does.
+  template <class InputIterator>
+  bool WriteMany(InputIterator first, InputIterator last) {
+    return WriteMany(first, last, ::grpc::WriteOptions());
+  }
+
   /// Write \a msg and coalesce it with the writing of trailing metadata, using
   /// WriteOptions \a options.
   ///
@@ -29,6 +29,9 @@ static inline void RegisterOpenCensusPlugin() {
 static inline void RegisterOpenCensusViewsForExport() {
   ::grpc_impl::RegisterOpenCensusViewsForExport();
 }
+static inline void SetOpenCensusStatsSamplingRate(uint32_t one_in_n) {
+  ::grpc_impl::SetOpenCensusStatsSamplingRate(one_in_n);
+}
 static inline ::opencensus::trace::Span GetSpanFromServerContext(
     ::grpc_impl::ServerContext* context) {
   return ::grpc_impl::GetSpanFromServerContext(context);
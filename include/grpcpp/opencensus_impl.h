@@ -19,6 +19,8 @@
 #ifndef GRPCPP_OPENCENSUS_IMPL_H
 #define GRPCPP_OPENCENSUS_IMPL_H
 
+#include <stdint.h>
+
 #include "opencensus/trace/span.h"
 
 namespace grpc_impl {
@@ -39,6 +41,13 @@ void RegisterOpenCensusPlugin();
 // ViewDescriptors below.
 void RegisterOpenCensusViewsForExport();
 
+// Records the per-RPC measures above for only one in \a one_in_n RPCs, to cut
+// the cost of the plugin on busy processes. The other RPCs are only counted,
+// by method and status, in the grpc.io/{client,server}/unsampled_rpcs
+// measures, and those counts are kept per thread and recorded in batches.
+// The default of 1 records every RPC. Tracing is not affected.
+void SetOpenCensusStatsSamplingRate(uint32_t one_in_n);
+
 // Returns the tracing Span for the current RPC.
 ::opencensus::trace::Span GetSpanFromServerContext(ServerContext* context);
 
@@ -221,6 +221,21 @@ class ServerBuilder {
   ServerBuilder& SetResourceQuota(
       const grpc_impl::ResourceQuota& resource_quota);
 
+  /// Keep every connection on the completion queue whose SO_REUSEPORT
+  /// listener accepted it. Where SO_REUSEPORT is available, one listener is
+  /// opened per frequently polled completion queue; with this set, the
+  /// connections each one accepts stay bound to that completion queue's
+  /// pollset for their lifetime instead of being spread across all of them.
+  ServerBuilder& SetReusePortListenerAffinity(bool enabled);
+
+  /// Spread the completion queues of a synchronous server across the NUMA
+  /// nodes of the machine, binding the threads that poll each completion queue
+  /// to the CPUs of its node. Also sets \a SetReusePortListenerAffinity, so
+  /// that each connection is served by the threads of a single node.
+  /// Asynchronous servers, whose completion queues are polled by threads of
+  /// the application, only get the listener affinity.
+  ServerBuilder& SetNumaThreadPlacement(bool enabled);
+
   ServerBuilder& SetOption(std::unique_ptr<grpc::ServerBuilderOption> option);
 
   /// Options for synchronous servers.
@@ -228,7 +243,8 @@ class ServerBuilder {
     NUM_CQS,         ///< Number of completion queues.
     MIN_POLLERS,     ///< Minimum number of polling threads.
     MAX_POLLERS,     ///< Maximum number of polling threads.
-    CQ_TIMEOUT_MSEC  ///< Completion queue timeout in milliseconds.
+    CQ_TIMEOUT_MSEC,  ///< Completion queue timeout in milliseconds.
+    WARM_THREADS      ///< Idle threads per completion queue kept parked.
   };
 
   /// Only useful if this is a Synchronous server.
@@ -284,6 +300,16 @@ class ServerBuilder {
     AddExternalConnectionAcceptor(ExternalConnectionType type,
                                   std::shared_ptr<ServerCredentials> creds);
 
+    /// Add a completion queue for handling asynchronous services that is
+    /// meant to be polled by many threads at once. Completed events are
+    /// sharded per core and idle pollers steal from other shards, so a single
+    /// such queue scales with the number of polling threads instead of
+    /// requiring one queue per thread.
+    ///
+    /// \param is_frequently_polled Same meaning as for \a AddCompletionQueue.
+    std::unique_ptr<grpc_impl::ServerCompletionQueue>
+    AddShardedCompletionQueue(bool is_frequently_polled = true);
+
    private:
     ServerBuilder* builder_;
   };
@@ -337,7 +363,11 @@ class ServerBuilder {
 
   struct SyncServerSettings {
     SyncServerSettings()
-        : num_cqs(1), min_pollers(1), max_pollers(2), cq_timeout_msec(10000) {}
+        : num_cqs(1),
+          min_pollers(1),
+          max_pollers(2),
+          cq_timeout_msec(10000),
+          warm_threads(0) {}
 
     /// Number of server completion queues to create to listen to incoming RPCs.
     int num_cqs;
@@ -352,6 +382,13 @@ class ServerBuilder {
 
     /// The timeout for server completion queue's AsyncNext call.
     int cq_timeout_msec;
+
+    /// Number of idle threads per completion queue to keep parked, ready to
+    /// poll. They are created when the server starts, take over polling
+    /// instead of new threads being created when the pollers get busy, and
+    /// pollers that are no longer needed are parked instead of being torn down
+    /// while there is room for them.
+    int warm_threads;
   };
 
   int max_receive_message_size_;
@@ -182,10 +182,15 @@ class Server : public grpc::ServerInterface, private grpc::GrpcLibraryCodegen {
   ///
   /// \param sync_cq_timeout_msec The timeout to use when calling AsyncNext() on
   /// server completion queues passed via sync_server_cqs param.
+  ///
+  /// \param warm_threads The number of idle threads per server completion
+  /// queue (in param sync_server_cqs) to keep parked, ready to poll (used only
+  /// in case of sync server)
   Server(int max_message_size, ChannelArguments* args,
          std::shared_ptr<std::vector<std::unique_ptr<ServerCompletionQueue>>>
              sync_server_cqs,
          int min_pollers, int max_pollers, int sync_cq_timeout_msec,
+         int warm_threads,
          std::vector<
              std::shared_ptr<grpc::internal::ExternalConnectionAcceptorImpl>>
              acceptors,
@@ -317,6 +322,10 @@ class Server : public grpc::ServerInterface, private grpc::GrpcLibraryCodegen {
   //       starts, but this is still a limitation.
   std::vector<gpr_atm> callback_unmatched_reqs_count_;
 
+  // Callback requests bound to a call whose handler has not finished yet,
+  // indexed by method. Sizes how many finished requests are recycled.
+  std::vector<gpr_atm> callback_busy_reqs_count_;
+
   // List of callback requests to start when server actually starts.
   std::list<CallbackRequestBase*> callback_reqs_to_start_;
 
@@ -374,6 +383,10 @@ class Server : public grpc::ServerInterface, private grpc::GrpcLibraryCodegen {
   // shutdown callback tag (invoked when the CQ is fully shutdown).
   // It is protected by mu_
   CompletionQueue* callback_cq_ = nullptr;
+
+  // Whether callback_cq_ runs its callbacks on the completing thread
+  // (GRPC_ARG_SERVER_INLINE_CALLBACKS).
+  bool inline_callbacks_ = false;
 };
 
 }  // namespace grpc_impl
@@ -0,0 +1,62 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef GRPCPP_SUPPORT_CORE_STATS_H
+#define GRPCPP_SUPPORT_CORE_STATS_H
+
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include <grpcpp/support/config.h>
+
+namespace grpc {
+
+namespace experimental {
+
+/// A histogram of the core library, such as the sizes of TCP writes.
+struct CoreStatsHistogram {
+  grpc::string name;
+  /// bucket_boundaries[i] is the smallest value counted in counts[i].
+  std::vector<int> bucket_boundaries;
+  std::vector<uint64_t> counts;
+};
+
+/// The counters and histograms of the core library, as listed in
+/// src/core/lib/debug/stats_data.yaml.
+struct CoreStats {
+  /// Pairs of counter name and count.
+  std::vector<std::pair<grpc::string, uint64_t>> counters;
+  std::vector<CoreStatsHistogram> histograms;
+};
+
+/// Returns a snapshot of the core library's stats, summed over all cpus.
+/// The stats cover every channel and server in the process since gRPC was
+/// initialized, so a monitoring system should export the difference between
+/// snapshots. All counts are zero if the library was built with
+/// GRPC_DISABLE_STATS.
+/// TODO: Promote it to out of experimental once it is proved useful.
+CoreStats GetCoreStats();
+
+}  // namespace experimental
+
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_CORE_STATS_H
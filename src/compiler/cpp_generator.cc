@@ -16,6 +16,7 @@
  *
  */
 
+#include <algorithm>
 #include <map>
 
 #include "src/compiler/cpp_generator.h"
@@ -55,8 +56,22 @@ grpc::string FilenameIdentifier(const grpc::string& filename) {
   }
   return result;
 }
+
+const char* const kServerApiFlavors[] = {
+    "async", "callback", "generic", "raw", "raw_callback", "streamed",
+};
+
+bool OmitsFlavor(const std::map<grpc::string, grpc::string>& vars,
+                 const char* flavor) {
+  return vars.find(grpc::string("omit_") + flavor) != vars.end();
+}
 }  // namespace
 
+bool IsServerApiFlavor(const grpc::string& flavor) {
+  return std::find(std::begin(kServerApiFlavors), std::end(kServerApiFlavors),
+                   flavor) != std::end(kServerApiFlavors);
+}
+
 template <class T, size_t N>
 T* array_end(T (&array)[N]) {
   return array + N;
@@ -155,6 +170,9 @@ grpc::string GetHeaderIncludes(grpc_generator::File* file,
         "grpcpp/impl/codegen/sync_stream.h",
     };
     std::vector<grpc::string> headers(headers_strs, array_end(headers_strs));
+    if (params.arena_message_allocator) {
+      headers.push_back("grpcpp/impl/codegen/proto_arena_message_allocator.h");
+    }
     PrintIncludes(printer.get(), headers, params.use_system_headers,
                   params.grpc_search_path);
     printer->Print(vars, "\n");
@@ -1023,7 +1041,14 @@ void PrintHeaderServerMethodCallback(
         "controller) {\n"
         "               return this->$"
         "Method$(context, request, response, controller);\n"
-        "             }));\n}\n");
+        "             }));\n");
+    if (vars->find("arena_message_allocator") != vars->end()) {
+      printer->Print(*vars,
+                     "  SetMessageAllocatorFor_$Method$(\n"
+                     "      ::grpc::experimental::ProtoArenaMessageAllocator< "
+                     "$RealRequest$, $RealResponse$>::Default());\n");
+    }
+    printer->Print("}\n");
     printer->Print(*vars,
                    "void SetMessageAllocatorFor_$Method$(\n"
                    "    ::grpc::experimental::MessageAllocator< "
@@ -1430,126 +1455,139 @@ void PrintHeaderService(grpc_generator::Printer* printer,
   printer->Print("};\n");
 
   // Server side - Asynchronous
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["Idx"] = as_string(i);
-    PrintHeaderServerMethodAsync(printer, service->method(i).get(), vars);
-  }
+  if (!OmitsFlavor(*vars, "async")) {
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["Idx"] = as_string(i);
+      PrintHeaderServerMethodAsync(printer, service->method(i).get(), vars);
+    }
 
-  printer->Print("typedef ");
+    printer->Print("typedef ");
 
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["method_name"] = service->method(i)->name();
-    printer->Print(*vars, "WithAsyncMethod_$method_name$<");
-  }
-  printer->Print("Service");
-  for (int i = 0; i < service->method_count(); ++i) {
-    printer->Print(" >");
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["method_name"] = service->method(i)->name();
+      printer->Print(*vars, "WithAsyncMethod_$method_name$<");
+    }
+    printer->Print("Service");
+    for (int i = 0; i < service->method_count(); ++i) {
+      printer->Print(" >");
+    }
+    printer->Print(" AsyncService;\n");
   }
-  printer->Print(" AsyncService;\n");
 
   // Server side - Callback
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["Idx"] = as_string(i);
-    PrintHeaderServerMethodCallback(printer, service->method(i).get(), vars);
-  }
+  if (!OmitsFlavor(*vars, "callback")) {
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["Idx"] = as_string(i);
+      PrintHeaderServerMethodCallback(printer, service->method(i).get(), vars);
+    }
 
-  printer->Print("typedef ");
+    printer->Print("typedef ");
 
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["method_name"] = service->method(i)->name();
-    printer->Print(*vars, "ExperimentalWithCallbackMethod_$method_name$<");
-  }
-  printer->Print("Service");
-  for (int i = 0; i < service->method_count(); ++i) {
-    printer->Print(" >");
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["method_name"] = service->method(i)->name();
+      printer->Print(*vars, "ExperimentalWithCallbackMethod_$method_name$<");
+    }
+    printer->Print("Service");
+    for (int i = 0; i < service->method_count(); ++i) {
+      printer->Print(" >");
+    }
+    printer->Print(" ExperimentalCallbackService;\n");
   }
-  printer->Print(" ExperimentalCallbackService;\n");
 
   // Server side - Generic
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["Idx"] = as_string(i);
-    PrintHeaderServerMethodGeneric(printer, service->method(i).get(), vars);
+  if (!OmitsFlavor(*vars, "generic")) {
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["Idx"] = as_string(i);
+      PrintHeaderServerMethodGeneric(printer, service->method(i).get(), vars);
+    }
   }
 
   // Server side - Raw
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["Idx"] = as_string(i);
-    PrintHeaderServerMethodRaw(printer, service->method(i).get(), vars);
+  if (!OmitsFlavor(*vars, "raw")) {
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["Idx"] = as_string(i);
+      PrintHeaderServerMethodRaw(printer, service->method(i).get(), vars);
+    }
   }
 
   // Server side - Raw Callback
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["Idx"] = as_string(i);
-    PrintHeaderServerMethodRawCallback(printer, service->method(i).get(), vars);
+  if (!OmitsFlavor(*vars, "raw_callback")) {
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["Idx"] = as_string(i);
+      PrintHeaderServerMethodRawCallback(printer, service->method(i).get(),
+                                         vars);
+    }
   }
 
   // Server side - Streamed Unary
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["Idx"] = as_string(i);
-    PrintHeaderServerMethodStreamedUnary(printer, service->method(i).get(),
-                                         vars);
-  }
+  if (!OmitsFlavor(*vars, "streamed")) {
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["Idx"] = as_string(i);
+      PrintHeaderServerMethodStreamedUnary(printer, service->method(i).get(),
+                                           vars);
+    }
 
-  printer->Print("typedef ");
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["method_name"] = service->method(i)->name();
-    if (service->method(i)->NoStreaming()) {
-      printer->Print(*vars, "WithStreamedUnaryMethod_$method_name$<");
+    printer->Print("typedef ");
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["method_name"] = service->method(i)->name();
+      if (service->method(i)->NoStreaming()) {
+        printer->Print(*vars, "WithStreamedUnaryMethod_$method_name$<");
+      }
     }
-  }
-  printer->Print("Service");
-  for (int i = 0; i < service->method_count(); ++i) {
-    if (service->method(i)->NoStreaming()) {
-      printer->Print(" >");
+    printer->Print("Service");
+    for (int i = 0; i < service->method_count(); ++i) {
+      if (service->method(i)->NoStreaming()) {
+        printer->Print(" >");
+      }
     }
-  }
-  printer->Print(" StreamedUnaryService;\n");
+    printer->Print(" StreamedUnaryService;\n");
 
-  // Server side - controlled server-side streaming
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["Idx"] = as_string(i);
-    PrintHeaderServerMethodSplitStreaming(printer, service->method(i).get(),
-                                          vars);
-  }
+    // Server side - controlled server-side streaming
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["Idx"] = as_string(i);
+      PrintHeaderServerMethodSplitStreaming(printer, service->method(i).get(),
+                                            vars);
+    }
 
-  printer->Print("typedef ");
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["method_name"] = service->method(i)->name();
-    auto method = service->method(i);
-    if (ServerOnlyStreaming(method.get())) {
-      printer->Print(*vars, "WithSplitStreamingMethod_$method_name$<");
+    printer->Print("typedef ");
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["method_name"] = service->method(i)->name();
+      auto method = service->method(i);
+      if (ServerOnlyStreaming(method.get())) {
+        printer->Print(*vars, "WithSplitStreamingMethod_$method_name$<");
+      }
     }
-  }
-  printer->Print("Service");
-  for (int i = 0; i < service->method_count(); ++i) {
-    auto method = service->method(i);
-    if (ServerOnlyStreaming(method.get())) {
-      printer->Print(" >");
+    printer->Print("Service");
+    for (int i = 0; i < service->method_count(); ++i) {
+      auto method = service->method(i);
+      if (ServerOnlyStreaming(method.get())) {
+        printer->Print(" >");
+      }
     }
-  }
-  printer->Print(" SplitStreamedService;\n");
+    printer->Print(" SplitStreamedService;\n");
 
-  // Server side - typedef for controlled both unary and server-side streaming
-  printer->Print("typedef ");
-  for (int i = 0; i < service->method_count(); ++i) {
-    (*vars)["method_name"] = service->method(i)->name();
-    auto method = service->method(i);
-    if (ServerOnlyStreaming(method.get())) {
-      printer->Print(*vars, "WithSplitStreamingMethod_$method_name$<");
-    }
-    if (service->method(i)->NoStreaming()) {
-      printer->Print(*vars, "WithStreamedUnaryMethod_$method_name$<");
+    // Server side - typedef for controlled both unary and server-side streaming
+    printer->Print("typedef ");
+    for (int i = 0; i < service->method_count(); ++i) {
+      (*vars)["method_name"] = service->method(i)->name();
+      auto method = service->method(i);
+      if (ServerOnlyStreaming(method.get())) {
+        printer->Print(*vars, "WithSplitStreamingMethod_$method_name$<");
+      }
+      if (service->method(i)->NoStreaming()) {
+        printer->Print(*vars, "WithStreamedUnaryMethod_$method_name$<");
+      }
     }
-  }
-  printer->Print("Service");
-  for (int i = 0; i < service->method_count(); ++i) {
-    auto method = service->method(i);
-    if (service->method(i)->NoStreaming() ||
-        ServerOnlyStreaming(method.get())) {
-      printer->Print(" >");
+    printer->Print("Service");
+    for (int i = 0; i < service->method_count(); ++i) {
+      auto method = service->method(i);
+      if (service->method(i)->NoStreaming() ||
+          ServerOnlyStreaming(method.get())) {
+        printer->Print(" >");
+      }
     }
+    printer->Print(" StreamedService;\n");
   }
-  printer->Print(" StreamedService;\n");
 
   printer->Outdent();
   printer->Print("};\n");
@@ -1569,6 +1607,22 @@ grpc::string GetHeaderServices(grpc_generator::File* file,
     if (!file->package().empty()) {
       vars["Package"].append(".");
     }
+    // Only its presence matters.
+    if (params.arena_message_allocator) {
+      vars["arena_message_allocator"] = "true";
+    }
+
+    // Only their presence matters: omit_<flavor> keeps PrintHeaderService
+    // from emitting that flavor's per-method templates and typedefs.
+    if (!params.server_api_flavors.empty()) {
+      for (const char* flavor : kServerApiFlavors) {
+        if (std::find(params.server_api_flavors.begin(),
+                      params.server_api_flavors.end(),
+                      flavor) == params.server_api_flavors.end()) {
+          vars[grpc::string("omit_") + flavor] = "true";
+        }
+      }
+    }
 
     if (!params.services_namespace.empty()) {
       vars["services_namespace"] = params.services_namespace;
@@ -60,8 +60,18 @@ struct Parameters {
   grpc::string message_header_extension;
   // Whether to include headers corresponding to imports in source file.
   bool include_import_headers;
+  // *EXPERIMENTAL* Whether callback unary methods allocate their messages on
+  // protobuf arenas by default.
+  bool arena_message_allocator;
+  // *EXPERIMENTAL* Server API flavors to generate besides the base Service:
+  // any of "async", "callback", "generic", "raw", "raw_callback" and
+  // "streamed". Empty means all of them.
+  std::vector<grpc::string> server_api_flavors;
 };
 
+// Returns whether flavor is a valid entry for Parameters::server_api_flavors.
+bool IsServerApiFlavor(const grpc::string& flavor);
+
 // Return the prologue of the generated header file.
 grpc::string GetHeaderPrologue(grpc_generator::File* file,
                                const Parameters& params);
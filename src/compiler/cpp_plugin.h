@@ -50,6 +50,7 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
     generator_parameters.use_system_headers = true;
     generator_parameters.generate_mock_code = false;
     generator_parameters.include_import_headers = false;
+    generator_parameters.arena_message_allocator = false;
 
     ProtoBufFile pbfile(file);
 
@@ -94,6 +95,22 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
             *error = grpc::string("Invalid parameter: ") + *parameter_string;
             return false;
           }
+        } else if (param[0] == "arena_message_allocator") {
+          if (param[1] == "true") {
+            generator_parameters.arena_message_allocator = true;
+          } else if (param[1] != "false") {
+            *error = grpc::string("Invalid parameter: ") + *parameter_string;
+            return false;
+          }
+        } else if (param[0] == "server_api_flavors") {
+          generator_parameters.server_api_flavors =
+              grpc_generator::tokenize(param[1], ":");
+          for (const auto& flavor : generator_parameters.server_api_flavors) {
+            if (!grpc_cpp_generator::IsServerApiFlavor(flavor)) {
+              *error = grpc::string("Invalid parameter: ") + *parameter_string;
+              return false;
+            }
+          }
         } else {
           *error = grpc::string("Unknown parameter: ") + *parameter_string;
           return false;
@@ -28,6 +28,7 @@
 #include "src/core/ext/filters/client_channel/client_channel.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/pollset.h"
@@ -45,6 +46,7 @@ struct backup_poller {
   gpr_mu* pollset_mu;
   grpc_pollset* pollset;  // guarded by pollset_mu
   bool shutting_down;     // guarded by pollset_mu
+  bool use_thread;        // polled by a thread of its own, not the timer
   gpr_refcount refs;
   gpr_refcount shutdown_refs;
 };
@@ -57,6 +59,8 @@ static backup_poller* g_poller = nullptr;  // guarded by g_poller_mu
 // grpc_client_channel_start_backup_polling() is called, after that it is
 // treated as const.
 static int g_poll_interval_ms = DEFAULT_POLL_INTERVAL_MS;
+// Likewise set only once, from GRPC_CLIENT_CHANNEL_BACKUP_POLLER_THREAD.
+static bool g_use_poller_thread = false;
 
 GPR_GLOBAL_CONFIG_DEFINE_INT32(
     grpc_client_channel_backup_poll_interval_ms, DEFAULT_POLL_INTERVAL_MS,
@@ -67,6 +71,13 @@ GPR_GLOBAL_CONFIG_DEFINE_INT32(
     "idleness), so that the next RPC on this channel won't fail. Set to 0 to "
     "turn off the backup polls.");
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_client_channel_backup_poller_thread, false,
+    "If set, the backup poller is a thread blocked polling the client "
+    "channels' fds, woken only when one of them has an event, instead of "
+    "a poll run by the timer every "
+    "GRPC_CLIENT_CHANNEL_BACKUP_POLL_INTERVAL_MS.");
+
 void grpc_client_channel_global_init_backup_polling() {
   gpr_once_init(&g_once, [] { gpr_mu_init(&g_poller_mu); });
   int32_t poll_interval_ms =
@@ -79,6 +90,8 @@ void grpc_client_channel_global_init_backup_polling() {
   } else {
     g_poll_interval_ms = poll_interval_ms;
   }
+  g_use_poller_thread =
+      GPR_GLOBAL_CONFIG_GET(grpc_client_channel_backup_poller_thread);
 }
 
 static void backup_poller_shutdown_unref(backup_poller* p) {
@@ -105,7 +118,8 @@ static void g_poller_unref() {
         p->pollset, GRPC_CLOSURE_INIT(&p->shutdown_closure, done_poller, p,
                                       grpc_schedule_on_exec_ctx));
     gpr_mu_unlock(p->pollset_mu);
-    grpc_timer_cancel(&p->polling_timer);
+    // the shutdown kicks the poller thread out of grpc_pollset_work()
+    if (!p->use_thread) grpc_timer_cancel(&p->polling_timer);
   } else {
     gpr_mu_unlock(&g_poller_mu);
   }
@@ -135,16 +149,48 @@ static void run_poller(void* arg, grpc_error* error) {
                   &p->run_poller_closure);
 }
 
+// Body of the poller thread: blocks in grpc_pollset_work() until an fd of
+// some channel has an event, so idle channels cost nothing between events.
+static void run_poller_thread(void* arg) {
+  backup_poller* p = static_cast<backup_poller*>(arg);
+  grpc_core::ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+  gpr_mu_lock(p->pollset_mu);
+  while (!p->shutting_down) {
+    grpc_pollset_worker* worker = nullptr;
+    GRPC_LOG_IF_ERROR(
+        "Run client channel backup poller",
+        grpc_pollset_work(p->pollset, &worker, GRPC_MILLIS_INF_FUTURE));
+    gpr_mu_unlock(p->pollset_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(p->pollset_mu);
+  }
+  gpr_mu_unlock(p->pollset_mu);
+  backup_poller_shutdown_unref(p);
+}
+
 static void g_poller_init_locked() {
   if (g_poller == nullptr) {
     g_poller = static_cast<backup_poller*>(gpr_zalloc(sizeof(backup_poller)));
     g_poller->pollset =
         static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
     g_poller->shutting_down = false;
+    g_poller->use_thread = g_use_poller_thread;
     grpc_pollset_init(g_poller->pollset, &g_poller->pollset_mu);
     gpr_ref_init(&g_poller->refs, 0);
-    // one for timer cancellation, one for pollset shutdown
+    // one for timer cancellation (or the poller thread exiting), one for
+    // pollset shutdown
     gpr_ref_init(&g_poller->shutdown_refs, 2);
+    if (g_poller->use_thread) {
+      // detached, since the last channel may be destroyed on the thread
+      // itself, and untracked, since it only exits with the last channel
+      grpc_core::Thread thd("grpc_backup_poller", run_poller_thread, g_poller,
+                            nullptr,
+                            grpc_core::Thread::Options()
+                                .set_joinable(false)
+                                .set_tracked(false));
+      thd.Start();
+      return;
+    }
     GRPC_CLOSURE_INIT(&g_poller->run_poller_closure, run_poller, g_poller,
                       grpc_schedule_on_exec_ctx);
     grpc_timer_init(&g_poller->polling_timer,
@@ -26,6 +26,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/direct_channel.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/completion_queue.h"
@@ -47,6 +48,10 @@ grpc_connectivity_state grpc_channel_check_connectivity_state(
 
     return state;
   }
+  if (client_channel_elem->filter == &grpc_direct_channel_filter) {
+    return grpc_direct_channel_check_connectivity_state(client_channel_elem,
+                                                        try_to_connect);
+  }
   gpr_log(GPR_ERROR,
           "grpc_channel_check_connectivity_state called on something that is "
           "not a client channel, but '%s'",
@@ -81,7 +86,8 @@ struct state_watcher {
 static void delete_state_watcher(state_watcher* w) {
   grpc_channel_element* client_channel_elem = grpc_channel_stack_last_element(
       grpc_channel_get_channel_stack(w->channel));
-  if (client_channel_elem->filter == &grpc_client_channel_filter) {
+  if (client_channel_elem->filter == &grpc_client_channel_filter ||
+      client_channel_elem->filter == &grpc_direct_channel_filter) {
     GRPC_CHANNEL_INTERNAL_UNREF(w->channel, "watch_channel_connectivity");
   } else {
     abort();
@@ -122,10 +128,15 @@ static void partly_done(state_watcher* w, bool due_to_completion,
   } else {
     grpc_channel_element* client_channel_elem = grpc_channel_stack_last_element(
         grpc_channel_get_channel_stack(w->channel));
-    grpc_client_channel_watch_connectivity_state(
-        client_channel_elem,
-        grpc_polling_entity_create_from_pollset(grpc_cq_pollset(w->cq)),
-        nullptr, &w->on_complete, nullptr);
+    grpc_polling_entity pollent =
+        grpc_polling_entity_create_from_pollset(grpc_cq_pollset(w->cq));
+    if (client_channel_elem->filter == &grpc_direct_channel_filter) {
+      grpc_direct_channel_watch_connectivity_state(
+          client_channel_elem, pollent, nullptr, &w->on_complete, nullptr);
+    } else {
+      grpc_client_channel_watch_connectivity_state(
+          client_channel_elem, pollent, nullptr, &w->on_complete, nullptr);
+    }
   }
 
   gpr_mu_lock(&w->mu);
@@ -189,6 +200,10 @@ static void timeout_complete(void* pw, grpc_error* error) {
 int grpc_channel_num_external_connectivity_watchers(grpc_channel* channel) {
   grpc_channel_element* client_channel_elem =
       grpc_channel_stack_last_element(grpc_channel_get_channel_stack(channel));
+  if (client_channel_elem->filter == &grpc_direct_channel_filter) {
+    return grpc_direct_channel_num_external_connectivity_watchers(
+        client_channel_elem);
+  }
   return grpc_client_channel_num_external_connectivity_watchers(
       client_channel_elem);
 }
@@ -209,7 +224,10 @@ static void watcher_timer_init(void* arg, grpc_error* error_ignored) {
 int grpc_channel_support_connectivity_watcher(grpc_channel* channel) {
   grpc_channel_element* client_channel_elem =
       grpc_channel_stack_last_element(grpc_channel_get_channel_stack(channel));
-  return client_channel_elem->filter != &grpc_client_channel_filter ? 0 : 1;
+  return client_channel_elem->filter == &grpc_client_channel_filter ||
+                 client_channel_elem->filter == &grpc_direct_channel_filter
+             ? 1
+             : 0;
 }
 
 void grpc_channel_watch_connectivity_state(
@@ -258,6 +276,12 @@ void grpc_channel_watch_connectivity_state(
         client_channel_elem,
         grpc_polling_entity_create_from_pollset(grpc_cq_pollset(cq)), &w->state,
         &w->on_complete, &w->watcher_timer_init);
+  } else if (client_channel_elem->filter == &grpc_direct_channel_filter) {
+    GRPC_CHANNEL_INTERNAL_REF(channel, "watch_channel_connectivity");
+    grpc_direct_channel_watch_connectivity_state(
+        client_channel_elem,
+        grpc_polling_entity_create_from_pollset(grpc_cq_pollset(cq)), &w->state,
+        &w->on_complete, &w->watcher_timer_init);
   } else {
     abort();
   }
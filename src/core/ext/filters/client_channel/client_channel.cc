@@ -78,6 +78,9 @@ using grpc_core::internal::ServerRetryThrottleData;
 // TODO(roth): Do we have any data to suggest a better value?
 #define DEFAULT_PER_RPC_RETRY_BUFFER_SIZE (256 << 10)
 
+// By default, all RPCs on a channel together buffer up to 16 MiB.
+#define DEFAULT_CHANNEL_RETRY_BUFFER_SIZE (16 << 20)
+
 // This value was picked arbitrarily.  It can be changed if there is
 // any even moderately compelling reason to do so.
 #define RETRY_BACKOFF_JITTER 0.2
@@ -119,17 +122,32 @@ class ChannelData {
                              const grpc_channel_info* info);
 
   bool deadline_checking_enabled() const { return deadline_checking_enabled_; }
+  DeadlineCoalescer* deadline_coalescer() const {
+    return deadline_coalescer_.get();
+  }
   bool enable_retries() const { return enable_retries_; }
   size_t per_rpc_retry_buffer_size() const {
     return per_rpc_retry_buffer_size_;
   }
 
+  // Charges \a bytes buffered for retries by a call to the channel-wide
+  // budget.  Returns false if that takes the channel over the budget, in
+  // which case the call should commit.  The bytes are charged either way
+  // and must be returned with ReleaseRetryBuffer().
+  bool ChargeRetryBuffer(size_t bytes) {
+    return retry_buffer_used_.FetchAdd(bytes, MemoryOrder::RELAXED) + bytes <=
+           channel_retry_buffer_size_;
+  }
+  void ReleaseRetryBuffer(size_t bytes) {
+    retry_buffer_used_.FetchSub(bytes, MemoryOrder::RELAXED);
+  }
+
   // Note: Does NOT return a new ref.
   grpc_error* disconnect_error() const {
     return disconnect_error_.Load(MemoryOrder::ACQUIRE);
   }
 
-  grpc_combiner* data_plane_combiner() const { return data_plane_combiner_; }
+  Mutex* data_plane_mu() const { return &data_plane_mu_; }
 
   LoadBalancingPolicy::SubchannelPicker* picker() const {
     return picker_.get();
@@ -165,8 +183,6 @@ class ChannelData {
 
  private:
   class SubchannelWrapper;
-  class ConnectivityStateAndPickerSetter;
-  class ServiceConfigSetter;
   class ClientChannelControlHelper;
 
   class ExternalConnectivityWatcher {
@@ -213,6 +229,20 @@ class ChannelData {
   ChannelData(grpc_channel_element_args* args, grpc_error** error);
   ~ChannelData();
 
+  // Sets the channel's connectivity state and then, holding the data plane
+  // mutex, updates the picker and re-processes the queued picks.  Must be
+  // invoked in the control plane combiner.
+  void UpdateStateAndPickerLocked(
+      grpc_connectivity_state state, const char* reason,
+      UniquePtr<LoadBalancingPolicy::SubchannelPicker> picker);
+
+  // Sets the channel's service config data, holding the data plane mutex.
+  // retry_throttle_data keeps the existing one if null.  Must be invoked in
+  // the control plane combiner.
+  void UpdateServiceConfigLocked(
+      RefCountedPtr<ServerRetryThrottleData> retry_throttle_data,
+      RefCountedPtr<ServiceConfig> service_config);
+
   void CreateResolvingLoadBalancingPolicyLocked();
 
   void DestroyResolvingLoadBalancingPolicyLocked();
@@ -238,8 +268,10 @@ class ChannelData {
   // Fields set at construction and never modified.
   //
   const bool deadline_checking_enabled_;
+  const RefCountedPtr<DeadlineCoalescer> deadline_coalescer_;
   const bool enable_retries_;
   const size_t per_rpc_retry_buffer_size_;
+  const size_t channel_retry_buffer_size_;
   grpc_channel_stack* owning_stack_;
   ClientChannelFactory* client_channel_factory_;
   const grpc_channel_args* channel_args_;
@@ -249,9 +281,12 @@ class ChannelData {
   channelz::ChannelNode* channelz_node_;
 
   //
-  // Fields used in the data plane.  Guarded by data_plane_combiner.
+  // Fields used in the data plane.  Guarded by data_plane_mu.
   //
-  grpc_combiner* data_plane_combiner_;
+  // Picks take the mutex on the calling thread rather than hopping into a
+  // combiner, and only hold it while the picker runs; the control plane
+  // takes it just long enough to swap in a new picker.
+  mutable Mutex data_plane_mu_;
   UniquePtr<LoadBalancingPolicy::SubchannelPicker> picker_;
   QueuedPick* queued_picks_ = nullptr;  // Linked list of queued picks.
   // Data from service config.
@@ -275,16 +310,22 @@ class ChannelData {
   Map<Subchannel*, int> subchannel_refcount_map_;
   // Pending ConnectedSubchannel updates for each SubchannelWrapper.
   // Updates are queued here in the control plane combiner and then applied
-  // in the data plane combiner when the picker is updated.
+  // in the data plane mutex when the picker is updated.
   Map<RefCountedPtr<SubchannelWrapper>, RefCountedPtr<ConnectedSubchannel>,
       RefCountedPtrLess<SubchannelWrapper>>
       pending_subchannel_updates_;
 
   //
-  // Fields accessed from both data plane and control plane combiners.
+  // Fields accessed from both data plane mutex and control plane combiner.
   //
   Atomic<grpc_error*> disconnect_error_;
 
+  //
+  // Fields updated by calls, each from its own call combiner.
+  //
+  // Bytes buffered for retries by calls that have not yet committed.
+  Atomic<size_t> retry_buffer_used_{0};
+
   //
   // Fields guarded by a mutex, since they need to be accessed
   // synchronously via get_channel_info().
@@ -315,7 +356,14 @@ class CallData {
   void MaybeApplyServiceConfigToCallLocked(grpc_call_element* elem);
 
   // Invoked by channel for queued picks when the picker is updated.
-  static void StartPickLocked(void* arg, grpc_error* error);
+  // Returns true if the pick is complete, in which case the caller must
+  // invoke PickDone() or AsyncPickDone() with the returned error.  Must be
+  // invoked holding the channel's data plane mutex.
+  bool PickSubchannelLocked(grpc_call_element* elem, grpc_error** error);
+
+  // Schedules a callback to process the completed pick.  The call will not
+  // run under the channel's data plane mutex.
+  void AsyncPickDone(grpc_call_element* elem, grpc_error* error);
 
  private:
   class QueuedPickCanceller;
@@ -456,6 +504,14 @@ class CallData {
     grpc_metadata_batch recv_trailing_metadata;
     grpc_transport_stream_stats collect_stats;
     grpc_closure recv_trailing_metadata_ready;
+    // The LB policy's recv_trailing_metadata_ready callback for the pick
+    // this subchannel call came from.  Kept here rather than in call_data,
+    // since a hedged attempt may still be finishing after the next pick.
+    void (*lb_recv_trailing_metadata_ready)(
+        void* user_data, grpc_error* error,
+        LoadBalancingPolicy::MetadataInterface* recv_trailing_metadata,
+        LoadBalancingPolicy::CallState* call_state) = nullptr;
+    void* lb_recv_trailing_metadata_ready_user_data = nullptr;
     // These fields indicate which ops have been started and completed on
     // this subchannel call.
     size_t started_send_message_count = 0;
@@ -563,6 +619,29 @@ class CallData {
   bool MaybeRetry(grpc_call_element* elem, SubchannelCallBatchData* batch_data,
                   grpc_status_code status, grpc_mdelem* server_pushback_md);
 
+  // State for the timer that starts the next attempt of a call with a
+  // hedging policy.  Allocated on the arena for each attempt, so that a
+  // timer that fired just before the attempt ended cannot act on the next
+  // attempt.
+  struct HedgingTimer {
+    grpc_call_element* elem;
+    grpc_timer timer;
+    grpc_closure on_timer;
+    grpc_closure start_hedged_attempt;
+    grpc_closure on_cancel_complete;
+    grpc_closure on_superseded_call_destroyed;
+  };
+  // Starts the hedging timer for the attempt on subchannel_call_, if the
+  // call has a hedging policy and attempts left.
+  void MaybeStartHedgingTimer(grpc_call_element* elem);
+  void CancelHedgingTimer();
+  static void OnHedgingTimer(void* arg, grpc_error* error);
+  // Cancels the attempt on subchannel_call_, which has not heard back from
+  // the server within the hedging delay, and starts the next one.
+  static void StartHedgedAttemptInCallCombiner(void* arg, grpc_error* error);
+  static void OnHedgedAttemptCancelComplete(void* arg, grpc_error* error);
+  static void OnSupersededCallDestroyed(void* arg, grpc_error* error);
+
   // Invokes recv_initial_metadata_ready for a subchannel batch.
   static void InvokeRecvInitialMetadataCallback(void* arg, grpc_error* error);
   // Intercepts recv_initial_metadata_ready callback for retries.
@@ -668,6 +747,9 @@ class CallData {
   void CreateSubchannelCall(grpc_call_element* elem);
   // Invoked when a pick is completed, on both success or failure.
   static void PickDone(void* arg, grpc_error* error);
+  // Takes the channel's data plane mutex and attempts a pick, calling
+  // PickDone() once the mutex is released if the pick completes.
+  static void PickSubchannel(void* arg, grpc_error* ignored);
   // Removes the call from the channel's list of queued picks.
   void RemoveCallFromQueuedPicksLocked(grpc_call_element* elem);
   // Adds the call to the channel's list of queued picks.
@@ -737,9 +819,13 @@ class CallData {
   bool last_attempt_got_server_pushback_ : 1;
   int num_attempts_completed_ = 0;
   size_t bytes_buffered_for_retry_ = 0;
+  // The part of bytes_buffered_for_retry_ charged to the channel-wide
+  // retry buffer budget.  Returned when retries are committed.
+  size_t bytes_charged_to_channel_ = 0;
   // TODO(roth): Restructure this to eliminate use of ManualConstructor.
   ManualConstructor<BackOff> retry_backoff_;
   grpc_timer retry_timer_;
+  HedgingTimer* hedging_timer_ = nullptr;
 
   // The number of pending retriable subchannel batches containing send ops.
   // We hold a ref to the call stack while this is non-zero, since replay
@@ -870,6 +956,11 @@ class ChannelData::SubchannelWrapper : public SubchannelInterface {
     return subchannel_->channel_args();
   }
 
+  int32_t GetAvailableStreams() override {
+    if (connected_subchannel_in_data_plane_ == nullptr) return 0;
+    return connected_subchannel_in_data_plane_->GetAvailableStreams();
+  }
+
   // Caller must be holding the control-plane combiner.
   ConnectedSubchannel* connected_subchannel() const {
     return connected_subchannel_.get();
@@ -981,7 +1072,7 @@ class ChannelData::SubchannelWrapper : public SubchannelInterface {
     // Update the connected subchannel only if the channel is not shutting
     // down.  This is because once the channel is shutting down, we
     // ignore picker updates from the LB policy, which means that
-    // ConnectivityStateAndPickerSetter will never process the entries
+    // UpdateStateAndPickerLocked() will never process the entries
     // in chand_->pending_subchannel_updates_.  So we don't want to add
     // entries there that will never be processed, since that would
     // leave dangling refs to the channel and prevent its destruction.
@@ -991,7 +1082,7 @@ class ChannelData::SubchannelWrapper : public SubchannelInterface {
     if (connected_subchannel_ != connected_subchannel) {
       connected_subchannel_ = std::move(connected_subchannel);
       // Record the new connected subchannel so that it can be updated
-      // in the data plane combiner the next time the picker is updated.
+      // in the data plane mutex the next time the picker is updated.
       chand_->pending_subchannel_updates_[Ref(
           DEBUG_LOCATION, "ConnectedSubchannelUpdate")] = connected_subchannel_;
     }
@@ -1008,159 +1099,10 @@ class ChannelData::SubchannelWrapper : public SubchannelInterface {
   Map<ConnectivityStateWatcherInterface*, WatcherWrapper*> watcher_map_;
   // To be accessed only in the control plane combiner.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
-  // To be accessed only in the data plane combiner.
+  // To be accessed only in the data plane mutex.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_in_data_plane_;
 };
 
-//
-// ChannelData::ConnectivityStateAndPickerSetter
-//
-
-// A fire-and-forget class that sets the channel's connectivity state
-// and then hops into the data plane combiner to update the picker.
-// Must be instantiated while holding the control plane combiner.
-// Deletes itself when done.
-class ChannelData::ConnectivityStateAndPickerSetter {
- public:
-  ConnectivityStateAndPickerSetter(
-      ChannelData* chand, grpc_connectivity_state state, const char* reason,
-      UniquePtr<LoadBalancingPolicy::SubchannelPicker> picker)
-      : chand_(chand), picker_(std::move(picker)) {
-    // Clean the control plane when entering IDLE, while holding control plane
-    // combiner.
-    if (picker_ == nullptr) {
-      chand->health_check_service_name_.reset();
-      chand->saved_service_config_.reset();
-      chand->received_first_resolver_result_ = false;
-    }
-    // Update connectivity state here, while holding control plane combiner.
-    grpc_connectivity_state_set(&chand->state_tracker_, state, reason);
-    if (chand->channelz_node_ != nullptr) {
-      chand->channelz_node_->SetConnectivityState(state);
-      chand->channelz_node_->AddTraceEvent(
-          channelz::ChannelTrace::Severity::Info,
-          grpc_slice_from_static_string(
-              channelz::ChannelNode::GetChannelConnectivityStateChangeString(
-                  state)));
-    }
-    // Grab any pending subchannel updates.
-    pending_subchannel_updates_ =
-        std::move(chand_->pending_subchannel_updates_);
-    // Bounce into the data plane combiner to reset the picker.
-    GRPC_CHANNEL_STACK_REF(chand->owning_stack_,
-                           "ConnectivityStateAndPickerSetter");
-    GRPC_CLOSURE_INIT(&closure_, SetPickerInDataPlane, this,
-                      grpc_combiner_scheduler(chand->data_plane_combiner_));
-    GRPC_CLOSURE_SCHED(&closure_, GRPC_ERROR_NONE);
-  }
-
- private:
-  static void SetPickerInDataPlane(void* arg, grpc_error* ignored) {
-    auto* self = static_cast<ConnectivityStateAndPickerSetter*>(arg);
-    // Handle subchannel updates.
-    for (auto& p : self->pending_subchannel_updates_) {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
-        gpr_log(GPR_INFO,
-                "chand=%p: updating subchannel wrapper %p data plane "
-                "connected_subchannel to %p",
-                self->chand_, p.first.get(), p.second.get());
-      }
-      p.first->set_connected_subchannel_in_data_plane(std::move(p.second));
-    }
-    // Swap out the picker.  We hang on to the old picker so that it can
-    // be deleted in the control-plane combiner, since that's where we need
-    // to unref the subchannel wrappers that are reffed by the picker.
-    self->picker_.swap(self->chand_->picker_);
-    // Clean the data plane if the updated picker is nullptr.
-    if (self->chand_->picker_ == nullptr) {
-      self->chand_->received_service_config_data_ = false;
-      self->chand_->retry_throttle_data_.reset();
-      self->chand_->service_config_.reset();
-    }
-    // Re-process queued picks.
-    for (QueuedPick* pick = self->chand_->queued_picks_; pick != nullptr;
-         pick = pick->next) {
-      CallData::StartPickLocked(pick->elem, GRPC_ERROR_NONE);
-    }
-    // Pop back into the control plane combiner to delete ourself, so
-    // that we make sure to unref subchannel wrappers there.  This
-    // includes both the ones reffed by the old picker (now stored in
-    // self->picker_) and the ones in self->pending_subchannel_updates_.
-    GRPC_CLOSURE_INIT(&self->closure_, CleanUpInControlPlane, self,
-                      grpc_combiner_scheduler(self->chand_->combiner_));
-    GRPC_CLOSURE_SCHED(&self->closure_, GRPC_ERROR_NONE);
-  }
-
-  static void CleanUpInControlPlane(void* arg, grpc_error* ignored) {
-    auto* self = static_cast<ConnectivityStateAndPickerSetter*>(arg);
-    GRPC_CHANNEL_STACK_UNREF(self->chand_->owning_stack_,
-                             "ConnectivityStateAndPickerSetter");
-    Delete(self);
-  }
-
-  ChannelData* chand_;
-  UniquePtr<LoadBalancingPolicy::SubchannelPicker> picker_;
-  Map<RefCountedPtr<SubchannelWrapper>, RefCountedPtr<ConnectedSubchannel>,
-      RefCountedPtrLess<SubchannelWrapper>>
-      pending_subchannel_updates_;
-  grpc_closure closure_;
-};
-
-//
-// ChannelData::ServiceConfigSetter
-//
-
-// A fire-and-forget class that sets the channel's service config data
-// in the data plane combiner.  Deletes itself when done.
-class ChannelData::ServiceConfigSetter {
- public:
-  ServiceConfigSetter(
-      ChannelData* chand,
-      Optional<internal::ClientChannelGlobalParsedConfig::RetryThrottling>
-          retry_throttle_data,
-      RefCountedPtr<ServiceConfig> service_config)
-      : chand_(chand),
-        retry_throttle_data_(retry_throttle_data),
-        service_config_(std::move(service_config)) {
-    GRPC_CHANNEL_STACK_REF(chand->owning_stack_, "ServiceConfigSetter");
-    GRPC_CLOSURE_INIT(&closure_, SetServiceConfigData, this,
-                      grpc_combiner_scheduler(chand->data_plane_combiner_));
-    GRPC_CLOSURE_SCHED(&closure_, GRPC_ERROR_NONE);
-  }
-
- private:
-  static void SetServiceConfigData(void* arg, grpc_error* ignored) {
-    ServiceConfigSetter* self = static_cast<ServiceConfigSetter*>(arg);
-    ChannelData* chand = self->chand_;
-    // Update channel state.
-    chand->received_service_config_data_ = true;
-    if (self->retry_throttle_data_.has_value()) {
-      chand->retry_throttle_data_ =
-          internal::ServerRetryThrottleMap::GetDataForServer(
-              chand->server_name_.get(),
-              self->retry_throttle_data_.value().max_milli_tokens,
-              self->retry_throttle_data_.value().milli_token_ratio);
-    }
-    chand->service_config_ = std::move(self->service_config_);
-    // Apply service config to queued picks.
-    for (QueuedPick* pick = chand->queued_picks_; pick != nullptr;
-         pick = pick->next) {
-      CallData* calld = static_cast<CallData*>(pick->elem->call_data);
-      calld->MaybeApplyServiceConfigToCallLocked(pick->elem);
-    }
-    // Clean up.
-    GRPC_CHANNEL_STACK_UNREF(self->chand_->owning_stack_,
-                             "ServiceConfigSetter");
-    Delete(self);
-  }
-
-  ChannelData* chand_;
-  Optional<internal::ClientChannelGlobalParsedConfig::RetryThrottling>
-      retry_throttle_data_;
-  RefCountedPtr<ServiceConfig> service_config_;
-  grpc_closure closure_;
-};
-
 //
 // ChannelData::ExternalConnectivityWatcher::WatcherList
 //
@@ -1336,9 +1278,7 @@ class ChannelData::ClientChannelControlHelper
     }
     // Do update only if not shutting down.
     if (disconnect_error == GRPC_ERROR_NONE) {
-      // Will delete itself.
-      New<ConnectivityStateAndPickerSetter>(chand_, state, "helper",
-                                            std::move(picker));
+      chand_->UpdateStateAndPickerLocked(state, "helper", std::move(picker));
     }
   }
 
@@ -1387,12 +1327,26 @@ bool GetEnableRetries(const grpc_channel_args* args) {
       grpc_channel_args_find(args, GRPC_ARG_ENABLE_RETRIES), true);
 }
 
+grpc_combiner* CreateControlPlaneCombiner(const grpc_channel_args* args) {
+  return grpc_channel_arg_get_bool(
+             grpc_channel_args_find(args, GRPC_ARG_CONTROL_PLANE_EXECUTOR),
+             false)
+             ? grpc_combiner_create_control_plane()
+             : grpc_combiner_create();
+}
+
 size_t GetMaxPerRpcRetryBufferSize(const grpc_channel_args* args) {
   return static_cast<size_t>(grpc_channel_arg_get_integer(
       grpc_channel_args_find(args, GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE),
       {DEFAULT_PER_RPC_RETRY_BUFFER_SIZE, 0, INT_MAX}));
 }
 
+size_t GetMaxChannelRetryBufferSize(const grpc_channel_args* args) {
+  return static_cast<size_t>(grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args, GRPC_ARG_CHANNEL_RETRY_BUFFER_SIZE),
+      {DEFAULT_CHANNEL_RETRY_BUFFER_SIZE, 0, INT_MAX}));
+}
+
 RefCountedPtr<SubchannelPoolInterface> GetSubchannelPool(
     const grpc_channel_args* args) {
   const bool use_local_subchannel_pool = grpc_channel_arg_get_bool(
@@ -1415,15 +1369,18 @@ channelz::ChannelNode* GetChannelzNode(const grpc_channel_args* args) {
 ChannelData::ChannelData(grpc_channel_element_args* args, grpc_error** error)
     : deadline_checking_enabled_(
           grpc_deadline_checking_enabled(args->channel_args)),
+      deadline_coalescer_(
+          DeadlineCoalescer::CreateFromChannelArgs(args->channel_args)),
       enable_retries_(GetEnableRetries(args->channel_args)),
       per_rpc_retry_buffer_size_(
           GetMaxPerRpcRetryBufferSize(args->channel_args)),
+      channel_retry_buffer_size_(
+          GetMaxChannelRetryBufferSize(args->channel_args)),
       owning_stack_(args->channel_stack),
       client_channel_factory_(
           ClientChannelFactory::GetFromChannelArgs(args->channel_args)),
       channelz_node_(GetChannelzNode(args->channel_args)),
-      data_plane_combiner_(grpc_combiner_create()),
-      combiner_(grpc_combiner_create()),
+      combiner_(CreateControlPlaneCombiner(args->channel_args)),
       interested_parties_(grpc_pollset_set_create()),
       subchannel_pool_(GetSubchannelPool(args->channel_args)),
       disconnect_error_(GRPC_ERROR_NONE) {
@@ -1495,13 +1452,93 @@ ChannelData::~ChannelData() {
   // Stop backup polling.
   grpc_client_channel_stop_backup_polling(interested_parties_);
   grpc_pollset_set_destroy(interested_parties_);
-  GRPC_COMBINER_UNREF(data_plane_combiner_, "client_channel");
   GRPC_COMBINER_UNREF(combiner_, "client_channel");
   GRPC_ERROR_UNREF(disconnect_error_.Load(MemoryOrder::RELAXED));
   grpc_connectivity_state_destroy(&state_tracker_);
   gpr_mu_destroy(&info_mu_);
 }
 
+void ChannelData::UpdateStateAndPickerLocked(
+    grpc_connectivity_state state, const char* reason,
+    UniquePtr<LoadBalancingPolicy::SubchannelPicker> picker) {
+  // Clean the control plane when entering IDLE.
+  if (picker == nullptr) {
+    health_check_service_name_.reset();
+    saved_service_config_.reset();
+    received_first_resolver_result_ = false;
+  }
+  // Update connectivity state.
+  grpc_connectivity_state_set(&state_tracker_, state, reason);
+  if (channelz_node_ != nullptr) {
+    channelz_node_->SetConnectivityState(state);
+    channelz_node_->AddTraceEvent(
+        channelz::ChannelTrace::Severity::Info,
+        grpc_slice_from_static_string(
+            channelz::ChannelNode::GetChannelConnectivityStateChangeString(
+                state)));
+  }
+  // Grab the data plane mutex to do the subchannel updates and swap in the
+  // picker.  We keep the work done while holding it small: the refs that
+  // may be the last ones (to the subchannel wrappers in
+  // pending_subchannel_updates_, to the old picker, which refs subchannel
+  // wrappers too, and to the old service config data) are released once
+  // the mutex is released, still in the control plane combiner, which is
+  // where subchannel wrappers must be unreffed.
+  RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_to_unref;
+  RefCountedPtr<ServiceConfig> service_config_to_unref;
+  {
+    MutexLock lock(&data_plane_mu_);
+    // Handle subchannel updates.
+    for (auto& p : pending_subchannel_updates_) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p: updating subchannel wrapper %p data plane "
+                "connected_subchannel to %p",
+                this, p.first.get(), p.second.get());
+      }
+      p.first->set_connected_subchannel_in_data_plane(std::move(p.second));
+    }
+    // Swap out the picker.  The old one is destroyed when picker goes out
+    // of scope.
+    picker_.swap(picker);
+    // Clean the data plane if the updated picker is nullptr.
+    if (picker_ == nullptr) {
+      received_service_config_data_ = false;
+      retry_throttle_data_to_unref = std::move(retry_throttle_data_);
+      service_config_to_unref = std::move(service_config_);
+    }
+    // Re-process queued picks.
+    for (QueuedPick* pick = queued_picks_; pick != nullptr;
+         pick = pick->next) {
+      grpc_call_element* elem = pick->elem;
+      CallData* calld = static_cast<CallData*>(elem->call_data);
+      grpc_error* error = GRPC_ERROR_NONE;
+      if (calld->PickSubchannelLocked(elem, &error)) {
+        calld->AsyncPickDone(elem, error);
+      }
+    }
+  }
+  pending_subchannel_updates_.clear();
+}
+
+void ChannelData::UpdateServiceConfigLocked(
+    RefCountedPtr<ServerRetryThrottleData> retry_throttle_data,
+    RefCountedPtr<ServiceConfig> service_config) {
+  // The old values are unreffed when the arguments go out of scope, after
+  // the data plane mutex is released.
+  MutexLock lock(&data_plane_mu_);
+  received_service_config_data_ = true;
+  if (retry_throttle_data != nullptr) {
+    std::swap(retry_throttle_data_, retry_throttle_data);
+  }
+  std::swap(service_config_, service_config);
+  // Apply service config to queued picks.
+  for (QueuedPick* pick = queued_picks_; pick != nullptr; pick = pick->next) {
+    CallData* calld = static_cast<CallData*>(pick->elem->call_data);
+    calld->MaybeApplyServiceConfigToCallLocked(pick->elem);
+  }
+}
+
 void ChannelData::CreateResolvingLoadBalancingPolicyLocked() {
   // Instantiate resolving LB policy.
   LoadBalancingPolicy::Args lb_args;
@@ -1637,13 +1674,15 @@ bool ChannelData::ProcessResolverResultLocked(
             service_config->GetGlobalParsedConfig(
                 internal::ClientChannelServiceConfigParser::ParserIndex()));
   }
-  // Check if the config has changed.
+  // Check if the config has changed.  Resolvers hand back the same object
+  // for an unchanged config, which saves comparing the text.
   const bool service_config_changed =
-      ((service_config == nullptr) !=
-       (chand->saved_service_config_ == nullptr)) ||
-      (service_config != nullptr &&
-       strcmp(service_config->service_config_json(),
-              chand->saved_service_config_->service_config_json()) != 0);
+      service_config != chand->saved_service_config_ &&
+      (((service_config == nullptr) !=
+        (chand->saved_service_config_ == nullptr)) ||
+       (service_config != nullptr &&
+        strcmp(service_config->service_config_json(),
+               chand->saved_service_config_->service_config_json()) != 0));
   if (service_config_changed) {
     service_config_json.reset(gpr_strdup(
         service_config != nullptr ? service_config->service_config_json()
@@ -1668,15 +1707,17 @@ bool ChannelData::ProcessResolverResultLocked(
   // if we feel it is unnecessary.
   if (service_config_changed || !chand->received_first_resolver_result_) {
     chand->received_first_resolver_result_ = true;
-    Optional<internal::ClientChannelGlobalParsedConfig::RetryThrottling>
-        retry_throttle_data;
-    if (parsed_service_config != nullptr) {
-      retry_throttle_data = parsed_service_config->retry_throttling();
+    RefCountedPtr<ServerRetryThrottleData> retry_throttle_data;
+    if (parsed_service_config != nullptr &&
+        parsed_service_config->retry_throttling().has_value()) {
+      const auto& retry_throttling =
+          parsed_service_config->retry_throttling().value();
+      retry_throttle_data = internal::ServerRetryThrottleMap::GetDataForServer(
+          chand->server_name_.get(), retry_throttling.max_milli_tokens,
+          retry_throttling.milli_token_ratio);
     }
-    // Create service config setter to update channel state in the data
-    // plane combiner.  Destroys itself when done.
-    New<ServiceConfigSetter>(chand, retry_throttle_data,
-                             chand->saved_service_config_);
+    chand->UpdateServiceConfigLocked(std::move(retry_throttle_data),
+                                     chand->saved_service_config_);
   }
   UniquePtr<char> processed_lb_policy_name;
   chand->ProcessLbPolicy(result, parsed_service_config,
@@ -1698,8 +1739,11 @@ grpc_error* ChannelData::DoPingLocked(grpc_transport_op* op) {
   if (grpc_connectivity_state_check(&state_tracker_) != GRPC_CHANNEL_READY) {
     return GRPC_ERROR_CREATE_FROM_STATIC_STRING("channel not connected");
   }
-  LoadBalancingPolicy::PickResult result =
-      picker_->Pick(LoadBalancingPolicy::PickArgs());
+  LoadBalancingPolicy::PickResult result;
+  {
+    MutexLock lock(&data_plane_mu_);
+    result = picker_->Pick(LoadBalancingPolicy::PickArgs());
+  }
   ConnectedSubchannel* connected_subchannel = nullptr;
   if (result.subchannel != nullptr) {
     SubchannelWrapper* subchannel =
@@ -1760,8 +1804,8 @@ void ChannelData::StartTransportOpLocked(void* arg, grpc_error* ignored) {
         static_cast<grpc_connectivity_state>(value) == GRPC_CHANNEL_IDLE) {
       if (chand->disconnect_error() == GRPC_ERROR_NONE) {
         // Enter IDLE state.
-        New<ConnectivityStateAndPickerSetter>(chand, GRPC_CHANNEL_IDLE,
-                                              "channel entering IDLE", nullptr);
+        chand->UpdateStateAndPickerLocked(GRPC_CHANNEL_IDLE,
+                                          "channel entering IDLE", nullptr);
       }
       GRPC_ERROR_UNREF(op->disconnect_with_error);
     } else {
@@ -1770,8 +1814,8 @@ void ChannelData::StartTransportOpLocked(void* arg, grpc_error* ignored) {
                  GRPC_ERROR_NONE);
       chand->disconnect_error_.Store(op->disconnect_with_error,
                                      MemoryOrder::RELEASE);
-      New<ConnectivityStateAndPickerSetter>(
-          chand, GRPC_CHANNEL_SHUTDOWN, "shutdown from API",
+      chand->UpdateStateAndPickerLocked(
+          GRPC_CHANNEL_SHUTDOWN, "shutdown from API",
           UniquePtr<LoadBalancingPolicy::SubchannelPicker>(
               New<LoadBalancingPolicy::TransientFailurePicker>(
                   GRPC_ERROR_REF(op->disconnect_with_error))));
@@ -1913,7 +1957,8 @@ CallData::CallData(grpc_call_element* elem, const ChannelData& chand,
     : deadline_state_(elem, args.call_stack, args.call_combiner,
                       GPR_LIKELY(chand.deadline_checking_enabled())
                           ? args.deadline
-                          : GRPC_MILLIS_INF_FUTURE),
+                          : GRPC_MILLIS_INF_FUTURE,
+                      chand.deadline_coalescer()),
       path_(grpc_slice_ref_internal(args.path)),
       call_start_time_(args.start_time),
       deadline_(args.deadline),
@@ -1949,6 +1994,10 @@ void CallData::Destroy(grpc_call_element* elem,
                        const grpc_call_final_info* final_info,
                        grpc_closure* then_schedule_closure) {
   CallData* calld = static_cast<CallData*>(elem->call_data);
+  if (calld->bytes_charged_to_channel_ > 0) {
+    ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+    chand->ReleaseRetryBuffer(calld->bytes_charged_to_channel_);
+  }
   if (GPR_LIKELY(calld->subchannel_call_ != nullptr)) {
     calld->subchannel_call_->SetAfterCallStackDestroy(then_schedule_closure);
     then_schedule_closure = nullptr;
@@ -2010,8 +2059,8 @@ void CallData::StartTransportStreamOpBatch(
   // Add the batch to the pending list.
   calld->PendingBatchesAdd(elem, batch);
   // Check if we've already gotten a subchannel call.
-  // Note that once we have completed the pick, we do not need to enter
-  // the channel combiner, which is more efficient (especially for
+  // Note that once we have completed the pick, we do not need to acquire
+  // the channel's data plane mutex, which is more efficient (especially for
   // streaming calls).
   if (calld->subchannel_call_ != nullptr) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
@@ -2023,18 +2072,15 @@ void CallData::StartTransportStreamOpBatch(
     return;
   }
   // We do not yet have a subchannel call.
-  // For batches containing a send_initial_metadata op, enter the channel
-  // combiner to start a pick.
+  // For batches containing a send_initial_metadata op, acquire the
+  // channel's data plane mutex to pick a subchannel.
   if (GPR_LIKELY(batch->send_initial_metadata)) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
-      gpr_log(GPR_INFO, "chand=%p calld=%p: entering client_channel combiner",
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: grabbing data plane mutex to perform pick",
               chand, calld);
     }
-    GRPC_CLOSURE_SCHED(
-        GRPC_CLOSURE_INIT(
-            &batch->handler_private.closure, StartPickLocked, elem,
-            grpc_combiner_scheduler(chand->data_plane_combiner())),
-        GRPC_ERROR_NONE);
+    PickSubchannel(elem, GRPC_ERROR_NONE);
   } else {
     // For all other batches, release the call combiner.
     if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
@@ -2217,25 +2263,34 @@ void CallData::PendingBatchesAdd(grpc_call_element* elem,
     // Also check if the batch takes us over the retry buffer limit.
     // Note: We don't check the size of trailing metadata here, because
     // gRPC clients do not send trailing metadata.
+    size_t bytes = 0;
     if (batch->send_initial_metadata) {
       pending_send_initial_metadata_ = true;
-      bytes_buffered_for_retry_ += grpc_metadata_batch_size(
+      bytes += grpc_metadata_batch_size(
           batch->payload->send_initial_metadata.send_initial_metadata);
     }
     if (batch->send_message) {
       pending_send_message_ = true;
-      bytes_buffered_for_retry_ +=
-          batch->payload->send_message.send_message->length();
+      bytes += batch->payload->send_message.send_message->length();
     }
     if (batch->send_trailing_metadata) {
       pending_send_trailing_metadata_ = true;
     }
+    bytes_buffered_for_retry_ += bytes;
+    // Once committed, the cached data is freed as soon as it has been
+    // sent, so it no longer counts against the channel's budget.
+    bool channel_budget_exceeded = false;
+    if (!retry_committed_ && bytes > 0) {
+      bytes_charged_to_channel_ += bytes;
+      channel_budget_exceeded = !chand->ChargeRetryBuffer(bytes);
+    }
     if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
-                     chand->per_rpc_retry_buffer_size())) {
+                         chand->per_rpc_retry_buffer_size() ||
+                     channel_budget_exceeded)) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
         gpr_log(GPR_INFO,
-                "chand=%p calld=%p: exceeded retry buffer size, committing",
-                chand, this);
+                "chand=%p calld=%p: exceeded %s retry buffer size, committing",
+                chand, this, channel_budget_exceeded ? "channel" : "per-RPC");
       }
       SubchannelCallRetryState* retry_state =
           subchannel_call_ == nullptr ? nullptr
@@ -2425,6 +2480,9 @@ void CallData::RetryCommit(grpc_call_element* elem,
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: committing retries", chand, this);
   }
+  chand->ReleaseRetryBuffer(bytes_charged_to_channel_);
+  bytes_charged_to_channel_ = 0;
+  CancelHedgingTimer();
   if (retry_state != nullptr) {
     FreeCachedSendOpDataAfterCommit(elem, retry_state);
   }
@@ -2439,11 +2497,16 @@ void CallData::DoRetry(grpc_call_element* elem,
   GPR_ASSERT(retry_policy != nullptr);
   // Reset subchannel call.
   subchannel_call_.reset();
+  CancelHedgingTimer();
   // Compute backoff delay.
   grpc_millis next_attempt_time;
   if (server_pushback_ms >= 0) {
     next_attempt_time = ExecCtx::Get()->Now() + server_pushback_ms;
     last_attempt_got_server_pushback_ = true;
+  } else if (retry_policy->hedging_delay > 0) {
+    // With a hedging policy, a non-fatal status is followed by the next
+    // attempt right away.
+    next_attempt_time = ExecCtx::Get()->Now();
   } else {
     if (num_attempts_completed_ == 1 || last_attempt_got_server_pushback_) {
       retry_backoff_.Init(
@@ -2462,8 +2525,8 @@ void CallData::DoRetry(grpc_call_element* elem,
             this, next_attempt_time - ExecCtx::Get()->Now());
   }
   // Schedule retry after computed delay.
-  GRPC_CLOSURE_INIT(&pick_closure_, StartPickLocked, elem,
-                    grpc_combiner_scheduler(chand->data_plane_combiner()));
+  GRPC_CLOSURE_INIT(&pick_closure_, PickSubchannel, elem,
+                    grpc_schedule_on_exec_ctx);
   grpc_timer_init(&retry_timer_, next_attempt_time, &pick_closure_);
   // Update bookkeeping.
   if (retry_state != nullptr) retry_state->retry_dispatched = true;
@@ -2576,6 +2639,148 @@ bool CallData::MaybeRetry(grpc_call_element* elem,
   return true;
 }
 
+//
+// hedging
+//
+
+// Hedging reuses the retry code above: the hedging policy is parsed into a
+// RetryPolicy with a hedging delay, its nonFatalStatusCodes are treated as
+// retryable, and the send ops are cached and replayed the same way.  When
+// an attempt has not received anything from the server after the hedging
+// delay, it is cancelled and the next attempt is started on a new pick.
+// Only one attempt runs at a time, since this filter (and the LB policy
+// callbacks) track a single subchannel call.
+
+void CallData::MaybeStartHedgingTimer(grpc_call_element* elem) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  if (method_params_ == nullptr) return;
+  const auto* retry_policy = method_params_->retry_policy();
+  if (retry_policy == nullptr || retry_policy->hedging_delay == 0) return;
+  if (retry_committed_ ||
+      num_attempts_completed_ + 1 >= retry_policy->max_attempts) {
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: starting next attempt in %" PRId64
+            " ms unless subchannel_call=%p hears from the server",
+            chand, this, retry_policy->hedging_delay, subchannel_call_.get());
+  }
+  hedging_timer_ = arena_->New<HedgingTimer>();
+  hedging_timer_->elem = elem;
+  GRPC_CALL_STACK_REF(owning_call_, "hedging_timer");
+  GRPC_CLOSURE_INIT(&hedging_timer_->on_timer, OnHedgingTimer, hedging_timer_,
+                    grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&hedging_timer_->timer,
+                  ExecCtx::Get()->Now() + retry_policy->hedging_delay,
+                  &hedging_timer_->on_timer);
+}
+
+void CallData::CancelHedgingTimer() {
+  if (hedging_timer_ != nullptr) {
+    grpc_timer_cancel(&hedging_timer_->timer);
+    hedging_timer_ = nullptr;
+  }
+}
+
+void CallData::OnHedgingTimer(void* arg, grpc_error* error) {
+  HedgingTimer* timer = static_cast<HedgingTimer*>(arg);
+  CallData* calld = static_cast<CallData*>(timer->elem->call_data);
+  if (error == GRPC_ERROR_CANCELLED) {
+    GRPC_CALL_STACK_UNREF(calld->owning_call_, "hedging_timer");
+    return;
+  }
+  GRPC_CLOSURE_INIT(&timer->start_hedged_attempt,
+                    StartHedgedAttemptInCallCombiner, timer,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CALL_COMBINER_START(calld->call_combiner_, &timer->start_hedged_attempt,
+                           GRPC_ERROR_NONE, "hedging delay elapsed");
+}
+
+void CallData::StartHedgedAttemptInCallCombiner(void* arg, grpc_error* error) {
+  HedgingTimer* timer = static_cast<HedgingTimer*>(arg);
+  grpc_call_element* elem = timer->elem;
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  // The attempt may have ended, or the call been committed, between the
+  // timer firing and our getting the call combiner.  We also leave alone an
+  // attempt that has not started recv_trailing_metadata yet, since nothing
+  // would then see it finish (and report that to the LB policy).
+  bool hedge = calld->hedging_timer_ == timer &&
+               calld->subchannel_call_ != nullptr &&
+               calld->cancel_error_ == GRPC_ERROR_NONE &&
+               static_cast<SubchannelCallRetryState*>(
+                   calld->subchannel_call_->GetParentData())
+                   ->started_recv_trailing_metadata;
+  if (hedge) {
+    calld->hedging_timer_ = nullptr;
+    // Hedged attempts are throttled the same way as retries.
+    if (calld->retry_throttle_data_ != nullptr &&
+        !calld->retry_throttle_data_->RecordFailure()) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
+        gpr_log(GPR_INFO, "chand=%p calld=%p: hedging throttled", chand,
+                calld);
+      }
+      hedge = false;
+    }
+  }
+  if (!hedge) {
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
+                            "hedged attempt not needed");
+    GRPC_CALL_STACK_UNREF(calld->owning_call_, "hedging_timer");
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: hedging delay elapsed, cancelling "
+            "subchannel_call=%p and starting next attempt",
+            chand, calld, calld->subchannel_call_.get());
+  }
+  ++calld->num_attempts_completed_;
+  RefCountedPtr<SubchannelCall> subchannel_call =
+      std::move(calld->subchannel_call_);
+  SubchannelCallRetryState* retry_state =
+      static_cast<SubchannelCallRetryState*>(
+          subchannel_call->GetParentData());
+  retry_state->retry_dispatched = true;
+  // The superseded call is allocated on our arena, so hold a ref to the
+  // call stack until it is destroyed.
+  GRPC_CALL_STACK_REF(calld->owning_call_, "superseded_subchannel_call");
+  GRPC_CLOSURE_INIT(&timer->on_superseded_call_destroyed,
+                    OnSupersededCallDestroyed, timer,
+                    grpc_schedule_on_exec_ctx);
+  subchannel_call->SetAfterCallStackDestroy(
+      &timer->on_superseded_call_destroyed);
+  // Start the next attempt once the cancellation below yields the call
+  // combiner.
+  GRPC_CLOSURE_INIT(&calld->pick_closure_, PickSubchannel, elem,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CALL_COMBINER_START(calld->call_combiner_, &calld->pick_closure_,
+                           GRPC_ERROR_NONE, "starting hedged attempt");
+  grpc_transport_stream_op_batch* batch = grpc_make_transport_stream_op(
+      GRPC_CLOSURE_INIT(&timer->on_cancel_complete,
+                        OnHedgedAttemptCancelComplete, timer,
+                        grpc_schedule_on_exec_ctx));
+  batch->cancel_stream = true;
+  batch->payload->cancel_stream.cancel_error = grpc_error_set_int(
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Superseded by hedged attempt"),
+      GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED);
+  // Note: This will release the call combiner.
+  subchannel_call->StartTransportStreamOpBatch(batch);
+}
+
+void CallData::OnHedgedAttemptCancelComplete(void* arg, grpc_error* error) {
+  HedgingTimer* timer = static_cast<HedgingTimer*>(arg);
+  CallData* calld = static_cast<CallData*>(timer->elem->call_data);
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "hedging_timer");
+}
+
+void CallData::OnSupersededCallDestroyed(void* arg, grpc_error* error) {
+  HedgingTimer* timer = static_cast<HedgingTimer*>(arg);
+  CallData* calld = static_cast<CallData*>(timer->elem->call_data);
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "superseded_subchannel_call");
+}
+
 //
 // CallData::SubchannelCallBatchData
 //
@@ -2978,6 +3183,13 @@ void CallData::RecvTrailingMetadataReady(void* arg, grpc_error* error) {
   grpc_mdelem* server_pushback_md = nullptr;
   grpc_metadata_batch* md_batch =
       batch_data->batch.payload->recv_trailing_metadata.recv_trailing_metadata;
+  // Invoke the callback of the LB policy that picked this attempt.
+  if (retry_state->lb_recv_trailing_metadata_ready != nullptr) {
+    Metadata trailing_metadata(calld, md_batch);
+    retry_state->lb_recv_trailing_metadata_ready(
+        retry_state->lb_recv_trailing_metadata_ready_user_data, error,
+        &trailing_metadata, &calld->lb_call_state_);
+  }
   calld->GetCallStatus(elem, md_batch, GRPC_ERROR_REF(error), &status,
                        &server_pushback_md);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
@@ -3098,8 +3310,9 @@ void CallData::OnComplete(void* arg, grpc_error* error) {
     retry_state->completed_send_trailing_metadata = true;
   }
   // If the call is committed, free cached data for send ops that we've just
-  // completed.
-  if (calld->retry_committed_) {
+  // completed.  An attempt superseded by a hedged one is never the one the
+  // call is committed to, so its batches must leave the cache alone.
+  if (calld->retry_committed_ && !retry_state->retry_dispatched) {
     calld->FreeCachedSendOpDataForCompletedBatch(elem, batch_data, retry_state);
   }
   // Construct list of closures to execute.
@@ -3293,8 +3506,7 @@ void CallData::AddRetriableRecvTrailingMetadataOp(
   batch_data->batch.payload->recv_trailing_metadata
       .recv_trailing_metadata_ready =
       &retry_state->recv_trailing_metadata_ready;
-  MaybeInjectRecvTrailingMetadataReadyForLoadBalancingPolicy(
-      &batch_data->batch);
+  // The LB policy's callback is invoked from RecvTrailingMetadataReady().
 }
 
 void CallData::StartInternalRecvTrailingMetadata(grpc_call_element* elem) {
@@ -3571,8 +3783,14 @@ void CallData::CreateSubchannelCall(grpc_call_element* elem) {
     PendingBatchesFail(elem, error, YieldCallCombiner);
   } else {
     if (parent_data_size > 0) {
-      new (subchannel_call_->GetParentData())
-          SubchannelCallRetryState(call_context_);
+      SubchannelCallRetryState* retry_state =
+          new (subchannel_call_->GetParentData())
+              SubchannelCallRetryState(call_context_);
+      retry_state->lb_recv_trailing_metadata_ready =
+          lb_recv_trailing_metadata_ready_;
+      retry_state->lb_recv_trailing_metadata_ready_user_data =
+          lb_recv_trailing_metadata_ready_user_data_;
+      MaybeStartHedgingTimer(elem);
     }
     PendingBatchesResume(elem);
   }
@@ -3594,16 +3812,20 @@ void CallData::PickDone(void* arg, grpc_error* error) {
   calld->CreateSubchannelCall(elem);
 }
 
+void CallData::AsyncPickDone(grpc_call_element* elem, grpc_error* error) {
+  GRPC_CLOSURE_INIT(&pick_closure_, PickDone, elem, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_SCHED(&pick_closure_, error);
+}
+
 // A class to handle the call combiner cancellation callback for a
 // queued pick.
 class CallData::QueuedPickCanceller {
  public:
   explicit QueuedPickCanceller(grpc_call_element* elem) : elem_(elem) {
     auto* calld = static_cast<CallData*>(elem->call_data);
-    auto* chand = static_cast<ChannelData*>(elem->channel_data);
     GRPC_CALL_STACK_REF(calld->owning_call_, "QueuedPickCanceller");
     GRPC_CLOSURE_INIT(&closure_, &CancelLocked, this,
-                      grpc_combiner_scheduler(chand->data_plane_combiner()));
+                      grpc_schedule_on_exec_ctx);
     calld->call_combiner_->SetNotifyOnCancel(&closure_);
   }
 
@@ -3612,19 +3834,22 @@ class CallData::QueuedPickCanceller {
     auto* self = static_cast<QueuedPickCanceller*>(arg);
     auto* chand = static_cast<ChannelData*>(self->elem_->channel_data);
     auto* calld = static_cast<CallData*>(self->elem_->call_data);
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
-      gpr_log(GPR_INFO,
-              "chand=%p calld=%p: cancelling queued pick: "
-              "error=%s self=%p calld->pick_canceller=%p",
-              chand, calld, grpc_error_string(error), self,
-              calld->pick_canceller_);
-    }
-    if (calld->pick_canceller_ == self && error != GRPC_ERROR_NONE) {
-      // Remove pick from list of queued picks.
-      calld->RemoveCallFromQueuedPicksLocked(self->elem_);
-      // Fail pending batches on the call.
-      calld->PendingBatchesFail(self->elem_, GRPC_ERROR_REF(error),
-                                YieldCallCombinerIfPendingBatchesFound);
+    {
+      MutexLock lock(chand->data_plane_mu());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p: cancelling queued pick: "
+                "error=%s self=%p calld->pick_canceller=%p",
+                chand, calld, grpc_error_string(error), self,
+                calld->pick_canceller_);
+      }
+      if (calld->pick_canceller_ == self && error != GRPC_ERROR_NONE) {
+        // Remove pick from list of queued picks.
+        calld->RemoveCallFromQueuedPicksLocked(self->elem_);
+        // Fail pending batches on the call.
+        calld->PendingBatchesFail(self->elem_, GRPC_ERROR_REF(error),
+                                  YieldCallCombinerIfPendingBatchesFound);
+      }
     }
     GRPC_CALL_STACK_UNREF(calld->owning_call_, "QueuedPickCanceller");
     Delete(self);
@@ -3736,23 +3961,38 @@ const char* PickResultTypeName(
   GPR_UNREACHABLE_CODE(return "UNKNOWN");
 }
 
-void CallData::StartPickLocked(void* arg, grpc_error* error) {
+void CallData::PickSubchannel(void* arg, grpc_error* ignored) {
   grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
   CallData* calld = static_cast<CallData*>(elem->call_data);
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
-  GPR_ASSERT(calld->connected_subchannel_ == nullptr);
-  GPR_ASSERT(calld->subchannel_call_ == nullptr);
+  grpc_error* error = GRPC_ERROR_NONE;
+  bool pick_complete;
+  {
+    MutexLock lock(chand->data_plane_mu());
+    pick_complete = calld->PickSubchannelLocked(elem, &error);
+  }
+  if (pick_complete) {
+    PickDone(elem, error);
+    GRPC_ERROR_UNREF(error);
+  }
+}
+
+bool CallData::PickSubchannelLocked(grpc_call_element* elem,
+                                    grpc_error** error) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  GPR_ASSERT(connected_subchannel_ == nullptr);
+  GPR_ASSERT(subchannel_call_ == nullptr);
   // picker's being null means the channel is currently in IDLE state. The
   // incoming call will make the channel exit IDLE and queue itself.
   if (chand->picker() == nullptr) {
     // We are currently in the data plane.
     // Bounce into the control plane to exit IDLE.
     chand->CheckConnectivityState(true);
-    calld->AddCallToQueuedPicksLocked(elem);
-    return;
+    if (!pick_queued_) AddCallToQueuedPicksLocked(elem);
+    return false;
   }
   // Apply service config to call if needed.
-  calld->MaybeApplyServiceConfigToCallLocked(elem);
+  MaybeApplyServiceConfigToCallLocked(elem);
   // If this is a retry, use the send_initial_metadata payload that
   // we've cached; otherwise, use the pending batch.  The
   // send_initial_metadata batch will be the first pending batch in the
@@ -3764,31 +4004,27 @@ void CallData::StartPickLocked(void* arg, grpc_error* error) {
   // subchannel's copy of the metadata batch (which is copied for each
   // attempt) to the LB policy instead the one from the parent channel.
   LoadBalancingPolicy::PickArgs pick_args;
-  pick_args.call_state = &calld->lb_call_state_;
+  pick_args.call_state = &lb_call_state_;
   Metadata initial_metadata(
-      calld,
-      calld->seen_send_initial_metadata_
-          ? &calld->send_initial_metadata_
-          : calld->pending_batches_[0]
+      this,
+      seen_send_initial_metadata_
+          ? &send_initial_metadata_
+          : pending_batches_[0]
                 .batch->payload->send_initial_metadata.send_initial_metadata);
   pick_args.initial_metadata = &initial_metadata;
   // Grab initial metadata flags so that we can check later if the call has
   // wait_for_ready enabled.
   const uint32_t send_initial_metadata_flags =
-      calld->seen_send_initial_metadata_
-          ? calld->send_initial_metadata_flags_
-          : calld->pending_batches_[0]
-                .batch->payload->send_initial_metadata
-                .send_initial_metadata_flags;
-  // When done, we schedule this closure to leave the data plane combiner.
-  GRPC_CLOSURE_INIT(&calld->pick_closure_, PickDone, elem,
-                    grpc_schedule_on_exec_ctx);
+      seen_send_initial_metadata_ ? send_initial_metadata_flags_
+                                  : pending_batches_[0]
+                                        .batch->payload->send_initial_metadata
+                                        .send_initial_metadata_flags;
   // Attempt pick.
   auto result = chand->picker()->Pick(pick_args);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
     gpr_log(GPR_INFO,
             "chand=%p calld=%p: LB pick returned %s (subchannel=%p, error=%s)",
-            chand, calld, PickResultTypeName(result.type),
+            chand, this, PickResultTypeName(result.type),
             result.subchannel.get(), grpc_error_string(result.error));
   }
   switch (result.type) {
@@ -3797,9 +4033,9 @@ void CallData::StartPickLocked(void* arg, grpc_error* error) {
       grpc_error* disconnect_error = chand->disconnect_error();
       if (disconnect_error != GRPC_ERROR_NONE) {
         GRPC_ERROR_UNREF(result.error);
-        GRPC_CLOSURE_SCHED(&calld->pick_closure_,
-                           GRPC_ERROR_REF(disconnect_error));
-        break;
+        if (pick_queued_) RemoveCallFromQueuedPicksLocked(elem);
+        *error = GRPC_ERROR_REF(disconnect_error);
+        return true;
       }
       // If wait_for_ready is false, then the error indicates the RPC
       // attempt's final status.
@@ -3807,19 +4043,18 @@ void CallData::StartPickLocked(void* arg, grpc_error* error) {
            GRPC_INITIAL_METADATA_WAIT_FOR_READY) == 0) {
         // Retry if appropriate; otherwise, fail.
         grpc_status_code status = GRPC_STATUS_OK;
-        grpc_error_get_status(result.error, calld->deadline_, &status, nullptr,
+        grpc_error_get_status(result.error, deadline_, &status, nullptr,
                               nullptr, nullptr);
-        if (!calld->enable_retries_ ||
-            !calld->MaybeRetry(elem, nullptr /* batch_data */, status,
-                               nullptr /* server_pushback_md */)) {
-          grpc_error* new_error =
-              GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
-                  "Failed to pick subchannel", &result.error, 1);
-          GRPC_ERROR_UNREF(result.error);
-          GRPC_CLOSURE_SCHED(&calld->pick_closure_, new_error);
+        const bool retried = enable_retries_ &&
+                             MaybeRetry(elem, nullptr /* batch_data */, status,
+                                        nullptr /* server_pushback_md */);
+        if (!retried) {
+          *error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+              "Failed to pick subchannel", &result.error, 1);
         }
-        if (calld->pick_queued_) calld->RemoveCallFromQueuedPicksLocked(elem);
-        break;
+        GRPC_ERROR_UNREF(result.error);
+        if (pick_queued_) RemoveCallFromQueuedPicksLocked(elem);
+        return !retried;
       }
       // If wait_for_ready is true, then queue to retry when we get a new
       // picker.
@@ -3827,8 +4062,8 @@ void CallData::StartPickLocked(void* arg, grpc_error* error) {
     }
     // Fallthrough
     case LoadBalancingPolicy::PickResult::PICK_QUEUE:
-      if (!calld->pick_queued_) calld->AddCallToQueuedPicksLocked(elem);
-      break;
+      if (!pick_queued_) AddCallToQueuedPicksLocked(elem);
+      return false;
     default:  // PICK_COMPLETE
       // Handle drops.
       if (GPR_UNLIKELY(result.subchannel == nullptr)) {
@@ -3836,17 +4071,17 @@ void CallData::StartPickLocked(void* arg, grpc_error* error) {
             "Call dropped by load balancing policy");
       } else {
         // Grab a ref to the connected subchannel while we're still
-        // holding the data plane combiner.
-        calld->connected_subchannel_ =
+        // holding the data plane mutex.
+        connected_subchannel_ =
             chand->GetConnectedSubchannelInDataPlane(result.subchannel.get());
-        GPR_ASSERT(calld->connected_subchannel_ != nullptr);
+        GPR_ASSERT(connected_subchannel_ != nullptr);
       }
-      calld->lb_recv_trailing_metadata_ready_ =
-          result.recv_trailing_metadata_ready;
-      calld->lb_recv_trailing_metadata_ready_user_data_ =
+      lb_recv_trailing_metadata_ready_ = result.recv_trailing_metadata_ready;
+      lb_recv_trailing_metadata_ready_user_data_ =
           result.recv_trailing_metadata_ready_user_data;
-      GRPC_CLOSURE_SCHED(&calld->pick_closure_, result.error);
-      if (calld->pick_queued_) calld->RemoveCallFromQueuedPicksLocked(elem);
+      *error = result.error;
+      if (pick_queued_) RemoveCallFromQueuedPicksLocked(elem);
+      return true;
   }
 }
 
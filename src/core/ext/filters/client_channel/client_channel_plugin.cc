@@ -27,6 +27,7 @@
 #include "src/core/ext/filters/client_channel/backup_poller.h"
 #include "src/core/ext/filters/client_channel/client_channel.h"
 #include "src/core/ext/filters/client_channel/client_channel_channelz.h"
+#include "src/core/ext/filters/client_channel/direct_channel.h"
 #include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
 #include "src/core/ext/filters/client_channel/http_connect_handshaker.h"
 #include "src/core/ext/filters/client_channel/http_proxy.h"
@@ -37,9 +38,15 @@
 #include "src/core/ext/filters/client_channel/retry_throttle.h"
 #include "src/core/lib/surface/channel_init.h"
 
-static bool append_filter(grpc_channel_stack_builder* builder, void* arg) {
-  return grpc_channel_stack_builder_append_filter(
-      builder, static_cast<const grpc_channel_filter*>(arg), nullptr, nullptr);
+static bool append_client_channel_filter(grpc_channel_stack_builder* builder,
+                                         void* arg) {
+  const grpc_channel_filter* filter =
+      grpc_direct_channel_enabled(
+          grpc_channel_stack_builder_get_channel_arguments(builder))
+          ? &grpc_direct_channel_filter
+          : &grpc_client_channel_filter;
+  return grpc_channel_stack_builder_append_filter(builder, filter, nullptr,
+                                                  nullptr);
 }
 
 void grpc_client_channel_init(void) {
@@ -52,8 +59,8 @@ void grpc_client_channel_init(void) {
   grpc_register_http_proxy_mapper();
   grpc_core::GlobalSubchannelPool::Init();
   grpc_channel_init_register_stage(
-      GRPC_CLIENT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY, append_filter,
-      (void*)&grpc_client_channel_filter);
+      GRPC_CLIENT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      append_client_channel_filter, nullptr);
   grpc_http_connect_register_handshaker_factory();
   grpc_client_channel_global_init_backup_polling();
 }
@@ -0,0 +1,1036 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/direct_channel.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/backup_poller.h"
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/client_channel_factory.h"
+#include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/local_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/parse_address.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/ext/filters/deadline/deadline_filter.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/polling_entity.h"
+#include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/connectivity_state.h"
+#include "src/core/lib/uri/uri_parser.h"
+
+// Max number of batches that can be pending on a call at any given time:
+// one for each of the six kinds of op other than cancel_stream.
+#define MAX_PENDING_BATCHES 6
+
+namespace grpc_core {
+
+namespace {
+
+//
+// ChannelData definition
+//
+
+class ChannelData {
+ public:
+  struct QueuedCall {
+    grpc_call_element* elem;
+    QueuedCall* next = nullptr;
+  };
+
+  static grpc_error* Init(grpc_channel_element* elem,
+                          grpc_channel_element_args* args);
+  static void Destroy(grpc_channel_element* elem);
+  static void StartTransportOp(grpc_channel_element* elem,
+                               grpc_transport_op* op);
+  static void GetChannelInfo(grpc_channel_element* elem,
+                             const grpc_channel_info* info);
+
+  bool deadline_checking_enabled() const { return deadline_checking_enabled_; }
+  DeadlineCoalescer* deadline_coalescer() const {
+    return deadline_coalescer_.get();
+  }
+  Mutex* mu() const { return &mu_; }
+
+  // The following require holding mu().
+  grpc_connectivity_state state() const { return state_; }
+  grpc_error* disconnect_error() const { return disconnect_error_; }
+  const RefCountedPtr<ConnectedSubchannel>& connected_subchannel() const {
+    return connected_subchannel_;
+  }
+  void AddQueuedCall(QueuedCall* call, grpc_polling_entity* pollent);
+  void RemoveQueuedCall(QueuedCall* to_remove, grpc_polling_entity* pollent);
+
+  // Starts connecting the first time it is called.
+  void ConnectLocked();
+
+  grpc_connectivity_state CheckConnectivityState(bool try_to_connect);
+  void AddExternalConnectivityWatcher(grpc_polling_entity pollent,
+                                      grpc_connectivity_state* state,
+                                      grpc_closure* on_complete,
+                                      grpc_closure* watcher_timer_init);
+  int NumExternalConnectivityWatchers() const;
+
+ private:
+  class SubchannelWatcher;
+  class ExternalConnectivityWatcher;
+
+  ChannelData(grpc_channel_element_args* args, grpc_error** error);
+  ~ChannelData();
+
+  static void StartConnectingInCombiner(void* arg, grpc_error* ignored);
+  static void StartTransportOpInCombiner(void* arg, grpc_error* ignored);
+
+  void OnSubchannelStateChangeInCombiner(
+      grpc_connectivity_state state,
+      RefCountedPtr<ConnectedSubchannel> connected_subchannel);
+  void UpdateStateLocked(
+      grpc_connectivity_state state,
+      RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+      const char* reason);
+  void CancelWatchInCombiner();
+
+  const bool deadline_checking_enabled_;
+  const RefCountedPtr<DeadlineCoalescer> deadline_coalescer_;
+  grpc_channel_stack* owning_stack_;
+  grpc_combiner* combiner_;
+  grpc_pollset_set* interested_parties_;
+  Subchannel* subchannel_ = nullptr;
+
+  //
+  // Fields used in the combiner.
+  //
+  bool watching_ = false;
+  SubchannelWatcher* watcher_ = nullptr;
+
+  //
+  // Fields guarded by mu_, which is taken on the data plane only to pick up
+  // the connected subchannel or queue the call.
+  //
+  mutable Mutex mu_;
+  bool connect_requested_ = false;
+  grpc_connectivity_state state_ = GRPC_CHANNEL_IDLE;
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
+  grpc_error* disconnect_error_ = GRPC_ERROR_NONE;
+  QueuedCall* queued_calls_ = nullptr;
+  ExternalConnectivityWatcher* external_watchers_ = nullptr;
+  grpc_connectivity_state_tracker state_tracker_;
+  grpc_closure start_connecting_closure_;
+};
+
+//
+// CallData definition
+//
+
+class CallData {
+ public:
+  static grpc_error* Init(grpc_call_element* elem,
+                          const grpc_call_element_args* args);
+  static void Destroy(grpc_call_element* elem,
+                      const grpc_call_final_info* final_info,
+                      grpc_closure* then_schedule_closure);
+  static void StartTransportStreamOpBatch(
+      grpc_call_element* elem, grpc_transport_stream_op_batch* batch);
+  static void SetPollent(grpc_call_element* elem, grpc_polling_entity* pollent);
+
+  // Called with the channel's mutex held, when the call is starting or is
+  // queued and the channel's state changed. Returns true if the call is done
+  // waiting for the channel, with *error set if it is to fail; the caller must
+  // then invoke AsyncPickDone() or PickDone().
+  bool PickLocked(grpc_call_element* elem, grpc_error** error);
+  void AsyncPickDone(grpc_call_element* elem, grpc_error* error);
+
+ private:
+  class QueuedCallCanceller;
+
+  CallData(grpc_call_element* elem, const ChannelData& chand,
+           const grpc_call_element_args& args);
+  ~CallData();
+
+  static size_t GetBatchIndex(grpc_transport_stream_op_batch* batch);
+  void PendingBatchesAdd(grpc_transport_stream_op_batch* batch);
+  static void FailPendingBatchInCallCombiner(void* arg, grpc_error* error);
+  // Fails all pending batches. Yields the call combiner if yield_call_combiner
+  // is true, or if there were pending batches and only_if_batches_found is
+  // true.
+  void PendingBatchesFail(grpc_error* error, bool yield_call_combiner,
+                          bool only_if_batches_found = false);
+  static void ResumePendingBatchInCallCombiner(void* arg, grpc_error* ignored);
+  void PendingBatchesResume();
+
+  static void Pick(grpc_call_element* elem);
+  static void PickDone(void* arg, grpc_error* error);
+  void CreateSubchannelCall();
+
+  void AddCallToQueueLocked(grpc_call_element* elem);
+  void RemoveCallFromQueueLocked(grpc_call_element* elem);
+
+  // State for handling deadlines.
+  // The code in deadline_filter.c requires this to be the first field.
+  grpc_deadline_state deadline_state_;
+
+  grpc_slice path_;  // Request path.
+  gpr_timespec call_start_time_;
+  grpc_millis deadline_;
+  Arena* arena_;
+  grpc_call_stack* owning_call_;
+  CallCombiner* call_combiner_;
+  grpc_call_context_element* call_context_;
+
+  grpc_polling_entity* pollent_ = nullptr;
+  grpc_closure pick_closure_;
+
+  // Accessed while holding the channel's mutex.
+  ChannelData::QueuedCall queued_call_;
+  bool queued_ = false;
+  QueuedCallCanceller* canceller_ = nullptr;
+
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
+  RefCountedPtr<SubchannelCall> subchannel_call_;
+
+  // Batches are added to this list when received from above.
+  // They are removed when we are done handling the batch (i.e., when
+  // either we have invoked all of the batch's callbacks or we have
+  // passed the batch down to the subchannel call and are not
+  // intercepting any of its callbacks).
+  grpc_transport_stream_op_batch* pending_batches_[MAX_PENDING_BATCHES] = {};
+
+  // Set when we get a cancel_stream op.
+  grpc_error* cancel_error_ = GRPC_ERROR_NONE;
+};
+
+//
+// ChannelData::SubchannelWatcher
+//
+
+// Delivers the subchannel's state changes to the channel's combiner. It is
+// owned by the subchannel, and only reads chand_ from there: a state change
+// takes a ref to the channel stack until it has been applied.
+class ChannelData::SubchannelWatcher
+    : public Subchannel::ConnectivityStateWatcherInterface {
+ public:
+  explicit SubchannelWatcher(ChannelData* chand) : chand_(chand) {}
+
+  void Orphan() override { Unref(); }
+
+  void OnConnectivityStateChange(
+      grpc_connectivity_state new_state,
+      RefCountedPtr<ConnectedSubchannel> connected_subchannel) override {
+    // Will delete itself.
+    New<Updater>(chand_, new_state, std::move(connected_subchannel));
+  }
+
+  grpc_pollset_set* interested_parties() override {
+    return chand_->interested_parties_;
+  }
+
+ private:
+  class Updater {
+   public:
+    Updater(ChannelData* chand, grpc_connectivity_state new_state,
+            RefCountedPtr<ConnectedSubchannel> connected_subchannel)
+        : chand_(chand),
+          state_(new_state),
+          connected_subchannel_(std::move(connected_subchannel)) {
+      GRPC_CHANNEL_STACK_REF(chand_->owning_stack_, "SubchannelWatcher");
+      GRPC_CLOSURE_INIT(&closure_, ApplyUpdateInCombiner, this,
+                        grpc_combiner_scheduler(chand_->combiner_));
+      GRPC_CLOSURE_SCHED(&closure_, GRPC_ERROR_NONE);
+    }
+
+   private:
+    static void ApplyUpdateInCombiner(void* arg, grpc_error* error) {
+      Updater* self = static_cast<Updater*>(arg);
+      ChannelData* chand = self->chand_;
+      chand->OnSubchannelStateChangeInCombiner(
+          self->state_, std::move(self->connected_subchannel_));
+      Delete(self);
+      GRPC_CHANNEL_STACK_UNREF(chand->owning_stack_, "SubchannelWatcher");
+    }
+
+    ChannelData* chand_;
+    grpc_connectivity_state state_;
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
+    grpc_closure closure_;
+  };
+
+  ChannelData* chand_;
+};
+
+//
+// ChannelData::ExternalConnectivityWatcher
+//
+
+// Implements grpc_channel_watch_connectivity_state() as the client channel
+// does, on the channel's state tracker.
+class ChannelData::ExternalConnectivityWatcher {
+ public:
+  ExternalConnectivityWatcher(ChannelData* chand, grpc_polling_entity pollent,
+                              grpc_connectivity_state* state,
+                              grpc_closure* on_complete,
+                              grpc_closure* watcher_timer_init)
+      : chand_(chand),
+        pollent_(pollent),
+        state_(state),
+        on_complete_(on_complete),
+        watcher_timer_init_(watcher_timer_init) {
+    grpc_polling_entity_add_to_pollset_set(&pollent_,
+                                           chand_->interested_parties_);
+    GRPC_CHANNEL_STACK_REF(chand_->owning_stack_,
+                           "ExternalConnectivityWatcher");
+    GRPC_CLOSURE_SCHED(
+        GRPC_CLOSURE_INIT(&my_closure_, WatchConnectivityStateInCombiner,
+                          this, grpc_combiner_scheduler(chand_->combiner_)),
+        GRPC_ERROR_NONE);
+  }
+
+  ~ExternalConnectivityWatcher() {
+    grpc_polling_entity_del_from_pollset_set(&pollent_,
+                                             chand_->interested_parties_);
+    GRPC_CHANNEL_STACK_UNREF(chand_->owning_stack_,
+                             "ExternalConnectivityWatcher");
+  }
+
+ private:
+  friend class ChannelData;
+
+  static void OnWatchCompleteInCombiner(void* arg, grpc_error* error) {
+    ExternalConnectivityWatcher* self =
+        static_cast<ExternalConnectivityWatcher*>(arg);
+    grpc_closure* on_complete = self->on_complete_;
+    {
+      MutexLock lock(&self->chand_->mu_);
+      for (ExternalConnectivityWatcher** w = &self->chand_->external_watchers_;
+           *w != nullptr; w = &(*w)->next_) {
+        if (*w == self) {
+          *w = self->next_;
+          break;
+        }
+      }
+    }
+    Delete(self);
+    GRPC_CLOSURE_SCHED(on_complete, GRPC_ERROR_REF(error));
+  }
+
+  static void WatchConnectivityStateInCombiner(void* arg, grpc_error* ignored) {
+    ExternalConnectivityWatcher* self =
+        static_cast<ExternalConnectivityWatcher*>(arg);
+    ChannelData* chand = self->chand_;
+    MutexLock lock(&chand->mu_);
+    if (self->state_ == nullptr) {
+      // Handle cancellation.
+      GPR_ASSERT(self->watcher_timer_init_ == nullptr);
+      for (ExternalConnectivityWatcher* w = chand->external_watchers_;
+           w != nullptr; w = w->next_) {
+        if (w->on_complete_ == self->on_complete_) {
+          grpc_connectivity_state_notify_on_state_change(
+              &chand->state_tracker_, nullptr, &w->my_closure_);
+          break;
+        }
+      }
+      Delete(self);
+      return;
+    }
+    // New watcher.
+    self->next_ = chand->external_watchers_;
+    chand->external_watchers_ = self;
+    // This assumes that the closure is scheduled on the ExecCtx scheduler
+    // and that GRPC_CLOSURE_RUN would run the closure immediately.
+    GRPC_CLOSURE_RUN(self->watcher_timer_init_, GRPC_ERROR_NONE);
+    GRPC_CLOSURE_INIT(&self->my_closure_, OnWatchCompleteInCombiner, self,
+                      grpc_combiner_scheduler(chand->combiner_));
+    grpc_connectivity_state_notify_on_state_change(
+        &chand->state_tracker_, self->state_, &self->my_closure_);
+  }
+
+  ChannelData* chand_;
+  grpc_polling_entity pollent_;
+  grpc_connectivity_state* state_;
+  grpc_closure* on_complete_;
+  grpc_closure* watcher_timer_init_;
+  grpc_closure my_closure_;
+  ExternalConnectivityWatcher* next_ = nullptr;
+};
+
+//
+// ChannelData implementation
+//
+
+RefCountedPtr<SubchannelPoolInterface> GetSubchannelPool(
+    const grpc_channel_args* args) {
+  const bool use_local_subchannel_pool = grpc_channel_arg_get_bool(
+      grpc_channel_args_find(args, GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), false);
+  if (use_local_subchannel_pool) {
+    return MakeRefCounted<LocalSubchannelPool>();
+  }
+  return GlobalSubchannelPool::instance();
+}
+
+// Parses the server URI in args into *addr, if it names exactly one address
+// that needs no resolving.
+bool GetDirectAddress(const grpc_channel_args* args,
+                      grpc_resolved_address* addr) {
+  const char* server_uri = grpc_channel_arg_get_string(
+      grpc_channel_args_find(args, GRPC_ARG_SERVER_URI));
+  if (server_uri == nullptr) return false;
+  grpc_uri* uri = grpc_uri_parse(server_uri, true);
+  if (uri == nullptr) return false;
+  const bool ok =
+      strchr(uri->path, ',') == nullptr && grpc_parse_uri(uri, addr);
+  grpc_uri_destroy(uri);
+  return ok;
+}
+
+grpc_error* ChannelData::Init(grpc_channel_element* elem,
+                              grpc_channel_element_args* args) {
+  GPR_ASSERT(args->is_last);
+  GPR_ASSERT(elem->filter == &grpc_direct_channel_filter);
+  grpc_error* error = GRPC_ERROR_NONE;
+  new (elem->channel_data) ChannelData(args, &error);
+  return error;
+}
+
+void ChannelData::Destroy(grpc_channel_element* elem) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  chand->~ChannelData();
+}
+
+ChannelData::ChannelData(grpc_channel_element_args* args, grpc_error** error)
+    : deadline_checking_enabled_(
+          grpc_deadline_checking_enabled(args->channel_args)),
+      deadline_coalescer_(
+          DeadlineCoalescer::CreateFromChannelArgs(args->channel_args)),
+      owning_stack_(args->channel_stack),
+      combiner_(grpc_combiner_create()),
+      interested_parties_(grpc_pollset_set_create()) {
+  grpc_connectivity_state_init(&state_tracker_, GRPC_CHANNEL_IDLE,
+                               "direct_channel");
+  GRPC_CLOSURE_INIT(&start_connecting_closure_, StartConnectingInCombiner,
+                    this, grpc_combiner_scheduler(combiner_));
+  grpc_client_channel_start_backup_polling(interested_parties_);
+  ClientChannelFactory* factory =
+      ClientChannelFactory::GetFromChannelArgs(args->channel_args);
+  if (factory == nullptr) {
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Missing client channel factory in args for direct channel filter");
+    return;
+  }
+  grpc_resolved_address addr;
+  if (!GetDirectAddress(args->channel_args, &addr)) {
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "server URI of a direct channel must be a single address");
+    return;
+  }
+  // Create the subchannel as pick_first would from a sockaddr resolver's
+  // result, so that it is shared, through the subchannel pool, with client
+  // channels to the same address.
+  RefCountedPtr<SubchannelPoolInterface> subchannel_pool =
+      GetSubchannelPool(args->channel_args);
+  static const char* args_to_remove[] = {GRPC_ARG_CHANNELZ_CHANNEL_NODE};
+  grpc_arg args_to_add[] = {
+      Subchannel::CreateSubchannelAddressArg(&addr),
+      SubchannelPoolInterface::CreateChannelArg(subchannel_pool.get()),
+  };
+  grpc_channel_args* subchannel_args =
+      grpc_channel_args_copy_and_add_and_remove(
+          args->channel_args, args_to_remove, GPR_ARRAY_SIZE(args_to_remove),
+          args_to_add, GPR_ARRAY_SIZE(args_to_add));
+  gpr_free(args_to_add[0].value.string);
+  subchannel_ = factory->CreateSubchannel(subchannel_args);
+  grpc_channel_args_destroy(subchannel_args);
+  if (subchannel_ == nullptr) {
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Failed to create subchannel for direct channel");
+  }
+}
+
+ChannelData::~ChannelData() {
+  // The watch is normally cancelled on disconnect; cancelling it again is a
+  // no-op.
+  if (watcher_ != nullptr) {
+    subchannel_->CancelConnectivityStateWatch(nullptr, watcher_);
+  }
+  if (subchannel_ != nullptr) {
+    GRPC_SUBCHANNEL_UNREF(subchannel_, "direct_channel");
+  }
+  connected_subchannel_.reset();
+  grpc_client_channel_stop_backup_polling(interested_parties_);
+  grpc_pollset_set_destroy(interested_parties_);
+  GRPC_COMBINER_UNREF(combiner_, "direct_channel");
+  GRPC_ERROR_UNREF(disconnect_error_);
+  grpc_connectivity_state_destroy(&state_tracker_);
+}
+
+void ChannelData::AddQueuedCall(QueuedCall* call,
+                                grpc_polling_entity* pollent) {
+  call->next = queued_calls_;
+  queued_calls_ = call;
+  // Add the call's pollent to the channel's interested_parties, so that the
+  // connection attempt is polled under the call's CQ.
+  grpc_polling_entity_add_to_pollset_set(pollent, interested_parties_);
+}
+
+void ChannelData::RemoveQueuedCall(QueuedCall* to_remove,
+                                   grpc_polling_entity* pollent) {
+  grpc_polling_entity_del_from_pollset_set(pollent, interested_parties_);
+  for (QueuedCall** call = &queued_calls_; *call != nullptr;
+       call = &(*call)->next) {
+    if (*call == to_remove) {
+      *call = to_remove->next;
+      return;
+    }
+  }
+}
+
+void ChannelData::ConnectLocked() {
+  if (connect_requested_ || disconnect_error_ != GRPC_ERROR_NONE) return;
+  connect_requested_ = true;
+  GRPC_CHANNEL_STACK_REF(owning_stack_, "StartConnecting");
+  GRPC_CLOSURE_SCHED(&start_connecting_closure_, GRPC_ERROR_NONE);
+}
+
+void ChannelData::StartConnectingInCombiner(void* arg, grpc_error* ignored) {
+  ChannelData* chand = static_cast<ChannelData*>(arg);
+  bool disconnected;
+  {
+    MutexLock lock(&chand->mu_);
+    disconnected = chand->disconnect_error_ != GRPC_ERROR_NONE;
+  }
+  if (!disconnected) {
+    chand->watcher_ = New<SubchannelWatcher>(chand);
+    chand->subchannel_->WatchConnectivityState(
+        GRPC_CHANNEL_IDLE, nullptr,
+        OrphanablePtr<Subchannel::ConnectivityStateWatcherInterface>(
+            chand->watcher_));
+    chand->subchannel_->AttemptToConnect();
+  }
+  GRPC_CHANNEL_STACK_UNREF(chand->owning_stack_, "StartConnecting");
+}
+
+void ChannelData::OnSubchannelStateChangeInCombiner(
+    grpc_connectivity_state state,
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel) {
+  if (watcher_ == nullptr) return;  // Disconnected since.
+  if (state == GRPC_CHANNEL_IDLE) {
+    // The connection went away: reconnect rather than waiting for a call.
+    subchannel_->AttemptToConnect();
+    state = GRPC_CHANNEL_CONNECTING;
+  }
+  MutexLock lock(&mu_);
+  UpdateStateLocked(state, std::move(connected_subchannel), "subchannel");
+}
+
+void ChannelData::UpdateStateLocked(
+    grpc_connectivity_state state,
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    const char* reason) {
+  state_ = state;
+  connected_subchannel_ = std::move(connected_subchannel);
+  grpc_connectivity_state_set(&state_tracker_, state, reason);
+  // Re-process queued calls.
+  for (QueuedCall* call = queued_calls_; call != nullptr; call = call->next) {
+    grpc_call_element* elem = call->elem;
+    CallData* calld = static_cast<CallData*>(elem->call_data);
+    grpc_error* error = GRPC_ERROR_NONE;
+    if (calld->PickLocked(elem, &error)) {
+      calld->AsyncPickDone(elem, error);
+    }
+  }
+}
+
+void ChannelData::CancelWatchInCombiner() {
+  if (watcher_ == nullptr) return;
+  subchannel_->CancelConnectivityStateWatch(nullptr, watcher_);
+  watcher_ = nullptr;
+}
+
+grpc_connectivity_state ChannelData::CheckConnectivityState(
+    bool try_to_connect) {
+  MutexLock lock(&mu_);
+  if (try_to_connect && state_ == GRPC_CHANNEL_IDLE) ConnectLocked();
+  return state_;
+}
+
+void ChannelData::AddExternalConnectivityWatcher(
+    grpc_polling_entity pollent, grpc_connectivity_state* state,
+    grpc_closure* on_complete, grpc_closure* watcher_timer_init) {
+  // Will delete itself.
+  New<ExternalConnectivityWatcher>(this, pollent, state, on_complete,
+                                   watcher_timer_init);
+}
+
+int ChannelData::NumExternalConnectivityWatchers() const {
+  MutexLock lock(&mu_);
+  int count = 0;
+  for (ExternalConnectivityWatcher* w = external_watchers_; w != nullptr;
+       w = w->next_) {
+    ++count;
+  }
+  return count;
+}
+
+void ChannelData::StartTransportOpInCombiner(void* arg, grpc_error* ignored) {
+  grpc_transport_op* op = static_cast<grpc_transport_op*>(arg);
+  grpc_channel_element* elem =
+      static_cast<grpc_channel_element*>(op->handler_private.extra_arg);
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  {
+    MutexLock lock(&chand->mu_);
+    // Connectivity watch.
+    if (op->on_connectivity_state_change != nullptr) {
+      grpc_connectivity_state_notify_on_state_change(
+          &chand->state_tracker_, op->connectivity_state,
+          op->on_connectivity_state_change);
+      op->on_connectivity_state_change = nullptr;
+      op->connectivity_state = nullptr;
+    }
+    // Ping.
+    if (op->send_ping.on_initiate != nullptr ||
+        op->send_ping.on_ack != nullptr) {
+      if (chand->connected_subchannel_ != nullptr) {
+        chand->connected_subchannel_->Ping(op->send_ping.on_initiate,
+                                           op->send_ping.on_ack);
+      } else {
+        grpc_error* error =
+            GRPC_ERROR_CREATE_FROM_STATIC_STRING("channel not connected");
+        GRPC_CLOSURE_SCHED(op->send_ping.on_initiate, GRPC_ERROR_REF(error));
+        GRPC_CLOSURE_SCHED(op->send_ping.on_ack, error);
+      }
+      op->send_ping.on_initiate = nullptr;
+      op->send_ping.on_ack = nullptr;
+    }
+  }
+  // Reset backoff.
+  if (op->reset_connect_backoff) {
+    chand->subchannel_->ResetBackoff();
+  }
+  // Disconnect. A request to enter IDLE (from client_idle) is ignored: the
+  // point of a direct channel is to keep its connection.
+  if (op->disconnect_with_error != GRPC_ERROR_NONE) {
+    intptr_t value;
+    if (grpc_error_get_int(op->disconnect_with_error,
+                           GRPC_ERROR_INT_CHANNEL_CONNECTIVITY_STATE, &value) &&
+        static_cast<grpc_connectivity_state>(value) == GRPC_CHANNEL_IDLE) {
+      GRPC_ERROR_UNREF(op->disconnect_with_error);
+    } else {
+      chand->CancelWatchInCombiner();
+      MutexLock lock(&chand->mu_);
+      GPR_ASSERT(chand->disconnect_error_ == GRPC_ERROR_NONE);
+      chand->disconnect_error_ = op->disconnect_with_error;
+      chand->UpdateStateLocked(GRPC_CHANNEL_SHUTDOWN, nullptr,
+                               "shutdown from API");
+    }
+  }
+  GRPC_CHANNEL_STACK_UNREF(chand->owning_stack_, "start_transport_op");
+  GRPC_CLOSURE_SCHED(op->on_consumed, GRPC_ERROR_NONE);
+}
+
+void ChannelData::StartTransportOp(grpc_channel_element* elem,
+                                   grpc_transport_op* op) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  GPR_ASSERT(op->set_accept_stream == false);
+  // Handle bind_pollset.
+  if (op->bind_pollset != nullptr) {
+    grpc_pollset_set_add_pollset(chand->interested_parties_, op->bind_pollset);
+  }
+  // Pop into the combiner for remaining ops.
+  op->handler_private.extra_arg = elem;
+  GRPC_CHANNEL_STACK_REF(chand->owning_stack_, "start_transport_op");
+  GRPC_CLOSURE_SCHED(
+      GRPC_CLOSURE_INIT(&op->handler_private.closure,
+                        ChannelData::StartTransportOpInCombiner, op,
+                        grpc_combiner_scheduler(chand->combiner_)),
+      GRPC_ERROR_NONE);
+}
+
+void ChannelData::GetChannelInfo(grpc_channel_element* elem,
+                                 const grpc_channel_info* info) {}
+
+//
+// CallData implementation
+//
+
+CallData::CallData(grpc_call_element* elem, const ChannelData& chand,
+                   const grpc_call_element_args& args)
+    : deadline_state_(elem, args.call_stack, args.call_combiner,
+                      GPR_LIKELY(chand.deadline_checking_enabled())
+                          ? args.deadline
+                          : GRPC_MILLIS_INF_FUTURE,
+                      chand.deadline_coalescer()),
+      path_(grpc_slice_ref_internal(args.path)),
+      call_start_time_(args.start_time),
+      deadline_(args.deadline),
+      arena_(args.arena),
+      owning_call_(args.call_stack),
+      call_combiner_(args.call_combiner),
+      call_context_(args.context) {}
+
+CallData::~CallData() {
+  grpc_slice_unref_internal(path_);
+  GRPC_ERROR_UNREF(cancel_error_);
+  // Make sure there are no remaining pending batches.
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
+    GPR_ASSERT(pending_batches_[i] == nullptr);
+  }
+}
+
+grpc_error* CallData::Init(grpc_call_element* elem,
+                           const grpc_call_element_args* args) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  new (elem->call_data) CallData(elem, *chand, *args);
+  return GRPC_ERROR_NONE;
+}
+
+void CallData::Destroy(grpc_call_element* elem,
+                       const grpc_call_final_info* final_info,
+                       grpc_closure* then_schedule_closure) {
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  if (GPR_LIKELY(calld->subchannel_call_ != nullptr)) {
+    calld->subchannel_call_->SetAfterCallStackDestroy(then_schedule_closure);
+    then_schedule_closure = nullptr;
+  }
+  calld->~CallData();
+  GRPC_CLOSURE_SCHED(then_schedule_closure, GRPC_ERROR_NONE);
+}
+
+void CallData::StartTransportStreamOpBatch(
+    grpc_call_element* elem, grpc_transport_stream_op_batch* batch) {
+  GPR_TIMER_SCOPE("direct_channel_start_transport_stream_op_batch", 0);
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  if (GPR_LIKELY(chand->deadline_checking_enabled())) {
+    grpc_deadline_state_client_start_transport_stream_op_batch(elem, batch);
+  }
+  // Once the call is started, batches go straight to the subchannel call.
+  if (GPR_LIKELY(calld->subchannel_call_ != nullptr)) {
+    if (GPR_UNLIKELY(batch->cancel_stream)) {
+      GRPC_ERROR_UNREF(calld->cancel_error_);
+      calld->cancel_error_ =
+          GRPC_ERROR_REF(batch->payload->cancel_stream.cancel_error);
+    }
+    // Note: This will release the call combiner.
+    calld->subchannel_call_->StartTransportStreamOpBatch(batch);
+    return;
+  }
+  // If we've previously been cancelled, immediately fail any new batches.
+  if (GPR_UNLIKELY(calld->cancel_error_ != GRPC_ERROR_NONE)) {
+    // Note: This will release the call combiner.
+    grpc_transport_stream_op_batch_finish_with_failure(
+        batch, GRPC_ERROR_REF(calld->cancel_error_), calld->call_combiner_);
+    return;
+  }
+  // Handle cancellation before the call has started.
+  if (GPR_UNLIKELY(batch->cancel_stream)) {
+    calld->cancel_error_ =
+        GRPC_ERROR_REF(batch->payload->cancel_stream.cancel_error);
+    calld->PendingBatchesFail(GRPC_ERROR_REF(calld->cancel_error_),
+                              false /* yield_call_combiner */);
+    // Note: This will release the call combiner.
+    grpc_transport_stream_op_batch_finish_with_failure(
+        batch, GRPC_ERROR_REF(calld->cancel_error_), calld->call_combiner_);
+    return;
+  }
+  calld->PendingBatchesAdd(batch);
+  // The call starts with send_initial_metadata; until then, hold the other
+  // batches.
+  if (GPR_LIKELY(batch->send_initial_metadata)) {
+    Pick(elem);
+  } else {
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
+                            "batch does not include send_initial_metadata");
+  }
+}
+
+void CallData::SetPollent(grpc_call_element* elem,
+                          grpc_polling_entity* pollent) {
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  calld->pollent_ = pollent;
+}
+
+//
+// pending_batches management
+//
+
+size_t CallData::GetBatchIndex(grpc_transport_stream_op_batch* batch) {
+  // Note: It is important the send_initial_metadata be the first entry
+  // here, since PickLocked() assumes it will be.
+  if (batch->send_initial_metadata) return 0;
+  if (batch->send_message) return 1;
+  if (batch->send_trailing_metadata) return 2;
+  if (batch->recv_initial_metadata) return 3;
+  if (batch->recv_message) return 4;
+  if (batch->recv_trailing_metadata) return 5;
+  GPR_UNREACHABLE_CODE(return (size_t)-1);
+}
+
+// This is called via the call combiner, so access to calld is synchronized.
+void CallData::PendingBatchesAdd(grpc_transport_stream_op_batch* batch) {
+  const size_t idx = GetBatchIndex(batch);
+  GPR_ASSERT(pending_batches_[idx] == nullptr);
+  pending_batches_[idx] = batch;
+}
+
+// This is called via the call combiner, so access to calld is synchronized.
+void CallData::FailPendingBatchInCallCombiner(void* arg, grpc_error* error) {
+  grpc_transport_stream_op_batch* batch =
+      static_cast<grpc_transport_stream_op_batch*>(arg);
+  CallData* calld = static_cast<CallData*>(batch->handler_private.extra_arg);
+  // Note: This will release the call combiner.
+  grpc_transport_stream_op_batch_finish_with_failure(
+      batch, GRPC_ERROR_REF(error), calld->call_combiner_);
+}
+
+// This is called via the call combiner, so access to calld is synchronized.
+void CallData::PendingBatchesFail(grpc_error* error, bool yield_call_combiner,
+                                  bool only_if_batches_found) {
+  GPR_ASSERT(error != GRPC_ERROR_NONE);
+  CallCombinerClosureList closures;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
+    grpc_transport_stream_op_batch* batch = pending_batches_[i];
+    if (batch != nullptr) {
+      batch->handler_private.extra_arg = this;
+      GRPC_CLOSURE_INIT(&batch->handler_private.closure,
+                        FailPendingBatchInCallCombiner, batch,
+                        grpc_schedule_on_exec_ctx);
+      closures.Add(&batch->handler_private.closure, GRPC_ERROR_REF(error),
+                   "PendingBatchesFail");
+      pending_batches_[i] = nullptr;
+    }
+  }
+  if (yield_call_combiner || (only_if_batches_found && closures.size() > 0)) {
+    closures.RunClosures(call_combiner_);
+  } else {
+    closures.RunClosuresWithoutYielding(call_combiner_);
+  }
+  GRPC_ERROR_UNREF(error);
+}
+
+// This is called via the call combiner, so access to calld is synchronized.
+void CallData::ResumePendingBatchInCallCombiner(void* arg,
+                                                grpc_error* ignored) {
+  grpc_transport_stream_op_batch* batch =
+      static_cast<grpc_transport_stream_op_batch*>(arg);
+  SubchannelCall* subchannel_call =
+      static_cast<SubchannelCall*>(batch->handler_private.extra_arg);
+  // Note: This will release the call combiner.
+  subchannel_call->StartTransportStreamOpBatch(batch);
+}
+
+// This is called via the call combiner, so access to calld is synchronized.
+void CallData::PendingBatchesResume() {
+  CallCombinerClosureList closures;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
+    grpc_transport_stream_op_batch* batch = pending_batches_[i];
+    if (batch != nullptr) {
+      batch->handler_private.extra_arg = subchannel_call_.get();
+      GRPC_CLOSURE_INIT(&batch->handler_private.closure,
+                        ResumePendingBatchInCallCombiner, batch,
+                        grpc_schedule_on_exec_ctx);
+      closures.Add(&batch->handler_private.closure, GRPC_ERROR_NONE,
+                   "PendingBatchesResume");
+      pending_batches_[i] = nullptr;
+    }
+  }
+  // Note: This will release the call combiner.
+  closures.RunClosures(call_combiner_);
+}
+
+//
+// picking the connected subchannel
+//
+
+void CallData::CreateSubchannelCall() {
+  SubchannelCall::Args call_args = {
+      std::move(connected_subchannel_), pollent_, path_, call_start_time_,
+      deadline_, arena_, call_context_, call_combiner_, 0};
+  grpc_error* error = GRPC_ERROR_NONE;
+  subchannel_call_ = SubchannelCall::Create(std::move(call_args), &error);
+  if (GPR_UNLIKELY(error != GRPC_ERROR_NONE)) {
+    subchannel_call_.reset();
+    PendingBatchesFail(error, true /* yield_call_combiner */);
+  } else {
+    PendingBatchesResume();
+  }
+}
+
+void CallData::PickDone(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  if (error != GRPC_ERROR_NONE) {
+    calld->PendingBatchesFail(GRPC_ERROR_REF(error),
+                              true /* yield_call_combiner */);
+    return;
+  }
+  calld->CreateSubchannelCall();
+}
+
+void CallData::AsyncPickDone(grpc_call_element* elem, grpc_error* error) {
+  GRPC_CLOSURE_INIT(&pick_closure_, PickDone, elem, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_SCHED(&pick_closure_, error);
+}
+
+// Handles the call combiner cancellation callback for a queued call.
+class CallData::QueuedCallCanceller {
+ public:
+  explicit QueuedCallCanceller(grpc_call_element* elem) : elem_(elem) {
+    auto* calld = static_cast<CallData*>(elem->call_data);
+    GRPC_CALL_STACK_REF(calld->owning_call_, "QueuedCallCanceller");
+    GRPC_CLOSURE_INIT(&closure_, &CancelLocked, this,
+                      grpc_schedule_on_exec_ctx);
+    calld->call_combiner_->SetNotifyOnCancel(&closure_);
+  }
+
+ private:
+  static void CancelLocked(void* arg, grpc_error* error) {
+    auto* self = static_cast<QueuedCallCanceller*>(arg);
+    auto* chand = static_cast<ChannelData*>(self->elem_->channel_data);
+    auto* calld = static_cast<CallData*>(self->elem_->call_data);
+    {
+      MutexLock lock(chand->mu());
+      if (calld->canceller_ == self && error != GRPC_ERROR_NONE) {
+        calld->RemoveCallFromQueueLocked(self->elem_);
+        calld->PendingBatchesFail(GRPC_ERROR_REF(error),
+                                  false /* yield_call_combiner */,
+                                  true /* only_if_batches_found */);
+      }
+    }
+    GRPC_CALL_STACK_UNREF(calld->owning_call_, "QueuedCallCanceller");
+    Delete(self);
+  }
+
+  grpc_call_element* elem_;
+  grpc_closure closure_;
+};
+
+void CallData::AddCallToQueueLocked(grpc_call_element* elem) {
+  auto* chand = static_cast<ChannelData*>(elem->channel_data);
+  queued_ = true;
+  queued_call_.elem = elem;
+  chand->AddQueuedCall(&queued_call_, pollent_);
+  canceller_ = New<QueuedCallCanceller>(elem);
+}
+
+void CallData::RemoveCallFromQueueLocked(grpc_call_element* elem) {
+  auto* chand = static_cast<ChannelData*>(elem->channel_data);
+  chand->RemoveQueuedCall(&queued_call_, pollent_);
+  queued_ = false;
+  // Lame the call combiner canceller.
+  canceller_ = nullptr;
+}
+
+void CallData::Pick(grpc_call_element* elem) {
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  grpc_error* error = GRPC_ERROR_NONE;
+  bool pick_complete;
+  {
+    MutexLock lock(chand->mu());
+    pick_complete = calld->PickLocked(elem, &error);
+  }
+  if (pick_complete) {
+    PickDone(elem, error);
+    GRPC_ERROR_UNREF(error);
+  }
+}
+
+bool CallData::PickLocked(grpc_call_element* elem, grpc_error** error) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  GPR_ASSERT(connected_subchannel_ == nullptr);
+  GPR_ASSERT(subchannel_call_ == nullptr);
+  if (GPR_UNLIKELY(chand->disconnect_error() != GRPC_ERROR_NONE)) {
+    *error = GRPC_ERROR_REF(chand->disconnect_error());
+  } else if (GPR_LIKELY(chand->connected_subchannel() != nullptr)) {
+    connected_subchannel_ = chand->connected_subchannel();
+  } else if (chand->state() == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+             (pending_batches_[0]
+                  ->payload->send_initial_metadata.send_initial_metadata_flags &
+              GRPC_INITIAL_METADATA_WAIT_FOR_READY) == 0) {
+    *error = GRPC_ERROR_IMMORTAL(grpc_error_set_int(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Failed to connect to the direct channel's address"),
+        GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+  } else {
+    if (chand->state() == GRPC_CHANNEL_IDLE) chand->ConnectLocked();
+    if (!queued_) AddCallToQueueLocked(elem);
+    return false;
+  }
+  if (queued_) RemoveCallFromQueueLocked(elem);
+  return true;
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+/*************************************************************************
+ * EXPORTED SYMBOLS
+ */
+
+using grpc_core::CallData;
+using grpc_core::ChannelData;
+
+const grpc_channel_filter grpc_direct_channel_filter = {
+    CallData::StartTransportStreamOpBatch,
+    ChannelData::StartTransportOp,
+    sizeof(CallData),
+    CallData::Init,
+    CallData::SetPollent,
+    CallData::Destroy,
+    sizeof(ChannelData),
+    ChannelData::Init,
+    ChannelData::Destroy,
+    ChannelData::GetChannelInfo,
+    "direct-channel",
+};
+
+bool grpc_direct_channel_enabled(const grpc_channel_args* args) {
+  if (!grpc_channel_arg_get_bool(
+          grpc_channel_args_find(args, GRPC_ARG_DIRECT_CHANNEL), false)) {
+    return false;
+  }
+  grpc_resolved_address addr;
+  return grpc_core::GetDirectAddress(args, &addr);
+}
+
+grpc_connectivity_state grpc_direct_channel_check_connectivity_state(
+    grpc_channel_element* elem, int try_to_connect) {
+  auto* chand = static_cast<ChannelData*>(elem->channel_data);
+  return chand->CheckConnectivityState(try_to_connect);
+}
+
+void grpc_direct_channel_watch_connectivity_state(
+    grpc_channel_element* elem, grpc_polling_entity pollent,
+    grpc_connectivity_state* state, grpc_closure* on_complete,
+    grpc_closure* watcher_timer_init) {
+  auto* chand = static_cast<ChannelData*>(elem->channel_data);
+  chand->AddExternalConnectivityWatcher(pollent, state, on_complete,
+                                        watcher_timer_init);
+}
+
+int grpc_direct_channel_num_external_connectivity_watchers(
+    grpc_channel_element* elem) {
+  auto* chand = static_cast<ChannelData*>(elem->channel_data);
+  return chand->NumExternalConnectivityWatchers();
+}
@@ -0,0 +1,60 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_DIRECT_CHANNEL_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_DIRECT_CHANNEL_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/iomgr/polling_entity.h"
+
+/* A direct channel stands in for the client channel filter at the bottom of a
+   GRPC_CLIENT_CHANNEL stack when GRPC_ARG_DIRECT_CHANNEL is set and the target
+   is a single ipv4:, ipv6: or unix: address. It owns one subchannel to that
+   address and starts each call straight on its connected subchannel, with no
+   resolver, LB policy or pick in between.
+
+   The subchannel connects on the first call (or connectivity check asking to
+   connect), and reconnects in the background, with the subchannel's backoff,
+   whenever it goes idle. Calls started while it is not connected are queued
+   until it is; ones without wait_for_ready fail instead while it is in
+   TRANSIENT_FAILURE. Since there is no resolver, the service config (retries,
+   per-method timeouts and limits, LB config) and proxy mapping are not
+   applied. */
+
+extern const grpc_channel_filter grpc_direct_channel_filter;
+
+/* Returns true if a GRPC_CLIENT_CHANNEL stack with these args should end in
+   grpc_direct_channel_filter rather than grpc_client_channel_filter. */
+bool grpc_direct_channel_enabled(const grpc_channel_args* args);
+
+/* The direct channel's implementations of the client channel's connectivity
+   API, for channel_connectivity.cc. */
+grpc_connectivity_state grpc_direct_channel_check_connectivity_state(
+    grpc_channel_element* elem, int try_to_connect);
+
+void grpc_direct_channel_watch_connectivity_state(
+    grpc_channel_element* elem, grpc_polling_entity pollent,
+    grpc_connectivity_state* state, grpc_closure* on_complete,
+    grpc_closure* watcher_timer_init);
+
+int grpc_direct_channel_num_external_connectivity_watchers(
+    grpc_channel_element* elem);
+
+#endif /* GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_DIRECT_CHANNEL_H */
@@ -25,13 +25,17 @@
 namespace grpc_core {
 
 GlobalSubchannelPool::GlobalSubchannelPool() {
-  subchannel_map_ = grpc_avl_create(&subchannel_avl_vtable_);
-  gpr_mu_init(&mu_);
+  for (Shard& shard : shards_) {
+    shard.subchannel_map = grpc_flat_map_create(&subchannel_avl_vtable_);
+    gpr_mu_init(&shard.mu);
+  }
 }
 
 GlobalSubchannelPool::~GlobalSubchannelPool() {
-  gpr_mu_destroy(&mu_);
-  grpc_avl_unref(subchannel_map_, nullptr);
+  for (Shard& shard : shards_) {
+    gpr_mu_destroy(&shard.mu);
+    grpc_flat_map_unref(shard.subchannel_map, nullptr);
+  }
 }
 
 void GlobalSubchannelPool::Init() {
@@ -56,15 +60,16 @@ RefCountedPtr<GlobalSubchannelPool> GlobalSubchannelPool::instance() {
 
 Subchannel* GlobalSubchannelPool::RegisterSubchannel(SubchannelKey* key,
                                                      Subchannel* constructed) {
+  Shard* shard = ShardForKey(*key);
   Subchannel* c = nullptr;
   // Compare and swap (CAS) loop:
   while (c == nullptr) {
     // Ref the shared map to have a local copy.
-    gpr_mu_lock(&mu_);
-    grpc_avl old_map = grpc_avl_ref(subchannel_map_, nullptr);
-    gpr_mu_unlock(&mu_);
+    gpr_mu_lock(&shard->mu);
+    grpc_flat_map old_map = grpc_flat_map_ref(shard->subchannel_map, nullptr);
+    gpr_mu_unlock(&shard->mu);
     // Check to see if a subchannel already exists.
-    c = static_cast<Subchannel*>(grpc_avl_get(old_map, key, nullptr));
+    c = static_cast<Subchannel*>(grpc_flat_map_get(old_map, key, nullptr));
     if (c != nullptr) {
       // The subchannel already exists. Try to reuse it.
       c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(c, "subchannel_register+reuse");
@@ -75,81 +80,81 @@ Subchannel* GlobalSubchannelPool::RegisterSubchannel(SubchannelKey* key,
       }  // Else, reuse failed, so retry CAS loop.
     } else {
       // There hasn't been such subchannel. Add one.
-      // Note that we should ref the old map first because grpc_avl_add() will
-      // unref it while we still need to access it later.
-      grpc_avl new_map = grpc_avl_add(
-          grpc_avl_ref(old_map, nullptr), New<SubchannelKey>(*key),
+      // Note that we should ref the old map first because grpc_flat_map_add()
+      // will unref it while we still need to access it later.
+      // The map borrows the key of the subchannel, which lives as long as
+      // the weak ref the map holds.
+      grpc_flat_map new_map = grpc_flat_map_add(
+          grpc_flat_map_ref(old_map, nullptr), key,
           GRPC_SUBCHANNEL_WEAK_REF(constructed, "subchannel_register+new"),
           nullptr);
       // Try to publish the change to the shared map. It may happen (but
       // unlikely) that some other thread has changed the shared map, so compare
       // to make sure it's unchanged before swapping. Retry if it's changed.
-      gpr_mu_lock(&mu_);
-      if (old_map.root == subchannel_map_.root) {
-        GPR_SWAP(grpc_avl, new_map, subchannel_map_);
+      gpr_mu_lock(&shard->mu);
+      if (old_map.data == shard->subchannel_map.data) {
+        GPR_SWAP(grpc_flat_map, new_map, shard->subchannel_map);
         c = constructed;
       }
-      gpr_mu_unlock(&mu_);
-      grpc_avl_unref(new_map, nullptr);
+      gpr_mu_unlock(&shard->mu);
+      grpc_flat_map_unref(new_map, nullptr);
     }
-    grpc_avl_unref(old_map, nullptr);
+    grpc_flat_map_unref(old_map, nullptr);
   }
   return c;
 }
 
 void GlobalSubchannelPool::UnregisterSubchannel(SubchannelKey* key) {
+  Shard* shard = ShardForKey(*key);
   bool done = false;
   // Compare and swap (CAS) loop:
   while (!done) {
     // Ref the shared map to have a local copy.
-    gpr_mu_lock(&mu_);
-    grpc_avl old_map = grpc_avl_ref(subchannel_map_, nullptr);
-    gpr_mu_unlock(&mu_);
+    gpr_mu_lock(&shard->mu);
+    grpc_flat_map old_map = grpc_flat_map_ref(shard->subchannel_map, nullptr);
+    gpr_mu_unlock(&shard->mu);
     // Remove the subchannel.
-    // Note that we should ref the old map first because grpc_avl_remove() will
-    // unref it while we still need to access it later.
-    grpc_avl new_map =
-        grpc_avl_remove(grpc_avl_ref(old_map, nullptr), key, nullptr);
+    // Note that we should ref the old map first because grpc_flat_map_remove()
+    // will unref it while we still need to access it later.
+    grpc_flat_map new_map =
+        grpc_flat_map_remove(grpc_flat_map_ref(old_map, nullptr), key, nullptr);
     // Try to publish the change to the shared map. It may happen (but
     // unlikely) that some other thread has changed the shared map, so compare
     // to make sure it's unchanged before swapping. Retry if it's changed.
-    gpr_mu_lock(&mu_);
-    if (old_map.root == subchannel_map_.root) {
-      GPR_SWAP(grpc_avl, new_map, subchannel_map_);
+    gpr_mu_lock(&shard->mu);
+    if (old_map.data == shard->subchannel_map.data) {
+      GPR_SWAP(grpc_flat_map, new_map, shard->subchannel_map);
       done = true;
     }
-    gpr_mu_unlock(&mu_);
-    grpc_avl_unref(new_map, nullptr);
-    grpc_avl_unref(old_map, nullptr);
+    gpr_mu_unlock(&shard->mu);
+    grpc_flat_map_unref(new_map, nullptr);
+    grpc_flat_map_unref(old_map, nullptr);
   }
 }
 
 Subchannel* GlobalSubchannelPool::FindSubchannel(SubchannelKey* key) {
+  Shard* shard = ShardForKey(*key);
   // Lock, and take a reference to the subchannel map.
-  // We don't need to do the search under a lock as AVL's are immutable.
-  gpr_mu_lock(&mu_);
-  grpc_avl index = grpc_avl_ref(subchannel_map_, nullptr);
-  gpr_mu_unlock(&mu_);
-  Subchannel* c = static_cast<Subchannel*>(grpc_avl_get(index, key, nullptr));
+  // We don't need to do the search under a lock as the maps are immutable.
+  gpr_mu_lock(&shard->mu);
+  grpc_flat_map index = grpc_flat_map_ref(shard->subchannel_map, nullptr);
+  gpr_mu_unlock(&shard->mu);
+  Subchannel* c = static_cast<Subchannel*>(grpc_flat_map_get(index, key, nullptr));
   if (c != nullptr) c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(c, "found_from_pool");
-  grpc_avl_unref(index, nullptr);
+  grpc_flat_map_unref(index, nullptr);
   return c;
 }
 
+constexpr size_t GlobalSubchannelPool::kNumShards;
+
 RefCountedPtr<GlobalSubchannelPool>* GlobalSubchannelPool::instance_ = nullptr;
 
 namespace {
 
-void sck_avl_destroy(void* p, void* user_data) {
-  SubchannelKey* key = static_cast<SubchannelKey*>(p);
-  Delete(key);
-}
+// Keys are owned by their subchannels.
+void sck_avl_destroy(void* p, void* user_data) {}
 
-void* sck_avl_copy(void* p, void* unused) {
-  const SubchannelKey* key = static_cast<const SubchannelKey*>(p);
-  auto* new_key = New<SubchannelKey>(*key);
-  return static_cast<void*>(new_key);
-}
+void* sck_avl_copy(void* p, void* unused) { return p; }
 
 long sck_avl_compare(void* a, void* b, void* unused) {
   const SubchannelKey* key_a = static_cast<const SubchannelKey*>(a);
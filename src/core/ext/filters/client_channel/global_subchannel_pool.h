@@ -22,6 +22,7 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/lib/avl/flat_map.h"
 
 namespace grpc_core {
 
@@ -55,12 +56,26 @@ class GlobalSubchannelPool final : public SubchannelPoolInterface {
   // non-local static object can be trivially destructible.)
   static RefCountedPtr<GlobalSubchannelPool>* instance_;
 
-  // The vtable for subchannel operations in an AVL tree.
+  // Subchannels are spread over shards by the hash of their key, each
+  // with its own map and lock, so that channels to different backends do not
+  // all serialize on one lock.
+  static constexpr size_t kNumShards = 16;
+  struct Shard {
+    // A map from subchannel key to subchannel.
+    // Channels mostly look subchannels up, so this is a flat map rather
+    // than an AVL tree.
+    grpc_flat_map subchannel_map;
+    // To protect subchannel_map.
+    gpr_mu mu;
+  };
+
+  Shard* ShardForKey(const SubchannelKey& key) {
+    return &shards_[key.Hash() % kNumShards];
+  }
+
+  // The vtable for subchannel operations in a map.
   static const grpc_avl_vtable subchannel_avl_vtable_;
-  // A map from subchannel key to subchannel.
-  grpc_avl subchannel_map_;
-  // To protect subchannel_map_.
-  gpr_mu mu_;
+  Shard shards_[kNumShards];
 };
 
 }  // namespace grpc_core
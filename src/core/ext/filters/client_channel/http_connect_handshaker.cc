@@ -310,6 +310,7 @@ void HttpConnectHandshaker::DoHandshake(grpc_tcp_server_acceptor* acceptor,
   request.http.body_length = 0;
   request.http.body = nullptr;
   request.handshaker = &grpc_httpcli_plaintext;
+  request.keep_alive = false;
   grpc_slice request_slice = grpc_httpcli_format_connect_request(&request);
   grpc_slice_buffer_add(&write_buffer_, request_slice);
   // Clean up.
@@ -248,7 +248,7 @@ class GrpcLb : public LoadBalancingPolicy {
     // should not be dropped.
     //
     // Note: This is called from the picker, so it will be invoked in
-    // the channel's data plane combiner, NOT the control plane
+    // the channel's data plane mutex, NOT the control plane
     // combiner.  It should not be accessed by any other part of the LB
     // policy.
     const char* ShouldDrop();
@@ -256,7 +256,7 @@ class GrpcLb : public LoadBalancingPolicy {
    private:
     grpc_grpclb_serverlist* serverlist_;
 
-    // Guarded by the channel's data plane combiner, NOT the control
+    // Guarded by the channel's data plane mutex, NOT the control
     // plane combiner.  It should not be accessed by anything but the
     // picker via the ShouldDrop() method.
     size_t drop_index_ = 0;
@@ -22,52 +22,87 @@
 
 #include <string.h>
 
-#include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
 
+GrpcLbClientStats::GrpcLbClientStats() {
+  const size_t num_cores = GPR_MAX(1, gpr_cpu_num_cores());
+  per_cpu_data_.reserve(num_cores);
+  for (size_t i = 0; i < num_cores; ++i) {
+    per_cpu_data_.emplace_back();
+  }
+}
+
+GrpcLbClientStats::PerCpuData& GrpcLbClientStats::CurrentCpuData() {
+  return per_cpu_data_[ExecCtx::Get()->starting_cpu()];
+}
+
 void GrpcLbClientStats::AddCallStarted() {
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
+  CurrentCpuData().num_calls_started.FetchAdd(1, MemoryOrder::RELAXED);
 }
 
 void GrpcLbClientStats::AddCallFinished(
     bool finished_with_client_failed_to_send, bool finished_known_received) {
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  PerCpuData& data = CurrentCpuData();
+  data.num_calls_finished.FetchAdd(1, MemoryOrder::RELAXED);
   if (finished_with_client_failed_to_send) {
-    gpr_atm_full_fetch_add(&num_calls_finished_with_client_failed_to_send_,
-                           (gpr_atm)1);
+    data.num_calls_finished_with_client_failed_to_send.FetchAdd(
+        1, MemoryOrder::RELAXED);
   }
   if (finished_known_received) {
-    gpr_atm_full_fetch_add(&num_calls_finished_known_received_, (gpr_atm)1);
+    data.num_calls_finished_known_received.FetchAdd(1, MemoryOrder::RELAXED);
   }
 }
 
 void GrpcLbClientStats::AddCallDropped(const char* token) {
+  PerCpuData& data = CurrentCpuData();
   // Increment num_calls_started and num_calls_finished.
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  data.num_calls_started.FetchAdd(1, MemoryOrder::RELAXED);
+  data.num_calls_finished.FetchAdd(1, MemoryOrder::RELAXED);
   // Record the drop.
-  MutexLock lock(&drop_count_mu_);
-  if (drop_token_counts_ == nullptr) {
-    drop_token_counts_.reset(New<DroppedCallCounts>());
+  MutexLock lock(&data.drop_count_mu);
+  if (data.drop_token_counts == nullptr) {
+    data.drop_token_counts.reset(New<DroppedCallCounts>());
   }
-  for (size_t i = 0; i < drop_token_counts_->size(); ++i) {
-    if (strcmp((*drop_token_counts_)[i].token.get(), token) == 0) {
-      ++(*drop_token_counts_)[i].count;
+  for (size_t i = 0; i < data.drop_token_counts->size(); ++i) {
+    if (strcmp((*data.drop_token_counts)[i].token.get(), token) == 0) {
+      ++(*data.drop_token_counts)[i].count;
       return;
     }
   }
   // Not found, so add a new entry.
-  drop_token_counts_->emplace_back(UniquePtr<char>(gpr_strdup(token)), 1);
+  data.drop_token_counts->emplace_back(UniquePtr<char>(gpr_strdup(token)), 1);
 }
 
 namespace {
 
-void AtomicGetAndResetCounter(int64_t* value, gpr_atm* counter) {
-  *value = static_cast<int64_t>(gpr_atm_full_xchg(counter, (gpr_atm)0));
+int64_t GetAndResetCounter(Atomic<int64_t>* counter) {
+  return counter->Exchange(0, MemoryOrder::RELAXED);
+}
+
+// Adds the counts of \a from to \a to.
+void MergeDropTokenCounts(GrpcLbClientStats::DroppedCallCounts* from,
+                          GrpcLbClientStats::DroppedCallCounts* to) {
+  for (size_t i = 0; i < from->size(); ++i) {
+    GrpcLbClientStats::DropTokenCount& from_count = (*from)[i];
+    bool found = false;
+    for (size_t j = 0; j < to->size(); ++j) {
+      if (strcmp((*to)[j].token.get(), from_count.token.get()) == 0) {
+        (*to)[j].count += from_count.count;
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      to->emplace_back(std::move(from_count.token), from_count.count);
+    }
+  }
 }
 
 }  // namespace
@@ -77,14 +112,31 @@ void GrpcLbClientStats::Get(
     int64_t* num_calls_finished_with_client_failed_to_send,
     int64_t* num_calls_finished_known_received,
     UniquePtr<DroppedCallCounts>* drop_token_counts) {
-  AtomicGetAndResetCounter(num_calls_started, &num_calls_started_);
-  AtomicGetAndResetCounter(num_calls_finished, &num_calls_finished_);
-  AtomicGetAndResetCounter(num_calls_finished_with_client_failed_to_send,
-                           &num_calls_finished_with_client_failed_to_send_);
-  AtomicGetAndResetCounter(num_calls_finished_known_received,
-                           &num_calls_finished_known_received_);
-  MutexLock lock(&drop_count_mu_);
-  *drop_token_counts = std::move(drop_token_counts_);
+  *num_calls_started = 0;
+  *num_calls_finished = 0;
+  *num_calls_finished_with_client_failed_to_send = 0;
+  *num_calls_finished_known_received = 0;
+  drop_token_counts->reset();
+  for (size_t i = 0; i < per_cpu_data_.size(); ++i) {
+    PerCpuData& data = per_cpu_data_[i];
+    *num_calls_started += GetAndResetCounter(&data.num_calls_started);
+    *num_calls_finished += GetAndResetCounter(&data.num_calls_finished);
+    *num_calls_finished_with_client_failed_to_send += GetAndResetCounter(
+        &data.num_calls_finished_with_client_failed_to_send);
+    *num_calls_finished_known_received +=
+        GetAndResetCounter(&data.num_calls_finished_known_received);
+    UniquePtr<DroppedCallCounts> counts;
+    {
+      MutexLock lock(&data.drop_count_mu);
+      counts = std::move(data.drop_token_counts);
+    }
+    if (counts == nullptr) continue;
+    if (*drop_token_counts == nullptr) {
+      *drop_token_counts = std::move(counts);
+    } else {
+      MergeDropTokenCounts(counts.get(), drop_token_counts->get());
+    }
+  }
 }
 
 }  // namespace grpc_core
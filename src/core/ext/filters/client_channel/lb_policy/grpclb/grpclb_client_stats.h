@@ -21,8 +21,9 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <grpc/support/atm.h>
+#include <grpc/support/sync.h>
 
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -42,6 +43,8 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
 
   typedef InlinedVector<DropTokenCount, 10> DroppedCallCounts;
 
+  GrpcLbClientStats();
+
   void AddCallStarted();
   void AddCallFinished(bool finished_with_client_failed_to_send,
                        bool finished_known_received);
@@ -60,12 +63,36 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
   }
 
  private:
-  gpr_atm num_calls_started_ = 0;
-  gpr_atm num_calls_finished_ = 0;
-  gpr_atm num_calls_finished_with_client_failed_to_send_ = 0;
-  gpr_atm num_calls_finished_known_received_ = 0;
-  Mutex drop_count_mu_;  // Guards drop_token_counts_.
-  UniquePtr<DroppedCallCounts> drop_token_counts_;
+  // The stats are kept per CPU, each CPU's on cache lines of its own, so that
+  // calls on different CPUs do not contend to record them. Get() adds them up.
+  struct PerCpuData {
+    // Define the ctors so that we can use this structure in InlinedVector.
+    // The move ctor is only used while the vector is being filled.
+    PerCpuData() = default;
+    PerCpuData(PerCpuData&& that)
+        : num_calls_started(that.num_calls_started.Load(MemoryOrder::RELAXED)),
+          num_calls_finished(
+              that.num_calls_finished.Load(MemoryOrder::RELAXED)),
+          num_calls_finished_with_client_failed_to_send(
+              that.num_calls_finished_with_client_failed_to_send.Load(
+                  MemoryOrder::RELAXED)),
+          num_calls_finished_known_received(
+              that.num_calls_finished_known_received.Load(
+                  MemoryOrder::RELAXED)),
+          drop_token_counts(std::move(that.drop_token_counts)) {}
+
+    Atomic<int64_t> num_calls_started{0};
+    Atomic<int64_t> num_calls_finished{0};
+    Atomic<int64_t> num_calls_finished_with_client_failed_to_send{0};
+    Atomic<int64_t> num_calls_finished_known_received{0};
+    Mutex drop_count_mu;  // Guards drop_token_counts.
+    UniquePtr<DroppedCallCounts> drop_token_counts;
+  } GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+
+  PerCpuData& CurrentCpuData();
+
+  // Really zero-sized, but 0-sized arrays are illegal on MSVC.
+  InlinedVector<PerCpuData, 1> per_cpu_data_;
 };
 
 }  // namespace grpc_core
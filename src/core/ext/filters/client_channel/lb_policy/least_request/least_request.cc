@@ -0,0 +1,606 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Least Request Policy.
+ *
+ * Connects to every address like round_robin, but rather than cycling through
+ * the READY subchannels, every pick samples \a choiceCount (2 by default) of
+ * them at random and returns the one with the fewest calls in flight (the
+ * "power of two choices"), so that a slow backend, on which calls pile up,
+ * gets fewer new ones. Calls are counted from the pick until their trailing
+ * metadata is received. The policy is configured in the service config as
+ *
+ *   "loadBalancingConfig": [ { "least_request": { "choiceCount": 2 } } ]
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_least_request_trace(false, "least_request");
+
+namespace {
+
+//
+// least_request LB policy
+//
+
+constexpr char kLeastRequest[] = "least_request";
+
+// Number of READY subchannels sampled by each pick, unless configured
+// otherwise.
+constexpr uint32_t kDefaultChoiceCount = 2;
+
+class ParsedLeastRequestConfig : public LoadBalancingPolicy::Config {
+ public:
+  explicit ParsedLeastRequestConfig(uint32_t choice_count)
+      : choice_count_(choice_count) {}
+
+  const char* name() const override { return kLeastRequest; }
+
+  uint32_t choice_count() const { return choice_count_; }
+
+ private:
+  const uint32_t choice_count_;
+};
+
+class LeastRequest : public LoadBalancingPolicy {
+ public:
+  explicit LeastRequest(Args args);
+
+  const char* name() const override { return kLeastRequest; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~LeastRequest();
+
+  // Forward declaration.
+  class LeastRequestSubchannelList;
+
+  // Number of calls in flight on a subchannel. Incremented by the picker
+  // and decremented when a call's trailing metadata is received, so it is
+  // shared with the calls, which can outlive both the picker and the
+  // subchannel list.
+  class CallCounter : public RefCounted<CallCounter> {
+   public:
+    uintptr_t Load() const { return in_flight_.Load(MemoryOrder::RELAXED); }
+    void Increment() { in_flight_.FetchAdd(1, MemoryOrder::RELAXED); }
+    void Decrement() { in_flight_.FetchSub(1, MemoryOrder::RELAXED); }
+
+   private:
+    Atomic<uintptr_t> in_flight_{0};
+  };
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the subchannel's call counter.
+  class LeastRequestSubchannelData
+      : public SubchannelData<LeastRequestSubchannelList,
+                              LeastRequestSubchannelData> {
+   public:
+    LeastRequestSubchannelData(
+        SubchannelList<LeastRequestSubchannelList, LeastRequestSubchannelData>*
+            subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)),
+          call_counter_(MakeRefCounted<CallCounter>()) {}
+
+    grpc_connectivity_state connectivity_state() const {
+      return last_connectivity_state_;
+    }
+
+    const RefCountedPtr<CallCounter>& call_counter() const {
+      return call_counter_;
+    }
+
+    void UpdateConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    RefCountedPtr<CallCounter> call_counter_;
+  };
+
+  // A list of subchannels.
+  class LeastRequestSubchannelList
+      : public SubchannelList<LeastRequestSubchannelList,
+                              LeastRequestSubchannelData> {
+   public:
+    LeastRequestSubchannelList(LeastRequest* policy, TraceFlag* tracer,
+                               const ServerAddressList& addresses,
+                               const grpc_channel_args& args)
+        : SubchannelList(policy, tracer, addresses,
+                         policy->channel_control_helper(), args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~LeastRequestSubchannelList() {
+      LeastRequest* p = static_cast<LeastRequest*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked();
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // If this subchannel list is the LR policy's current subchannel
+    // list, updates the LR policy's connectivity state based on the
+    // subchannel list's state counters.
+    void MaybeUpdateLeastRequestConnectivityStateLocked();
+
+    // Updates the LR policy's overall state based on the counters of
+    // subchannels in each state.
+    void UpdateLeastRequestStateFromSubchannelStateCountsLocked();
+
+   private:
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(LeastRequest* parent, LeastRequestSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    struct ReadySubchannel {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<CallCounter> call_counter;
+    };
+
+    // Runs when the trailing metadata of a call picked for a subchannel is
+    // received, outside of the LB policy's combiner.
+    static void RecordCallCompletion(
+        void* arg, grpc_error* error,
+        LoadBalancingPolicy::MetadataInterface* recv_trailing_metadata,
+        LoadBalancingPolicy::CallState* call_state);
+
+    // Using pointer value only, no ref held -- do not dereference!
+    LeastRequest* parent_;
+
+    const uint32_t choice_count_;
+    InlinedVector<ReadySubchannel, 10> subchannels_;
+  };
+
+  void ShutdownLocked() override;
+
+  /** number of READY subchannels sampled by each pick */
+  uint32_t choice_count_ = kDefaultChoiceCount;
+  /** list of subchannels */
+  OrphanablePtr<LeastRequestSubchannelList> subchannel_list_;
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  OrphanablePtr<LeastRequestSubchannelList> latest_pending_subchannel_list_;
+  /** are we shutting down? */
+  bool shutdown_ = false;
+};
+
+//
+// LeastRequest::Picker
+//
+
+LeastRequest::Picker::Picker(LeastRequest* parent,
+                             LeastRequestSubchannelList* subchannel_list)
+    : parent_(parent), choice_count_(parent->choice_count_) {
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    LeastRequestSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      subchannels_.push_back(
+          ReadySubchannel{sd->subchannel()->Ref(), sd->call_counter()});
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO,
+            "[LR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels; choice_count=%u",
+            parent_, this, subchannel_list, subchannels_.size(),
+            choice_count_);
+  }
+}
+
+LeastRequest::PickResult LeastRequest::Picker::Pick(PickArgs args) {
+  // Sample choice_count_ subchannels at random, with replacement, and keep
+  // the one with the fewest calls in flight.  A subchannel whose connection
+  // has no stream left loses to one that can start the call right away.
+  // TODO(roth): rand(3) is not thread-safe.  This should be replaced with
+  // something better as part of https://github.com/grpc/grpc/issues/17891.
+  size_t index = rand() % subchannels_.size();
+  uintptr_t in_flight = subchannels_[index].call_counter->Load();
+  bool saturated = subchannels_[index].subchannel->GetAvailableStreams() <= 0;
+  for (uint32_t i = 1; i < choice_count_ && subchannels_.size() > 1; ++i) {
+    const size_t candidate = rand() % subchannels_.size();
+    const uintptr_t candidate_in_flight =
+        subchannels_[candidate].call_counter->Load();
+    const bool candidate_saturated =
+        subchannels_[candidate].subchannel->GetAvailableStreams() <= 0;
+    if (candidate_saturated != saturated ? saturated
+                                         : candidate_in_flight < in_flight) {
+      index = candidate;
+      in_flight = candidate_in_flight;
+      saturated = candidate_saturated;
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO,
+            "[LR %p picker %p] returning index %" PRIuPTR
+            ", subchannel=%p, in_flight=%" PRIuPTR,
+            parent_, this, index, subchannels_[index].subchannel.get(),
+            in_flight);
+  }
+  CallCounter* call_counter = subchannels_[index].call_counter.get();
+  call_counter->Increment();
+  PickResult result;
+  result.type = PickResult::PICK_COMPLETE;
+  result.subchannel = subchannels_[index].subchannel;
+  // Intercept the recv_trailing_metadata op to record call completion.
+  result.recv_trailing_metadata_ready = RecordCallCompletion;
+  result.recv_trailing_metadata_ready_user_data =
+      call_counter->Ref().release();
+  return result;
+}
+
+void LeastRequest::Picker::RecordCallCompletion(
+    void* arg, grpc_error* error,
+    LoadBalancingPolicy::MetadataInterface* recv_trailing_metadata,
+    LoadBalancingPolicy::CallState* call_state) {
+  CallCounter* call_counter = static_cast<CallCounter*>(arg);
+  call_counter->Decrement();
+  call_counter->Unref();
+}
+
+//
+// LeastRequest
+//
+
+LeastRequest::LeastRequest(Args args) : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Created", this);
+  }
+}
+
+LeastRequest::~LeastRequest() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Destroying Least Request policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void LeastRequest::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void LeastRequest::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+void LeastRequest::LeastRequestSubchannelList::StartWatchingLocked() {
+  if (num_subchannels() == 0) return;
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->subchannel()->AttemptToConnect();
+    }
+  }
+  // Now set the LB policy's state based on the subchannels' states.
+  UpdateLeastRequestStateFromSubchannelStateCountsLocked();
+}
+
+void LeastRequest::LeastRequestSubchannelList::UpdateStateCountersLocked(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+// Sets the LR policy's connectivity state and generates a new picker based
+// on the current subchannel list.
+void LeastRequest::LeastRequestSubchannelList::
+    MaybeUpdateLeastRequestConnectivityStateLocked() {
+  LeastRequest* p = static_cast<LeastRequest*>(policy());
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  /* In priority order. The first rule to match terminates the search (ie, if we
+   * are on rule n, all previous rules were unfulfilled).
+   *
+   * 1) RULE: ANY subchannel is READY => policy is READY.
+   *    CHECK: subchannel_list->num_ready > 0.
+   *
+   * 2) RULE: ANY subchannel is CONNECTING => policy is CONNECTING.
+   *    CHECK: sd->curr_connectivity_state == CONNECTING.
+   *
+   * 3) RULE: ALL subchannels are TRANSIENT_FAILURE => policy is
+   *                                                   TRANSIENT_FAILURE.
+   *    CHECK: subchannel_list->num_transient_failures ==
+   *           subchannel_list->num_subchannels.
+   */
+  if (num_ready_ > 0) {
+    /* 1) READY */
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, UniquePtr<SubchannelPicker>(New<Picker>(p, this)));
+  } else if (num_connecting_ > 0) {
+    /* 2) CONNECTING */
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, UniquePtr<SubchannelPicker>(New<QueuePicker>(
+                                     p->Ref(DEBUG_LOCATION, "QueuePicker"))));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    /* 3) TRANSIENT_FAILURE */
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                               "connections to all backends failing"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        UniquePtr<SubchannelPicker>(New<TransientFailurePicker>(error)));
+  }
+}
+
+void LeastRequest::LeastRequestSubchannelList::
+    UpdateLeastRequestStateFromSubchannelStateCountsLocked() {
+  LeastRequest* p = static_cast<LeastRequest*>(policy());
+  if (num_ready_ > 0) {
+    if (p->subchannel_list_.get() != this) {
+      // Promote this list to p->subchannel_list_.
+      // This list must be p->latest_pending_subchannel_list_, because
+      // any previous update would have been shut down already and
+      // therefore we would not be receiving a notification for them.
+      GPR_ASSERT(p->latest_pending_subchannel_list_.get() == this);
+      GPR_ASSERT(!shutting_down());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+        const size_t old_num_subchannels =
+            p->subchannel_list_ != nullptr
+                ? p->subchannel_list_->num_subchannels()
+                : 0;
+        gpr_log(GPR_INFO,
+                "[LR %p] phasing out subchannel list %p (size %" PRIuPTR
+                ") in favor of %p (size %" PRIuPTR ")",
+                p, p->subchannel_list_.get(), old_num_subchannels, this,
+                num_subchannels());
+      }
+      p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+    }
+  }
+  // Update the LR policy's connectivity state if needed.
+  MaybeUpdateLeastRequestConnectivityStateLocked();
+}
+
+void LeastRequest::LeastRequestSubchannelData::UpdateConnectivityStateLocked(
+    grpc_connectivity_state connectivity_state) {
+  LeastRequest* p = static_cast<LeastRequest*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[LR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        grpc_connectivity_state_name(last_connectivity_state_),
+        grpc_connectivity_state_name(connectivity_state));
+  }
+  subchannel_list()->UpdateStateCountersLocked(last_connectivity_state_,
+                                               connectivity_state);
+  last_connectivity_state_ = connectivity_state;
+}
+
+void LeastRequest::LeastRequestSubchannelData::ProcessConnectivityChangeLocked(
+    grpc_connectivity_state connectivity_state) {
+  LeastRequest* p = static_cast<LeastRequest*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE, re-resolve.
+  // Only do this if we've started watching, not at startup time.
+  // Otherwise, if the subchannel was already in state TRANSIENT_FAILURE
+  // when the subchannel list was created, we'd wind up in a constant
+  // loop of re-resolution.
+  // Also attempt to reconnect.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] Subchannel %p has gone into TRANSIENT_FAILURE. "
+              "Requesting re-resolution",
+              p, subchannel());
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->AttemptToConnect();
+  }
+  // Update state counters.
+  UpdateConnectivityStateLocked(connectivity_state);
+  // Update overall state and renew notification.
+  subchannel_list()->UpdateLeastRequestStateFromSubchannelStateCountsLocked();
+}
+
+void LeastRequest::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] received update with %" PRIuPTR " addresses",
+            this, args.addresses.size());
+  }
+  // Pickers created from now on use the new choice count.
+  choice_count_ =
+      args.config != nullptr
+          ? static_cast<const ParsedLeastRequestConfig*>(args.config.get())
+                ->choice_count()
+          : kDefaultChoiceCount;
+  // Replace latest_pending_subchannel_list_.
+  if (latest_pending_subchannel_list_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] Shutting down previous pending subchannel list %p", this,
+              latest_pending_subchannel_list_.get());
+    }
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<LeastRequestSubchannelList>(
+      this, &grpc_lb_least_request_trace, args.addresses, *args.args);
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    // If the new list is empty, immediately promote the new list to the
+    // current list and transition to TRANSIENT_FAILURE.
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        UniquePtr<SubchannelPicker>(New<TransientFailurePicker>(error)));
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  } else if (subchannel_list_ == nullptr) {
+    // If there is no current list, immediately promote the new list to
+    // the current list and start watching it.
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    subchannel_list_->StartWatchingLocked();
+  } else {
+    // Start watching the pending list.  It will get swapped into the
+    // current list when it reports READY.
+    latest_pending_subchannel_list_->StartWatchingLocked();
+  }
+}
+
+//
+// factory
+//
+
+class LeastRequestFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return OrphanablePtr<LoadBalancingPolicy>(
+        New<LeastRequest>(std::move(args)));
+  }
+
+  const char* name() const override { return kLeastRequest; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const grpc_json* json, grpc_error** error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    uint32_t choice_count = kDefaultChoiceCount;
+    if (json != nullptr) {
+      GPR_DEBUG_ASSERT(strcmp(json->key, name()) == 0);
+      InlinedVector<grpc_error*, 2> error_list;
+      bool seen_choice_count = false;
+      for (const grpc_json* field = json->child; field != nullptr;
+           field = field->next) {
+        if (field->key == nullptr) continue;
+        if (strcmp(field->key, "choiceCount") == 0) {
+          if (seen_choice_count) {
+            error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "field:choiceCount error:Duplicate entry"));
+            continue;
+          }
+          seen_choice_count = true;
+          int value = field->type == GRPC_JSON_NUMBER
+                          ? gpr_parse_nonnegative_int(field->value)
+                          : -1;
+          if (value < 2) {
+            error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "field:choiceCount error:should be a number of at least 2"));
+            continue;
+          }
+          choice_count = static_cast<uint32_t>(value);
+        }
+      }
+      if (!error_list.empty()) {
+        *error = GRPC_ERROR_CREATE_FROM_VECTOR("LeastRequest Parser",
+                                               &error_list);
+        return nullptr;
+      }
+    }
+    return RefCountedPtr<LoadBalancingPolicy::Config>(
+        New<ParsedLeastRequestConfig>(choice_count));
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_least_request_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          grpc_core::UniquePtr<grpc_core::LoadBalancingPolicyFactory>(
+              grpc_core::New<grpc_core::LeastRequestFactory>()));
+}
+
+void grpc_lb_policy_least_request_shutdown() {}
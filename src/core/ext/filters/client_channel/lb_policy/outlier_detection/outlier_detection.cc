@@ -0,0 +1,899 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Outlier Detection Policy.
+ *
+ * Wraps a child policy (round_robin by default) and tracks the outcome of
+ * the calls sent to each address. Every \a intervalMs, it ejects the
+ * addresses whose calls failed \a consecutiveFailures times in a row, or
+ * whose success rate is more than \a successRateStdevFactor standard
+ * deviations below the mean of the addresses that got at least
+ * \a successRateRequestVolume calls (if at least \a successRateMinimumHosts
+ * did). The subchannels of an ejected address look TRANSIENT_FAILURE to the
+ * child policy, which thus stops picking them although they are connected.
+ * An address is brought back after \a baseEjectionTimeMs times the number of
+ * times in a row it was ejected. No more than \a maxEjectionPercent of the
+ * addresses are ejected at a time, except that one address can always be.
+ * Calls count as failed when they fail with a status that indicates a server
+ * error, like the server_load_reporting filter does. The policy is
+ * configured in the service config as
+ *
+ *   "loadBalancingConfig": [ { "outlier_detection": {
+ *     "childPolicy": [ { "round_robin": {} } ],
+ *     "intervalMs": 10000,
+ *     "baseEjectionTimeMs": 30000,
+ *     "maxEjectionPercent": 10,
+ *     "consecutiveFailures": 5,
+ *     "successRateStdevFactor": 1.9,
+ *     "successRateMinimumHosts": 5,
+ *     "successRateRequestVolume": 100
+ *   } } ]
+ *
+ * where 0 disables the consecutive failure and success rate ejections,
+ * respectively, for \a consecutiveFailures and \a successRateMinimumHosts.
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/inlined_vector.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/iomgr/timer.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_outlier_detection_trace(false, "outlier_detection");
+
+namespace {
+
+//
+// outlier_detection LB policy
+//
+
+constexpr char kOutlierDetection[] = "outlier_detection";
+
+// Ejection times do not grow beyond this one, or beyond the base ejection
+// time if it is longer.
+constexpr grpc_millis kMaxEjectionTimeMs = 300 * 1000;
+
+class ParsedOutlierDetectionConfig : public LoadBalancingPolicy::Config {
+ public:
+  struct Parameters {
+    grpc_millis interval = 10 * 1000;
+    grpc_millis base_ejection_time = 30 * 1000;
+    uint32_t max_ejection_percent = 10;
+    uint32_t consecutive_failures = 5;
+    double success_rate_stdev_factor = 1.9;
+    uint32_t success_rate_minimum_hosts = 5;
+    uint32_t success_rate_request_volume = 100;
+  };
+
+  ParsedOutlierDetectionConfig(
+      RefCountedPtr<LoadBalancingPolicy::Config> child_policy,
+      const Parameters& parameters)
+      : child_policy_(std::move(child_policy)), parameters_(parameters) {}
+
+  const char* name() const override { return kOutlierDetection; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy() const {
+    return child_policy_;
+  }
+  const Parameters& parameters() const { return parameters_; }
+
+ private:
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy_;
+  const Parameters parameters_;
+};
+
+class OutlierDetection : public LoadBalancingPolicy {
+ public:
+  explicit OutlierDetection(Args args);
+
+  const char* name() const override { return kOutlierDetection; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ExitIdleLocked() override;
+  void ResetBackoffLocked() override;
+
+ private:
+  // Forward declaration.
+  class SubchannelWrapper;
+
+  // The call outcomes and ejection state of an address, shared by the
+  // subchannels the child policy creates for it. The counters are updated
+  // when the trailing metadata of a call is received; everything else is
+  // only accessed in the combiner.
+  class AddressState : public RefCounted<AddressState> {
+   public:
+    void RecordCallOutcome(bool success) {
+      if (success) {
+        successes_.FetchAdd(1, MemoryOrder::RELAXED);
+        consecutive_failures_.Store(0, MemoryOrder::RELAXED);
+      } else {
+        failures_.FetchAdd(1, MemoryOrder::RELAXED);
+        consecutive_failures_.FetchAdd(1, MemoryOrder::RELAXED);
+      }
+    }
+
+    // Moves the counts of the interval that just ended to
+    // interval_successes() and interval_failures().
+    void EndIntervalLocked() {
+      interval_successes_ = successes_.Exchange(0, MemoryOrder::RELAXED);
+      interval_failures_ = failures_.Exchange(0, MemoryOrder::RELAXED);
+    }
+    uint64_t interval_successes() const { return interval_successes_; }
+    uint64_t interval_failures() const { return interval_failures_; }
+
+    uint32_t consecutive_failures() const {
+      return consecutive_failures_.Load(MemoryOrder::RELAXED);
+    }
+
+    bool ejected() const { return ejected_; }
+    grpc_millis ejection_time() const { return ejection_time_; }
+    uint32_t ejection_multiplier() const { return ejection_multiplier_; }
+    void DecrementEjectionMultiplierLocked() {
+      if (ejection_multiplier_ > 0) --ejection_multiplier_;
+    }
+
+    void EjectLocked(grpc_millis now);
+    void UnejectLocked();
+
+    void AddSubchannelLocked(SubchannelWrapper* subchannel) {
+      subchannels_.push_back(subchannel);
+    }
+    void RemoveSubchannelLocked(SubchannelWrapper* subchannel);
+
+   private:
+    Atomic<uint64_t> successes_{0};
+    Atomic<uint64_t> failures_{0};
+    Atomic<uint32_t> consecutive_failures_{0};
+    uint64_t interval_successes_ = 0;
+    uint64_t interval_failures_ = 0;
+    bool ejected_ = false;
+    grpc_millis ejection_time_ = 0;
+    uint32_t ejection_multiplier_ = 0;
+    InlinedVector<SubchannelWrapper*, 1> subchannels_;
+  };
+
+  // Handed to the child policy in place of the subchannels it creates, so
+  // that the subchannels of ejected addresses can look TRANSIENT_FAILURE.
+  class SubchannelWrapper : public SubchannelInterface {
+   public:
+    SubchannelWrapper(RefCountedPtr<SubchannelInterface> subchannel,
+                      RefCountedPtr<AddressState> address_state)
+        : subchannel_(std::move(subchannel)),
+          address_state_(std::move(address_state)) {
+      if (address_state_ != nullptr) address_state_->AddSubchannelLocked(this);
+    }
+
+    ~SubchannelWrapper() {
+      if (address_state_ != nullptr) {
+        address_state_->RemoveSubchannelLocked(this);
+      }
+    }
+
+    SubchannelInterface* wrapped_subchannel() const {
+      return subchannel_.get();
+    }
+    AddressState* address_state() const { return address_state_.get(); }
+
+    // Invoked when the address is ejected or brought back.
+    void EjectLocked();
+    void UnejectLocked();
+
+    grpc_connectivity_state CheckConnectivityState() override {
+      if (ejected()) return GRPC_CHANNEL_TRANSIENT_FAILURE;
+      return subchannel_->CheckConnectivityState();
+    }
+
+    void WatchConnectivityState(
+        grpc_connectivity_state initial_state,
+        UniquePtr<ConnectivityStateWatcherInterface> watcher) override;
+
+    void CancelConnectivityStateWatch(
+        ConnectivityStateWatcherInterface* watcher) override;
+
+    void AttemptToConnect() override { subchannel_->AttemptToConnect(); }
+
+    void ResetBackoff() override { subchannel_->ResetBackoff(); }
+
+    const grpc_channel_args* channel_args() override {
+      return subchannel_->channel_args();
+    }
+
+    int32_t GetAvailableStreams() override {
+      return subchannel_->GetAvailableStreams();
+    }
+
+   private:
+    // Forwards the connectivity state changes of the wrapped subchannel,
+    // except while the address is ejected.
+    class WatcherWrapper : public ConnectivityStateWatcherInterface {
+     public:
+      WatcherWrapper(UniquePtr<ConnectivityStateWatcherInterface> watcher,
+                     grpc_connectivity_state initial_state, bool ejected)
+          : watcher_(std::move(watcher)),
+            last_seen_state_(initial_state),
+            ejected_(ejected) {}
+
+      ConnectivityStateWatcherInterface* watcher() const {
+        return watcher_.get();
+      }
+
+      void OnConnectivityStateChange(
+          grpc_connectivity_state new_state) override {
+        last_seen_state_ = new_state;
+        if (!ejected_) watcher_->OnConnectivityStateChange(new_state);
+      }
+
+      grpc_pollset_set* interested_parties() override {
+        return watcher_->interested_parties();
+      }
+
+      void Eject() {
+        ejected_ = true;
+        if (last_seen_state_ != GRPC_CHANNEL_TRANSIENT_FAILURE) {
+          watcher_->OnConnectivityStateChange(GRPC_CHANNEL_TRANSIENT_FAILURE);
+        }
+      }
+
+      void Uneject() {
+        ejected_ = false;
+        if (last_seen_state_ != GRPC_CHANNEL_TRANSIENT_FAILURE) {
+          watcher_->OnConnectivityStateChange(last_seen_state_);
+        }
+      }
+
+     private:
+      UniquePtr<ConnectivityStateWatcherInterface> watcher_;
+      grpc_connectivity_state last_seen_state_;
+      bool ejected_;
+    };
+
+    bool ejected() const {
+      return address_state_ != nullptr && address_state_->ejected();
+    }
+
+    RefCountedPtr<SubchannelInterface> subchannel_;
+    RefCountedPtr<AddressState> address_state_;
+    // Owned by subchannel_; null when not watching.
+    WatcherWrapper* watcher_wrapper_ = nullptr;
+  };
+
+  using AddressMap =
+      Map<UniquePtr<char>, RefCountedPtr<AddressState>, StringLess>;
+
+  // Wraps the child policy's picker, to unwrap the picked subchannels and
+  // track the outcome of the calls sent to them.
+  class Picker : public SubchannelPicker {
+   public:
+    explicit Picker(UniquePtr<SubchannelPicker> child_picker)
+        : child_picker_(std::move(child_picker)) {}
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // What is needed to record the outcome of a call and to chain to the
+    // child policy's callback.
+    struct CallTracker {
+      AddressState* address_state;
+      void (*child_recv_trailing_metadata_ready)(
+          void* user_data, grpc_error* error,
+          MetadataInterface* recv_trailing_metadata, CallState* call_state);
+      void* child_recv_trailing_metadata_ready_user_data;
+    };
+
+    // Runs when the trailing metadata of a picked call is received, outside
+    // of the LB policy's combiner.
+    static void RecordCallCompletion(void* arg, grpc_error* error,
+                                     MetadataInterface* recv_trailing_metadata,
+                                     CallState* call_state);
+
+    UniquePtr<SubchannelPicker> child_picker_;
+  };
+
+  class Helper : public ChannelControlHelper {
+   public:
+    explicit Helper(RefCountedPtr<OutlierDetection> parent)
+        : parent_(std::move(parent)) {}
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        const grpc_channel_args& args) override;
+    grpc_channel* CreateChannel(const char* target,
+                                const grpc_channel_args& args) override;
+    void UpdateState(grpc_connectivity_state state,
+                     UniquePtr<SubchannelPicker> picker) override;
+    void RequestReresolution() override;
+    void AddTraceEvent(TraceSeverity severity, const char* message) override;
+
+    void set_child(LoadBalancingPolicy* child) { child_ = child; }
+
+   private:
+    bool CalledByCurrentChild() const {
+      GPR_ASSERT(child_ != nullptr);
+      return child_ == parent_->child_policy_.get();
+    }
+
+    RefCountedPtr<OutlierDetection> parent_;
+    LoadBalancingPolicy* child_ = nullptr;
+  };
+
+  ~OutlierDetection();
+
+  void ShutdownLocked() override;
+
+  OrphanablePtr<LoadBalancingPolicy> CreateChildPolicyLocked(
+      const char* name, const grpc_channel_args* args);
+
+  void StartIntervalTimerLocked();
+  static void OnIntervalTimerLocked(void* arg, grpc_error* error);
+  // Ejects the outliers among the addresses and brings back the ones whose
+  // ejection time has elapsed.
+  void RunEjectionSweepLocked();
+
+  /** latest config */
+  RefCountedPtr<ParsedOutlierDetectionConfig> config_;
+  /** state of the addresses of the latest update */
+  AddressMap addresses_;
+  /** the child policy */
+  OrphanablePtr<LoadBalancingPolicy> child_policy_;
+  /** are we shutting down? */
+  bool shutting_down_ = false;
+  /** timer running the ejection sweeps */
+  bool interval_timer_pending_ = false;
+  grpc_timer interval_timer_;
+  grpc_closure on_interval_timer_;
+};
+
+//
+// OutlierDetection::AddressState
+//
+
+void OutlierDetection::AddressState::EjectLocked(grpc_millis now) {
+  ejected_ = true;
+  ejection_time_ = now;
+  ++ejection_multiplier_;
+  consecutive_failures_.Store(0, MemoryOrder::RELAXED);
+  for (size_t i = 0; i < subchannels_.size(); ++i) {
+    subchannels_[i]->EjectLocked();
+  }
+}
+
+void OutlierDetection::AddressState::UnejectLocked() {
+  ejected_ = false;
+  for (size_t i = 0; i < subchannels_.size(); ++i) {
+    subchannels_[i]->UnejectLocked();
+  }
+}
+
+void OutlierDetection::AddressState::RemoveSubchannelLocked(
+    SubchannelWrapper* subchannel) {
+  for (size_t i = 0; i < subchannels_.size(); ++i) {
+    if (subchannels_[i] == subchannel) {
+      subchannels_[i] = subchannels_[subchannels_.size() - 1];
+      subchannels_.pop_back();
+      return;
+    }
+  }
+}
+
+//
+// OutlierDetection::SubchannelWrapper
+//
+
+void OutlierDetection::SubchannelWrapper::EjectLocked() {
+  if (watcher_wrapper_ != nullptr) watcher_wrapper_->Eject();
+}
+
+void OutlierDetection::SubchannelWrapper::UnejectLocked() {
+  if (watcher_wrapper_ != nullptr) watcher_wrapper_->Uneject();
+}
+
+void OutlierDetection::SubchannelWrapper::WatchConnectivityState(
+    grpc_connectivity_state initial_state,
+    UniquePtr<ConnectivityStateWatcherInterface> watcher) {
+  watcher_wrapper_ =
+      New<WatcherWrapper>(std::move(watcher), initial_state, ejected());
+  subchannel_->WatchConnectivityState(
+      initial_state,
+      UniquePtr<ConnectivityStateWatcherInterface>(watcher_wrapper_));
+}
+
+void OutlierDetection::SubchannelWrapper::CancelConnectivityStateWatch(
+    ConnectivityStateWatcherInterface* watcher) {
+  if (watcher_wrapper_ == nullptr || watcher_wrapper_->watcher() != watcher) {
+    return;
+  }
+  subchannel_->CancelConnectivityStateWatch(watcher_wrapper_);
+  watcher_wrapper_ = nullptr;
+}
+
+//
+// OutlierDetection::Picker
+//
+
+OutlierDetection::PickResult OutlierDetection::Picker::Pick(PickArgs args) {
+  PickResult result = child_picker_->Pick(args);
+  if (result.type != PickResult::PICK_COMPLETE ||
+      result.subchannel == nullptr) {
+    return result;
+  }
+  // All the child's subchannels were created by our helper.
+  SubchannelWrapper* subchannel =
+      static_cast<SubchannelWrapper*>(result.subchannel.get());
+  AddressState* address_state = subchannel->address_state();
+  result.subchannel = subchannel->wrapped_subchannel()->Ref();
+  if (address_state != nullptr) {
+    // Wrap the child's recv_trailing_metadata callback, if any.
+    CallTracker* tracker = static_cast<CallTracker*>(
+        args.call_state->Alloc(sizeof(CallTracker)));
+    tracker->address_state = address_state->Ref().release();
+    tracker->child_recv_trailing_metadata_ready =
+        result.recv_trailing_metadata_ready;
+    tracker->child_recv_trailing_metadata_ready_user_data =
+        result.recv_trailing_metadata_ready_user_data;
+    result.recv_trailing_metadata_ready = RecordCallCompletion;
+    result.recv_trailing_metadata_ready_user_data = tracker;
+  }
+  return result;
+}
+
+void OutlierDetection::Picker::RecordCallCompletion(
+    void* arg, grpc_error* error, MetadataInterface* recv_trailing_metadata,
+    CallState* call_state) {
+  CallTracker* tracker = static_cast<CallTracker*>(arg);
+  // Only statuses that indicate a server error count as failures, so that
+  // calls rejected by the application on their merits do not get a backend
+  // ejected.
+  bool success = error == GRPC_ERROR_NONE;
+  if (success && recv_trailing_metadata != nullptr) {
+    const StringView status_key("grpc-status");
+    for (MetadataInterface::Iterator it = recv_trailing_metadata->Begin();
+         !recv_trailing_metadata->IsEnd(it);
+         recv_trailing_metadata->Next(&it)) {
+      if (!(recv_trailing_metadata->Key(it) == status_key)) continue;
+      const StringView value = recv_trailing_metadata->Value(it);
+      int status = GRPC_STATUS_OK;
+      if (value.size() > 0 && value.size() < 4) {
+        char buf[4];
+        memcpy(buf, value.data(), value.size());
+        buf[value.size()] = '\0';
+        status = atoi(buf);
+      }
+      switch (status) {
+        case GRPC_STATUS_UNKNOWN:
+        case GRPC_STATUS_DEADLINE_EXCEEDED:
+        case GRPC_STATUS_UNIMPLEMENTED:
+        case GRPC_STATUS_INTERNAL:
+        case GRPC_STATUS_UNAVAILABLE:
+        case GRPC_STATUS_DATA_LOSS:
+          success = false;
+          break;
+        default:
+          break;
+      }
+      break;
+    }
+  }
+  tracker->address_state->RecordCallOutcome(success);
+  tracker->address_state->Unref();
+  if (tracker->child_recv_trailing_metadata_ready != nullptr) {
+    tracker->child_recv_trailing_metadata_ready(
+        tracker->child_recv_trailing_metadata_ready_user_data, error,
+        recv_trailing_metadata, call_state);
+  }
+}
+
+//
+// OutlierDetection::Helper
+//
+
+RefCountedPtr<SubchannelInterface> OutlierDetection::Helper::CreateSubchannel(
+    const grpc_channel_args& args) {
+  if (parent_->shutting_down_ || !CalledByCurrentChild()) return nullptr;
+  RefCountedPtr<SubchannelInterface> subchannel =
+      parent_->channel_control_helper()->CreateSubchannel(args);
+  if (subchannel == nullptr) return nullptr;
+  RefCountedPtr<AddressState> address_state;
+  const char* address =
+      grpc_channel_args_find_string(&args, GRPC_ARG_SUBCHANNEL_ADDRESS);
+  if (address != nullptr) {
+    auto it = parent_->addresses_.find(UniquePtr<char>(gpr_strdup(address)));
+    if (it != parent_->addresses_.end()) address_state = it->second;
+  }
+  return MakeRefCounted<SubchannelWrapper>(std::move(subchannel),
+                                           std::move(address_state));
+}
+
+grpc_channel* OutlierDetection::Helper::CreateChannel(
+    const char* target, const grpc_channel_args& args) {
+  if (parent_->shutting_down_ || !CalledByCurrentChild()) return nullptr;
+  return parent_->channel_control_helper()->CreateChannel(target, args);
+}
+
+void OutlierDetection::Helper::UpdateState(grpc_connectivity_state state,
+                                           UniquePtr<SubchannelPicker> picker) {
+  if (parent_->shutting_down_ || !CalledByCurrentChild()) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection %p] child reports state=%s",
+            parent_.get(), grpc_connectivity_state_name(state));
+  }
+  parent_->channel_control_helper()->UpdateState(
+      state, UniquePtr<SubchannelPicker>(New<Picker>(std::move(picker))));
+}
+
+void OutlierDetection::Helper::RequestReresolution() {
+  if (parent_->shutting_down_ || !CalledByCurrentChild()) return;
+  parent_->channel_control_helper()->RequestReresolution();
+}
+
+void OutlierDetection::Helper::AddTraceEvent(TraceSeverity severity,
+                                             const char* message) {
+  if (parent_->shutting_down_ || !CalledByCurrentChild()) return;
+  parent_->channel_control_helper()->AddTraceEvent(severity, message);
+}
+
+//
+// OutlierDetection
+//
+
+OutlierDetection::OutlierDetection(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  GRPC_CLOSURE_INIT(&on_interval_timer_,
+                    &OutlierDetection::OnIntervalTimerLocked, this,
+                    grpc_combiner_scheduler(combiner()));
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection %p] Created", this);
+  }
+}
+
+OutlierDetection::~OutlierDetection() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection %p] Destroying", this);
+  }
+  GPR_ASSERT(child_policy_ == nullptr);
+}
+
+void OutlierDetection::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection %p] Shutting down", this);
+  }
+  shutting_down_ = true;
+  if (interval_timer_pending_) grpc_timer_cancel(&interval_timer_);
+  if (child_policy_ != nullptr) {
+    grpc_pollset_set_del_pollset_set(child_policy_->interested_parties(),
+                                     interested_parties());
+    child_policy_.reset();
+  }
+}
+
+void OutlierDetection::ExitIdleLocked() {
+  if (child_policy_ != nullptr) child_policy_->ExitIdleLocked();
+}
+
+void OutlierDetection::ResetBackoffLocked() {
+  if (child_policy_ != nullptr) child_policy_->ResetBackoffLocked();
+}
+
+OrphanablePtr<LoadBalancingPolicy> OutlierDetection::CreateChildPolicyLocked(
+    const char* name, const grpc_channel_args* args) {
+  Helper* helper = New<Helper>(Ref());
+  LoadBalancingPolicy::Args lb_policy_args;
+  lb_policy_args.combiner = combiner();
+  lb_policy_args.args = args;
+  lb_policy_args.channel_control_helper =
+      UniquePtr<ChannelControlHelper>(helper);
+  OrphanablePtr<LoadBalancingPolicy> lb_policy =
+      LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
+          name, std::move(lb_policy_args));
+  if (GPR_UNLIKELY(lb_policy == nullptr)) {
+    gpr_log(GPR_ERROR,
+            "[outlier_detection %p] Failure creating child policy %s", this,
+            name);
+    return nullptr;
+  }
+  helper->set_child(lb_policy.get());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection %p] Created new child policy %s (%p)",
+            this, name, lb_policy.get());
+  }
+  // Add our interested_parties pollset_set to that of the newly created
+  // child policy. This will make the child policy progress upon activity on
+  // this policy, which in turn is tied to the application's call.
+  grpc_pollset_set_add_pollset_set(lb_policy->interested_parties(),
+                                   interested_parties());
+  return lb_policy;
+}
+
+void OutlierDetection::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO,
+            "[outlier_detection %p] received update with %" PRIuPTR
+            " addresses",
+            this, args.addresses.size());
+  }
+  if (args.config != nullptr) {
+    config_.reset(
+        static_cast<ParsedOutlierDetectionConfig*>(args.config.release()));
+  } else if (config_ == nullptr) {
+    config_ = MakeRefCounted<ParsedOutlierDetectionConfig>(
+        nullptr, ParsedOutlierDetectionConfig::Parameters());
+  }
+  // Keep the state of the addresses that are still there, so that their
+  // ejections survive the update, and drop the others.
+  AddressMap addresses;
+  for (size_t i = 0; i < args.addresses.size(); ++i) {
+    UniquePtr<char> address(grpc_sockaddr_to_uri(&args.addresses[i].address()));
+    auto it = addresses_.find(address);
+    RefCountedPtr<AddressState> address_state =
+        it != addresses_.end() ? it->second : MakeRefCounted<AddressState>();
+    addresses.emplace(std::move(address), std::move(address_state));
+  }
+  addresses_ = std::move(addresses);
+  if (!interval_timer_pending_) StartIntervalTimerLocked();
+  // Create the child policy if needed, or a new one if its name changes.
+  RefCountedPtr<LoadBalancingPolicy::Config> child_config =
+      config_->child_policy();
+  const char* child_policy_name =
+      child_config == nullptr ? "round_robin" : child_config->name();
+  if (child_policy_ == nullptr ||
+      strcmp(child_policy_->name(), child_policy_name) != 0) {
+    if (child_policy_ != nullptr) {
+      grpc_pollset_set_del_pollset_set(child_policy_->interested_parties(),
+                                       interested_parties());
+    }
+    child_policy_ = CreateChildPolicyLocked(child_policy_name, args.args);
+    if (child_policy_ == nullptr) return;
+  }
+  UpdateArgs update_args;
+  update_args.addresses = std::move(args.addresses);
+  update_args.config = std::move(child_config);
+  update_args.args = args.args;
+  args.args = nullptr;
+  child_policy_->UpdateLocked(std::move(update_args));
+}
+
+void OutlierDetection::StartIntervalTimerLocked() {
+  interval_timer_pending_ = true;
+  Ref(DEBUG_LOCATION, "on_interval_timer").release();
+  grpc_timer_init(&interval_timer_,
+                  ExecCtx::Get()->Now() + config_->parameters().interval,
+                  &on_interval_timer_);
+}
+
+void OutlierDetection::OnIntervalTimerLocked(void* arg, grpc_error* error) {
+  OutlierDetection* p = static_cast<OutlierDetection*>(arg);
+  p->interval_timer_pending_ = false;
+  if (error == GRPC_ERROR_NONE && !p->shutting_down_) {
+    p->RunEjectionSweepLocked();
+    p->StartIntervalTimerLocked();
+  }
+  p->Unref(DEBUG_LOCATION, "on_interval_timer");
+}
+
+void OutlierDetection::RunEjectionSweepLocked() {
+  const ParsedOutlierDetectionConfig::Parameters& params =
+      config_->parameters();
+  const grpc_millis now = ExecCtx::Get()->Now();
+  size_t num_ejected = 0;
+  for (auto& p : addresses_) {
+    p.second->EndIntervalLocked();
+    if (p.second->ejected()) ++num_ejected;
+  }
+  auto maybe_eject = [&](const char* address, AddressState* address_state,
+                         const char* reason) {
+    if (num_ejected * 100 >= params.max_ejection_percent * addresses_.size() &&
+        num_ejected > 0) {
+      return;
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+      gpr_log(GPR_INFO, "[outlier_detection %p] ejecting %s: %s", this,
+              address, reason);
+    }
+    address_state->EjectLocked(now);
+    ++num_ejected;
+  };
+  // Success rate ejection.
+  if (params.success_rate_minimum_hosts > 0) {
+    size_t num_candidates = 0;
+    double sum = 0;
+    double sum_of_squares = 0;
+    for (auto& p : addresses_) {
+      const uint64_t volume =
+          p.second->interval_successes() + p.second->interval_failures();
+      if (volume == 0 || volume < params.success_rate_request_volume) continue;
+      const double rate =
+          static_cast<double>(p.second->interval_successes()) / volume;
+      ++num_candidates;
+      sum += rate;
+      sum_of_squares += rate * rate;
+    }
+    if (num_candidates >= params.success_rate_minimum_hosts) {
+      const double mean = sum / num_candidates;
+      const double variance =
+          std::max(sum_of_squares / num_candidates - mean * mean, 0.0);
+      const double threshold =
+          mean - params.success_rate_stdev_factor * sqrt(variance);
+      for (auto& p : addresses_) {
+        if (p.second->ejected()) continue;
+        const uint64_t volume =
+            p.second->interval_successes() + p.second->interval_failures();
+        if (volume == 0 || volume < params.success_rate_request_volume) {
+          continue;
+        }
+        const double rate =
+            static_cast<double>(p.second->interval_successes()) / volume;
+        if (rate < threshold) {
+          maybe_eject(p.first.get(), p.second.get(), "low success rate");
+        }
+      }
+    }
+  }
+  // Consecutive failure ejection.
+  if (params.consecutive_failures > 0) {
+    for (auto& p : addresses_) {
+      if (!p.second->ejected() &&
+          p.second->consecutive_failures() >= params.consecutive_failures) {
+        maybe_eject(p.first.get(), p.second.get(), "consecutive failures");
+      }
+    }
+  }
+  // Bring back the addresses whose ejection time has elapsed; the ones that
+  // are not ejected slowly regain a short ejection time.
+  for (auto& p : addresses_) {
+    AddressState* address_state = p.second.get();
+    if (!address_state->ejected()) {
+      address_state->DecrementEjectionMultiplierLocked();
+      continue;
+    }
+    const grpc_millis ejection_duration =
+        std::min(params.base_ejection_time *
+                     static_cast<grpc_millis>(
+                         address_state->ejection_multiplier()),
+                 std::max(params.base_ejection_time, kMaxEjectionTimeMs));
+    if (now >= address_state->ejection_time() + ejection_duration) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+        gpr_log(GPR_INFO, "[outlier_detection %p] unejecting %s", this,
+                p.first.get());
+      }
+      address_state->UnejectLocked();
+    }
+  }
+}
+
+//
+// factory
+//
+
+// Parses the number in \a field into \a value,  which must be between
+// \a min and \a max. Returns an error otherwise.
+grpc_error* ParseNumber(const grpc_json* field, double min, double max,
+                        double* value) {
+  char* end = nullptr;
+  const double parsed = field->type == GRPC_JSON_NUMBER
+                            ? strtod(field->value, &end)
+                            : min - 1;
+  if (end == nullptr || *end != '\0' || !(parsed >= min && parsed <= max)) {
+    char* message;
+    gpr_asprintf(&message, "field:%s error:should be a number between %g and %g",
+                 field->key, min, max);
+    grpc_error* error = GRPC_ERROR_CREATE_FROM_COPIED_STRING(message);
+    gpr_free(message);
+    return error;
+  }
+  *value = parsed;
+  return GRPC_ERROR_NONE;
+}
+
+class OutlierDetectionFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return OrphanablePtr<LoadBalancingPolicy>(
+        New<OutlierDetection>(std::move(args)));
+  }
+
+  const char* name() const override { return kOutlierDetection; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const grpc_json* json, grpc_error** error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    RefCountedPtr<LoadBalancingPolicy::Config> child_policy;
+    ParsedOutlierDetectionConfig::Parameters params;
+    if (json == nullptr) {
+      return RefCountedPtr<LoadBalancingPolicy::Config>(
+          New<ParsedOutlierDetectionConfig>(nullptr, params));
+    }
+    InlinedVector<grpc_error*, 2> error_list;
+    for (const grpc_json* field = json->child; field != nullptr;
+         field = field->next) {
+      if (field->key == nullptr) continue;
+      double value = 0;
+      grpc_error* parse_error = GRPC_ERROR_NONE;
+      if (strcmp(field->key, "childPolicy") == 0) {
+        if (child_policy != nullptr) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:childPolicy error:Duplicate entry"));
+        }
+        child_policy = LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
+            field, &parse_error);
+      } else if (strcmp(field->key, "intervalMs") == 0) {
+        parse_error = ParseNumber(field, 1, INT32_MAX, &value);
+        params.interval = static_cast<grpc_millis>(value);
+      } else if (strcmp(field->key, "baseEjectionTimeMs") == 0) {
+        parse_error = ParseNumber(field, 1, INT32_MAX, &value);
+        params.base_ejection_time = static_cast<grpc_millis>(value);
+      } else if (strcmp(field->key, "maxEjectionPercent") == 0) {
+        parse_error = ParseNumber(field, 0, 100, &value);
+        params.max_ejection_percent = static_cast<uint32_t>(value);
+      } else if (strcmp(field->key, "consecutiveFailures") == 0) {
+        parse_error = ParseNumber(field, 0, INT32_MAX, &value);
+        params.consecutive_failures = static_cast<uint32_t>(value);
+      } else if (strcmp(field->key, "successRateStdevFactor") == 0) {
+        parse_error = ParseNumber(field, 0, 100, &value);
+        params.success_rate_stdev_factor = value;
+      } else if (strcmp(field->key, "successRateMinimumHosts") == 0) {
+        parse_error = ParseNumber(field, 0, INT32_MAX, &value);
+        params.success_rate_minimum_hosts = static_cast<uint32_t>(value);
+      } else if (strcmp(field->key, "successRateRequestVolume") == 0) {
+        parse_error = ParseNumber(field, 0, INT32_MAX, &value);
+        params.success_rate_request_volume = static_cast<uint32_t>(value);
+      }
+      if (parse_error != GRPC_ERROR_NONE) error_list.push_back(parse_error);
+    }
+    if (!error_list.empty()) {
+      *error =
+          GRPC_ERROR_CREATE_FROM_VECTOR("OutlierDetection Parser", &error_list);
+      return nullptr;
+    }
+    return RefCountedPtr<LoadBalancingPolicy::Config>(
+        New<ParsedOutlierDetectionConfig>(std::move(child_policy), params));
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_outlier_detection_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          grpc_core::UniquePtr<grpc_core::LoadBalancingPolicyFactory>(
+              grpc_core::New<grpc_core::OutlierDetectionFactory>()));
+}
+
+void grpc_lb_policy_outlier_detection_shutdown() {}
@@ -18,6 +18,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <limits.h>
 #include <string.h>
 
 #include <grpc/support/alloc.h>
@@ -29,6 +30,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/transport/connectivity_state.h"
 
 namespace grpc_core {
@@ -91,6 +93,10 @@ class PickFirst : public LoadBalancingPolicy {
       // any references to subchannels, since the subchannels'
       // pollset_sets will include the LB policy's pollset_set.
       policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+      attempt_delay_ms_ = grpc_channel_arg_get_integer(
+          grpc_channel_args_find(
+              &args, GRPC_ARG_PICK_FIRST_CONNECTION_ATTEMPT_DELAY_MS),
+          {0, 0, INT_MAX});
     }
 
     ~PickFirstSubchannelList() {
@@ -98,13 +104,47 @@ class PickFirst : public LoadBalancingPolicy {
       p->Unref(DEBUG_LOCATION, "subchannel_list");
     }
 
+    void Orphan() override {
+      if (attempt_timer_pending_) grpc_timer_cancel(&attempt_timer_);
+      SubchannelList::Orphan();
+    }
+
     bool in_transient_failure() const { return in_transient_failure_; }
     void set_in_transient_failure(bool in_transient_failure) {
       in_transient_failure_ = in_transient_failure;
     }
 
+    // Whether connection attempts overlap, as set by
+    // GRPC_ARG_PICK_FIRST_CONNECTION_ATTEMPT_DELAY_MS.
+    bool staggers_attempts() const { return attempt_delay_ms_ > 0; }
+
+    // Starts connecting to the first subchannel, whose connectivity state
+    // has already been checked.
+    void StartFirstAttemptLocked();
+
+    // Called when a connection attempt fails while attempts are staggered.
+    void ProcessAttemptFailedLocked();
+
+    // Called once every subchannel has failed to connect.
+    void ProcessAllAttemptsFailedLocked();
+
    private:
+    // Starts connecting to the next subchannel and arms the timer that
+    // starts the one after it.
+    void StartNextAttemptLocked();
+    static void OnAttemptTimerLocked(void* arg, grpc_error* error);
+
     bool in_transient_failure_ = false;
+    // Staggered connection attempts (RFC 8305 happy eyeballs): the next
+    // subchannel is attempted attempt_delay_ms_ after the previous one was,
+    // or as soon as it fails, without giving up on the ones in flight.
+    grpc_millis attempt_delay_ms_;
+    size_t next_attempt_index_ = 0;
+    size_t num_failed_attempts_ = 0;
+    grpc_millis last_attempt_start_ = 0;
+    bool attempt_timer_pending_ = false;
+    grpc_timer attempt_timer_;
+    grpc_closure on_attempt_timer_;
   };
 
   class Picker : public SubchannelPicker {
@@ -229,11 +269,7 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
     subchannel_list_ = std::move(subchannel_list);
     // If we're not in IDLE state, start trying to connect to the first
     // subchannel in the new list.
-    // Note: No need to use CheckConnectivityStateAndStartWatchingLocked()
-    // here, since we've already checked the initial connectivity
-    // state of all subchannels above.
-    subchannel_list_->subchannel(0)->StartConnectivityWatchLocked();
-    subchannel_list_->subchannel(0)->subchannel()->AttemptToConnect();
+    subchannel_list_->StartFirstAttemptLocked();
   } else {
     // We do have a selected subchannel (which means it's READY), so keep
     // using it until one of the subchannels in the new list reports READY.
@@ -249,17 +285,152 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
     latest_pending_subchannel_list_ = std::move(subchannel_list);
     // If we're not in IDLE state, start trying to connect to the first
     // subchannel in the new list.
-    // Note: No need to use CheckConnectivityStateAndStartWatchingLocked()
-    // here, since we've already checked the initial connectivity
-    // state of all subchannels above.
-    latest_pending_subchannel_list_->subchannel(0)
-        ->StartConnectivityWatchLocked();
-    latest_pending_subchannel_list_->subchannel(0)
-        ->subchannel()
-        ->AttemptToConnect();
+    latest_pending_subchannel_list_->StartFirstAttemptLocked();
+  }
+}
+
+void PickFirst::PickFirstSubchannelList::StartFirstAttemptLocked() {
+  // Note: No need to use CheckConnectivityStateAndStartWatchingLocked()
+  // here, since the initial connectivity state of all subchannels has
+  // already been checked.
+  subchannel(0)->StartConnectivityWatchLocked();
+  subchannel(0)->subchannel()->AttemptToConnect();
+  next_attempt_index_ = 1;
+  num_failed_attempts_ = 0;
+  last_attempt_start_ = ExecCtx::Get()->Now();
+  if (staggers_attempts() && num_subchannels() > 1) {
+    PickFirst* p = static_cast<PickFirst*>(policy());
+    attempt_timer_pending_ = true;
+    Ref(DEBUG_LOCATION, "attempt_timer").release();
+    GRPC_CLOSURE_INIT(&on_attempt_timer_, &OnAttemptTimerLocked, this,
+                      grpc_combiner_scheduler(p->combiner()));
+    grpc_timer_init(&attempt_timer_, last_attempt_start_ + attempt_delay_ms_,
+                    &on_attempt_timer_);
   }
 }
 
+void PickFirst::PickFirstSubchannelList::StartNextAttemptLocked() {
+  PickFirstSubchannelData* sd = subchannel(next_attempt_index_++);
+  last_attempt_start_ = ExecCtx::Get()->Now();
+  // If the timer is already pending, it will notice that it fires early and
+  // wait for the rest of the delay.
+  if (next_attempt_index_ < num_subchannels() && !attempt_timer_pending_) {
+    PickFirst* p = static_cast<PickFirst*>(policy());
+    attempt_timer_pending_ = true;
+    Ref(DEBUG_LOCATION, "attempt_timer").release();
+    GRPC_CLOSURE_INIT(&on_attempt_timer_, &OnAttemptTimerLocked, this,
+                      grpc_combiner_scheduler(p->combiner()));
+    grpc_timer_init(&attempt_timer_, last_attempt_start_ + attempt_delay_ms_,
+                    &on_attempt_timer_);
+  }
+  sd->CheckConnectivityStateAndStartWatchingLocked();
+}
+
+void PickFirst::PickFirstSubchannelList::OnAttemptTimerLocked(
+    void* arg, grpc_error* error) {
+  PickFirstSubchannelList* subchannel_list =
+      static_cast<PickFirstSubchannelList*>(arg);
+  PickFirst* p = static_cast<PickFirst*>(subchannel_list->policy());
+  subchannel_list->attempt_timer_pending_ = false;
+  // Nothing more to start once a subchannel of this list is selected.
+  if (error == GRPC_ERROR_NONE && !subchannel_list->shutting_down() &&
+      (p->selected_ == nullptr ||
+       p->selected_->subchannel_list() != subchannel_list) &&
+      subchannel_list->next_attempt_index_ <
+          subchannel_list->num_subchannels()) {
+    const grpc_millis deadline = subchannel_list->last_attempt_start_ +
+                                 subchannel_list->attempt_delay_ms_;
+    if (ExecCtx::Get()->Now() < deadline) {
+      // An attempt failed and the next one started since the timer was
+      // armed; give that one its full delay.
+      subchannel_list->attempt_timer_pending_ = true;
+      subchannel_list->Ref(DEBUG_LOCATION, "attempt_timer").release();
+      GRPC_CLOSURE_INIT(&subchannel_list->on_attempt_timer_,
+                        &OnAttemptTimerLocked, subchannel_list,
+                        grpc_combiner_scheduler(p->combiner()));
+      grpc_timer_init(&subchannel_list->attempt_timer_, deadline,
+                      &subchannel_list->on_attempt_timer_);
+    } else {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+        gpr_log(GPR_INFO,
+                "Pick First %p subchannel list %p: starting attempt %" PRIuPTR
+                " alongside the ones in flight",
+                p, subchannel_list, subchannel_list->next_attempt_index_);
+      }
+      subchannel_list->StartNextAttemptLocked();
+    }
+  }
+  subchannel_list->Unref(DEBUG_LOCATION, "attempt_timer");
+}
+
+void PickFirst::PickFirstSubchannelList::ProcessAttemptFailedLocked() {
+  ++num_failed_attempts_;
+  // Start the next attempt right away on failure.
+  if (next_attempt_index_ < num_subchannels()) {
+    StartNextAttemptLocked();
+    return;
+  }
+  // Wait for the attempts still in flight.
+  if (num_failed_attempts_ < num_subchannels()) return;
+  ProcessAllAttemptsFailedLocked();
+  // Start over from the top of the list.
+  next_attempt_index_ = 0;
+  num_failed_attempts_ = 0;
+  StartNextAttemptLocked();
+}
+
+void PickFirst::PickFirstSubchannelList::ProcessAllAttemptsFailedLocked() {
+  PickFirst* p = static_cast<PickFirst*>(policy());
+  // Re-resolve if this is the most recent subchannel list.
+  if (this == (p->latest_pending_subchannel_list_ != nullptr
+                   ? p->latest_pending_subchannel_list_.get()
+                   : p->subchannel_list_.get())) {
+    p->channel_control_helper()->RequestReresolution();
+  }
+  set_in_transient_failure(true);
+  // Only report new state in case 1.
+  if (this == p->subchannel_list_.get()) {
+    grpc_error* error = grpc_error_set_int(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "failed to connect to all addresses"),
+        GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        UniquePtr<SubchannelPicker>(New<TransientFailurePicker>(error)));
+  }
+}
+
+// Reorders addresses so that the ones of the first address's family
+// alternate with the others, each keeping their relative order (RFC 8305
+// section 4).  With staggered connection attempts, this keeps an unreachable
+// address family from delaying the connection by more than one attempt delay.
+void InterleaveAddressFamilies(ServerAddressList* addresses) {
+  if (addresses->size() < 2) return;
+  const int first_family = grpc_sockaddr_get_family(&(*addresses)[0].address());
+  ServerAddressList same_family;
+  ServerAddressList other_families;
+  for (size_t i = 0; i < addresses->size(); ++i) {
+    ServerAddress& address = (*addresses)[i];
+    if (grpc_sockaddr_get_family(&address.address()) == first_family) {
+      same_family.emplace_back(std::move(address));
+    } else {
+      other_families.emplace_back(std::move(address));
+    }
+  }
+  ServerAddressList interleaved;
+  interleaved.reserve(addresses->size());
+  for (size_t i = 0; i < same_family.size() || i < other_families.size();
+       ++i) {
+    if (i < same_family.size()) {
+      interleaved.emplace_back(std::move(same_family[i]));
+    }
+    if (i < other_families.size()) {
+      interleaved.emplace_back(std::move(other_families[i]));
+    }
+  }
+  *addresses = std::move(interleaved);
+}
+
 void PickFirst::UpdateLocked(UpdateArgs args) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
     gpr_log(GPR_INFO,
@@ -273,6 +444,12 @@ void PickFirst::UpdateLocked(UpdateArgs args) {
       grpc_channel_args_copy_and_add(args.args, &new_arg, 1);
   GPR_SWAP(const grpc_channel_args*, new_args, args.args);
   grpc_channel_args_destroy(new_args);
+  if (grpc_channel_arg_get_integer(
+          grpc_channel_args_find(
+              args.args, GRPC_ARG_PICK_FIRST_CONNECTION_ATTEMPT_DELAY_MS),
+          {0, 0, INT_MAX}) > 0) {
+    InterleaveAddressFamilies(&args.addresses);
+  }
   latest_update_args_ = std::move(args);
   // If we are not in idle, start connection attempt immediately.
   // Otherwise, we defer the attempt into ExitIdleLocked().
@@ -375,30 +552,16 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
     }
     case GRPC_CHANNEL_TRANSIENT_FAILURE: {
       CancelConnectivityWatchLocked("connection attempt failed");
+      if (subchannel_list()->staggers_attempts()) {
+        subchannel_list()->ProcessAttemptFailedLocked();
+        break;
+      }
       PickFirstSubchannelData* sd = this;
       size_t next_index =
           (sd->Index() + 1) % subchannel_list()->num_subchannels();
       sd = subchannel_list()->subchannel(next_index);
       // If we're tried all subchannels, set state to TRANSIENT_FAILURE.
-      if (sd->Index() == 0) {
-        // Re-resolve if this is the most recent subchannel list.
-        if (subchannel_list() == (p->latest_pending_subchannel_list_ != nullptr
-                                      ? p->latest_pending_subchannel_list_.get()
-                                      : p->subchannel_list_.get())) {
-          p->channel_control_helper()->RequestReresolution();
-        }
-        subchannel_list()->set_in_transient_failure(true);
-        // Only report new state in case 1.
-        if (subchannel_list() == p->subchannel_list_.get()) {
-          grpc_error* error = grpc_error_set_int(
-              GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-                  "failed to connect to all addresses"),
-              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
-          p->channel_control_helper()->UpdateState(
-              GRPC_CHANNEL_TRANSIENT_FAILURE,
-              UniquePtr<SubchannelPicker>(New<TransientFailurePicker>(error)));
-        }
-      }
+      if (sd->Index() == 0) subchannel_list()->ProcessAllAttemptsFailedLocked();
       sd->CheckConnectivityStateAndStartWatchingLocked();
       break;
     }
@@ -0,0 +1,696 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Ring Hash Policy.
+ *
+ * Connects to every address like round_robin, but sends all the calls that
+ * carry the same value of a configured initial metadata header to the same
+ * backend, so that backends keeping a per key cache see each key on one
+ * backend only. Every address is hashed onto a ring at several points
+ * (ketama style consistent hashing); a call goes to the address owning the
+ * first point at or after the hash of its header value, skipping the
+ * addresses that are not READY. Since the points of an address only depend
+ * on the address itself, adding or removing an address only moves the keys
+ * falling next to its points. Calls without the header are spread at random.
+ * The policy is configured in the service config as
+ *
+ *   "loadBalancingConfig": [
+ *     { "ring_hash": { "hashHeader": "x-user-id", "minRingSize": 1024 } }
+ *   ]
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/murmur_hash.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_ring_hash_trace(false, "ring_hash");
+
+namespace {
+
+//
+// ring_hash LB policy
+//
+
+constexpr char kRingHash[] = "ring_hash";
+
+// Minimum number of points on the ring, unless configured otherwise. Each
+// address gets an equal share of them.
+constexpr uint32_t kDefaultMinRingSize = 1024;
+// Upper bound of the configurable minimum ring size.
+constexpr uint32_t kMaxRingSize = 8 * 1024 * 1024;
+
+class ParsedRingHashConfig : public LoadBalancingPolicy::Config {
+ public:
+  ParsedRingHashConfig(UniquePtr<char> hash_header, uint32_t min_ring_size)
+      : hash_header_(std::move(hash_header)), min_ring_size_(min_ring_size) {}
+
+  const char* name() const override { return kRingHash; }
+
+  // Lower case name of the header whose value is hashed, or null to spread
+  // all calls at random.
+  const char* hash_header() const { return hash_header_.get(); }
+  uint32_t min_ring_size() const { return min_ring_size_; }
+
+ private:
+  UniquePtr<char> hash_header_;
+  const uint32_t min_ring_size_;
+};
+
+class RingHash : public LoadBalancingPolicy {
+ public:
+  explicit RingHash(Args args);
+
+  const char* name() const override { return kRingHash; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~RingHash();
+
+  // Forward declaration.
+  class RingHashSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the address string the subchannel's ring points are derived
+  //   from.
+  class RingHashSubchannelData
+      : public SubchannelData<RingHashSubchannelList, RingHashSubchannelData> {
+   public:
+    RingHashSubchannelData(
+        SubchannelList<RingHashSubchannelList, RingHashSubchannelData>*
+            subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)) {
+      char* address_string = nullptr;
+      grpc_sockaddr_to_string(&address_string, &address.address(),
+                              false /* normalize */);
+      address_.reset(address_string);
+    }
+
+    grpc_connectivity_state connectivity_state() const {
+      return last_connectivity_state_;
+    }
+
+    const char* address() const { return address_.get(); }
+
+    void UpdateConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    UniquePtr<char> address_;
+  };
+
+  // The points of the subchannels of a subchannel list, sorted by hash.
+  // Built once per subchannel list and shared by the pickers created from
+  // it, which only differ by the subchannels that are READY.
+  class Ring : public RefCounted<Ring> {
+   public:
+    struct Entry {
+      uint32_t hash;
+      size_t subchannel_index;
+    };
+
+    Ring(RingHashSubchannelList* subchannel_list, uint32_t min_ring_size);
+
+    size_t size() const { return entries_.size(); }
+    const Entry& entry(size_t index) const { return entries_[index]; }
+
+    // Returns the index of the first entry whose hash is at least \a hash,
+    // wrapping around to the first entry.
+    size_t FindEntry(uint32_t hash) const;
+
+   private:
+    InlinedVector<Entry, 1> entries_;
+  };
+
+  // A list of subchannels.
+  class RingHashSubchannelList
+      : public SubchannelList<RingHashSubchannelList, RingHashSubchannelData> {
+   public:
+    RingHashSubchannelList(RingHash* policy, TraceFlag* tracer,
+                           const ServerAddressList& addresses,
+                           const grpc_channel_args& args)
+        : SubchannelList(policy, tracer, addresses,
+                         policy->channel_control_helper(), args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+      ring_ = MakeRefCounted<Ring>(this, policy->config_->min_ring_size());
+    }
+
+    ~RingHashSubchannelList() {
+      RingHash* p = static_cast<RingHash*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    const RefCountedPtr<Ring>& ring() const { return ring_; }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked();
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // If this subchannel list is the RH policy's current subchannel
+    // list, updates the RH policy's connectivity state based on the
+    // subchannel list's state counters.
+    void MaybeUpdateRingHashConnectivityStateLocked();
+
+    // Updates the RH policy's overall state based on the counters of
+    // subchannels in each state.
+    void UpdateRingHashStateFromSubchannelStateCountsLocked();
+
+   private:
+    RefCountedPtr<Ring> ring_;
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(RingHash* parent, RingHashSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Hashes the value of the configured header of \a initial_metadata.
+    // Returns false if there is no such header.
+    bool HashHeader(MetadataInterface* initial_metadata, uint32_t* hash);
+
+    // Using pointer value only, no ref held -- do not dereference!
+    RingHash* parent_;
+
+    RefCountedPtr<ParsedRingHashConfig> config_;
+    RefCountedPtr<Ring> ring_;
+    // Indexed like the subchannel list; null for subchannels not READY.
+    InlinedVector<RefCountedPtr<SubchannelInterface>, 10> subchannels_;
+  };
+
+  void ShutdownLocked() override;
+
+  /** latest config, or the defaults */
+  RefCountedPtr<ParsedRingHashConfig> config_;
+  /** list of subchannels */
+  OrphanablePtr<RingHashSubchannelList> subchannel_list_;
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  OrphanablePtr<RingHashSubchannelList> latest_pending_subchannel_list_;
+  /** are we shutting down? */
+  bool shutdown_ = false;
+};
+
+//
+// RingHash::Ring
+//
+
+RingHash::Ring::Ring(RingHashSubchannelList* subchannel_list,
+                     uint32_t min_ring_size) {
+  const size_t num_subchannels = subchannel_list->num_subchannels();
+  if (num_subchannels == 0) return;
+  // Every subchannel gets the same number of points, the one with seed i
+  // being the hash of its address with seed i. Adding or removing addresses
+  // thus leaves the points of the others where they were, except for the
+  // points appended or dropped when the share of each address changes.
+  const size_t points_per_subchannel =
+      (min_ring_size + num_subchannels - 1) / num_subchannels;
+  entries_.reserve(points_per_subchannel * num_subchannels);
+  for (size_t i = 0; i < num_subchannels; ++i) {
+    const char* address = subchannel_list->subchannel(i)->address();
+    const size_t address_length = address == nullptr ? 0 : strlen(address);
+    for (size_t j = 0; j < points_per_subchannel; ++j) {
+      entries_.push_back(
+          Entry{gpr_murmur_hash3(address, address_length,
+                                 static_cast<uint32_t>(j)),
+                i});
+    }
+  }
+  std::sort(entries_.data(), entries_.data() + entries_.size(),
+            [](const Entry& lhs, const Entry& rhs) {
+              return lhs.hash < rhs.hash;
+            });
+}
+
+size_t RingHash::Ring::FindEntry(uint32_t hash) const {
+  const Entry* end = entries_.data() + entries_.size();
+  const Entry* it = std::lower_bound(
+      entries_.data(), end, hash,
+      [](const Entry& entry, uint32_t hash) { return entry.hash < hash; });
+  return it == end ? 0 : static_cast<size_t>(it - entries_.data());
+}
+
+//
+// RingHash::Picker
+//
+
+RingHash::Picker::Picker(RingHash* parent,
+                         RingHashSubchannelList* subchannel_list)
+    : parent_(parent),
+      config_(parent->config_),
+      ring_(subchannel_list->ring()) {
+  size_t num_ready = 0;
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    RingHashSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      subchannels_.push_back(sd->subchannel()->Ref());
+      ++num_ready;
+    } else {
+      subchannels_.emplace_back();
+    }
+  }
+  // There is at least one READY subchannel, or we would not be here.
+  GPR_ASSERT(num_ready > 0);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO,
+            "[RH %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels and %" PRIuPTR
+            " ring entries; hash_header=%s",
+            parent_, this, subchannel_list, num_ready, ring_->size(),
+            config_->hash_header() == nullptr ? "(none)"
+                                              : config_->hash_header());
+  }
+}
+
+bool RingHash::Picker::HashHeader(MetadataInterface* initial_metadata,
+                                  uint32_t* hash) {
+  if (config_->hash_header() == nullptr || initial_metadata == nullptr) {
+    return false;
+  }
+  const StringView hash_header(config_->hash_header());
+  for (MetadataInterface::Iterator it = initial_metadata->Begin();
+       !initial_metadata->IsEnd(it); initial_metadata->Next(&it)) {
+    if (initial_metadata->Key(it) == hash_header) {
+      const StringView value = initial_metadata->Value(it);
+      *hash = gpr_murmur_hash3(value.data(), value.size(), 0);
+      return true;
+    }
+  }
+  return false;
+}
+
+RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
+  uint32_t hash;
+  size_t index;
+  if (HashHeader(args.initial_metadata, &hash)) {
+    index = ring_->FindEntry(hash);
+  } else {
+    // TODO(roth): rand(3) is not thread-safe.  This should be replaced with
+    // something better as part of https://github.com/grpc/grpc/issues/17891.
+    index = rand() % ring_->size();
+  }
+  // Walk the ring up to the first point of a READY subchannel. The keys of
+  // a subchannel that is not READY thus go to the next READY ones on the
+  // ring rather than all to the same one.
+  for (size_t i = 0; i < ring_->size(); ++i) {
+    const Ring::Entry& entry = ring_->entry((index + i) % ring_->size());
+    const RefCountedPtr<SubchannelInterface>& subchannel =
+        subchannels_[entry.subchannel_index];
+    if (subchannel == nullptr) continue;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p picker %p] returning index %" PRIuPTR
+              ", subchannel=%p, ring entry %" PRIuPTR " (hash %u)",
+              parent_, this, entry.subchannel_index, subchannel.get(),
+              (index + i) % ring_->size(), entry.hash);
+    }
+    PickResult result;
+    result.type = PickResult::PICK_COMPLETE;
+    result.subchannel = subchannel;
+    return result;
+  }
+  // Unreachable: every subchannel has points on the ring.
+  GPR_UNREACHABLE_CODE(return PickResult());
+}
+
+//
+// RingHash
+//
+
+RingHash::RingHash(Args args)
+    : LoadBalancingPolicy(std::move(args)),
+      config_(MakeRefCounted<ParsedRingHashConfig>(nullptr,
+                                                   kDefaultMinRingSize)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Created", this);
+  }
+}
+
+RingHash::~RingHash() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Destroying Ring Hash policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void RingHash::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void RingHash::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+void RingHash::RingHashSubchannelList::StartWatchingLocked() {
+  if (num_subchannels() == 0) return;
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->subchannel()->AttemptToConnect();
+    }
+  }
+  // Now set the LB policy's state based on the subchannels' states.
+  UpdateRingHashStateFromSubchannelStateCountsLocked();
+}
+
+void RingHash::RingHashSubchannelList::UpdateStateCountersLocked(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+// Sets the RH policy's connectivity state and generates a new picker based
+// on the current subchannel list.
+void RingHash::RingHashSubchannelList::
+    MaybeUpdateRingHashConnectivityStateLocked() {
+  RingHash* p = static_cast<RingHash*>(policy());
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  /* In priority order. The first rule to match terminates the search (ie, if we
+   * are on rule n, all previous rules were unfulfilled).
+   *
+   * 1) RULE: ANY subchannel is READY => policy is READY.
+   *    CHECK: subchannel_list->num_ready > 0.
+   *
+   * 2) RULE: ANY subchannel is CONNECTING => policy is CONNECTING.
+   *    CHECK: sd->curr_connectivity_state == CONNECTING.
+   *
+   * 3) RULE: ALL subchannels are TRANSIENT_FAILURE => policy is
+   *                                                   TRANSIENT_FAILURE.
+   *    CHECK: subchannel_list->num_transient_failures ==
+   *           subchannel_list->num_subchannels.
+   */
+  if (num_ready_ > 0) {
+    /* 1) READY */
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, UniquePtr<SubchannelPicker>(New<Picker>(p, this)));
+  } else if (num_connecting_ > 0) {
+    /* 2) CONNECTING */
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, UniquePtr<SubchannelPicker>(New<QueuePicker>(
+                                     p->Ref(DEBUG_LOCATION, "QueuePicker"))));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    /* 3) TRANSIENT_FAILURE */
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                               "connections to all backends failing"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        UniquePtr<SubchannelPicker>(New<TransientFailurePicker>(error)));
+  }
+}
+
+void RingHash::RingHashSubchannelList::
+    UpdateRingHashStateFromSubchannelStateCountsLocked() {
+  RingHash* p = static_cast<RingHash*>(policy());
+  if (num_ready_ > 0) {
+    if (p->subchannel_list_.get() != this) {
+      // Promote this list to p->subchannel_list_.
+      // This list must be p->latest_pending_subchannel_list_, because
+      // any previous update would have been shut down already and
+      // therefore we would not be receiving a notification for them.
+      GPR_ASSERT(p->latest_pending_subchannel_list_.get() == this);
+      GPR_ASSERT(!shutting_down());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+        const size_t old_num_subchannels =
+            p->subchannel_list_ != nullptr
+                ? p->subchannel_list_->num_subchannels()
+                : 0;
+        gpr_log(GPR_INFO,
+                "[RH %p] phasing out subchannel list %p (size %" PRIuPTR
+                ") in favor of %p (size %" PRIuPTR ")",
+                p, p->subchannel_list_.get(), old_num_subchannels, this,
+                num_subchannels());
+      }
+      p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+    }
+  }
+  // Update the RH policy's connectivity state if needed.
+  MaybeUpdateRingHashConnectivityStateLocked();
+}
+
+void RingHash::RingHashSubchannelData::UpdateConnectivityStateLocked(
+    grpc_connectivity_state connectivity_state) {
+  RingHash* p = static_cast<RingHash*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[RH %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        grpc_connectivity_state_name(last_connectivity_state_),
+        grpc_connectivity_state_name(connectivity_state));
+  }
+  subchannel_list()->UpdateStateCountersLocked(last_connectivity_state_,
+                                               connectivity_state);
+  last_connectivity_state_ = connectivity_state;
+}
+
+void RingHash::RingHashSubchannelData::ProcessConnectivityChangeLocked(
+    grpc_connectivity_state connectivity_state) {
+  RingHash* p = static_cast<RingHash*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE, re-resolve.
+  // Only do this if we've started watching, not at startup time.
+  // Otherwise, if the subchannel was already in state TRANSIENT_FAILURE
+  // when the subchannel list was created, we'd wind up in a constant
+  // loop of re-resolution.
+  // Also attempt to reconnect.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p] Subchannel %p has gone into TRANSIENT_FAILURE. "
+              "Requesting re-resolution",
+              p, subchannel());
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->AttemptToConnect();
+  }
+  // Update state counters.
+  UpdateConnectivityStateLocked(connectivity_state);
+  // Update overall state and renew notification.
+  subchannel_list()->UpdateRingHashStateFromSubchannelStateCountsLocked();
+}
+
+void RingHash::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] received update with %" PRIuPTR " addresses",
+            this, args.addresses.size());
+  }
+  // The subchannel list and pickers created from now on use the new config.
+  if (args.config != nullptr) {
+    config_.reset(static_cast<ParsedRingHashConfig*>(args.config.release()));
+  }
+  // Replace latest_pending_subchannel_list_.
+  if (latest_pending_subchannel_list_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p] Shutting down previous pending subchannel list %p", this,
+              latest_pending_subchannel_list_.get());
+    }
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<RingHashSubchannelList>(
+      this, &grpc_lb_ring_hash_trace, args.addresses, *args.args);
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    // If the new list is empty, immediately promote the new list to the
+    // current list and transition to TRANSIENT_FAILURE.
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        UniquePtr<SubchannelPicker>(New<TransientFailurePicker>(error)));
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  } else if (subchannel_list_ == nullptr) {
+    // If there is no current list, immediately promote the new list to
+    // the current list and start watching it.
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    subchannel_list_->StartWatchingLocked();
+  } else {
+    // Start watching the pending list.  It will get swapped into the
+    // current list when it reports READY.
+    latest_pending_subchannel_list_->StartWatchingLocked();
+  }
+}
+
+//
+// factory
+//
+
+class RingHashFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return OrphanablePtr<LoadBalancingPolicy>(New<RingHash>(std::move(args)));
+  }
+
+  const char* name() const override { return kRingHash; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const grpc_json* json, grpc_error** error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    UniquePtr<char> hash_header;
+    uint32_t min_ring_size = kDefaultMinRingSize;
+    if (json != nullptr) {
+      GPR_DEBUG_ASSERT(strcmp(json->key, name()) == 0);
+      InlinedVector<grpc_error*, 2> error_list;
+      bool seen_min_ring_size = false;
+      for (const grpc_json* field = json->child; field != nullptr;
+           field = field->next) {
+        if (field->key == nullptr) continue;
+        if (strcmp(field->key, "hashHeader") == 0) {
+          if (hash_header != nullptr) {
+            error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "field:hashHeader error:Duplicate entry"));
+            continue;
+          }
+          if (field->type != GRPC_JSON_STRING || field->value[0] == '\0') {
+            error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "field:hashHeader error:should be a non-empty string"));
+            continue;
+          }
+          // Metadata keys are lower case.
+          hash_header.reset(gpr_strdup(field->value));
+          for (char* c = hash_header.get(); *c != '\0'; ++c) {
+            *c = static_cast<char>(tolower(*c));
+          }
+        } else if (strcmp(field->key, "minRingSize") == 0) {
+          if (seen_min_ring_size) {
+            error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "field:minRingSize error:Duplicate entry"));
+            continue;
+          }
+          seen_min_ring_size = true;
+          int value = field->type == GRPC_JSON_NUMBER
+                          ? gpr_parse_nonnegative_int(field->value)
+                          : -1;
+          if (value < 1 || static_cast<uint32_t>(value) > kMaxRingSize) {
+            error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "field:minRingSize error:should be a number between 1 and "
+                "8388608"));
+            continue;
+          }
+          min_ring_size = static_cast<uint32_t>(value);
+        }
+      }
+      if (!error_list.empty()) {
+        *error = GRPC_ERROR_CREATE_FROM_VECTOR("RingHash Parser", &error_list);
+        return nullptr;
+      }
+    }
+    return RefCountedPtr<LoadBalancingPolicy::Config>(
+        New<ParsedRingHashConfig>(std::move(hash_header), min_ring_size));
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_ring_hash_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          grpc_core::UniquePtr<grpc_core::LoadBalancingPolicyFactory>(
+              grpc_core::New<grpc_core::RingHashFactory>()));
+}
+
+void grpc_lb_policy_ring_hash_shutdown() {}
@@ -26,6 +26,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -38,7 +39,9 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/transport/connectivity_state.h"
 #include "src/core/lib/transport/static_metadata.h"
 
@@ -119,8 +122,26 @@ class RoundRobin : public LoadBalancingPolicy {
       p->Unref(DEBUG_LOCATION, "subchannel_list");
     }
 
-    // Starts watching the subchannels in this list.
-    void StartWatchingLocked();
+    void Orphan() override {
+      if (warm_up_timer_pending_) grpc_timer_cancel(&warm_up_timer_);
+      SubchannelList::Orphan();
+    }
+
+    // Starts watching the subchannels in this list, from first_index on.
+    void StartWatchingLocked(size_t first_index = 0);
+
+    // Returns true if applying delta in place would leave the policy able to
+    // serve calls whenever it is now, i.e. it does not remove every READY
+    // subchannel.
+    bool CanUpdateInPlaceLocked(const Delta& delta);
+
+    // Removes and adds the subchannels in delta, keeping the others and
+    // their connections and watches, and updates the RR policy's state.
+    void UpdateInPlaceLocked(const Delta& delta);
+
+    // Keeps this list from replacing the current one until all of its
+    // subchannels have connected or failed, or until \a timeout expires.
+    void StartWarmUpTimerLocked(grpc_millis timeout);
 
     // Updates the counters of subchannels in each state when a
     // subchannel transitions from old_state to new_state.
@@ -137,9 +158,19 @@ class RoundRobin : public LoadBalancingPolicy {
     void UpdateRoundRobinStateFromSubchannelStateCountsLocked();
 
    private:
+    static void OnWarmUpTimerLocked(void* arg, grpc_error* error);
+
+    // Returns true if this pending list may replace the current one.
+    bool ReadyToReplaceLocked() const;
+
     size_t num_ready_ = 0;
     size_t num_connecting_ = 0;
     size_t num_transient_failure_ = 0;
+    // Warm-up of a pending list.
+    bool warmed_up_ = true;
+    bool warm_up_timer_pending_ = false;
+    grpc_timer warm_up_timer_;
+    grpc_closure on_warm_up_timer_;
   };
 
   class Picker : public SubchannelPicker {
@@ -198,7 +229,18 @@ RoundRobin::Picker::Picker(RoundRobin* parent,
 }
 
 RoundRobin::PickResult RoundRobin::Picker::Pick(PickArgs args) {
-  last_picked_index_ = (last_picked_index_ + 1) % subchannels_.size();
+  // Skip the subchannels whose connection has no stream left, since the call
+  // would wait in that transport even if another backend could take it now.
+  // If every connection is saturated, fall back to the next one in order.
+  const size_t start_index = (last_picked_index_ + 1) % subchannels_.size();
+  last_picked_index_ = start_index;
+  for (size_t i = 0; i < subchannels_.size(); ++i) {
+    const size_t index = (start_index + i) % subchannels_.size();
+    if (subchannels_[index]->GetAvailableStreams() > 0) {
+      last_picked_index_ = index;
+      break;
+    }
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
@@ -245,12 +287,12 @@ void RoundRobin::ResetBackoffLocked() {
   }
 }
 
-void RoundRobin::RoundRobinSubchannelList::StartWatchingLocked() {
-  if (num_subchannels() == 0) return;
+void RoundRobin::RoundRobinSubchannelList::StartWatchingLocked(
+    size_t first_index) {
   // Check current state of each subchannel synchronously, since any
   // subchannel already used by some other channel may have a non-IDLE
   // state.
-  for (size_t i = 0; i < num_subchannels(); ++i) {
+  for (size_t i = first_index; i < num_subchannels(); ++i) {
     grpc_connectivity_state state =
         subchannel(i)->CheckConnectivityStateLocked();
     if (state != GRPC_CHANNEL_IDLE) {
@@ -258,7 +300,7 @@ void RoundRobin::RoundRobinSubchannelList::StartWatchingLocked() {
     }
   }
   // Start connectivity watch for each subchannel.
-  for (size_t i = 0; i < num_subchannels(); i++) {
+  for (size_t i = first_index; i < num_subchannels(); i++) {
     if (subchannel(i)->subchannel() != nullptr) {
       subchannel(i)->StartConnectivityWatchLocked();
       subchannel(i)->subchannel()->AttemptToConnect();
@@ -268,6 +310,71 @@ void RoundRobin::RoundRobinSubchannelList::StartWatchingLocked() {
   UpdateRoundRobinStateFromSubchannelStateCountsLocked();
 }
 
+bool RoundRobin::RoundRobinSubchannelList::CanUpdateInPlaceLocked(
+    const Delta& delta) {
+  if (num_ready_ == 0) return true;
+  size_t num_ready_removed = 0;
+  for (size_t i = 0; i < delta.removed.size(); ++i) {
+    if (subchannel(delta.removed[i])->connectivity_state() ==
+        GRPC_CHANNEL_READY) {
+      ++num_ready_removed;
+    }
+  }
+  return num_ready_removed < num_ready_;
+}
+
+void RoundRobin::RoundRobinSubchannelList::UpdateInPlaceLocked(
+    const Delta& delta) {
+  RoundRobin* p = static_cast<RoundRobin*>(policy());
+  // Removed subchannels no longer count towards any state.
+  for (size_t i = 0; i < delta.removed.size(); ++i) {
+    RoundRobinSubchannelData* sd = subchannel(delta.removed[i]);
+    UpdateStateCountersLocked(sd->connectivity_state(), GRPC_CHANNEL_IDLE);
+  }
+  const size_t first_added =
+      ApplyDeltaLocked(delta, p->channel_control_helper());
+  // Also reports the new state and picker.
+  StartWatchingLocked(first_added);
+}
+
+void RoundRobin::RoundRobinSubchannelList::StartWarmUpTimerLocked(
+    grpc_millis timeout) {
+  RoundRobin* p = static_cast<RoundRobin*>(policy());
+  warmed_up_ = false;
+  warm_up_timer_pending_ = true;
+  Ref(DEBUG_LOCATION, "warm_up_timer").release();
+  GRPC_CLOSURE_INIT(&on_warm_up_timer_, &OnWarmUpTimerLocked, this,
+                    grpc_combiner_scheduler(p->combiner()));
+  grpc_timer_init(&warm_up_timer_, ExecCtx::Get()->Now() + timeout,
+                  &on_warm_up_timer_);
+}
+
+void RoundRobin::RoundRobinSubchannelList::OnWarmUpTimerLocked(
+    void* arg, grpc_error* error) {
+  RoundRobinSubchannelList* subchannel_list =
+      static_cast<RoundRobinSubchannelList*>(arg);
+  subchannel_list->warm_up_timer_pending_ = false;
+  if (error == GRPC_ERROR_NONE && !subchannel_list->shutting_down()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
+      gpr_log(GPR_INFO, "[RR %p] warm-up of subchannel list %p timed out",
+              subchannel_list->policy(), subchannel_list);
+    }
+    subchannel_list->warmed_up_ = true;
+    subchannel_list->UpdateRoundRobinStateFromSubchannelStateCountsLocked();
+  }
+  subchannel_list->Unref(DEBUG_LOCATION, "warm_up_timer");
+}
+
+bool RoundRobin::RoundRobinSubchannelList::ReadyToReplaceLocked() const {
+  if (num_ready_ == 0) return false;
+  if (warmed_up_) return true;
+  // Done connecting when no subchannel is still IDLE or CONNECTING.
+  if (num_ready_ + num_transient_failure_ == num_subchannels()) return true;
+  // There is no point in waiting if the current list cannot serve calls.
+  RoundRobin* p = static_cast<RoundRobin*>(policy());
+  return p->subchannel_list_->num_ready_ == 0;
+}
+
 void RoundRobin::RoundRobinSubchannelList::UpdateStateCountersLocked(
     grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
   GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
@@ -337,7 +444,7 @@ void RoundRobin::RoundRobinSubchannelList::
     UpdateRoundRobinStateFromSubchannelStateCountsLocked() {
   RoundRobin* p = static_cast<RoundRobin*>(policy());
   if (num_ready_ > 0) {
-    if (p->subchannel_list_.get() != this) {
+    if (p->subchannel_list_.get() != this && ReadyToReplaceLocked()) {
       // Promote this list to p->subchannel_list_.
       // This list must be p->latest_pending_subchannel_list_, because
       // any previous update would have been shut down already and
@@ -356,10 +463,18 @@ void RoundRobin::RoundRobinSubchannelList::
                 num_subchannels());
       }
       p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+      if (warm_up_timer_pending_) grpc_timer_cancel(&warm_up_timer_);
     }
   }
   // Update the RR policy's connectivity state if needed.
   MaybeUpdateRoundRobinConnectivityStateLocked();
+  // If the current list just lost its last READY subchannel, a pending list
+  // that is still warming up should not wait any longer.
+  if (p->subchannel_list_.get() == this && num_ready_ == 0 &&
+      p->latest_pending_subchannel_list_ != nullptr) {
+    p->latest_pending_subchannel_list_
+        ->UpdateRoundRobinStateFromSubchannelStateCountsLocked();
+  }
 }
 
 void RoundRobin::RoundRobinSubchannelData::UpdateConnectivityStateLocked(
@@ -411,6 +526,30 @@ void RoundRobin::UpdateLocked(UpdateArgs args) {
     gpr_log(GPR_INFO, "[RR %p] received update with %" PRIuPTR " addresses",
             this, args.addresses.size());
   }
+  // Unless a new list is already pending, apply the update to the current
+  // list in place when it can be, so that only the subchannels whose
+  // addresses were added or removed are created or shut down.  The others
+  // keep their watches and stay in the picker throughout.
+  if (subchannel_list_ != nullptr && subchannel_list_->num_subchannels() > 0 &&
+      latest_pending_subchannel_list_ == nullptr) {
+    RoundRobinSubchannelList::Delta delta;
+    if (subchannel_list_->ComputeDeltaLocked(args.addresses, *args.args,
+                                             &delta)) {
+      if (delta.removed.empty() && delta.added.empty()) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
+          gpr_log(GPR_INFO, "[RR %p] update identical to current, ignoring",
+                  this);
+        }
+        return;
+      }
+      if ((delta.removed.size() < subchannel_list_->num_subchannels() ||
+           !delta.added.empty()) &&
+          subchannel_list_->CanUpdateInPlaceLocked(delta)) {
+        subchannel_list_->UpdateInPlaceLocked(delta);
+        return;
+      }
+    }
+  }
   // Replace latest_pending_subchannel_list_.
   if (latest_pending_subchannel_list_ != nullptr) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
@@ -438,7 +577,15 @@ void RoundRobin::UpdateLocked(UpdateArgs args) {
     subchannel_list_->StartWatchingLocked();
   } else {
     // Start watching the pending list.  It will get swapped into the
-    // current list when it reports READY.
+    // current list when it reports READY, or once it has warmed up if
+    // GRPC_ARG_ROUND_ROBIN_WARM_UP_TIMEOUT_MS is set.
+    const grpc_millis warm_up_timeout = grpc_channel_arg_get_integer(
+        grpc_channel_args_find(args.args,
+                               GRPC_ARG_ROUND_ROBIN_WARM_UP_TIMEOUT_MS),
+        {0, 0, INT_MAX});
+    if (warm_up_timeout > 0) {
+      latest_pending_subchannel_list_->StartWarmUpTimerLocked(warm_up_timeout);
+    }
     latest_pending_subchannel_list_->StartWatchingLocked();
   }
 }
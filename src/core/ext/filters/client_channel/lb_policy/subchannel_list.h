@@ -35,6 +35,8 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/abstract.h"
 #include "src/core/lib/gprpp/inlined_vector.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -83,10 +85,7 @@ class SubchannelData {
   }
 
   // Returns the index into the subchannel list of this object.
-  size_t Index() const {
-    return static_cast<size_t>(static_cast<const SubchannelDataType*>(this) -
-                               subchannel_list_->subchannel(0));
-  }
+  size_t Index() const { return index_; }
 
   // Returns a pointer to the subchannel.
   SubchannelInterface* subchannel() const { return subchannel_.get(); }
@@ -134,6 +133,9 @@ class SubchannelData {
       grpc_connectivity_state connectivity_state) GRPC_ABSTRACT;
 
  private:
+  // For setting index_ and connection_index_, and for reading address_.
+  friend class SubchannelList<SubchannelListType, SubchannelDataType>;
+
   // Watcher for subchannel connectivity state.
   class Watcher
       : public SubchannelInterface::ConnectivityStateWatcherInterface {
@@ -152,6 +154,11 @@ class SubchannelData {
       return subchannel_list_->policy()->interested_parties();
     }
 
+    // Called when the watch is cancelled.  A notification that was already
+    // on its way is then dropped without touching subchannel_data_, which
+    // may have been removed from the list by the time it arrives.
+    void Detach() { subchannel_data_ = nullptr; }
+
    private:
     SubchannelData<SubchannelListType, SubchannelDataType>* subchannel_data_;
     RefCountedPtr<SubchannelListType> subchannel_list_;
@@ -162,11 +169,16 @@ class SubchannelData {
 
   // Backpointer to owning subchannel list.  Not owned.
   SubchannelList<SubchannelListType, SubchannelDataType>* subchannel_list_;
+  // Position in the list.
+  size_t index_ = 0;
+  // The address the subchannel was created for, and which of the connections
+  // to that address it is, for matching it against later updates.
+  ServerAddress address_;
+  int connection_index_ = 0;
   // The subchannel.
   RefCountedPtr<SubchannelInterface> subchannel_;
   // Will be non-null when the subchannel's state is being watched.
-  SubchannelInterface::ConnectivityStateWatcherInterface* pending_watcher_ =
-      nullptr;
+  Watcher* pending_watcher_ = nullptr;
   // Data updated by the watcher.
   grpc_connectivity_state connectivity_state_;
 };
@@ -175,13 +187,42 @@ class SubchannelData {
 template <typename SubchannelListType, typename SubchannelDataType>
 class SubchannelList : public InternallyRefCounted<SubchannelListType> {
  public:
-  typedef InlinedVector<SubchannelDataType, 10> SubchannelVector;
+  // Each SubchannelData is allocated separately, so that it stays put while
+  // subchannels are added to and removed from the list.
+  typedef InlinedVector<UniquePtr<SubchannelDataType>, 10> SubchannelVector;
+
+  // The changes needed to bring this list in line with a new address list.
+  struct Delta {
+    // Indexes of the subchannels whose address is no longer present.
+    InlinedVector<size_t, 10> removed;
+    // Addresses, with the connection index, that have no subchannel yet.
+    // These point into the address list the delta was computed from.
+    InlinedVector<std::pair<const ServerAddress*, int>, 10> added;
+  };
 
   // The number of subchannels in the list.
   size_t num_subchannels() const { return subchannels_.size(); }
 
   // The data for the subchannel at a particular index.
-  SubchannelDataType* subchannel(size_t index) { return &subchannels_[index]; }
+  SubchannelDataType* subchannel(size_t index) {
+    return subchannels_[index].get();
+  }
+
+  // Computes the subchannels to remove and the ones to create so that this
+  // list matches addresses.  Returns false if the list cannot be updated in
+  // place, because args differ from the ones it was created with (beyond
+  // the keys that are removed for every subchannel) or because it holds
+  // duplicate addresses; a new list is needed then.
+  bool ComputeDeltaLocked(const ServerAddressList& addresses,
+                          const grpc_channel_args& args, Delta* delta) const;
+
+  // Shuts down and removes the subchannels in delta.removed and creates the
+  // ones in delta.added, leaving every other subchannel, and its watch, as
+  // it is.  The remaining subchannels keep their order; the new ones are
+  // appended, starting at the index returned.  Their state is not watched
+  // yet.
+  size_t ApplyDeltaLocked(const Delta& delta,
+                          LoadBalancingPolicy::ChannelControlHelper* helper);
 
   // Returns true if the subchannel list is shutting down.
   bool shutting_down() const { return shutting_down_; }
@@ -218,13 +259,33 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
   // For accessing Ref() and Unref().
   friend class SubchannelData<SubchannelListType, SubchannelDataType>;
 
+  // Orders subchannels by address, address args and connection index.
+  struct AddressKey {
+    const ServerAddress* address;
+    int connection_index;
+  };
+  struct AddressKeyLess {
+    bool operator()(const AddressKey& a, const AddressKey& b) const;
+  };
+
   void ShutdownLocked();
 
+  // Creates a subchannel for connection_index to address and appends it to
+  // the list.  Does nothing if the subchannel cannot be created.
+  void AddSubchannelLocked(const ServerAddress& address, int connection_index,
+                           LoadBalancingPolicy::ChannelControlHelper* helper);
+
   // Backpointer to owning policy.
   LoadBalancingPolicy* policy_;
 
   TraceFlag* tracer_;
 
+  // The args the list was created with, without the keys that are set or
+  // removed per subchannel.
+  grpc_channel_args* args_;
+
+  int connections_per_address_;
+
   // The list of subchannels.
   SubchannelVector subchannels_;
 
@@ -245,6 +306,7 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
 template <typename SubchannelListType, typename SubchannelDataType>
 void SubchannelData<SubchannelListType, SubchannelDataType>::Watcher::
     OnConnectivityStateChange(grpc_connectivity_state new_state) {
+  if (subchannel_data_ == nullptr) return;
   if (GRPC_TRACE_FLAG_ENABLED(*subchannel_list_->tracer())) {
     gpr_log(GPR_INFO,
             "[%s %p] subchannel list %p index %" PRIuPTR " of %" PRIuPTR
@@ -275,6 +337,7 @@ SubchannelData<SubchannelListType, SubchannelDataType>::SubchannelData(
     SubchannelList<SubchannelListType, SubchannelDataType>* subchannel_list,
     const ServerAddress& address, RefCountedPtr<SubchannelInterface> subchannel)
     : subchannel_list_(subchannel_list),
+      address_(address),
       subchannel_(std::move(subchannel)),
       // We assume that the current state is IDLE.  If not, we'll get a
       // callback telling us that.
@@ -342,6 +405,7 @@ void SubchannelData<SubchannelListType, SubchannelDataType>::
             subchannel_.get(), reason);
   }
   if (pending_watcher_ != nullptr) {
+    pending_watcher_->Detach();
     subchannel_->CancelConnectivityStateWatch(pending_watcher_);
     pending_watcher_ = nullptr;
   }
@@ -357,6 +421,13 @@ void SubchannelData<SubchannelListType, SubchannelDataType>::ShutdownLocked() {
 // SubchannelList
 //
 
+// We need to remove the LB addresses in order to be able to compare the
+// subchannel keys of subchannels from a different batch of addresses.
+// We remove the service config, since it will be passed into the
+// subchannel via call context.
+static const char* kSubchannelListKeysToRemove[] = {GRPC_ARG_SUBCHANNEL_ADDRESS,
+                                                    GRPC_ARG_SERVICE_CONFIG};
+
 template <typename SubchannelListType, typename SubchannelDataType>
 SubchannelList<SubchannelListType, SubchannelDataType>::SubchannelList(
     LoadBalancingPolicy* policy, TraceFlag* tracer,
@@ -365,19 +436,21 @@ SubchannelList<SubchannelListType, SubchannelDataType>::SubchannelList(
     const grpc_channel_args& args)
     : InternallyRefCounted<SubchannelListType>(tracer),
       policy_(policy),
-      tracer_(tracer) {
+      tracer_(tracer),
+      args_(grpc_channel_args_copy_and_remove(
+          &args, kSubchannelListKeysToRemove,
+          GPR_ARRAY_SIZE(kSubchannelListKeysToRemove))) {
   if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
     gpr_log(GPR_INFO,
             "[%s %p] Creating subchannel list %p for %" PRIuPTR " subchannels",
             tracer_->name(), policy, this, addresses.size());
   }
-  subchannels_.reserve(addresses.size());
-  // We need to remove the LB addresses in order to be able to compare the
-  // subchannel keys of subchannels from a different batch of addresses.
-  // We remove the service config, since it will be passed into the
-  // subchannel via call context.
-  static const char* keys_to_remove[] = {GRPC_ARG_SUBCHANNEL_ADDRESS,
-                                         GRPC_ARG_SERVICE_CONFIG};
+  // Opening several connections to each address takes as many subchannels,
+  // told apart by their connection index.
+  connections_per_address_ = grpc_channel_args_find_integer(
+      &args, GRPC_ARG_CONNECTIONS_PER_ADDRESS,
+      {1, 1, 16});
+  subchannels_.reserve(addresses.size() * connections_per_address_);
   // Create a subchannel for each address.
   for (size_t i = 0; i < addresses.size(); i++) {
     // TODO(roth): we should ideally hide this from the LB policy code. In
@@ -387,53 +460,160 @@ SubchannelList<SubchannelListType, SubchannelDataType>::SubchannelList(
     if (addresses[i].IsBalancer()) {
       continue;
     }
-    InlinedVector<grpc_arg, 3> args_to_add;
-    const size_t subchannel_address_arg_index = args_to_add.size();
-    args_to_add.emplace_back(
-        Subchannel::CreateSubchannelAddressArg(&addresses[i].address()));
-    if (addresses[i].args() != nullptr) {
-      for (size_t j = 0; j < addresses[i].args()->num_args; ++j) {
-        args_to_add.emplace_back(addresses[i].args()->args[j]);
-      }
+    for (int connection_index = 0; connection_index < connections_per_address_;
+         ++connection_index) {
+      AddSubchannelLocked(addresses[i], connection_index, helper);
     }
-    grpc_channel_args* new_args = grpc_channel_args_copy_and_add_and_remove(
-        &args, keys_to_remove, GPR_ARRAY_SIZE(keys_to_remove),
-        args_to_add.data(), args_to_add.size());
-    gpr_free(args_to_add[subchannel_address_arg_index].value.string);
-    RefCountedPtr<SubchannelInterface> subchannel =
-        helper->CreateSubchannel(*new_args);
-    grpc_channel_args_destroy(new_args);
-    if (subchannel == nullptr) {
-      // Subchannel could not be created.
-      if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
-        char* address_uri = grpc_sockaddr_to_uri(&addresses[i].address());
-        gpr_log(GPR_INFO,
-                "[%s %p] could not create subchannel for address uri %s, "
-                "ignoring",
-                tracer_->name(), policy_, address_uri);
-        gpr_free(address_uri);
-      }
-      continue;
+  }
+}
+
+template <typename SubchannelListType, typename SubchannelDataType>
+SubchannelList<SubchannelListType, SubchannelDataType>::~SubchannelList() {
+  if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
+    gpr_log(GPR_INFO, "[%s %p] Destroying subchannel_list %p", tracer_->name(),
+            policy_, this);
+  }
+  grpc_channel_args_destroy(args_);
+}
+
+template <typename SubchannelListType, typename SubchannelDataType>
+void SubchannelList<SubchannelListType, SubchannelDataType>::
+    AddSubchannelLocked(const ServerAddress& address, int connection_index,
+                        LoadBalancingPolicy::ChannelControlHelper* helper) {
+  InlinedVector<grpc_arg, 4> args_to_add;
+  const size_t subchannel_address_arg_index = args_to_add.size();
+  args_to_add.emplace_back(
+      Subchannel::CreateSubchannelAddressArg(&address.address()));
+  // The first connection keeps the key it has without this arg, so that
+  // it can still be shared with the channels that do not set it.
+  if (connection_index > 0) {
+    args_to_add.emplace_back(grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_SUBCHANNEL_CONNECTION_INDEX),
+        connection_index));
+  }
+  if (address.args() != nullptr) {
+    for (size_t j = 0; j < address.args()->num_args; ++j) {
+      args_to_add.emplace_back(address.args()->args[j]);
     }
+  }
+  grpc_channel_args* new_args = grpc_channel_args_copy_and_add(
+      args_, args_to_add.data(), args_to_add.size());
+  gpr_free(args_to_add[subchannel_address_arg_index].value.string);
+  RefCountedPtr<SubchannelInterface> subchannel =
+      helper->CreateSubchannel(*new_args);
+  grpc_channel_args_destroy(new_args);
+  if (subchannel == nullptr) {
+    // Subchannel could not be created.
     if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
-      char* address_uri = grpc_sockaddr_to_uri(&addresses[i].address());
+      char* address_uri = grpc_sockaddr_to_uri(&address.address());
       gpr_log(GPR_INFO,
-              "[%s %p] subchannel list %p index %" PRIuPTR
-              ": Created subchannel %p for address uri %s",
-              tracer_->name(), policy_, this, subchannels_.size(),
-              subchannel.get(), address_uri);
+              "[%s %p] could not create subchannel for address uri %s, "
+              "ignoring",
+              tracer_->name(), policy_, address_uri);
       gpr_free(address_uri);
     }
-    subchannels_.emplace_back(this, addresses[i], std::move(subchannel));
+    return;
   }
+  if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
+    char* address_uri = grpc_sockaddr_to_uri(&address.address());
+    gpr_log(GPR_INFO,
+            "[%s %p] subchannel list %p index %" PRIuPTR
+            ": Created subchannel %p for address uri %s (connection %d)",
+            tracer_->name(), policy_, this, subchannels_.size(),
+            subchannel.get(), address_uri, connection_index);
+    gpr_free(address_uri);
+  }
+  UniquePtr<SubchannelDataType> sd =
+      MakeUnique<SubchannelDataType>(this, address, std::move(subchannel));
+  sd->index_ = subchannels_.size();
+  sd->connection_index_ = connection_index;
+  subchannels_.emplace_back(std::move(sd));
 }
 
 template <typename SubchannelListType, typename SubchannelDataType>
-SubchannelList<SubchannelListType, SubchannelDataType>::~SubchannelList() {
+bool SubchannelList<SubchannelListType, SubchannelDataType>::AddressKeyLess::
+operator()(const AddressKey& a, const AddressKey& b) const {
+  const grpc_resolved_address& a_addr = a.address->address();
+  const grpc_resolved_address& b_addr = b.address->address();
+  if (a_addr.len != b_addr.len) return a_addr.len < b_addr.len;
+  int r = memcmp(a_addr.addr, b_addr.addr, a_addr.len);
+  if (r != 0) return r < 0;
+  r = grpc_channel_args_compare(a.address->args(), b.address->args());
+  if (r != 0) return r < 0;
+  return a.connection_index < b.connection_index;
+}
+
+template <typename SubchannelListType, typename SubchannelDataType>
+bool SubchannelList<SubchannelListType, SubchannelDataType>::
+    ComputeDeltaLocked(const ServerAddressList& addresses,
+                       const grpc_channel_args& args, Delta* delta) const {
+  grpc_channel_args* stripped_args = grpc_channel_args_copy_and_remove(
+      &args, kSubchannelListKeysToRemove,
+      GPR_ARRAY_SIZE(kSubchannelListKeysToRemove));
+  const bool same_args = grpc_channel_args_compare(stripped_args, args_) == 0;
+  grpc_channel_args_destroy(stripped_args);
+  if (!same_args) return false;
+  Map<AddressKey, size_t, AddressKeyLess> existing;
+  for (size_t i = 0; i < subchannels_.size(); ++i) {
+    const SubchannelDataType* sd = subchannels_[i].get();
+    if (!existing
+             .emplace(AddressKey{&sd->address_, sd->connection_index_}, i)
+             .second) {
+      return false;
+    }
+  }
+  InlinedVector<bool, 10> kept;
+  kept.reserve(subchannels_.size());
+  for (size_t i = 0; i < subchannels_.size(); ++i) kept.push_back(false);
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    if (addresses[i].IsBalancer()) continue;
+    for (int connection_index = 0; connection_index < connections_per_address_;
+         ++connection_index) {
+      auto it = existing.find(AddressKey{&addresses[i], connection_index});
+      if (it != existing.end() && !kept[it->second]) {
+        kept[it->second] = true;
+      } else {
+        delta->added.emplace_back(&addresses[i], connection_index);
+      }
+    }
+  }
+  for (size_t i = 0; i < subchannels_.size(); ++i) {
+    if (!kept[i]) delta->removed.push_back(i);
+  }
+  return true;
+}
+
+template <typename SubchannelListType, typename SubchannelDataType>
+size_t SubchannelList<SubchannelListType, SubchannelDataType>::
+    ApplyDeltaLocked(const Delta& delta,
+                     LoadBalancingPolicy::ChannelControlHelper* helper) {
   if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
-    gpr_log(GPR_INFO, "[%s %p] Destroying subchannel_list %p", tracer_->name(),
-            policy_, this);
+    gpr_log(GPR_INFO,
+            "[%s %p] Updating subchannel list %p in place: removing %" PRIuPTR
+            " and adding %" PRIuPTR " of %" PRIuPTR " subchannels",
+            tracer_->name(), policy_, this, delta.removed.size(),
+            delta.added.size(), subchannels_.size());
+  }
+  for (size_t i = 0; i < delta.removed.size(); ++i) {
+    UniquePtr<SubchannelDataType>& sd = subchannels_[delta.removed[i]];
+    sd->ShutdownLocked();
+    sd.reset();
+  }
+  if (!delta.removed.empty()) {
+    size_t size = 0;
+    for (size_t i = 0; i < subchannels_.size(); ++i) {
+      if (subchannels_[i] == nullptr) continue;
+      if (i != size) subchannels_[size] = std::move(subchannels_[i]);
+      subchannels_[size]->index_ = size;
+      ++size;
+    }
+    while (subchannels_.size() > size) subchannels_.pop_back();
+  }
+  const size_t first_added = subchannels_.size();
+  for (size_t i = 0; i < delta.added.size(); ++i) {
+    AddSubchannelLocked(*delta.added[i].first, delta.added[i].second, helper);
   }
+  return first_added;
 }
 
 template <typename SubchannelListType, typename SubchannelDataType>
@@ -445,7 +625,7 @@ void SubchannelList<SubchannelListType, SubchannelDataType>::ShutdownLocked() {
   GPR_ASSERT(!shutting_down_);
   shutting_down_ = true;
   for (size_t i = 0; i < subchannels_.size(); i++) {
-    SubchannelDataType* sd = &subchannels_[i];
+    SubchannelDataType* sd = subchannels_[i].get();
     sd->ShutdownLocked();
   }
 }
@@ -454,7 +634,7 @@ template <typename SubchannelListType, typename SubchannelDataType>
 void SubchannelList<SubchannelListType,
                     SubchannelDataType>::ResetBackoffLocked() {
   for (size_t i = 0; i < subchannels_.size(); i++) {
-    SubchannelDataType* sd = &subchannels_[i];
+    SubchannelDataType* sd = subchannels_[i].get();
     sd->ResetBackoffLocked();
   }
 }
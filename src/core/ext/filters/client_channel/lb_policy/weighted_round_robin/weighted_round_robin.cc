@@ -0,0 +1,757 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Weighted Round Robin Policy.
+ *
+ * Connects to every address like round_robin, but weights the READY
+ * subchannels by the load their backends report: a backend that reports
+ * half the utilization of another one gets twice its calls. Backends report
+ * their utilization (a number, 1 meaning fully loaded) in the trailing
+ * metadata of their responses with
+ * grpc::load_reporter::experimental::AddLoadReportingCost(), under the cost
+ * name configured as \a costName ("cpu_utilization" by default). Reports are
+ * smoothed per backend, and the weights are refreshed every second; backends
+ * that have not reported yet get the mean weight of the others. Calls are
+ * spread according to the weights with an earliest deadline first schedule,
+ * which interleaves the backends rather than sending bursts to the heavy
+ * ones. The policy is configured in the service config as
+ *
+ *   "loadBalancingConfig": [
+ *     { "weighted_round_robin": { "costName": "cpu_utilization" } }
+ *   ]
+ *
+ * Note that the server_load_reporting filter consumes the cost reports, so
+ * backends using it do not pass them on to the clients.
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <grpc/load_reporting.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_weighted_round_robin_trace(false, "weighted_round_robin");
+
+namespace {
+
+//
+// weighted_round_robin LB policy
+//
+
+constexpr char kWeightedRoundRobin[] = "weighted_round_robin";
+
+// Cost name the backend utilization is reported under, unless configured
+// otherwise.
+constexpr char kDefaultCostName[] = "cpu_utilization";
+// Interval between two refreshes of the weights.
+constexpr grpc_millis kWeightUpdatePeriodMs = 1000;
+// Share of a new utilization report in the smoothed utilization.
+constexpr double kUtilizationSmoothing = 0.25;
+// Utilizations below this one are counted as this one, bounding the weight
+// of idle backends.
+constexpr double kMinUtilization = 0.01;
+
+class ParsedWeightedRoundRobinConfig : public LoadBalancingPolicy::Config {
+ public:
+  explicit ParsedWeightedRoundRobinConfig(UniquePtr<char> cost_name)
+      : cost_name_(std::move(cost_name)) {}
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  const char* cost_name() const { return cost_name_.get(); }
+
+ private:
+  UniquePtr<char> cost_name_;
+};
+
+class WeightedRoundRobin : public LoadBalancingPolicy {
+ public:
+  explicit WeightedRoundRobin(Args args);
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~WeightedRoundRobin();
+
+  // Forward declaration.
+  class WeightedRoundRobinSubchannelList;
+
+  // The smoothed utilization reported by a backend. Updated when the
+  // trailing metadata of a call is received, so it is shared with the calls,
+  // which can outlive both the picker and the subchannel list.
+  class BackendLoad : public RefCounted<BackendLoad> {
+   public:
+    explicit BackendLoad(const char* cost_name)
+        : cost_name_(gpr_strdup(cost_name)) {}
+
+    const char* cost_name() const { return cost_name_.get(); }
+
+    // Returns the smoothed utilization, or a negative number if the backend
+    // has not reported any.
+    double utilization() {
+      MutexLock lock(&mu_);
+      return utilization_;
+    }
+
+    void RecordUtilization(double utilization) {
+      MutexLock lock(&mu_);
+      if (utilization_ < 0) {
+        utilization_ = utilization;
+      } else {
+        utilization_ += kUtilizationSmoothing * (utilization - utilization_);
+      }
+    }
+
+   private:
+    UniquePtr<char> cost_name_;
+    Mutex mu_;
+    double utilization_ = -1;
+  };
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the load reported by the subchannel's backend.
+  class WeightedRoundRobinSubchannelData
+      : public SubchannelData<WeightedRoundRobinSubchannelList,
+                              WeightedRoundRobinSubchannelData> {
+   public:
+    WeightedRoundRobinSubchannelData(
+        SubchannelList<WeightedRoundRobinSubchannelList,
+                       WeightedRoundRobinSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)),
+          load_(MakeRefCounted<BackendLoad>(
+              static_cast<WeightedRoundRobin*>(subchannel_list->policy())
+                  ->config_->cost_name())) {}
+
+    grpc_connectivity_state connectivity_state() const {
+      return last_connectivity_state_;
+    }
+
+    const RefCountedPtr<BackendLoad>& load() const { return load_; }
+
+    void UpdateConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    RefCountedPtr<BackendLoad> load_;
+  };
+
+  // A list of subchannels.
+  class WeightedRoundRobinSubchannelList
+      : public SubchannelList<WeightedRoundRobinSubchannelList,
+                              WeightedRoundRobinSubchannelData> {
+   public:
+    WeightedRoundRobinSubchannelList(WeightedRoundRobin* policy,
+                                     TraceFlag* tracer,
+                                     const ServerAddressList& addresses,
+                                     const grpc_channel_args& args)
+        : SubchannelList(policy, tracer, addresses,
+                         policy->channel_control_helper(), args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~WeightedRoundRobinSubchannelList() {
+      WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked();
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // If this subchannel list is the WRR policy's current subchannel
+    // list, updates the WRR policy's connectivity state based on the
+    // subchannel list's state counters.
+    void MaybeUpdateWeightedRoundRobinConnectivityStateLocked();
+
+    // Updates the WRR policy's overall state based on the counters of
+    // subchannels in each state.
+    void UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked();
+
+    // If this subchannel list is the WRR policy's current subchannel list
+    // and the policy is READY, replaces the picker by one weighted by the
+    // latest loads.
+    void MaybeUpdatePickerWeightsLocked();
+
+   private:
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(WeightedRoundRobin* parent,
+           WeightedRoundRobinSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    struct ReadySubchannel {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<BackendLoad> load;
+      // Time between two picks of this subchannel, the inverse of its
+      // weight.
+      double period;
+    };
+
+    // An entry of the earliest deadline first schedule.
+    struct ScheduleEntry {
+      double deadline;
+      size_t index;
+    };
+
+    // Orders the schedule as a min heap of deadlines; ties go to the lowest
+    // index.
+    static bool LaterDeadline(const ScheduleEntry& lhs,
+                              const ScheduleEntry& rhs) {
+      if (lhs.deadline != rhs.deadline) return lhs.deadline > rhs.deadline;
+      return lhs.index > rhs.index;
+    }
+
+    // Runs when the trailing metadata of a call picked for a subchannel is
+    // received, outside of the LB policy's combiner.
+    static void RecordCallCompletion(
+        void* arg, grpc_error* error,
+        LoadBalancingPolicy::MetadataInterface* recv_trailing_metadata,
+        LoadBalancingPolicy::CallState* call_state);
+
+    // Using pointer value only, no ref held -- do not dereference!
+    WeightedRoundRobin* parent_;
+
+    InlinedVector<ReadySubchannel, 10> subchannels_;
+    InlinedVector<ScheduleEntry, 10> schedule_;
+  };
+
+  void ShutdownLocked() override;
+
+  void StartWeightUpdateTimerLocked();
+  static void OnWeightUpdateTimerLocked(void* arg, grpc_error* error);
+
+  /** latest config, or the defaults */
+  RefCountedPtr<ParsedWeightedRoundRobinConfig> config_;
+  /** list of subchannels */
+  OrphanablePtr<WeightedRoundRobinSubchannelList> subchannel_list_;
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  OrphanablePtr<WeightedRoundRobinSubchannelList>
+      latest_pending_subchannel_list_;
+  /** are we shutting down? */
+  bool shutdown_ = false;
+  /** timer refreshing the picker weights */
+  bool weight_update_timer_pending_ = false;
+  grpc_timer weight_update_timer_;
+  grpc_closure on_weight_update_timer_;
+};
+
+//
+// WeightedRoundRobin::Picker
+//
+
+WeightedRoundRobin::Picker::Picker(
+    WeightedRoundRobin* parent,
+    WeightedRoundRobinSubchannelList* subchannel_list)
+    : parent_(parent) {
+  // Weigh the backends that reported a load by the inverse of their
+  // utilization, and the others by the mean weight of the former.
+  InlinedVector<double, 10> weights;
+  double total_weight = 0;
+  size_t num_reported = 0;
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    WeightedRoundRobinSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() != GRPC_CHANNEL_READY) continue;
+    const double utilization = sd->load()->utilization();
+    double weight = 0;
+    if (utilization >= 0) {
+      weight = 1 / std::max(utilization, kMinUtilization);
+      total_weight += weight;
+      ++num_reported;
+    }
+    weights.push_back(weight);
+    subchannels_.push_back(
+        ReadySubchannel{sd->subchannel()->Ref(), sd->load(), 0});
+  }
+  const double mean_weight =
+      num_reported > 0 ? total_weight / num_reported : 1;
+  for (size_t i = 0; i < subchannels_.size(); ++i) {
+    ReadySubchannel& subchannel = subchannels_[i];
+    subchannel.period = 1 / (weights[i] > 0 ? weights[i] : mean_weight);
+    // Start every subchannel at a random point of its period, so that
+    // successive pickers do not all begin with the same subchannels.
+    // TODO(roth): rand(3) is not thread-safe.  This should be replaced with
+    // something better as part of https://github.com/grpc/grpc/issues/17891.
+    const double offset = static_cast<double>(rand()) / RAND_MAX;
+    schedule_.push_back(ScheduleEntry{offset * subchannel.period, i});
+  }
+  std::make_heap(schedule_.data(), schedule_.data() + schedule_.size(),
+                 LaterDeadline);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels, %" PRIuPTR
+            " of which reported a load",
+            parent_, this, subchannel_list, subchannels_.size(),
+            num_reported);
+    for (size_t i = 0; i < subchannels_.size(); ++i) {
+      gpr_log(GPR_INFO, "[WRR %p picker %p] subchannel %p weight %f", parent_,
+              this, subchannels_[i].subchannel.get(),
+              1 / subchannels_[i].period);
+    }
+  }
+}
+
+WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
+    PickArgs args) {
+  // Take the subchannel with the earliest deadline and schedule its next
+  // pick one period later.
+  ScheduleEntry* begin = schedule_.data();
+  ScheduleEntry* end = begin + schedule_.size();
+  std::pop_heap(begin, end, LaterDeadline);
+  ScheduleEntry& entry = *(end - 1);
+  const ReadySubchannel& subchannel = subchannels_[entry.index];
+  entry.deadline += subchannel.period;
+  std::push_heap(begin, end, LaterDeadline);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] returning subchannel=%p, next deadline %f",
+            parent_, this, subchannel.subchannel.get(), entry.deadline);
+  }
+  PickResult result;
+  result.type = PickResult::PICK_COMPLETE;
+  result.subchannel = subchannel.subchannel;
+  // Intercept the recv_trailing_metadata op to record the reported load.
+  result.recv_trailing_metadata_ready = RecordCallCompletion;
+  result.recv_trailing_metadata_ready_user_data =
+      subchannel.load->Ref().release();
+  return result;
+}
+
+void WeightedRoundRobin::Picker::RecordCallCompletion(
+    void* arg, grpc_error* error,
+    LoadBalancingPolicy::MetadataInterface* recv_trailing_metadata,
+    LoadBalancingPolicy::CallState* call_state) {
+  BackendLoad* load = static_cast<BackendLoad*>(arg);
+  if (recv_trailing_metadata != nullptr) {
+    // The cost entries are a double in host byte order followed by the cost
+    // name, see AddLoadReportingCost().
+    const StringView cost_key(GRPC_LB_COST_MD_KEY);
+    const StringView cost_name(load->cost_name());
+    for (MetadataInterface::Iterator it = recv_trailing_metadata->Begin();
+         !recv_trailing_metadata->IsEnd(it);
+         recv_trailing_metadata->Next(&it)) {
+      if (!(recv_trailing_metadata->Key(it) == cost_key)) continue;
+      StringView value = recv_trailing_metadata->Value(it);
+      double utilization;
+      if (value.size() < sizeof(utilization)) continue;
+      memcpy(&utilization, value.data(), sizeof(utilization));
+      if (!(value.substr(sizeof(utilization)) == cost_name)) continue;
+      if (!std::isfinite(utilization) || utilization < 0) continue;
+      load->RecordUtilization(utilization);
+      break;
+    }
+  }
+  load->Unref();
+}
+
+//
+// WeightedRoundRobin
+//
+
+WeightedRoundRobin::WeightedRoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)),
+      config_(MakeRefCounted<ParsedWeightedRoundRobinConfig>(
+          UniquePtr<char>(gpr_strdup(kDefaultCostName)))) {
+  GRPC_CLOSURE_INIT(&on_weight_update_timer_,
+                    &WeightedRoundRobin::OnWeightUpdateTimerLocked, this,
+                    grpc_combiner_scheduler(combiner()));
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+  }
+}
+
+WeightedRoundRobin::~WeightedRoundRobin() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Destroying Weighted Round Robin policy",
+            this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void WeightedRoundRobin::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  if (weight_update_timer_pending_) {
+    grpc_timer_cancel(&weight_update_timer_);
+  }
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void WeightedRoundRobin::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+void WeightedRoundRobin::StartWeightUpdateTimerLocked() {
+  weight_update_timer_pending_ = true;
+  Ref(DEBUG_LOCATION, "on_weight_update_timer").release();
+  grpc_timer_init(&weight_update_timer_,
+                  ExecCtx::Get()->Now() + kWeightUpdatePeriodMs,
+                  &on_weight_update_timer_);
+}
+
+void WeightedRoundRobin::OnWeightUpdateTimerLocked(void* arg,
+                                                   grpc_error* error) {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(arg);
+  p->weight_update_timer_pending_ = false;
+  if (error == GRPC_ERROR_NONE && !p->shutdown_) {
+    if (p->subchannel_list_ != nullptr) {
+      p->subchannel_list_->MaybeUpdatePickerWeightsLocked();
+    }
+    p->StartWeightUpdateTimerLocked();
+  }
+  p->Unref(DEBUG_LOCATION, "on_weight_update_timer");
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    StartWatchingLocked() {
+  if (num_subchannels() == 0) return;
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->subchannel()->AttemptToConnect();
+    }
+  }
+  // Now set the LB policy's state based on the subchannels' states.
+  UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked();
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                              grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+// Sets the WRR policy's connectivity state and generates a new picker based
+// on the current subchannel list.
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    MaybeUpdateWeightedRoundRobinConnectivityStateLocked() {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  /* In priority order. The first rule to match terminates the search (ie, if we
+   * are on rule n, all previous rules were unfulfilled).
+   *
+   * 1) RULE: ANY subchannel is READY => policy is READY.
+   *    CHECK: subchannel_list->num_ready > 0.
+   *
+   * 2) RULE: ANY subchannel is CONNECTING => policy is CONNECTING.
+   *    CHECK: sd->curr_connectivity_state == CONNECTING.
+   *
+   * 3) RULE: ALL subchannels are TRANSIENT_FAILURE => policy is
+   *                                                   TRANSIENT_FAILURE.
+   *    CHECK: subchannel_list->num_transient_failures ==
+   *           subchannel_list->num_subchannels.
+   */
+  if (num_ready_ > 0) {
+    /* 1) READY */
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, UniquePtr<SubchannelPicker>(New<Picker>(p, this)));
+  } else if (num_connecting_ > 0) {
+    /* 2) CONNECTING */
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, UniquePtr<SubchannelPicker>(New<QueuePicker>(
+                                     p->Ref(DEBUG_LOCATION, "QueuePicker"))));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    /* 3) TRANSIENT_FAILURE */
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                               "connections to all backends failing"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        UniquePtr<SubchannelPicker>(New<TransientFailurePicker>(error)));
+  }
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked() {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  if (num_ready_ > 0) {
+    if (p->subchannel_list_.get() != this) {
+      // Promote this list to p->subchannel_list_.
+      // This list must be p->latest_pending_subchannel_list_, because
+      // any previous update would have been shut down already and
+      // therefore we would not be receiving a notification for them.
+      GPR_ASSERT(p->latest_pending_subchannel_list_.get() == this);
+      GPR_ASSERT(!shutting_down());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+        const size_t old_num_subchannels =
+            p->subchannel_list_ != nullptr
+                ? p->subchannel_list_->num_subchannels()
+                : 0;
+        gpr_log(GPR_INFO,
+                "[WRR %p] phasing out subchannel list %p (size %" PRIuPTR
+                ") in favor of %p (size %" PRIuPTR ")",
+                p, p->subchannel_list_.get(), old_num_subchannels, this,
+                num_subchannels());
+      }
+      p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+    }
+  }
+  // Update the WRR policy's connectivity state if needed.
+  MaybeUpdateWeightedRoundRobinConnectivityStateLocked();
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    MaybeUpdatePickerWeightsLocked() {
+  if (num_ready_ == 0) return;
+  MaybeUpdateWeightedRoundRobinConnectivityStateLocked();
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    UpdateConnectivityStateLocked(grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[WRR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        grpc_connectivity_state_name(last_connectivity_state_),
+        grpc_connectivity_state_name(connectivity_state));
+  }
+  subchannel_list()->UpdateStateCountersLocked(last_connectivity_state_,
+                                               connectivity_state);
+  last_connectivity_state_ = connectivity_state;
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE, re-resolve.
+  // Only do this if we've started watching, not at startup time.
+  // Otherwise, if the subchannel was already in state TRANSIENT_FAILURE
+  // when the subchannel list was created, we'd wind up in a constant
+  // loop of re-resolution.
+  // Also attempt to reconnect.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p has gone into TRANSIENT_FAILURE. "
+              "Requesting re-resolution",
+              p, subchannel());
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->AttemptToConnect();
+  }
+  // Update state counters.
+  UpdateConnectivityStateLocked(connectivity_state);
+  // Update overall state and renew notification.
+  subchannel_list()
+      ->UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked();
+}
+
+void WeightedRoundRobin::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] received update with %" PRIuPTR " addresses",
+            this, args.addresses.size());
+  }
+  // The subchannel list created from now on uses the new config.
+  if (args.config != nullptr) {
+    config_.reset(
+        static_cast<ParsedWeightedRoundRobinConfig*>(args.config.release()));
+  }
+  if (!weight_update_timer_pending_) StartWeightUpdateTimerLocked();
+  // Replace latest_pending_subchannel_list_.
+  if (latest_pending_subchannel_list_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Shutting down previous pending subchannel list %p",
+              this, latest_pending_subchannel_list_.get());
+    }
+  }
+  latest_pending_subchannel_list_ =
+      MakeOrphanable<WeightedRoundRobinSubchannelList>(
+          this, &grpc_lb_weighted_round_robin_trace, args.addresses,
+          *args.args);
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    // If the new list is empty, immediately promote the new list to the
+    // current list and transition to TRANSIENT_FAILURE.
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        UniquePtr<SubchannelPicker>(New<TransientFailurePicker>(error)));
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  } else if (subchannel_list_ == nullptr) {
+    // If there is no current list, immediately promote the new list to
+    // the current list and start watching it.
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    subchannel_list_->StartWatchingLocked();
+  } else {
+    // Start watching the pending list.  It will get swapped into the
+    // current list when it reports READY.
+    latest_pending_subchannel_list_->StartWatchingLocked();
+  }
+}
+
+//
+// factory
+//
+
+class WeightedRoundRobinFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return OrphanablePtr<LoadBalancingPolicy>(
+        New<WeightedRoundRobin>(std::move(args)));
+  }
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const grpc_json* json, grpc_error** error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    UniquePtr<char> cost_name;
+    if (json != nullptr) {
+      GPR_DEBUG_ASSERT(strcmp(json->key, name()) == 0);
+      InlinedVector<grpc_error*, 2> error_list;
+      for (const grpc_json* field = json->child; field != nullptr;
+           field = field->next) {
+        if (field->key == nullptr) continue;
+        if (strcmp(field->key, "costName") == 0) {
+          if (cost_name != nullptr) {
+            error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "field:costName error:Duplicate entry"));
+            continue;
+          }
+          if (field->type != GRPC_JSON_STRING || field->value[0] == '\0') {
+            error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "field:costName error:should be a non-empty string"));
+            continue;
+          }
+          cost_name.reset(gpr_strdup(field->value));
+        }
+      }
+      if (!error_list.empty()) {
+        *error = GRPC_ERROR_CREATE_FROM_VECTOR("WeightedRoundRobin Parser",
+                                               &error_list);
+        return nullptr;
+      }
+    }
+    if (cost_name == nullptr) cost_name.reset(gpr_strdup(kDefaultCostName));
+    return RefCountedPtr<LoadBalancingPolicy::Config>(
+        New<ParsedWeightedRoundRobinConfig>(std::move(cost_name)));
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_weighted_round_robin_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          grpc_core::UniquePtr<grpc_core::LoadBalancingPolicyFactory>(
+              grpc_core::New<grpc_core::WeightedRoundRobinFactory>()));
+}
+
+void grpc_lb_policy_weighted_round_robin_shutdown() {}
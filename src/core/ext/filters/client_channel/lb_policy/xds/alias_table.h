@@ -0,0 +1,115 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_XDS_ALIAS_TABLE_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_XDS_ALIAS_TABLE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/inlined_vector.h"
+#include "src/core/lib/gprpp/pair.h"
+
+namespace grpc_core {
+
+// Picks items at random with probabilities proportional to their weights, in
+// constant time however many items there are (Vose's alias method).
+//
+// Each item owns a column of height total_weight. The bottom of column i, up
+// to its threshold, picks item i and the rest of it picks the column's
+// alias. The columns are filled such that item i covers num_items * weight_i
+// of the whole area, so a point chosen uniformly at random falls on it with
+// probability weight_i / total_weight. Weights are integers and the table is
+// built with integer arithmetic, so those probabilities are exact.
+template <typename T, size_t N = 1>
+class AliasTable {
+ public:
+  // (weight, item) pairs. Items with a weight of 0 are never picked.
+  using WeightedList = InlinedVector<Pair<uint32_t, T>, N>;
+
+  // The list must have a non-zero total weight, which must fit in 32 bits.
+  explicit AliasTable(WeightedList items) {
+    const size_t num_items = items.size();
+    uint64_t total_weight = 0;
+    for (size_t i = 0; i < num_items; ++i) {
+      total_weight += items[i].first;
+    }
+    GPR_ASSERT(total_weight > 0 && total_weight <= UINT32_MAX);
+    total_weight_ = static_cast<uint32_t>(total_weight);
+    // Each item's remaining area, scaled so that a full column is
+    // total_weight. Items with less than a column left are "small".
+    InlinedVector<uint64_t, N> area;
+    InlinedVector<size_t, N> small;
+    InlinedVector<size_t, N> large;
+    for (size_t i = 0; i < num_items; ++i) {
+      area.push_back(static_cast<uint64_t>(items[i].first) * num_items);
+      if (area[i] < total_weight) {
+        small.push_back(i);
+      } else {
+        large.push_back(i);
+      }
+      columns_.push_back(Column{total_weight_, i});
+    }
+    // Top up each small item's column with part of a large item. The items
+    // left over fill their own columns, as initialized above.
+    while (!small.empty() && !large.empty()) {
+      const size_t s = small[small.size() - 1];
+      small.pop_back();
+      const size_t l = large[large.size() - 1];
+      columns_[s].threshold = static_cast<uint32_t>(area[s]);
+      columns_[s].alias = l;
+      area[l] -= total_weight - area[s];
+      if (area[l] < total_weight) {
+        small.push_back(l);
+        large.pop_back();
+      }
+    }
+    for (size_t i = 0; i < num_items; ++i) {
+      items_.push_back(std::move(items[i].second));
+    }
+  }
+
+  // Returns an item, given two uniformly distributed random numbers.
+  const T& Pick(uint32_t column_rand, uint32_t height_rand) const {
+    const size_t index = column_rand % columns_.size();
+    const Column& column = columns_[index];
+    return items_[height_rand % total_weight_ < column.threshold
+                      ? index
+                      : column.alias];
+  }
+
+  size_t size() const { return items_.size(); }
+
+ private:
+  struct Column {
+    // Heights below this pick the column's own item.
+    uint32_t threshold;
+    size_t alias;
+  };
+
+  uint32_t total_weight_;
+  InlinedVector<Column, N> columns_;
+  InlinedVector<T, N> items_;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_XDS_ALIAS_TABLE_H */
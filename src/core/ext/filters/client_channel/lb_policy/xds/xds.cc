@@ -71,6 +71,7 @@
 #include "include/grpc/support/alloc.h"
 #include "src/core/ext/filters/client_channel/client_channel.h"
 #include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/xds/alias_table.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds_channel.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds_client_stats.h"
@@ -110,6 +111,8 @@
 #define GRPC_XDS_DEFAULT_FALLBACK_TIMEOUT_MS 10000
 #define GRPC_XDS_MIN_CLIENT_LOAD_REPORTING_INTERVAL_MS 1000
 #define GRPC_XDS_DEFAULT_LOCALITY_RETENTION_INTERVAL_MS (15 * 60 * 1000)
+#define GRPC_XDS_DELTA_ENDPOINTS_METHOD \
+  "/envoy.api.v2.EndpointDiscoveryService/DeltaEndpoints"
 
 namespace grpc_core {
 
@@ -212,12 +215,19 @@ class XdsLb : public LoadBalancingPolicy {
      private:
       static void OnResponseReceivedLocked(void* arg, grpc_error* error);
       static void OnStatusReceivedLocked(void* arg, grpc_error* error);
+      static void OnRequestSentLocked(void* arg, grpc_error* error);
 
       bool IsCurrentCallOnChannel() const;
 
+      // Sends an ACK or NACK on a delta stream, or buffers it if a previous
+      // request is still being sent. Takes ownership of \a error.
+      void SendDeltaAckLocked(const char* nonce, grpc_error* error);
+
       // The owning RetryableLbCall<>.
       RefCountedPtr<RetryableLbCall<EdsCallState>> parent_;
       bool seen_response_ = false;
+      // Whether this call uses the incremental xDS protocol.
+      const bool delta_;
 
       // Always non-NULL.
       grpc_call* lb_call_;
@@ -227,6 +237,9 @@ class XdsLb : public LoadBalancingPolicy {
 
       // send_message
       grpc_byte_buffer* send_message_payload_ = nullptr;
+      // Only used on delta streams, which send a request per response.
+      grpc_closure on_request_sent_;
+      InlinedVector<grpc_slice, 1> buffered_requests_;
 
       // recv_message
       grpc_byte_buffer* recv_message_payload_ = nullptr;
@@ -368,6 +381,10 @@ class XdsLb : public LoadBalancingPolicy {
     // The retryable XDS calls to the LB server.
     OrphanablePtr<RetryableLbCall<EdsCallState>> eds_calld_;
     OrphanablePtr<RetryableLbCall<LrsCallState>> lrs_calld_;
+
+    // The versions of the EDS resources received over delta streams on this
+    // channel, so that a restarted call doesn't get them resent.
+    XdsResourceVersionMap eds_versions_;
   };
 
   // We need this wrapper for the following reasons:
@@ -400,12 +417,11 @@ class XdsLb : public LoadBalancingPolicy {
   // use for each request.
   class Picker : public SubchannelPicker {
    public:
-    // Maintains a weighted list of pickers from each locality that is in ready
-    // state. The first element in the pair represents the end of a range
-    // proportional to the locality's weight. The start of the range is the
-    // previous value in the vector and is 0 for the first element.
-    using PickerList =
-        InlinedVector<Pair<uint32_t, RefCountedPtr<PickerWrapper>>, 1>;
+    // The pickers of the localities that are in ready state, chosen with
+    // probability proportional to their weights in constant time.
+    using PickerTable = AliasTable<RefCountedPtr<PickerWrapper>, 1>;
+    // The weight of each locality in the first element of the pair.
+    using PickerList = PickerTable::WeightedList;
     Picker(RefCountedPtr<XdsLb> xds_policy, PickerList pickers)
         : xds_policy_(std::move(xds_policy)),
           pickers_(std::move(pickers)),
@@ -414,11 +430,8 @@ class XdsLb : public LoadBalancingPolicy {
     PickResult Pick(PickArgs args) override;
 
    private:
-    // Calls the picker of the locality that the key falls within.
-    PickResult PickFromLocality(const uint32_t key, PickArgs args);
-
     RefCountedPtr<XdsLb> xds_policy_;
-    PickerList pickers_;
+    PickerTable pickers_;
     RefCountedPtr<XdsDropConfig> drop_config_;
   };
 
@@ -468,6 +481,9 @@ class XdsLb : public LoadBalancingPolicy {
         return connectivity_state_;
       }
       uint32_t locality_weight() const { return locality_weight_; }
+      void set_locality_weight(uint32_t locality_weight) {
+        locality_weight_ = locality_weight;
+      }
       RefCountedPtr<PickerWrapper> picker_wrapper() const {
         return picker_wrapper_;
       }
@@ -521,10 +537,13 @@ class XdsLb : public LoadBalancingPolicy {
 
     explicit LocalityMap(XdsLb* xds_policy) : xds_policy_(xds_policy) {}
 
+    // If previous_locality_list is given, the child policies of localities
+    // whose serverlist is the same in both lists are left as they are.
     void UpdateLocked(const XdsLocalityList& locality_list,
                       LoadBalancingPolicy::Config* child_policy_config,
                       const grpc_channel_args* args, XdsLb* parent,
-                      bool is_initial_update = false);
+                      bool is_initial_update = false,
+                      const XdsLocalityList* previous_locality_list = nullptr);
     void UpdateXdsPickerLocked();
     void ShutdownLocked();
     void ResetBackoffLocked();
@@ -581,6 +600,8 @@ class XdsLb : public LoadBalancingPolicy {
 
   // Timeout in milliseconds for the LB call. 0 means no deadline.
   const grpc_millis lb_call_timeout_ms_;
+  // Whether to use the incremental xDS protocol for EDS.
+  const bool use_delta_eds_;
 
   // Whether the checks for fallback at startup are ALL pending. There are
   // several cases where this can be reset:
@@ -646,7 +667,7 @@ LoadBalancingPolicy::PickResult XdsLb::PickerWrapper::Pick(
 }
 
 // Note that the following callback does not run in either the control plane
-// combiner or the data plane combiner.
+// combiner or the data plane mutex.
 void XdsLb::PickerWrapper::RecordCallCompletion(
     void* arg, grpc_error* error,
     LoadBalancingPolicy::MetadataInterface* recv_trailing_metadata,
@@ -671,33 +692,8 @@ XdsLb::PickResult XdsLb::Picker::Pick(PickArgs args) {
     result.type = PickResult::PICK_COMPLETE;
     return result;
   }
-  // Generate a random number in [0, total weight).
-  const uint32_t key = rand() % pickers_[pickers_.size() - 1].first;
-  // Forward pick to whichever locality maps to the range in which the
-  // random number falls in.
-  return PickFromLocality(key, args);
-}
-
-XdsLb::PickResult XdsLb::Picker::PickFromLocality(const uint32_t key,
-                                                  PickArgs args) {
-  size_t mid = 0;
-  size_t start_index = 0;
-  size_t end_index = pickers_.size() - 1;
-  size_t index = 0;
-  while (end_index > start_index) {
-    mid = (start_index + end_index) / 2;
-    if (pickers_[mid].first > key) {
-      end_index = mid;
-    } else if (pickers_[mid].first < key) {
-      start_index = mid + 1;
-    } else {
-      index = mid + 1;
-      break;
-    }
-  }
-  if (index == 0) index = start_index;
-  GPR_ASSERT(pickers_[index].first > key);
-  return pickers_[index].second->Pick(args);
+  // Forward pick to a locality chosen at random by weight.
+  return pickers_.Pick(rand(), rand())->Pick(args);
 }
 
 //
@@ -972,7 +968,8 @@ void XdsLb::LbChannelState::RetryableLbCall<T>::OnRetryTimerLocked(
 XdsLb::LbChannelState::EdsCallState::EdsCallState(
     RefCountedPtr<RetryableLbCall<EdsCallState>> parent)
     : InternallyRefCounted<EdsCallState>(&grpc_lb_xds_trace),
-      parent_(std::move(parent)) {
+      parent_(std::move(parent)),
+      delta_(xdslb_policy()->use_delta_eds_) {
   // Init the LB call. Note that the LB call will progress every time there's
   // activity in xdslb_policy()->interested_parties(), which is comprised of
   // the polling entities from client_channel.
@@ -984,15 +981,29 @@ XdsLb::LbChannelState::EdsCallState::EdsCallState(
           ? GRPC_MILLIS_INF_FUTURE
           : ExecCtx::Get()->Now() + xdslb_policy()->lb_call_timeout_ms_;
   // Create an LB call with the specified method name.
+  grpc_slice method =
+      GRPC_MDSTR_SLASH_ENVOY_DOT_API_DOT_V2_DOT_ENDPOINTDISCOVERYSERVICE_SLASH_STREAMENDPOINTS;
+  if (delta_) {
+    method = grpc_slice_from_static_string(GRPC_XDS_DELTA_ENDPOINTS_METHOD);
+  }
   lb_call_ = grpc_channel_create_pollset_set_call(
       lb_chand()->channel_, nullptr, GRPC_PROPAGATE_DEFAULTS,
-      xdslb_policy()->interested_parties(),
-      GRPC_MDSTR_SLASH_ENVOY_DOT_API_DOT_V2_DOT_ENDPOINTDISCOVERYSERVICE_SLASH_STREAMENDPOINTS,
-      nullptr, deadline, nullptr);
+      xdslb_policy()->interested_parties(), method, nullptr, deadline,
+      nullptr);
   GPR_ASSERT(lb_call_ != nullptr);
-  // Init the LB call request payload.
-  grpc_slice request_payload_slice =
-      XdsEdsRequestCreateAndEncode(xdslb_policy()->server_name_);
+  // Init the LB call request payload. A delta stream resumes from the versions
+  // already received on this channel.
+  grpc_slice request_payload_slice;
+  if (delta_) {
+    XdsResourceNameList subscribe;
+    subscribe.push_back(xdslb_policy()->server_name_);
+    request_payload_slice = XdsEdsDeltaRequestCreateAndEncode(
+        subscribe, XdsResourceNameList(), &lb_chand()->eds_versions_,
+        /*response_nonce=*/nullptr, GRPC_ERROR_NONE);
+  } else {
+    request_payload_slice =
+        XdsEdsRequestCreateAndEncode(xdslb_policy()->server_name_);
+  }
   send_message_payload_ =
       grpc_raw_byte_buffer_create(&request_payload_slice, 1);
   grpc_slice_unref_internal(request_payload_slice);
@@ -1003,12 +1014,15 @@ XdsLb::LbChannelState::EdsCallState::EdsCallState(
                     grpc_combiner_scheduler(xdslb_policy()->combiner()));
   GRPC_CLOSURE_INIT(&on_status_received_, OnStatusReceivedLocked, this,
                     grpc_combiner_scheduler(xdslb_policy()->combiner()));
+  GRPC_CLOSURE_INIT(&on_request_sent_, OnRequestSentLocked, this,
+                    grpc_combiner_scheduler(xdslb_policy()->combiner()));
   // Start the call.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_xds_trace)) {
     gpr_log(GPR_INFO,
-            "[xdslb %p] Starting EDS call (lb_chand: %p, lb_calld: %p, "
+            "[xdslb %p] Starting %sEDS call (lb_chand: %p, lb_calld: %p, "
             "lb_call: %p)",
-            xdslb_policy(), lb_chand(), this, lb_call_);
+            xdslb_policy(), delta_ ? "delta " : "", lb_chand(), this,
+            lb_call_);
   }
   // Create the ops.
   grpc_call_error call_error;
@@ -1028,8 +1042,11 @@ XdsLb::LbChannelState::EdsCallState::EdsCallState(
   op->flags = 0;
   op->reserved = nullptr;
   op++;
-  call_error = grpc_call_start_batch_and_execute(lb_call_, ops,
-                                                 (size_t)(op - ops), nullptr);
+  // A delta stream needs to know when the request is sent, so that the next
+  // one (ACKing a response) can follow.
+  if (delta_) Ref(DEBUG_LOCATION, "EDS+OnRequestSentLocked").release();
+  call_error = grpc_call_start_batch_and_execute(
+      lb_call_, ops, (size_t)(op - ops), delta_ ? &on_request_sent_ : nullptr);
   GPR_ASSERT(GRPC_CALL_OK == call_error);
   // Op: recv initial metadata.
   op = ops;
@@ -1071,6 +1088,9 @@ XdsLb::LbChannelState::EdsCallState::~EdsCallState() {
   grpc_metadata_array_destroy(&trailing_metadata_recv_);
   grpc_byte_buffer_destroy(send_message_payload_);
   grpc_byte_buffer_destroy(recv_message_payload_);
+  for (size_t i = 0; i < buffered_requests_.size(); ++i) {
+    grpc_slice_unref_internal(buffered_requests_[i]);
+  }
   grpc_slice_unref_internal(status_details_);
   GPR_ASSERT(lb_call_ != nullptr);
   grpc_call_unref(lb_call_);
@@ -1117,13 +1137,48 @@ void XdsLb::LbChannelState::EdsCallState::OnResponseReceivedLocked(
   [&]() {
     // Parse the response.
     XdsUpdate update;
-    grpc_error* parse_error =
-        XdsEdsResponseDecodeAndParse(response_slice, &update);
-    if (parse_error != GRPC_ERROR_NONE) {
-      gpr_log(GPR_ERROR, "[xdslb %p] EDS response parsing failed. error=%s",
-              xdslb_policy, grpc_error_string(parse_error));
-      GRPC_ERROR_UNREF(parse_error);
-      return;
+    if (eds_calld->delta_) {
+      XdsDeltaResponse delta_response;
+      grpc_error* parse_error = XdsEdsDeltaResponseDecodeAndParse(
+          response_slice, xdslb_policy->server_name_, &delta_response,
+          &update);
+      const bool parse_failed = parse_error != GRPC_ERROR_NONE;
+      if (parse_failed) {
+        gpr_log(GPR_ERROR,
+                "[xdslb %p] Delta EDS response parsing failed. error=%s",
+                xdslb_policy, grpc_error_string(parse_error));
+      }
+      // Every response is ACKed, or NACKed with the parsing error, so that
+      // the balancer knows which versions we hold.
+      if (delta_response.nonce != nullptr) {
+        eds_calld->SendDeltaAckLocked(delta_response.nonce.get(),
+                                      parse_error);
+      } else {
+        GRPC_ERROR_UNREF(parse_error);
+      }
+      if (parse_failed) return;
+      UniquePtr<char> resource_name(gpr_strdup(xdslb_policy->server_name_));
+      if (delta_response.removed) {
+        gpr_log(GPR_ERROR,
+                "[xdslb %p] EDS resource %s removed by the balancer; keeping "
+                "the current localities.",
+                xdslb_policy, xdslb_policy->server_name_);
+        lb_chand->eds_versions_.erase(resource_name);
+        return;
+      }
+      // Nothing changed for the resource we care about.
+      if (delta_response.version == nullptr) return;
+      lb_chand->eds_versions_[std::move(resource_name)] =
+          std::move(delta_response.version);
+    } else {
+      grpc_error* parse_error =
+          XdsEdsResponseDecodeAndParse(response_slice, &update);
+      if (parse_error != GRPC_ERROR_NONE) {
+        gpr_log(GPR_ERROR, "[xdslb %p] EDS response parsing failed. error=%s",
+                xdslb_policy, grpc_error_string(parse_error));
+        GRPC_ERROR_UNREF(parse_error);
+        return;
+      }
     }
     if (update.locality_list.empty() && !update.drop_all) {
       char* response_slice_str =
@@ -1214,11 +1269,15 @@ void XdsLb::LbChannelState::EdsCallState::OnResponseReceivedLocked(
       return;
     }
     // Update the locality list.
+    XdsLocalityList previous_locality_list =
+        std::move(xdslb_policy->locality_list_);
     xdslb_policy->locality_list_ = std::move(update.locality_list);
-    // Update the locality map.
+    // Update the locality map. Only the localities whose serverlist changed
+    // need to update their child policy.
     xdslb_policy->locality_map_.UpdateLocked(
         xdslb_policy->locality_list_, xdslb_policy->child_policy_config_.get(),
-        xdslb_policy->args_, xdslb_policy);
+        xdslb_policy->args_, xdslb_policy, /*is_initial_update=*/false,
+        &previous_locality_list);
   }();
   grpc_slice_unref_internal(response_slice);
   if (xdslb_policy->shutting_down_) {
@@ -1291,6 +1350,58 @@ void XdsLb::LbChannelState::EdsCallState::OnStatusReceivedLocked(
   eds_calld->Unref(DEBUG_LOCATION, "EDS+OnStatusReceivedLocked");
 }
 
+void XdsLb::LbChannelState::EdsCallState::OnRequestSentLocked(
+    void* arg, grpc_error* error) {
+  EdsCallState* eds_calld = static_cast<EdsCallState*>(arg);
+  grpc_byte_buffer_destroy(eds_calld->send_message_payload_);
+  eds_calld->send_message_payload_ = nullptr;
+  if (error == GRPC_ERROR_NONE && eds_calld->IsCurrentCallOnChannel() &&
+      !eds_calld->buffered_requests_.empty()) {
+    // Only the latest ACK needs to go out: the balancer tracks the last nonce.
+    const size_t num_buffered = eds_calld->buffered_requests_.size();
+    grpc_slice request = eds_calld->buffered_requests_[num_buffered - 1];
+    for (size_t i = 0; i + 1 < num_buffered; ++i) {
+      grpc_slice_unref_internal(eds_calld->buffered_requests_[i]);
+    }
+    eds_calld->buffered_requests_.clear();
+    eds_calld->send_message_payload_ = grpc_raw_byte_buffer_create(&request, 1);
+    grpc_slice_unref_internal(request);
+    grpc_op op;
+    memset(&op, 0, sizeof(op));
+    op.op = GRPC_OP_SEND_MESSAGE;
+    op.data.send_message.send_message = eds_calld->send_message_payload_;
+    // Reuse the "EDS+OnRequestSentLocked" ref.
+    const grpc_call_error call_error = grpc_call_start_batch_and_execute(
+        eds_calld->lb_call_, &op, 1, &eds_calld->on_request_sent_);
+    GPR_ASSERT(GRPC_CALL_OK == call_error);
+    return;
+  }
+  eds_calld->Unref(DEBUG_LOCATION, "EDS+OnRequestSentLocked");
+}
+
+void XdsLb::LbChannelState::EdsCallState::SendDeltaAckLocked(
+    const char* nonce, grpc_error* error) {
+  grpc_slice request = XdsEdsDeltaRequestCreateAndEncode(
+      XdsResourceNameList(), XdsResourceNameList(),
+      /*initial_versions=*/nullptr, nonce, error);
+  GRPC_ERROR_UNREF(error);
+  // A send is in flight; OnRequestSentLocked() will pick this up.
+  if (send_message_payload_ != nullptr) {
+    buffered_requests_.push_back(request);
+    return;
+  }
+  send_message_payload_ = grpc_raw_byte_buffer_create(&request, 1);
+  grpc_slice_unref_internal(request);
+  grpc_op op;
+  memset(&op, 0, sizeof(op));
+  op.op = GRPC_OP_SEND_MESSAGE;
+  op.data.send_message.send_message = send_message_payload_;
+  Ref(DEBUG_LOCATION, "EDS+OnRequestSentLocked").release();
+  const grpc_call_error call_error =
+      grpc_call_start_batch_and_execute(lb_call_, &op, 1, &on_request_sent_);
+  GPR_ASSERT(GRPC_CALL_OK == call_error);
+}
+
 bool XdsLb::LbChannelState::EdsCallState::IsCurrentCallOnChannel() const {
   // If the retryable EDS call is null (which only happens when the LB channel
   // is shutting down), all the EDS calls are stale.
@@ -1714,6 +1825,8 @@ XdsLb::XdsLb(Args args)
     : LoadBalancingPolicy(std::move(args)),
       lb_call_timeout_ms_(grpc_channel_args_find_integer(
           args.args, GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS, {0, 0, INT_MAX})),
+      use_delta_eds_(grpc_channel_args_find_bool(
+          args.args, GRPC_ARG_XDS_DELTA_EDS, false)),
       lb_fallback_timeout_ms_(grpc_channel_args_find_integer(
           args.args, GRPC_ARG_XDS_FALLBACK_TIMEOUT_MS,
           {GRPC_XDS_DEFAULT_FALLBACK_TIMEOUT_MS, 0, INT_MAX})),
@@ -2045,10 +2158,23 @@ void XdsLb::MaybeExitFallbackMode() {
 // XdsLb::LocalityMap
 //
 
+// Returns true if locality_list has an entry for locality's name with the
+// same serverlist.
+bool SameServerlist(const XdsLocalityList& locality_list,
+                    const XdsLocalityInfo& locality) {
+  for (size_t i = 0; i < locality_list.size(); ++i) {
+    if (*locality_list[i].locality_name == *locality.locality_name) {
+      return locality_list[i].serverlist == locality.serverlist;
+    }
+  }
+  return false;
+}
+
 void XdsLb::LocalityMap::UpdateLocked(
     const XdsLocalityList& locality_list,
     LoadBalancingPolicy::Config* child_policy_config,
-    const grpc_channel_args* args, XdsLb* parent, bool is_initial_update) {
+    const grpc_channel_args* args, XdsLb* parent, bool is_initial_update,
+    const XdsLocalityList* previous_locality_list) {
   if (parent->shutting_down_) return;
   // Add or update the localities in locality_list.
   for (size_t i = 0; i < locality_list.size(); i++) {
@@ -2060,6 +2186,12 @@ void XdsLb::LocalityMap::UpdateLocked(
       OrphanablePtr<LocalityEntry> new_entry = MakeOrphanable<LocalityEntry>(
           parent->Ref(DEBUG_LOCATION, "LocalityEntry"), locality_name);
       iter = map_.emplace(locality_name, std::move(new_entry)).first;
+    } else if (previous_locality_list != nullptr &&
+               SameServerlist(*previous_locality_list, locality_list[i])) {
+      // The locality was active with this serverlist already: only its
+      // weight may have changed.
+      iter->second->set_locality_weight(locality_list[i].lb_weight);
+      continue;
     }
     // Keep a copy of serverlist in locality_list_ so that we can compare it
     // with the future ones.
@@ -2087,11 +2219,8 @@ void XdsLb::LocalityMap::UpdateLocked(
 void XdsLb::LocalityMap::UpdateXdsPickerLocked() {
   // If we are in fallback mode, don't generate an xds picker from localities.
   if (xds_policy_->fallback_policy_ != nullptr) return;
-  // Construct a new xds picker which maintains a map of all locality pickers
-  // that are ready. Each locality is represented by a portion of the range
-  // proportional to its weight, such that the total range is the sum of the
-  // weights of all localities.
-  uint32_t end = 0;
+  // Construct a new xds picker which maintains a table of all locality
+  // pickers that are ready, weighted by the weights of their localities.
   size_t num_connecting = 0;
   size_t num_idle = 0;
   size_t num_transient_failures = 0;
@@ -2101,8 +2230,8 @@ void XdsLb::LocalityMap::UpdateXdsPickerLocked() {
     if (entry->locality_weight() == 0) continue;
     switch (entry->connectivity_state()) {
       case GRPC_CHANNEL_READY: {
-        end += entry->locality_weight();
-        pickers.push_back(MakePair(end, entry->picker_wrapper()));
+        pickers.push_back(
+            MakePair(entry->locality_weight(), entry->picker_wrapper()));
         break;
       }
       case GRPC_CHANNEL_CONNECTING: {
@@ -21,9 +21,12 @@
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds_client_stats.h"
 
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
 #include <string.h>
 
+#include "src/core/lib/gpr/useful.h"
+
 namespace grpc_core {
 
 namespace {
@@ -75,15 +78,30 @@ bool XdsClientStats::LocalityStats::Snapshot::IsAllZero() {
 // XdsClientStats::LocalityStats
 //
 
+XdsClientStats::LocalityStats::LocalityStats() {
+  const size_t num_cores = GPR_MAX(1, gpr_cpu_num_cores());
+  per_cpu_counters_.reserve(num_cores);
+  for (size_t i = 0; i < num_cores; ++i) {
+    per_cpu_counters_.emplace_back();
+  }
+}
+
 XdsClientStats::LocalityStats::Snapshot
 XdsClientStats::LocalityStats::GetSnapshotAndReset() {
-  Snapshot snapshot = {
-      GetAndResetCounter(&total_successful_requests_),
-      // Don't reset total_requests_in_progress because it's not
-      // related to a single reporting interval.
-      total_requests_in_progress_.Load(MemoryOrder::RELAXED),
-      GetAndResetCounter(&total_error_requests_),
-      GetAndResetCounter(&total_issued_requests_)};
+  Snapshot snapshot = {0, 0, 0, 0};
+  for (size_t i = 0; i < per_cpu_counters_.size(); ++i) {
+    PerCpuCounters& counters = per_cpu_counters_[i];
+    snapshot.total_successful_requests +=
+        GetAndResetCounter(&counters.total_successful_requests);
+    // Don't reset total_requests_in_progress because it's not
+    // related to a single reporting interval.
+    snapshot.total_requests_in_progress +=
+        counters.total_requests_in_progress.Load(MemoryOrder::RELAXED);
+    snapshot.total_error_requests +=
+        GetAndResetCounter(&counters.total_error_requests);
+    snapshot.total_issued_requests +=
+        GetAndResetCounter(&counters.total_issued_requests);
+  }
   {
     MutexLock lock(&load_metric_stats_mu_);
     for (auto& p : load_metric_stats_) {
@@ -97,16 +115,29 @@ XdsClientStats::LocalityStats::GetSnapshotAndReset() {
   return snapshot;
 }
 
+uint64_t XdsClientStats::LocalityStats::TotalRequestsInProgress() {
+  uint64_t total = 0;
+  for (size_t i = 0; i < per_cpu_counters_.size(); ++i) {
+    total += per_cpu_counters_[i].total_requests_in_progress.FetchAdd(
+        0, MemoryOrder::ACQ_REL);
+  }
+  return total;
+}
+
 void XdsClientStats::LocalityStats::AddCallStarted() {
-  total_issued_requests_.FetchAdd(1, MemoryOrder::RELAXED);
-  total_requests_in_progress_.FetchAdd(1, MemoryOrder::RELAXED);
+  PerCpuCounters& counters =
+      per_cpu_counters_[ExecCtx::Get()->starting_cpu()];
+  counters.total_issued_requests.FetchAdd(1, MemoryOrder::RELAXED);
+  counters.total_requests_in_progress.FetchAdd(1, MemoryOrder::RELAXED);
 }
 
 void XdsClientStats::LocalityStats::AddCallFinished(bool fail) {
-  Atomic<uint64_t>& to_increment =
-      fail ? total_error_requests_ : total_successful_requests_;
+  PerCpuCounters& counters =
+      per_cpu_counters_[ExecCtx::Get()->starting_cpu()];
+  Atomic<uint64_t>& to_increment = fail ? counters.total_error_requests
+                                        : counters.total_successful_requests;
   to_increment.FetchAdd(1, MemoryOrder::RELAXED);
-  total_requests_in_progress_.FetchAdd(-1, MemoryOrder::ACQ_REL);
+  counters.total_requests_in_progress.FetchAdd(-1, MemoryOrder::ACQ_REL);
 }
 
 //
@@ -83,10 +83,12 @@ class XdsLocalityName : public RefCounted<XdsLocalityName> {
 // be taken a snapshot (and reset) to populate the load report. The snapshots
 // are contained in the respective Snapshot structs. The Snapshot structs have
 // no synchronization. The stats classes use several different synchronization
-// methods. 1. Most of the counters are Atomic<>s for performance. 2. Some of
-// the Map<>s are protected by Mutex if we are not guaranteed that the accesses
-// to them are synchronized by the callers. 3. The Map<>s to which the accesses
-// are already synchronized by the callers do not have additional
+// methods. 1. Most of the counters are Atomic<>s for performance. The ones
+// updated for every call are kept per CPU, so that calls on different CPUs do
+// not contend to update them, and are added up when taking a snapshot. 2. Some
+// of the Map<>s are protected by Mutex if we are not guaranteed that the
+// accesses to them are synchronized by the callers. 3. The Map<>s to which the
+// accesses are already synchronized by the callers do not have additional
 // synchronization here. Note that the Map<>s we mentioned in 2 and 3 refer to
 // the map's tree structure rather than the content in each tree node.
 class XdsClientStats {
@@ -127,6 +129,8 @@ class XdsClientStats {
       LoadMetricSnapshotMap load_metric_stats;
     };
 
+    LocalityStats();
+
     // Returns a snapshot of this instance and reset all the accumulative
     // counters.
     Snapshot GetSnapshotAndReset();
@@ -147,23 +151,46 @@ class XdsClientStats {
     // Only be called from the control plane combiner.
     // The only place where the picker_refcount_ can be increased is
     // RefByPicker(), which also can only be called from the control plane
-    // combiner. Also, if the picker_refcount_ is 0, total_requests_in_progress_
+    // combiner. Also, if the picker_refcount_ is 0, total_requests_in_progress
     // can't be increased from 0. So it's safe to delete the LocalityStats right
     // after this method returns true.
     bool IsSafeToDelete() {
       return picker_refcount_.FetchAdd(0, MemoryOrder::ACQ_REL) == 0 &&
-             total_requests_in_progress_.FetchAdd(0, MemoryOrder::ACQ_REL) == 0;
+             TotalRequestsInProgress() == 0;
     }
 
     void AddCallStarted();
     void AddCallFinished(bool fail = false);
 
    private:
-    Atomic<uint64_t> total_successful_requests_{0};
-    Atomic<uint64_t> total_requests_in_progress_{0};
-    // Requests that were issued (not dropped) but failed.
-    Atomic<uint64_t> total_error_requests_{0};
-    Atomic<uint64_t> total_issued_requests_{0};
+    struct PerCpuCounters {
+      // Define the ctors so that we can use this structure in InlinedVector.
+      PerCpuCounters() = default;
+      PerCpuCounters(const PerCpuCounters& that)
+          : total_successful_requests(
+                that.total_successful_requests.Load(MemoryOrder::RELAXED)),
+            total_requests_in_progress(
+                that.total_requests_in_progress.Load(MemoryOrder::RELAXED)),
+            total_error_requests(
+                that.total_error_requests.Load(MemoryOrder::RELAXED)),
+            total_issued_requests(
+                that.total_issued_requests.Load(MemoryOrder::RELAXED)) {}
+
+      Atomic<uint64_t> total_successful_requests{0};
+      // A call may finish on another CPU than it started on, so this wraps
+      // around on some CPUs; only the sum over all CPUs is meaningful.
+      Atomic<uint64_t> total_requests_in_progress{0};
+      // Requests that were issued (not dropped) but failed.
+      Atomic<uint64_t> total_error_requests{0};
+      Atomic<uint64_t> total_issued_requests{0};
+      // Make sure the size is exactly one cache line.
+      uint8_t padding[GPR_CACHELINE_SIZE - 4 * sizeof(Atomic<uint64_t>)];
+    } GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+
+    uint64_t TotalRequestsInProgress();
+
+    // Really zero-sized, but 0-sized arrays are illegal on MSVC.
+    InlinedVector<PerCpuCounters, 1> per_cpu_counters_;
     // Protects load_metric_stats_. A mutex is necessary because the length of
     // load_metric_stats_ can be accessed by both the callback intercepting the
     // call's recv_trailing_metadata (not from any combiner) and the load
@@ -41,6 +41,7 @@
 #include "google/protobuf/struct.upb.h"
 #include "google/protobuf/timestamp.upb.h"
 #include "google/protobuf/wrappers.upb.h"
+#include "google/rpc/status.upb.h"
 #include "upb/upb.h"
 
 namespace grpc_core {
@@ -66,22 +67,29 @@ bool XdsDropConfig::ShouldDrop(const UniquePtr<char>** category_name) const {
   return false;
 }
 
-grpc_slice XdsEdsRequestCreateAndEncode(const char* service_name) {
-  upb::Arena arena;
-  // Create a request.
-  envoy_api_v2_DiscoveryRequest* request =
-      envoy_api_v2_DiscoveryRequest_new(arena.ptr());
-  envoy_api_v2_core_Node* node =
-      envoy_api_v2_DiscoveryRequest_mutable_node(request, arena.ptr());
+namespace {
+
+void PopulateNode(envoy_api_v2_core_Node* node, upb_arena* arena) {
   google_protobuf_Struct* metadata =
-      envoy_api_v2_core_Node_mutable_metadata(node, arena.ptr());
+      envoy_api_v2_core_Node_mutable_metadata(node, arena);
   google_protobuf_Struct_FieldsEntry* field =
-      google_protobuf_Struct_add_fields(metadata, arena.ptr());
+      google_protobuf_Struct_add_fields(metadata, arena);
   google_protobuf_Struct_FieldsEntry_set_key(
       field, upb_strview_makez(kEndpointRequired));
   google_protobuf_Value* value =
-      google_protobuf_Struct_FieldsEntry_mutable_value(field, arena.ptr());
+      google_protobuf_Struct_FieldsEntry_mutable_value(field, arena);
   google_protobuf_Value_set_bool_value(value, true);
+}
+
+}  // namespace
+
+grpc_slice XdsEdsRequestCreateAndEncode(const char* service_name) {
+  upb::Arena arena;
+  // Create a request.
+  envoy_api_v2_DiscoveryRequest* request =
+      envoy_api_v2_DiscoveryRequest_new(arena.ptr());
+  PopulateNode(envoy_api_v2_DiscoveryRequest_mutable_node(request, arena.ptr()),
+               arena.ptr());
   envoy_api_v2_DiscoveryRequest_add_resource_names(
       request, upb_strview_makez(service_name), arena.ptr());
   envoy_api_v2_DiscoveryRequest_set_type_url(request,
@@ -93,6 +101,62 @@ grpc_slice XdsEdsRequestCreateAndEncode(const char* service_name) {
   return grpc_slice_from_copied_buffer(output, output_length);
 }
 
+grpc_slice XdsEdsDeltaRequestCreateAndEncode(
+    const XdsResourceNameList& subscribe,
+    const XdsResourceNameList& unsubscribe,
+    const XdsResourceVersionMap* initial_versions, const char* response_nonce,
+    grpc_error* error) {
+  upb::Arena arena;
+  // Create a request.
+  envoy_api_v2_DeltaDiscoveryRequest* request =
+      envoy_api_v2_DeltaDiscoveryRequest_new(arena.ptr());
+  envoy_api_v2_DeltaDiscoveryRequest_set_type_url(
+      request, upb_strview_makez(kEdsTypeUrl));
+  // The node only needs to be sent on the first request of the stream, which
+  // is the only one without a nonce.
+  if (response_nonce == nullptr) {
+    PopulateNode(
+        envoy_api_v2_DeltaDiscoveryRequest_mutable_node(request, arena.ptr()),
+        arena.ptr());
+  } else {
+    envoy_api_v2_DeltaDiscoveryRequest_set_response_nonce(
+        request, upb_strview_makez(response_nonce));
+  }
+  for (size_t i = 0; i < subscribe.size(); ++i) {
+    envoy_api_v2_DeltaDiscoveryRequest_add_resource_names_subscribe(
+        request, upb_strview_makez(subscribe[i]), arena.ptr());
+  }
+  for (size_t i = 0; i < unsubscribe.size(); ++i) {
+    envoy_api_v2_DeltaDiscoveryRequest_add_resource_names_unsubscribe(
+        request, upb_strview_makez(unsubscribe[i]), arena.ptr());
+  }
+  if (initial_versions != nullptr) {
+    for (const auto& p : *initial_versions) {
+      envoy_api_v2_DeltaDiscoveryRequest_InitialResourceVersionsEntry* entry =
+          envoy_api_v2_DeltaDiscoveryRequest_add_initial_resource_versions(
+              request, arena.ptr());
+      envoy_api_v2_DeltaDiscoveryRequest_InitialResourceVersionsEntry_set_key(
+          entry, upb_strview_makez(p.first.get()));
+      envoy_api_v2_DeltaDiscoveryRequest_InitialResourceVersionsEntry_set_value(
+          entry, upb_strview_makez(p.second.get()));
+    }
+  }
+  // A NACK carries the reason the previous response was rejected.
+  if (error != GRPC_ERROR_NONE) {
+    google_rpc_Status* error_detail =
+        envoy_api_v2_DeltaDiscoveryRequest_mutable_error_detail(request,
+                                                                arena.ptr());
+    google_rpc_Status_set_code(error_detail, GRPC_STATUS_INVALID_ARGUMENT);
+    google_rpc_Status_set_message(
+        error_detail, upb_strview_makez(grpc_error_string(error)));
+  }
+  // Encode the request.
+  size_t output_length;
+  char* output = envoy_api_v2_DeltaDiscoveryRequest_serialize(
+      request, arena.ptr(), &output_length);
+  return grpc_slice_from_copied_buffer(output, output_length);
+}
+
 namespace {
 
 grpc_error* ServerAddressParseAndAppend(
@@ -208,47 +272,26 @@ grpc_error* DropParseAndAppend(
   return GRPC_ERROR_NONE;
 }
 
-}  // namespace
-
-grpc_error* XdsEdsResponseDecodeAndParse(const grpc_slice& encoded_response,
-                                         XdsUpdate* update) {
-  upb::Arena arena;
-  // Decode the response.
-  const envoy_api_v2_DiscoveryResponse* response =
-      envoy_api_v2_DiscoveryResponse_parse(
-          reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(encoded_response)),
-          GRPC_SLICE_LENGTH(encoded_response), arena.ptr());
-  // Parse the response.
-  if (response == nullptr) {
-    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("No response found.");
-  }
-  // Check the type_url of the response.
-  upb_strview type_url = envoy_api_v2_DiscoveryResponse_type_url(response);
-  upb_strview expected_type_url = upb_strview_makez(kEdsTypeUrl);
-  if (!upb_strview_eql(type_url, expected_type_url)) {
-    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource is not EDS.");
-  }
-  // Get the resources from the response.
-  size_t size;
-  const google_protobuf_Any* const* resources =
-      envoy_api_v2_DiscoveryResponse_resources(response, &size);
-  if (size < 1) {
-    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-        "EDS response contains 0 resource.");
-  }
+grpc_error* ClusterLoadAssignmentParse(const google_protobuf_Any* resource,
+                                       upb_arena* arena, XdsUpdate* update) {
   // Check the type_url of the resource.
-  type_url = google_protobuf_Any_type_url(resources[0]);
-  if (!upb_strview_eql(type_url, expected_type_url)) {
+  upb_strview type_url = google_protobuf_Any_type_url(resource);
+  if (!upb_strview_eql(type_url, upb_strview_makez(kEdsTypeUrl))) {
     return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource is not EDS.");
   }
   // Get the cluster_load_assignment.
   upb_strview encoded_cluster_load_assignment =
-      google_protobuf_Any_value(resources[0]);
+      google_protobuf_Any_value(resource);
   envoy_api_v2_ClusterLoadAssignment* cluster_load_assignment =
       envoy_api_v2_ClusterLoadAssignment_parse(
           encoded_cluster_load_assignment.data,
-          encoded_cluster_load_assignment.size, arena.ptr());
+          encoded_cluster_load_assignment.size, arena);
+  if (cluster_load_assignment == nullptr) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Can't parse cluster_load_assignment.");
+  }
   // Get the endpoints.
+  size_t size;
   const envoy_api_v2_endpoint_LocalityLbEndpoints* const* endpoints =
       envoy_api_v2_ClusterLoadAssignment_endpoints(cluster_load_assignment,
                                                    &size);
@@ -283,6 +326,90 @@ grpc_error* XdsEdsResponseDecodeAndParse(const grpc_slice& encoded_response,
   return GRPC_ERROR_NONE;
 }
 
+}  // namespace
+
+grpc_error* XdsEdsResponseDecodeAndParse(const grpc_slice& encoded_response,
+                                         XdsUpdate* update) {
+  upb::Arena arena;
+  // Decode the response.
+  const envoy_api_v2_DiscoveryResponse* response =
+      envoy_api_v2_DiscoveryResponse_parse(
+          reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(encoded_response)),
+          GRPC_SLICE_LENGTH(encoded_response), arena.ptr());
+  // Parse the response.
+  if (response == nullptr) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("No response found.");
+  }
+  // Check the type_url of the response.
+  upb_strview type_url = envoy_api_v2_DiscoveryResponse_type_url(response);
+  upb_strview expected_type_url = upb_strview_makez(kEdsTypeUrl);
+  if (!upb_strview_eql(type_url, expected_type_url)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource is not EDS.");
+  }
+  // Get the resources from the response.
+  size_t size;
+  const google_protobuf_Any* const* resources =
+      envoy_api_v2_DiscoveryResponse_resources(response, &size);
+  if (size < 1) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "EDS response contains 0 resource.");
+  }
+  return ClusterLoadAssignmentParse(resources[0], arena.ptr(), update);
+}
+
+grpc_error* XdsEdsDeltaResponseDecodeAndParse(
+    const grpc_slice& encoded_response, const char* service_name,
+    XdsDeltaResponse* delta_response, XdsUpdate* update) {
+  upb::Arena arena;
+  // Decode the response.
+  const envoy_api_v2_DeltaDiscoveryResponse* response =
+      envoy_api_v2_DeltaDiscoveryResponse_parse(
+          reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(encoded_response)),
+          GRPC_SLICE_LENGTH(encoded_response), arena.ptr());
+  if (response == nullptr) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("No response found.");
+  }
+  // Record the nonce first, so that even a rejected response can be NACKed.
+  delta_response->nonce =
+      StringCopy(envoy_api_v2_DeltaDiscoveryResponse_nonce(response));
+  // Check the type_url of the response.
+  upb_strview type_url = envoy_api_v2_DeltaDiscoveryResponse_type_url(response);
+  if (!upb_strview_eql(type_url, upb_strview_makez(kEdsTypeUrl))) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource is not EDS.");
+  }
+  const upb_strview name = upb_strview_makez(service_name);
+  // Only the resources that changed are sent, so look for the one we want by
+  // name and leave the others unparsed.
+  size_t size;
+  const envoy_api_v2_Resource* const* resources =
+      envoy_api_v2_DeltaDiscoveryResponse_resources(response, &size);
+  for (size_t i = 0; i < size; ++i) {
+    if (!upb_strview_eql(envoy_api_v2_Resource_name(resources[i]), name)) {
+      continue;
+    }
+    const google_protobuf_Any* resource =
+        envoy_api_v2_Resource_resource(resources[i]);
+    if (resource == nullptr) {
+      return GRPC_ERROR_CREATE_FROM_STATIC_STRING("EDS resource is empty.");
+    }
+    grpc_error* error =
+        ClusterLoadAssignmentParse(resource, arena.ptr(), update);
+    if (error != GRPC_ERROR_NONE) return error;
+    delta_response->version =
+        StringCopy(envoy_api_v2_Resource_version(resources[i]));
+    return GRPC_ERROR_NONE;
+  }
+  const upb_strview* removed_resources =
+      envoy_api_v2_DeltaDiscoveryResponse_removed_resources(response, &size);
+  for (size_t i = 0; i < size; ++i) {
+    if (upb_strview_eql(removed_resources[i], name)) {
+      delta_response->removed = true;
+      break;
+    }
+  }
+  return GRPC_ERROR_NONE;
+}
+
 namespace {
 
 grpc_slice LrsRequestEncode(
@@ -25,6 +25,7 @@
 
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds_client_stats.h"
 #include "src/core/ext/filters/client_channel/server_address.h"
+#include "src/core/lib/gprpp/map.h"
 
 namespace grpc_core {
 
@@ -53,7 +54,7 @@ using XdsLocalityList = InlinedVector<XdsLocalityInfo, 1>;
 
 // There are two phases of accessing this class's content:
 // 1. to initialize in the control plane combiner;
-// 2. to use in the data plane combiner.
+// 2. to use in the data plane mutex.
 // So no additional synchronization is needed.
 class XdsDropConfig : public RefCounted<XdsDropConfig> {
  public:
@@ -74,7 +75,7 @@ class XdsDropConfig : public RefCounted<XdsDropConfig> {
         DropCategory{std::move(name), parts_per_million});
   }
 
-  // The only method invoked from the data plane combiner.
+  // The only method invoked from the data plane mutex.
   bool ShouldDrop(const UniquePtr<char>** category_name) const;
 
   const DropCategoryList& drop_category_list() const {
@@ -106,6 +107,43 @@ grpc_slice XdsEdsRequestCreateAndEncode(const char* service_name);
 grpc_error* XdsEdsResponseDecodeAndParse(const grpc_slice& encoded_response,
                                          XdsUpdate* update);
 
+// The names of the resources to subscribe to or unsubscribe from.
+using XdsResourceNameList = InlinedVector<const char*, 1>;
+
+// The versions of the resources the client already has, keyed by name.
+using XdsResourceVersionMap = Map<UniquePtr<char>, UniquePtr<char>, StringLess>;
+
+// What an incremental EDS response said about the requested resource.
+struct XdsDeltaResponse {
+  // To be echoed back when ACKing or NACKing the response.
+  UniquePtr<char> nonce;
+  // The version of the resource if the response carries a new one, null if
+  // the resource is unchanged.
+  UniquePtr<char> version;
+  // Whether the control plane removed the resource.
+  bool removed = false;
+};
+
+// Creates an incremental EDS request, subscribing to the resources in \a
+// subscribe and unsubscribing from those in \a unsubscribe. On a new stream,
+// \a response_nonce is null and \a initial_versions (if non-null) tells the
+// control plane which versions we already have so that it doesn't resend
+// them. Otherwise the request ACKs the response with \a response_nonce, or
+// NACKs it if \a error is set.
+grpc_slice XdsEdsDeltaRequestCreateAndEncode(
+    const XdsResourceNameList& subscribe,
+    const XdsResourceNameList& unsubscribe,
+    const XdsResourceVersionMap* initial_versions, const char* response_nonce,
+    grpc_error* error);
+
+// Parses an incremental EDS response. Only the resource named \a service_name
+// is parsed; if the response carries a new version of it, \a update is
+// populated and \a delta_response's version is set. The nonce is set whenever
+// the response could be decoded, even if an error is returned.
+grpc_error* XdsEdsDeltaResponseDecodeAndParse(
+    const grpc_slice& encoded_response, const char* service_name,
+    XdsDeltaResponse* delta_response, XdsUpdate* update);
+
 // Creates an LRS request querying \a server_name.
 grpc_slice XdsLrsRequestCreateAndEncode(const char* server_name);
 
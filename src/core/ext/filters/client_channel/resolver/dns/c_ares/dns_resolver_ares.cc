@@ -109,6 +109,8 @@ class AresDnsResolver : public Resolver {
   UniquePtr<ServerAddressList> addresses_;
   /// currently resolving service config
   char* service_config_json_ = nullptr;
+  /// the service config last returned, reused while its text is unchanged
+  RefCountedPtr<ServiceConfig> service_config_;
   // has shutdown been initiated
   bool shutdown_initiated_ = false;
   // timeout in milliseconds for active DNS queries
@@ -338,10 +340,27 @@ void AresDnsResolver::OnResolvedLocked(void* arg, grpc_error* error) {
           service_config_string != nullptr) {
         GRPC_CARES_TRACE_LOG("resolver:%p selected service config choice: %s",
                              r, service_config_string);
-        result.service_config = ServiceConfig::Create(
-            service_config_string, &result.service_config_error);
+        // Most re-resolutions return the same TXT record, so only parse it
+        // when it differs from the last valid one.
+        if (r->service_config_ != nullptr &&
+            strcmp(r->service_config_->service_config_json(),
+                   service_config_string) == 0) {
+          result.service_config = r->service_config_;
+        } else {
+          result.service_config = ServiceConfig::Create(
+              service_config_string, &result.service_config_error);
+          if (result.service_config_error == GRPC_ERROR_NONE) {
+            r->service_config_ = result.service_config;
+          } else {
+            r->service_config_.reset();
+          }
+        }
+      } else {
+        r->service_config_.reset();
       }
       gpr_free(service_config_string);
+    } else {
+      r->service_config_.reset();
     }
     result.args = grpc_channel_args_copy(r->channel_args_);
     r->result_handler()->ReturnResult(std::move(result));
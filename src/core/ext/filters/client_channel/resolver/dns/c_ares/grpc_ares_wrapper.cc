@@ -36,7 +36,10 @@
 #include "src/core/ext/filters/client_channel/parse_address.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/executor.h"
@@ -69,6 +72,15 @@ struct grpc_ares_request {
 
   /** the errors explaining query failures, appended to in query callbacks */
   grpc_error* error;
+
+  /** following members are set while the request waits for a lookup of the
+      DNS cache */
+  /** the pollset_set to drive the lookup with */
+  grpc_pollset_set* interested_parties;
+  /** the lookup waited for */
+  struct grpc_ares_cache_lookup* cache_lookup;
+  /** the next request waiting for the same lookup */
+  grpc_ares_request* next_cache_waiter;
 };
 
 typedef struct grpc_ares_hostbyname_request {
@@ -585,6 +597,324 @@ static bool grpc_ares_maybe_resolve_localhost_manually_locked(
 }
 #endif /* GRPC_ARES_RESOLVE_LOCALHOST_MANUALLY */
 
+/*
+ * Process-wide cache of lookup results
+ */
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_dns_cache_ttl_ms, 0,
+    "Time in milliseconds for which the c-ares resolver answers lookups of a "
+    "name from the result of the last lookup of that name. 0 disables the "
+    "cache.");
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_dns_cache_stale_ms, 0,
+    "Time in milliseconds past GRPC_DNS_CACHE_TTL_MS for which a cached "
+    "result is still returned while it is refreshed in the background.");
+
+struct grpc_ares_cache_entry;
+
+/* A lookup run on behalf of the cache, under its own combiner, whose result
+   is handed to every request waiting for it. */
+struct grpc_ares_cache_lookup {
+  grpc_ares_cache_entry* entry;
+  grpc_combiner* combiner;
+  /** driven by the interested parties of the waiting requests */
+  grpc_pollset_set* pollset_set;
+  char* dns_server;
+  char* name;
+  char* default_port;
+  bool check_grpclb;
+  int query_timeout_ms;
+  grpc_ares_request* request;
+  grpc_core::UniquePtr<ServerAddressList> addresses;
+  char* service_config_json;
+  grpc_closure on_start;
+  grpc_closure on_cancel;
+  grpc_closure on_done;
+  /** requests waiting for the result, linked by next_cache_waiter */
+  grpc_ares_request* waiters;
+  /** set once on_done has run */
+  bool done;
+  /** set while on_cancel is scheduled; the lookup is destroyed by whichever
+      of on_done and on_cancel runs last */
+  bool cancel_pending;
+};
+
+struct grpc_ares_cache_entry {
+  char* key;
+  bool want_service_config;
+  /** the result of the last successful lookup, if any */
+  grpc_core::UniquePtr<ServerAddressList> addresses;
+  char* service_config_json;
+  /** the result is returned as is until fresh_until, and while it is being
+      refreshed until stale_until */
+  grpc_millis fresh_until;
+  grpc_millis stale_until;
+  /** the lookup in flight, if any */
+  grpc_ares_cache_lookup* lookup;
+  /** set when the cache is shut down while lookup is in flight */
+  bool orphaned;
+};
+
+static gpr_once g_cache_once = GPR_ONCE_INIT;
+/** guards g_cache, its entries and their lookups' waiters */
+static gpr_mu g_cache_mu;
+static grpc_core::Map<const char*, grpc_ares_cache_entry*,
+                      grpc_core::StringLess>* g_cache;
+static grpc_millis g_cache_ttl_ms;
+static grpc_millis g_cache_stale_ms;
+
+static void grpc_ares_cache_init_mu(void) { gpr_mu_init(&g_cache_mu); }
+
+static void grpc_ares_cache_init(void) {
+  gpr_once_init(&g_cache_once, grpc_ares_cache_init_mu);
+  g_cache_ttl_ms = GPR_MAX(0, GPR_GLOBAL_CONFIG_GET(grpc_dns_cache_ttl_ms));
+  g_cache_stale_ms =
+      GPR_MAX(0, GPR_GLOBAL_CONFIG_GET(grpc_dns_cache_stale_ms));
+  gpr_mu_lock(&g_cache_mu);
+  if (g_cache == nullptr) {
+    g_cache = grpc_core::New<grpc_core::Map<const char*, grpc_ares_cache_entry*,
+                                            grpc_core::StringLess>>();
+  }
+  gpr_mu_unlock(&g_cache_mu);
+}
+
+static void grpc_ares_cache_entry_destroy(grpc_ares_cache_entry* entry) {
+  gpr_free(entry->key);
+  gpr_free(entry->service_config_json);
+  grpc_core::Delete(entry);
+}
+
+static void grpc_ares_cache_copy_result(grpc_ares_cache_entry* entry,
+                                        grpc_ares_request* r) {
+  *r->addresses_out =
+      grpc_core::MakeUnique<ServerAddressList>(*entry->addresses);
+  if (r->service_config_json_out != nullptr &&
+      entry->service_config_json != nullptr) {
+    *r->service_config_json_out = gpr_strdup(entry->service_config_json);
+  }
+}
+
+static void on_cache_lookup_start_locked(void* arg, grpc_error* unused_error) {
+  grpc_ares_cache_lookup* lookup = static_cast<grpc_ares_cache_lookup*>(arg);
+  grpc_dns_lookup_ares_continue_after_check_localhost_and_ip_literals_locked(
+      lookup->request, lookup->dns_server, lookup->name, lookup->default_port,
+      lookup->pollset_set, lookup->check_grpclb, lookup->query_timeout_ms,
+      lookup->combiner);
+}
+
+static void grpc_ares_cache_lookup_destroy(grpc_ares_cache_lookup* lookup) {
+  gpr_free(lookup->request);
+  grpc_pollset_set_destroy(lookup->pollset_set);
+  gpr_free(lookup->dns_server);
+  gpr_free(lookup->name);
+  gpr_free(lookup->default_port);
+  gpr_free(lookup->service_config_json);
+  GRPC_COMBINER_UNREF(lookup->combiner, "cache lookup done");
+  grpc_core::Delete(lookup);
+}
+
+static void on_cache_lookup_cancel_locked(void* arg,
+                                          grpc_error* unused_error) {
+  grpc_ares_cache_lookup* lookup = static_cast<grpc_ares_cache_lookup*>(arg);
+  gpr_mu_lock(&g_cache_mu);
+  lookup->cancel_pending = false;
+  const bool done = lookup->done;
+  gpr_mu_unlock(&g_cache_mu);
+  if (done) {
+    grpc_ares_cache_lookup_destroy(lookup);
+  } else {
+    grpc_cancel_ares_request_locked(lookup->request);
+  }
+}
+
+static void on_cache_lookup_done_locked(void* arg, grpc_error* error) {
+  grpc_ares_cache_lookup* lookup = static_cast<grpc_ares_cache_lookup*>(arg);
+  grpc_ares_cache_entry* entry = lookup->entry;
+  gpr_mu_lock(&g_cache_mu);
+  entry->lookup = nullptr;
+  const bool succeeded = lookup->addresses != nullptr;
+  if (succeeded) {
+    // Failures keep the previous result, which may still be returned while
+    // stale.
+    entry->addresses = std::move(lookup->addresses);
+    gpr_free(entry->service_config_json);
+    entry->service_config_json = lookup->service_config_json;
+    lookup->service_config_json = nullptr;
+    entry->fresh_until = grpc_core::ExecCtx::Get()->Now() + g_cache_ttl_ms;
+    entry->stale_until = entry->fresh_until + g_cache_stale_ms;
+  }
+  GRPC_CARES_TRACE_LOG("cache lookup:%p of %s done: %s", lookup, lookup->name,
+                       grpc_error_string(error));
+  while (lookup->waiters != nullptr) {
+    grpc_ares_request* r = lookup->waiters;
+    lookup->waiters = r->next_cache_waiter;
+    r->cache_lookup = nullptr;
+    r->next_cache_waiter = nullptr;
+    grpc_pollset_set_del_pollset_set(lookup->pollset_set,
+                                     r->interested_parties);
+    if (succeeded) grpc_ares_cache_copy_result(entry, r);
+    GRPC_CLOSURE_SCHED(r->on_done, GRPC_ERROR_REF(error));
+  }
+  const bool orphaned = entry->orphaned;
+  lookup->done = true;
+  const bool cancel_pending = lookup->cancel_pending;
+  gpr_mu_unlock(&g_cache_mu);
+  if (orphaned) grpc_ares_cache_entry_destroy(entry);
+  if (!cancel_pending) grpc_ares_cache_lookup_destroy(lookup);
+}
+
+/* Starts looking up entry's name on behalf of the cache.  Must be called with
+   g_cache_mu held. */
+static void grpc_ares_cache_start_lookup_locked(grpc_ares_cache_entry* entry,
+                                                const char* dns_server,
+                                                const char* name,
+                                                const char* default_port,
+                                                bool check_grpclb,
+                                                int query_timeout_ms) {
+  grpc_ares_cache_lookup* lookup = grpc_core::New<grpc_ares_cache_lookup>();
+  lookup->entry = entry;
+  lookup->combiner = grpc_combiner_create();
+  lookup->pollset_set = grpc_pollset_set_create();
+  lookup->dns_server = gpr_strdup(dns_server);
+  lookup->name = gpr_strdup(name);
+  lookup->default_port = gpr_strdup(default_port);
+  lookup->check_grpclb = check_grpclb;
+  lookup->query_timeout_ms = query_timeout_ms;
+  GRPC_CLOSURE_INIT(&lookup->on_done, on_cache_lookup_done_locked, lookup,
+                    grpc_combiner_scheduler(lookup->combiner));
+  grpc_ares_request* r =
+      static_cast<grpc_ares_request*>(gpr_zalloc(sizeof(grpc_ares_request)));
+  r->on_done = &lookup->on_done;
+  r->addresses_out = &lookup->addresses;
+  if (entry->want_service_config) {
+    r->service_config_json_out = &lookup->service_config_json;
+  }
+  r->error = GRPC_ERROR_NONE;
+  lookup->request = r;
+  entry->lookup = lookup;
+  GRPC_CLOSURE_SCHED(
+      GRPC_CLOSURE_INIT(&lookup->on_start, on_cache_lookup_start_locked,
+                        lookup, grpc_combiner_scheduler(lookup->combiner)),
+      GRPC_ERROR_NONE);
+}
+
+/* Drops the entries whose results can no longer be returned. Must be called
+   with g_cache_mu held. */
+static void grpc_ares_cache_sweep_locked(grpc_millis now) {
+  for (auto it = g_cache->begin(); it != g_cache->end();) {
+    grpc_ares_cache_entry* entry = it->second;
+    if (entry->lookup == nullptr && now >= entry->stale_until) {
+      it = g_cache->erase(it);
+      grpc_ares_cache_entry_destroy(entry);
+    } else {
+      ++it;
+    }
+  }
+}
+
+/* Answers r from the cache: right away if it holds a usable result for name,
+   otherwise once the lookup for name in flight (started if needed)
+   completes. Concurrent requests for the same name share one lookup. Returns
+   false, leaving r to the caller, if the cache is disabled. */
+static bool grpc_ares_cache_lookup_locked(
+    grpc_ares_request* r, const char* dns_server, const char* name,
+    const char* default_port, grpc_pollset_set* interested_parties,
+    bool check_grpclb, int query_timeout_ms) {
+  if (g_cache_ttl_ms == 0) return false;
+  const bool want_service_config = r->service_config_json_out != nullptr;
+  char* key;
+  gpr_asprintf(&key, "%s\n%s\n%s\n%d%d",
+               dns_server == nullptr ? "" : dns_server, name,
+               default_port == nullptr ? "" : default_port, check_grpclb,
+               want_service_config);
+  grpc_core::MutexLock lock(&g_cache_mu);
+  if (g_cache == nullptr) {
+    gpr_free(key);
+    return false;
+  }
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_ares_cache_entry* entry;
+  auto it = g_cache->find(key);
+  if (it != g_cache->end()) {
+    gpr_free(key);
+    entry = it->second;
+  } else {
+    grpc_ares_cache_sweep_locked(now);
+    entry = grpc_core::New<grpc_ares_cache_entry>();
+    entry->key = key;
+    entry->want_service_config = want_service_config;
+    (*g_cache)[entry->key] = entry;
+  }
+  if (entry->addresses != nullptr && now < entry->stale_until) {
+    GRPC_CARES_TRACE_LOG("request:%p answered from cache", r);
+    if (now >= entry->fresh_until && entry->lookup == nullptr) {
+      grpc_ares_cache_start_lookup_locked(entry, dns_server, name,
+                                          default_port, check_grpclb,
+                                          query_timeout_ms);
+    }
+    grpc_ares_cache_copy_result(entry, r);
+    GRPC_CLOSURE_SCHED(r->on_done, GRPC_ERROR_NONE);
+    return true;
+  }
+  if (entry->lookup == nullptr) {
+    grpc_ares_cache_start_lookup_locked(entry, dns_server, name, default_port,
+                                        check_grpclb, query_timeout_ms);
+  }
+  GRPC_CARES_TRACE_LOG("request:%p waiting for cache lookup %p", r,
+                       entry->lookup);
+  r->interested_parties = interested_parties;
+  r->cache_lookup = entry->lookup;
+  r->next_cache_waiter = entry->lookup->waiters;
+  entry->lookup->waiters = r;
+  grpc_pollset_set_add_pollset_set(entry->lookup->pollset_set,
+                                   interested_parties);
+  return true;
+}
+
+/* If r is waiting for a cache lookup, stops waiting and fails it. Returns
+   whether it was. */
+static bool grpc_ares_cache_cancel_waiter_locked(grpc_ares_request* r) {
+  gpr_once_init(&g_cache_once, grpc_ares_cache_init_mu);
+  grpc_core::MutexLock lock(&g_cache_mu);
+  grpc_ares_cache_lookup* lookup = r->cache_lookup;
+  if (lookup == nullptr) return false;
+  for (grpc_ares_request** p = &lookup->waiters; *p != nullptr;
+       p = &(*p)->next_cache_waiter) {
+    if (*p == r) {
+      *p = r->next_cache_waiter;
+      break;
+    }
+  }
+  r->cache_lookup = nullptr;
+  r->next_cache_waiter = nullptr;
+  grpc_pollset_set_del_pollset_set(lookup->pollset_set, r->interested_parties);
+  GRPC_CLOSURE_SCHED(r->on_done, GRPC_ERROR_CANCELLED);
+  return true;
+}
+
+static void grpc_ares_cache_shutdown(void) {
+  grpc_core::MutexLock lock(&g_cache_mu);
+  if (g_cache == nullptr) return;
+  for (auto& p : *g_cache) {
+    grpc_ares_cache_entry* entry = p.second;
+    grpc_ares_cache_lookup* lookup = entry->lookup;
+    if (lookup == nullptr) {
+      grpc_ares_cache_entry_destroy(entry);
+    } else {
+      // The entry is destroyed when its lookup completes.
+      entry->orphaned = true;
+      lookup->cancel_pending = true;
+      GRPC_CLOSURE_SCHED(
+          GRPC_CLOSURE_INIT(&lookup->on_cancel, on_cache_lookup_cancel_locked,
+                            lookup, grpc_combiner_scheduler(lookup->combiner)),
+          GRPC_ERROR_NONE);
+    }
+  }
+  grpc_core::Delete(g_cache);
+  g_cache = nullptr;
+}
+
 static grpc_ares_request* grpc_dns_lookup_ares_locked_impl(
     const char* dns_server, const char* name, const char* default_port,
     grpc_pollset_set* interested_parties, grpc_closure* on_done,
@@ -621,6 +951,12 @@ static grpc_ares_request* grpc_dns_lookup_ares_locked_impl(
     check_grpclb = false;
     r->service_config_json_out = nullptr;
   }
+  // Answer from the process-wide cache if enabled.
+  if (grpc_ares_cache_lookup_locked(r, dns_server, name, default_port,
+                                    interested_parties, check_grpclb,
+                                    query_timeout_ms)) {
+    return r;
+  }
   // Look up name using c-ares lib.
   grpc_dns_lookup_ares_continue_after_check_localhost_and_ip_literals_locked(
       r, dns_server, name, default_port, interested_parties, check_grpclb,
@@ -637,6 +973,7 @@ grpc_ares_request* (*grpc_dns_lookup_ares_locked)(
 
 static void grpc_cancel_ares_request_locked_impl(grpc_ares_request* r) {
   GPR_ASSERT(r != nullptr);
+  if (grpc_ares_cache_cancel_waiter_locked(r)) return;
   if (r->ev_driver != nullptr) {
     grpc_ares_ev_driver_shutdown_locked(r->ev_driver);
   }
@@ -649,7 +986,7 @@ void (*grpc_cancel_ares_request_locked)(grpc_ares_request* r) =
 // Windows. Calling them may cause race conditions when other parts of the
 // binary calls these functions concurrently.
 #ifdef GPR_WINDOWS
-grpc_error* grpc_ares_init(void) {
+static grpc_error* grpc_ares_library_init(void) {
   int status = ares_library_init(ARES_LIB_INIT_ALL);
   if (status != ARES_SUCCESS) {
     char* error_msg;
@@ -662,12 +999,23 @@ grpc_error* grpc_ares_init(void) {
   return GRPC_ERROR_NONE;
 }
 
-void grpc_ares_cleanup(void) { ares_library_cleanup(); }
+static void grpc_ares_library_cleanup(void) { ares_library_cleanup(); }
 #else
-grpc_error* grpc_ares_init(void) { return GRPC_ERROR_NONE; }
-void grpc_ares_cleanup(void) {}
+static grpc_error* grpc_ares_library_init(void) { return GRPC_ERROR_NONE; }
+static void grpc_ares_library_cleanup(void) {}
 #endif  // GPR_WINDOWS
 
+grpc_error* grpc_ares_init(void) {
+  grpc_error* error = grpc_ares_library_init();
+  if (error == GRPC_ERROR_NONE) grpc_ares_cache_init();
+  return error;
+}
+
+void grpc_ares_cleanup(void) {
+  grpc_ares_cache_shutdown();
+  grpc_ares_library_cleanup();
+}
+
 /*
  * grpc_resolve_address_ares related structs and functions
  */
@@ -22,12 +22,16 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/ext/filters/client_channel/server_address.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 
 #define GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS 120000
 
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_dns_cache_ttl_ms);
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_dns_cache_stale_ms);
+
 extern grpc_core::TraceFlag grpc_trace_cares_address_sorting;
 
 extern grpc_core::TraceFlag grpc_trace_cares_resolver;
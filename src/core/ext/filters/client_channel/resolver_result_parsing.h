@@ -79,12 +79,15 @@ class ClientChannelGlobalParsedConfig : public ServiceConfig::ParsedConfig {
 
 class ClientChannelMethodParsedConfig : public ServiceConfig::ParsedConfig {
  public:
+  // Also holds a hedgingPolicy, which has a non-zero hedging_delay, no
+  // backoff and its nonFatalStatusCodes as retryable_status_codes.
   struct RetryPolicy {
     int max_attempts = 0;
     grpc_millis initial_backoff = 0;
     grpc_millis max_backoff = 0;
     float backoff_multiplier = 0;
     StatusCodeSet retryable_status_codes;
+    grpc_millis hedging_delay = 0;
   };
 
   ClientChannelMethodParsedConfig(grpc_millis timeout,
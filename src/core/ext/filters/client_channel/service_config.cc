@@ -61,6 +61,7 @@ ServiceConfig::ServiceConfig(UniquePtr<char> service_config_json,
     : service_config_json_(std::move(service_config_json)),
       json_string_(std::move(json_string)),
       json_tree_(json_tree) {
+  gpr_mu_init(&method_config_cache_mu_);
   GPR_DEBUG_ASSERT(error != nullptr);
   if (json_tree->type != GRPC_JSON_OBJECT || json_tree->key != nullptr) {
     *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
@@ -212,7 +213,13 @@ grpc_error* ServiceConfig::ParsePerMethodParams(const grpc_json* json_tree) {
   return GRPC_ERROR_CREATE_FROM_VECTOR("Method Params", &error_list);
 }
 
-ServiceConfig::~ServiceConfig() { grpc_json_destroy(json_tree_); }
+ServiceConfig::~ServiceConfig() {
+  for (const auto& p : method_config_cache_) {
+    p.first->Unref();
+  }
+  gpr_mu_destroy(&method_config_cache_mu_);
+  grpc_json_destroy(json_tree_);
+}
 
 int ServiceConfig::CountNamesInMethodConfig(grpc_json* json) {
   int num_names = 0;
@@ -285,11 +292,38 @@ UniquePtr<char> ServiceConfig::ParseJsonMethodName(grpc_json* json,
   return UniquePtr<char>(path);
 }
 
+// Upper bound on the number of paths memoized by a service config, in case an
+// application makes calls to an unbounded set of interned paths.
+#define MAX_CACHED_METHOD_CONFIGS 1024
+
 const ServiceConfig::ParsedConfigVector*
 ServiceConfig::GetMethodParsedConfigVector(const grpc_slice& path) {
   if (parsed_method_configs_table_.get() == nullptr) {
     return nullptr;
   }
+  if (!grpc_slice_is_interned(path)) {
+    return LookupMethodParsedConfigVector(path);
+  }
+  gpr_mu_lock(&method_config_cache_mu_);
+  auto it = method_config_cache_.find(path.refcount);
+  if (it != method_config_cache_.end()) {
+    const ParsedConfigVector* vector = it->second;
+    gpr_mu_unlock(&method_config_cache_mu_);
+    return vector;
+  }
+  gpr_mu_unlock(&method_config_cache_mu_);
+  const ParsedConfigVector* vector = LookupMethodParsedConfigVector(path);
+  gpr_mu_lock(&method_config_cache_mu_);
+  if (method_config_cache_.size() < MAX_CACHED_METHOD_CONFIGS &&
+      method_config_cache_.emplace(path.refcount, vector).second) {
+    path.refcount->Ref();
+  }
+  gpr_mu_unlock(&method_config_cache_mu_);
+  return vector;
+}
+
+const ServiceConfig::ParsedConfigVector*
+ServiceConfig::LookupMethodParsedConfigVector(const grpc_slice& path) {
   const auto* value = parsed_method_configs_table_->Get(path);
   // If we didn't find a match for the path, try looking for a wildcard
   // entry (i.e., change "/service/method" to "/service/*").
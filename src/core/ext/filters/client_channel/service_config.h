@@ -21,8 +21,10 @@
 
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/lib/gprpp/inlined_vector.h"
+#include "src/core/lib/gprpp/map.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/error.h"
@@ -143,6 +145,9 @@ class ServiceConfig : public RefCounted<ServiceConfig> {
   /// Retrieves the vector of parsed configs for the method identified
   /// by \a path.  The lifetime of the returned vector and contained objects
   /// is tied to the lifetime of the ServiceConfig object.
+  /// Results for interned paths (such as those of registered calls) are
+  /// memoized, so only the first call for a method pays for the table lookup
+  /// and the wildcard fallback.
   const ParsedConfigVector* GetMethodParsedConfigVector(const grpc_slice& path);
 
   /// Globally register a service config parser. On successful registration, it
@@ -183,6 +188,11 @@ class ServiceConfig : public RefCounted<ServiceConfig> {
       const grpc_json* json,
       SliceHashTable<const ParsedConfigVector*>::Entry* entries, size_t* idx);
 
+  // Looks up \a path in parsed_method_configs_table_, falling back to the
+  // wildcard entry for its service.
+  const ParsedConfigVector* LookupMethodParsedConfigVector(
+      const grpc_slice& path);
+
   UniquePtr<char> service_config_json_;
   UniquePtr<char> json_string_;  // Underlying storage for json_tree.
   grpc_json* json_tree_;
@@ -198,6 +208,11 @@ class ServiceConfig : public RefCounted<ServiceConfig> {
   // parsed_method_configs_table_.
   InlinedVector<UniquePtr<ParsedConfigVector>, 32>
       parsed_method_config_vectors_storage_;
+  // Results of GetMethodParsedConfigVector() for interned paths, by the
+  // path's refcount; null for paths without a method config. Holds a ref to
+  // each path, so that its refcount is not reused for another path.
+  gpr_mu method_config_cache_mu_;
+  Map<grpc_slice_refcount*, const ParsedConfigVector*> method_config_cache_;
 };
 
 }  // namespace grpc_core
@@ -83,10 +83,12 @@ DebugOnlyTraceFlag grpc_trace_subchannel_refcount(false, "subchannel_refcount");
 //
 
 ConnectedSubchannel::ConnectedSubchannel(
-    grpc_channel_stack* channel_stack, const grpc_channel_args* args,
+    grpc_channel_stack* channel_stack, grpc_transport* transport,
+    const grpc_channel_args* args,
     RefCountedPtr<channelz::SubchannelNode> channelz_subchannel)
     : RefCounted<ConnectedSubchannel>(&grpc_trace_subchannel_refcount),
       channel_stack_(channel_stack),
+      transport_(transport),
       args_(grpc_channel_args_copy(args)),
       channelz_subchannel_(std::move(channelz_subchannel)) {}
 
@@ -413,6 +415,191 @@ void Subchannel::ConnectivityStateWatcherList::NotifyLocked(
   }
 }
 
+//
+// SharedHealthCheck
+//
+
+namespace {
+
+// Implemented by the HealthWatchers that take part in a SharedHealthCheck.
+class SharedHealthCheckParticipant {
+ public:
+  virtual ~SharedHealthCheckParticipant() = default;
+
+  // Called with g_shared_health_check_mu held when the shared health
+  // state has changed and the participant has no notification pending.
+  // Must not take the participant's subchannel lock.
+  virtual void OnSharedStateChangedLocked() = 0;
+};
+
+class SharedHealthCheck;
+
+// Guards g_shared_health_checks and every SharedHealthCheck.  When held
+// together with a subchannel's lock, the subchannel's lock is taken first.
+gpr_once g_shared_health_check_once = GPR_ONCE_INIT;
+gpr_mu g_shared_health_check_mu;
+Map<const char*, RefCountedPtr<SharedHealthCheck>, StringLess>*
+    g_shared_health_checks;
+
+void InitSharedHealthChecks() {
+  gpr_mu_init(&g_shared_health_check_mu);
+  g_shared_health_checks =
+      New<Map<const char*, RefCountedPtr<SharedHealthCheck>, StringLess>>();
+}
+
+// A single health check stream for one service name on one backend
+// address, shared by the subchannels of all channels to that address that
+// set GRPC_ARG_SHARE_HEALTH_CHECKS.  The stream runs on the connection of
+// the first participant; when that one leaves, it is restarted on the
+// connection of another.  Each participant gets at most one pending
+// notification at a time, which reads the latest shared state when it
+// runs, so a burst of changes costs each participant one callback.
+class SharedHealthCheck : public RefCounted<SharedHealthCheck> {
+ public:
+  SharedHealthCheck(UniquePtr<char> key, const char* service_name)
+      : key_(std::move(key)), service_name_(gpr_strdup(service_name)) {}
+
+  // Adds participant to the shared check for service_name on address,
+  // creating the check if needed.  The participant's subchannel must be
+  // READY on connected_subchannel.
+  static RefCountedPtr<SharedHealthCheck> Join(
+      const char* address, const char* service_name,
+      SharedHealthCheckParticipant* participant,
+      RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+      grpc_pollset_set* interested_parties,
+      RefCountedPtr<channelz::SubchannelNode> channelz_node) {
+    gpr_once_init(&g_shared_health_check_once, InitSharedHealthChecks);
+    char* key;
+    gpr_asprintf(&key, "%s %s", address, service_name);
+    MutexLock lock(&g_shared_health_check_mu);
+    RefCountedPtr<SharedHealthCheck> check;
+    auto it = g_shared_health_checks->find(key);
+    if (it == g_shared_health_checks->end()) {
+      check = MakeRefCounted<SharedHealthCheck>(UniquePtr<char>(key),
+                                                service_name);
+      (*g_shared_health_checks)[check->key_.get()] = check;
+    } else {
+      gpr_free(key);
+      check = it->second;
+    }
+    check->participants_.emplace_back();
+    Participant& p = check->participants_[check->participants_.size() - 1];
+    p.participant = participant;
+    p.connected_subchannel = std::move(connected_subchannel);
+    p.interested_parties = interested_parties;
+    p.channelz_node = std::move(channelz_node);
+    if (check->hosted_ == nullptr) {
+      check->StartHostingLocked();
+    } else if (check->state_ != GRPC_CHANNEL_CONNECTING) {
+      // The participant starts out CONNECTING; catch it up.
+      p.notify_pending = true;
+      participant->OnSharedStateChangedLocked();
+    }
+    return check;
+  }
+
+  void Leave(SharedHealthCheckParticipant* participant) {
+    MutexLock lock(&g_shared_health_check_mu);
+    size_t i = IndexOfLocked(participant);
+    if (i == 0) StopHostingLocked();
+    participants_[i] = std::move(participants_[participants_.size() - 1]);
+    participants_.pop_back();
+    if (participants_.empty()) {
+      // The caller still holds a ref, so this does not destroy us.
+      g_shared_health_checks->erase(key_.get());
+    } else if (hosted_ == nullptr) {
+      StartHostingLocked();
+    }
+  }
+
+  // Called by a participant when running the notification scheduled by
+  // OnSharedStateChangedLocked().  Returns the current shared state.
+  grpc_connectivity_state ConsumeNotification(
+      SharedHealthCheckParticipant* participant) {
+    MutexLock lock(&g_shared_health_check_mu);
+    participants_[IndexOfLocked(participant)].notify_pending = false;
+    return state_;
+  }
+
+ private:
+  struct Participant {
+    SharedHealthCheckParticipant* participant = nullptr;
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+    grpc_pollset_set* interested_parties = nullptr;
+    RefCountedPtr<channelz::SubchannelNode> channelz_node;
+    bool notify_pending = false;
+  };
+
+  // The health check client running on the first participant's
+  // connection.  Deleted by its own callback once it is no longer hosted_.
+  struct HostedCheck {
+    RefCountedPtr<SharedHealthCheck> parent;
+    OrphanablePtr<HealthCheckClient> client;
+    grpc_connectivity_state state;
+    grpc_closure on_health_changed;
+  };
+
+  size_t IndexOfLocked(SharedHealthCheckParticipant* participant) const {
+    for (size_t i = 0; i < participants_.size(); ++i) {
+      if (participants_[i].participant == participant) return i;
+    }
+    GPR_UNREACHABLE_CODE(return 0);
+  }
+
+  void StartHostingLocked() {
+    const Participant& host = participants_[0];
+    hosted_ = New<HostedCheck>();
+    hosted_->parent = Ref();
+    hosted_->client = MakeOrphanable<HealthCheckClient>(
+        service_name_.get(), host.connected_subchannel,
+        host.interested_parties, host.channelz_node);
+    hosted_->state = state_;
+    GRPC_CLOSURE_INIT(&hosted_->on_health_changed, OnHealthChanged, hosted_,
+                      grpc_schedule_on_exec_ctx);
+    hosted_->client->NotifyOnHealthChange(&hosted_->state,
+                                          &hosted_->on_health_changed);
+  }
+
+  void StopHostingLocked() {
+    // Orphaning the client runs its pending callback, which deletes
+    // hosted_.
+    hosted_->client.reset();
+    hosted_ = nullptr;
+  }
+
+  static void OnHealthChanged(void* arg, grpc_error* error) {
+    HostedCheck* hosted = static_cast<HostedCheck*>(arg);
+    {
+      MutexLock lock(&g_shared_health_check_mu);
+      SharedHealthCheck* self = hosted->parent.get();
+      if (self->hosted_ == hosted) {
+        self->state_ = hosted->state;
+        for (size_t i = 0; i < self->participants_.size(); ++i) {
+          Participant& p = self->participants_[i];
+          if (!p.notify_pending) {
+            p.notify_pending = true;
+            p.participant->OnSharedStateChangedLocked();
+          }
+        }
+        // Renew watch.
+        hosted->client->NotifyOnHealthChange(&hosted->state,
+                                             &hosted->on_health_changed);
+        return;
+      }
+    }
+    Delete(hosted);
+  }
+
+  UniquePtr<char> key_;
+  UniquePtr<char> service_name_;
+  // The first participant hosts the health check stream.
+  InlinedVector<Participant, 4> participants_;
+  HostedCheck* hosted_ = nullptr;
+  grpc_connectivity_state state_ = GRPC_CHANNEL_CONNECTING;
+};
+
+}  // namespace
+
 //
 // Subchannel::HealthWatcherMap::HealthWatcher
 //
@@ -420,17 +607,23 @@ void Subchannel::ConnectivityStateWatcherList::NotifyLocked(
 // State needed for tracking the connectivity state with a particular
 // health check service name.
 class Subchannel::HealthWatcherMap::HealthWatcher
-    : public InternallyRefCounted<HealthWatcher> {
+    : public InternallyRefCounted<HealthWatcher>,
+      public SharedHealthCheckParticipant {
  public:
   HealthWatcher(Subchannel* c, UniquePtr<char> health_check_service_name,
                 grpc_connectivity_state subchannel_state)
       : subchannel_(c),
         health_check_service_name_(std::move(health_check_service_name)),
+        share_health_check_(grpc_channel_arg_get_bool(
+            grpc_channel_args_find(c->args_, GRPC_ARG_SHARE_HEALTH_CHECKS),
+            false)),
         state_(subchannel_state == GRPC_CHANNEL_READY ? GRPC_CHANNEL_CONNECTING
                                                       : subchannel_state) {
     GRPC_SUBCHANNEL_WEAK_REF(subchannel_, "health_watcher");
     GRPC_CLOSURE_INIT(&on_health_changed_, OnHealthChanged, this,
                       grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_shared_state_changed_, OnSharedStateChanged, this,
+                      grpc_schedule_on_exec_ctx);
     // If the subchannel is already connected, start health checking.
     if (subchannel_state == GRPC_CHANNEL_READY) StartHealthCheckingLocked();
   }
@@ -481,19 +674,33 @@ class Subchannel::HealthWatcherMap::HealthWatcher
       state_ = state;
       watcher_list_.NotifyLocked(subchannel_, state_);
       // We're not connected, so stop health checking.
-      health_check_client_.reset();
+      StopHealthCheckingLocked();
     }
   }
 
   void Orphan() override {
     watcher_list_.Clear();
-    health_check_client_.reset();
+    StopHealthCheckingLocked();
     Unref();
   }
 
+  void OnSharedStateChangedLocked() override {
+    Ref().release();  // Ref for notification callback tracked manually.
+    GRPC_CLOSURE_SCHED(&on_shared_state_changed_, GRPC_ERROR_NONE);
+  }
+
  private:
   void StartHealthCheckingLocked() {
     GPR_ASSERT(health_check_client_ == nullptr);
+    GPR_ASSERT(shared_health_check_ == nullptr);
+    if (share_health_check_) {
+      shared_health_check_ = SharedHealthCheck::Join(
+          GetUriFromSubchannelAddressArg(subchannel_->args_),
+          health_check_service_name_.get(), this,
+          subchannel_->connected_subchannel_, subchannel_->pollset_set_,
+          subchannel_->channelz_node_);
+      return;
+    }
     health_check_client_ = MakeOrphanable<HealthCheckClient>(
         health_check_service_name_.get(), subchannel_->connected_subchannel_,
         subchannel_->pollset_set_, subchannel_->channelz_node_);
@@ -520,10 +727,40 @@ class Subchannel::HealthWatcherMap::HealthWatcher
     self->Unref();
   }
 
+  void StopHealthCheckingLocked() {
+    health_check_client_.reset();
+    if (shared_health_check_ != nullptr) {
+      shared_health_check_->Leave(this);
+      shared_health_check_.reset();
+    }
+  }
+
+  static void OnSharedStateChanged(void* arg, grpc_error* error) {
+    auto* self = static_cast<HealthWatcher*>(arg);
+    Subchannel* c = self->subchannel_;
+    {
+      MutexLock lock(&c->mu_);
+      // If we stopped health checking since the notification was
+      // scheduled, the state is no longer ours to report.
+      if (self->shared_health_check_ != nullptr) {
+        grpc_connectivity_state state =
+            self->shared_health_check_->ConsumeNotification(self);
+        if (state != self->state_) {
+          self->state_ = state;
+          self->watcher_list_.NotifyLocked(c, self->state_);
+        }
+      }
+    }
+    self->Unref();
+  }
+
   Subchannel* subchannel_;
   UniquePtr<char> health_check_service_name_;
+  const bool share_health_check_;
   OrphanablePtr<HealthCheckClient> health_check_client_;
+  RefCountedPtr<SharedHealthCheck> shared_health_check_;
   grpc_closure on_health_changed_;
+  grpc_closure on_shared_state_changed_;
   grpc_connectivity_state state_;
   ConnectivityStateWatcherList watcher_list_;
 };
@@ -823,7 +1060,7 @@ void Subchannel::WatchConnectivityState(
   MutexLock lock(&mu_);
   grpc_pollset_set* interested_parties = watcher->interested_parties();
   if (interested_parties != nullptr) {
-    grpc_pollset_set_add_pollset_set(pollset_set_, interested_parties);
+    AddInterestedPartiesLocked(interested_parties);
   }
   if (health_check_service_name == nullptr) {
     if (state_ != initial_state) {
@@ -843,7 +1080,7 @@ void Subchannel::CancelConnectivityStateWatch(
   MutexLock lock(&mu_);
   grpc_pollset_set* interested_parties = watcher->interested_parties();
   if (interested_parties != nullptr) {
-    grpc_pollset_set_del_pollset_set(pollset_set_, interested_parties);
+    RemoveInterestedPartiesLocked(interested_parties);
   }
   if (health_check_service_name == nullptr) {
     watcher_list_.RemoveWatcherLocked(watcher);
@@ -852,6 +1089,24 @@ void Subchannel::CancelConnectivityStateWatch(
   }
 }
 
+void Subchannel::AddInterestedPartiesLocked(
+    grpc_pollset_set* interested_parties) {
+  size_t& watchers = interested_parties_[interested_parties];
+  if (watchers++ == 0) {
+    grpc_pollset_set_add_pollset_set(pollset_set_, interested_parties);
+  }
+}
+
+void Subchannel::RemoveInterestedPartiesLocked(
+    grpc_pollset_set* interested_parties) {
+  auto it = interested_parties_.find(interested_parties);
+  GPR_ASSERT(it != interested_parties_.end());
+  if (--it->second == 0) {
+    grpc_pollset_set_del_pollset_set(pollset_set_, interested_parties);
+    interested_parties_.erase(it);
+  }
+}
+
 void Subchannel::AttemptToConnect() {
   MutexLock lock(&mu_);
   MaybeStartConnectingLocked();
@@ -1072,6 +1327,7 @@ bool Subchannel::PublishTransportLocked() {
     GRPC_ERROR_UNREF(error);
     return false;
   }
+  grpc_transport* transport = connecting_result_.transport;
   RefCountedPtr<channelz::SocketNode> socket =
       std::move(connecting_result_.socket);
   connecting_result_.reset();
@@ -1082,7 +1338,7 @@ bool Subchannel::PublishTransportLocked() {
   }
   // Publish.
   connected_subchannel_.reset(
-      New<ConnectedSubchannel>(stk, args_, channelz_node_));
+      New<ConnectedSubchannel>(stk, transport, args_, channelz_node_));
   gpr_log(GPR_INFO, "New connected subchannel at %p for subchannel %p",
           connected_subchannel_.get(), this);
   if (channelz_node_ != nullptr) {
@@ -39,6 +39,10 @@
 // Channel arg containing a grpc_resolved_address to connect to.
 #define GRPC_ARG_SUBCHANNEL_ADDRESS "grpc.subchannel_address"
 
+// Channel arg telling apart the subchannels LB policies create for the same
+// address when GRPC_ARG_CONNECTIONS_PER_ADDRESS is set.
+#define GRPC_ARG_SUBCHANNEL_CONNECTION_INDEX "grpc.subchannel_connection_index"
+
 // For debugging refcounting.
 #ifndef NDEBUG
 #define GRPC_SUBCHANNEL_REF(p, r) (p)->Ref(__FILE__, __LINE__, (r))
@@ -72,7 +76,8 @@ class SubchannelCall;
 class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
  public:
   ConnectedSubchannel(
-      grpc_channel_stack* channel_stack, const grpc_channel_args* args,
+      grpc_channel_stack* channel_stack, grpc_transport* transport,
+      const grpc_channel_args* args,
       RefCountedPtr<channelz::SubchannelNode> channelz_subchannel);
   ~ConnectedSubchannel();
 
@@ -89,8 +94,16 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
 
   size_t GetInitialCallSizeEstimate(size_t parent_data_size) const;
 
+  // Returns how many more calls the connection can start right now without
+  // queueing them in the transport (see grpc_transport_get_available_streams).
+  int32_t GetAvailableStreams() const {
+    return grpc_transport_get_available_streams(transport_);
+  }
+
  private:
   grpc_channel_stack* channel_stack_;
+  // Owned by the channel stack.
+  grpc_transport* transport_;
   grpc_channel_args* args_;
   // ref counted pointer to the channelz node in this connected subchannel's
   // owning subchannel.
@@ -337,6 +350,11 @@ class Subchannel {
   // Sets the subchannel's connectivity state to \a state.
   void SetConnectivityStateLocked(grpc_connectivity_state state);
 
+  // Links a watcher's pollset_set into pollset_set_, or unlinks it once no
+  // watcher uses it any more.
+  void AddInterestedPartiesLocked(grpc_pollset_set* interested_parties);
+  void RemoveInterestedPartiesLocked(grpc_pollset_set* interested_parties);
+
   // Methods for connection.
   void MaybeStartConnectingLocked();
   static void OnRetryAlarm(void* arg, grpc_error* error);
@@ -383,6 +401,12 @@ class Subchannel {
   // The map of watchers with health check service names.
   HealthWatcherMap health_watcher_map_;
 
+  // The pollset_sets of watchers, linked into pollset_set_, with the number of
+  // watchers using each. Many watchers share their channel's pollset_set, so
+  // only the first watch links it in and only the last one unlinks it, rather
+  // than every watch merging and unmerging the sets again.
+  Map<grpc_pollset_set*, size_t> interested_parties_;
+
   // Backoff state.
   BackOff backoff_;
   grpc_millis next_attempt_deadline_;
@@ -90,6 +90,13 @@ class SubchannelInterface : public RefCounted<SubchannelInterface> {
   // TODO(roth): Need a better non-grpc-specific abstraction here.
   virtual const grpc_channel_args* channel_args() GRPC_ABSTRACT;
 
+  // Returns how many more calls the subchannel's connection can start right
+  // now without queueing them until the backend allows more concurrent
+  // streams, or INT32_MAX if that is not limited (or not known).  Only
+  // meaningful while the subchannel is READY.  May only be called from a
+  // picker, so that the caller holds the channel's data plane mutex.
+  virtual int32_t GetAvailableStreams() { return INT32_MAX; }
+
   GRPC_ABSTRACT_BASE_CLASS
 };
 
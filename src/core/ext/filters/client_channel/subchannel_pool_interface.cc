@@ -33,23 +33,27 @@ TraceFlag grpc_subchannel_pool_trace(false, "subchannel_pool");
 
 SubchannelKey::SubchannelKey(const grpc_channel_args* args) {
   Init(args, grpc_channel_args_normalize);
+  hash_ = grpc_channel_args_hash(args_);
 }
 
 SubchannelKey::~SubchannelKey() {
   grpc_channel_args_destroy(const_cast<grpc_channel_args*>(args_));
 }
 
-SubchannelKey::SubchannelKey(const SubchannelKey& other) {
+SubchannelKey::SubchannelKey(const SubchannelKey& other)
+    : hash_(other.hash_) {
   Init(other.args_, grpc_channel_args_copy);
 }
 
 SubchannelKey& SubchannelKey::operator=(const SubchannelKey& other) {
   grpc_channel_args_destroy(const_cast<grpc_channel_args*>(args_));
   Init(other.args_, grpc_channel_args_copy);
+  hash_ = other.hash_;
   return *this;
 }
 
 int SubchannelKey::Cmp(const SubchannelKey& other) const {
+  if (hash_ != other.hash_) return hash_ < other.hash_ ? -1 : 1;
   return grpc_channel_args_compare(args_, other.args_);
 }
 
@@ -45,8 +45,13 @@ class SubchannelKey {
   SubchannelKey(SubchannelKey&&) = delete;
   SubchannelKey& operator=(SubchannelKey&&) = delete;
 
+  // Orders keys by hash first, so that most comparisons of different keys
+  // do not walk their args.
   int Cmp(const SubchannelKey& other) const;
 
+  // Keys that compare equal have the same hash.
+  uint32_t Hash() const { return hash_; }
+
  private:
   // Initializes the subchannel key with the given \a args and the function to
   // copy channel args.
@@ -55,6 +60,7 @@ class SubchannelKey {
       grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args));
 
   const grpc_channel_args* args_;
+  uint32_t hash_;
 };
 
 // Interface for subchannel pool.
@@ -0,0 +1,303 @@
+//
+// Copyright 2019 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/concurrency_limit/concurrency_limit_filter.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/transport/error_utils.h"
+#include "src/core/lib/transport/status_metadata.h"
+
+static void recv_trailing_metadata_ready(void* user_data, grpc_error* error);
+
+namespace grpc_core {
+
+namespace {
+size_t g_concurrency_limit_parser_index;
+
+constexpr uint32_t kDefaultInitialLimit = 20;
+constexpr uint32_t kDefaultMinLimit = 1;
+constexpr uint32_t kDefaultMaxLimit = 1000;
+
+// Parses a positive integer field of the concurrencyLimit object into *value.
+void ParseLimit(const grpc_json* field, uint32_t* value,
+                InlinedVector<grpc_error*, 4>* error_list) {
+  if (field->type != GRPC_JSON_NUMBER) {
+    char* msg;
+    gpr_asprintf(&msg, "field:%s error:should be of type number", field->key);
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_COPIED_STRING(msg));
+    gpr_free(msg);
+    return;
+  }
+  const int parsed = gpr_parse_nonnegative_int(field->value);
+  if (parsed <= 0) {
+    char* msg;
+    gpr_asprintf(&msg, "field:%s error:should be positive", field->key);
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_COPIED_STRING(msg));
+    gpr_free(msg);
+    return;
+  }
+  *value = static_cast<uint32_t>(parsed);
+}
+}  // namespace
+
+UniquePtr<ServiceConfig::ParsedConfig>
+ConcurrencyLimitParser::ParsePerMethodParams(const grpc_json* json,
+                                             grpc_error** error) {
+  GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+  const grpc_json* limit_json = nullptr;
+  for (grpc_json* field = json->child; field != nullptr; field = field->next) {
+    if (field->key == nullptr) continue;
+    if (strcmp(field->key, "concurrencyLimit") == 0) {
+      if (limit_json != nullptr) {
+        *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:concurrencyLimit error:Duplicate entry");
+        return nullptr;
+      }
+      limit_json = field;
+    }
+  }
+  if (limit_json == nullptr) return nullptr;
+  if (limit_json->type != GRPC_JSON_OBJECT) {
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:concurrencyLimit error:should be of type object");
+    return nullptr;
+  }
+  uint32_t initial_limit = kDefaultInitialLimit;
+  uint32_t min_limit = kDefaultMinLimit;
+  uint32_t max_limit = kDefaultMaxLimit;
+  InlinedVector<grpc_error*, 4> error_list;
+  for (grpc_json* field = limit_json->child; field != nullptr;
+       field = field->next) {
+    if (field->key == nullptr) continue;
+    if (strcmp(field->key, "initialLimit") == 0) {
+      ParseLimit(field, &initial_limit, &error_list);
+    } else if (strcmp(field->key, "minLimit") == 0) {
+      ParseLimit(field, &min_limit, &error_list);
+    } else if (strcmp(field->key, "maxLimit") == 0) {
+      ParseLimit(field, &max_limit, &error_list);
+    }
+  }
+  if (error_list.empty() &&
+      (min_limit > initial_limit || initial_limit > max_limit)) {
+    error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:concurrencyLimit error:should have minLimit <= initialLimit <= "
+        "maxLimit"));
+  }
+  if (!error_list.empty()) {
+    *error =
+        GRPC_ERROR_CREATE_FROM_VECTOR("Concurrency limit parser", &error_list);
+    return nullptr;
+  }
+  return UniquePtr<ServiceConfig::ParsedConfig>(
+      New<ConcurrencyLimitParsedConfig>(initial_limit, min_limit, max_limit));
+}
+
+void ConcurrencyLimitParser::Register() {
+  g_concurrency_limit_parser_index = ServiceConfig::RegisterParser(
+      UniquePtr<ServiceConfig::Parser>(New<ConcurrencyLimitParser>()));
+}
+
+size_t ConcurrencyLimitParser::ParserIndex() {
+  return g_concurrency_limit_parser_index;
+}
+}  // namespace grpc_core
+
+namespace {
+struct call_data {
+  call_data(grpc_call_element* elem, const grpc_call_element_args& args)
+      : call_combiner(args.call_combiner), deadline(args.deadline) {
+    GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready,
+                      ::recv_trailing_metadata_ready, elem,
+                      grpc_schedule_on_exec_ctx);
+    // The client channel puts the method's config in the call context.
+    grpc_core::ServiceConfig::CallData* svc_cfg_call_data = nullptr;
+    if (args.context != nullptr) {
+      svc_cfg_call_data = static_cast<grpc_core::ServiceConfig::CallData*>(
+          args.context[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value);
+    }
+    if (svc_cfg_call_data != nullptr) {
+      const auto* config =
+          static_cast<const grpc_core::ConcurrencyLimitParsedConfig*>(
+              svc_cfg_call_data->GetMethodParsedConfig(
+                  grpc_core::ConcurrencyLimitParser::ParserIndex()));
+      if (config != nullptr) limiter = config->limiter();
+    }
+  }
+
+  ~call_data() {
+    if (acquired) limiter->Release();
+  }
+
+  grpc_core::CallCombiner* call_combiner;
+  grpc_millis deadline;
+  // The limiter of the call's method, if it has one.
+  grpc_core::RefCountedPtr<grpc_core::ConcurrencyLimiter> limiter;
+  // Whether the call holds a slot of the limiter, and since when.
+  bool acquired = false;
+  gpr_timespec start_time;
+  grpc_closure recv_trailing_metadata_ready;
+  grpc_metadata_batch* recv_trailing_metadata = nullptr;
+  // Original recv_trailing_metadata callback, invoked after our own.
+  grpc_closure* original_recv_trailing_metadata_ready = nullptr;
+};
+
+}  // namespace
+
+// Callback invoked on completion of recv_trailing_metadata. Gives the call's
+// slot back to the limiter, along with how long the call took and whether it
+// failed in a way that suggests the server is overloaded.
+static void recv_trailing_metadata_ready(void* user_data, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(user_data);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (calld->acquired) {
+    calld->acquired = false;
+    grpc_status_code status = GRPC_STATUS_OK;
+    if (error != GRPC_ERROR_NONE) {
+      grpc_error_get_status(error, calld->deadline, &status, nullptr, nullptr,
+                            nullptr);
+    } else if (calld->recv_trailing_metadata->idx.named.grpc_status !=
+               nullptr) {
+      status = grpc_get_status_code_from_metadata(
+          calld->recv_trailing_metadata->idx.named.grpc_status->md);
+    }
+    switch (status) {
+      case GRPC_STATUS_CANCELLED:
+        calld->limiter->Release();
+        break;
+      case GRPC_STATUS_DEADLINE_EXCEEDED:
+      case GRPC_STATUS_RESOURCE_EXHAUSTED:
+      case GRPC_STATUS_UNAVAILABLE:
+        calld->limiter->Release(0, true /* overloaded */);
+        break;
+      default:
+        calld->limiter->Release(
+            gpr_timespec_to_micros(gpr_time_sub(
+                gpr_now(GPR_CLOCK_MONOTONIC), calld->start_time)) /
+                GPR_US_PER_SEC,
+            false /* overloaded */);
+    }
+  }
+  // Invoke the next callback.
+  GRPC_CLOSURE_RUN(calld->original_recv_trailing_metadata_ready,
+                   GRPC_ERROR_REF(error));
+}
+
+// Start transport stream op.
+static void start_transport_stream_op_batch(
+    grpc_call_element* elem, grpc_transport_stream_op_batch* op) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (calld->limiter != nullptr) {
+    // Take a slot when the call starts, or fail it.
+    if (op->send_initial_metadata) {
+      if (!calld->limiter->TryAcquire()) {
+        grpc_transport_stream_op_batch_finish_with_failure(
+            op,
+            grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                   "Concurrency limit reached"),
+                               GRPC_ERROR_INT_GRPC_STATUS,
+                               GRPC_STATUS_RESOURCE_EXHAUSTED),
+            calld->call_combiner);
+        return;
+      }
+      calld->acquired = true;
+      calld->start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+    }
+    // Inject callback for receiving trailing metadata.
+    if (op->recv_trailing_metadata) {
+      calld->recv_trailing_metadata =
+          op->payload->recv_trailing_metadata.recv_trailing_metadata;
+      calld->original_recv_trailing_metadata_ready =
+          op->payload->recv_trailing_metadata.recv_trailing_metadata_ready;
+      op->payload->recv_trailing_metadata.recv_trailing_metadata_ready =
+          &calld->recv_trailing_metadata_ready;
+    }
+  }
+  // Chain to the next filter.
+  grpc_call_next_op(elem, op);
+}
+
+// Constructor for call_data.
+static grpc_error* init_call_elem(grpc_call_element* elem,
+                                  const grpc_call_element_args* args) {
+  new (elem->call_data) call_data(elem, *args);
+  return GRPC_ERROR_NONE;
+}
+
+// Destructor for call_data.
+static void destroy_call_elem(grpc_call_element* elem,
+                              const grpc_call_final_info* final_info,
+                              grpc_closure* ignored) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  calld->~call_data();
+}
+
+// Constructor for channel_data.
+static grpc_error* init_channel_elem(grpc_channel_element* elem,
+                                     grpc_channel_element_args* args) {
+  GPR_ASSERT(!args->is_last);
+  return GRPC_ERROR_NONE;
+}
+
+// Destructor for channel_data.
+static void destroy_channel_elem(grpc_channel_element* elem) {}
+
+const grpc_channel_filter grpc_concurrency_limit_filter = {
+    start_transport_stream_op_batch,
+    grpc_channel_next_op,
+    sizeof(call_data),
+    init_call_elem,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    destroy_call_elem,
+    0,  // sizeof(channel_data)
+    init_channel_elem,
+    destroy_channel_elem,
+    grpc_channel_next_get_info,
+    "concurrency_limit"};
+
+// The limits come from the service config the client channel applies to each
+// call, so the filter only goes in subchannel stacks.
+static bool maybe_add_concurrency_limit_filter(
+    grpc_channel_stack_builder* builder, void* arg) {
+  const grpc_channel_args* channel_args =
+      grpc_channel_stack_builder_get_channel_arguments(builder);
+  if (grpc_channel_args_want_minimal_stack(channel_args)) {
+    return true;
+  }
+  return grpc_channel_stack_builder_prepend_filter(
+      builder, &grpc_concurrency_limit_filter, nullptr, nullptr);
+}
+
+void grpc_concurrency_limit_filter_init(void) {
+  grpc_channel_init_register_stage(
+      GRPC_CLIENT_SUBCHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      maybe_add_concurrency_limit_filter, nullptr);
+  grpc_core::ConcurrencyLimitParser::Register();
+}
+
+void grpc_concurrency_limit_filter_shutdown(void) {}
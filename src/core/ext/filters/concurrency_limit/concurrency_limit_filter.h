@@ -0,0 +1,71 @@
+//
+// Copyright 2019 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CONCURRENCY_LIMIT_CONCURRENCY_LIMIT_FILTER_H
+#define GRPC_CORE_EXT_FILTERS_CONCURRENCY_LIMIT_CONCURRENCY_LIMIT_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/service_config.h"
+#include "src/core/ext/filters/concurrency_limit/concurrency_limiter.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+
+extern const grpc_channel_filter grpc_concurrency_limit_filter;
+
+namespace grpc_core {
+
+// The "concurrencyLimit" object of a method config. Since a service config is
+// parsed for each channel, the limiter it holds is shared by the calls of
+// that channel to the methods the config names, and starts over when the
+// channel gets a new service config.
+class ConcurrencyLimitParsedConfig : public ServiceConfig::ParsedConfig {
+ public:
+  ConcurrencyLimitParsedConfig(uint32_t initial_limit, uint32_t min_limit,
+                               uint32_t max_limit)
+      : initial_limit_(initial_limit),
+        min_limit_(min_limit),
+        max_limit_(max_limit),
+        limiter_(MakeRefCounted<ConcurrencyLimiter>(initial_limit, min_limit,
+                                                    max_limit)) {}
+
+  uint32_t initial_limit() const { return initial_limit_; }
+  uint32_t min_limit() const { return min_limit_; }
+  uint32_t max_limit() const { return max_limit_; }
+
+  const RefCountedPtr<ConcurrencyLimiter>& limiter() const { return limiter_; }
+
+ private:
+  uint32_t initial_limit_;
+  uint32_t min_limit_;
+  uint32_t max_limit_;
+  RefCountedPtr<ConcurrencyLimiter> limiter_;
+};
+
+class ConcurrencyLimitParser : public ServiceConfig::Parser {
+ public:
+  UniquePtr<ServiceConfig::ParsedConfig> ParsePerMethodParams(
+      const grpc_json* json, grpc_error** error) override;
+
+  static void Register();
+
+  static size_t ParserIndex();
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_FILTERS_CONCURRENCY_LIMIT_CONCURRENCY_LIMIT_FILTER_H \
+        */
@@ -0,0 +1,148 @@
+//
+// Copyright 2019 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CONCURRENCY_LIMIT_CONCURRENCY_LIMITER_H
+#define GRPC_CORE_EXT_FILTERS_CONCURRENCY_LIMIT_CONCURRENCY_LIMITER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <math.h>
+#include <stdint.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Caps the number of calls in flight, adapting the cap to the latency the
+// calls see (the gradient algorithm).
+//
+// The limit is revised once per window of samples, a window being as many
+// completed calls as the limit, or about one round trip at full use. A
+// long-term average of the windows' round trip times stands for the latency
+// without queueing. While the latest window stays within kTolerance of it the
+// limit grows by about sqrt(limit), and once it rises above that the limit
+// shrinks in proportion. A window with calls that failed in a way that
+// suggests overload (deadline exceeded, resource exhausted, unavailable) cuts
+// the limit multiplicatively instead, as AIMD would.
+class ConcurrencyLimiter : public RefCounted<ConcurrencyLimiter> {
+ public:
+  // How far above the long-term average a window may be before the limit
+  // shrinks.
+  static constexpr double kTolerance = 1.5;
+  // The number of windows the long-term average is taken over.
+  static constexpr double kLongWindow = 20;
+  // The weight of each new limit estimate against the current limit.
+  static constexpr double kSmoothing = 0.2;
+  // The factor the limit is cut by after a window with overloaded calls.
+  static constexpr double kBackoff = 0.9;
+
+  ConcurrencyLimiter(uint32_t initial_limit, uint32_t min_limit,
+                     uint32_t max_limit)
+      : min_limit_(min_limit), max_limit_(max_limit), limit_(initial_limit) {}
+
+  // Takes a slot for a new call, or returns false if the limit is reached.
+  bool TryAcquire() {
+    MutexLock lock(&mu_);
+    if (in_flight_ >= static_cast<uint32_t>(limit_)) return false;
+    ++in_flight_;
+    return true;
+  }
+
+  // Gives back the slot of a call that completed after rtt_seconds, or that
+  // was overloaded, and revises the limit at the end of a window.
+  void Release(double rtt_seconds, bool overloaded) {
+    MutexLock lock(&mu_);
+    window_max_in_flight_ = GPR_MAX(window_max_in_flight_, in_flight_);
+    --in_flight_;
+    if (overloaded) {
+      window_overloaded_ = true;
+    } else {
+      window_rtt_sum_ += rtt_seconds;
+      ++window_rtt_count_;
+    }
+    if (++window_samples_ < static_cast<uint32_t>(limit_)) return;
+    const bool overloaded_window = window_overloaded_;
+    const uint32_t max_in_flight = window_max_in_flight_;
+    const double short_rtt = window_rtt_count_ > 0
+                                 ? window_rtt_sum_ / window_rtt_count_
+                                 : 0;
+    window_samples_ = 0;
+    window_max_in_flight_ = 0;
+    window_overloaded_ = false;
+    window_rtt_sum_ = 0;
+    window_rtt_count_ = 0;
+    if (overloaded_window) {
+      SetLimitLocked(limit_ * kBackoff);
+      return;
+    }
+    if (short_rtt <= 0) return;
+    if (long_rtt_ == 0) {
+      long_rtt_ = short_rtt;
+    } else {
+      long_rtt_ += (short_rtt - long_rtt_) / kLongWindow;
+      // Once latency has recovered, let go of the slow past quickly.
+      if (long_rtt_ > 2 * short_rtt) long_rtt_ *= 0.95;
+    }
+    // Windows in which the limit was not being used say nothing about it.
+    if (max_in_flight < limit_ / 2) return;
+    const double gradient =
+        GPR_CLAMP(kTolerance * long_rtt_ / short_rtt, 0.5, 1.0);
+    const double estimate = limit_ * gradient + sqrt(limit_);
+    SetLimitLocked(limit_ * (1 - kSmoothing) + estimate * kSmoothing);
+  }
+
+  // Gives back the slot of a call that completed without a usable sample,
+  // such as one cancelled by the application.
+  void Release() {
+    MutexLock lock(&mu_);
+    --in_flight_;
+  }
+
+  uint32_t limit() {
+    MutexLock lock(&mu_);
+    return static_cast<uint32_t>(limit_);
+  }
+
+  uint32_t in_flight() {
+    MutexLock lock(&mu_);
+    return in_flight_;
+  }
+
+ private:
+  void SetLimitLocked(double limit) {
+    limit_ = GPR_CLAMP(limit, static_cast<double>(min_limit_),
+                       static_cast<double>(max_limit_));
+  }
+
+  const uint32_t min_limit_;
+  const uint32_t max_limit_;
+  Mutex mu_;
+  double limit_;
+  uint32_t in_flight_ = 0;
+  double long_rtt_ = 0;
+  // The samples of the current window.
+  uint32_t window_samples_ = 0;
+  uint32_t window_max_in_flight_ = 0;
+  bool window_overloaded_ = false;
+  double window_rtt_sum_ = 0;
+  uint32_t window_rtt_count_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_FILTERS_CONCURRENCY_LIMIT_CONCURRENCY_LIMITER_H */
@@ -18,6 +18,7 @@
 
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 
+#include <limits.h>
 #include <stdbool.h>
 #include <string.h>
 
@@ -26,12 +27,121 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/channel_init.h"
 
+//
+// DeadlineCoalescer
+//
+
+namespace grpc_core {
+
+struct DeadlineCoalescer::Bucket {
+  Bucket(RefCountedPtr<DeadlineCoalescer> coalescer, grpc_millis deadline)
+      : coalescer(std::move(coalescer)), deadline(deadline) {
+    GRPC_CLOSURE_INIT(&on_timer, OnBucketTimer, this,
+                      grpc_schedule_on_exec_ctx);
+  }
+
+  // Keeps the coalescer alive until the bucket's timer callback has run.
+  RefCountedPtr<DeadlineCoalescer> coalescer;
+  const grpc_millis deadline;
+  Entry* entries = nullptr;
+  grpc_timer timer;
+  grpc_closure on_timer;
+};
+
+RefCountedPtr<DeadlineCoalescer> DeadlineCoalescer::CreateFromChannelArgs(
+    const grpc_channel_args* args) {
+  const int slack = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args, GRPC_ARG_DEADLINE_COALESCING_SLACK_MS),
+      {0, 0, INT_MAX});
+  if (slack == 0) return nullptr;
+  return MakeRefCounted<DeadlineCoalescer>(slack);
+}
+
+// Rounds deadline up to the end of its bucket.
+grpc_millis DeadlineCoalescer::BucketDeadline(grpc_millis deadline) const {
+  if (deadline > GRPC_MILLIS_INF_FUTURE - slack_) return deadline;
+  grpc_millis rem = deadline % slack_;
+  if (rem == 0) return deadline;
+  return rem > 0 ? deadline + (slack_ - rem) : deadline - rem;
+}
+
+void DeadlineCoalescer::Add(Entry* entry, grpc_millis deadline,
+                            grpc_closure* closure) {
+  const grpc_millis bucket_deadline = BucketDeadline(deadline);
+  MutexLock lock(&mu_);
+  Bucket* bucket;
+  auto it = buckets_.find(bucket_deadline);
+  if (it != buckets_.end()) {
+    bucket = it->second;
+  } else {
+    bucket = New<Bucket>(Ref(), bucket_deadline);
+    buckets_.emplace(bucket_deadline, bucket);
+    // Armed under mu_ so that a concurrent Cancel() emptying the bucket never
+    // sees an uninitialized timer.
+    grpc_timer_init(&bucket->timer, bucket_deadline, &bucket->on_timer);
+  }
+  entry->closure = closure;
+  entry->bucket = bucket;
+  entry->prev = nullptr;
+  entry->next = bucket->entries;
+  if (entry->next != nullptr) entry->next->prev = entry;
+  bucket->entries = entry;
+}
+
+void DeadlineCoalescer::Cancel(Entry* entry) {
+  MutexLock lock(&mu_);
+  Bucket* bucket = entry->bucket;
+  if (bucket == nullptr) return;  // Already fired.
+  if (entry->prev != nullptr) {
+    entry->prev->next = entry->next;
+  } else {
+    bucket->entries = entry->next;
+  }
+  if (entry->next != nullptr) entry->next->prev = entry->prev;
+  entry->bucket = nullptr;
+  GRPC_CLOSURE_SCHED(entry->closure, GRPC_ERROR_CANCELLED);
+  if (bucket->entries == nullptr) {
+    // Nobody is waiting on the bucket any more: stop new calls from joining
+    // it and drop its timer.  OnBucketTimer() still runs and frees it.
+    buckets_.erase(bucket->deadline);
+    grpc_timer_cancel(&bucket->timer);
+  }
+}
+
+void DeadlineCoalescer::OnBucketTimer(void* arg, grpc_error* error) {
+  Bucket* bucket = static_cast<Bucket*>(arg);
+  DeadlineCoalescer* coalescer = bucket->coalescer.get();
+  Entry* entries;
+  {
+    MutexLock lock(&coalescer->mu_);
+    auto it = coalescer->buckets_.find(bucket->deadline);
+    if (it != coalescer->buckets_.end() && it->second == bucket) {
+      coalescer->buckets_.erase(it);
+    }
+    entries = bucket->entries;
+    for (Entry* entry = entries; entry != nullptr; entry = entry->next) {
+      entry->bucket = nullptr;
+    }
+  }
+  // A cancelled bucket timer has no entries left, so there is nothing to
+  // propagate the error to.
+  while (entries != nullptr) {
+    Entry* next = entries->next;
+    GRPC_CLOSURE_SCHED(entries->closure, GRPC_ERROR_NONE);
+    entries = next;
+  }
+  Delete(bucket);
+}
+
+}  // namespace grpc_core
+
 //
 // grpc_deadline_state
 //
@@ -65,9 +175,9 @@ static void timer_callback(void* arg, grpc_error* error) {
   grpc_deadline_state* deadline_state =
       static_cast<grpc_deadline_state*>(elem->call_data);
   if (error != GRPC_ERROR_CANCELLED) {
-    error = grpc_error_set_int(
+    error = GRPC_ERROR_IMMORTAL(grpc_error_set_int(
         GRPC_ERROR_CREATE_FROM_STATIC_STRING("Deadline Exceeded"),
-        GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_DEADLINE_EXCEEDED);
+        GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_DEADLINE_EXCEEDED));
     deadline_state->call_combiner->Cancel(GRPC_ERROR_REF(error));
     GRPC_CLOSURE_INIT(&deadline_state->timer_callback,
                       send_cancel_op_in_call_combiner, elem,
@@ -112,7 +222,12 @@ static void start_timer_if_needed(grpc_call_element* elem,
   }
   GPR_ASSERT(closure != nullptr);
   GRPC_CALL_STACK_REF(deadline_state->call_stack, "deadline_timer");
-  grpc_timer_init(&deadline_state->timer, deadline, closure);
+  if (deadline_state->coalescer != nullptr) {
+    deadline_state->coalescer->Add(&deadline_state->coalescer_entry, deadline,
+                                   closure);
+  } else {
+    grpc_timer_init(&deadline_state->timer, deadline, closure);
+  }
 }
 
 // Cancels the deadline timer.
@@ -121,7 +236,11 @@ static void start_timer_if_needed(grpc_call_element* elem,
 static void cancel_timer_if_needed(grpc_deadline_state* deadline_state) {
   if (deadline_state->timer_state == GRPC_DEADLINE_STATE_PENDING) {
     deadline_state->timer_state = GRPC_DEADLINE_STATE_FINISHED;
-    grpc_timer_cancel(&deadline_state->timer);
+    if (deadline_state->coalescer != nullptr) {
+      deadline_state->coalescer->Cancel(&deadline_state->coalescer_entry);
+    } else {
+      grpc_timer_cancel(&deadline_state->timer);
+    }
   } else {
     // timer was either in STATE_INITIAL (nothing to cancel)
     // OR in STATE_FINISHED (again nothing to cancel)
@@ -180,11 +299,13 @@ static void start_timer_after_init(void* arg, grpc_error* error) {
                           "done scheduling deadline timer");
 }
 
-grpc_deadline_state::grpc_deadline_state(grpc_call_element* elem,
-                                         grpc_call_stack* call_stack,
-                                         grpc_core::CallCombiner* call_combiner,
-                                         grpc_millis deadline)
-    : call_stack(call_stack), call_combiner(call_combiner) {
+grpc_deadline_state::grpc_deadline_state(
+    grpc_call_element* elem, grpc_call_stack* call_stack,
+    grpc_core::CallCombiner* call_combiner, grpc_millis deadline,
+    grpc_core::DeadlineCoalescer* coalescer)
+    : call_stack(call_stack),
+      call_combiner(call_combiner),
+      coalescer(coalescer) {
   // Deadline will always be infinite on servers, so the timer will only be
   // set on clients with a finite deadline.
   if (deadline != GRPC_MILLIS_INF_FUTURE) {
@@ -232,15 +353,26 @@ void grpc_deadline_state_client_start_transport_stream_op_batch(
 // filter code
 //
 
+// Channel data used for both client and server filters.
+struct channel_data {
+  // Set if GRPC_ARG_DEADLINE_COALESCING_SLACK_MS is.
+  grpc_core::RefCountedPtr<grpc_core::DeadlineCoalescer> coalescer;
+};
+
 // Constructor for channel_data.  Used for both client and server filters.
 static grpc_error* init_channel_elem(grpc_channel_element* elem,
                                      grpc_channel_element_args* args) {
   GPR_ASSERT(!args->is_last);
+  channel_data* chand = new (elem->channel_data) channel_data();
+  chand->coalescer =
+      grpc_core::DeadlineCoalescer::CreateFromChannelArgs(args->channel_args);
   return GRPC_ERROR_NONE;
 }
 
 // Destructor for channel_data.  Used for both client and server filters.
-static void destroy_channel_elem(grpc_channel_element* elem) {}
+static void destroy_channel_elem(grpc_channel_element* elem) {
+  static_cast<channel_data*>(elem->channel_data)->~channel_data();
+}
 
 // Call data used for both client and server filter.
 typedef struct base_call_data {
@@ -262,8 +394,10 @@ typedef struct server_call_data {
 // Constructor for call_data.  Used for both client and server filters.
 static grpc_error* init_call_elem(grpc_call_element* elem,
                                   const grpc_call_element_args* args) {
-  new (elem->call_data) grpc_deadline_state(
-      elem, args->call_stack, args->call_combiner, args->deadline);
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  new (elem->call_data)
+      grpc_deadline_state(elem, args->call_stack, args->call_combiner,
+                          args->deadline, chand->coalescer.get());
   return GRPC_ERROR_NONE;
 }
 
@@ -335,11 +469,12 @@ const grpc_channel_filter grpc_client_deadline_filter = {
     init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     init_channel_elem,
     destroy_channel_elem,
     grpc_channel_next_get_info,
     "deadline",
+    GRPC_FILTER_BATCH_RECV_TRAILING_METADATA | GRPC_FILTER_BATCH_CANCEL_STREAM,
 };
 
 const grpc_channel_filter grpc_server_deadline_filter = {
@@ -349,11 +484,14 @@ const grpc_channel_filter grpc_server_deadline_filter = {
     init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     init_channel_elem,
     destroy_channel_elem,
     grpc_channel_next_get_info,
     "deadline",
+    GRPC_FILTER_BATCH_RECV_INITIAL_METADATA |
+        GRPC_FILTER_BATCH_RECV_TRAILING_METADATA |
+        GRPC_FILTER_BATCH_CANCEL_STREAM,
 };
 
 bool grpc_deadline_checking_enabled(const grpc_channel_args* channel_args) {
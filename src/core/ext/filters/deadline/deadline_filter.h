@@ -20,8 +20,54 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/timer.h"
 
+namespace grpc_core {
+
+// Groups the deadlines of a channel's calls into buckets of a fixed width
+// (the slack, from GRPC_ARG_DEADLINE_COALESCING_SLACK_MS) and arms a single
+// timer per bucket rather than one per call.  A call's deadline fires when its
+// bucket's does: never early, and at most slack late.
+class DeadlineCoalescer : public RefCounted<DeadlineCoalescer> {
+ public:
+  struct Bucket;
+
+  // A call's registration with the coalescer, used in place of a grpc_timer.
+  struct Entry {
+    Entry* next;
+    Entry* prev;
+    Bucket* bucket;  // nullptr once fired or cancelled.
+    grpc_closure* closure;
+  };
+
+  // Returns the channel's coalescer, or nullptr if coalescing is disabled.
+  static RefCountedPtr<DeadlineCoalescer> CreateFromChannelArgs(
+      const grpc_channel_args* args);
+
+  explicit DeadlineCoalescer(grpc_millis slack) : slack_(slack) {}
+
+  // Same contract as grpc_timer_init() / grpc_timer_cancel(): closure is run
+  // exactly once, with GRPC_ERROR_NONE when the deadline's bucket expires or
+  // with GRPC_ERROR_CANCELLED if Cancel() gets to it first.
+  void Add(Entry* entry, grpc_millis deadline, grpc_closure* closure);
+  void Cancel(Entry* entry);
+
+ private:
+  static void OnBucketTimer(void* arg, grpc_error* error);
+
+  grpc_millis BucketDeadline(grpc_millis deadline) const;
+
+  const grpc_millis slack_;
+  Mutex mu_;
+  Map<grpc_millis, Bucket*> buckets_;
+};
+
+}  // namespace grpc_core
+
 enum grpc_deadline_timer_state {
   GRPC_DEADLINE_STATE_INITIAL,
   GRPC_DEADLINE_STATE_PENDING,
@@ -31,16 +77,23 @@ enum grpc_deadline_timer_state {
 // State used for filters that enforce call deadlines.
 // Must be the first field in the filter's call_data.
 struct grpc_deadline_state {
+  // If coalescer is non-null, the deadline is tracked by it instead of by a
+  // timer of our own; it must outlive the call.
   grpc_deadline_state(grpc_call_element* elem, grpc_call_stack* call_stack,
                       grpc_core::CallCombiner* call_combiner,
-                      grpc_millis deadline);
+                      grpc_millis deadline,
+                      grpc_core::DeadlineCoalescer* coalescer = nullptr);
   ~grpc_deadline_state();
 
   // We take a reference to the call stack for the timer callback.
   grpc_call_stack* call_stack;
   grpc_core::CallCombiner* call_combiner;
+  grpc_core::DeadlineCoalescer* coalescer;
   grpc_deadline_timer_state timer_state = GRPC_DEADLINE_STATE_INITIAL;
-  grpc_timer timer;
+  union {
+    grpc_timer timer;
+    grpc_core::DeadlineCoalescer::Entry coalescer_entry;
+  };
   grpc_closure timer_callback;
   // Closure to invoke when we receive trailing metadata.
   // We use this to cancel the timer.
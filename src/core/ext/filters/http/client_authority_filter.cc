@@ -128,7 +128,8 @@ const grpc_channel_filter grpc_client_authority_filter = {
     init_channel_elem,
     destroy_channel_elem,
     grpc_channel_next_get_info,
-    "authority"};
+    "authority",
+    GRPC_FILTER_BATCH_SEND_INITIAL_METADATA};
 
 static bool add_client_authority_filter(grpc_channel_stack_builder* builder,
                                         void* arg) {
@@ -0,0 +1,83 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_FILTERS_HTTP_MESSAGE_COMPRESS_COMPRESSION_RATIO_TRACKER_H
+#define GRPC_CORE_EXT_FILTERS_HTTP_MESSAGE_COMPRESS_COMPRESSION_RATIO_TRACKER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Decides which messages of a method are worth compressing, from how well its
+// recent messages compressed. While the moving average of the compressed to
+// uncompressed size ratio stays above max_ratio, only one message in
+// kProbeInterval is compressed, to notice when the payloads change.
+class CompressionRatioTracker {
+ public:
+  // While compression is off, one message in this many is still compressed.
+  static constexpr uint32_t kProbeInterval = 16;
+  // The weight of each message's ratio in the moving average.
+  static constexpr double kWeight = 0.25;
+
+  explicit CompressionRatioTracker(double max_ratio) : max_ratio_(max_ratio) {}
+
+  // Returns whether the next message should be compressed.
+  bool ShouldCompress() {
+    MutexLock lock(&mu_);
+    if (!disabled_) return true;
+    if (++skipped_ < kProbeInterval) return false;
+    skipped_ = 0;
+    return true;
+  }
+
+  // Records that a message of uncompressed_size bytes compressed to
+  // compressed_size bytes; its own size if compressing did not make it any
+  // smaller.
+  void Record(size_t uncompressed_size, size_t compressed_size) {
+    if (uncompressed_size == 0) return;
+    const double ratio = static_cast<double>(compressed_size) /
+                         static_cast<double>(uncompressed_size);
+    MutexLock lock(&mu_);
+    ratio_ = ratio_ < 0 ? ratio : ratio_ + (ratio - ratio_) * kWeight;
+    disabled_ = ratio_ > max_ratio_;
+  }
+
+  bool disabled() {
+    MutexLock lock(&mu_);
+    return disabled_;
+  }
+
+ private:
+  const double max_ratio_;
+  Mutex mu_;
+  // The moving average, or -1 before the first message.
+  double ratio_ = -1;
+  bool disabled_ = false;
+  // The messages not compressed since compression was last tried.
+  uint32_t skipped_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_FILTERS_HTTP_MESSAGE_COMPRESS_COMPRESSION_RATIO_TRACKER_H \
+        */
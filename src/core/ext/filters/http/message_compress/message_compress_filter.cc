@@ -19,13 +19,16 @@
 #include <grpc/support/port_platform.h>
 
 #include <assert.h>
+#include <limits.h>
 #include <string.h>
 
 #include <grpc/compression.h>
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 
+#include "src/core/ext/filters/http/message_compress/compression_ratio_tracker.h"
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/compression/algorithm_metadata.h"
@@ -34,6 +37,8 @@
 #include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -43,9 +48,19 @@
 static void start_send_message_batch(void* arg, grpc_error* unused);
 static void send_message_on_complete(void* arg, grpc_error* error);
 static void on_send_message_next_done(void* arg, grpc_error* error);
+static void on_recv_initial_metadata_ready(void* arg, grpc_error* error);
 
 namespace {
 
+/* The most methods whose compression ratios a channel tracks */
+constexpr size_t kMaxRatioTrackedMethods = 256;
+
+struct SliceLess {
+  bool operator()(const grpc_slice& a, const grpc_slice& b) const {
+    return grpc_slice_cmp(a, b) < 0;
+  }
+};
+
 struct channel_data {
   /** The default, channel-level, compression algorithm */
   grpc_compression_algorithm default_compression_algorithm;
@@ -55,11 +70,34 @@ struct channel_data {
   uint32_t enabled_message_compression_algorithms_bitset;
   /** Bitset of enabled stream compression algorithms */
   uint32_t enabled_stream_compression_algorithms_bitset;
+  /** The zlib level messages are compressed with */
+  int zlib_level;
+  /** Messages smaller than this are sent uncompressed */
+  size_t min_message_size;
+  /** If positive, the compressed to uncompressed size ratio above which a
+      method's messages stop being compressed */
+  double adaptive_max_ratio;
+  /** Whether deflate calls keep one compression context for all their
+      messages (GRPC_COMPRESSION_CHANNEL_PERSISTENT_DICTIONARY). If so, the
+      grpc-encoding they are sent with, and the grpc-accept-encoding listing
+      it that all calls send; otherwise both are null */
+  bool persistent_dictionary;
+  grpc_mdelem persistent_encoding = GRPC_MDNULL;
+  grpc_mdelem persistent_accept_encoding = GRPC_MDNULL;
+  /** The ratio trackers of the methods seen so far, keyed by path (a ref is
+      held on each key) */
+  grpc_core::Mutex mu;
+  grpc_core::Map<grpc_slice,
+                 grpc_core::UniquePtr<grpc_core::CompressionRatioTracker>,
+                 SliceLess>
+      ratio_trackers;
 };
 
 struct call_data {
   call_data(grpc_call_element* elem, const grpc_call_element_args& args)
-      : call_combiner(args.call_combiner) {
+      : call_combiner(args.call_combiner),
+        path(args.path),
+        is_server(args.server_transport_data != nullptr) {
     channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
     // The call's message compression algorithm is set to channel's default
     // setting. It can be overridden later by initial metadata.
@@ -72,18 +110,39 @@ struct call_data {
     GRPC_CLOSURE_INIT(&start_send_message_batch_in_call_combiner,
                       start_send_message_batch, elem,
                       grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&recv_initial_metadata_ready,
+                      on_recv_initial_metadata_ready, elem,
+                      grpc_schedule_on_exec_ctx);
   }
 
   ~call_data() {
     if (state_initialized) {
       grpc_slice_buffer_destroy_internal(&slices);
     }
+    if (persistent_compressor != nullptr) {
+      grpc_msg_persistent_compressor_destroy(persistent_compressor);
+    }
     GRPC_ERROR_UNREF(cancel_error);
   }
 
   grpc_core::CallCombiner* call_combiner;
+  grpc_slice path;
+  bool is_server;
   grpc_message_compression_algorithm message_compression_algorithm =
       GRPC_MESSAGE_COMPRESS_NONE;
+  /* The tracker of the call's method, if looked up and tracked */
+  bool ratio_tracker_looked_up = false;
+  grpc_core::CompressionRatioTracker* ratio_tracker = nullptr;
+  /* On servers, whether the client listed the persistent deflate encoding in
+     its grpc-accept-encoding */
+  bool peer_accepts_persistent_dictionary = false;
+  grpc_metadata_batch* recv_initial_metadata = nullptr;
+  grpc_closure recv_initial_metadata_ready;
+  grpc_closure* original_recv_initial_metadata_ready = nullptr;
+  /* Whether the call's messages are deflated with persistent_compressor,
+     which is created with its first compressed message */
+  bool use_persistent_dictionary = false;
+  grpc_msg_persistent_compressor* persistent_compressor = nullptr;
   grpc_error* cancel_error = GRPC_ERROR_NONE;
   grpc_transport_stream_op_batch* send_message_batch = nullptr;
   bool seen_initial_metadata = false;
@@ -107,9 +166,33 @@ struct call_data {
 
 }  // namespace
 
+// Returns the compression ratio tracker of the call's method, adding one if
+// this is the first call to it, or null if too many methods are tracked.
+static grpc_core::CompressionRatioTracker* get_ratio_tracker(
+    grpc_call_element* elem) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
+  if (!calld->ratio_tracker_looked_up) {
+    calld->ratio_tracker_looked_up = true;
+    grpc_core::MutexLock lock(&channeld->mu);
+    auto it = channeld->ratio_trackers.find(calld->path);
+    if (it != channeld->ratio_trackers.end()) {
+      calld->ratio_tracker = it->second.get();
+    } else if (channeld->ratio_trackers.size() < kMaxRatioTrackedMethods) {
+      auto tracker = grpc_core::MakeUnique<grpc_core::CompressionRatioTracker>(
+          channeld->adaptive_max_ratio);
+      calld->ratio_tracker = tracker.get();
+      channeld->ratio_trackers.emplace(grpc_slice_ref_internal(calld->path),
+                                       std::move(tracker));
+    }
+  }
+  return calld->ratio_tracker;
+}
+
 // Returns true if we should skip message compression for the current message.
 static bool skip_message_compression(grpc_call_element* elem) {
   call_data* calld = static_cast<call_data*>(elem->call_data);
+  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
   // If the flags of this message indicate that it shouldn't be compressed, we
   // skip message compression.
   uint32_t flags =
@@ -119,7 +202,20 @@ static bool skip_message_compression(grpc_call_element* elem) {
   }
   // If this call doesn't have any message compression algorithm set, skip
   // message compression.
-  return calld->message_compression_algorithm == GRPC_MESSAGE_COMPRESS_NONE;
+  if (calld->message_compression_algorithm == GRPC_MESSAGE_COMPRESS_NONE) {
+    return true;
+  }
+  // Small messages are not worth the CPU.
+  if (calld->send_message_batch->payload->send_message.send_message->length() <
+      channeld->min_message_size) {
+    return true;
+  }
+  // Nor are the messages of methods that recently compressed poorly.
+  if (channeld->adaptive_max_ratio > 0) {
+    grpc_core::CompressionRatioTracker* tracker = get_ratio_tracker(elem);
+    if (tracker != nullptr && !tracker->ShouldCompress()) return true;
+  }
+  return false;
 }
 
 // Determines the compression algorithm from the initial metadata and the
@@ -189,12 +285,20 @@ static grpc_error* process_send_initial_metadata(
           compression_algorithm);
   // Hint compression algorithm.
   grpc_error* error = GRPC_ERROR_NONE;
+  // Clients can only assume the server supports a persistent dictionary, but
+  // servers know whether the client does.
+  calld->use_persistent_dictionary =
+      !GRPC_MDISNULL(channeld->persistent_encoding) &&
+      calld->message_compression_algorithm == GRPC_MESSAGE_COMPRESS_DEFLATE &&
+      (!calld->is_server || calld->peer_accepts_persistent_dictionary);
   if (calld->message_compression_algorithm != GRPC_MESSAGE_COMPRESS_NONE) {
     initialize_state(elem, calld);
     error = grpc_metadata_batch_add_tail(
         initial_metadata, &calld->message_compression_algorithm_storage,
-        grpc_message_compression_encoding_mdelem(
-            calld->message_compression_algorithm),
+        calld->use_persistent_dictionary
+            ? GRPC_MDELEM_REF(channeld->persistent_encoding)
+            : grpc_message_compression_encoding_mdelem(
+                  calld->message_compression_algorithm),
         GRPC_BATCH_GRPC_ENCODING);
   } else if (stream_compression_algorithm != GRPC_STREAM_COMPRESS_NONE) {
     initialize_state(elem, calld);
@@ -207,8 +311,10 @@ static grpc_error* process_send_initial_metadata(
   // Convey supported compression algorithms.
   error = grpc_metadata_batch_add_tail(
       initial_metadata, &calld->accept_encoding_storage,
-      GRPC_MDELEM_ACCEPT_ENCODING_FOR_ALGORITHMS(
-          channeld->enabled_message_compression_algorithms_bitset),
+      GRPC_MDISNULL(channeld->persistent_accept_encoding)
+          ? GRPC_MDELEM_ACCEPT_ENCODING_FOR_ALGORITHMS(
+                channeld->enabled_message_compression_algorithms_bitset)
+          : GRPC_MDELEM_REF(channeld->persistent_accept_encoding),
       GRPC_BATCH_GRPC_ACCEPT_ENCODING);
   if (error != GRPC_ERROR_NONE) return error;
   // Do not overwrite accept-encoding header if it already presents (e.g., added
@@ -244,6 +350,7 @@ static void send_message_batch_continue(grpc_call_element* elem) {
 
 static void finish_send_message(grpc_call_element* elem) {
   call_data* calld = static_cast<call_data*>(elem->call_data);
+  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
   GPR_DEBUG_ASSERT(calld->message_compression_algorithm !=
                    GRPC_MESSAGE_COMPRESS_NONE);
   // Compress the data if appropriate.
@@ -251,8 +358,23 @@ static void finish_send_message(grpc_call_element* elem) {
   grpc_slice_buffer_init(&tmp);
   uint32_t send_flags =
       calld->send_message_batch->payload->send_message.send_message->flags();
-  bool did_compress = grpc_msg_compress(calld->message_compression_algorithm,
-                                        &calld->slices, &tmp);
+  bool did_compress;
+  if (calld->use_persistent_dictionary) {
+    if (calld->persistent_compressor == nullptr) {
+      calld->persistent_compressor =
+          grpc_msg_persistent_compressor_create(channeld->zlib_level);
+    }
+    did_compress = grpc_msg_persistent_compress(calld->persistent_compressor,
+                                                &calld->slices, &tmp);
+  } else {
+    did_compress = grpc_msg_compress_with_level(
+        calld->message_compression_algorithm, channeld->zlib_level,
+        &calld->slices, &tmp);
+  }
+  if (calld->ratio_tracker != nullptr) {
+    calld->ratio_tracker->Record(
+        calld->slices.length, did_compress ? tmp.length : calld->slices.length);
+  }
   if (did_compress) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
       const char* algo_name;
@@ -370,6 +492,22 @@ static void start_send_message_batch(void* arg, grpc_error* unused) {
   }
 }
 
+// Notes whether the client accepts the persistent deflate encoding.
+static void on_recv_initial_metadata_ready(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  if (error == GRPC_ERROR_NONE) {
+    grpc_linked_mdelem* accept_encoding =
+        calld->recv_initial_metadata->idx.named.grpc_accept_encoding;
+    calld->peer_accepts_persistent_dictionary =
+        accept_encoding != nullptr &&
+        grpc_message_compression_accepts_deflate_persistent(
+            GRPC_MDVALUE(accept_encoding->md));
+  }
+  GRPC_CLOSURE_RUN(calld->original_recv_initial_metadata_ready,
+                   GRPC_ERROR_REF(error));
+}
+
 static void compress_start_transport_stream_op_batch(
     grpc_call_element* elem, grpc_transport_stream_op_batch* batch) {
   GPR_TIMER_SCOPE("compress_start_transport_stream_op_batch", 0);
@@ -396,6 +534,18 @@ static void compress_start_transport_stream_op_batch(
         batch, GRPC_ERROR_REF(calld->cancel_error), calld->call_combiner);
     return;
   }
+  // Servers look for the persistent deflate encoding in the client's
+  // grpc-accept-encoding before sending their own initial metadata.
+  if (batch->recv_initial_metadata && calld->is_server &&
+      !GRPC_MDISNULL(
+          static_cast<channel_data*>(elem->channel_data)->persistent_encoding)) {
+    calld->recv_initial_metadata =
+        batch->payload->recv_initial_metadata.recv_initial_metadata;
+    calld->original_recv_initial_metadata_ready =
+        batch->payload->recv_initial_metadata.recv_initial_metadata_ready;
+    batch->payload->recv_initial_metadata.recv_initial_metadata_ready =
+        &calld->recv_initial_metadata_ready;
+  }
   // Handle send_initial_metadata.
   if (batch->send_initial_metadata) {
     GPR_ASSERT(!calld->seen_initial_metadata);
@@ -458,7 +608,7 @@ static void destroy_call_elem(grpc_call_element* elem,
 /* Constructor for channel_data */
 static grpc_error* init_channel_elem(grpc_channel_element* elem,
                                      grpc_channel_element_args* args) {
-  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
+  channel_data* channeld = new (elem->channel_data) channel_data();
   // Get the enabled and the default algorithms from channel args.
   channeld->enabled_compression_algorithms_bitset =
       grpc_channel_args_compression_algorithm_get_states(args->channel_args);
@@ -482,12 +632,59 @@ static grpc_error* init_channel_elem(grpc_channel_element* elem,
   channeld->enabled_stream_compression_algorithms_bitset =
       grpc_compression_bitset_to_stream_bitset(
           channeld->enabled_compression_algorithms_bitset);
+  channeld->zlib_level = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args->channel_args,
+                             GRPC_COMPRESSION_CHANNEL_ZLIB_LEVEL),
+      {GRPC_MSG_COMPRESS_DEFAULT_LEVEL, 1, 9});
+  channeld->min_message_size = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args->channel_args,
+                             GRPC_COMPRESSION_CHANNEL_MIN_MESSAGE_SIZE),
+      {0, 0, INT_MAX});
+  const int min_savings_percent = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(
+          args->channel_args,
+          GRPC_COMPRESSION_CHANNEL_ADAPTIVE_MIN_SAVINGS_PERCENT),
+      {0, 0, 99});
+  channeld->adaptive_max_ratio =
+      min_savings_percent > 0 ? 1 - min_savings_percent / 100.0 : 0;
+  channeld->persistent_dictionary = grpc_channel_arg_get_bool(
+      grpc_channel_args_find(args->channel_args,
+                             GRPC_COMPRESSION_CHANNEL_PERSISTENT_DICTIONARY),
+      false);
+  if (channeld->persistent_dictionary &&
+      GPR_BITGET(channeld->enabled_message_compression_algorithms_bitset,
+                 GRPC_MESSAGE_COMPRESS_DEFLATE)) {
+    channeld->persistent_encoding = grpc_mdelem_from_slices(
+        GRPC_MDSTR_GRPC_ENCODING,
+        grpc_slice_intern(grpc_slice_from_static_string(
+            GRPC_MESSAGE_COMPRESS_DEFLATE_PERSISTENT_NAME)));
+    char* accept_encoding = grpc_slice_to_c_string(
+        GRPC_MDVALUE(GRPC_MDELEM_ACCEPT_ENCODING_FOR_ALGORITHMS(
+            channeld->enabled_message_compression_algorithms_bitset)));
+    char* persistent_accept_encoding;
+    gpr_asprintf(&persistent_accept_encoding, "%s,%s", accept_encoding,
+                 GRPC_MESSAGE_COMPRESS_DEFLATE_PERSISTENT_NAME);
+    channeld->persistent_accept_encoding = grpc_mdelem_from_slices(
+        GRPC_MDSTR_GRPC_ACCEPT_ENCODING,
+        grpc_slice_intern(
+            grpc_slice_from_static_string(persistent_accept_encoding)));
+    gpr_free(persistent_accept_encoding);
+    gpr_free(accept_encoding);
+  }
   GPR_ASSERT(!args->is_last);
   return GRPC_ERROR_NONE;
 }
 
 /* Destructor for channel data */
-static void destroy_channel_elem(grpc_channel_element* elem) {}
+static void destroy_channel_elem(grpc_channel_element* elem) {
+  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
+  for (auto& p : channeld->ratio_trackers) {
+    grpc_slice_unref_internal(p.first);
+  }
+  GRPC_MDELEM_UNREF(channeld->persistent_encoding);
+  GRPC_MDELEM_UNREF(channeld->persistent_accept_encoding);
+  channeld->~channel_data();
+}
 
 const grpc_channel_filter grpc_message_compress_filter = {
     compress_start_transport_stream_op_batch,
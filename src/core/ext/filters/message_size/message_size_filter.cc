@@ -258,15 +258,18 @@ static void start_transport_stream_op_batch(
     gpr_free(message_string);
     return;
   }
+  // Without a receive limit there is nothing to check, and hence no error for
+  // recv_trailing_metadata to wait for.
+  const bool check_recv = calld->limits.max_recv_size >= 0;
   // Inject callback for receiving a message.
-  if (op->recv_message) {
+  if (op->recv_message && check_recv) {
     calld->next_recv_message_ready =
         op->payload->recv_message.recv_message_ready;
     calld->recv_message = op->payload->recv_message.recv_message;
     op->payload->recv_message.recv_message_ready = &calld->recv_message_ready;
   }
   // Inject callback for receiving trailing metadata.
-  if (op->recv_trailing_metadata) {
+  if (op->recv_trailing_metadata && check_recv) {
     calld->original_recv_trailing_metadata_ready =
         op->payload->recv_trailing_metadata.recv_trailing_metadata_ready;
     op->payload->recv_trailing_metadata.recv_trailing_metadata_ready =
@@ -371,7 +374,9 @@ const grpc_channel_filter grpc_message_size_filter = {
     init_channel_elem,
     destroy_channel_elem,
     grpc_channel_next_get_info,
-    "message_size"};
+    "message_size",
+    GRPC_FILTER_BATCH_SEND_MESSAGE | GRPC_FILTER_BATCH_RECV_MESSAGE |
+        GRPC_FILTER_BATCH_RECV_TRAILING_METADATA};
 
 // Used for GRPC_CLIENT_SUBCHANNEL
 static bool maybe_add_message_size_filter_subchannel(
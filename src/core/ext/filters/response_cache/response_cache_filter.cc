@@ -0,0 +1,674 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <limits.h>
+#include <string.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/channel/unary_batch.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/wyhash.h"
+#include "src/core/lib/gprpp/inlined_vector.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/transport/byte_stream.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/static_metadata.h"
+#include "src/core/lib/transport/status_metadata.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_trace_response_cache(false, "response_cache");
+
+#define GRPC_RESPONSE_CACHE_LOG(format, ...)                          \
+  do {                                                                \
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_response_cache)) {         \
+      gpr_log(GPR_INFO, "(response cache) " format, ##__VA_ARGS__); \
+    }                                                                 \
+  } while (0)
+
+namespace {
+
+/*
+  A unary call whose whole batch arrives at once, with
+  GRPC_INITIAL_METADATA_CACHEABLE_REQUEST set, is keyed by its :path,
+  :authority, message flags and request bytes. On a hit the filter completes
+  the batch itself from the cached Entry; nothing below it sees the call
+  except a cancel_stream that releases the lower filters' per-call state.
+
+  On a miss the batch goes down as usual and the filter copies the initial
+  metadata, response message and trailing metadata as they come back. If the
+  call ends with status OK and the server sent "cache-control: max-age=N"
+  (and not no-store, no-cache or private) in either metadata batch, the copy
+  is cached for N seconds. Entries are kept in LRU order and evicted from the
+  tail when the cache would exceed its size.
+
+  The key does not identify the caller, so calls that carry credentials
+  (authorization or cookie metadata, or per-call credentials) bypass the
+  cache entirely: they are neither served from it nor used to fill it.
+*/
+
+struct CacheKey {
+  uint32_t hash;
+  grpc_slice signature;
+};
+
+struct CacheKeyLess {
+  bool operator()(const CacheKey& a, const CacheKey& b) const {
+    if (a.hash != b.hash) return a.hash < b.hash;
+    const size_t a_len = GRPC_SLICE_LENGTH(a.signature);
+    const size_t b_len = GRPC_SLICE_LENGTH(b.signature);
+    if (a_len != b_len) return a_len < b_len;
+    return memcmp(GRPC_SLICE_START_PTR(a.signature),
+                  GRPC_SLICE_START_PTR(b.signature), a_len) < 0;
+  }
+};
+
+struct Entry : public RefCounted<Entry> {
+  // Takes ownership of signature.
+  Entry(uint32_t hash, grpc_slice signature) : key{hash, signature} {}
+
+  ~Entry() { grpc_slice_unref_internal(key.signature); }
+
+  // Bytes charged against the cache size.
+  size_t Size() const {
+    size_t size = sizeof(*this) + GRPC_SLICE_LENGTH(key.signature) +
+                  response.message.length;
+    for (size_t i = 0; i < response.initial_metadata.size(); i++) {
+      size += GRPC_SLICE_LENGTH(GRPC_MDKEY(response.initial_metadata[i])) +
+              GRPC_SLICE_LENGTH(GRPC_MDVALUE(response.initial_metadata[i]));
+    }
+    for (size_t i = 0; i < response.trailing_metadata.size(); i++) {
+      size += GRPC_SLICE_LENGTH(GRPC_MDKEY(response.trailing_metadata[i])) +
+              GRPC_SLICE_LENGTH(GRPC_MDVALUE(response.trailing_metadata[i]));
+    }
+    return size;
+  }
+
+  const CacheKey key;
+  // The response. Written only by the call that fetched it, before the entry
+  // is inserted; immutable afterwards.
+  UnaryResponse response;
+  grpc_millis expires_at = GRPC_MILLIS_INF_PAST;
+  size_t size = 0;
+  // LRU list links, most recently used first. Guarded by the channel's mu_.
+  Entry* prev = nullptr;
+  Entry* next = nullptr;
+};
+
+class ChannelData {
+ public:
+  static grpc_error* Init(grpc_channel_element* elem,
+                          grpc_channel_element_args* args);
+  static void Destroy(grpc_channel_element* elem);
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  // Returns the unexpired entry for key, if any, marking it most recently
+  // used.
+  RefCountedPtr<Entry> Lookup(const CacheKey& key);
+  // Adds entry, replacing any entry with the same key and evicting least
+  // recently used entries to make room.
+  void Insert(RefCountedPtr<Entry> entry);
+
+ private:
+  explicit ChannelData(size_t max_bytes) : max_bytes_(max_bytes) {}
+  ~ChannelData();
+
+  void RemoveLocked(Entry* entry);
+  void PushFrontLocked(Entry* entry);
+  void UnlinkLocked(Entry* entry);
+
+  const size_t max_bytes_;
+  Mutex mu_;
+  size_t bytes_ = 0;
+  // Each entry here holds one ref.
+  Map<CacheKey, Entry*, CacheKeyLess> entries_;
+  Entry* lru_head_ = nullptr;
+  Entry* lru_tail_ = nullptr;
+};
+
+grpc_error* ChannelData::Init(grpc_channel_element* elem,
+                              grpc_channel_element_args* args) {
+  GPR_ASSERT(!args->is_last);
+  const int max_bytes = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args->channel_args,
+                             GRPC_ARG_UNARY_RESPONSE_CACHE_SIZE),
+      {0, 0, INT_MAX});
+  new (elem->channel_data) ChannelData(static_cast<size_t>(max_bytes));
+  return GRPC_ERROR_NONE;
+}
+
+void ChannelData::Destroy(grpc_channel_element* elem) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  chand->~ChannelData();
+}
+
+ChannelData::~ChannelData() {
+  while (lru_head_ != nullptr) RemoveLocked(lru_head_);
+}
+
+RefCountedPtr<Entry> ChannelData::Lookup(const CacheKey& key) {
+  MutexLock lock(&mu_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return nullptr;
+  Entry* entry = it->second;
+  if (entry->expires_at <= ExecCtx::Get()->Now()) {
+    RemoveLocked(entry);
+    return nullptr;
+  }
+  if (entry != lru_head_) {
+    UnlinkLocked(entry);
+    PushFrontLocked(entry);
+  }
+  return entry->Ref();
+}
+
+void ChannelData::Insert(RefCountedPtr<Entry> entry) {
+  entry->size = entry->Size();
+  if (entry->size > max_bytes_) return;
+  MutexLock lock(&mu_);
+  auto it = entries_.find(entry->key);
+  if (it != entries_.end()) RemoveLocked(it->second);
+  while (bytes_ + entry->size > max_bytes_) RemoveLocked(lru_tail_);
+  bytes_ += entry->size;
+  Entry* e = entry.release();
+  entries_.emplace(e->key, e);
+  PushFrontLocked(e);
+}
+
+void ChannelData::RemoveLocked(Entry* entry) {
+  entries_.erase(entry->key);
+  UnlinkLocked(entry);
+  bytes_ -= entry->size;
+  entry->Unref();
+}
+
+void ChannelData::PushFrontLocked(Entry* entry) {
+  entry->prev = nullptr;
+  entry->next = lru_head_;
+  if (lru_head_ != nullptr) lru_head_->prev = entry;
+  lru_head_ = entry;
+  if (lru_tail_ == nullptr) lru_tail_ = entry;
+}
+
+void ChannelData::UnlinkLocked(Entry* entry) {
+  if (entry->prev != nullptr) {
+    entry->prev->next = entry->next;
+  } else {
+    lru_head_ = entry->next;
+  }
+  if (entry->next != nullptr) {
+    entry->next->prev = entry->prev;
+  } else {
+    lru_tail_ = entry->prev;
+  }
+  entry->prev = nullptr;
+  entry->next = nullptr;
+}
+
+// Returns the max-age, in milliseconds, allowed by a cache-control value, or
+// 0 if the response must not be cached.
+grpc_millis ParseMaxAge(const grpc_slice& value) {
+  static const char kMaxAge[] = "max-age=";
+  const size_t kMaxAgeLength = sizeof(kMaxAge) - 1;
+  const char* p = reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(value));
+  const char* end = reinterpret_cast<const char*>(GRPC_SLICE_END_PTR(value));
+  grpc_millis max_age = 0;
+  while (p < end) {
+    while (p < end && (*p == ' ' || *p == ',')) p++;
+    const char* directive = p;
+    while (p < end && *p != ',' && *p != ' ') p++;
+    const size_t length = static_cast<size_t>(p - directive);
+    if ((length == 8 && memcmp(directive, "no-store", 8) == 0) ||
+        (length == 8 && memcmp(directive, "no-cache", 8) == 0) ||
+        (length == 7 && memcmp(directive, "private", 7) == 0)) {
+      return 0;
+    }
+    uint32_t seconds;
+    if (length > kMaxAgeLength &&
+        memcmp(directive, kMaxAge, kMaxAgeLength) == 0 &&
+        gpr_parse_bytes_to_uint32(directive + kMaxAgeLength,
+                                  length - kMaxAgeLength, &seconds)) {
+      max_age = static_cast<grpc_millis>(seconds) * GPR_MS_PER_SEC;
+    }
+  }
+  return max_age;
+}
+
+grpc_millis FindMaxAge(const InlinedVector<grpc_mdelem, 8>& mds) {
+  for (size_t i = 0; i < mds.size(); i++) {
+    if (grpc_slice_eq(GRPC_MDKEY(mds[i]), GRPC_MDSTR_CACHE_CONTROL)) {
+      return ParseMaxAge(GRPC_MDVALUE(mds[i]));
+    }
+  }
+  return 0;
+}
+
+class CallData {
+ public:
+  static grpc_error* Init(grpc_call_element* elem,
+                          const grpc_call_element_args* args);
+  static void Destroy(grpc_call_element* elem,
+                      const grpc_call_final_info* final_info,
+                      grpc_closure* ignored);
+  static void StartTransportStreamOpBatch(
+      grpc_call_element* elem, grpc_transport_stream_op_batch* batch);
+
+ private:
+  CallData(grpc_call_element* elem, const grpc_call_element_args& args);
+  ~CallData();
+
+  grpc_slice BuildSignature();
+  void LookupOrFetch();
+
+  // Miss side.
+  void InterceptRecvOps();
+  static void OnRecvInitialMetadataReady(void* arg, grpc_error* error);
+  static void OnRecvMessageReady(void* arg, grpc_error* error);
+  grpc_error* ReadRecvMessage(bool* done);
+  static void OnRecvMessageNextDone(void* arg, grpc_error* error);
+  static void FinishRecvMessageInCallCombiner(void* arg, grpc_error* error);
+  void FinishRecvMessage(grpc_error* error);
+  static void OnRecvTrailingMetadataReady(void* arg, grpc_error* error);
+  void FetchStepDone();
+
+  // Hit side.
+  void DeliverResult();
+
+  grpc_call_element* elem_;
+  ChannelData* chand_;
+  CallCombiner* call_combiner_;
+  Arena* arena_;
+  grpc_transport_stream_op_batch* batch_ = nullptr;
+
+  // The request, read once to build the signature and replayed downwards.
+  UnaryRequestReader request_reader_;
+
+  // On a hit, the cached response; on a miss, the one being fetched.
+  RefCountedPtr<Entry> entry_;
+
+  // Miss state.
+  int pending_steps_ = 3;
+  bool fetch_ok_ = true;
+  grpc_metadata_batch* recv_initial_metadata_ = nullptr;
+  grpc_closure recv_initial_metadata_ready_;
+  grpc_closure* original_recv_initial_metadata_ready_ = nullptr;
+  OrphanablePtr<ByteStream>* recv_message_ = nullptr;
+  grpc_closure recv_message_ready_;
+  grpc_closure* original_recv_message_ready_ = nullptr;
+  OrphanablePtr<ByteStream> recv_message_source_;
+  grpc_slice_buffer recv_message_buffer_;
+  grpc_closure recv_message_next_done_;
+  grpc_closure recv_message_finish_;
+  bool has_recv_message_stream_ = false;
+  ManualConstructor<SliceBufferByteStream> recv_message_stream_;
+  grpc_metadata_batch* recv_trailing_metadata_ = nullptr;
+  grpc_closure recv_trailing_metadata_ready_;
+  grpc_closure* original_recv_trailing_metadata_ready_ = nullptr;
+
+  // Hit state.
+  UnaryBatchCompleter completer_;
+};
+
+CallData::CallData(grpc_call_element* elem, const grpc_call_element_args& args)
+    : elem_(elem),
+      chand_(static_cast<ChannelData*>(elem->channel_data)),
+      call_combiner_(args.call_combiner),
+      arena_(args.arena) {
+  grpc_slice_buffer_init(&recv_message_buffer_);
+}
+
+CallData::~CallData() {
+  if (has_recv_message_stream_) recv_message_stream_.Destroy();
+  grpc_slice_buffer_destroy_internal(&recv_message_buffer_);
+}
+
+grpc_error* CallData::Init(grpc_call_element* elem,
+                           const grpc_call_element_args* args) {
+  new (elem->call_data) CallData(elem, *args);
+  return GRPC_ERROR_NONE;
+}
+
+void CallData::Destroy(grpc_call_element* elem,
+                       const grpc_call_final_info* final_info,
+                       grpc_closure* ignored) {
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  calld->~CallData();
+}
+
+// Returns true if md carries metadata that identifies the caller.
+bool HasCredentialMetadata(const grpc_metadata_batch* md) {
+  for (grpc_linked_mdelem* l = md->list.head; l != nullptr; l = l->next) {
+    const grpc_slice& key = GRPC_MDKEY(l->md);
+    if (grpc_slice_eq(key, GRPC_MDSTR_AUTHORIZATION) ||
+        grpc_slice_eq(key, GRPC_MDSTR_PROXY_AUTHORIZATION) ||
+        grpc_slice_eq(key, GRPC_MDSTR_COOKIE)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsCacheableUnaryBatch(const grpc_transport_stream_op_batch* batch) {
+  return IsUnaryBatch(batch) &&
+         (batch->payload->send_initial_metadata.send_initial_metadata_flags &
+          GRPC_INITIAL_METADATA_CACHEABLE_REQUEST) &&
+         !HasCallCredentials(batch) &&
+         !HasCredentialMetadata(
+             batch->payload->send_initial_metadata.send_initial_metadata);
+}
+
+void CallData::StartTransportStreamOpBatch(
+    grpc_call_element* elem, grpc_transport_stream_op_batch* batch) {
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  if (IsCacheableUnaryBatch(batch) &&
+      batch->payload->send_message.send_message->length() <=
+          calld->chand_->max_bytes()) {
+    calld->batch_ = batch;
+    // If the request cannot be read synchronously, the reader sends the
+    // batch down uncached.
+    if (calld->request_reader_.Read(elem, calld->call_combiner_, batch)) {
+      calld->LookupOrFetch();
+    }
+    return;
+  }
+  grpc_call_next_op(elem, batch);
+}
+
+uint8_t* AppendMdValue(uint8_t* p, const grpc_linked_mdelem* l) {
+  if (l == nullptr) return AppendUint32(p, UINT32_MAX);
+  const grpc_slice& value = GRPC_MDVALUE(l->md);
+  const size_t length = GRPC_SLICE_LENGTH(value);
+  p = AppendUint32(p, static_cast<uint32_t>(length));
+  memcpy(p, GRPC_SLICE_START_PTR(value), length);
+  return p + length;
+}
+
+size_t MdValueLength(const grpc_linked_mdelem* l) {
+  return sizeof(uint32_t) +
+         (l == nullptr ? 0 : GRPC_SLICE_LENGTH(GRPC_MDVALUE(l->md)));
+}
+
+grpc_slice CallData::BuildSignature() {
+  grpc_metadata_batch* md =
+      batch_->payload->send_initial_metadata.send_initial_metadata;
+  const grpc_linked_mdelem* path = md->idx.named.path;
+  const grpc_linked_mdelem* authority = md->idx.named.authority;
+  grpc_slice_buffer* request = request_reader_.request();
+  const size_t length = sizeof(uint32_t) + MdValueLength(path) +
+                        MdValueLength(authority) + request->length;
+  grpc_slice signature = GRPC_SLICE_MALLOC(length);
+  uint8_t* p = GRPC_SLICE_START_PTR(signature);
+  p = AppendUint32(p, request_reader_.flags());
+  p = AppendMdValue(p, path);
+  p = AppendMdValue(p, authority);
+  for (size_t i = 0; i < request->count; i++) {
+    const size_t slice_length = GRPC_SLICE_LENGTH(request->slices[i]);
+    memcpy(p, GRPC_SLICE_START_PTR(request->slices[i]), slice_length);
+    p += slice_length;
+  }
+  GPR_DEBUG_ASSERT(p == GRPC_SLICE_END_PTR(signature));
+  return signature;
+}
+
+void CallData::LookupOrFetch() {
+  grpc_slice signature = BuildSignature();
+  const uint32_t hash = gpr_wyhash(GRPC_SLICE_START_PTR(signature),
+                                   GRPC_SLICE_LENGTH(signature), 0);
+  entry_ = chand_->Lookup(CacheKey{hash, signature});
+  if (entry_ != nullptr) {
+    grpc_slice_unref_internal(signature);
+    GRPC_RESPONSE_CACHE_LOG("calld=%p: hit entry %p", this, entry_.get());
+    DeliverResult();
+    return;
+  }
+  GRPC_RESPONSE_CACHE_LOG("calld=%p: miss", this);
+  entry_ = MakeRefCounted<Entry>(hash, signature);
+  InterceptRecvOps();
+  grpc_call_next_op(elem_, batch_);
+}
+
+//
+// miss
+//
+
+void CallData::InterceptRecvOps() {
+  auto* payload = batch_->payload;
+  recv_initial_metadata_ =
+      payload->recv_initial_metadata.recv_initial_metadata;
+  original_recv_initial_metadata_ready_ =
+      payload->recv_initial_metadata.recv_initial_metadata_ready;
+  payload->recv_initial_metadata.recv_initial_metadata_ready =
+      &recv_initial_metadata_ready_;
+  recv_message_ = payload->recv_message.recv_message;
+  original_recv_message_ready_ = payload->recv_message.recv_message_ready;
+  payload->recv_message.recv_message_ready = &recv_message_ready_;
+  recv_trailing_metadata_ =
+      payload->recv_trailing_metadata.recv_trailing_metadata;
+  original_recv_trailing_metadata_ready_ =
+      payload->recv_trailing_metadata.recv_trailing_metadata_ready;
+  payload->recv_trailing_metadata.recv_trailing_metadata_ready =
+      &recv_trailing_metadata_ready_;
+  GRPC_CLOSURE_INIT(&recv_initial_metadata_ready_, OnRecvInitialMetadataReady,
+                    this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&recv_message_ready_, OnRecvMessageReady, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&recv_message_next_done_, OnRecvMessageNextDone, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&recv_message_finish_, FinishRecvMessageInCallCombiner,
+                    this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready_,
+                    OnRecvTrailingMetadataReady, this,
+                    grpc_schedule_on_exec_ctx);
+}
+
+void CallData::OnRecvInitialMetadataReady(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    for (grpc_linked_mdelem* l = calld->recv_initial_metadata_->list.head;
+         l != nullptr; l = l->next) {
+      calld->entry_->response.initial_metadata.push_back(
+          GRPC_MDELEM_REF(l->md));
+    }
+  } else {
+    calld->fetch_ok_ = false;
+  }
+  grpc_closure* closure = calld->original_recv_initial_metadata_ready_;
+  calld->FetchStepDone();
+  GRPC_CLOSURE_RUN(closure, GRPC_ERROR_REF(error));
+}
+
+void CallData::OnRecvMessageReady(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  if (error != GRPC_ERROR_NONE || *calld->recv_message_ == nullptr) {
+    calld->FinishRecvMessage(GRPC_ERROR_REF(error));
+    return;
+  }
+  calld->recv_message_source_ = std::move(*calld->recv_message_);
+  bool done = false;
+  error = calld->ReadRecvMessage(&done);
+  if (error != GRPC_ERROR_NONE || done) {
+    calld->FinishRecvMessage(error);
+    return;
+  }
+  // The rest of the response arrives in OnRecvMessageNextDone().
+  GRPC_CALL_COMBINER_STOP(calld->call_combiner_, "reading cached response");
+}
+
+// Pulls as much of the response as is available into recv_message_buffer_.
+// Sets *done once all of it has been read.
+grpc_error* CallData::ReadRecvMessage(bool* done) {
+  while (recv_message_buffer_.length < recv_message_source_->length()) {
+    if (!recv_message_source_->Next(SIZE_MAX, &recv_message_next_done_)) {
+      return GRPC_ERROR_NONE;
+    }
+    grpc_slice slice;
+    grpc_error* error = recv_message_source_->Pull(&slice);
+    if (error != GRPC_ERROR_NONE) return error;
+    grpc_slice_buffer_add(&recv_message_buffer_, slice);
+  }
+  *done = true;
+  return GRPC_ERROR_NONE;
+}
+
+void CallData::OnRecvMessageNextDone(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    grpc_slice slice;
+    error = calld->recv_message_source_->Pull(&slice);
+    if (error == GRPC_ERROR_NONE) {
+      grpc_slice_buffer_add(&calld->recv_message_buffer_, slice);
+      bool done = false;
+      error = calld->ReadRecvMessage(&done);
+      if (error == GRPC_ERROR_NONE && !done) return;
+    }
+  } else {
+    GRPC_ERROR_REF(error);
+  }
+  GRPC_CALL_COMBINER_START(calld->call_combiner_, &calld->recv_message_finish_,
+                           error, "finished reading cached response");
+}
+
+void CallData::FinishRecvMessageInCallCombiner(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  calld->FinishRecvMessage(GRPC_ERROR_REF(error));
+}
+
+// Hands the call its response (re-wrapped, if one was read) and keeps a copy
+// for the cache. Takes ownership of error.
+void CallData::FinishRecvMessage(grpc_error* error) {
+  if (recv_message_source_ != nullptr) {
+    if (error == GRPC_ERROR_NONE) {
+      UnaryResponse* response = &entry_->response;
+      response->has_message = true;
+      response->message_flags = recv_message_source_->flags();
+      for (size_t i = 0; i < recv_message_buffer_.count; i++) {
+        grpc_slice_buffer_add(
+            &response->message,
+            grpc_slice_ref_internal(recv_message_buffer_.slices[i]));
+      }
+      has_recv_message_stream_ = true;
+      recv_message_stream_.Init(&recv_message_buffer_, response->message_flags);
+      recv_message_->reset(recv_message_stream_.get());
+    }
+    recv_message_source_.reset();
+  }
+  if (error != GRPC_ERROR_NONE) fetch_ok_ = false;
+  grpc_closure* closure = original_recv_message_ready_;
+  FetchStepDone();
+  GRPC_CLOSURE_RUN(closure, error);
+}
+
+void CallData::OnRecvTrailingMetadataReady(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  grpc_linked_mdelem* status =
+      calld->recv_trailing_metadata_->idx.named.grpc_status;
+  if (error == GRPC_ERROR_NONE && status != nullptr &&
+      grpc_get_status_code_from_metadata(status->md) == GRPC_STATUS_OK) {
+    for (grpc_linked_mdelem* l = calld->recv_trailing_metadata_->list.head;
+         l != nullptr; l = l->next) {
+      calld->entry_->response.trailing_metadata.push_back(
+          GRPC_MDELEM_REF(l->md));
+    }
+  } else {
+    calld->fetch_ok_ = false;
+  }
+  grpc_closure* closure = calld->original_recv_trailing_metadata_ready_;
+  calld->FetchStepDone();
+  GRPC_CLOSURE_RUN(closure, GRPC_ERROR_REF(error));
+}
+
+// Once all three receive ops have completed, caches the response if the call
+// succeeded and the server allowed it.
+void CallData::FetchStepDone() {
+  if (--pending_steps_ > 0) return;
+  RefCountedPtr<Entry> entry = std::move(entry_);
+  if (!fetch_ok_) return;
+  grpc_millis max_age = FindMaxAge(entry->response.trailing_metadata);
+  if (max_age == 0) max_age = FindMaxAge(entry->response.initial_metadata);
+  if (max_age == 0) return;
+  entry->expires_at = ExecCtx::Get()->Now() + max_age;
+  GRPC_RESPONSE_CACHE_LOG("calld=%p: caching entry %p for %" PRId64 "ms",
+                          this, entry.get(), max_age);
+  chand_->Insert(std::move(entry));
+}
+
+//
+// hit
+//
+
+void CallData::DeliverResult() {
+  RefCountedPtr<Entry> entry = std::move(entry_);
+  completer_.Complete(elem_, call_combiner_, arena_, batch_, entry->response);
+}
+
+const grpc_channel_filter grpc_response_cache_filter = {
+    CallData::StartTransportStreamOpBatch,
+    grpc_channel_next_op,
+    sizeof(CallData),
+    CallData::Init,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    CallData::Destroy,
+    sizeof(ChannelData),
+    ChannelData::Init,
+    ChannelData::Destroy,
+    grpc_channel_next_get_info,
+    "response_cache",
+    GRPC_FILTER_BATCH_SEND_INITIAL_METADATA};
+
+bool MaybeAddResponseCacheFilter(grpc_channel_stack_builder* builder,
+                                 void* arg) {
+  const grpc_channel_args* channel_args =
+      grpc_channel_stack_builder_get_channel_arguments(builder);
+  if (grpc_channel_args_want_minimal_stack(channel_args) ||
+      grpc_channel_arg_get_integer(
+          grpc_channel_args_find(channel_args,
+                                 GRPC_ARG_UNARY_RESPONSE_CACHE_SIZE),
+          {0, 0, INT_MAX}) == 0) {
+    return true;
+  }
+  return grpc_channel_stack_builder_prepend_filter(
+      builder, &grpc_response_cache_filter, nullptr, nullptr);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+// Registered after the unary coalescing filter so that, when both are
+// enabled, hits are served before a call joins an in-flight one.
+void grpc_response_cache_filter_init(void) {
+  grpc_channel_init_register_stage(
+      GRPC_CLIENT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      grpc_core::MaybeAddResponseCacheFilter, nullptr);
+  grpc_channel_init_register_stage(
+      GRPC_CLIENT_DIRECT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      grpc_core::MaybeAddResponseCacheFilter, nullptr);
+}
+
+void grpc_response_cache_filter_shutdown(void) {}
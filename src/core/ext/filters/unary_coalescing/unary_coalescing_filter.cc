@@ -0,0 +1,616 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <string.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/channel/unary_batch.h"
+#include "src/core/lib/gpr/wyhash.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/transport/byte_stream.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/status_metadata.h"
+
+// Requests larger than this are never coalesced, since a flight keeps a copy
+// of its request to tell identical calls from hash collisions.
+#define MAX_COALESCED_REQUEST_BYTES (64 * 1024)
+
+namespace grpc_core {
+
+TraceFlag grpc_trace_unary_coalescing(false, "unary_coalescing");
+
+#define GRPC_COALESCING_LOG(format, ...)                               \
+  do {                                                                 \
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_unary_coalescing)) {        \
+      gpr_log(GPR_INFO, "(unary coalescing) " format, ##__VA_ARGS__); \
+    }                                                                  \
+  } while (0)
+
+namespace {
+
+/*
+  A unary call whose whole batch (send and receive) arrives at once is keyed
+  by a signature of its initial metadata, flags and request bytes. The first
+  such call on the channel becomes the leader of a Flight and goes down the
+  stack as usual; the filter copies its initial metadata, response message
+  and trailing metadata as they come back. Identical calls arriving while the
+  flight is open are followers: their batches are held here and, once the
+  leader has all three, completed in their own call combiners with copies of
+  the leader's results.
+
+  A flight whose leader fails locally shares nothing: each follower resumes
+  and sends its own batch down. Local failures either reach the filter as
+  errors or, once the call is on a transport, as a status the transport
+  synthesizes, so the statuses a local failure produces (CANCELLED,
+  DEADLINE_EXCEEDED and UNAVAILABLE) are never shared either. A
+  follower cancelled while waiting leaves the flight and fails its batch.
+  Calls with per-call credentials are never coalesced, since the metadata
+  those add is not part of the signature.
+*/
+
+class CallData;
+
+struct FlightKey {
+  uint32_t hash;
+  grpc_slice signature;
+};
+
+struct FlightKeyLess {
+  bool operator()(const FlightKey& a, const FlightKey& b) const {
+    if (a.hash != b.hash) return a.hash < b.hash;
+    const size_t a_len = GRPC_SLICE_LENGTH(a.signature);
+    const size_t b_len = GRPC_SLICE_LENGTH(b.signature);
+    if (a_len != b_len) return a_len < b_len;
+    return memcmp(GRPC_SLICE_START_PTR(a.signature),
+                  GRPC_SLICE_START_PTR(b.signature), a_len) < 0;
+  }
+};
+
+struct Flight : public RefCounted<Flight> {
+  // Takes ownership of signature.
+  Flight(uint32_t hash, grpc_slice signature) : key{hash, signature} {}
+
+  ~Flight() {
+    grpc_slice_unref_internal(key.signature);
+    GRPC_ERROR_UNREF(error);
+  }
+
+  const FlightKey key;
+  // Followers still waiting. Guarded by the channel's mu_.
+  CallData* followers = nullptr;
+  // The leader's results. Written only by the leader, in its call combiner,
+  // before the flight is closed; read by followers only after that.
+  UnaryResponse response;
+  // First local failure the leader saw, if any.
+  grpc_error* error = GRPC_ERROR_NONE;
+};
+
+class ChannelData {
+ public:
+  static grpc_error* Init(grpc_channel_element* elem,
+                          grpc_channel_element_args* args);
+  static void Destroy(grpc_channel_element* elem);
+
+ private:
+  friend class CallData;
+
+  ChannelData() = default;
+  ~ChannelData() { GPR_ASSERT(flights_.empty()); }
+
+  Mutex mu_;
+  Map<FlightKey, Flight*, FlightKeyLess> flights_;
+};
+
+grpc_error* ChannelData::Init(grpc_channel_element* elem,
+                              grpc_channel_element_args* args) {
+  GPR_ASSERT(!args->is_last);
+  new (elem->channel_data) ChannelData();
+  return GRPC_ERROR_NONE;
+}
+
+void ChannelData::Destroy(grpc_channel_element* elem) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  chand->~ChannelData();
+}
+
+class CallData {
+ public:
+  static grpc_error* Init(grpc_call_element* elem,
+                          const grpc_call_element_args* args);
+  static void Destroy(grpc_call_element* elem,
+                      const grpc_call_final_info* final_info,
+                      grpc_closure* ignored);
+  static void StartTransportStreamOpBatch(
+      grpc_call_element* elem, grpc_transport_stream_op_batch* batch);
+
+ private:
+  friend class ChannelData;
+
+  CallData(grpc_call_element* elem, const grpc_call_element_args& args);
+  ~CallData();
+
+  grpc_slice BuildSignature();
+  void LeadOrJoin();
+
+  // Leader side.
+  void InterceptRecvOps();
+  static void OnRecvInitialMetadataReady(void* arg, grpc_error* error);
+  static void OnRecvMessageReady(void* arg, grpc_error* error);
+  grpc_error* ReadRecvMessage(bool* done);
+  static void OnRecvMessageNextDone(void* arg, grpc_error* error);
+  static void FinishRecvMessageInCallCombiner(void* arg, grpc_error* error);
+  void FinishRecvMessage(grpc_error* error);
+  static void OnRecvTrailingMetadataReady(void* arg, grpc_error* error);
+  void RecordFailure(grpc_error* error);
+  void LeaderStepDone();
+
+  // Follower side.
+  static void OnCancel(void* arg, grpc_error* error);
+  static void FailHeldBatch(void* arg, grpc_error* error);
+  static void ResumeHeldBatch(void* arg, grpc_error* ignored);
+  static void DeliverResult(void* arg, grpc_error* ignored);
+
+  grpc_call_element* elem_;
+  ChannelData* chand_;
+  CallCombiner* call_combiner_;
+  Arena* arena_;
+  grpc_transport_stream_op_batch* batch_ = nullptr;
+
+  // The request, read once to build the signature and replayed downwards.
+  UnaryRequestReader request_reader_;
+
+  RefCountedPtr<Flight> flight_;
+
+  // Leader state.
+  int pending_steps_ = 3;
+  grpc_metadata_batch* recv_initial_metadata_ = nullptr;
+  grpc_closure recv_initial_metadata_ready_;
+  grpc_closure* original_recv_initial_metadata_ready_ = nullptr;
+  OrphanablePtr<ByteStream>* recv_message_ = nullptr;
+  grpc_closure recv_message_ready_;
+  grpc_closure* original_recv_message_ready_ = nullptr;
+  OrphanablePtr<ByteStream> recv_message_source_;
+  grpc_slice_buffer recv_message_buffer_;
+  grpc_closure recv_message_next_done_;
+  grpc_closure recv_message_finish_;
+  bool has_recv_message_stream_ = false;
+  ManualConstructor<SliceBufferByteStream> recv_message_stream_;
+  grpc_metadata_batch* recv_trailing_metadata_ = nullptr;
+  grpc_closure recv_trailing_metadata_ready_;
+  grpc_closure* original_recv_trailing_metadata_ready_ = nullptr;
+
+  // Follower state. waiting_ and the list links are guarded by chand_->mu_.
+  bool waiting_ = false;
+  CallData* next_follower_ = nullptr;
+  CallData* prev_follower_ = nullptr;
+  grpc_closure on_cancel_;
+  grpc_closure held_batch_closure_;
+  UnaryBatchCompleter completer_;
+};
+
+CallData::CallData(grpc_call_element* elem, const grpc_call_element_args& args)
+    : elem_(elem),
+      chand_(static_cast<ChannelData*>(elem->channel_data)),
+      call_combiner_(args.call_combiner),
+      arena_(args.arena) {
+  grpc_slice_buffer_init(&recv_message_buffer_);
+}
+
+CallData::~CallData() {
+  GPR_ASSERT(!waiting_);
+  if (has_recv_message_stream_) recv_message_stream_.Destroy();
+  grpc_slice_buffer_destroy_internal(&recv_message_buffer_);
+}
+
+grpc_error* CallData::Init(grpc_call_element* elem,
+                           const grpc_call_element_args* args) {
+  new (elem->call_data) CallData(elem, *args);
+  return GRPC_ERROR_NONE;
+}
+
+void CallData::Destroy(grpc_call_element* elem,
+                       const grpc_call_final_info* final_info,
+                       grpc_closure* ignored) {
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  calld->~CallData();
+}
+
+void CallData::StartTransportStreamOpBatch(
+    grpc_call_element* elem, grpc_transport_stream_op_batch* batch) {
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  if (IsUnaryBatch(batch) && !HasCallCredentials(batch) &&
+      batch->payload->send_message.send_message->length() <=
+          MAX_COALESCED_REQUEST_BYTES) {
+    calld->batch_ = batch;
+    // If the request cannot be read synchronously, the reader sends the
+    // batch down uncoalesced.
+    if (calld->request_reader_.Read(elem, calld->call_combiner_, batch)) {
+      calld->LeadOrJoin();
+    }
+    return;
+  }
+  grpc_call_next_op(elem, batch);
+}
+
+uint8_t* AppendSlice(uint8_t* p, const grpc_slice& slice) {
+  const size_t length = GRPC_SLICE_LENGTH(slice);
+  p = AppendUint32(p, static_cast<uint32_t>(length));
+  memcpy(p, GRPC_SLICE_START_PTR(slice), length);
+  return p + length;
+}
+
+grpc_slice CallData::BuildSignature() {
+  grpc_metadata_batch* md =
+      batch_->payload->send_initial_metadata.send_initial_metadata;
+  grpc_slice_buffer* request = request_reader_.request();
+  size_t length = 2 * sizeof(uint32_t) + request->length;
+  for (grpc_linked_mdelem* l = md->list.head; l != nullptr; l = l->next) {
+    length += 2 * sizeof(uint32_t) + GRPC_SLICE_LENGTH(GRPC_MDKEY(l->md)) +
+              GRPC_SLICE_LENGTH(GRPC_MDVALUE(l->md));
+  }
+  grpc_slice signature = GRPC_SLICE_MALLOC(length);
+  uint8_t* p = GRPC_SLICE_START_PTR(signature);
+  p = AppendUint32(
+      p, batch_->payload->send_initial_metadata.send_initial_metadata_flags);
+  p = AppendUint32(p, request_reader_.flags());
+  for (grpc_linked_mdelem* l = md->list.head; l != nullptr; l = l->next) {
+    p = AppendSlice(p, GRPC_MDKEY(l->md));
+    p = AppendSlice(p, GRPC_MDVALUE(l->md));
+  }
+  for (size_t i = 0; i < request->count; i++) {
+    const size_t slice_length = GRPC_SLICE_LENGTH(request->slices[i]);
+    memcpy(p, GRPC_SLICE_START_PTR(request->slices[i]), slice_length);
+    p += slice_length;
+  }
+  GPR_DEBUG_ASSERT(p == GRPC_SLICE_END_PTR(signature));
+  return signature;
+}
+
+void CallData::LeadOrJoin() {
+  grpc_slice signature = BuildSignature();
+  const uint32_t hash = gpr_wyhash(GRPC_SLICE_START_PTR(signature),
+                                   GRPC_SLICE_LENGTH(signature), 0);
+  bool lead = false;
+  {
+    MutexLock lock(&chand_->mu_);
+    auto it = chand_->flights_.find(FlightKey{hash, signature});
+    if (it == chand_->flights_.end()) {
+      flight_ = MakeRefCounted<Flight>(hash, signature);
+      chand_->flights_.emplace(flight_->key, flight_.get());
+      lead = true;
+    } else {
+      grpc_slice_unref_internal(signature);
+      flight_ = it->second->Ref();
+      next_follower_ = flight_->followers;
+      if (next_follower_ != nullptr) next_follower_->prev_follower_ = this;
+      flight_->followers = this;
+      waiting_ = true;
+    }
+  }
+  if (lead) {
+    GRPC_COALESCING_LOG("calld=%p: leading flight %p", this, flight_.get());
+    InterceptRecvOps();
+    grpc_call_next_op(elem_, batch_);
+    return;
+  }
+  GRPC_COALESCING_LOG("calld=%p: joining flight %p", this, flight_.get());
+  GRPC_CLOSURE_INIT(&on_cancel_, OnCancel, this, grpc_schedule_on_exec_ctx);
+  call_combiner_->SetNotifyOnCancel(&on_cancel_);
+  GRPC_CALL_COMBINER_STOP(call_combiner_, "waiting for coalesced call");
+}
+
+//
+// leader
+//
+
+void CallData::InterceptRecvOps() {
+  auto* payload = batch_->payload;
+  recv_initial_metadata_ =
+      payload->recv_initial_metadata.recv_initial_metadata;
+  original_recv_initial_metadata_ready_ =
+      payload->recv_initial_metadata.recv_initial_metadata_ready;
+  payload->recv_initial_metadata.recv_initial_metadata_ready =
+      &recv_initial_metadata_ready_;
+  recv_message_ = payload->recv_message.recv_message;
+  original_recv_message_ready_ = payload->recv_message.recv_message_ready;
+  payload->recv_message.recv_message_ready = &recv_message_ready_;
+  recv_trailing_metadata_ =
+      payload->recv_trailing_metadata.recv_trailing_metadata;
+  original_recv_trailing_metadata_ready_ =
+      payload->recv_trailing_metadata.recv_trailing_metadata_ready;
+  payload->recv_trailing_metadata.recv_trailing_metadata_ready =
+      &recv_trailing_metadata_ready_;
+  GRPC_CLOSURE_INIT(&recv_initial_metadata_ready_, OnRecvInitialMetadataReady,
+                    this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&recv_message_ready_, OnRecvMessageReady, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&recv_message_next_done_, OnRecvMessageNextDone, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&recv_message_finish_, FinishRecvMessageInCallCombiner,
+                    this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready_,
+                    OnRecvTrailingMetadataReady, this,
+                    grpc_schedule_on_exec_ctx);
+}
+
+void CallData::OnRecvInitialMetadataReady(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    for (grpc_linked_mdelem* l = calld->recv_initial_metadata_->list.head;
+         l != nullptr; l = l->next) {
+      calld->flight_->response.initial_metadata.push_back(
+          GRPC_MDELEM_REF(l->md));
+    }
+  } else {
+    calld->RecordFailure(GRPC_ERROR_REF(error));
+  }
+  grpc_closure* closure = calld->original_recv_initial_metadata_ready_;
+  calld->LeaderStepDone();
+  GRPC_CLOSURE_RUN(closure, GRPC_ERROR_REF(error));
+}
+
+void CallData::OnRecvMessageReady(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  if (error != GRPC_ERROR_NONE || *calld->recv_message_ == nullptr) {
+    calld->FinishRecvMessage(GRPC_ERROR_REF(error));
+    return;
+  }
+  calld->recv_message_source_ = std::move(*calld->recv_message_);
+  bool done = false;
+  error = calld->ReadRecvMessage(&done);
+  if (error != GRPC_ERROR_NONE || done) {
+    calld->FinishRecvMessage(error);
+    return;
+  }
+  // The rest of the response arrives in OnRecvMessageNextDone().
+  GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
+                          "reading coalesced response");
+}
+
+// Pulls as much of the response as is available into recv_message_buffer_.
+// Sets *done once all of it has been read.
+grpc_error* CallData::ReadRecvMessage(bool* done) {
+  while (recv_message_buffer_.length < recv_message_source_->length()) {
+    if (!recv_message_source_->Next(SIZE_MAX, &recv_message_next_done_)) {
+      return GRPC_ERROR_NONE;
+    }
+    grpc_slice slice;
+    grpc_error* error = recv_message_source_->Pull(&slice);
+    if (error != GRPC_ERROR_NONE) return error;
+    grpc_slice_buffer_add(&recv_message_buffer_, slice);
+  }
+  *done = true;
+  return GRPC_ERROR_NONE;
+}
+
+void CallData::OnRecvMessageNextDone(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    grpc_slice slice;
+    error = calld->recv_message_source_->Pull(&slice);
+    if (error == GRPC_ERROR_NONE) {
+      grpc_slice_buffer_add(&calld->recv_message_buffer_, slice);
+      bool done = false;
+      error = calld->ReadRecvMessage(&done);
+      if (error == GRPC_ERROR_NONE && !done) return;
+    }
+  } else {
+    GRPC_ERROR_REF(error);
+  }
+  GRPC_CALL_COMBINER_START(calld->call_combiner_, &calld->recv_message_finish_,
+                           error, "finished reading coalesced response");
+}
+
+void CallData::FinishRecvMessageInCallCombiner(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  calld->FinishRecvMessage(GRPC_ERROR_REF(error));
+}
+
+// Hands the leader its response (re-wrapped, if one was read) and keeps a
+// copy for the followers. Takes ownership of error.
+void CallData::FinishRecvMessage(grpc_error* error) {
+  if (recv_message_source_ != nullptr) {
+    if (error == GRPC_ERROR_NONE) {
+      UnaryResponse* response = &flight_->response;
+      response->has_message = true;
+      response->message_flags = recv_message_source_->flags();
+      for (size_t i = 0; i < recv_message_buffer_.count; i++) {
+        grpc_slice_buffer_add(
+            &response->message,
+            grpc_slice_ref_internal(recv_message_buffer_.slices[i]));
+      }
+      has_recv_message_stream_ = true;
+      recv_message_stream_.Init(&recv_message_buffer_, response->message_flags);
+      recv_message_->reset(recv_message_stream_.get());
+    }
+    recv_message_source_.reset();
+  }
+  if (error != GRPC_ERROR_NONE) RecordFailure(GRPC_ERROR_REF(error));
+  grpc_closure* closure = original_recv_message_ready_;
+  LeaderStepDone();
+  GRPC_CLOSURE_RUN(closure, error);
+}
+
+// Returns true if status may come from the leader's own cancellation,
+// deadline or connection rather than from the server.
+bool MayBeLocalStatus(grpc_status_code status) {
+  return status == GRPC_STATUS_CANCELLED ||
+         status == GRPC_STATUS_DEADLINE_EXCEEDED ||
+         status == GRPC_STATUS_UNAVAILABLE;
+}
+
+void CallData::OnRecvTrailingMetadataReady(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  grpc_linked_mdelem* status =
+      calld->recv_trailing_metadata_->idx.named.grpc_status;
+  if (error == GRPC_ERROR_NONE && status != nullptr &&
+      MayBeLocalStatus(grpc_get_status_code_from_metadata(status->md))) {
+    calld->RecordFailure(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Coalesced call ended with a status that may be local"));
+  } else if (error == GRPC_ERROR_NONE) {
+    for (grpc_linked_mdelem* l = calld->recv_trailing_metadata_->list.head;
+         l != nullptr; l = l->next) {
+      calld->flight_->response.trailing_metadata.push_back(
+          GRPC_MDELEM_REF(l->md));
+    }
+  } else {
+    calld->RecordFailure(GRPC_ERROR_REF(error));
+  }
+  grpc_closure* closure = calld->original_recv_trailing_metadata_ready_;
+  calld->LeaderStepDone();
+  GRPC_CLOSURE_RUN(closure, GRPC_ERROR_REF(error));
+}
+
+// Takes ownership of error.
+void CallData::RecordFailure(grpc_error* error) {
+  if (flight_->error == GRPC_ERROR_NONE) {
+    flight_->error = error;
+  } else {
+    GRPC_ERROR_UNREF(error);
+  }
+}
+
+// Once the leader has seen all three of its receive ops complete, closes the
+// flight and hands every follower either the results or its own batch back.
+void CallData::LeaderStepDone() {
+  if (--pending_steps_ > 0) return;
+  CallData* followers;
+  {
+    MutexLock lock(&chand_->mu_);
+    chand_->flights_.erase(flight_->key);
+    followers = flight_->followers;
+    flight_->followers = nullptr;
+    for (CallData* f = followers; f != nullptr; f = f->next_follower_) {
+      f->waiting_ = false;
+    }
+  }
+  const bool share = flight_->error == GRPC_ERROR_NONE;
+  GRPC_COALESCING_LOG("calld=%p: closing flight %p, %s followers", this,
+                      flight_.get(), share ? "completing" : "resuming");
+  while (followers != nullptr) {
+    CallData* follower = followers;
+    followers = follower->next_follower_;
+    GRPC_CLOSURE_INIT(&follower->held_batch_closure_,
+                      share ? DeliverResult : ResumeHeldBatch, follower,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CALL_COMBINER_START(follower->call_combiner_,
+                             &follower->held_batch_closure_, GRPC_ERROR_NONE,
+                             share ? "delivering coalesced result"
+                                   : "resuming coalesced call");
+  }
+  flight_.reset();
+}
+
+//
+// follower
+//
+
+void CallData::OnCancel(void* arg, grpc_error* error) {
+  if (error == GRPC_ERROR_NONE) return;
+  CallData* calld = static_cast<CallData*>(arg);
+  {
+    MutexLock lock(&calld->chand_->mu_);
+    if (!calld->waiting_) return;
+    calld->waiting_ = false;
+    if (calld->prev_follower_ != nullptr) {
+      calld->prev_follower_->next_follower_ = calld->next_follower_;
+    } else {
+      calld->flight_->followers = calld->next_follower_;
+    }
+    if (calld->next_follower_ != nullptr) {
+      calld->next_follower_->prev_follower_ = calld->prev_follower_;
+    }
+  }
+  GRPC_CLOSURE_INIT(&calld->held_batch_closure_, FailHeldBatch, calld,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CALL_COMBINER_START(calld->call_combiner_, &calld->held_batch_closure_,
+                           GRPC_ERROR_REF(error),
+                           "cancelled while waiting for coalesced call");
+}
+
+void CallData::FailHeldBatch(void* arg, grpc_error* error) {
+  CallData* calld = static_cast<CallData*>(arg);
+  calld->flight_.reset();
+  grpc_transport_stream_op_batch_finish_with_failure(
+      calld->batch_, GRPC_ERROR_REF(error), calld->call_combiner_);
+}
+
+void CallData::ResumeHeldBatch(void* arg, grpc_error* ignored) {
+  CallData* calld = static_cast<CallData*>(arg);
+  calld->flight_.reset();
+  grpc_call_next_op(calld->elem_, calld->batch_);
+}
+
+void CallData::DeliverResult(void* arg, grpc_error* ignored) {
+  CallData* calld = static_cast<CallData*>(arg);
+  RefCountedPtr<Flight> flight = std::move(calld->flight_);
+  calld->completer_.Complete(calld->elem_, calld->call_combiner_,
+                             calld->arena_, calld->batch_, flight->response);
+}
+
+const grpc_channel_filter grpc_unary_coalescing_filter = {
+    CallData::StartTransportStreamOpBatch,
+    grpc_channel_next_op,
+    sizeof(CallData),
+    CallData::Init,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    CallData::Destroy,
+    sizeof(ChannelData),
+    ChannelData::Init,
+    ChannelData::Destroy,
+    grpc_channel_next_get_info,
+    "unary_coalescing",
+    GRPC_FILTER_BATCH_SEND_INITIAL_METADATA};
+
+bool MaybeAddUnaryCoalescingFilter(grpc_channel_stack_builder* builder,
+                                   void* arg) {
+  const grpc_channel_args* channel_args =
+      grpc_channel_stack_builder_get_channel_arguments(builder);
+  if (grpc_channel_args_want_minimal_stack(channel_args) ||
+      !grpc_channel_arg_get_bool(
+          grpc_channel_args_find(channel_args, GRPC_ARG_COALESCE_UNARY_CALLS),
+          false)) {
+    return true;
+  }
+  return grpc_channel_stack_builder_prepend_filter(
+      builder, &grpc_unary_coalescing_filter, nullptr, nullptr);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+void grpc_unary_coalescing_filter_init(void) {
+  grpc_channel_init_register_stage(
+      GRPC_CLIENT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      grpc_core::MaybeAddUnaryCoalescingFilter, nullptr);
+  grpc_channel_init_register_stage(
+      GRPC_CLIENT_DIRECT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      grpc_core::MaybeAddUnaryCoalescingFilter, nullptr);
+}
+
+void grpc_unary_coalescing_filter_shutdown(void) {}
@@ -45,6 +45,16 @@
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/server.h"
 
+// A connection accepted while the listener was running as many handshakes as
+// it may, waiting for one of them to finish.
+typedef struct queued_connection {
+  grpc_endpoint* tcp;
+  grpc_pollset* accepting_pollset;
+  grpc_tcp_server_acceptor* acceptor;
+  grpc_millis deadline;
+  struct queued_connection* next;
+} queued_connection;
+
 typedef struct {
   grpc_server* server;
   grpc_tcp_server* tcp_server;
@@ -56,8 +66,24 @@ typedef struct {
   grpc_core::HandshakeManager* pending_handshake_mgrs;
   grpc_core::RefCountedPtr<grpc_core::channelz::ListenSocketNode>
       channelz_listen_socket;
+  // Handshake admission control. max_concurrent_handshakes is 0 if the number
+  // of handshakes is not limited.
+  int max_concurrent_handshakes;
+  int max_queued_handshakes;
+  int handshakes_in_progress;
+  int num_queued_connections;
+  queued_connection* queued_head;
+  queued_connection* queued_tail;
 } server_state;
 
+static void init_handshake_admission(server_state* state,
+                                     const grpc_channel_args* args) {
+  state->max_concurrent_handshakes = grpc_channel_args_find_integer(
+      args, GRPC_ARG_SERVER_MAX_CONCURRENT_HANDSHAKES, {0, 0, INT_MAX});
+  state->max_queued_handshakes = grpc_channel_args_find_integer(
+      args, GRPC_ARG_SERVER_MAX_QUEUED_HANDSHAKES, {1024, 0, INT_MAX});
+}
+
 typedef struct {
   gpr_refcount refs;
   server_state* svr_state;
@@ -110,6 +136,46 @@ static void on_receive_settings(void* arg, grpc_error* error) {
   server_connection_state_unref(connection_state);
 }
 
+static void close_connection(grpc_endpoint* tcp,
+                             grpc_tcp_server_acceptor* acceptor) {
+  grpc_endpoint_shutdown(tcp, GRPC_ERROR_NONE);
+  grpc_endpoint_destroy(tcp);
+  gpr_free(acceptor);
+}
+
+static grpc_core::RefCountedPtr<grpc_core::HandshakeManager>
+reserve_handshake_locked(server_state* state);
+static void start_handshake(
+    server_state* state, grpc_endpoint* tcp, grpc_pollset* accepting_pollset,
+    grpc_tcp_server_acceptor* acceptor, grpc_millis deadline,
+    grpc_core::RefCountedPtr<grpc_core::HandshakeManager> handshake_mgr);
+
+// Starts the handshakes of queued connections for as long as handshake slots
+// are free. The caller must hold a ref to state->tcp_server.
+static void start_queued_handshakes(server_state* state) {
+  for (;;) {
+    gpr_mu_lock(&state->mu);
+    if (state->shutdown || state->queued_head == nullptr ||
+        state->handshakes_in_progress >= state->max_concurrent_handshakes) {
+      gpr_mu_unlock(&state->mu);
+      return;
+    }
+    queued_connection* conn = state->queued_head;
+    state->queued_head = conn->next;
+    if (state->queued_head == nullptr) state->queued_tail = nullptr;
+    state->num_queued_connections--;
+    auto handshake_mgr = reserve_handshake_locked(state);
+    gpr_mu_unlock(&state->mu);
+    if (handshake_mgr == nullptr) {
+      close_connection(conn->tcp, conn->acceptor);
+    } else {
+      start_handshake(state, conn->tcp, conn->accepting_pollset, conn->acceptor,
+                      conn->deadline, std::move(handshake_mgr));
+    }
+    gpr_free(conn);
+  }
+}
+
 static void on_handshake_done(void* arg, grpc_error* error) {
   auto* args = static_cast<grpc_core::HandshakerArgs*>(arg);
   server_connection_state* connection_state =
@@ -176,25 +242,19 @@ static void on_handshake_done(void* arg, grpc_error* error) {
   }
   connection_state->handshake_mgr->RemoveFromPendingMgrList(
       &connection_state->svr_state->pending_handshake_mgrs);
+  connection_state->svr_state->handshakes_in_progress--;
   gpr_mu_unlock(&connection_state->svr_state->mu);
   connection_state->handshake_mgr.reset();
   gpr_free(connection_state->acceptor);
+  start_queued_handshakes(connection_state->svr_state);
   grpc_tcp_server_unref(connection_state->svr_state->tcp_server);
   server_connection_state_unref(connection_state);
 }
 
-static void on_accept(void* arg, grpc_endpoint* tcp,
-                      grpc_pollset* accepting_pollset,
-                      grpc_tcp_server_acceptor* acceptor) {
-  server_state* state = static_cast<server_state*>(arg);
-  gpr_mu_lock(&state->mu);
-  if (state->shutdown) {
-    gpr_mu_unlock(&state->mu);
-    grpc_endpoint_shutdown(tcp, GRPC_ERROR_NONE);
-    grpc_endpoint_destroy(tcp);
-    gpr_free(acceptor);
-    return;
-  }
+// Takes the resources for a new handshake. Returns null if the memory quota is
+// exhausted.
+static grpc_core::RefCountedPtr<grpc_core::HandshakeManager>
+reserve_handshake_locked(server_state* state) {
   grpc_resource_user* resource_user =
       grpc_server_get_default_resource_user(state->server);
   if (resource_user != nullptr &&
@@ -203,16 +263,19 @@ static void on_accept(void* arg, grpc_endpoint* tcp,
     gpr_log(
         GPR_ERROR,
         "Memory quota exhausted, rejecting the connection, no handshaking.");
-    gpr_mu_unlock(&state->mu);
-    grpc_endpoint_shutdown(tcp, GRPC_ERROR_NONE);
-    grpc_endpoint_destroy(tcp);
-    gpr_free(acceptor);
-    return;
+    return nullptr;
   }
   auto handshake_mgr = grpc_core::MakeRefCounted<grpc_core::HandshakeManager>();
   handshake_mgr->AddToPendingMgrList(&state->pending_handshake_mgrs);
   grpc_tcp_server_ref(state->tcp_server);
-  gpr_mu_unlock(&state->mu);
+  state->handshakes_in_progress++;
+  return handshake_mgr;
+}
+
+static void start_handshake(
+    server_state* state, grpc_endpoint* tcp, grpc_pollset* accepting_pollset,
+    grpc_tcp_server_acceptor* acceptor, grpc_millis deadline,
+    grpc_core::RefCountedPtr<grpc_core::HandshakeManager> handshake_mgr) {
   server_connection_state* connection_state =
       static_cast<server_connection_state*>(
           gpr_zalloc(sizeof(*connection_state)));
@@ -228,15 +291,72 @@ static void on_accept(void* arg, grpc_endpoint* tcp,
       grpc_core::HANDSHAKER_SERVER, state->args,
       connection_state->interested_parties,
       connection_state->handshake_mgr.get());
+  connection_state->deadline = deadline;
+  connection_state->handshake_mgr->DoHandshake(
+      tcp, state->args, connection_state->deadline, acceptor, on_handshake_done,
+      connection_state);
+}
+
+static void on_accept(void* arg, grpc_endpoint* tcp,
+                      grpc_pollset* accepting_pollset,
+                      grpc_tcp_server_acceptor* acceptor) {
+  server_state* state = static_cast<server_state*>(arg);
+  // Time spent waiting for a handshake slot counts against the timeout.
   const grpc_arg* timeout_arg =
       grpc_channel_args_find(state->args, GRPC_ARG_SERVER_HANDSHAKE_TIMEOUT_MS);
-  connection_state->deadline =
+  grpc_millis deadline =
       grpc_core::ExecCtx::Get()->Now() +
       grpc_channel_arg_get_integer(timeout_arg,
                                    {120 * GPR_MS_PER_SEC, 1, INT_MAX});
-  connection_state->handshake_mgr->DoHandshake(
-      tcp, state->args, connection_state->deadline, acceptor, on_handshake_done,
-      connection_state);
+  gpr_mu_lock(&state->mu);
+  if (state->shutdown) {
+    gpr_mu_unlock(&state->mu);
+    close_connection(tcp, acceptor);
+    return;
+  }
+  if (state->max_concurrent_handshakes > 0 &&
+      state->handshakes_in_progress >= state->max_concurrent_handshakes) {
+    bool queue = state->num_queued_connections < state->max_queued_handshakes;
+    if (queue) {
+      queued_connection* conn =
+          static_cast<queued_connection*>(gpr_malloc(sizeof(*conn)));
+      conn->tcp = tcp;
+      conn->accepting_pollset = accepting_pollset;
+      conn->acceptor = acceptor;
+      conn->deadline = deadline;
+      conn->next = nullptr;
+      if (state->queued_tail == nullptr) {
+        state->queued_head = conn;
+      } else {
+        state->queued_tail->next = conn;
+      }
+      state->queued_tail = conn;
+      state->num_queued_connections++;
+    }
+    if (state->channelz_listen_socket != nullptr) {
+      if (queue) {
+        state->channelz_listen_socket->RecordHandshakeQueued();
+      } else {
+        state->channelz_listen_socket->RecordHandshakeRejected();
+      }
+    }
+    gpr_mu_unlock(&state->mu);
+    if (!queue) {
+      gpr_log(GPR_DEBUG,
+              "Too many connections waiting for a handshake, rejecting the "
+              "connection.");
+      close_connection(tcp, acceptor);
+    }
+    return;
+  }
+  auto handshake_mgr = reserve_handshake_locked(state);
+  gpr_mu_unlock(&state->mu);
+  if (handshake_mgr == nullptr) {
+    close_connection(tcp, acceptor);
+    return;
+  }
+  start_handshake(state, tcp, accepting_pollset, acceptor, deadline,
+                  std::move(handshake_mgr));
 }
 
 /* Server callback: start listening on our ports */
@@ -283,7 +403,17 @@ static void server_destroy_listener(grpc_server* server, void* arg,
   state->shutdown = true;
   state->server_destroy_listener_done = destroy_done;
   grpc_tcp_server* tcp_server = state->tcp_server;
+  queued_connection* queued = state->queued_head;
+  state->queued_head = nullptr;
+  state->queued_tail = nullptr;
+  state->num_queued_connections = 0;
   gpr_mu_unlock(&state->mu);
+  while (queued != nullptr) {
+    queued_connection* next = queued->next;
+    close_connection(queued->tcp, queued->acceptor);
+    gpr_free(queued);
+    queued = next;
+  }
   grpc_tcp_server_shutdown_listeners(tcp_server);
   grpc_tcp_server_unref(tcp_server);
 }
@@ -310,6 +440,7 @@ static grpc_error* chttp2_server_add_acceptor(grpc_server* server,
   state->args = args;
   state->shutdown = true;
   gpr_mu_init(&state->mu);
+  init_handshake_admission(state, args);
   // TODO(yangg) channelz
   arg = grpc_channel_args_find(args, name);
   GPR_ASSERT(arg->type == GRPC_ARG_POINTER);
@@ -372,6 +503,7 @@ grpc_error* grpc_chttp2_server_add_port(grpc_server* server, const char* addr,
   state->args = args;
   state->shutdown = true;
   gpr_mu_init(&state->mu);
+  init_handshake_admission(state, args);
 
   naddrs = resolved->naddrs;
   errors = static_cast<grpc_error**>(gpr_malloc(sizeof(*errors) * naddrs));
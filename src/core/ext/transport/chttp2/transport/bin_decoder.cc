@@ -59,13 +59,45 @@ static bool input_is_valid(const uint8_t* input_ptr, size_t length) {
       gpr_log(GPR_ERROR,
               "Base64 decoding failed, invalid character '%c' in base64 "
               "input.\n",
-              static_cast<char>(*input_ptr));
+              static_cast<char>(input_ptr[i]));
       return false;
     }
   }
   return true;
 }
 
+/* Decodes the whole 4 character blocks that fit in the input and the output,
+ * checking them for invalid characters once at the end instead of character
+ * by character. */
+static bool decode_blocks(struct grpc_base64_decode_context* ctx) {
+  size_t blocks = GPR_MIN(
+      static_cast<size_t>(ctx->input_end - ctx->input_cur) / 4,
+      static_cast<size_t>(ctx->output_end - ctx->output_cur) / 3);
+  const uint8_t* in = ctx->input_cur;
+  uint8_t* out = ctx->output_cur;
+  uint32_t invalid = 0;
+  for (size_t i = 0; i < blocks; i++) {
+    const uint32_t c0 = decode_table[in[0]];
+    const uint32_t c1 = decode_table[in[1]];
+    const uint32_t c2 = decode_table[in[2]];
+    const uint32_t c3 = decode_table[in[3]];
+    invalid |= c0 | c1 | c2 | c3;
+    const uint32_t block = (c0 << 18) | (c1 << 12) | (c2 << 6) | c3;
+    out[0] = static_cast<uint8_t>(block >> 16);
+    out[1] = static_cast<uint8_t>(block >> 8);
+    out[2] = static_cast<uint8_t>(block);
+    in += 4;
+    out += 3;
+  }
+  if (GPR_UNLIKELY((invalid & 0xC0) != 0)) {
+    /* find and log the offending character */
+    return input_is_valid(ctx->input_cur, blocks * 4);
+  }
+  ctx->input_cur = in;
+  ctx->output_cur = out;
+  return true;
+}
+
 #define COMPOSE_OUTPUT_BYTE_0(input_ptr)        \
   (uint8_t)((decode_table[input_ptr[0]] << 2) | \
             (decode_table[input_ptr[1]] >> 4))
@@ -110,16 +142,8 @@ bool grpc_base64_decode_partial(struct grpc_base64_decode_context* ctx) {
     return false;
   }
 
-  // Process a block of 4 input characters and 3 output bytes
-  while (ctx->input_end >= ctx->input_cur + 4 &&
-         ctx->output_end >= ctx->output_cur + 3) {
-    if (!input_is_valid(ctx->input_cur, 4)) return false;
-    ctx->output_cur[0] = COMPOSE_OUTPUT_BYTE_0(ctx->input_cur);
-    ctx->output_cur[1] = COMPOSE_OUTPUT_BYTE_1(ctx->input_cur);
-    ctx->output_cur[2] = COMPOSE_OUTPUT_BYTE_2(ctx->input_cur);
-    ctx->output_cur += 3;
-    ctx->input_cur += 4;
-  }
+  // Process blocks of 4 input characters and 3 output bytes
+  if (!decode_blocks(ctx)) return false;
 
   // Process the tail of input data
   input_tail = static_cast<size_t>(ctx->input_end - ctx->input_cur);
@@ -23,7 +23,10 @@
 #include <string.h>
 
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
 #include "src/core/ext/transport/chttp2/transport/huffsyms.h"
+#include "src/core/lib/gpr/useful.h"
 
 static const char alphabet[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -48,6 +51,18 @@ static const b64_huff_sym huff_alphabet[64] = {
 
 static const uint8_t tail_xtra[3] = {0, 2, 3};
 
+/* The two base64 symbols for every 12 bit value, so that a triplet is
+ * encoded with two lookups */
+static char b64_pairs[4096][2];
+static gpr_once b64_pairs_once = GPR_ONCE_INIT;
+
+static void init_b64_pairs(void) {
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(b64_pairs); i++) {
+    b64_pairs[i][0] = alphabet[i >> 6];
+    b64_pairs[i][1] = alphabet[i & 0x3f];
+  }
+}
+
 grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   size_t input_length = GRPC_SLICE_LENGTH(input);
   size_t input_triplets = input_length / 3;
@@ -58,12 +73,13 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   char* out = reinterpret_cast<char*> GRPC_SLICE_START_PTR(output);
   size_t i;
 
+  gpr_once_init(&b64_pairs_once, init_b64_pairs);
   /* encode full triplets */
   for (i = 0; i < input_triplets; i++) {
-    out[0] = alphabet[in[0] >> 2];
-    out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
-    out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
-    out[3] = alphabet[in[2] & 0x3f];
+    const uint32_t triplet = (static_cast<uint32_t>(in[0]) << 16) |
+                             (static_cast<uint32_t>(in[1]) << 8) | in[2];
+    memcpy(out, b64_pairs[triplet >> 12], 2);
+    memcpy(out + 2, b64_pairs[triplet & 0xfff], 2);
     out += 4;
     in += 3;
   }
@@ -92,78 +108,96 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   return output;
 }
 
-grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
-  size_t nbits;
-  const uint8_t* in;
+/* Output accumulator shared by the huffman encoders. Codes are appended to a
+ * 64 bit register which is flushed 32 bits at a time, so most input bytes cost
+ * a single branch and no store. After every append temp_length is below 32,
+ * hence any code of up to 32 bits can be appended without losing bits. */
+typedef struct {
+  uint64_t temp;
+  uint32_t temp_length;
   uint8_t* out;
-  grpc_slice output;
-  uint32_t temp = 0;
-  uint32_t temp_length = 0;
+} huff_out;
 
-  nbits = 0;
-  for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
-       ++in) {
-    nbits += grpc_chttp2_huffsyms[*in].length;
+static void enc_add(huff_out* out, uint32_t bits, uint32_t length) {
+  out->temp = (out->temp << length) | bits;
+  out->temp_length += length;
+  if (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    const uint32_t word = static_cast<uint32_t>(out->temp >> out->temp_length);
+    out->out[0] = static_cast<uint8_t>(word >> 24);
+    out->out[1] = static_cast<uint8_t>(word >> 16);
+    out->out[2] = static_cast<uint8_t>(word >> 8);
+    out->out[3] = static_cast<uint8_t>(word);
+    out->out += 4;
   }
+}
 
-  output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
-  out = GRPC_SLICE_START_PTR(output);
-  for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
-       ++in) {
-    int sym = *in;
-    temp <<= grpc_chttp2_huffsyms[sym].length;
-    temp |= grpc_chttp2_huffsyms[sym].bits;
-    temp_length += grpc_chttp2_huffsyms[sym].length;
-
-    while (temp_length > 8) {
-      temp_length -= 8;
-      *out++ = static_cast<uint8_t>(temp >> temp_length);
-    }
+/* Writes out the remaining bits, padding the last byte with ones (the prefix
+ * of EOS) as required by RFC 7541 */
+static void enc_finish(huff_out* out) {
+  while (out->temp_length >= 8) {
+    out->temp_length -= 8;
+    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
   }
-
-  if (temp_length) {
+  if (out->temp_length) {
     /* NB: the following integer arithmetic operation needs to be in its
      * expanded form due to the "integral promotion" performed (see section
      * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
      * is then required to avoid the compiler warning */
-    *out++ =
-        static_cast<uint8_t>(static_cast<uint8_t>(temp << (8u - temp_length)) |
-                             static_cast<uint8_t>(0xffu >> temp_length));
+    *out->out++ = static_cast<uint8_t>(
+        static_cast<uint8_t>(out->temp << (8u - out->temp_length)) |
+        static_cast<uint8_t>(0xffu >> out->temp_length));
+    out->temp_length = 0;
+  }
+}
+
+grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
+  const uint8_t* const start = GRPC_SLICE_START_PTR(input);
+  const uint8_t* const end = GRPC_SLICE_END_PTR(input);
+  const uint8_t* in;
+  size_t nbits = 0;
+
+  for (in = start; in != end; ++in) {
+    nbits += grpc_chttp2_huffsyms[*in].length;
+  }
+
+  grpc_slice output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
+  huff_out out;
+  out.temp = 0;
+  out.temp_length = 0;
+  out.out = GRPC_SLICE_START_PTR(output);
+  /* Only complete 32 bit words are flushed before enc_finish(), so this never
+   * writes past the exactly sized output */
+  for (in = start; in != end; ++in) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[*in];
+    enc_add(&out, sym.bits, sym.length);
   }
+  enc_finish(&out);
 
-  GPR_ASSERT(out == GRPC_SLICE_END_PTR(output));
+  GPR_ASSERT(out.out == GRPC_SLICE_END_PTR(output));
 
   return output;
 }
 
-typedef struct {
-  uint32_t temp;
-  uint32_t temp_length;
-  uint8_t* out;
-} huff_out;
+/* Huffman codes for every pair of base64 symbols, indexed by the 12 input bits
+ * that the pair encodes. Each entry is (bits << 5) | length; a pair is at most
+ * 22 bits long. This lets the base64+huffman encoder emit a whole input
+ * triplet with two lookups. */
+static uint32_t b64_huff_pairs[4096];
+static gpr_once b64_huff_pairs_once = GPR_ONCE_INIT;
 
-static void enc_flush_some(huff_out* out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
+static void init_b64_huff_pairs(void) {
+  for (uint32_t i = 0; i < GPR_ARRAY_SIZE(b64_huff_pairs); i++) {
+    const b64_huff_sym sa = huff_alphabet[i >> 6];
+    const b64_huff_sym sb = huff_alphabet[i & 0x3f];
+    const uint32_t bits = (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits;
+    b64_huff_pairs[i] = (bits << 5) | (sa.length + sb.length);
   }
 }
 
-static void enc_add2(huff_out* out, uint8_t a, uint8_t b) {
-  b64_huff_sym sa = huff_alphabet[a];
-  b64_huff_sym sb = huff_alphabet[b];
-  out->temp = (out->temp << (sa.length + sb.length)) |
-              (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits;
-  out->temp_length +=
-      static_cast<uint32_t>(sa.length) + static_cast<uint32_t>(sb.length);
-  enc_flush_some(out);
-}
-
-static void enc_add1(huff_out* out, uint8_t a) {
-  b64_huff_sym sa = huff_alphabet[a];
-  out->temp = (out->temp << sa.length) | sa.bits;
-  out->temp_length += sa.length;
-  enc_flush_some(out);
+static void enc_add_pair(huff_out* out, uint32_t index) {
+  const uint32_t pair = b64_huff_pairs[index];
+  enc_add(out, pair >> 5, pair & 0x1f);
 }
 
 grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
@@ -180,19 +214,18 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
   huff_out out;
   size_t i;
 
+  gpr_once_init(&b64_huff_pairs_once, init_b64_huff_pairs);
+
   out.temp = 0;
   out.temp_length = 0;
   out.out = start_out;
 
-  /* encode full triplets */
+  /* encode full triplets: the 24 input bits are two 12 bit symbol pairs */
   for (i = 0; i < input_triplets; i++) {
-    const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-    const uint8_t high_to_low = in[1] >> 4;
-    enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-
-    const uint8_t a = static_cast<uint8_t>((in[1] & 0xf) << 2);
-    const uint8_t b = (in[2] >> 6);
-    enc_add2(&out, a | b, in[2] & 0x3f);
+    const uint32_t triplet = (static_cast<uint32_t>(in[0]) << 16) |
+                             (static_cast<uint32_t>(in[1]) << 8) | in[2];
+    enc_add_pair(&out, triplet >> 12);
+    enc_add_pair(&out, triplet & 0xfff);
     in += 3;
   }
 
@@ -201,28 +234,21 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     case 0:
       break;
     case 1:
-      enc_add2(&out, in[0] >> 2, static_cast<uint8_t>((in[0] & 0x3) << 4));
+      enc_add_pair(&out, static_cast<uint32_t>(in[0]) << 4);
       in += 1;
       break;
     case 2: {
-      const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-      const uint8_t high_to_low = in[1] >> 4;
-      enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-      enc_add1(&out, static_cast<uint8_t>((in[1] & 0xf) << 2));
+      const uint32_t pair =
+          (static_cast<uint32_t>(in[0]) << 4) | (in[1] >> 4);
+      enc_add_pair(&out, pair);
+      const b64_huff_sym sym = huff_alphabet[(in[1] & 0xf) << 2];
+      enc_add(&out, sym.bits, sym.length);
       in += 2;
       break;
     }
   }
 
-  if (out.temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out.out++ = static_cast<uint8_t>(
-        static_cast<uint8_t>(out.temp << (8u - out.temp_length)) |
-        static_cast<uint8_t>(0xffu >> out.temp_length));
-  }
+  enc_finish(&out);
 
   GPR_ASSERT(out.out <= GRPC_SLICE_END_PTR(output));
   GRPC_SLICE_SET_LENGTH(output, out.out - start_out);
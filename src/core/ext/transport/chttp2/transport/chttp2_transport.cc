@@ -30,11 +30,13 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/time.h>
 
 #include "src/core/ext/transport/chttp2/transport/context_list.h"
 #include "src/core/ext/transport/chttp2/transport/frame_data.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
+#include "src/core/lib/channel/call_latency_breakdown.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/compression/stream_compression.h"
 #include "src/core/lib/debug/stats.h"
@@ -43,9 +45,11 @@
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/http/parser.h"
 #include "src/core/lib/iomgr/executor.h"
+#include "src/core/lib/iomgr/internal_errqueue.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/error_utils.h"
@@ -76,6 +80,16 @@
 
 #define DEFAULT_MAX_PENDING_INDUCED_FRAMES 10000
 
+#define MAX_WRITE_COALESCING_WINDOW_US 10000 /* 10 milliseconds */
+#define DEFAULT_WRITE_COALESCING_MAX_BYTES (64 * 1024)
+#define DEFAULT_IDLE_RELEASE_MS 30000 /* 30 seconds */
+
+/* Writes of more slices than this have their small slices (frame headers,
+   hpack output, short messages) copied together, so that the endpoint can
+   usually send the whole write with a single sendmsg */
+#define WRITE_COMPACTION_MIN_SLICES 16
+#define WRITE_COMPACTION_MAX_SLICE_BYTES 256
+
 static int g_default_client_keepalive_time_ms =
     DEFAULT_CLIENT_KEEPALIVE_TIME_MS;
 static int g_default_client_keepalive_timeout_ms =
@@ -105,6 +119,7 @@ grpc_core::DebugOnlyTraceFlag grpc_trace_chttp2_refcount(false,
 static void write_action_begin_locked(void* t, grpc_error* error);
 static void write_action(void* t, grpc_error* error);
 static void write_action_end_locked(void* t, grpc_error* error);
+static void write_coalescing_timer_fired_locked(void* t, grpc_error* error);
 
 static void read_action_locked(void* t, grpc_error* error);
 static void continue_read_action_locked(grpc_chttp2_transport* t);
@@ -152,6 +167,12 @@ static void keepalive_watchdog_fired_locked(void* arg, grpc_error* error);
 
 static void reset_byte_stream(void* arg, grpc_error* error);
 
+static void graceful_goaway_ping_acked_locked(void* arg, grpc_error* error);
+static void graceful_goaway_timer_fired_locked(void* arg, grpc_error* error);
+
+static void schedule_idle_release(grpc_chttp2_transport* t);
+static void idle_release_locked(void* arg, grpc_error* error);
+
 // Flow control default enabled. Can be disabled by setting
 // GRPC_EXPERIMENTAL_DISABLE_FLOW_CONTROL
 bool g_flow_control_enabled = true;
@@ -192,6 +213,7 @@ grpc_chttp2_transport::~grpc_chttp2_transport() {
   }
 
   GRPC_ERROR_UNREF(goaway_error);
+  GRPC_ERROR_UNREF(graceful_goaway_error);
 
   GPR_ASSERT(grpc_chttp2_stream_map_size(&stream_map) == 0);
 
@@ -282,9 +304,42 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
       t->write_buffer_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
           &channel_args->args[i], {0, 0, MAX_WRITE_BUFFER_SIZE}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_QUANTUM_BYTES)) {
+      t->write_quantum = static_cast<uint32_t>(grpc_channel_arg_get_integer(
+          &channel_args->args[i], {64 * 1024, 0, MAX_WRITE_BUFFER_SIZE}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_MAX_CONTIGUOUS_RECV_MESSAGE_SIZE)) {
+      t->max_contiguous_recv_message_size =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i], {0, 0, INT_MAX}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US)) {
+      t->write_coalescing_window_us = grpc_channel_arg_get_integer(
+          &channel_args->args[i], {0, 0, MAX_WRITE_COALESCING_WINDOW_US});
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_IDLE_RELEASE_MS)) {
+      const int value = grpc_channel_arg_get_integer(
+          &channel_args->args[i], {DEFAULT_IDLE_RELEASE_MS, 0, INT_MAX});
+      t->idle_release_timeout =
+          value == 0 || value == INT_MAX ? GRPC_MILLIS_INF_FUTURE : value;
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_MAX_BYTES)) {
+      t->write_coalescing_max_bytes =
+          static_cast<size_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i], {DEFAULT_WRITE_COALESCING_MAX_BYTES, 0,
+                                       MAX_WRITE_BUFFER_SIZE}));
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_MEMORY_BUDGET_WINDOWS)) {
+      t->memory_budget_windows =
+          grpc_channel_arg_get_bool(&channel_args->args[i], false);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_BDP_DELIVERY_RATE_ESTIMATION)) {
+      t->bdp_delivery_rate_estimation =
+          grpc_channel_arg_get_bool(&channel_args->args[i], false);
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_KEEPALIVE_TIME_MS)) {
       const int value = grpc_channel_arg_get_integer(
@@ -394,7 +449,7 @@ static bool read_channel_args(grpc_chttp2_transport* t,
 
 static void init_transport_closures(grpc_chttp2_transport* t) {
   GRPC_CLOSURE_INIT(&t->read_action_locked, read_action_locked, t,
-                    grpc_combiner_scheduler(t->combiner));
+                    grpc_combiner_urgent_scheduler(t->combiner));
   GRPC_CLOSURE_INIT(&t->benign_reclaimer_locked, benign_reclaimer_locked, t,
                     grpc_combiner_scheduler(t->combiner));
   GRPC_CLOSURE_INIT(&t->destructive_reclaimer_locked,
@@ -420,6 +475,14 @@ static void init_transport_closures(grpc_chttp2_transport* t) {
   GRPC_CLOSURE_INIT(&t->keepalive_watchdog_fired_locked,
                     keepalive_watchdog_fired_locked, t,
                     grpc_combiner_scheduler(t->combiner));
+  GRPC_CLOSURE_INIT(&t->graceful_goaway_ping_acked_locked,
+                    graceful_goaway_ping_acked_locked, t,
+                    grpc_combiner_scheduler(t->combiner));
+  GRPC_CLOSURE_INIT(&t->graceful_goaway_timer_fired_locked,
+                    graceful_goaway_timer_fired_locked, t,
+                    grpc_combiner_scheduler(t->combiner));
+  GRPC_CLOSURE_INIT(&t->idle_release_locked, idle_release_locked, t,
+                    grpc_combiner_scheduler(t->combiner));
 }
 
 static void init_transport_keepalive_settings(grpc_chttp2_transport* t) {
@@ -453,13 +516,28 @@ static void configure_transport_ping_policy(grpc_chttp2_transport* t) {
       g_default_min_recv_ping_interval_without_data_ms;
 }
 
+/* When the keepalive ping timer should fire, for a ping due keepalive_time
+   after from: rounded up to a slot of keepalive_time / 16, at most a second,
+   so that the timers of transports with the same keepalive time expire in the
+   same timer check rather than each waking the timer manager. */
+static grpc_millis keepalive_ping_deadline(grpc_chttp2_transport* t,
+                                           grpc_millis from) {
+  if (t->keepalive_time == GRPC_MILLIS_INF_FUTURE) {
+    return GRPC_MILLIS_INF_FUTURE;
+  }
+  const grpc_millis slot = GPR_CLAMP(t->keepalive_time / 16, 1, 1000);
+  const grpc_millis due = from + t->keepalive_time;
+  return (due + slot - 1) / slot * slot;
+}
+
 static void init_keepalive_pings_if_enabled(grpc_chttp2_transport* t) {
   if (t->keepalive_time != GRPC_MILLIS_INF_FUTURE) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
     GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    grpc_timer_init(
+        &t->keepalive_ping_timer,
+        keepalive_ping_deadline(t, grpc_core::ExecCtx::Get()->Now()),
+        &t->init_keepalive_ping_locked);
   } else {
     /* Use GRPC_CHTTP2_KEEPALIVE_STATE_DISABLED to indicate there are no
        inflight keeaplive timers */
@@ -524,6 +602,7 @@ grpc_chttp2_transport::grpc_chttp2_transport(
 
   configure_transport_ping_policy(this);
   init_transport_keepalive_settings(this);
+  idle_release_timeout = DEFAULT_IDLE_RELEASE_MS;
 
   bool enable_bdp = true;
   if (channel_args) {
@@ -531,8 +610,8 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   }
 
   if (g_flow_control_enabled) {
-    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(this,
-                                                               enable_bdp);
+    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(
+        this, enable_bdp, memory_budget_windows, bdp_delivery_rate_estimation);
   } else {
     flow_control.Init<grpc_core::chttp2::TransportFlowControlDisabled>(this);
     enable_bdp = false;
@@ -555,6 +634,9 @@ grpc_chttp2_transport::grpc_chttp2_transport(
                                       nullptr);
   }
 
+  idle_since = grpc_core::ExecCtx::Get()->Now();
+  schedule_idle_release(this);
+
   grpc_chttp2_initiate_write(this, GRPC_CHTTP2_INITIATE_WRITE_INITIAL_WRITE);
   post_benign_reclaimer(this);
 }
@@ -605,6 +687,16 @@ static void close_transport_locked(grpc_chttp2_transport* t,
     if (t->have_next_bdp_ping_timer) {
       grpc_timer_cancel(&t->next_bdp_ping_timer);
     }
+    if (t->have_idle_release_timer) {
+      grpc_timer_cancel(&t->idle_release_timer);
+    }
+    if (t->sent_goaway_state == GRPC_CHTTP2_GRACEFUL_GOAWAY_SENT) {
+      grpc_timer_cancel(&t->graceful_goaway_timer);
+    }
+    if (t->write_coalescing_timer_pending) {
+      /* a held write is released to find the transport closed */
+      grpc_timer_cancel(&t->write_coalescing_timer);
+    }
     switch (t->keepalive_state) {
       case GRPC_CHTTP2_KEEPALIVE_STATE_WAITING:
         grpc_timer_cancel(&t->keepalive_ping_timer);
@@ -665,12 +757,13 @@ grpc_chttp2_stream::grpc_chttp2_stream(grpc_chttp2_transport* t,
     : t(t),
       refcount(refcount),
       reffer(this),
-      metadata_buffer{grpc_chttp2_incoming_metadata_buffer(arena),
-                      grpc_chttp2_incoming_metadata_buffer(arena)} {
+      arena(arena),
+      initial_metadata_buffer(arena) {
   if (server_data) {
     id = static_cast<uint32_t>((uintptr_t)server_data);
     *t->accepting_stream = this;
     grpc_chttp2_stream_map_add(&t->stream_map, id, this);
+    GRPC_USDT2(stream_open, t, id);
     post_destructive_reclaimer(t);
   }
   if (t->flow_control->flow_control_enabled()) {
@@ -692,6 +785,23 @@ grpc_chttp2_stream::grpc_chttp2_stream(grpc_chttp2_transport* t,
                     grpc_combiner_scheduler(t->combiner));
 }
 
+grpc_chttp2_stream_compression* grpc_chttp2_stream_get_compression(
+    grpc_chttp2_stream* s) {
+  if (s->compression == nullptr) {
+    s->compression = s->arena->New<grpc_chttp2_stream_compression>();
+  }
+  return s->compression;
+}
+
+grpc_chttp2_incoming_metadata_buffer*
+grpc_chttp2_stream_get_trailing_metadata_buffer(grpc_chttp2_stream* s) {
+  if (s->trailing_metadata_buffer == nullptr) {
+    s->trailing_metadata_buffer =
+        s->arena->New<grpc_chttp2_incoming_metadata_buffer>(s->arena);
+  }
+  return s->trailing_metadata_buffer;
+}
+
 grpc_chttp2_stream::~grpc_chttp2_stream() {
   if (t->channelz_socket != nullptr) {
     if ((t->is_client && eos_received) || (!t->is_client && eos_sent)) {
@@ -708,12 +818,12 @@ grpc_chttp2_stream::~grpc_chttp2_stream() {
 
   grpc_slice_buffer_destroy_internal(&unprocessed_incoming_frames_buffer);
   grpc_slice_buffer_destroy_internal(&frame_storage);
-  if (stream_compression_method != GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS) {
-    grpc_slice_buffer_destroy_internal(&compressed_data_buffer);
+  /* both were allocated from the arena, which frees their memory */
+  if (compression != nullptr) {
+    compression->~grpc_chttp2_stream_compression();
   }
-  if (stream_decompression_method !=
-      GRPC_STREAM_COMPRESSION_IDENTITY_DECOMPRESS) {
-    grpc_slice_buffer_destroy_internal(&decompressed_data_buffer);
+  if (trailing_metadata_buffer != nullptr) {
+    trailing_metadata_buffer->~grpc_chttp2_incoming_metadata_buffer();
   }
 
   grpc_chttp2_list_remove_stalled_by_transport(t, this);
@@ -768,17 +878,17 @@ static void destroy_stream(grpc_transport* gt, grpc_stream* gs,
   GPR_TIMER_SCOPE("destroy_stream", 0);
   grpc_chttp2_transport* t = reinterpret_cast<grpc_chttp2_transport*>(gt);
   grpc_chttp2_stream* s = reinterpret_cast<grpc_chttp2_stream*>(gs);
-  if (s->stream_compression_method !=
-          GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS &&
-      s->stream_compression_ctx != nullptr) {
-    grpc_stream_compression_context_destroy(s->stream_compression_ctx);
-    s->stream_compression_ctx = nullptr;
-  }
-  if (s->stream_decompression_method !=
-          GRPC_STREAM_COMPRESSION_IDENTITY_DECOMPRESS &&
-      s->stream_decompression_ctx != nullptr) {
-    grpc_stream_compression_context_destroy(s->stream_decompression_ctx);
-    s->stream_decompression_ctx = nullptr;
+  if (s->compression != nullptr) {
+    if (s->compression->stream_compression_ctx != nullptr) {
+      grpc_stream_compression_context_destroy(
+          s->compression->stream_compression_ctx);
+      s->compression->stream_compression_ctx = nullptr;
+    }
+    if (s->compression->stream_decompression_ctx != nullptr) {
+      grpc_stream_compression_context_destroy(
+          s->compression->stream_decompression_ctx);
+      s->compression->stream_decompression_ctx = nullptr;
+    }
   }
 
   s->destroy_stream_arg = then_schedule_closure;
@@ -920,6 +1030,71 @@ static void inc_initiate_write_reason(
   }
 }
 
+/* A write is held back only if it carries stream frames and follows closely
+   on the end of the previous write: that is, when the connection sees a burst
+   of small writes from many streams, each of which would otherwise cost an
+   endpoint write of its own. Isolated writes go out immediately. */
+static bool should_coalesce_write(grpc_chttp2_transport* t,
+                                  grpc_chttp2_initiate_write_reason reason) {
+  if (t->write_coalescing_window_us == 0 || t->write_coalescing_timer_pending ||
+      t->write_coalescing_bytes >= t->write_coalescing_max_bytes) {
+    return false;
+  }
+  switch (reason) {
+    case GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_MESSAGE:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_INITIAL_METADATA:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_TRAILING_METADATA:
+      break;
+    default:
+      return false;
+  }
+  gpr_timespec since_last_write =
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), t->last_write_end);
+  return gpr_time_cmp(since_last_write,
+                      gpr_time_from_micros(t->write_coalescing_window_us,
+                                           GPR_TIMESPAN)) < 0;
+}
+
+/* The write is released by a timer, so that no thread waits out the window.
+   Timers fire at millisecond granularity, so the window is rounded up to
+   whole milliseconds here; it stays exact for telling whether writes come
+   close together. */
+static void start_write_coalescing_locked(grpc_chttp2_transport* t) {
+  GRPC_STATS_INC_HTTP2_WRITES_COALESCED();
+  t->write_coalescing = true;
+  t->write_coalescing_timer_pending = true;
+  GRPC_CHTTP2_REF_TRANSPORT(t, "write_coalescing_timer");
+  grpc_timer_init(
+      &t->write_coalescing_timer,
+      grpc_core::ExecCtx::Get()->Now() +
+          (t->write_coalescing_window_us + GPR_US_PER_MS - 1) / GPR_US_PER_MS,
+      GRPC_CLOSURE_INIT(&t->write_coalescing_timer_fired_locked,
+                        write_coalescing_timer_fired_locked, t,
+                        grpc_combiner_scheduler(t->combiner)));
+}
+
+static void release_coalesced_write_locked(grpc_chttp2_transport* t) {
+  t->write_coalescing = false;
+  GRPC_CLOSURE_SCHED(
+      GRPC_CLOSURE_INIT(&t->write_action_begin_locked,
+                        write_action_begin_locked, t,
+                        grpc_combiner_finally_scheduler(t->combiner)),
+      GRPC_ERROR_NONE);
+}
+
+static void write_coalescing_timer_fired_locked(void* gt,
+                                                grpc_error* error_ignored) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
+  t->write_coalescing_timer_pending = false;
+  /* the write may already have been released by the byte bound, in which
+     case the timer was cancelled */
+  if (t->write_coalescing) {
+    release_coalesced_write_locked(t);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "write_coalescing_timer");
+}
+
 void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                                 grpc_chttp2_initiate_write_reason reason) {
   GPR_TIMER_SCOPE("grpc_chttp2_initiate_write", 0);
@@ -931,6 +1106,10 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                       grpc_chttp2_initiate_write_reason_string(reason));
       t->is_first_write_in_batch = true;
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
+      if (should_coalesce_write(t, reason)) {
+        start_write_coalescing_locked(t);
+        break;
+      }
       /* Note that the 'write_action_begin_locked' closure is being scheduled
        * on the 'finally_scheduler' of t->combiner. This means that
        * 'write_action_begin_locked' is called only *after* all the other
@@ -960,6 +1139,11 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
       break;
   }
+  if (t->write_coalescing &&
+      t->write_coalescing_bytes >= t->write_coalescing_max_bytes) {
+    release_coalesced_write_locked(t);
+    grpc_timer_cancel(&t->write_coalescing_timer);
+  }
 }
 
 void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
@@ -975,28 +1159,28 @@ static grpc_closure_scheduler* write_scheduler(grpc_chttp2_transport* t,
                                                bool partial_write) {
   // If we're already in a background poller, don't offload this to an executor
   if (grpc_iomgr_is_any_background_poller_thread()) {
-    return grpc_schedule_on_exec_ctx;
+    return grpc_schedule_on_exec_ctx_urgent;
   }
   /* if it's not the first write in a batch, always offload to the executor:
      we'll probably end up queuing against the kernel anyway, so we'll likely
      get better latency overall if we switch writing work elsewhere and continue
      with application work above */
   if (!t->is_first_write_in_batch) {
-    return grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::SHORT);
+    return grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::URGENT);
   }
   /* equivalently, if it's a partial write, we *know* we're going to be taking a
      thread jump to write it because of the above, may as well do so
      immediately */
   if (partial_write) {
-    return grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::SHORT);
+    return grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::URGENT);
   }
   switch (t->opt_target) {
     case GRPC_CHTTP2_OPTIMIZE_FOR_THROUGHPUT:
       /* executor gives us the largest probability of being able to batch a
        * write with others on this transport */
-      return grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::SHORT);
+      return grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::URGENT);
     case GRPC_CHTTP2_OPTIMIZE_FOR_LATENCY:
-      return grpc_schedule_on_exec_ctx;
+      return grpc_schedule_on_exec_ctx_urgent;
   }
   GPR_UNREACHABLE_CODE(return nullptr);
 }
@@ -1021,6 +1205,7 @@ static void write_action_begin_locked(void* gt, grpc_error* error_ignored) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   GPR_ASSERT(t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE);
   grpc_chttp2_begin_write_result r;
+  t->write_coalescing_bytes = 0;
   if (t->closed_with_error != GRPC_ERROR_NONE) {
     r.writing = false;
   } else {
@@ -1035,14 +1220,18 @@ static void write_action_begin_locked(void* gt, grpc_error* error_ignored) {
     }
     grpc_closure_scheduler* scheduler =
         write_scheduler(t, r.early_results_scheduled, r.partial);
-    if (scheduler != grpc_schedule_on_exec_ctx) {
+    if (scheduler != grpc_schedule_on_exec_ctx_urgent) {
       GRPC_STATS_INC_HTTP2_WRITES_OFFLOADED();
     }
     set_write_state(
         t,
         r.partial ? GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE
                   : GRPC_CHTTP2_WRITE_STATE_WRITING,
-        begin_writing_desc(r.partial, scheduler == grpc_schedule_on_exec_ctx));
+        begin_writing_desc(r.partial,
+                           scheduler == grpc_schedule_on_exec_ctx_urgent));
+    /* a partial write stopped at the write size limit: the next one starts as
+       soon as it completes */
+    grpc_endpoint_set_write_hint(t->ep, r.partial);
     GRPC_CLOSURE_SCHED(
         GRPC_CLOSURE_INIT(&t->write_action, write_action, t, scheduler),
         GRPC_ERROR_NONE);
@@ -1071,6 +1260,10 @@ static void write_action(void* gt, grpc_error* error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   void* cl = t->cl;
   t->cl = nullptr;
+  if (t->outbuf.count > WRITE_COMPACTION_MIN_SLICES) {
+    grpc_slice_buffer_coalesce_small_slices(&t->outbuf,
+                                            WRITE_COMPACTION_MAX_SLICE_BYTES);
+  }
   grpc_endpoint_write(
       t->ep, &t->outbuf,
       GRPC_CLOSURE_INIT(&t->write_action_end_locked, write_action_end_locked, t,
@@ -1084,6 +1277,10 @@ static void write_action_end_locked(void* tp, grpc_error* error) {
   GPR_TIMER_SCOPE("terminate_writing_with_lock", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
 
+  if (t->write_coalescing_window_us != 0) {
+    t->last_write_end = gpr_now(GPR_CLOCK_MONOTONIC);
+  }
+
   bool closed = false;
   if (error != GRPC_ERROR_NONE) {
     close_transport_locked(t, GRPC_ERROR_REF(error));
@@ -1207,6 +1404,7 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
               GRPC_ERROR_CREATE_FROM_STATIC_STRING("GOAWAY received"),
               GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
     }
+    grpc_chttp2_update_available_streams(t);
     return;
   }
   /* start streams where we have free grpc_chttp2_stream ids and free
@@ -1232,6 +1430,7 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
     }
 
     grpc_chttp2_stream_map_add(&t->stream_map, s->id, s);
+    GRPC_USDT2(stream_open, t, s->id);
     post_destructive_reclaimer(t);
     grpc_chttp2_mark_stream_writable(t, s);
     grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM);
@@ -1246,6 +1445,23 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
               GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
     }
   }
+  grpc_chttp2_update_available_streams(t);
+}
+
+void grpc_chttp2_update_available_streams(grpc_chttp2_transport* t) {
+  int64_t available = 0;
+  if (t->goaway_error == GRPC_ERROR_NONE &&
+      t->closed_with_error == GRPC_ERROR_NONE &&
+      t->next_stream_id < MAX_CLIENT_STREAM_ID &&
+      t->lists[GRPC_CHTTP2_LIST_WAITING_FOR_CONCURRENCY].head == nullptr) {
+    const int64_t limit = t->settings[GRPC_PEER_SETTINGS]
+                                     [GRPC_CHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS];
+    const int64_t in_use = grpc_chttp2_stream_map_size(&t->stream_map);
+    available = limit - in_use;
+    available = GPR_CLAMP(available, 0, INT32_MAX);
+  }
+  t->available_streams.Store(static_cast<int32_t>(available),
+                             grpc_core::MemoryOrder::RELAXED);
 }
 
 /* Flag that this closure barrier may be covering a write in a pollset, and so
@@ -1430,6 +1646,8 @@ static void perform_stream_op_locked(void* stream_op,
 
   s->context = op->payload->context;
   s->traced = op->is_traced;
+  grpc_core::CallLatencyRecord(op->payload->context,
+                               grpc_core::CallLatencyStage::kTransportOpStarted);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
     char* str = grpc_transport_stream_op_batch_string(op);
     gpr_log(GPR_INFO, "perform_stream_op_locked: %s; on_complete = %p", str,
@@ -1479,9 +1697,7 @@ static void perform_stream_op_locked(void* stream_op,
     }
     if (s->stream_compression_method !=
         GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS) {
-      s->uncompressed_data_size = 0;
-      s->stream_compression_ctx = nullptr;
-      grpc_slice_buffer_init(&s->compressed_data_buffer);
+      grpc_chttp2_stream_get_compression(s);
     }
     s->send_initial_metadata_finished = add_closure_barrier(on_complete);
     s->send_initial_metadata =
@@ -1556,6 +1772,8 @@ static void perform_stream_op_locked(void* stream_op,
     t->num_messages_in_next_write++;
     GRPC_STATS_INC_HTTP2_SEND_MESSAGE_SIZE(
         op->payload->send_message.send_message->length());
+    t->write_coalescing_bytes +=
+        op->payload->send_message.send_message->length();
     on_complete->next_data.scratch |= CLOSURE_BARRIER_MAY_COVER_WRITE;
     s->fetching_send_message_finished = add_closure_barrier(op->on_complete);
     if (s->write_closed) {
@@ -1818,10 +2036,14 @@ void grpc_chttp2_ack_ping(grpc_chttp2_transport* t, uint64_t id) {
   }
 }
 
-static void send_goaway(grpc_chttp2_transport* t, grpc_error* error) {
+/* Sends a GOAWAY with the last stream id we have seen */
+static void send_final_goaway(grpc_chttp2_transport* t, grpc_error* error) {
   /* We want to log this irrespective of whether http tracing is enabled */
   gpr_log(GPR_INFO, "%s: Sending goaway err=%s", t->peer_string,
           grpc_error_string(error));
+  if (t->sent_goaway_state == GRPC_CHTTP2_GRACEFUL_GOAWAY_SENT) {
+    grpc_timer_cancel(&t->graceful_goaway_timer);
+  }
   t->sent_goaway_state = GRPC_CHTTP2_GOAWAY_SEND_SCHEDULED;
   grpc_http2_error_code http_error;
   grpc_slice slice;
@@ -1834,6 +2056,72 @@ static void send_goaway(grpc_chttp2_transport* t, grpc_error* error) {
   GRPC_ERROR_UNREF(error);
 }
 
+static void send_goaway(grpc_chttp2_transport* t, grpc_error* error) {
+  grpc_http2_error_code http_error;
+  grpc_slice slice;
+  grpc_error_get_status(error, GRPC_MILLIS_INF_FUTURE, nullptr, &slice,
+                        &http_error, nullptr);
+  if (http_error != GRPC_HTTP2_NO_ERROR) {
+    send_final_goaway(t, error);
+    return;
+  }
+  if (t->sent_goaway_state == GRPC_CHTTP2_GRACEFUL_GOAWAY_SENT) {
+    /* the final GOAWAY follows anyway */
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  if (t->is_client || t->sent_goaway_state != GRPC_CHTTP2_NO_GOAWAY_SEND) {
+    send_final_goaway(t, error);
+    return;
+  }
+  /* Shut down gracefully, as RFC 7540 section 6.8 suggests: a first GOAWAY
+     with the maximum stream id tells the client to stop opening streams, and
+     only once a ping round trip shows it has seen that does the final one
+     carry our last stream id, which then covers every stream the client
+     opened in the meantime instead of leaving them to be refused. */
+  gpr_log(GPR_INFO, "%s: Sending graceful goaway err=%s", t->peer_string,
+          grpc_error_string(error));
+  t->sent_goaway_state = GRPC_CHTTP2_GRACEFUL_GOAWAY_SENT;
+  GRPC_ERROR_UNREF(t->graceful_goaway_error);
+  t->graceful_goaway_error = error;
+  grpc_chttp2_goaway_append((1u << 31) - 1, GRPC_HTTP2_NO_ERROR,
+                            grpc_slice_ref_internal(slice), &t->qbuf);
+  GRPC_CHTTP2_REF_TRANSPORT(t, "graceful_goaway_ping");
+  send_ping_locked(t, nullptr, &t->graceful_goaway_ping_acked_locked);
+  /* don't wait longer for the ack than keepalive would */
+  GRPC_CHTTP2_REF_TRANSPORT(t, "graceful_goaway_timer");
+  grpc_timer_init(&t->graceful_goaway_timer,
+                  grpc_core::ExecCtx::Get()->Now() + t->keepalive_timeout,
+                  &t->graceful_goaway_timer_fired_locked);
+  grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_GOAWAY_SENT);
+}
+
+static void finish_graceful_goaway(grpc_chttp2_transport* t) {
+  if (t->sent_goaway_state != GRPC_CHTTP2_GRACEFUL_GOAWAY_SENT ||
+      t->closed_with_error != GRPC_ERROR_NONE) {
+    return;
+  }
+  grpc_error* error = t->graceful_goaway_error;
+  t->graceful_goaway_error = GRPC_ERROR_NONE;
+  send_final_goaway(t, error);
+}
+
+static void graceful_goaway_ping_acked_locked(void* arg, grpc_error* error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    finish_graceful_goaway(t);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "graceful_goaway_ping");
+}
+
+static void graceful_goaway_timer_fired_locked(void* arg, grpc_error* error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    finish_graceful_goaway(t);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "graceful_goaway_timer");
+}
+
 void grpc_chttp2_add_ping_strike(grpc_chttp2_transport* t) {
   if (++t->ping_recv_state.ping_strikes > t->ping_policy.max_ping_strikes &&
       t->ping_policy.max_ping_strikes != 0) {
@@ -1923,7 +2211,7 @@ void grpc_chttp2_maybe_complete_recv_initial_metadata(grpc_chttp2_transport* t,
             &s->unprocessed_incoming_frames_buffer);
       }
     }
-    grpc_chttp2_incoming_metadata_buffer_publish(&s->metadata_buffer[0],
+    grpc_chttp2_incoming_metadata_buffer_publish(&s->initial_metadata_buffer,
                                                  s->recv_initial_metadata);
     null_then_sched_closure(&s->recv_initial_metadata_ready);
   }
@@ -1952,18 +2240,19 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
         if (!s->unprocessed_incoming_frames_decompressed &&
             s->stream_decompression_method !=
                 GRPC_STREAM_COMPRESSION_IDENTITY_DECOMPRESS) {
-          GPR_ASSERT(s->decompressed_data_buffer.length == 0);
+          grpc_chttp2_stream_compression* c = s->compression;
+          GPR_ASSERT(c->decompressed_data_buffer.length == 0);
           bool end_of_context;
-          if (!s->stream_decompression_ctx) {
-            s->stream_decompression_ctx =
+          if (!c->stream_decompression_ctx) {
+            c->stream_decompression_ctx =
                 grpc_stream_compression_context_create(
                     s->stream_decompression_method);
           }
           if (!grpc_stream_decompress(
-                  s->stream_decompression_ctx,
+                  c->stream_decompression_ctx,
                   &s->unprocessed_incoming_frames_buffer,
-                  &s->decompressed_data_buffer, nullptr,
-                  GRPC_HEADER_SIZE_IN_BYTES - s->decompressed_header_bytes,
+                  &c->decompressed_data_buffer, nullptr,
+                  GRPC_HEADER_SIZE_IN_BYTES - c->decompressed_header_bytes,
                   &end_of_context)) {
             grpc_slice_buffer_reset_and_unref_internal(&s->frame_storage);
             grpc_slice_buffer_reset_and_unref_internal(
@@ -1971,17 +2260,17 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
             error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
                 "Stream decompression error.");
           } else {
-            s->decompressed_header_bytes += s->decompressed_data_buffer.length;
-            if (s->decompressed_header_bytes == GRPC_HEADER_SIZE_IN_BYTES) {
-              s->decompressed_header_bytes = 0;
+            c->decompressed_header_bytes += c->decompressed_data_buffer.length;
+            if (c->decompressed_header_bytes == GRPC_HEADER_SIZE_IN_BYTES) {
+              c->decompressed_header_bytes = 0;
             }
             error = grpc_deframe_unprocessed_incoming_frames(
-                &s->data_parser, s, &s->decompressed_data_buffer, nullptr,
+                &s->data_parser, s, &c->decompressed_data_buffer, nullptr,
                 s->recv_message);
             if (end_of_context) {
               grpc_stream_compression_context_destroy(
-                  s->stream_decompression_ctx);
-              s->stream_decompression_ctx = nullptr;
+                  c->stream_decompression_ctx);
+              c->stream_decompression_ctx = nullptr;
             }
           }
         } else {
@@ -2043,13 +2332,14 @@ void grpc_chttp2_maybe_complete_recv_trailing_metadata(grpc_chttp2_transport* t,
           pending_data = true;
         }
       } else {
+        grpc_chttp2_stream_compression* c = s->compression;
         bool end_of_context;
-        if (!s->stream_decompression_ctx) {
-          s->stream_decompression_ctx = grpc_stream_compression_context_create(
+        if (!c->stream_decompression_ctx) {
+          c->stream_decompression_ctx = grpc_stream_compression_context_create(
               s->stream_decompression_method);
         }
         if (!grpc_stream_decompress(
-                s->stream_decompression_ctx, &s->frame_storage,
+                c->stream_decompression_ctx, &s->frame_storage,
                 &s->unprocessed_incoming_frames_buffer, nullptr,
                 GRPC_HEADER_SIZE_IN_BYTES, &end_of_context)) {
           grpc_slice_buffer_reset_and_unref_internal(&s->frame_storage);
@@ -2063,8 +2353,8 @@ void grpc_chttp2_maybe_complete_recv_trailing_metadata(grpc_chttp2_transport* t,
           }
           if (end_of_context) {
             grpc_stream_compression_context_destroy(
-                s->stream_decompression_ctx);
-            s->stream_decompression_ctx = nullptr;
+                c->stream_decompression_ctx);
+            c->stream_decompression_ctx = nullptr;
           }
         }
       }
@@ -2073,8 +2363,10 @@ void grpc_chttp2_maybe_complete_recv_trailing_metadata(grpc_chttp2_transport* t,
         s->recv_trailing_metadata_finished != nullptr) {
       grpc_transport_move_stats(&s->stats, s->collecting_stats);
       s->collecting_stats = nullptr;
-      grpc_chttp2_incoming_metadata_buffer_publish(&s->metadata_buffer[1],
-                                                   s->recv_trailing_metadata);
+      if (s->trailing_metadata_buffer != nullptr) {
+        grpc_chttp2_incoming_metadata_buffer_publish(
+            s->trailing_metadata_buffer, s->recv_trailing_metadata);
+      }
       null_then_sched_closure(&s->recv_trailing_metadata_finished);
     }
   }
@@ -2106,6 +2398,8 @@ static void remove_stream(grpc_chttp2_transport* t, uint32_t id,
 
   if (grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
     post_benign_reclaimer(t);
+    t->idle_since = grpc_core::ExecCtx::Get()->Now();
+    schedule_idle_release(t);
     if (t->sent_goaway_state == GRPC_CHTTP2_GOAWAY_SENT) {
       close_transport_locked(
           t, GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
@@ -2165,7 +2459,7 @@ void grpc_chttp2_fake_status(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
     gpr_ltoa(status, status_string);
     GRPC_LOG_IF_ERROR("add_status",
                       grpc_chttp2_incoming_metadata_buffer_replace_or_add(
-                          &s->metadata_buffer[1],
+                          grpc_chttp2_stream_get_trailing_metadata_buffer(s),
                           grpc_mdelem_from_slices(
                               GRPC_MDSTR_GRPC_STATUS,
                               grpc_core::UnmanagedMemorySlice(status_string))));
@@ -2173,7 +2467,7 @@ void grpc_chttp2_fake_status(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
       GRPC_LOG_IF_ERROR(
           "add_status_message",
           grpc_chttp2_incoming_metadata_buffer_replace_or_add(
-              &s->metadata_buffer[1],
+              grpc_chttp2_stream_get_trailing_metadata_buffer(s),
               grpc_mdelem_create(GRPC_MDSTR_GRPC_MESSAGE, slice, nullptr)));
     }
     s->published_metadata[1] = GRPC_METADATA_SYNTHESIZED_FROM_FAKE;
@@ -2260,6 +2554,10 @@ void grpc_chttp2_mark_stream_closed(grpc_chttp2_transport* t,
     s->read_closed_error = GRPC_ERROR_REF(error);
     s->read_closed = true;
     closed_read = true;
+    /* nothing more of its message is coming */
+    if (t->incoming_message_stream_id == s->id) {
+      t->incoming_message_bytes_expected = 0;
+    }
   }
   if (close_writes && !s->write_closed) {
     s->write_closed_error = GRPC_ERROR_REF(error);
@@ -2268,6 +2566,7 @@ void grpc_chttp2_mark_stream_closed(grpc_chttp2_transport* t,
   }
   if (s->read_closed && s->write_closed) {
     became_closed = true;
+    GRPC_USDT2(stream_close, t, s->id);
     grpc_error* overall_error =
         removal_error(GRPC_ERROR_REF(error), s, "Stream removed");
     if (s->id != 0) {
@@ -2275,6 +2574,7 @@ void grpc_chttp2_mark_stream_closed(grpc_chttp2_transport* t,
     } else {
       /* Purge streams waiting on concurrency still waiting for id assignment */
       grpc_chttp2_list_remove_waiting_for_concurrency(t, s);
+      grpc_chttp2_update_available_streams(t);
     }
     if (overall_error != GRPC_ERROR_NONE) {
       grpc_chttp2_fake_status(t, s, overall_error);
@@ -2509,6 +2809,10 @@ void grpc_chttp2_act_on_flowctl_action(
                 queue_setting_update(t, GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE,
                                      action.max_frame_size());
               });
+  if (t->channelz_socket != nullptr) {
+    t->channelz_socket->RecordFlowControlWindows(
+        t->flow_control->remote_window(), t->flow_control->announced_window());
+  }
 }
 
 static grpc_error* try_http_parsing(grpc_chttp2_transport* t) {
@@ -2609,10 +2913,9 @@ static void read_action_locked(void* tp, grpc_error* error) {
     t->endpoint_reading = 0;
   } else if (t->closed_with_error == GRPC_ERROR_NONE) {
     keep_reading = true;
-    /* Since we have read a byte, reset the keepalive timer */
-    if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
-      grpc_timer_cancel(&t->keepalive_ping_timer);
-    }
+    /* Since we have read a byte, push back the keepalive ping. The timer is
+       re-armed when it fires rather than cancelled here, on every read. */
+    t->keepalive_last_activity = grpc_core::ExecCtx::Get()->Now();
   }
   grpc_slice_buffer_reset_and_unref_internal(&t->read_buffer);
 
@@ -2634,8 +2937,32 @@ static void read_action_locked(void* tp, grpc_error* error) {
   GRPC_ERROR_UNREF(error);
 }
 
+/* How many bytes the transport knows are on their way: the rest of the frame
+   being parsed, or of the message last seen on the wire, which arrives split
+   into frames of at most the advertised size. The message length is peer
+   controlled, so it only counts up to what the peer may still send within
+   the window we announced. */
+static size_t expected_read_size(grpc_chttp2_transport* t) {
+  const int64_t window = t->flow_control->announced_window();
+  size_t expected =
+      window <= 0
+          ? 0
+          : static_cast<size_t>(GPR_MIN(
+                static_cast<int64_t>(t->incoming_message_bytes_expected),
+                window));
+  if (t->deframe_state == GRPC_DTS_FRAME) {
+    expected = GPR_MAX(expected, static_cast<size_t>(t->incoming_frame_size));
+  }
+  if (expected == 0) return 0;
+  const size_t max_frame_size =
+      t->settings[GRPC_ACKED_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE];
+  /* each frame carries a 9 byte header */
+  return expected + (expected / max_frame_size + 1) * 9;
+}
+
 static void continue_read_action_locked(grpc_chttp2_transport* t) {
   const bool urgent = t->goaway_error != GRPC_ERROR_NONE;
+  grpc_endpoint_set_read_hint(t->ep, expected_read_size(t));
   grpc_endpoint_read(t->ep, &t->read_buffer, &t->read_action_locked, urgent);
   grpc_chttp2_act_on_flowctl_action(t->flow_control->MakeAction(), t, nullptr);
 }
@@ -2656,13 +2983,24 @@ static void start_bdp_ping_locked(void* tp, grpc_error* error) {
   if (error != GRPC_ERROR_NONE || t->closed_with_error != GRPC_ERROR_NONE) {
     return;
   }
-  /* Reset the keepalive ping timer */
-  if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
-    grpc_timer_cancel(&t->keepalive_ping_timer);
-  }
+  /* The bdp ping will do as a keepalive ping: push back the next one */
+  t->keepalive_last_activity = grpc_core::ExecCtx::Get()->Now();
   t->flow_control->bdp_estimator()->StartPing();
 }
 
+// Reads TCP_INFO for the transport's socket, if it has one, and records it
+// in channelz. Callers piggyback this on pings, which are already paced, so
+// that it costs one system call per ping rather than per read or write.
+static bool sample_tcp_info_locked(grpc_chttp2_transport* t,
+                                   grpc_core::TcpInfoSample* sample) {
+  int fd = grpc_endpoint_get_fd(t->ep);
+  if (fd < 0 || !grpc_core::get_socket_tcp_info(fd, sample)) return false;
+  if (t->channelz_socket != nullptr) {
+    t->channelz_socket->RecordTcpInfo(*sample);
+  }
+  return true;
+}
+
 static void finish_bdp_ping_locked(void* tp, grpc_error* error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
@@ -2673,7 +3011,16 @@ static void finish_bdp_ping_locked(void* tp, grpc_error* error) {
     GRPC_CHTTP2_UNREF_TRANSPORT(t, "bdp_ping");
     return;
   }
-  grpc_millis next_ping = t->flow_control->bdp_estimator()->CompletePing();
+  grpc_core::BdpEstimator* bdp_est = t->flow_control->bdp_estimator();
+  grpc_core::TcpInfoSample tcp_info;
+  if ((bdp_est->delivery_rate_estimation() || t->channelz_socket != nullptr) &&
+      sample_tcp_info_locked(t, &tcp_info) &&
+      bdp_est->delivery_rate_estimation() && tcp_info.min_rtt_usec != 0) {
+    // The kernel's view of the round trip time is not inflated by the time
+    // the peer took to answer the ping.
+    bdp_est->AddRttSample(1e-6 * tcp_info.min_rtt_usec);
+  }
+  grpc_millis next_ping = bdp_est->CompletePing();
   grpc_chttp2_act_on_flowctl_action(t->flow_control->PeriodicUpdate(), t,
                                     nullptr);
   GPR_ASSERT(!t->have_next_bdp_ping_timer);
@@ -2765,6 +3112,15 @@ static void init_keepalive_ping_locked(void* arg, grpc_error* error) {
   GPR_ASSERT(t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING);
   if (t->destroying || t->closed_with_error != GRPC_ERROR_NONE) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_DYING;
+  } else if (error == GRPC_ERROR_NONE &&
+             keepalive_ping_deadline(t, t->keepalive_last_activity) >
+                 grpc_core::ExecCtx::Get()->Now()) {
+    /* Data was read since the timer was armed: wait for keepalive_time from
+       then */
+    GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
+    grpc_timer_init(&t->keepalive_ping_timer,
+                    keepalive_ping_deadline(t, t->keepalive_last_activity),
+                    &t->init_keepalive_ping_locked);
   } else if (error == GRPC_ERROR_NONE) {
     if (t->keepalive_permit_without_calls ||
         grpc_chttp2_stream_map_size(&t->stream_map) > 0) {
@@ -2775,16 +3131,18 @@ static void init_keepalive_ping_locked(void* arg, grpc_error* error) {
       grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_KEEPALIVE_PING);
     } else {
       GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      grpc_timer_init(
+          &t->keepalive_ping_timer,
+          keepalive_ping_deadline(t, grpc_core::ExecCtx::Get()->Now()),
+          &t->init_keepalive_ping_locked);
     }
   } else if (error == GRPC_ERROR_CANCELLED) {
-    /* The keepalive ping timer may be cancelled by bdp */
+    /* Re-arm a timer cancelled for any other reason than closing */
     GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    grpc_timer_init(
+        &t->keepalive_ping_timer,
+        keepalive_ping_deadline(t, grpc_core::ExecCtx::Get()->Now()),
+        &t->init_keepalive_ping_locked);
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "init keepalive ping");
 }
@@ -2815,10 +3173,14 @@ static void finish_keepalive_ping_locked(void* arg, grpc_error* error) {
       }
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
       grpc_timer_cancel(&t->keepalive_watchdog_timer);
+      // Idle connections send no BDP pings, so sample TCP_INFO here too.
+      grpc_core::TcpInfoSample tcp_info;
+      if (t->channelz_socket != nullptr) sample_tcp_info_locked(t, &tcp_info);
       GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      grpc_timer_init(
+          &t->keepalive_ping_timer,
+          keepalive_ping_deadline(t, grpc_core::ExecCtx::Get()->Now()),
+          &t->init_keepalive_ping_locked);
     }
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "keepalive ping end");
@@ -2912,6 +3274,16 @@ Chttp2IncomingByteStream::Chttp2IncomingByteStream(
   stream->byte_stream_error = GRPC_ERROR_NONE;
 }
 
+Chttp2IncomingByteStream::~Chttp2IncomingByteStream() {
+  grpc_slice_unref_internal(assembly_);
+}
+
+void Chttp2IncomingByteStream::AssembleContiguously() {
+  GPR_ASSERT(remaining_bytes_ == length());
+  assembling_ = true;
+  assembly_ = GRPC_SLICE_MALLOC(length());
+}
+
 void Chttp2IncomingByteStream::OrphanLocked(void* arg,
                                             grpc_error* error_ignored) {
   Chttp2IncomingByteStream* bs = static_cast<Chttp2IncomingByteStream*>(arg);
@@ -2997,8 +3369,9 @@ bool Chttp2IncomingByteStream::Next(size_t max_size_hint,
 void Chttp2IncomingByteStream::MaybeCreateStreamDecompressionCtx() {
   GPR_DEBUG_ASSERT(stream_->stream_decompression_method !=
                    GRPC_STREAM_COMPRESSION_IDENTITY_DECOMPRESS);
-  if (!stream_->stream_decompression_ctx) {
-    stream_->stream_decompression_ctx = grpc_stream_compression_context_create(
+  grpc_chttp2_stream_compression* c = stream_->compression;
+  if (!c->stream_decompression_ctx) {
+    c->stream_decompression_ctx = grpc_stream_compression_context_create(
         stream_->stream_decompression_method);
   }
 }
@@ -3010,11 +3383,12 @@ grpc_error* Chttp2IncomingByteStream::Pull(grpc_slice* slice) {
     if (!stream_->unprocessed_incoming_frames_decompressed &&
         stream_->stream_decompression_method !=
             GRPC_STREAM_COMPRESSION_IDENTITY_DECOMPRESS) {
+      grpc_chttp2_stream_compression* c = stream_->compression;
       bool end_of_context;
       MaybeCreateStreamDecompressionCtx();
-      if (!grpc_stream_decompress(stream_->stream_decompression_ctx,
+      if (!grpc_stream_decompress(c->stream_decompression_ctx,
                                   &stream_->unprocessed_incoming_frames_buffer,
-                                  &stream_->decompressed_data_buffer, nullptr,
+                                  &c->decompressed_data_buffer, nullptr,
                                   MAX_SIZE_T, &end_of_context)) {
         error =
             GRPC_ERROR_CREATE_FROM_STATIC_STRING("Stream decompression error.");
@@ -3022,12 +3396,11 @@ grpc_error* Chttp2IncomingByteStream::Pull(grpc_slice* slice) {
       }
       GPR_ASSERT(stream_->unprocessed_incoming_frames_buffer.length == 0);
       grpc_slice_buffer_swap(&stream_->unprocessed_incoming_frames_buffer,
-                             &stream_->decompressed_data_buffer);
+                             &c->decompressed_data_buffer);
       stream_->unprocessed_incoming_frames_decompressed = true;
       if (end_of_context) {
-        grpc_stream_compression_context_destroy(
-            stream_->stream_decompression_ctx);
-        stream_->stream_decompression_ctx = nullptr;
+        grpc_stream_compression_context_destroy(c->stream_decompression_ctx);
+        c->stream_decompression_ctx = nullptr;
       }
       if (stream_->unprocessed_incoming_frames_buffer.length == 0) {
         *slice = grpc_empty_slice();
@@ -3065,6 +3438,24 @@ grpc_error* Chttp2IncomingByteStream::Push(const grpc_slice& slice,
     grpc_slice_unref_internal(slice);
     return error;
   } else {
+    if (assembling_) {
+      memcpy(GRPC_SLICE_START_PTR(assembly_) + (length() - remaining_bytes_),
+             GRPC_SLICE_START_PTR(slice), GRPC_SLICE_LENGTH(slice));
+      remaining_bytes_ -= static_cast<uint32_t> GRPC_SLICE_LENGTH(slice);
+      grpc_slice_unref_internal(slice);
+      grpc_slice out = grpc_empty_slice();
+      if (remaining_bytes_ == 0) {
+        out = assembly_;
+        assembly_ = grpc_empty_slice();
+        assembling_ = false;
+      }
+      if (slice_out != nullptr) {
+        *slice_out = out;
+      } else {
+        grpc_slice_unref_internal(out);
+      }
+      return GRPC_ERROR_NONE;
+    }
     remaining_bytes_ -= static_cast<uint32_t> GRPC_SLICE_LENGTH(slice);
     if (slice_out != nullptr) {
       *slice_out = slice;
@@ -3093,6 +3484,58 @@ void Chttp2IncomingByteStream::Shutdown(grpc_error* error) {
 
 }  // namespace grpc_core
 
+/*******************************************************************************
+ * IDLE RELEASE
+ */
+
+/* Arms the idle release timer, unless it is already pending: it is not moved
+   when streams come and go, but checks idle_since when it fires */
+static void schedule_idle_release(grpc_chttp2_transport* t) {
+  if (t->have_idle_release_timer ||
+      t->idle_release_timeout == GRPC_MILLIS_INF_FUTURE ||
+      t->closed_with_error != GRPC_ERROR_NONE) {
+    return;
+  }
+  t->have_idle_release_timer = true;
+  GRPC_CHTTP2_REF_TRANSPORT(t, "idle_release");
+  grpc_timer_init(&t->idle_release_timer,
+                  t->idle_since + t->idle_release_timeout,
+                  &t->idle_release_locked);
+}
+
+static void release_idle_memory(grpc_chttp2_transport* t) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+    gpr_log(GPR_INFO, "HTTP2: %s - release idle memory", t->peer_string);
+  }
+  grpc_chttp2_hpack_compressor_release_idle(&t->hpack_compressor);
+  grpc_chttp2_hptbl_shrink_to_fit(&t->hpack_parser.table);
+  /* Buffers that grew past their inline slices keep the larger array */
+  if (t->write_state == GRPC_CHTTP2_WRITE_STATE_IDLE && t->outbuf.count == 0) {
+    grpc_slice_buffer_destroy_internal(&t->outbuf);
+    grpc_slice_buffer_init(&t->outbuf);
+  }
+  if (t->qbuf.count == 0) {
+    grpc_slice_buffer_destroy_internal(&t->qbuf);
+    grpc_slice_buffer_init(&t->qbuf);
+  }
+}
+
+static void idle_release_locked(void* arg, grpc_error* error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
+  t->have_idle_release_timer = false;
+  if (error == GRPC_ERROR_NONE && t->closed_with_error == GRPC_ERROR_NONE &&
+      grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
+    if (grpc_core::ExecCtx::Get()->Now() >=
+        t->idle_since + t->idle_release_timeout) {
+      release_idle_memory(t);
+    } else {
+      /* streams came and went since the timer was armed */
+      schedule_idle_release(t);
+    }
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "idle_release");
+}
+
 /*******************************************************************************
  * RESOURCE QUOTAS
  */
@@ -3230,6 +3673,11 @@ static grpc_endpoint* chttp2_get_endpoint(grpc_transport* t) {
   return (reinterpret_cast<grpc_chttp2_transport*>(t))->ep;
 }
 
+static int32_t chttp2_get_available_streams(grpc_transport* t) {
+  return (reinterpret_cast<grpc_chttp2_transport*>(t))
+      ->available_streams.Load(grpc_core::MemoryOrder::RELAXED);
+}
+
 static const grpc_transport_vtable vtable = {sizeof(grpc_chttp2_stream),
                                              "chttp2",
                                              init_stream,
@@ -3239,7 +3687,8 @@ static const grpc_transport_vtable vtable = {sizeof(grpc_chttp2_stream),
                                              perform_transport_op,
                                              destroy_stream,
                                              destroy_transport,
-                                             chttp2_get_endpoint};
+                                             chttp2_get_endpoint,
+                                             chttp2_get_available_streams};
 
 static const grpc_transport_vtable* get_vtable(void) { return &vtable; }
 
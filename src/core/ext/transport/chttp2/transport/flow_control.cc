@@ -173,10 +173,13 @@ TransportFlowControlDisabled::TransportFlowControlDisabled(
 }
 
 TransportFlowControl::TransportFlowControl(const grpc_chttp2_transport* t,
-                                           bool enable_bdp_probe)
+                                           bool enable_bdp_probe,
+                                           bool enable_memory_budget,
+                                           bool enable_delivery_rate_estimation)
     : t_(t),
       enable_bdp_probe_(enable_bdp_probe),
-      bdp_estimator_(t->peer_string),
+      enable_memory_budget_(enable_memory_budget),
+      bdp_estimator_(t->peer_string, enable_delivery_rate_estimation),
       pid_controller_(grpc_core::PidController::Args()
                           .set_gain_p(4)
                           .set_gain_i(8)
@@ -297,6 +300,15 @@ void StreamFlowControl::IncomingByteStreamUpdate(size_t max_size_hint,
     max_recv_bytes = 0;
   }
 
+  /* under memory pressure, only let the stream window grow to what the memory
+     budget allows: the rest is granted as the application reads */
+  const int64_t budget_window = tfc_->MemoryBudgetWindow();
+  if (sent_init_window + static_cast<int64_t>(max_recv_bytes) >
+      budget_window) {
+    max_recv_bytes = static_cast<uint32_t>(
+        GPR_MAX(0, budget_window - static_cast<int64_t>(sent_init_window)));
+  }
+
   /* add some small lookahead to keep pipelines flowing */
   GPR_ASSERT(max_recv_bytes <= UINT32_MAX - sent_init_window);
   if (local_window_delta_ < max_recv_bytes) {
@@ -325,6 +337,51 @@ static double AdjustForMemoryPressure(grpc_resource_quota* quota,
   return target;
 }
 
+int64_t TransportFlowControl::MemoryBudgetWindow() const {
+  if (!enable_memory_budget_) return kMaxWindow;
+  // Below kLowMemPressure windows are not limited. From there to
+  // kMaxMemPressure the limit falls geometrically from a share of the quota to
+  // kMinWindow, so that the total all transports on the quota may announce
+  // shrinks as the memory they leave free does.
+  static const double kLowMemPressure = 0.5;
+  static const double kMaxMemPressure = 0.9;
+  static const int64_t kMinWindow = 16384;
+  static const int64_t kQuotaShare = 16;
+  grpc_resource_quota* quota =
+      grpc_resource_user_quota(grpc_endpoint_get_resource_user(t_->ep));
+  double memory_pressure = grpc_resource_quota_get_memory_pressure(quota);
+  if (memory_pressure <= kLowMemPressure) return kMaxWindow;
+  const int64_t ceiling = GPR_CLAMP(
+      static_cast<int64_t>(grpc_resource_quota_peek_size(quota) / kQuotaShare),
+      kMinWindow, kMaxWindow);
+  const double fraction =
+      GPR_MIN(1, (memory_pressure - kLowMemPressure) /
+                     (kMaxMemPressure - kLowMemPressure));
+  return GPR_MAX(kMinWindow,
+                 static_cast<int64_t>(
+                     ceiling * pow(static_cast<double>(kMinWindow) / ceiling,
+                                   fraction)));
+}
+
+FlowControlAction TransportFlowControl::UpdateAction(FlowControlAction action) {
+  if (announced_window_ < target_window() / 2) {
+    action.set_send_transport_update(
+        FlowControlAction::Urgency::UPDATE_IMMEDIATELY);
+  }
+  // Between bdp pings, keep the initial stream window announced to the peer
+  // within the memory budget as the pressure changes.
+  if (enable_bdp_probe_ && enable_memory_budget_ &&
+      action.send_initial_window_update() ==
+          FlowControlAction::Urgency::NO_ACTION_NEEDED) {
+    const int64_t initial_window =
+        GPR_MIN(target_initial_window_size_, MemoryBudgetWindow());
+    action.set_send_initial_window_update(
+        DeltaUrgency(initial_window, GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE),
+        static_cast<uint32_t>(initial_window));
+  }
+  return action;
+}
+
 double TransportFlowControl::TargetLogBdp() {
   return AdjustForMemoryPressure(
       grpc_resource_user_quota(grpc_endpoint_get_resource_user(t_->ep)),
@@ -360,16 +417,22 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
     // target might change based on how much memory pressure we are under
     // TODO(ncteisen): experiment with setting target to be huge under low
     // memory pressure.
-    const double target = pow(2, SmoothLogBdp(TargetLogBdp()));
+    // The delivery rate estimator filters its own samples, so its estimate
+    // is applied as is instead of being smoothed by the pid controller.
+    const double target =
+        pow(2, bdp_estimator_.delivery_rate_estimation()
+                   ? TargetLogBdp()
+                   : SmoothLogBdp(TargetLogBdp()));
 
     // Though initial window 'could' drop to 0, we keep the floor at 128
     target_initial_window_size_ =
         static_cast<int32_t> GPR_CLAMP(target, 128, INT32_MAX);
+    const int64_t initial_window =
+        GPR_MIN(target_initial_window_size_, MemoryBudgetWindow());
 
     action.set_send_initial_window_update(
-        DeltaUrgency(target_initial_window_size_,
-                     GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE),
-        static_cast<uint32_t>(target_initial_window_size_));
+        DeltaUrgency(initial_window, GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE),
+        static_cast<uint32_t>(initial_window));
 
     // get bandwidth estimate and update max_frame accordingly.
     double bw_dbl = bdp_estimator_.EstimateBandwidth();
@@ -224,13 +224,20 @@ class TransportFlowControlDisabled final : public TransportFlowControlBase {
 // to be as performant as possible.
 class TransportFlowControl final : public TransportFlowControlBase {
  public:
-  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe);
+  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe,
+                       bool enable_memory_budget,
+                       bool enable_delivery_rate_estimation);
   ~TransportFlowControl() {}
 
   bool flow_control_enabled() const override { return true; }
 
   bool bdp_probe() const { return enable_bdp_probe_; }
 
+  // The most window the memory budget lets this transport announce, for the
+  // connection and for any one stream: kMaxWindow unless memory budgeting is
+  // enabled and the resource quota is under pressure.
+  int64_t MemoryBudgetWindow() const;
+
   // returns an announce if we should send a transport update to our peer,
   // else returns zero; writing_anyway indicates if a write would happen
   // regardless of the send - if it is false and this function returns non-zero,
@@ -273,7 +280,7 @@ class TransportFlowControl final : public TransportFlowControlBase {
   // logic behind this decision.
   int64_t target_window() const override {
     return static_cast<uint32_t> GPR_MIN(
-        (int64_t)((1u << 31) - 1),
+        GPR_MIN((int64_t)((1u << 31) - 1), MemoryBudgetWindow()),
         announced_stream_total_over_incoming_window_ +
             target_initial_window_size_);
   }
@@ -309,13 +316,7 @@ class TransportFlowControl final : public TransportFlowControlBase {
   FlowControlAction::Urgency DeltaUrgency(int64_t value,
                                           grpc_chttp2_setting_id setting_id);
 
-  FlowControlAction UpdateAction(FlowControlAction action) {
-    if (announced_window_ < target_window() / 2) {
-      action.set_send_transport_update(
-          FlowControlAction::Urgency::UPDATE_IMMEDIATELY);
-    }
-    return action;
-  }
+  FlowControlAction UpdateAction(FlowControlAction action);
 
   const grpc_chttp2_transport* const t_;
 
@@ -333,6 +334,9 @@ class TransportFlowControl final : public TransportFlowControlBase {
   /** should we probe bdp? */
   const bool enable_bdp_probe_;
 
+  /** should announced windows follow the resource quota's memory pressure? */
+  const bool enable_memory_budget_;
+
   /* bdp estimation */
   grpc_core::BdpEstimator bdp_estimator_;
 
@@ -28,6 +28,7 @@
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/transport.h"
@@ -85,6 +86,8 @@ void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
   *p++ = static_cast<uint8_t>(id >> 8);
   *p++ = static_cast<uint8_t>(id);
   grpc_slice_buffer_add(outbuf, hdr);
+  GRPC_USDT4(frame_written, GRPC_CHTTP2_FRAME_DATA,
+             is_eof ? GRPC_CHTTP2_DATA_FLAG_END_STREAM : 0, id, write_bytes);
 
   grpc_slice_buffer_move_first_no_ref(inbuf, write_bytes, outbuf);
 
@@ -197,6 +200,12 @@ grpc_error* grpc_deframe_unprocessed_incoming_frames(
         p->parsing_frame = grpc_core::New<grpc_core::Chttp2IncomingByteStream>(
             t, s, p->frame_size, message_flags);
         stream_out->reset(p->parsing_frame);
+        if (p->frame_size <= t->max_contiguous_recv_message_size &&
+            p->frame_size > static_cast<uint32_t>(end - cur)) {
+          /* the message continues past this slice: gather it into one slice
+             sized from the length prefix as the rest arrives */
+          p->parsing_frame->AssembleContiguously();
+        }
         if (p->parsing_frame->remaining_bytes() == 0) {
           GRPC_ERROR_UNREF(p->parsing_frame->Finished(GRPC_ERROR_NONE, true));
           p->parsing_frame = nullptr;
@@ -279,11 +288,48 @@ grpc_error* grpc_deframe_unprocessed_incoming_frames(
   return GRPC_ERROR_NONE;
 }
 
+uint32_t grpc_chttp2_data_length_tracker_advance(
+    grpc_chttp2_data_length_tracker* tracker, const grpc_slice& slice) {
+  const uint8_t* cur = GRPC_SLICE_START_PTR(slice);
+  const uint8_t* const end = GRPC_SLICE_END_PTR(slice);
+  while (cur != end) {
+    if (tracker->remaining > 0) {
+      uint32_t n = static_cast<uint32_t>(
+          GPR_MIN(static_cast<size_t>(tracker->remaining),
+                  static_cast<size_t>(end - cur)));
+      tracker->remaining -= n;
+      cur += n;
+      continue;
+    }
+    /* the first header byte holds the flags, the next four the length */
+    if (tracker->header_bytes == 0) {
+      tracker->message_length = 0;
+    } else {
+      tracker->message_length = (tracker->message_length << 8) | *cur;
+    }
+    ++cur;
+    if (++tracker->header_bytes == GRPC_HEADER_SIZE_IN_BYTES) {
+      tracker->header_bytes = 0;
+      tracker->remaining = tracker->message_length;
+    }
+  }
+  if (tracker->header_bytes > 0) {
+    return GRPC_HEADER_SIZE_IN_BYTES - tracker->header_bytes;
+  }
+  return tracker->remaining;
+}
+
 grpc_error* grpc_chttp2_data_parser_parse(void* parser,
                                           grpc_chttp2_transport* t,
                                           grpc_chttp2_stream* s,
                                           const grpc_slice& slice,
                                           int is_last) {
+  if (s->stream_decompression_method ==
+      GRPC_STREAM_COMPRESSION_IDENTITY_DECOMPRESS) {
+    t->incoming_message_bytes_expected =
+        grpc_chttp2_data_length_tracker_advance(&s->data_length_tracker, slice);
+    t->incoming_message_stream_id = s->id;
+  }
   if (!s->pending_byte_stream) {
     grpc_slice_ref_internal(slice);
     grpc_slice_buffer_add(&s->frame_storage, slice);
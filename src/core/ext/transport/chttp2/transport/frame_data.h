@@ -56,6 +56,24 @@ struct grpc_chttp2_data_parser {
   grpc_core::Chttp2IncomingByteStream* parsing_frame = nullptr;
 };
 
+/* Follows the gRPC message framing of DATA as the transport receives it,
+   without consuming it, to tell how much of the current message is still to
+   come. Unlike grpc_chttp2_data_parser, which deframes on behalf of the
+   reader of the byte stream, this is only touched by the transport thread. */
+struct grpc_chttp2_data_length_tracker {
+  /* bytes of the current 5 byte message header seen so far */
+  uint8_t header_bytes = 0;
+  /* length from the message header, while it is being read */
+  uint32_t message_length = 0;
+  /* bytes of the message still to come once its header is complete */
+  uint32_t remaining = 0;
+};
+
+/* accounts for a slice of received DATA, returning how many more bytes the
+   message in progress needs (0 at a message boundary) */
+uint32_t grpc_chttp2_data_length_tracker_advance(
+    grpc_chttp2_data_length_tracker* tracker, const grpc_slice& slice);
+
 /* start processing a new data frame */
 grpc_error* grpc_chttp2_data_parser_begin_frame(grpc_chttp2_data_parser* parser,
                                                 uint8_t flags,
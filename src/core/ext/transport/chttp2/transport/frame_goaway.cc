@@ -27,6 +27,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/profiling/usdt.h"
+
 void grpc_chttp2_goaway_parser_init(grpc_chttp2_goaway_parser* p) {
   p->debug_data = nullptr;
 }
@@ -157,6 +159,7 @@ void grpc_chttp2_goaway_append(uint32_t last_stream_id, uint32_t error_code,
   uint32_t frame_length;
   GPR_ASSERT(GRPC_SLICE_LENGTH(debug_data) < UINT32_MAX - 4 - 4);
   frame_length = 4 + 4 + static_cast<uint32_t> GRPC_SLICE_LENGTH(debug_data);
+  GRPC_USDT4(frame_written, GRPC_CHTTP2_FRAME_GOAWAY, 0, 0, frame_length);
 
   /* frame header: length */
   *p++ = static_cast<uint8_t>(frame_length >> 16);
@@ -27,11 +27,14 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/profiling/usdt.h"
+
 static bool g_disable_ping_ack = false;
 
 grpc_slice grpc_chttp2_ping_create(uint8_t ack, uint64_t opaque_8bytes) {
   grpc_slice slice = GRPC_SLICE_MALLOC(9 + 8);
   uint8_t* p = GRPC_SLICE_START_PTR(slice);
+  GRPC_USDT4(frame_written, GRPC_CHTTP2_FRAME_PING, ack ? 1 : 0, 0, 8);
 
   *p++ = 0;
   *p++ = 0;
@@ -27,6 +27,7 @@
 
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/transport/http2_errors.h"
 
 grpc_slice grpc_chttp2_rst_stream_create(uint32_t id, uint32_t code,
@@ -34,6 +35,7 @@ grpc_slice grpc_chttp2_rst_stream_create(uint32_t id, uint32_t code,
   static const size_t frame_size = 13;
   grpc_slice slice = GRPC_SLICE_MALLOC(frame_size);
   if (stats != nullptr) stats->framing_bytes += frame_size;
+  GRPC_USDT4(frame_written, GRPC_CHTTP2_FRAME_RST_STREAM, 0, id, 4);
   uint8_t* p = GRPC_SLICE_START_PTR(slice);
 
   // Frame size.
@@ -105,7 +107,19 @@ grpc_error* grpc_chttp2_rst_stream_parser_parse(void* parser,
                       ((static_cast<uint32_t>(p->reason_bytes[2])) << 8) |
                       ((static_cast<uint32_t>(p->reason_bytes[3])));
     grpc_error* error = GRPC_ERROR_NONE;
-    if (reason != GRPC_HTTP2_NO_ERROR || s->metadata_buffer[1].size == 0) {
+    if (reason == GRPC_HTTP2_CANCEL) {
+      // By far the most common reason, so its error is not rebuilt each time.
+      error = GRPC_ERROR_IMMORTAL(grpc_error_set_int(
+          grpc_error_set_str(
+              GRPC_ERROR_CREATE_FROM_STATIC_STRING("RST_STREAM"),
+              GRPC_ERROR_STR_GRPC_MESSAGE,
+              grpc_slice_from_static_string(
+                  "Received RST_STREAM with error code 8")),
+          GRPC_ERROR_INT_HTTP2_ERROR,
+          static_cast<intptr_t>(GRPC_HTTP2_CANCEL)));
+    } else if (reason != GRPC_HTTP2_NO_ERROR ||
+               s->trailing_metadata_buffer == nullptr ||
+               s->trailing_metadata_buffer->size == 0) {
       char* message;
       gpr_asprintf(&message, "Received RST_STREAM with error code %d", reason);
       error = grpc_error_set_int(
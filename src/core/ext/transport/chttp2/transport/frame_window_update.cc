@@ -25,6 +25,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/profiling/usdt.h"
+
 grpc_slice grpc_chttp2_window_update_create(
     uint32_t id, uint32_t window_update, grpc_transport_one_way_stats* stats) {
   static const size_t frame_size = 13;
@@ -33,6 +35,7 @@ grpc_slice grpc_chttp2_window_update_create(
   uint8_t* p = GRPC_SLICE_START_PTR(slice);
 
   GPR_ASSERT(window_update);
+  GRPC_USDT4(frame_written, GRPC_CHTTP2_FRAME_WINDOW_UPDATE, 0, id, 4);
 
   *p++ = 0;
   *p++ = 0;
@@ -35,6 +35,7 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_table.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
 #include "src/core/lib/debug/stats.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/surface/validate_metadata.h"
@@ -56,6 +57,11 @@
 #define ONE_ON_ADD_PROBABILITY (GRPC_CHTTP2_HPACKC_NUM_VALUES >> 1)
 /* don't consider adding anything bigger than this to the hpack table */
 #define MAX_DECODER_SPACE_USAGE 512
+/* nor anything taking more than 1/x of the decoder's table */
+#define MAX_TABLE_FRACTION 4
+/* an element taking n/x of the decoder's table must be seen (n+1) times as
+   often as a small one to be added */
+#define SIZE_PENALTY_FRACTION 8
 
 #define DATA_FRAME_HEADER_SIZE 9
 
@@ -66,6 +72,15 @@ static const grpc_slice terminal_slice = {
     {{0, nullptr}}            /* data.refcounted */
 };
 
+/* the bytes of the header block being encoded, as long as it is made only of
+   table references, so that it can be cached */
+typedef struct {
+  size_t num_indexed;
+  size_t length;
+  bool overflowed;
+  uint8_t bytes[GRPC_SLICE_INLINED_SIZE];
+} block_record;
+
 typedef struct {
   int is_first_frame;
   /* number of bytes in 'output' when we started the frame - used to calculate
@@ -82,6 +97,8 @@ typedef struct {
   /* maximum size of a frame */
   size_t max_frame_size;
   bool use_true_binary_metadata;
+  /* if non-null, indexed emissions are recorded here */
+  block_record* record;
 } framer_state;
 
 /* fills p (which is expected to be DATA_FRAME_HEADER_SIZE bytes long)
@@ -89,6 +106,7 @@ typedef struct {
 static void fill_header(uint8_t* p, uint8_t type, uint32_t id, size_t len,
                         uint8_t flags) {
   GPR_ASSERT(len < 16777316);
+  GRPC_USDT4(frame_written, type, flags, id, len);
   *p++ = static_cast<uint8_t>(len >> 16);
   *p++ = static_cast<uint8_t>(len >> 8);
   *p++ = static_cast<uint8_t>(len);
@@ -178,7 +196,12 @@ static uint8_t* add_tiny_header_data(framer_state* st, size_t len) {
   return grpc_slice_buffer_tiny_add(st->output, len);
 }
 
+static void table_changed(grpc_chttp2_hpack_compressor* c) {
+  c->table_epoch++;
+}
+
 static void evict_entry(grpc_chttp2_hpack_compressor* c) {
+  table_changed(c);
   c->tail_remote_index++;
   GPR_ASSERT(c->tail_remote_index > 0);
   GPR_ASSERT(c->table_size >=
@@ -218,6 +241,7 @@ static uint32_t prepare_space_for_new_elem(grpc_chttp2_hpack_compressor* c,
       static_cast<uint16_t>(elem_size);
   c->table_size = static_cast<uint16_t>(c->table_size + elem_size);
   c->table_elems++;
+  table_changed(c);
 
   return new_index;
 }
@@ -321,8 +345,18 @@ static void emit_indexed(grpc_chttp2_hpack_compressor* c, uint32_t elem_index,
                          framer_state* st) {
   GRPC_STATS_INC_HPACK_SEND_INDEXED();
   uint32_t len = GRPC_CHTTP2_VARINT_LENGTH(elem_index, 1);
-  GRPC_CHTTP2_WRITE_VARINT(elem_index, 1, 0x80, add_tiny_header_data(st, len),
-                           len);
+  uint8_t* data = add_tiny_header_data(st, len);
+  GRPC_CHTTP2_WRITE_VARINT(elem_index, 1, 0x80, data, len);
+  block_record* record = st->record;
+  if (record != nullptr) {
+    if (record->length + len <= sizeof(record->bytes)) {
+      memcpy(record->bytes + record->length, data, len);
+      record->length += len;
+      record->num_indexed++;
+    } else {
+      record->overflowed = true;
+    }
+  }
 }
 
 typedef struct {
@@ -466,6 +500,49 @@ static uint32_t dynidx(grpc_chttp2_hpack_compressor* c, uint32_t elem_index) {
          c->table_elems - elem_index;
 }
 
+/* Keys whose values are (nearly) always unique per call, such as request and
+   trace ids. Adding them to the table would only evict useful entries. */
+static bool is_unique_key(const grpc_slice& key) {
+#define UNIQUE_KEY(x) \
+  { x, sizeof(x) - 1 }
+  static const struct {
+    const char* key;
+    size_t length;
+  } kUniqueKeys[] = {
+      UNIQUE_KEY("grpc-trace-bin"), UNIQUE_KEY("x-request-id"),
+      UNIQUE_KEY("x-b3-traceid"),   UNIQUE_KEY("x-b3-spanid"),
+      UNIQUE_KEY("traceparent"),    UNIQUE_KEY("x-cloud-trace-context"),
+  };
+#undef UNIQUE_KEY
+  const size_t length = GRPC_SLICE_LENGTH(key);
+  for (const auto& unique_key : kUniqueKeys) {
+    if (length == unique_key.length &&
+        memcmp(GRPC_SLICE_START_PTR(key), unique_key.key, length) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* is an element of this size worth its space in the decoder's table? */
+static bool fits_table(grpc_chttp2_hpack_compressor* c,
+                       size_t decoder_space_usage) {
+  return decoder_space_usage < MAX_DECODER_SPACE_USAGE &&
+         decoder_space_usage <= c->max_table_size / MAX_TABLE_FRACTION;
+}
+
+/* is this element seen often enough, given its size, to be added? */
+static bool popular_enough(grpc_chttp2_hpack_compressor* c, uint32_t elem_hash,
+                           size_t decoder_space_usage) {
+  const uint32_t size_penalty =
+      c->max_table_size == 0
+          ? 0
+          : static_cast<uint32_t>(decoder_space_usage * SIZE_PENALTY_FRACTION /
+                                  c->max_table_size);
+  return c->filter_elems[HASH_FRAGMENT_1(elem_hash)] >=
+         c->filter_elems_sum / ONE_ON_ADD_PROBABILITY * (1 + size_penalty);
+}
+
 /* encode an mdelem */
 static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
                       framer_state* st) {
@@ -545,10 +622,11 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
   /* should this elem be in the table? */
   const size_t decoder_space_usage =
       grpc_chttp2_get_size_in_hpack_table(elem, st->use_true_binary_metadata);
-  const bool should_add_elem = elem_interned &&
-                               decoder_space_usage < MAX_DECODER_SPACE_USAGE &&
-                               c->filter_elems[HASH_FRAGMENT_1(elem_hash)] >=
-                                   c->filter_elems_sum / ONE_ON_ADD_PROBABILITY;
+  const bool indexable = fits_table(c, decoder_space_usage) &&
+                         !is_unique_key(GRPC_MDKEY(elem));
+  const bool should_add_elem =
+      elem_interned && indexable &&
+      popular_enough(c, elem_hash, decoder_space_usage);
 
   uint32_t key_hash = GRPC_MDKEY(elem).refcount->Hash(GRPC_MDKEY(elem));
   auto emit_maybe_add = [&should_add_elem, &elem, &st, &c, &indices_key,
@@ -581,8 +659,7 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
   }
 
   /* no elem, key in the table... fall back to literal emission */
-  const bool should_add_key =
-      !elem_interned && decoder_space_usage < MAX_DECODER_SPACE_USAGE;
+  const bool should_add_key = !elem_interned && indexable;
   if (should_add_elem || should_add_key) {
     emit_lithdr_incidx_v(c, 0, elem, st);
   } else {
@@ -601,13 +678,16 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
 static void deadline_enc(grpc_chttp2_hpack_compressor* c, grpc_millis deadline,
                          framer_state* st) {
   char timeout_str[GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE];
-  grpc_mdelem mdelem;
   grpc_http2_encode_timeout(deadline - grpc_core::ExecCtx::Get()->Now(),
                             timeout_str);
-  mdelem = grpc_mdelem_from_slices(
-      GRPC_MDSTR_GRPC_TIMEOUT, grpc_core::UnmanagedMemorySlice(timeout_str));
-  hpack_enc(c, mdelem, st);
-  GRPC_MDELEM_UNREF(mdelem);
+  if (GRPC_MDISNULL(c->timeout_elem) ||
+      strcmp(timeout_str, c->timeout_str) != 0) {
+    GRPC_MDELEM_UNREF(c->timeout_elem);
+    c->timeout_elem = grpc_mdelem_from_slices(
+        GRPC_MDSTR_GRPC_TIMEOUT, grpc_core::UnmanagedMemorySlice(timeout_str));
+    memcpy(c->timeout_str, timeout_str, sizeof(timeout_str));
+  }
+  hpack_enc(c, c->timeout_elem, st);
 }
 
 static uint32_t elems_for_bytes(uint32_t bytes) { return (bytes + 31) / 32; }
@@ -635,9 +715,38 @@ void grpc_chttp2_hpack_compressor_destroy(grpc_chttp2_hpack_compressor* c) {
     }
     GRPC_MDELEM_UNREF(c->entries_elems[i]);
   }
+  for (i = 0; i < GRPC_CHTTP2_HPACKC_NUM_CACHED_BLOCKS; i++) {
+    grpc_chttp2_hpack_cached_block* block = &c->cached_blocks[i];
+    for (size_t j = 0; j < block->num_elems; j++) {
+      GRPC_MDELEM_UNREF(block->elems[j]);
+    }
+  }
+  GRPC_MDELEM_UNREF(c->timeout_elem);
   gpr_free(c->table_elem_size);
 }
 
+void grpc_chttp2_hpack_compressor_release_idle(
+    grpc_chttp2_hpack_compressor* c) {
+  for (size_t i = 0; i < GRPC_CHTTP2_HPACKC_NUM_VALUES; i++) {
+    if (c->entries_keys[i].refcount != &terminal_slice_refcount) {
+      grpc_slice_unref_internal(c->entries_keys[i]);
+      c->entries_keys[i] = terminal_slice;
+    }
+    GRPC_MDELEM_UNREF(c->entries_elems[i]);
+    c->entries_elems[i] = GRPC_MDNULL;
+  }
+  for (size_t i = 0; i < GRPC_CHTTP2_HPACKC_NUM_CACHED_BLOCKS; i++) {
+    grpc_chttp2_hpack_cached_block* block = &c->cached_blocks[i];
+    for (size_t j = 0; j < block->num_elems; j++) {
+      GRPC_MDELEM_UNREF(block->elems[j]);
+    }
+    block->num_elems = 0;
+  }
+  GRPC_MDELEM_UNREF(c->timeout_elem);
+  c->timeout_elem = GRPC_MDNULL;
+  table_changed(c);
+}
+
 void grpc_chttp2_hpack_compressor_set_max_usable_size(
     grpc_chttp2_hpack_compressor* c, uint32_t max_table_size) {
   c->max_usable_size = max_table_size;
@@ -684,11 +793,126 @@ void grpc_chttp2_hpack_compressor_set_max_table_size(
     }
   }
   c->advertise_table_size_change = 1;
+  table_changed(c);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
     gpr_log(GPR_INFO, "set max table size from encoder to %d", max_table_size);
   }
 }
 
+/* gathers the elements of a header block that could be cached into elems,
+   returning how many there are, or 0 if the block cannot be cached */
+static size_t cacheable_block_elems(grpc_mdelem** extra_headers,
+                                    size_t extra_headers_size,
+                                    grpc_metadata_batch* metadata,
+                                    grpc_mdelem* elems) {
+  size_t n = extra_headers_size + metadata->list.count;
+  if (n == 0 || n > GRPC_CHTTP2_HPACKC_MAX_CACHED_BLOCK_ELEMS) return 0;
+  size_t i = 0;
+  for (; i < extra_headers_size; i++) {
+    elems[i] = *extra_headers[i];
+  }
+  for (grpc_linked_mdelem* l = metadata->list.head; l; l = l->next) {
+    elems[i++] = l->md;
+  }
+  /* only interned elements are known to be equal just from their address */
+  for (i = 0; i < n; i++) {
+    if (!GRPC_MDELEM_IS_INTERNED(elems[i])) return 0;
+  }
+  return n;
+}
+
+static grpc_chttp2_hpack_cached_block* find_cached_block(
+    grpc_chttp2_hpack_compressor* c, const grpc_mdelem* elems, size_t n) {
+  for (size_t i = 0; i < GRPC_CHTTP2_HPACKC_NUM_CACHED_BLOCKS; i++) {
+    grpc_chttp2_hpack_cached_block* block = &c->cached_blocks[i];
+    if (block->num_elems != n || block->table_epoch != c->table_epoch) {
+      continue;
+    }
+    size_t j = 0;
+    while (j < n && block->elems[j].payload == elems[j].payload) j++;
+    if (j == n) return block;
+  }
+  return nullptr;
+}
+
+static void cache_block(grpc_chttp2_hpack_compressor* c,
+                        const grpc_mdelem* elems, size_t n,
+                        const block_record* record) {
+  grpc_chttp2_hpack_cached_block* block =
+      &c->cached_blocks[c->next_cached_block];
+  c->next_cached_block =
+      (c->next_cached_block + 1) % GRPC_CHTTP2_HPACKC_NUM_CACHED_BLOCKS;
+  for (size_t i = 0; i < block->num_elems; i++) {
+    GRPC_MDELEM_UNREF(block->elems[i]);
+  }
+  block->table_epoch = c->table_epoch;
+  block->num_elems = static_cast<uint8_t>(n);
+  block->length = static_cast<uint8_t>(record->length);
+  for (size_t i = 0; i < n; i++) {
+    block->elems[i] = GRPC_MDELEM_REF(elems[i]);
+  }
+  memcpy(block->bytes, record->bytes, record->length);
+}
+
+static void emit_cached_block(grpc_chttp2_hpack_compressor* c,
+                              const grpc_chttp2_hpack_cached_block* block,
+                              framer_state* st) {
+  for (size_t i = 0; i < block->num_elems; i++) {
+    GRPC_STATS_INC_HPACK_SEND_INDEXED();
+    /* keep the popularity counts that hpack_enc would have updated, so that
+       later decisions about what to add to the table are unchanged */
+    grpc_mdelem elem = block->elems[i];
+    uint32_t elem_hash;
+    if (GRPC_MDELEM_STORAGE(elem) == GRPC_MDELEM_STORAGE_INTERNED) {
+      elem_hash =
+          reinterpret_cast<grpc_core::InternedMetadata*>(GRPC_MDELEM_DATA(elem))
+              ->hash();
+    } else {
+      grpc_core::StaticMetadata* md =
+          reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(elem));
+      if (md->StaticIndex() < GRPC_CHTTP2_LAST_STATIC_ENTRY) continue;
+      elem_hash = md->hash();
+    }
+    inc_filter(HASH_FRAGMENT_1(elem_hash), &c->filter_elems_sum,
+               c->filter_elems);
+  }
+  memcpy(add_tiny_header_data(st, block->length), block->bytes,
+         block->length);
+}
+
+static void encode_elems(grpc_chttp2_hpack_compressor* c,
+                         grpc_mdelem** extra_headers, size_t extra_headers_size,
+                         grpc_metadata_batch* metadata, framer_state* st) {
+  for (size_t i = 0; i < extra_headers_size; ++i) {
+    grpc_mdelem md = *extra_headers[i];
+    const bool is_static =
+        GRPC_MDELEM_STORAGE(md) == GRPC_MDELEM_STORAGE_STATIC;
+    uintptr_t static_index;
+    if (is_static &&
+        (static_index =
+             reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(md))
+                 ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
+      emit_indexed(c, static_cast<uint32_t>(static_index + 1), st);
+    } else {
+      hpack_enc(c, md, st);
+    }
+  }
+  grpc_metadata_batch_assert_ok(metadata);
+  for (grpc_linked_mdelem* l = metadata->list.head; l; l = l->next) {
+    const bool is_static =
+        GRPC_MDELEM_STORAGE(l->md) == GRPC_MDELEM_STORAGE_STATIC;
+    uintptr_t static_index;
+    if (is_static &&
+        (static_index = reinterpret_cast<grpc_core::StaticMetadata*>(
+                            GRPC_MDELEM_DATA(l->md))
+                            ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
+      emit_indexed(c, static_cast<uint32_t>(static_index + 1), st);
+    } else {
+      hpack_enc(c, l->md, st);
+    }
+  }
+}
+
 void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
                                grpc_mdelem** extra_headers,
                                size_t extra_headers_size,
@@ -705,6 +929,7 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
   st.stats = options->stats;
   st.max_frame_size = options->max_frame_size;
   st.use_true_binary_metadata = options->use_true_binary_metadata;
+  st.record = nullptr;
 
   /* Encode a metadata batch; store the returned values, representing
      a metadata element that needs to be unreffed back into the metadata
@@ -714,33 +939,30 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
   if (c->advertise_table_size_change != 0) {
     emit_advertise_table_size_change(c, &st);
   }
-  for (size_t i = 0; i < extra_headers_size; ++i) {
-    grpc_mdelem md = *extra_headers[i];
-    const bool is_static =
-        GRPC_MDELEM_STORAGE(md) == GRPC_MDELEM_STORAGE_STATIC;
-    uintptr_t static_index;
-    if (is_static &&
-        (static_index =
-             reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(md))
-                 ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
-      emit_indexed(c, static_cast<uint32_t>(static_index + 1), &st);
-    } else {
-      hpack_enc(c, md, &st);
+  grpc_mdelem block_elems[GRPC_CHTTP2_HPACKC_MAX_CACHED_BLOCK_ELEMS];
+  const size_t num_block_elems = cacheable_block_elems(
+      extra_headers, extra_headers_size, metadata, block_elems);
+  const grpc_chttp2_hpack_cached_block* cached =
+      num_block_elems != 0 ? find_cached_block(c, block_elems, num_block_elems)
+                           : nullptr;
+  /* the cached bytes are spliced as one piece, so they must fit in a frame */
+  if (cached != nullptr && cached->length <= st.max_frame_size) {
+    emit_cached_block(c, cached, &st);
+  } else {
+    block_record record;
+    if (num_block_elems != 0) {
+      record.num_indexed = 0;
+      record.length = 0;
+      record.overflowed = false;
+      st.record = &record;
     }
-  }
-  grpc_metadata_batch_assert_ok(metadata);
-  for (grpc_linked_mdelem* l = metadata->list.head; l; l = l->next) {
-    const bool is_static =
-        GRPC_MDELEM_STORAGE(l->md) == GRPC_MDELEM_STORAGE_STATIC;
-    uintptr_t static_index;
-    if (is_static &&
-        (static_index = reinterpret_cast<grpc_core::StaticMetadata*>(
-                            GRPC_MDELEM_DATA(l->md))
-                            ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
-      emit_indexed(c, static_cast<uint32_t>(static_index + 1), &st);
-    } else {
-      hpack_enc(c, l->md, &st);
+    encode_elems(c, extra_headers, extra_headers_size, metadata, &st);
+    /* if every element was a table reference, the table did not change */
+    if (st.record != nullptr && !record.overflowed &&
+        record.num_indexed == num_block_elems) {
+      cache_block(c, block_elems, num_block_elems, &record);
     }
+    st.record = nullptr;
   }
   grpc_millis deadline = metadata->deadline;
   if (deadline != GRPC_MILLIS_INF_FUTURE) {
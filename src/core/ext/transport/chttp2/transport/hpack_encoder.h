@@ -26,6 +26,7 @@
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/lib/transport/metadata.h"
 #include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/timeout_encoding.h"
 #include "src/core/lib/transport/transport.h"
 
 // This should be <= 8. We use 6 to save space.
@@ -35,9 +36,27 @@
 #define GRPC_CHTTP2_HPACKC_INITIAL_TABLE_SIZE 4096
 /* maximum table size we'll actually use */
 #define GRPC_CHTTP2_HPACKC_MAX_TABLE_SIZE (1024 * 1024)
+/* number of encoded header blocks remembered for reuse */
+#define GRPC_CHTTP2_HPACKC_NUM_CACHED_BLOCKS 4
+/* most elements in a header block that may be reused */
+#define GRPC_CHTTP2_HPACKC_MAX_CACHED_BLOCK_ELEMS 8
 
 extern grpc_core::TraceFlag grpc_http_trace;
 
+/* A header block that was encoded entirely as references to the static and
+   dynamic tables. As long as the dynamic table does not change, encoding the
+   same elements again would produce the same bytes, so they are spliced in
+   instead. */
+typedef struct {
+  /** value of table_epoch when the block was encoded */
+  uint32_t table_epoch;
+  uint8_t num_elems;
+  uint8_t length;
+  /** the elements, in order; refs are held on them */
+  grpc_mdelem elems[GRPC_CHTTP2_HPACKC_MAX_CACHED_BLOCK_ELEMS];
+  uint8_t bytes[GRPC_SLICE_INLINED_SIZE];
+} grpc_chttp2_hpack_cached_block;
+
 typedef struct {
   uint32_t filter_elems_sum;
   uint32_t max_table_size;
@@ -69,6 +88,19 @@ typedef struct {
   uint32_t indices_elems[GRPC_CHTTP2_HPACKC_NUM_VALUES];
 
   uint16_t* table_elem_size;
+
+  /* changes whenever the decoder's table does, making cached blocks stale */
+  uint32_t table_epoch;
+  grpc_chttp2_hpack_cached_block cached_blocks
+      [GRPC_CHTTP2_HPACKC_NUM_CACHED_BLOCKS];
+  /* slot the next cached block replaces */
+  uint32_t next_cached_block;
+
+  /* the last grpc-timeout sent and its encoding: calls with similar deadlines
+     round to the same value, which can then be sent without building a new
+     element */
+  grpc_mdelem timeout_elem;
+  char timeout_str[GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE];
 } grpc_chttp2_hpack_compressor;
 
 void grpc_chttp2_hpack_compressor_init(grpc_chttp2_hpack_compressor* c);
@@ -77,6 +109,11 @@ void grpc_chttp2_hpack_compressor_set_max_table_size(
     grpc_chttp2_hpack_compressor* c, uint32_t max_table_size);
 void grpc_chttp2_hpack_compressor_set_max_usable_size(
     grpc_chttp2_hpack_compressor* c, uint32_t max_table_size);
+/* Drops the refs the compressor holds on what it put in the decoder's table,
+   and its cached blocks, so that an idle connection does not keep them
+   alive. The decoder's table is not touched: the forgotten entries are just
+   sent as literals again, and age out of it as usual. */
+void grpc_chttp2_hpack_compressor_release_idle(grpc_chttp2_hpack_compressor* c);
 
 typedef struct {
   uint32_t stream_id;
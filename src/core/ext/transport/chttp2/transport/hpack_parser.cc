@@ -28,8 +28,10 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/profiling/timers.h"
@@ -604,6 +606,28 @@ static const int16_t emit_sub_tbl[249 * 16] = {
     13,  22,  22,  22,  22,  256, 256, 256, 256,
 };
 
+/* Wide huffman decoding tables, built from grpc_chttp2_huffsyms the first time
+   a parser is initialized and used by decode_huff_string() to decode complete
+   strings several bits at a time rather than a nibble at a time.
+
+   huff_fast_tbl is indexed by the next HUFF_FAST_BITS bits of input and packs:
+     bits 0..7:   first symbol
+     bits 8..15:  second symbol
+     bits 16..19: length of the first symbol's code
+     bits 20..23: total length of the codes of all decoded symbols
+     bits 24..25: the number of symbols decoded (0, 1 or 2)
+   A count of 0 means the next code is longer than HUFF_FAST_BITS; those codes
+   are resolved through the canonical code tables below (the HPACK code is
+   canonical: codes of a given length are consecutive, ordered by symbol). */
+#define HUFF_FAST_BITS 11
+#define HUFF_MAX_CODE_LENGTH 30
+static uint32_t huff_fast_tbl[1 << HUFF_FAST_BITS];
+static uint32_t huff_first_code[HUFF_MAX_CODE_LENGTH + 1];
+static uint16_t huff_first_index[HUFF_MAX_CODE_LENGTH + 1];
+static uint16_t huff_code_count[HUFF_MAX_CODE_LENGTH + 1];
+static uint16_t huff_sorted_syms[GRPC_CHTTP2_NUM_HUFFSYMS];
+static gpr_once huff_tables_once = GPR_ONCE_INIT;
+
 static const uint8_t inverse_base64[256] = {
     255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
     255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
@@ -695,6 +719,32 @@ static grpc_core::ManagedMemorySlice take_string_intern(
   return s;
 }
 
+/* Takes the key of a header that is not added to the table: a static slice
+   if it is a well known key, as the metadata batch relies on those, and
+   otherwise a plain slice, as interning it would cost a hash table lookup
+   under a shard lock for a key that may never be seen again. */
+static grpc_slice take_string_key_extern(grpc_chttp2_hpack_parser* p,
+                                         grpc_chttp2_hpack_parser_string* str) {
+  bool is_static = false;
+  grpc_slice s;
+  if (!str->copied) {
+    s = grpc_slice_maybe_static_intern(str->data.referenced, &is_static);
+  } else {
+    s = grpc_slice_maybe_static_intern(
+        grpc_slice_from_static_buffer(str->data.copied.str,
+                                      str->data.copied.length),
+        &is_static);
+  }
+  if (!is_static) return take_string_extern(p, str);
+  if (!str->copied) {
+    grpc_slice_unref_internal(str->data.referenced);
+    str->copied = true;
+    str->data.referenced = grpc_empty_slice();
+  }
+  str->data.copied.length = 0;
+  return s;
+}
+
 /* jump to the next state */
 static grpc_error* parse_next(grpc_chttp2_hpack_parser* p, const uint8_t* cur,
                               const uint8_t* end) {
@@ -912,7 +962,7 @@ static grpc_error* finish_lithdr_notidx_v(grpc_chttp2_hpack_parser* p,
                                           const uint8_t* end) {
   GRPC_STATS_INC_HPACK_RECV_LITHDR_NOTIDX_V();
   grpc_error* err = on_hdr<false>(
-      p, grpc_mdelem_from_slices(take_string_intern(p, &p->key),
+      p, grpc_mdelem_from_slices(take_string_key_extern(p, &p->key),
                                  take_string_extern(p, &p->value)));
   if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
   return parse_begin(p, cur, end);
@@ -976,7 +1026,7 @@ static grpc_error* finish_lithdr_nvridx_v(grpc_chttp2_hpack_parser* p,
                                           const uint8_t* end) {
   GRPC_STATS_INC_HPACK_RECV_LITHDR_NVRIDX_V();
   grpc_error* err = on_hdr<false>(
-      p, grpc_mdelem_from_slices(take_string_intern(p, &p->key),
+      p, grpc_mdelem_from_slices(take_string_key_extern(p, &p->key),
                                  take_string_extern(p, &p->value)));
   if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
   return parse_begin(p, cur, end);
@@ -1446,6 +1496,102 @@ static grpc_error* add_huff_bytes(grpc_chttp2_hpack_parser* p,
   return GRPC_ERROR_NONE;
 }
 
+/* decode one symbol from the 32 bits of input left-aligned in window, using a
+   code of at most max_length bits: returns the code length (setting *sym), or
+   0 if no such code matches */
+static unsigned huff_decode_canonical(uint32_t window, unsigned max_length,
+                                      uint16_t* sym) {
+  if (max_length > HUFF_MAX_CODE_LENGTH) max_length = HUFF_MAX_CODE_LENGTH;
+  for (unsigned length = 1; length <= max_length; length++) {
+    uint32_t offset = (window >> (32 - length)) - huff_first_code[length];
+    if (offset < huff_code_count[length]) {
+      *sym = huff_sorted_syms[huff_first_index[length] + offset];
+      return length;
+    }
+  }
+  return 0;
+}
+
+static void build_huff_tables(void) {
+  /* order symbols by (code length, code) and record where each length starts;
+     with a canonical code, a code's offset from the first code of its length
+     is its index within that length */
+  uint16_t n = 0;
+  for (unsigned length = 1; length <= HUFF_MAX_CODE_LENGTH; length++) {
+    huff_first_index[length] = n;
+    huff_code_count[length] = 0;
+    for (uint16_t i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) {
+      const grpc_chttp2_huffsym* s = &grpc_chttp2_huffsyms[i];
+      if (s->length != length) continue;
+      if (huff_code_count[length] == 0) huff_first_code[length] = s->bits;
+      GPR_ASSERT(s->bits == huff_first_code[length] + huff_code_count[length]);
+      huff_code_count[length]++;
+      huff_sorted_syms[n++] = i;
+    }
+  }
+  GPR_ASSERT(n == GRPC_CHTTP2_NUM_HUFFSYMS);
+  for (uint32_t i = 0; i < (1 << HUFF_FAST_BITS); i++) {
+    uint32_t window = i << (32 - HUFF_FAST_BITS);
+    uint16_t sym1, sym2 = 0;
+    unsigned len1 = huff_decode_canonical(window, HUFF_FAST_BITS, &sym1);
+    if (len1 == 0) {
+      huff_fast_tbl[i] = 0;
+      continue;
+    }
+    unsigned len2 = huff_decode_canonical(window << len1,
+                                          HUFF_FAST_BITS - len1, &sym2);
+    huff_fast_tbl[i] = sym1 | (static_cast<uint32_t>(sym2) << 8) |
+                       (len1 << 16) | ((len1 + len2) << 20) |
+                       ((len2 == 0 ? 1u : 2u) << 24);
+  }
+}
+
+/* decode a complete huffman encoded string: equivalent to add_huff_bytes
+   starting from huff_state 0 and discarding the final state, but consumes up
+   to HUFF_FAST_BITS bits (and up to two symbols) per table lookup and hands
+   decoded bytes to append_string in batches */
+static grpc_error* decode_huff_string(grpc_chttp2_hpack_parser* p,
+                                      const uint8_t* cur, const uint8_t* end) {
+  uint8_t out[256];
+  size_t out_length = 0;
+  /* unconsumed input bits, left-aligned */
+  uint64_t bits = 0;
+  unsigned bit_count = 0;
+  for (;;) {
+    while (bit_count <= 56 && cur != end) {
+      bits |= static_cast<uint64_t>(*cur++) << (56 - bit_count);
+      bit_count += 8;
+    }
+    if (bit_count == 0) break;
+    if (out_length > sizeof(out) - 2) {
+      grpc_error* err = append_string(p, out, out + out_length);
+      if (err != GRPC_ERROR_NONE) return err;
+      out_length = 0;
+    }
+    uint32_t entry = huff_fast_tbl[bits >> (64 - HUFF_FAST_BITS)];
+    unsigned consumed = (entry >> 20) & 0xf;
+    if (entry != 0 && consumed <= bit_count) {
+      out[out_length++] = static_cast<uint8_t>(entry);
+      if ((entry >> 24) == 2) {
+        out[out_length++] = static_cast<uint8_t>(entry >> 8);
+      }
+    } else {
+      /* long code, or too few bits left for everything in the fast entry */
+      uint16_t sym;
+      consumed =
+          huff_decode_canonical(static_cast<uint32_t>(bits >> 32), bit_count,
+                                &sym);
+      /* a trailing partial code (normally EOS padding) is dropped */
+      if (consumed == 0) break;
+      /* an embedded EOS is ignored, as in huff_nibble */
+      if (sym != 256) out[out_length++] = static_cast<uint8_t>(sym);
+    }
+    bits <<= consumed;
+    bit_count -= consumed;
+  }
+  return append_string(p, out, out + out_length);
+}
+
 /* decode some string bytes based on the current decoding mode
    (huffman or not) */
 static grpc_error* add_str_bytes(grpc_chttp2_hpack_parser* p,
@@ -1463,7 +1609,11 @@ static grpc_error* parse_string(grpc_chttp2_hpack_parser* p, const uint8_t* cur,
   size_t remaining = p->strlen - p->strgot;
   size_t given = static_cast<size_t>(end - cur);
   if (remaining <= given) {
-    grpc_error* err = add_str_bytes(p, cur, cur + remaining);
+    /* the whole (rest of the) string is here: if huffman decoding has not
+       started yet, decode it in one go */
+    grpc_error* err = p->huff && p->strgot == 0
+                          ? decode_huff_string(p, cur, cur + remaining)
+                          : add_str_bytes(p, cur, cur + remaining);
     if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
     err = finish_str(p, cur + remaining, end);
     if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
@@ -1602,6 +1752,7 @@ static grpc_error* parse_value_string_with_literal_key(
 /* PUBLIC INTERFACE */
 
 void grpc_chttp2_hpack_parser_init(grpc_chttp2_hpack_parser* p) {
+  gpr_once_init(&huff_tables_once, build_huff_tables);
   p->on_header = nullptr;
   p->on_header_user_data = nullptr;
   p->state = parse_begin;
@@ -1692,8 +1843,7 @@ static void parse_stream_compression_md(grpc_chttp2_transport* t,
 
   if (s->stream_decompression_method !=
       GRPC_STREAM_COMPRESSION_IDENTITY_DECOMPRESS) {
-    s->stream_decompression_ctx = nullptr;
-    grpc_slice_buffer_init(&s->decompressed_data_buffer);
+    grpc_chttp2_stream_get_compression(s);
   }
 }
 
@@ -1721,14 +1871,15 @@ grpc_error* grpc_chttp2_header_parser_parse(void* hpack_parser,
        stream id on a header */
     if (s != nullptr) {
       if (parser->is_boundary) {
-        if (s->header_frames_received == GPR_ARRAY_SIZE(s->metadata_buffer)) {
+        /* initial metadata, then trailing metadata */
+        if (s->header_frames_received == 2) {
           return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
               "Too many trailer frames");
         }
         /* Process stream compression md element if it exists */
         if (s->header_frames_received ==
             0) { /* Only acts on initial metadata */
-          parse_stream_compression_md(t, s, &s->metadata_buffer[0].batch);
+          parse_stream_compression_md(t, s, &s->initial_metadata_buffer.batch);
         }
         s->published_metadata[s->header_frames_received] =
             GRPC_METADATA_PUBLISHED_FROM_WIRE;
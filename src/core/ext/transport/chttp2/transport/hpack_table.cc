@@ -38,7 +38,7 @@ extern grpc_core::TraceFlag grpc_http_trace;
 void grpc_chttp2_hptbl_destroy(grpc_chttp2_hptbl* tbl) {
   size_t i;
   for (i = 0; i < tbl->num_ents; i++) {
-    GRPC_MDELEM_UNREF(tbl->ents[(tbl->first_ent + i) % tbl->cap_entries]);
+    GRPC_MDELEM_UNREF(tbl->ents[(tbl->first_ent + i) & (tbl->cap_entries - 1)]);
   }
   gpr_free(tbl->ents);
   tbl->ents = nullptr;
@@ -49,8 +49,8 @@ grpc_mdelem grpc_chttp2_hptbl_lookup_dynamic_index(const grpc_chttp2_hptbl* tbl,
   /* Not static - find the value in the list of valid entries */
   tbl_index -= (GRPC_CHTTP2_LAST_STATIC_ENTRY + 1);
   if (tbl_index < tbl->num_ents) {
-    uint32_t offset =
-        (tbl->num_ents - 1u - tbl_index + tbl->first_ent) % tbl->cap_entries;
+    uint32_t offset = (tbl->num_ents - 1u - tbl_index + tbl->first_ent) &
+                      (tbl->cap_entries - 1);
     return tbl->ents[offset];
   }
   /* Invalid entry: return error */
@@ -65,18 +65,28 @@ static void evict1(grpc_chttp2_hptbl* tbl) {
                       GRPC_CHTTP2_HPACK_ENTRY_OVERHEAD;
   GPR_ASSERT(elem_bytes <= tbl->mem_used);
   tbl->mem_used -= static_cast<uint32_t>(elem_bytes);
-  tbl->first_ent = ((tbl->first_ent + 1) % tbl->cap_entries);
+  tbl->first_ent = (tbl->first_ent + 1) & (tbl->cap_entries - 1);
   tbl->num_ents--;
   GRPC_MDELEM_UNREF(first_ent);
 }
 
+/* the capacity needed to hold n entries: a power of two, and never less than
+   kInitialCapacity */
+static uint32_t capacity_for_entries(uint32_t n) {
+  uint32_t cap = grpc_chttp2_hptbl::kInitialCapacity;
+  while (cap < n) cap *= 2;
+  return cap;
+}
+
 static void rebuild_ents(grpc_chttp2_hptbl* tbl, uint32_t new_cap) {
+  GPR_DEBUG_ASSERT((new_cap & (new_cap - 1)) == 0);
+  GPR_DEBUG_ASSERT(new_cap >= tbl->num_ents);
   grpc_mdelem* ents =
       static_cast<grpc_mdelem*>(gpr_malloc(sizeof(*ents) * new_cap));
   uint32_t i;
 
   for (i = 0; i < tbl->num_ents; i++) {
-    ents[i] = tbl->ents[(tbl->first_ent + i) % tbl->cap_entries];
+    ents[i] = tbl->ents[(tbl->first_ent + i) & (tbl->cap_entries - 1)];
   }
   gpr_free(tbl->ents);
   tbl->ents = ents;
@@ -120,17 +130,30 @@ grpc_error* grpc_chttp2_hptbl_set_current_table_size(grpc_chttp2_hptbl* tbl,
   }
   tbl->current_table_bytes = bytes;
   tbl->max_entries = grpc_chttp2_hptbl::entries_for_bytes(bytes);
-  if (tbl->max_entries > tbl->cap_entries) {
-    rebuild_ents(tbl, GPR_MAX(tbl->max_entries, 2 * tbl->cap_entries));
-  } else if (tbl->max_entries < tbl->cap_entries / 3) {
-    uint32_t new_cap = GPR_MAX(tbl->max_entries, 16u);
-    if (new_cap != tbl->cap_entries) {
+  /* growing is left to grpc_chttp2_hptbl_add, as entries actually arrive */
+  if (tbl->cap_entries != 0 && tbl->max_entries < tbl->cap_entries / 3) {
+    uint32_t new_cap = capacity_for_entries(tbl->max_entries);
+    if (new_cap < tbl->cap_entries) {
       rebuild_ents(tbl, new_cap);
     }
   }
   return GRPC_ERROR_NONE;
 }
 
+void grpc_chttp2_hptbl_shrink_to_fit(grpc_chttp2_hptbl* tbl) {
+  if (tbl->num_ents == 0) {
+    gpr_free(tbl->ents);
+    tbl->ents = nullptr;
+    tbl->cap_entries = 0;
+    tbl->first_ent = 0;
+    return;
+  }
+  uint32_t new_cap = capacity_for_entries(tbl->num_ents);
+  if (new_cap < tbl->cap_entries) {
+    rebuild_ents(tbl, new_cap);
+  }
+}
+
 grpc_error* grpc_chttp2_hptbl_add(grpc_chttp2_hptbl* tbl, grpc_mdelem md) {
   /* determine how many bytes of buffer this entry represents */
   size_t elem_bytes = GRPC_SLICE_LENGTH(GRPC_MDKEY(md)) +
@@ -172,8 +195,12 @@ grpc_error* grpc_chttp2_hptbl_add(grpc_chttp2_hptbl* tbl, grpc_mdelem md) {
     evict1(tbl);
   }
 
+  if (tbl->num_ents == tbl->cap_entries) {
+    rebuild_ents(tbl, capacity_for_entries(tbl->num_ents + 1));
+  }
+
   /* copy the finalized entry in */
-  tbl->ents[(tbl->first_ent + tbl->num_ents) % tbl->cap_entries] =
+  tbl->ents[(tbl->first_ent + tbl->num_ents) & (tbl->cap_entries - 1)] =
       GRPC_MDELEM_REF(md);
 
   /* update accounting values */
@@ -200,7 +227,7 @@ grpc_chttp2_hptbl_find_result grpc_chttp2_hptbl_find(
   for (i = 0; i < tbl->num_ents; i++) {
     uint32_t idx = static_cast<uint32_t>(tbl->num_ents - i +
                                          GRPC_CHTTP2_LAST_STATIC_ENTRY);
-    grpc_mdelem ent = tbl->ents[(tbl->first_ent + i) % tbl->cap_entries];
+    grpc_mdelem ent = tbl->ents[(tbl->first_ent + i) & (tbl->cap_entries - 1)];
     if (!grpc_slice_eq(GRPC_MDKEY(md), GRPC_MDKEY(ent))) continue;
     r.index = idx;
     r.has_value = grpc_slice_eq(GRPC_MDVALUE(md), GRPC_MDVALUE(ent));
@@ -52,17 +52,11 @@ struct grpc_chttp2_hptbl {
     return (bytes + GRPC_CHTTP2_HPACK_ENTRY_OVERHEAD - 1) /
            GRPC_CHTTP2_HPACK_ENTRY_OVERHEAD;
   }
-  static constexpr uint32_t kInitialCapacity =
-      (GRPC_CHTTP2_INITIAL_HPACK_TABLE_SIZE + GRPC_CHTTP2_HPACK_ENTRY_OVERHEAD -
-       1) /
-      GRPC_CHTTP2_HPACK_ENTRY_OVERHEAD;
-
-  grpc_chttp2_hptbl() {
-    GPR_DEBUG_ASSERT(!ents);
-    constexpr uint32_t AllocSize = sizeof(*ents) * kInitialCapacity;
-    ents = static_cast<grpc_mdelem*>(gpr_malloc(AllocSize));
-    memset(ents, 0, AllocSize);
-  }
+  /* ents is allocated on the first add, with room for this many entries, and
+     doubled as it fills: most peers put only a handful of headers in the
+     table, so sizing it for the advertised table size up front wastes memory
+     on every connection */
+  static constexpr uint32_t kInitialCapacity = 16;
 
   /* the first used entry in ents */
   uint32_t first_ent = 0;
@@ -77,9 +71,11 @@ struct grpc_chttp2_hptbl {
   uint32_t current_table_bytes = GRPC_CHTTP2_INITIAL_HPACK_TABLE_SIZE;
   /* Maximum number of entries we could possibly fit in the table, given defined
      overheads */
-  uint32_t max_entries = kInitialCapacity;
-  /* Number of entries allocated in ents */
-  uint32_t cap_entries = kInitialCapacity;
+  uint32_t max_entries =
+      entries_for_bytes(GRPC_CHTTP2_INITIAL_HPACK_TABLE_SIZE);
+  /* Number of entries allocated in ents: zero or a power of two, so that
+     positions in the ring can be masked rather than divided */
+  uint32_t cap_entries = 0;
   /* a circular buffer of headers - this is stored in the opposite order to
      what hpack specifies, in order to simplify table management a little...
      meaning lookups need to SUBTRACT from the end position */
@@ -91,6 +87,9 @@ void grpc_chttp2_hptbl_set_max_bytes(grpc_chttp2_hptbl* tbl,
                                      uint32_t max_bytes);
 grpc_error* grpc_chttp2_hptbl_set_current_table_size(grpc_chttp2_hptbl* tbl,
                                                      uint32_t bytes);
+/* Shrinks ents to the smallest capacity that holds the current entries, or
+   frees it if there are none, for idle connections */
+void grpc_chttp2_hptbl_shrink_to_fit(grpc_chttp2_hptbl* tbl);
 
 /* lookup a table entry based on its hpack index */
 grpc_mdelem grpc_chttp2_hptbl_lookup_dynamic_index(const grpc_chttp2_hptbl* tbl,
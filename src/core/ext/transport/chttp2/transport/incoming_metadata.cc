@@ -35,8 +35,14 @@ grpc_error* grpc_chttp2_incoming_metadata_buffer_add(
     storage = &buffer->preallocated_mdelems[buffer->count];
     buffer->count++;
   } else {
-    storage = static_cast<grpc_linked_mdelem*>(
-        buffer->arena->Alloc(sizeof(grpc_linked_mdelem)));
+    if (buffer->overflow_left == 0) {
+      buffer->overflow_mdelems =
+          static_cast<grpc_linked_mdelem*>(buffer->arena->Alloc(
+              sizeof(grpc_linked_mdelem) * buffer->kPreallocatedMDElem));
+      buffer->overflow_left = buffer->kPreallocatedMDElem;
+    }
+    storage = buffer->overflow_mdelems++;
+    buffer->overflow_left--;
   }
   storage->md = elem;
   return grpc_metadata_batch_link_tail(&buffer->batch, storage);
@@ -44,13 +50,12 @@ grpc_error* grpc_chttp2_incoming_metadata_buffer_add(
 
 grpc_error* grpc_chttp2_incoming_metadata_buffer_replace_or_add(
     grpc_chttp2_incoming_metadata_buffer* buffer, grpc_mdelem elem) {
-  for (grpc_linked_mdelem* l = buffer->batch.list.head; l != nullptr;
-       l = l->next) {
-    if (grpc_slice_eq(GRPC_MDKEY(l->md), GRPC_MDKEY(elem))) {
-      GRPC_MDELEM_UNREF(l->md);
-      l->md = elem;
-      return GRPC_ERROR_NONE;
-    }
+  grpc_linked_mdelem* l =
+      grpc_metadata_batch_find(&buffer->batch, GRPC_MDKEY(elem));
+  if (l != nullptr) {
+    GRPC_MDELEM_UNREF(l->md);
+    l->md = elem;
+    return GRPC_ERROR_NONE;
   }
   return grpc_chttp2_incoming_metadata_buffer_add(buffer, elem);
 }
@@ -40,6 +40,10 @@ struct grpc_chttp2_incoming_metadata_buffer {
   size_t count = 0;  // minimum of count of metadata and kPreallocatedMDElem.
   // These preallocated mdelems are used while count < kPreallocatedMDElem.
   grpc_linked_mdelem preallocated_mdelems[kPreallocatedMDElem];
+  // Past that, mdelems are carved out of arena chunks of kPreallocatedMDElem
+  // rather than allocated one by one.
+  grpc_linked_mdelem* overflow_mdelems = nullptr;
+  size_t overflow_left = 0;
   grpc_metadata_batch batch;
 };
 
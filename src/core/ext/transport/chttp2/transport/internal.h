@@ -38,10 +38,12 @@
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/compression/stream_compression.h"
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/connectivity_state.h"
 #include "src/core/lib/transport/transport_impl.h"
 
@@ -198,6 +200,9 @@ typedef enum {
 
 typedef enum {
   GRPC_CHTTP2_NO_GOAWAY_SEND,
+  /* A server's first GOAWAY of a graceful shutdown, with the maximum last
+     stream id, is out; the real one follows once the peer has acked a ping */
+  GRPC_CHTTP2_GRACEFUL_GOAWAY_SENT,
   GRPC_CHTTP2_GOAWAY_SEND_SCHEDULED,
   GRPC_CHTTP2_GOAWAY_SENT,
 } grpc_chttp2_sent_goaway_state;
@@ -215,6 +220,7 @@ class Chttp2IncomingByteStream : public ByteStream {
   Chttp2IncomingByteStream(grpc_chttp2_transport* transport,
                            grpc_chttp2_stream* stream, uint32_t frame_size,
                            uint32_t flags);
+  ~Chttp2IncomingByteStream();
 
   void Orphan() override;
 
@@ -251,6 +257,11 @@ class Chttp2IncomingByteStream : public ByteStream {
 
   uint32_t remaining_bytes() const { return remaining_bytes_; }
 
+  // Copies pushed slices into a single slice of the message's length, which
+  // is handed out by the Push() that completes it; earlier Push() calls hand
+  // out empty slices. Must be called before the first Push().
+  void AssembleContiguously();
+
  private:
   static void NextLocked(void* arg, grpc_error* error_ignored);
   static void OrphanLocked(void* arg, grpc_error* error_ignored);
@@ -267,6 +278,10 @@ class Chttp2IncomingByteStream : public ByteStream {
    * true */
   uint32_t remaining_bytes_;
 
+  /* Accessed as remaining_bytes_ is */
+  bool assembling_ = false;
+  grpc_slice assembly_ = grpc_empty_slice();
+
   /* Accessed only by transport thread when stream->pending_byte_stream == false
    * Accessed only by application thread when stream->pending_byte_stream ==
    * true */
@@ -330,6 +345,7 @@ struct grpc_chttp2_transport {
   grpc_closure write_action_begin_locked;
   grpc_closure write_action;
   grpc_closure write_action_end_locked;
+  grpc_closure write_coalescing_timer_fired_locked;
 
   grpc_closure read_action_locked;
 
@@ -365,11 +381,63 @@ struct grpc_chttp2_transport {
    */
   uint32_t write_buffer_size = grpc_core::chttp2::kDefaultWindow;
 
+  /** how many DATA bytes a stream may write per turn in the writable list
+      (see GRPC_ARG_HTTP2_WRITE_QUANTUM_BYTES); 0 for no limit */
+  uint32_t write_quantum = 64 * 1024;
+
+  /** limit announced windows by the resource quota's memory pressure (see
+      GRPC_ARG_HTTP2_MEMORY_BUDGET_WINDOWS) */
+  bool memory_budget_windows = false;
+
+  /** estimate the bdp from delivery rate and round trip time samples (see
+      GRPC_ARG_HTTP2_BDP_DELIVERY_RATE_ESTIMATION) */
+  bool bdp_delivery_rate_estimation = false;
+
+  /** messages up to this size spanning several slices are gathered into one
+      contiguous slice as they are parsed (see
+      GRPC_ARG_HTTP2_MAX_CONTIGUOUS_RECV_MESSAGE_SIZE) */
+  uint32_t max_contiguous_recv_message_size = 0;
+
+  /** write coalescing: a write of stream frames initiated less than
+      write_coalescing_window_us after the previous write finished is held
+      back for up to that long, or until write_coalescing_max_bytes of
+      messages are queued, so that frames from other streams can join it.
+      A window of zero disables this. */
+  int write_coalescing_window_us = 0;
+  size_t write_coalescing_max_bytes = 64 * 1024;
+  /** is a write being held back right now? */
+  bool write_coalescing = false;
+  /** releases the write being held back at the end of the window */
+  grpc_timer write_coalescing_timer;
+  /** is write_coalescing_timer set and not yet run? */
+  bool write_coalescing_timer_pending = false;
+  /** bytes of messages queued since the last write began */
+  size_t write_coalescing_bytes = 0;
+  /** when the last endpoint write finished */
+  gpr_timespec last_write_end = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+
+  /** idle release: once there have been no streams for idle_release_timeout,
+      memory only needed by active calls is dropped (see
+      GRPC_ARG_HTTP2_IDLE_RELEASE_MS). GRPC_MILLIS_INF_FUTURE disables it. */
+  grpc_millis idle_release_timeout;
+  /** when the last stream went away */
+  grpc_millis idle_since;
+  bool have_idle_release_timer = false;
+  grpc_timer idle_release_timer;
+  grpc_closure idle_release_locked;
+
   /** Set to a grpc_error object if a goaway frame is received. By default, set
    * to GRPC_ERROR_NONE */
   grpc_error* goaway_error = GRPC_ERROR_NONE;
 
   grpc_chttp2_sent_goaway_state sent_goaway_state = GRPC_CHTTP2_NO_GOAWAY_SEND;
+  /** the error of the final GOAWAY of a graceful shutdown, sent when the
+      ping sent with the first GOAWAY is acked or graceful_goaway_timer
+      fires, whichever is first */
+  grpc_error* graceful_goaway_error = GRPC_ERROR_NONE;
+  grpc_closure graceful_goaway_ping_acked_locked;
+  grpc_closure graceful_goaway_timer_fired_locked;
+  grpc_timer graceful_goaway_timer;
 
   /** are the local settings dirty and need to be sent? */
   bool dirtied_local_settings = true;
@@ -389,6 +457,11 @@ struct grpc_chttp2_transport {
   /** last new stream id */
   uint32_t last_new_stream_id = 0;
 
+  /** how many more streams the peer lets us start right now (0 while streams
+      wait for concurrency); written under the combiner, read from any thread
+      by grpc_transport_get_available_streams */
+  grpc_core::Atomic<int32_t> available_streams{INT32_MAX};
+
   /** ping queues for various ping insertion points */
   grpc_chttp2_ping_queue ping_queue = grpc_chttp2_ping_queue();
   grpc_chttp2_repeated_ping_policy ping_policy;
@@ -433,6 +506,11 @@ struct grpc_chttp2_transport {
   uint32_t expect_continuation_stream_id = 0;
   uint32_t incoming_frame_size = 0;
   uint32_t incoming_stream_id = 0;
+  /* bytes still to come of the last gRPC message DATA was received for, used
+     as a read hint for the endpoint, and the stream it belongs to; reset when
+     that stream's reads are closed */
+  uint32_t incoming_message_bytes_expected = 0;
+  uint32_t incoming_message_stream_id = 0;
 
   /* active parser */
   void* parser_data = nullptr;
@@ -484,6 +562,9 @@ struct grpc_chttp2_transport {
   grpc_timer keepalive_watchdog_timer;
   /** time duration in between pings */
   grpc_millis keepalive_time;
+  /** when data was last read or a bdp ping started; the keepalive ping timer
+      is not reset on each read, but re-armed from this when it fires */
+  grpc_millis keepalive_last_activity = 0;
   /** grace period for a ping to complete before watchdog kicks in */
   grpc_millis keepalive_timeout;
   /** if keepalive pings are allowed when there's no outstanding streams */
@@ -509,12 +590,49 @@ typedef enum {
   GRPC_METADATA_PUBLISHED_AT_CLOSE
 } grpc_published_metadata_method;
 
+/** Stream compression state of a stream whose content-encoding is not
+    identity, in either direction. Allocated from the call arena the first
+    time it is needed, as almost no stream uses it. */
+struct grpc_chttp2_stream_compression {
+  grpc_chttp2_stream_compression() {
+    grpc_slice_buffer_init(&compressed_data_buffer);
+    grpc_slice_buffer_init(&decompressed_data_buffer);
+  }
+  ~grpc_chttp2_stream_compression() {
+    if (stream_compression_ctx != nullptr) {
+      grpc_stream_compression_context_destroy(stream_compression_ctx);
+    }
+    if (stream_decompression_ctx != nullptr) {
+      grpc_stream_compression_context_destroy(stream_decompression_ctx);
+    }
+    grpc_slice_buffer_destroy_internal(&compressed_data_buffer);
+    grpc_slice_buffer_destroy_internal(&decompressed_data_buffer);
+  }
+
+  /** Amount of uncompressed bytes sent out when compressed_data_buffer is
+   * emptied */
+  size_t uncompressed_data_size = 0;
+  /** Stream compression compress context */
+  grpc_stream_compression_context* stream_compression_ctx = nullptr;
+  /** Buffer storing data that is compressed but not sent */
+  grpc_slice_buffer compressed_data_buffer;
+
+  /** Stream compression decompress context */
+  grpc_stream_compression_context* stream_decompression_ctx = nullptr;
+  /** gRPC header bytes that are already decompressed */
+  size_t decompressed_header_bytes = 0;
+  /** Temporary buffer storing decompressed data */
+  grpc_slice_buffer decompressed_data_buffer;
+};
+
 struct grpc_chttp2_stream {
   grpc_chttp2_stream(grpc_chttp2_transport* t, grpc_stream_refcount* refcount,
                      const void* server_data, grpc_core::Arena* arena);
   ~grpc_chttp2_stream();
 
-  void* context;
+  /** The call's context, set by its first op; null on a server stream whose
+      headers are still being parsed */
+  void* context = nullptr;
   grpc_chttp2_transport* t;
   grpc_stream_refcount* refcount;
   // Reffer is a 0-len structure, simply reffing `t` and `refcount` in its ctor
@@ -523,15 +641,28 @@ struct grpc_chttp2_stream {
   struct Reffer {
     explicit Reffer(grpc_chttp2_stream* s);
   } reffer;
-
-  grpc_closure destroy_stream;
-  grpc_closure* destroy_stream_arg;
-
-  grpc_chttp2_stream_link links[STREAM_LIST_COUNT];
-  uint8_t included[STREAM_LIST_COUNT] = {};
+  /** the call arena, for state that is only allocated when needed */
+  grpc_core::Arena* arena;
 
   /** HTTP2 stream id for this stream, or zero if one has not been assigned */
   uint32_t id = 0;
+  /* The state checked by every frame and write of the stream is packed here,
+     next to id, in the first cache line. */
+  /** Is this stream closed for writing. */
+  bool write_closed = false;
+  /** Is this stream reading half-closed. */
+  bool read_closed = false;
+  /** Has this stream seen an error.
+      If true, then pending incoming frames can be thrown away. */
+  bool seen_error = false;
+  /** Are we buffering writes on this stream? If yes, we won't become writable
+      until there's enough queued up in the flow_controlled_buffer */
+  bool write_buffering = false;
+  uint8_t included[STREAM_LIST_COUNT] = {};
+  grpc_chttp2_stream_link links[STREAM_LIST_COUNT];
+
+  grpc_closure destroy_stream;
+  grpc_closure* destroy_stream_arg;
 
   /** things the upper layers would like to send */
   grpc_metadata_batch* send_initial_metadata = nullptr;
@@ -559,18 +690,8 @@ struct grpc_chttp2_stream {
   grpc_transport_stream_stats* collecting_stats = nullptr;
   grpc_transport_stream_stats stats = grpc_transport_stream_stats();
 
-  /** Is this stream closed for writing. */
-  bool write_closed = false;
-  /** Is this stream reading half-closed. */
-  bool read_closed = false;
   /** Are all published incoming byte streams closed. */
   bool all_incoming_byte_streams_finished = false;
-  /** Has this stream seen an error.
-      If true, then pending incoming frames can be thrown away. */
-  bool seen_error = false;
-  /** Are we buffering writes on this stream? If yes, we won't become writable
-      until there's enough queued up in the flow_controlled_buffer */
-  bool write_buffering = false;
 
   /* have we sent or received the EOS bit? */
   bool eos_received = false;
@@ -584,7 +705,10 @@ struct grpc_chttp2_stream {
   grpc_published_metadata_method published_metadata[2] = {};
   bool final_metadata_requested = false;
 
-  grpc_chttp2_incoming_metadata_buffer metadata_buffer[2];
+  grpc_chttp2_incoming_metadata_buffer initial_metadata_buffer;
+  /** allocated from the arena when trailing metadata is first received or
+      synthesized; servers rarely get any */
+  grpc_chttp2_incoming_metadata_buffer* trailing_metadata_buffer = nullptr;
 
   grpc_slice_buffer frame_storage; /* protected by t combiner */
 
@@ -614,6 +738,9 @@ struct grpc_chttp2_stream {
    * Accessed only by application thread when stream->pending_byte_stream ==
    * true */
   grpc_chttp2_data_parser data_parser;
+  /** message framing of the DATA received so far, for read hints; accessed
+      only by the transport thread */
+  grpc_chttp2_data_length_tracker data_length_tracker;
   /** number of bytes received - reset at end of parse thread execution */
   int64_t received_bytes = 0;
 
@@ -632,6 +759,9 @@ struct grpc_chttp2_stream {
   grpc_chttp2_write_cb* on_write_finished_cbs = nullptr;
   grpc_chttp2_write_cb* finish_after_write = nullptr;
   size_t sending_bytes = 0;
+  /** DATA bytes the stream may still write in its current turn; may go
+      negative, by less than a frame, to be paid back the next turn */
+  int64_t write_deficit = 0;
 
   /* Stream compression method to be used. */
   grpc_stream_compression_method stream_compression_method =
@@ -645,28 +775,22 @@ struct grpc_chttp2_stream {
   bool unprocessed_incoming_frames_decompressed = false;
   /** Whether the bytes needs to be traced using Fathom */
   bool traced = false;
-  /** gRPC header bytes that are already decompressed */
-  size_t decompressed_header_bytes = 0;
   /** Byte counter for number of bytes written */
   size_t byte_counter = 0;
 
-  /** Amount of uncompressed bytes sent out when compressed_data_buffer is
-   * emptied */
-  size_t uncompressed_data_size;
-  /** Stream compression compress context */
-  grpc_stream_compression_context* stream_compression_ctx;
-  /** Buffer storing data that is compressed but not sent */
-  grpc_slice_buffer compressed_data_buffer;
-
-  /** Stream compression decompress context */
-  grpc_stream_compression_context* stream_decompression_ctx;
-  /** Temporary buffer storing decompressed data.
-   * Initialized, used, and destroyed only when stream uses (non-identity)
-   * compression.
-   */
-  grpc_slice_buffer decompressed_data_buffer;
+  /** Set once either compression method is not identity; see
+      grpc_chttp2_stream_get_compression() */
+  grpc_chttp2_stream_compression* compression = nullptr;
 };
 
+/** Returns s->compression, allocating it from the call arena if need be. */
+grpc_chttp2_stream_compression* grpc_chttp2_stream_get_compression(
+    grpc_chttp2_stream* s);
+/** Returns s->trailing_metadata_buffer, allocating it from the call arena if
+    need be. */
+grpc_chttp2_incoming_metadata_buffer*
+grpc_chttp2_stream_get_trailing_metadata_buffer(grpc_chttp2_stream* s);
+
 /** Transport writing call flow:
     grpc_chttp2_initiate_write() is called anywhere that we know bytes need to
     go out on the wire.
@@ -726,6 +850,9 @@ bool grpc_chttp2_list_pop_waiting_for_concurrency(grpc_chttp2_transport* t,
                                                   grpc_chttp2_stream** s);
 void grpc_chttp2_list_remove_waiting_for_concurrency(grpc_chttp2_transport* t,
                                                      grpc_chttp2_stream* s);
+/** recompute t->available_streams after the streams or the peer's settings
+    changed */
+void grpc_chttp2_update_available_streams(grpc_chttp2_transport* t);
 
 void grpc_chttp2_list_add_stalled_by_transport(grpc_chttp2_transport* t,
                                                grpc_chttp2_stream* s);
@@ -26,7 +26,9 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/channel/call_latency_breakdown.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/slice/slice_utils.h"
 #include "src/core/lib/transport/http2_errors.h"
@@ -175,6 +177,8 @@ grpc_error* grpc_chttp2_perform_read(grpc_chttp2_transport* t,
       GPR_DEBUG_ASSERT(cur < end);
       t->incoming_stream_id |= (static_cast<uint32_t>(*cur));
       t->deframe_state = GRPC_DTS_FRAME;
+      GRPC_USDT4(frame_parsed, t->incoming_frame_type, t->incoming_frame_flags,
+                 t->incoming_stream_id, t->incoming_frame_size);
       err = init_frame_parser(t);
       if (err != GRPC_ERROR_NONE) {
         return err;
@@ -425,6 +429,9 @@ static void on_initial_header(void* tp, grpc_mdelem md) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
   grpc_chttp2_stream* s = t->incoming_stream;
   GPR_DEBUG_ASSERT(s != nullptr);
+  grpc_core::CallLatencyRecord(
+      static_cast<grpc_call_context_element*>(s->context),
+      grpc_core::CallLatencyStage::kInitialMetadataParsed);
 
   if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
     char* key = grpc_slice_to_c_string(GRPC_MDKEY(md));
@@ -462,13 +469,15 @@ static void on_initial_header(void* tp, grpc_mdelem md) {
     }
     if (timeout != GRPC_MILLIS_INF_FUTURE) {
       grpc_chttp2_incoming_metadata_buffer_set_deadline(
-          &s->metadata_buffer[0], grpc_core::ExecCtx::Get()->Now() + timeout);
+          &s->initial_metadata_buffer,
+          grpc_core::ExecCtx::Get()->Now() + timeout);
     }
     GRPC_MDELEM_UNREF(md);
     return;
   }
 
-  const size_t new_size = s->metadata_buffer[0].size + GRPC_MDELEM_LENGTH(md);
+  const size_t new_size =
+      s->initial_metadata_buffer.size + GRPC_MDELEM_LENGTH(md);
   const size_t metadata_size_limit =
       t->settings[GRPC_ACKED_SETTINGS]
                  [GRPC_CHTTP2_SETTINGS_MAX_HEADER_LIST_SIZE];
@@ -487,8 +496,8 @@ static void on_initial_header(void* tp, grpc_mdelem md) {
     s->seen_error = true;
     GRPC_MDELEM_UNREF(md);
   } else {
-    grpc_error* error =
-        grpc_chttp2_incoming_metadata_buffer_add(&s->metadata_buffer[0], md);
+    grpc_error* error = grpc_chttp2_incoming_metadata_buffer_add(
+        &s->initial_metadata_buffer, md);
     if (error != GRPC_ERROR_NONE) {
       grpc_chttp2_cancel_stream(t, s, error);
       grpc_chttp2_parsing_become_skip_parser(t);
@@ -519,7 +528,10 @@ static void on_trailing_header(void* tp, grpc_mdelem md) {
     s->seen_error = true;
   }
 
-  const size_t new_size = s->metadata_buffer[1].size + GRPC_MDELEM_LENGTH(md);
+  grpc_chttp2_incoming_metadata_buffer* trailing_metadata_buffer =
+      grpc_chttp2_stream_get_trailing_metadata_buffer(s);
+  const size_t new_size =
+      trailing_metadata_buffer->size + GRPC_MDELEM_LENGTH(md);
   const size_t metadata_size_limit =
       t->settings[GRPC_ACKED_SETTINGS]
                  [GRPC_CHTTP2_SETTINGS_MAX_HEADER_LIST_SIZE];
@@ -539,7 +551,7 @@ static void on_trailing_header(void* tp, grpc_mdelem md) {
     GRPC_MDELEM_UNREF(md);
   } else {
     grpc_error* error =
-        grpc_chttp2_incoming_metadata_buffer_add(&s->metadata_buffer[1], md);
+        grpc_chttp2_incoming_metadata_buffer_add(trailing_metadata_buffer, md);
     if (error != GRPC_ERROR_NONE) {
       grpc_chttp2_cancel_stream(t, s, error);
       grpc_chttp2_parsing_become_skip_parser(t);
@@ -25,6 +25,138 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#ifdef GRPC_CHTTP2_HASH_STREAM_MAP
+
+/* marks a slot whose entry was deleted: probe sequences continue past it */
+static char tombstone_marker;
+#define TOMBSTONE (static_cast<void*>(&tombstone_marker))
+
+static bool is_live(void* value) {
+  return value != nullptr && value != TOMBSTONE;
+}
+
+/* fibonacci hashing: stream ids are sequential (and all odd or all even), so
+   multiplying spreads them well across the table */
+static size_t hash_slot(uint32_t key, size_t capacity) {
+  return static_cast<size_t>(key * 2654435769u) & (capacity - 1);
+}
+
+static void alloc_table(grpc_chttp2_stream_map* map, size_t capacity) {
+  map->keys = static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * capacity));
+  map->values = static_cast<void**>(gpr_zalloc(sizeof(void*) * capacity));
+  map->tombstones = 0;
+  map->capacity = capacity;
+}
+
+void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
+                                 size_t initial_capacity) {
+  GPR_DEBUG_ASSERT(initial_capacity > 1);
+  size_t capacity = 4;
+  while (capacity < initial_capacity) capacity *= 2;
+  alloc_table(map, capacity);
+  map->count = 0;
+}
+
+void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
+  gpr_free(map->keys);
+  gpr_free(map->values);
+}
+
+/* the slot holding key, or nullptr if it isn't present */
+static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
+  size_t mask = map->capacity - 1;
+  for (size_t i = hash_slot(key, map->capacity);; i = (i + 1) & mask) {
+    void* value = map->values[i];
+    if (value == nullptr) return nullptr;
+    if (value != TOMBSTONE && map->keys[i] == key) return &map->values[i];
+  }
+}
+
+/* insert into a slot known to be free of key (there is always an empty or
+   tombstone slot, since the load including tombstones stays under 3/4) */
+static void insert(grpc_chttp2_stream_map* map, uint32_t key, void* value) {
+  size_t mask = map->capacity - 1;
+  size_t i = hash_slot(key, map->capacity);
+  while (is_live(map->values[i])) i = (i + 1) & mask;
+  if (map->values[i] == TOMBSTONE) map->tombstones--;
+  map->keys[i] = key;
+  map->values[i] = value;
+}
+
+static void rehash(grpc_chttp2_stream_map* map, size_t capacity) {
+  uint32_t* keys = map->keys;
+  void** values = map->values;
+  size_t old_capacity = map->capacity;
+  alloc_table(map, capacity);
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (is_live(values[i])) insert(map, keys[i], values[i]);
+  }
+  gpr_free(keys);
+  gpr_free(values);
+}
+
+void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
+                                void* value) {
+  GPR_DEBUG_ASSERT(value);
+  GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
+  if (4 * (map->count + map->tombstones + 1) > 3 * map->capacity) {
+    /* mostly tombstones: clean them out at the same size; otherwise grow to
+       keep the live load under one half */
+    rehash(map, 2 * (map->count + 1) > map->capacity ? 2 * map->capacity
+                                                     : map->capacity);
+  }
+  insert(map, key, value);
+  map->count++;
+}
+
+void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
+  void** pvalue = find(map, key);
+  GPR_DEBUG_ASSERT(pvalue != nullptr);
+  if (pvalue == nullptr) return nullptr;
+  void* out = *pvalue;
+  *pvalue = TOMBSTONE;
+  map->tombstones++;
+  /* recognize complete emptyness and drop all tombstones at once */
+  if (--map->count == 0) {
+    memset(map->values, 0, sizeof(void*) * map->capacity);
+    map->tombstones = 0;
+  }
+  GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
+  return out;
+}
+
+void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
+  void** pvalue = find(map, key);
+  return pvalue != nullptr ? *pvalue : nullptr;
+}
+
+size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
+  return map->count;
+}
+
+void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
+  if (map->count == 0) {
+    return nullptr;
+  }
+  size_t mask = map->capacity - 1;
+  size_t i = static_cast<size_t>(rand()) & mask;
+  while (!is_live(map->values[i])) i = (i + 1) & mask;
+  return map->values[i];
+}
+
+void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
+                                     void (*f)(void* user_data, uint32_t key,
+                                               void* value),
+                                     void* user_data) {
+  for (size_t i = 0; i < map->capacity; i++) {
+    if (is_live(map->values[i])) {
+      f(user_data, map->keys[i], map->values[i]);
+    }
+  }
+}
+
+#else /* GRPC_CHTTP2_HASH_STREAM_MAP */
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
   GPR_DEBUG_ASSERT(initial_capacity > 1);
@@ -175,3 +307,5 @@ void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
     }
   }
 }
+
+#endif /* GRPC_CHTTP2_HASH_STREAM_MAP */
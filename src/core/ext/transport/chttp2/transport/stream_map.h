@@ -28,7 +28,23 @@
    Represented as a sorted array of keys, and a corresponding array of values.
    Lookups are performed with binary search.
    Adds are restricted to strictly higher keys than previously seen (this is
-   guaranteed by http2). */
+   guaranteed by http2).
+
+   Building with GRPC_CHTTP2_HASH_STREAM_MAP defined instead represents the map
+   as an open addressing hash table (linear probing, power of two capacity),
+   which keeps lookups and deletes constant time for connections with very
+   many concurrent streams. Deleted entries leave tombstones (so that
+   for_each tolerates deletes from its callback) which are reclaimed when the
+   table is rehashed. for_each then visits streams in no particular order. */
+#ifdef GRPC_CHTTP2_HASH_STREAM_MAP
+typedef struct {
+  uint32_t* keys;
+  void** values;
+  size_t count;
+  size_t tombstones;
+  size_t capacity;
+} grpc_chttp2_stream_map;
+#else
 typedef struct {
   uint32_t* keys;
   void** values;
@@ -36,6 +52,7 @@ typedef struct {
   size_t free;
   size_t capacity;
 } grpc_chttp2_stream_map;
+#endif
 
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
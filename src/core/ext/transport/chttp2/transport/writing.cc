@@ -25,6 +25,7 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/call_latency_breakdown.h"
 #include "src/core/lib/compression/stream_compression.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/profiling/timers.h"
@@ -158,7 +159,7 @@ static void report_stall(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
         s->stream_compression_method ==
                 GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS
             ? 0
-            : s->compressed_data_buffer.length,
+            : s->compression->compressed_data_buffer.length,
         s->flow_controlled_bytes_flowed,
         t->settings[GRPC_ACKED_SETTINGS]
                    [GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE],
@@ -200,6 +201,9 @@ class WriteContext {
     GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(
         trailing_metadata_writes_);
     GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(flow_control_writes_);
+    GRPC_STATS_INC_HTTP2_FRAMES_PER_WRITE(
+        initial_metadata_writes_ + message_writes_ +
+        trailing_metadata_writes_ + flow_control_writes_);
   }
 
   void FlushSettings() {
@@ -335,6 +339,11 @@ class DataSendContext {
 
   bool AnyOutgoing() const { return max_outgoing() > 0; }
 
+  // Whether the stream may start another frame in this turn.
+  bool HasQuantum() const {
+    return t_->write_quantum == 0 || s_->write_deficit > 0;
+  }
+
   void FlushUncompressedBytes() {
     uint32_t send_bytes = static_cast<uint32_t> GPR_MIN(
         max_outgoing(), s_->flow_controlled_buffer.length);
@@ -346,29 +355,31 @@ class DataSendContext {
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control->SentData(send_bytes);
     s_->sending_bytes += send_bytes;
+    s_->write_deficit -= send_bytes;
   }
 
   void FlushCompressedBytes() {
     GPR_DEBUG_ASSERT(s_->stream_compression_method !=
                      GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS);
+    grpc_chttp2_stream_compression* c = s_->compression;
 
     uint32_t send_bytes = static_cast<uint32_t> GPR_MIN(
-        max_outgoing(), s_->compressed_data_buffer.length);
+        max_outgoing(), c->compressed_data_buffer.length);
     bool is_last_data_frame =
-        (send_bytes == s_->compressed_data_buffer.length &&
+        (send_bytes == c->compressed_data_buffer.length &&
          s_->flow_controlled_buffer.length == 0 &&
          s_->fetching_send_message == nullptr);
     if (is_last_data_frame && s_->send_trailing_metadata != nullptr &&
-        s_->stream_compression_ctx != nullptr) {
+        c->stream_compression_ctx != nullptr) {
       if (GPR_UNLIKELY(!grpc_stream_compress(
-              s_->stream_compression_ctx, &s_->flow_controlled_buffer,
-              &s_->compressed_data_buffer, nullptr, MAX_SIZE_T,
+              c->stream_compression_ctx, &s_->flow_controlled_buffer,
+              &c->compressed_data_buffer, nullptr, MAX_SIZE_T,
               GRPC_STREAM_COMPRESSION_FLUSH_FINISH))) {
         gpr_log(GPR_ERROR, "Stream compression failed.");
       }
-      grpc_stream_compression_context_destroy(s_->stream_compression_ctx);
-      s_->stream_compression_ctx = nullptr;
-      /* After finish, bytes in s->compressed_data_buffer may be
+      grpc_stream_compression_context_destroy(c->stream_compression_ctx);
+      c->stream_compression_ctx = nullptr;
+      /* After finish, bytes in c->compressed_data_buffer may be
        * more than max_outgoing. Start another round of the current
        * while loop so that send_bytes and is_last_data_frame are
        * recalculated. */
@@ -377,26 +388,28 @@ class DataSendContext {
     is_last_frame_ = is_last_data_frame &&
                      s_->send_trailing_metadata != nullptr &&
                      grpc_metadata_batch_is_empty(s_->send_trailing_metadata);
-    grpc_chttp2_encode_data(s_->id, &s_->compressed_data_buffer, send_bytes,
+    grpc_chttp2_encode_data(s_->id, &c->compressed_data_buffer, send_bytes,
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control->SentData(send_bytes);
-    if (s_->compressed_data_buffer.length == 0) {
-      s_->sending_bytes += s_->uncompressed_data_size;
+    s_->write_deficit -= send_bytes;
+    if (c->compressed_data_buffer.length == 0) {
+      s_->sending_bytes += c->uncompressed_data_size;
     }
   }
 
   void CompressMoreBytes() {
     GPR_DEBUG_ASSERT(s_->stream_compression_method !=
                      GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS);
+    grpc_chttp2_stream_compression* c = s_->compression;
 
-    if (s_->stream_compression_ctx == nullptr) {
-      s_->stream_compression_ctx =
+    if (c->stream_compression_ctx == nullptr) {
+      c->stream_compression_ctx =
           grpc_stream_compression_context_create(s_->stream_compression_method);
     }
-    s_->uncompressed_data_size = s_->flow_controlled_buffer.length;
+    c->uncompressed_data_size = s_->flow_controlled_buffer.length;
     if (GPR_UNLIKELY(!grpc_stream_compress(
-            s_->stream_compression_ctx, &s_->flow_controlled_buffer,
-            &s_->compressed_data_buffer, nullptr, MAX_SIZE_T,
+            c->stream_compression_ctx, &s_->flow_controlled_buffer,
+            &c->compressed_data_buffer, nullptr, MAX_SIZE_T,
             GRPC_STREAM_COMPRESSION_FLUSH_SYNC))) {
       gpr_log(GPR_ERROR, "Stream compression failed.");
     }
@@ -463,6 +476,9 @@ class StreamWriteContext {
       };
       grpc_chttp2_encode_header(&t_->hpack_compressor, nullptr, 0,
                                 s_->send_initial_metadata, &hopt, &t_->outbuf);
+      grpc_core::CallLatencyRecord(
+          static_cast<grpc_call_context_element*>(s_->context),
+          grpc_core::CallLatencyStage::kInitialMetadataEncoded);
       write_context_->ResetPingClock();
       write_context_->IncInitialMetadataWrites();
     }
@@ -479,7 +495,7 @@ class StreamWriteContext {
     return s_->stream_compression_method ==
                    GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS
                ? 0
-               : s_->compressed_data_buffer.length;
+               : s_->compression->compressed_data_buffer.length;
   }
 
   void FlushWindowUpdates() {
@@ -515,17 +531,25 @@ class StreamWriteContext {
       return;  // early out: nothing to do
     }
 
+    // Deficit round robin: each turn grants the stream write_quantum more
+    // bytes, and once they are spent it goes back to the end of the writable
+    // list, behind the streams that were waiting.
+    if (t_->write_quantum > 0) {
+      s_->write_deficit += t_->write_quantum;
+    }
     if (s_->stream_compression_method ==
         GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS) {
       while (s_->flow_controlled_buffer.length > 0 &&
-             data_send_context.max_outgoing() > 0) {
+             data_send_context.max_outgoing() > 0 &&
+             data_send_context.HasQuantum()) {
         data_send_context.FlushUncompressedBytes();
       }
     } else {
       while ((s_->flow_controlled_buffer.length > 0 ||
-              s_->compressed_data_buffer.length > 0) &&
-             data_send_context.max_outgoing() > 0) {
-        if (s_->compressed_data_buffer.length > 0) {
+              s_->compression->compressed_data_buffer.length > 0) &&
+             data_send_context.max_outgoing() > 0 &&
+             data_send_context.HasQuantum()) {
+        if (s_->compression->compressed_data_buffer.length > 0) {
           data_send_context.FlushCompressedBytes();
         } else {
           data_send_context.CompressMoreBytes();
@@ -542,6 +566,9 @@ class StreamWriteContext {
         compressed_data_buffer_len() > 0) {
       GRPC_CHTTP2_STREAM_REF(s_, "chttp2_writing:fork");
       grpc_chttp2_list_add_writable_stream(t_, s_);
+    } else {
+      // A stream with nothing left to send keeps no credit for later.
+      s_->write_deficit = 0;
     }
     write_context_->IncMessageWrites();
   }
@@ -649,7 +676,12 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     if (t->outbuf.length > orig_len) {
       /* Add this stream to the list of the contexts to be traced at TCP */
       s->byte_counter += t->outbuf.length - orig_len;
-      if (s->traced && grpc_endpoint_can_track_err(t->ep)) {
+      grpc_core::CallLatencyRecord(
+          static_cast<grpc_call_context_element*>(s->context),
+          grpc_core::CallLatencyStage::kWriteStarted);
+      // A stream that took several turns in this write is traced once.
+      if (s->traced && !s->included[GRPC_CHTTP2_LIST_WRITING] &&
+          grpc_endpoint_can_track_err(t->ep)) {
         grpc_core::ContextList::Append(&t->cl, s);
       }
     }
@@ -47,6 +47,13 @@
 
 #define GRPC_HEADER_SIZE_IN_BYTES 5
 #define GRPC_FLUSH_READ_SIZE 4096
+/* Messages sent with GRPC_WRITE_BUFFER_HINT are held back and written along
+   with later ones, up to this many bytes per write */
+#define GRPC_CRONET_MAX_COALESCED_WRITE_SIZE (16 * 1024)
+/* Write buffers released by finished streams are kept for reuse by later
+   ones: at most this many, of at most this size */
+#define GRPC_CRONET_BUFFER_POOL_SIZE 8
+#define GRPC_CRONET_MAX_POOLED_BUFFER_SIZE (64 * 1024)
 
 grpc_core::TraceFlag grpc_cronet_trace(false, "cronet");
 #define CRONET_LOG(...)                                    \
@@ -106,6 +113,11 @@ struct grpc_cronet_transport {
   stream_engine* engine;
   char* host;
   bool use_packet_coalescing;
+  /* write buffers kept for reuse, guarded by buffer_pool_mu */
+  gpr_mu buffer_pool_mu;
+  size_t num_pooled_buffers;
+  char* pooled_buffers[GRPC_CRONET_BUFFER_POOL_SIZE];
+  size_t pooled_buffer_capacities[GRPC_CRONET_BUFFER_POOL_SIZE];
 };
 typedef struct grpc_cronet_transport grpc_cronet_transport;
 
@@ -119,6 +131,10 @@ struct read_state {
 
   /* vars to store data coming from server */
   char* read_buffer = nullptr;
+  /* a message is read straight into the slice handed to the application:
+     read_buffer then points into read_slice */
+  grpc_slice read_slice = grpc_empty_slice();
+  bool read_buffer_is_slice = false;
   bool length_field_received = false;
   int received_bytes = 0;
   int remaining_bytes = 0;
@@ -141,7 +157,15 @@ struct read_state {
 };
 
 struct write_state {
+  /* bytes handed to Cronet by the last write; kept for the next one once
+     on_write_completed is received */
   char* write_buffer = nullptr;
+  size_t write_buffer_capacity = 0;
+  bool write_in_flight = false;
+  /* framed messages waiting for the next write */
+  char* pending_buffer = nullptr;
+  size_t pending_buffer_capacity = 0;
+  size_t pending_length = 0;
 };
 
 /* track state of one stream op */
@@ -285,13 +309,73 @@ static const char* op_id_string(enum e_op_id i) {
 }
 
 static void null_and_maybe_free_read_buffer(stream_obj* s) {
-  if (s->state.rs.read_buffer &&
-      s->state.rs.read_buffer != s->state.rs.grpc_header_bytes) {
+  if (s->state.rs.read_buffer_is_slice) {
+    grpc_slice_unref_internal(s->state.rs.read_slice);
+    s->state.rs.read_slice = grpc_empty_slice();
+    s->state.rs.read_buffer_is_slice = false;
+  } else if (s->state.rs.read_buffer &&
+             s->state.rs.read_buffer != s->state.rs.grpc_header_bytes) {
     gpr_free(s->state.rs.read_buffer);
   }
   s->state.rs.read_buffer = nullptr;
 }
 
+/*
+  Take a buffer of at least size bytes from the transport's pool, or allocate
+  one
+*/
+static char* get_pooled_buffer(grpc_cronet_transport* t, size_t size,
+                               size_t* capacity) {
+  gpr_mu_lock(&t->buffer_pool_mu);
+  for (size_t i = 0; i < t->num_pooled_buffers; i++) {
+    if (t->pooled_buffer_capacities[i] >= size) {
+      char* buffer = t->pooled_buffers[i];
+      *capacity = t->pooled_buffer_capacities[i];
+      t->num_pooled_buffers--;
+      t->pooled_buffers[i] = t->pooled_buffers[t->num_pooled_buffers];
+      t->pooled_buffer_capacities[i] =
+          t->pooled_buffer_capacities[t->num_pooled_buffers];
+      gpr_mu_unlock(&t->buffer_pool_mu);
+      return buffer;
+    }
+  }
+  gpr_mu_unlock(&t->buffer_pool_mu);
+  *capacity = size;
+  return static_cast<char*>(gpr_malloc(size));
+}
+
+static void put_pooled_buffer(grpc_cronet_transport* t, char* buffer,
+                              size_t capacity) {
+  if (buffer == nullptr) return;
+  if (capacity <= GRPC_CRONET_MAX_POOLED_BUFFER_SIZE) {
+    gpr_mu_lock(&t->buffer_pool_mu);
+    if (t->num_pooled_buffers < GRPC_CRONET_BUFFER_POOL_SIZE) {
+      t->pooled_buffers[t->num_pooled_buffers] = buffer;
+      t->pooled_buffer_capacities[t->num_pooled_buffers] = capacity;
+      t->num_pooled_buffers++;
+      buffer = nullptr;
+    }
+    gpr_mu_unlock(&t->buffer_pool_mu);
+  }
+  gpr_free(buffer);
+}
+
+/*
+  Return the stream's write buffers to the transport's pool, dropping any
+  messages still waiting to be written
+*/
+static void release_write_buffers(stream_obj* s) {
+  put_pooled_buffer(s->curr_ct, s->state.ws.write_buffer,
+                    s->state.ws.write_buffer_capacity);
+  s->state.ws.write_buffer = nullptr;
+  s->state.ws.write_buffer_capacity = 0;
+  put_pooled_buffer(s->curr_ct, s->state.ws.pending_buffer,
+                    s->state.ws.pending_buffer_capacity);
+  s->state.ws.pending_buffer = nullptr;
+  s->state.ws.pending_buffer_capacity = 0;
+  s->state.ws.pending_length = 0;
+}
+
 static void maybe_flush_read(stream_obj* s) {
   /* To enter flush read state (discarding all the buffered messages in
    * transport layer), two conditions must be satisfied: 1) non-zero grpc status
@@ -452,10 +536,7 @@ static void on_failed(bidirectional_stream* stream, int net_error) {
     gpr_free(s->header_array.headers);
     s->header_array.headers = nullptr;
   }
-  if (s->state.ws.write_buffer) {
-    gpr_free(s->state.ws.write_buffer);
-    s->state.ws.write_buffer = nullptr;
-  }
+  release_write_buffers(s);
   null_and_maybe_free_read_buffer(s);
   gpr_mu_unlock(&s->mu);
   execute_from_storage(s);
@@ -479,10 +560,7 @@ static void on_canceled(bidirectional_stream* stream) {
     gpr_free(s->header_array.headers);
     s->header_array.headers = nullptr;
   }
-  if (s->state.ws.write_buffer) {
-    gpr_free(s->state.ws.write_buffer);
-    s->state.ws.write_buffer = nullptr;
-  }
+  release_write_buffers(s);
   null_and_maybe_free_read_buffer(s);
   gpr_mu_unlock(&s->mu);
   execute_from_storage(s);
@@ -589,10 +667,8 @@ static void on_write_completed(bidirectional_stream* stream, const char* data) {
   stream_obj* s = static_cast<stream_obj*>(stream->annotation);
   CRONET_LOG(GPR_DEBUG, "W: on_write_completed(%p, %s)", stream, data);
   gpr_mu_lock(&s->mu);
-  if (s->state.ws.write_buffer) {
-    gpr_free(s->state.ws.write_buffer);
-    s->state.ws.write_buffer = nullptr;
-  }
+  /* the write buffer is kept for the next write */
+  s->state.ws.write_in_flight = false;
   s->state.state_callback_received[OP_SEND_MESSAGE] = true;
   gpr_mu_unlock(&s->mu);
   execute_from_storage(s);
@@ -688,20 +764,32 @@ static void on_response_trailers_received(
 }
 
 /*
- Utility function that takes the data from s->write_slice_buffer and assembles
- into a contiguous byte stream with 5 byte gRPC header prepended.
+ Utility function that takes the data from write_slice_buffer and appends it,
+ with the 5 byte gRPC header prepended, to the bytes waiting for the stream's
+ next write.
 */
-static void create_grpc_frame(grpc_slice_buffer* write_slice_buffer,
-                              char** pp_write_buffer,
-                              size_t* p_write_buffer_size, uint32_t flags) {
+static void append_grpc_frame(stream_obj* s,
+                              grpc_slice_buffer* write_slice_buffer,
+                              uint32_t flags) {
+  struct write_state* ws = &s->state.ws;
   grpc_slice slice = grpc_slice_buffer_take_first(write_slice_buffer);
   size_t length = GRPC_SLICE_LENGTH(slice);
-  *p_write_buffer_size = length + GRPC_HEADER_SIZE_IN_BYTES;
-  /* This is freed in the on_write_completed callback */
-  char* write_buffer =
-      static_cast<char*>(gpr_malloc(length + GRPC_HEADER_SIZE_IN_BYTES));
-  *pp_write_buffer = write_buffer;
-  uint8_t* p = reinterpret_cast<uint8_t*>(write_buffer);
+  size_t needed = ws->pending_length + length + GRPC_HEADER_SIZE_IN_BYTES;
+  if (needed > ws->pending_buffer_capacity) {
+    size_t capacity;
+    char* buffer = get_pooled_buffer(
+        s->curr_ct, GPR_MAX(needed, 2 * ws->pending_buffer_capacity),
+        &capacity);
+    if (ws->pending_length > 0) {
+      memcpy(buffer, ws->pending_buffer, ws->pending_length);
+    }
+    put_pooled_buffer(s->curr_ct, ws->pending_buffer,
+                      ws->pending_buffer_capacity);
+    ws->pending_buffer = buffer;
+    ws->pending_buffer_capacity = capacity;
+  }
+  uint8_t* p = reinterpret_cast<uint8_t*>(ws->pending_buffer) +
+               ws->pending_length;
   /* Append 5 byte header */
   /* Compressed flag */
   *p++ = static_cast<uint8_t>((flags & GRPC_WRITE_INTERNAL_COMPRESS) ? 1 : 0);
@@ -712,9 +800,50 @@ static void create_grpc_frame(grpc_slice_buffer* write_slice_buffer,
   *p++ = static_cast<uint8_t>(length);
   /* append actual data */
   memcpy(p, GRPC_SLICE_START_PTR(slice), length);
+  ws->pending_length = needed;
   grpc_slice_unref_internal(slice);
 }
 
+/*
+ Hand the bytes waiting for the stream's next write to Cronet. The buffers
+ are swapped rather than copied: Cronet owns write_buffer until
+ on_write_completed.
+*/
+static void start_write(stream_obj* s, bool end_of_stream) {
+  struct write_state* ws = &s->state.ws;
+  GPR_ASSERT(!ws->write_in_flight);
+  char* buffer = ws->write_buffer;
+  size_t capacity = ws->write_buffer_capacity;
+  ws->write_buffer = ws->pending_buffer;
+  ws->write_buffer_capacity = ws->pending_buffer_capacity;
+  ws->pending_buffer = buffer;
+  ws->pending_buffer_capacity = capacity;
+  size_t length = ws->pending_length;
+  ws->pending_length = 0;
+  CRONET_LOG(GPR_DEBUG, "bidirectional_stream_write (%p, %p, %" PRIuPTR ")",
+             s->cbs, ws->write_buffer, length);
+  ws->write_in_flight = true;
+  s->state.state_callback_received[OP_SEND_MESSAGE] = false;
+  bidirectional_stream_write(s->cbs, ws->write_buffer,
+                             static_cast<int>(length), end_of_stream);
+}
+
+/*
+ Whether the message of a send op can wait in the stream's pending bytes
+ for a later write
+*/
+static bool can_buffer_message(grpc_transport_stream_op_batch* op,
+                               stream_obj* s) {
+  if (op->send_trailing_metadata ||
+      !(op->payload->send_message.send_message->flags() &
+        GRPC_WRITE_BUFFER_HINT)) {
+    return false;
+  }
+  return s->state.ws.pending_length + GRPC_HEADER_SIZE_IN_BYTES +
+             op->payload->send_message.send_message->length() <=
+         GRPC_CRONET_MAX_COALESCED_WRITE_SIZE;
+}
+
 /*
  Convert metadata in a format that Cronet can consume
 */
@@ -911,6 +1040,10 @@ static bool op_can_be_run(grpc_transport_stream_op_batch* curr_op,
     /* we haven't sent headers yet. */
     else if (!stream_state->state_callback_received[OP_SEND_INITIAL_METADATA])
       result = false;
+    /* the message has to be written, and the last write hasn't completed */
+    else if (stream_state->ws.write_in_flight &&
+             !can_buffer_message(curr_op, s))
+      result = false;
   } else if (op_id == OP_RECV_MESSAGE) {
     /* already executed */
     if (op_state->state_op_done[OP_RECV_MESSAGE]) result = false;
@@ -947,6 +1080,11 @@ static bool op_can_be_run(grpc_transport_stream_op_batch* curr_op,
              !(t->use_packet_coalescing &&
                stream_state->pending_write_for_trailer))
       result = false;
+    /* a write of buffered messages hasn't completed */
+    else if (stream_state->ws.write_in_flight &&
+             !(t->use_packet_coalescing &&
+               stream_state->pending_write_for_trailer))
+      result = false;
   } else if (op_id == OP_CANCEL_ERROR) {
     /* already executed */
     if (stream_state->state_op_done[OP_CANCEL_ERROR]) result = false;
@@ -971,7 +1109,8 @@ static bool op_can_be_run(grpc_transport_stream_op_batch* curr_op,
       CRONET_LOG(GPR_DEBUG, "Because");
       result = false;
     } else if (curr_op->send_message &&
-               !stream_state->state_callback_received[OP_SEND_MESSAGE]) {
+               !stream_state->state_callback_received[OP_SEND_MESSAGE] &&
+               !op_state->state_callback_received[OP_SEND_MESSAGE]) {
       CRONET_LOG(GPR_DEBUG, "Because");
       result = false;
     } else if (curr_op->send_trailing_metadata &&
@@ -1076,6 +1215,7 @@ static enum e_op_result execute_stream_op(struct op_and_state* oas) {
       result = NO_ACTION_POSSIBLE;
       CRONET_LOG(GPR_DEBUG, "Stream is either cancelled or failed.");
     } else {
+      const bool buffer_message = can_buffer_message(stream_op, s);
       grpc_slice_buffer write_slice_buffer;
       grpc_slice slice;
       grpc_slice_buffer_init(&write_slice_buffer);
@@ -1097,28 +1237,31 @@ static enum e_op_result execute_stream_op(struct op_and_state* oas) {
         GPR_ASSERT(write_slice_buffer.count == 1);
       }
       if (write_slice_buffer.count > 0) {
-        size_t write_buffer_size;
-        create_grpc_frame(
-            &write_slice_buffer, &stream_state->ws.write_buffer,
-            &write_buffer_size,
+        append_grpc_frame(
+            s, &write_slice_buffer,
             stream_op->payload->send_message.send_message->flags());
-        CRONET_LOG(GPR_DEBUG, "bidirectional_stream_write (%p, %p)", s->cbs,
-                   stream_state->ws.write_buffer);
-        stream_state->state_callback_received[OP_SEND_MESSAGE] = false;
-        bidirectional_stream_write(s->cbs, stream_state->ws.write_buffer,
-                                   static_cast<int>(write_buffer_size), false);
         grpc_slice_buffer_destroy_internal(&write_slice_buffer);
-        if (t->use_packet_coalescing) {
-          if (!stream_op->send_trailing_metadata) {
-            CRONET_LOG(GPR_DEBUG, "bidirectional_stream_flush (%p)", s->cbs);
-            bidirectional_stream_flush(s->cbs);
-            result = ACTION_TAKEN_WITH_CALLBACK;
+        if (buffer_message) {
+          /* written along with a later message or the end of stream; the op
+             completes without waiting for Cronet */
+          CRONET_LOG(GPR_DEBUG, "buffered message (%p, %" PRIuPTR " bytes)",
+                     s->cbs, stream_state->ws.pending_length);
+          oas->state.state_callback_received[OP_SEND_MESSAGE] = true;
+          result = ACTION_TAKEN_NO_CALLBACK;
+        } else {
+          start_write(s, false);
+          if (t->use_packet_coalescing) {
+            if (!stream_op->send_trailing_metadata) {
+              CRONET_LOG(GPR_DEBUG, "bidirectional_stream_flush (%p)", s->cbs);
+              bidirectional_stream_flush(s->cbs);
+              result = ACTION_TAKEN_WITH_CALLBACK;
+            } else {
+              stream_state->pending_write_for_trailer = true;
+              result = ACTION_TAKEN_NO_CALLBACK;
+            }
           } else {
-            stream_state->pending_write_for_trailer = true;
-            result = ACTION_TAKEN_NO_CALLBACK;
+            result = ACTION_TAKEN_WITH_CALLBACK;
           }
-        } else {
-          result = ACTION_TAKEN_WITH_CALLBACK;
         }
       } else {
         result = NO_ACTION_POSSIBLE;
@@ -1135,9 +1278,14 @@ static enum e_op_result execute_stream_op(struct op_and_state* oas) {
       result = NO_ACTION_POSSIBLE;
       CRONET_LOG(GPR_DEBUG, "Stream is either cancelled or failed.");
     } else {
-      CRONET_LOG(GPR_DEBUG, "bidirectional_stream_write (%p, 0)", s->cbs);
-      stream_state->state_callback_received[OP_SEND_MESSAGE] = false;
-      bidirectional_stream_write(s->cbs, "", 0, true);
+      if (stream_state->ws.pending_length > 0) {
+        /* buffered messages go out with the end of stream */
+        start_write(s, true);
+      } else {
+        CRONET_LOG(GPR_DEBUG, "bidirectional_stream_write (%p, 0)", s->cbs);
+        stream_state->state_callback_received[OP_SEND_MESSAGE] = false;
+        bidirectional_stream_write(s->cbs, "", 0, true);
+      }
       if (t->use_packet_coalescing) {
         CRONET_LOG(GPR_DEBUG, "bidirectional_stream_flush (%p)", s->cbs);
         bidirectional_stream_flush(s->cbs);
@@ -1214,9 +1362,11 @@ static enum e_op_result execute_stream_op(struct op_and_state* oas) {
         CRONET_LOG(GPR_DEBUG, "length field = %d",
                    stream_state->rs.length_field);
         if (stream_state->rs.length_field > 0) {
-          stream_state->rs.read_buffer = static_cast<char*>(
-              gpr_malloc(static_cast<size_t>(stream_state->rs.length_field)));
-          GPR_ASSERT(stream_state->rs.read_buffer);
+          stream_state->rs.read_slice = GRPC_SLICE_MALLOC(
+              static_cast<size_t>(stream_state->rs.length_field));
+          stream_state->rs.read_buffer_is_slice = true;
+          stream_state->rs.read_buffer = reinterpret_cast<char*>(
+              GRPC_SLICE_START_PTR(stream_state->rs.read_slice));
           stream_state->rs.remaining_bytes = stream_state->rs.length_field;
           stream_state->rs.received_bytes = 0;
           CRONET_LOG(GPR_DEBUG, "bidirectional_stream_read(%p)", s->cbs);
@@ -1278,12 +1428,12 @@ static enum e_op_result execute_stream_op(struct op_and_state* oas) {
       }
     } else if (stream_state->rs.remaining_bytes == 0) {
       CRONET_LOG(GPR_DEBUG, "read operation complete");
-      grpc_slice read_data_slice =
-          GRPC_SLICE_MALLOC((uint32_t)stream_state->rs.length_field);
-      uint8_t* dst_p = GRPC_SLICE_START_PTR(read_data_slice);
-      memcpy(dst_p, stream_state->rs.read_buffer,
-             static_cast<size_t>(stream_state->rs.length_field));
-      null_and_maybe_free_read_buffer(s);
+      /* the message was read straight into the slice: hand it over as is */
+      GPR_ASSERT(stream_state->rs.read_buffer_is_slice);
+      grpc_slice read_data_slice = stream_state->rs.read_slice;
+      stream_state->rs.read_slice = grpc_empty_slice();
+      stream_state->rs.read_buffer_is_slice = false;
+      stream_state->rs.read_buffer = nullptr;
       /* Clean up read_slice_buffer in case there is unread data. */
       grpc_slice_buffer_destroy_internal(&stream_state->rs.read_slice_buffer);
       grpc_slice_buffer_init(&stream_state->rs.read_slice_buffer);
@@ -1401,6 +1551,7 @@ inline stream_obj::stream_obj(grpc_transport* gt, grpc_stream* gs,
 
 inline stream_obj::~stream_obj() {
   null_and_maybe_free_read_buffer(this);
+  release_write_buffers(this);
   /* Clean up read_slice_buffer in case there is unread data. */
   grpc_slice_buffer_destroy_internal(&state.rs.read_slice_buffer);
   GRPC_ERROR_UNREF(state.cancel_error);
@@ -1456,7 +1607,14 @@ static void destroy_stream(grpc_transport* gt, grpc_stream* gs,
   GRPC_CLOSURE_SCHED(then_schedule_closure, GRPC_ERROR_NONE);
 }
 
-static void destroy_transport(grpc_transport* gt) {}
+static void destroy_transport(grpc_transport* gt) {
+  grpc_cronet_transport* t = reinterpret_cast<grpc_cronet_transport*>(gt);
+  for (size_t i = 0; i < t->num_pooled_buffers; i++) {
+    gpr_free(t->pooled_buffers[i]);
+  }
+  t->num_pooled_buffers = 0;
+  gpr_mu_destroy(&t->buffer_pool_mu);
+}
 
 static grpc_endpoint* get_endpoint(grpc_transport* gt) { return nullptr; }
 
@@ -1472,7 +1630,8 @@ static const grpc_transport_vtable grpc_cronet_vtable = {
     perform_op,
     destroy_stream,
     destroy_transport,
-    get_endpoint};
+    get_endpoint,
+    nullptr};
 
 grpc_transport* grpc_create_cronet_transport(void* engine, const char* target,
                                              const grpc_channel_args* args,
@@ -1484,6 +1643,8 @@ grpc_transport* grpc_create_cronet_transport(void* engine, const char* target,
   }
   ct->base.vtable = &grpc_cronet_vtable;
   ct->engine = static_cast<stream_engine*>(engine);
+  gpr_mu_init(&ct->buffer_pool_mu);
+  ct->num_pooled_buffers = 0;
   ct->host = static_cast<char*>(gpr_malloc(strlen(target) + 1));
   if (!ct->host) {
     goto error;
@@ -1512,6 +1673,7 @@ error:
     if (ct->host) {
       gpr_free(ct->host);
     }
+    gpr_mu_destroy(&ct->buffer_pool_mu);
     gpr_free(ct);
   }
 
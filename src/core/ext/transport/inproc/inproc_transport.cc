@@ -524,9 +524,14 @@ void fail_helper_locked(inproc_stream* s, grpc_error* error) {
   GRPC_ERROR_UNREF(error);
 }
 
+// The message's slices are handed to the receiver by reference; their data is
+// never copied.
+//
 // TODO(vjpai): It should not be necessary to drain the incoming byte
 // stream and create a new one; instead, we should simply pass the byte
-// stream from the sender directly to the receiver as-is.
+// stream from the sender directly to the receiver as-is. That needs the
+// receiver to own the stream, whereas the sender's lives in its call and goes
+// away once the send completes, which here is before the receiver reads it.
 //
 // Note that fixing this will also avoid the assumption in this code
 // that the incoming byte stream's next() call will always return
@@ -1176,7 +1181,7 @@ const grpc_transport_vtable inproc_vtable = {
     sizeof(inproc_stream), "inproc",        init_stream,
     set_pollset,           set_pollset_set, perform_stream_op,
     perform_transport_op,  destroy_stream,  destroy_transport,
-    get_endpoint};
+    get_endpoint,          nullptr};
 
 /*******************************************************************************
  * Main inproc transport functions
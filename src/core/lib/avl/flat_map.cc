@@ -0,0 +1,145 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/avl/flat_map.h"
+
+#include <grpc/support/alloc.h>
+
+grpc_flat_map grpc_flat_map_create(const grpc_avl_vtable* vtable) {
+  grpc_flat_map out;
+  out.vtable = vtable;
+  out.data = nullptr;
+  return out;
+}
+
+static size_t map_size(grpc_flat_map map) {
+  return map.data == nullptr ? 0 : map.data->count;
+}
+
+static grpc_flat_map_data* new_data(size_t count) {
+  grpc_flat_map_data* data = static_cast<grpc_flat_map_data*>(
+      gpr_malloc(offsetof(grpc_flat_map_data, entries) +
+                 count * sizeof(grpc_flat_map_entry)));
+  gpr_ref_init(&data->refs, 1);
+  data->count = count;
+  return data;
+}
+
+static void copy_entry(const grpc_avl_vtable* vtable,
+                       const grpc_flat_map_entry* from, grpc_flat_map_entry* to,
+                       void* user_data) {
+  to->key = vtable->copy_key(from->key, user_data);
+  to->value = vtable->copy_value(from->value, user_data);
+}
+
+/* Returns the index of the first entry whose key is not less than key, and
+   sets *found if that entry's key is equal to key. */
+static size_t lower_bound(grpc_flat_map map, void* key, bool* found,
+                          void* user_data) {
+  size_t lo = 0;
+  size_t hi = map_size(map);
+  *found = false;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    long cmp =
+        map.vtable->compare_keys(map.data->entries[mid].key, key, user_data);
+    if (cmp < 0) {
+      lo = mid + 1;
+    } else if (cmp > 0) {
+      hi = mid;
+    } else {
+      *found = true;
+      return mid;
+    }
+  }
+  return lo;
+}
+
+grpc_flat_map grpc_flat_map_ref(grpc_flat_map map, void* user_data) {
+  if (map.data != nullptr) gpr_ref(&map.data->refs);
+  return map;
+}
+
+void grpc_flat_map_unref(grpc_flat_map map, void* user_data) {
+  if (map.data == nullptr || !gpr_unref(&map.data->refs)) return;
+  for (size_t i = 0; i < map.data->count; ++i) {
+    map.vtable->destroy_key(map.data->entries[i].key, user_data);
+    map.vtable->destroy_value(map.data->entries[i].value, user_data);
+  }
+  gpr_free(map.data);
+}
+
+grpc_flat_map grpc_flat_map_add(grpc_flat_map map, void* key, void* value,
+                                void* user_data) {
+  bool found;
+  const size_t pos = lower_bound(map, key, &found, user_data);
+  const size_t count = map_size(map);
+  grpc_flat_map out = grpc_flat_map_create(map.vtable);
+  out.data = new_data(found ? count : count + 1);
+  for (size_t i = 0; i < pos; ++i) {
+    copy_entry(map.vtable, &map.data->entries[i], &out.data->entries[i],
+               user_data);
+  }
+  out.data->entries[pos].key = key;
+  out.data->entries[pos].value = value;
+  const size_t skip = found ? 1 : 0;
+  for (size_t i = pos + skip; i < count; ++i) {
+    copy_entry(map.vtable, &map.data->entries[i],
+               &out.data->entries[i + 1 - skip], user_data);
+  }
+  grpc_flat_map_unref(map, user_data);
+  return out;
+}
+
+grpc_flat_map grpc_flat_map_remove(grpc_flat_map map, void* key,
+                                   void* user_data) {
+  bool found;
+  const size_t pos = lower_bound(map, key, &found, user_data);
+  if (!found) return map;
+  const size_t count = map_size(map);
+  grpc_flat_map out = grpc_flat_map_create(map.vtable);
+  if (count > 1) {
+    out.data = new_data(count - 1);
+    for (size_t i = 0; i < count; ++i) {
+      if (i == pos) continue;
+      copy_entry(map.vtable, &map.data->entries[i],
+                 &out.data->entries[i < pos ? i : i - 1], user_data);
+    }
+  }
+  grpc_flat_map_unref(map, user_data);
+  return out;
+}
+
+void* grpc_flat_map_get(grpc_flat_map map, void* key, void* user_data) {
+  void* value = nullptr;
+  grpc_flat_map_maybe_get(map, key, &value, user_data);
+  return value;
+}
+
+int grpc_flat_map_maybe_get(grpc_flat_map map, void* key, void** value,
+                            void* user_data) {
+  bool found;
+  const size_t pos = lower_bound(map, key, &found, user_data);
+  if (!found) return 0;
+  *value = map.data->entries[pos].value;
+  return 1;
+}
+
+int grpc_flat_map_is_empty(grpc_flat_map map) { return map.data == nullptr; }
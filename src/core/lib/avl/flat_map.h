@@ -0,0 +1,89 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_AVL_FLAT_MAP_H
+#define GRPC_CORE_LIB_AVL_FLAT_MAP_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/avl/avl.h"
+
+/** An immutable map with the same interface and reference semantics as
+    grpc_avl, keeping its entries in one sorted array rather than a tree of
+    nodes. Lookups are a binary search over contiguous memory, and a map
+    costs a single allocation, but every add or remove copies the array, with
+    a copy_key and copy_value call per entry kept. It suits maps that are
+    looked up much more often than they change, and whose keys and values
+    are cheap to copy (such as refcounted pointers).
+    The vtable is the one grpc_avl uses. */
+
+typedef struct grpc_flat_map_entry {
+  void* key;
+  void* value;
+} grpc_flat_map_entry;
+
+/** internal, reference counted array of a grpc_flat_map */
+typedef struct grpc_flat_map_data {
+  gpr_refcount refs;
+  size_t count;
+  /** sorted by key, count entries follow */
+  grpc_flat_map_entry entries[1];
+} grpc_flat_map_data;
+
+/** "pointer" to a map - as with grpc_avl, use grpc_flat_map_ref to add a
+    reference, and grpc_flat_map_unref when done with a reference */
+typedef struct grpc_flat_map {
+  const grpc_avl_vtable* vtable;
+  /** nullptr if the map is empty */
+  grpc_flat_map_data* data;
+} grpc_flat_map;
+
+/** Create an empty immutable map. */
+grpc_flat_map grpc_flat_map_create(const grpc_avl_vtable* vtable);
+/** Add a reference to an existing map - returns the map as a convenience. */
+grpc_flat_map grpc_flat_map_ref(grpc_flat_map map, void* user_data);
+/** Remove a reference to a map - destroying it if there are no references
+    left. The optional user_data will be passed to vtable functions. */
+void grpc_flat_map_unref(grpc_flat_map map, void* user_data);
+/** Return a new map with (key, value) added to map, taking ownership of both.
+    Implicitly unrefs map to allow easy chaining. If key exists in map, the
+    new map's entry is replaced (i.e. a duplicate is not created). The
+    optional user_data will be passed to vtable functions. */
+grpc_flat_map grpc_flat_map_add(grpc_flat_map map, void* key, void* value,
+                                void* user_data);
+/** Return a new map with key deleted, or map itself if it does not hold key.
+    Implicitly unrefs map to allow easy chaining. The optional user_data will
+    be passed to vtable functions. */
+grpc_flat_map grpc_flat_map_remove(grpc_flat_map map, void* key,
+                                   void* user_data);
+/** Lookup key, and return the associated value.
+    Returns NULL if key is not found. The optional user_data will be passed to
+    vtable functions. */
+void* grpc_flat_map_get(grpc_flat_map map, void* key, void* user_data);
+/** Return 1 if map contains key, 0 otherwise; if it has the key, sets *value
+    to its value. The optional user_data will be passed to vtable functions. */
+int grpc_flat_map_maybe_get(grpc_flat_map map, void* key, void** value,
+                            void* user_data);
+/** Return 1 if map is empty, 0 otherwise */
+int grpc_flat_map_is_empty(grpc_flat_map map);
+
+#endif /* GRPC_CORE_LIB_AVL_FLAT_MAP_H */
@@ -0,0 +1,114 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/channel/call_latency_breakdown.h"
+
+#include <grpc/support/time.h>
+
+#include <grpc/support/atm.h>
+
+#include "src/core/lib/gpr/useful.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_call_latency_breakdown_sample_interval, 1000,
+    "Number of calls created for each one whose per-stage latency breakdown "
+    "is recorded, once an exporter is set. 0 disables the breakdown.");
+
+namespace grpc_core {
+
+namespace {
+
+gpr_atm g_exporter;
+gpr_atm g_sample_interval;
+gpr_atm g_calls_until_sample;
+
+}  // namespace
+
+void CallLatencyBreakdown::Init() {
+  int32_t interval =
+      GPR_GLOBAL_CONFIG_GET(grpc_call_latency_breakdown_sample_interval);
+  SetSampleInterval(static_cast<size_t>(GPR_MAX(interval, 0)));
+}
+
+void CallLatencyBreakdown::SetExporter(Exporter exporter) {
+  gpr_atm_rel_store(&g_exporter, reinterpret_cast<gpr_atm>(exporter));
+}
+
+void CallLatencyBreakdown::SetSampleInterval(size_t interval) {
+  gpr_atm_no_barrier_store(&g_sample_interval, static_cast<gpr_atm>(interval));
+  gpr_atm_no_barrier_store(&g_calls_until_sample,
+                           static_cast<gpr_atm>(interval));
+}
+
+CallLatencyBreakdown* CallLatencyBreakdown::MaybeCreate(Arena* arena,
+                                                        bool is_client) {
+  if (gpr_atm_no_barrier_load(&g_exporter) == 0) return nullptr;
+  const gpr_atm interval = gpr_atm_no_barrier_load(&g_sample_interval);
+  if (interval == 0) return nullptr;
+  // Only the call that takes the countdown to zero is sampled; the countdown
+  // is then restarted. Calls racing with the restart may skip a sample.
+  if (gpr_atm_no_barrier_fetch_add(&g_calls_until_sample, -1) != 1) {
+    return nullptr;
+  }
+  gpr_atm_no_barrier_store(&g_calls_until_sample, interval);
+  return arena->New<CallLatencyBreakdown>(is_client);
+}
+
+double CallLatencyBreakdown::MicrosBetween(CallLatencyStage from,
+                                           CallLatencyStage to) const {
+  if (!Recorded(from) || !Recorded(to)) return -1;
+  gpr_timespec elapsed = gpr_time_sub(
+      gpr_cycle_counter_to_time(stamps_[static_cast<size_t>(to)]),
+      gpr_cycle_counter_to_time(stamps_[static_cast<size_t>(from)]));
+  return gpr_timespec_to_micros(elapsed);
+}
+
+void CallLatencyBreakdown::Export() const {
+  Exporter exporter =
+      reinterpret_cast<Exporter>(gpr_atm_acq_load(&g_exporter));
+  if (exporter != nullptr) exporter(*this);
+}
+
+const char* CallLatencyBreakdown::StageName(CallLatencyStage stage) {
+  switch (stage) {
+    case CallLatencyStage::kCallCreated:
+      return "call_created";
+    case CallLatencyStage::kTransportOpStarted:
+      return "transport_op_started";
+    case CallLatencyStage::kInitialMetadataEncoded:
+      return "initial_metadata_encoded";
+    case CallLatencyStage::kWriteStarted:
+      return "write_started";
+    case CallLatencyStage::kInitialMetadataParsed:
+      return "initial_metadata_parsed";
+    case CallLatencyStage::kInitialMetadataDelivered:
+      return "initial_metadata_delivered";
+    case CallLatencyStage::kMessageDelivered:
+      return "message_delivered";
+    case CallLatencyStage::kFinalOpPosted:
+      return "final_op_posted";
+    case CallLatencyStage::kCount:
+      break;
+  }
+  return "unknown";
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,129 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef GRPC_CORE_LIB_CHANNEL_CALL_LATENCY_BREAKDOWN_H
+#define GRPC_CORE_LIB_CHANNEL_CALL_LATENCY_BREAKDOWN_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/arena.h"
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_call_latency_breakdown_sample_interval);
+
+namespace grpc_core {
+
+// The points in the life of a call at which a sampled call is timestamped.
+// Each is recorded the first time the call reaches it.
+enum class CallLatencyStage {
+  // The call was created by the surface.
+  kCallCreated,
+  // The first op batch for the call ran in the transport's combiner.
+  kTransportOpStarted,
+  // The call's initial metadata was hpack encoded.
+  kInitialMetadataEncoded,
+  // Bytes of the call were first handed to an endpoint write.
+  kWriteStarted,
+  // The first of the peer's initial metadata was parsed.
+  kInitialMetadataParsed,
+  // The peer's initial metadata was delivered to the surface.
+  kInitialMetadataDelivered,
+  // The peer's first message was delivered to the surface.
+  kMessageDelivered,
+  // The completion of the call's final op was posted.
+  kFinalOpPosted,
+  kCount
+};
+
+// Per-stage timestamps of one call, kept in its arena. Only a sample of the
+// calls, one in every GRPC_CALL_LATENCY_BREAKDOWN_SAMPLE_INTERVAL, has one, so
+// that the breakdown can stay on in production: a call without one pays a
+// null check per stage. The breakdown is handed to the exporter when the call
+// is destroyed.
+class CallLatencyBreakdown {
+ public:
+  typedef void (*Exporter)(const CallLatencyBreakdown& breakdown);
+
+  // To be called in grpc_init().
+  static void Init();
+
+  // Sets the function that sampled calls are handed to; nullptr, the default,
+  // stops sampling. Meant to be set once, by a stats or census plugin.
+  static void SetExporter(Exporter exporter);
+
+  // Sets how many calls are created for each one that is sampled; 0 stops
+  // sampling.
+  static void SetSampleInterval(size_t interval);
+
+  // Returns a breakdown allocated in arena if this call is to be sampled, and
+  // nullptr otherwise.
+  static CallLatencyBreakdown* MaybeCreate(Arena* arena, bool is_client);
+
+  // Returns the breakdown stored in the call's context, if any.
+  static CallLatencyBreakdown* FromContext(
+      const grpc_call_context_element* context) {
+    if (context == nullptr) return nullptr;
+    return static_cast<CallLatencyBreakdown*>(
+        context[GRPC_CONTEXT_LATENCY_BREAKDOWN].value);
+  }
+
+  // Records that the call reached stage, unless it already had.
+  void Record(CallLatencyStage stage) {
+    gpr_cycle_counter* stamp = &stamps_[static_cast<size_t>(stage)];
+    if (*stamp == 0) *stamp = gpr_get_cycle_counter();
+  }
+
+  bool is_client() const { return is_client_; }
+
+  bool Recorded(CallLatencyStage stage) const {
+    return stamps_[static_cast<size_t>(stage)] != 0;
+  }
+
+  // Returns the microseconds from stage from to stage to, or a negative value
+  // if the call did not reach both.
+  double MicrosBetween(CallLatencyStage from, CallLatencyStage to) const;
+
+  // Hands the breakdown to the exporter. Called when the call is destroyed.
+  void Export() const;
+
+  static const char* StageName(CallLatencyStage stage);
+
+ private:
+  explicit CallLatencyBreakdown(bool is_client) : is_client_(is_client) {}
+  friend class Arena;
+
+  const bool is_client_;
+  gpr_cycle_counter stamps_[static_cast<size_t>(CallLatencyStage::kCount)] =
+      {};
+};
+
+// Records stage on the call whose context is given, if it is sampled.
+inline void CallLatencyRecord(const grpc_call_context_element* context,
+                              CallLatencyStage stage) {
+  CallLatencyBreakdown* breakdown = CallLatencyBreakdown::FromContext(context);
+  if (GPR_UNLIKELY(breakdown != nullptr)) breakdown->Record(stage);
+}
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_CHANNEL_CALL_LATENCY_BREAKDOWN_H */
@@ -27,6 +27,7 @@
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/murmur_hash.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
 
@@ -214,7 +215,7 @@ void grpc_channel_args_destroy(grpc_channel_args* a) {
 
 int grpc_channel_args_compare(const grpc_channel_args* a,
                               const grpc_channel_args* b) {
-  if (a == nullptr && b == nullptr) return 0;
+  if (a == b) return 0;
   if (a == nullptr || b == nullptr) return a == nullptr ? -1 : 1;
   int c = GPR_ICMP(a->num_args, b->num_args);
   if (c != 0) return c;
@@ -225,6 +226,29 @@ int grpc_channel_args_compare(const grpc_channel_args* a,
   return 0;
 }
 
+uint32_t grpc_channel_args_hash(const grpc_channel_args* args) {
+  if (args == nullptr) return 0;
+  uint32_t hash = static_cast<uint32_t>(args->num_args);
+  for (size_t i = 0; i < args->num_args; i++) {
+    const grpc_arg* arg = &args->args[i];
+    hash = gpr_murmur_hash3(arg->key, strlen(arg->key), hash);
+    switch (arg->type) {
+      case GRPC_ARG_STRING:
+        hash = gpr_murmur_hash3(arg->value.string, strlen(arg->value.string),
+                                hash);
+        break;
+      case GRPC_ARG_INTEGER:
+        hash = gpr_murmur_hash3(&arg->value.integer,
+                                sizeof(arg->value.integer), hash);
+        break;
+      case GRPC_ARG_POINTER:
+        hash = gpr_murmur_hash3(&arg->type, sizeof(arg->type), hash);
+        break;
+    }
+  }
+  return hash;
+}
+
 const grpc_arg* grpc_channel_args_find(const grpc_channel_args* args,
                                        const char* name) {
   if (args != nullptr) {
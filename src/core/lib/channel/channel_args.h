@@ -61,6 +61,11 @@ inline void grpc_channel_args_destroy(const grpc_channel_args* a) {
 int grpc_channel_args_compare(const grpc_channel_args* a,
                               const grpc_channel_args* b);
 
+/** Returns a hash of \a args that is equal for args that
+    grpc_channel_args_compare() finds equal. Pointer args only contribute
+    their key, since their vtable may consider distinct pointers equal. */
+uint32_t grpc_channel_args_hash(const grpc_channel_args* args);
+
 /** Returns the value of argument \a name from \a args, or NULL if not found. */
 const grpc_arg* grpc_channel_args_find(const grpc_channel_args* args,
                                        const char* name);
@@ -130,6 +130,8 @@ grpc_error* grpc_channel_stack_init(
     call_size += GPR_ROUND_UP_TO_ALIGNMENT_SIZE(filters[i]->sizeof_call_data);
   }
 
+  // grpc_call_next_op relies on this not to skip past the end of the stack.
+  GPR_ASSERT(filter_count == 0 || filters[filter_count - 1]->batch_ops == 0);
   GPR_ASSERT(user_data > (char*)stack);
   GPR_ASSERT((uintptr_t)(user_data - (char*)stack) ==
              grpc_channel_stack_size(filters, filter_count));
@@ -220,9 +222,31 @@ void grpc_call_stack_destroy(grpc_call_stack* stack,
   }
 }
 
+static uint32_t batch_ops(const grpc_transport_stream_op_batch* op) {
+  return (op->send_initial_metadata ? GRPC_FILTER_BATCH_SEND_INITIAL_METADATA
+                                    : 0) |
+         (op->send_message ? GRPC_FILTER_BATCH_SEND_MESSAGE : 0) |
+         (op->send_trailing_metadata ? GRPC_FILTER_BATCH_SEND_TRAILING_METADATA
+                                     : 0) |
+         (op->recv_initial_metadata ? GRPC_FILTER_BATCH_RECV_INITIAL_METADATA
+                                    : 0) |
+         (op->recv_message ? GRPC_FILTER_BATCH_RECV_MESSAGE : 0) |
+         (op->recv_trailing_metadata ? GRPC_FILTER_BATCH_RECV_TRAILING_METADATA
+                                     : 0) |
+         (op->cancel_stream ? GRPC_FILTER_BATCH_CANCEL_STREAM : 0);
+}
+
 void grpc_call_next_op(grpc_call_element* elem,
                        grpc_transport_stream_op_batch* op) {
   grpc_call_element* next_elem = elem + 1;
+  if (next_elem->filter->batch_ops != 0) {
+    const uint32_t ops = batch_ops(op);
+    // The last filter of a stack has batch_ops 0, so this stays in the stack.
+    while (next_elem->filter->batch_ops != 0 &&
+           (next_elem->filter->batch_ops & ops) == 0) {
+      ++next_elem;
+    }
+  }
   GRPC_CALL_LOG_OP(GPR_INFO, next_elem, op);
   next_elem->filter->start_transport_stream_op_batch(next_elem, op);
 }
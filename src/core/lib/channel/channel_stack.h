@@ -93,8 +93,21 @@ struct grpc_call_final_info {
    3. functions to implement call operations and channel operations (call_op,
       channel_op)
    4. a name, which is useful when debugging
+   5. optionally, which kinds of op in a batch the filter acts on (batch_ops)
+
+   Members are laid out in approximate frequency of use order, except that
+   batch_ops comes last so that filters may leave it out. */
+
+/* Bits of grpc_channel_filter.batch_ops, one per kind of op in a
+   grpc_transport_stream_op_batch */
+#define GRPC_FILTER_BATCH_SEND_INITIAL_METADATA (1u << 0)
+#define GRPC_FILTER_BATCH_SEND_MESSAGE (1u << 1)
+#define GRPC_FILTER_BATCH_SEND_TRAILING_METADATA (1u << 2)
+#define GRPC_FILTER_BATCH_RECV_INITIAL_METADATA (1u << 3)
+#define GRPC_FILTER_BATCH_RECV_MESSAGE (1u << 4)
+#define GRPC_FILTER_BATCH_RECV_TRAILING_METADATA (1u << 5)
+#define GRPC_FILTER_BATCH_CANCEL_STREAM (1u << 6)
 
-   Members are laid out in approximate frequency of use order. */
 typedef struct {
   /* Called to eg. send/receive data on a call.
      See grpc_call_next_op on how to call the next element in the stack */
@@ -151,6 +164,12 @@ typedef struct {
 
   /* The name of this filter */
   const char* name;
+
+  /* The GRPC_FILTER_BATCH_* ops that start_transport_stream_op_batch acts on.
+     grpc_call_next_op passes a batch containing none of them straight to the
+     next filter that does want it. 0, the default, means the filter sees
+     every batch; it must be 0 for the last filter of a stack. */
+  uint32_t batch_ops;
 } grpc_channel_filter;
 
 /* A channel_element tracks its filter and the filter requested memory within
@@ -252,7 +271,8 @@ void grpc_call_stack_destroy(grpc_call_stack* stack,
  * at all. Does nothing. */
 void grpc_call_stack_ignore_set_pollset_or_pollset_set(
     grpc_call_element* elem, grpc_polling_entity* pollent);
-/* Call the next operation in a call stack */
+/* Call the next operation in a call stack, skipping filters whose batch_ops
+   show they would only pass it on */
 void grpc_call_next_op(grpc_call_element* elem,
                        grpc_transport_stream_op_batch* op);
 /* Call the next operation (depending on call directionality) in a channel
@@ -36,6 +36,7 @@
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json_writer.h"
 #include "src/core/lib/slice/b64.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/channel.h"
@@ -87,7 +88,7 @@ intptr_t GetParentUuidFromArgs(const grpc_channel_args& args) {
 
 BaseNode::BaseNode(EntityType type, UniquePtr<char> name)
     : type_(type), uuid_(-1), name_(std::move(name)) {
-  // The registry will set uuid_ under its lock.
+  // The registry will set uuid_ before making the node visible.
   ChannelzRegistry::Register(this);
 }
 
@@ -342,38 +343,102 @@ void ServerNode::RemoveChildListenSocket(intptr_t child_uuid) {
   child_listen_sockets_.erase(child_uuid);
 }
 
+namespace {
+
+// Collects the output of a grpc_json_writer into a string, for responses that
+// are written out directly rather than built as a grpc_json tree first.
+class JsonStringWriter {
+ public:
+  JsonStringWriter() { grpc_json_writer_init(&writer_, 0, &vtable_, this); }
+  ~JsonStringWriter() { gpr_free(output_); }
+
+  grpc_json_writer* writer() { return &writer_; }
+
+  // Returns the NUL-terminated output, which the caller takes ownership of.
+  char* Release() {
+    Append("", 1);
+    char* output = output_;
+    output_ = nullptr;
+    return output;
+  }
+
+ private:
+  static void OutputChar(void* userdata, char c) {
+    static_cast<JsonStringWriter*>(userdata)->Append(&c, 1);
+  }
+  static void OutputString(void* userdata, const char* str) {
+    static_cast<JsonStringWriter*>(userdata)->Append(str, strlen(str));
+  }
+  static void OutputStringWithLen(void* userdata, const char* str,
+                                  size_t len) {
+    static_cast<JsonStringWriter*>(userdata)->Append(str, len);
+  }
+
+  void Append(const char* data, size_t len) {
+    if (length_ + len > capacity_) {
+      capacity_ = GPR_MAX(capacity_ * 2, length_ + len);
+      output_ = static_cast<char*>(gpr_realloc(output_, capacity_));
+    }
+    memcpy(output_ + length_, data, len);
+    length_ += len;
+  }
+
+  static grpc_json_writer_vtable vtable_;
+  grpc_json_writer writer_;
+  char* output_ = nullptr;
+  size_t length_ = 0;
+  size_t capacity_ = 0;
+};
+
+grpc_json_writer_vtable JsonStringWriter::vtable_ = {
+    JsonStringWriter::OutputChar, JsonStringWriter::OutputString,
+    JsonStringWriter::OutputStringWithLen};
+
+}  // namespace
+
 char* ServerNode::RenderServerSockets(intptr_t start_socket_id,
                                       intptr_t max_results) {
   // If user does not set max_results, we choose 500.
   size_t pagination_limit = max_results == 0 ? 500 : max_results;
-  grpc_json* top_level_json = grpc_json_create(GRPC_JSON_OBJECT);
-  grpc_json* json = top_level_json;
-  grpc_json* json_iterator = nullptr;
-  MutexLock lock(&child_mu_);
-  size_t sockets_rendered = 0;
-  if (!child_sockets_.empty()) {
-    // Create list of socket refs
-    grpc_json* array_parent = grpc_json_create_child(
-        nullptr, json, "socketRef", nullptr, GRPC_JSON_ARRAY, false);
-    const size_t limit = GPR_MIN(child_sockets_.size(), pagination_limit);
-    for (auto it = child_sockets_.lower_bound(start_socket_id);
-         it != child_sockets_.end() && sockets_rendered < limit;
-         ++it, ++sockets_rendered) {
-      grpc_json* socket_ref_json = grpc_json_create_child(
-          nullptr, array_parent, nullptr, nullptr, GRPC_JSON_OBJECT, false);
-      json_iterator = grpc_json_add_number_string_child(
-          socket_ref_json, nullptr, "socketId", it->first);
-      grpc_json_create_child(json_iterator, socket_ref_json, "name",
-                             it->second->name(), GRPC_JSON_STRING, false);
+  // Only take refs to the page of sockets under the lock, so that a server
+  // with many connections isn't kept from accepting more while it renders.
+  InlinedVector<RefCountedPtr<SocketNode>, 10> sockets;
+  bool reached_end;
+  {
+    MutexLock lock(&child_mu_);
+    auto it = child_sockets_.lower_bound(start_socket_id);
+    for (; it != child_sockets_.end() && sockets.size() < pagination_limit;
+         ++it) {
+      sockets.push_back(it->second);
     }
+    reached_end = it == child_sockets_.end();
   }
-  if (sockets_rendered == child_sockets_.size()) {
-    json_iterator = grpc_json_create_child(nullptr, json, "end", nullptr,
-                                           GRPC_JSON_TRUE, false);
+  // The socket refs are written out directly, as a grpc_json tree would cost
+  // several allocations for each of them.
+  JsonStringWriter output;
+  grpc_json_writer* writer = output.writer();
+  grpc_json_writer_container_begins(writer, GRPC_JSON_OBJECT);
+  if (!sockets.empty()) {
+    grpc_json_writer_object_key(writer, "socketRef");
+    grpc_json_writer_container_begins(writer, GRPC_JSON_ARRAY);
+    char socket_id[GPR_LTOA_MIN_BUFSIZE];
+    for (size_t i = 0; i < sockets.size(); ++i) {
+      grpc_json_writer_container_begins(writer, GRPC_JSON_OBJECT);
+      int64_ttoa(sockets[i]->uuid(), socket_id);
+      grpc_json_writer_object_key(writer, "socketId");
+      grpc_json_writer_value_string(writer, socket_id);
+      grpc_json_writer_object_key(writer, "name");
+      grpc_json_writer_value_string(writer, sockets[i]->name());
+      grpc_json_writer_container_ends(writer, GRPC_JSON_OBJECT);
+    }
+    grpc_json_writer_container_ends(writer, GRPC_JSON_ARRAY);
   }
-  char* json_str = grpc_json_dump_to_string(top_level_json, 0);
-  grpc_json_destroy(top_level_json);
-  return json_str;
+  if (reached_end) {
+    grpc_json_writer_object_key(writer, "end");
+    grpc_json_writer_value_raw_with_len(writer, "true", 4);
+  }
+  grpc_json_writer_container_ends(writer, GRPC_JSON_OBJECT);
+  return output.Release();
 }
 
 grpc_json* ServerNode::RenderJson() {
@@ -599,6 +664,72 @@ grpc_json* SocketNode::RenderJson() {
     json_iterator = grpc_json_add_number_string_child(
         json, json_iterator, "keepAlivesSent", keepalives_sent);
   }
+  if (gpr_atm_no_barrier_load(&flow_control_windows_recorded_)) {
+    json_iterator = grpc_json_add_number_string_child(
+        json, json_iterator, "localFlowControlWindow",
+        gpr_atm_no_barrier_load(&local_flow_control_window_));
+    json_iterator = grpc_json_add_number_string_child(
+        json, json_iterator, "remoteFlowControlWindow",
+        gpr_atm_no_barrier_load(&remote_flow_control_window_));
+  }
+  TcpInfoSample tcp_info;
+  bool tcp_info_recorded;
+  {
+    MutexLock lock(&tcp_info_mu_);
+    tcp_info = tcp_info_;
+    tcp_info_recorded = tcp_info_recorded_;
+  }
+  if (tcp_info_recorded) {
+    grpc_json* options = grpc_json_create_child(
+        json_iterator, json, "option", nullptr, GRPC_JSON_ARRAY, false);
+    grpc_json* option = grpc_json_create_child(
+        nullptr, options, nullptr, nullptr, GRPC_JSON_OBJECT, false);
+    grpc_json* option_iterator = grpc_json_create_child(
+        nullptr, option, "name", "TCP_INFO", GRPC_JSON_STRING, false);
+    grpc_json* additional =
+        grpc_json_create_child(option_iterator, option, "additional", nullptr,
+                               GRPC_JSON_OBJECT, false);
+    const struct {
+      const char* name;
+      uint32_t value;
+    } fields[] = {{"tcpiState", tcp_info.state},
+                  {"tcpiCaState", tcp_info.ca_state},
+                  {"tcpiRetransmits", tcp_info.retransmits},
+                  {"tcpiRto", tcp_info.rto_usec},
+                  {"tcpiSndMss", tcp_info.snd_mss},
+                  {"tcpiUnacked", tcp_info.unacked},
+                  {"tcpiLost", tcp_info.lost},
+                  {"tcpiRetrans", tcp_info.retrans},
+                  {"tcpiRtt", tcp_info.rtt_usec},
+                  {"tcpiRttvar", tcp_info.rttvar_usec},
+                  {"tcpiSndSsthresh", tcp_info.snd_ssthresh},
+                  {"tcpiSndCwnd", tcp_info.snd_cwnd},
+                  {"tcpiReordering", tcp_info.reordering}};
+    grpc_json* field_iterator = grpc_json_create_child(
+        nullptr, additional, "@type",
+        "type.googleapis.com/grpc.channelz.v1.SocketOptionTcpInfo",
+        GRPC_JSON_STRING, false);
+    for (const auto& field : fields) {
+      field_iterator = grpc_json_add_number_string_child(
+          additional, field_iterator, field.name, field.value);
+    }
+    // SocketOptionTcpInfo predates these, so they are options of their own.
+    const struct {
+      const char* name;
+      int64_t value;
+    } extras[] = {{"grpc.tcp_total_retrans", tcp_info.total_retrans},
+                  {"grpc.tcp_min_rtt_usec", tcp_info.min_rtt_usec},
+                  {"grpc.tcp_delivery_rate",
+                   static_cast<int64_t>(tcp_info.delivery_rate)}};
+    for (const auto& extra : extras) {
+      option = grpc_json_create_child(option, options, nullptr, nullptr,
+                                      GRPC_JSON_OBJECT, false);
+      option_iterator = grpc_json_create_child(
+          nullptr, option, "name", extra.name, GRPC_JSON_STRING, false);
+      grpc_json_add_number_string_child(option, option_iterator, "value",
+                                        extra.value);
+    }
+  }
   return top_level_json;
 }
 
@@ -627,6 +758,32 @@ grpc_json* ListenSocketNode::RenderJson() {
                                          GRPC_JSON_STRING, false);
   json = top_level_json;
   PopulateSocketAddressJson(json, "local", local_addr_.get());
+  // Handshake admission counters have no field of their own in SocketData,
+  // so they are reported as socket options.
+  gpr_atm handshakes_queued = gpr_atm_no_barrier_load(&handshakes_queued_);
+  gpr_atm handshakes_rejected = gpr_atm_no_barrier_load(&handshakes_rejected_);
+  if (handshakes_queued != 0 || handshakes_rejected != 0) {
+    json_iterator = nullptr;
+    grpc_json* data = grpc_json_create_child(json_iterator, json, "data",
+                                             nullptr, GRPC_JSON_OBJECT, false);
+    grpc_json* options = grpc_json_create_child(
+        nullptr, data, "option", nullptr, GRPC_JSON_ARRAY, false);
+    const struct {
+      const char* name;
+      gpr_atm value;
+    } counters[] = {{"grpc.handshakes_queued", handshakes_queued},
+                    {"grpc.handshakes_rejected", handshakes_rejected}};
+    json_iterator = nullptr;
+    for (const auto& counter : counters) {
+      json_iterator = grpc_json_create_child(json_iterator, options, nullptr,
+                                             nullptr, GRPC_JSON_OBJECT, false);
+      grpc_json* option_iterator =
+          grpc_json_create_child(nullptr, json_iterator, "name", counter.name,
+                                 GRPC_JSON_STRING, false);
+      grpc_json_add_number_string_child(json_iterator, option_iterator,
+                                        "value", counter.value);
+    }
+  }
 
   return top_level_json;
 }
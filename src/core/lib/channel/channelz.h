@@ -33,6 +33,7 @@
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/internal_errqueue.h"
 #include "src/core/lib/json/json.h"
 
 // Channel arg key for channelz node.
@@ -288,6 +289,22 @@ class SocketNode : public BaseNode {
   void RecordKeepaliveSent() {
     gpr_atm_no_barrier_fetch_add(&keepalives_sent_, static_cast<gpr_atm>(1));
   }
+  // Records the connection level flow control windows: the window granted to
+  // us by the peer (local) and the one we have granted to the peer (remote).
+  void RecordFlowControlWindows(int64_t local_window, int64_t remote_window) {
+    gpr_atm_no_barrier_store(&local_flow_control_window_,
+                             static_cast<gpr_atm>(local_window));
+    gpr_atm_no_barrier_store(&remote_flow_control_window_,
+                             static_cast<gpr_atm>(remote_window));
+    gpr_atm_no_barrier_store(&flow_control_windows_recorded_, 1);
+  }
+  // Records the latest TCP_INFO sampled from the socket, which is rendered as
+  // its TCP_INFO option.
+  void RecordTcpInfo(const TcpInfoSample& sample) {
+    MutexLock lock(&tcp_info_mu_);
+    tcp_info_ = sample;
+    tcp_info_recorded_ = true;
+  }
 
   const char* remote() { return remote_.get(); }
 
@@ -302,6 +319,12 @@ class SocketNode : public BaseNode {
   gpr_atm last_remote_stream_created_cycle_ = 0;
   gpr_atm last_message_sent_cycle_ = 0;
   gpr_atm last_message_received_cycle_ = 0;
+  gpr_atm flow_control_windows_recorded_ = 0;
+  gpr_atm local_flow_control_window_ = 0;
+  gpr_atm remote_flow_control_window_ = 0;
+  Mutex tcp_info_mu_;  // Guards tcp_info_ and tcp_info_recorded_.
+  TcpInfoSample tcp_info_ = {};
+  bool tcp_info_recorded_ = false;
   UniquePtr<char> local_;
   UniquePtr<char> remote_;
 };
@@ -314,7 +337,20 @@ class ListenSocketNode : public BaseNode {
 
   grpc_json* RenderJson() override;
 
+  // Records an accepted connection that had to wait for a handshake slot.
+  void RecordHandshakeQueued() {
+    gpr_atm_no_barrier_fetch_add(&handshakes_queued_, static_cast<gpr_atm>(1));
+  }
+  // Records an accepted connection that was closed without a handshake
+  // because too many were already waiting.
+  void RecordHandshakeRejected() {
+    gpr_atm_no_barrier_fetch_add(&handshakes_rejected_,
+                                 static_cast<gpr_atm>(1));
+  }
+
  private:
+  gpr_atm handshakes_queued_ = 0;
+  gpr_atm handshakes_rejected_ = 0;
   UniquePtr<char> local_addr_;
 };
 
@@ -52,26 +52,58 @@ ChannelzRegistry* ChannelzRegistry::Default() {
   return g_channelz_registry;
 }
 
+Map<intptr_t, BaseNode*>* ChannelzRegistry::IndexFor(
+    BaseNode::EntityType type) {
+  switch (type) {
+    case BaseNode::EntityType::kTopLevelChannel:
+      return &top_level_channels_;
+    case BaseNode::EntityType::kServer:
+      return &servers_;
+    default:
+      return nullptr;
+  }
+}
+
 void ChannelzRegistry::InternalRegister(BaseNode* node) {
-  MutexLock lock(&mu_);
-  node->uuid_ = ++uuid_generator_;
-  node_map_[node->uuid_] = node;
+  node->uuid_ = uuid_generator_.FetchAdd(1, MemoryOrder::RELAXED) + 1;
+  Shard* shard = ShardFor(node->uuid_);
+  {
+    MutexLock lock(&shard->mu);
+    shard->nodes[node->uuid_] = node;
+  }
+  Map<intptr_t, BaseNode*>* index = IndexFor(node->type());
+  if (index != nullptr) {
+    MutexLock lock(&index_mu_);
+    (*index)[node->uuid_] = node;
+  }
 }
 
 void ChannelzRegistry::InternalUnregister(intptr_t uuid) {
   GPR_ASSERT(uuid >= 1);
-  MutexLock lock(&mu_);
-  GPR_ASSERT(uuid <= uuid_generator_);
-  node_map_.erase(uuid);
+  GPR_ASSERT(uuid <= uuid_generator_.Load(MemoryOrder::RELAXED));
+  Shard* shard = ShardFor(uuid);
+  Map<intptr_t, BaseNode*>* index = nullptr;
+  {
+    MutexLock lock(&shard->mu);
+    auto it = shard->nodes.find(uuid);
+    if (it == shard->nodes.end()) return;
+    index = IndexFor(it->second->type());
+    shard->nodes.erase(it);
+  }
+  if (index != nullptr) {
+    MutexLock lock(&index_mu_);
+    index->erase(uuid);
+  }
 }
 
 RefCountedPtr<BaseNode> ChannelzRegistry::InternalGet(intptr_t uuid) {
-  MutexLock lock(&mu_);
-  if (uuid < 1 || uuid > uuid_generator_) {
+  if (uuid < 1 || uuid > uuid_generator_.Load(MemoryOrder::RELAXED)) {
     return nullptr;
   }
-  auto it = node_map_.find(uuid);
-  if (it == node_map_.end()) return nullptr;
+  Shard* shard = ShardFor(uuid);
+  MutexLock lock(&shard->mu);
+  auto it = shard->nodes.find(uuid);
+  if (it == shard->nodes.end()) return nullptr;
   // Found node.  Return only if its refcount is not zero (i.e., when we
   // know that there is no other thread about to destroy it).
   BaseNode* node = it->second;
@@ -79,41 +111,41 @@ RefCountedPtr<BaseNode> ChannelzRegistry::InternalGet(intptr_t uuid) {
   return RefCountedPtr<BaseNode>(node);
 }
 
-char* ChannelzRegistry::InternalGetTopChannels(intptr_t start_channel_id) {
+char* ChannelzRegistry::RenderPage(BaseNode::EntityType type,
+                                   intptr_t start_id, const char* array_key) {
   grpc_json* top_level_json = grpc_json_create(GRPC_JSON_OBJECT);
   grpc_json* json = top_level_json;
   grpc_json* json_iterator = nullptr;
-  InlinedVector<RefCountedPtr<BaseNode>, 10> top_level_channels;
+  InlinedVector<RefCountedPtr<BaseNode>, 10> nodes;
   RefCountedPtr<BaseNode> node_after_pagination_limit;
   {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_channel_id);
-         it != node_map_.end(); ++it) {
+    MutexLock lock(&index_mu_);
+    Map<intptr_t, BaseNode*>* index = IndexFor(type);
+    for (auto it = index->lower_bound(start_id); it != index->end(); ++it) {
       BaseNode* node = it->second;
-      if (node->type() == BaseNode::EntityType::kTopLevelChannel &&
-          node->RefIfNonZero()) {
+      if (node->RefIfNonZero()) {
         // Check if we are over pagination limit to determine if we need to set
         // the "end" element. If we don't go through this block, we know that
         // when the loop terminates, we have <= to kPaginationLimit.
         // Note that because we have already increased this node's
         // refcount, we need to decrease it, but we can't unref while
         // holding the lock, because this may lead to a deadlock.
-        if (top_level_channels.size() == kPaginationLimit) {
+        if (nodes.size() == kPaginationLimit) {
           node_after_pagination_limit.reset(node);
           break;
         }
-        top_level_channels.emplace_back(node);
+        nodes.emplace_back(node);
       }
     }
   }
-  if (!top_level_channels.empty()) {
-    // create list of channels
+  if (!nodes.empty()) {
+    // create list of nodes
     grpc_json* array_parent = grpc_json_create_child(
-        nullptr, json, "channel", nullptr, GRPC_JSON_ARRAY, false);
-    for (size_t i = 0; i < top_level_channels.size(); ++i) {
-      grpc_json* channel_json = top_level_channels[i]->RenderJson();
+        nullptr, json, array_key, nullptr, GRPC_JSON_ARRAY, false);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      grpc_json* node_json = nodes[i]->RenderJson();
       json_iterator =
-          grpc_json_link_child(array_parent, channel_json, json_iterator);
+          grpc_json_link_child(array_parent, node_json, json_iterator);
     }
   }
   if (node_after_pagination_limit == nullptr) {
@@ -125,57 +157,20 @@ char* ChannelzRegistry::InternalGetTopChannels(intptr_t start_channel_id) {
   return json_str;
 }
 
+char* ChannelzRegistry::InternalGetTopChannels(intptr_t start_channel_id) {
+  return RenderPage(BaseNode::EntityType::kTopLevelChannel, start_channel_id,
+                    "channel");
+}
+
 char* ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
-  grpc_json* top_level_json = grpc_json_create(GRPC_JSON_OBJECT);
-  grpc_json* json = top_level_json;
-  grpc_json* json_iterator = nullptr;
-  InlinedVector<RefCountedPtr<BaseNode>, 10> servers;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_server_id);
-         it != node_map_.end(); ++it) {
-      BaseNode* node = it->second;
-      if (node->type() == BaseNode::EntityType::kServer &&
-          node->RefIfNonZero()) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (servers.size() == kPaginationLimit) {
-          node_after_pagination_limit.reset(node);
-          break;
-        }
-        servers.emplace_back(node);
-      }
-    }
-  }
-  if (!servers.empty()) {
-    // create list of servers
-    grpc_json* array_parent = grpc_json_create_child(
-        nullptr, json, "server", nullptr, GRPC_JSON_ARRAY, false);
-    for (size_t i = 0; i < servers.size(); ++i) {
-      grpc_json* server_json = servers[i]->RenderJson();
-      json_iterator =
-          grpc_json_link_child(array_parent, server_json, json_iterator);
-    }
-  }
-  if (node_after_pagination_limit == nullptr) {
-    grpc_json_create_child(nullptr, json, "end", nullptr, GRPC_JSON_TRUE,
-                           false);
-  }
-  char* json_str = grpc_json_dump_to_string(top_level_json, 0);
-  grpc_json_destroy(top_level_json);
-  return json_str;
+  return RenderPage(BaseNode::EntityType::kServer, start_server_id, "server");
 }
 
 void ChannelzRegistry::InternalLogAllEntities() {
   InlinedVector<RefCountedPtr<BaseNode>, 10> nodes;
-  {
-    MutexLock lock(&mu_);
-    for (auto& p : node_map_) {
+  for (size_t i = 0; i < kNumShards; ++i) {
+    MutexLock lock(&shards_[i].mu);
+    for (auto& p : shards_[i].nodes) {
       BaseNode* node = p.second;
       if (node->RefIfNonZero()) {
         nodes.emplace_back(node);
@@ -25,6 +25,7 @@
 
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/gprpp/map.h"
 #include "src/core/lib/gprpp/sync.h"
 
@@ -85,10 +86,32 @@ class ChannelzRegistry {
 
   void InternalLogAllEntities();
 
-  // protects members
-  Mutex mu_;
-  Map<intptr_t, BaseNode*> node_map_;
-  intptr_t uuid_generator_ = 0;
+  // The nodes are spread over kNumShards maps by uuid, each with its own lock,
+  // so that registering and unregistering the many sockets of a busy server
+  // don't all contend on one mutex.
+  static constexpr size_t kNumShards = 16;
+  struct Shard {
+    Mutex mu;  // protects nodes
+    Map<intptr_t, BaseNode*> nodes;
+  };
+  Shard* ShardFor(intptr_t uuid) { return &shards_[uuid % kNumShards]; }
+
+  // Returns the map that also holds nodes of this type, or nullptr for types
+  // that are only looked up by uuid.
+  Map<intptr_t, BaseNode*>* IndexFor(BaseNode::EntityType type);
+
+  // Renders one page, starting at start_id, of the nodes in the index for
+  // type, as the array named array_key.
+  char* RenderPage(BaseNode::EntityType type, intptr_t start_id,
+                   const char* array_key);
+
+  Atomic<intptr_t> uuid_generator_{0};
+  Shard shards_[kNumShards];
+  // Top level channels and servers, in uuid order, so that paginating over
+  // them needn't walk every socket and subchannel.
+  Mutex index_mu_;  // protects the two maps below
+  Map<intptr_t, BaseNode*> top_level_channels_;
+  Map<intptr_t, BaseNode*> servers_;
 };
 
 }  // namespace channelz
@@ -38,6 +38,9 @@ typedef enum {
   /// Holds a pointer to ServiceConfig::CallData associated with this call.
   GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA,
 
+  /// Value is a \a grpc_core::CallLatencyBreakdown, set on sampled calls.
+  GRPC_CONTEXT_LATENCY_BREAKDOWN,
+
   GRPC_CONTEXT_COUNT
 } grpc_context_index;
 
@@ -0,0 +1,208 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/channel/unary_batch.h"
+
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+namespace grpc_core {
+
+bool IsUnaryBatch(const grpc_transport_stream_op_batch* batch) {
+  return batch->send_initial_metadata && batch->send_message &&
+         batch->send_trailing_metadata && batch->recv_initial_metadata &&
+         batch->recv_message && batch->recv_trailing_metadata &&
+         !batch->cancel_stream;
+}
+
+bool HasCallCredentials(const grpc_transport_stream_op_batch* batch) {
+  // The security context exists this early only if the application set
+  // per-call credentials; the client auth filter creates it otherwise.
+  const grpc_call_context_element* context = batch->payload->context;
+  return context != nullptr && context[GRPC_CONTEXT_SECURITY].value != nullptr;
+}
+
+//
+// UnaryRequestReader
+//
+
+UnaryRequestReader::~UnaryRequestReader() {
+  if (started_) {
+    caching_stream_.Destroy();
+    cache_.Destroy();
+  }
+}
+
+bool UnaryRequestReader::Read(grpc_call_element* elem,
+                              CallCombiner* call_combiner,
+                              grpc_transport_stream_op_batch* batch) {
+  GPR_ASSERT(!started_);
+  started_ = true;
+  elem_ = elem;
+  call_combiner_ = call_combiner;
+  batch_ = batch;
+  cache_.Init(std::move(batch->payload->send_message.send_message));
+  caching_stream_.Init(cache_.get());
+  batch->payload->send_message.send_message.reset(caching_stream_.get());
+  GRPC_CLOSURE_INIT(&on_next_done_, OnNextDone, this,
+                    grpc_schedule_on_exec_ctx);
+  const size_t length = caching_stream_->length();
+  while (bytes_read_ < length &&
+         caching_stream_->Next(SIZE_MAX, &on_next_done_)) {
+    grpc_slice slice;
+    grpc_error* error = caching_stream_->Pull(&slice);
+    if (error != GRPC_ERROR_NONE) {
+      grpc_transport_stream_op_batch_finish_with_failure(batch, error,
+                                                         call_combiner);
+      return false;
+    }
+    bytes_read_ += GRPC_SLICE_LENGTH(slice);
+    grpc_slice_unref_internal(slice);
+  }
+  // If not all of the request was available synchronously, the batch goes
+  // down as is from OnNextDone().
+  if (bytes_read_ < length) return false;
+  caching_stream_->Reset();
+  return true;
+}
+
+void UnaryRequestReader::OnNextDone(void* arg, grpc_error* error) {
+  UnaryRequestReader* reader = static_cast<UnaryRequestReader*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    grpc_slice slice;
+    error = reader->caching_stream_->Pull(&slice);
+    if (error == GRPC_ERROR_NONE) grpc_slice_unref_internal(slice);
+  } else {
+    GRPC_ERROR_REF(error);
+  }
+  if (error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(reader->batch_, error,
+                                                       reader->call_combiner_);
+    return;
+  }
+  reader->caching_stream_->Reset();
+  grpc_call_next_op(reader->elem_, reader->batch_);
+}
+
+//
+// UnaryResponse
+//
+
+UnaryResponse::~UnaryResponse() {
+  for (size_t i = 0; i < initial_metadata.size(); i++) {
+    GRPC_MDELEM_UNREF(initial_metadata[i]);
+  }
+  for (size_t i = 0; i < trailing_metadata.size(); i++) {
+    GRPC_MDELEM_UNREF(trailing_metadata[i]);
+  }
+  grpc_slice_buffer_destroy_internal(&message);
+}
+
+//
+// UnaryBatchCompleter
+//
+
+UnaryBatchCompleter::~UnaryBatchCompleter() {
+  if (has_message_stream_) message_stream_.Destroy();
+}
+
+grpc_error* UnaryBatchCompleter::AddMetadata(
+    const InlinedVector<grpc_mdelem, 8>& mds, Arena* arena,
+    grpc_metadata_batch* batch) {
+  if (mds.empty()) return GRPC_ERROR_NONE;
+  grpc_linked_mdelem* storage = static_cast<grpc_linked_mdelem*>(
+      arena->Alloc(sizeof(grpc_linked_mdelem) * mds.size()));
+  for (size_t i = 0; i < mds.size(); i++) {
+    grpc_error* error = grpc_metadata_batch_add_tail(batch, &storage[i],
+                                                     GRPC_MDELEM_REF(mds[i]));
+    if (error != GRPC_ERROR_NONE) {
+      GRPC_MDELEM_UNREF(mds[i]);
+      return error;
+    }
+  }
+  return GRPC_ERROR_NONE;
+}
+
+void UnaryBatchCompleter::Complete(grpc_call_element* elem,
+                                   CallCombiner* call_combiner, Arena* arena,
+                                   grpc_transport_stream_op_batch* batch,
+                                   const UnaryResponse& response) {
+  call_combiner_ = call_combiner;
+  auto* payload = batch->payload;
+  grpc_error* error =
+      AddMetadata(response.initial_metadata, arena,
+                  payload->recv_initial_metadata.recv_initial_metadata);
+  if (error == GRPC_ERROR_NONE) {
+    error = AddMetadata(response.trailing_metadata, arena,
+                        payload->recv_trailing_metadata.recv_trailing_metadata);
+  }
+  if (error != GRPC_ERROR_NONE) {
+    grpc_transport_stream_op_batch_finish_with_failure(batch, error,
+                                                       call_combiner);
+    return;
+  }
+  if (payload->recv_initial_metadata.recv_flags != nullptr) {
+    *payload->recv_initial_metadata.recv_flags = 0;
+  }
+  if (payload->recv_initial_metadata.trailing_metadata_available != nullptr) {
+    *payload->recv_initial_metadata.trailing_metadata_available = false;
+  }
+  if (response.has_message) {
+    grpc_slice_buffer message;
+    grpc_slice_buffer_init(&message);
+    for (size_t i = 0; i < response.message.count; i++) {
+      grpc_slice_buffer_add(
+          &message, grpc_slice_ref_internal(response.message.slices[i]));
+    }
+    has_message_stream_ = true;
+    message_stream_.Init(&message, response.message_flags);
+    grpc_slice_buffer_destroy_internal(&message);
+    payload->recv_message.recv_message->reset(message_stream_.get());
+  } else {
+    payload->recv_message.recv_message->reset();
+  }
+  payload->send_message.send_message.reset();
+  CallCombinerClosureList closures;
+  closures.Add(payload->recv_initial_metadata.recv_initial_metadata_ready,
+               GRPC_ERROR_NONE, "shared recv_initial_metadata_ready");
+  closures.Add(payload->recv_message.recv_message_ready, GRPC_ERROR_NONE,
+               "shared recv_message_ready");
+  closures.Add(payload->recv_trailing_metadata.recv_trailing_metadata_ready,
+               GRPC_ERROR_NONE, "shared recv_trailing_metadata_ready");
+  if (batch->on_complete != nullptr) {
+    closures.Add(batch->on_complete, GRPC_ERROR_NONE, "shared on_complete");
+  }
+  closures.RunClosuresWithoutYielding(call_combiner);
+  grpc_transport_stream_op_batch* cancel =
+      grpc_make_transport_stream_op(GRPC_CLOSURE_INIT(
+          &on_cancel_stream_done_, OnCancelStreamDone, this,
+          grpc_schedule_on_exec_ctx));
+  cancel->cancel_stream = true;
+  cancel->payload->cancel_stream.cancel_error = GRPC_ERROR_CANCELLED;
+  grpc_call_next_op(elem, cancel);
+}
+
+void UnaryBatchCompleter::OnCancelStreamDone(void* arg, grpc_error* error) {
+  UnaryBatchCompleter* completer = static_cast<UnaryBatchCompleter*>(arg);
+  GRPC_CALL_COMBINER_STOP(completer->call_combiner_,
+                          "shared call's cancel_stream done");
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,130 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_CHANNEL_UNARY_BATCH_H
+#define GRPC_CORE_LIB_CHANNEL_UNARY_BATCH_H
+
+#include <grpc/support/port_platform.h>
+
+#include <string.h>
+
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/gprpp/arena.h"
+#include "src/core/lib/gprpp/inlined_vector.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/transport/byte_stream.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/transport.h"
+
+// Helpers for filters that take a unary call's whole batch (every send and
+// receive op at once), key it by its request and may complete it themselves
+// with the response of another call: the unary coalescing and response cache
+// filters.
+
+namespace grpc_core {
+
+/// Returns true if \a batch carries all six ops of a unary call.
+bool IsUnaryBatch(const grpc_transport_stream_op_batch* batch);
+
+/// Returns true if the call \a batch belongs to has per-call credentials.
+/// Those are applied below the client channel, so a filter above it that
+/// shares responses between calls never sees the metadata they add.
+bool HasCallCredentials(const grpc_transport_stream_op_batch* batch);
+
+/// Writes \a value at \a p and returns the byte after it.
+inline uint8_t* AppendUint32(uint8_t* p, uint32_t value) {
+  memcpy(p, &value, sizeof(value));
+  return p + sizeof(value);
+}
+
+/// Reads the request of a unary batch so that a filter can key on its bytes;
+/// the request is replayed when the batch goes down.
+class UnaryRequestReader {
+ public:
+  UnaryRequestReader() = default;
+  ~UnaryRequestReader();
+
+  /// Reads the request of \a batch, which must be a unary batch. Returns true
+  /// if all of it was available synchronously, in which case request() and
+  /// flags() describe it and the caller still owns the batch. Otherwise the
+  /// reader has failed the batch or will send it down \a elem unchanged once
+  /// the read completes.
+  bool Read(grpc_call_element* elem, CallCombiner* call_combiner,
+            grpc_transport_stream_op_batch* batch);
+
+  grpc_slice_buffer* request() { return cache_->cache_buffer(); }
+  uint32_t flags() { return caching_stream_->flags(); }
+
+ private:
+  static void OnNextDone(void* arg, grpc_error* error);
+
+  grpc_call_element* elem_ = nullptr;
+  CallCombiner* call_combiner_ = nullptr;
+  grpc_transport_stream_op_batch* batch_ = nullptr;
+  bool started_ = false;
+  ManualConstructor<ByteStreamCache> cache_;
+  ManualConstructor<ByteStreamCache::CachingByteStream> caching_stream_;
+  size_t bytes_read_ = 0;
+  grpc_closure on_next_done_;
+};
+
+/// The results of a unary call, kept to complete other calls' batches with.
+struct UnaryResponse {
+  UnaryResponse() { grpc_slice_buffer_init(&message); }
+  ~UnaryResponse();
+
+  InlinedVector<grpc_mdelem, 8> initial_metadata;
+  bool has_message = false;
+  uint32_t message_flags = 0;
+  grpc_slice_buffer message;
+  InlinedVector<grpc_mdelem, 8> trailing_metadata;
+};
+
+/// Completes a unary batch held by a filter from a UnaryResponse, instead of
+/// sending it down.
+class UnaryBatchCompleter {
+ public:
+  UnaryBatchCompleter() = default;
+  ~UnaryBatchCompleter();
+
+  /// Fills in the receive ops of \a batch with copies of \a response and
+  /// runs their callbacks, or fails the batch if the metadata cannot be
+  /// added. Must be called in the call combiner. Since nothing below \a elem
+  /// has seen the call, a cancel_stream is then sent down so that state
+  /// waiting on it (such as the client channel's deadline timer) is released
+  /// now rather than when it expires; the call combiner is yielded when that
+  /// completes.
+  void Complete(grpc_call_element* elem, CallCombiner* call_combiner,
+                Arena* arena, grpc_transport_stream_op_batch* batch,
+                const UnaryResponse& response);
+
+ private:
+  static grpc_error* AddMetadata(const InlinedVector<grpc_mdelem, 8>& mds,
+                                 Arena* arena, grpc_metadata_batch* batch);
+  static void OnCancelStreamDone(void* arg, grpc_error* error);
+
+  CallCombiner* call_combiner_ = nullptr;
+  bool has_message_stream_ = false;
+  ManualConstructor<SliceBufferByteStream> message_stream_;
+  grpc_closure on_cancel_stream_done_;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_CHANNEL_UNARY_BATCH_H */
@@ -26,6 +26,8 @@
 #include "src/core/lib/compression/algorithm_metadata.h"
 #include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/slice/slice_utils.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/transport/static_metadata.h"
@@ -263,6 +265,24 @@ int grpc_message_compression_algorithm_parse(
   return 0;
 }
 
+int grpc_message_compression_is_deflate_persistent(grpc_slice value) {
+  return grpc_slice_str_cmp(value,
+                            GRPC_MESSAGE_COMPRESS_DEFLATE_PERSISTENT_NAME) == 0;
+}
+
+int grpc_message_compression_accepts_deflate_persistent(
+    grpc_slice accept_encoding) {
+  grpc_slice_buffer parts;
+  grpc_slice_buffer_init(&parts);
+  grpc_slice_split_without_space(accept_encoding, ",", &parts);
+  int found = 0;
+  for (size_t i = 0; i < parts.count && !found; i++) {
+    found = grpc_message_compression_is_deflate_persistent(parts.slices[i]);
+  }
+  grpc_slice_buffer_destroy_internal(&parts);
+  return found;
+}
+
 /* Interfaces for stream compression. */
 
 int grpc_stream_compression_algorithm_parse(
@@ -76,6 +76,19 @@ grpc_message_compression_algorithm grpc_message_compression_algorithm_for_level(
 int grpc_message_compression_algorithm_parse(
     grpc_slice value, grpc_message_compression_algorithm* algorithm);
 
+/* The grpc-encoding of deflate messages compressed with one context per
+   stream (see grpc_msg_persistent_compressor). Every receiver decodes it;
+   channels that send it also list it in their grpc-accept-encoding. */
+#define GRPC_MESSAGE_COMPRESS_DEFLATE_PERSISTENT_NAME "deflate-persistent"
+
+/* Returns 1 if value is GRPC_MESSAGE_COMPRESS_DEFLATE_PERSISTENT_NAME. */
+int grpc_message_compression_is_deflate_persistent(grpc_slice value);
+
+/* Returns 1 if the grpc-accept-encoding value accept_encoding lists
+   GRPC_MESSAGE_COMPRESS_DEFLATE_PERSISTENT_NAME. */
+int grpc_message_compression_accepts_deflate_persistent(
+    grpc_slice accept_encoding);
+
 /* Interfaces for stream compression. */
 
 int grpc_stream_compression_algorithm_parse(
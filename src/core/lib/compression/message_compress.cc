@@ -20,23 +20,33 @@
 
 #include "src/core/lib/compression/message_compress.h"
 
+#include <stdint.h>
 #include <string.h>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 
 #include <zlib.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 #define OUTPUT_BLOCK_SIZE 1024
+/* The most zlib streams of each kind kept for reuse */
+#define MAX_POOLED_STREAMS 8
 
+/* Runs flate over input, appending its output to output, and ends with
+   last_flush (Z_FINISH or Z_SYNC_FLUSH). Gives up once the output reaches
+   max_output_length bytes. */
 static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
                      grpc_slice_buffer* output,
-                     int (*flate)(z_stream* zs, int flush)) {
+                     int (*flate)(z_stream* zs, int flush), int last_flush,
+                     size_t max_output_length) {
   int r;
   int flush;
   size_t i;
+  size_t output_length = 0;
   grpc_slice outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
   const uInt uint_max = ~static_cast<uInt>(0);
 
@@ -45,13 +55,15 @@ static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
   zs->next_out = GRPC_SLICE_START_PTR(outbuf);
   flush = Z_NO_FLUSH;
   for (i = 0; i < input->count; i++) {
-    if (i == input->count - 1) flush = Z_FINISH;
+    if (i == input->count - 1) flush = last_flush;
     GPR_ASSERT(GRPC_SLICE_LENGTH(input->slices[i]) <= uint_max);
     zs->avail_in = static_cast<uInt> GRPC_SLICE_LENGTH(input->slices[i]);
     zs->next_in = GRPC_SLICE_START_PTR(input->slices[i]);
     do {
       if (zs->avail_out == 0) {
+        output_length += GRPC_SLICE_LENGTH(outbuf);
         grpc_slice_buffer_add_indexed(output, outbuf);
+        if (output_length >= max_output_length) return 0;
         outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
         GPR_ASSERT(GRPC_SLICE_LENGTH(outbuf) <= uint_max);
         zs->avail_out = static_cast<uInt> GRPC_SLICE_LENGTH(outbuf);
@@ -86,20 +98,102 @@ static void* zalloc_gpr(void* opaque, unsigned int items, unsigned int size) {
 
 static void zfree_gpr(void* opaque, void* address) { gpr_free(address); }
 
-static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                         int gzip) {
+/* Setting up a zlib stream allocates and clears several hundred KB of state,
+   which costs more than compressing a small message. Streams are reset and
+   kept in pools for the next message instead. */
+typedef struct {
   z_stream zs;
+  int level; /* for deflate streams */
+} zlib_stream;
+
+/* Pools are indexed by stream_kind(). */
+static gpr_once g_stream_pool_once = GPR_ONCE_INIT;
+static gpr_mu g_stream_pool_mu;
+static zlib_stream* g_stream_pool[4][MAX_POOLED_STREAMS];
+static size_t g_stream_pool_count[4];
+
+static void init_stream_pool(void) { gpr_mu_init(&g_stream_pool_mu); }
+
+static size_t stream_kind(int inflating, int gzip) {
+  return (inflating ? 2 : 0) + (gzip ? 1 : 0);
+}
+
+static zlib_stream* take_pooled_stream(size_t kind) {
+  zlib_stream* s = nullptr;
+  gpr_once_init(&g_stream_pool_once, init_stream_pool);
+  gpr_mu_lock(&g_stream_pool_mu);
+  if (g_stream_pool_count[kind] > 0) {
+    s = g_stream_pool[kind][--g_stream_pool_count[kind]];
+  }
+  gpr_mu_unlock(&g_stream_pool_mu);
+  return s;
+}
+
+static void end_stream(size_t kind, zlib_stream* s) {
+  if (kind >= 2) {
+    inflateEnd(&s->zs);
+  } else {
+    deflateEnd(&s->zs);
+  }
+  gpr_free(s);
+}
+
+/* Resets s and pools it, or ends it if its pool is full. */
+static void release_stream(size_t kind, zlib_stream* s) {
+  int r = kind >= 2 ? inflateReset(&s->zs) : deflateReset(&s->zs);
+  if (r == Z_OK) {
+    gpr_mu_lock(&g_stream_pool_mu);
+    if (g_stream_pool_count[kind] < MAX_POOLED_STREAMS) {
+      g_stream_pool[kind][g_stream_pool_count[kind]++] = s;
+      s = nullptr;
+    }
+    gpr_mu_unlock(&g_stream_pool_mu);
+  }
+  if (s != nullptr) end_stream(kind, s);
+}
+
+static zlib_stream* get_deflate_stream(int gzip, int level) {
+  zlib_stream* s = take_pooled_stream(stream_kind(0, gzip));
+  int r;
+  if (s != nullptr) {
+    if (s->level == level) return s;
+    /* deflateParams() may flush through the stale output pointers of the
+       previous message, so start afresh instead. Channels rarely mix levels. */
+    end_stream(stream_kind(0, gzip), s);
+  }
+  s = static_cast<zlib_stream*>(gpr_zalloc(sizeof(*s)));
+  s->zs.zalloc = zalloc_gpr;
+  s->zs.zfree = zfree_gpr;
+  r = deflateInit2(&s->zs, level, Z_DEFLATED, 15 | (gzip ? 16 : 0), 8,
+                   Z_DEFAULT_STRATEGY);
+  GPR_ASSERT(r == Z_OK);
+  s->level = level;
+  return s;
+}
+
+static zlib_stream* get_inflate_stream(int gzip) {
+  zlib_stream* s = take_pooled_stream(stream_kind(1, gzip));
+  int r;
+  if (s != nullptr) return s;
+  s = static_cast<zlib_stream*>(gpr_zalloc(sizeof(*s)));
+  s->zs.zalloc = zalloc_gpr;
+  s->zs.zfree = zfree_gpr;
+  r = inflateInit2(&s->zs, 15 | (gzip ? 16 : 0));
+  GPR_ASSERT(r == Z_OK);
+  return s;
+}
+
+static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
+                         int gzip, int level) {
+  zlib_stream* s = get_deflate_stream(gzip, level);
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
-                   8, Z_DEFAULT_STRATEGY);
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, deflate) && output->length < input->length;
+  /* Output that is not smaller than the input is of no use: stop making it
+     as soon as that is known, rather than compressing all the input. */
+  r = zlib_body(&s->zs, input, output, deflate, Z_FINISH, input->length) &&
+      output->length - length_before < input->length;
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_slice_unref_internal(output->slices[i]);
@@ -107,23 +201,18 @@ static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
     output->count = count_before;
     output->length = length_before;
   }
-  deflateEnd(&zs);
+  release_stream(stream_kind(0, gzip), s);
   return r;
 }
 
 static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
                            int gzip) {
-  z_stream zs;
+  zlib_stream* s = get_inflate_stream(gzip);
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, inflate);
+  r = zlib_body(&s->zs, input, output, inflate, Z_FINISH, SIZE_MAX);
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_slice_unref_internal(output->slices[i]);
@@ -131,10 +220,100 @@ static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
     output->count = count_before;
     output->length = length_before;
   }
-  inflateEnd(&zs);
+  release_stream(stream_kind(1, gzip), s);
   return r;
 }
 
+void grpc_msg_compress_shutdown(void) {
+  size_t kind;
+  gpr_once_init(&g_stream_pool_once, init_stream_pool);
+  gpr_mu_lock(&g_stream_pool_mu);
+  for (kind = 0; kind < GPR_ARRAY_SIZE(g_stream_pool); kind++) {
+    while (g_stream_pool_count[kind] > 0) {
+      end_stream(kind, g_stream_pool[kind][--g_stream_pool_count[kind]]);
+    }
+  }
+  gpr_mu_unlock(&g_stream_pool_mu);
+}
+
+struct grpc_msg_persistent_compressor {
+  int inflating;
+  /* lazily taken from the pool by the first message */
+  zlib_stream* stream;
+  int level;
+  int failed;
+};
+
+static grpc_msg_persistent_compressor* persistent_create(int inflating,
+                                                         int level) {
+  grpc_msg_persistent_compressor* c =
+      static_cast<grpc_msg_persistent_compressor*>(gpr_zalloc(sizeof(*c)));
+  c->inflating = inflating;
+  c->level = level;
+  return c;
+}
+
+static void persistent_destroy(grpc_msg_persistent_compressor* c) {
+  if (c->stream != nullptr) {
+    /* Pooled streams are reset on their way in, which also discards the
+       dictionary built up here. */
+    release_stream(stream_kind(c->inflating, 0), c->stream);
+  }
+  gpr_free(c);
+}
+
+static int persistent_flate(grpc_msg_persistent_compressor* c,
+                            grpc_slice_buffer* input,
+                            grpc_slice_buffer* output) {
+  size_t i;
+  size_t count_before = output->count;
+  size_t length_before = output->length;
+  if (c->failed) return 0;
+  if (c->stream == nullptr) {
+    c->stream = c->inflating ? get_inflate_stream(0)
+                             : get_deflate_stream(0, c->level);
+  }
+  if (zlib_body(&c->stream->zs, input, output,
+                c->inflating ? inflate : deflate, Z_SYNC_FLUSH, SIZE_MAX)) {
+    return 1;
+  }
+  for (i = count_before; i < output->count; i++) {
+    grpc_slice_unref_internal(output->slices[i]);
+  }
+  output->count = count_before;
+  output->length = length_before;
+  /* The two ends' dictionaries no longer match. */
+  c->failed = 1;
+  return 0;
+}
+
+grpc_msg_persistent_compressor* grpc_msg_persistent_compressor_create(
+    int level) {
+  return persistent_create(0, level);
+}
+
+grpc_msg_persistent_compressor* grpc_msg_persistent_decompressor_create(void) {
+  return persistent_create(1, GRPC_MSG_COMPRESS_DEFAULT_LEVEL);
+}
+
+void grpc_msg_persistent_compressor_destroy(grpc_msg_persistent_compressor* c) {
+  persistent_destroy(c);
+}
+
+int grpc_msg_persistent_compress(grpc_msg_persistent_compressor* c,
+                                 grpc_slice_buffer* input,
+                                 grpc_slice_buffer* output) {
+  GPR_DEBUG_ASSERT(!c->inflating);
+  return persistent_flate(c, input, output);
+}
+
+int grpc_msg_persistent_decompress(grpc_msg_persistent_compressor* c,
+                                   grpc_slice_buffer* input,
+                                   grpc_slice_buffer* output) {
+  GPR_DEBUG_ASSERT(c->inflating);
+  return persistent_flate(c, input, output);
+}
+
 static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
   size_t i;
   for (i = 0; i < input->count; i++) {
@@ -144,16 +323,17 @@ static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
 }
 
 static int compress_inner(grpc_message_compression_algorithm algorithm,
-                          grpc_slice_buffer* input, grpc_slice_buffer* output) {
+                          int level, grpc_slice_buffer* input,
+                          grpc_slice_buffer* output) {
   switch (algorithm) {
     case GRPC_MESSAGE_COMPRESS_NONE:
       /* the fallback path always needs to be send uncompressed: we simply
          rely on that here */
       return 0;
     case GRPC_MESSAGE_COMPRESS_DEFLATE:
-      return zlib_compress(input, output, 0);
+      return zlib_compress(input, output, 0, level);
     case GRPC_MESSAGE_COMPRESS_GZIP:
-      return zlib_compress(input, output, 1);
+      return zlib_compress(input, output, 1, level);
     case GRPC_MESSAGE_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -163,7 +343,14 @@ static int compress_inner(grpc_message_compression_algorithm algorithm,
 
 int grpc_msg_compress(grpc_message_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output) {
-  if (!compress_inner(algorithm, input, output)) {
+  return grpc_msg_compress_with_level(
+      algorithm, GRPC_MSG_COMPRESS_DEFAULT_LEVEL, input, output);
+}
+
+int grpc_msg_compress_with_level(grpc_message_compression_algorithm algorithm,
+                                 int level, grpc_slice_buffer* input,
+                                 grpc_slice_buffer* output) {
+  if (!compress_inner(algorithm, level, input, output)) {
     copy(input, output);
     return 0;
   }
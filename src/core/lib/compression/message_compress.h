@@ -31,10 +31,52 @@
 int grpc_msg_compress(grpc_message_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output);
 
+/* As grpc_msg_compress, with the effort deflate and gzip spend given as a zlib
+   level: 1 (fastest) to 9 (smallest), or GRPC_MSG_COMPRESS_DEFAULT_LEVEL. */
+int grpc_msg_compress_with_level(grpc_message_compression_algorithm algorithm,
+                                 int level, grpc_slice_buffer* input,
+                                 grpc_slice_buffer* output);
+
+/* zlib's own default level, 6. */
+#define GRPC_MSG_COMPRESS_DEFAULT_LEVEL (-1)
+
+/* Frees the zlib streams kept for reuse across messages. */
+void grpc_msg_compress_shutdown(void);
+
 /* decompress 'input' to 'output' using 'algorithm'.
    On success, appends slices to output and returns 1.
    On failure, output is unchanged, and returns 0. */
 int grpc_msg_decompress(grpc_message_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output);
 
+/* Deflates the messages of one stream with a single zlib stream, so that
+   small, repetitive messages can refer back to the ones sent before them.
+   Each message ends on a sync flush: it is still framed on its own, but only
+   decodes after all the earlier compressed messages of the stream have, in
+   order, through one grpc_msg_persistent_decompressor. Sent with the
+   "deflate-persistent" grpc-encoding. */
+typedef struct grpc_msg_persistent_compressor grpc_msg_persistent_compressor;
+
+/* level is as for grpc_msg_compress_with_level. The decompressor is of the
+   same type, and only used with grpc_msg_persistent_decompress. */
+grpc_msg_persistent_compressor* grpc_msg_persistent_compressor_create(
+    int level);
+grpc_msg_persistent_compressor* grpc_msg_persistent_decompressor_create(void);
+void grpc_msg_persistent_compressor_destroy(grpc_msg_persistent_compressor* c);
+
+/* Appends the compressed input to output and returns 1. Unlike
+   grpc_msg_compress, the output is kept even if it is larger than the input:
+   once the compressor has seen a message, the receiver has to as well.
+   On failure, output is unchanged and 0 is returned, now and for every later
+   message, which must then be sent uncompressed. */
+int grpc_msg_persistent_compress(grpc_msg_persistent_compressor* c,
+                                 grpc_slice_buffer* input,
+                                 grpc_slice_buffer* output);
+
+/* Appends the decompressed input to output and returns 1. On failure,
+   output is unchanged and 0 is returned, now and for every later message. */
+int grpc_msg_persistent_decompress(grpc_msg_persistent_compressor* c,
+                                   grpc_slice_buffer* input,
+                                   grpc_slice_buffer* output);
+
 #endif /* GRPC_CORE_LIB_COMPRESSION_MESSAGE_COMPRESS_H */
@@ -35,20 +35,28 @@ extern grpc_stats_data* grpc_stats_per_cpu_storage;
 #define GRPC_THREAD_STATS_DATA() \
   (&grpc_stats_per_cpu_storage[grpc_core::ExecCtx::Get()->starting_cpu()])
 
-/* Only collect stats if GRPC_COLLECT_STATS is defined or it is a debug build.
- */
-#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+/* Stats are collected unless GRPC_DISABLE_STATS is defined. Each increment is
+   a relaxed add to a counter of the cpu the exec_ctx started on, so they stay
+   on in optimized builds and can be read with grpc_stats_collect() or
+   grpc::experimental::GetCoreStats(). */
+#ifndef GRPC_DISABLE_STATS
 #define GRPC_STATS_INC_COUNTER(ctr) \
   (gpr_atm_no_barrier_fetch_add(&GRPC_THREAD_STATS_DATA()->counters[(ctr)], 1))
 
+/* For counters that sum a quantity, such as time, rather than count events */
+#define GRPC_STATS_ADD_COUNTER(ctr, value)                                  \
+  (gpr_atm_no_barrier_fetch_add(&GRPC_THREAD_STATS_DATA()->counters[(ctr)], \
+                                (value)))
+
 #define GRPC_STATS_INC_HISTOGRAM(histogram, index)                             \
   (gpr_atm_no_barrier_fetch_add(                                               \
       &GRPC_THREAD_STATS_DATA()->histograms[histogram##_FIRST_SLOT + (index)], \
       1))
-#else /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+#else /* GRPC_DISABLE_STATS */
 #define GRPC_STATS_INC_COUNTER(ctr)
+#define GRPC_STATS_ADD_COUNTER(ctr, value)
 #define GRPC_STATS_INC_HISTOGRAM(histogram, index)
-#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+#endif /* GRPC_DISABLE_STATS */
 
 void grpc_stats_init(void);
 void grpc_stats_shutdown(void);
@@ -34,6 +34,8 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "server_channels_created",
     "syscall_poll",
     "syscall_wait",
+    "busy_poll_hits",
+    "busy_poll_misses",
     "pollset_kick",
     "pollset_kicked_without_poller",
     "pollset_kicked_again",
@@ -60,6 +62,7 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "http2_writes_begun",
     "http2_writes_offloaded",
     "http2_writes_continued",
+    "http2_writes_coalesced",
     "http2_partial_writes",
     "http2_initiate_write_due_to_initial_write",
     "http2_initiate_write_due_to_start_new_stream",
@@ -109,6 +112,9 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "combiner_locks_scheduled_items",
     "combiner_locks_scheduled_final_items",
     "combiner_locks_offloaded",
+    "combiner_locks_offload_deferred",
+    "control_plane_combiner_handoffs",
+    "control_plane_combiner_run_time_us",
     "call_combiner_locks_initiated",
     "call_combiner_locks_scheduled_items",
     "call_combiner_set_notify_on_cancel",
@@ -119,8 +125,17 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "executor_wakeup_initiated",
     "executor_queue_drained",
     "executor_push_retries",
+    "executor_steals",
+    "resolver_lookups",
+    "resolver_lookups_shared",
+    "handshaker_next_offloaded",
+    "handshaker_next_offload_queue_full",
     "server_requested_calls",
     "server_slowpath_requests_queued",
+    "server_requests_matched_locally",
+    "server_requests_matched_remotely",
+    "server_requests_shed",
+    "messages_decompressed_offloaded",
     "cq_ev_queue_trylock_failures",
     "cq_ev_queue_trylock_successes",
     "cq_ev_queue_transient_pop_failures",
@@ -134,6 +149,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of server channels created",
     "Number of polling syscalls (epoll_wait, poll, etc) made by this process",
     "Number of sleeping syscalls made by this process",
+    "Number of times a busy-polling poller found events before its spin "
+    "budget ran out",
+    "Number of times a busy-polling poller spent its spin budget without "
+    "finding events, and blocked",
     "How many polling wakeups were performed by the process (only valid for "
     "epoll1 right now)",
     "How many times was a polling wakeup requested without an active poller "
@@ -170,6 +189,8 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of HTTP2 writes offloaded to the executor from application threads",
     "Number of HTTP2 writes that finished seeing more data needed to be "
     "written",
+    "Number of HTTP2 writes held back by the write coalescing window to pick "
+    "up frames from other streams",
     "Number of HTTP2 writes that were made knowing there was still more data "
     "to be written (we cap maximum write size to syscall_write)",
     "Number of HTTP2 writes initiated due to 'initial_write'",
@@ -228,6 +249,11 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of items scheduled against combiner locks",
     "Number of final items scheduled against combiner locks",
     "Number of combiner locks offloaded to different threads",
+    "Number of times a contended combiner lock kept running on its thread "
+    "rather than being offloaded, because it had offload budget left",
+    "Number of times a control plane combiner lock was handed from another "
+    "thread to the control plane executor",
+    "Microseconds control plane combiner locks spent running closures",
     "Number of call combiner lock entries by process (first items queued to a "
     "call combiner)",
     "Number of items scheduled against call combiner locks",
@@ -242,9 +268,26 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of times an executor queue was drained",
     "Number of times we raced and were forced to retry pushing a closure to "
     "the executor",
+    "Number of closures an idle executor thread took from the queue of a "
+    "busy one (work stealing scheduling only)",
+    "Number of getaddrinfo lookups made by the native DNS resolver",
+    "Number of native DNS resolutions answered by a lookup of the same name "
+    "that was already in flight",
+    "Number of TSI handshaker steps run on the handshake offload thread pool",
+    "Number of TSI handshaker steps run inline because the handshake offload "
+    "queue was full",
     "How many calls were requested (not necessarily received) by the server",
     "How many times was the server slow path taken (indicates too few "
     "outstanding requests)",
+    "Number of incoming calls matched to a request on the completion queue "
+    "polled by the thread that received them",
+    "Number of incoming calls matched to a request on a completion queue "
+    "other than the one polled by the thread that received them",
+    "Number of incoming calls failed with RESOURCE_EXHAUSTED because they had "
+    "been kept waiting too long for a request (see "
+    "GRPC_ARG_SERVER_QUEUE_DELAY_TARGET_MS)",
+    "Number of received messages decompressed on an executor thread rather "
+    "than by the application",
     "Number of lock (trylock) acquisition failures on completion queue event "
     "queue. High value here indicates high contention on completion queues",
     "Number of lock (trylock) acquisition successes on completion queue event "
@@ -255,6 +298,7 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
 const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "call_initial_size",
     "poll_events_returned",
+    "poll_events_processed",
     "tcp_write_size",
     "tcp_write_iov_size",
     "tcp_read_size",
@@ -265,11 +309,16 @@ const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "http2_send_message_per_write",
     "http2_send_trailing_metadata_per_write",
     "http2_send_flowctl_per_write",
+    "http2_frames_per_write",
+    "executor_queue_depth",
+    "handshaker_offload_queue_depth",
     "server_cqs_checked",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Initial size of the grpc_call arena created at call start",
     "How many events are called for each syscall_poll",
+    "How many polling events were handled by a poller before it flushed the "
+    "resulting closures (only valid for epoll1 right now)",
     "Number of bytes offered to each syscall_write",
     "Number of byte segments offered to each syscall_write",
     "Number of bytes received by each syscall_read",
@@ -280,6 +329,12 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of streams whose payload was written per TCP write",
     "Number of streams terminated per TCP write",
     "Number of flow control updates written per TCP write",
+    "Number of stream frames (headers, data, trailers and window updates) "
+    "written per TCP write",
+    "Number of closures queued on an executor thread when another is enqueued "
+    "to it",
+    "Number of handshaker steps already queued on the handshake offload pool "
+    "when another is queued",
     "How many completion queues were checked looking for a CQ that had "
     "requested the incoming call",
 };
@@ -350,6 +405,10 @@ const uint8_t grpc_stats_table_7[102] = {
     42, 42, 43, 44, 44, 45, 46, 46, 47, 48, 48, 49, 49, 50, 50, 51, 51};
 const int grpc_stats_table_8[9] = {0, 1, 2, 4, 7, 13, 23, 39, 64};
 const uint8_t grpc_stats_table_9[9] = {0, 0, 1, 2, 2, 3, 4, 4, 5};
+const int grpc_stats_table_10[17] = {0,  1,  2,   4,   7,   11,  17,  26,  40,
+                                     60, 90, 135, 203, 305, 457, 685, 1024};
+const uint8_t grpc_stats_table_11[17] = {0, 0, 1, 2, 3,  3,  4,  5, 6,
+                                         7, 8, 8, 9, 10, 11, 12, 13};
 void grpc_stats_inc_call_initial_size(int value) {
   value = GPR_CLAMP(value, 0, 262144);
   if (value < 6) {
@@ -396,6 +455,31 @@ void grpc_stats_inc_poll_events_returned(int value) {
       GRPC_STATS_HISTOGRAM_POLL_EVENTS_RETURNED,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_2, 128));
 }
+void grpc_stats_inc_poll_events_processed(int value) {
+  value = GPR_CLAMP(value, 0, 1024);
+  if (value < 29) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_POLL_EVENTS_PROCESSED,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4642789003353915392ull) {
+    int bucket =
+        grpc_stats_table_3[((_val.uint - 4628855992006737920ull) >> 47)] + 29;
+    _bkt.dbl = grpc_stats_table_2[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_POLL_EVENTS_PROCESSED,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_POLL_EVENTS_PROCESSED,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_2, 128));
+}
 void grpc_stats_inc_tcp_write_size(int value) {
   value = GPR_CLAMP(value, 0, 16777216);
   if (value < 5) {
@@ -638,6 +722,79 @@ void grpc_stats_inc_http2_send_flowctl_per_write(int value) {
       GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
 }
+void grpc_stats_inc_http2_frames_per_write(int value) {
+  value = GPR_CLAMP(value, 0, 1024);
+  if (value < 13) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4637863191261478912ull) {
+    int bucket =
+        grpc_stats_table_7[((_val.uint - 4623507967449235456ull) >> 48)] + 13;
+    _bkt.dbl = grpc_stats_table_6[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
+}
+void grpc_stats_inc_executor_queue_depth(int value) {
+  value = GPR_CLAMP(value, 0, 64);
+  if (value < 3) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4625196817309499392ull) {
+    int bucket =
+        grpc_stats_table_9[((_val.uint - 4613937818241073152ull) >> 51)] + 3;
+    _bkt.dbl = grpc_stats_table_8[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
+}
+void grpc_stats_inc_handshaker_offload_queue_depth(int value) {
+  value = GPR_CLAMP(value, 0, 1024);
+  if (value < 3) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HANDSHAKER_OFFLOAD_QUEUE_DEPTH,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4643211215818981376ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4613937818241073152ull) >> 51)] + 3;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HANDSHAKER_OFFLOAD_QUEUE_DEPTH,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_HANDSHAKER_OFFLOAD_QUEUE_DEPTH,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 16));
+}
 void grpc_stats_inc_server_cqs_checked(int value) {
   value = GPR_CLAMP(value, 0, 64);
   if (value < 3) {
@@ -661,19 +818,22 @@ void grpc_stats_inc_server_cqs_checked(int value) {
       GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
 }
-const int grpc_stats_histo_buckets[13] = {64, 128, 64, 64, 64, 64, 64,
-                                          64, 64,  64, 64, 64, 8};
-const int grpc_stats_histo_start[13] = {0,   64,  192, 256, 320, 384, 448,
-                                        512, 576, 640, 704, 768, 832};
-const int* const grpc_stats_histo_bucket_boundaries[13] = {
-    grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_6,
-    grpc_stats_table_6, grpc_stats_table_6, grpc_stats_table_6,
-    grpc_stats_table_8};
-void (*const grpc_stats_inc_histogram[13])(int x) = {
+const int grpc_stats_histo_buckets[17] = {64, 128, 128, 64, 64, 64, 64, 64, 64,
+                                          64, 64,  64,  64, 64, 8,  16, 8};
+const int grpc_stats_histo_start[17] = {
+    0,   64,  192, 320, 384, 448, 512,  576,  640,
+    704, 768, 832, 896, 960, 1024, 1032, 1048};
+const int* const grpc_stats_histo_bucket_boundaries[17] = {
+    grpc_stats_table_0,  grpc_stats_table_2, grpc_stats_table_2,
+    grpc_stats_table_4,  grpc_stats_table_6, grpc_stats_table_4,
+    grpc_stats_table_4,  grpc_stats_table_6, grpc_stats_table_4,
+    grpc_stats_table_6,  grpc_stats_table_6, grpc_stats_table_6,
+    grpc_stats_table_6,  grpc_stats_table_6, grpc_stats_table_8,
+    grpc_stats_table_10, grpc_stats_table_8};
+void (*const grpc_stats_inc_histogram[17])(int x) = {
     grpc_stats_inc_call_initial_size,
     grpc_stats_inc_poll_events_returned,
+    grpc_stats_inc_poll_events_processed,
     grpc_stats_inc_tcp_write_size,
     grpc_stats_inc_tcp_write_iov_size,
     grpc_stats_inc_tcp_read_size,
@@ -684,4 +844,7 @@ void (*const grpc_stats_inc_histogram[13])(int x) = {
     grpc_stats_inc_http2_send_message_per_write,
     grpc_stats_inc_http2_send_trailing_metadata_per_write,
     grpc_stats_inc_http2_send_flowctl_per_write,
+    grpc_stats_inc_http2_frames_per_write,
+    grpc_stats_inc_executor_queue_depth,
+    grpc_stats_inc_handshaker_offload_queue_depth,
     grpc_stats_inc_server_cqs_checked};
@@ -35,6 +35,8 @@ typedef enum {
   GRPC_STATS_COUNTER_SERVER_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_SYSCALL_POLL,
   GRPC_STATS_COUNTER_SYSCALL_WAIT,
+  GRPC_STATS_COUNTER_BUSY_POLL_HITS,
+  GRPC_STATS_COUNTER_BUSY_POLL_MISSES,
   GRPC_STATS_COUNTER_POLLSET_KICK,
   GRPC_STATS_COUNTER_POLLSET_KICKED_WITHOUT_POLLER,
   GRPC_STATS_COUNTER_POLLSET_KICKED_AGAIN,
@@ -61,6 +63,7 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_WRITES_BEGUN,
   GRPC_STATS_COUNTER_HTTP2_WRITES_OFFLOADED,
   GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED,
+  GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED,
   GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM,
@@ -110,6 +113,9 @@ typedef enum {
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_ITEMS,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOADED,
+  GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOAD_DEFERRED,
+  GRPC_STATS_COUNTER_CONTROL_PLANE_COMBINER_HANDOFFS,
+  GRPC_STATS_COUNTER_CONTROL_PLANE_COMBINER_RUN_TIME_US,
   GRPC_STATS_COUNTER_CALL_COMBINER_LOCKS_INITIATED,
   GRPC_STATS_COUNTER_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS,
   GRPC_STATS_COUNTER_CALL_COMBINER_SET_NOTIFY_ON_CANCEL,
@@ -120,8 +126,17 @@ typedef enum {
   GRPC_STATS_COUNTER_EXECUTOR_WAKEUP_INITIATED,
   GRPC_STATS_COUNTER_EXECUTOR_QUEUE_DRAINED,
   GRPC_STATS_COUNTER_EXECUTOR_PUSH_RETRIES,
+  GRPC_STATS_COUNTER_EXECUTOR_STEALS,
+  GRPC_STATS_COUNTER_RESOLVER_LOOKUPS,
+  GRPC_STATS_COUNTER_RESOLVER_LOOKUPS_SHARED,
+  GRPC_STATS_COUNTER_HANDSHAKER_NEXT_OFFLOADED,
+  GRPC_STATS_COUNTER_HANDSHAKER_NEXT_OFFLOAD_QUEUE_FULL,
   GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS,
   GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED,
+  GRPC_STATS_COUNTER_SERVER_REQUESTS_MATCHED_LOCALLY,
+  GRPC_STATS_COUNTER_SERVER_REQUESTS_MATCHED_REMOTELY,
+  GRPC_STATS_COUNTER_SERVER_REQUESTS_SHED,
+  GRPC_STATS_COUNTER_MESSAGES_DECOMPRESSED_OFFLOADED,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
@@ -132,6 +147,7 @@ extern const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT];
 typedef enum {
   GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE,
   GRPC_STATS_HISTOGRAM_POLL_EVENTS_RETURNED,
+  GRPC_STATS_HISTOGRAM_POLL_EVENTS_PROCESSED,
   GRPC_STATS_HISTOGRAM_TCP_WRITE_SIZE,
   GRPC_STATS_HISTOGRAM_TCP_WRITE_IOV_SIZE,
   GRPC_STATS_HISTOGRAM_TCP_READ_SIZE,
@@ -142,6 +158,9 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH,
+  GRPC_STATS_HISTOGRAM_HANDSHAKER_OFFLOAD_QUEUE_DEPTH,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
@@ -152,31 +171,39 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_POLL_EVENTS_RETURNED_FIRST_SLOT = 64,
   GRPC_STATS_HISTOGRAM_POLL_EVENTS_RETURNED_BUCKETS = 128,
-  GRPC_STATS_HISTOGRAM_TCP_WRITE_SIZE_FIRST_SLOT = 192,
+  GRPC_STATS_HISTOGRAM_POLL_EVENTS_PROCESSED_FIRST_SLOT = 192,
+  GRPC_STATS_HISTOGRAM_POLL_EVENTS_PROCESSED_BUCKETS = 128,
+  GRPC_STATS_HISTOGRAM_TCP_WRITE_SIZE_FIRST_SLOT = 320,
   GRPC_STATS_HISTOGRAM_TCP_WRITE_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_TCP_WRITE_IOV_SIZE_FIRST_SLOT = 256,
+  GRPC_STATS_HISTOGRAM_TCP_WRITE_IOV_SIZE_FIRST_SLOT = 384,
   GRPC_STATS_HISTOGRAM_TCP_WRITE_IOV_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_TCP_READ_SIZE_FIRST_SLOT = 320,
+  GRPC_STATS_HISTOGRAM_TCP_READ_SIZE_FIRST_SLOT = 448,
   GRPC_STATS_HISTOGRAM_TCP_READ_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_FIRST_SLOT = 384,
+  GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_FIRST_SLOT = 512,
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE_FIRST_SLOT = 448,
+  GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE_FIRST_SLOT = 576,
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_FIRST_SLOT = 512,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_FIRST_SLOT = 640,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_INITIAL_METADATA_PER_WRITE_FIRST_SLOT = 576,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_INITIAL_METADATA_PER_WRITE_FIRST_SLOT = 704,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_INITIAL_METADATA_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE_FIRST_SLOT = 640,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE_FIRST_SLOT = 768,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_FIRST_SLOT = 704,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_FIRST_SLOT = 832,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_FIRST_SLOT = 768,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_FIRST_SLOT = 896,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE_FIRST_SLOT = 960,
+  GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH_FIRST_SLOT = 1024,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH_BUCKETS = 8,
+  GRPC_STATS_HISTOGRAM_HANDSHAKER_OFFLOAD_QUEUE_DEPTH_FIRST_SLOT = 1032,
+  GRPC_STATS_HISTOGRAM_HANDSHAKER_OFFLOAD_QUEUE_DEPTH_BUCKETS = 16,
+  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 1048,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_BUCKETS = 1056
 } grpc_stats_histogram_constants;
-#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+#ifndef GRPC_DISABLE_STATS
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED)
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED() \
@@ -193,6 +220,10 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYSCALL_POLL)
 #define GRPC_STATS_INC_SYSCALL_WAIT() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYSCALL_WAIT)
+#define GRPC_STATS_INC_BUSY_POLL_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_BUSY_POLL_HITS)
+#define GRPC_STATS_INC_BUSY_POLL_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_BUSY_POLL_MISSES)
 #define GRPC_STATS_INC_POLLSET_KICK() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK)
 #define GRPC_STATS_INC_POLLSET_KICKED_WITHOUT_POLLER() \
@@ -245,6 +276,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_OFFLOADED)
 #define GRPC_STATS_INC_HTTP2_WRITES_CONTINUED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED)
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED)
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES)
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE() \
@@ -365,6 +398,12 @@ typedef enum {
       GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS)
 #define GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOADED)
+#define GRPC_STATS_INC_COMBINER_LOCKS_OFFLOAD_DEFERRED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOAD_DEFERRED)
+#define GRPC_STATS_INC_CONTROL_PLANE_COMBINER_HANDOFFS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CONTROL_PLANE_COMBINER_HANDOFFS)
+#define GRPC_STATS_INC_CONTROL_PLANE_COMBINER_RUN_TIME_US() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CONTROL_PLANE_COMBINER_RUN_TIME_US)
 #define GRPC_STATS_INC_CALL_COMBINER_LOCKS_INITIATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_COMBINER_LOCKS_INITIATED)
 #define GRPC_STATS_INC_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS() \
@@ -385,10 +424,28 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_QUEUE_DRAINED)
 #define GRPC_STATS_INC_EXECUTOR_PUSH_RETRIES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_PUSH_RETRIES)
+#define GRPC_STATS_INC_EXECUTOR_STEALS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_STEALS)
+#define GRPC_STATS_INC_RESOLVER_LOOKUPS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_RESOLVER_LOOKUPS)
+#define GRPC_STATS_INC_RESOLVER_LOOKUPS_SHARED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_RESOLVER_LOOKUPS_SHARED)
+#define GRPC_STATS_INC_HANDSHAKER_NEXT_OFFLOADED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HANDSHAKER_NEXT_OFFLOADED)
+#define GRPC_STATS_INC_HANDSHAKER_NEXT_OFFLOAD_QUEUE_FULL() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HANDSHAKER_NEXT_OFFLOAD_QUEUE_FULL)
 #define GRPC_STATS_INC_SERVER_REQUESTED_CALLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS)
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED)
+#define GRPC_STATS_INC_SERVER_REQUESTS_MATCHED_LOCALLY() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_REQUESTS_MATCHED_LOCALLY)
+#define GRPC_STATS_INC_SERVER_REQUESTS_MATCHED_REMOTELY() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_REQUESTS_MATCHED_REMOTELY)
+#define GRPC_STATS_INC_SERVER_REQUESTS_SHED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_REQUESTS_SHED)
+#define GRPC_STATS_INC_MESSAGES_DECOMPRESSED_OFFLOADED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_MESSAGES_DECOMPRESSED_OFFLOADED)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES() \
@@ -401,6 +458,9 @@ void grpc_stats_inc_call_initial_size(int x);
 #define GRPC_STATS_INC_POLL_EVENTS_RETURNED(value) \
   grpc_stats_inc_poll_events_returned((int)(value))
 void grpc_stats_inc_poll_events_returned(int x);
+#define GRPC_STATS_INC_POLL_EVENTS_PROCESSED(value) \
+  grpc_stats_inc_poll_events_processed((int)(value))
+void grpc_stats_inc_poll_events_processed(int x);
 #define GRPC_STATS_INC_TCP_WRITE_SIZE(value) \
   grpc_stats_inc_tcp_write_size((int)(value))
 void grpc_stats_inc_tcp_write_size(int x);
@@ -431,6 +491,15 @@ void grpc_stats_inc_http2_send_trailing_metadata_per_write(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value) \
   grpc_stats_inc_http2_send_flowctl_per_write((int)(value))
 void grpc_stats_inc_http2_send_flowctl_per_write(int x);
+#define GRPC_STATS_INC_HTTP2_FRAMES_PER_WRITE(value) \
+  grpc_stats_inc_http2_frames_per_write((int)(value))
+void grpc_stats_inc_http2_frames_per_write(int x);
+#define GRPC_STATS_INC_EXECUTOR_QUEUE_DEPTH(value) \
+  grpc_stats_inc_executor_queue_depth((int)(value))
+void grpc_stats_inc_executor_queue_depth(int x);
+#define GRPC_STATS_INC_HANDSHAKER_OFFLOAD_QUEUE_DEPTH(value) \
+  grpc_stats_inc_handshaker_offload_queue_depth((int)(value))
+void grpc_stats_inc_handshaker_offload_queue_depth(int x);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int x);
@@ -443,6 +512,8 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_SERVER_CHANNELS_CREATED()
 #define GRPC_STATS_INC_SYSCALL_POLL()
 #define GRPC_STATS_INC_SYSCALL_WAIT()
+#define GRPC_STATS_INC_BUSY_POLL_HITS()
+#define GRPC_STATS_INC_BUSY_POLL_MISSES()
 #define GRPC_STATS_INC_POLLSET_KICK()
 #define GRPC_STATS_INC_POLLSET_KICKED_WITHOUT_POLLER()
 #define GRPC_STATS_INC_POLLSET_KICKED_AGAIN()
@@ -469,6 +540,7 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_WRITES_BEGUN()
 #define GRPC_STATS_INC_HTTP2_WRITES_OFFLOADED()
 #define GRPC_STATS_INC_HTTP2_WRITES_CONTINUED()
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED()
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM()
@@ -518,6 +590,9 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS()
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS()
 #define GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED()
+#define GRPC_STATS_INC_COMBINER_LOCKS_OFFLOAD_DEFERRED()
+#define GRPC_STATS_INC_CONTROL_PLANE_COMBINER_HANDOFFS()
+#define GRPC_STATS_INC_CONTROL_PLANE_COMBINER_RUN_TIME_US()
 #define GRPC_STATS_INC_CALL_COMBINER_LOCKS_INITIATED()
 #define GRPC_STATS_INC_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS()
 #define GRPC_STATS_INC_CALL_COMBINER_SET_NOTIFY_ON_CANCEL()
@@ -528,13 +603,23 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_EXECUTOR_WAKEUP_INITIATED()
 #define GRPC_STATS_INC_EXECUTOR_QUEUE_DRAINED()
 #define GRPC_STATS_INC_EXECUTOR_PUSH_RETRIES()
+#define GRPC_STATS_INC_EXECUTOR_STEALS()
+#define GRPC_STATS_INC_RESOLVER_LOOKUPS()
+#define GRPC_STATS_INC_RESOLVER_LOOKUPS_SHARED()
+#define GRPC_STATS_INC_HANDSHAKER_NEXT_OFFLOADED()
+#define GRPC_STATS_INC_HANDSHAKER_NEXT_OFFLOAD_QUEUE_FULL()
 #define GRPC_STATS_INC_SERVER_REQUESTED_CALLS()
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED()
+#define GRPC_STATS_INC_SERVER_REQUESTS_MATCHED_LOCALLY()
+#define GRPC_STATS_INC_SERVER_REQUESTS_MATCHED_REMOTELY()
+#define GRPC_STATS_INC_SERVER_REQUESTS_SHED()
+#define GRPC_STATS_INC_MESSAGES_DECOMPRESSED_OFFLOADED()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES()
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value)
 #define GRPC_STATS_INC_POLL_EVENTS_RETURNED(value)
+#define GRPC_STATS_INC_POLL_EVENTS_PROCESSED(value)
 #define GRPC_STATS_INC_TCP_WRITE_SIZE(value)
 #define GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(value)
 #define GRPC_STATS_INC_TCP_READ_SIZE(value)
@@ -545,11 +630,14 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_MESSAGE_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
+#define GRPC_STATS_INC_HTTP2_FRAMES_PER_WRITE(value)
+#define GRPC_STATS_INC_EXECUTOR_QUEUE_DEPTH(value)
+#define GRPC_STATS_INC_HANDSHAKER_OFFLOAD_QUEUE_DEPTH(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
-#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+#endif /* GRPC_DISABLE_STATS */
+extern const int grpc_stats_histo_buckets[17];
+extern const int grpc_stats_histo_start[17];
+extern const int* const grpc_stats_histo_bucket_boundaries[17];
+extern void (*const grpc_stats_inc_histogram[17])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
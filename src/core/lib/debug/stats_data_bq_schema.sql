@@ -6,6 +6,8 @@ client_subchannels_created_per_iteration:FLOAT,
 server_channels_created_per_iteration:FLOAT,
 syscall_poll_per_iteration:FLOAT,
 syscall_wait_per_iteration:FLOAT,
+busy_poll_hits_per_iteration:FLOAT,
+busy_poll_misses_per_iteration:FLOAT,
 pollset_kick_per_iteration:FLOAT,
 pollset_kicked_without_poller_per_iteration:FLOAT,
 pollset_kicked_again_per_iteration:FLOAT,
@@ -32,6 +34,7 @@ http2_pings_sent_per_iteration:FLOAT,
 http2_writes_begun_per_iteration:FLOAT,
 http2_writes_offloaded_per_iteration:FLOAT,
 http2_writes_continued_per_iteration:FLOAT,
+http2_writes_coalesced_per_iteration:FLOAT,
 http2_partial_writes_per_iteration:FLOAT,
 http2_initiate_write_due_to_initial_write_per_iteration:FLOAT,
 http2_initiate_write_due_to_start_new_stream_per_iteration:FLOAT,
@@ -81,6 +84,9 @@ combiner_locks_initiated_per_iteration:FLOAT,
 combiner_locks_scheduled_items_per_iteration:FLOAT,
 combiner_locks_scheduled_final_items_per_iteration:FLOAT,
 combiner_locks_offloaded_per_iteration:FLOAT,
+combiner_locks_offload_deferred_per_iteration:FLOAT,
+control_plane_combiner_handoffs_per_iteration:FLOAT,
+control_plane_combiner_run_time_us_per_iteration:FLOAT,
 call_combiner_locks_initiated_per_iteration:FLOAT,
 call_combiner_locks_scheduled_items_per_iteration:FLOAT,
 call_combiner_set_notify_on_cancel_per_iteration:FLOAT,
@@ -91,8 +97,17 @@ executor_scheduled_to_self_per_iteration:FLOAT,
 executor_wakeup_initiated_per_iteration:FLOAT,
 executor_queue_drained_per_iteration:FLOAT,
 executor_push_retries_per_iteration:FLOAT,
+executor_steals_per_iteration:FLOAT,
+resolver_lookups_per_iteration:FLOAT,
+resolver_lookups_shared_per_iteration:FLOAT,
+handshaker_next_offloaded_per_iteration:FLOAT,
+handshaker_next_offload_queue_full_per_iteration:FLOAT,
 server_requested_calls_per_iteration:FLOAT,
 server_slowpath_requests_queued_per_iteration:FLOAT,
+server_requests_matched_locally_per_iteration:FLOAT,
+server_requests_matched_remotely_per_iteration:FLOAT,
+server_requests_shed_per_iteration:FLOAT,
+messages_decompressed_offloaded_per_iteration:FLOAT,
 cq_ev_queue_trylock_failures_per_iteration:FLOAT,
 cq_ev_queue_trylock_successes_per_iteration:FLOAT,
 cq_ev_queue_transient_pop_failures_per_iteration:FLOAT
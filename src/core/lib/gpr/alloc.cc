@@ -20,9 +20,12 @@
 
 #include <grpc/support/alloc.h>
 
+#include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <stdlib.h>
 #include <string.h>
+#include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/profiling/timers.h"
 
 static void* zalloc_with_calloc(size_t sz) { return calloc(sz, 1); }
@@ -97,3 +100,96 @@ void* gpr_malloc_aligned(size_t size, size_t alignment) {
 }
 
 void gpr_free_aligned(void* ptr) { gpr_free((static_cast<void**>(ptr))[-1]); }
+
+static void* malloc_with_gpr_malloc(size_t size, void* user_data) {
+  return gpr_malloc(size);
+}
+
+static void free_with_gpr_free(void* ptr, size_t size, void* user_data) {
+  gpr_free(ptr);
+}
+
+static gpr_subsystem_allocation_functions
+    g_subsystem_alloc_functions[GPR_ALLOC_SUBSYSTEM_COUNT] = {
+        {malloc_with_gpr_malloc, free_with_gpr_free, nullptr},
+        {malloc_with_gpr_malloc, free_with_gpr_free, nullptr},
+        {malloc_with_gpr_malloc, free_with_gpr_free, nullptr}};
+
+/* The bytes each subsystem holds, counted in shards picked by the current CPU
+   so that allocations on different CPUs do not all update one cache line */
+#define SUBSYSTEM_BYTES_SHARDS 16
+
+typedef union {
+  gpr_atm bytes[GPR_ALLOC_SUBSYSTEM_COUNT];
+  char padding[GPR_CACHELINE_SIZE];
+} subsystem_bytes_shard;
+
+static subsystem_bytes_shard g_subsystem_bytes[SUBSYSTEM_BYTES_SHARDS];
+
+static void count_subsystem_bytes(gpr_alloc_subsystem subsystem,
+                                  gpr_atm delta) {
+  gpr_atm_no_barrier_fetch_add(
+      &g_subsystem_bytes[gpr_cpu_current_cpu() % SUBSYSTEM_BYTES_SHARDS]
+           .bytes[subsystem],
+      delta);
+}
+
+void gpr_set_subsystem_allocation_functions(
+    gpr_alloc_subsystem subsystem,
+    gpr_subsystem_allocation_functions functions) {
+  GPR_ASSERT(subsystem >= 0 && subsystem < GPR_ALLOC_SUBSYSTEM_COUNT);
+  GPR_ASSERT(functions.malloc_fn != nullptr);
+  GPR_ASSERT(functions.free_fn != nullptr);
+  g_subsystem_alloc_functions[subsystem] = functions;
+}
+
+size_t gpr_subsystem_allocated_bytes(gpr_alloc_subsystem subsystem) {
+  GPR_ASSERT(subsystem >= 0 && subsystem < GPR_ALLOC_SUBSYSTEM_COUNT);
+  gpr_atm total = 0;
+  for (size_t i = 0; i < SUBSYSTEM_BYTES_SHARDS; i++) {
+    total += gpr_atm_no_barrier_load(&g_subsystem_bytes[i].bytes[subsystem]);
+  }
+  /* The shards are read one at a time, so a concurrent free may be seen
+     without its allocation */
+  return total > 0 ? static_cast<size_t>(total) : 0;
+}
+
+void* gpr_subsystem_malloc(gpr_alloc_subsystem subsystem, size_t size) {
+  GPR_TIMER_SCOPE("gpr_subsystem_malloc", 0);
+  if (size == 0) return nullptr;
+  const gpr_subsystem_allocation_functions& functions =
+      g_subsystem_alloc_functions[subsystem];
+  void* p = functions.malloc_fn(size, functions.user_data);
+  if (!p) {
+    abort();
+  }
+  count_subsystem_bytes(subsystem, static_cast<gpr_atm>(size));
+  return p;
+}
+
+void gpr_subsystem_free(gpr_alloc_subsystem subsystem, void* ptr,
+                        size_t size) {
+  GPR_TIMER_SCOPE("gpr_subsystem_free", 0);
+  if (ptr == nullptr) return;
+  count_subsystem_bytes(subsystem, -static_cast<gpr_atm>(size));
+  const gpr_subsystem_allocation_functions& functions =
+      g_subsystem_alloc_functions[subsystem];
+  functions.free_fn(ptr, size, functions.user_data);
+}
+
+void* gpr_subsystem_malloc_aligned(gpr_alloc_subsystem subsystem, size_t size,
+                                   size_t alignment) {
+  GPR_ASSERT(((alignment - 1) & alignment) == 0);  // Must be power of 2.
+  /* Room in front of the aligned block for the allocation's start and size */
+  size_t extra = alignment - 1 + 2 * sizeof(void*);
+  void* p = gpr_subsystem_malloc(subsystem, size + extra);
+  void** ret = (void**)(((uintptr_t)p + extra) & ~(alignment - 1));
+  ret[-1] = p;
+  ret[-2] = (void*)(uintptr_t)(size + extra);
+  return (void*)ret;
+}
+
+void gpr_subsystem_free_aligned(gpr_alloc_subsystem subsystem, void* ptr) {
+  void** header = static_cast<void**>(ptr);
+  gpr_subsystem_free(subsystem, header[-1], (size_t)(uintptr_t)header[-2]);
+}
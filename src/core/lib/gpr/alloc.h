@@ -21,8 +21,23 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <grpc/support/alloc.h>
+
 /// Given a size, round up to the next multiple of sizeof(void*).
 #define GPR_ROUND_UP_TO_ALIGNMENT_SIZE(x) \
   (((x) + GPR_MAX_ALIGNMENT - 1u) & ~(GPR_MAX_ALIGNMENT - 1u))
 
+/// Allocates size bytes for subsystem with its allocation functions, and
+/// counts them in gpr_subsystem_allocated_bytes(). Never returns null.
+void* gpr_subsystem_malloc(gpr_alloc_subsystem subsystem, size_t size);
+/// Frees memory from gpr_subsystem_malloc(); size must be what it was called
+/// with.
+void gpr_subsystem_free(gpr_alloc_subsystem subsystem, void* ptr, size_t size);
+
+/// Like gpr_malloc_aligned() and gpr_free_aligned(), for subsystem. The size
+/// is kept with the allocation, so freeing does not need it.
+void* gpr_subsystem_malloc_aligned(gpr_alloc_subsystem subsystem, size_t size,
+                                   size_t alignment);
+void gpr_subsystem_free_aligned(gpr_alloc_subsystem subsystem, void* ptr);
+
 #endif /* GRPC_CORE_LIB_GPR_ALLOC_H */
@@ -0,0 +1,40 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPR_CPU_H
+#define GRPC_CORE_LIB_GPR_CPU_H
+
+#include <grpc/support/port_platform.h>
+
+/* NUMA topology utility functions, complementing <grpc/support/cpu.h>.
+   Platforms without NUMA information report a single node holding every
+   CPU. */
+
+/* Return the number of NUMA nodes on this machine, at least 1. */
+unsigned gpr_cpu_num_numa_nodes(void);
+
+/* Return the NUMA node that \a cpu (as numbered by gpr_cpu_current_cpu())
+   belongs to, in [0, gpr_cpu_num_numa_nodes()). */
+unsigned gpr_cpu_numa_node_of_cpu(unsigned cpu);
+
+/* Restrict the calling thread to the CPUs of NUMA node \a node. Returns false
+   if the thread could not be bound, either because \a node does not exist or
+   because the platform does not support it. */
+bool gpr_cpu_bind_current_thread_to_numa_node(unsigned node);
+
+#endif /* GRPC_CORE_LIB_GPR_CPU_H */
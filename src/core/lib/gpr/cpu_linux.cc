@@ -26,6 +26,8 @@
 
 #include <errno.h>
 #include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -33,6 +35,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gpr/cpu.h"
+
 static int ncpus = 0;
 
 static void init_num_cpus() {
@@ -79,4 +83,98 @@ unsigned gpr_cpu_current_cpu(void) {
 #endif
 }
 
+/* NUMA nodes are discovered from sysfs and numbered densely, skipping nodes
+   without CPUs; kernel node ids from this value up are ignored (their CPUs are
+   reported as belonging to node 0) */
+#define MAX_NUMA_NODES 64
+
+static unsigned num_numa_nodes = 1;
+static unsigned short numa_node_of_cpu[CPU_SETSIZE];
+static cpu_set_t numa_node_cpus[MAX_NUMA_NODES];
+
+/* Parse a sysfs cpulist such as "0-3,8-11" into \a set. */
+static bool parse_cpu_list(const char* list, cpu_set_t* set) {
+  CPU_ZERO(set);
+  const char* p = list;
+  while (*p != '\0' && *p != '\n') {
+    char* end;
+    long first = strtol(p, &end, 10);
+    if (end == p || first < 0) return false;
+    long last = first;
+    p = end;
+    if (*p == '-') {
+      last = strtol(p + 1, &end, 10);
+      if (end == p + 1 || last < first) return false;
+      p = end;
+    }
+    for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+      CPU_SET(static_cast<int>(cpu), set);
+    }
+    if (*p == ',') p++;
+  }
+  return true;
+}
+
+static void init_numa_nodes() {
+  unsigned nodes = 0;
+  memset(numa_node_of_cpu, 0, sizeof(numa_node_of_cpu));
+  for (unsigned node = 0; node < MAX_NUMA_NODES; node++) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist",
+             node);
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) continue;
+    char list[4096];
+    bool parsed = fgets(list, sizeof(list), f) != nullptr &&
+                  parse_cpu_list(list, &numa_node_cpus[nodes]);
+    fclose(f);
+    if (!parsed) {
+      gpr_log(GPR_ERROR, "Cannot parse %s: ignoring NUMA topology", path);
+      nodes = 0;
+      break;
+    }
+    /* memory-only nodes have no CPUs to place threads on */
+    if (CPU_COUNT(&numa_node_cpus[nodes]) == 0) continue;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &numa_node_cpus[nodes])) {
+        numa_node_of_cpu[cpu] = static_cast<unsigned short>(nodes);
+      }
+    }
+    nodes++;
+  }
+  if (nodes == 0) {
+    /* no (usable) NUMA information: one node holding every CPU */
+    memset(numa_node_of_cpu, 0, sizeof(numa_node_of_cpu));
+    CPU_ZERO(&numa_node_cpus[0]);
+    for (unsigned cpu = 0; cpu < gpr_cpu_num_cores() && cpu < CPU_SETSIZE;
+         cpu++) {
+      CPU_SET(cpu, &numa_node_cpus[0]);
+    }
+    nodes = 1;
+  }
+  num_numa_nodes = nodes;
+}
+
+static gpr_once numa_once = GPR_ONCE_INIT;
+
+unsigned gpr_cpu_num_numa_nodes(void) {
+  gpr_once_init(&numa_once, init_numa_nodes);
+  return num_numa_nodes;
+}
+
+unsigned gpr_cpu_numa_node_of_cpu(unsigned cpu) {
+  gpr_once_init(&numa_once, init_numa_nodes);
+  return cpu < CPU_SETSIZE ? numa_node_of_cpu[cpu] : 0;
+}
+
+bool gpr_cpu_bind_current_thread_to_numa_node(unsigned node) {
+  if (node >= gpr_cpu_num_numa_nodes()) return false;
+  if (sched_setaffinity(0, sizeof(cpu_set_t), &numa_node_cpus[node]) != 0) {
+    gpr_log(GPR_ERROR, "Cannot bind thread to NUMA node %u: %s", node,
+            strerror(errno));
+    return false;
+  }
+  return true;
+}
+
 #endif /* GPR_CPU_LINUX */
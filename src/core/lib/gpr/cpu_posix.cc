@@ -29,6 +29,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gpr/cpu.h"
 #include "src/core/lib/gpr/useful.h"
 
 static long ncpus = 0;
@@ -80,4 +81,11 @@ unsigned gpr_cpu_current_cpu(void) {
   return (unsigned)GPR_HASH_POINTER(thread_id, gpr_cpu_num_cores());
 }
 
+unsigned gpr_cpu_num_numa_nodes(void) { return 1; }
+
+unsigned gpr_cpu_numa_node_of_cpu(unsigned cpu) { return 0; }
+
+/* there is no portable way to bind threads to CPUs */
+bool gpr_cpu_bind_current_thread_to_numa_node(unsigned node) { return false; }
+
 #endif /* GPR_CPU_POSIX */
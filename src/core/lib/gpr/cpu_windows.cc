@@ -22,6 +22,8 @@
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/cpu.h"
+
 unsigned gpr_cpu_num_cores(void) {
   SYSTEM_INFO si;
   GetSystemInfo(&si);
@@ -30,4 +32,12 @@ unsigned gpr_cpu_num_cores(void) {
 
 unsigned gpr_cpu_current_cpu(void) { return GetCurrentProcessorNumber(); }
 
+/* Windows processor groups are not mapped to NUMA nodes yet: report a single
+   node */
+unsigned gpr_cpu_num_numa_nodes(void) { return 1; }
+
+unsigned gpr_cpu_numa_node_of_cpu(unsigned cpu) { return 0; }
+
+bool gpr_cpu_bind_current_thread_to_numa_node(unsigned node) { return false; }
+
 #endif /* GPR_WINDOWS */
@@ -0,0 +1,234 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gpr/mu_contention.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_mu_contention_profiling, false,
+    "If set, record which locks are contended, in builds with "
+    "GPR_MU_CONTENTION_PROFILING defined, and log the most contended ones "
+    "at shutdown.");
+
+namespace {
+
+// Nothing here may take a gpr_mu, as it runs inside gpr_mu_lock().
+
+// A lock site; file and line if known, else just pc.
+struct Site {
+  gpr_atm file;
+  gpr_atm line;
+  gpr_atm pc;
+};
+
+// A contended lock, keyed by address. A lock destroyed and another created at
+// the same address share an entry.
+struct Entry {
+  gpr_atm mu;
+  gpr_atm contentions;
+  gpr_atm wait_ns;
+  gpr_atm max_wait_ns;
+  // The site that last acquired the lock.
+  Site holder;
+  // The site that was holding the lock the last time it was waited for, and
+  // the site that waited.
+  Site blocker;
+  Site waiter;
+};
+
+constexpr size_t kTableSize = 4096;
+constexpr size_t kMaxProbes = 16;
+
+Entry g_table[kTableSize];
+gpr_atm g_untracked_contentions;
+// 0 until the config has been read, then 1 if disabled and 2 if enabled.
+gpr_atm g_enabled;
+
+Entry* FindEntry(gpr_mu* mu, bool create) {
+  const gpr_atm key = reinterpret_cast<gpr_atm>(mu);
+  const size_t hash = static_cast<size_t>(key >> 4) ^
+                      static_cast<size_t>(key >> 16);
+  for (size_t i = 0; i < kMaxProbes; ++i) {
+    Entry* entry = &g_table[(hash + i) & (kTableSize - 1)];
+    gpr_atm current = gpr_atm_acq_load(&entry->mu);
+    if (current == key) return entry;
+    if (current != 0) continue;
+    if (!create) return nullptr;
+    if (gpr_atm_full_cas(&entry->mu, 0, key) ||
+        gpr_atm_acq_load(&entry->mu) == key) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+void StoreSite(Site* site, const char* file, int line, void* pc) {
+  gpr_atm_no_barrier_store(&site->file, reinterpret_cast<gpr_atm>(file));
+  gpr_atm_no_barrier_store(&site->line, static_cast<gpr_atm>(line));
+  gpr_atm_no_barrier_store(&site->pc, reinterpret_cast<gpr_atm>(pc));
+}
+
+void CopySite(Site* to, const Site* from) {
+  gpr_atm_no_barrier_store(&to->file, gpr_atm_no_barrier_load(&from->file));
+  gpr_atm_no_barrier_store(&to->line, gpr_atm_no_barrier_load(&from->line));
+  gpr_atm_no_barrier_store(&to->pc, gpr_atm_no_barrier_load(&from->pc));
+}
+
+char* FormatSite(const Site* site) {
+  const char* file =
+      reinterpret_cast<const char*>(gpr_atm_no_barrier_load(&site->file));
+  void* pc = reinterpret_cast<void*>(gpr_atm_no_barrier_load(&site->pc));
+  char* out;
+  if (file != nullptr) {
+    gpr_asprintf(&out, "%s:%d", file,
+                 static_cast<int>(gpr_atm_no_barrier_load(&site->line)));
+  } else if (pc != nullptr) {
+    gpr_asprintf(&out, "pc %p", pc);
+  } else {
+    out = gpr_strdup("unknown");
+  }
+  return out;
+}
+
+struct ReportEntry {
+  const Entry* entry;
+  gpr_atm wait_ns;
+};
+
+int CompareByWaitDescending(const void* a, const void* b) {
+  gpr_atm wait_a = static_cast<const ReportEntry*>(a)->wait_ns;
+  gpr_atm wait_b = static_cast<const ReportEntry*>(b)->wait_ns;
+  return wait_a < wait_b ? 1 : wait_a > wait_b ? -1 : 0;
+}
+
+}  // namespace
+
+bool gpr_mu_contention_profiling_enabled() {
+  gpr_atm enabled = gpr_atm_no_barrier_load(&g_enabled);
+  if (GPR_UNLIKELY(enabled == 0)) {
+    gpr_atm_no_barrier_cas(
+        &g_enabled, 0,
+        GPR_GLOBAL_CONFIG_GET(grpc_mu_contention_profiling) ? 2 : 1);
+    enabled = gpr_atm_no_barrier_load(&g_enabled);
+  }
+  return enabled == 2;
+}
+
+void gpr_mu_contention_profiling_enable(bool enable) {
+  gpr_atm_no_barrier_store(&g_enabled, enable ? 2 : 1);
+}
+
+void gpr_mu_contention_record_holder(gpr_mu* mu, const char* file, int line,
+                                     void* pc) {
+  Entry* entry = FindEntry(mu, false);
+  if (entry != nullptr) StoreSite(&entry->holder, file, line, pc);
+}
+
+void gpr_mu_contention_record_wait(gpr_mu* mu, int64_t wait_ns,
+                                   const char* file, int line, void* pc) {
+  Entry* entry = FindEntry(mu, true);
+  if (entry == nullptr) {
+    gpr_atm_no_barrier_fetch_add(&g_untracked_contentions, 1);
+    return;
+  }
+  gpr_atm_no_barrier_fetch_add(&entry->contentions, 1);
+  gpr_atm_no_barrier_fetch_add(&entry->wait_ns, static_cast<gpr_atm>(wait_ns));
+  gpr_atm max_wait_ns = gpr_atm_no_barrier_load(&entry->max_wait_ns);
+  while (wait_ns > max_wait_ns &&
+         !gpr_atm_no_barrier_cas(&entry->max_wait_ns, max_wait_ns,
+                                 static_cast<gpr_atm>(wait_ns))) {
+    max_wait_ns = gpr_atm_no_barrier_load(&entry->max_wait_ns);
+  }
+  // The holder site is still that of whoever we waited for.
+  CopySite(&entry->blocker, &entry->holder);
+  StoreSite(&entry->waiter, file, line, pc);
+}
+
+char* gpr_mu_contention_report(size_t max_locks) {
+  ReportEntry* entries =
+      static_cast<ReportEntry*>(gpr_malloc(sizeof(ReportEntry) * kTableSize));
+  size_t count = 0;
+  for (size_t i = 0; i < kTableSize; ++i) {
+    if (gpr_atm_acq_load(&g_table[i].mu) == 0) continue;
+    entries[count].entry = &g_table[i];
+    entries[count].wait_ns = gpr_atm_no_barrier_load(&g_table[i].wait_ns);
+    ++count;
+  }
+  qsort(entries, count, sizeof(*entries), CompareByWaitDescending);
+  gpr_strvec lines;
+  gpr_strvec_init(&lines);
+  char* line;
+  for (size_t i = 0; i < count && i < max_locks; ++i) {
+    const Entry* entry = entries[i].entry;
+    char* blocker = FormatSite(&entry->blocker);
+    char* waiter = FormatSite(&entry->waiter);
+    gpr_asprintf(
+        &line,
+        "gpr_mu %p: %" PRIdPTR " contentions, %.3fms waited, max %.3fms; "
+        "last held at %s while waited for at %s\n",
+        reinterpret_cast<void*>(gpr_atm_no_barrier_load(&entry->mu)),
+        gpr_atm_no_barrier_load(&entry->contentions), entries[i].wait_ns / 1e6,
+        gpr_atm_no_barrier_load(&entry->max_wait_ns) / 1e6, blocker, waiter);
+    gpr_strvec_add(&lines, line);
+    gpr_free(blocker);
+    gpr_free(waiter);
+  }
+  gpr_atm untracked = gpr_atm_no_barrier_load(&g_untracked_contentions);
+  if (untracked != 0) {
+    gpr_asprintf(&line, "%" PRIdPTR " contentions on untracked locks\n",
+                 untracked);
+    gpr_strvec_add(&lines, line);
+  }
+  char* report = gpr_strvec_flatten(&lines, nullptr);
+  gpr_strvec_destroy(&lines);
+  gpr_free(entries);
+  return report;
+}
+
+void gpr_mu_contention_dump(size_t max_locks) {
+  char* report = gpr_mu_contention_report(max_locks);
+  if (report[0] != '\0') {
+    gpr_log(GPR_INFO, "Most contended locks:\n%s", report);
+  }
+  gpr_free(report);
+}
+
+void gpr_mu_contention_reset() {
+  memset(g_table, 0, sizeof(g_table));
+  gpr_atm_no_barrier_store(&g_untracked_contentions, 0);
+}
+
+#if defined(GPR_MU_CONTENTION_PROFILING) && !defined(GPR_POSIX_SYNC)
+// Only the POSIX gpr_mu is instrumented.
+void gpr_mu_lock_at(gpr_mu* mu, const char* file, int line) {
+  gpr_mu_lock(mu);
+}
+#endif
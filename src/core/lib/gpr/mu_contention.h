@@ -0,0 +1,74 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPR_MU_CONTENTION_H
+#define GRPC_CORE_LIB_GPR_MU_CONTENTION_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <grpc/support/sync.h>
+
+/* Lock contention profiling for gpr_mu.
+
+   When gRPC is built with GPR_MU_CONTENTION_PROFILING defined and profiling
+   is turned on (with the GRPC_MU_CONTENTION_PROFILING environment variable or
+   gpr_mu_contention_profiling_enable()), every gpr_mu_lock() that finds the
+   lock held measures how long it waited, and charges it to that lock along
+   with the site that was holding it. Sites are file:line when the lock was
+   taken through grpc_core::MutexLock with a DebugLocation, and the caller's
+   return address otherwise. Without GPR_MU_CONTENTION_PROFILING, gpr_mu_lock()
+   is not instrumented at all.
+
+   Only contended locks are tracked, in a fixed size table; waits on locks
+   that do not fit are counted but not attributed. Waits inside gpr_cv_wait()
+   are not counted. Recording is lock-free, so the sites reported for a lock
+   are best effort when several threads contend for it at once. */
+
+/* Returns whether instrumented locks record contention. */
+bool gpr_mu_contention_profiling_enabled();
+void gpr_mu_contention_profiling_enable(bool enable);
+
+/* Called by instrumented locks once they hold mu: notes the site holding it,
+   if mu has been contended before. file is nullptr if only pc is known. */
+void gpr_mu_contention_record_holder(gpr_mu* mu, const char* file, int line,
+                                     void* pc);
+
+/* Called by instrumented locks that waited wait_ns for mu before acquiring it
+   at the given site. */
+void gpr_mu_contention_record_wait(gpr_mu* mu, int64_t wait_ns,
+                                   const char* file, int line, void* pc);
+
+/* Returns a report of the max_locks locks waited on longest in total, one
+   line each, to be freed with gpr_free(). */
+char* gpr_mu_contention_report(size_t max_locks);
+
+/* Logs gpr_mu_contention_report(max_locks), if anything was recorded. */
+void gpr_mu_contention_dump(size_t max_locks);
+
+/* Forgets everything recorded. Must not race with locking. */
+void gpr_mu_contention_reset();
+
+#ifdef GPR_MU_CONTENTION_PROFILING
+/* gpr_mu_lock(), recording file and line as the site taking the lock. */
+void gpr_mu_lock_at(gpr_mu* mu, const char* file, int line);
+#endif
+
+#endif /* GRPC_CORE_LIB_GPR_MU_CONTENTION_H */
@@ -27,6 +27,7 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 #include <time.h>
+#include "src/core/lib/gpr/mu_contention.h"
 #include "src/core/lib/profiling/timers.h"
 
 #ifdef GPR_LOW_LEVEL_COUNTERS
@@ -54,16 +55,65 @@ void gpr_mu_destroy(gpr_mu* mu) {
 #endif
 }
 
+static void mu_lock(gpr_mu* mu) {
+#ifdef GRPC_ASAN_ENABLED
+  GPR_ASSERT(pthread_mutex_lock(&mu->mutex) == 0);
+#else
+  GPR_ASSERT(pthread_mutex_lock(mu) == 0);
+#endif
+}
+
+static int mu_trylock(gpr_mu* mu) {
+  int err = 0;
+#ifdef GRPC_ASAN_ENABLED
+  err = pthread_mutex_trylock(&mu->mutex);
+#else
+  err = pthread_mutex_trylock(mu);
+#endif
+  GPR_ASSERT(err == 0 || err == EBUSY);
+  return err == 0;
+}
+
+#ifdef GPR_MU_CONTENTION_PROFILING
+/* Takes mu, recording how long it waited if it was held. */
+static void mu_lock_profiled(gpr_mu* mu, const char* file, int line,
+                             void* pc) {
+  if (!mu_trylock(mu)) {
+    gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+    mu_lock(mu);
+    gpr_timespec wait = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start);
+    gpr_mu_contention_record_wait(
+        mu, static_cast<int64_t>(wait.tv_sec) * GPR_NS_PER_SEC + wait.tv_nsec,
+        file, line, pc);
+  }
+  gpr_mu_contention_record_holder(mu, file, line, pc);
+}
+
+void gpr_mu_lock_at(gpr_mu* mu, const char* file, int line) {
+#ifdef GPR_LOW_LEVEL_COUNTERS
+  GPR_ATM_INC_COUNTER(gpr_mu_locks);
+#endif
+  GPR_TIMER_SCOPE("gpr_mu_lock", 0);
+  if (gpr_mu_contention_profiling_enabled()) {
+    mu_lock_profiled(mu, file, line, __builtin_return_address(0));
+  } else {
+    mu_lock(mu);
+  }
+}
+#endif /* GPR_MU_CONTENTION_PROFILING */
+
 void gpr_mu_lock(gpr_mu* mu) {
 #ifdef GPR_LOW_LEVEL_COUNTERS
   GPR_ATM_INC_COUNTER(gpr_mu_locks);
 #endif
   GPR_TIMER_SCOPE("gpr_mu_lock", 0);
-#ifdef GRPC_ASAN_ENABLED
-  GPR_ASSERT(pthread_mutex_lock(&mu->mutex) == 0);
-#else
-  GPR_ASSERT(pthread_mutex_lock(mu) == 0);
+#ifdef GPR_MU_CONTENTION_PROFILING
+  if (gpr_mu_contention_profiling_enabled()) {
+    mu_lock_profiled(mu, nullptr, 0, __builtin_return_address(0));
+    return;
+  }
 #endif
+  mu_lock(mu);
 }
 
 void gpr_mu_unlock(gpr_mu* mu) {
@@ -77,14 +127,15 @@ void gpr_mu_unlock(gpr_mu* mu) {
 
 int gpr_mu_trylock(gpr_mu* mu) {
   GPR_TIMER_SCOPE("gpr_mu_trylock", 0);
-  int err = 0;
-#ifdef GRPC_ASAN_ENABLED
-  err = pthread_mutex_trylock(&mu->mutex);
-#else
-  err = pthread_mutex_trylock(mu);
+#ifdef GPR_MU_CONTENTION_PROFILING
+  if (gpr_mu_contention_profiling_enabled()) {
+    if (!mu_trylock(mu)) return 0;
+    gpr_mu_contention_record_holder(mu, nullptr, 0,
+                                    __builtin_return_address(0));
+    return 1;
+  }
 #endif
-  GPR_ASSERT(err == 0 || err == EBUSY);
-  return err == 0;
+  return mu_trylock(mu);
 }
 
 /*----------------------------------------*/
@@ -20,9 +20,14 @@
 
 #if GPR_LINUX
 #include <fcntl.h>
+#include <string.h>
 #include <unistd.h>
 #endif
 
+#if GPR_CYCLE_COUNTER_RDTSC_64
+#include <cpuid.h>
+#endif
+
 #include <algorithm>
 
 #include <grpc/impl/codegen/gpr_types.h>
@@ -30,6 +35,14 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_tsc_calibration, false,
+    "If set, on x86-64 Linux where the TSC is a stable clock but the kernel "
+    "does not export its frequency, measure the frequency when gRPC starts, "
+    "which takes up to 255ms, so that the TSC can be the cycle counter. "
+    "Otherwise the monotonic clock is used there.");
 
 #if GPR_CYCLE_COUNTER_RDTSC_32 or GPR_CYCLE_COUNTER_RDTSC_64
 #if GPR_LINUX
@@ -58,6 +71,46 @@ static bool read_freq_from_kernel(double* freq) {
 static double cycles_per_second = 0;
 static gpr_cycle_counter start_cycle;
 
+#if GPR_CYCLE_COUNTER_RDTSC_64
+bool gpr_cycle_counter_is_tsc = false;
+
+gpr_cycle_counter gpr_get_cycle_counter_fallback() {
+  gpr_timespec ts = gpr_now(GPR_CLOCK_MONOTONIC);
+  return ts.tv_sec * GPR_NS_PER_SEC + ts.tv_nsec;
+}
+
+// The TSC is a clock only if it ticks at a constant rate across frequency
+// and sleep state changes (invariant TSC: CPUID 0x80000007, EDX bit 8) and,
+// on Linux, if the kernel also chose it as its clocksource, which it only
+// does once it found the TSCs of all CPUs to be in sync.
+static bool is_tsc_stable() {
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 ||
+      eax < 0x80000007) {
+    return false;
+  }
+  __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+  if ((edx & (1u << 8)) == 0) {
+    return false;
+  }
+#if GPR_LINUX
+  int fd = open("/sys/devices/system/clocksource/clocksource0/"
+                "current_clocksource",
+                O_RDONLY);
+  if (fd == -1) {
+    return false;
+  }
+  char line[64] = {};
+  int len = read(fd, line, sizeof(line) - 1);
+  close(fd);
+  if (len <= 0 || strcmp(line, "tsc\n") != 0) {
+    return false;
+  }
+#endif /* GPR_LINUX */
+  return true;
+}
+#endif /* GPR_CYCLE_COUNTER_RDTSC_64 */
+
 static bool is_fake_clock() {
   gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
   int64_t sum = 0;
@@ -70,15 +123,42 @@ static bool is_fake_clock() {
   return sum == 0;
 }
 
+#if GPR_CYCLE_COUNTER_RDTSC_64
+static void use_monotonic_clock(const char* reason) {
+  gpr_log(GPR_DEBUG, "%s, using the monotonic clock", reason);
+  gpr_cycle_counter_is_tsc = false;
+  cycles_per_second = GPR_NS_PER_SEC;
+  start_cycle = gpr_get_cycle_counter();
+}
+#endif /* GPR_CYCLE_COUNTER_RDTSC_64 */
+
 void gpr_precise_clock_init(void) {
+#if GPR_CYCLE_COUNTER_RDTSC_64
+  if (is_fake_clock() || !is_tsc_stable()) {
+    use_monotonic_clock("TSC is not a stable clock");
+    return;
+  }
+  if (read_freq_from_kernel(&cycles_per_second)) {
+    gpr_cycle_counter_is_tsc = true;
+    start_cycle = gpr_get_cycle_counter();
+    return;
+  }
+  // Measuring the frequency busy-waits, so it is only done on request.
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_tsc_calibration)) {
+    use_monotonic_clock("TSC frequency is unknown");
+    return;
+  }
+  gpr_cycle_counter_is_tsc = true;
+#endif /* GPR_CYCLE_COUNTER_RDTSC_64 */
+
   gpr_log(GPR_DEBUG, "Calibrating timers");
 
-#if GPR_LINUX
+#if GPR_LINUX && !GPR_CYCLE_COUNTER_RDTSC_64
   if (read_freq_from_kernel(&cycles_per_second)) {
     start_cycle = gpr_get_cycle_counter();
     return;
   }
-#endif /* GPR_LINUX */
+#endif /* GPR_LINUX && !GPR_CYCLE_COUNTER_RDTSC_64 */
 
   if (is_fake_clock()) {
     cycles_per_second = 1;
@@ -126,6 +206,8 @@ void gpr_precise_clock_now(gpr_timespec* clk) {
   int64_t counter = gpr_get_cycle_counter();
   *clk = gpr_cycle_counter_to_time(counter);
 }
+
+double gpr_cycles_per_second(void) { return cycles_per_second; }
 #elif GPR_CYCLE_COUNTER_FALLBACK
 void gpr_precise_clock_init(void) {}
 
@@ -146,4 +228,6 @@ void gpr_precise_clock_now(gpr_timespec* clk) {
   *clk = gpr_now(GPR_CLOCK_REALTIME);
   clk->clock_type = GPR_CLOCK_PRECISE;
 }
+
+double gpr_cycles_per_second(void) { return GPR_US_PER_SEC; }
 #endif /* GPR_CYCLE_COUNTER_FALLBACK */
@@ -24,6 +24,12 @@
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gprpp/global_config.h"
+
+// Whether the TSC may have its frequency measured at startup, where it would
+// otherwise not be used for lack of one (see time_precise.cc).
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_tsc_calibration);
+
 // Depending on the platform gpr_get_cycle_counter() can have a resolution as
 // low as a usec. Use other clock sources or gpr_precise_clock_now(),
 // where you need high resolution clocks.
@@ -40,7 +46,14 @@ inline gpr_cycle_counter gpr_get_cycle_counter() {
 }
 #elif GPR_CYCLE_COUNTER_RDTSC_64
 typedef int64_t gpr_cycle_counter;
+// Set by gpr_precise_clock_init() if the TSC is a stable clock. Until then,
+// and otherwise, cycles are nanoseconds of the monotonic clock.
+extern bool gpr_cycle_counter_is_tsc;
+gpr_cycle_counter gpr_get_cycle_counter_fallback();
 inline gpr_cycle_counter gpr_get_cycle_counter() {
+  if (GPR_UNLIKELY(!gpr_cycle_counter_is_tsc)) {
+    return gpr_get_cycle_counter_fallback();
+  }
   uint64_t low, high;
   __asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
   return (high << 32) | low;
@@ -61,5 +74,10 @@ gpr_cycle_counter gpr_get_cycle_counter();
 void gpr_precise_clock_init(void);
 void gpr_precise_clock_now(gpr_timespec* clk);
 gpr_timespec gpr_cycle_counter_to_time(gpr_cycle_counter cycles);
+// Returns how many gpr_get_cycle_counter() ticks make a second.
+double gpr_cycles_per_second(void);
+
+// Returns false if gpr_now() has been replaced, e.g. by a test's fake clock.
+bool gpr_now_is_system_clock(void);
 
 #endif /* GRPC_CORE_LIB_GPR_TIME_PRECISE_H */
@@ -0,0 +1,110 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gpr/wyhash.h"
+
+#include <string.h>
+
+namespace {
+
+constexpr uint64_t kSecret0 = 0xa0761d6478bd642full;
+constexpr uint64_t kSecret1 = 0xe7037ed1a0b428dbull;
+constexpr uint64_t kSecret2 = 0x8ebc6af09c88c6e3ull;
+constexpr uint64_t kSecret3 = 0x589965cc75374cc3ull;
+
+// The 128 bit product of a and b, folded to 64 bits.
+inline uint64_t Mix(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = static_cast<__uint128_t>(a) * b;
+  return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+  const uint64_t ha = a >> 32, hb = b >> 32;
+  const uint64_t la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+  const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  const uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  const uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  return lo ^ hi;
+#endif
+}
+
+inline uint64_t Read8(const uint8_t* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t Read4(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// Reads 1 to 3 bytes.
+inline uint64_t Read3(const uint8_t* p, size_t k) {
+  return (static_cast<uint64_t>(p[0]) << 16) |
+         (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+}  // namespace
+
+uint32_t gpr_wyhash(const void* key, size_t len, uint32_t seed) {
+  const uint8_t* p = static_cast<const uint8_t*>(key);
+  uint64_t s = seed ^ kSecret0;
+  uint64_t a, b;
+  if (GPR_LIKELY(len <= 16)) {
+    if (GPR_LIKELY(len >= 4)) {
+      // Two possibly overlapping 4 byte reads from each end.
+      const size_t mid = (len >> 3) << 2;
+      a = (Read4(p) << 32) | Read4(p + mid);
+      b = (Read4(p + len - 4) << 32) | Read4(p + len - 4 - mid);
+    } else if (GPR_LIKELY(len > 0)) {
+      a = Read3(p, len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = len;
+    if (GPR_UNLIKELY(i > 48)) {
+      uint64_t s1 = s, s2 = s;
+      do {
+        s = Mix(Read8(p) ^ kSecret1, Read8(p + 8) ^ s);
+        s1 = Mix(Read8(p + 16) ^ kSecret2, Read8(p + 24) ^ s1);
+        s2 = Mix(Read8(p + 32) ^ kSecret3, Read8(p + 40) ^ s2);
+        p += 48;
+        i -= 48;
+      } while (GPR_LIKELY(i > 48));
+      s ^= s1 ^ s2;
+    }
+    while (GPR_UNLIKELY(i > 16)) {
+      s = Mix(Read8(p) ^ kSecret1, Read8(p + 8) ^ s);
+      p += 16;
+      i -= 16;
+    }
+    // The last 16 bytes, overlapping what was already mixed in.
+    a = Read8(p + i - 16);
+    b = Read8(p + i - 8);
+  }
+  const uint64_t h = Mix(kSecret1 ^ len, Mix(a ^ kSecret1, b ^ s));
+  return static_cast<uint32_t>(h) ^ static_cast<uint32_t>(h >> 32);
+}
@@ -0,0 +1,34 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPR_WYHASH_H
+#define GRPC_CORE_LIB_GPR_WYHASH_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* compute the hash of key (length len), with a wyhash style function: it
+   reads 8 bytes at a time and mixes them with 64x64->128 bit multiplies, which
+   makes it about twice as fast as gpr_murmur_hash3 on strings longer than 16
+   bytes, such as method paths, and as fast on shorter ones. Values depend on
+   the byte order of the host, so they must not be persisted or sent. */
+uint32_t gpr_wyhash(const void* key, size_t len, uint32_t seed);
+
+#endif /* GRPC_CORE_LIB_GPR_WYHASH_H */
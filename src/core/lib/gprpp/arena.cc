@@ -43,7 +43,8 @@ void* ArenaStorage(size_t initial_size) {
        GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
           ? GPR_CACHELINE_SIZE
           : GPR_MAX_ALIGNMENT;
-  return gpr_malloc_aligned(alloc_size, alignment);
+  return gpr_subsystem_malloc_aligned(GPR_ALLOC_SUBSYSTEM_ARENAS, alloc_size,
+                                      alignment);
 }
 
 }  // namespace
@@ -55,7 +56,7 @@ Arena::~Arena() {
   while (z) {
     Zone* prev_z = z->prev;
     z->~Zone();
-    gpr_free_aligned(z);
+    gpr_subsystem_free_aligned(GPR_ALLOC_SUBSYSTEM_ARENAS, z);
     z = prev_z;
   }
 }
@@ -77,7 +78,7 @@ Pair<Arena*, void*> Arena::CreateWithAlloc(size_t initial_size,
 size_t Arena::Destroy() {
   size_t size = total_used_.Load(MemoryOrder::RELAXED);
   this->~Arena();
-  gpr_free_aligned(this);
+  gpr_subsystem_free_aligned(GPR_ALLOC_SUBSYSTEM_ARENAS, this);
   return size;
 }
 
@@ -90,7 +91,8 @@ void* Arena::AllocZone(size_t size) {
   static constexpr size_t zone_base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Zone));
   size_t alloc_size = zone_base_size + size;
-  Zone* z = new (gpr_malloc_aligned(alloc_size, GPR_MAX_ALIGNMENT)) Zone();
+  Zone* z = new (gpr_subsystem_malloc_aligned(
+      GPR_ALLOC_SUBSYSTEM_ARENAS, alloc_size, GPR_MAX_ALIGNMENT)) Zone();
   {
     gpr_spinlock_lock(&arena_growth_spinlock_);
     z->prev = last_zone_;
@@ -100,4 +102,74 @@ void* Arena::AllocZone(size_t size) {
   return reinterpret_cast<char*>(z) + zone_base_size;
 }
 
+constexpr size_t ArenaPool::kDefaultMaxFreeArenas;
+
+ArenaPool::~ArenaPool() {
+  while (free_list_ != nullptr) {
+    FreeArena* next = free_list_->next;
+    gpr_subsystem_free_aligned(GPR_ALLOC_SUBSYSTEM_ARENAS, free_list_);
+    free_list_ = next;
+  }
+}
+
+void* ArenaPool::TakeStorage(size_t* initial_size) {
+  *initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(*initial_size);
+  gpr_spinlock_lock(&lock_);
+  FreeArena* f = free_list_;
+  if (f != nullptr) {
+    free_list_ = f->next;
+    num_free_arenas_--;
+  }
+  gpr_spinlock_unlock(&lock_);
+  if (f != nullptr) {
+    // Reuse the storage unless the size estimate has since moved past it:
+    // too small to hold the arena we want, or so large it mostly idles.
+    if (f->initial_zone_size >= *initial_size &&
+        f->initial_zone_size <= 2 * *initial_size) {
+      *initial_size = f->initial_zone_size;
+      return f;
+    }
+    gpr_subsystem_free_aligned(GPR_ALLOC_SUBSYSTEM_ARENAS, f);
+  }
+  return ArenaStorage(*initial_size);
+}
+
+Arena* ArenaPool::Create(size_t initial_size) {
+  void* storage = TakeStorage(&initial_size);
+  return new (storage) Arena(initial_size);
+}
+
+Pair<Arena*, void*> ArenaPool::CreateWithAlloc(size_t initial_size,
+                                               size_t alloc_size) {
+  static constexpr size_t base_size =
+      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
+  void* storage = TakeStorage(&initial_size);
+  auto* new_arena = new (storage) Arena(initial_size, alloc_size);
+  void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
+  return MakePair(new_arena, first_alloc);
+}
+
+size_t ArenaPool::Release(Arena* arena) {
+  size_t size = arena->total_used_.Load(MemoryOrder::RELAXED);
+  size_t initial_zone_size = arena->initial_zone_size_;
+  arena->~Arena();
+  // An arena that overflowed its initial zone is too small for the sizes
+  // being learned; let it go rather than hand it out again.
+  if (size <= initial_zone_size) {
+    gpr_spinlock_lock(&lock_);
+    if (num_free_arenas_ < max_free_arenas_) {
+      FreeArena* f = new (arena) FreeArena;
+      f->next = free_list_;
+      f->initial_zone_size = initial_zone_size;
+      free_list_ = f;
+      num_free_arenas_++;
+      gpr_spinlock_unlock(&lock_);
+      return size;
+    }
+    gpr_spinlock_unlock(&lock_);
+  }
+  gpr_subsystem_free_aligned(GPR_ALLOC_SUBSYSTEM_ARENAS, arena);
+  return size;
+}
+
 }  // namespace grpc_core
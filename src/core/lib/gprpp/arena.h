@@ -80,6 +80,8 @@ class Arena {
   }
 
  private:
+  friend class ArenaPool;
+
   struct Zone {
     Zone* prev;
   };
@@ -116,6 +118,51 @@ class Arena {
   Zone* last_zone_ = nullptr;
 };
 
+// A freelist of arena storage, so that short lived arenas of a similar size
+// (typically one per call on a channel) can be created without going to the
+// allocator. Arenas created by a pool must be returned to it with Release()
+// rather than destroyed, and the pool must outlive them.
+class ArenaPool {
+ public:
+  static constexpr size_t kDefaultMaxFreeArenas = 16;
+
+  // Keep at most \a max_free_arenas unused arenas around; zero disables
+  // caching entirely.
+  explicit ArenaPool(size_t max_free_arenas = kDefaultMaxFreeArenas)
+      : max_free_arenas_(max_free_arenas) {}
+  ~ArenaPool();
+
+  ArenaPool(const ArenaPool&) = delete;
+  ArenaPool& operator=(const ArenaPool&) = delete;
+
+  // Same as Arena::Create(), but reuses a released arena when one with a
+  // large enough initial zone is available.
+  Arena* Create(size_t initial_size);
+  // Same as Arena::CreateWithAlloc(), but reuses a released arena when one with
+  // a large enough initial zone is available.
+  Pair<Arena*, void*> CreateWithAlloc(size_t initial_size, size_t alloc_size);
+
+  // Destroy an arena created by this pool, keeping its initial zone for reuse,
+  // and return the total number of bytes allocated.
+  size_t Release(Arena* arena);
+
+ private:
+  // Overlays the storage of a released arena.
+  struct FreeArena {
+    FreeArena* next;
+    size_t initial_zone_size;
+  };
+
+  // Returns storage for an arena with an initial zone of at least
+  // *initial_size bytes, updating *initial_size to the actual zone size.
+  void* TakeStorage(size_t* initial_size);
+
+  const size_t max_free_arenas_;
+  gpr_spinlock lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
+  FreeArena* free_list_ = nullptr;
+  size_t num_free_arenas_ = 0;
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_GPRPP_ARENA_H */
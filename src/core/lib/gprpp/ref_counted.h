@@ -208,6 +208,87 @@ class RefCount {
   Atomic<Value> value_;
 };
 
+// NonAtomicRefCount has the interface of RefCount but plain, non-atomic
+// updates. Only use it for objects that are never reffed or unreffed
+// concurrently, e.g. ones only ever touched under the same combiner or
+// mutex; everything else needs RefCount.
+class NonAtomicRefCount {
+ public:
+  using Value = intptr_t;
+
+  template <typename TraceFlagT = TraceFlag>
+  constexpr explicit NonAtomicRefCount(Value init = 1,
+                                       TraceFlagT* trace_flag = nullptr)
+      :
+#ifndef NDEBUG
+        trace_flag_(trace_flag),
+#endif
+        value_(init) {
+  }
+
+  void Ref(Value n = 1) {
+    Trace("ref", nullptr, nullptr, n);
+    value_ += n;
+  }
+  void Ref(const DebugLocation& location, const char* reason, Value n = 1) {
+    Trace("ref", &location, reason, n);
+    value_ += n;
+  }
+
+  void RefNonZero() {
+    assert(value_ > 0);
+    Ref();
+  }
+  void RefNonZero(const DebugLocation& location, const char* reason) {
+    assert(value_ > 0);
+    Ref(location, reason);
+  }
+
+  bool RefIfNonZero() {
+    if (value_ == 0) return false;
+    Ref();
+    return true;
+  }
+  bool RefIfNonZero(const DebugLocation& location, const char* reason) {
+    if (value_ == 0) return false;
+    Ref(location, reason);
+    return true;
+  }
+
+  // Decrements the ref-count and returns true if the ref-count reaches 0.
+  bool Unref() {
+    Trace("unref", nullptr, nullptr, -1);
+    GPR_DEBUG_ASSERT(value_ > 0);
+    return --value_ == 0;
+  }
+  bool Unref(const DebugLocation& location, const char* reason) {
+    Trace("unref", &location, reason, -1);
+    GPR_DEBUG_ASSERT(value_ > 0);
+    return --value_ == 0;
+  }
+
+ private:
+  void Trace(const char* op, const DebugLocation* location, const char* reason,
+             Value delta) {
+#ifndef NDEBUG
+    if (trace_flag_ == nullptr || !trace_flag_->enabled()) return;
+    if (location == nullptr) {
+      gpr_log(GPR_INFO, "%s:%p %s %" PRIdPTR " -> %" PRIdPTR,
+              trace_flag_->name(), this, op, value_, value_ + delta);
+    } else {
+      gpr_log(GPR_INFO, "%s:%p %s:%d %s %" PRIdPTR " -> %" PRIdPTR " %s",
+              trace_flag_->name(), this, location->file(), location->line(),
+              op, value_, value_ + delta, reason);
+    }
+#endif
+  }
+
+#ifndef NDEBUG
+  TraceFlag* trace_flag_;
+#endif
+  Value value_;
+};
+
 // A base class for reference-counted objects.
 // New objects should be created via New() and start with a refcount of 1.
 // When the refcount reaches 0, the object will be deleted via Delete().
@@ -218,6 +299,10 @@ class RefCount {
 // Use PolymorphicRefCount and NonPolymorphicRefCount to select between
 // different implementations of RefCounted.
 //
+// RefCountT selects the ref-count itself: RefCount by default, or
+// NonAtomicRefCount for objects that are never reffed or unreffed
+// concurrently, saving the atomic instructions.
+//
 // Note that NonPolymorphicRefCount does not support polymorphic destruction.
 // So, use NonPolymorphicRefCount only when both of the following conditions
 // are guaranteed to hold:
@@ -234,7 +319,8 @@ class RefCount {
 //    Child* ch;
 //    ch->Unref();
 //
-template <typename Child, typename Impl = PolymorphicRefCount>
+template <typename Child, typename Impl = PolymorphicRefCount,
+          typename RefCountT = RefCount>
 class RefCounted : public Impl {
  public:
   RefCountedPtr<Child> Ref() GRPC_MUST_USE_RESULT {
@@ -298,7 +384,7 @@ class RefCounted : public Impl {
     refs_.Ref(location, reason);
   }
 
-  RefCount refs_;
+  RefCountT refs_;
 };
 
 }  // namespace grpc_core
@@ -26,6 +26,11 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gprpp/debug_location.h"
+#ifdef GPR_MU_CONTENTION_PROFILING
+#include "src/core/lib/gpr/mu_contention.h"
+#endif
+
 // The core library is not accessible in C++ codegen headers, and vice versa.
 // Thus, we need to have duplicate headers with similar functionality.
 // Make sure any change to this file is also reflected in
@@ -52,11 +57,28 @@ class Mutex {
   gpr_mu mu_;
 };
 
+// Takes mu for the caller at location, which is the site lock contention
+// profiling charges (see src/core/lib/gpr/mu_contention.h). The same as
+// gpr_mu_lock() when that is not compiled in.
+inline void MutexLockAt(gpr_mu* mu, const DebugLocation& location) {
+#ifdef GPR_MU_CONTENTION_PROFILING
+  gpr_mu_lock_at(mu, location.file(), location.line());
+#else
+  gpr_mu_lock(mu);
+#endif
+}
+
 // MutexLock is a std::
 class MutexLock {
  public:
   explicit MutexLock(Mutex* mu) : mu_(mu->get()) { gpr_mu_lock(mu_); }
   explicit MutexLock(gpr_mu* mu) : mu_(mu) { gpr_mu_lock(mu_); }
+  MutexLock(Mutex* mu, const DebugLocation& location) : mu_(mu->get()) {
+    MutexLockAt(mu_, location);
+  }
+  MutexLock(gpr_mu* mu, const DebugLocation& location) : mu_(mu) {
+    MutexLockAt(mu_, location);
+  }
   ~MutexLock() { gpr_mu_unlock(mu_); }
 
   MutexLock(const MutexLock&) = delete;
@@ -70,6 +92,10 @@ class ReleasableMutexLock {
  public:
   explicit ReleasableMutexLock(Mutex* mu) : mu_(mu->get()) { gpr_mu_lock(mu_); }
   explicit ReleasableMutexLock(gpr_mu* mu) : mu_(mu) { gpr_mu_lock(mu_); }
+  ReleasableMutexLock(Mutex* mu, const DebugLocation& location)
+      : mu_(mu->get()) {
+    MutexLockAt(mu_, location);
+  }
   ~ReleasableMutexLock() {
     if (!released_) gpr_mu_unlock(mu_);
   }
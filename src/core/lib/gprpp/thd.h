@@ -49,7 +49,8 @@ class Thread {
  public:
   class Options {
    public:
-    Options() : joinable_(true), tracked_(true), stack_size_(0) {}
+    Options()
+        : joinable_(true), tracked_(true), stack_size_(0), numa_node_(-1) {}
     /// Set whether the thread is joinable or detached.
     Options& set_joinable(bool joinable) {
       joinable_ = joinable;
@@ -72,10 +73,20 @@ class Thread {
     }
     size_t stack_size() const { return stack_size_; }
 
+    /// Restricts the thread to the CPUs of NUMA node \a node (see
+    /// gpr_cpu_num_numa_nodes()). Sets to -1 (the default) to let the thread
+    /// run anywhere. Ignored on platforms that cannot bind threads.
+    Options& set_numa_node(int node) {
+      numa_node_ = node;
+      return *this;
+    }
+    int numa_node() const { return numa_node_; }
+
    private:
     bool joinable_;
     bool tracked_;
     size_t stack_size_;
+    int numa_node_;
   };
   /// Default constructor only to allow use in structs that lack constructors
   /// Does not produce a validly-constructed thread; must later
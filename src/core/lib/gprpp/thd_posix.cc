@@ -33,6 +33,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include "src/core/lib/gpr/cpu.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/fork.h"
 #include "src/core/lib/gprpp/memory.h"
@@ -47,6 +48,7 @@ struct thd_arg {
   const char* name;        /* name of thread. Can be nullptr. */
   bool joinable;
   bool tracked;
+  int numa_node; /* NUMA node to bind the thread to, or -1 */
 };
 
 size_t RoundUpToPageSize(size_t size) {
@@ -86,6 +88,7 @@ class ThreadInternalsPosix : public internal::ThreadInternalsInterface {
     info->name = thd_name;
     info->joinable = options.joinable();
     info->tracked = options.tracked();
+    info->numa_node = options.numa_node();
     if (options.tracked()) {
       Fork::IncThreadCount();
     }
@@ -124,6 +127,10 @@ class ThreadInternalsPosix : public internal::ThreadInternalsInterface {
                             pthread_setname_np(pthread_self(), buf);
 #endif  // GPR_APPLE_PTHREAD_NAME
                           }
+                          if (arg.numa_node >= 0) {
+                            gpr_cpu_bind_current_thread_to_numa_node(
+                                static_cast<unsigned>(arg.numa_node));
+                          }
 
                           gpr_mu_lock(&arg.thread->mu_);
                           while (!arg.thread->started_) {
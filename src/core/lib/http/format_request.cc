@@ -30,7 +30,7 @@
 #include "src/core/lib/gpr/string.h"
 
 static void fill_common_header(const grpc_httpcli_request* request,
-                               gpr_strvec* buf, bool connection_close) {
+                               gpr_strvec* buf, const char* connection) {
   size_t i;
   gpr_strvec_add(buf, gpr_strdup(request->http.path));
   gpr_strvec_add(buf, gpr_strdup(" HTTP/1.0\r\n"));
@@ -38,8 +38,11 @@ static void fill_common_header(const grpc_httpcli_request* request,
   gpr_strvec_add(buf, gpr_strdup("Host: "));
   gpr_strvec_add(buf, gpr_strdup(request->host));
   gpr_strvec_add(buf, gpr_strdup("\r\n"));
-  if (connection_close)
-    gpr_strvec_add(buf, gpr_strdup("Connection: close\r\n"));
+  if (connection != nullptr) {
+    gpr_strvec_add(buf, gpr_strdup("Connection: "));
+    gpr_strvec_add(buf, gpr_strdup(connection));
+    gpr_strvec_add(buf, gpr_strdup("\r\n"));
+  }
   gpr_strvec_add(buf,
                  gpr_strdup("User-Agent: " GRPC_HTTPCLI_USER_AGENT "\r\n"));
   /* user supplied headers */
@@ -59,7 +62,8 @@ grpc_slice grpc_httpcli_format_get_request(
 
   gpr_strvec_init(&out);
   gpr_strvec_add(&out, gpr_strdup("GET "));
-  fill_common_header(request, &out, true);
+  fill_common_header(request, &out,
+                     request->keep_alive ? "keep-alive" : "close");
   gpr_strvec_add(&out, gpr_strdup("\r\n"));
 
   flat = gpr_strvec_flatten(&out, &flat_len);
@@ -79,7 +83,8 @@ grpc_slice grpc_httpcli_format_post_request(const grpc_httpcli_request* request,
   gpr_strvec_init(&out);
 
   gpr_strvec_add(&out, gpr_strdup("POST "));
-  fill_common_header(request, &out, true);
+  fill_common_header(request, &out,
+                     request->keep_alive ? "keep-alive" : "close");
   if (body_bytes) {
     uint8_t has_content_type = 0;
     for (i = 0; i < request->http.hdr_count; i++) {
@@ -113,7 +118,7 @@ grpc_slice grpc_httpcli_format_connect_request(
   gpr_strvec out;
   gpr_strvec_init(&out);
   gpr_strvec_add(&out, gpr_strdup("CONNECT "));
-  fill_common_header(request, &out, false);
+  fill_common_header(request, &out, nullptr);
   gpr_strvec_add(&out, gpr_strdup("\r\n"));
   size_t flat_len;
   char* flat = gpr_strvec_flatten(&out, &flat_len);
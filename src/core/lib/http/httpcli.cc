@@ -25,6 +25,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/string.h"
@@ -38,6 +39,12 @@
 #include "src/core/lib/iomgr/tcp_client.h"
 #include "src/core/lib/slice/slice_internal.h"
 
+/* most idle keep-alive connections kept around, across all hosts */
+#define GRPC_HTTPCLI_MAX_IDLE_CONNECTIONS 4
+/* idle keep-alive connections older than this are closed rather than reused,
+   well before servers usually time them out */
+#define GRPC_HTTPCLI_IDLE_TIMEOUT_MS (30 * GPR_MS_PER_SEC)
+
 typedef struct {
   grpc_slice request_text;
   grpc_http_parser parser;
@@ -60,8 +67,101 @@ typedef struct {
   grpc_closure connected;
   grpc_error* overall_error;
   grpc_resource_quota* resource_quota;
+  /* set for keep-alive requests: identifies the connections they may share */
+  char* pool_key;
+  /* ep was taken from the idle pool rather than freshly connected */
+  bool reused;
+  /* ep has been added to context->pollset_set */
+  bool ep_in_pollset_set;
 } internal_request;
 
+/* A keep-alive connection waiting for the next request to the same host. */
+typedef struct idle_connection {
+  char* pool_key;
+  grpc_endpoint* ep;
+  grpc_millis idle_since;
+  struct idle_connection* next;
+} idle_connection;
+
+static gpr_once g_idle_once = GPR_ONCE_INIT;
+static gpr_mu g_idle_mu;
+static idle_connection* g_idle_connections = nullptr;
+static size_t g_num_idle_connections = 0;
+
+static void init_idle_connections(void) { gpr_mu_init(&g_idle_mu); }
+
+static void destroy_idle_connections(idle_connection* conn) {
+  while (conn != nullptr) {
+    idle_connection* next = conn->next;
+    grpc_endpoint_destroy(conn->ep);
+    gpr_free(conn->pool_key);
+    gpr_free(conn);
+    conn = next;
+  }
+}
+
+/* Takes an idle connection for pool_key, or returns nullptr. Connections
+   that have been idle for too long are closed on the way. */
+static grpc_endpoint* take_idle_connection(const char* pool_key) {
+  gpr_once_init(&g_idle_once, init_idle_connections);
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_endpoint* ep = nullptr;
+  idle_connection* expired = nullptr;
+  gpr_mu_lock(&g_idle_mu);
+  idle_connection** link = &g_idle_connections;
+  while (*link != nullptr) {
+    idle_connection* conn = *link;
+    bool is_expired = now - conn->idle_since > GRPC_HTTPCLI_IDLE_TIMEOUT_MS;
+    if (is_expired || (ep == nullptr && strcmp(conn->pool_key, pool_key) == 0)) {
+      *link = conn->next;
+      --g_num_idle_connections;
+      if (is_expired) {
+        conn->next = expired;
+        expired = conn;
+      } else {
+        ep = conn->ep;
+        gpr_free(conn->pool_key);
+        gpr_free(conn);
+      }
+    } else {
+      link = &conn->next;
+    }
+  }
+  gpr_mu_unlock(&g_idle_mu);
+  destroy_idle_connections(expired);
+  return ep;
+}
+
+/* Keeps ep for a later request to pool_key, or closes it if the pool is
+   full. Takes ownership of ep. */
+static void put_idle_connection(const char* pool_key, grpc_endpoint* ep) {
+  gpr_once_init(&g_idle_once, init_idle_connections);
+  gpr_mu_lock(&g_idle_mu);
+  if (g_num_idle_connections < GRPC_HTTPCLI_MAX_IDLE_CONNECTIONS) {
+    idle_connection* conn =
+        static_cast<idle_connection*>(gpr_malloc(sizeof(*conn)));
+    conn->pool_key = gpr_strdup(pool_key);
+    conn->ep = ep;
+    conn->idle_since = grpc_core::ExecCtx::Get()->Now();
+    conn->next = g_idle_connections;
+    g_idle_connections = conn;
+    ++g_num_idle_connections;
+    ep = nullptr;
+  }
+  gpr_mu_unlock(&g_idle_mu);
+  if (ep != nullptr) grpc_endpoint_destroy(ep);
+}
+
+void grpc_httpcli_shutdown(void) {
+  gpr_once_init(&g_idle_once, init_idle_connections);
+  gpr_mu_lock(&g_idle_mu);
+  idle_connection* conns = g_idle_connections;
+  g_idle_connections = nullptr;
+  g_num_idle_connections = 0;
+  gpr_mu_unlock(&g_idle_mu);
+  destroy_idle_connections(conns);
+}
+
 static grpc_httpcli_get_override g_get_override = nullptr;
 static grpc_httpcli_post_override g_post_override = nullptr;
 
@@ -84,6 +184,18 @@ void grpc_httpcli_context_destroy(grpc_httpcli_context* context) {
 }
 
 static void next_address(internal_request* req, grpc_error* due_to_error);
+static void resolve(internal_request* req);
+
+/* Detaches req->ep from the request, leaving it to the caller. */
+static grpc_endpoint* release_endpoint(internal_request* req) {
+  grpc_endpoint* ep = req->ep;
+  if (req->ep_in_pollset_set) {
+    grpc_endpoint_delete_from_pollset_set(ep, req->context->pollset_set);
+    req->ep_in_pollset_set = false;
+  }
+  req->ep = nullptr;
+  return ep;
+}
 
 static void finish(internal_request* req, grpc_error* error) {
   grpc_polling_entity_del_from_pollset_set(req->pollent,
@@ -94,11 +206,12 @@ static void finish(internal_request* req, grpc_error* error) {
     grpc_resolved_addresses_destroy(req->addresses);
   }
   if (req->ep != nullptr) {
-    grpc_endpoint_destroy(req->ep);
+    grpc_endpoint_destroy(release_endpoint(req));
   }
   grpc_slice_unref_internal(req->request_text);
   gpr_free(req->host);
   gpr_free(req->ssl_host_override);
+  gpr_free(req->pool_key);
   grpc_iomgr_unregister_object(&req->iomgr_obj);
   grpc_slice_buffer_destroy_internal(&req->incoming);
   grpc_slice_buffer_destroy_internal(&req->outgoing);
@@ -120,6 +233,44 @@ static void append_error(internal_request* req, grpc_error* error) {
                          grpc_slice_from_moved_string(std::move(addr_text))));
 }
 
+/* Returns true if req asked for keep-alive and has read a complete response
+   after which the server agreed to keep the connection open. That needs an
+   explicit Content-Length: otherwise the body runs until the server closes. */
+static bool response_complete_and_reusable(internal_request* req) {
+  if (req->pool_key == nullptr || req->parser.state != GRPC_HTTP_BODY) {
+    return false;
+  }
+  const grpc_http_response* response = req->parser.http.response;
+  bool keep_alive = false;
+  int content_length = -1;
+  for (size_t i = 0; i < response->hdr_count; i++) {
+    const grpc_http_header* hdr = &response->hdrs[i];
+    if (gpr_stricmp(hdr->key, "Content-Length") == 0) {
+      content_length = gpr_parse_nonnegative_int(hdr->value);
+    } else if (gpr_stricmp(hdr->key, "Connection") == 0) {
+      keep_alive = gpr_stricmp(hdr->value, "keep-alive") == 0;
+    }
+  }
+  return keep_alive && content_length >= 0 &&
+         response->body_length == static_cast<size_t>(content_length);
+}
+
+/* The connection failed before any of the response was read. A reused
+   connection may simply have been closed by the server while idle, so the
+   request starts over on a new one; otherwise the next address is tried. */
+static void connection_failed(internal_request* req, grpc_error* error) {
+  if (!req->reused) {
+    next_address(req, error);
+    return;
+  }
+  GRPC_ERROR_UNREF(error);
+  grpc_endpoint_destroy(release_endpoint(req));
+  grpc_slice_buffer_reset_and_unref_internal(&req->incoming);
+  grpc_slice_buffer_reset_and_unref_internal(&req->outgoing);
+  req->reused = false;
+  resolve(req);
+}
+
 static void do_read(internal_request* req) {
   grpc_endpoint_read(req->ep, &req->incoming, &req->on_read, /*urgent=*/true);
 }
@@ -140,10 +291,13 @@ static void on_read(void* user_data, grpc_error* error) {
     }
   }
 
-  if (error == GRPC_ERROR_NONE) {
+  if (error == GRPC_ERROR_NONE && response_complete_and_reusable(req)) {
+    put_idle_connection(req->pool_key, release_endpoint(req));
+    finish(req, GRPC_ERROR_NONE);
+  } else if (error == GRPC_ERROR_NONE) {
     do_read(req);
   } else if (!req->have_read_byte) {
-    next_address(req, GRPC_ERROR_REF(error));
+    connection_failed(req, GRPC_ERROR_REF(error));
   } else {
     finish(req, grpc_http_parser_eof(&req->parser));
   }
@@ -156,11 +310,18 @@ static void done_write(void* arg, grpc_error* error) {
   if (error == GRPC_ERROR_NONE) {
     on_written(req);
   } else {
-    next_address(req, GRPC_ERROR_REF(error));
+    connection_failed(req, GRPC_ERROR_REF(error));
   }
 }
 
 static void start_write(internal_request* req) {
+  /* A keep-alive connection outlives this request's pollset_set, so rather
+     than relying on the one it was connected under, it is polled through
+     the current request's explicitly. */
+  if (req->pool_key != nullptr && !req->ep_in_pollset_set) {
+    grpc_endpoint_add_to_pollset_set(req->ep, req->context->pollset_set);
+    req->ep_in_pollset_set = true;
+  }
   grpc_slice_ref_internal(req->request_text);
   grpc_slice_buffer_add(&req->outgoing, req->request_text);
   grpc_endpoint_write(req->ep, &req->outgoing, &req->done_write, nullptr);
@@ -223,6 +384,13 @@ static void on_resolved(void* arg, grpc_error* error) {
   next_address(req, GRPC_ERROR_NONE);
 }
 
+static void resolve(internal_request* req) {
+  grpc_resolve_address(
+      req->host, req->handshaker->default_port, req->context->pollset_set,
+      GRPC_CLOSURE_CREATE(on_resolved, req, grpc_schedule_on_exec_ctx),
+      &req->addresses);
+}
+
 static void internal_request_begin(grpc_httpcli_context* context,
                                    grpc_polling_entity* pollent,
                                    grpc_resource_quota* resource_quota,
@@ -253,13 +421,24 @@ static void internal_request_begin(grpc_httpcli_context* context,
   req->host = gpr_strdup(request->host);
   req->ssl_host_override = gpr_strdup(request->ssl_host_override);
 
+  if (request->keep_alive) {
+    gpr_asprintf(&req->pool_key, "%s:%s:%s", req->handshaker->default_port,
+                 req->host,
+                 req->ssl_host_override ? req->ssl_host_override : "");
+  }
+
   GPR_ASSERT(pollent);
   grpc_polling_entity_add_to_pollset_set(req->pollent,
                                          req->context->pollset_set);
-  grpc_resolve_address(
-      request->host, req->handshaker->default_port, req->context->pollset_set,
-      GRPC_CLOSURE_CREATE(on_resolved, req, grpc_schedule_on_exec_ctx),
-      &req->addresses);
+  if (req->pool_key != nullptr) {
+    req->ep = take_idle_connection(req->pool_key);
+  }
+  if (req->ep != nullptr) {
+    req->reused = true;
+    start_write(req);
+  } else {
+    resolve(req);
+  }
 }
 
 void grpc_httpcli_get(grpc_httpcli_context* context,
@@ -63,6 +63,10 @@ typedef struct grpc_httpcli_request {
   grpc_http_request http;
   /* handshaker to use ssl for the request */
   const grpc_httpcli_handshaker* handshaker;
+  /* If true, ask the server to keep the connection open. When the response
+     carries a Content-Length and the server agrees, the connection is kept
+     idle for a while and reused by the next request to the same host */
+  bool keep_alive;
 } grpc_httpcli_request;
 
 /* Expose the parser response type as a httpcli response too */
@@ -124,4 +128,7 @@ typedef int (*grpc_httpcli_post_override)(const grpc_httpcli_request* request,
 void grpc_httpcli_set_override(grpc_httpcli_get_override get,
                                grpc_httpcli_post_override post);
 
+/* Closes the idle keep-alive connections. Called at grpc_shutdown. */
+void grpc_httpcli_shutdown(void);
+
 #endif /* GRPC_CORE_LIB_HTTP_HTTPCLI_H */
@@ -119,13 +119,19 @@ void CallCombiner::Start(grpc_closure* closure, grpc_error* error,
             "%s] error=%s",
             this, closure DEBUG_FMT_ARGS, reason, grpc_error_string(error));
   }
-  size_t prev_size =
-      static_cast<size_t>(gpr_atm_full_fetch_add(&size_, (gpr_atm)1));
+  GRPC_STATS_INC_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS();
+  // Fast path: the combiner is idle (the common case of a single batch in
+  // flight), so take it with an acquire CAS rather than a full barrier. The
+  // queue is never touched.
+  size_t prev_size = 0;
+  if (!gpr_atm_acq_cas(&size_, 0, 1)) {
+    prev_size =
+        static_cast<size_t>(gpr_atm_full_fetch_add(&size_, (gpr_atm)1));
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
     gpr_log(GPR_INFO, "  size: %" PRIdPTR " -> %" PRIdPTR, prev_size,
             prev_size + 1);
   }
-  GRPC_STATS_INC_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS();
   if (prev_size == 0) {
     GRPC_STATS_INC_CALL_COMBINER_LOCKS_INITIATED();
     GPR_TIMER_MARK("call_combiner_initiate", 0);
@@ -150,8 +156,13 @@ void CallCombiner::Stop(DEBUG_ARGS const char* reason) {
     gpr_log(GPR_INFO, "==> CallCombiner::Stop() [%p] [" DEBUG_FMT_STR "%s]",
             this DEBUG_FMT_ARGS, reason);
   }
-  size_t prev_size =
-      static_cast<size_t>(gpr_atm_full_fetch_add(&size_, (gpr_atm)-1));
+  // Fast path: nothing was queued behind us, so hand the combiner back with a
+  // release CAS; the queue is known to be empty.
+  size_t prev_size = 1;
+  if (!gpr_atm_rel_cas(&size_, 1, 0)) {
+    prev_size =
+        static_cast<size_t>(gpr_atm_full_fetch_add(&size_, (gpr_atm)-1));
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
     gpr_log(GPR_INFO, "  size: %" PRIdPTR " -> %" PRIdPTR, prev_size,
             prev_size - 1);
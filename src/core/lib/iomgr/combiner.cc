@@ -26,14 +26,34 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 #include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 
 grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_combiner_offload_closure_budget, 0,
+    "Number of closures a contended combiner may run on the thread that "
+    "picked it up before it is offloaded to the executor. 0 means no limit "
+    "on closures.");
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_combiner_offload_time_budget_us, 0,
+    "Time in microseconds a contended combiner may keep running on the "
+    "thread that picked it up before it is offloaded to the executor. 0 "
+    "means no limit on time.");
+
+// Offload budgets: with both of them 0 a contended combiner is offloaded as
+// soon as its exec_ctx is ready to finish.
+static size_t g_offload_closure_budget;
+static int64_t g_offload_time_budget_us;
+
 #define GRPC_COMBINER_TRACE(fn)          \
   do {                                   \
     if (grpc_combiner_trace.enabled()) { \
@@ -48,6 +68,9 @@ struct grpc_combiner {
   grpc_combiner* next_combiner_on_this_exec_ctx;
   grpc_closure_scheduler scheduler;
   grpc_closure_scheduler finally_scheduler;
+  grpc_closure_scheduler urgent_scheduler;
+  // closures queued through urgent_scheduler that have not run yet
+  gpr_atm urgent_pending;
   gpr_mpscq queue;
   // either:
   // a pointer to the initiating exec ctx if that is the only exec_ctx that has
@@ -61,25 +84,56 @@ struct grpc_combiner {
   bool time_to_execute_final_list;
   grpc_closure_list final_list;
   grpc_closure offload;
+  // closures run since this combiner last started running on some thread
+  size_t closures_run;
+  // whether offload_deadline is valid: it is set the first time the combiner
+  // is found contended after starting on a thread
+  bool offload_deadline_set;
+  gpr_timespec offload_deadline;
+  // lifetime totals, traced when the combiner is destroyed
+  size_t total_closures_run;
+  size_t total_offloads;
+  // created by grpc_combiner_create_control_plane()
+  bool control_plane;
   gpr_refcount refs;
 };
 
 static void combiner_run(grpc_closure* closure, grpc_error* error);
 static void combiner_exec(grpc_closure* closure, grpc_error* error);
 static void combiner_finally_exec(grpc_closure* closure, grpc_error* error);
+static void combiner_run_urgent(grpc_closure* closure, grpc_error* error);
+static void combiner_exec_urgent(grpc_closure* closure, grpc_error* error);
 
 static const grpc_closure_scheduler_vtable scheduler = {
     combiner_run, combiner_exec, "combiner:immediately"};
 static const grpc_closure_scheduler_vtable finally_scheduler = {
     combiner_finally_exec, combiner_finally_exec, "combiner:finally"};
+static const grpc_closure_scheduler_vtable urgent_scheduler = {
+    combiner_run_urgent, combiner_exec_urgent, "combiner:urgent"};
 
 static void offload(void* arg, grpc_error* error);
 
+void grpc_combiner_global_init(void) {
+  int32_t closure_budget =
+      GPR_GLOBAL_CONFIG_GET(grpc_combiner_offload_closure_budget);
+  int32_t time_budget_us =
+      GPR_GLOBAL_CONFIG_GET(grpc_combiner_offload_time_budget_us);
+  grpc_combiner_set_offload_budget(
+      static_cast<size_t>(GPR_MAX(closure_budget, 0)),
+      static_cast<int64_t>(GPR_MAX(time_budget_us, 0)));
+}
+
+void grpc_combiner_set_offload_budget(size_t closures, int64_t time_us) {
+  g_offload_closure_budget = closures;
+  g_offload_time_budget_us = time_us;
+}
+
 grpc_combiner* grpc_combiner_create(void) {
   grpc_combiner* lock = static_cast<grpc_combiner*>(gpr_zalloc(sizeof(*lock)));
   gpr_ref_init(&lock->refs, 1);
   lock->scheduler.vtable = &scheduler;
   lock->finally_scheduler.vtable = &finally_scheduler;
+  lock->urgent_scheduler.vtable = &urgent_scheduler;
   gpr_atm_no_barrier_store(&lock->state, STATE_UNORPHANED);
   gpr_mpscq_init(&lock->queue);
   grpc_closure_list_init(&lock->final_list);
@@ -90,8 +144,22 @@ grpc_combiner* grpc_combiner_create(void) {
   return lock;
 }
 
+grpc_combiner* grpc_combiner_create_control_plane(void) {
+  grpc_combiner* lock = grpc_combiner_create();
+  lock->control_plane = true;
+  GRPC_CLOSURE_INIT(&lock->offload, offload, lock,
+                    grpc_core::Executor::Scheduler(
+                        grpc_core::ExecutorType::CONTROL_PLANE,
+                        grpc_core::ExecutorJobType::SHORT));
+  return lock;
+}
+
 static void really_destroy(grpc_combiner* lock) {
-  GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p really_destroy", lock));
+  GRPC_COMBINER_TRACE(gpr_log(GPR_INFO,
+                              "C:%p really_destroy closures_run=%" PRIuPTR
+                              " offloads=%" PRIuPTR,
+                              lock, lock->total_closures_run,
+                              lock->total_offloads));
   GPR_ASSERT(gpr_atm_no_barrier_load(&lock->state) == 0);
   gpr_mpscq_destroy(&lock->queue);
   gpr_free(lock);
@@ -153,26 +221,42 @@ static void push_first_on_exec_ctx(grpc_combiner* lock) {
   }
 }
 
+// Called whenever the combiner starts running on a new thread: the offload
+// budget is measured from here.
+static void reset_offload_budget(grpc_combiner* lock) {
+  lock->closures_run = 0;
+  lock->offload_deadline_set = false;
+}
+
 #define COMBINER_FROM_CLOSURE_SCHEDULER(closure, scheduler_name) \
   ((grpc_combiner*)(((char*)((closure)->scheduler)) -            \
                     offsetof(grpc_combiner, scheduler_name)))
 
-static void combiner_exec(grpc_closure* cl, grpc_error* error) {
+static void combiner_exec_closure(grpc_combiner* lock, grpc_closure* cl,
+                                  grpc_error* error) {
   GPR_TIMER_SCOPE("combiner.execute", 0);
   GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS();
-  grpc_combiner* lock = COMBINER_FROM_CLOSURE_SCHEDULER(cl, scheduler);
   gpr_atm last = gpr_atm_full_fetch_add(&lock->state, STATE_ELEM_COUNT_LOW_BIT);
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO,
                               "C:%p grpc_combiner_execute c=%p last=%" PRIdPTR,
                               lock, cl, last));
+  bool hand_off = false;
   if (last == 1) {
     GRPC_STATS_INC_COMBINER_LOCKS_INITIATED();
     GPR_TIMER_MARK("combiner.initiated", 0);
-    gpr_atm_no_barrier_store(&lock->initiating_exec_ctx_or_null,
-                             (gpr_atm)grpc_core::ExecCtx::Get());
-    // first element on this list: add it to the list of combiner locks
-    // executing within this exec_ctx
-    push_last_on_exec_ctx(lock);
+    if (lock->control_plane && !grpc_core::Executor::IsExecutorThread(
+                                   grpc_core::ExecutorType::CONTROL_PLANE)) {
+      // started away from the control plane executor: once the closure is
+      // queued, have the executor pick the lock up instead of this thread
+      hand_off = true;
+    } else {
+      gpr_atm_no_barrier_store(&lock->initiating_exec_ctx_or_null,
+                               (gpr_atm)grpc_core::ExecCtx::Get());
+      // first element on this list: add it to the list of combiner locks
+      // executing within this exec_ctx
+      reset_offload_budget(lock);
+      push_last_on_exec_ctx(lock);
+    }
   } else {
     // there may be a race with setting here: if that happens, we may delay
     // offload for one or two actions, and that's fine
@@ -186,6 +270,24 @@ static void combiner_exec(grpc_closure* cl, grpc_error* error) {
   assert(cl->cb);
   cl->error_data.error = error;
   gpr_mpscq_push(&lock->queue, &cl->next_data.atm_next);
+  if (hand_off) {
+    GRPC_STATS_INC_CONTROL_PLANE_COMBINER_HANDOFFS();
+    GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p hand_off", lock));
+    GRPC_CLOSURE_SCHED(&lock->offload, GRPC_ERROR_NONE);
+  }
+}
+
+static void combiner_exec(grpc_closure* cl, grpc_error* error) {
+  combiner_exec_closure(COMBINER_FROM_CLOSURE_SCHEDULER(cl, scheduler), cl,
+                        error);
+}
+
+static void combiner_exec_urgent(grpc_closure* cl, grpc_error* error) {
+  grpc_combiner* lock = COMBINER_FROM_CLOSURE_SCHEDULER(cl, urgent_scheduler);
+  // counted before the closure is visible on the queue, so that whoever pops
+  // it always finds the count to take it off
+  gpr_atm_full_fetch_add(&lock->urgent_pending, 1);
+  combiner_exec_closure(lock, cl, error);
 }
 
 static void move_next() {
@@ -200,16 +302,54 @@ static void move_next() {
 
 static void offload(void* arg, grpc_error* error) {
   grpc_combiner* lock = static_cast<grpc_combiner*>(arg);
+  reset_offload_budget(lock);
   push_last_on_exec_ctx(lock);
 }
 
 static void queue_offload(grpc_combiner* lock) {
   GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED();
+  lock->total_offloads++;
   move_next();
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p queue_offload", lock));
   GRPC_CLOSURE_SCHED(&lock->offload, GRPC_ERROR_NONE);
 }
 
+// Returns true if a contended combiner has used up its budget for running on
+// the current thread and should now be offloaded.
+static bool offload_budget_exhausted(grpc_combiner* lock) {
+  if (g_offload_closure_budget == 0 && g_offload_time_budget_us == 0) {
+    return true;
+  }
+  if (g_offload_closure_budget != 0 &&
+      lock->closures_run >= g_offload_closure_budget) {
+    return true;
+  }
+  if (g_offload_time_budget_us != 0) {
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    if (!lock->offload_deadline_set) {
+      lock->offload_deadline_set = true;
+      lock->offload_deadline = gpr_time_add(
+          now, gpr_time_from_micros(g_offload_time_budget_us, GPR_TIMESPAN));
+      return false;
+    }
+    return gpr_time_cmp(now, lock->offload_deadline) >= 0;
+  }
+  return false;
+}
+
+// Start and finish timing a closure of a control plane combiner
+static gpr_timespec start_run_timer(grpc_combiner* lock) {
+  return lock->control_plane ? gpr_now(GPR_CLOCK_MONOTONIC)
+                             : gpr_inf_past(GPR_CLOCK_MONOTONIC);
+}
+
+static void stop_run_timer(grpc_combiner* lock, gpr_timespec start) {
+  if (!lock->control_plane) return;
+  gpr_timespec elapsed = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start);
+  GRPC_STATS_ADD_COUNTER(GRPC_STATS_COUNTER_CONTROL_PLANE_COMBINER_RUN_TIME_US,
+                         static_cast<gpr_atm>(gpr_timespec_to_micros(elapsed)));
+}
+
 bool grpc_combiner_continue_exec_ctx() {
   GPR_TIMER_SCOPE("combiner.continue_exec_ctx", 0);
   grpc_combiner* lock =
@@ -235,14 +375,20 @@ bool grpc_combiner_continue_exec_ctx() {
   // 2. the current execution context needs to finish as soon as possible
   // 3. the current thread is not a worker for any background poller
   // 4. the DEFAULT executor is threaded
+  // 5. the combiner has used up its offload budget on this thread
   if (contended && grpc_core::ExecCtx::Get()->IsReadyToFinish() &&
       !grpc_iomgr_is_any_background_poller_thread() &&
       grpc_core::Executor::IsThreadedDefault()) {
-    GPR_TIMER_MARK("offload_from_finished_exec_ctx", 0);
-    // this execution context wants to move on: schedule remaining work to be
-    // picked up on the executor
-    queue_offload(lock);
-    return true;
+    if (offload_budget_exhausted(lock)) {
+      GPR_TIMER_MARK("offload_from_finished_exec_ctx", 0);
+      // this execution context wants to move on: schedule remaining work to
+      // be picked up on the executor
+      queue_offload(lock);
+      return true;
+    }
+    // a short burst of work: finish it here rather than paying for a thread
+    // hop
+    GRPC_STATS_INC_COMBINER_LOCKS_OFFLOAD_DEFERRED();
   }
 
   if (!lock->time_to_execute_final_list ||
@@ -262,11 +408,19 @@ bool grpc_combiner_continue_exec_ctx() {
     GPR_TIMER_SCOPE("combiner.exec1", 0);
     grpc_closure* cl = reinterpret_cast<grpc_closure*>(n);
     grpc_error* cl_err = cl->error_data.error;
+    if (cl->scheduler == &lock->urgent_scheduler) {
+      gpr_atm_no_barrier_fetch_add(&lock->urgent_pending, -1);
+    }
 #ifndef NDEBUG
     cl->scheduled = false;
 #endif
+    GRPC_USDT2(combiner_run, lock, cl);
+    gpr_timespec start = start_run_timer(lock);
     cl->cb(cl->cb_arg, cl_err);
+    stop_run_timer(lock, start);
     GRPC_ERROR_UNREF(cl_err);
+    lock->closures_run++;
+    lock->total_closures_run++;
   } else {
     grpc_closure* c = lock->final_list.head;
     GPR_ASSERT(c != nullptr);
@@ -281,8 +435,12 @@ bool grpc_combiner_continue_exec_ctx() {
 #ifndef NDEBUG
       c->scheduled = false;
 #endif
+      gpr_timespec start = start_run_timer(lock);
       c->cb(c->cb_arg, error);
+      stop_run_timer(lock, start);
       GRPC_ERROR_UNREF(error);
+      lock->closures_run++;
+      lock->total_closures_run++;
       c = next;
     }
   }
@@ -328,6 +486,28 @@ bool grpc_combiner_continue_exec_ctx() {
   return true;
 }
 
+bool grpc_combiner_continue_urgent_exec_ctx() {
+  grpc_core::ExecCtx::CombinerData* data =
+      grpc_core::ExecCtx::Get()->combiner_data();
+  grpc_combiner* prev = nullptr;
+  for (grpc_combiner* lock = data->active_combiner; lock != nullptr;
+       prev = lock, lock = lock->next_combiner_on_this_exec_ctx) {
+    if (gpr_atm_no_barrier_load(&lock->urgent_pending) == 0) continue;
+    if (prev != nullptr) {
+      // bring it to the front: grpc_combiner_continue_exec_ctx() always
+      // continues the first active combiner
+      prev->next_combiner_on_this_exec_ctx =
+          lock->next_combiner_on_this_exec_ctx;
+      if (data->last_combiner == lock) {
+        data->last_combiner = prev;
+      }
+      push_first_on_exec_ctx(lock);
+    }
+    return grpc_combiner_continue_exec_ctx();
+  }
+  return false;
+}
+
 static void enqueue_finally(void* closure, grpc_error* error);
 
 static void combiner_finally_exec(grpc_closure* closure, grpc_error* error) {
@@ -352,8 +532,8 @@ static void combiner_finally_exec(grpc_closure* closure, grpc_error* error) {
   grpc_closure_list_append(&lock->final_list, closure, error);
 }
 
-static void combiner_run(grpc_closure* closure, grpc_error* error) {
-  grpc_combiner* lock = COMBINER_FROM_CLOSURE_SCHEDULER(closure, scheduler);
+static void combiner_run_closure(grpc_combiner* lock, grpc_closure* closure,
+                                 grpc_error* error) {
 #ifndef NDEBUG
   closure->scheduled = false;
   GRPC_COMBINER_TRACE(gpr_log(
@@ -364,10 +544,22 @@ static void combiner_run(grpc_closure* closure, grpc_error* error) {
 #endif
   GPR_ASSERT(grpc_core::ExecCtx::Get()->combiner_data()->active_combiner ==
              lock);
+  GRPC_USDT2(combiner_run, lock, closure);
   closure->cb(closure->cb_arg, error);
   GRPC_ERROR_UNREF(error);
 }
 
+static void combiner_run(grpc_closure* closure, grpc_error* error) {
+  combiner_run_closure(COMBINER_FROM_CLOSURE_SCHEDULER(closure, scheduler),
+                       closure, error);
+}
+
+static void combiner_run_urgent(grpc_closure* closure, grpc_error* error) {
+  combiner_run_closure(
+      COMBINER_FROM_CLOSURE_SCHEDULER(closure, urgent_scheduler), closure,
+      error);
+}
+
 static void enqueue_finally(void* closure, grpc_error* error) {
   combiner_finally_exec(static_cast<grpc_closure*>(closure),
                         GRPC_ERROR_REF(error));
@@ -381,3 +573,8 @@ grpc_closure_scheduler* grpc_combiner_finally_scheduler(
     grpc_combiner* combiner) {
   return &combiner->finally_scheduler;
 }
+
+grpc_closure_scheduler* grpc_combiner_urgent_scheduler(
+    grpc_combiner* combiner) {
+  return &combiner->urgent_scheduler;
+}
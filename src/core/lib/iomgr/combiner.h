@@ -33,10 +33,30 @@
 // The actual thread executing actions may change over time (but there will only
 // ever be one at a time).
 
+// Read the offload budget from the environment: called by grpc_iomgr_init
+void grpc_combiner_global_init(void);
+
+// A contended combiner whose exec_ctx is ready to finish is offloaded to the
+// executor once it has run \a closures closures or \a time_us microseconds on
+// the thread that picked it up, whichever comes first (0 disables that limit;
+// with both 0 it is offloaded straight away, which is the default).
+// Normally set from GRPC_COMBINER_OFFLOAD_CLOSURE_BUDGET and
+// GRPC_COMBINER_OFFLOAD_TIME_BUDGET_US, exposed for tests and benchmarks.
+void grpc_combiner_set_offload_budget(size_t closures, int64_t time_us);
+
 // Initialize the lock, with an optional workqueue to shift load to when
 // necessary
 grpc_combiner* grpc_combiner_create(void);
 
+// Create a lock whose closures only ever run on the control plane executor:
+// work queued from any other thread is handed to that executor rather than run
+// by the queueing thread. For control plane work (resolver results, LB policy
+// and connectivity updates) that should not hold up the threads polling for
+// RPC completions. Handoffs and the time spent running closures are reported
+// by the control_plane_combiner_handoffs and
+// control_plane_combiner_run_time_us stats.
+grpc_combiner* grpc_combiner_create_control_plane(void);
+
 #ifndef NDEBUG
 #define GRPC_COMBINER_DEBUG_ARGS \
   , const char *file, int line, const char *reason
@@ -58,8 +78,15 @@ void grpc_combiner_unref(grpc_combiner* lock GRPC_COMBINER_DEBUG_ARGS);
 grpc_closure_scheduler* grpc_combiner_scheduler(grpc_combiner* lock);
 // Scheduler to execute \a action within the lock just prior to unlocking.
 grpc_closure_scheduler* grpc_combiner_finally_scheduler(grpc_combiner* lock);
+// Like grpc_combiner_scheduler, for latency critical closures: while one of
+// them is queued, an exec_ctx running the lock continues it ahead of its own
+// queued closures (see ExecCtx::Flush)
+grpc_closure_scheduler* grpc_combiner_urgent_scheduler(grpc_combiner* lock);
 
 bool grpc_combiner_continue_exec_ctx();
+// Continue an active combiner that has urgent closures queued; returns false
+// if there is none
+bool grpc_combiner_continue_urgent_exec_ctx();
 
 extern grpc_core::DebugOnlyTraceFlag grpc_combiner_trace;
 
@@ -65,3 +65,11 @@ grpc_resource_user* grpc_endpoint_get_resource_user(grpc_endpoint* ep) {
 bool grpc_endpoint_can_track_err(grpc_endpoint* ep) {
   return ep->vtable->can_track_err(ep);
 }
+
+void grpc_endpoint_set_read_hint(grpc_endpoint* ep, size_t bytes) {
+  ep->vtable->set_read_hint(ep, bytes);
+}
+
+void grpc_endpoint_set_write_hint(grpc_endpoint* ep, bool more_writes_follow) {
+  ep->vtable->set_write_hint(ep, more_writes_follow);
+}
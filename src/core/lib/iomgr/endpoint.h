@@ -49,6 +49,8 @@ struct grpc_endpoint_vtable {
   char* (*get_peer)(grpc_endpoint* ep);
   int (*get_fd)(grpc_endpoint* ep);
   bool (*can_track_err)(grpc_endpoint* ep);
+  void (*set_read_hint)(grpc_endpoint* ep, size_t bytes);
+  void (*set_write_hint)(grpc_endpoint* ep, bool more_writes_follow);
 };
 
 /* When data is available on the connection, calls the callback with slices.
@@ -99,6 +101,20 @@ grpc_resource_user* grpc_endpoint_get_resource_user(grpc_endpoint* endpoint);
 
 bool grpc_endpoint_can_track_err(grpc_endpoint* ep);
 
+/* Tells \a ep that the upper layer expects about \a bytes more to arrive
+   (e.g., the rest of a large message whose header has been parsed), so that
+   it can size the buffers for its following reads accordingly. Zero means
+   nothing is known. Only a hint: endpoints may ignore it, and reads still
+   complete as soon as any data is available. */
+void grpc_endpoint_set_read_hint(grpc_endpoint* ep, size_t bytes);
+
+/* Tells \a ep whether the upper layer will start another write as soon as the
+   next one completes (e.g., because it stopped filling that write at its size
+   limit), so that it can let the network stack hold back a trailing partial
+   segment until the following write instead of sending it on its own. Applies
+   to writes started after the call. Only a hint: endpoints may ignore it. */
+void grpc_endpoint_set_write_hint(grpc_endpoint* ep, bool more_writes_follow);
+
 struct grpc_endpoint {
   const grpc_endpoint_vtable* vtable;
 };
@@ -317,6 +317,10 @@ int CFStreamGetFD(grpc_endpoint* ep) { return 0; }
 
 bool CFStreamCanTrackErr(grpc_endpoint* ep) { return false; }
 
+void CFStreamSetReadHint(grpc_endpoint* ep, size_t bytes) {}
+
+void CFStreamSetWriteHint(grpc_endpoint* ep, bool more_writes_follow) {}
+
 void CFStreamAddToPollset(grpc_endpoint* ep, grpc_pollset* pollset) {}
 void CFStreamAddToPollsetSet(grpc_endpoint* ep, grpc_pollset_set* pollset) {}
 void CFStreamDeleteFromPollsetSet(grpc_endpoint* ep,
@@ -332,7 +336,9 @@ static const grpc_endpoint_vtable vtable = {CFStreamRead,
                                             CFStreamGetResourceUser,
                                             CFStreamGetPeer,
                                             CFStreamGetFD,
-                                            CFStreamCanTrackErr};
+                                            CFStreamCanTrackErr,
+                                            CFStreamSetReadHint,
+                                            CFStreamSetWriteHint};
 
 grpc_endpoint* grpc_cfstream_endpoint_create(
     CFReadStreamRef read_stream, CFWriteStreamRef write_stream,
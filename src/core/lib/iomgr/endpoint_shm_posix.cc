@@ -0,0 +1,493 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EVENTFD
+
+#include "src/core/lib/iomgr/endpoint_shm_posix.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/resource_quota.h"
+#include "src/core/lib/iomgr/shm_ring.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+/* The region holds the two rings' headers, then the data of the ring carrying
+   bytes from the client to the server, then that of the other. */
+#define RING_HEADERS_SIZE (2 * sizeof(grpc_core::ShmRing::Header))
+#define CLIENT_TO_SERVER 0
+#define SERVER_TO_CLIENT 1
+
+/* The most bytes taken out of the ring into one slice per read */
+#define MAX_READ_SIZE (256 * 1024)
+
+typedef struct {
+  grpc_endpoint base;
+  gpr_refcount refcount;
+
+  gpr_mu mu;
+  void* region;
+  size_t region_size;
+  /* rx is written by the peer and read here; tx the other way around. */
+  grpc_core::ManualConstructor<grpc_core::ShmRing> rx;
+  grpc_core::ManualConstructor<grpc_core::ShmRing> tx;
+
+  /* Signalled by the peer, and polled here whenever a read or write waits. */
+  grpc_fd* event_fd;
+  int peer_event_fd;
+  grpc_closure on_event;
+  bool event_armed;
+
+  grpc_closure* read_cb;
+  grpc_slice_buffer* read_slices;
+  grpc_closure* write_cb;
+  grpc_slice_buffer* write_slices;
+  /* The bytes of write_slices' first slice already copied into tx. */
+  size_t write_offset;
+
+  grpc_error* shutdown_error;
+  char* peer_string;
+  grpc_resource_user* resource_user;
+} grpc_shm_endpoint;
+
+static void shm_free(grpc_shm_endpoint* ep) {
+  grpc_fd_orphan(ep->event_fd, nullptr, nullptr, "shm_endpoint_free");
+  close(ep->peer_event_fd);
+  ep->rx.Destroy();
+  ep->tx.Destroy();
+  munmap(ep->region, ep->region_size);
+  GRPC_ERROR_UNREF(ep->shutdown_error);
+  grpc_resource_user_unref(ep->resource_user);
+  gpr_free(ep->peer_string);
+  gpr_mu_destroy(&ep->mu);
+  gpr_free(ep);
+}
+
+static void shm_unref(grpc_shm_endpoint* ep) {
+  if (gpr_unref(&ep->refcount)) {
+    shm_free(ep);
+  }
+}
+
+static grpc_error* shm_annotate_error(grpc_error* error,
+                                      grpc_shm_endpoint* ep) {
+  return grpc_error_set_str(
+      grpc_error_set_int(error, GRPC_ERROR_INT_GRPC_STATUS,
+                         GRPC_STATUS_UNAVAILABLE),
+      GRPC_ERROR_STR_TARGET_ADDRESS,
+      grpc_slice_from_copied_string(ep->peer_string));
+}
+
+static void signal_peer(grpc_shm_endpoint* ep) {
+  const uint64_t one = 1;
+  ssize_t r;
+  do {
+    r = write(ep->peer_event_fd, &one, sizeof(one));
+  } while (r < 0 && errno == EINTR);
+}
+
+static void arm_event_locked(grpc_shm_endpoint* ep) {
+  if (ep->event_armed) return;
+  ep->event_armed = true;
+  gpr_ref(&ep->refcount);
+  grpc_fd_notify_on_read(ep->event_fd, &ep->on_event);
+}
+
+static void finish_read_locked(grpc_shm_endpoint* ep, grpc_error* error) {
+  if (error != GRPC_ERROR_NONE) {
+    grpc_slice_buffer_reset_and_unref_internal(ep->read_slices);
+  }
+  grpc_closure* cb = ep->read_cb;
+  ep->read_cb = nullptr;
+  ep->read_slices = nullptr;
+  GRPC_CLOSURE_SCHED(cb, error);
+}
+
+static void finish_write_locked(grpc_shm_endpoint* ep, grpc_error* error) {
+  grpc_closure* cb = ep->write_cb;
+  ep->write_cb = nullptr;
+  ep->write_slices = nullptr;
+  GRPC_CLOSURE_SCHED(cb, error);
+}
+
+/* Completes the pending read if it can, or returns false if it has to wait
+   for the peer. */
+static bool read_locked(grpc_shm_endpoint* ep) {
+  for (;;) {
+    if (ep->shutdown_error != GRPC_ERROR_NONE) {
+      finish_read_locked(ep, GRPC_ERROR_REF(ep->shutdown_error));
+      return true;
+    }
+    /* The peer closes the ring only after its last write. */
+    const bool closed = ep->rx->closed();
+    const size_t readable = ep->rx->Readable();
+    if (readable > 0) {
+      grpc_slice slice = GRPC_SLICE_MALLOC(GPR_MIN(readable, MAX_READ_SIZE));
+      ep->rx->Read(GRPC_SLICE_START_PTR(slice), GRPC_SLICE_LENGTH(slice));
+      grpc_slice_buffer_add(ep->read_slices, slice);
+      if (ep->rx->TakeWriterWaiting()) signal_peer(ep);
+      finish_read_locked(ep, GRPC_ERROR_NONE);
+      return true;
+    }
+    if (closed) {
+      finish_read_locked(
+          ep, shm_annotate_error(
+                  GRPC_ERROR_CREATE_FROM_STATIC_STRING("Socket closed"), ep));
+      return true;
+    }
+    if (ep->rx->PrepareToWaitForData()) return false;
+  }
+}
+
+/* Completes the pending write if it can, or returns false if it has to wait
+   for the peer to make room. */
+static bool write_locked(grpc_shm_endpoint* ep) {
+  for (;;) {
+    if (ep->shutdown_error != GRPC_ERROR_NONE) {
+      finish_write_locked(ep, GRPC_ERROR_REF(ep->shutdown_error));
+      return true;
+    }
+    if (ep->tx->closed()) {
+      finish_write_locked(
+          ep, shm_annotate_error(
+                  GRPC_ERROR_CREATE_FROM_STATIC_STRING("Socket closed"), ep));
+      return true;
+    }
+    bool wrote = false;
+    while (ep->write_slices->count > 0) {
+      const grpc_slice& slice = ep->write_slices->slices[0];
+      const size_t length = GRPC_SLICE_LENGTH(slice) - ep->write_offset;
+      const size_t n = ep->tx->Write(
+          GRPC_SLICE_START_PTR(slice) + ep->write_offset, length);
+      wrote |= n > 0;
+      if (n < length) {
+        ep->write_offset += n;
+        break;
+      }
+      grpc_slice_unref_internal(grpc_slice_buffer_take_first(ep->write_slices));
+      ep->write_offset = 0;
+    }
+    if (wrote && ep->tx->TakeReaderWaiting()) signal_peer(ep);
+    if (ep->write_slices->count == 0) {
+      finish_write_locked(ep, GRPC_ERROR_NONE);
+      return true;
+    }
+    if (ep->tx->PrepareToWaitForSpace()) return false;
+  }
+}
+
+static void on_event(void* arg, grpc_error* error) {
+  grpc_shm_endpoint* ep = static_cast<grpc_shm_endpoint*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    uint64_t count;
+    ssize_t r;
+    do {
+      r = read(grpc_fd_wrapped_fd(ep->event_fd), &count, sizeof(count));
+    } while (r < 0 && errno == EINTR);
+  }
+  gpr_mu_lock(&ep->mu);
+  ep->event_armed = false;
+  if (error != GRPC_ERROR_NONE && ep->shutdown_error == GRPC_ERROR_NONE) {
+    ep->shutdown_error = GRPC_ERROR_REF(error);
+  }
+  bool wait = false;
+  if (ep->read_cb != nullptr && !read_locked(ep)) wait = true;
+  if (ep->write_cb != nullptr && !write_locked(ep)) wait = true;
+  if (wait) arm_event_locked(ep);
+  gpr_mu_unlock(&ep->mu);
+  shm_unref(ep);
+}
+
+static void shm_read(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                     grpc_closure* cb, bool urgent) {
+  grpc_shm_endpoint* shm = reinterpret_cast<grpc_shm_endpoint*>(ep);
+  gpr_mu_lock(&shm->mu);
+  GPR_ASSERT(shm->read_cb == nullptr);
+  shm->read_cb = cb;
+  shm->read_slices = slices;
+  grpc_slice_buffer_reset_and_unref_internal(slices);
+  if (!read_locked(shm)) arm_event_locked(shm);
+  gpr_mu_unlock(&shm->mu);
+}
+
+static void shm_write(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                      grpc_closure* cb, void* arg) {
+  grpc_shm_endpoint* shm = reinterpret_cast<grpc_shm_endpoint*>(ep);
+  gpr_mu_lock(&shm->mu);
+  GPR_ASSERT(shm->write_cb == nullptr);
+  shm->write_cb = cb;
+  shm->write_slices = slices;
+  shm->write_offset = 0;
+  if (!write_locked(shm)) arm_event_locked(shm);
+  gpr_mu_unlock(&shm->mu);
+}
+
+static void shm_add_to_pollset(grpc_endpoint* ep, grpc_pollset* pollset) {
+  grpc_shm_endpoint* shm = reinterpret_cast<grpc_shm_endpoint*>(ep);
+  grpc_pollset_add_fd(pollset, shm->event_fd);
+}
+
+static void shm_add_to_pollset_set(grpc_endpoint* ep,
+                                   grpc_pollset_set* pollset_set) {
+  grpc_shm_endpoint* shm = reinterpret_cast<grpc_shm_endpoint*>(ep);
+  grpc_pollset_set_add_fd(pollset_set, shm->event_fd);
+}
+
+static void shm_delete_from_pollset_set(grpc_endpoint* ep,
+                                        grpc_pollset_set* pollset_set) {
+  grpc_shm_endpoint* shm = reinterpret_cast<grpc_shm_endpoint*>(ep);
+  grpc_pollset_set_del_fd(pollset_set, shm->event_fd);
+}
+
+/* Closes both rings, which the peer notices as end of stream, and fails the
+   pending read and write. */
+static void shm_shutdown(grpc_endpoint* ep, grpc_error* why) {
+  grpc_shm_endpoint* shm = reinterpret_cast<grpc_shm_endpoint*>(ep);
+  gpr_mu_lock(&shm->mu);
+  if (shm->shutdown_error == GRPC_ERROR_NONE) {
+    shm->shutdown_error = GRPC_ERROR_REF(why);
+    shm->rx->Close();
+    shm->tx->Close();
+    signal_peer(shm);
+    grpc_fd_shutdown(shm->event_fd, GRPC_ERROR_REF(why));
+    grpc_resource_user_shutdown(shm->resource_user);
+  }
+  gpr_mu_unlock(&shm->mu);
+  GRPC_ERROR_UNREF(why);
+}
+
+static void shm_destroy(grpc_endpoint* ep) {
+  shm_shutdown(ep, GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint destroyed"));
+  shm_unref(reinterpret_cast<grpc_shm_endpoint*>(ep));
+}
+
+static grpc_resource_user* shm_get_resource_user(grpc_endpoint* ep) {
+  grpc_shm_endpoint* shm = reinterpret_cast<grpc_shm_endpoint*>(ep);
+  return shm->resource_user;
+}
+
+static char* shm_get_peer(grpc_endpoint* ep) {
+  grpc_shm_endpoint* shm = reinterpret_cast<grpc_shm_endpoint*>(ep);
+  return gpr_strdup(shm->peer_string);
+}
+
+static int shm_get_fd(grpc_endpoint* ep) { return -1; }
+
+static bool shm_can_track_err(grpc_endpoint* ep) { return false; }
+
+static void shm_set_read_hint(grpc_endpoint* ep, size_t bytes) {}
+
+static void shm_set_write_hint(grpc_endpoint* ep, bool more_writes_follow) {}
+
+static const grpc_endpoint_vtable vtable = {shm_read,
+                                            shm_write,
+                                            shm_add_to_pollset,
+                                            shm_add_to_pollset_set,
+                                            shm_delete_from_pollset_set,
+                                            shm_shutdown,
+                                            shm_destroy,
+                                            shm_get_resource_user,
+                                            shm_get_peer,
+                                            shm_get_fd,
+                                            shm_can_track_err,
+                                            shm_set_read_hint,
+                                            shm_set_write_hint};
+
+grpc_error* grpc_shm_endpoint_fds_create(size_t ring_size,
+                                         grpc_shm_endpoint_fds* fds) {
+  GPR_ASSERT(ring_size > 0 && (ring_size & (ring_size - 1)) == 0);
+  fds->region_fd = fds->client_event_fd = fds->server_event_fd = -1;
+#ifndef SYS_memfd_create
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING("memfd_create is unavailable");
+#else
+  fds->region_fd = static_cast<int>(
+      syscall(SYS_memfd_create, "grpc_shm_endpoint", 1 /* MFD_CLOEXEC */));
+  if (fds->region_fd < 0) {
+    return GRPC_OS_ERROR(errno, "memfd_create");
+  }
+  grpc_error* error = GRPC_ERROR_NONE;
+  /* The region starts out zeroed, as empty open rings are. */
+  if (ftruncate(fds->region_fd,
+                static_cast<off_t>(RING_HEADERS_SIZE + 2 * ring_size)) != 0) {
+    error = GRPC_OS_ERROR(errno, "ftruncate");
+  } else if ((fds->client_event_fd =
+                  eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0 ||
+             (fds->server_event_fd =
+                  eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0) {
+    error = GRPC_OS_ERROR(errno, "eventfd");
+  }
+  if (error != GRPC_ERROR_NONE) {
+    if (fds->server_event_fd >= 0) close(fds->server_event_fd);
+    if (fds->client_event_fd >= 0) close(fds->client_event_fd);
+    close(fds->region_fd);
+    fds->region_fd = fds->client_event_fd = fds->server_event_fd = -1;
+  }
+  return error;
+#endif
+}
+
+grpc_error* grpc_shm_endpoint_fds_send(int unix_socket,
+                                       const grpc_shm_endpoint_fds* fds) {
+  const int sent_fds[3] = {fds->region_fd, fds->client_event_fd,
+                           fds->server_event_fd};
+  char byte = 0;
+  struct iovec iov = {&byte, 1};
+  char control[CMSG_SPACE(sizeof(sent_fds))];
+  memset(control, 0, sizeof(control));
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(sent_fds));
+  memcpy(CMSG_DATA(cmsg), sent_fds, sizeof(sent_fds));
+  ssize_t r;
+  do {
+    r = sendmsg(unix_socket, &msg, MSG_NOSIGNAL);
+  } while (r < 0 && errno == EINTR);
+  return r < 0 ? GRPC_OS_ERROR(errno, "sendmsg") : GRPC_ERROR_NONE;
+}
+
+grpc_error* grpc_shm_endpoint_fds_receive(int unix_socket,
+                                          grpc_shm_endpoint_fds* fds) {
+  int received_fds[3];
+  char byte;
+  struct iovec iov = {&byte, 1};
+  char control[CMSG_SPACE(sizeof(received_fds))];
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  ssize_t r;
+  do {
+    r = recvmsg(unix_socket, &msg, MSG_CMSG_CLOEXEC);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0) return GRPC_OS_ERROR(errno, "recvmsg");
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  if (r == 0 || cmsg == nullptr || cmsg->cmsg_level != SOL_SOCKET ||
+      cmsg->cmsg_type != SCM_RIGHTS ||
+      cmsg->cmsg_len != CMSG_LEN(sizeof(received_fds))) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Peer did not send shared memory endpoint fds");
+  }
+  memcpy(received_fds, CMSG_DATA(cmsg), sizeof(received_fds));
+  fds->region_fd = received_fds[0];
+  fds->client_event_fd = received_fds[1];
+  fds->server_event_fd = received_fds[2];
+  return GRPC_ERROR_NONE;
+}
+
+grpc_endpoint* grpc_shm_endpoint_create(const grpc_shm_endpoint_fds* fds,
+                                        bool is_client,
+                                        const grpc_channel_args* args,
+                                        const char* peer_string) {
+  struct stat st;
+  GPR_ASSERT(fstat(fds->region_fd, &st) == 0);
+  const size_t region_size = static_cast<size_t>(st.st_size);
+  GPR_ASSERT(region_size > RING_HEADERS_SIZE);
+  const size_t ring_size = (region_size - RING_HEADERS_SIZE) / 2;
+  void* region = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fds->region_fd, 0);
+  GPR_ASSERT(region != MAP_FAILED);
+  close(fds->region_fd);
+
+  grpc_shm_endpoint* ep =
+      static_cast<grpc_shm_endpoint*>(gpr_zalloc(sizeof(grpc_shm_endpoint)));
+  ep->base.vtable = &vtable;
+  gpr_ref_init(&ep->refcount, 1);
+  gpr_mu_init(&ep->mu);
+  ep->region = region;
+  ep->region_size = region_size;
+  grpc_core::ShmRing::Header* headers =
+      static_cast<grpc_core::ShmRing::Header*>(region);
+  uint8_t* data = static_cast<uint8_t*>(region) + RING_HEADERS_SIZE;
+  const int rx = is_client ? SERVER_TO_CLIENT : CLIENT_TO_SERVER;
+  const int tx = is_client ? CLIENT_TO_SERVER : SERVER_TO_CLIENT;
+  ep->rx.Init(&headers[rx], data + rx * ring_size, ring_size);
+  ep->tx.Init(&headers[tx], data + tx * ring_size, ring_size);
+  char* name;
+  gpr_asprintf(&name, "shm-endpoint:%s", peer_string);
+  ep->event_fd = grpc_fd_create(
+      is_client ? fds->client_event_fd : fds->server_event_fd, name, false);
+  gpr_free(name);
+  ep->peer_event_fd = is_client ? fds->server_event_fd : fds->client_event_fd;
+  GRPC_CLOSURE_INIT(&ep->on_event, on_event, ep, grpc_schedule_on_exec_ctx);
+  ep->shutdown_error = GRPC_ERROR_NONE;
+  ep->peer_string = gpr_strdup(peer_string);
+  grpc_resource_quota* resource_quota = grpc_resource_quota_create(nullptr);
+  const grpc_arg* arg = grpc_channel_args_find(args, GRPC_ARG_RESOURCE_QUOTA);
+  if (arg != nullptr && arg->type == GRPC_ARG_POINTER) {
+    grpc_resource_quota_unref_internal(resource_quota);
+    resource_quota = grpc_resource_quota_ref_internal(
+        static_cast<grpc_resource_quota*>(arg->value.pointer.p));
+  }
+  ep->resource_user = grpc_resource_user_create(resource_quota, peer_string);
+  grpc_resource_quota_unref_internal(resource_quota);
+  return &ep->base;
+}
+
+grpc_endpoint_pair grpc_shm_endpoint_pair_create(
+    const char* name, size_t ring_size, const grpc_channel_args* args) {
+  grpc_shm_endpoint_fds fds;
+  GPR_ASSERT(grpc_shm_endpoint_fds_create(ring_size, &fds) == GRPC_ERROR_NONE);
+  grpc_shm_endpoint_fds server_fds;
+  server_fds.region_fd = dup(fds.region_fd);
+  server_fds.client_event_fd = dup(fds.client_event_fd);
+  server_fds.server_event_fd = dup(fds.server_event_fd);
+  GPR_ASSERT(server_fds.region_fd >= 0 && server_fds.client_event_fd >= 0 &&
+             server_fds.server_event_fd >= 0);
+
+  grpc_core::ExecCtx exec_ctx;
+  grpc_endpoint_pair p;
+  char* final_name;
+  gpr_asprintf(&final_name, "%s:client", name);
+  p.client = grpc_shm_endpoint_create(&fds, true, args, final_name);
+  gpr_free(final_name);
+  gpr_asprintf(&final_name, "%s:server", name);
+  p.server = grpc_shm_endpoint_create(&server_fds, false, args, final_name);
+  gpr_free(final_name);
+  return p;
+}
+
+#endif /* GRPC_LINUX_EVENTFD */
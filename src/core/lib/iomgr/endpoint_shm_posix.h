@@ -0,0 +1,80 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_ENDPOINT_SHM_POSIX_H
+#define GRPC_CORE_LIB_IOMGR_ENDPOINT_SHM_POSIX_H
+/*
+   An endpoint between two processes on the same host over shared memory, for
+   transports such as chttp2 to run on instead of a loopback socket.
+
+   Each direction is a ring buffer in a shared memory region (see shm_ring.h),
+   so sending bytes is a copy into the region and receiving them a copy out,
+   with no system call while both sides keep up. A side that runs out of data
+   to read or room to write sleeps on its own eventfd, which the other side
+   signals once it has made progress.
+
+   The region and the two eventfds are set up by one process and handed to
+   the other over a unix socket they already share. Linux only.
+*/
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/port.h"
+
+/* The file descriptors shared by the two sides of an endpoint: the memory
+   region holding both rings, and each side's eventfd. */
+typedef struct {
+  int region_fd;
+  int client_event_fd;
+  int server_event_fd;
+} grpc_shm_endpoint_fds;
+
+/* Creates the shared memory and eventfds for an endpoint whose rings hold
+   ring_size bytes each, which must be a power of two. */
+grpc_error* grpc_shm_endpoint_fds_create(size_t ring_size,
+                                         grpc_shm_endpoint_fds* fds);
+
+/* Sends fds over the connected unix socket, to the process that will create
+   the other side of the endpoint. Does not close them. */
+grpc_error* grpc_shm_endpoint_fds_send(int unix_socket,
+                                       const grpc_shm_endpoint_fds* fds);
+
+/* Receives the fds sent by grpc_shm_endpoint_fds_send(). Blocks until they
+   arrive unless the socket is non-blocking. */
+grpc_error* grpc_shm_endpoint_fds_receive(int unix_socket,
+                                          grpc_shm_endpoint_fds* fds);
+
+/* Creates one side of an endpoint, taking ownership of fds. The endpoint is
+   the client side if is_client; the other process creates the other side from
+   its copy of the fds. Reads GRPC_ARG_RESOURCE_QUOTA from args. */
+grpc_endpoint* grpc_shm_endpoint_create(const grpc_shm_endpoint_fds* fds,
+                                        bool is_client,
+                                        const grpc_channel_args* args,
+                                        const char* peer_string);
+
+/* Creates both sides of an endpoint in this process, mostly for tests. */
+grpc_endpoint_pair grpc_shm_endpoint_pair_create(const char* name,
+                                                 size_t ring_size,
+                                                 const grpc_channel_args* args);
+
+#endif /* GRPC_CORE_LIB_IOMGR_ENDPOINT_SHM_POSIX_H */
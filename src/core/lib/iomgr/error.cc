@@ -123,8 +123,27 @@ static const char* error_time_name(grpc_error_times key) {
   GPR_UNREACHABLE_CODE(return "unknown");
 }
 
+// The refcount of an immortal error. It is never changed, so it is never 1
+// and grpc_error_set_* always copy the error rather than modifying it.
+#define IMMORTAL_REFS GPR_ATM_MAX
+
+static bool is_immortal(grpc_error* err) {
+  return gpr_atm_no_barrier_load(&err->atomics.refs.count) ==
+         static_cast<gpr_atm>(IMMORTAL_REFS);
+}
+
+grpc_error* grpc_error_make_immortal(grpc_error* err) {
+  if (grpc_error_is_special(err)) return err;
+  // Its creation time would only be that of its first use.
+  err->times[GRPC_ERROR_TIME_CREATED] = UINT8_MAX;
+  gpr_atm_no_barrier_store(&err->atomics.refs.count,
+                           static_cast<gpr_atm>(IMMORTAL_REFS));
+  return err;
+}
+
 #ifndef NDEBUG
 grpc_error* grpc_error_do_ref(grpc_error* err, const char* file, int line) {
+  if (is_immortal(err)) return err;
   if (grpc_trace_error_refcount.enabled()) {
     gpr_log(GPR_DEBUG, "%p: %" PRIdPTR " -> %" PRIdPTR " [%s:%d]", err,
             gpr_atm_no_barrier_load(&err->atomics.refs.count),
@@ -135,6 +154,7 @@ grpc_error* grpc_error_do_ref(grpc_error* err, const char* file, int line) {
 }
 #else
 grpc_error* grpc_error_do_ref(grpc_error* err) {
+  if (is_immortal(err)) return err;
   gpr_ref(&err->atomics.refs);
   return err;
 }
@@ -172,6 +192,7 @@ static void error_destroy(grpc_error* err) {
 
 #ifndef NDEBUG
 void grpc_error_do_unref(grpc_error* err, const char* file, int line) {
+  if (is_immortal(err)) return;
   if (grpc_trace_error_refcount.enabled()) {
     gpr_log(GPR_DEBUG, "%p: %" PRIdPTR " -> %" PRIdPTR " [%s:%d]", err,
             gpr_atm_no_barrier_load(&err->atomics.refs.count),
@@ -183,6 +204,7 @@ void grpc_error_do_unref(grpc_error* err, const char* file, int line) {
 }
 #else
 void grpc_error_do_unref(grpc_error* err) {
+  if (is_immortal(err)) return;
   if (gpr_unref(&err->atomics.refs)) {
     error_destroy(err);
   }
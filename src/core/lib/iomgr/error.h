@@ -168,6 +168,27 @@ grpc_error* grpc_error_create(const char* file, int line,
   grpc_error_create(__FILE__, __LINE__, grpc_slice_from_copied_string(desc), \
                     errs, count)
 
+/// Marks \a err as immortal and returns it: it is never destroyed, and
+/// GRPC_ERROR_REF and GRPC_ERROR_UNREF leave it alone. grpc_error_set_* and
+/// grpc_error_add_child return a copy of it rather than modifying it.
+/// Immortal errors carry no creation time. Use GRPC_ERROR_IMMORTAL instead.
+grpc_error* grpc_error_make_immortal(grpc_error* err);
+
+/// Evaluates \a create, an expression creating an error from constants only,
+/// the first time it is reached, and returns the same immortal error from then
+/// on. For errors created very often on hot paths, whose creation time does not
+/// matter, this takes no allocation and costs no more than a special error:
+///   return GRPC_ERROR_IMMORTAL(grpc_error_set_int(
+///       GRPC_ERROR_CREATE_FROM_STATIC_STRING("Deadline Exceeded"),
+///       GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_DEADLINE_EXCEEDED));
+/// As with any other error, the caller owns the returned reference.
+#define GRPC_ERROR_IMMORTAL(create)                                     \
+  ([] {                                                                 \
+    static grpc_error* const immortal_error = grpc_error_make_immortal( \
+        create);                                                        \
+    return immortal_error;                                              \
+  }())
+
 #define GRPC_ERROR_CREATE_FROM_VECTOR(desc, error_list) \
   grpc_error_create_from_vector(__FILE__, __LINE__, desc, error_list)
 
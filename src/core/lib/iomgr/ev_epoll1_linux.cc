@@ -46,6 +46,7 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/ev_posix.h"
@@ -54,6 +55,11 @@
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/lib/profiling/timers.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_epoll_batch_events, false,
+    "If set, the designated poller handles every event returned by an "
+    "epoll_wait before flushing, rather than handing them out one at a time");
+
 static grpc_wakeup_fd global_wakeup_fd;
 
 /*******************************************************************************
@@ -63,6 +69,13 @@ static grpc_wakeup_fd global_wakeup_fd;
 #define MAX_EPOLL_EVENTS 100
 #define MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION 1
 
+/* How many events process_epoll_events() handles per call: either
+   MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION, or MAX_EPOLL_EVENTS when the
+   GRPC_EPOLL_BATCH_EVENTS mode is on, in which case the closures of every fd
+   made ready by one epoll_wait run back to back in a single exec_ctx flush */
+static int g_events_handled_per_iteration =
+    MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION;
+
 /* NOTE ON SYNCHRONIZATION:
  * - Fields in this struct are only modified by the designated poller. Hence
  *   there is no need for any locks to protect the struct.
@@ -219,6 +232,13 @@ struct grpc_pollset {
    * worker list */
   int begin_refs;
 
+  /* The longest the designated poller spins on epoll_wait before blocking, in
+     microseconds, or 0 if it never spins. See grpc_pollset_enable_busy_poll */
+  gpr_atm busy_poll_max_us;
+  /* How long the designated poller spins next time: reset to the maximum
+     when events arrive within it, halved when they do not */
+  gpr_atm busy_poll_us;
+
   grpc_pollset* next;
   grpc_pollset* prev;
 };
@@ -554,9 +574,17 @@ static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
   pollset->shutting_down = false;
   pollset->shutdown_closure = nullptr;
   pollset->begin_refs = 0;
+  gpr_atm_no_barrier_store(&pollset->busy_poll_max_us, 0);
+  gpr_atm_no_barrier_store(&pollset->busy_poll_us, 0);
   pollset->next = pollset->prev = nullptr;
 }
 
+static void pollset_enable_busy_poll(grpc_pollset* pollset,
+                                     int max_budget_us) {
+  gpr_atm_no_barrier_store(&pollset->busy_poll_max_us, max_budget_us);
+  gpr_atm_no_barrier_store(&pollset->busy_poll_us, max_budget_us);
+}
+
 static void pollset_destroy(grpc_pollset* pollset) {
   gpr_mu_lock(&pollset->mu);
   if (!pollset->seen_inactive) {
@@ -652,8 +680,8 @@ static int poll_deadline_to_millis_timeout(grpc_millis millis) {
 
 /* Process the epoll events found by do_epoll_wait() function.
    - g_epoll_set.cursor points to the index of the first event to be processed
-   - This function then processes up-to MAX_EPOLL_EVENTS_PER_ITERATION and
-     updates the g_epoll_set.cursor
+   - This function then processes up-to g_events_handled_per_iteration events
+     and updates the g_epoll_set.cursor
 
    NOTE ON SYNCRHONIZATION: Similar to do_epoll_wait(), this function is only
    called by g_active_poller thread. So there is no need for synchronization
@@ -665,8 +693,8 @@ static grpc_error* process_epoll_events(grpc_pollset* pollset) {
   grpc_error* error = GRPC_ERROR_NONE;
   long num_events = gpr_atm_acq_load(&g_epoll_set.num_events);
   long cursor = gpr_atm_acq_load(&g_epoll_set.cursor);
-  for (int idx = 0;
-       (idx < MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION) && cursor != num_events;
+  int idx;
+  for (idx = 0; (idx < g_events_handled_per_iteration) && cursor != num_events;
        idx++) {
     long c = cursor++;
     struct epoll_event* ev = &g_epoll_set.events[c];
@@ -700,9 +728,44 @@ static grpc_error* process_epoll_events(grpc_pollset* pollset) {
     }
   }
   gpr_atm_rel_store(&g_epoll_set.cursor, cursor);
+  GRPC_STATS_INC_POLL_EVENTS_PROCESSED(idx);
   return error;
 }
 
+/* Polls g_epoll_set without blocking until events arrive, or until the current
+   busy poll budget of ps (capped by timeout, in milliseconds, unless it is -1)
+   has passed since wait_start. Returns what the last epoll_wait returned. The
+   budget adapts to the load: it is reset to max_us when the spin finds events,
+   and halved when it does not, so that a pollset whose events mostly come
+   later than its budget soon stops spinning. */
+static int busy_poll(grpc_pollset* ps, int64_t max_us, int timeout,
+                     gpr_timespec wait_start) {
+  int64_t budget_us = gpr_atm_no_barrier_load(&ps->busy_poll_us);
+  if (budget_us > max_us) budget_us = max_us;
+  if (timeout > 0 && budget_us > timeout * GPR_US_PER_MS) {
+    budget_us = timeout * GPR_US_PER_MS;
+  }
+  if (budget_us <= 0) return 0;
+  GPR_TIMER_SCOPE("busy_poll", 0);
+  const gpr_timespec spin_end = gpr_time_add(
+      wait_start, gpr_time_from_micros(budget_us, GPR_TIMESPAN));
+  int r;
+  do {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS, 0);
+  } while ((r == 0 || (r < 0 && errno == EINTR)) &&
+           gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), spin_end) < 0);
+  if (r < 0 && errno == EINTR) r = 0;
+  if (r > 0) {
+    GRPC_STATS_INC_BUSY_POLL_HITS();
+    gpr_atm_no_barrier_store(&ps->busy_poll_us, max_us);
+  } else if (r == 0) {
+    GRPC_STATS_INC_BUSY_POLL_MISSES();
+    gpr_atm_no_barrier_store(&ps->busy_poll_us, budget_us / 2);
+  }
+  return r;
+}
+
 /* Do epoll_wait and store the events in g_epoll_set.events field. This does not
    "process" any of the events yet; that is done in process_epoll_events().
    *See process_epoll_events() function for more details.
@@ -713,18 +776,36 @@ static grpc_error* process_epoll_events(grpc_pollset* pollset) {
 static grpc_error* do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
   GPR_TIMER_SCOPE("do_epoll_wait", 0);
 
-  int r;
+  int r = 0;
   int timeout = poll_deadline_to_millis_timeout(deadline);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  const int64_t busy_poll_max_us =
+      timeout != 0 ? gpr_atm_no_barrier_load(&ps->busy_poll_max_us) : 0;
+  gpr_timespec wait_start = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  if (busy_poll_max_us > 0) {
+    wait_start = gpr_now(GPR_CLOCK_MONOTONIC);
+    r = busy_poll(ps, busy_poll_max_us, timeout, wait_start);
+    if (r == 0) timeout = poll_deadline_to_millis_timeout(deadline);
   }
-  do {
-    GRPC_STATS_INC_SYSCALL_POLL();
-    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
-                   timeout);
-  } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (r == 0) {
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
+                     timeout);
+    } while (r < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
+    /* Events that came soon after the spin gave up would have been caught by
+       a full one: spin for the whole budget again */
+    if (r > 0 && busy_poll_max_us > 0 &&
+        gpr_time_cmp(gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), wait_start),
+                     gpr_time_from_micros(busy_poll_max_us, GPR_TIMESPAN)) <=
+            0) {
+      gpr_atm_no_barrier_store(&ps->busy_poll_us, busy_poll_max_us);
+    }
   }
 
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
@@ -1291,6 +1372,7 @@ static const grpc_event_engine_vtable vtable = {
     pollset_work,
     pollset_kick,
     pollset_add_fd,
+    pollset_enable_busy_poll,
 
     pollset_set_create,
     pollset_set_destroy,
@@ -1337,6 +1419,11 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request) {
 
   fd_global_init();
 
+  g_events_handled_per_iteration =
+      GPR_GLOBAL_CONFIG_GET(grpc_epoll_batch_events)
+          ? MAX_EPOLL_EVENTS
+          : MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION;
+
   if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
     fd_global_shutdown();
     epoll_set_shutdown();
@@ -1586,6 +1586,7 @@ static const grpc_event_engine_vtable vtable = {
     pollset_work,
     pollset_kick,
     pollset_add_fd,
+    nullptr, /* pollset_enable_busy_poll */
 
     pollset_set_create,
     pollset_set_unref,  // destroy ==> unref 1 public ref
@@ -36,6 +36,7 @@
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
 #include "src/core/lib/iomgr/ev_epollex_linux.h"
 #include "src/core/lib/iomgr/ev_poll_posix.h"
+#include "src/core/lib/iomgr/ev_uring_linux.h"
 #include "src/core/lib/iomgr/internal_errqueue.h"
 
 GPR_GLOBAL_CONFIG_DEFINE_STRING(
@@ -131,9 +132,10 @@ static event_engine_factory g_factories[] = {
     {ENGINE_HEAD_CUSTOM, nullptr},        {ENGINE_HEAD_CUSTOM, nullptr},
     {ENGINE_HEAD_CUSTOM, nullptr},        {ENGINE_HEAD_CUSTOM, nullptr},
     {"epollex", grpc_init_epollex_linux}, {"epoll1", grpc_init_epoll1_linux},
-    {"poll", grpc_init_poll_posix},       {"none", init_non_polling},
-    {ENGINE_TAIL_CUSTOM, nullptr},        {ENGINE_TAIL_CUSTOM, nullptr},
+    {"uring", grpc_init_uring_linux},     {"poll", grpc_init_poll_posix},
+    {"none", init_non_polling},           {ENGINE_TAIL_CUSTOM, nullptr},
     {ENGINE_TAIL_CUSTOM, nullptr},        {ENGINE_TAIL_CUSTOM, nullptr},
+    {ENGINE_TAIL_CUSTOM, nullptr},
 };
 
 static void add(const char* beg, const char* end, char*** ss, size_t* ns) {
@@ -339,6 +341,15 @@ void grpc_pollset_add_fd(grpc_pollset* pollset, struct grpc_fd* fd) {
   g_event_engine->pollset_add_fd(pollset, fd);
 }
 
+static void pollset_enable_busy_poll(grpc_pollset* pollset,
+                                     int max_budget_us) {
+  GRPC_POLLING_API_TRACE("pollset_enable_busy_poll(%p, %d)", pollset,
+                         max_budget_us);
+  if (g_event_engine->pollset_enable_busy_poll != nullptr) {
+    g_event_engine->pollset_enable_busy_poll(pollset, max_budget_us);
+  }
+}
+
 void pollset_global_init() {}
 void pollset_global_shutdown() {}
 
@@ -346,7 +357,8 @@ grpc_pollset_vtable grpc_posix_pollset_vtable = {
     pollset_global_init, pollset_global_shutdown,
     pollset_init,        pollset_shutdown,
     pollset_destroy,     pollset_work,
-    pollset_kick,        pollset_size};
+    pollset_kick,        pollset_size,
+    pollset_enable_busy_poll};
 
 static grpc_pollset_set* pollset_set_create(void) {
   grpc_pollset_set* pss = g_event_engine->pollset_set_create();
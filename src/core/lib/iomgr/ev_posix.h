@@ -70,6 +70,8 @@ typedef struct grpc_event_engine_vtable {
   grpc_error* (*pollset_kick)(grpc_pollset* pollset,
                               grpc_pollset_worker* specific_worker);
   void (*pollset_add_fd)(grpc_pollset* pollset, struct grpc_fd* fd);
+  /* May be null if the engine cannot busy poll */
+  void (*pollset_enable_busy_poll)(grpc_pollset* pollset, int max_budget_us);
 
   grpc_pollset_set* (*pollset_set_create)(void);
   void (*pollset_set_destroy)(grpc_pollset_set* pollset_set);
@@ -0,0 +1,1693 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#include <grpc/support/log.h>
+
+/* This polling engine is only relevant on linux kernels supporting io_uring
+   with multishot poll requests */
+#ifdef GRPC_LINUX_IO_URING
+#include "src/core/lib/iomgr/ev_uring_linux.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/iomgr/block_annotate.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/iomgr/lockfree_event.h"
+#include "src/core/lib/iomgr/wakeup_fd_posix.h"
+#include "src/core/lib/profiling/timers.h"
+
+static grpc_wakeup_fd global_wakeup_fd;
+
+/*******************************************************************************
+ * Singleton io_uring related fields
+ */
+
+#define URING_SQ_ENTRIES 1024
+#define URING_CQ_ENTRIES 16384
+#define MAX_URING_EVENTS 100
+#define MAX_URING_EVENTS_HANDLED_PER_ITERATION 1
+
+/* Events every fd is polled for. POLLERR and POLLHUP are always reported. */
+#define URING_POLL_EVENTS (POLLIN | POLLPRI | POLLOUT | POLLERR | POLLHUP)
+
+/* user_data tags for completions that do not belong to a grpc_fd. grpc_fd
+ * pointers are word aligned, so these never collide with them. */
+#define URING_TAG_IGNORE 0
+#define URING_TAG_WAKEUP 1
+
+/* A completion reaped from the completion queue */
+typedef struct uring_event {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+} uring_event;
+
+/* NOTE ON SYNCHRONIZATION:
+ * - The submission queue may be written by any thread (fds are created and
+ *   orphaned everywhere), so it is guarded by sq_mu. The kernel consumes every
+ *   published entry on each io_uring_enter() call, so any thread entering the
+ *   ring submits entries queued by others too.
+ * - The completion queue and the events array are only accessed by the
+ *   designated poller. num_events and cursor are atomic only to provide memory
+ *   visibility guarantees, as in the epoll1 engine.
+ */
+typedef struct uring_set {
+  int ring_fd;
+
+  gpr_mu sq_mu;
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned* sq_ring_mask;
+  unsigned* sq_array;
+  unsigned sq_entries;
+  struct io_uring_sqe* sqes;
+
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned* cq_ring_mask;
+  struct io_uring_cqe* cqes;
+
+  void* sq_ring_ptr;
+  size_t sq_ring_size;
+  void* cq_ring_ptr;
+  size_t cq_ring_size;
+  size_t sqes_size;
+
+  /* The completions reaped by the last call to do_uring_wait() */
+  uring_event events[MAX_URING_EVENTS];
+
+  /* The number of completions reaped by the last call to do_uring_wait() */
+  gpr_atm num_events;
+
+  /* Index of the first event in events that has to be processed. This field is
+   * only valid if num_events > 0 */
+  gpr_atm cursor;
+} uring_set;
+
+/* The global singleton io_uring */
+static uring_set g_uring_set;
+
+static int uring_enter(unsigned to_submit, unsigned min_complete,
+                       unsigned flags, const void* arg, size_t arg_size) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, g_uring_set.ring_fd,
+                                  to_submit, min_complete, flags, arg,
+                                  arg_size));
+}
+
+/* Must be called *only* once */
+static bool uring_set_init() {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = URING_CQ_ENTRIES;
+  g_uring_set.ring_fd = static_cast<int>(
+      syscall(__NR_io_uring_setup, URING_SQ_ENTRIES, &params));
+  if (g_uring_set.ring_fd < 0) {
+    gpr_log(GPR_ERROR, "io_uring_setup unavailable: %s", strerror(errno));
+    return false;
+  }
+  /* Waiting with a timeout needs IORING_ENTER_EXT_ARG (linux 5.11) */
+  if ((params.features & IORING_FEAT_EXT_ARG) == 0) {
+    gpr_log(GPR_ERROR, "io_uring lacks IORING_FEAT_EXT_ARG");
+    close(g_uring_set.ring_fd);
+    g_uring_set.ring_fd = -1;
+    return false;
+  }
+
+  g_uring_set.sq_ring_size =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  g_uring_set.cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    g_uring_set.sq_ring_size =
+        GPR_MAX(g_uring_set.sq_ring_size, g_uring_set.cq_ring_size);
+    g_uring_set.cq_ring_size = g_uring_set.sq_ring_size;
+  }
+  g_uring_set.sq_ring_ptr =
+      mmap(nullptr, g_uring_set.sq_ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, g_uring_set.ring_fd, IORING_OFF_SQ_RING);
+  g_uring_set.cq_ring_ptr =
+      single_mmap ? g_uring_set.sq_ring_ptr
+                  : mmap(nullptr, g_uring_set.cq_ring_size,
+                         PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         g_uring_set.ring_fd, IORING_OFF_CQ_RING);
+  g_uring_set.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  g_uring_set.sqes = static_cast<struct io_uring_sqe*>(
+      mmap(nullptr, g_uring_set.sqes_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, g_uring_set.ring_fd, IORING_OFF_SQES));
+  if (g_uring_set.sq_ring_ptr == MAP_FAILED ||
+      g_uring_set.cq_ring_ptr == MAP_FAILED ||
+      g_uring_set.sqes == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "io_uring mmap failed: %s", strerror(errno));
+    if (g_uring_set.sq_ring_ptr != MAP_FAILED) {
+      munmap(g_uring_set.sq_ring_ptr, g_uring_set.sq_ring_size);
+    }
+    if (!single_mmap && g_uring_set.cq_ring_ptr != MAP_FAILED) {
+      munmap(g_uring_set.cq_ring_ptr, g_uring_set.cq_ring_size);
+    }
+    if (g_uring_set.sqes != MAP_FAILED) {
+      munmap(g_uring_set.sqes, g_uring_set.sqes_size);
+    }
+    close(g_uring_set.ring_fd);
+    g_uring_set.ring_fd = -1;
+    return false;
+  }
+
+  char* sq = static_cast<char*>(g_uring_set.sq_ring_ptr);
+  g_uring_set.sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  g_uring_set.sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  g_uring_set.sq_ring_mask =
+      reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  g_uring_set.sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  g_uring_set.sq_entries = params.sq_entries;
+  char* cq = static_cast<char*>(g_uring_set.cq_ring_ptr);
+  g_uring_set.cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  g_uring_set.cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  g_uring_set.cq_ring_mask =
+      reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  g_uring_set.cqes =
+      reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  gpr_mu_init(&g_uring_set.sq_mu);
+  gpr_log(GPR_INFO, "grpc io_uring fd: %d", g_uring_set.ring_fd);
+  gpr_atm_no_barrier_store(&g_uring_set.num_events, 0);
+  gpr_atm_no_barrier_store(&g_uring_set.cursor, 0);
+  return true;
+}
+
+/* uring_set_init() MUST be called before calling this. */
+static void uring_set_shutdown() {
+  if (g_uring_set.ring_fd >= 0) {
+    munmap(g_uring_set.sqes, g_uring_set.sqes_size);
+    if (g_uring_set.cq_ring_ptr != g_uring_set.sq_ring_ptr) {
+      munmap(g_uring_set.cq_ring_ptr, g_uring_set.cq_ring_size);
+    }
+    munmap(g_uring_set.sq_ring_ptr, g_uring_set.sq_ring_size);
+    close(g_uring_set.ring_fd);
+    g_uring_set.ring_fd = -1;
+    gpr_mu_destroy(&g_uring_set.sq_mu);
+  }
+}
+
+/* Queues a submission. If submit_now is false the entry is only published
+ * and is picked up by the next io_uring_enter() on any thread, which lets the
+ * designated poller batch its own submissions into its next wait. Entries
+ * queued from other threads must be submitted right away since the poller
+ * may already be blocked in the kernel. */
+static grpc_error* uring_queue_sqe(uint8_t opcode, int fd, uint64_t addr,
+                                   uint32_t len, uint32_t poll_events,
+                                   uint64_t user_data, bool submit_now) {
+  grpc_error* error = GRPC_ERROR_NONE;
+  gpr_mu_lock(&g_uring_set.sq_mu);
+  unsigned tail = *g_uring_set.sq_tail;
+  if (tail - __atomic_load_n(g_uring_set.sq_head, __ATOMIC_ACQUIRE) ==
+      g_uring_set.sq_entries) {
+    /* The ring is full of entries the poller has not submitted yet. */
+    GRPC_STATS_INC_SYSCALL_WRITE();
+    if (uring_enter(g_uring_set.sq_entries, 0, 0, nullptr, 0) < 0) {
+      error = GRPC_OS_ERROR(errno, "io_uring_enter");
+      gpr_mu_unlock(&g_uring_set.sq_mu);
+      return error;
+    }
+  }
+  unsigned idx = tail & *g_uring_set.sq_ring_mask;
+  struct io_uring_sqe* sqe = &g_uring_set.sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = addr;
+  sqe->len = len;
+  sqe->poll32_events = poll_events;
+  sqe->user_data = user_data;
+  g_uring_set.sq_array[idx] = idx;
+  __atomic_store_n(g_uring_set.sq_tail, tail + 1, __ATOMIC_RELEASE);
+  if (submit_now) {
+    int r;
+    do {
+      GRPC_STATS_INC_SYSCALL_WRITE();
+      r = uring_enter(g_uring_set.sq_entries, 0, 0, nullptr, 0);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0) error = GRPC_OS_ERROR(errno, "io_uring_enter");
+  }
+  gpr_mu_unlock(&g_uring_set.sq_mu);
+  return error;
+}
+
+/* Registers a multishot poll for fd, which (like EPOLLET) posts a completion
+ * every time the file's wait queue is woken rather than only once. */
+static grpc_error* uring_poll_add(int fd, uint32_t events, uint64_t user_data,
+                                  bool submit_now) {
+  return uring_queue_sqe(IORING_OP_POLL_ADD, fd, 0, IORING_POLL_ADD_MULTI,
+                         events, user_data, submit_now);
+}
+
+static grpc_error* uring_poll_remove(uint64_t target_user_data) {
+  return uring_queue_sqe(IORING_OP_POLL_REMOVE, -1, target_user_data, 0, 0,
+                         URING_TAG_IGNORE, true);
+}
+
+/*******************************************************************************
+ * Fd Declarations
+ */
+
+/* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
+struct grpc_fork_fd_list {
+  grpc_fd* fd;
+  grpc_fd* next;
+  grpc_fd* prev;
+};
+
+struct grpc_fd {
+  int fd;
+
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> read_closure;
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> write_closure;
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> error_closure;
+
+  struct grpc_fd* freelist_next;
+
+  /* Guards poll_armed and orphaned against the designated poller, which
+   * re-arms the poll request or freelists the fd on a terminal completion. */
+  gpr_mu uring_mu;
+  /* True while a multishot poll request for this fd is live in the ring */
+  bool poll_armed;
+  bool orphaned;
+  bool track_err;
+
+  grpc_iomgr_object iomgr_object;
+
+  /* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
+  grpc_fork_fd_list* fork_fd_list;
+};
+
+static void fd_global_init(void);
+static void fd_global_shutdown(void);
+static void fd_freelist_push(grpc_fd* fd);
+
+/*******************************************************************************
+ * Pollset Declarations
+ */
+
+typedef enum { UNKICKED, KICKED, DESIGNATED_POLLER } kick_state;
+
+static const char* kick_state_string(kick_state st) {
+  switch (st) {
+    case UNKICKED:
+      return "UNKICKED";
+    case KICKED:
+      return "KICKED";
+    case DESIGNATED_POLLER:
+      return "DESIGNATED_POLLER";
+  }
+  GPR_UNREACHABLE_CODE(return "UNKNOWN");
+}
+
+struct grpc_pollset_worker {
+  kick_state state;
+  int kick_state_mutator;  // which line of code last changed kick state
+  bool initialized_cv;
+  grpc_pollset_worker* next;
+  grpc_pollset_worker* prev;
+  gpr_cv cv;
+  grpc_closure_list schedule_on_end_work;
+};
+
+#define SET_KICK_STATE(worker, kick_state)   \
+  do {                                       \
+    (worker)->state = (kick_state);          \
+    (worker)->kick_state_mutator = __LINE__; \
+  } while (false)
+
+#define MAX_NEIGHBORHOODS 1024
+
+typedef struct pollset_neighborhood {
+  union {
+    char pad[GPR_CACHELINE_SIZE];
+    struct {
+      gpr_mu mu;
+      grpc_pollset* active_root;
+    };
+  };
+} pollset_neighborhood;
+
+struct grpc_pollset {
+  gpr_mu mu;
+  pollset_neighborhood* neighborhood;
+  bool reassigning_neighborhood;
+  grpc_pollset_worker* root_worker;
+  bool kicked_without_poller;
+
+  /* Set to true if the pollset is observed to have no workers available to
+     poll */
+  bool seen_inactive;
+  bool shutting_down;             /* Is the pollset shutting down ? */
+  grpc_closure* shutdown_closure; /* Called after shutdown is complete */
+
+  /* Number of workers who are *about-to* attach themselves to the pollset
+   * worker list */
+  int begin_refs;
+
+  grpc_pollset* next;
+  grpc_pollset* prev;
+};
+
+/*******************************************************************************
+ * Pollset-set Declarations
+ */
+
+struct grpc_pollset_set {
+  char unused;
+};
+
+/*******************************************************************************
+ * Common helpers
+ */
+
+static bool append_error(grpc_error** composite, grpc_error* error,
+                         const char* desc) {
+  if (error == GRPC_ERROR_NONE) return true;
+  if (*composite == GRPC_ERROR_NONE) {
+    *composite = GRPC_ERROR_CREATE_FROM_COPIED_STRING(desc);
+  }
+  *composite = grpc_error_add_child(*composite, error);
+  return false;
+}
+
+/*******************************************************************************
+ * Fd Definitions
+ */
+
+/* We need to keep a freelist not because of any concerns of malloc performance
+ * but instead so that implementations with multiple threads in (for example)
+ * epoll_wait deal with the race between pollset removal and incoming poll
+ * notifications.
+ *
+ * The problem is that the poller ultimately holds a reference to this
+ * object, so it is very difficult to know when is safe to free it, at least
+ * without some expensive synchronization.
+ *
+ * With io_uring the ring tells us when it is done with an fd: the multishot
+ * poll request posts a final completion without IORING_CQE_F_MORE once it has
+ * been removed. Orphaned fds are only freelisted after that completion.
+ *
+ * If we keep the object freelisted, in the worst case losing this race just
+ * becomes a spurious read notification on a reused fd.
+ */
+
+/* The alarm system needs to be able to wakeup 'some poller' sometimes
+ * (specifically when a new alarm needs to be triggered earlier than the next
+ * alarm 'epoch'). This wakeup_fd gives us something to alert on when such a
+ * case occurs. */
+
+static grpc_fd* fd_freelist = nullptr;
+static gpr_mu fd_freelist_mu;
+
+/* Number of orphaned fds still waiting for their final poll completion */
+static gpr_atm g_pending_orphans;
+
+/* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
+static grpc_fd* fork_fd_list_head = nullptr;
+static gpr_mu fork_fd_list_mu;
+
+static void fd_global_init(void) {
+  gpr_mu_init(&fd_freelist_mu);
+  gpr_atm_no_barrier_store(&g_pending_orphans, 0);
+}
+
+static void fd_global_shutdown(void) {
+  // TODO(guantaol): We don't have a reasonable explanation about this
+  // lock()/unlock() pattern. It can be a valid barrier if there is at most one
+  // pending lock() at this point. Otherwise, there is still a possibility of
+  // use-after-free race. Need to reason about the code and/or clean it up.
+  gpr_mu_lock(&fd_freelist_mu);
+  gpr_mu_unlock(&fd_freelist_mu);
+  while (fd_freelist != nullptr) {
+    grpc_fd* fd = fd_freelist;
+    fd_freelist = fd_freelist->freelist_next;
+    gpr_mu_destroy(&fd->uring_mu);
+    gpr_free(fd);
+  }
+  gpr_mu_destroy(&fd_freelist_mu);
+}
+
+static void fd_freelist_push(grpc_fd* fd) {
+  gpr_mu_lock(&fd_freelist_mu);
+  fd->freelist_next = fd_freelist;
+  fd_freelist = fd;
+  gpr_mu_unlock(&fd_freelist_mu);
+}
+
+/* Use the least significant bit of user_data to store track_err. We expect
+ * the addresses to be word aligned. We need to store track_err to avoid
+ * synchronization issues when accessing it after receiving a completion. */
+static uint64_t fd_user_data(grpc_fd* fd) {
+  return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(fd) |
+                               (fd->track_err ? 1 : 0));
+}
+
+/* Arms the multishot poll request for fd. Called with fd->uring_mu held. */
+static void fd_arm_poll_locked(grpc_fd* fd, bool submit_now) {
+  grpc_error* err =
+      uring_poll_add(fd->fd, URING_POLL_EVENTS, fd_user_data(fd), submit_now);
+  if (err != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "io_uring poll add failed: %s", grpc_error_string(err));
+    GRPC_ERROR_UNREF(err);
+    return;
+  }
+  fd->poll_armed = true;
+}
+
+static void fork_fd_list_add_grpc_fd(grpc_fd* fd) {
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_lock(&fork_fd_list_mu);
+    fd->fork_fd_list =
+        static_cast<grpc_fork_fd_list*>(gpr_malloc(sizeof(grpc_fork_fd_list)));
+    fd->fork_fd_list->next = fork_fd_list_head;
+    fd->fork_fd_list->prev = nullptr;
+    if (fork_fd_list_head != nullptr) {
+      fork_fd_list_head->fork_fd_list->prev = fd;
+    }
+    fork_fd_list_head = fd;
+    gpr_mu_unlock(&fork_fd_list_mu);
+  }
+}
+
+static void fork_fd_list_remove_grpc_fd(grpc_fd* fd) {
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_lock(&fork_fd_list_mu);
+    if (fork_fd_list_head == fd) {
+      fork_fd_list_head = fd->fork_fd_list->next;
+    }
+    if (fd->fork_fd_list->prev != nullptr) {
+      fd->fork_fd_list->prev->fork_fd_list->next = fd->fork_fd_list->next;
+    }
+    if (fd->fork_fd_list->next != nullptr) {
+      fd->fork_fd_list->next->fork_fd_list->prev = fd->fork_fd_list->prev;
+    }
+    gpr_free(fd->fork_fd_list);
+    gpr_mu_unlock(&fork_fd_list_mu);
+  }
+}
+
+static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
+  grpc_fd* new_fd = nullptr;
+
+  gpr_mu_lock(&fd_freelist_mu);
+  if (fd_freelist != nullptr) {
+    new_fd = fd_freelist;
+    fd_freelist = fd_freelist->freelist_next;
+  }
+  gpr_mu_unlock(&fd_freelist_mu);
+
+  if (new_fd == nullptr) {
+    new_fd = static_cast<grpc_fd*>(gpr_malloc(sizeof(grpc_fd)));
+    new_fd->read_closure.Init();
+    new_fd->write_closure.Init();
+    new_fd->error_closure.Init();
+    gpr_mu_init(&new_fd->uring_mu);
+  }
+  new_fd->fd = fd;
+  new_fd->read_closure->InitEvent();
+  new_fd->write_closure->InitEvent();
+  new_fd->error_closure->InitEvent();
+
+  new_fd->freelist_next = nullptr;
+  new_fd->poll_armed = false;
+  new_fd->orphaned = false;
+  new_fd->track_err = track_err;
+
+  char* fd_name;
+  gpr_asprintf(&fd_name, "%s fd=%d", name, fd);
+  grpc_iomgr_register_object(&new_fd->iomgr_object, fd_name);
+  fork_fd_list_add_grpc_fd(new_fd);
+#ifndef NDEBUG
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_fd_refcount)) {
+    gpr_log(GPR_DEBUG, "FD %d %p create %s", fd, new_fd, fd_name);
+  }
+#endif
+  gpr_free(fd_name);
+
+  gpr_mu_lock(&new_fd->uring_mu);
+  fd_arm_poll_locked(new_fd, true);
+  gpr_mu_unlock(&new_fd->uring_mu);
+
+  return new_fd;
+}
+
+static int fd_wrapped_fd(grpc_fd* fd) { return fd->fd; }
+
+/* if 'releasing_fd' is true, it means that we are going to detach the internal
+ * fd from grpc_fd structure (i.e which means we should not be calling
+ * shutdown() syscall on that fd) */
+static void fd_shutdown_internal(grpc_fd* fd, grpc_error* why,
+                                 bool releasing_fd) {
+  if (fd->read_closure->SetShutdown(GRPC_ERROR_REF(why))) {
+    /* When releasing the fd, the poll request is removed by fd_orphan */
+    if (!releasing_fd) {
+      shutdown(fd->fd, SHUT_RDWR);
+    }
+    fd->write_closure->SetShutdown(GRPC_ERROR_REF(why));
+    fd->error_closure->SetShutdown(GRPC_ERROR_REF(why));
+  }
+  GRPC_ERROR_UNREF(why);
+}
+
+/* Might be called multiple times */
+static void fd_shutdown(grpc_fd* fd, grpc_error* why) {
+  fd_shutdown_internal(fd, why, false);
+}
+
+static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
+                      const char* reason) {
+  grpc_error* error = GRPC_ERROR_NONE;
+  bool is_release_fd = (release_fd != nullptr);
+
+  if (!fd->read_closure->IsShutdown()) {
+    fd_shutdown_internal(fd, GRPC_ERROR_CREATE_FROM_COPIED_STRING(reason),
+                         is_release_fd);
+  }
+
+  /* If release_fd is not NULL, we should be relinquishing control of the file
+     descriptor fd->fd (but we still own the grpc_fd structure). */
+  if (is_release_fd) {
+    *release_fd = fd->fd;
+  } else {
+    close(fd->fd);
+  }
+
+  GRPC_CLOSURE_SCHED(on_done, GRPC_ERROR_REF(error));
+
+  grpc_iomgr_unregister_object(&fd->iomgr_object);
+  fork_fd_list_remove_grpc_fd(fd);
+  fd->read_closure->DestroyEvent();
+  fd->write_closure->DestroyEvent();
+  fd->error_closure->DestroyEvent();
+
+  /* The ring holds its own reference to the file, so closing or releasing the
+   * descriptor does not cancel the poll request. Remove it explicitly and let
+   * the final completion freelist the fd. */
+  gpr_mu_lock(&fd->uring_mu);
+  fd->orphaned = true;
+  bool armed = fd->poll_armed;
+  if (armed) {
+    gpr_atm_no_barrier_fetch_add(&g_pending_orphans, 1);
+    grpc_error* err = uring_poll_remove(fd_user_data(fd));
+    if (err != GRPC_ERROR_NONE) {
+      gpr_log(GPR_ERROR, "io_uring poll remove failed: %s",
+              grpc_error_string(err));
+      GRPC_ERROR_UNREF(err);
+    }
+  }
+  gpr_mu_unlock(&fd->uring_mu);
+  if (!armed) {
+    fd_freelist_push(fd);
+  }
+}
+
+static bool fd_is_shutdown(grpc_fd* fd) {
+  return fd->read_closure->IsShutdown();
+}
+
+static void fd_notify_on_read(grpc_fd* fd, grpc_closure* closure) {
+  fd->read_closure->NotifyOn(closure);
+}
+
+static void fd_notify_on_write(grpc_fd* fd, grpc_closure* closure) {
+  fd->write_closure->NotifyOn(closure);
+}
+
+static void fd_notify_on_error(grpc_fd* fd, grpc_closure* closure) {
+  fd->error_closure->NotifyOn(closure);
+}
+
+static void fd_become_readable(grpc_fd* fd) { fd->read_closure->SetReady(); }
+
+static void fd_become_writable(grpc_fd* fd) { fd->write_closure->SetReady(); }
+
+static void fd_has_errors(grpc_fd* fd) { fd->error_closure->SetReady(); }
+
+/*******************************************************************************
+ * Pollset Definitions
+ */
+
+GPR_TLS_DECL(g_current_thread_pollset);
+GPR_TLS_DECL(g_current_thread_worker);
+
+/* The designated poller */
+static gpr_atm g_active_poller;
+
+static pollset_neighborhood* g_neighborhoods;
+static size_t g_num_neighborhoods;
+
+/* Return true if first in list */
+static bool worker_insert(grpc_pollset* pollset, grpc_pollset_worker* worker) {
+  if (pollset->root_worker == nullptr) {
+    pollset->root_worker = worker;
+    worker->next = worker->prev = worker;
+    return true;
+  } else {
+    worker->next = pollset->root_worker;
+    worker->prev = worker->next->prev;
+    worker->next->prev = worker;
+    worker->prev->next = worker;
+    return false;
+  }
+}
+
+/* Return true if last in list */
+typedef enum { EMPTIED, NEW_ROOT, REMOVED } worker_remove_result;
+
+static worker_remove_result worker_remove(grpc_pollset* pollset,
+                                          grpc_pollset_worker* worker) {
+  if (worker == pollset->root_worker) {
+    if (worker == worker->next) {
+      pollset->root_worker = nullptr;
+      return EMPTIED;
+    } else {
+      pollset->root_worker = worker->next;
+      worker->prev->next = worker->next;
+      worker->next->prev = worker->prev;
+      return NEW_ROOT;
+    }
+  } else {
+    worker->prev->next = worker->next;
+    worker->next->prev = worker->prev;
+    return REMOVED;
+  }
+}
+
+static size_t choose_neighborhood(void) {
+  return static_cast<size_t>(gpr_cpu_current_cpu()) % g_num_neighborhoods;
+}
+
+static grpc_error* pollset_global_init(void) {
+  gpr_tls_init(&g_current_thread_pollset);
+  gpr_tls_init(&g_current_thread_worker);
+  gpr_atm_no_barrier_store(&g_active_poller, 0);
+  global_wakeup_fd.read_fd = -1;
+  grpc_error* err = grpc_wakeup_fd_init(&global_wakeup_fd);
+  if (err != GRPC_ERROR_NONE) return err;
+  err = uring_poll_add(global_wakeup_fd.read_fd, POLLIN, URING_TAG_WAKEUP,
+                       true);
+  if (err != GRPC_ERROR_NONE) return err;
+  g_num_neighborhoods = GPR_CLAMP(gpr_cpu_num_cores(), 1, MAX_NEIGHBORHOODS);
+  g_neighborhoods = static_cast<pollset_neighborhood*>(
+      gpr_zalloc(sizeof(*g_neighborhoods) * g_num_neighborhoods));
+  for (size_t i = 0; i < g_num_neighborhoods; i++) {
+    gpr_mu_init(&g_neighborhoods[i].mu);
+  }
+  return GRPC_ERROR_NONE;
+}
+
+static void pollset_global_shutdown(void) {
+  gpr_tls_destroy(&g_current_thread_pollset);
+  gpr_tls_destroy(&g_current_thread_worker);
+  if (global_wakeup_fd.read_fd != -1) grpc_wakeup_fd_destroy(&global_wakeup_fd);
+  for (size_t i = 0; i < g_num_neighborhoods; i++) {
+    gpr_mu_destroy(&g_neighborhoods[i].mu);
+  }
+  gpr_free(g_neighborhoods);
+}
+
+static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
+  gpr_mu_init(&pollset->mu);
+  *mu = &pollset->mu;
+  pollset->neighborhood = &g_neighborhoods[choose_neighborhood()];
+  pollset->reassigning_neighborhood = false;
+  pollset->root_worker = nullptr;
+  pollset->kicked_without_poller = false;
+  pollset->seen_inactive = true;
+  pollset->shutting_down = false;
+  pollset->shutdown_closure = nullptr;
+  pollset->begin_refs = 0;
+  pollset->next = pollset->prev = nullptr;
+}
+
+static void pollset_destroy(grpc_pollset* pollset) {
+  gpr_mu_lock(&pollset->mu);
+  if (!pollset->seen_inactive) {
+    pollset_neighborhood* neighborhood = pollset->neighborhood;
+    gpr_mu_unlock(&pollset->mu);
+  retry_lock_neighborhood:
+    gpr_mu_lock(&neighborhood->mu);
+    gpr_mu_lock(&pollset->mu);
+    if (!pollset->seen_inactive) {
+      if (pollset->neighborhood != neighborhood) {
+        gpr_mu_unlock(&neighborhood->mu);
+        neighborhood = pollset->neighborhood;
+        gpr_mu_unlock(&pollset->mu);
+        goto retry_lock_neighborhood;
+      }
+      pollset->prev->next = pollset->next;
+      pollset->next->prev = pollset->prev;
+      if (pollset == pollset->neighborhood->active_root) {
+        pollset->neighborhood->active_root =
+            pollset->next == pollset ? nullptr : pollset->next;
+      }
+    }
+    gpr_mu_unlock(&pollset->neighborhood->mu);
+  }
+  gpr_mu_unlock(&pollset->mu);
+  gpr_mu_destroy(&pollset->mu);
+}
+
+static grpc_error* pollset_kick_all(grpc_pollset* pollset) {
+  GPR_TIMER_SCOPE("pollset_kick_all", 0);
+  grpc_error* error = GRPC_ERROR_NONE;
+  if (pollset->root_worker != nullptr) {
+    grpc_pollset_worker* worker = pollset->root_worker;
+    do {
+      GRPC_STATS_INC_POLLSET_KICK();
+      switch (worker->state) {
+        case KICKED:
+          GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+          break;
+        case UNKICKED:
+          SET_KICK_STATE(worker, KICKED);
+          if (worker->initialized_cv) {
+            GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+            gpr_cv_signal(&worker->cv);
+          }
+          break;
+        case DESIGNATED_POLLER:
+          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+          SET_KICK_STATE(worker, KICKED);
+          append_error(&error, grpc_wakeup_fd_wakeup(&global_wakeup_fd),
+                       "pollset_kick_all");
+          break;
+      }
+
+      worker = worker->next;
+    } while (worker != pollset->root_worker);
+  }
+  // TODO: sreek.  Check if we need to set 'kicked_without_poller' to true here
+  // in the else case
+  return error;
+}
+
+static void pollset_maybe_finish_shutdown(grpc_pollset* pollset) {
+  if (pollset->shutdown_closure != nullptr && pollset->root_worker == nullptr &&
+      pollset->begin_refs == 0) {
+    GPR_TIMER_MARK("pollset_finish_shutdown", 0);
+    GRPC_CLOSURE_SCHED(pollset->shutdown_closure, GRPC_ERROR_NONE);
+    pollset->shutdown_closure = nullptr;
+  }
+}
+
+static void pollset_shutdown(grpc_pollset* pollset, grpc_closure* closure) {
+  GPR_TIMER_SCOPE("pollset_shutdown", 0);
+  GPR_ASSERT(pollset->shutdown_closure == nullptr);
+  GPR_ASSERT(!pollset->shutting_down);
+  pollset->shutdown_closure = closure;
+  pollset->shutting_down = true;
+  GRPC_LOG_IF_ERROR("pollset_shutdown", pollset_kick_all(pollset));
+  pollset_maybe_finish_shutdown(pollset);
+}
+
+static int poll_deadline_to_millis_timeout(grpc_millis millis) {
+  if (millis == GRPC_MILLIS_INF_FUTURE) return -1;
+  grpc_millis delta = millis - grpc_core::ExecCtx::Get()->Now();
+  if (delta > INT_MAX) {
+    return INT_MAX;
+  } else if (delta < 0) {
+    return 0;
+  } else {
+    return static_cast<int>(delta);
+  }
+}
+
+/* Handles a completion for a grpc_fd poll request that will not post any more
+ * completions: either the request was removed by fd_orphan, or the kernel
+ * terminated the multishot request (e.g. on CQ overflow) and it has to be
+ * re-armed. Only called by the designated poller, which batches the re-arm
+ * into its next io_uring_enter(). */
+static void fd_poll_terminated(grpc_fd* fd) {
+  gpr_mu_lock(&fd->uring_mu);
+  fd->poll_armed = false;
+  bool orphaned = fd->orphaned;
+  if (!orphaned) {
+    fd_arm_poll_locked(fd, false);
+  }
+  gpr_mu_unlock(&fd->uring_mu);
+  if (orphaned) {
+    gpr_atm_no_barrier_fetch_add(&g_pending_orphans, -1);
+    fd_freelist_push(fd);
+  }
+}
+
+/* Copies up to MAX_URING_EVENTS completions out of the completion queue and
+ * returns how many were reaped */
+static int reap_completions() {
+  unsigned head = *g_uring_set.cq_head;
+  unsigned tail = __atomic_load_n(g_uring_set.cq_tail, __ATOMIC_ACQUIRE);
+  int n = 0;
+  while (head != tail && n < MAX_URING_EVENTS) {
+    struct io_uring_cqe* cqe =
+        &g_uring_set.cqes[head & *g_uring_set.cq_ring_mask];
+    g_uring_set.events[n].user_data = cqe->user_data;
+    g_uring_set.events[n].res = cqe->res;
+    g_uring_set.events[n].flags = cqe->flags;
+    n++;
+    head++;
+  }
+  __atomic_store_n(g_uring_set.cq_head, head, __ATOMIC_RELEASE);
+  return n;
+}
+
+/* Process the completions found by do_uring_wait() function.
+   - g_uring_set.cursor points to the index of the first event to be processed
+   - This function then processes up-to MAX_URING_EVENTS_HANDLED_PER_ITERATION
+     and updates the g_uring_set.cursor
+
+   NOTE ON SYNCRHONIZATION: Similar to do_uring_wait(), this function is only
+   called by g_active_poller thread. So there is no need for synchronization
+   when accessing the completion fields in g_uring_set */
+static grpc_error* process_uring_events(grpc_pollset* pollset) {
+  GPR_TIMER_SCOPE("process_uring_events", 0);
+
+  static const char* err_desc = "process_events";
+  grpc_error* error = GRPC_ERROR_NONE;
+  long num_events = gpr_atm_acq_load(&g_uring_set.num_events);
+  long cursor = gpr_atm_acq_load(&g_uring_set.cursor);
+  for (int idx = 0;
+       (idx < MAX_URING_EVENTS_HANDLED_PER_ITERATION) && cursor != num_events;
+       idx++) {
+    long c = cursor++;
+    uring_event* ev = &g_uring_set.events[c];
+    bool terminated = (ev->flags & IORING_CQE_F_MORE) == 0;
+
+    if (ev->user_data == URING_TAG_IGNORE) {
+      /* completion of a poll remove request */
+    } else if (ev->user_data == URING_TAG_WAKEUP) {
+      append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
+                   err_desc);
+      if (terminated) {
+        append_error(&error,
+                     uring_poll_add(global_wakeup_fd.read_fd, POLLIN,
+                                    URING_TAG_WAKEUP, false),
+                     err_desc);
+      }
+    } else {
+      grpc_fd* fd = reinterpret_cast<grpc_fd*>(
+          static_cast<uintptr_t>(ev->user_data) & ~static_cast<uintptr_t>(1));
+      bool track_err = (ev->user_data & 1) != 0;
+      /* A negative result carries no readiness information; -ECANCELED is the
+       * expected result once fd_orphan removed the request. */
+      uint32_t events = ev->res >= 0 ? static_cast<uint32_t>(ev->res) : 0;
+      bool cancel = (events & POLLHUP) != 0;
+      bool error = (events & POLLERR) != 0;
+      bool read_ev = (events & (POLLIN | POLLPRI)) != 0;
+      bool write_ev = (events & POLLOUT) != 0;
+      bool err_fallback = error && !track_err;
+
+      if (error && !err_fallback) {
+        fd_has_errors(fd);
+      }
+
+      if (read_ev || cancel || err_fallback) {
+        fd_become_readable(fd);
+      }
+
+      if (write_ev || cancel || err_fallback) {
+        fd_become_writable(fd);
+      }
+
+      if (terminated) {
+        fd_poll_terminated(fd);
+      }
+    }
+  }
+  gpr_atm_rel_store(&g_uring_set.cursor, cursor);
+  return error;
+}
+
+/* Submits any queued entries, waits for completions and stores them in the
+   g_uring_set.events field. This does not "process" any of the completions
+   yet; that is done in process_uring_events().
+   *See process_uring_events() function for more details.
+
+   NOTE ON SYNCHRONIZATION: At any point of time, only the g_active_poller
+   (i.e the designated poller thread) will be calling this function. So there is
+   no need for any synchronization when accesing the completion fields in
+   g_uring_set */
+static grpc_error* do_uring_wait(grpc_pollset* ps, grpc_millis deadline) {
+  GPR_TIMER_SCOPE("do_uring_wait", 0);
+
+  int r = reap_completions();
+  if (r == 0) {
+    int timeout = poll_deadline_to_millis_timeout(deadline);
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    if (timeout >= 0) {
+      ts.tv_sec = timeout / GPR_MS_PER_SEC;
+      ts.tv_nsec = (timeout % GPR_MS_PER_SEC) * GPR_NS_PER_MS;
+      arg.ts = reinterpret_cast<uint64_t>(&ts);
+    }
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    int ret;
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      /* Entries queued by this thread (re-armed polls) are submitted as part
+       * of the wait */
+      ret = uring_enter(g_uring_set.sq_entries, 1,
+                        IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg,
+                        sizeof(arg));
+    } while (ret < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
+
+    if (ret < 0 && errno != ETIME) {
+      return GRPC_OS_ERROR(errno, "io_uring_enter");
+    }
+    r = reap_completions();
+  }
+
+  GRPC_STATS_INC_POLL_EVENTS_RETURNED(r);
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "ps: %p poll got %d events", ps, r);
+  }
+
+  gpr_atm_rel_store(&g_uring_set.num_events, r);
+  gpr_atm_rel_store(&g_uring_set.cursor, 0);
+
+  return GRPC_ERROR_NONE;
+}
+
+/* Waits (boundedly) for the final completions of orphaned fds so that they
+ * can be freed by fd_global_shutdown(). Only called from shutdown_engine(),
+ * when there are no pollers left. */
+static void drain_pending_orphans() {
+  grpc_core::ExecCtx exec_ctx;
+  for (int attempts = 0;
+       gpr_atm_no_barrier_load(&g_pending_orphans) > 0 && attempts < 10;
+       attempts++) {
+    grpc_error* err = do_uring_wait(
+        nullptr, grpc_core::ExecCtx::Get()->Now() + 100 /* milliseconds */);
+    GRPC_LOG_IF_ERROR("drain_pending_orphans", err);
+    while (gpr_atm_acq_load(&g_uring_set.cursor) !=
+           gpr_atm_acq_load(&g_uring_set.num_events)) {
+      GRPC_LOG_IF_ERROR("drain_pending_orphans", process_uring_events(nullptr));
+    }
+  }
+}
+
+static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
+                         grpc_pollset_worker** worker_hdl,
+                         grpc_millis deadline) {
+  GPR_TIMER_SCOPE("begin_worker", 0);
+  if (worker_hdl != nullptr) *worker_hdl = worker;
+  worker->initialized_cv = false;
+  SET_KICK_STATE(worker, UNKICKED);
+  worker->schedule_on_end_work = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
+  pollset->begin_refs++;
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "PS:%p BEGIN_STARTS:%p", pollset, worker);
+  }
+
+  if (pollset->seen_inactive) {
+    // pollset has been observed to be inactive, we need to move back to the
+    // active list
+    bool is_reassigning = false;
+    if (!pollset->reassigning_neighborhood) {
+      is_reassigning = true;
+      pollset->reassigning_neighborhood = true;
+      pollset->neighborhood = &g_neighborhoods[choose_neighborhood()];
+    }
+    pollset_neighborhood* neighborhood = pollset->neighborhood;
+    gpr_mu_unlock(&pollset->mu);
+  // pollset unlocked: state may change (even worker->kick_state)
+  retry_lock_neighborhood:
+    gpr_mu_lock(&neighborhood->mu);
+    gpr_mu_lock(&pollset->mu);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, "PS:%p BEGIN_REORG:%p kick_state=%s is_reassigning=%d",
+              pollset, worker, kick_state_string(worker->state),
+              is_reassigning);
+    }
+    if (pollset->seen_inactive) {
+      if (neighborhood != pollset->neighborhood) {
+        gpr_mu_unlock(&neighborhood->mu);
+        neighborhood = pollset->neighborhood;
+        gpr_mu_unlock(&pollset->mu);
+        goto retry_lock_neighborhood;
+      }
+
+      /* In the brief time we released the pollset locks above, the worker MAY
+         have been kicked. In this case, the worker should get out of this
+         pollset ASAP and hence this should neither add the pollset to
+         neighborhood nor mark the pollset as active.
+
+         On a side note, the only way a worker's kick state could have changed
+         at this point is if it were "kicked specifically". Since the worker has
+         not added itself to the pollset yet (by calling worker_insert()), it is
+         not visible in the "kick any" path yet */
+      if (worker->state == UNKICKED) {
+        pollset->seen_inactive = false;
+        if (neighborhood->active_root == nullptr) {
+          neighborhood->active_root = pollset->next = pollset->prev = pollset;
+          /* Make this the designated poller if there isn't one already */
+          if (worker->state == UNKICKED &&
+              gpr_atm_no_barrier_cas(&g_active_poller, 0, (gpr_atm)worker)) {
+            SET_KICK_STATE(worker, DESIGNATED_POLLER);
+          }
+        } else {
+          pollset->next = neighborhood->active_root;
+          pollset->prev = pollset->next->prev;
+          pollset->next->prev = pollset->prev->next = pollset;
+        }
+      }
+    }
+    if (is_reassigning) {
+      GPR_ASSERT(pollset->reassigning_neighborhood);
+      pollset->reassigning_neighborhood = false;
+    }
+    gpr_mu_unlock(&neighborhood->mu);
+  }
+
+  worker_insert(pollset, worker);
+  pollset->begin_refs--;
+  if (worker->state == UNKICKED && !pollset->kicked_without_poller) {
+    GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
+    worker->initialized_cv = true;
+    gpr_cv_init(&worker->cv);
+    while (worker->state == UNKICKED && !pollset->shutting_down) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+        gpr_log(GPR_INFO, "PS:%p BEGIN_WAIT:%p kick_state=%s shutdown=%d",
+                pollset, worker, kick_state_string(worker->state),
+                pollset->shutting_down);
+      }
+
+      if (gpr_cv_wait(&worker->cv, &pollset->mu,
+                      grpc_millis_to_timespec(deadline, GPR_CLOCK_MONOTONIC)) &&
+          worker->state == UNKICKED) {
+        /* If gpr_cv_wait returns true (i.e a timeout), pretend that the worker
+           received a kick */
+        SET_KICK_STATE(worker, KICKED);
+      }
+    }
+    grpc_core::ExecCtx::Get()->InvalidateNow();
+  }
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO,
+            "PS:%p BEGIN_DONE:%p kick_state=%s shutdown=%d "
+            "kicked_without_poller: %d",
+            pollset, worker, kick_state_string(worker->state),
+            pollset->shutting_down, pollset->kicked_without_poller);
+  }
+
+  /* We release pollset lock in this function at a couple of places:
+   *   1. Briefly when assigning pollset to a neighborhood
+   *   2. When doing gpr_cv_wait()
+   * It is possible that 'kicked_without_poller' was set to true during (1) and
+   * 'shutting_down' is set to true during (1) or (2). If either of them is
+   * true, this worker cannot do polling */
+  /* TODO(sreek): Perhaps there is a better way to handle kicked_without_poller
+   * case; especially when the worker is the DESIGNATED_POLLER */
+
+  if (pollset->kicked_without_poller) {
+    pollset->kicked_without_poller = false;
+    return false;
+  }
+
+  return worker->state == DESIGNATED_POLLER && !pollset->shutting_down;
+}
+
+static bool check_neighborhood_for_available_poller(
+    pollset_neighborhood* neighborhood) {
+  GPR_TIMER_SCOPE("check_neighborhood_for_available_poller", 0);
+  bool found_worker = false;
+  do {
+    grpc_pollset* inspect = neighborhood->active_root;
+    if (inspect == nullptr) {
+      break;
+    }
+    gpr_mu_lock(&inspect->mu);
+    GPR_ASSERT(!inspect->seen_inactive);
+    grpc_pollset_worker* inspect_worker = inspect->root_worker;
+    if (inspect_worker != nullptr) {
+      do {
+        switch (inspect_worker->state) {
+          case UNKICKED:
+            if (gpr_atm_no_barrier_cas(&g_active_poller, 0,
+                                       (gpr_atm)inspect_worker)) {
+              if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+                gpr_log(GPR_INFO, " .. choose next poller to be %p",
+                        inspect_worker);
+              }
+              SET_KICK_STATE(inspect_worker, DESIGNATED_POLLER);
+              if (inspect_worker->initialized_cv) {
+                GPR_TIMER_MARK("signal worker", 0);
+                GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+                gpr_cv_signal(&inspect_worker->cv);
+              }
+            } else {
+              if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+                gpr_log(GPR_INFO, " .. beaten to choose next poller");
+              }
+            }
+            // even if we didn't win the cas, there's a worker, we can stop
+            found_worker = true;
+            break;
+          case KICKED:
+            break;
+          case DESIGNATED_POLLER:
+            found_worker = true;  // ok, so someone else found the worker, but
+                                  // we'll accept that
+            break;
+        }
+        inspect_worker = inspect_worker->next;
+      } while (!found_worker && inspect_worker != inspect->root_worker);
+    }
+    if (!found_worker) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+        gpr_log(GPR_INFO, " .. mark pollset %p inactive", inspect);
+      }
+      inspect->seen_inactive = true;
+      if (inspect == neighborhood->active_root) {
+        neighborhood->active_root =
+            inspect->next == inspect ? nullptr : inspect->next;
+      }
+      inspect->next->prev = inspect->prev;
+      inspect->prev->next = inspect->next;
+      inspect->next = inspect->prev = nullptr;
+    }
+    gpr_mu_unlock(&inspect->mu);
+  } while (!found_worker);
+  return found_worker;
+}
+
+static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
+                       grpc_pollset_worker** worker_hdl) {
+  GPR_TIMER_SCOPE("end_worker", 0);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "PS:%p END_WORKER:%p", pollset, worker);
+  }
+  if (worker_hdl != nullptr) *worker_hdl = nullptr;
+  /* Make sure we appear kicked */
+  SET_KICK_STATE(worker, KICKED);
+  grpc_closure_list_move(&worker->schedule_on_end_work,
+                         grpc_core::ExecCtx::Get()->closure_list());
+  if (gpr_atm_no_barrier_load(&g_active_poller) == (gpr_atm)worker) {
+    if (worker->next != worker && worker->next->state == UNKICKED) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+        gpr_log(GPR_INFO, " .. choose next poller to be peer %p", worker);
+      }
+      GPR_ASSERT(worker->next->initialized_cv);
+      gpr_atm_no_barrier_store(&g_active_poller, (gpr_atm)worker->next);
+      SET_KICK_STATE(worker->next, DESIGNATED_POLLER);
+      GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+      gpr_cv_signal(&worker->next->cv);
+      if (grpc_core::ExecCtx::Get()->HasWork()) {
+        gpr_mu_unlock(&pollset->mu);
+        grpc_core::ExecCtx::Get()->Flush();
+        gpr_mu_lock(&pollset->mu);
+      }
+    } else {
+      gpr_atm_no_barrier_store(&g_active_poller, 0);
+      size_t poller_neighborhood_idx =
+          static_cast<size_t>(pollset->neighborhood - g_neighborhoods);
+      gpr_mu_unlock(&pollset->mu);
+      bool found_worker = false;
+      bool scan_state[MAX_NEIGHBORHOODS];
+      for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
+        pollset_neighborhood* neighborhood =
+            &g_neighborhoods[(poller_neighborhood_idx + i) %
+                             g_num_neighborhoods];
+        if (gpr_mu_trylock(&neighborhood->mu)) {
+          found_worker = check_neighborhood_for_available_poller(neighborhood);
+          gpr_mu_unlock(&neighborhood->mu);
+          scan_state[i] = true;
+        } else {
+          scan_state[i] = false;
+        }
+      }
+      for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
+        if (scan_state[i]) continue;
+        pollset_neighborhood* neighborhood =
+            &g_neighborhoods[(poller_neighborhood_idx + i) %
+                             g_num_neighborhoods];
+        gpr_mu_lock(&neighborhood->mu);
+        found_worker = check_neighborhood_for_available_poller(neighborhood);
+        gpr_mu_unlock(&neighborhood->mu);
+      }
+      grpc_core::ExecCtx::Get()->Flush();
+      gpr_mu_lock(&pollset->mu);
+    }
+  } else if (grpc_core::ExecCtx::Get()->HasWork()) {
+    gpr_mu_unlock(&pollset->mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(&pollset->mu);
+  }
+  if (worker->initialized_cv) {
+    gpr_cv_destroy(&worker->cv);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, " .. remove worker");
+  }
+  if (EMPTIED == worker_remove(pollset, worker)) {
+    pollset_maybe_finish_shutdown(pollset);
+  }
+  GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
+}
+
+/* pollset->po.mu lock must be held by the caller before calling this.
+   The function pollset_work() may temporarily release the lock (pollset->po.mu)
+   during the course of its execution but it will always re-acquire the lock and
+   ensure that it is held by the time the function returns */
+static grpc_error* pollset_work(grpc_pollset* ps,
+                                grpc_pollset_worker** worker_hdl,
+                                grpc_millis deadline) {
+  GPR_TIMER_SCOPE("pollset_work", 0);
+  grpc_pollset_worker worker;
+  grpc_error* error = GRPC_ERROR_NONE;
+  static const char* err_desc = "pollset_work";
+  if (ps->kicked_without_poller) {
+    ps->kicked_without_poller = false;
+    return GRPC_ERROR_NONE;
+  }
+
+  if (begin_worker(ps, &worker, worker_hdl, deadline)) {
+    gpr_tls_set(&g_current_thread_pollset, (intptr_t)ps);
+    gpr_tls_set(&g_current_thread_worker, (intptr_t)&worker);
+    GPR_ASSERT(!ps->shutting_down);
+    GPR_ASSERT(!ps->seen_inactive);
+
+    gpr_mu_unlock(&ps->mu); /* unlock */
+    /* This is the designated polling thread at this point and should ideally do
+       polling. However, if there are unprocessed events left from a previous
+       call to do_uring_wait(), skip waiting on the ring in this iteration and
+       process the pending completions.
+
+       The reason for decoupling do_uring_wait and process_uring_events is to
+       better distribute the work (i.e handling completions) across multiple
+       threads
+
+       process_uring_events() returns very quickly: It just queues the work on
+       exec_ctx but does not execute it (the actual exectution or more
+       accurately grpc_core::ExecCtx::Get()->Flush() happens in end_worker()
+       AFTER selecting a designated poller). So we are not waiting long periods
+       without a designated poller */
+    if (gpr_atm_acq_load(&g_uring_set.cursor) ==
+        gpr_atm_acq_load(&g_uring_set.num_events)) {
+      append_error(&error, do_uring_wait(ps, deadline), err_desc);
+    }
+    append_error(&error, process_uring_events(ps), err_desc);
+
+    gpr_mu_lock(&ps->mu); /* lock */
+
+    gpr_tls_set(&g_current_thread_worker, 0);
+  } else {
+    gpr_tls_set(&g_current_thread_pollset, (intptr_t)ps);
+  }
+  end_worker(ps, &worker, worker_hdl);
+
+  gpr_tls_set(&g_current_thread_pollset, 0);
+  return error;
+}
+
+static grpc_error* pollset_kick(grpc_pollset* pollset,
+                                grpc_pollset_worker* specific_worker) {
+  GPR_TIMER_SCOPE("pollset_kick", 0);
+  GRPC_STATS_INC_POLLSET_KICK();
+  grpc_error* ret_err = GRPC_ERROR_NONE;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_strvec log;
+    gpr_strvec_init(&log);
+    char* tmp;
+    gpr_asprintf(&tmp, "PS:%p KICK:%p curps=%p curworker=%p root=%p", pollset,
+                 specific_worker, (void*)gpr_tls_get(&g_current_thread_pollset),
+                 (void*)gpr_tls_get(&g_current_thread_worker),
+                 pollset->root_worker);
+    gpr_strvec_add(&log, tmp);
+    if (pollset->root_worker != nullptr) {
+      gpr_asprintf(&tmp, " {kick_state=%s next=%p {kick_state=%s}}",
+                   kick_state_string(pollset->root_worker->state),
+                   pollset->root_worker->next,
+                   kick_state_string(pollset->root_worker->next->state));
+      gpr_strvec_add(&log, tmp);
+    }
+    if (specific_worker != nullptr) {
+      gpr_asprintf(&tmp, " worker_kick_state=%s",
+                   kick_state_string(specific_worker->state));
+      gpr_strvec_add(&log, tmp);
+    }
+    tmp = gpr_strvec_flatten(&log, nullptr);
+    gpr_strvec_destroy(&log);
+    gpr_log(GPR_DEBUG, "%s", tmp);
+    gpr_free(tmp);
+  }
+
+  if (specific_worker == nullptr) {
+    if (gpr_tls_get(&g_current_thread_pollset) != (intptr_t)pollset) {
+      grpc_pollset_worker* root_worker = pollset->root_worker;
+      if (root_worker == nullptr) {
+        GRPC_STATS_INC_POLLSET_KICKED_WITHOUT_POLLER();
+        pollset->kicked_without_poller = true;
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. kicked_without_poller");
+        }
+        goto done;
+      }
+      grpc_pollset_worker* next_worker = root_worker->next;
+      if (root_worker->state == KICKED) {
+        GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. already kicked %p", root_worker);
+        }
+        SET_KICK_STATE(root_worker, KICKED);
+        goto done;
+      } else if (next_worker->state == KICKED) {
+        GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. already kicked %p", next_worker);
+        }
+        SET_KICK_STATE(next_worker, KICKED);
+        goto done;
+      } else if (root_worker ==
+                     next_worker &&  // only try and wake up a poller if
+                                     // there is no next worker
+                 root_worker == (grpc_pollset_worker*)gpr_atm_no_barrier_load(
+                                    &g_active_poller)) {
+        GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. kicked %p", root_worker);
+        }
+        SET_KICK_STATE(root_worker, KICKED);
+        ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+        goto done;
+      } else if (next_worker->state == UNKICKED) {
+        GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. kicked %p", next_worker);
+        }
+        GPR_ASSERT(next_worker->initialized_cv);
+        SET_KICK_STATE(next_worker, KICKED);
+        gpr_cv_signal(&next_worker->cv);
+        goto done;
+      } else if (next_worker->state == DESIGNATED_POLLER) {
+        if (root_worker->state != DESIGNATED_POLLER) {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+            gpr_log(
+                GPR_INFO,
+                " .. kicked root non-poller %p (initialized_cv=%d) (poller=%p)",
+                root_worker, root_worker->initialized_cv, next_worker);
+          }
+          SET_KICK_STATE(root_worker, KICKED);
+          if (root_worker->initialized_cv) {
+            GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+            gpr_cv_signal(&root_worker->cv);
+          }
+          goto done;
+        } else {
+          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+            gpr_log(GPR_INFO, " .. non-root poller %p (root=%p)", next_worker,
+                    root_worker);
+          }
+          SET_KICK_STATE(next_worker, KICKED);
+          ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+          goto done;
+        }
+      } else {
+        GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+        GPR_ASSERT(next_worker->state == KICKED);
+        SET_KICK_STATE(next_worker, KICKED);
+        goto done;
+      }
+    } else {
+      GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD();
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+        gpr_log(GPR_INFO, " .. kicked while waking up");
+      }
+      goto done;
+    }
+
+    GPR_UNREACHABLE_CODE(goto done);
+  }
+
+  if (specific_worker->state == KICKED) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. specific worker already kicked");
+    }
+    goto done;
+  } else if (gpr_tls_get(&g_current_thread_worker) ==
+             (intptr_t)specific_worker) {
+    GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. mark %p kicked", specific_worker);
+    }
+    SET_KICK_STATE(specific_worker, KICKED);
+    goto done;
+  } else if (specific_worker ==
+             (grpc_pollset_worker*)gpr_atm_no_barrier_load(&g_active_poller)) {
+    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. kick active poller");
+    }
+    SET_KICK_STATE(specific_worker, KICKED);
+    ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+    goto done;
+  } else if (specific_worker->initialized_cv) {
+    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. kick waiting worker");
+    }
+    SET_KICK_STATE(specific_worker, KICKED);
+    gpr_cv_signal(&specific_worker->cv);
+    goto done;
+  } else {
+    GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. kick non-waiting worker");
+    }
+    SET_KICK_STATE(specific_worker, KICKED);
+    goto done;
+  }
+done:
+  return ret_err;
+}
+
+static void pollset_add_fd(grpc_pollset* pollset, grpc_fd* fd) {}
+
+/*******************************************************************************
+ * Pollset-set Definitions
+ */
+
+static grpc_pollset_set* pollset_set_create(void) {
+  return (grpc_pollset_set*)(static_cast<intptr_t>(0xdeafbeef));
+}
+
+static void pollset_set_destroy(grpc_pollset_set* pss) {}
+
+static void pollset_set_add_fd(grpc_pollset_set* pss, grpc_fd* fd) {}
+
+static void pollset_set_del_fd(grpc_pollset_set* pss, grpc_fd* fd) {}
+
+static void pollset_set_add_pollset(grpc_pollset_set* pss, grpc_pollset* ps) {}
+
+static void pollset_set_del_pollset(grpc_pollset_set* pss, grpc_pollset* ps) {}
+
+static void pollset_set_add_pollset_set(grpc_pollset_set* bag,
+                                        grpc_pollset_set* item) {}
+
+static void pollset_set_del_pollset_set(grpc_pollset_set* bag,
+                                        grpc_pollset_set* item) {}
+
+/*******************************************************************************
+ * Event engine binding
+ */
+
+static bool is_any_background_poller_thread(void) { return false; }
+
+static void shutdown_background_closure(void) {}
+
+static bool add_closure_to_background_poller(grpc_closure* closure,
+                                             grpc_error* error) {
+  return false;
+}
+
+static void shutdown_engine(void) {
+  drain_pending_orphans();
+  fd_global_shutdown();
+  pollset_global_shutdown();
+  uring_set_shutdown();
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_destroy(&fork_fd_list_mu);
+    grpc_core::Fork::SetResetChildPollingEngineFunc(nullptr);
+  }
+}
+
+static const grpc_event_engine_vtable vtable = {
+    sizeof(grpc_pollset),
+    true,
+    false,
+
+    fd_create,
+    fd_wrapped_fd,
+    fd_orphan,
+    fd_shutdown,
+    fd_notify_on_read,
+    fd_notify_on_write,
+    fd_notify_on_error,
+    fd_become_readable,
+    fd_become_writable,
+    fd_has_errors,
+    fd_is_shutdown,
+
+    pollset_init,
+    pollset_shutdown,
+    pollset_destroy,
+    pollset_work,
+    pollset_kick,
+    pollset_add_fd,
+    nullptr, /* pollset_enable_busy_poll */
+
+    pollset_set_create,
+    pollset_set_destroy,
+    pollset_set_add_pollset,
+    pollset_set_del_pollset,
+    pollset_set_add_pollset_set,
+    pollset_set_del_pollset_set,
+    pollset_set_add_fd,
+    pollset_set_del_fd,
+
+    is_any_background_poller_thread,
+    shutdown_background_closure,
+    shutdown_engine,
+    add_closure_to_background_poller,
+};
+
+/* Called by the child process's post-fork handler to close open fds, including
+ * the global io_uring fd. This allows gRPC to shutdown in the child process
+ * without interfering with connections or RPCs ongoing in the parent. */
+static void reset_event_manager_on_fork() {
+  gpr_mu_lock(&fork_fd_list_mu);
+  while (fork_fd_list_head != nullptr) {
+    close(fork_fd_list_head->fd);
+    fork_fd_list_head->fd = -1;
+    fork_fd_list_head = fork_fd_list_head->fork_fd_list->next;
+  }
+  gpr_mu_unlock(&fork_fd_list_mu);
+  /* The child does not share the parent's ring; completions for fds orphaned
+   * before the fork will never arrive. */
+  gpr_atm_no_barrier_store(&g_pending_orphans, 0);
+  shutdown_engine();
+  grpc_init_uring_linux(true);
+}
+
+/* Checks that the kernel accepted the multishot poll request for the wakeup
+ * fd. Kernels without IORING_POLL_ADD_MULTI fail the request immediately with
+ * -EINVAL. */
+static bool uring_supports_multishot_poll() {
+  unsigned head = *g_uring_set.cq_head;
+  unsigned tail = __atomic_load_n(g_uring_set.cq_tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; head++) {
+    struct io_uring_cqe* cqe =
+        &g_uring_set.cqes[head & *g_uring_set.cq_ring_mask];
+    if (cqe->user_data == URING_TAG_WAKEUP && cqe->res < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* The io_uring engine is experimental and only used when explicitly requested
+ * (GRPC_POLL_STRATEGY=uring). It is possible that the headers support io_uring
+ * but the running kernel doesn't (or forbids it), so the ring is created and
+ * probed before the engine is returned. */
+const grpc_event_engine_vtable* grpc_init_uring_linux(bool explicit_request) {
+  if (!explicit_request) {
+    return nullptr;
+  }
+
+  if (!grpc_has_wakeup_fd()) {
+    gpr_log(GPR_ERROR, "Skipping uring because of no wakeup fd.");
+    return nullptr;
+  }
+
+  if (!uring_set_init()) {
+    return nullptr;
+  }
+
+  fd_global_init();
+
+  if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
+    fd_global_shutdown();
+    uring_set_shutdown();
+    return nullptr;
+  }
+
+  if (!uring_supports_multishot_poll()) {
+    gpr_log(GPR_ERROR, "Skipping uring because of no multishot poll support.");
+    pollset_global_shutdown();
+    fd_global_shutdown();
+    uring_set_shutdown();
+    return nullptr;
+  }
+
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_init(&fork_fd_list_mu);
+    grpc_core::Fork::SetResetChildPollingEngineFunc(
+        reset_event_manager_on_fork);
+  }
+  return &vtable;
+}
+
+#else /* defined(GRPC_LINUX_IO_URING) */
+#if defined(GRPC_POSIX_SOCKET_EV_URING)
+#include "src/core/lib/iomgr/ev_uring_linux.h"
+/* If GRPC_LINUX_IO_URING is not defined, it means io_uring is not available.
+ * Return NULL */
+const grpc_event_engine_vtable* grpc_init_uring_linux(bool explicit_request) {
+  return nullptr;
+}
+#endif /* defined(GRPC_POSIX_SOCKET_EV_URING) */
+#endif /* !defined(GRPC_LINUX_IO_URING) */
@@ -23,6 +23,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/profiling/timers.h"
@@ -51,17 +53,60 @@ static void exec_ctx_sched(grpc_closure* closure, grpc_error* error) {
                            error);
 }
 
+static void exec_ctx_sched_urgent(grpc_closure* closure, grpc_error* error) {
+  grpc_closure_list_append(grpc_core::ExecCtx::Get()->urgent_closure_list(),
+                           closure, error);
+}
+
+static void exec_ctx_sched_background(grpc_closure* closure,
+                                      grpc_error* error) {
+  grpc_closure_list_append(grpc_core::ExecCtx::Get()->background_closure_list(),
+                           closure, error);
+}
+
+/* Urgent work runs at most this many times in a row while there are other
+   closures or combiners waiting, and background closures wait behind at most
+   this many units of other work */
+static const int kMaxUrgentBurst = 8;
+static const int kMaxBackgroundDelay = 32;
+
+static grpc_closure* pop_closure(grpc_closure_list* list) {
+  grpc_closure* c = list->head;
+  list->head = c->next_data.next;
+  if (list->head == nullptr) {
+    list->tail = nullptr;
+  }
+  return c;
+}
+
 static gpr_timespec g_start_time;
 
-static grpc_millis timespec_to_millis_round_down(gpr_timespec ts) {
+/* Where the cycle counter is the TSC, Now() extrapolates from each thread's
+   last read of the monotonic clock for up to kNowResyncMillis, and so is off
+   by no more than the TSC calibration error over that interval. */
+static const grpc_millis kNowResyncMillis = 10;
+/* kNowResyncMillis in cycles, or zero where Now() reads the monotonic clock
+   every time */
+static gpr_cycle_counter g_now_resync_cycles;
+static double g_cycles_per_ms;
+
+/* Milliseconds since g_start_time, with the fraction */
+static double timespec_to_millis_exact(gpr_timespec ts) {
   ts = gpr_time_sub(ts, g_start_time);
-  double x = GPR_MS_PER_SEC * static_cast<double>(ts.tv_sec) +
-             static_cast<double>(ts.tv_nsec) / GPR_NS_PER_MS;
+  return GPR_MS_PER_SEC * static_cast<double>(ts.tv_sec) +
+         static_cast<double>(ts.tv_nsec) / GPR_NS_PER_MS;
+}
+
+static grpc_millis millis_round_down(double x) {
   if (x < 0) return 0;
   if (x > GRPC_MILLIS_INF_FUTURE) return GRPC_MILLIS_INF_FUTURE;
   return static_cast<grpc_millis>(x);
 }
 
+static grpc_millis timespec_to_millis_round_down(gpr_timespec ts) {
+  return millis_round_down(timespec_to_millis_exact(ts));
+}
+
 static grpc_millis timespec_to_millis_round_up(gpr_timespec ts) {
   ts = gpr_time_sub(ts, g_start_time);
   double x = GPR_MS_PER_SEC * static_cast<double>(ts.tv_sec) +
@@ -106,37 +151,97 @@ static const grpc_closure_scheduler_vtable exec_ctx_scheduler_vtable = {
 static grpc_closure_scheduler exec_ctx_scheduler = {&exec_ctx_scheduler_vtable};
 grpc_closure_scheduler* grpc_schedule_on_exec_ctx = &exec_ctx_scheduler;
 
+static const grpc_closure_scheduler_vtable exec_ctx_urgent_scheduler_vtable = {
+    exec_ctx_run, exec_ctx_sched_urgent, "exec_ctx:urgent"};
+static grpc_closure_scheduler exec_ctx_urgent_scheduler = {
+    &exec_ctx_urgent_scheduler_vtable};
+grpc_closure_scheduler* grpc_schedule_on_exec_ctx_urgent =
+    &exec_ctx_urgent_scheduler;
+
+static const grpc_closure_scheduler_vtable
+    exec_ctx_background_scheduler_vtable = {
+        exec_ctx_run, exec_ctx_sched_background, "exec_ctx:background"};
+static grpc_closure_scheduler exec_ctx_background_scheduler = {
+    &exec_ctx_background_scheduler_vtable};
+grpc_closure_scheduler* grpc_schedule_on_exec_ctx_background =
+    &exec_ctx_background_scheduler;
+
 namespace grpc_core {
 GPR_TLS_CLASS_DEF(ExecCtx::exec_ctx_);
+GPR_TLS_CLASS_DEF(ExecCtx::now_anchor_cycles_);
+GPR_TLS_CLASS_DEF(ExecCtx::now_anchor_millis_);
 GPR_TLS_CLASS_DEF(ApplicationCallbackExecCtx::callback_exec_ctx_);
 
 // WARNING: for testing purposes only!
 void ExecCtx::TestOnlyGlobalInit(gpr_timespec new_val) {
   g_start_time = new_val;
+  g_now_resync_cycles = 0;
   gpr_tls_init(&exec_ctx_);
+  gpr_tls_init(&now_anchor_cycles_);
+  gpr_tls_init(&now_anchor_millis_);
 }
 
 void ExecCtx::GlobalInit(void) {
   g_start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  g_now_resync_cycles = 0;
+#if GPR_CYCLE_COUNTER_RDTSC_64
+  if (gpr_cycle_counter_is_tsc) {
+    g_cycles_per_ms = gpr_cycles_per_second() / GPR_MS_PER_SEC;
+    g_now_resync_cycles =
+        static_cast<gpr_cycle_counter>(g_cycles_per_ms * kNowResyncMillis);
+  }
+#endif
   gpr_tls_init(&exec_ctx_);
+  gpr_tls_init(&now_anchor_cycles_);
+  gpr_tls_init(&now_anchor_millis_);
+}
+
+void ExecCtx::GlobalShutdown(void) {
+  gpr_tls_destroy(&exec_ctx_);
+  gpr_tls_destroy(&now_anchor_cycles_);
+  gpr_tls_destroy(&now_anchor_millis_);
 }
 
 bool ExecCtx::Flush() {
   bool did_something = 0;
   GPR_TIMER_SCOPE("grpc_exec_ctx_flush", 0);
+  int urgent_burst = 0;
+  int background_delay = 0;
   for (;;) {
-    if (!grpc_closure_list_empty(closure_list_)) {
-      grpc_closure* c = closure_list_.head;
-      closure_list_.head = closure_list_.tail = nullptr;
-      while (c != nullptr) {
-        grpc_closure* next = c->next_data.next;
-        grpc_error* error = c->error_data.error;
-        did_something = true;
-        exec_ctx_run(c, error);
-        c = next;
-      }
-    } else if (!grpc_combiner_continue_exec_ctx()) {
+    const bool other_work = !grpc_closure_list_empty(closure_list_) ||
+                            combiner_data_.active_combiner != nullptr;
+    const bool urgent_work = !grpc_closure_list_empty(urgent_closure_list_);
+    grpc_closure* c = nullptr;
+    if (!grpc_closure_list_empty(background_closure_list_) &&
+        (background_delay >= kMaxBackgroundDelay ||
+         (!other_work && !urgent_work))) {
+      c = pop_closure(&background_closure_list_);
+      background_delay = 0;
+    } else if (!other_work && !urgent_work) {
       break;
+    } else {
+      const bool urgent_allowed =
+          urgent_burst < kMaxUrgentBurst || !other_work;
+      if (urgent_allowed && urgent_work) {
+        c = pop_closure(&urgent_closure_list_);
+        urgent_burst++;
+      } else if (urgent_allowed && grpc_combiner_continue_urgent_exec_ctx()) {
+        urgent_burst++;
+      } else if (!grpc_closure_list_empty(closure_list_)) {
+        c = pop_closure(&closure_list_);
+        urgent_burst = 0;
+      } else {
+        // there is an active combiner: this always makes progress with it
+        grpc_combiner_continue_exec_ctx();
+        urgent_burst = 0;
+      }
+      if (!grpc_closure_list_empty(background_closure_list_)) {
+        background_delay++;
+      }
+    }
+    if (c != nullptr) {
+      did_something = true;
+      exec_ctx_run(c, c->error_data.error);
     }
   }
   GPR_ASSERT(combiner_data_.active_combiner == nullptr);
@@ -145,7 +250,40 @@ bool ExecCtx::Flush() {
 
 grpc_millis ExecCtx::Now() {
   if (!now_is_valid_) {
-    now_ = timespec_to_millis_round_down(gpr_now(GPR_CLOCK_MONOTONIC));
+    if (g_now_resync_cycles == 0 || !gpr_now_is_system_clock()) {
+      now_ = timespec_to_millis_round_down(gpr_now(GPR_CLOCK_MONOTONIC));
+    } else {
+      const gpr_cycle_counter cycles = gpr_get_cycle_counter();
+      const gpr_cycle_counter anchor_cycles =
+          static_cast<gpr_cycle_counter>(gpr_tls_get(&now_anchor_cycles_));
+      const grpc_millis anchor_millis =
+          static_cast<grpc_millis>(gpr_tls_get(&now_anchor_millis_));
+      const gpr_cycle_counter elapsed = cycles - anchor_cycles;
+      const grpc_millis extrapolated =
+          anchor_millis + static_cast<grpc_millis>(elapsed / g_cycles_per_ms);
+      if (anchor_cycles != 0 && elapsed >= 0 &&
+          elapsed < g_now_resync_cycles) {
+        now_ = extrapolated;
+      } else {
+        const double exact_millis =
+            timespec_to_millis_exact(gpr_now(GPR_CLOCK_MONOTONIC));
+        now_ = millis_round_down(exact_millis);
+        /* Never step back from what this thread may have been told last */
+        if (anchor_cycles != 0 && elapsed >= 0) {
+          now_ = GPR_MAX(
+              now_, GPR_MIN(extrapolated, anchor_millis + kNowResyncMillis));
+        }
+        /* Anchor the cycle count at the start of millisecond now_ rather
+           than at the clock read, so that extrapolating from it does not
+           lose the fraction of a millisecond that now_ was rounded down by */
+        const double fraction = GPR_MAX(0.0, exact_millis - now_);
+        gpr_tls_set(&now_anchor_cycles_,
+                    static_cast<intptr_t>(
+                        cycles - static_cast<gpr_cycle_counter>(
+                                     fraction * g_cycles_per_ms)));
+        gpr_tls_set(&now_anchor_millis_, static_cast<intptr_t>(now_));
+      }
+    }
     now_is_valid_ = true;
   }
   return now_;
@@ -48,12 +48,22 @@ typedef struct grpc_combiner grpc_combiner;
 /* This exec ctx was initialized by an internal thread, and should not
    be counted by fork handlers */
 #define GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD 4
+/* grpc_call_start_batch() runs batches in this exec_ctx rather than in one of
+   its own, so that batches started together reach the transports together */
+#define GRPC_EXEC_CTX_FLAG_HOLDS_CALL_BATCHES 8
 
 /* This application callback exec ctx was initialized by an internal thread, and
    should not be counted by fork handlers */
 #define GRPC_APP_CALLBACK_EXEC_CTX_FLAG_IS_INTERNAL_THREAD 1
 
 extern grpc_closure_scheduler* grpc_schedule_on_exec_ctx;
+/* Like grpc_schedule_on_exec_ctx, for latency critical closures (transport
+   reads and writes): Flush() runs them ahead of the other closures queued on
+   the exec_ctx. */
+extern grpc_closure_scheduler* grpc_schedule_on_exec_ctx_urgent;
+/* Like grpc_schedule_on_exec_ctx, for housekeeping that can wait: Flush() runs
+   it once everything else queued on the exec_ctx is done. */
+extern grpc_closure_scheduler* grpc_schedule_on_exec_ctx_background;
 
 gpr_timespec grpc_millis_to_timespec(grpc_millis millis, gpr_clock_type clock);
 grpc_millis grpc_timespec_to_millis_round_down(gpr_timespec timespec);
@@ -144,16 +154,27 @@ class ExecCtx {
   /** Return pointer to grpc_closure_list */
   grpc_closure_list* closure_list() { return &closure_list_; }
 
+  /** Return pointers to the urgent and background lanes */
+  grpc_closure_list* urgent_closure_list() { return &urgent_closure_list_; }
+  grpc_closure_list* background_closure_list() {
+    return &background_closure_list_;
+  }
+
   /** Return flags */
   uintptr_t flags() { return flags_; }
 
   /** Checks if there is work to be done */
   bool HasWork() {
     return combiner_data_.active_combiner != nullptr ||
-           !grpc_closure_list_empty(closure_list_);
+           !grpc_closure_list_empty(closure_list_) ||
+           !grpc_closure_list_empty(urgent_closure_list_) ||
+           !grpc_closure_list_empty(background_closure_list_);
   }
 
   /** Flush any work that has been enqueued onto this grpc_exec_ctx.
+   *  Urgent closures run first, then the other closures and combiners, then
+   *  background closures; each lane still gets a turn every so often while
+   *  a busier one has work, so that none of them can be starved.
    *  Caller must guarantee that no interfering locks are held.
    *  Returns true if work was performed, false otherwise.
    */
@@ -206,7 +227,7 @@ class ExecCtx {
   static void GlobalInit(void);
 
   /** Global shutdown for ExecCtx. Called by iomgr. */
-  static void GlobalShutdown(void) { gpr_tls_destroy(&exec_ctx_); }
+  static void GlobalShutdown(void);
 
   /** Gets pointer to current exec_ctx. */
   static ExecCtx* Get() {
@@ -228,6 +249,8 @@ class ExecCtx {
   /** Set exec_ctx_ to exec_ctx. */
 
   grpc_closure_list closure_list_ = GRPC_CLOSURE_LIST_INIT;
+  grpc_closure_list urgent_closure_list_ = GRPC_CLOSURE_LIST_INIT;
+  grpc_closure_list background_closure_list_ = GRPC_CLOSURE_LIST_INIT;
   CombinerData combiner_data_ = {nullptr, nullptr};
   uintptr_t flags_;
 
@@ -237,6 +260,11 @@ class ExecCtx {
   grpc_millis now_ = 0;
 
   GPR_TLS_CLASS_DECL(exec_ctx_);
+  /* The cycle counter value and Now() at this thread's last read of the
+     monotonic clock, from which Now() extrapolates for a while (see
+     exec_ctx.cc). */
+  GPR_TLS_CLASS_DECL(now_anchor_cycles_);
+  GPR_TLS_CLASS_DECL(now_anchor_millis_);
   ExecCtx* last_exec_ctx_ = Get();
 };
 
@@ -326,6 +354,10 @@ class ApplicationCallbackExecCtx {
     }
   }
 
+  /** Returns whether the calling thread has an ApplicationCallbackExecCtx, and
+      so whether Enqueue() can be used */
+  static bool Available() { return gpr_tls_get(&callback_exec_ctx_) != 0; }
+
   static void Enqueue(grpc_experimental_completion_queue_functor* functor,
                       int is_success) {
     functor->internal_success = is_success;
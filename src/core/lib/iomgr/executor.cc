@@ -33,8 +33,26 @@
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
+#include "src/core/lib/profiling/usdt.h"
 
 #define MAX_DEPTH 2
+// Most urgent closures queued on a thread ahead of other ones waiting there
+#define MAX_URGENT_BURST 8
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_executor_work_stealing, false,
+    "If set, idle executor threads take closures queued behind busy threads "
+    "instead of waiting for closures of their own");
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_resolver_executor_threads, 0,
+    "Maximum number of threads of the executor running blocking DNS "
+    "resolutions, 0 for twice the number of cores");
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_control_plane_executor_threads, 0,
+    "Maximum number of threads of the executor running control plane "
+    "combiners, 0 for twice the number of cores");
 
 #define EXECUTOR_TRACE(format, ...)                       \
   do {                                                    \
@@ -67,6 +85,11 @@ void default_enqueue_long(grpc_closure* closure, grpc_error* error) {
       closure, error, false /* is_short */);
 }
 
+void default_enqueue_urgent(grpc_closure* closure, grpc_error* error) {
+  executors[static_cast<size_t>(ExecutorType::DEFAULT)]->Enqueue(
+      closure, error, true /* is_short */, true /* is_urgent */);
+}
+
 void resolver_enqueue_short(grpc_closure* closure, grpc_error* error) {
   executors[static_cast<size_t>(ExecutorType::RESOLVER)]->Enqueue(
       closure, error, true /* is_short */);
@@ -77,16 +100,46 @@ void resolver_enqueue_long(grpc_closure* closure, grpc_error* error) {
       closure, error, false /* is_short */);
 }
 
+void resolver_enqueue_urgent(grpc_closure* closure, grpc_error* error) {
+  executors[static_cast<size_t>(ExecutorType::RESOLVER)]->Enqueue(
+      closure, error, true /* is_short */, true /* is_urgent */);
+}
+
+void control_plane_enqueue_short(grpc_closure* closure, grpc_error* error) {
+  executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)]->Enqueue(
+      closure, error, true /* is_short */);
+}
+
+void control_plane_enqueue_long(grpc_closure* closure, grpc_error* error) {
+  executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)]->Enqueue(
+      closure, error, false /* is_short */);
+}
+
+void control_plane_enqueue_urgent(grpc_closure* closure, grpc_error* error) {
+  executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)]->Enqueue(
+      closure, error, true /* is_short */, true /* is_urgent */);
+}
+
 const grpc_closure_scheduler_vtable
     vtables_[static_cast<size_t>(ExecutorType::NUM_EXECUTORS)]
             [static_cast<size_t>(ExecutorJobType::NUM_JOB_TYPES)] = {
                 {{&default_enqueue_short, &default_enqueue_short,
                   "def-ex-short"},
-                 {&default_enqueue_long, &default_enqueue_long, "def-ex-long"}},
+                 {&default_enqueue_long, &default_enqueue_long, "def-ex-long"},
+                 {&default_enqueue_urgent, &default_enqueue_urgent,
+                  "def-ex-urgent"}},
                 {{&resolver_enqueue_short, &resolver_enqueue_short,
                   "res-ex-short"},
                  {&resolver_enqueue_long, &resolver_enqueue_long,
-                  "res-ex-long"}}};
+                  "res-ex-long"},
+                 {&resolver_enqueue_urgent, &resolver_enqueue_urgent,
+                  "res-ex-urgent"}},
+                {{&control_plane_enqueue_short, &control_plane_enqueue_short,
+                  "cp-ex-short"},
+                 {&control_plane_enqueue_long, &control_plane_enqueue_long,
+                  "cp-ex-long"},
+                 {&control_plane_enqueue_urgent, &control_plane_enqueue_urgent,
+                  "cp-ex-urgent"}}};
 
 grpc_closure_scheduler
     schedulers_[static_cast<size_t>(ExecutorType::NUM_EXECUTORS)]
@@ -94,23 +147,78 @@ grpc_closure_scheduler
                    {{&vtables_[static_cast<size_t>(ExecutorType::DEFAULT)]
                               [static_cast<size_t>(ExecutorJobType::SHORT)]},
                     {&vtables_[static_cast<size_t>(ExecutorType::DEFAULT)]
-                              [static_cast<size_t>(ExecutorJobType::LONG)]}},
+                              [static_cast<size_t>(ExecutorJobType::LONG)]},
+                    {&vtables_[static_cast<size_t>(ExecutorType::DEFAULT)]
+                              [static_cast<size_t>(ExecutorJobType::URGENT)]}},
                    {{&vtables_[static_cast<size_t>(ExecutorType::RESOLVER)]
                               [static_cast<size_t>(ExecutorJobType::SHORT)]},
                     {&vtables_[static_cast<size_t>(ExecutorType::RESOLVER)]
-                              [static_cast<size_t>(ExecutorJobType::LONG)]}}};
+                              [static_cast<size_t>(ExecutorJobType::LONG)]},
+                    {&vtables_[static_cast<size_t>(ExecutorType::RESOLVER)]
+                              [static_cast<size_t>(ExecutorJobType::URGENT)]}},
+                   {{&vtables_[static_cast<size_t>(
+                         ExecutorType::CONTROL_PLANE)]
+                              [static_cast<size_t>(ExecutorJobType::SHORT)]},
+                    {&vtables_[static_cast<size_t>(
+                         ExecutorType::CONTROL_PLANE)]
+                              [static_cast<size_t>(ExecutorJobType::LONG)]},
+                    {&vtables_[static_cast<size_t>(
+                         ExecutorType::CONTROL_PLANE)]
+                              [static_cast<size_t>(
+                                  ExecutorJobType::URGENT)]}}};
+
+// Removes the oldest closure queued on ts. Must be called with ts->mu held.
+grpc_closure* PopClosureLocked(ThreadState* ts) {
+  grpc_closure* closure = ts->elems.head;
+  if (closure == nullptr) {
+    return nullptr;
+  }
+  ts->elems.head = closure->next_data.next;
+  if (ts->elems.head == nullptr) {
+    ts->elems.tail = nullptr;
+  }
+  closure->next_data.next = nullptr;
+  ts->depth--;
+  if (ts->urgent_tail == closure) {
+    ts->urgent_tail = nullptr;
+  } else if (ts->urgent_tail == nullptr) {
+    ts->urgent_burst = 0;
+  }
+  return closure;
+}
 
 }  // namespace
 
 TraceFlag executor_trace(false, "executor");
 
-Executor::Executor(const char* name) : name_(name) {
+Executor::Executor(const char* name, size_t max_threads)
+    : name_(name),
+      work_stealing_(GPR_GLOBAL_CONFIG_GET(grpc_executor_work_stealing)) {
   adding_thread_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
+  start_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
+  gpr_atm_rel_store(&start_pending_, 0);
   gpr_atm_rel_store(&num_threads_, 0);
-  max_threads_ = GPR_MAX(1, 2 * gpr_cpu_num_cores());
+  gpr_atm_rel_store(&num_waiting_, 0);
+  max_threads_ = max_threads > 0 ? max_threads
+                                 : GPR_MAX(1, 2 * gpr_cpu_num_cores());
 }
 
-void Executor::Init() { SetThreading(true); }
+void Executor::Init() {
+  if (grpc_iomgr_lazy_thread_start()) {
+    gpr_atm_rel_store(&start_pending_, 1);
+  } else {
+    SetThreading(true);
+  }
+}
+
+void Executor::StartPendingThreads() {
+  gpr_spinlock_lock(&start_lock_);
+  if (gpr_atm_acq_load(&start_pending_)) {
+    EXECUTOR_TRACE("(%s) starting threads for the first closure", name_);
+    SetThreading(true);
+  }
+  gpr_spinlock_unlock(&start_lock_);
+}
 
 size_t Executor::RunClosures(const char* executor_name,
                              grpc_closure_list list) {
@@ -138,6 +246,7 @@ size_t Executor::RunClosures(const char* executor_name,
 #else
     EXECUTOR_TRACE("(%s) run %p", executor_name, c);
 #endif
+    GRPC_USDT2(executor_dequeue, executor_name, c);
     c->cb(c->cb_arg, error);
     GRPC_ERROR_UNREF(error);
     c = next;
@@ -149,7 +258,8 @@ size_t Executor::RunClosures(const char* executor_name,
 }
 
 bool Executor::IsThreaded() const {
-  return gpr_atm_acq_load(&num_threads_) > 0;
+  return gpr_atm_acq_load(&num_threads_) > 0 ||
+         gpr_atm_acq_load(&start_pending_);
 }
 
 void Executor::SetThreading(bool threading) {
@@ -163,7 +273,6 @@ void Executor::SetThreading(bool threading) {
     }
 
     GPR_ASSERT(num_threads_ == 0);
-    gpr_atm_rel_store(&num_threads_, 1);
     gpr_tls_init(&g_this_thread_state);
     thd_state_ = static_cast<ThreadState*>(
         gpr_zalloc(sizeof(ThreadState) * max_threads_));
@@ -175,12 +284,20 @@ void Executor::SetThreading(bool threading) {
       thd_state_[i].name = name_;
       thd_state_[i].thd = grpc_core::Thread();
       thd_state_[i].elems = GRPC_CLOSURE_LIST_INIT;
+      thd_state_[i].executor = this;
     }
+    // Only publish the thread count once thd_state_ is ready for Enqueue()
+    // calls racing with a lazy start
+    gpr_atm_rel_store(&num_threads_, 1);
+    gpr_atm_rel_store(&start_pending_, 0);
 
-    thd_state_[0].thd =
-        grpc_core::Thread(name_, &Executor::ThreadMain, &thd_state_[0]);
+    thd_state_[0].thd = grpc_core::Thread(
+        name_, &Executor::ThreadMain, &thd_state_[0], nullptr,
+        grpc_core::Thread::Options().set_numa_node(
+            grpc_iomgr_thread_numa_node(0)));
     thd_state_[0].thd.Start();
   } else {  // !threading
+    gpr_atm_rel_store(&start_pending_, 0);
     if (curr_num_threads == 0) {
       EXECUTOR_TRACE("(%s) SetThreading(false). curr_num_threads == 0", name_);
       return;
@@ -235,6 +352,11 @@ void Executor::ThreadMain(void* arg) {
 
   grpc_core::ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
 
+  if (ts->executor->work_stealing_) {
+    ts->executor->WorkStealingThreadLoop(ts);
+    return;
+  }
+
   size_t subtract_depth = 0;
   for (;;) {
     EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: step (sub_depth=%" PRIdPTR ")",
@@ -257,6 +379,8 @@ void Executor::ThreadMain(void* arg) {
     GRPC_STATS_INC_EXECUTOR_QUEUE_DRAINED();
     grpc_closure_list closures = ts->elems;
     ts->elems = GRPC_CLOSURE_LIST_INIT;
+    ts->urgent_tail = nullptr;
+    ts->urgent_burst = 0;
     gpr_mu_unlock(&ts->mu);
 
     EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: execute", ts->name, ts->id);
@@ -266,8 +390,108 @@ void Executor::ThreadMain(void* arg) {
   }
 }
 
+void Executor::WorkStealingThreadLoop(ThreadState* ts) {
+  for (;;) {
+    gpr_mu_lock(&ts->mu);
+    if (ts->shutdown) {
+      EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: shutdown", ts->name, ts->id);
+      gpr_mu_unlock(&ts->mu);
+      break;
+    }
+
+    grpc_closure* closure = PopClosureLocked(ts);
+    if (closure == nullptr) {
+      // Advertise that this thread is looking for work *before* looking at
+      // the other threads' queues: a closure queued behind a busy thread after
+      // we looked at it is then guaranteed to see us (both sides go through
+      // that thread's mutex) and wake us up, so it is never stranded there.
+      ts->waiting = true;
+      gpr_atm_full_fetch_add(&num_waiting_, 1);
+      gpr_mu_unlock(&ts->mu);
+
+      closure = StealClosure(ts);
+
+      gpr_mu_lock(&ts->mu);
+      if (closure == nullptr) {
+        while (grpc_closure_list_empty(ts->elems) && !ts->shutdown &&
+               !ts->steal_wakeup) {
+          ts->queued_long_job = false;
+          gpr_cv_wait(&ts->cv, &ts->mu, gpr_inf_future(GPR_CLOCK_MONOTONIC));
+        }
+      }
+      ts->waiting = false;
+      ts->steal_wakeup = false;
+      gpr_atm_full_fetch_add(&num_waiting_, -1);
+      gpr_mu_unlock(&ts->mu);
+      if (closure == nullptr) {
+        continue;  // Pick up our own closures or steal again
+      }
+    } else {
+      gpr_mu_unlock(&ts->mu);
+    }
+
+    EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: execute", ts->name, ts->id);
+
+    grpc_core::ExecCtx::Get()->InvalidateNow();
+    grpc_closure_list list = {closure, closure};
+    RunClosures(ts->name, list);
+  }
+}
+
+grpc_closure* Executor::StealClosure(ThreadState* thief) {
+  size_t cur_thread_count =
+      static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
+  for (size_t i = 1; i < cur_thread_count; i++) {
+    ThreadState* victim = &thd_state_[(thief->id + i) % cur_thread_count];
+    gpr_mu_lock(&victim->mu);
+    grpc_closure* closure = PopClosureLocked(victim);
+    // A long job is always the last closure queued on a thread; if we take it,
+    // its victim is free to accept new closures again and we are not.
+    bool took_long_job = closure != nullptr &&
+                         grpc_closure_list_empty(victim->elems) &&
+                         victim->queued_long_job;
+    if (took_long_job) {
+      victim->queued_long_job = false;
+    }
+    gpr_mu_unlock(&victim->mu);
+
+    if (closure != nullptr) {
+      EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: stole %p from [%" PRIdPTR "]",
+                     name_, thief->id, closure, victim->id);
+      GRPC_STATS_INC_EXECUTOR_STEALS();
+      if (took_long_job) {
+        gpr_mu_lock(&thief->mu);
+        thief->queued_long_job = true;
+        gpr_mu_unlock(&thief->mu);
+      }
+      return closure;
+    }
+  }
+  return nullptr;
+}
+
+void Executor::WakeStealer(ThreadState* busy_ts, size_t cur_thread_count) {
+  for (size_t i = 1; i < cur_thread_count; i++) {
+    if (gpr_atm_acq_load(&num_waiting_) == 0) {
+      return;
+    }
+    ThreadState* ts = &thd_state_[(busy_ts->id + i) % cur_thread_count];
+    gpr_mu_lock(&ts->mu);
+    bool wake = ts->waiting && !ts->steal_wakeup && !ts->shutdown;
+    if (wake) {
+      GRPC_STATS_INC_EXECUTOR_WAKEUP_INITIATED();
+      ts->steal_wakeup = true;
+      gpr_cv_signal(&ts->cv);
+    }
+    gpr_mu_unlock(&ts->mu);
+    if (wake) {
+      return;
+    }
+  }
+}
+
 void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
-                       bool is_short) {
+                       bool is_short, bool is_urgent) {
   bool retry_push;
   if (is_short) {
     GRPC_STATS_INC_EXECUTOR_SCHEDULED_SHORT_ITEMS();
@@ -280,6 +504,12 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
     size_t cur_thread_count =
         static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
 
+    if (cur_thread_count == 0 && gpr_atm_acq_load(&start_pending_)) {
+      StartPendingThreads();
+      retry_push = true;
+      continue;
+    }
+
     // If the number of threads is zero(i.e either the executor is not threaded
     // or already shutdown), then queue the closure on the exec context itself
     if (cur_thread_count == 0) {
@@ -289,8 +519,10 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
 #else
       EXECUTOR_TRACE("(%s) schedule %p inline", name_, closure);
 #endif
-      grpc_closure_list_append(grpc_core::ExecCtx::Get()->closure_list(),
-                               closure, error);
+      grpc_closure_list_append(
+          is_urgent ? grpc_core::ExecCtx::Get()->urgent_closure_list()
+                    : grpc_core::ExecCtx::Get()->closure_list(),
+          closure, error);
       return;
     }
 
@@ -299,7 +531,8 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
     }
 
     ThreadState* ts = (ThreadState*)gpr_tls_get(&g_this_thread_state);
-    if (ts == nullptr) {
+    // A thread of another executor has to pick one of ours
+    if (ts == nullptr || ts->executor != this) {
       ts = &thd_state_[GPR_HASH_POINTER(grpc_core::ExecCtx::Get(),
                                         cur_thread_count)];
     } else {
@@ -308,6 +541,7 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
 
     ThreadState* orig_ts = ts;
     bool try_new_thread = false;
+    bool wake_stealer = false;
 
     for (;;) {
 #ifndef NDEBUG
@@ -360,11 +594,36 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
         gpr_cv_signal(&ts->cv);
       }
 
-      grpc_closure_list_append(&ts->elems, closure, error);
+      // nothing but urgent closures (or nothing at all) queued here
+      const bool only_urgent_queued = ts->urgent_tail == ts->elems.tail;
+      if (is_urgent && !only_urgent_queued &&
+          ts->urgent_burst < MAX_URGENT_BURST) {
+        // queue it after the urgent closures already there, ahead of the rest
+        closure->error_data.error = error;
+        if (ts->urgent_tail == nullptr) {
+          closure->next_data.next = ts->elems.head;
+          ts->elems.head = closure;
+        } else {
+          closure->next_data.next = ts->urgent_tail->next_data.next;
+          ts->urgent_tail->next_data.next = closure;
+        }
+        ts->urgent_tail = closure;
+        ts->urgent_burst++;
+      } else {
+        grpc_closure_list_append(&ts->elems, closure, error);
+        if (is_urgent && only_urgent_queued) {
+          ts->urgent_tail = closure;
+        }
+      }
+      GRPC_USDT3(executor_enqueue, name_, closure, is_short);
 
       // If we already queued more than MAX_DEPTH number of closures on this
       // thread, use this as a hint to create more threads
       ts->depth++;
+      GRPC_STATS_INC_EXECUTOR_QUEUE_DEPTH(ts->depth);
+      // With work stealing, a closure queued behind a busy thread can be
+      // picked up by an idle one right away
+      wake_stealer = work_stealing_ && !ts->waiting && !ts->shutdown;
       try_new_thread = ts->depth > MAX_DEPTH &&
                        cur_thread_count < max_threads_ && !ts->shutdown;
 
@@ -374,6 +633,10 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
       break;
     }
 
+    if (wake_stealer) {
+      WakeStealer(ts, cur_thread_count);
+    }
+
     if (try_new_thread && gpr_spinlock_trylock(&adding_thread_lock_)) {
       cur_thread_count = static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
       if (cur_thread_count < max_threads_) {
@@ -382,7 +645,10 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
         gpr_atm_rel_store(&num_threads_, cur_thread_count + 1);
 
         thd_state_[cur_thread_count].thd = grpc_core::Thread(
-            name_, &Executor::ThreadMain, &thd_state_[cur_thread_count]);
+            name_, &Executor::ThreadMain, &thd_state_[cur_thread_count],
+            nullptr,
+            grpc_core::Thread::Options().set_numa_node(
+                grpc_iomgr_thread_numa_node(cur_thread_count)));
         thd_state_[cur_thread_count].thd.Start();
       }
       gpr_spinlock_unlock(&adding_thread_lock_);
@@ -404,16 +670,26 @@ void Executor::InitAll() {
   if (executors[static_cast<size_t>(ExecutorType::DEFAULT)] != nullptr) {
     GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::RESOLVER)] !=
                nullptr);
+    GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)] !=
+               nullptr);
     return;
   }
 
   executors[static_cast<size_t>(ExecutorType::DEFAULT)] =
       grpc_core::New<Executor>("default-executor");
   executors[static_cast<size_t>(ExecutorType::RESOLVER)] =
-      grpc_core::New<Executor>("resolver-executor");
+      grpc_core::New<Executor>(
+          "resolver-executor",
+          GPR_MAX(0, GPR_GLOBAL_CONFIG_GET(grpc_resolver_executor_threads)));
+  executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)] =
+      grpc_core::New<Executor>(
+          "control-plane-executor",
+          GPR_MAX(0,
+                  GPR_GLOBAL_CONFIG_GET(grpc_control_plane_executor_threads)));
 
   executors[static_cast<size_t>(ExecutorType::DEFAULT)]->Init();
   executors[static_cast<size_t>(ExecutorType::RESOLVER)]->Init();
+  executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)]->Init();
 
   EXECUTOR_TRACE0("Executor::InitAll() done");
 }
@@ -435,11 +711,14 @@ void Executor::ShutdownAll() {
   if (executors[static_cast<size_t>(ExecutorType::DEFAULT)] == nullptr) {
     GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::RESOLVER)] ==
                nullptr);
+    GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)] ==
+               nullptr);
     return;
   }
 
   executors[static_cast<size_t>(ExecutorType::DEFAULT)]->Shutdown();
   executors[static_cast<size_t>(ExecutorType::RESOLVER)]->Shutdown();
+  executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)]->Shutdown();
 
   // Delete the executor objects.
   //
@@ -457,8 +736,11 @@ void Executor::ShutdownAll() {
       executors[static_cast<size_t>(ExecutorType::DEFAULT)]);
   grpc_core::Delete<Executor>(
       executors[static_cast<size_t>(ExecutorType::RESOLVER)]);
+  grpc_core::Delete<Executor>(
+      executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)]);
   executors[static_cast<size_t>(ExecutorType::DEFAULT)] = nullptr;
   executors[static_cast<size_t>(ExecutorType::RESOLVER)] = nullptr;
+  executors[static_cast<size_t>(ExecutorType::CONTROL_PLANE)] = nullptr;
 
   EXECUTOR_TRACE0("Executor::ShutdownAll() done");
 }
@@ -472,6 +754,13 @@ bool Executor::IsThreadedDefault() {
   return Executor::IsThreaded(ExecutorType::DEFAULT);
 }
 
+bool Executor::IsExecutorThread(ExecutorType executor_type) {
+  GPR_ASSERT(executor_type < ExecutorType::NUM_EXECUTORS);
+  ThreadState* ts = (ThreadState*)gpr_tls_get(&g_this_thread_state);
+  return ts != nullptr &&
+         ts->executor == executors[static_cast<size_t>(executor_type)];
+}
+
 void Executor::SetThreadingAll(bool enable) {
   EXECUTOR_TRACE("Executor::SetThreadingAll(%d) called", enable);
   for (size_t i = 0; i < static_cast<size_t>(ExecutorType::NUM_EXECUTORS);
@@ -22,11 +22,16 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/closure.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_executor_work_stealing);
+
 namespace grpc_core {
 
+class Executor;
+
 struct ThreadState {
   gpr_mu mu;
   size_t id;         // For debugging purposes
@@ -34,14 +39,27 @@ struct ThreadState {
   gpr_cv cv;
   grpc_closure_list elems;
   size_t depth;  // Number of closures in the closure list
+  // Urgent closures are queued ahead of the others, after the last one still
+  // queued (nullptr if none is). urgent_burst counts the urgent closures
+  // queued ahead of others since the thread last got to one of those: past
+  // a limit, they queue at the back like everything else.
+  grpc_closure* urgent_tail;
+  size_t urgent_burst;
   bool shutdown;
   bool queued_long_job;
+  // Work stealing only: the thread has run out of work and is looking for
+  // closures to steal (or sleeping), and whether another thread woke it up
+  // because it queued a closure behind a busy thread.
+  bool waiting;
+  bool steal_wakeup;
+  Executor* executor;
   grpc_core::Thread thd;
 };
 
 enum class ExecutorType {
   DEFAULT = 0,
   RESOLVER,
+  CONTROL_PLANE,
 
   NUM_EXECUTORS  // Add new values above this
 };
@@ -49,16 +67,19 @@ enum class ExecutorType {
 enum class ExecutorJobType {
   SHORT = 0,
   LONG,
+  URGENT,  // A short job that runs ahead of the other jobs queued with it
   NUM_JOB_TYPES  // Add new values above this
 };
 
 class Executor {
  public:
-  Executor(const char* executor_name);
+  /** max_threads of 0 means twice the number of cores */
+  Executor(const char* executor_name, size_t max_threads = 0);
 
   void Init();
 
-  /** Is the executor multi-threaded? */
+  /** Is the executor multi-threaded? (It is, too, while its threads are only
+   *  waiting to be started by the first Enqueue.) */
   bool IsThreaded() const;
 
   /* Enable/disable threading - must be called after Init and Shutdown(). Never
@@ -69,11 +90,17 @@ class Executor {
   void Shutdown();
 
   /** Enqueue the closure onto the executor. is_short is true if the closure is
-   * a short job (i.e expected to not block and complete quickly) */
-  void Enqueue(grpc_closure* closure, grpc_error* error, bool is_short);
+   * a short job (i.e expected to not block and complete quickly); is_urgent
+   * (only for short jobs) queues it ahead of the non urgent closures */
+  void Enqueue(grpc_closure* closure, grpc_error* error, bool is_short,
+               bool is_urgent = false);
+
+  /** Does this executor let idle threads steal closures queued on busy ones?
+   * Controlled by GRPC_EXECUTOR_WORK_STEALING when the executor is created */
+  bool IsWorkStealing() const { return work_stealing_; }
 
-  // TODO(sreek): Currently we have two executors (available globally): The
-  // default executor and the resolver executor.
+  // TODO(sreek): Currently we have three executors (available globally): The
+  // default executor, the resolver executor and the control plane executor.
   //
   // Some of the functions below operate on the DEFAULT executor only while some
   // operate of ALL the executors. This is a bit confusing and should be cleaned
@@ -106,15 +133,33 @@ class Executor {
   // Return if the DEFAULT executor is threaded
   static bool IsThreadedDefault();
 
+  // Return if the calling thread is one of the threads of the given executor
+  static bool IsExecutorThread(ExecutorType executor_type);
+
  private:
   static size_t RunClosures(const char* executor_name, grpc_closure_list list);
   static void ThreadMain(void* arg);
 
+  // Work stealing scheduling: each thread runs its own closures one at a time
+  // (so that the ones behind a long running closure stay visible to other
+  // threads) and, once it runs out, takes the oldest closure queued on another
+  // thread.
+  void WorkStealingThreadLoop(ThreadState* ts);
+  grpc_closure* StealClosure(ThreadState* thief);
+  void WakeStealer(ThreadState* busy_ts, size_t cur_thread_count);
+
+  // Starts the threads Init() left to the first Enqueue, if still pending
+  void StartPendingThreads();
+
   const char* name_;
   ThreadState* thd_state_;
   size_t max_threads_;
   gpr_atm num_threads_;
   gpr_spinlock adding_thread_lock_;
+  gpr_atm start_pending_;  // Init() left starting threads to Enqueue()
+  gpr_spinlock start_lock_;
+  const bool work_stealing_;
+  gpr_atm num_waiting_;  // Threads with ThreadState::waiting set
 };
 
 }  // namespace grpc_core
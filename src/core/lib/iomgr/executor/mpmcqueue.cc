@@ -180,4 +180,166 @@ void InfLenFIFOQueue::RemoveWaiter(Waiter* waiter) {
 
 InfLenFIFOQueue::Waiter* InfLenFIFOQueue::TopWaiter() { return waiters_.next; }
 
+LockFreeMPMCQueue::LockFreeMPMCQueue(size_t ring_size) {
+  size_t size = 2;
+  while (size < ring_size) size *= 2;
+  mask_ = size - 1;
+  ring_ = static_cast<Slot*>(gpr_malloc(sizeof(Slot) * size));
+  for (size_t i = 0; i < size; ++i) {
+    new (&ring_[i]) Slot();
+    ring_[i].seq.Store(i, MemoryOrder::RELAXED);
+    ring_[i].elem = nullptr;
+  }
+  waiters_.next = &waiters_;
+  waiters_.prev = &waiters_;
+}
+
+LockFreeMPMCQueue::~LockFreeMPMCQueue() {
+  GPR_ASSERT(count_.Load(MemoryOrder::RELAXED) == 0);
+  gpr_free(overflow_);
+  gpr_free(ring_);
+}
+
+bool LockFreeMPMCQueue::TryPutRing(void* elem) {
+  size_t pos = enqueue_pos_.Load(MemoryOrder::RELAXED);
+  Slot* slot;
+  while (true) {
+    slot = &ring_[pos & mask_];
+    size_t seq = slot->seq.Load(MemoryOrder::ACQUIRE);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      // The slot is free for this position: claim the position.
+      if (enqueue_pos_.CompareExchangeWeak(&pos, pos + 1, MemoryOrder::RELAXED,
+                                           MemoryOrder::RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // The slot still holds the element from one lap ago: full.
+      return false;
+    } else {
+      // Another producer claimed this position first.
+      pos = enqueue_pos_.Load(MemoryOrder::RELAXED);
+    }
+  }
+  slot->elem = elem;
+  slot->seq.Store(pos + 1, MemoryOrder::RELEASE);
+  return true;
+}
+
+bool LockFreeMPMCQueue::TryGetRing(void** elem) {
+  size_t pos = dequeue_pos_.Load(MemoryOrder::RELAXED);
+  Slot* slot;
+  while (true) {
+    slot = &ring_[pos & mask_];
+    size_t seq = slot->seq.Load(MemoryOrder::ACQUIRE);
+    intptr_t diff =
+        static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0) {
+      // The slot holds the element for this position: claim the position.
+      if (dequeue_pos_.CompareExchangeWeak(&pos, pos + 1, MemoryOrder::RELAXED,
+                                           MemoryOrder::RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // No element has been published for this position yet: empty.
+      return false;
+    } else {
+      // Another consumer claimed this position first.
+      pos = dequeue_pos_.Load(MemoryOrder::RELAXED);
+    }
+  }
+  *elem = slot->elem;
+  // Hand the slot to the producer one lap ahead.
+  slot->seq.Store(pos + mask_ + 1, MemoryOrder::RELEASE);
+  return true;
+}
+
+bool LockFreeMPMCQueue::TryGet(void** elem) {
+  if (!TryGetRing(elem)) {
+    if (overflow_count_.Load(MemoryOrder::ACQUIRE) == 0) return false;
+    MutexLock l(&overflow_mu_);
+    if (overflow_count_.Load(MemoryOrder::RELAXED) == 0) return false;
+    *elem = overflow_[overflow_head_];
+    overflow_head_ = (overflow_head_ + 1) & (overflow_capacity_ - 1);
+    overflow_count_.FetchSub(1, MemoryOrder::RELEASE);
+  }
+  count_.FetchSub(1, MemoryOrder::SEQ_CST);
+  return true;
+}
+
+void LockFreeMPMCQueue::Put(void* elem) {
+  // Keep using the overflow list until it has drained, so that elements in it
+  // are not overtaken by later ones put in the ring.
+  if (overflow_count_.Load(MemoryOrder::ACQUIRE) > 0 || !TryPutRing(elem)) {
+    MutexLock l(&overflow_mu_);
+    size_t count = overflow_count_.Load(MemoryOrder::RELAXED);
+    if (count == overflow_capacity_) {
+      // Grow, unwrapping the elements to the start of the new array.
+      size_t capacity = overflow_capacity_ == 0 ? mask_ + 1 : 2 * count;
+      void** overflow =
+          static_cast<void**>(gpr_malloc(sizeof(void*) * capacity));
+      for (size_t i = 0; i < count; ++i) {
+        overflow[i] = overflow_[(overflow_head_ + i) & (count - 1)];
+      }
+      gpr_free(overflow_);
+      overflow_ = overflow;
+      overflow_capacity_ = capacity;
+      overflow_head_ = 0;
+    }
+    overflow_[(overflow_head_ + count) & (overflow_capacity_ - 1)] = elem;
+    overflow_count_.FetchAdd(1, MemoryOrder::RELEASE);
+  }
+  // Paired with the sleeping consumer's increment of num_waiters_ followed by
+  // a load of count_: one of the two sides sees the other's update, so a
+  // consumer never sleeps through this element.
+  count_.FetchAdd(1, MemoryOrder::SEQ_CST);
+  WakeWaiter();
+}
+
+void LockFreeMPMCQueue::WakeWaiter() {
+  if (num_waiters_.Load(MemoryOrder::SEQ_CST) > 0) {
+    MutexLock l(&mu_);
+    // The waiter leaves the list itself once it runs: signalling it again in
+    // the meantime wakes no one else, which avoids spurious wakeups when
+    // producers outpace consumers. Consumers pass the wakeup on (see Get())
+    // so that elements don't sit in the queue while others sleep.
+    if (waiters_.next != &waiters_) waiters_.next->cv.Signal();
+  }
+}
+
+void* LockFreeMPMCQueue::Get(gpr_timespec* wait_time) {
+  void* elem;
+  if (TryGet(&elem)) {
+    if (count_.Load(MemoryOrder::RELAXED) > 0) WakeWaiter();
+    return elem;
+  }
+
+  gpr_timespec start_time;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace) && wait_time != nullptr) {
+    start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  }
+  do {
+    MutexLock l(&mu_);
+    Waiter self;
+    self.next = waiters_.next;
+    self.prev = &waiters_;
+    self.next->prev = &self;
+    self.prev->next = &self;
+    num_waiters_.FetchAdd(1, MemoryOrder::SEQ_CST);
+    // count_ can be non-zero while TryGet() fails, when another consumer has
+    // taken the element but not yet updated count_: just retry then.
+    while (count_.Load(MemoryOrder::SEQ_CST) == 0) {
+      self.cv.Wait(&mu_);
+    }
+    num_waiters_.FetchSub(1, MemoryOrder::SEQ_CST);
+    self.next->prev = self.prev;
+    self.prev->next = self.next;
+  } while (!TryGet(&elem));
+  if (count_.Load(MemoryOrder::RELAXED) > 0) WakeWaiter();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace) && wait_time != nullptr) {
+    *wait_time = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_time);
+  }
+  return elem;
+}
+
 }  // namespace grpc_core
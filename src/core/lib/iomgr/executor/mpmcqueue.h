@@ -173,6 +173,100 @@ class InfLenFIFOQueue : public MPMCQueueInterface {
   Node* AllocateNodes(int num);
 };
 
+// A Multiple-Producer-Multiple-Consumer queue whose Put() and Get() take no
+// lock while there are elements to take and room to put them: elements live in
+// a fixed size ring of slots, each carrying a sequence number that tells
+// producers and consumers whose turn the slot is, based upon the bounded MPMC
+// queue from Dmitry Vyukov here:
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//
+// The queue still has infinite length: when the ring is full, elements spill
+// into a mutex protected, growable overflow list, and further Put()s go there
+// too until
+// consumers, which drain the ring first, have emptied it. Elements are
+// therefore removed in FIFO order, except for Put()s that race with the ring
+// filling up or the overflow list draining.
+// Consumers only take a lock to sleep on an empty queue; producers only take
+// it when a consumer is asleep.
+class LockFreeMPMCQueue : public MPMCQueueInterface {
+ public:
+  // Creates a new queue whose lock-free ring has room for ring_size elements
+  // (rounded up to a power of two).
+  explicit LockFreeMPMCQueue(size_t ring_size = kDefaultRingSize);
+
+  // Releases all resources held by the queue. The queue must be empty, and no
+  // one waits on conditional variables.
+  ~LockFreeMPMCQueue();
+
+  // Puts elem into queue immediately at the end of queue. Since the queue has
+  // infinite length, this routine will never block and should never fail.
+  void Put(void* elem) override;
+
+  // Removes the oldest element from the queue and returns it.
+  // This routine will cause the thread to block if queue is currently empty.
+  // If wait_time is given and the trace flag is on, it is set to the time
+  // spent blocked.
+  void* Get(gpr_timespec* wait_time = nullptr) override;
+
+  // Returns number of elements in queue currently.
+  // There might be concurrently add/remove on queue, so count might change
+  // quickly.
+  int count() const override { return count_.Load(MemoryOrder::RELAXED); }
+
+  // For test purpose only. Returns the number of elements the ring can hold.
+  size_t ring_size() const { return mask_ + 1; }
+
+ private:
+  static const size_t kDefaultRingSize = 1024;
+
+  struct Slot {
+    Atomic<size_t> seq;
+    void* elem;
+  };
+
+  // Lock-free ring operations: return false if the ring is full (or empty).
+  bool TryPutRing(void* elem);
+  bool TryGetRing(void** elem);
+
+  // Takes an element from the ring, or else the overflow list; returns false
+  // if neither had one. Updates count_ on success.
+  bool TryGet(void** elem);
+
+  // Wakes the most recent waiting consumer, if any.
+  void WakeWaiter();
+
+  Slot* ring_;
+  size_t mask_;
+
+  // Producer and consumer positions are written by different threads: keep
+  // them (and the rest of the state) on separate cache lines.
+  char pad0_[GPR_CACHELINE_SIZE];
+  Atomic<size_t> enqueue_pos_{0};
+  char pad1_[GPR_CACHELINE_SIZE];
+  Atomic<size_t> dequeue_pos_{0};
+  char pad2_[GPR_CACHELINE_SIZE];
+
+  // Node for waiting consumer list, as in InfLenFIFOQueue: one consumer waits
+  // on each CondVar, and the most recent waiter is woken first.
+  struct Waiter {
+    CondVar cv;
+    Waiter* next;
+    Waiter* prev;
+  };
+
+  Atomic<int> count_{0};        // Number of elements in queue
+  Atomic<int> num_waiters_{0};  // Length of the waiter list
+  Mutex mu_;                    // Protects the waiter list
+  Waiter waiters_;              // Head of the waiter list
+
+  // Overflow list: a circular array, doubled in size when full.
+  Mutex overflow_mu_;  // Protects the overflow list
+  void** overflow_ = nullptr;
+  size_t overflow_capacity_ = 0;
+  size_t overflow_head_ = 0;       // Index of the oldest element
+  Atomic<int> overflow_count_{0};  // Number of elements in overflow list
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_MPMCQUEUE_H */
@@ -54,7 +54,14 @@ void ThreadPool::SharedThreadPoolConstructor() {
   // Create at least 1 worker thread.
   if (num_threads_ <= 0) num_threads_ = 1;
 
-  queue_ = New<InfLenFIFOQueue>();
+  switch (queue_type_) {
+    case QueueType::kInfLenFIFO:
+      queue_ = New<InfLenFIFOQueue>();
+      break;
+    case QueueType::kLockFree:
+      queue_ = New<LockFreeMPMCQueue>();
+      break;
+  }
   threads_ = static_cast<ThreadPoolWorker**>(
       gpr_zalloc(num_threads_ * sizeof(ThreadPoolWorker*)));
   for (int i = 0; i < num_threads_; ++i) {
@@ -102,6 +109,19 @@ ThreadPool::ThreadPool(int num_threads, const char* thd_name,
   SharedThreadPoolConstructor();
 }
 
+ThreadPool::ThreadPool(int num_threads, const char* thd_name,
+                       const Thread::Options& thread_options,
+                       QueueType queue_type)
+    : num_threads_(num_threads),
+      thd_name_(thd_name),
+      thread_options_(thread_options),
+      queue_type_(queue_type) {
+  if (thread_options_.stack_size() == 0) {
+    thread_options_.set_stack_size(DefaultStackSize());
+  }
+  SharedThreadPoolConstructor();
+}
+
 ThreadPool::~ThreadPool() {
   // For debug checking purpose, using RELAXED order is sufficient.
   shut_down_.Store(true, MemoryOrder::RELAXED);
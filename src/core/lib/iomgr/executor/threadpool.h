@@ -100,6 +100,12 @@ class ThreadPoolWorker {
 // capacity of closure queue is unlimited.
 class ThreadPool : public ThreadPoolInterface {
  public:
+  // Implementations of the pending closure queue that a pool can use.
+  enum class QueueType {
+    kInfLenFIFO,  // InfLenFIFOQueue: one mutex shared by all adds and workers
+    kLockFree,    // LockFreeMPMCQueue: no locking while there is work to do
+  };
+
   // Creates a thread pool with size of "num_threads", with default thread name
   // "ThreadPoolWorker" and all thread options set to default. If the given size
   // is 0 or less, there will be 1 worker thread created inside pool.
@@ -119,6 +125,13 @@ class ThreadPool : public ThreadPoolInterface {
   ThreadPool(int num_threads, const char* thd_name,
              const Thread::Options& thread_options);
 
+  // Same as ThreadPool(int num_threads, const char* thd_name,
+  // const Thread::Options& thread_options) constructor, except that it also
+  // selects the implementation of the closure queue. The other constructors
+  // use QueueType::kInfLenFIFO.
+  ThreadPool(int num_threads, const char* thd_name,
+             const Thread::Options& thread_options, QueueType queue_type);
+
   // Waits for all pending closures to complete, then shuts down thread pool.
   ~ThreadPool() override;
 
@@ -135,6 +148,7 @@ class ThreadPool : public ThreadPoolInterface {
   int num_threads_ = 0;
   const char* thd_name_ = nullptr;
   Thread::Options thread_options_;
+  QueueType queue_type_ = QueueType::kInfLenFIFO;
   ThreadPoolWorker** threads_ = nullptr;  // Array of worker threads
   MPMCQueueInterface* queue_ = nullptr;   // Closure queue
 
@@ -26,6 +26,8 @@
 #ifdef GRPC_POSIX_SOCKET_TCP
 
 #include <errno.h>
+#include <netinet/in.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/utsname.h>
@@ -56,12 +58,45 @@ void grpc_errqueue_init() {
   }
 #endif /* GRPC_LINUX_ERRQUEUE */
 }
+
+bool get_socket_tcp_info(int fd, TcpInfoSample* sample) {
+#ifdef GRPC_LINUX_ERRQUEUE
+  tcp_info info;
+  memset(&info, 0, sizeof(info));
+  info.length = sizeof(info) - sizeof(socklen_t);
+  if (getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &info.length) != 0) {
+    return false;
+  }
+  /* Older kernels return a shorter struct; what they leave out stays zero. */
+  sample->state = info.tcpi_state;
+  sample->ca_state = info.tcpi_ca_state;
+  sample->retransmits = info.tcpi_retransmits;
+  sample->rto_usec = info.tcpi_rto;
+  sample->snd_mss = info.tcpi_snd_mss;
+  sample->unacked = info.tcpi_unacked;
+  sample->lost = info.tcpi_lost;
+  sample->retrans = info.tcpi_retrans;
+  sample->rtt_usec = info.tcpi_rtt;
+  sample->rttvar_usec = info.tcpi_rttvar;
+  sample->snd_ssthresh = info.tcpi_snd_ssthresh;
+  sample->snd_cwnd = info.tcpi_snd_cwnd;
+  sample->reordering = info.tcpi_reordering;
+  sample->total_retrans = info.tcpi_total_retrans;
+  sample->min_rtt_usec = info.tcpi_min_rtt;
+  sample->delivery_rate = info.tcpi_delivery_rate;
+  return true;
+#else
+  return false;
+#endif /* GRPC_LINUX_ERRQUEUE */
+}
 } /* namespace grpc_core */
 
 #else
 
 namespace grpc_core {
 void grpc_errqueue_init() {}
+
+bool get_socket_tcp_info(int fd, TcpInfoSample* sample) { return false; }
 } /* namespace grpc_core */
 
 #endif /* GRPC_POSIX_SOCKET_TCP */
@@ -29,6 +29,8 @@
 
 #include "src/core/lib/iomgr/port.h"
 
+#include <stdint.h>
+
 #ifdef GRPC_POSIX_SOCKET_TCP
 
 #include <sys/types.h>
@@ -172,6 +174,18 @@ struct tcp_info {
 #ifndef TCP_INFO
 #define TCP_INFO 11
 #endif
+
+/* Redefine zerocopy constants from <linux/socket.h> and <linux/errqueue.h>
+ * (available since 4.14) so that tcp_posix.cc compiles on older headers. */
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
 #endif /* GRPC_LINUX_ERRQUEUE */
 
 /* Returns true if kernel is capable of supporting errqueue and timestamping.
@@ -186,6 +200,36 @@ bool kernel_supports_errqueue();
 namespace grpc_core {
 /* Initializes errqueue support */
 void grpc_errqueue_init();
+
+/* The parts of the kernel's TCP_INFO for a socket that are useful for
+ * diagnosing network-bound latency. Times are in microseconds. Fields the
+ * kernel does not report are zero: min_rtt_usec needs Linux 4.10 and
+ * delivery_rate (bytes per second) 4.9.
+ */
+struct TcpInfoSample {
+  uint8_t state;
+  uint8_t ca_state;
+  uint8_t retransmits;
+  uint32_t rto_usec;
+  uint32_t snd_mss;
+  uint32_t unacked;
+  uint32_t lost;
+  uint32_t retrans;
+  uint32_t rtt_usec;
+  uint32_t rttvar_usec;
+  uint32_t snd_ssthresh;
+  uint32_t snd_cwnd;
+  uint32_t reordering;
+  uint32_t total_retrans;
+  uint32_t min_rtt_usec;
+  uint64_t delivery_rate;
+};
+
+/* Reads TCP_INFO for the TCP socket \a fd into \a sample, with a single
+ * getsockopt. Returns false if it is not available on this platform or for
+ * this socket.
+ */
+bool get_socket_tcp_info(int fd, TcpInfoSample* sample);
 } /* namespace grpc_core */
 
 #endif /* GRPC_CORE_LIB_IOMGR_INTERNAL_ERRQUEUE_H */
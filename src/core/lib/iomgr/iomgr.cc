@@ -29,27 +29,40 @@
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gpr/cpu.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/buffer_list.h"
+#include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/internal_errqueue.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/iomgr/resource_quota.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/iomgr/timer_manager.h"
 
 GPR_GLOBAL_CONFIG_DEFINE_BOOL(grpc_abort_on_leaks, false,
                               "A debugging aid to cause a call to abort() when "
                               "gRPC objects are leaked past grpc_shutdown()");
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_numa_thread_placement, false,
+    "If set, gRPC's internal threads are spread across the NUMA nodes of the "
+    "machine and each one is bound to the CPUs of its node");
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_lazy_thread_start, true,
+    "If set, gRPC's executor and timer threads are only started once they "
+    "first have work, which makes grpc_init cheaper for short-lived processes");
 
 static gpr_mu g_mu;
 static gpr_cv g_rcv;
 static int g_shutdown;
 static grpc_iomgr_object g_root_object;
 static bool g_grpc_abort_on_leaks;
+static bool g_numa_thread_placement;
+static bool g_lazy_thread_start;
 
 void grpc_iomgr_init() {
   grpc_core::ExecCtx exec_ctx;
@@ -57,6 +70,10 @@ void grpc_iomgr_init() {
   g_shutdown = 0;
   gpr_mu_init(&g_mu);
   gpr_cv_init(&g_rcv);
+  g_numa_thread_placement = GPR_GLOBAL_CONFIG_GET(grpc_numa_thread_placement);
+  g_lazy_thread_start = GPR_GLOBAL_CONFIG_GET(grpc_lazy_thread_start);
+  grpc_combiner_global_init();
+  grpc_resource_quota_global_init();
   grpc_core::Executor::InitAll();
   g_root_object.next = g_root_object.prev = &g_root_object;
   g_root_object.name = (char*)"root";
@@ -68,6 +85,13 @@ void grpc_iomgr_init() {
 
 void grpc_iomgr_start() { grpc_timer_manager_init(); }
 
+int grpc_iomgr_thread_numa_node(size_t thread_index) {
+  if (!g_numa_thread_placement) return -1;
+  return static_cast<int>(thread_index % gpr_cpu_num_numa_nodes());
+}
+
+bool grpc_iomgr_lazy_thread_start() { return g_lazy_thread_start; }
+
 static size_t count_objects(void) {
   grpc_iomgr_object* obj;
   size_t n = 0;
@@ -21,11 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/port.h"
 
 #include <stdlib.h>
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_numa_thread_placement);
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_lazy_thread_start);
+
 /** Initializes the iomgr. */
 void grpc_iomgr_init();
 
@@ -54,6 +58,16 @@ bool grpc_iomgr_is_any_background_poller_thread();
 bool grpc_iomgr_add_closure_to_background_poller(grpc_closure* closure,
                                                  grpc_error* error);
 
+/** Returns the NUMA node the \a thread_index-th thread of one of iomgr's
+ * thread pools (executors, timer threads) should be bound to, spreading the
+ * pool evenly across the nodes; or -1 if GRPC_NUMA_THREAD_PLACEMENT is not set
+ * and threads are not bound. */
+int grpc_iomgr_thread_numa_node(size_t thread_index);
+
+/** Returns true if the executors and the timer manager should only start
+ * their threads once they first get work (GRPC_LAZY_THREAD_START). */
+bool grpc_iomgr_lazy_thread_start();
+
 /* Exposed only for testing */
 size_t grpc_iomgr_count_objects_for_testing();
 
@@ -54,3 +54,9 @@ grpc_error* grpc_pollset_kick(grpc_pollset* pollset,
 }
 
 size_t grpc_pollset_size(void) { return grpc_pollset_impl->pollset_size(); }
+
+void grpc_pollset_enable_busy_poll(grpc_pollset* pollset, int max_budget_us) {
+  if (grpc_pollset_impl->enable_busy_poll != nullptr) {
+    grpc_pollset_impl->enable_busy_poll(pollset, max_budget_us);
+  }
+}
@@ -49,6 +49,8 @@ typedef struct grpc_pollset_vtable {
   grpc_error* (*kick)(grpc_pollset* pollset,
                       grpc_pollset_worker* specific_worker);
   size_t (*pollset_size)(void);
+  /* May be null if busy polling is not supported */
+  void (*enable_busy_poll)(grpc_pollset* pollset, int max_budget_us);
 } grpc_pollset_vtable;
 
 void grpc_set_pollset_vtable(grpc_pollset_vtable* vtable);
@@ -96,4 +98,10 @@ grpc_error* grpc_pollset_kick(grpc_pollset* pollset,
                               grpc_pollset_worker* specific_worker)
     GRPC_MUST_USE_RESULT;
 
+/* Let threads polling on behalf of this pollset spin, polling without
+   blocking, for up to max_budget_us microseconds before they block; 0 turns
+   spinning off. Pollers may spin for less when events seldom arrive within
+   the budget. A no-op where busy polling is not supported. */
+void grpc_pollset_enable_busy_poll(grpc_pollset* pollset, int max_budget_us);
+
 #endif /* GRPC_CORE_LIB_IOMGR_POLLSET_H */
@@ -98,7 +98,8 @@ grpc_pollset_vtable custom_pollset_vtable = {
     pollset_global_init, pollset_global_shutdown,
     pollset_init,        pollset_shutdown,
     pollset_destroy,     pollset_work,
-    pollset_kick,        pollset_size};
+    pollset_kick,        pollset_size,
+    nullptr};
 
 void grpc_custom_pollset_init(grpc_custom_poller_vtable* vtable) {
   poller_vtable = vtable;
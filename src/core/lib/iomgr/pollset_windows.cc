@@ -224,6 +224,7 @@ grpc_pollset_vtable grpc_windows_pollset_vtable = {
     pollset_global_init, pollset_global_shutdown,
     pollset_init,        pollset_shutdown,
     pollset_destroy,     pollset_work,
-    pollset_kick,        pollset_size};
+    pollset_kick,        pollset_size,
+    nullptr};
 
 #endif /* GRPC_WINSOCK_SOCKET */
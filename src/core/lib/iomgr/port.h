@@ -73,6 +73,16 @@
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
 #define GRPC_LINUX_ERRQUEUE 1
 #endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0) */
+/* Kernel TLS transmit offload (TCP_ULP "tls" with TLS_TX) appeared in 4.13.
+   Runtime support depends on the tls module being available. */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 13, 0)
+#define GRPC_LINUX_KTLS 1
+#endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(4, 13, 0) */
+/* The io_uring polling engine relies on multishot poll requests, which first
+   appeared in 5.13 headers. Runtime support is probed when the engine starts. */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0)
+#define GRPC_LINUX_IO_URING 1
+#endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0) */
 #endif /* LINUX_VERSION_CODE */
 #define GRPC_LINUX_MULTIPOLL_WITH_EPOLL 1
 #define GRPC_POSIX_FORK 1
@@ -90,6 +100,10 @@
 #if __GLIBC_PREREQ(2, 10)
 #define GRPC_LINUX_SOCKETUTILS 1
 #endif
+#if __GLIBC_PREREQ(2, 14)
+/* recvmmsg (glibc 2.12) and sendmmsg (glibc 2.14) */
+#define GRPC_LINUX_MMSG 1
+#endif
 #endif
 #ifdef LINUX_VERSION_CODE
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 37)
@@ -132,6 +146,7 @@
 #define GRPC_POSIX_SOCKET_ARES_EV_DRIVER 1
 #define GRPC_POSIX_SOCKET_EV 1
 #define GRPC_POSIX_SOCKET_EV_EPOLL1 1
+#define GRPC_POSIX_SOCKET_EV_URING 1
 #define GRPC_POSIX_SOCKET_EV_EPOLLEX 1
 #define GRPC_POSIX_SOCKET_EV_POLL 1
 #define GRPC_POSIX_SOCKET_RESOLVE_ADDRESS 1
@@ -218,6 +233,7 @@
 #define GRPC_POSIX_SOCKET_EV_EPOLLEX 1
 #define GRPC_POSIX_SOCKET_EV_POLL 1
 #define GRPC_POSIX_SOCKET_EV_EPOLL1 1
+#define GRPC_POSIX_SOCKET_EV_URING 1
 #define GRPC_POSIX_SOCKET_IF_NAMETOINDEX 1
 #define GRPC_POSIX_SOCKET_IOMGR 1
 #define GRPC_POSIX_SOCKET_RESOLVE_ADDRESS 1
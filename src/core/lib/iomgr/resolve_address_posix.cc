@@ -33,9 +33,11 @@
 #include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/gprpp/map.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/executor.h"
@@ -83,6 +85,7 @@ static grpc_error* posix_blocking_resolve_address(
   hints.ai_socktype = SOCK_STREAM; /* stream socket */
   hints.ai_flags = AI_PASSIVE;     /* for wildcard IP address */
 
+  GRPC_STATS_INC_RESOLVER_LOOKUPS();
   GRPC_SCHEDULING_START_BLOCKING_REGION;
   s = getaddrinfo(host.get(), port.get(), &hints, &result);
   GRPC_SCHEDULING_END_BLOCKING_REGION;
@@ -139,40 +142,120 @@ done:
   return err;
 }
 
-typedef struct {
-  char* name;
-  char* default_port;
+typedef struct request {
   grpc_closure* on_done;
   grpc_resolved_addresses** addrs_out;
-  grpc_closure request_closure;
-  void* arg;
+  /* next request waiting for the same lookup */
+  struct request* next;
 } request;
 
+/* A getaddrinfo() call in flight, and the requests waiting for its result.
+   Requests for a name and default port already being looked up wait for that
+   lookup rather than starting another, so a slow name takes up one resolver
+   executor thread however many channels resolve it. */
+typedef struct lookup {
+  char* key;
+  char* name;
+  char* default_port;
+  request* waiters;
+  grpc_closure closure;
+} lookup;
+
+static gpr_once g_lookups_once = GPR_ONCE_INIT;
+static gpr_mu g_lookups_mu;
+/* lookups in flight, by key; guarded by g_lookups_mu */
+static grpc_core::Map<const char*, lookup*, grpc_core::StringLess>* g_lookups;
+
+static void init_lookups(void) {
+  gpr_mu_init(&g_lookups_mu);
+  g_lookups = grpc_core::New<
+      grpc_core::Map<const char*, lookup*, grpc_core::StringLess>>();
+}
+
+static grpc_resolved_addresses* copy_addresses(
+    const grpc_resolved_addresses* addresses) {
+  grpc_resolved_addresses* copy = static_cast<grpc_resolved_addresses*>(
+      gpr_malloc(sizeof(grpc_resolved_addresses)));
+  copy->naddrs = addresses->naddrs;
+  copy->addrs = static_cast<grpc_resolved_address*>(
+      gpr_malloc(sizeof(grpc_resolved_address) * addresses->naddrs));
+  memcpy(copy->addrs, addresses->addrs,
+         sizeof(grpc_resolved_address) * addresses->naddrs);
+  return copy;
+}
+
 /* Callback to be passed to grpc Executor to asynch-ify
  * grpc_blocking_resolve_address */
-static void do_request_thread(void* rp, grpc_error* error) {
-  request* r = static_cast<request*>(rp);
-  GRPC_CLOSURE_SCHED(r->on_done, grpc_blocking_resolve_address(
-                                     r->name, r->default_port, r->addrs_out));
-  gpr_free(r->name);
-  gpr_free(r->default_port);
-  gpr_free(r);
+static void do_request_thread(void* lp, grpc_error* error) {
+  lookup* l = static_cast<lookup*>(lp);
+  grpc_resolved_addresses* addresses = nullptr;
+  grpc_error* err =
+      grpc_blocking_resolve_address(l->name, l->default_port, &addresses);
+  gpr_mu_lock(&g_lookups_mu);
+  g_lookups->erase(l->key);
+  request* waiters = l->waiters;
+  gpr_mu_unlock(&g_lookups_mu);
+  while (waiters != nullptr) {
+    request* r = waiters;
+    waiters = r->next;
+    if (err == GRPC_ERROR_NONE) {
+      // The last waiter gets the original.
+      if (waiters == nullptr) {
+        *r->addrs_out = addresses;
+        addresses = nullptr;
+      } else {
+        *r->addrs_out = copy_addresses(addresses);
+      }
+    }
+    GRPC_CLOSURE_SCHED(r->on_done, GRPC_ERROR_REF(err));
+    gpr_free(r);
+  }
+  GRPC_ERROR_UNREF(err);
+  if (addresses != nullptr) grpc_resolved_addresses_destroy(addresses);
+  gpr_free(l->key);
+  gpr_free(l->name);
+  gpr_free(l->default_port);
+  gpr_free(l);
 }
 
 static void posix_resolve_address(const char* name, const char* default_port,
                                   grpc_pollset_set* interested_parties,
                                   grpc_closure* on_done,
                                   grpc_resolved_addresses** addrs) {
+  gpr_once_init(&g_lookups_once, init_lookups);
   request* r = static_cast<request*>(gpr_malloc(sizeof(request)));
-  GRPC_CLOSURE_INIT(
-      &r->request_closure, do_request_thread, r,
-      grpc_core::Executor::Scheduler(grpc_core::ExecutorType::RESOLVER,
-                                     grpc_core::ExecutorJobType::SHORT));
-  r->name = gpr_strdup(name);
-  r->default_port = gpr_strdup(default_port);
   r->on_done = on_done;
   r->addrs_out = addrs;
-  GRPC_CLOSURE_SCHED(&r->request_closure, GRPC_ERROR_NONE);
+  char* key;
+  gpr_asprintf(&key, "%s\n%s", name,
+               default_port == nullptr ? "" : default_port);
+  gpr_mu_lock(&g_lookups_mu);
+  auto it = g_lookups->find(key);
+  if (it != g_lookups->end()) {
+    // Wait for the lookup in flight.
+    r->next = it->second->waiters;
+    it->second->waiters = r;
+    gpr_mu_unlock(&g_lookups_mu);
+    gpr_free(key);
+    GRPC_STATS_INC_RESOLVER_LOOKUPS_SHARED();
+    return;
+  }
+  lookup* l = static_cast<lookup*>(gpr_malloc(sizeof(lookup)));
+  l->key = key;
+  l->name = gpr_strdup(name);
+  l->default_port = gpr_strdup(default_port);
+  r->next = nullptr;
+  l->waiters = r;
+  (*g_lookups)[l->key] = l;
+  gpr_mu_unlock(&g_lookups_mu);
+  // getaddrinfo() may block for a long time, so run it as a long job: the
+  // resolver executor then gives it a thread of its own (up to its thread
+  // limit) instead of queueing it behind other lookups.
+  GRPC_CLOSURE_INIT(
+      &l->closure, do_request_thread, l,
+      grpc_core::Executor::Scheduler(grpc_core::ExecutorType::RESOLVER,
+                                     grpc_core::ExecutorJobType::LONG));
+  GRPC_CLOSURE_SCHED(&l->closure, GRPC_ERROR_NONE);
 }
 
 grpc_address_resolver_vtable grpc_posix_resolver_vtable = {
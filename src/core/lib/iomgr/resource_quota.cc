@@ -27,15 +27,38 @@
 
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 grpc_core::TraceFlag grpc_resource_quota_trace(false, "resource_quota");
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_resource_quota_sharded_accounting, false,
+    "If set, resource quotas account the memory in use through per CPU credit "
+    "caches, only updating the quota wide count when a cache runs out or "
+    "overflows");
+
+static bool g_sharded_accounting;
+
+/* Upper bound on the credit a shard takes from the quota wide used count at a
+   time; a shard returns credit once it holds twice this much */
+#define RQ_CREDIT_BATCH (64 * 1024)
+/* Shards of the used count, when sharded accounting is on */
+#define RQ_MAX_USED_SHARDS 64
+
+/* Bytes already counted in grpc_resource_quota::used that no allocation is
+   using yet: allocations on this shard's CPUs draw on it, frees add to it */
+typedef struct {
+  gpr_atm credit;
+  char padding[GPR_CACHELINE_SIZE - sizeof(gpr_atm)];
+} rq_used_shard;
+
 #define MEMORY_USAGE_ESTIMATION_MAX 65536
 
 /* Internal linked list pointers for a resource user */
@@ -138,8 +161,13 @@ struct grpc_resource_quota {
   /* Amount of free memory in the resource quota */
   int64_t free_pool;
   /* Used size of memory in the resource quota. Updated as soon as the resource
-   * users start to allocate or free the memory. */
+   * users start to allocate or free the memory. With sharded accounting this
+   * also counts the credit cached in used_shards, so it never undercounts. */
   gpr_atm used;
+  /* Per CPU credit caches in front of used, or NULL if sharded accounting is
+   * off */
+  rq_used_shard* used_shards;
+  size_t num_used_shards;
 
   gpr_atm last_size;
 
@@ -427,6 +455,81 @@ static bool rq_reclaim(grpc_resource_quota* resource_quota, bool destructive) {
   return true;
 }
 
+/*******************************************************************************
+ * used count accounting: these do not need the quota combiner
+ */
+
+static rq_used_shard* rq_current_used_shard(
+    grpc_resource_quota* resource_quota) {
+  return &resource_quota
+              ->used_shards[gpr_cpu_current_cpu() %
+                            resource_quota->num_used_shards];
+}
+
+/* Credit a shard takes at a time: small quotas get proportionally less, so
+   that cached credit cannot hold a large part of them */
+static gpr_atm rq_credit_batch(grpc_resource_quota* resource_quota) {
+  size_t size = grpc_resource_quota_peek_size(resource_quota);
+  return static_cast<gpr_atm>(GPR_MIN(
+      static_cast<size_t>(RQ_CREDIT_BATCH),
+      size / (4 * resource_quota->num_used_shards)));
+}
+
+static void rq_charge_used(grpc_resource_quota* resource_quota, size_t size) {
+  if (resource_quota->used_shards == nullptr) {
+    gpr_atm_no_barrier_fetch_add(&resource_quota->used, size);
+    return;
+  }
+  rq_used_shard* shard = rq_current_used_shard(resource_quota);
+  gpr_atm credit = gpr_atm_no_barrier_load(&shard->credit);
+  while (credit >= static_cast<gpr_atm>(size)) {
+    if (gpr_atm_no_barrier_cas(&shard->credit, credit,
+                               credit - static_cast<gpr_atm>(size))) {
+      return;
+    }
+    credit = gpr_atm_no_barrier_load(&shard->credit);
+  }
+  // Out of credit: charge the allocation and a new batch of credit in one go.
+  gpr_atm batch = rq_credit_batch(resource_quota);
+  gpr_atm_no_barrier_fetch_add(&resource_quota->used,
+                               static_cast<gpr_atm>(size) + batch);
+  if (batch > 0) gpr_atm_no_barrier_fetch_add(&shard->credit, batch);
+}
+
+static void rq_uncharge_used(grpc_resource_quota* resource_quota,
+                             size_t size) {
+  if (resource_quota->used_shards == nullptr) {
+    gpr_atm prior =
+        gpr_atm_no_barrier_fetch_add(&resource_quota->used, -size);
+    GPR_ASSERT(prior >= static_cast<long>(size));
+    return;
+  }
+  rq_used_shard* shard = rq_current_used_shard(resource_quota);
+  gpr_atm credit = gpr_atm_no_barrier_fetch_add(&shard->credit, size) +
+                   static_cast<gpr_atm>(size);
+  gpr_atm batch = rq_credit_batch(resource_quota);
+  if (credit > 2 * batch &&
+      gpr_atm_no_barrier_cas(&shard->credit, credit, batch)) {
+    // Hand everything above one batch back to the quota.
+    gpr_atm_no_barrier_fetch_add(&resource_quota->used, batch - credit);
+  }
+}
+
+/* Returns all cached credit to the used count, making it exact (as of the
+   time each shard was visited) */
+static void rq_drain_used_credit(grpc_resource_quota* resource_quota) {
+  for (size_t i = 0; i < resource_quota->num_used_shards; i++) {
+    rq_used_shard* shard = &resource_quota->used_shards[i];
+    gpr_atm credit = gpr_atm_no_barrier_load(&shard->credit);
+    while (credit > 0 && !gpr_atm_no_barrier_cas(&shard->credit, credit, 0)) {
+      credit = gpr_atm_no_barrier_load(&shard->credit);
+    }
+    if (credit > 0) {
+      gpr_atm_no_barrier_fetch_add(&resource_quota->used, -credit);
+    }
+  }
+}
+
 /*******************************************************************************
  * ru_slice: a slice implementation that is backed by a grpc_resource_user
  */
@@ -629,6 +732,11 @@ static void rq_reclamation_done(void* rq, grpc_error* error) {
  * grpc_resource_quota api
  */
 
+void grpc_resource_quota_global_init(void) {
+  g_sharded_accounting =
+      GPR_GLOBAL_CONFIG_GET(grpc_resource_quota_sharded_accounting);
+}
+
 /* Public API */
 grpc_resource_quota* grpc_resource_quota_create(const char* name) {
   grpc_resource_quota* resource_quota =
@@ -638,6 +746,15 @@ grpc_resource_quota* grpc_resource_quota_create(const char* name) {
   resource_quota->free_pool = INT64_MAX;
   resource_quota->size = INT64_MAX;
   resource_quota->used = 0;
+  if (g_sharded_accounting) {
+    resource_quota->num_used_shards =
+        GPR_CLAMP(gpr_cpu_num_cores(), 1, RQ_MAX_USED_SHARDS);
+    resource_quota->used_shards = static_cast<rq_used_shard*>(
+        gpr_zalloc(sizeof(rq_used_shard) * resource_quota->num_used_shards));
+  } else {
+    resource_quota->num_used_shards = 0;
+    resource_quota->used_shards = nullptr;
+  }
   gpr_atm_no_barrier_store(&resource_quota->last_size, GPR_ATM_MAX);
   gpr_mu_init(&resource_quota->thread_count_mu);
   resource_quota->max_threads = INT_MAX;
@@ -668,6 +785,7 @@ void grpc_resource_quota_unref_internal(grpc_resource_quota* resource_quota) {
     GPR_ASSERT(resource_quota->num_threads_allocated == 0);
     GRPC_COMBINER_UNREF(resource_quota->combiner, "resource_quota");
     gpr_free(resource_quota->name);
+    gpr_free(resource_quota->used_shards);
     gpr_mu_destroy(&resource_quota->thread_count_mu);
     gpr_free(resource_quota);
   }
@@ -911,11 +1029,20 @@ bool grpc_resource_user_safe_alloc(grpc_resource_user* resource_user,
   gpr_mu_lock(&resource_user->mu);
   grpc_resource_quota* resource_quota = resource_user->resource_quota;
   bool cas_success;
+  // cached credit makes the used count an overestimate: drain it once before
+  // refusing the allocation
+  bool drained = resource_quota->used_shards == nullptr;
   do {
     gpr_atm used = gpr_atm_no_barrier_load(&resource_quota->used);
     gpr_atm new_used = used + size;
     if (static_cast<size_t>(new_used) >
         grpc_resource_quota_peek_size(resource_quota)) {
+      if (!drained) {
+        drained = true;
+        rq_drain_used_credit(resource_quota);
+        cas_success = false;
+        continue;
+      }
       gpr_mu_unlock(&resource_user->mu);
       return false;
     }
@@ -931,17 +1058,14 @@ void grpc_resource_user_alloc(grpc_resource_user* resource_user, size_t size,
   // TODO(juanlishen): Maybe return immediately if shutting down. Deferring this
   // because some tests become flaky after the change.
   gpr_mu_lock(&resource_user->mu);
-  grpc_resource_quota* resource_quota = resource_user->resource_quota;
-  gpr_atm_no_barrier_fetch_add(&resource_quota->used, size);
+  rq_charge_used(resource_user->resource_quota, size);
   resource_user_alloc_locked(resource_user, size, optional_on_done);
   gpr_mu_unlock(&resource_user->mu);
 }
 
 void grpc_resource_user_free(grpc_resource_user* resource_user, size_t size) {
   gpr_mu_lock(&resource_user->mu);
-  grpc_resource_quota* resource_quota = resource_user->resource_quota;
-  gpr_atm prior = gpr_atm_no_barrier_fetch_add(&resource_quota->used, -size);
-  GPR_ASSERT(prior >= static_cast<long>(size));
+  rq_uncharge_used(resource_user->resource_quota, size);
   bool was_zero_or_negative = resource_user->free_pool <= 0;
   resource_user->free_pool += static_cast<int64_t>(size);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
@@ -24,6 +24,7 @@
 #include <grpc/grpc.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/closure.h"
 
 /** \file Tracks resource usage against a pool.
@@ -70,6 +71,11 @@ extern grpc_core::TraceFlag grpc_resource_quota_trace;
 constexpr size_t GRPC_RESOURCE_QUOTA_CALL_SIZE = 15 * 1024;
 constexpr size_t GRPC_RESOURCE_QUOTA_CHANNEL_SIZE = 50 * 1024;
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_resource_quota_sharded_accounting);
+
+/* Read the accounting mode from the environment: called by grpc_iomgr_init */
+void grpc_resource_quota_global_init(void);
+
 grpc_resource_quota* grpc_resource_quota_ref_internal(
     grpc_resource_quota* resource_quota);
 void grpc_resource_quota_unref_internal(grpc_resource_quota* resource_quota);
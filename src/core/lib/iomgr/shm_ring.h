@@ -0,0 +1,165 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_SHM_RING_H
+#define GRPC_CORE_LIB_IOMGR_SHM_RING_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <grpc/support/atm.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+
+// A single-producer single-consumer byte ring in memory that may be shared
+// between processes. The producer and the consumer each advance their own
+// position and only read the other's, so neither needs a lock.
+//
+// To sleep without missing a wakeup, a side first announces that it is about
+// to wait (PrepareToWaitForData/PrepareToWaitForSpace) and sleeps only if the
+// ring is still empty (or full) after that; the other side checks for that
+// announcement after each transfer (TakeReaderWaiting/TakeWriterWaiting) and
+// wakes it. While both sides are busy no wakeups are needed at all.
+class ShmRing {
+ public:
+  // The ring's shared state, which lives in the shared memory in front of its
+  // data. Its all-zero state is an empty, open ring.
+  struct Header {
+    // The total bytes ever written and read; each on its own cache line as
+    // the two sides write them.
+    gpr_atm write_pos;
+    char pad1[GPR_CACHELINE_SIZE - sizeof(gpr_atm)];
+    gpr_atm read_pos;
+    char pad2[GPR_CACHELINE_SIZE - sizeof(gpr_atm)];
+    gpr_atm reader_waiting;
+    gpr_atm writer_waiting;
+    gpr_atm closed;
+    char pad3[GPR_CACHELINE_SIZE - 3 * sizeof(gpr_atm)];
+  };
+
+  // capacity must be a power of two.
+  ShmRing(Header* header, uint8_t* data, size_t capacity)
+      : header_(header), data_(data), capacity_(capacity) {
+    GPR_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  size_t Readable() const {
+    return static_cast<size_t>(
+        static_cast<uintptr_t>(gpr_atm_acq_load(&header_->write_pos)) -
+        static_cast<uintptr_t>(gpr_atm_no_barrier_load(&header_->read_pos)));
+  }
+
+  size_t Writable() const {
+    return capacity_ -
+           static_cast<size_t>(
+               static_cast<uintptr_t>(
+                   gpr_atm_no_barrier_load(&header_->write_pos)) -
+               static_cast<uintptr_t>(gpr_atm_acq_load(&header_->read_pos)));
+  }
+
+  // Copies in as many of the length bytes at data as there is room for, and
+  // returns how many that was. Producer only.
+  size_t Write(const uint8_t* data, size_t length) {
+    const size_t writable = Writable();
+    const size_t n = GPR_MIN(length, writable);
+    const uintptr_t pos =
+        static_cast<uintptr_t>(gpr_atm_no_barrier_load(&header_->write_pos));
+    Copy(data_, pos, data, n, true);
+    gpr_atm_rel_store(&header_->write_pos, static_cast<gpr_atm>(pos + n));
+    return n;
+  }
+
+  // Copies out up to length bytes into data, and returns how many. Consumer
+  // only.
+  size_t Read(uint8_t* data, size_t length) {
+    const size_t readable = Readable();
+    const size_t n = GPR_MIN(length, readable);
+    const uintptr_t pos =
+        static_cast<uintptr_t>(gpr_atm_no_barrier_load(&header_->read_pos));
+    Copy(data, pos, data_, n, false);
+    gpr_atm_rel_store(&header_->read_pos, static_cast<gpr_atm>(pos + n));
+    return n;
+  }
+
+  // Announces that the consumer is about to wait for data, and returns
+  // whether it should: false if data has arrived or the ring was closed.
+  bool PrepareToWaitForData() {
+    gpr_atm_no_barrier_store(&header_->reader_waiting, 1);
+    gpr_atm_full_barrier();
+    return Readable() == 0 && !closed();
+  }
+
+  // Announces that the producer is about to wait for room, and returns
+  // whether it should: false if room was made or the ring was closed.
+  bool PrepareToWaitForSpace() {
+    gpr_atm_no_barrier_store(&header_->writer_waiting, 1);
+    gpr_atm_full_barrier();
+    return Writable() == 0 && !closed();
+  }
+
+  // Called by the producer after writing: returns whether the consumer is
+  // waiting for data and needs waking up.
+  bool TakeReaderWaiting() { return TakeFlag(&header_->reader_waiting); }
+
+  // Called by the consumer after reading: returns whether the producer is
+  // waiting for room and needs waking up.
+  bool TakeWriterWaiting() { return TakeFlag(&header_->writer_waiting); }
+
+  // Either side may close the ring. The consumer still reads what was written
+  // before.
+  void Close() { gpr_atm_full_xchg(&header_->closed, 1); }
+
+  bool closed() const { return gpr_atm_acq_load(&header_->closed) != 0; }
+
+ private:
+  static bool TakeFlag(gpr_atm* flag) {
+    gpr_atm_full_barrier();
+    if (gpr_atm_no_barrier_load(flag) == 0) return false;
+    return gpr_atm_full_xchg(flag, 0) != 0;
+  }
+
+  // Copies n bytes between the ring, at position pos, and buffer.
+  void Copy(uint8_t* dst, uintptr_t pos, const uint8_t* src, size_t n,
+            bool into_ring) const {
+    const size_t offset = static_cast<size_t>(pos & (capacity_ - 1));
+    const size_t first = GPR_MIN(n, capacity_ - offset);
+    if (into_ring) {
+      memcpy(dst + offset, src, first);
+      memcpy(dst, src + first, n - first);
+    } else {
+      memcpy(dst, src + offset, first);
+      memcpy(dst + first, src, n - first);
+    }
+  }
+
+  Header* header_;
+  uint8_t* data_;
+  const size_t capacity_;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_IOMGR_SHM_RING_H */
@@ -321,6 +321,55 @@ grpc_error* grpc_set_socket_tcp_user_timeout(
   return GRPC_ERROR_NONE;
 }
 
+grpc_error* grpc_set_socket_unix_buffer_size(
+    int fd, const grpc_channel_args* channel_args) {
+  const grpc_arg* arg =
+      grpc_channel_args_find(channel_args, GRPC_ARG_UNIX_SOCKET_BUFFER_SIZE);
+  const int size =
+      grpc_channel_arg_get_integer(arg, grpc_integer_options{0, 0, INT_MAX});
+  if (size == 0) return GRPC_ERROR_NONE;
+  grpc_error* err = grpc_set_socket_sndbuf(fd, size);
+  if (err != GRPC_ERROR_NONE) return err;
+  return grpc_set_socket_rcvbuf(fd, size);
+}
+
+/* Queue length of not yet accepted TCP Fast Open connections on a listener */
+#define GRPC_TCP_FAST_OPEN_QUEUE_LENGTH 256
+
+grpc_error* grpc_set_socket_tcp_fast_open(
+    int fd, const grpc_channel_args* channel_args, bool is_client) {
+  const grpc_arg* arg =
+      grpc_channel_args_find(channel_args, GRPC_ARG_TCP_FAST_OPEN);
+  if (!grpc_channel_arg_get_bool(arg, false)) return GRPC_ERROR_NONE;
+  int option;
+  int value;
+  if (is_client) {
+#ifndef TCP_FASTOPEN_CONNECT
+    gpr_log(GPR_INFO, "TCP_FASTOPEN_CONNECT not supported for this platform");
+    return GRPC_ERROR_NONE;
+#else
+    option = TCP_FASTOPEN_CONNECT;
+    value = 1;
+#endif
+  } else {
+#ifndef TCP_FASTOPEN
+    gpr_log(GPR_INFO, "TCP_FASTOPEN not supported for this platform");
+    return GRPC_ERROR_NONE;
+#else
+    option = TCP_FASTOPEN;
+    value = GRPC_TCP_FAST_OPEN_QUEUE_LENGTH;
+#endif
+  }
+  /* Do not fail on failing to enable TCP Fast Open: connections then just
+     take the full handshake. */
+  if (0 != setsockopt(fd, IPPROTO_TCP, option, &value, sizeof(value))) {
+    gpr_log(GPR_ERROR, "setsockopt(%s) %s",
+            is_client ? "TCP_FASTOPEN_CONNECT" : "TCP_FASTOPEN",
+            strerror(errno));
+  }
+  return GRPC_ERROR_NONE;
+}
+
 /* set a socket using a grpc_socket_mutator */
 grpc_error* grpc_set_socket_with_mutator(int fd, grpc_socket_mutator* mutator) {
   GPR_ASSERT(mutator);
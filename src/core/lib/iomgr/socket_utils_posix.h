@@ -60,6 +60,17 @@ void config_default_tcp_user_timeout(bool enable, int timeout, bool is_client);
 grpc_error* grpc_set_socket_tcp_user_timeout(
     int fd, const grpc_channel_args* channel_args, bool is_client);
 
+/* Set the send and receive buffer sizes of a unix domain socket from
+   GRPC_ARG_UNIX_SOCKET_BUFFER_SIZE, if it is in channel_args. */
+grpc_error* grpc_set_socket_unix_buffer_size(
+    int fd, const grpc_channel_args* channel_args);
+
+/* Enable TCP Fast Open if GRPC_ARG_TCP_FAST_OPEN is set in channel_args:
+   TCP_FASTOPEN_CONNECT on a client socket, to be set before connect(), or
+   TCP_FASTOPEN on a server socket, to be set before listen(). */
+grpc_error* grpc_set_socket_tcp_fast_open(
+    int fd, const grpc_channel_args* channel_args, bool is_client);
+
 /* Returns true if this system can create AF_INET6 sockets bound to ::1.
    The value is probed once, and cached for the life of the process.
 
@@ -81,6 +81,12 @@ static grpc_error* prepare_socket(const grpc_resolved_address* addr, int fd,
     err = grpc_set_socket_tcp_user_timeout(fd, channel_args,
                                            true /* is_client */);
     if (err != GRPC_ERROR_NONE) goto error;
+    err =
+        grpc_set_socket_tcp_fast_open(fd, channel_args, true /* is_client */);
+    if (err != GRPC_ERROR_NONE) goto error;
+  } else {
+    err = grpc_set_socket_unix_buffer_size(fd, channel_args);
+    if (err != GRPC_ERROR_NONE) goto error;
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (err != GRPC_ERROR_NONE) goto error;
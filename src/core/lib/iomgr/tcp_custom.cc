@@ -329,6 +329,11 @@ static int endpoint_get_fd(grpc_endpoint* ep) { return -1; }
 
 static bool endpoint_can_track_err(grpc_endpoint* ep) { return false; }
 
+static void endpoint_set_read_hint(grpc_endpoint* ep, size_t bytes) {}
+
+static void endpoint_set_write_hint(grpc_endpoint* ep,
+                                    bool more_writes_follow) {}
+
 static grpc_endpoint_vtable vtable = {endpoint_read,
                                       endpoint_write,
                                       endpoint_add_to_pollset,
@@ -339,7 +344,9 @@ static grpc_endpoint_vtable vtable = {endpoint_read,
                                       endpoint_get_resource_user,
                                       endpoint_get_peer,
                                       endpoint_get_fd,
-                                      endpoint_can_track_err};
+                                      endpoint_can_track_err,
+                                      endpoint_set_read_hint,
+                                      endpoint_set_write_hint};
 
 grpc_endpoint* custom_tcp_endpoint_create(grpc_custom_socket* socket,
                                           grpc_resource_quota* resource_quota,
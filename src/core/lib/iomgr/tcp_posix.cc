@@ -49,10 +49,15 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 
@@ -71,6 +76,12 @@
 #define SENDMSG_FLAGS 0
 #endif
 
+#ifdef MSG_MORE
+#define CORK_SENDMSG_FLAGS MSG_MORE
+#else
+#define CORK_SENDMSG_FLAGS 0
+#endif
+
 #ifdef GRPC_MSG_IOVLEN_TYPE
 typedef GRPC_MSG_IOVLEN_TYPE msg_iovlen_type;
 #else
@@ -80,7 +91,225 @@ typedef size_t msg_iovlen_type;
 extern grpc_core::TraceFlag grpc_tcp_trace;
 
 namespace {
+
+/* Slices written with MSG_ZEROCOPY are pinned by the kernel until it reports
+ * completion on the socket error queue. A TcpZerocopySendRecord owns the
+ * slices of one tcp_write() call and stays alive while the write is in
+ * progress plus one ref per sendmsg() whose completion is still pending. */
+class TcpZerocopySendRecord {
+ public:
+  TcpZerocopySendRecord() { grpc_slice_buffer_init(&buf_); }
+
+  ~TcpZerocopySendRecord() {
+    AssertEmpty();
+    grpc_slice_buffer_destroy_internal(&buf_);
+  }
+
+  /* Takes ownership of the slices in \a slices_to_send (leaving it empty) and
+   * takes the ref held on behalf of the pending write. */
+  void PrepareForSends(grpc_slice_buffer* slices_to_send) {
+    AssertEmpty();
+    out_offset_.slice_idx = 0;
+    out_offset_.byte_idx = 0;
+    grpc_slice_buffer_swap(slices_to_send, &buf_);
+    Ref();
+  }
+
+  /* Fills \a iov with up to \a max_iov entries starting at the current send
+   * offset. On return, *sending_length is the number of bytes covered and the
+   * unwind indices can be passed to UnwindIfThrottled(). */
+  msg_iovlen_type PopulateIovs(size_t* unwind_slice_idx,
+                               size_t* unwind_byte_idx, size_t* sending_length,
+                               struct iovec* iov, size_t max_iov) {
+    msg_iovlen_type iov_size;
+    *unwind_slice_idx = out_offset_.slice_idx;
+    *unwind_byte_idx = out_offset_.byte_idx;
+    for (iov_size = 0;
+         out_offset_.slice_idx != buf_.count && iov_size != max_iov;
+         iov_size++) {
+      iov[iov_size].iov_base =
+          GRPC_SLICE_START_PTR(buf_.slices[out_offset_.slice_idx]) +
+          out_offset_.byte_idx;
+      iov[iov_size].iov_len =
+          GRPC_SLICE_LENGTH(buf_.slices[out_offset_.slice_idx]) -
+          out_offset_.byte_idx;
+      *sending_length += iov[iov_size].iov_len;
+      ++(out_offset_.slice_idx);
+      out_offset_.byte_idx = 0;
+    }
+    GPR_DEBUG_ASSERT(iov_size > 0);
+    return iov_size;
+  }
+
+  /* Restores the send offset after a sendmsg() that made no progress. */
+  void UnwindIfThrottled(size_t unwind_slice_idx, size_t unwind_byte_idx) {
+    out_offset_.slice_idx = unwind_slice_idx;
+    out_offset_.byte_idx = unwind_byte_idx;
+  }
+
+  /* Moves the send offset back over the bytes the kernel did not accept. */
+  void UpdateOffsetForBytesSent(size_t sending_length, size_t actually_sent) {
+    size_t trailing = sending_length - actually_sent;
+    while (trailing > 0) {
+      size_t slice_length;
+      out_offset_.slice_idx--;
+      slice_length = GRPC_SLICE_LENGTH(buf_.slices[out_offset_.slice_idx]);
+      if (slice_length > trailing) {
+        out_offset_.byte_idx = slice_length - trailing;
+        break;
+      } else {
+        trailing -= slice_length;
+      }
+    }
+  }
+
+  bool AllSlicesSent() { return out_offset_.slice_idx == buf_.count; }
+
+  void Ref() { ref_.FetchAdd(1, grpc_core::MemoryOrder::RELAXED); }
+
+  /* Returns true if this was the last ref, in which case the slices have been
+   * released and the record may be reused. */
+  bool Unref() {
+    const intptr_t prior = ref_.FetchSub(1, grpc_core::MemoryOrder::ACQ_REL);
+    GPR_DEBUG_ASSERT(prior > 0);
+    if (prior == 1) {
+      grpc_slice_buffer_reset_and_unref_internal(&buf_);
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  struct OutgoingOffset {
+    size_t slice_idx = 0;
+    size_t byte_idx = 0;
+  };
+
+  void AssertEmpty() {
+    GPR_DEBUG_ASSERT(buf_.count == 0);
+    GPR_DEBUG_ASSERT(buf_.length == 0);
+    GPR_DEBUG_ASSERT(ref_.Load(grpc_core::MemoryOrder::RELAXED) == 0);
+  }
+
+  grpc_slice_buffer buf_;
+  grpc_core::Atomic<intptr_t> ref_{0};
+  OutgoingOffset out_offset_;
+};
+
+/* Per-endpoint zerocopy state: a fixed pool of send records and the mapping
+ * from kernel zerocopy sequence numbers (one per successful sendmsg() with
+ * MSG_ZEROCOPY, counting up from 0) to the record that covers them. Completion
+ * processing runs from the error closure, possibly concurrently with writes,
+ * so everything here is guarded by mu_. */
+class TcpZerocopySendCtx {
+ public:
+  static constexpr int kDefaultMaxSends = 4;
+  static constexpr size_t kDefaultSendBytesThreshold = 16 * 1024;
+
+  TcpZerocopySendCtx(int max_sends = kDefaultMaxSends,
+                     size_t send_bytes_threshold = kDefaultSendBytesThreshold)
+      : max_sends_(max_sends), threshold_bytes_(send_bytes_threshold) {
+    send_records_ = static_cast<TcpZerocopySendRecord*>(
+        gpr_malloc(max_sends * sizeof(*send_records_)));
+    free_send_records_ = static_cast<TcpZerocopySendRecord**>(
+        gpr_malloc(max_sends * sizeof(*free_send_records_)));
+    for (int idx = 0; idx < max_sends_; ++idx) {
+      new (send_records_ + idx) TcpZerocopySendRecord();
+      free_send_records_[idx] = send_records_ + idx;
+    }
+    free_send_records_size_ = max_sends_;
+  }
+
+  ~TcpZerocopySendCtx() {
+    GPR_DEBUG_ASSERT(AllSendRecordsEmpty());
+    for (int idx = 0; idx < max_sends_; ++idx) {
+      send_records_[idx].~TcpZerocopySendRecord();
+    }
+    gpr_free(send_records_);
+    gpr_free(free_send_records_);
+  }
+
+  /* Returns a free record, or nullptr if max_sends_ writes are in flight (in
+   * which case the caller should use the copying path). */
+  TcpZerocopySendRecord* GetSendRecord() {
+    grpc_core::MutexLock lock(&mu_);
+    if (shutdown_ || free_send_records_size_ == 0) return nullptr;
+    return free_send_records_[--free_send_records_size_];
+  }
+
+  /* Returns a record to the pool once its last ref has been dropped. */
+  void PutSendRecord(TcpZerocopySendRecord* record) {
+    grpc_core::MutexLock lock(&mu_);
+    GPR_DEBUG_ASSERT(free_send_records_size_ < max_sends_);
+    free_send_records_[free_send_records_size_++] = record;
+  }
+
+  /* Must be called before each sendmsg() with MSG_ZEROCOPY so that a
+   * completion racing with the return of sendmsg() finds its record. */
+  void NoteSend(TcpZerocopySendRecord* record) {
+    record->Ref();
+    grpc_core::MutexLock lock(&mu_);
+    ctx_lookup_[last_send_] = record;
+    ++last_send_;
+  }
+
+  /* Reverts the last NoteSend() when sendmsg() failed, since the kernel only
+   * assigns sequence numbers to successful sends. */
+  void UndoSend() {
+    TcpZerocopySendRecord* record;
+    {
+      grpc_core::MutexLock lock(&mu_);
+      --last_send_;
+      auto it = ctx_lookup_.find(last_send_);
+      GPR_ASSERT(it != ctx_lookup_.end());
+      record = it->second;
+      ctx_lookup_.erase(it);
+    }
+    /* The write still holds a ref, so this can never be the last one. */
+    GPR_ASSERT(!record->Unref());
+  }
+
+  /* Returns the record covering zerocopy send \a seq, if any. */
+  TcpZerocopySendRecord* ReleaseSendRecord(uint32_t seq) {
+    grpc_core::MutexLock lock(&mu_);
+    auto it = ctx_lookup_.find(seq);
+    if (it == ctx_lookup_.end()) return nullptr;
+    TcpZerocopySendRecord* record = it->second;
+    ctx_lookup_.erase(it);
+    return record;
+  }
+
+  void Shutdown() {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+  }
+
+  bool AllSendRecordsEmpty() {
+    grpc_core::MutexLock lock(&mu_);
+    return free_send_records_size_ == max_sends_;
+  }
+
+  bool enabled() const { return enabled_; }
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+  size_t threshold_bytes() const { return threshold_bytes_; }
+
+ private:
+  TcpZerocopySendRecord* send_records_;
+  TcpZerocopySendRecord** free_send_records_;
+  int max_sends_;
+  int free_send_records_size_;
+  grpc_core::Mutex mu_;
+  uint32_t last_send_ = 0;
+  bool shutdown_ = false;
+  bool enabled_ = false;
+  size_t threshold_bytes_;
+  grpc_core::Map<uint32_t, TcpZerocopySendRecord*> ctx_lookup_;
+};
+
 struct grpc_tcp {
+  grpc_tcp(int max_sends, size_t send_bytes_threshold)
+      : refcount(1, &grpc_tcp_trace),
+        tcp_zerocopy_send_ctx(max_sends, send_bytes_threshold) {}
   grpc_endpoint base;
   grpc_fd* em_fd;
   int fd;
@@ -89,6 +318,8 @@ struct grpc_tcp {
   bool is_first_read;
   double target_length;
   double bytes_read_this_round;
+  /* bytes expected next, see grpc_endpoint_set_read_hint() */
+  size_t read_hint;
   grpc_core::RefCount refcount;
   gpr_atm shutdown_count;
 
@@ -142,6 +373,13 @@ struct grpc_tcp {
   bool ts_capable;        /* Cache whether we can set timestamping options */
   gpr_atm stop_error_notification; /* Set to 1 if we do not want to be notified
                                       on errors anymore */
+  TcpZerocopySendCtx tcp_zerocopy_send_ctx;
+  /* Record for the write currently in progress, if it is a zerocopy write */
+  TcpZerocopySendRecord* current_zerocopy_send = nullptr;
+  /* Send with MSG_MORE when more data follows, see GRPC_ARG_TCP_CORK_WRITES */
+  bool cork_writes = false;
+  /* another write follows this one, see grpc_endpoint_set_write_hint() */
+  bool write_more_hint = false;
 };
 
 struct backup_poller {
@@ -306,8 +544,11 @@ static void finish_estimate(grpc_tcp* tcp) {
 static size_t get_target_read_size(grpc_tcp* tcp) {
   grpc_resource_quota* rq = grpc_resource_user_quota(tcp->resource_user);
   double pressure = grpc_resource_quota_get_memory_pressure(rq);
-  double target =
-      tcp->target_length * (pressure > 0.8 ? (1.0 - pressure) / 0.2 : 1.0);
+  /* a hint of a large message on its way overrides the estimate right away,
+     rather than waiting for it to double its way up over several reads */
+  double target = GPR_MAX(tcp->target_length,
+                          static_cast<double>(tcp->read_hint)) *
+                  (pressure > 0.8 ? (1.0 - pressure) / 0.2 : 1.0);
   size_t sz = ((static_cast<size_t> GPR_CLAMP(target, tcp->min_read_chunk_size,
                                               tcp->max_read_chunk_size)) +
                255) &
@@ -355,7 +596,7 @@ static void tcp_free(grpc_tcp* tcp) {
   gpr_mu_unlock(&tcp->tb_mu);
   tcp->outgoing_buffer_arg = nullptr;
   gpr_mu_destroy(&tcp->tb_mu);
-  gpr_free(tcp);
+  grpc_core::Delete(tcp);
 }
 
 #ifndef NDEBUG
@@ -384,10 +625,13 @@ static void tcp_unref(grpc_tcp* tcp) {
 static void tcp_ref(grpc_tcp* tcp) { tcp->refcount.Ref(); }
 #endif
 
+static void zerocopy_disable_and_wait_for_remaining(grpc_tcp* tcp);
+
 static void tcp_destroy(grpc_endpoint* ep) {
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
   grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
   if (grpc_event_engine_can_track_errors()) {
+    zerocopy_disable_and_wait_for_remaining(tcp);
     gpr_atm_no_barrier_store(&tcp->stop_error_notification, true);
     grpc_fd_set_error(tcp->em_fd);
   }
@@ -561,6 +805,7 @@ static void tcp_do_read(grpc_tcp* tcp) {
                                tcp->incoming_buffer->length - total_read_bytes,
                                &tcp->last_read_buffer);
   }
+  GRPC_USDT2(endpoint_read, tcp, total_read_bytes);
   call_read_cb(tcp, GRPC_ERROR_NONE);
   TCP_UNREF(tcp, "read");
 }
@@ -581,6 +826,26 @@ static void tcp_read_allocation_done(void* tcpp, grpc_error* error) {
   }
 }
 
+/* If even a maximal slice will not hold what the read hint says is coming,
+   reads into a few so that it arrives in as few syscalls as possible. The
+   hint is peer controlled, so the slices together stay within the share of
+   the quota a single read may use, and there is only one under memory
+   pressure. */
+static size_t get_target_read_slices(grpc_tcp* tcp, size_t target_read_size) {
+  if (tcp->read_hint <= target_read_size) return 1;
+  grpc_resource_quota* rq = grpc_resource_user_quota(tcp->resource_user);
+  if (grpc_resource_quota_get_memory_pressure(rq) > 0.8) return 1;
+  size_t count =
+      GPR_MIN(static_cast<size_t>(MAX_READ_IOVEC),
+              (tcp->read_hint + target_read_size - 1) / target_read_size);
+  size_t rqmax = grpc_resource_quota_peek_size(rq);
+  if (rqmax > 1024) {
+    count = GPR_MAX(static_cast<size_t>(1),
+                    GPR_MIN(count, rqmax / 16 / target_read_size));
+  }
+  return count;
+}
+
 static void tcp_continue_read(grpc_tcp* tcp) {
   size_t target_read_size = get_target_read_size(tcp);
   /* Wait for allocation only when there is no buffer left. */
@@ -589,8 +854,9 @@ static void tcp_continue_read(grpc_tcp* tcp) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO, "TCP:%p alloc_slices", tcp);
     }
-    grpc_resource_user_alloc_slices(&tcp->slice_allocator, target_read_size, 1,
-                                    tcp->incoming_buffer);
+    grpc_resource_user_alloc_slices(
+        &tcp->slice_allocator, target_read_size,
+        get_target_read_slices(tcp, target_read_size), tcp->incoming_buffer);
   } else {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO, "TCP:%p do_read", tcp);
@@ -645,14 +911,14 @@ static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
 }
 
 /* A wrapper around sendmsg. It sends \a msg over \a fd and returns the number
- * of bytes sent. */
-ssize_t tcp_send(int fd, const struct msghdr* msg) {
+ * of bytes sent. \a additional_flags are or'ed into the sendmsg flags. */
+ssize_t tcp_send(int fd, const struct msghdr* msg, int additional_flags = 0) {
   GPR_TIMER_SCOPE("sendmsg", 1);
   ssize_t sent_length;
   do {
     /* TODO(klempner): Cork if this is a partial write */
     GRPC_STATS_INC_SYSCALL_WRITE();
-    sent_length = sendmsg(fd, msg, SENDMSG_FLAGS);
+    sent_length = sendmsg(fd, msg, SENDMSG_FLAGS | additional_flags);
   } while (sent_length < 0 && errno == EINTR);
   return sent_length;
 }
@@ -670,7 +936,27 @@ static bool tcp_write_with_timestamps(grpc_tcp* tcp, struct msghdr* msg,
 /** The callback function to be invoked when we get an error on the socket. */
 static void tcp_handle_error(void* arg /* grpc_tcp */, grpc_error* error);
 
+/** Drops a ref on \a record, returning it to the endpoint's pool of zerocopy
+ * send records if that was the last one. */
+static void unref_maybe_put_zerocopy_send_record(
+    grpc_tcp* tcp, TcpZerocopySendRecord* record) {
+  if (record->Unref()) {
+    tcp->tcp_zerocopy_send_ctx.PutSendRecord(record);
+  }
+}
+
 #ifdef GRPC_LINUX_ERRQUEUE
+static void process_errors(grpc_tcp* tcp);
+
+static void zerocopy_disable_and_wait_for_remaining(grpc_tcp* tcp) {
+  if (!tcp->tcp_zerocopy_send_ctx.enabled()) return;
+  tcp->tcp_zerocopy_send_ctx.Shutdown();
+  /* The kernel may still be reading from slices we handed it. Keep draining
+   * the error queue until every outstanding send has been reported. */
+  while (!tcp->tcp_zerocopy_send_ctx.AllSendRecordsEmpty()) {
+    process_errors(tcp);
+  }
+}
 
 static bool tcp_write_with_timestamps(grpc_tcp* tcp, struct msghdr* msg,
                                       size_t sending_length,
@@ -774,6 +1060,38 @@ struct cmsghdr* process_timestamp(grpc_tcp* tcp, msghdr* msg,
   return next_cmsg;
 }
 
+/** Returns true if \a cmsg is a zerocopy completion notification. */
+static bool cmsg_is_zerocopy(const struct cmsghdr& cmsg) {
+  if (cmsg.cmsg_level != SOL_IP && cmsg.cmsg_level != SOL_IPV6) {
+    return false;
+  }
+  if (cmsg.cmsg_type != IP_RECVERR && cmsg.cmsg_type != IPV6_RECVERR) {
+    return false;
+  }
+  auto serr = reinterpret_cast<const struct sock_extended_err*>(
+      CMSG_DATA(&cmsg));
+  return serr->ee_errno == 0 && serr->ee_origin == SO_EE_ORIGIN_ZEROCOPY;
+}
+
+/** Releases the send records for the range of zerocopy sends that the kernel
+ * reports as complete in \a cmsg. */
+static void process_zerocopy(grpc_tcp* tcp, struct cmsghdr* cmsg) {
+  auto serr = reinterpret_cast<struct sock_extended_err*>(CMSG_DATA(cmsg));
+  const uint32_t lo = serr->ee_info;
+  const uint32_t hi = serr->ee_data;
+  /* The range is inclusive and the sequence number may wrap around. */
+  for (uint32_t seq = lo;; ++seq) {
+    TcpZerocopySendRecord* record =
+        tcp->tcp_zerocopy_send_ctx.ReleaseSendRecord(seq);
+    if (record != nullptr) {
+      unref_maybe_put_zerocopy_send_record(tcp, record);
+    } else if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+      gpr_log(GPR_ERROR, "TCP:%p unknown zerocopy completion %u", tcp, seq);
+    }
+    if (seq == hi) break;
+  }
+}
+
 /** For linux platforms, reads the socket's error queue and processes error
  * messages from the queue.
  */
@@ -828,6 +1146,11 @@ static void process_errors(grpc_tcp* tcp) {
     bool seen = false;
     for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg && cmsg->cmsg_len;
          cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg_is_zerocopy(*cmsg)) {
+        process_zerocopy(tcp, cmsg);
+        seen = true;
+        continue;
+      }
       if (cmsg->cmsg_level != SOL_SOCKET ||
           cmsg->cmsg_type != SCM_TIMESTAMPING) {
         /* Got a control message that is not a timestamp. Don't know how to
@@ -873,6 +1196,8 @@ static void tcp_handle_error(void* arg /* grpc_tcp */, grpc_error* error) {
 }
 
 #else  /* GRPC_LINUX_ERRQUEUE */
+static void zerocopy_disable_and_wait_for_remaining(grpc_tcp* tcp) {}
+
 static bool tcp_write_with_timestamps(grpc_tcp* tcp, struct msghdr* msg,
                                       size_t sending_length,
                                       ssize_t* sent_length) {
@@ -964,7 +1289,12 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error** error) {
       GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
       GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
 
-      sent_length = tcp_send(tcp->fd, &msg);
+      /* let the kernel hold a trailing partial segment back if the rest of
+       * this write, or the next one, is about to be sent */
+      const bool more = outgoing_slice_idx != tcp->outgoing_buffer->count ||
+                        tcp->write_more_hint;
+      sent_length = tcp_send(tcp->fd, &msg,
+                             tcp->cork_writes && more ? CORK_SENDMSG_FLAGS : 0);
     }
 
     if (sent_length < 0) {
@@ -990,6 +1320,7 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error** error) {
     }
 
     GPR_ASSERT(tcp->outgoing_byte_idx == 0);
+    GRPC_USDT3(endpoint_write, tcp, sent_length, sending_length);
     tcp->bytes_counter += sent_length;
     trailing = sending_length - static_cast<size_t>(sent_length);
     while (trailing > 0) {
@@ -1013,6 +1344,95 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error** error) {
   }
 }
 
+#ifdef GRPC_LINUX_ERRQUEUE
+#define ZEROCOPY_SENDMSG_FLAGS MSG_ZEROCOPY
+#else
+#define ZEROCOPY_SENDMSG_FLAGS 0
+#endif
+
+/* Like tcp_flush, but sends the slices owned by \a record with MSG_ZEROCOPY.
+ * The slices are not released when this returns true; the record keeps them
+ * alive until the kernel reports every send covering them as complete. */
+static bool tcp_flush_zerocopy(grpc_tcp* tcp, TcpZerocopySendRecord* record,
+                               grpc_error** error) {
+  struct msghdr msg;
+  struct iovec iov[MAX_WRITE_IOVEC];
+  msg_iovlen_type iov_size;
+  ssize_t sent_length = 0;
+  size_t sending_length;
+  size_t unwind_slice_idx;
+  size_t unwind_byte_idx;
+  for (;;) {
+    sending_length = 0;
+    iov_size = record->PopulateIovs(&unwind_slice_idx, &unwind_byte_idx,
+                                    &sending_length, iov, MAX_WRITE_IOVEC);
+    msg.msg_name = nullptr;
+    msg.msg_namelen = 0;
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_size;
+    msg.msg_flags = 0;
+    msg.msg_control = nullptr;
+    msg.msg_controllen = 0;
+
+    GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
+    GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
+
+    tcp->tcp_zerocopy_send_ctx.NoteSend(record);
+    sent_length = tcp_send(
+        tcp->fd, &msg,
+        ZEROCOPY_SENDMSG_FLAGS |
+            (tcp->cork_writes && tcp->write_more_hint ? CORK_SENDMSG_FLAGS
+                                                      : 0));
+    if (sent_length < 0) {
+      const int saved_errno = errno;
+      tcp->tcp_zerocopy_send_ctx.UndoSend();
+      /* ENOBUFS means the socket's optmem limit is exhausted by pinned pages.
+       * Wait for completions (which also mark the fd writable) and retry. */
+      if (saved_errno == EAGAIN || saved_errno == ENOBUFS) {
+        record->UnwindIfThrottled(unwind_slice_idx, unwind_byte_idx);
+        return false;
+      }
+      *error = tcp_annotate_error(GRPC_OS_ERROR(saved_errno, "sendmsg"), tcp);
+      tcp->current_zerocopy_send = nullptr;
+      unref_maybe_put_zerocopy_send_record(tcp, record);
+      return true;
+    }
+    tcp->bytes_counter += sent_length;
+    record->UpdateOffsetForBytesSent(sending_length,
+                                     static_cast<size_t>(sent_length));
+    if (record->AllSlicesSent()) {
+      *error = GRPC_ERROR_NONE;
+      tcp->current_zerocopy_send = nullptr;
+      unref_maybe_put_zerocopy_send_record(tcp, record);
+      return true;
+    }
+  }
+}
+
+/* Returns a send record holding the slices of \a buf if this write should use
+ * the zerocopy path, or nullptr to use the copying path. Timestamped writes
+ * always use the copying path. */
+static TcpZerocopySendRecord* tcp_get_send_zerocopy_record(
+    grpc_tcp* tcp, grpc_slice_buffer* buf) {
+  if (!tcp->tcp_zerocopy_send_ctx.enabled() ||
+      tcp->outgoing_buffer_arg != nullptr ||
+      buf->length < tcp->tcp_zerocopy_send_ctx.threshold_bytes()) {
+    return nullptr;
+  }
+  TcpZerocopySendRecord* record = tcp->tcp_zerocopy_send_ctx.GetSendRecord();
+#ifdef GRPC_LINUX_ERRQUEUE
+  if (record == nullptr) {
+    /* Completions may be sitting on the error queue; reap them and retry. */
+    process_errors(tcp);
+    record = tcp->tcp_zerocopy_send_ctx.GetSendRecord();
+  }
+#endif /* GRPC_LINUX_ERRQUEUE */
+  if (record != nullptr) {
+    record->PrepareForSends(buf);
+  }
+  return record;
+}
+
 static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error) {
   grpc_tcp* tcp = static_cast<grpc_tcp*>(arg);
   grpc_closure* cb;
@@ -1020,12 +1440,20 @@ static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error) {
   if (error != GRPC_ERROR_NONE) {
     cb = tcp->write_cb;
     tcp->write_cb = nullptr;
+    if (tcp->current_zerocopy_send != nullptr) {
+      unref_maybe_put_zerocopy_send_record(tcp, tcp->current_zerocopy_send);
+      tcp->current_zerocopy_send = nullptr;
+    }
     cb->cb(cb->cb_arg, error);
     TCP_UNREF(tcp, "write");
     return;
   }
 
-  if (!tcp_flush(tcp, &error)) {
+  bool flush_result =
+      tcp->current_zerocopy_send != nullptr
+          ? tcp_flush_zerocopy(tcp, tcp->current_zerocopy_send, &error)
+          : tcp_flush(tcp, &error);
+  if (!flush_result) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO, "write: delayed");
     }
@@ -1080,7 +1508,12 @@ static void tcp_write(grpc_endpoint* ep, grpc_slice_buffer* buf,
     GPR_ASSERT(grpc_event_engine_can_track_errors());
   }
 
-  if (!tcp_flush(tcp, &error)) {
+  tcp->current_zerocopy_send = tcp_get_send_zerocopy_record(tcp, buf);
+  bool flush_result =
+      tcp->current_zerocopy_send != nullptr
+          ? tcp_flush_zerocopy(tcp, tcp->current_zerocopy_send, &error)
+          : tcp_flush(tcp, &error);
+  if (!flush_result) {
     TCP_REF(tcp, "write");
     tcp->write_cb = cb;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
@@ -1144,6 +1577,16 @@ static bool tcp_can_track_err(grpc_endpoint* ep) {
   return false;
 }
 
+static void tcp_set_read_hint(grpc_endpoint* ep, size_t bytes) {
+  grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
+  tcp->read_hint = bytes;
+}
+
+static void tcp_set_write_hint(grpc_endpoint* ep, bool more_writes_follow) {
+  grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
+  tcp->write_more_hint = more_writes_follow;
+}
+
 static const grpc_endpoint_vtable vtable = {tcp_read,
                                             tcp_write,
                                             tcp_add_to_pollset,
@@ -1154,7 +1597,9 @@ static const grpc_endpoint_vtable vtable = {tcp_read,
                                             tcp_get_resource_user,
                                             tcp_get_peer,
                                             tcp_get_fd,
-                                            tcp_can_track_err};
+                                            tcp_can_track_err,
+                                            tcp_set_read_hint,
+                                            tcp_set_write_hint};
 
 #define MAX_CHUNK_SIZE 32 * 1024 * 1024
 
@@ -1164,6 +1609,11 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
+  bool tcp_tx_zerocopy_enabled = false;
+  bool tcp_cork_writes = false;
+  int tcp_tx_zerocopy_send_bytes_thresh =
+      TcpZerocopySendCtx::kDefaultSendBytesThreshold;
+  int tcp_tx_zerocopy_max_simult_sends = TcpZerocopySendCtx::kDefaultMaxSends;
   grpc_resource_quota* resource_quota = grpc_resource_quota_create(nullptr);
   if (channel_args != nullptr) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
@@ -1182,6 +1632,26 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
         grpc_integer_options options = {tcp_read_chunk_size, 1, MAX_CHUNK_SIZE};
         tcp_max_read_chunk_size =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED)) {
+        tcp_tx_zerocopy_enabled =
+            grpc_channel_arg_get_bool(&channel_args->args[i], false);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {
+            TcpZerocopySendCtx::kDefaultSendBytesThreshold, 0, INT_MAX};
+        tcp_tx_zerocopy_send_bytes_thresh =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS)) {
+        grpc_integer_options options = {TcpZerocopySendCtx::kDefaultMaxSends, 1,
+                                        INT_MAX};
+        tcp_tx_zerocopy_max_simult_sends =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_CORK_WRITES)) {
+        tcp_cork_writes =
+            grpc_channel_arg_get_bool(&channel_args->args[i], false);
       } else if (0 ==
                  strcmp(channel_args->args[i].key, GRPC_ARG_RESOURCE_QUOTA)) {
         grpc_resource_quota_unref_internal(resource_quota);
@@ -1198,7 +1668,8 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   tcp_read_chunk_size = GPR_CLAMP(tcp_read_chunk_size, tcp_min_read_chunk_size,
                                   tcp_max_read_chunk_size);
 
-  grpc_tcp* tcp = static_cast<grpc_tcp*>(gpr_malloc(sizeof(grpc_tcp)));
+  grpc_tcp* tcp = grpc_core::New<grpc_tcp>(tcp_tx_zerocopy_max_simult_sends,
+                                           tcp_tx_zerocopy_send_bytes_thresh);
   tcp->base.vtable = &vtable;
   tcp->peer_string = gpr_strdup(peer_string);
   tcp->fd = grpc_fd_wrapped_fd(em_fd);
@@ -1211,14 +1682,34 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   tcp->min_read_chunk_size = tcp_min_read_chunk_size;
   tcp->max_read_chunk_size = tcp_max_read_chunk_size;
   tcp->bytes_read_this_round = 0;
+  tcp->read_hint = 0;
   /* Will be set to false by the very first endpoint read function */
   tcp->is_first_read = true;
   tcp->bytes_counter = -1;
   tcp->socket_ts_enabled = false;
   tcp->ts_capable = true;
   tcp->outgoing_buffer_arg = nullptr;
+  tcp->cork_writes = tcp_cork_writes && CORK_SENDMSG_FLAGS != 0;
+  if (tcp_tx_zerocopy_enabled) {
+#ifdef GRPC_LINUX_ERRQUEUE
+    /* Completions are delivered on the error queue, so zerocopy is only
+     * usable when the polling engine can notify us of socket errors. */
+    const int enable = 1;
+    if (!grpc_event_engine_can_track_errors()) {
+      gpr_log(GPR_INFO,
+              "Tx zerocopy disabled: polling engine cannot track errors");
+    } else if (setsockopt(tcp->fd, SOL_SOCKET, SO_ZEROCOPY, &enable,
+                          sizeof(enable)) != 0) {
+      gpr_log(GPR_INFO, "Tx zerocopy disabled: setsockopt failed errno=%d",
+              errno);
+    } else {
+      tcp->tcp_zerocopy_send_ctx.set_enabled(true);
+    }
+#else
+    gpr_log(GPR_INFO, "Tx zerocopy not supported on this platform");
+#endif /* GRPC_LINUX_ERRQUEUE */
+  }
   /* paired with unref in grpc_tcp_destroy */
-  new (&tcp->refcount) grpc_core::RefCount(1, &grpc_tcp_trace);
   gpr_atm_no_barrier_store(&tcp->shutdown_count, 0);
   tcp->em_fd = em_fd;
   grpc_slice_buffer_init(&tcp->last_read_buffer);
@@ -1282,6 +1773,7 @@ void grpc_tcp_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
   tcp->release_fd_cb = done;
   grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
   if (grpc_event_engine_can_track_errors()) {
+    zerocopy_disable_and_wait_for_remaining(tcp);
     /* Stop errors notification. */
     gpr_atm_no_barrier_store(&tcp->stop_error_notification, true);
     grpc_fd_set_error(tcp->em_fd);
@@ -47,6 +47,7 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/sockaddr.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
@@ -62,7 +63,9 @@ static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
   grpc_tcp_server* s =
       static_cast<grpc_tcp_server*>(gpr_zalloc(sizeof(grpc_tcp_server)));
   s->so_reuseport = grpc_is_socket_reuse_port_supported();
+  s->listener_affinity = false;
   s->expand_wildcard_addrs = false;
+  s->offload_accept = false;
   for (size_t i = 0; i < (args == nullptr ? 0 : args->num_args); i++) {
     if (0 == strcmp(GRPC_ARG_ALLOW_REUSEPORT, args->args[i].key)) {
       if (args->args[i].type == GRPC_ARG_INTEGER) {
@@ -73,6 +76,24 @@ static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
         return GRPC_ERROR_CREATE_FROM_STATIC_STRING(GRPC_ARG_ALLOW_REUSEPORT
                                                     " must be an integer");
       }
+    } else if (0 == strcmp(GRPC_ARG_REUSEPORT_LISTENER_AFFINITY,
+                           args->args[i].key)) {
+      if (args->args[i].type == GRPC_ARG_INTEGER) {
+        s->listener_affinity |= (args->args[i].value.integer != 0);
+      } else {
+        gpr_free(s);
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            GRPC_ARG_REUSEPORT_LISTENER_AFFINITY " must be an integer");
+      }
+    } else if (0 ==
+               strcmp(GRPC_ARG_NUMA_THREAD_PLACEMENT, args->args[i].key)) {
+      if (args->args[i].type == GRPC_ARG_INTEGER) {
+        s->listener_affinity |= (args->args[i].value.integer != 0);
+      } else {
+        gpr_free(s);
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            GRPC_ARG_NUMA_THREAD_PLACEMENT " must be an integer");
+      }
     } else if (0 == strcmp(GRPC_ARG_EXPAND_WILDCARD_ADDRS, args->args[i].key)) {
       if (args->args[i].type == GRPC_ARG_INTEGER) {
         s->expand_wildcard_addrs = (args->args[i].value.integer != 0);
@@ -81,6 +102,15 @@ static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
         return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             GRPC_ARG_EXPAND_WILDCARD_ADDRS " must be an integer");
       }
+    } else if (0 ==
+               strcmp(GRPC_ARG_TCP_SERVER_OFFLOAD_ACCEPT, args->args[i].key)) {
+      if (args->args[i].type == GRPC_ARG_INTEGER) {
+        s->offload_accept = (args->args[i].value.integer != 0);
+      } else {
+        gpr_free(s);
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            GRPC_ARG_TCP_SERVER_OFFLOAD_ACCEPT " must be an integer");
+      }
     }
   }
   gpr_ref_init(&s->refs, 1);
@@ -182,10 +212,94 @@ static void tcp_server_destroy(grpc_tcp_server* s) {
   }
 }
 
+/* Creates the endpoint for a connection accepted by listener port_index,
+   fd_index of s and hands it to the server's on_accept_cb. */
+static void setup_accepted_fd(grpc_tcp_server* s,
+                              grpc_pollset* read_notifier_pollset,
+                              unsigned port_index, unsigned fd_index, int fd,
+                              const grpc_resolved_address* addr) {
+  char* addr_str;
+  char* name;
+
+  if (grpc_is_unix_socket(addr)) {
+    /* Unlike TCP, accepted unix sockets do not inherit the listener's
+       buffer sizes. */
+    grpc_error* buffer_err =
+        grpc_set_socket_unix_buffer_size(fd, s->channel_args);
+    if (buffer_err != GRPC_ERROR_NONE) {
+      gpr_log(GPR_ERROR, "Failed to size socket buffers: %s",
+              grpc_error_string(buffer_err));
+      GRPC_ERROR_UNREF(buffer_err);
+    }
+  }
+
+  grpc_set_socket_no_sigpipe_if_possible(fd);
+
+  addr_str = grpc_sockaddr_to_uri(addr);
+  gpr_asprintf(&name, "tcp-server-connection:%s", addr_str);
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+    gpr_log(GPR_INFO, "SERVER_CONNECT: incoming connection: %s", addr_str);
+  }
+
+  grpc_fd* fdobj = grpc_fd_create(fd, name, true);
+
+  if (read_notifier_pollset == nullptr) {
+    read_notifier_pollset =
+        s->pollsets[static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
+                        &s->next_pollset_to_assign, 1)) %
+                    s->pollset_count];
+  }
+
+  grpc_pollset_add_fd(read_notifier_pollset, fdobj);
+
+  // Create acceptor.
+  grpc_tcp_server_acceptor* acceptor =
+      static_cast<grpc_tcp_server_acceptor*>(gpr_malloc(sizeof(*acceptor)));
+  acceptor->from_server = s;
+  acceptor->port_index = port_index;
+  acceptor->fd_index = fd_index;
+  acceptor->external_connection = false;
+
+  s->on_accept_cb(s->on_accept_cb_arg,
+                  grpc_tcp_create(fdobj, s->channel_args, addr_str),
+                  read_notifier_pollset, acceptor);
+
+  gpr_free(name);
+  gpr_free(addr_str);
+}
+
+/* A connection accepted by on_read, waiting for setup_accepted_fd on the
+   executor. Counts as an active port of the server, so that the server is
+   not destroyed under it. */
+typedef struct {
+  grpc_closure closure;
+  grpc_tcp_server* server;
+  grpc_pollset* read_notifier_pollset;
+  unsigned port_index;
+  unsigned fd_index;
+  int fd;
+  grpc_resolved_address addr;
+} offloaded_accept;
+
+static void on_offloaded_accept(void* arg, grpc_error* error) {
+  offloaded_accept* accept = static_cast<offloaded_accept*>(arg);
+  grpc_tcp_server* s = accept->server;
+  setup_accepted_fd(s, accept->read_notifier_pollset, accept->port_index,
+                    accept->fd_index, accept->fd, &accept->addr);
+  gpr_free(accept);
+  gpr_mu_lock(&s->mu);
+  if (0 == --s->active_ports && s->shutdown) {
+    gpr_mu_unlock(&s->mu);
+    deactivated_all_ports(s);
+  } else {
+    gpr_mu_unlock(&s->mu);
+  }
+}
+
 /* event manager callback when reads are ready */
 static void on_read(void* arg, grpc_error* err) {
   grpc_tcp_listener* sp = static_cast<grpc_tcp_listener*>(arg);
-  grpc_pollset* read_notifier_pollset;
   if (err != GRPC_ERROR_NONE) {
     goto error;
   }
@@ -193,8 +307,6 @@ static void on_read(void* arg, grpc_error* err) {
   /* loop until accept4 returns EAGAIN, and then re-arm notification */
   for (;;) {
     grpc_resolved_address addr;
-    char* addr_str;
-    char* name;
     memset(&addr, 0, sizeof(addr));
     addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
     /* Note: If we ever decide to return this address to the user, remember to
@@ -233,39 +345,27 @@ static void on_read(void* arg, grpc_error* err) {
       }
     }
 
-    grpc_set_socket_no_sigpipe_if_possible(fd);
-
-    addr_str = grpc_sockaddr_to_uri(&addr);
-    gpr_asprintf(&name, "tcp-server-connection:%s", addr_str);
-
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
-      gpr_log(GPR_INFO, "SERVER_CONNECT: incoming connection: %s", addr_str);
+    if (sp->server->offload_accept) {
+      offloaded_accept* accept =
+          static_cast<offloaded_accept*>(gpr_malloc(sizeof(*accept)));
+      accept->server = sp->server;
+      accept->read_notifier_pollset = sp->read_notifier_pollset;
+      accept->port_index = sp->port_index;
+      accept->fd_index = sp->fd_index;
+      accept->fd = fd;
+      accept->addr = addr;
+      gpr_mu_lock(&sp->server->mu);
+      sp->server->active_ports++;
+      gpr_mu_unlock(&sp->server->mu);
+      GRPC_CLOSURE_SCHED(
+          GRPC_CLOSURE_INIT(&accept->closure, on_offloaded_accept, accept,
+                            grpc_core::Executor::Scheduler(
+                                grpc_core::ExecutorJobType::SHORT)),
+          GRPC_ERROR_NONE);
+    } else {
+      setup_accepted_fd(sp->server, sp->read_notifier_pollset,
+                        sp->port_index, sp->fd_index, fd, &addr);
     }
-
-    grpc_fd* fdobj = grpc_fd_create(fd, name, true);
-
-    read_notifier_pollset =
-        sp->server->pollsets[static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-                                 &sp->server->next_pollset_to_assign, 1)) %
-                             sp->server->pollset_count];
-
-    grpc_pollset_add_fd(read_notifier_pollset, fdobj);
-
-    // Create acceptor.
-    grpc_tcp_server_acceptor* acceptor =
-        static_cast<grpc_tcp_server_acceptor*>(gpr_malloc(sizeof(*acceptor)));
-    acceptor->from_server = sp->server;
-    acceptor->port_index = sp->port_index;
-    acceptor->fd_index = sp->fd_index;
-    acceptor->external_connection = false;
-
-    sp->server->on_accept_cb(
-        sp->server->on_accept_cb_arg,
-        grpc_tcp_create(fdobj, sp->server->channel_args, addr_str),
-        read_notifier_pollset, acceptor);
-
-    gpr_free(name);
-    gpr_free(addr_str);
   }
 
   GPR_UNREACHABLE_CODE(return );
@@ -509,6 +609,8 @@ static void tcp_server_start(grpc_tcp_server* s, grpc_pollset** pollsets,
           "clone_port", clone_port(sp, (unsigned)(pollset_count - 1))));
       for (i = 0; i < pollset_count; i++) {
         grpc_pollset_add_fd(pollsets[i], sp->emfd);
+        sp->read_notifier_pollset =
+            s->listener_affinity ? pollsets[i] : nullptr;
         GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                           grpc_schedule_on_exec_ctx);
         grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
@@ -519,6 +621,7 @@ static void tcp_server_start(grpc_tcp_server* s, grpc_pollset** pollsets,
       for (i = 0; i < pollset_count; i++) {
         grpc_pollset_add_fd(pollsets[i], sp->emfd);
       }
+      sp->read_notifier_pollset = nullptr;
       GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                         grpc_schedule_on_exec_ctx);
       grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
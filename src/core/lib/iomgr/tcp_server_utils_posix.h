@@ -37,6 +37,9 @@ typedef struct grpc_tcp_listener {
   unsigned fd_index;
   grpc_closure read_closure;
   grpc_closure destroyed_closure;
+  /* when non-null, the pollset every connection accepted by this listener is
+     bound to (see grpc_tcp_server.listener_affinity) */
+  grpc_pollset* read_notifier_pollset;
   struct grpc_tcp_listener* next;
   /* sibling is a linked list of all listeners for a given port. add_port and
      clone_port place all new listeners in the same sibling list. A member of
@@ -57,7 +60,8 @@ struct grpc_tcp_server {
 
   gpr_mu mu;
 
-  /* active port count: how many ports are actually still listening */
+  /* active port count: how many ports are actually still listening, plus
+     accepted connections still waiting for setup on the executor */
   size_t active_ports;
   /* destroyed port count: how many ports are completely destroyed */
   size_t destroyed_ports;
@@ -68,8 +72,13 @@ struct grpc_tcp_server {
   bool shutdown_listeners;
   /* use SO_REUSEPORT */
   bool so_reuseport;
+  /* bind each SO_REUSEPORT listener, and the connections it accepts, to a
+     single pollset */
+  bool listener_affinity;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs;
+  /* set accepted connections up on the executor rather than in on_read */
+  bool offload_accept;
 
   /* linked list of server ports */
   grpc_tcp_listener* head;
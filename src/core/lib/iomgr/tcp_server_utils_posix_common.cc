@@ -169,6 +169,12 @@ grpc_error* grpc_tcp_server_prepare_socket(grpc_tcp_server* s, int fd,
     err = grpc_set_socket_tcp_user_timeout(fd, s->channel_args,
                                            false /* is_client */);
     if (err != GRPC_ERROR_NONE) goto error;
+    err = grpc_set_socket_tcp_fast_open(fd, s->channel_args,
+                                        false /* is_client */);
+    if (err != GRPC_ERROR_NONE) goto error;
+  } else {
+    err = grpc_set_socket_unix_buffer_size(fd, s->channel_args);
+    if (err != GRPC_ERROR_NONE) goto error;
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (err != GRPC_ERROR_NONE) goto error;
@@ -486,6 +486,10 @@ static int win_get_fd(grpc_endpoint* ep) { return -1; }
 
 static bool win_can_track_err(grpc_endpoint* ep) { return false; }
 
+static void win_set_read_hint(grpc_endpoint* ep, size_t bytes) {}
+
+static void win_set_write_hint(grpc_endpoint* ep, bool more_writes_follow) {}
+
 static grpc_endpoint_vtable vtable = {win_read,
                                       win_write,
                                       win_add_to_pollset,
@@ -496,7 +500,9 @@ static grpc_endpoint_vtable vtable = {win_read,
                                       win_get_resource_user,
                                       win_get_peer,
                                       win_get_fd,
-                                      win_can_track_err};
+                                      win_can_track_err,
+                                      win_set_read_hint,
+                                      win_set_write_hint};
 
 grpc_endpoint* grpc_tcp_create(grpc_winsocket* socket,
                                grpc_channel_args* channel_args,
@@ -29,6 +29,7 @@ void grpc_set_timer_impl(grpc_timer_vtable* vtable) {
 
 void grpc_timer_init(grpc_timer* timer, grpc_millis deadline,
                      grpc_closure* closure) {
+  grpc_timer_manager_start_pending_threads();
   grpc_timer_impl->init(timer, deadline, closure);
 }
 
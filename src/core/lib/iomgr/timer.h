@@ -24,6 +24,7 @@
 #include "src/core/lib/iomgr/port.h"
 
 #include <grpc/support/time.h>
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
 
@@ -60,6 +61,10 @@ typedef struct grpc_timer_vtable {
   void (*consume_kick)(void);
 } grpc_timer_vtable;
 
+/* Selects the timing wheel timer implementation (grpc_wheel_timer_vtable)
+   over the generic heap based one on platforms that would use the latter. */
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_timer_wheel);
+
 /* Initialize *timer. When expired or canceled, closure will be called with
    error set to indicate if it expired (GRPC_ERROR_NONE) or was canceled
    (GRPC_ERROR_CANCELLED). *closure is guaranteed to be called exactly once, and
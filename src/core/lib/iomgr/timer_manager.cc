@@ -27,6 +27,7 @@
 
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/timer.h"
 
 struct completed_thread {
@@ -40,6 +41,8 @@ extern grpc_core::TraceFlag grpc_timer_check_trace;
 static gpr_mu g_mu;
 // are we multi-threaded
 static bool g_threaded;
+// did grpc_timer_manager_init leave starting the threads to the first timer?
+static gpr_atm g_start_pending;
 // cv to wait until a thread is needed
 static gpr_cv g_cv_wait;
 // cv for notification when threading ends
@@ -82,14 +85,16 @@ static void gc_completed_threads(void) {
 static void start_timer_thread_and_unlock(void) {
   GPR_ASSERT(g_threaded);
   ++g_waiter_count;
-  ++g_thread_count;
+  int thread_index = g_thread_count++;
   gpr_mu_unlock(&g_mu);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
     gpr_log(GPR_INFO, "Spawn timer thread");
   }
   completed_thread* ct =
       static_cast<completed_thread*>(gpr_malloc(sizeof(*ct)));
-  ct->thd = grpc_core::Thread("grpc_global_timer", timer_thread, ct);
+  ct->thd = grpc_core::Thread("grpc_global_timer", timer_thread, ct, nullptr,
+                              grpc_core::Thread::Options().set_numa_node(
+                                  grpc_iomgr_thread_numa_node(thread_index)));
   ct->thd.Start();
 }
 
@@ -288,6 +293,7 @@ static void timer_thread(void* completed_thread_ptr) {
 
 static void start_threads(void) {
   gpr_mu_lock(&g_mu);
+  gpr_atm_no_barrier_store(&g_start_pending, 0);
   if (!g_threaded) {
     g_threaded = true;
     start_timer_thread_and_unlock();
@@ -308,11 +314,28 @@ void grpc_timer_manager_init(void) {
   g_has_timed_waiter = false;
   g_timed_waiter_deadline = GRPC_MILLIS_INF_FUTURE;
 
-  start_threads();
+  if (grpc_iomgr_lazy_thread_start()) {
+    gpr_atm_rel_store(&g_start_pending, 1);
+  } else {
+    start_threads();
+  }
+}
+
+void grpc_timer_manager_start_pending_threads(void) {
+  if (!gpr_atm_acq_load(&g_start_pending)) return;
+  gpr_mu_lock(&g_mu);
+  if (gpr_atm_no_barrier_load(&g_start_pending) && !g_threaded) {
+    gpr_atm_no_barrier_store(&g_start_pending, 0);
+    g_threaded = true;
+    start_timer_thread_and_unlock();
+  } else {
+    gpr_mu_unlock(&g_mu);
+  }
 }
 
 static void stop_threads(void) {
   gpr_mu_lock(&g_mu);
+  gpr_atm_no_barrier_store(&g_start_pending, 0);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
     gpr_log(GPR_INFO, "stop timer threads: threaded=%d", g_threaded);
   }
@@ -32,6 +32,9 @@ void grpc_timer_manager_shutdown(void);
 /* enable/disable threading - must be called after grpc_timer_manager_init and
  * before grpc_timer_manager_shutdown */
 void grpc_timer_manager_set_threading(bool enabled);
+/* start the threads that grpc_timer_manager_init left to the first timer
+ * (GRPC_LAZY_THREAD_START), if that has not happened yet */
+void grpc_timer_manager_start_pending_threads(void);
 /* explicitly perform one tick of the timer system - for when threading is
  * disabled */
 void grpc_timer_manager_tick(void);
@@ -0,0 +1,482 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#include <inttypes.h>
+#include <new>
+
+#include "src/core/lib/iomgr/timer.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+/* A hierarchical timing wheel (Varghese & Lauck), in the style of the classic
+ * cascading kernel timer wheel. Time is counted in 1ms ticks. The root level
+ * has 256 slots of one tick each; every further level has 64 slots, each
+ * covering a whole turn of the level below it. A timer is linked into the
+ * slot of the lowest level whose span covers its deadline, so both adding and
+ * cancelling a timer are O(1) list operations. When the wheel reaches a slot
+ * boundary of a level, that slot's timers are redistributed (cascaded) into
+ * the levels below; root slots are fired as they are reached.
+ *
+ * Every slot keeps an occupancy bit, which lets the wheel jump straight to the
+ * next tick with work to do rather than stepping through idle ticks. Deadlines
+ * beyond the reach of the top level are parked in its furthest slot and
+ * re-placed each time they are cascaded. */
+
+#define WHEEL_LEVELS 5
+#define WHEEL_ROOT_BITS 8
+#define WHEEL_LEVEL_BITS 6
+#define WHEEL_ROOT_SLOTS (1 << WHEEL_ROOT_BITS)
+#define WHEEL_LEVEL_SLOTS (1 << WHEEL_LEVEL_BITS)
+#define WHEEL_SLOTS (WHEEL_ROOT_SLOTS + (WHEEL_LEVELS - 1) * WHEEL_LEVEL_SLOTS)
+/* Span of the whole wheel, in ticks: 2^32ms, a little over 49 days. */
+#define WHEEL_SPAN \
+  (static_cast<grpc_millis>(1) << (WHEEL_ROOT_BITS + (WHEEL_LEVELS - 1) * \
+                                                         WHEEL_LEVEL_BITS))
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_timer_wheel, false,
+    "If set, timers are kept in a hierarchical timing wheel, making timer add "
+    "and cancel O(1), instead of in per shard heaps");
+
+/* A "wheel shard". Timers are hashed to a shard by address, as in the generic
+   implementation, so that unrelated timers do not contend on one lock. */
+struct wheel_shard {
+  gpr_mu mu;
+  /* The next tick to be processed: every timer due before it has fired. */
+  grpc_millis now_tick = 0;
+  /* A lower bound on the next tick at which this shard has work to do (a
+     timer to fire or a slot to cascade). Written under mu, read without it by
+     the checker. */
+  grpc_core::Atomic<grpc_millis> min_deadline{GRPC_MILLIS_INF_FUTURE};
+  size_t count = 0;
+  uint64_t occupied[WHEEL_SLOTS / 64] = {};
+  grpc_timer* slots[WHEEL_SLOTS] = {};
+};
+
+static size_t g_num_shards;
+static wheel_shard* g_shards;
+
+struct shared_mutables {
+  /* The earliest min_deadline across all wheel shards */
+  grpc_core::Atomic<grpc_millis> min_timer;
+  /* Allow only one run_some_expired_timers at once */
+  gpr_spinlock checker_mu;
+  bool initialized;
+  /* Serializes updates of min_timer */
+  gpr_mu mu;
+} GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+
+static struct shared_mutables g_shared_mutables;
+
+static int level_shift(int level) {
+  return level == 0 ? 0 : WHEEL_ROOT_BITS + (level - 1) * WHEEL_LEVEL_BITS;
+}
+
+/* Number of ticks ahead of now_tick that a level can hold. */
+static grpc_millis level_span(int level) {
+  return static_cast<grpc_millis>(1)
+         << (level == 0 ? WHEEL_ROOT_BITS
+                        : level_shift(level) + WHEEL_LEVEL_BITS);
+}
+
+static size_t slot_index(int level, grpc_millis tick) {
+  uint64_t t = static_cast<uint64_t>(tick);
+  if (level == 0) return t & (WHEEL_ROOT_SLOTS - 1);
+  return WHEEL_ROOT_SLOTS + (level - 1) * WHEEL_LEVEL_SLOTS +
+         ((t >> level_shift(level)) & (WHEEL_LEVEL_SLOTS - 1));
+}
+
+static void set_occupied(wheel_shard* shard, size_t slot) {
+  shard->occupied[slot / 64] |= static_cast<uint64_t>(1) << (slot % 64);
+}
+
+static void clear_occupied(wheel_shard* shard, size_t slot) {
+  shard->occupied[slot / 64] &= ~(static_cast<uint64_t>(1) << (slot % 64));
+}
+
+static int count_trailing_zeros(uint64_t x) {
+  GPR_DEBUG_ASSERT(x != 0);
+#if defined(__GNUC__)
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+/* Returns the distance from 'from' to the first set bit of the 64 bit ring
+   'bits', walking upwards and wrapping, or -1 if no bit is set. */
+static int ring_distance(uint64_t bits, int from) {
+  if (bits == 0) return -1;
+  uint64_t rotated = from == 0 ? bits : (bits >> from) | (bits << (64 - from));
+  return count_trailing_zeros(rotated);
+}
+
+/* Links timer into the slot that its deadline maps to, relative to
+   shard->now_tick. The slot is remembered in heap_index (unused otherwise by
+   this implementation) so that cancellation can unlink it.
+   REQUIRES: shard->mu locked */
+static void add_locked(wheel_shard* shard, grpc_timer* timer) {
+  grpc_millis expires = GPR_MAX(timer->deadline, shard->now_tick);
+  grpc_millis delta = expires - shard->now_tick;
+  if (delta >= WHEEL_SPAN) {
+    delta = WHEEL_SPAN - 1;
+    expires = shard->now_tick + delta;
+  }
+  int level = 0;
+  while (delta >= level_span(level)) level++;
+  size_t slot = slot_index(level, expires);
+  timer->heap_index = static_cast<uint32_t>(slot);
+  timer->prev = nullptr;
+  timer->next = shard->slots[slot];
+  if (timer->next != nullptr) timer->next->prev = timer;
+  shard->slots[slot] = timer;
+  set_occupied(shard, slot);
+  shard->count++;
+}
+
+/* REQUIRES: shard->mu locked */
+static void remove_locked(wheel_shard* shard, grpc_timer* timer) {
+  size_t slot = timer->heap_index;
+  if (timer->prev != nullptr) {
+    timer->prev->next = timer->next;
+  } else {
+    shard->slots[slot] = timer->next;
+    if (timer->next == nullptr) clear_occupied(shard, slot);
+  }
+  if (timer->next != nullptr) timer->next->prev = timer->prev;
+  shard->count--;
+}
+
+/* Unlinks and returns the whole list of a slot.
+   REQUIRES: shard->mu locked */
+static grpc_timer* take_slot_locked(wheel_shard* shard, size_t slot) {
+  grpc_timer* head = shard->slots[slot];
+  shard->slots[slot] = nullptr;
+  clear_occupied(shard, slot);
+  for (grpc_timer* timer = head; timer != nullptr; timer = timer->next) {
+    shard->count--;
+  }
+  return head;
+}
+
+/* Returns the first tick >= now_tick at which the shard has a root slot to
+   fire or a slot to cascade, or GRPC_MILLIS_INF_FUTURE if it holds no timers.
+   The result is exact for timers in the root level and a lower bound for the
+   others, which only need attention once their slot boundary is reached.
+   REQUIRES: shard->mu locked */
+static grpc_millis next_event_locked(wheel_shard* shard) {
+  if (shard->count == 0) return GRPC_MILLIS_INF_FUTURE;
+  grpc_millis base = shard->now_tick;
+  grpc_millis best = GRPC_MILLIS_INF_FUTURE;
+  /* Root level: 256 slots kept in four words, searched as one ring. */
+  size_t offset = slot_index(0, base);
+  for (size_t i = 0; i <= WHEEL_ROOT_SLOTS / 64; i++) {
+    size_t word = (offset / 64 + i) % (WHEEL_ROOT_SLOTS / 64);
+    uint64_t bits = shard->occupied[word];
+    if (i == 0) {
+      bits &= ~static_cast<uint64_t>(0) << (offset % 64);
+    } else if (i == WHEEL_ROOT_SLOTS / 64) {
+      bits &= (static_cast<uint64_t>(1) << (offset % 64)) - 1;
+    }
+    if (bits != 0) {
+      size_t slot = word * 64 + count_trailing_zeros(bits);
+      best = base + static_cast<grpc_millis>(
+                        (slot + WHEEL_ROOT_SLOTS - offset) % WHEEL_ROOT_SLOTS);
+      break;
+    }
+  }
+  for (int level = 1; level < WHEEL_LEVELS; level++) {
+    uint64_t bits = shard->occupied[WHEEL_ROOT_SLOTS / 64 + level - 1];
+    if (bits == 0) continue;
+    grpc_millis unit = static_cast<grpc_millis>(1) << level_shift(level);
+    grpc_millis first = (base + unit - 1) & ~(unit - 1);
+    int from = static_cast<int>(slot_index(level, first) - WHEEL_ROOT_SLOTS -
+                                (level - 1) * WHEEL_LEVEL_SLOTS);
+    grpc_millis boundary = first + ring_distance(bits, from) * unit;
+    best = GPR_MIN(best, boundary);
+  }
+  return best;
+}
+
+/* Advances the shard's wheel up to and including tick 'now', scheduling the
+   closures of every timer due by then. Returns the number of timers fired.
+   REQUIRES: shard->mu locked */
+static size_t advance_locked(wheel_shard* shard, grpc_millis now,
+                             grpc_error* error) {
+  size_t n = 0;
+  if (now == GRPC_MILLIS_INF_FUTURE) {
+    /* Shutting down: there is no tick to advance to, fire everything. */
+    for (size_t slot = 0; slot < WHEEL_SLOTS; slot++) {
+      grpc_timer* timer = take_slot_locked(shard, slot);
+      while (timer != nullptr) {
+        grpc_timer* next = timer->next;
+        timer->pending = false;
+        GRPC_CLOSURE_SCHED(timer->closure, GRPC_ERROR_REF(error));
+        n++;
+        timer = next;
+      }
+    }
+    return n;
+  }
+  for (;;) {
+    grpc_millis tick = next_event_locked(shard);
+    if (tick > now) break;
+    shard->now_tick = tick;
+    for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+      grpc_millis unit = static_cast<grpc_millis>(1) << level_shift(level);
+      if ((tick & (unit - 1)) != 0) continue;
+      grpc_timer* timer = take_slot_locked(shard, slot_index(level, tick));
+      while (timer != nullptr) {
+        grpc_timer* next = timer->next;
+        add_locked(shard, timer);
+        timer = next;
+      }
+    }
+    grpc_timer* timer = take_slot_locked(shard, slot_index(0, tick));
+    while (timer != nullptr) {
+      grpc_timer* next = timer->next;
+      if (timer->deadline > tick) {
+        /* Parked beyond the span of the wheel: place it again. */
+        add_locked(shard, timer);
+      } else {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+          gpr_log(GPR_INFO,
+                  "TIMER %p: FIRE %" PRId64 "ms late via %s scheduler", timer,
+                  now - timer->deadline,
+                  timer->closure->scheduler->vtable->name);
+        }
+        timer->pending = false;
+        GRPC_CLOSURE_SCHED(timer->closure, GRPC_ERROR_REF(error));
+        n++;
+      }
+      timer = next;
+    }
+    shard->now_tick = tick + 1;
+  }
+  /* Nothing is due before the next event, so the idle ticks up to now can be
+     skipped in one step. */
+  if (shard->now_tick <= now) shard->now_tick = now + 1;
+  return n;
+}
+
+static void timer_list_init() {
+  g_num_shards = GPR_CLAMP(2 * gpr_cpu_num_cores(), 1, 32);
+  g_shards = static_cast<wheel_shard*>(
+      gpr_malloc(g_num_shards * sizeof(*g_shards)));
+
+  g_shared_mutables.initialized = true;
+  g_shared_mutables.checker_mu = GPR_SPINLOCK_INITIALIZER;
+  gpr_mu_init(&g_shared_mutables.mu);
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  g_shared_mutables.min_timer.Store(GRPC_MILLIS_INF_FUTURE,
+                                    grpc_core::MemoryOrder::RELAXED);
+
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = new (&g_shards[i]) wheel_shard();
+    gpr_mu_init(&shard->mu);
+    shard->now_tick = now;
+  }
+}
+
+static grpc_timer_check_result run_some_expired_timers(grpc_millis now,
+                                                       grpc_millis* next,
+                                                       grpc_error* error);
+
+static void timer_list_shutdown() {
+  run_some_expired_timers(
+      GRPC_MILLIS_INF_FUTURE, nullptr,
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown"));
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    gpr_mu_destroy(&shard->mu);
+    shard->~wheel_shard();
+  }
+  gpr_mu_destroy(&g_shared_mutables.mu);
+  gpr_free(g_shards);
+  g_shared_mutables.initialized = false;
+}
+
+static void timer_init(grpc_timer* timer, grpc_millis deadline,
+                       grpc_closure* closure) {
+  timer->closure = closure;
+  timer->deadline = deadline;
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline, grpc_core::ExecCtx::Get()->Now(), closure,
+            closure->cb);
+  }
+
+  if (!g_shared_mutables.initialized) {
+    timer->pending = false;
+    GRPC_CLOSURE_SCHED(timer->closure,
+                       GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                           "Attempt to create timer before initialization"));
+    return;
+  }
+
+  wheel_shard* shard = &g_shards[GPR_HASH_POINTER(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  timer->pending = true;
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  if (deadline <= now) {
+    timer->pending = false;
+    GRPC_CLOSURE_SCHED(timer->closure, GRPC_ERROR_NONE);
+    gpr_mu_unlock(&shard->mu);
+    /* early out */
+    return;
+  }
+  add_locked(shard, timer);
+  bool is_first_timer =
+      deadline < shard->min_deadline.Load(grpc_core::MemoryOrder::RELAXED);
+  if (is_first_timer) {
+    shard->min_deadline.Store(deadline, grpc_core::MemoryOrder::RELAXED);
+  }
+  gpr_mu_unlock(&shard->mu);
+
+  /* As in the generic implementation, a grpc_timer_check may run between the
+     unlock above and the lock below; at worst the new timer then waits for
+     the next check, or the poller is kicked needlessly. */
+  if (is_first_timer) {
+    gpr_mu_lock(&g_shared_mutables.mu);
+    if (deadline <
+        g_shared_mutables.min_timer.Load(grpc_core::MemoryOrder::RELAXED)) {
+      g_shared_mutables.min_timer.Store(deadline,
+                                        grpc_core::MemoryOrder::RELAXED);
+      grpc_kick_poller();
+    }
+    gpr_mu_unlock(&g_shared_mutables.mu);
+  }
+}
+
+static void timer_consume_kick(void) {}
+
+static void timer_cancel(grpc_timer* timer) {
+  if (!g_shared_mutables.initialized) {
+    /* must have already been cancelled, also the shard mutex is invalid */
+    return;
+  }
+
+  wheel_shard* shard = &g_shards[GPR_HASH_POINTER(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+  if (timer->pending) {
+    GRPC_CLOSURE_SCHED(timer->closure, GRPC_ERROR_CANCELLED);
+    timer->pending = false;
+    remove_locked(shard, timer);
+  }
+  gpr_mu_unlock(&shard->mu);
+}
+
+static grpc_timer_check_result run_some_expired_timers(grpc_millis now,
+                                                       grpc_millis* next,
+                                                       grpc_error* error) {
+  grpc_timer_check_result result = GRPC_TIMERS_NOT_CHECKED;
+
+  if (gpr_spinlock_trylock(&g_shared_mutables.checker_mu)) {
+    /* Holding mu while the shard minimums are gathered means a concurrent
+       timer_init that lowers one of them either is seen here or lowers
+       min_timer after it is stored below. */
+    gpr_mu_lock(&g_shared_mutables.mu);
+    result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+    grpc_millis new_min_timer = GRPC_MILLIS_INF_FUTURE;
+    for (size_t i = 0; i < g_num_shards; i++) {
+      wheel_shard* shard = &g_shards[i];
+      if (shard->min_deadline.Load(grpc_core::MemoryOrder::RELAXED) <= now) {
+        gpr_mu_lock(&shard->mu);
+        size_t n = advance_locked(shard, now, error);
+        grpc_millis min_deadline = next_event_locked(shard);
+        shard->min_deadline.Store(min_deadline,
+                                  grpc_core::MemoryOrder::RELAXED);
+        gpr_mu_unlock(&shard->mu);
+        if (n > 0) result = GRPC_TIMERS_FIRED;
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+          gpr_log(GPR_INFO,
+                  "  .. shard[%d] fired %" PRIdPTR
+                  ", min_deadline --> %" PRId64,
+                  static_cast<int>(i), n, min_deadline);
+        }
+      }
+      new_min_timer = GPR_MIN(
+          new_min_timer,
+          shard->min_deadline.Load(grpc_core::MemoryOrder::RELAXED));
+    }
+    if (next != nullptr) *next = GPR_MIN(*next, new_min_timer);
+    g_shared_mutables.min_timer.Store(new_min_timer,
+                                      grpc_core::MemoryOrder::RELAXED);
+    gpr_mu_unlock(&g_shared_mutables.mu);
+    gpr_spinlock_unlock(&g_shared_mutables.checker_mu);
+  }
+
+  GRPC_ERROR_UNREF(error);
+
+  return result;
+}
+
+static grpc_timer_check_result timer_check(grpc_millis* next) {
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_millis min_timer =
+      g_shared_mutables.min_timer.Load(grpc_core::MemoryOrder::RELAXED);
+  if (now < min_timer) {
+    if (next != nullptr) *next = GPR_MIN(*next, min_timer);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+      gpr_log(GPR_INFO, "TIMER CHECK SKIP: now=%" PRId64 " min_timer=%" PRId64,
+              now, min_timer);
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  grpc_error* shutdown_error =
+      now != GRPC_MILLIS_INF_FUTURE
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+  grpc_timer_check_result r =
+      run_some_expired_timers(now, next, shutdown_error);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK END: now=%" PRId64 " r=%d", now, r);
+  }
+  return r;
+}
+
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
@@ -38,6 +38,7 @@
 #include <limits.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
@@ -52,6 +53,7 @@
 #include <grpc/support/time.h>
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/error.h"
@@ -745,4 +747,208 @@ void GrpcUdpListener::OnDestroy() {
   }
 }
 
+#ifndef SOL_UDP
+#define SOL_UDP IPPROTO_UDP
+#endif
+#ifdef GRPC_LINUX_MMSG
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif
+
+namespace {
+
+/* Datagrams handed to the kernel per recvmmsg or sendmmsg. */
+constexpr size_t kMaxUdpBatch = 64;
+
+/* Room for one UDP_SEGMENT or UDP_GRO control message. */
+union UdpSegmentCmsg {
+  char buf[CMSG_SPACE(sizeof(int))];
+  struct cmsghdr align;
+};
+
+void fill_msghdr(grpc_udp_datagram* datagram, struct iovec* iov,
+                 UdpSegmentCmsg* control, bool recv, struct msghdr* hdr) {
+  memset(hdr, 0, sizeof(*hdr));
+  iov->iov_base = datagram->buf;
+  iov->iov_len = datagram->len;
+  hdr->msg_iov = iov;
+  hdr->msg_iovlen = 1;
+  if (recv) {
+    hdr->msg_name = datagram->addr.addr;
+    hdr->msg_namelen = sizeof(datagram->addr.addr);
+#ifdef GRPC_LINUX_MMSG
+    hdr->msg_control = control->buf;
+    hdr->msg_controllen = sizeof(control->buf);
+#endif
+    return;
+  }
+  if (datagram->addr.len > 0) {
+    hdr->msg_name = datagram->addr.addr;
+    hdr->msg_namelen = datagram->addr.len;
+  }
+#ifdef GRPC_LINUX_MMSG
+  if (datagram->segment_size > 0) {
+    memset(control, 0, sizeof(*control));
+    hdr->msg_control = control->buf;
+    hdr->msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(hdr);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    uint16_t segment_size = static_cast<uint16_t>(datagram->segment_size);
+    memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+  }
+#endif
+}
+
+void finish_recv(const struct msghdr* hdr, size_t len,
+                 grpc_udp_datagram* datagram) {
+  datagram->len = len;
+  datagram->addr.len = static_cast<socklen_t>(hdr->msg_namelen);
+  datagram->segment_size = 0;
+#ifdef GRPC_LINUX_MMSG
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(hdr); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(hdr), cmsg)) {
+    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+      int segment_size;
+      memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      datagram->segment_size = static_cast<size_t>(segment_size);
+    }
+  }
+#endif
+}
+
+bool is_would_block(int err) { return err == EAGAIN || err == EWOULDBLOCK; }
+
+}  // namespace
+
+bool grpc_udp_set_socket_gro(int fd) {
+#ifdef GRPC_LINUX_MMSG
+  int on = 1;
+  return setsockopt(fd, SOL_UDP, UDP_GRO, &on, sizeof(on)) == 0;
+#else
+  return false;
+#endif
+}
+
+bool grpc_udp_gso_supported() {
+#ifdef GRPC_LINUX_MMSG
+  /* UDP_SEGMENT is also a socket option; probing it on a throwaway socket is
+     the documented way to detect kernel support. */
+  static const bool supported = [] {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return false;
+    int segment_size = 0;
+    socklen_t len = sizeof(segment_size);
+    bool ok =
+        getsockopt(fd, SOL_UDP, UDP_SEGMENT, &segment_size, &len) == 0;
+    close(fd);
+    return ok;
+  }();
+  return supported;
+#else
+  return false;
+#endif
+}
+
+int grpc_udp_recv_batch(int fd, grpc_udp_datagram* datagrams, size_t count) {
+  size_t received = 0;
+  while (received < count) {
+    const size_t batch = GPR_MIN(count - received, kMaxUdpBatch);
+    struct iovec iovs[kMaxUdpBatch];
+    UdpSegmentCmsg controls[kMaxUdpBatch];
+#ifdef GRPC_LINUX_MMSG
+    struct mmsghdr hdrs[kMaxUdpBatch];
+    for (size_t i = 0; i < batch; i++) {
+      fill_msghdr(&datagrams[received + i], &iovs[i], &controls[i], true,
+                  &hdrs[i].msg_hdr);
+      hdrs[i].msg_len = 0;
+    }
+    int n;
+    do {
+      n = recvmmsg(fd, hdrs, static_cast<unsigned>(batch), MSG_DONTWAIT,
+                   nullptr);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+      if (received > 0 || is_would_block(errno)) break;
+      return -1;
+    }
+    for (int i = 0; i < n; i++) {
+      finish_recv(&hdrs[i].msg_hdr, hdrs[i].msg_len, &datagrams[received + i]);
+    }
+#else
+    int n = 0;
+    for (size_t i = 0; i < batch; i++) {
+      struct msghdr hdr;
+      fill_msghdr(&datagrams[received + i], &iovs[i], &controls[i], true,
+                  &hdr);
+      ssize_t len;
+      do {
+        len = recvmsg(fd, &hdr, MSG_DONTWAIT);
+      } while (len < 0 && errno == EINTR);
+      if (len < 0) {
+        if (received + n > 0 || is_would_block(errno)) break;
+        return -1;
+      }
+      finish_recv(&hdr, static_cast<size_t>(len), &datagrams[received + i]);
+      n++;
+    }
+#endif
+    received += static_cast<size_t>(n);
+    if (static_cast<size_t>(n) < batch) break;
+  }
+  return static_cast<int>(received);
+}
+
+int grpc_udp_send_batch(int fd, const grpc_udp_datagram* datagrams,
+                        size_t count) {
+  size_t sent = 0;
+  while (sent < count) {
+    const size_t batch = GPR_MIN(count - sent, kMaxUdpBatch);
+    struct iovec iovs[kMaxUdpBatch];
+    UdpSegmentCmsg controls[kMaxUdpBatch];
+    /* fill_msghdr only reads the datagram when sending */
+    grpc_udp_datagram* pending = const_cast<grpc_udp_datagram*>(datagrams);
+#ifdef GRPC_LINUX_MMSG
+    struct mmsghdr hdrs[kMaxUdpBatch];
+    for (size_t i = 0; i < batch; i++) {
+      fill_msghdr(&pending[sent + i], &iovs[i], &controls[i], false,
+                  &hdrs[i].msg_hdr);
+      hdrs[i].msg_len = 0;
+    }
+    int n;
+    do {
+      n = sendmmsg(fd, hdrs, static_cast<unsigned>(batch),
+                   MSG_DONTWAIT | MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+      if (sent > 0 || is_would_block(errno)) break;
+      return -1;
+    }
+#else
+    int n = 0;
+    for (size_t i = 0; i < batch; i++) {
+      struct msghdr hdr;
+      fill_msghdr(&pending[sent + i], &iovs[i], &controls[i], false, &hdr);
+      ssize_t len;
+      do {
+        len = sendmsg(fd, &hdr, MSG_DONTWAIT);
+      } while (len < 0 && errno == EINTR);
+      if (len < 0) {
+        if (sent + n > 0 || is_would_block(errno)) break;
+        return -1;
+      }
+      n++;
+    }
+#endif
+    sent += static_cast<size_t>(n);
+    if (static_cast<size_t>(n) < batch) break;
+  }
+  return static_cast<int>(sent);
+}
+
 #endif
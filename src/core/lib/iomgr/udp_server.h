@@ -104,4 +104,43 @@ int grpc_udp_server_add_port(grpc_udp_server* s,
 
 void grpc_udp_server_destroy(grpc_udp_server* server, grpc_closure* on_done);
 
+/* Batched datagram I/O for GrpcUdpHandler implementations. */
+
+/* One datagram of grpc_udp_recv_batch or grpc_udp_send_batch. */
+struct grpc_udp_datagram {
+  /* On send, the payload. On receive, the buffer to fill. */
+  char* buf;
+  /* On send, the payload length. On receive, the capacity of buf going in and
+     the number of bytes received coming out. */
+  size_t len;
+  /* On send, the destination, or addr.len == 0 on a connected socket. On
+     receive, the sender. */
+  grpc_resolved_address addr;
+  /* On send, if non-zero, has the kernel split buf into datagrams of this
+     size (UDP GSO; the last one may be shorter). On receive, the size of the
+     datagrams the kernel coalesced into buf (UDP GRO), or 0 if buf holds a
+     single datagram. */
+  size_t segment_size;
+};
+
+/* Asks the kernel to coalesce datagrams received on fd (UDP GRO), which
+   grpc_udp_recv_batch then reports through segment_size. Returns false if
+   unsupported. */
+bool grpc_udp_set_socket_gro(int fd);
+
+/* Whether the kernel accepts grpc_udp_datagram::segment_size on send. */
+bool grpc_udp_gso_supported();
+
+/* Receives up to count datagrams from the non-blocking socket fd, using a
+   single recvmmsg per batch where available. Returns the number received,
+   which is 0 if none are pending, or -1 with errno set on error. */
+int grpc_udp_recv_batch(int fd, grpc_udp_datagram* datagrams, size_t count);
+
+/* Sends up to count datagrams on the non-blocking socket fd, using a single
+   sendmmsg per batch where available. Returns the number sent, which is
+   fewer than count when the socket buffer fills up, or -1 with errno set if
+   none could be sent. */
+int grpc_udp_send_batch(int fd, const grpc_udp_datagram* datagrams,
+                        size_t count);
+
 #endif /* GRPC_CORE_LIB_IOMGR_UDP_SERVER_H */
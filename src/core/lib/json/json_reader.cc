@@ -75,6 +75,13 @@ static void json_reader_set_null(grpc_json_reader* reader) {
   reader->vtable->set_null(reader->userdata);
 }
 
+/* Returns whether c is added to a string as it is: anything but the closing
+ * quote, the start of an escape sequence, control characters and the
+ * GRPC_JSON_READ_CHAR_* codes. */
+static bool json_reader_is_plain_string_char(uint32_t c) {
+  return c >= 32 && c != '"' && c != '\\' && c < GRPC_JSON_READ_CHAR_EOF;
+}
+
 /* Call this function to initialize the reader structure. */
 void grpc_json_reader_init(grpc_json_reader* reader,
                            grpc_json_reader_vtable* vtable, void* userdata) {
@@ -97,6 +104,16 @@ grpc_json_reader_status grpc_json_reader_run(grpc_json_reader* reader) {
   /* This state-machine is a strict implementation of ECMA-404 */
   for (;;) {
     c = grpc_json_reader_read_char(reader);
+    /* Copy plain string characters straight to the scratchpad, rather than
+     * going through the state machine below for each of them. */
+    if ((reader->state == GRPC_JSON_STATE_OBJECT_KEY_STRING ||
+         reader->state == GRPC_JSON_STATE_VALUE_STRING) &&
+        reader->unicode_high_surrogate == 0) {
+      while (json_reader_is_plain_string_char(c)) {
+        json_reader_string_add_char(reader, c);
+        c = grpc_json_reader_read_char(reader);
+      }
+    }
     switch (c) {
       /* Let's process the error cases first. */
       case GRPC_JSON_READ_CHAR_ERROR:
@@ -0,0 +1,99 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_PROFILING_USDT_H
+#define GRPC_CORE_LIB_PROFILING_USDT_H
+
+#include <grpc/support/port_platform.h>
+
+/* USDT (user-level statically defined tracing) probes in the "grpc" provider.
+
+   On Linux, when <sys/sdt.h> (systemtap-sdt-dev) is available at build time,
+   each probe compiles to a single nop plus an ELF note naming it and its
+   arguments, so any build can be traced live with bpftrace, perf or
+   systemtap, without rebuilding or restarting it:
+
+     bpftrace -e 'usdt:/path/to/libgrpc.so:grpc:endpoint_read
+                  { @bytes = hist(arg1); }'
+     perf probe -x /path/to/libgrpc.so sdt_grpc:call_end
+
+   Nothing is recorded while no tracer is attached; the arguments of a probe
+   are values the surrounding code already has. Elsewhere, or with
+   GRPC_NO_USDT defined, the probes compile to nothing.
+
+   Probes and their arguments:
+     call_start(call, is_client)
+         A call was created.
+     call_end(call, status, latency_ns)
+         A call was destroyed, with its final grpc_status_code.
+     stream_open(transport, stream_id)
+         A chttp2 stream was given its id: when a client starts it, or when a
+         server accepts it.
+     stream_close(transport, stream_id)
+         A chttp2 stream was closed for both reading and writing. stream_id
+         is 0 if it never started.
+     frame_parsed(type, flags, stream_id, length)
+         The header of an incoming HTTP/2 frame was parsed, before its
+         payload is.
+     frame_written(type, flags, stream_id, length)
+         An outgoing HTTP/2 frame was serialized. length excludes the 9 byte
+         frame header.
+     combiner_run(combiner, closure)
+         A combiner is about to run a closure.
+     executor_enqueue(executor_name, closure, is_short)
+         A closure was queued to an executor thread.
+     executor_dequeue(executor_name, closure)
+         An executor thread is about to run a closure.
+     endpoint_read(endpoint, bytes)
+         A TCP endpoint read bytes and is about to hand them up.
+     endpoint_write(endpoint, bytes, attempted_bytes)
+         A TCP endpoint's sendmsg() accepted bytes of attempted_bytes. */
+
+#if !defined(GRPC_NO_USDT) && defined(GPR_LINUX) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define GRPC_HAVE_USDT 1
+#endif
+#endif
+
+#ifdef GRPC_HAVE_USDT
+#include <sys/sdt.h>
+
+#define GRPC_USDT0(name) DTRACE_PROBE(grpc, name)
+#define GRPC_USDT1(name, a) DTRACE_PROBE1(grpc, name, a)
+#define GRPC_USDT2(name, a, b) DTRACE_PROBE2(grpc, name, a, b)
+#define GRPC_USDT3(name, a, b, c) DTRACE_PROBE3(grpc, name, a, b, c)
+#define GRPC_USDT4(name, a, b, c, d) DTRACE_PROBE4(grpc, name, a, b, c, d)
+#else
+#define GRPC_USDT0(name) \
+  do {                   \
+  } while (0)
+#define GRPC_USDT1(name, a) \
+  do {                      \
+  } while (0)
+#define GRPC_USDT2(name, a, b) \
+  do {                         \
+  } while (0)
+#define GRPC_USDT3(name, a, b, c) \
+  do {                            \
+  } while (0)
+#define GRPC_USDT4(name, a, b, c, d) \
+  do {                               \
+  } while (0)
+#endif
+
+#endif /* GRPC_CORE_LIB_PROFILING_USDT_H */
@@ -37,6 +37,12 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_token_refresh_ahead_percent, 0,
+    "Percentage of the lifetime of an OAuth2 or JWT token after which it is "
+    "refreshed in the background while calls keep using it. 0 disables "
+    "refresh-ahead.");
+
 /* -- Common. -- */
 
 void grpc_channel_credentials_release(grpc_channel_credentials* creds) {
@@ -45,6 +51,15 @@ void grpc_channel_credentials_release(grpc_channel_credentials* creds) {
   if (creds) creds->Unref();
 }
 
+gpr_timespec grpc_token_refresh_ahead_time(gpr_timespec now,
+                                           gpr_timespec lifetime) {
+  int32_t percent = GPR_GLOBAL_CONFIG_GET(grpc_token_refresh_ahead_percent);
+  if (percent <= 0 || percent >= 100) return gpr_inf_future(now.clock_type);
+  int64_t lifetime_ms = gpr_time_to_millis(lifetime);
+  return gpr_time_add(
+      now, gpr_time_from_millis(lifetime_ms / 100 * percent, GPR_TIMESPAN));
+}
+
 static grpc_core::Map<grpc_core::UniquePtr<char>,
                       grpc_core::RefCountedPtr<grpc_channel_credentials>,
                       grpc_core::StringLess>* g_grpc_control_plane_creds;
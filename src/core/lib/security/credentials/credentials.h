@@ -26,6 +26,7 @@
 #include <grpc/support/sync.h>
 #include "src/core/lib/transport/metadata_batch.h"
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/map.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -62,6 +63,8 @@ typedef enum {
 
 #define GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS 60
 
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_token_refresh_ahead_percent);
+
 #define GRPC_COMPUTE_ENGINE_METADATA_HOST "metadata.google.internal."
 #define GRPC_COMPUTE_ENGINE_METADATA_TOKEN_PATH \
   "/computeMetadata/v1/instance/service-accounts/default/token"
@@ -206,6 +209,15 @@ void grpc_test_only_control_plane_credentials_destroy();
  * the few tests that need it. */
 void grpc_test_only_control_plane_credentials_force_init();
 
+/* --- Token refresh-ahead. --- */
+
+/// Returns the time after which a token obtained at \a now and valid for \a
+/// lifetime should be replaced in the background, while it is still used for
+/// calls. This is GRPC_TOKEN_REFRESH_AHEAD_PERCENT percent into its lifetime,
+/// or never if that is not set.
+gpr_timespec grpc_token_refresh_ahead_time(gpr_timespec now,
+                                           gpr_timespec lifetime);
+
 /* --- grpc_credentials_mdelem_array. --- */
 
 typedef struct {
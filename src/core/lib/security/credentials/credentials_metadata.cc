@@ -26,15 +26,26 @@
 
 #include "src/core/lib/slice/slice_internal.h"
 
+// Capacity is not stored: it is the smallest power of two, at least 2, that
+// holds the current size.
+static size_t mdelem_list_capacity(size_t size) {
+  size_t capacity = 2;
+  while (capacity < size) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
 static void mdelem_list_ensure_capacity(grpc_credentials_mdelem_array* list,
                                         size_t additional_space_needed) {
   size_t target_size = list->size + additional_space_needed;
-  // Find the next power of two greater than the target size (i.e.,
-  // whenever we add more space, we double what we already have).
-  size_t new_size = 2;
-  while (new_size < target_size) {
-    new_size *= 2;
+  // Adding to a list with room left, as a call's list of auth metadata
+  // usually has, needs no allocation.
+  if (list->md != nullptr && target_size <= mdelem_list_capacity(list->size)) {
+    return;
   }
+  // Whenever we add more space, we double what we already have.
+  size_t new_size = mdelem_list_capacity(target_size);
   list->md = static_cast<grpc_mdelem*>(
       gpr_realloc(list->md, sizeof(grpc_mdelem) * new_size));
 }
@@ -57,6 +57,12 @@
 static int g_metadata_server_available = 0;
 static int g_is_on_gce = 0;
 static gpr_mu g_state_mu;
+/* Set while a network test for the metadata server is running. Only one runs
+ * at a time: callers arriving meanwhile wait on g_probe_cv and share its
+ * result instead of each paying for their own probe. g_state_mu is not held
+ * during the probe itself. */
+static bool g_probe_in_flight = false;
+static gpr_cv g_probe_cv;
 /* Protect a metadata_server_detector instance that can be modified by more than
  * one gRPC threads */
 static gpr_mu* g_polling_mu;
@@ -64,7 +70,10 @@ static gpr_once g_once = GPR_ONCE_INIT;
 static grpc_core::internal::grpc_gce_tenancy_checker g_gce_tenancy_checker =
     grpc_alts_is_running_on_gcp;
 
-static void init_default_credentials(void) { gpr_mu_init(&g_state_mu); }
+static void init_default_credentials(void) {
+  gpr_mu_init(&g_state_mu);
+  gpr_cv_init(&g_probe_cv);
+}
 
 typedef struct {
   grpc_polling_entity pollent;
@@ -175,6 +184,9 @@ static int is_metadata_server_reachable() {
   memset(&request, 0, sizeof(grpc_httpcli_request));
   request.host = (char*)GRPC_COMPUTE_ENGINE_DETECTION_HOST;
   request.http.path = (char*)"/";
+  /* On GCE, the connection is then reused by the first token fetch from the
+     same host. */
+  request.keep_alive = true;
   grpc_httpcli_context_init(&context);
   grpc_resource_quota* resource_quota =
       grpc_resource_quota_create("google_default_credentials");
@@ -282,6 +294,7 @@ grpc_channel_credentials* grpc_google_default_credentials_create() {
   grpc_error* error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
       "Failed to create Google credentials");
   grpc_error* err;
+  int metadata_server_available;
   grpc_core::ExecCtx exec_ctx;
 
   GRPC_API_TRACE("grpc_google_default_credentials_create(void)", 0, ());
@@ -309,13 +322,27 @@ grpc_channel_credentials* grpc_google_default_credentials_create() {
   }
   /* TODO: Add a platform-provided hint for GAE. */
 
-  /* Do a network test for metadata server. */
+  /* Do a network test for metadata server, or wait for the one in flight. */
   if (!g_metadata_server_available) {
-    g_metadata_server_available = is_metadata_server_reachable();
+    if (g_probe_in_flight) {
+      while (g_probe_in_flight) {
+        gpr_cv_wait(&g_probe_cv, &g_state_mu,
+                    gpr_inf_future(GPR_CLOCK_MONOTONIC));
+      }
+    } else {
+      g_probe_in_flight = true;
+      gpr_mu_unlock(&g_state_mu);
+      int reachable = is_metadata_server_reachable();
+      gpr_mu_lock(&g_state_mu);
+      g_probe_in_flight = false;
+      if (reachable) g_metadata_server_available = 1;
+      gpr_cv_broadcast(&g_probe_cv);
+    }
   }
+  metadata_server_available = g_metadata_server_available;
   gpr_mu_unlock(&g_state_mu);
 
-  if (g_metadata_server_available) {
+  if (metadata_server_available) {
     call_creds = grpc_core::RefCountedPtr<grpc_call_credentials>(
         grpc_google_compute_engine_credentials_create(nullptr));
     if (call_creds == nullptr) {
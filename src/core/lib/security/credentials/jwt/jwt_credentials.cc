@@ -25,6 +25,7 @@
 
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/surface/api_trace.h"
 
 #include <grpc/support/alloc.h>
@@ -40,6 +41,64 @@ void grpc_service_account_jwt_access_credentials::reset_cache() {
     cached_.service_url = nullptr;
   }
   cached_.jwt_expiration = gpr_inf_past(GPR_CLOCK_REALTIME);
+  cached_.jwt_refresh_ahead_time = gpr_inf_future(GPR_CLOCK_REALTIME);
+}
+
+grpc_mdelem grpc_service_account_jwt_access_credentials::sign_jwt_md(
+    const char* service_url) {
+  char* jwt =
+      grpc_jwt_encode_and_sign(&key_, service_url, jwt_lifetime_, nullptr);
+  if (jwt == nullptr) return GRPC_MDNULL;
+  char* md_value;
+  gpr_asprintf(&md_value, "Bearer %s", jwt);
+  gpr_free(jwt);
+  grpc_mdelem jwt_md = grpc_mdelem_from_slices(
+      grpc_slice_from_static_string(GRPC_AUTHORIZATION_METADATA_KEY),
+      grpc_slice_from_copied_string(md_value));
+  gpr_free(md_value);
+  return jwt_md;
+}
+
+void grpc_service_account_jwt_access_credentials::cache_jwt_md_locked(
+    const char* service_url, grpc_mdelem jwt_md) {
+  char* cached_service_url = gpr_strdup(service_url);
+  reset_cache();
+  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+  cached_.jwt_expiration = gpr_time_add(now, jwt_lifetime_);
+  cached_.jwt_refresh_ahead_time =
+      grpc_token_refresh_ahead_time(now, jwt_lifetime_);
+  cached_.service_url = cached_service_url;
+  cached_.jwt_md = jwt_md;
+}
+
+namespace {
+struct jwt_refresh_ahead_request {
+  grpc_closure closure;
+  grpc_core::RefCountedPtr<grpc_call_credentials> creds;
+  char* service_url;
+};
+}  // namespace
+
+void grpc_service_account_jwt_access_credentials::on_refresh_ahead(
+    void* arg, grpc_error* error) {
+  jwt_refresh_ahead_request* request =
+      static_cast<jwt_refresh_ahead_request*>(arg);
+  auto* c = static_cast<grpc_service_account_jwt_access_credentials*>(
+      request->creds.get());
+  grpc_mdelem jwt_md = c->sign_jwt_md(request->service_url);
+  gpr_mu_lock(&c->cache_mu_);
+  // Drop the new jwt if the calls moved on to another service meanwhile. A
+  // failed signing keeps the cached jwt, which is still valid.
+  if (!GRPC_MDISNULL(jwt_md) && c->cached_.service_url != nullptr &&
+      strcmp(c->cached_.service_url, request->service_url) == 0) {
+    c->cache_jwt_md_locked(request->service_url, jwt_md);
+  } else {
+    GRPC_MDELEM_UNREF(jwt_md);
+  }
+  c->refresh_ahead_pending_ = false;
+  gpr_mu_unlock(&c->cache_mu_);
+  gpr_free(request->service_url);
+  grpc_core::Delete(request);
 }
 
 grpc_service_account_jwt_access_credentials::
@@ -56,42 +115,46 @@ bool grpc_service_account_jwt_access_credentials::get_request_metadata(
   gpr_timespec refresh_threshold = gpr_time_from_seconds(
       GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS, GPR_TIMESPAN);
 
-  /* See if we can return a cached jwt. */
+  /* See if we can return a cached jwt, else generate a new one. A call that
+     finds the cache stale waits for |cache_mu_| while another call signs a
+     new jwt, and then uses that one. */
   grpc_mdelem jwt_md = GRPC_MDNULL;
-  {
-    gpr_mu_lock(&cache_mu_);
-    if (cached_.service_url != nullptr &&
-        strcmp(cached_.service_url, context.service_url) == 0 &&
-        !GRPC_MDISNULL(cached_.jwt_md) &&
-        (gpr_time_cmp(
-             gpr_time_sub(cached_.jwt_expiration, gpr_now(GPR_CLOCK_REALTIME)),
-             refresh_threshold) > 0)) {
-      jwt_md = GRPC_MDELEM_REF(cached_.jwt_md);
+  bool refresh_ahead = false;
+  gpr_mu_lock(&cache_mu_);
+  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+  bool cache_matches = cached_.service_url != nullptr &&
+                       strcmp(cached_.service_url, context.service_url) == 0 &&
+                       !GRPC_MDISNULL(cached_.jwt_md);
+  if (!cache_matches ||
+      gpr_time_cmp(gpr_time_sub(cached_.jwt_expiration, now),
+                   refresh_threshold) <= 0) {
+    grpc_mdelem new_jwt_md = sign_jwt_md(context.service_url);
+    if (GRPC_MDISNULL(new_jwt_md)) {
+      reset_cache();
+    } else {
+      cache_jwt_md_locked(context.service_url, new_jwt_md);
     }
-    gpr_mu_unlock(&cache_mu_);
+  } else if (!refresh_ahead_pending_ &&
+             gpr_time_cmp(now, cached_.jwt_refresh_ahead_time) >= 0) {
+    refresh_ahead_pending_ = true;
+    refresh_ahead = true;
   }
-
-  if (GRPC_MDISNULL(jwt_md)) {
-    char* jwt = nullptr;
-    /* Generate a new jwt. */
-    gpr_mu_lock(&cache_mu_);
-    reset_cache();
-    jwt = grpc_jwt_encode_and_sign(&key_, context.service_url, jwt_lifetime_,
-                                   nullptr);
-    if (jwt != nullptr) {
-      char* md_value;
-      gpr_asprintf(&md_value, "Bearer %s", jwt);
-      gpr_free(jwt);
-      cached_.jwt_expiration =
-          gpr_time_add(gpr_now(GPR_CLOCK_REALTIME), jwt_lifetime_);
-      cached_.service_url = gpr_strdup(context.service_url);
-      cached_.jwt_md = grpc_mdelem_from_slices(
-          grpc_slice_from_static_string(GRPC_AUTHORIZATION_METADATA_KEY),
-          grpc_slice_from_copied_string(md_value));
-      gpr_free(md_value);
-      jwt_md = GRPC_MDELEM_REF(cached_.jwt_md);
-    }
-    gpr_mu_unlock(&cache_mu_);
+  if (cached_.service_url != nullptr &&
+      strcmp(cached_.service_url, context.service_url) == 0) {
+    jwt_md = GRPC_MDELEM_REF(cached_.jwt_md);
+  }
+  gpr_mu_unlock(&cache_mu_);
+  if (refresh_ahead) {
+    // Sign the next jwt on the executor rather than on this call's thread.
+    jwt_refresh_ahead_request* request =
+        grpc_core::New<jwt_refresh_ahead_request>();
+    request->creds = Ref();
+    request->service_url = gpr_strdup(context.service_url);
+    GRPC_CLOSURE_SCHED(
+        GRPC_CLOSURE_INIT(&request->closure, on_refresh_ahead, request,
+                          grpc_core::Executor::Scheduler(
+                              grpc_core::ExecutorJobType::SHORT)),
+        GRPC_ERROR_NONE);
   }
 
   if (!GRPC_MDISNULL(jwt_md)) {
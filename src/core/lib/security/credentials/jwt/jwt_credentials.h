@@ -45,6 +45,12 @@ class grpc_service_account_jwt_access_credentials
 
  private:
   void reset_cache();
+  // Returns the metadata for a newly signed jwt for service_url, or null if
+  // the signing failed.
+  grpc_mdelem sign_jwt_md(const char* service_url);
+  // Caches jwt_md, taking ownership of it. Called with cache_mu_ held.
+  void cache_jwt_md_locked(const char* service_url, grpc_mdelem jwt_md);
+  static void on_refresh_ahead(void* arg, grpc_error* error);
 
   // Have a simple cache for now with just 1 entry. We could have a map based on
   // the service_url for a more sophisticated one.
@@ -53,7 +59,11 @@ class grpc_service_account_jwt_access_credentials
     grpc_mdelem jwt_md = GRPC_MDNULL;
     char* service_url = nullptr;
     gpr_timespec jwt_expiration;
+    // Once this passes, the next call still uses the cached jwt but has a new
+    // one signed in the background.
+    gpr_timespec jwt_refresh_ahead_time;
   } cached_;
+  bool refresh_ahead_pending_ = false;
 
   grpc_auth_json_key key_;
   gpr_timespec jwt_lifetime_;
@@ -34,10 +34,12 @@ extern "C" {
 #include <openssl/bn.h>
 #include <openssl/pem.h>
 #include <openssl/rsa.h>
+#include <openssl/sha.h>
 }
 
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/http/httpcli.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/slice/b64.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -347,8 +349,14 @@ typedef struct {
   void* user_data;
   grpc_jwt_verification_done_cb user_cb;
   grpc_http_response responses[HTTP_RESPONSE_COUNT];
+  /* Identifies the JWT in the verified token cache of the verifier. */
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  grpc_closure offload_closure;
 } verifier_cb_ctx;
 
+static void verifier_ref(grpc_jwt_verifier* v);
+static void verifier_unref(grpc_jwt_verifier* v);
+
 /* Takes ownership of the header, claims and signature. */
 static verifier_cb_ctx* verifier_cb_ctx_create(
     grpc_jwt_verifier* verifier, grpc_pollset* pollset, jose_header* header,
@@ -359,6 +367,7 @@ static verifier_cb_ctx* verifier_cb_ctx_create(
   grpc_core::ExecCtx exec_ctx;
   verifier_cb_ctx* ctx =
       static_cast<verifier_cb_ctx*>(gpr_zalloc(sizeof(verifier_cb_ctx)));
+  verifier_ref(verifier);
   ctx->verifier = verifier;
   ctx->pollent = grpc_polling_entity_create_from_pollset(pollset);
   ctx->header = header;
@@ -369,6 +378,13 @@ static verifier_cb_ctx* verifier_cb_ctx_create(
   ctx->user_data = user_data;
   ctx->user_cb = cb;
 
+  SHA256_CTX sha_ctx;
+  SHA256_Init(&sha_ctx);
+  SHA256_Update(&sha_ctx, GRPC_SLICE_START_PTR(ctx->signed_data),
+                GRPC_SLICE_LENGTH(ctx->signed_data));
+  SHA256_Update(&sha_ctx, GRPC_SLICE_START_PTR(ctx->signature),
+                GRPC_SLICE_LENGTH(ctx->signature));
+  SHA256_Final(ctx->digest, &sha_ctx);
   return ctx;
 }
 
@@ -382,6 +398,7 @@ void verifier_cb_ctx_destroy(verifier_cb_ctx* ctx) {
     grpc_http_response_destroy(&ctx->responses[i]);
   }
   /* TODO: see what to do with claims... */
+  verifier_unref(ctx->verifier);
   gpr_free(ctx);
 }
 
@@ -393,18 +410,143 @@ gpr_timespec grpc_jwt_verifier_clock_skew = {60, 0, GPR_TIMESPAN};
 /* Max delay defaults to one minute. */
 grpc_millis grpc_jwt_verifier_max_delay = 60 * GPR_MS_PER_SEC;
 
+/* Key sets are cached for five minutes by default. */
+grpc_millis grpc_jwt_verifier_key_set_cache_ttl = 5 * 60 * GPR_MS_PER_SEC;
+
+#define GRPC_JWT_VERIFIER_MAX_CACHED_KEY_SETS 16
+#define GRPC_JWT_VERIFIER_VERIFIED_TOKEN_CACHE_SIZE 256
+
 typedef struct {
   char* email_domain;
   char* key_url_prefix;
 } email_key_mapping;
 
+typedef struct {
+  char* issuer;
+  char* key_set; /* The (unparsed) body of the key set response. */
+  grpc_millis expiry;
+} cached_key_set;
+
+typedef struct {
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  gpr_timespec exp;
+  bool used;
+} verified_token;
+
 struct grpc_jwt_verifier {
+  gpr_refcount refs;
   email_key_mapping* mappings;
   size_t num_mappings; /* Should be very few, linear search ok. */
   size_t allocated_mappings;
   grpc_httpcli_context http_ctx;
+
+  gpr_mu cache_mu;
+  cached_key_set key_sets[GRPC_JWT_VERIFIER_MAX_CACHED_KEY_SETS];
+  size_t num_key_sets; /* Should be very few, linear search ok. */
+  /* Direct mapped on the first byte of the digest of the JWT. */
+  verified_token verified_tokens[GRPC_JWT_VERIFIER_VERIFIED_TOKEN_CACHE_SIZE];
 };
 
+static void verifier_ref(grpc_jwt_verifier* v) { gpr_ref(&v->refs); }
+
+static void verifier_unref(grpc_jwt_verifier* v) {
+  size_t i;
+  if (!gpr_unref(&v->refs)) return;
+  grpc_httpcli_context_destroy(&v->http_ctx);
+  if (v->mappings != nullptr) {
+    for (i = 0; i < v->num_mappings; i++) {
+      gpr_free(v->mappings[i].email_domain);
+      gpr_free(v->mappings[i].key_url_prefix);
+    }
+    gpr_free(v->mappings);
+  }
+  for (i = 0; i < v->num_key_sets; i++) {
+    gpr_free(v->key_sets[i].issuer);
+    gpr_free(v->key_sets[i].key_set);
+  }
+  gpr_mu_destroy(&v->cache_mu);
+  gpr_free(v);
+}
+
+/* Returns a copy of the cached key set of issuer or NULL if there is none or
+   it expired. The caller takes ownership of the copy. */
+static char* verifier_get_cached_key_set(grpc_jwt_verifier* v,
+                                         const char* issuer) {
+  char* key_set = nullptr;
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  gpr_mu_lock(&v->cache_mu);
+  for (size_t i = 0; i < v->num_key_sets; i++) {
+    if (strcmp(v->key_sets[i].issuer, issuer) == 0) {
+      if (v->key_sets[i].expiry > now) {
+        key_set = gpr_strdup(v->key_sets[i].key_set);
+      }
+      break;
+    }
+  }
+  gpr_mu_unlock(&v->cache_mu);
+  return key_set;
+}
+
+/* Caches the key_set_len bytes of key_set as the key set of issuer, replacing
+   the one that expires first when the cache is full. */
+static void verifier_cache_key_set(grpc_jwt_verifier* v, const char* issuer,
+                                   const char* key_set, size_t key_set_len) {
+  if (grpc_jwt_verifier_key_set_cache_ttl <= 0) return;
+  grpc_millis expiry =
+      grpc_core::ExecCtx::Get()->Now() + grpc_jwt_verifier_key_set_cache_ttl;
+  char* copy = static_cast<char*>(gpr_malloc(key_set_len + 1));
+  memcpy(copy, key_set, key_set_len);
+  copy[key_set_len] = '\0';
+  gpr_mu_lock(&v->cache_mu);
+  cached_key_set* entry = nullptr;
+  for (size_t i = 0; i < v->num_key_sets; i++) {
+    if (strcmp(v->key_sets[i].issuer, issuer) == 0) {
+      entry = &v->key_sets[i];
+      break;
+    }
+  }
+  if (entry != nullptr) {
+    gpr_free(entry->key_set);
+  } else {
+    if (v->num_key_sets < GRPC_JWT_VERIFIER_MAX_CACHED_KEY_SETS) {
+      entry = &v->key_sets[v->num_key_sets++];
+    } else {
+      entry = &v->key_sets[0];
+      for (size_t i = 1; i < v->num_key_sets; i++) {
+        if (v->key_sets[i].expiry < entry->expiry) entry = &v->key_sets[i];
+      }
+      gpr_free(entry->issuer);
+      gpr_free(entry->key_set);
+    }
+    entry->issuer = gpr_strdup(issuer);
+  }
+  entry->key_set = copy;
+  entry->expiry = expiry;
+  gpr_mu_unlock(&v->cache_mu);
+}
+
+static bool verifier_is_verified_token(grpc_jwt_verifier* v,
+                                       const uint8_t* digest) {
+  verified_token* token = &v->verified_tokens[digest[0]];
+  gpr_mu_lock(&v->cache_mu);
+  bool verified =
+      token->used && memcmp(token->digest, digest, SHA256_DIGEST_LENGTH) == 0 &&
+      gpr_time_cmp(token->exp, gpr_now(GPR_CLOCK_REALTIME)) > 0;
+  gpr_mu_unlock(&v->cache_mu);
+  return verified;
+}
+
+static void verifier_put_verified_token(grpc_jwt_verifier* v,
+                                        const uint8_t* digest,
+                                        gpr_timespec exp) {
+  verified_token* token = &v->verified_tokens[digest[0]];
+  gpr_mu_lock(&v->cache_mu);
+  memcpy(token->digest, digest, SHA256_DIGEST_LENGTH);
+  token->exp = exp;
+  token->used = true;
+  gpr_mu_unlock(&v->cache_mu);
+}
+
 static grpc_json* json_from_http(const grpc_httpcli_response* response) {
   grpc_json* json = nullptr;
 
@@ -636,46 +778,89 @@ end:
   return result;
 }
 
-static void on_keys_retrieved(void* user_data, grpc_error* error) {
-  verifier_cb_ctx* ctx = static_cast<verifier_cb_ctx*>(user_data);
-  grpc_json* json = json_from_http(&ctx->responses[HTTP_RESPONSE_KEYS]);
-  EVP_PKEY* verification_key = nullptr;
-  grpc_jwt_verifier_status status = GRPC_JWT_VERIFIER_GENERIC_ERROR;
-  grpc_jwt_claims* claims = nullptr;
-
-  if (json == nullptr) {
-    status = GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR;
-    goto end;
-  }
-  verification_key =
+/* Checks the signature of the JWT of ctx with the key its header refers to in
+   the key set json. Returns GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR if there is
+   no such key. */
+static grpc_jwt_verifier_status verify_signature_with_key_set(
+    verifier_cb_ctx* ctx, const grpc_json* json) {
+  grpc_jwt_verifier_status status = GRPC_JWT_VERIFIER_OK;
+  EVP_PKEY* verification_key =
       find_verification_key(json, ctx->header->alg, ctx->header->kid);
   if (verification_key == nullptr) {
     gpr_log(GPR_ERROR, "Could not find verification key with kid %s.",
             ctx->header->kid);
-    status = GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR;
-    goto end;
+    return GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR;
   }
-
-  if (!verify_jwt_signature(verification_key, ctx->header->alg, ctx->signature,
-                            ctx->signed_data)) {
+  if (verify_jwt_signature(verification_key, ctx->header->alg, ctx->signature,
+                           ctx->signed_data)) {
+    verifier_put_verified_token(ctx->verifier, ctx->digest, ctx->claims->exp);
+  } else {
     status = GRPC_JWT_VERIFIER_BAD_SIGNATURE;
-    goto end;
   }
+  EVP_PKEY_free(verification_key);
+  return status;
+}
 
-  status = grpc_jwt_claims_check(ctx->claims, ctx->audience);
+/* Checks the claims of ctx if its signature is fine, reports the outcome to
+   the user callback and destroys ctx. */
+static void verifier_cb_ctx_done(verifier_cb_ctx* ctx,
+                                 grpc_jwt_verifier_status status) {
+  grpc_jwt_claims* claims = nullptr;
+  if (status == GRPC_JWT_VERIFIER_OK) {
+    status = grpc_jwt_claims_check(ctx->claims, ctx->audience);
+  }
   if (status == GRPC_JWT_VERIFIER_OK) {
     /* Pass ownership. */
     claims = ctx->claims;
     ctx->claims = nullptr;
   }
-
-end:
-  grpc_json_destroy(json);
-  EVP_PKEY_free(verification_key);
   ctx->user_cb(ctx->user_data, status, claims);
   verifier_cb_ctx_destroy(ctx);
 }
 
+/* Verifies the JWT of ctx with the cached key set of its issuer, if any.
+   Returns false, leaving ctx untouched, if the key has to be retrieved. */
+static bool verify_with_cached_key_set(verifier_cb_ctx* ctx) {
+  char* key_set = verifier_get_cached_key_set(ctx->verifier, ctx->claims->iss);
+  if (key_set == nullptr) return false;
+  grpc_json* json = grpc_json_parse_string(key_set);
+  grpc_jwt_verifier_status status = GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR;
+  if (json != nullptr) status = verify_signature_with_key_set(ctx, json);
+  grpc_json_destroy(json);
+  gpr_free(key_set);
+  /* The issuer may have rotated in a new key since the key set was cached. */
+  if (status == GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR) return false;
+  verifier_cb_ctx_done(ctx, status);
+  return true;
+}
+
+static void on_keys_retrieved(void* user_data, grpc_error* error) {
+  verifier_cb_ctx* ctx = static_cast<verifier_cb_ctx*>(user_data);
+  const grpc_http_response* response = &ctx->responses[HTTP_RESPONSE_KEYS];
+  grpc_jwt_verifier_status status = GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR;
+  char* key_set = nullptr;
+  size_t key_set_len = 0;
+  grpc_json* json;
+
+  /* Parsing the response modifies its body, keep a copy for the cache. */
+  if (response->status == 200 && response->body != nullptr) {
+    key_set_len = response->body_length;
+    key_set = static_cast<char*>(gpr_malloc(key_set_len));
+    memcpy(key_set, response->body, key_set_len);
+  }
+  json = json_from_http(response);
+  if (json != nullptr) {
+    status = verify_signature_with_key_set(ctx, json);
+    if (status != GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR) {
+      verifier_cache_key_set(ctx->verifier, ctx->claims->iss, key_set,
+                             key_set_len);
+    }
+  }
+  grpc_json_destroy(json);
+  gpr_free(key_set);
+  verifier_cb_ctx_done(ctx, status);
+}
+
 static void on_openid_config_retrieved(void* user_data, grpc_error* error) {
   const grpc_json* cur;
   verifier_cb_ctx* ctx = static_cast<verifier_cb_ctx*>(user_data);
@@ -685,7 +870,6 @@ static void on_openid_config_retrieved(void* user_data, grpc_error* error) {
   const char* jwks_uri;
   grpc_resource_quota* resource_quota = nullptr;
 
-  /* TODO(jboeuf): Cache the jwks_uri in order to avoid this hop next time. */
   if (json == nullptr) goto error;
   cur = find_property_by_name(json, "jwks_uri");
   if (cur == nullptr) {
@@ -699,7 +883,9 @@ static void on_openid_config_retrieved(void* user_data, grpc_error* error) {
     goto error;
   }
   jwks_uri += 8;
+  memset(&req, 0, sizeof(grpc_httpcli_request));
   req.handshaker = &grpc_httpcli_ssl;
+  req.keep_alive = true;
   req.host = gpr_strdup(jwks_uri);
   req.http.path = const_cast<char*>(strchr(jwks_uri, '/'));
   if (req.http.path == nullptr) {
@@ -724,8 +910,7 @@ static void on_openid_config_retrieved(void* user_data, grpc_error* error) {
 
 error:
   grpc_json_destroy(json);
-  ctx->user_cb(ctx->user_data, GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR, nullptr);
-  verifier_cb_ctx_destroy(ctx);
+  verifier_cb_ctx_done(ctx, GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR);
 }
 
 static email_key_mapping* verifier_get_mapping(grpc_jwt_verifier* v,
@@ -782,6 +967,7 @@ static void retrieve_key_and_verify(verifier_cb_ctx* ctx) {
   grpc_resource_quota* resource_quota = nullptr;
   memset(&req, 0, sizeof(grpc_httpcli_request));
   req.handshaker = &grpc_httpcli_ssl;
+  req.keep_alive = true;
   http_response_index rsp_idx;
 
   GPR_ASSERT(ctx != nullptr && ctx->header != nullptr &&
@@ -795,6 +981,7 @@ static void retrieve_key_and_verify(verifier_cb_ctx* ctx) {
     gpr_log(GPR_ERROR, "Missing iss in claims.");
     goto error;
   }
+  if (verify_with_cached_key_set(ctx)) return;
 
   /* This code relies on:
      https://openid.net/specs/openid-connect-discovery-1_0.html
@@ -850,15 +1037,20 @@ static void retrieve_key_and_verify(verifier_cb_ctx* ctx) {
   return;
 
 error:
-  ctx->user_cb(ctx->user_data, GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR, nullptr);
-  verifier_cb_ctx_destroy(ctx);
+  verifier_cb_ctx_done(ctx, GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR);
 }
 
-void grpc_jwt_verifier_verify(grpc_jwt_verifier* verifier,
-                              grpc_pollset* pollset, const char* jwt,
-                              const char* audience,
-                              grpc_jwt_verification_done_cb cb,
-                              void* user_data) {
+static void retrieve_key_and_verify_offloaded(void* arg, grpc_error* error) {
+  retrieve_key_and_verify(static_cast<verifier_cb_ctx*>(arg));
+}
+
+/* If offload is set, the key retrieval and the signature check run on the
+   executor. */
+static void verify_jwt(grpc_jwt_verifier* verifier, grpc_pollset* pollset,
+                       const char* jwt, const char* audience,
+                       grpc_jwt_verification_done_cb cb, void* user_data,
+                       bool offload) {
+  verifier_cb_ctx* ctx;
   const char* dot = nullptr;
   grpc_json* json;
   jose_header* header = nullptr;
@@ -892,9 +1084,18 @@ void grpc_jwt_verifier_verify(grpc_jwt_verifier* verifier,
   cur = dot + 1;
   signature = grpc_base64_decode(cur, 1);
   if (GRPC_SLICE_IS_EMPTY(signature)) goto error;
-  retrieve_key_and_verify(
-      verifier_cb_ctx_create(verifier, pollset, header, claims, audience,
-                             signature, jwt, signed_jwt_len, user_data, cb));
+  ctx = verifier_cb_ctx_create(verifier, pollset, header, claims, audience,
+                               signature, jwt, signed_jwt_len, user_data, cb);
+  if (verifier_is_verified_token(verifier, ctx->digest)) {
+    verifier_cb_ctx_done(ctx, GRPC_JWT_VERIFIER_OK);
+  } else if (offload) {
+    GRPC_CLOSURE_INIT(
+        &ctx->offload_closure, retrieve_key_and_verify_offloaded, ctx,
+        grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::SHORT));
+    GRPC_CLOSURE_SCHED(&ctx->offload_closure, GRPC_ERROR_NONE);
+  } else {
+    retrieve_key_and_verify(ctx);
+  }
   return;
 
 error:
@@ -903,12 +1104,35 @@ error:
   cb(user_data, GRPC_JWT_VERIFIER_BAD_FORMAT, nullptr);
 }
 
+void grpc_jwt_verifier_verify(grpc_jwt_verifier* verifier,
+                              grpc_pollset* pollset, const char* jwt,
+                              const char* audience,
+                              grpc_jwt_verification_done_cb cb,
+                              void* user_data) {
+  verify_jwt(verifier, pollset, jwt, audience, cb, user_data, false);
+}
+
+void grpc_jwt_verifier_verify_batch(grpc_jwt_verifier* verifier,
+                                    grpc_pollset* pollset,
+                                    const char* const* jwts, size_t num_jwts,
+                                    const char* audience,
+                                    grpc_jwt_verification_done_cb cb,
+                                    void* const* user_data) {
+  grpc_core::ExecCtx exec_ctx;
+  GPR_ASSERT(num_jwts == 0 || (jwts != nullptr && user_data != nullptr));
+  for (size_t i = 0; i < num_jwts; i++) {
+    verify_jwt(verifier, pollset, jwts[i], audience, cb, user_data[i], true);
+  }
+}
+
 grpc_jwt_verifier* grpc_jwt_verifier_create(
     const grpc_jwt_verifier_email_domain_key_url_mapping* mappings,
     size_t num_mappings) {
   grpc_jwt_verifier* v =
       static_cast<grpc_jwt_verifier*>(gpr_zalloc(sizeof(grpc_jwt_verifier)));
+  gpr_ref_init(&v->refs, 1);
   grpc_httpcli_context_init(&v->http_ctx);
+  gpr_mu_init(&v->cache_mu);
 
   /* We know at least of one mapping. */
   v->allocated_mappings = 1 + num_mappings;
@@ -928,15 +1152,6 @@ grpc_jwt_verifier* grpc_jwt_verifier_create(
 }
 
 void grpc_jwt_verifier_destroy(grpc_jwt_verifier* v) {
-  size_t i;
   if (v == nullptr) return;
-  grpc_httpcli_context_destroy(&v->http_ctx);
-  if (v->mappings != nullptr) {
-    for (i = 0; i < v->num_mappings; i++) {
-      gpr_free(v->mappings[i].email_domain);
-      gpr_free(v->mappings[i].key_url_prefix);
-    }
-    gpr_free(v->mappings);
-  }
-  gpr_free(v);
+  verifier_unref(v);
 }
@@ -84,6 +84,9 @@ typedef struct {
 /* Globals to control the verifier. Not thread-safe. */
 extern gpr_timespec grpc_jwt_verifier_clock_skew;
 extern grpc_millis grpc_jwt_verifier_max_delay;
+/* How long a verifier keeps using the key set it retrieved for an issuer
+   before fetching it again. 0 disables key set caching. */
+extern grpc_millis grpc_jwt_verifier_key_set_cache_ttl;
 
 /* The verifier can be created with some custom mappings to help with key
    discovery in the case where the issuer is an email address.
@@ -95,7 +98,11 @@ grpc_jwt_verifier* grpc_jwt_verifier_create(
     const grpc_jwt_verifier_email_domain_key_url_mapping* mappings,
     size_t num_mappings);
 
-/*The verifier must not be destroyed if there are still outstanding callbacks.*/
+/* The verifier keeps the key sets it retrieved (see
+   grpc_jwt_verifier_key_set_cache_ttl) and remembers the JWTs whose signature
+   it checked until they expire, so verifying them again skips key retrieval
+   and signature verification. Outstanding verifications keep the verifier
+   alive after it is destroyed. */
 void grpc_jwt_verifier_destroy(grpc_jwt_verifier* verifier);
 
 /* User provided callback that will be called when the verification of the JWT
@@ -113,6 +120,18 @@ void grpc_jwt_verifier_verify(grpc_jwt_verifier* verifier,
                               grpc_jwt_verification_done_cb cb,
                               void* user_data);
 
+/* Verifies the num_jwts JWTs in jwts for the given expected audience. cb is
+   called once per JWT, with the matching entry of user_data. The retrieval of
+   the keys and the signature checks of the JWTs not verified before run in
+   parallel on the executor, so cb may be called from several threads at
+   once. */
+void grpc_jwt_verifier_verify_batch(grpc_jwt_verifier* verifier,
+                                    grpc_pollset* pollset,
+                                    const char* const* jwts, size_t num_jwts,
+                                    const char* audience,
+                                    grpc_jwt_verification_done_cb cb,
+                                    void* const* user_data);
+
 /* --- TESTING ONLY exposed functions. --- */
 
 grpc_jwt_claims* grpc_jwt_claims_from_json(grpc_json* json,
@@ -237,12 +237,16 @@ void grpc_oauth2_token_fetcher_credentials::on_http_response(
   // Update cache and grab list of pending requests.
   gpr_mu_lock(&mu_);
   token_fetch_pending_ = false;
-  access_token_md_ = GRPC_MDELEM_REF(access_token_md);
-  token_expiration_ =
-      status == GRPC_CREDENTIALS_OK
-          ? gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
-                         gpr_time_from_millis(token_lifetime, GPR_TIMESPAN))
-          : gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  // A failed fetch leaves the cached token alone, so that a failed refresh
+  // ahead of expiry does not cut off calls that could still use it.
+  if (status == GRPC_CREDENTIALS_OK) {
+    GRPC_MDELEM_UNREF(access_token_md_);
+    access_token_md_ = GRPC_MDELEM_REF(access_token_md);
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    gpr_timespec lifetime = gpr_time_from_millis(token_lifetime, GPR_TIMESPAN);
+    token_expiration_ = gpr_time_add(now, lifetime);
+    token_refresh_ahead_time_ = grpc_token_refresh_ahead_time(now, lifetime);
+  }
   grpc_oauth2_pending_get_request_metadata* pending_request = pending_requests_;
   pending_requests_ = nullptr;
   gpr_mu_unlock(&mu_);
@@ -276,18 +280,37 @@ bool grpc_oauth2_token_fetcher_credentials::get_request_metadata(
   grpc_millis refresh_threshold =
       GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS * GPR_MS_PER_SEC;
   grpc_mdelem cached_access_token_md = GRPC_MDNULL;
+  bool refresh_ahead = false;
   gpr_mu_lock(&mu_);
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
   if (!GRPC_MDISNULL(access_token_md_) &&
-      gpr_time_cmp(
-          gpr_time_sub(token_expiration_, gpr_now(GPR_CLOCK_MONOTONIC)),
-          gpr_time_from_seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
-                                GPR_TIMESPAN)) > 0) {
+      gpr_time_cmp(gpr_time_sub(token_expiration_, now),
+                   gpr_time_from_seconds(
+                       GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
+                       GPR_TIMESPAN)) > 0) {
     cached_access_token_md = GRPC_MDELEM_REF(access_token_md_);
+    // Fetch the next token while this one keeps serving calls. Only one
+    // fetch is in flight at a time.
+    if (!token_fetch_pending_ &&
+        gpr_time_cmp(now, token_refresh_ahead_time_) >= 0) {
+      token_fetch_pending_ = true;
+      refresh_ahead = true;
+    }
   }
   if (!GRPC_MDISNULL(cached_access_token_md)) {
     gpr_mu_unlock(&mu_);
     grpc_credentials_mdelem_array_add(md_array, cached_access_token_md);
     GRPC_MDELEM_UNREF(cached_access_token_md);
+    if (refresh_ahead) {
+      // No call waits for this fetch, so it is polled by whichever pollers
+      // see its fd, or by the calls that queue on it once the token gets
+      // close to its expiry.
+      Ref().release();
+      fetch_oauth2(grpc_credentials_metadata_request_create(this->Ref()),
+                   &httpcli_context_, &pollent_,
+                   on_oauth2_token_fetcher_http_response,
+                   grpc_core::ExecCtx::Get()->Now() + refresh_threshold);
+    }
     return true;
   }
   // Couldn't get the token from the cache.
@@ -347,6 +370,7 @@ void grpc_oauth2_token_fetcher_credentials::cancel_get_request_metadata(
 grpc_oauth2_token_fetcher_credentials::grpc_oauth2_token_fetcher_credentials()
     : grpc_call_credentials(GRPC_CALL_CREDENTIALS_TYPE_OAUTH2),
       token_expiration_(gpr_inf_past(GPR_CLOCK_MONOTONIC)),
+      token_refresh_ahead_time_(gpr_inf_future(GPR_CLOCK_MONOTONIC)),
       pollent_(grpc_polling_entity_create_from_pollset_set(
           grpc_pollset_set_create())) {
   gpr_mu_init(&mu_);
@@ -379,6 +403,7 @@ class grpc_compute_engine_token_fetcher_credentials
     request.http.path = (char*)GRPC_COMPUTE_ENGINE_METADATA_TOKEN_PATH;
     request.http.hdr_count = 1;
     request.http.hdrs = &header;
+    request.keep_alive = true;
     /* TODO(ctiller): Carry the resource_quota in ctx and share it with the host
        channel. This would allow us to cancel an authentication query when under
        extreme memory pressure. */
@@ -434,6 +459,7 @@ void grpc_google_refresh_token_credentials::fetch_oauth2(
   request.http.hdr_count = 1;
   request.http.hdrs = &header;
   request.handshaker = &grpc_httpcli_ssl;
+  request.keep_alive = true;
   /* TODO(ctiller): Carry the resource_quota in ctx and share it with the host
      channel. This would allow us to cancel an authentication query when under
      extreme memory pressure. */
@@ -561,6 +587,7 @@ class StsTokenFetcherCredentials
     request.handshaker = (strcmp(sts_url_->scheme, "https") == 0)
                              ? &grpc_httpcli_ssl
                              : &grpc_httpcli_plaintext;
+    request.keep_alive = true;
     /* TODO(ctiller): Carry the resource_quota in ctx and share it with the host
        channel. This would allow us to cancel an authentication query when under
        extreme memory pressure. */
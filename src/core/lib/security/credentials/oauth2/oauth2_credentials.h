@@ -97,6 +97,9 @@ class grpc_oauth2_token_fetcher_credentials : public grpc_call_credentials {
   gpr_mu mu_;
   grpc_mdelem access_token_md_ = GRPC_MDNULL;
   gpr_timespec token_expiration_;
+  // Once this passes, the next call still uses the cached token but starts a
+  // fetch of a new one.
+  gpr_timespec token_refresh_ahead_time_;
   bool token_fetch_pending_ = false;
   grpc_oauth2_pending_get_request_metadata* pending_requests_ = nullptr;
   grpc_httpcli_context httpcli_context_;
@@ -19,11 +19,19 @@
 #ifndef GRPC_CORE_LIB_SECURITY_SECURITY_CONNECTOR_LOAD_SYSTEM_ROOTS_H
 #define GRPC_CORE_LIB_SECURITY_SECURITY_CONNECTOR_LOAD_SYSTEM_ROOTS_H
 
+#include "src/core/lib/gprpp/memory.h"
+
 namespace grpc_core {
 
 // Returns a slice containing roots from the OS trust store
 grpc_slice LoadSystemRootCerts();
 
+// Returns the directory, in OpenSSL's hashed format, that the roots returned
+// by LoadSystemRootCerts() come from, for a root store loading them as they
+// are needed. Returns nullptr if there is none, or unless the
+// grpc_lazy_system_ssl_roots config is set.
+UniquePtr<char> GetSystemRootCertsHashedDir();
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_SECURITY_SECURITY_CONNECTOR_LOAD_SYSTEM_ROOTS_H */
@@ -27,6 +27,8 @@ namespace grpc_core {
 
 grpc_slice LoadSystemRootCerts() { return grpc_empty_slice(); }
 
+UniquePtr<char> GetSystemRootCertsHashedDir() { return nullptr; }
+
 }  // namespace grpc_core
 
 #endif /* GPR_LINUX */
@@ -25,10 +25,12 @@
 
 #include "src/core/lib/security/security_connector/load_system_roots.h"
 
+#include <ctype.h>
 #include <dirent.h>
 #include <fcntl.h>
 #include <stdbool.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -42,11 +44,17 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/inlined_vector.h"
+#include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/load_file.h"
 
 GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_system_ssl_roots_dir, "",
                                 "Custom directory to SSL Roots");
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_lazy_system_ssl_roots, false,
+    "Map the system SSL roots bundle rather than reading it, and load roots "
+    "from the hashed system certificate directory as handshakes need them.");
+
 namespace grpc_core {
 namespace {
 
@@ -59,20 +67,109 @@ const char* kLinuxCertDirectories[] = {
     "/etc/pki/tls/certs", "/etc/openssl/certs"};
 
 grpc_slice GetSystemRootCerts() {
+  const bool map_files = GPR_GLOBAL_CONFIG_GET(grpc_lazy_system_ssl_roots);
   grpc_slice valid_bundle_slice = grpc_empty_slice();
   size_t num_cert_files_ = GPR_ARRAY_SIZE(kLinuxCertFiles);
   for (size_t i = 0; i < num_cert_files_; i++) {
+    if (map_files) {
+      valid_bundle_slice = MapRootCertsFile(kLinuxCertFiles[i]);
+      if (!GRPC_SLICE_IS_EMPTY(valid_bundle_slice)) {
+        return valid_bundle_slice;
+      }
+      continue;
+    }
     grpc_error* error =
         grpc_load_file(kLinuxCertFiles[i], 1, &valid_bundle_slice);
     if (error == GRPC_ERROR_NONE) {
       return valid_bundle_slice;
     }
+    GRPC_ERROR_UNREF(error);
   }
   return grpc_empty_slice();
 }
 
+struct MappedFile {
+  void* data;
+  size_t size;
+};
+
+void UnmapFile(void* user_data) {
+  MappedFile* mapped = static_cast<MappedFile*>(user_data);
+  munmap(mapped->data, mapped->size);
+  gpr_free(mapped);
+}
+
+// Whether name is that of an entry of an OpenSSL hashed directory: the
+// subject name hash in hex, a dot and a sequence number.
+bool IsSubjectHashName(const char* name) {
+  for (int i = 0; i < 8; i++) {
+    if (!isxdigit(static_cast<unsigned char>(name[i]))) return false;
+  }
+  if (name[8] != '.' || name[9] == '\0') return false;
+  for (const char* c = name + 9; *c != '\0'; c++) {
+    if (!isdigit(static_cast<unsigned char>(*c))) return false;
+  }
+  return true;
+}
+
+// Returns a copy of the directory \a path is in.
+UniquePtr<char> DirectoryOf(const char* path) {
+  const char* last_slash = strrchr(path, '/');
+  if (last_slash == nullptr) return UniquePtr<char>(gpr_strdup("."));
+  const size_t length = static_cast<size_t>(last_slash - path);
+  char* dir = static_cast<char*>(gpr_malloc(length + 1));
+  memcpy(dir, path, length);
+  dir[length] = '\0';
+  return UniquePtr<char>(dir);
+}
+
 }  // namespace
 
+grpc_slice MapRootCertsFile(const char* path) {
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) return grpc_empty_slice();
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode) ||
+      file_stat.st_size == 0) {
+    close(fd);
+    return grpc_empty_slice();
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  // The rest of the last page of the mapping reads as zeros, terminating the
+  // bundle like grpc_load_file() does. A file filling its last page has no
+  // room for that and is read instead.
+  if (size % static_cast<size_t>(sysconf(_SC_PAGESIZE)) == 0) {
+    close(fd);
+    grpc_slice bundle_slice = grpc_empty_slice();
+    GRPC_LOG_IF_ERROR("load_file", grpc_load_file(path, 1, &bundle_slice));
+    return bundle_slice;
+  }
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "failed to map file: %s", path);
+    return grpc_empty_slice();
+  }
+  MappedFile* mapped = static_cast<MappedFile*>(gpr_malloc(sizeof(*mapped)));
+  mapped->data = data;
+  mapped->size = size;
+  return grpc_slice_new_with_user_data(data, size + 1, UnmapFile, mapped);
+}
+
+bool IsHashedCertsDirectory(const char* certs_directory) {
+  DIR* ca_directory = opendir(certs_directory);
+  if (ca_directory == nullptr) {
+    return false;
+  }
+  bool hashed = false;
+  struct dirent* directory_entry;
+  while (!hashed && (directory_entry = readdir(ca_directory)) != nullptr) {
+    hashed = IsSubjectHashName(directory_entry->d_name);
+  }
+  closedir(ca_directory);
+  return hashed;
+}
+
 void GetAbsoluteFilePath(const char* valid_file_dir,
                          const char* file_entry_name, char* path_buffer) {
   if (valid_file_dir != nullptr && file_entry_name != nullptr) {
@@ -162,6 +259,30 @@ grpc_slice LoadSystemRootCerts() {
   return result;
 }
 
+UniquePtr<char> GetSystemRootCertsHashedDir() {
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_lazy_system_ssl_roots)) return nullptr;
+  // Follow the order LoadSystemRootCerts() picks the roots in, and only use
+  // the directory that the picked roots come from.
+  UniquePtr<char> dir = GPR_GLOBAL_CONFIG_GET(grpc_system_ssl_roots_dir);
+  if (strlen(dir.get()) == 0) {
+    dir.reset();
+    for (size_t i = 0; dir == nullptr && i < GPR_ARRAY_SIZE(kLinuxCertFiles);
+         i++) {
+      if (access(kLinuxCertFiles[i], R_OK) == 0) {
+        dir = DirectoryOf(kLinuxCertFiles[i]);
+      }
+    }
+    for (size_t i = 0;
+         dir == nullptr && i < GPR_ARRAY_SIZE(kLinuxCertDirectories); i++) {
+      if (access(kLinuxCertDirectories[i], R_OK) == 0) {
+        dir.reset(gpr_strdup(kLinuxCertDirectories[i]));
+      }
+    }
+  }
+  if (dir == nullptr || !IsHashedCertsDirectory(dir.get())) return nullptr;
+  return dir;
+}
+
 }  // namespace grpc_core
 
 #endif /* GPR_LINUX */
@@ -37,6 +37,17 @@ grpc_slice CreateRootCertsBundle(const char* certs_directory);
 void GetAbsoluteFilePath(const char* valid_file_dir,
                          const char* file_entry_name, char* path_buffer);
 
+// Maps the certificate file at path into memory, rather than reading it, so
+// that its pages are only loaded as they are used and are shared by the
+// processes mapping it. Returns a NUL-terminated slice, empty on failure.
+// Exposed for testing purposes only.
+grpc_slice MapRootCertsFile(const char* path);
+
+// Returns whether a directory holds certificates in OpenSSL's hashed format,
+// named after their subject name hashes (as c_rehash creates them).
+// Exposed for testing purposes only.
+bool IsHashedCertsDirectory(const char* certs_directory);
+
 }  // namespace grpc_core
 
 #endif /* GPR_LINUX */
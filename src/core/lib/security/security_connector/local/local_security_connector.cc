@@ -20,7 +20,9 @@
 
 #include "src/core/lib/security/security_connector/local/local_security_connector.h"
 
+#include <errno.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <string.h>
 
 #include <grpc/grpc.h>
@@ -58,6 +60,29 @@ grpc_core::RefCountedPtr<grpc_auth_context> local_auth_context_create() {
   return ctx;
 }
 
+/* Adds the ids of the process at the other end of the unix socket fd to ctx,
+   for authorization by the application. */
+void local_auth_context_add_peer_credentials(grpc_auth_context* ctx, int fd) {
+#ifdef SO_PEERCRED
+  struct ucred cred;
+  socklen_t len = sizeof(cred);
+  if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) {
+    gpr_log(GPR_ERROR, "getsockopt(SO_PEERCRED) failed: %s", strerror(errno));
+    return;
+  }
+  char value[32];
+  snprintf(value, sizeof(value), "%u", static_cast<unsigned>(cred.uid));
+  grpc_auth_context_add_cstring_property(ctx, GRPC_LOCAL_PEER_UID_PROPERTY_NAME,
+                                         value);
+  snprintf(value, sizeof(value), "%u", static_cast<unsigned>(cred.gid));
+  grpc_auth_context_add_cstring_property(ctx, GRPC_LOCAL_PEER_GID_PROPERTY_NAME,
+                                         value);
+  snprintf(value, sizeof(value), "%d", static_cast<int>(cred.pid));
+  grpc_auth_context_add_cstring_property(ctx, GRPC_LOCAL_PEER_PID_PROPERTY_NAME,
+                                         value);
+#endif
+}
+
 void local_check_peer(grpc_security_connector* sc, tsi_peer peer,
                       grpc_endpoint* ep,
                       grpc_core::RefCountedPtr<grpc_auth_context>* auth_context,
@@ -105,10 +130,12 @@ void local_check_peer(grpc_security_connector* sc, tsi_peer peer,
   }
   /* Create an auth context which is necessary to pass the santiy check in
    * {client, server}_auth_filter that verifies if the peer's auth context is
-   * obtained during handshakes. The auth context is only checked for its
-   * existence and not actually used.
+   * obtained during handshakes. Over UDS it also carries the peer's ids.
    */
   *auth_context = local_auth_context_create();
+  if (type == UDS && *auth_context != nullptr) {
+    local_auth_context_add_peer_credentials(auth_context->get(), fd);
+  }
   error = *auth_context != nullptr ? GRPC_ERROR_NONE
                                    : GRPC_ERROR_CREATE_FROM_STATIC_STRING(
                                          "Could not create local auth context");
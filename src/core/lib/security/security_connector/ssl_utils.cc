@@ -20,10 +20,14 @@
 
 #include "src/core/lib/security/security_connector/ssl_utils.h"
 
+#include <openssl/opensslv.h>
+#include <openssl/sha.h>
+
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/ext/transport/chttp2/alpn/alpn.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -34,6 +38,7 @@
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/security_connector/load_system_roots.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl_transport_security.h"
 
 /* -- Constants. -- */
@@ -88,6 +93,58 @@ static void init_cipher_suites(void) {
   cipher_suites = value.release();
 }
 
+/** Config variable that points to a file of session ticket keys, which all the
+   servers of a fleet can share so that clients resume sessions with any of
+   them. The file holds keys of TSI_SSL_SESSION_TICKET_KEY_SIZE bytes back to
+   back, the first of which issues new tickets; see
+   tsi_ssl_session_ticket_keys. It is re-read every
+   kSessionTicketKeysReloadIntervalSecs, so keys are rotated by rewriting it:
+   to avoid full handshakes during a rotation, first append the new key, then
+   once every server has read it move it to the front. */
+GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_ssl_session_ticket_keys_file, "",
+                                "Path to the session ticket keys file.");
+
+static const int kSessionTicketKeysReloadIntervalSecs = 60;
+
+static gpr_once session_ticket_keys_once = GPR_ONCE_INIT;
+static gpr_mu session_ticket_keys_mu;
+/* nullptr unless grpc_ssl_session_ticket_keys_file is set */
+static tsi_ssl_session_ticket_keys* session_ticket_keys;
+static char* session_ticket_keys_path;
+static gpr_timespec session_ticket_keys_next_load;
+
+static void load_session_ticket_keys_locked(void) {
+  grpc_slice contents;
+  grpc_error* error = grpc_load_file(session_ticket_keys_path, 0, &contents);
+  if (error != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "Could not load session ticket keys: %s",
+            grpc_error_string(error));
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  if (tsi_ssl_session_ticket_keys_set(session_ticket_keys,
+                                      GRPC_SLICE_START_PTR(contents),
+                                      GRPC_SLICE_LENGTH(contents)) != TSI_OK) {
+    gpr_log(GPR_ERROR, "Invalid session ticket keys in %s, keeping old keys.",
+            session_ticket_keys_path);
+  }
+  grpc_slice_unref_internal(contents);
+}
+
+static void init_session_ticket_keys(void) {
+  grpc_core::UniquePtr<char> path =
+      GPR_GLOBAL_CONFIG_GET(grpc_ssl_session_ticket_keys_file);
+  if (strlen(path.get()) == 0) return;
+  gpr_mu_init(&session_ticket_keys_mu);
+  session_ticket_keys_path = path.release();
+  session_ticket_keys = tsi_ssl_session_ticket_keys_create();
+  load_session_ticket_keys_locked();
+  session_ticket_keys_next_load = gpr_time_add(
+      gpr_now(GPR_CLOCK_MONOTONIC),
+      gpr_time_from_seconds(kSessionTicketKeysReloadIntervalSecs,
+                            GPR_TIMESPAN));
+}
+
 /* --- Util --- */
 
 const char* grpc_get_ssl_cipher_suites(void) {
@@ -95,6 +152,24 @@ const char* grpc_get_ssl_cipher_suites(void) {
   return cipher_suites;
 }
 
+tsi_ssl_session_ticket_keys* grpc_ssl_server_session_ticket_keys(void) {
+  gpr_once_init(&session_ticket_keys_once, init_session_ticket_keys);
+  return session_ticket_keys;
+}
+
+void grpc_ssl_server_session_ticket_keys_refresh(void) {
+  if (grpc_ssl_server_session_ticket_keys() == nullptr) return;
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_mu_lock(&session_ticket_keys_mu);
+  if (gpr_time_cmp(now, session_ticket_keys_next_load) >= 0) {
+    session_ticket_keys_next_load = gpr_time_add(
+        now, gpr_time_from_seconds(kSessionTicketKeysReloadIntervalSecs,
+                                   GPR_TIMESPAN));
+    load_session_ticket_keys_locked();
+  }
+  gpr_mu_unlock(&session_ticket_keys_mu);
+}
+
 tsi_client_certificate_request_type
 grpc_get_tsi_client_certificate_request_type(
     grpc_ssl_client_certificate_request_type grpc_request_type) {
@@ -293,6 +368,137 @@ void grpc_shallow_peer_destruct(tsi_peer* peer) {
   if (peer->properties != nullptr) gpr_free(peer->properties);
 }
 
+/* -- Shared client handshaker factories. -- */
+
+/* The most factories kept for sharing. Past it, the least recently used one
+   is dropped (staying alive as long as its users hold refs to it). */
+#define MAX_SHARED_CLIENT_HANDSHAKER_FACTORIES 64
+
+namespace {
+struct shared_client_handshaker_factory {
+  /* digest of the options the factory was created with */
+  uint8_t key[SHA256_DIGEST_LENGTH];
+  tsi_ssl_client_handshaker_factory* factory;
+  uint64_t last_used;
+};
+}  // namespace
+
+static gpr_once g_shared_factories_once = GPR_ONCE_INIT;
+static gpr_mu g_shared_factories_mu;
+static shared_client_handshaker_factory
+    g_shared_factories[MAX_SHARED_CLIENT_HANDSHAKER_FACTORIES];
+static size_t g_num_shared_factories;
+static uint64_t g_shared_factories_clock;
+
+static void init_shared_factories(void) {
+  gpr_mu_init(&g_shared_factories_mu);
+}
+
+/* Hashes s, telling NULL apart from empty and each field from the next. */
+static void hash_option(SHA256_CTX* ctx, const char* s) {
+  const uint8_t present = s != nullptr;
+  const uint64_t length = s != nullptr ? strlen(s) : 0;
+  SHA256_Update(ctx, &present, sizeof(present));
+  SHA256_Update(ctx, &length, sizeof(length));
+  if (length > 0) SHA256_Update(ctx, s, length);
+}
+
+static void client_handshaker_options_key(
+    const tsi_ssl_client_handshaker_options* options, uint8_t* key) {
+  SHA256_CTX ctx;
+  SHA256_Init(&ctx);
+  /* The default root store lives as long as the process, so its address
+     identifies it. Where the SSL library uses it, the PEM roots are ignored,
+     so there is no need to read them (the default ones may be mapped from
+     disk, see grpc_lazy_system_ssl_roots). */
+  SHA256_Update(&ctx, &options->root_store, sizeof(options->root_store));
+  if (OPENSSL_VERSION_NUMBER < 0x10100000 || options->root_store == nullptr) {
+    hash_option(&ctx, options->pem_root_certs);
+  }
+  hash_option(&ctx, options->pem_key_cert_pair == nullptr
+                        ? nullptr
+                        : options->pem_key_cert_pair->private_key);
+  hash_option(&ctx, options->pem_key_cert_pair == nullptr
+                        ? nullptr
+                        : options->pem_key_cert_pair->cert_chain);
+  hash_option(&ctx, options->cipher_suites);
+  const uint64_t num_alpn_protocols = options->num_alpn_protocols;
+  SHA256_Update(&ctx, &num_alpn_protocols, sizeof(num_alpn_protocols));
+  for (size_t i = 0; i < options->num_alpn_protocols; i++) {
+    hash_option(&ctx, options->alpn_protocols[i]);
+  }
+  SHA256_Final(key, &ctx);
+}
+
+/* Returns a new ref to the factory shared under key, or nullptr. Called with
+   g_shared_factories_mu held. */
+static tsi_ssl_client_handshaker_factory* find_shared_factory_locked(
+    const uint8_t* key) {
+  for (size_t i = 0; i < g_num_shared_factories; i++) {
+    if (memcmp(g_shared_factories[i].key, key, SHA256_DIGEST_LENGTH) == 0) {
+      g_shared_factories[i].last_used = ++g_shared_factories_clock;
+      return tsi_ssl_client_handshaker_factory_ref(
+          g_shared_factories[i].factory);
+    }
+  }
+  return nullptr;
+}
+
+/* Shares factory under key, taking a ref to it. Called with
+   g_shared_factories_mu held. */
+static void add_shared_factory_locked(
+    const uint8_t* key, tsi_ssl_client_handshaker_factory* factory) {
+  shared_client_handshaker_factory* entry;
+  if (g_num_shared_factories < MAX_SHARED_CLIENT_HANDSHAKER_FACTORIES) {
+    entry = &g_shared_factories[g_num_shared_factories++];
+  } else {
+    entry = &g_shared_factories[0];
+    for (size_t i = 1; i < g_num_shared_factories; i++) {
+      if (g_shared_factories[i].last_used < entry->last_used) {
+        entry = &g_shared_factories[i];
+      }
+    }
+    tsi_ssl_client_handshaker_factory_unref(entry->factory);
+  }
+  memcpy(entry->key, key, SHA256_DIGEST_LENGTH);
+  entry->factory = tsi_ssl_client_handshaker_factory_ref(factory);
+  entry->last_used = ++g_shared_factories_clock;
+}
+
+tsi_result grpc_ssl_get_shared_client_handshaker_factory(
+    const tsi_ssl_client_handshaker_options* options,
+    tsi_ssl_client_handshaker_factory** factory) {
+  /* The session cache is owned by the application, which expects it to be
+     released with the channels using it. */
+  if (options->session_cache != nullptr) {
+    return tsi_create_ssl_client_handshaker_factory_with_options(options,
+                                                                 factory);
+  }
+  uint8_t key[SHA256_DIGEST_LENGTH];
+  client_handshaker_options_key(options, key);
+  gpr_once_init(&g_shared_factories_once, init_shared_factories);
+  gpr_mu_lock(&g_shared_factories_mu);
+  *factory = find_shared_factory_locked(key);
+  gpr_mu_unlock(&g_shared_factories_mu);
+  if (*factory != nullptr) return TSI_OK;
+  /* Parse the certificates without holding the lock. */
+  tsi_ssl_client_handshaker_factory* created = nullptr;
+  const tsi_result result =
+      tsi_create_ssl_client_handshaker_factory_with_options(options, &created);
+  if (result != TSI_OK) return result;
+  gpr_mu_lock(&g_shared_factories_mu);
+  *factory = find_shared_factory_locked(key);
+  if (*factory == nullptr) {
+    add_shared_factory_locked(key, created);
+    *factory = created;
+    created = nullptr;
+  }
+  gpr_mu_unlock(&g_shared_factories_mu);
+  /* Lost a race with an identical creation. */
+  tsi_ssl_client_handshaker_factory_unref(created);
+  return TSI_OK;
+}
+
 grpc_security_status grpc_ssl_tsi_client_handshaker_factory_init(
     tsi_ssl_pem_key_cert_pair* pem_key_cert_pair, const char* pem_root_certs,
     tsi_ssl_session_cache* ssl_session_cache,
@@ -325,9 +531,8 @@ grpc_security_status grpc_ssl_tsi_client_handshaker_factory_init(
   }
   options.cipher_suites = grpc_get_ssl_cipher_suites();
   options.session_cache = ssl_session_cache;
-  const tsi_result result =
-      tsi_create_ssl_client_handshaker_factory_with_options(&options,
-                                                            handshaker_factory);
+  const tsi_result result = grpc_ssl_get_shared_client_handshaker_factory(
+      &options, handshaker_factory);
   gpr_free((void*)options.alpn_protocols);
   if (result != TSI_OK) {
     gpr_log(GPR_ERROR, "Handshaker factory creation failed with %s.",
@@ -354,6 +559,9 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
   options.cipher_suites = grpc_get_ssl_cipher_suites();
   options.alpn_protocols = alpn_protocol_strings;
   options.num_alpn_protocols = static_cast<uint16_t>(num_alpn_protocols);
+  options.session_ticket_keys = session_ticket_keys != nullptr
+                                    ? session_ticket_keys
+                                    : grpc_ssl_server_session_ticket_keys();
   const tsi_result result =
       tsi_create_ssl_server_handshaker_factory_with_options(&options,
                                                             handshaker_factory);
@@ -414,6 +622,7 @@ namespace grpc_core {
 
 tsi_ssl_root_certs_store* DefaultSslRootStore::default_root_store_;
 grpc_slice DefaultSslRootStore::default_pem_root_certs_;
+bool DefaultSslRootStore::default_roots_from_system_;
 
 const tsi_ssl_root_certs_store* DefaultSslRootStore::GetRootStore() {
   InitRootStore();
@@ -453,8 +662,10 @@ grpc_slice DefaultSslRootStore::ComputePemRootCerts() {
     gpr_free(pem_root_certs);
   }
   // Try loading roots from OS trust store if flag is enabled.
+  default_roots_from_system_ = false;
   if (GRPC_SLICE_IS_EMPTY(result) && !not_use_system_roots) {
     result = LoadSystemRootCerts();
+    default_roots_from_system_ = !GRPC_SLICE_IS_EMPTY(result);
   }
   // Fallback to roots manually shipped with gRPC.
   if (GRPC_SLICE_IS_EMPTY(result) &&
@@ -472,7 +683,17 @@ void DefaultSslRootStore::InitRootStore() {
 
 void DefaultSslRootStore::InitRootStoreOnce() {
   default_pem_root_certs_ = ComputePemRootCerts();
-  if (!GRPC_SLICE_IS_EMPTY(default_pem_root_certs_)) {
+  if (GRPC_SLICE_IS_EMPTY(default_pem_root_certs_)) return;
+  // Rather than parsing every system root, load the ones handshakes need
+  // from the hashed directory they come from, if there is one.
+  if (default_roots_from_system_) {
+    UniquePtr<char> hashed_dir = GetSystemRootCertsHashedDir();
+    if (hashed_dir != nullptr) {
+      default_root_store_ =
+          tsi_ssl_root_certs_store_create_from_hashed_dir(hashed_dir.get());
+    }
+  }
+  if (default_root_store_ == nullptr) {
     default_root_store_ =
         tsi_ssl_root_certs_store_create(reinterpret_cast<const char*>(
             GRPC_SLICE_START_PTR(default_pem_root_certs_)));
@@ -64,6 +64,14 @@ bool grpc_ssl_check_call_host(grpc_core::StringView host,
 /* Return HTTP2-compliant cipher suites that gRPC accepts by default. */
 const char* grpc_get_ssl_cipher_suites(void);
 
+/* Return the session ticket keys that servers load from the file set by the
+   grpc_ssl_session_ticket_keys_file config, or nullptr if it is not set. */
+tsi_ssl_session_ticket_keys* grpc_ssl_server_session_ticket_keys(void);
+
+/* Re-read the session ticket keys file if it has not been read in a while.
+   Servers call this before each handshake. */
+void grpc_ssl_server_session_ticket_keys_refresh(void);
+
 /* Map from grpc_ssl_client_certificate_request_type to
  * tsi_client_certificate_request_type. */
 tsi_client_certificate_request_type
@@ -73,16 +81,29 @@ grpc_get_tsi_client_certificate_request_type(
 /* Return an array of strings containing alpn protocols. */
 const char** grpc_fill_alpn_protocol_strings(size_t* num_alpn_protocols);
 
+/* Like tsi_create_ssl_client_handshaker_factory_with_options(), but returns
+   the factory created for the same options (compared by content) by an
+   earlier call if it is still kept, so that channels with identical
+   credentials share one SSL context and root store rather than each parsing
+   the certificates again. The caller owns a ref to the returned factory.
+   Factories with a session cache are never shared. */
+tsi_result grpc_ssl_get_shared_client_handshaker_factory(
+    const tsi_ssl_client_handshaker_options* options,
+    tsi_ssl_client_handshaker_factory** factory);
+
 /* Initialize TSI SSL server/client handshaker factory. */
 grpc_security_status grpc_ssl_tsi_client_handshaker_factory_init(
     tsi_ssl_pem_key_cert_pair* key_cert_pair, const char* pem_root_certs,
     tsi_ssl_session_cache* ssl_session_cache,
     tsi_ssl_client_handshaker_factory** handshaker_factory);
 
+/* session_ticket_keys, if not null, is used instead of the keys loaded from
+   the grpc_ssl_session_ticket_keys_file config. */
 grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
     tsi_ssl_pem_key_cert_pair* key_cert_pairs, size_t num_key_cert_pairs,
     const char* pem_root_certs,
     grpc_ssl_client_certificate_request_type client_certificate_request,
+    tsi_ssl_session_ticket_keys* session_ticket_keys,
     tsi_ssl_server_handshaker_factory** handshaker_factory);
 
 /* Exposed for testing only. */
@@ -126,6 +147,9 @@ class DefaultSslRootStore {
 
   // Default PEM root certificates.
   static grpc_slice default_pem_root_certs_;
+
+  // Whether the default PEM root certificates come from the OS trust store.
+  static bool default_roots_from_system_;
 };
 
 class PemKeyCertPair {
@@ -27,8 +27,10 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <openssl/rand.h>
 
 #include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/security/credentials/ssl/ssl_credentials.h"
 #include "src/core/lib/security/credentials/tls/spiffe_credentials.h"
 #include "src/core/lib/security/security_connector/ssl_utils.h"
@@ -131,6 +133,9 @@ SpiffeChannelSecurityConnector::~SpiffeChannelSecurityConnector() {
   if (client_handshaker_factory_ != nullptr) {
     tsi_ssl_client_handshaker_factory_unref(client_handshaker_factory_);
   }
+  if (ssl_session_cache_ != nullptr) {
+    tsi_ssl_session_cache_unref(ssl_session_cache_);
+  }
   if (key_materials_config_.get() != nullptr) {
     key_materials_config_.get()->Unref();
   }
@@ -140,17 +145,17 @@ SpiffeChannelSecurityConnector::~SpiffeChannelSecurityConnector() {
 void SpiffeChannelSecurityConnector::add_handshakers(
     grpc_pollset_set* interested_parties,
     grpc_core::HandshakeManager* handshake_mgr) {
-  if (RefreshHandshakerFactory() != GRPC_SECURITY_OK) {
-    gpr_log(GPR_ERROR, "Handshaker factory refresh failed.");
-    return;
-  }
+  // Credentials are reloaded in the background: this handshake uses the
+  // factory built from the current ones.
+  tsi_ssl_client_handshaker_factory* factory = GetHandshakerFactory();
   // Instantiate TSI handshaker.
   tsi_handshaker* tsi_hs = nullptr;
   tsi_result result = tsi_ssl_client_handshaker_factory_create_handshaker(
-      client_handshaker_factory_,
+      factory,
       overridden_target_name_ != nullptr ? overridden_target_name_.get()
                                          : target_name_.get(),
       &tsi_hs);
+  tsi_ssl_client_handshaker_factory_unref(factory);
   if (result != TSI_OK) {
     gpr_log(GPR_ERROR, "Handshaker creation failed with error %s.",
             tsi_result_to_string(result));
@@ -268,27 +273,70 @@ SpiffeChannelSecurityConnector::CreateSpiffeChannelSecurityConnector(
   return c;
 }
 
-grpc_security_status SpiffeChannelSecurityConnector::ReplaceHandshakerFactory(
-    tsi_ssl_session_cache* ssl_session_cache) {
-  /* Free the client handshaker factory if exists. */
-  if (client_handshaker_factory_) {
-    tsi_ssl_client_handshaker_factory_unref(client_handshaker_factory_);
-  }
+grpc_security_status
+SpiffeChannelSecurityConnector::ReplaceHandshakerFactory() {
   GPR_ASSERT(!key_materials_config_->pem_key_cert_pair_list().empty());
   tsi_ssl_pem_key_cert_pair* pem_key_cert_pair = ConvertToTsiPemKeyCertPair(
       key_materials_config_->pem_key_cert_pair_list());
+  tsi_ssl_client_handshaker_factory* factory = nullptr;
   grpc_security_status status = grpc_ssl_tsi_client_handshaker_factory_init(
       pem_key_cert_pair, key_materials_config_->pem_root_certs(),
-      ssl_session_cache, &client_handshaker_factory_);
+      ssl_session_cache_, &factory);
   /* Free memory. */
   grpc_tsi_ssl_pem_key_cert_pairs_destroy(pem_key_cert_pair, 1);
-  return status;
+  if (status != GRPC_SECURITY_OK) {
+    /* Keep using the existing factory. */
+    return status;
+  }
+  tsi_ssl_client_handshaker_factory* old_factory;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    old_factory = client_handshaker_factory_;
+    client_handshaker_factory_ = factory;
+    key_materials_config_->set_version(key_materials_config_->version() + 1);
+  }
+  if (old_factory != nullptr) {
+    tsi_ssl_client_handshaker_factory_unref(old_factory);
+  }
+  return GRPC_SECURITY_OK;
+}
+
+tsi_ssl_client_handshaker_factory*
+SpiffeChannelSecurityConnector::GetHandshakerFactory() {
+  const SpiffeCredentials* creds =
+      static_cast<const SpiffeCredentials*>(channel_creds());
+  grpc_core::MutexLock lock(&mu_);
+  if (creds->options().credential_reload_config() != nullptr &&
+      !reload_pending_) {
+    reload_pending_ = true;
+    /* The reload holds a ref to the connector until it is done. */
+    Ref().release();
+    GRPC_CLOSURE_SCHED(
+        GRPC_CLOSURE_INIT(&reload_closure_, ReloadCredentials, this,
+                          grpc_core::Executor::Scheduler(
+                              grpc_core::ExecutorJobType::SHORT)),
+        GRPC_ERROR_NONE);
+  }
+  return tsi_ssl_client_handshaker_factory_ref(client_handshaker_factory_);
+}
+
+void SpiffeChannelSecurityConnector::ReloadCredentials(void* arg,
+                                                       grpc_error* error) {
+  SpiffeChannelSecurityConnector* self =
+      static_cast<SpiffeChannelSecurityConnector*>(arg);
+  if (self->RefreshHandshakerFactory() != GRPC_SECURITY_OK) {
+    gpr_log(GPR_ERROR, "Handshaker factory refresh failed.");
+  }
+  {
+    grpc_core::MutexLock lock(&self->mu_);
+    self->reload_pending_ = false;
+  }
+  self->Unref();
 }
 
 grpc_security_status
 SpiffeChannelSecurityConnector::InitializeHandshakerFactory(
     tsi_ssl_session_cache* ssl_session_cache) {
-  grpc_core::MutexLock lock(&mu_);
   const SpiffeCredentials* creds =
       static_cast<const SpiffeCredentials*>(channel_creds());
   grpc_tls_key_materials_config* key_materials_config =
@@ -309,12 +357,19 @@ SpiffeChannelSecurityConnector::InitializeHandshakerFactory(
     /* Raise an error if key materials are not populated. */
     return GRPC_SECURITY_ERROR;
   }
-  return ReplaceHandshakerFactory(ssl_session_cache);
+  if (ssl_session_cache != nullptr) {
+    tsi_ssl_session_cache_ref(ssl_session_cache);
+    ssl_session_cache_ = ssl_session_cache;
+  }
+  return ReplaceHandshakerFactory();
 }
 
+/* Only ever runs on one thread at a time: on the creating one before the
+ * connector is shared, then in ReloadCredentials(), which is never scheduled
+ * while it is pending. mu_ is only held to swap the factories, so that
+ * handshakes do not wait for the credential reload. */
 grpc_security_status
 SpiffeChannelSecurityConnector::RefreshHandshakerFactory() {
-  grpc_core::MutexLock lock(&mu_);
   const SpiffeCredentials* creds =
       static_cast<const SpiffeCredentials*>(channel_creds());
   grpc_ssl_certificate_config_reload_status reload_status =
@@ -327,7 +382,7 @@ SpiffeChannelSecurityConnector::RefreshHandshakerFactory() {
     // Re-use existing handshaker factory.
     return GRPC_SECURITY_OK;
   } else {
-    return ReplaceHandshakerFactory(nullptr);
+    return ReplaceHandshakerFactory();
   }
 }
 
@@ -400,12 +455,32 @@ SpiffeServerSecurityConnector::SpiffeServerSecurityConnector(
     : grpc_server_security_connector(GRPC_SSL_URL_SCHEME,
                                      std::move(server_creds)) {
   key_materials_config_ = grpc_tls_key_materials_config_create()->Ref();
+  session_ticket_keys_ = grpc_ssl_server_session_ticket_keys();
+  if (session_ticket_keys_ != nullptr) {
+    tsi_ssl_session_ticket_keys_ref(session_ticket_keys_);
+  } else {
+    /* Servers do not share keys through the grpc_ssl_session_ticket_keys_file
+     * config: use a random one for the lifetime of the connector rather than
+     * the one each factory would generate for itself. */
+    unsigned char key[TSI_SSL_SESSION_TICKET_KEY_SIZE];
+    session_ticket_keys_ = tsi_ssl_session_ticket_keys_create();
+    if (RAND_bytes(key, sizeof(key)) != 1 ||
+        tsi_ssl_session_ticket_keys_set(session_ticket_keys_, key,
+                                        sizeof(key)) != TSI_OK) {
+      gpr_log(GPR_ERROR, "Could not generate session ticket keys.");
+      tsi_ssl_session_ticket_keys_unref(session_ticket_keys_);
+      session_ticket_keys_ = nullptr;
+    }
+  }
 }
 
 SpiffeServerSecurityConnector::~SpiffeServerSecurityConnector() {
   if (server_handshaker_factory_ != nullptr) {
     tsi_ssl_server_handshaker_factory_unref(server_handshaker_factory_);
   }
+  if (session_ticket_keys_ != nullptr) {
+    tsi_ssl_session_ticket_keys_unref(session_ticket_keys_);
+  }
   if (key_materials_config_.get() != nullptr) {
     key_materials_config_.get()->Unref();
   }
@@ -414,15 +489,15 @@ SpiffeServerSecurityConnector::~SpiffeServerSecurityConnector() {
 void SpiffeServerSecurityConnector::add_handshakers(
     grpc_pollset_set* interested_parties,
     grpc_core::HandshakeManager* handshake_mgr) {
-  /* Refresh handshaker factory if needed. */
-  if (RefreshHandshakerFactory() != GRPC_SECURITY_OK) {
-    gpr_log(GPR_ERROR, "Handshaker factory refresh failed.");
-    return;
-  }
+  /* Credentials are reloaded in the background: this handshake uses the
+   * factory built from the current ones. */
+  tsi_ssl_server_handshaker_factory* factory = GetHandshakerFactory();
+  grpc_ssl_server_session_ticket_keys_refresh();
   /* Create a TLS SPIFFE TSI handshaker for server. */
   tsi_handshaker* tsi_hs = nullptr;
-  tsi_result result = tsi_ssl_server_handshaker_factory_create_handshaker(
-      server_handshaker_factory_, &tsi_hs);
+  tsi_result result =
+      tsi_ssl_server_handshaker_factory_create_handshaker(factory, &tsi_hs);
+  tsi_ssl_server_handshaker_factory_unref(factory);
   if (result != TSI_OK) {
     gpr_log(GPR_ERROR, "Handshaker creation failed with error %s.",
             tsi_result_to_string(result));
@@ -469,28 +544,71 @@ SpiffeServerSecurityConnector::CreateSpiffeServerSecurityConnector(
 grpc_security_status SpiffeServerSecurityConnector::ReplaceHandshakerFactory() {
   const SpiffeServerCredentials* creds =
       static_cast<const SpiffeServerCredentials*>(server_creds());
-  /* Free the server handshaker factory if exists. */
-  if (server_handshaker_factory_) {
-    tsi_ssl_server_handshaker_factory_unref(server_handshaker_factory_);
-  }
   GPR_ASSERT(!key_materials_config_->pem_key_cert_pair_list().empty());
   tsi_ssl_pem_key_cert_pair* pem_key_cert_pairs = ConvertToTsiPemKeyCertPair(
       key_materials_config_->pem_key_cert_pair_list());
   size_t num_key_cert_pairs =
       key_materials_config_->pem_key_cert_pair_list().size();
+  tsi_ssl_server_handshaker_factory* factory = nullptr;
   grpc_security_status status = grpc_ssl_tsi_server_handshaker_factory_init(
       pem_key_cert_pairs, num_key_cert_pairs,
       key_materials_config_->pem_root_certs(),
-      creds->options().cert_request_type(), &server_handshaker_factory_);
+      creds->options().cert_request_type(), session_ticket_keys_, &factory);
   /* Free memory. */
   grpc_tsi_ssl_pem_key_cert_pairs_destroy(pem_key_cert_pairs,
                                           num_key_cert_pairs);
-  return status;
+  if (status != GRPC_SECURITY_OK) {
+    /* Keep using the existing factory. */
+    return status;
+  }
+  tsi_ssl_server_handshaker_factory* old_factory;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    old_factory = server_handshaker_factory_;
+    server_handshaker_factory_ = factory;
+    key_materials_config_->set_version(key_materials_config_->version() + 1);
+  }
+  if (old_factory != nullptr) {
+    tsi_ssl_server_handshaker_factory_unref(old_factory);
+  }
+  return GRPC_SECURITY_OK;
+}
+
+tsi_ssl_server_handshaker_factory*
+SpiffeServerSecurityConnector::GetHandshakerFactory() {
+  const SpiffeServerCredentials* creds =
+      static_cast<const SpiffeServerCredentials*>(server_creds());
+  grpc_core::MutexLock lock(&mu_);
+  if (creds->options().credential_reload_config() != nullptr &&
+      !reload_pending_) {
+    reload_pending_ = true;
+    /* The reload holds a ref to the connector until it is done. */
+    Ref().release();
+    GRPC_CLOSURE_SCHED(
+        GRPC_CLOSURE_INIT(&reload_closure_, ReloadCredentials, this,
+                          grpc_core::Executor::Scheduler(
+                              grpc_core::ExecutorJobType::SHORT)),
+        GRPC_ERROR_NONE);
+  }
+  return tsi_ssl_server_handshaker_factory_ref(server_handshaker_factory_);
+}
+
+void SpiffeServerSecurityConnector::ReloadCredentials(void* arg,
+                                                      grpc_error* error) {
+  SpiffeServerSecurityConnector* self =
+      static_cast<SpiffeServerSecurityConnector*>(arg);
+  if (self->RefreshHandshakerFactory() != GRPC_SECURITY_OK) {
+    gpr_log(GPR_ERROR, "Handshaker factory refresh failed.");
+  }
+  {
+    grpc_core::MutexLock lock(&self->mu_);
+    self->reload_pending_ = false;
+  }
+  self->Unref();
 }
 
 grpc_security_status
 SpiffeServerSecurityConnector::InitializeHandshakerFactory() {
-  grpc_core::MutexLock lock(&mu_);
   const SpiffeServerCredentials* creds =
       static_cast<const SpiffeServerCredentials*>(server_creds());
   grpc_tls_key_materials_config* key_materials_config =
@@ -513,8 +631,8 @@ SpiffeServerSecurityConnector::InitializeHandshakerFactory() {
   return ReplaceHandshakerFactory();
 }
 
+/* Only ever runs on one thread at a time, see the channel connector. */
 grpc_security_status SpiffeServerSecurityConnector::RefreshHandshakerFactory() {
-  grpc_core::MutexLock lock(&mu_);
   const SpiffeServerCredentials* creds =
       static_cast<const SpiffeServerCredentials*>(server_creds());
   grpc_ssl_certificate_config_reload_status reload_status =
@@ -22,6 +22,7 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_credentials_options.h"
 
@@ -69,10 +70,19 @@ class SpiffeChannelSecurityConnector final
   grpc_security_status InitializeHandshakerFactory(
       tsi_ssl_session_cache* ssl_session_cache);
 
-  // A util function to create a new client handshaker factory to replace
-  // the existing one if exists.
-  grpc_security_status ReplaceHandshakerFactory(
-      tsi_ssl_session_cache* ssl_session_cache);
+  // A util function to create a new client handshaker factory from the
+  // current key materials and swap it in for the existing one if exists.
+  // Handshakers created from the old factory keep it alive until they are
+  // done.
+  grpc_security_status ReplaceHandshakerFactory();
+
+  // Returns a ref to the current client handshaker factory, scheduling a
+  // credential reload on the executor unless one is already pending.
+  tsi_ssl_client_handshaker_factory* GetHandshakerFactory();
+
+  // Executor callback running RefreshHandshakerFactory() off the handshake
+  // path.
+  static void ReloadCredentials(void* arg, grpc_error* error);
 
   // gRPC-provided callback executed by application, which servers to bring the
   // control back to gRPC core.
@@ -95,11 +105,17 @@ class SpiffeChannelSecurityConnector final
   // credential.
   grpc_security_status RefreshHandshakerFactory();
 
+  // Guards client_handshaker_factory_ and reload_pending_.
   grpc_core::Mutex mu_;
   grpc_closure* on_peer_checked_;
   grpc_core::UniquePtr<char> target_name_;
   grpc_core::UniquePtr<char> overridden_target_name_;
   tsi_ssl_client_handshaker_factory* client_handshaker_factory_ = nullptr;
+  // Reused by every factory, so that sessions stay resumable across
+  // credential reloads.
+  tsi_ssl_session_cache* ssl_session_cache_ = nullptr;
+  bool reload_pending_ = false;
+  grpc_closure reload_closure_;
   grpc_tls_server_authorization_check_arg* check_arg_;
   grpc_core::RefCountedPtr<grpc_tls_key_materials_config> key_materials_config_;
 };
@@ -130,16 +146,32 @@ class SpiffeServerSecurityConnector final
   // Initialize SSL TSI server handshaker factory.
   grpc_security_status InitializeHandshakerFactory();
 
-  // A util function to create a new server handshaker factory to replace the
-  // existing once if exists.
+  // A util function to create a new server handshaker factory from the
+  // current key materials and swap it in for the existing one if exists.
+  // Handshakers created from the old factory keep it alive until they are
+  // done.
   grpc_security_status ReplaceHandshakerFactory();
 
   // A util function to refresh SSL TSI server handshaker factory with a valid
   // credential.
   grpc_security_status RefreshHandshakerFactory();
 
+  // Returns a ref to the current server handshaker factory, scheduling a
+  // credential reload on the executor unless one is already pending.
+  tsi_ssl_server_handshaker_factory* GetHandshakerFactory();
+
+  // Executor callback running RefreshHandshakerFactory() off the handshake
+  // path.
+  static void ReloadCredentials(void* arg, grpc_error* error);
+
+  // Guards server_handshaker_factory_ and reload_pending_.
   grpc_core::Mutex mu_;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory_ = nullptr;
+  // Session ticket keys shared by every factory, so that sessions stay
+  // resumable across credential reloads.
+  tsi_ssl_session_ticket_keys* session_ticket_keys_ = nullptr;
+  bool reload_pending_ = false;
+  grpc_closure reload_closure_;
   grpc_core::RefCountedPtr<grpc_tls_key_materials_config> key_materials_config_;
 };
 
@@ -31,16 +31,34 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
+#include "src/core/tsi/ssl_transport_security.h"
 #include "src/core/tsi/transport_security_grpc.h"
 
+#ifdef GRPC_LINUX_KTLS
+#include <errno.h>
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif /* GRPC_LINUX_KTLS */
+
 #define STAGING_BUFFER_SIZE 8192
 
 static void on_read(void* user_data, grpc_error* error);
@@ -88,6 +106,7 @@ struct secure_endpoint {
   /* saved upper level callbacks and user_data. */
   grpc_closure* read_cb = nullptr;
   grpc_closure* write_cb = nullptr;
+  void* write_arg = nullptr;
   grpc_closure on_read;
   grpc_slice_buffer* read_buffer = nullptr;
   grpc_slice_buffer source_buffer;
@@ -97,6 +116,12 @@ struct secure_endpoint {
   grpc_slice read_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
   grpc_slice write_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
   grpc_slice_buffer output_buffer;
+  /* the kernel encrypts what is written, see
+     grpc_secure_endpoint_offload_writes_to_kernel() */
+  bool kernel_tls_writes = false;
+  /* seals and unseals records for zero_copy_protector, see
+     grpc_secure_endpoint_set_crypto_offload_engine() */
+  tsi_crypto_offload_engine* offload_engine = nullptr;
 
   gpr_refcount ref;
 };
@@ -169,6 +194,33 @@ static void call_read_cb(secure_endpoint* ep, grpc_error* error) {
   SECURE_ENDPOINT_UNREF(ep, "read");
 }
 
+static void finish_read(secure_endpoint* ep, tsi_result result) {
+  /* TODO(yangg) experiment with moving this block after read_cb to see if it
+     helps latency */
+  grpc_slice_buffer_reset_and_unref_internal(&ep->source_buffer);
+
+  if (result != TSI_OK) {
+    grpc_slice_buffer_reset_and_unref_internal(ep->read_buffer);
+    call_read_cb(
+        ep, grpc_set_tsi_error_result(
+                GRPC_ERROR_CREATE_FROM_STATIC_STRING("Unwrap failed"), result));
+    return;
+  }
+
+  call_read_cb(ep, GRPC_ERROR_NONE);
+}
+
+/* The engine may complete from a thread of its own, without an exec_ctx. */
+static void on_offload_unprotected(void* user_data, tsi_result result) {
+  secure_endpoint* ep = static_cast<secure_endpoint*>(user_data);
+  if (grpc_core::ExecCtx::Get() != nullptr) {
+    finish_read(ep, result);
+    return;
+  }
+  grpc_core::ExecCtx exec_ctx;
+  finish_read(ep, result);
+}
+
 static void on_read(void* user_data, grpc_error* error) {
   unsigned i;
   uint8_t keep_looping = 0;
@@ -184,7 +236,13 @@ static void on_read(void* user_data, grpc_error* error) {
     return;
   }
 
-  if (ep->zero_copy_protector != nullptr) {
+  if (ep->zero_copy_protector != nullptr && ep->offload_engine != nullptr) {
+    // Have the offload engine unprotect, finishing the read when it is done.
+    tsi_crypto_offload_engine_unprotect(
+        ep->offload_engine, ep->zero_copy_protector, &ep->source_buffer,
+        ep->read_buffer, on_offload_unprotected, ep);
+    return;
+  } else if (ep->zero_copy_protector != nullptr) {
     // Use zero-copy grpc protector to unprotect.
     result = tsi_zero_copy_grpc_protector_unprotect(
         ep->zero_copy_protector, &ep->source_buffer, ep->read_buffer);
@@ -239,19 +297,7 @@ static void on_read(void* user_data, grpc_error* error) {
     }
   }
 
-  /* TODO(yangg) experiment with moving this block after read_cb to see if it
-     helps latency */
-  grpc_slice_buffer_reset_and_unref_internal(&ep->source_buffer);
-
-  if (result != TSI_OK) {
-    grpc_slice_buffer_reset_and_unref_internal(ep->read_buffer);
-    call_read_cb(
-        ep, grpc_set_tsi_error_result(
-                GRPC_ERROR_CREATE_FROM_STATIC_STRING("Unwrap failed"), result));
-    return;
-  }
-
-  call_read_cb(ep, GRPC_ERROR_NONE);
+  finish_read(ep, result);
 }
 
 static void endpoint_read(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
@@ -280,6 +326,38 @@ static void flush_write_staging_buffer(secure_endpoint* ep, uint8_t** cur,
   *end = GRPC_SLICE_END_PTR(ep->write_staging_buffer);
 }
 
+static void finish_write(secure_endpoint* ep, tsi_result result,
+                         grpc_closure* cb, void* arg) {
+  if (result != TSI_OK) {
+    /* TODO(yangg) do different things according to the error type? */
+    grpc_slice_buffer_reset_and_unref_internal(&ep->output_buffer);
+    GRPC_CLOSURE_SCHED(
+        cb, grpc_set_tsi_error_result(
+                GRPC_ERROR_CREATE_FROM_STATIC_STRING("Wrap failed"), result));
+    return;
+  }
+
+  grpc_endpoint_write(ep->wrapped_ep, &ep->output_buffer, cb, arg);
+}
+
+static void finish_offloaded_write(secure_endpoint* ep, tsi_result result) {
+  grpc_closure* cb = ep->write_cb;
+  ep->write_cb = nullptr;
+  finish_write(ep, result, cb, ep->write_arg);
+  SECURE_ENDPOINT_UNREF(ep, "offload_write");
+}
+
+/* The engine may complete from a thread of its own, without an exec_ctx. */
+static void on_offload_protected(void* user_data, tsi_result result) {
+  secure_endpoint* ep = static_cast<secure_endpoint*>(user_data);
+  if (grpc_core::ExecCtx::Get() != nullptr) {
+    finish_offloaded_write(ep, result);
+    return;
+  }
+  grpc_core::ExecCtx exec_ctx;
+  finish_offloaded_write(ep, result);
+}
+
 static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
                            grpc_closure* cb, void* arg) {
   GPR_TIMER_SCOPE("secure_endpoint.endpoint_write", 0);
@@ -301,7 +379,22 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
     }
   }
 
-  if (ep->zero_copy_protector != nullptr) {
+  if (ep->kernel_tls_writes) {
+    grpc_endpoint_write(ep->wrapped_ep, slices, cb, arg);
+    return;
+  }
+
+  if (ep->zero_copy_protector != nullptr && ep->offload_engine != nullptr) {
+    // Have the offload engine protect, writing the frames when it is done.
+    ep->write_cb = cb;
+    ep->write_arg = arg;
+    SECURE_ENDPOINT_REF(ep, "offload_write");
+    tsi_crypto_offload_engine_protect(ep->offload_engine,
+                                      ep->zero_copy_protector, slices,
+                                      &ep->output_buffer, on_offload_protected,
+                                      ep);
+    return;
+  } else if (ep->zero_copy_protector != nullptr) {
     // Use zero-copy grpc protector to protect.
     result = tsi_zero_copy_grpc_protector_protect(ep->zero_copy_protector,
                                                   slices, &ep->output_buffer);
@@ -360,16 +453,7 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
     }
   }
 
-  if (result != TSI_OK) {
-    /* TODO(yangg) do different things according to the error type? */
-    grpc_slice_buffer_reset_and_unref_internal(&ep->output_buffer);
-    GRPC_CLOSURE_SCHED(
-        cb, grpc_set_tsi_error_result(
-                GRPC_ERROR_CREATE_FROM_STATIC_STRING("Wrap failed"), result));
-    return;
-  }
-
-  grpc_endpoint_write(ep->wrapped_ep, &ep->output_buffer, cb, arg);
+  finish_write(ep, result, cb, arg);
 }
 
 static void endpoint_shutdown(grpc_endpoint* secure_ep, grpc_error* why) {
@@ -421,6 +505,17 @@ static bool endpoint_can_track_err(grpc_endpoint* secure_ep) {
   return grpc_endpoint_can_track_err(ep->wrapped_ep);
 }
 
+static void endpoint_set_read_hint(grpc_endpoint* secure_ep, size_t bytes) {
+  secure_endpoint* ep = reinterpret_cast<secure_endpoint*>(secure_ep);
+  grpc_endpoint_set_read_hint(ep->wrapped_ep, bytes);
+}
+
+static void endpoint_set_write_hint(grpc_endpoint* secure_ep,
+                                    bool more_writes_follow) {
+  secure_endpoint* ep = reinterpret_cast<secure_endpoint*>(secure_ep);
+  grpc_endpoint_set_write_hint(ep->wrapped_ep, more_writes_follow);
+}
+
 static const grpc_endpoint_vtable vtable = {endpoint_read,
                                             endpoint_write,
                                             endpoint_add_to_pollset,
@@ -431,7 +526,9 @@ static const grpc_endpoint_vtable vtable = {endpoint_read,
                                             endpoint_get_resource_user,
                                             endpoint_get_peer,
                                             endpoint_get_fd,
-                                            endpoint_can_track_err};
+                                            endpoint_can_track_err,
+                                            endpoint_set_read_hint,
+                                            endpoint_set_write_hint};
 
 grpc_endpoint* grpc_secure_endpoint_create(
     struct tsi_frame_protector* protector,
@@ -443,3 +540,107 @@ grpc_endpoint* grpc_secure_endpoint_create(
       leftover_nslices);
   return &ep->base;
 }
+
+#ifdef GRPC_LINUX_KTLS
+/* Configures TLS_TX on fd from keys; false if the kernel refuses */
+static bool set_kernel_tls_tx(int fd, const tsi_ssl_kernel_tls_keys& keys) {
+  if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+    gpr_log(GPR_INFO, "kTLS unavailable: TCP_ULP failed errno=%d", errno);
+    return false;
+  }
+  /* The explicit nonce of each record is its sequence number, as in the
+     protector, so the kernel continues both from the next sequence number. */
+  int rc = -1;
+  if (keys.key_size == 16) {
+    struct tls12_crypto_info_aes_gcm_128 info;
+    memset(&info, 0, sizeof(info));
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+    memcpy(info.key, keys.key, sizeof(info.key));
+    memcpy(info.salt, keys.salt, sizeof(info.salt));
+    memcpy(info.iv, keys.rec_seq, sizeof(info.iv));
+    memcpy(info.rec_seq, keys.rec_seq, sizeof(info.rec_seq));
+    rc = setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info));
+    memset(&info, 0, sizeof(info));
+#ifdef TLS_CIPHER_AES_GCM_256
+  } else if (keys.key_size == 32) {
+    struct tls12_crypto_info_aes_gcm_256 info;
+    memset(&info, 0, sizeof(info));
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+    memcpy(info.key, keys.key, sizeof(info.key));
+    memcpy(info.salt, keys.salt, sizeof(info.salt));
+    memcpy(info.iv, keys.rec_seq, sizeof(info.iv));
+    memcpy(info.rec_seq, keys.rec_seq, sizeof(info.rec_seq));
+    rc = setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info));
+    memset(&info, 0, sizeof(info));
+#endif /* TLS_CIPHER_AES_GCM_256 */
+  } else {
+    return false;
+  }
+  /* Without TLS_TX the tls ULP passes writes straight through, so failing
+     here leaves the socket usable by the userspace protector. */
+  if (rc != 0) {
+    gpr_log(GPR_INFO, "kTLS unavailable: TLS_TX failed errno=%d", errno);
+    return false;
+  }
+  return true;
+}
+#endif /* GRPC_LINUX_KTLS */
+
+bool grpc_secure_endpoint_offload_writes_to_kernel(grpc_endpoint* secure_ep) {
+#ifdef GRPC_LINUX_KTLS
+  secure_endpoint* ep = reinterpret_cast<secure_endpoint*>(secure_ep);
+  const int fd = grpc_endpoint_get_fd(ep->wrapped_ep);
+  if (fd < 0) return false;
+  tsi_ssl_kernel_tls_keys keys;
+  tsi_result result;
+  if (ep->zero_copy_protector != nullptr) {
+    result = tsi_ssl_zero_copy_grpc_protector_export_write_keys(
+        ep->zero_copy_protector, &keys);
+  } else {
+    gpr_mu_lock(&ep->protector_mu);
+    result = tsi_ssl_frame_protector_export_write_keys(ep->protector, &keys);
+    gpr_mu_unlock(&ep->protector_mu);
+  }
+  if (result != TSI_OK) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_secure_endpoint)) {
+      gpr_log(GPR_INFO, "SECENDP %p: keys not exportable for kTLS: %s", ep,
+              tsi_result_to_string(result));
+    }
+    return false;
+  }
+  const bool offloaded = set_kernel_tls_tx(fd, keys);
+  memset(&keys, 0, sizeof(keys));
+  if (!offloaded) return false;
+  ep->kernel_tls_writes = true;
+  return true;
+#else
+  return false;
+#endif /* GRPC_LINUX_KTLS */
+}
+
+void grpc_secure_endpoint_set_crypto_offload_engine(
+    grpc_endpoint* secure_ep, tsi_crypto_offload_engine* engine) {
+  secure_endpoint* ep = reinterpret_cast<secure_endpoint*>(secure_ep);
+  ep->offload_engine = engine;
+}
+
+static void* crypto_offload_engine_arg_copy(void* p) { return p; }
+
+static void crypto_offload_engine_arg_destroy(void* p) {}
+
+static int crypto_offload_engine_arg_cmp(void* p, void* q) {
+  return GPR_ICMP(p, q);
+}
+
+grpc_arg grpc_tsi_crypto_offload_engine_create_channel_arg(
+    tsi_crypto_offload_engine* engine) {
+  static const grpc_arg_pointer_vtable vtable = {
+      crypto_offload_engine_arg_copy,
+      crypto_offload_engine_arg_destroy,
+      crypto_offload_engine_arg_cmp,
+  };
+  return grpc_channel_arg_pointer_create(
+      const_cast<char*>(GRPC_ARG_TSI_CRYPTO_OFFLOAD_ENGINE), engine, &vtable);
+}
@@ -26,6 +26,18 @@
 
 struct tsi_frame_protector;
 struct tsi_zero_copy_grpc_protector;
+struct tsi_crypto_offload_engine;
+
+/* Channel arg (pointer to a tsi_crypto_offload_engine, which must outlive
+   every channel and server using it) handing the sealing and unsealing of
+   the records of secure connections to an offload engine. Only applies to
+   connections using zero-copy grpc protectors, such as SSL and ALTS ones. */
+#define GRPC_ARG_TSI_CRYPTO_OFFLOAD_ENGINE \
+  "grpc.internal.tsi_crypto_offload_engine"
+
+/* Creates a GRPC_ARG_TSI_CRYPTO_OFFLOAD_ENGINE channel arg for \a engine. */
+grpc_arg grpc_tsi_crypto_offload_engine_create_channel_arg(
+    struct tsi_crypto_offload_engine* engine);
 
 extern grpc_core::TraceFlag grpc_trace_secure_endpoint;
 
@@ -38,4 +50,18 @@ grpc_endpoint* grpc_secure_endpoint_create(
     grpc_endpoint* to_wrap, grpc_slice* leftover_slices,
     size_t leftover_nslices);
 
+/* Hands encryption of everything written to \a secure_ep from now on to the
+ * kernel (Linux kTLS), so that writes reach the wrapped endpoint as plaintext.
+ * Reads are still unprotected in userspace. Must be called before the first
+ * write. Returns false, changing nothing, if the protector cannot export its
+ * keys or the socket does not accept them. */
+bool grpc_secure_endpoint_offload_writes_to_kernel(grpc_endpoint* secure_ep);
+
+/* Has \a engine protect and unprotect the data of \a secure_ep, each read
+ * and write completing once the engine is done. Writes handed to the kernel
+ * do not use it. Ignored unless \a secure_ep has a zero-copy protector. Must
+ * be called before the first read or write. */
+void grpc_secure_endpoint_set_crypto_offload_engine(
+    grpc_endpoint* secure_ep, struct tsi_crypto_offload_engine* engine);
+
 #endif /* GRPC_CORE_LIB_SECURITY_TRANSPORT_SECURE_ENDPOINT_H */
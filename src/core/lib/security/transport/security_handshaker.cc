@@ -20,6 +20,7 @@
 
 #include "src/core/lib/security/transport/security_handshaker.h"
 
+#include <limits.h>
 #include <stdbool.h>
 #include <string.h>
 
@@ -30,7 +31,10 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/handshaker.h"
 #include "src/core/lib/channel/handshaker_registry.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/executor/threadpool.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
@@ -39,10 +43,45 @@
 
 #define GRPC_INITIAL_HANDSHAKE_BUFFER_SIZE 256
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_handshake_offload_threads, 0,
+    "Number of threads running TSI handshaker steps (the key exchange and "
+    "signature computations of TLS handshakes) away from the polling threads. "
+    "0 runs them inline.");
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_handshake_offload_max_queue, 1024,
+    "Number of handshaker steps that may wait for a handshake offload thread. "
+    "Steps started while the queue is full run inline.");
+
 namespace grpc_core {
 
 namespace {
 
+// Thread pool running TSI handshaker steps, created on first use and shut
+// down by grpc_shutdown(). Null if offloading is disabled.
+gpr_once g_offload_pool_once = GPR_ONCE_INIT;
+gpr_mu g_offload_pool_mu;
+bool g_offload_pool_initialized;
+ThreadPool* g_offload_pool;
+int g_offload_max_queue;
+
+void InitOffloadPoolMu() { gpr_mu_init(&g_offload_pool_mu); }
+
+ThreadPool* OffloadPool() {
+  gpr_once_init(&g_offload_pool_once, InitOffloadPoolMu);
+  MutexLock lock(&g_offload_pool_mu);
+  if (!g_offload_pool_initialized) {
+    g_offload_pool_initialized = true;
+    int32_t threads = GPR_GLOBAL_CONFIG_GET(grpc_handshake_offload_threads);
+    if (threads > 0) {
+      g_offload_max_queue =
+          GPR_MAX(GPR_GLOBAL_CONFIG_GET(grpc_handshake_offload_max_queue), 0);
+      g_offload_pool = New<ThreadPool>(threads, "handshake_offload");
+    }
+  }
+  return g_offload_pool;
+}
+
 class SecurityHandshaker : public Handshaker {
  public:
   SecurityHandshaker(tsi_handshaker* handshaker,
@@ -55,8 +94,19 @@ class SecurityHandshaker : public Handshaker {
   const char* name() const override { return "security"; }
 
  private:
+  // Handshaker step queued on the offload pool.
+  struct OffloadedNext : public grpc_experimental_completion_queue_functor {
+    SecurityHandshaker* handshaker;
+    const unsigned char* bytes_received;
+    size_t bytes_received_size;
+  };
+
   grpc_error* DoHandshakerNextLocked(const unsigned char* bytes_received,
                                      size_t bytes_received_size);
+  grpc_error* DoHandshakerNextInlineLocked(const unsigned char* bytes_received,
+                                           size_t bytes_received_size);
+  static void RunOffloadedNext(grpc_experimental_completion_queue_functor* cb,
+                               int ok);
 
   grpc_error* OnHandshakeNextDoneLocked(
       tsi_result result, const unsigned char* bytes_to_send,
@@ -95,6 +145,7 @@ class SecurityHandshaker : public Handshaker {
   grpc_closure on_handshake_data_sent_to_peer_;
   grpc_closure on_handshake_data_received_from_peer_;
   grpc_closure on_peer_checked_;
+  OffloadedNext offloaded_next_;
   RefCountedPtr<grpc_auth_context> auth_context_;
   tsi_handshaker_result* handshaker_result_ = nullptr;
 };
@@ -198,10 +249,14 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error* error) {
     HandshakeFailedLocked(error);
     return;
   }
+  // Get the frame size to use, if set.
+  size_t max_frame_size = static_cast<size_t>(grpc_channel_args_find_integer(
+      args_->args, GRPC_ARG_TSI_MAX_FRAME_SIZE, {0, 0, INT_MAX}));
+  size_t* max_frame_size_ptr = max_frame_size == 0 ? nullptr : &max_frame_size;
   // Create zero-copy frame protector, if implemented.
   tsi_zero_copy_grpc_protector* zero_copy_protector = nullptr;
   tsi_result result = tsi_handshaker_result_create_zero_copy_grpc_protector(
-      handshaker_result_, nullptr, &zero_copy_protector);
+      handshaker_result_, max_frame_size_ptr, &zero_copy_protector);
   if (result != TSI_OK && result != TSI_UNIMPLEMENTED) {
     error = grpc_set_tsi_error_result(
         GRPC_ERROR_CREATE_FROM_STATIC_STRING(
@@ -213,8 +268,8 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error* error) {
   // Create frame protector if zero-copy frame protector is NULL.
   tsi_frame_protector* protector = nullptr;
   if (zero_copy_protector == nullptr) {
-    result = tsi_handshaker_result_create_frame_protector(handshaker_result_,
-                                                          nullptr, &protector);
+    result = tsi_handshaker_result_create_frame_protector(
+        handshaker_result_, max_frame_size_ptr, &protector);
     if (result != TSI_OK) {
       error = grpc_set_tsi_error_result(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
                                             "Frame protector creation failed"),
@@ -239,6 +294,21 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error* error) {
     args_->endpoint = grpc_secure_endpoint_create(
         protector, zero_copy_protector, args_->endpoint, nullptr, 0);
   }
+  // Zerocopy sends are not supported on sockets doing kTLS.
+  if (grpc_channel_args_find_bool(args_->args, GRPC_ARG_SSL_KERNEL_TLS_WRITES,
+                                  false) &&
+      !grpc_channel_args_find_bool(args_->args,
+                                   GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED, false)) {
+    grpc_secure_endpoint_offload_writes_to_kernel(args_->endpoint);
+  }
+  const grpc_arg* offload_engine_arg =
+      grpc_channel_args_find(args_->args, GRPC_ARG_TSI_CRYPTO_OFFLOAD_ENGINE);
+  if (offload_engine_arg != nullptr &&
+      offload_engine_arg->type == GRPC_ARG_POINTER) {
+    grpc_secure_endpoint_set_crypto_offload_engine(
+        args_->endpoint, static_cast<tsi_crypto_offload_engine*>(
+                             offload_engine_arg->value.pointer.p));
+  }
   tsi_handshaker_result_destroy(handshaker_result_);
   handshaker_result_ = nullptr;
   // Add auth context to channel args.
@@ -331,6 +401,46 @@ void SecurityHandshaker::OnHandshakeNextDoneGrpcWrapper(
 
 grpc_error* SecurityHandshaker::DoHandshakerNextLocked(
     const unsigned char* bytes_received, size_t bytes_received_size) {
+  ThreadPool* pool = OffloadPool();
+  if (pool != nullptr) {
+    int queued = pool->num_pending_closures();
+    if (queued < g_offload_max_queue) {
+      GRPC_STATS_INC_HANDSHAKER_OFFLOAD_QUEUE_DEPTH(queued);
+      GRPC_STATS_INC_HANDSHAKER_NEXT_OFFLOADED();
+      // The caller's ref is passed on to RunOffloadedNext(). The handshake
+      // buffer is not touched until then, as no read is pending.
+      offloaded_next_.functor_run = &SecurityHandshaker::RunOffloadedNext;
+      offloaded_next_.handshaker = this;
+      offloaded_next_.bytes_received = bytes_received;
+      offloaded_next_.bytes_received_size = bytes_received_size;
+      pool->Add(&offloaded_next_);
+      return GRPC_ERROR_NONE;
+    }
+    GRPC_STATS_INC_HANDSHAKER_NEXT_OFFLOAD_QUEUE_FULL();
+  }
+  return DoHandshakerNextInlineLocked(bytes_received, bytes_received_size);
+}
+
+void SecurityHandshaker::RunOffloadedNext(
+    grpc_experimental_completion_queue_functor* cb, int ok) {
+  ExecCtx exec_ctx;
+  OffloadedNext* next = static_cast<OffloadedNext*>(cb);
+  RefCountedPtr<SecurityHandshaker> h(next->handshaker);
+  MutexLock lock(&h->mu_);
+  grpc_error* error =
+      h->is_shutdown_
+          ? GRPC_ERROR_CREATE_FROM_STATIC_STRING("Handshaker shutdown")
+          : h->DoHandshakerNextInlineLocked(next->bytes_received,
+                                            next->bytes_received_size);
+  if (error != GRPC_ERROR_NONE) {
+    h->HandshakeFailedLocked(error);
+  } else {
+    h.release();  // Avoid unref
+  }
+}
+
+grpc_error* SecurityHandshaker::DoHandshakerNextInlineLocked(
+    const unsigned char* bytes_received, size_t bytes_received_size) {
   // Invoke TSI handshaker.
   const unsigned char* bytes_to_send = nullptr;
   size_t bytes_to_send_size = 0;
@@ -506,6 +616,19 @@ void SecurityRegisterHandshakerFactories() {
       UniquePtr<HandshakerFactory>(New<ServerSecurityHandshakerFactory>()));
 }
 
+void SecurityHandshakerOffloadShutdown() {
+  gpr_once_init(&g_offload_pool_once, InitOffloadPoolMu);
+  ThreadPool* pool;
+  {
+    MutexLock lock(&g_offload_pool_mu);
+    pool = g_offload_pool;
+    g_offload_pool = nullptr;
+    g_offload_pool_initialized = false;
+  }
+  // Steps still queued run before the pool threads exit.
+  Delete(pool);
+}
+
 }  // namespace grpc_core
 
 grpc_handshaker* grpc_security_handshaker_create(
@@ -22,8 +22,12 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/channel/handshaker.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/security/security_connector/security_connector.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_handshake_offload_threads);
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_handshake_offload_max_queue);
+
 namespace grpc_core {
 
 /// Creates a security handshaker using \a handshaker.
@@ -33,6 +37,10 @@ RefCountedPtr<Handshaker> SecurityHandshakerCreate(
 /// Registers security handshaker factories.
 void SecurityRegisterHandshakerFactories();
 
+/// Shuts down the thread pool handshaker steps are offloaded to, if one was
+/// created. The next handshake creates it again.
+void SecurityHandshakerOffloadShutdown();
+
 }  // namespace grpc_core
 
 // TODO(arjunroy): This is transitional to account for the new handshaker API
@@ -25,6 +25,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -49,6 +50,21 @@ static const char base64_url_unsafe_chars[] =
 static const char base64_url_safe_chars[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
 
+/* The two characters for every 12 bit value, in each alphabet, so that a
+ * block is encoded with two lookups. */
+static char base64_url_unsafe_pairs[4096][2];
+static char base64_url_safe_pairs[4096][2];
+static gpr_once base64_pairs_once = GPR_ONCE_INIT;
+
+static void init_base64_pairs(void) {
+  for (size_t i = 0; i < 4096; i++) {
+    base64_url_unsafe_pairs[i][0] = base64_url_unsafe_chars[i >> 6];
+    base64_url_unsafe_pairs[i][1] = base64_url_unsafe_chars[i & 0x3F];
+    base64_url_safe_pairs[i][0] = base64_url_safe_chars[i >> 6];
+    base64_url_safe_pairs[i][1] = base64_url_safe_chars[i & 0x3F];
+  }
+}
+
 #define GRPC_BASE64_PAD_CHAR '='
 #define GRPC_BASE64_PAD_BYTE 0x7F
 #define GRPC_BASE64_MULTILINE_LINE_LEN 76
@@ -82,6 +98,9 @@ void grpc_base64_encode_core(char* result, const void* vdata, size_t data_size,
       url_safe ? base64_url_safe_chars : base64_url_unsafe_chars;
   const size_t result_projected_size =
       grpc_base64_estimate_encoded_size(data_size, url_safe, multiline);
+  gpr_once_init(&base64_pairs_once, init_base64_pairs);
+  const char(*base64_pairs)[2] =
+      url_safe ? base64_url_safe_pairs : base64_url_unsafe_pairs;
 
   char* current = result;
   size_t num_blocks = 0;
@@ -89,12 +108,12 @@ void grpc_base64_encode_core(char* result, const void* vdata, size_t data_size,
 
   /* Encode each block. */
   while (data_size >= 3) {
-    *current++ = base64_chars[(data[i] >> 2) & 0x3F];
-    *current++ =
-        base64_chars[((data[i] & 0x03) << 4) | ((data[i + 1] >> 4) & 0x0F)];
-    *current++ =
-        base64_chars[((data[i + 1] & 0x0F) << 2) | ((data[i + 2] >> 6) & 0x03)];
-    *current++ = base64_chars[data[i + 2] & 0x3F];
+    const uint32_t block = (static_cast<uint32_t>(data[i]) << 16) |
+                           (static_cast<uint32_t>(data[i + 1]) << 8) |
+                           data[i + 2];
+    memcpy(current, base64_pairs[block >> 12], 2);
+    memcpy(current + 2, base64_pairs[block & 0xFFF], 2);
+    current += 4;
 
     data_size -= 3;
     i += 3;
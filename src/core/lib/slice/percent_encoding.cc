@@ -20,6 +20,8 @@
 
 #include "src/core/lib/slice/percent_encoding.h"
 
+#include <string.h>
+
 #include <grpc/support/log.h>
 
 #include "src/core/lib/slice/slice_internal.h"
@@ -38,17 +40,44 @@ static bool is_unreserved_character(uint8_t c,
   return ((unreserved_bytes[c / 8] >> (c % 8)) & 1) != 0;
 }
 
+/* Returns the length of the longest prefix of [p, end) made of unreserved
+ * characters. The compatible set (the one used for grpc-message) is every
+ * printable character but '%', so it is checked eight bytes at a time. */
+static size_t unreserved_prefix_length(const uint8_t* p, const uint8_t* end,
+                                       const uint8_t* unreserved_bytes) {
+  const uint8_t* start = p;
+  if (unreserved_bytes == grpc_compatible_percent_encoding_unreserved_bytes) {
+    static const uint64_t kOnes = 0x0101010101010101;
+    static const uint64_t kHighBits = 0x8080808080808080;
+    while (end - p >= 8) {
+      uint64_t w;
+      memcpy(&w, p, sizeof(w));
+      const uint64_t pct = w ^ (kOnes * '%');
+      /* the high bit of a byte is set in each term if some byte of w is
+       * below ' ', above '~' or equal to '%' respectively */
+      const uint64_t below = (w - kOnes * ' ') & ~w;
+      const uint64_t above = (w + kOnes * (127 - '~')) | w;
+      const uint64_t percent = (pct - kOnes) & ~pct;
+      if (((below | above | percent) & kHighBits) != 0) break;
+      p += 8;
+    }
+  }
+  while (p < end && is_unreserved_character(*p, unreserved_bytes)) p++;
+  return static_cast<size_t>(p - start);
+}
+
 grpc_slice grpc_percent_encode_slice(const grpc_slice& slice,
                                      const uint8_t* unreserved_bytes) {
   static const uint8_t hex[] = "0123456789ABCDEF";
 
   // first pass: count the number of bytes needed to output this string
-  size_t output_length = 0;
   const uint8_t* slice_start = GRPC_SLICE_START_PTR(slice);
   const uint8_t* slice_end = GRPC_SLICE_END_PTR(slice);
+  size_t output_length =
+      unreserved_prefix_length(slice_start, slice_end, unreserved_bytes);
   const uint8_t* p;
   bool any_reserved_bytes = false;
-  for (p = slice_start; p < slice_end; p++) {
+  for (p = slice_start + output_length; p < slice_end; p++) {
     bool unres = is_unreserved_character(*p, unreserved_bytes);
     output_length += unres ? 1 : 3;
     any_reserved_bytes |= !unres;
@@ -91,8 +120,9 @@ bool grpc_strict_percent_decode_slice(const grpc_slice& slice_in,
                                       grpc_slice* slice_out) {
   const uint8_t* p = GRPC_SLICE_START_PTR(slice_in);
   const uint8_t* in_end = GRPC_SLICE_END_PTR(slice_in);
-  size_t out_length = 0;
+  size_t out_length = unreserved_prefix_length(p, in_end, unreserved_bytes);
   bool any_percent_encoded_stuff = false;
+  p += out_length;
   while (p != in_end) {
     if (*p == '%') {
       if (!valid_hex(++p, in_end)) return false;
@@ -22,10 +22,16 @@
 
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 
 #include <string.h>
 
+#include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -251,13 +257,15 @@ class MallocRefCount {
  public:
   static void Destroy(void* arg) {
     MallocRefCount* r = static_cast<MallocRefCount*>(arg);
+    const size_t alloc_size = r->alloc_size_;
     r->~MallocRefCount();
-    gpr_free(r);
+    gpr_subsystem_free(GPR_ALLOC_SUBSYSTEM_SLICES, r, alloc_size);
   }
 
-  MallocRefCount()
+  explicit MallocRefCount(size_t alloc_size)
       : base_(grpc_slice_refcount::Type::REGULAR, &refs_, Destroy, this,
-              &base_) {}
+              &base_),
+        alloc_size_(alloc_size) {}
   ~MallocRefCount() = default;
 
   grpc_slice_refcount* base_refcount() { return &base_; }
@@ -265,10 +273,191 @@ class MallocRefCount {
  private:
   grpc_slice_refcount base_;
   grpc_core::RefCount refs_;
+  // The size of the allocation holding this and the bytes, for a sized free.
+  const size_t alloc_size_;
+};
+
+/* The slab allocator keeps the blocks of freed slices of up to
+   kSlabMaxPayload bytes, in power of two size classes, for the next slices of
+   their class. Each CPU has its own cache of blocks; a cache that fills up
+   hands blocks to a central list shared by all CPUs, which an empty cache
+   takes blocks back from, so blocks freed on one CPU can be reused on
+   another. Caches are per CPU rather than per thread because thread locals
+   here have no hook to return their blocks when the thread exits. */
+constexpr size_t kSlabMinPayload = 64;
+constexpr size_t kSlabSizeClasses = 7;
+constexpr size_t kSlabMaxPayload = kSlabMinPayload << (kSlabSizeClasses - 1);
+/* The payload bytes each CPU cache, and the central list, keeps per class */
+constexpr size_t kSlabCacheBytes = 64 * 1024;
+constexpr size_t kSlabCacheMaxShards = 64;
+
+struct SlabFreeList {
+  void* head;
+  size_t count;
+};
+
+struct SlabCache {
+  gpr_spinlock lock;
+  SlabFreeList lists[kSlabSizeClasses];
+};
+
+union SlabShard {
+  SlabCache cache;
+  char padding[GPR_CACHELINE_SIZE *
+               ((sizeof(SlabCache) + GPR_CACHELINE_SIZE - 1) /
+                GPR_CACHELINE_SIZE)];
 };
 
+SlabShard g_slab_shards[kSlabCacheMaxShards];
+SlabCache g_slab_central;
+size_t g_slab_num_shards;
+gpr_atm g_slab_enabled;
+
+size_t slab_payload_size(size_t size_class) {
+  return kSlabMinPayload << size_class;
+}
+
+size_t slab_size_class(size_t length) {
+  size_t size_class = 0;
+  while (slab_payload_size(size_class) < length) ++size_class;
+  return size_class;
+}
+
+size_t slab_cache_limit(size_t size_class) {
+  return kSlabCacheBytes / slab_payload_size(size_class);
+}
+
+void* slab_pop(SlabFreeList* list) {
+  void* block = list->head;
+  list->head = *static_cast<void**>(block);
+  --list->count;
+  return block;
+}
+
+void slab_push(SlabFreeList* list, void* block) {
+  *static_cast<void**>(block) = list->head;
+  list->head = block;
+  ++list->count;
+}
+
+SlabCache* slab_current_cache() {
+  return &g_slab_shards[gpr_cpu_current_cpu() % g_slab_num_shards].cache;
+}
+
+/* Returns a cached block of the class, or null if there is none. */
+void* slab_alloc(size_t size_class) {
+  SlabCache* cache = slab_current_cache();
+  SlabFreeList* list = &cache->lists[size_class];
+  gpr_spinlock_lock(&cache->lock);
+  if (list->count == 0) {
+    /* Refill half of the cache from the central list. */
+    SlabFreeList* central = &g_slab_central.lists[size_class];
+    gpr_spinlock_lock(&g_slab_central.lock);
+    size_t n = GPR_MIN(central->count, slab_cache_limit(size_class) / 2);
+    while (n-- > 0) slab_push(list, slab_pop(central));
+    gpr_spinlock_unlock(&g_slab_central.lock);
+  }
+  void* block = list->count > 0 ? slab_pop(list) : nullptr;
+  gpr_spinlock_unlock(&cache->lock);
+  return block;
+}
+
+/* Caches the block of a freed slice, or returns false if it should be freed
+   instead. */
+bool slab_free(size_t size_class, void* block) {
+  if (gpr_atm_acq_load(&g_slab_enabled) == 0) return false;
+  SlabCache* cache = slab_current_cache();
+  SlabFreeList* list = &cache->lists[size_class];
+  const size_t limit = slab_cache_limit(size_class);
+  bool cached = false;
+  gpr_spinlock_lock(&cache->lock);
+  /* Checked again under the lock so that no block is cached after
+     grpc_slice_slab_allocator_shutdown() empties the caches. */
+  if (gpr_atm_no_barrier_load(&g_slab_enabled) != 0) {
+    if (list->count == limit) {
+      /* Move half of the cache to the central list, as far as it has room. */
+      SlabFreeList* central = &g_slab_central.lists[size_class];
+      gpr_spinlock_lock(&g_slab_central.lock);
+      size_t n = GPR_MIN(limit / 2, limit - central->count);
+      while (n-- > 0) slab_push(central, slab_pop(list));
+      gpr_spinlock_unlock(&g_slab_central.lock);
+    }
+    if (list->count < limit) {
+      slab_push(list, block);
+      cached = true;
+    }
+  }
+  gpr_spinlock_unlock(&cache->lock);
+  return cached;
+}
+
+/* The refcount at the front of a block from the slab allocator, which puts
+   the block back in the allocator when the slice is freed. */
+class SlabRefCount {
+ public:
+  static void Destroy(void* arg) {
+    SlabRefCount* r = static_cast<SlabRefCount*>(arg);
+    const size_t size_class = r->size_class_;
+    r->~SlabRefCount();
+    if (!slab_free(size_class, r)) {
+      gpr_subsystem_free(GPR_ALLOC_SUBSYSTEM_SLICES, r, BlockSize(size_class));
+    }
+  }
+
+  // The size of the blocks of a class, which hold this and the bytes.
+  static size_t BlockSize(size_t size_class) {
+    return sizeof(SlabRefCount) + slab_payload_size(size_class);
+  }
+
+  explicit SlabRefCount(size_t size_class)
+      : base_(grpc_slice_refcount::Type::REGULAR, &refs_, Destroy, this,
+              &base_),
+        size_class_(size_class) {}
+  ~SlabRefCount() = default;
+
+  grpc_slice_refcount* base_refcount() { return &base_; }
+
+ private:
+  grpc_slice_refcount base_;
+  grpc_core::RefCount refs_;
+  const size_t size_class_;
+};
+
+void slab_drain(SlabCache* cache) {
+  gpr_spinlock_lock(&cache->lock);
+  for (size_t i = 0; i < kSlabSizeClasses; ++i) {
+    while (cache->lists[i].count > 0) {
+      gpr_subsystem_free(GPR_ALLOC_SUBSYSTEM_SLICES,
+                         slab_pop(&cache->lists[i]),
+                         SlabRefCount::BlockSize(i));
+    }
+  }
+  gpr_spinlock_unlock(&cache->lock);
+}
+
 }  // namespace
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_slice_slab_allocator, false,
+    "If set, the memory of slices of up to 4KB is allocated from size classes "
+    "of cached blocks rather than with a malloc and a free per slice");
+
+void grpc_slice_slab_allocator_init(void) {
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_slice_slab_allocator)) return;
+  g_slab_num_shards = GPR_CLAMP(static_cast<size_t>(gpr_cpu_num_cores()),
+                                static_cast<size_t>(1), kSlabCacheMaxShards);
+  gpr_atm_rel_store(&g_slab_enabled, 1);
+}
+
+void grpc_slice_slab_allocator_shutdown(void) {
+  if (gpr_atm_no_barrier_load(&g_slab_enabled) == 0) return;
+  gpr_atm_rel_store(&g_slab_enabled, 0);
+  for (size_t i = 0; i < g_slab_num_shards; ++i) {
+    slab_drain(&g_slab_shards[i].cache);
+  }
+  slab_drain(&g_slab_central);
+}
+
 grpc_slice grpc_slice_malloc_large(size_t length) {
   return grpc_core::UnmanagedMemorySlice(
       length, grpc_core::UnmanagedMemorySlice::ForceHeapAllocation());
@@ -283,13 +472,28 @@ void grpc_core::UnmanagedMemorySlice::HeapInit(size_t length) {
 
      refcount is a malloc_refcount
      bytes is an array of bytes of the requested length
-     Both parts are placed in the same allocation returned from gpr_malloc */
-  auto* rc =
-      static_cast<MallocRefCount*>(gpr_malloc(sizeof(MallocRefCount) + length));
+     Both parts are placed in the same allocation for the slices subsystem,
+     from the slab allocator when it is on and the bytes fit */
+  if (length <= kSlabMaxPayload && gpr_atm_acq_load(&g_slab_enabled) != 0) {
+    const size_t size_class = slab_size_class(length);
+    void* block = slab_alloc(size_class);
+    if (block == nullptr) {
+      block = gpr_subsystem_malloc(GPR_ALLOC_SUBSYSTEM_SLICES,
+                                   SlabRefCount::BlockSize(size_class));
+    }
+    auto* rc = new (block) SlabRefCount(size_class);
+    refcount = rc->base_refcount();
+    data.refcounted.bytes = reinterpret_cast<uint8_t*>(rc + 1);
+    data.refcounted.length = length;
+    return;
+  }
+  const size_t alloc_size = sizeof(MallocRefCount) + length;
+  auto* rc = static_cast<MallocRefCount*>(
+      gpr_subsystem_malloc(GPR_ALLOC_SUBSYSTEM_SLICES, alloc_size));
 
   /* Initial refcount on rc is 1 - and it's up to the caller to release
      this reference. */
-  new (rc) MallocRefCount();
+  new (rc) MallocRefCount(alloc_size);
 
   /* Build up the slice to be returned. */
   /* The slices refcount points back to the allocated block. */
@@ -35,17 +35,21 @@
 /* Typically, we do not actually need to embiggen (by calling
  * memmove/malloc/realloc) - only if we were up against the full capacity of the
  * slice buffer. If do_embiggen is inlined, the compiler clobbers multiple
- * registers pointlessly in the common case. */
+ * registers pointlessly in the common case. Makes room for n more slices. */
 static void GPR_ATTRIBUTE_NOINLINE do_embiggen(grpc_slice_buffer* sb,
-                                               const size_t slice_count,
-                                               const size_t slice_offset) {
-  if (slice_offset != 0) {
+                                               const size_t n) {
+  const size_t slice_offset = static_cast<size_t>(sb->slices - sb->base_slices);
+  const size_t slice_count = sb->count + slice_offset;
+  /* Only move elements back when at least half the array is unused in front
+   * of them: a buffer used as a queue (add at the back, take from the front)
+   * would otherwise move all its slices each time it fills up. */
+  if (sb->count + n <= sb->capacity && 2 * slice_offset >= sb->capacity) {
     /* Make room by moving elements if there's still space unused */
     memmove(sb->base_slices, sb->slices, sb->count * sizeof(grpc_slice));
     sb->slices = sb->base_slices;
   } else {
     /* Allocate more memory if no more space is available */
-    const size_t new_capacity = GROW(sb->capacity);
+    const size_t new_capacity = GPR_MAX(GROW(sb->capacity), slice_count + n);
     sb->capacity = new_capacity;
     if (sb->base_slices == sb->inlined) {
       sb->base_slices = static_cast<grpc_slice*>(
@@ -70,7 +74,25 @@ static void maybe_embiggen(grpc_slice_buffer* sb) {
   size_t slice_offset = static_cast<size_t>(sb->slices - sb->base_slices);
   size_t slice_count = sb->count + slice_offset;
   if (GPR_UNLIKELY(slice_count == sb->capacity)) {
-    do_embiggen(sb, slice_count, slice_offset);
+    do_embiggen(sb, 1);
+  }
+}
+
+/* Appends n slices as that many grpc_slice_buffer_add() calls would, but
+ * grows the array at most once */
+static void add_slices(grpc_slice_buffer* sb, const grpc_slice* s, size_t n) {
+  if (n == 0) return;
+  if (sb->count == 0) sb->slices = sb->base_slices;
+  const size_t slice_offset = static_cast<size_t>(sb->slices - sb->base_slices);
+  if (sb->count + slice_offset + n > sb->capacity) do_embiggen(sb, n);
+  for (size_t i = 0; i < n; i++) {
+    if (s[i].refcount != nullptr) {
+      sb->slices[sb->count++] = s[i];
+      sb->length += s[i].data.refcounted.length;
+    } else {
+      /* may be merged into the back slice */
+      grpc_slice_buffer_add(sb, s[i]);
+    }
   }
 }
 
@@ -171,10 +193,7 @@ void grpc_slice_buffer_add(grpc_slice_buffer* sb, grpc_slice s) {
 }
 
 void grpc_slice_buffer_addn(grpc_slice_buffer* sb, grpc_slice* s, size_t n) {
-  size_t i;
-  for (i = 0; i < n; i++) {
-    grpc_slice_buffer_add(sb, s[i]);
-  }
+  add_slices(sb, s, n);
 }
 
 void grpc_slice_buffer_pop(grpc_slice_buffer* sb) {
@@ -275,27 +294,31 @@ static void slice_buffer_move_first_maybe_ref(grpc_slice_buffer* src, size_t n,
   size_t output_len = dst->length + n;
   size_t new_input_len = src->length - n;
 
-  while (src->count > 0) {
+  /* move the slices that go whole in one step */
+  size_t whole = 0;
+  size_t whole_len = 0;
+  while (whole_len + GRPC_SLICE_LENGTH(src->slices[whole]) <= n) {
+    whole_len += GRPC_SLICE_LENGTH(src->slices[whole]);
+    whole++;
+  }
+  add_slices(dst, src->slices, whole);
+  src->slices += whole;
+  src->count -= whole;
+  src->length -= whole_len;
+  n -= whole_len;
+
+  if (n > 0) {
     grpc_slice slice = grpc_slice_buffer_take_first(src);
-    size_t slice_len = GRPC_SLICE_LENGTH(slice);
-    if (n > slice_len) {
-      grpc_slice_buffer_add(dst, slice);
-      n -= slice_len;
-    } else if (n == slice_len) {
-      grpc_slice_buffer_add(dst, slice);
-      break;
-    } else if (incref) { /* n < slice_len */
+    if (incref) {
       grpc_slice_buffer_undo_take_first(
           src, grpc_slice_split_tail_maybe_ref(&slice, n, GRPC_SLICE_REF_BOTH));
       GPR_ASSERT(GRPC_SLICE_LENGTH(slice) == n);
       grpc_slice_buffer_add(dst, slice);
-      break;
-    } else { /* n < slice_len */
+    } else {
       grpc_slice_buffer_undo_take_first(
           src, grpc_slice_split_tail_maybe_ref(&slice, n, GRPC_SLICE_REF_TAIL));
       GPR_ASSERT(GRPC_SLICE_LENGTH(slice) == n);
       grpc_slice_buffer_add_indexed(dst, slice);
-      break;
     }
   }
   GPR_ASSERT(dst->length == output_len);
@@ -404,6 +427,55 @@ void grpc_slice_buffer_sub_first(grpc_slice_buffer* sb, size_t begin,
   sb->length += end - begin;
 }
 
+void grpc_slice_buffer_coalesce_small_slices(grpc_slice_buffer* sb,
+                                             size_t max_small_length) {
+  // Size the shared buffer for every run that will be merged
+  size_t pool_length = 0;
+  size_t run_count = 0;
+  size_t run_length = 0;
+  for (size_t i = 0; i <= sb->count; i++) {
+    const size_t len = i < sb->count ? GRPC_SLICE_LENGTH(sb->slices[i]) : 0;
+    if (i < sb->count && len <= max_small_length) {
+      run_count++;
+      run_length += len;
+      continue;
+    }
+    if (run_count > 1) pool_length += run_length;
+    run_count = 0;
+    run_length = 0;
+  }
+  if (pool_length == 0) return;
+
+  grpc_slice pool = GRPC_SLICE_MALLOC(pool_length);
+  uint8_t* pool_bytes = GRPC_SLICE_START_PTR(pool);
+  size_t pool_used = 0;
+  size_t out = 0;
+  size_t i = 0;
+  while (i < sb->count) {
+    size_t run_end = i;
+    while (run_end < sb->count &&
+           GRPC_SLICE_LENGTH(sb->slices[run_end]) <= max_small_length) {
+      run_end++;
+    }
+    if (run_end - i < 2) {
+      // Not a run worth merging: keep the slice where it is
+      sb->slices[out++] = sb->slices[i++];
+      continue;
+    }
+    const size_t run_begin = pool_used;
+    for (; i < run_end; i++) {
+      const size_t len = GRPC_SLICE_LENGTH(sb->slices[i]);
+      memcpy(pool_bytes + pool_used, GRPC_SLICE_START_PTR(sb->slices[i]), len);
+      pool_used += len;
+      grpc_slice_unref_internal(sb->slices[i]);
+    }
+    sb->slices[out++] = grpc_slice_sub(pool, run_begin, pool_used);
+  }
+  GPR_ASSERT(pool_used == pool_length);
+  sb->count = out;
+  grpc_slice_unref_internal(pool);
+}
+
 void grpc_slice_buffer_undo_take_first(grpc_slice_buffer* sb,
                                        grpc_slice slice) {
   sb->slices--;
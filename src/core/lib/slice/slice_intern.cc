@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/murmur_hash.h"
@@ -34,16 +35,22 @@
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/static_metadata.h"
 
-#define LOG2_SHARD_COUNT 5
-#define SHARD_COUNT (1 << LOG2_SHARD_COUNT)
+/* The shard count scales with the machine (SHARDS_PER_CORE shards per core,
+   rounded up to a power of two) so that threads interning different strings
+   rarely meet on a shard lock. */
+#define MIN_LOG2_SHARD_COUNT 5
+#define MAX_LOG2_SHARD_COUNT 10
+#define SHARDS_PER_CORE 4
 #define INITIAL_SHARD_CAPACITY 8
 
-#define TABLE_IDX(hash, capacity) (((hash) >> LOG2_SHARD_COUNT) % (capacity))
-#define SHARD_IDX(hash) ((hash) & ((1 << LOG2_SHARD_COUNT) - 1))
+#define TABLE_IDX(hash, capacity) (((hash) >> g_log2_shard_count) % (capacity))
+#define SHARD_IDX(hash) ((hash) & ((1u << g_log2_shard_count) - 1))
 
 using grpc_core::InternedSliceRefcount;
 
-typedef struct slice_shard {
+/* Each shard gets its own cache line(s), so that contention on one shard's
+   lock does not slow down its neighbours. */
+typedef struct alignas(GPR_CACHELINE_SIZE) slice_shard {
   gpr_mu mu;
   InternedSliceRefcount** strs;
   size_t count;
@@ -54,16 +61,9 @@ typedef struct slice_shard {
 uint32_t g_hash_seed;
 static int g_forced_hash_seed = 0;
 
-static slice_shard g_shards[SHARD_COUNT];
+static uint32_t g_log2_shard_count;
+static slice_shard* g_shards;
 
-typedef struct {
-  uint32_t hash;
-  uint32_t idx;
-} static_metadata_hash_ent;
-
-static static_metadata_hash_ent
-    static_metadata_hash[4 * GRPC_STATIC_MDSTR_COUNT];
-static uint32_t max_static_metadata_hash_probe;
 uint32_t grpc_static_metadata_hash_values[GRPC_STATIC_MDSTR_COUNT];
 
 namespace grpc_core {
@@ -114,8 +114,8 @@ grpc_core::InternedSlice::InternedSlice(InternedSliceRefcount* s) {
 }
 
 uint32_t grpc_slice_default_hash_impl(grpc_slice s) {
-  return gpr_murmur_hash3(GRPC_SLICE_START_PTR(s), GRPC_SLICE_LENGTH(s),
-                          g_hash_seed);
+  return GRPC_SLICE_BYTES_HASH(GRPC_SLICE_START_PTR(s), GRPC_SLICE_LENGTH(s),
+                               g_hash_seed);
 }
 
 uint32_t grpc_static_slice_hash(grpc_slice s) {
@@ -134,16 +134,11 @@ grpc_slice grpc_slice_maybe_static_intern(grpc_slice slice,
     return slice;
   }
 
-  uint32_t hash = grpc_slice_hash_internal(slice);
-  for (uint32_t i = 0; i <= max_static_metadata_hash_probe; i++) {
-    static_metadata_hash_ent ent =
-        static_metadata_hash[(hash + i) % GPR_ARRAY_SIZE(static_metadata_hash)];
-    if (ent.hash == hash && ent.idx < GRPC_STATIC_MDSTR_COUNT &&
-        grpc_slice_eq_static_interned(slice,
-                                      grpc_static_slice_table[ent.idx])) {
-      *returned_slice_is_different = true;
-      return grpc_static_slice_table[ent.idx];
-    }
+  const int32_t idx = grpc_static_slice_index_of(GRPC_SLICE_START_PTR(slice),
+                                                 GRPC_SLICE_LENGTH(slice));
+  if (idx >= 0) {
+    *returned_slice_is_different = true;
+    return grpc_static_slice_table[idx];
   }
 
   return slice;
@@ -157,24 +152,14 @@ grpc_slice grpc_slice_intern(grpc_slice slice) {
   return grpc_core::ManagedMemorySlice(&slice);
 }
 
-// Attempt to see if the provided slice or string matches a static slice.
-// SliceArgs... is either a const grpc_slice& or a string and length. In either
-// case, hash is the pre-computed hash value.
+// Attempt to see if the provided string matches a static slice, with the
+// generated length and byte switch rather than a hash.
 //
 // Returns: a matching static slice, or null.
-template <class... SliceArgs>
 static const grpc_core::StaticMetadataSlice* MatchStaticSlice(
-    uint32_t hash, SliceArgs&&... args) {
-  for (uint32_t i = 0; i <= max_static_metadata_hash_probe; i++) {
-    static_metadata_hash_ent ent =
-        static_metadata_hash[(hash + i) % GPR_ARRAY_SIZE(static_metadata_hash)];
-    if (ent.hash == hash && ent.idx < GRPC_STATIC_MDSTR_COUNT &&
-        grpc_static_slice_table[ent.idx].Equals(
-            std::forward<SliceArgs>(args)...)) {
-      return &grpc_static_slice_table[ent.idx];
-    }
-  }
-  return nullptr;
+    const void* buf, size_t len) {
+  const int32_t idx = grpc_static_slice_index_of(buf, len);
+  return idx >= 0 ? &grpc_static_slice_table[idx] : nullptr;
 }
 
 // Helper methods to enable us to select appropriately overloaded slice methods
@@ -189,30 +174,42 @@ static size_t GetLength(const grpc_slice& slice) {
   return GRPC_SLICE_LENGTH(slice);
 }
 
-// Creates an interned slice for a string that does not currently exist in the
-// intern table. SliceArgs... is either a const grpc_slice& or a string and
-// length. In either case, hash is the pre-computed hash value. We must already
-// hold the shard lock. Helper for FindOrCreateInternedSlice().
+// Allocates an interned slice for a string that does not currently exist in
+// the intern table, without adding it to the table yet; that way the
+// allocation and copy happen outside the shard lock. SliceArgs... is either a
+// const grpc_slice& or a string and length. In either case, hash is the
+// pre-computed hash value. Helper for FindOrCreateInternedSlice().
 //
-// Returns: a newly interned slice.
+// Returns: a new interned slice, to be handed to InsertInternedSliceLocked() or
+// DiscardInternedSlice().
 template <class... SliceArgs>
-static InternedSliceRefcount* InternNewStringLocked(slice_shard* shard,
-                                                    size_t shard_idx,
-                                                    uint32_t hash,
-                                                    SliceArgs&&... args) {
+static InternedSliceRefcount* NewInternedSlice(uint32_t hash,
+                                               SliceArgs&&... args) {
   /* string data goes after the internal_string header */
   size_t len = GetLength(std::forward<SliceArgs>(args)...);
   const void* buffer = GetBuffer(std::forward<SliceArgs>(args)...);
   InternedSliceRefcount* s =
       static_cast<InternedSliceRefcount*>(gpr_malloc(sizeof(*s) + len));
-  new (s) grpc_core::InternedSliceRefcount(len, hash, shard->strs[shard_idx]);
+  new (s) grpc_core::InternedSliceRefcount(len, hash, nullptr);
   memcpy(reinterpret_cast<char*>(s + 1), buffer, len);
+  return s;
+}
+
+// Frees a slice from NewInternedSlice() that lost the race to be inserted. It
+// never made it into the table, so its destructor (which unlinks it) must not
+// run.
+static void DiscardInternedSlice(InternedSliceRefcount* s) { gpr_free(s); }
+
+// Adds a slice from NewInternedSlice() to the intern table. We must already
+// hold the shard lock. Helper for FindOrCreateInternedSlice().
+static void InsertInternedSliceLocked(slice_shard* shard, size_t shard_idx,
+                                      InternedSliceRefcount* s) {
+  s->bucket_next = shard->strs[shard_idx];
   shard->strs[shard_idx] = s;
   shard->count++;
   if (shard->count > shard->capacity * 2) {
     grow_shard(shard);
   }
-  return s;
 }
 
 // Attempt to see if the provided slice or string matches an existing interned
@@ -252,14 +249,27 @@ static InternedSliceRefcount* FindOrCreateInternedSlice(uint32_t hash,
                                                         SliceArgs&&... args) {
   slice_shard* shard = &g_shards[SHARD_IDX(hash)];
   gpr_mu_lock(&shard->mu);
+  InternedSliceRefcount* s = MatchInternedSliceLocked(
+      hash, TABLE_IDX(hash, shard->capacity), std::forward<SliceArgs>(args)...);
+  gpr_mu_unlock(&shard->mu);
+  if (s != nullptr) {
+    return s;
+  }
+  // Build the new entry without holding the lock, then look again: another
+  // thread may have interned the same string in the meantime.
+  InternedSliceRefcount* created =
+      NewInternedSlice(hash, std::forward<SliceArgs>(args)...);
+  gpr_mu_lock(&shard->mu);
   const size_t idx = TABLE_IDX(hash, shard->capacity);
-  InternedSliceRefcount* s =
-      MatchInternedSliceLocked(hash, idx, std::forward<SliceArgs>(args)...);
+  s = MatchInternedSliceLocked(hash, idx, std::forward<SliceArgs>(args)...);
   if (s == nullptr) {
-    s = InternNewStringLocked(shard, idx, hash,
-                              std::forward<SliceArgs>(args)...);
+    InsertInternedSliceLocked(shard, idx, created);
+    s = created;
   }
   gpr_mu_unlock(&shard->mu);
+  if (s != created) {
+    DiscardInternedSlice(created);
+  }
   return s;
 }
 
@@ -270,11 +280,11 @@ grpc_core::ManagedMemorySlice::ManagedMemorySlice(const char* string)
 grpc_core::ManagedMemorySlice::ManagedMemorySlice(const char* string,
                                                   size_t len) {
   GPR_TIMER_SCOPE("grpc_slice_intern", 0);
-  const uint32_t hash = gpr_murmur_hash3(string, len, g_hash_seed);
-  const StaticMetadataSlice* static_slice = MatchStaticSlice(hash, string, len);
+  const StaticMetadataSlice* static_slice = MatchStaticSlice(string, len);
   if (static_slice) {
     *this = *static_slice;
   } else {
+    const uint32_t hash = GRPC_SLICE_BYTES_HASH(string, len, g_hash_seed);
     *this =
         grpc_core::InternedSlice(FindOrCreateInternedSlice(hash, string, len));
   }
@@ -287,11 +297,12 @@ grpc_core::ManagedMemorySlice::ManagedMemorySlice(const grpc_slice* slice_ptr) {
     *this = static_cast<const grpc_core::StaticMetadataSlice&>(slice);
     return;
   }
-  const uint32_t hash = grpc_slice_hash_internal(slice);
-  const StaticMetadataSlice* static_slice = MatchStaticSlice(hash, slice);
+  const StaticMetadataSlice* static_slice = MatchStaticSlice(
+      GRPC_SLICE_START_PTR(slice), GRPC_SLICE_LENGTH(slice));
   if (static_slice) {
     *this = *static_slice;
   } else {
+    const uint32_t hash = grpc_slice_hash_internal(slice);
     *this = grpc_core::InternedSlice(FindOrCreateInternedSlice(hash, slice));
   }
 }
@@ -305,7 +316,15 @@ void grpc_slice_intern_init(void) {
   if (!g_forced_hash_seed) {
     g_hash_seed = static_cast<uint32_t>(gpr_now(GPR_CLOCK_REALTIME).tv_nsec);
   }
-  for (size_t i = 0; i < SHARD_COUNT; i++) {
+  g_log2_shard_count = MIN_LOG2_SHARD_COUNT;
+  while (g_log2_shard_count < MAX_LOG2_SHARD_COUNT &&
+         (1u << g_log2_shard_count) < SHARDS_PER_CORE * gpr_cpu_num_cores()) {
+    g_log2_shard_count++;
+  }
+  const size_t shard_count = static_cast<size_t>(1) << g_log2_shard_count;
+  g_shards = static_cast<slice_shard*>(
+      gpr_malloc_aligned(sizeof(*g_shards) * shard_count, GPR_CACHELINE_SIZE));
+  for (size_t i = 0; i < shard_count; i++) {
     slice_shard* shard = &g_shards[i];
     gpr_mu_init(&shard->mu);
     shard->count = 0;
@@ -313,26 +332,9 @@ void grpc_slice_intern_init(void) {
     shard->strs = static_cast<InternedSliceRefcount**>(
         gpr_zalloc(sizeof(*shard->strs) * shard->capacity));
   }
-  for (size_t i = 0; i < GPR_ARRAY_SIZE(static_metadata_hash); i++) {
-    static_metadata_hash[i].hash = 0;
-    static_metadata_hash[i].idx = GRPC_STATIC_MDSTR_COUNT;
-  }
-  max_static_metadata_hash_probe = 0;
   for (size_t i = 0; i < GRPC_STATIC_MDSTR_COUNT; i++) {
     grpc_static_metadata_hash_values[i] =
         grpc_slice_default_hash_internal(grpc_static_slice_table[i]);
-    for (size_t j = 0; j < GPR_ARRAY_SIZE(static_metadata_hash); j++) {
-      size_t slot = (grpc_static_metadata_hash_values[i] + j) %
-                    GPR_ARRAY_SIZE(static_metadata_hash);
-      if (static_metadata_hash[slot].idx == GRPC_STATIC_MDSTR_COUNT) {
-        static_metadata_hash[slot].hash = grpc_static_metadata_hash_values[i];
-        static_metadata_hash[slot].idx = static_cast<uint32_t>(i);
-        if (j > max_static_metadata_hash_probe) {
-          max_static_metadata_hash_probe = static_cast<uint32_t>(j);
-        }
-        break;
-      }
-    }
   }
   // Handle KV hash for all static mdelems.
   for (size_t i = 0; i < GRPC_STATIC_MDELEM_COUNT; ++i) {
@@ -341,7 +343,8 @@ void grpc_slice_intern_init(void) {
 }
 
 void grpc_slice_intern_shutdown(void) {
-  for (size_t i = 0; i < SHARD_COUNT; i++) {
+  const size_t shard_count = static_cast<size_t>(1) << g_log2_shard_count;
+  for (size_t i = 0; i < shard_count; i++) {
     slice_shard* shard = &g_shards[i];
     gpr_mu_destroy(&shard->mu);
     /* TODO(ctiller): GPR_ASSERT(shard->count == 0); */
@@ -362,4 +365,6 @@ void grpc_slice_intern_shutdown(void) {
     }
     gpr_free(shard->strs);
   }
+  gpr_free_aligned(g_shards);
+  g_shards = nullptr;
 }
@@ -28,6 +28,9 @@
 #include <string.h>
 
 #include "src/core/lib/gpr/murmur_hash.h"
+#include "src/core/lib/gpr/wyhash.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/slice/slice_utils.h"
@@ -38,6 +41,16 @@
 extern uint32_t grpc_static_metadata_hash_values[GRPC_STATIC_MDSTR_COUNT];
 extern uint32_t g_hash_seed;
 
+// The hash of slice bytes, for the intern table and the metadata and slice
+// hash tables built on it. Builds with GRPC_SLICE_HASH_WYHASH defined use the
+// faster gpr_wyhash. The default remains gpr_murmur_hash3, which tests that
+// depend on the hpack encoder's hash collisions were written against.
+#ifdef GRPC_SLICE_HASH_WYHASH
+#define GRPC_SLICE_BYTES_HASH gpr_wyhash
+#else
+#define GRPC_SLICE_BYTES_HASH gpr_murmur_hash3
+#endif
+
 // grpc_slice_refcount : A reference count for grpc_slice.
 //
 // Non-inlined grpc_slice objects are refcounted. Historically this was
@@ -209,6 +222,11 @@ struct InternedSliceRefcount {
   const size_t length;
   RefCount refcnt;
   const uint32_t hash;
+  // Set once the slice has passed the corresponding check in
+  // surface/validate_metadata.cc, so that interned metadata sent on every call
+  // is only validated once.
+  Atomic<bool> valid_header_key;
+  Atomic<bool> valid_header_nonbin_value;
   InternedSliceRefcount* bucket_next;
 };
 
@@ -242,8 +260,8 @@ inline uint32_t grpc_slice_refcount::Hash(const grpc_slice& slice) {
     case Type::REGULAR:
       break;
   }
-  return gpr_murmur_hash3(GRPC_SLICE_START_PTR(slice), GRPC_SLICE_LENGTH(slice),
-                          g_hash_seed);
+  return GRPC_SLICE_BYTES_HASH(GRPC_SLICE_START_PTR(slice),
+                               GRPC_SLICE_LENGTH(slice), g_hash_seed);
 }
 
 inline const grpc_slice& grpc_slice_ref_internal(const grpc_slice& slice) {
@@ -278,6 +296,13 @@ void grpc_slice_buffer_remove_first(grpc_slice_buffer* sb);
 void grpc_slice_buffer_sub_first(grpc_slice_buffer* sb, size_t begin,
                                  size_t end);
 
+// Copies every run of two or more consecutive slices no longer than
+// max_small_length into one shared buffer, replacing each run with a single
+// slice, so that writing the buffer out needs fewer iovecs. Longer slices are
+// kept by reference. The contents and length of the buffer are unchanged.
+void grpc_slice_buffer_coalesce_small_slices(grpc_slice_buffer* sb,
+                                             size_t max_small_length);
+
 /* Check if a slice is interned */
 bool grpc_slice_is_interned(const grpc_slice& slice);
 inline bool grpc_slice_is_interned(const grpc_slice& slice) {
@@ -294,6 +319,14 @@ inline bool grpc_slice_static_interned_equal(const grpc_slice& a,
 
 void grpc_slice_intern_init(void);
 void grpc_slice_intern_shutdown(void);
+
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_slice_slab_allocator);
+
+// Turns the slab allocator for small slices on if grpc_slice_slab_allocator is
+// set; called by grpc_init(). grpc_slice_slab_allocator_shutdown() frees the
+// blocks it caches, and slices freed after it go back to gpr_free.
+void grpc_slice_slab_allocator_init(void);
+void grpc_slice_slab_allocator_shutdown(void);
 void grpc_test_only_set_slice_hash_seed(uint32_t key);
 // if slice matches a static slice, returns the static slice
 // otherwise returns the passed in slice (without reffing it)
@@ -310,8 +343,8 @@ inline uint32_t grpc_slice_hash_refcounted(const grpc_slice& s) {
 }
 
 inline uint32_t grpc_slice_default_hash_internal(const grpc_slice& s) {
-  return gpr_murmur_hash3(GRPC_SLICE_START_PTR(s), GRPC_SLICE_LENGTH(s),
-                          g_hash_seed);
+  return GRPC_SLICE_BYTES_HASH(GRPC_SLICE_START_PTR(s), GRPC_SLICE_LENGTH(s),
+                               g_hash_seed);
 }
 
 inline uint32_t grpc_slice_hash_internal(const grpc_slice& s) {
@@ -127,6 +127,12 @@ int grpc_byte_buffer_reader_next(grpc_byte_buffer_reader* reader,
 }
 
 grpc_slice grpc_byte_buffer_reader_readall(grpc_byte_buffer_reader* reader) {
+  grpc_slice_buffer* slice_buffer = &reader->buffer_out->data.raw.slice_buffer;
+  /* a message read in one piece is handed back as is, without a copy */
+  if (reader->current.index == 0 && slice_buffer->count == 1) {
+    reader->current.index = 1;
+    return grpc_slice_ref_internal(slice_buffer->slices[0]);
+  }
   grpc_slice in_slice;
   size_t bytes_read = 0;
   const size_t input_size = grpc_byte_buffer_length(reader->buffer_out);
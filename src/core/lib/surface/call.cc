@@ -28,11 +28,14 @@
 #include <grpc/grpc.h>
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/channel/call_latency_breakdown.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/compression/algorithm_metadata.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/gpr/string.h"
@@ -40,8 +43,10 @@
 #include "src/core/lib/gprpp/arena.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/profiling/usdt.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/slice/slice_utils.h"
 #include "src/core/lib/surface/api_trace.h"
@@ -146,6 +151,9 @@ struct grpc_call {
 
   ~grpc_call() {
     gpr_free(static_cast<void*>(const_cast<char*>(final_info.error_string)));
+    if (incoming_persistent_decompressor != nullptr) {
+      grpc_msg_persistent_compressor_destroy(incoming_persistent_decompressor);
+    }
   }
 
   grpc_core::RefCount ext_ref;
@@ -199,6 +207,9 @@ struct grpc_call {
   /* Stream compression algorithm for *incoming* data */
   grpc_stream_compression_algorithm incoming_stream_compression_algorithm =
       GRPC_STREAM_COMPRESS_NONE;
+  /* Set if incoming messages are deflated with one context for the whole
+     stream: they are then decompressed as they arrive, in order */
+  grpc_msg_persistent_compressor* incoming_persistent_decompressor = nullptr;
   /* Supported encodings (compression algorithms), a bitset.
    * Always support no compression. */
   uint32_t encodings_accepted_by_peer = 1 << GRPC_MESSAGE_COMPRESS_NONE;
@@ -221,6 +232,7 @@ struct grpc_call {
   grpc_slice receiving_slice = grpc_empty_slice();
   grpc_closure receiving_slice_ready;
   grpc_closure receiving_stream_ready;
+  grpc_closure decompress_received_message;
   grpc_closure receiving_initial_metadata_ready;
   grpc_closure receiving_trailing_metadata_ready;
   uint32_t test_only_last_message_flags = 0;
@@ -341,7 +353,8 @@ grpc_error* grpc_call_create(const grpc_call_create_args* args,
       call_and_stack_size + (args->parent ? sizeof(child_call) : 0);
 
   std::pair<grpc_core::Arena*, void*> arena_with_call =
-      grpc_core::Arena::CreateWithAlloc(initial_size, call_alloc_size);
+      args->channel->call_arena_pool->CreateWithAlloc(initial_size,
+                                                      call_alloc_size);
   arena = arena_with_call.first;
   call = new (arena_with_call.second) grpc_call(arena, *args);
   *out_call = call;
@@ -411,6 +424,13 @@ grpc_error* grpc_call_create(const grpc_call_create_args* args,
     }
   }
   call->send_deadline = send_deadline;
+  grpc_core::CallLatencyBreakdown* latency_breakdown =
+      grpc_core::CallLatencyBreakdown::MaybeCreate(arena, call->is_client);
+  if (latency_breakdown != nullptr) {
+    latency_breakdown->Record(grpc_core::CallLatencyStage::kCallCreated);
+    grpc_call_context_set(call, GRPC_CONTEXT_LATENCY_BREAKDOWN,
+                          latency_breakdown, nullptr);
+  }
   /* initial refcount dropped by grpc_call_unref */
   grpc_call_element_args call_args = {CALL_STACK_FROM_CALL(call),
                                       args->server_transport_data,
@@ -461,6 +481,7 @@ grpc_error* grpc_call_create(const grpc_call_create_args* args,
     grpc_call_stack_set_pollset_or_pollset_set(CALL_STACK_FROM_CALL(call),
                                                &call->pollent);
   }
+  GRPC_USDT2(call_start, call, call->is_client);
 
   if (call->is_client) {
     grpc_core::channelz::ChannelNode* channelz_channel =
@@ -515,7 +536,8 @@ static void release_call(void* call, grpc_error* error) {
   grpc_channel* channel = c->channel;
   grpc_core::Arena* arena = c->arena;
   c->~grpc_call();
-  grpc_channel_update_call_size_estimate(channel, arena->Destroy());
+  grpc_channel_update_call_size_estimate(
+      channel, channel->call_arena_pool->Release(arena));
   GRPC_CHANNEL_INTERNAL_UNREF(channel, "call");
 }
 
@@ -536,6 +558,9 @@ static void destroy_call(void* call, grpc_error* error) {
   for (ii = 0; ii < c->send_extra_metadata_count; ii++) {
     GRPC_MDELEM_UNREF(c->send_extra_metadata[ii].md);
   }
+  grpc_core::CallLatencyBreakdown* latency_breakdown =
+      grpc_core::CallLatencyBreakdown::FromContext(c->context);
+  if (latency_breakdown != nullptr) latency_breakdown->Export();
   for (i = 0; i < GRPC_CONTEXT_COUNT; i++) {
     if (c->context[i].destroy) {
       c->context[i].destroy(c->context[i].value);
@@ -553,6 +578,8 @@ static void destroy_call(void* call, grpc_error* error) {
   GRPC_ERROR_UNREF(status_error);
   c->final_info.stats.latency =
       gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), c->start_time);
+  GRPC_USDT3(call_end, c, c->final_info.final_status,
+             gpr_timespec_to_micros(c->final_info.stats.latency) * 1000);
 
   grpc_call_stack_destroy(CALL_STACK_FROM_CALL(c), &c->final_info,
                           GRPC_CLOSURE_INIT(&c->release_call, release_call, c,
@@ -846,6 +873,10 @@ static void set_encodings_accepted_by_peer(grpc_call* call, grpc_mdelem mdel,
     }
     if (r) {
       GPR_BITSET(encodings_accepted_by_peer, algorithm);
+    } else if (!stream_encoding &&
+               grpc_message_compression_is_deflate_persistent(
+                   accept_encoding_entry_slice)) {
+      /* Only of interest to the message compression filter. */
     } else {
       char* accept_encoding_entry_str =
           grpc_slice_to_c_string(accept_encoding_entry_slice);
@@ -1011,8 +1042,16 @@ static void recv_initial_filter(grpc_call* call, grpc_metadata_batch* b) {
   }
   if (b->idx.named.grpc_encoding != nullptr) {
     GPR_TIMER_SCOPE("incoming_message_compression_algorithm", 0);
-    set_incoming_message_compression_algorithm(
-        call, decode_message_compression(b->idx.named.grpc_encoding->md));
+    grpc_mdelem md = b->idx.named.grpc_encoding->md;
+    if (grpc_message_compression_is_deflate_persistent(GRPC_MDVALUE(md))) {
+      set_incoming_message_compression_algorithm(call,
+                                                 GRPC_MESSAGE_COMPRESS_DEFLATE);
+      call->incoming_persistent_decompressor =
+          grpc_msg_persistent_decompressor_create();
+    } else {
+      set_incoming_message_compression_algorithm(
+          call, decode_message_compression(md));
+    }
     grpc_metadata_batch_remove(b, GRPC_BATCH_GRPC_ENCODING);
   }
   uint32_t message_encodings_accepted_by_peer = 1u;
@@ -1188,6 +1227,8 @@ static void post_batch_completion(batch_control* bctl) {
         &call->metadata_batch[0 /* is_receiving */][1 /* is_trailing */]);
   }
   if (bctl->op.recv_trailing_metadata) {
+    grpc_core::CallLatencyRecord(call->context,
+                                 grpc_core::CallLatencyStage::kFinalOpPosted);
     /* propagate cancellation to any interested children */
     gpr_atm_rel_store(&call->received_final_op_atm, 1);
     parent_call* pc = get_parent_call(call);
@@ -1242,6 +1283,102 @@ static void finish_batch_step(batch_control* bctl) {
   }
 }
 
+/* Byte streams may hand back empty slices (e.g., while a transport gathers a
+   message into one contiguous slice); keep them out of the message. */
+static void add_received_slice(grpc_call* call, const grpc_slice& slice) {
+  if (GRPC_SLICE_LENGTH(slice) > 0) {
+    grpc_slice_buffer_add(&(*call->receiving_buffer)->data.raw.slice_buffer,
+                          slice);
+  } else {
+    grpc_slice_unref_internal(slice);
+  }
+}
+
+/* Messages being decompressed on the executor, across all calls. */
+static gpr_atm g_offloaded_decompressions;
+
+/* Replaces the received message with its decompressed form, and returns
+   whether that worked. */
+static bool decompress_receiving_buffer(grpc_call* call) {
+  grpc_byte_buffer* compressed = *call->receiving_buffer;
+  grpc_slice_buffer decompressed;
+  grpc_slice_buffer_init(&decompressed);
+  bool ok = call->incoming_persistent_decompressor != nullptr
+                ? grpc_msg_persistent_decompress(
+                      call->incoming_persistent_decompressor,
+                      &compressed->data.raw.slice_buffer, &decompressed)
+                : grpc_msg_decompress(
+                      call->incoming_message_compression_algorithm,
+                      &compressed->data.raw.slice_buffer, &decompressed);
+  if (ok) {
+    *call->receiving_buffer = grpc_raw_byte_buffer_create(
+        decompressed.slices, decompressed.count);
+    grpc_byte_buffer_destroy(compressed);
+  }
+  grpc_slice_buffer_destroy_internal(&decompressed);
+  return ok;
+}
+
+/* Messages compressed with a persistent dictionary only decode in order, and
+   so cannot be left for the application to decompress: they are decompressed
+   here, and a failure fails the call. */
+static void decompress_persistent_message(batch_control* bctl) {
+  grpc_call* call = bctl->call;
+  if (call->incoming_persistent_decompressor == nullptr ||
+      (*call->receiving_buffer)->data.raw.compression == GRPC_COMPRESS_NONE) {
+    return;
+  }
+  if (!decompress_receiving_buffer(call)) {
+    grpc_byte_buffer_destroy(*call->receiving_buffer);
+    *call->receiving_buffer = nullptr;
+    cancel_with_status(call, GRPC_STATUS_INTERNAL,
+                       "Failed to decompress message with persistent "
+                       "dictionary");
+  }
+}
+
+static void decompress_received_message(void* bctlp, grpc_error* error) {
+  batch_control* bctl = static_cast<batch_control*>(bctlp);
+  grpc_call* call = bctl->call;
+  if (call->incoming_persistent_decompressor != nullptr) {
+    decompress_persistent_message(bctl);
+  } else if (decompress_receiving_buffer(call)) {
+    /* On failure the message is left compressed, for the application to fail
+       to read as before. */
+    GRPC_STATS_INC_MESSAGES_DECOMPRESSED_OFFLOADED();
+  }
+  gpr_atm_no_barrier_fetch_add(&g_offloaded_decompressions, -1);
+  finish_batch_step(bctl);
+}
+
+/* Starts decompressing a received message on the executor if it is large
+   enough to hold up the thread that would otherwise, and returns whether it
+   did. The receive completes once that is done, which holds off reading more
+   messages of the call meanwhile. */
+static bool maybe_offload_decompression(batch_control* bctl) {
+  grpc_call* call = bctl->call;
+  grpc_byte_buffer* buffer = *call->receiving_buffer;
+  const uint32_t threshold =
+      grpc_channel_offload_decompression_threshold(call->channel);
+  if (threshold == 0 || buffer->data.raw.compression == GRPC_COMPRESS_NONE ||
+      buffer->data.raw.slice_buffer.length < threshold) {
+    return false;
+  }
+  const gpr_atm max_offloaded = 2 * gpr_cpu_num_cores();
+  if (gpr_atm_no_barrier_fetch_add(&g_offloaded_decompressions, 1) >=
+      max_offloaded) {
+    gpr_atm_no_barrier_fetch_add(&g_offloaded_decompressions, -1);
+    return false;
+  }
+  GRPC_CLOSURE_SCHED(
+      GRPC_CLOSURE_INIT(
+          &call->decompress_received_message, decompress_received_message,
+          bctl,
+          grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::LONG)),
+      GRPC_ERROR_NONE);
+  return true;
+}
+
 static void continue_receiving_slices(batch_control* bctl) {
   grpc_error* error;
   grpc_call* call = bctl->call;
@@ -1251,14 +1388,16 @@ static void continue_receiving_slices(batch_control* bctl) {
     if (remaining == 0) {
       call->receiving_message = 0;
       call->receiving_stream.reset();
-      finish_batch_step(bctl);
+      if (!maybe_offload_decompression(bctl)) {
+        decompress_persistent_message(bctl);
+        finish_batch_step(bctl);
+      }
       return;
     }
     if (call->receiving_stream->Next(remaining, &call->receiving_slice_ready)) {
       error = call->receiving_stream->Pull(&call->receiving_slice);
       if (error == GRPC_ERROR_NONE) {
-        grpc_slice_buffer_add(&(*call->receiving_buffer)->data.raw.slice_buffer,
-                              call->receiving_slice);
+        add_received_slice(call, call->receiving_slice);
       } else {
         call->receiving_stream.reset();
         grpc_byte_buffer_destroy(*call->receiving_buffer);
@@ -1282,8 +1421,7 @@ static void receiving_slice_ready(void* bctlp, grpc_error* error) {
     grpc_slice slice;
     error = call->receiving_stream->Pull(&slice);
     if (error == GRPC_ERROR_NONE) {
-      grpc_slice_buffer_add(&(*call->receiving_buffer)->data.raw.slice_buffer,
-                            slice);
+      add_received_slice(call, slice);
       continue_receiving_slices(bctl);
     } else {
       /* Error returned by ByteStream::Pull() needs to be released manually */
@@ -1344,6 +1482,9 @@ static void receiving_stream_ready(void* bctlp, grpc_error* error) {
                         reinterpret_cast<gpr_atm>(GRPC_ERROR_REF(error)));
     }
     cancel_with_error(call, GRPC_ERROR_REF(error));
+  } else if (call->receiving_stream != nullptr) {
+    grpc_core::CallLatencyRecord(
+        call->context, grpc_core::CallLatencyStage::kMessageDelivered);
   }
   /* If recv_state is RECV_NONE, we will save the batch_control
    * object with rel_cas, and will not use it after the cas. Its corresponding
@@ -1435,6 +1576,8 @@ static void receiving_initial_metadata_ready(void* bctlp, grpc_error* error) {
   GRPC_CALL_COMBINER_STOP(&call->call_combiner, "recv_initial_metadata_ready");
 
   if (error == GRPC_ERROR_NONE) {
+    grpc_core::CallLatencyRecord(
+        call->context, grpc_core::CallLatencyStage::kInitialMetadataDelivered);
     grpc_metadata_batch* md =
         &call->metadata_batch[1 /* is_receiving */][0 /* is_trailing */];
     recv_initial_filter(call, md);
@@ -1932,8 +2075,13 @@ grpc_call_error grpc_call_start_batch(grpc_call* call, const grpc_op* ops,
       "reserved=%p)",
       5, (call, ops, (unsigned long)nops, tag, reserved));
 
+  grpc_core::ExecCtx* holding_exec_ctx = grpc_core::ExecCtx::Get();
   if (reserved != nullptr) {
     err = GRPC_CALL_ERROR;
+  } else if (holding_exec_ctx != nullptr &&
+             (holding_exec_ctx->flags() &
+              GRPC_EXEC_CTX_FLAG_HOLDS_CALL_BATCHES) != 0) {
+    err = call_start_batch(call, ops, nops, tag, 0);
   } else {
     grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
     grpc_core::ExecCtx exec_ctx;
@@ -24,6 +24,7 @@
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/context.h"
 #include "src/core/lib/gprpp/arena.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/surface/api_trace.h"
 
 #include <grpc/grpc.h>
@@ -82,6 +83,25 @@ grpc_call_error grpc_call_start_batch_and_execute(grpc_call* call,
                                                   size_t nops,
                                                   grpc_closure* closure);
 
+namespace grpc_core {
+
+/* While a CallBatchScope is alive, the batches that grpc_call_start_batch()
+   starts on its thread are held in its exec_ctx and handed on together when
+   it is destroyed. The batches of many calls then reach their transports at
+   once, and an http2 transport sends all of their frames in one write. Their
+   completions are held back as well, so the thread must not wait for them
+   inside the scope. */
+class CallBatchScope {
+ public:
+  CallBatchScope() : exec_ctx_(GRPC_EXEC_CTX_FLAG_HOLDS_CALL_BATCHES) {}
+
+ private:
+  ApplicationCallbackExecCtx callback_exec_ctx_;
+  ExecCtx exec_ctx_;
+};
+
+}  // namespace grpc_core
+
 /* gRPC core internal version of grpc_call_cancel that does not create
  * exec_ctx. */
 void grpc_call_cancel_internal(grpc_call* call);
@@ -97,8 +97,10 @@ grpc_channel* grpc_channel_create_with_builder(
       &channel->call_size_estimate,
       (gpr_atm)CHANNEL_STACK_FROM_CHANNEL(channel)->call_stack_size +
           grpc_call_get_initial_size_estimate());
+  channel->call_arena_pool = grpc_core::New<grpc_core::ArenaPool>();
 
   grpc_compression_options_init(&channel->compression_options);
+  channel->offload_decompression_threshold = 0;
   for (size_t i = 0; i < args->num_args; i++) {
     if (0 ==
         strcmp(args->args[i].key, GRPC_COMPRESSION_CHANNEL_DEFAULT_LEVEL)) {
@@ -121,6 +123,12 @@ grpc_channel* grpc_channel_create_with_builder(
       channel->compression_options.enabled_algorithms_bitset =
           static_cast<uint32_t>(args->args[i].value.integer) |
           0x1; /* always support no compression */
+    } else if (0 ==
+               strcmp(args->args[i].key,
+                      GRPC_COMPRESSION_CHANNEL_DECOMPRESS_OFFLOAD_THRESHOLD)) {
+      channel->offload_decompression_threshold =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &args->args[i], {0, 0, INT_MAX}));
     } else if (0 == strcmp(args->args[i].key, GRPC_ARG_CHANNELZ_CHANNEL_NODE)) {
       GPR_ASSERT(args->args[i].type == GRPC_ARG_POINTER);
       GPR_ASSERT(args->args[i].value.pointer.p != nullptr);
@@ -487,6 +495,7 @@ static void destroy_channel(void* arg, grpc_error* error) {
                             GRPC_RESOURCE_QUOTA_CHANNEL_SIZE);
   }
   gpr_mu_destroy(&channel->registered_call_mu);
+  grpc_core::Delete(channel->call_arena_pool);
   gpr_free(channel->target);
   gpr_free(channel);
   // See comment in grpc_channel_create() for why we do this.
@@ -24,6 +24,7 @@
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gprpp/arena.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 
 grpc_channel* grpc_channel_create(const char* target,
@@ -81,8 +82,13 @@ struct registered_call;
 struct grpc_channel {
   int is_client;
   grpc_compression_options compression_options;
+  // Messages at least this large are decompressed on the executor; 0 for
+  // none.
+  uint32_t offload_decompression_threshold;
 
   gpr_atm call_size_estimate;
+  // Recycles call arenas, whose size follows call_size_estimate.
+  grpc_core::ArenaPool* call_arena_pool;
   grpc_resource_user* resource_user;
 
   gpr_mu registered_call_mu;
@@ -99,6 +105,11 @@ inline grpc_compression_options grpc_channel_compression_options(
   return channel->compression_options;
 }
 
+inline uint32_t grpc_channel_offload_decompression_threshold(
+    const grpc_channel* channel) {
+  return channel->offload_decompression_threshold;
+}
+
 inline grpc_channel_stack* grpc_channel_get_channel_stack(
     grpc_channel* channel) {
   return CHANNEL_STACK_FROM_CHANNEL(channel);
@@ -25,6 +25,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
@@ -33,6 +34,7 @@
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/pollset.h"
@@ -55,6 +57,9 @@ namespace {
 // NOTE: Only one event will ever be cached.
 GPR_TLS_DECL(g_cached_event);
 GPR_TLS_DECL(g_cached_cq);
+// The completion queue this thread is in grpc_completion_queue_next() or
+// grpc_completion_queue_pluck() for, if any.
+GPR_TLS_DECL(g_polling_cq);
 
 typedef struct {
   grpc_pollset_worker** worker;
@@ -240,11 +245,69 @@ class CqEventQueue {
   grpc_core::Atomic<intptr_t> num_queue_items_{0};
 };
 
-struct cq_next_data {
-  ~cq_next_data() { GPR_ASSERT(queue.num_items() == 0); }
+/* A set of CqEventQueues, one per core. Completions are pushed to the shard of
+ * the core the producer runs on, and consumers pop from the shard of their own
+ * core first, stealing from the other shards only when it is empty. Pollers on
+ * different cores therefore rarely contend on the same queue lock.
+ * Only used in completion queues whose completion_type is GRPC_CQ_NEXT_SHARDED
+ */
+class ShardedCqEventQueue {
+ public:
+  ShardedCqEventQueue()
+      : num_shards_(GPR_CLAMP(gpr_cpu_num_cores(), 1, kMaxShards)) {
+    shards_ = static_cast<Shard*>(gpr_malloc(sizeof(Shard) * num_shards_));
+    for (size_t i = 0; i < num_shards_; i++) {
+      new (&shards_[i]) Shard();
+    }
+  }
+  ~ShardedCqEventQueue() {
+    for (size_t i = 0; i < num_shards_; i++) {
+      shards_[i].~Shard();
+    }
+    gpr_free(shards_);
+  }
+
+  /* Note: Like CqEventQueue::num_items(), this is only eventually consistent */
+  intptr_t num_items() const {
+    intptr_t n = 0;
+    for (size_t i = 0; i < num_shards_; i++) {
+      n += shards_[i].queue.num_items();
+    }
+    return n;
+  }
 
-  /** Completed events for completion-queues of type GRPC_CQ_NEXT */
-  CqEventQueue queue;
+  /* Returns true if the producer's shard was empty */
+  bool Push(grpc_cq_completion* c) {
+    return shards_[current_shard()].queue.Push(c);
+  }
+  grpc_cq_completion* Pop();
+
+ private:
+  static constexpr size_t kMaxShards = 64;
+
+  struct Shard {
+    CqEventQueue queue;
+    /* Keeps the hot queue tails of neighbouring shards on separate lines */
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  size_t current_shard() const {
+    return static_cast<size_t>(gpr_cpu_current_cpu()) % num_shards_;
+  }
+
+  const size_t num_shards_;
+  Shard* shards_;
+};
+
+constexpr size_t ShardedCqEventQueue::kMaxShards;
+
+template <typename EventQueue>
+struct cq_next_data_t {
+  ~cq_next_data_t() { GPR_ASSERT(queue.num_items() == 0); }
+
+  /** Completed events for completion-queues of type GRPC_CQ_NEXT or
+      GRPC_CQ_NEXT_SHARDED */
+  EventQueue queue;
 
   /** Counter of how many things have ever been queued on this completion queue
       useful for avoiding locks to check the queue */
@@ -258,6 +321,9 @@ struct cq_next_data {
   bool shutdown_called = false;
 };
 
+typedef cq_next_data_t<CqEventQueue> cq_next_data;
+typedef cq_next_data_t<ShardedCqEventQueue> cq_sharded_next_data;
+
 struct cq_pluck_data {
   cq_pluck_data() {
     completed_tail = &completed_head;
@@ -313,6 +379,10 @@ struct cq_callback_data {
 
   /** A callback that gets invoked when the CQ completes shutdown */
   grpc_experimental_completion_queue_functor* shutdown_callback;
+
+  /** Whether callbacks run on the thread that completed their operation,
+      when it can run them, rather than being handed to the executor */
+  bool inline_callbacks = false;
 };
 
 }  // namespace
@@ -338,13 +408,16 @@ struct grpc_completion_queue {
 };
 
 /* Forward declarations */
+template <typename NextData>
 static void cq_finish_shutdown_next(grpc_completion_queue* cq);
 static void cq_finish_shutdown_pluck(grpc_completion_queue* cq);
 static void cq_finish_shutdown_callback(grpc_completion_queue* cq);
+template <typename NextData>
 static void cq_shutdown_next(grpc_completion_queue* cq);
 static void cq_shutdown_pluck(grpc_completion_queue* cq);
 static void cq_shutdown_callback(grpc_completion_queue* cq);
 
+template <typename NextData>
 static bool cq_begin_op_for_next(grpc_completion_queue* cq, void* tag);
 static bool cq_begin_op_for_pluck(grpc_completion_queue* cq, void* tag);
 static bool cq_begin_op_for_callback(grpc_completion_queue* cq, void* tag);
@@ -355,6 +428,7 @@ static bool cq_begin_op_for_callback(grpc_completion_queue* cq, void* tag);
 // queue. The done argument is a callback that will be invoked when it is
 // safe to free up that storage. The storage MUST NOT be freed until the
 // done callback is invoked.
+template <typename NextData>
 static void cq_end_op_for_next(
     grpc_completion_queue* cq, void* tag, grpc_error* error,
     void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
@@ -370,6 +444,7 @@ static void cq_end_op_for_callback(
     void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
     grpc_cq_completion* storage, bool internal);
 
+template <typename NextData>
 static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
                           void* reserved);
 
@@ -377,12 +452,14 @@ static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
                            gpr_timespec deadline, void* reserved);
 
 // Note that cq_init_next and cq_init_pluck do not use the shutdown_callback
+template <typename NextData>
 static void cq_init_next(
     void* data, grpc_experimental_completion_queue_functor* shutdown_callback);
 static void cq_init_pluck(
     void* data, grpc_experimental_completion_queue_functor* shutdown_callback);
 static void cq_init_callback(
     void* data, grpc_experimental_completion_queue_functor* shutdown_callback);
+template <typename NextData>
 static void cq_destroy_next(void* data);
 static void cq_destroy_pluck(void* data);
 static void cq_destroy_callback(void* data);
@@ -390,9 +467,10 @@ static void cq_destroy_callback(void* data);
 /* Completion queue vtables based on the completion-type */
 static const cq_vtable g_cq_vtable[] = {
     /* GRPC_CQ_NEXT */
-    {GRPC_CQ_NEXT, sizeof(cq_next_data), cq_init_next, cq_shutdown_next,
-     cq_destroy_next, cq_begin_op_for_next, cq_end_op_for_next, cq_next,
-     nullptr},
+    {GRPC_CQ_NEXT, sizeof(cq_next_data), cq_init_next<cq_next_data>,
+     cq_shutdown_next<cq_next_data>, cq_destroy_next<cq_next_data>,
+     cq_begin_op_for_next<cq_next_data>, cq_end_op_for_next<cq_next_data>,
+     cq_next<cq_next_data>, nullptr},
     /* GRPC_CQ_PLUCK */
     {GRPC_CQ_PLUCK, sizeof(cq_pluck_data), cq_init_pluck, cq_shutdown_pluck,
      cq_destroy_pluck, cq_begin_op_for_pluck, cq_end_op_for_pluck, nullptr,
@@ -401,6 +479,14 @@ static const cq_vtable g_cq_vtable[] = {
     {GRPC_CQ_CALLBACK, sizeof(cq_callback_data), cq_init_callback,
      cq_shutdown_callback, cq_destroy_callback, cq_begin_op_for_callback,
      cq_end_op_for_callback, nullptr, nullptr},
+    /* GRPC_CQ_NEXT_SHARDED */
+    {GRPC_CQ_NEXT_SHARDED, sizeof(cq_sharded_next_data),
+     cq_init_next<cq_sharded_next_data>,
+     cq_shutdown_next<cq_sharded_next_data>,
+     cq_destroy_next<cq_sharded_next_data>,
+     cq_begin_op_for_next<cq_sharded_next_data>,
+     cq_end_op_for_next<cq_sharded_next_data>, cq_next<cq_sharded_next_data>,
+     nullptr},
 };
 
 #define DATA_FROM_CQ(cq) ((void*)(cq + 1))
@@ -425,8 +511,29 @@ static void on_pollset_shutdown_done(void* cq, grpc_error* error);
 void grpc_cq_global_init() {
   gpr_tls_init(&g_cached_event);
   gpr_tls_init(&g_cached_cq);
+  gpr_tls_init(&g_polling_cq);
 }
 
+grpc_completion_queue* grpc_cq_polling_cq() {
+  return reinterpret_cast<grpc_completion_queue*>(gpr_tls_get(&g_polling_cq));
+}
+
+namespace {
+// Records the completion queue polled by the current thread for the lifetime
+// of the object, including the closures flushed when its ExecCtx goes away.
+class PollingCqScope {
+ public:
+  explicit PollingCqScope(grpc_completion_queue* cq)
+      : prev_(gpr_tls_get(&g_polling_cq)) {
+    gpr_tls_set(&g_polling_cq, reinterpret_cast<intptr_t>(cq));
+  }
+  ~PollingCqScope() { gpr_tls_set(&g_polling_cq, prev_); }
+
+ private:
+  intptr_t prev_;
+};
+}  // namespace
+
 void grpc_completion_queue_thread_local_cache_init(grpc_completion_queue* cq) {
   if ((grpc_completion_queue*)gpr_tls_get(&g_cached_cq) == nullptr) {
     gpr_tls_set(&g_cached_event, (intptr_t)0);
@@ -434,6 +541,19 @@ void grpc_completion_queue_thread_local_cache_init(grpc_completion_queue* cq) {
   }
 }
 
+/* Releases the pending event that a cached completion was holding */
+template <typename NextData>
+static void cq_release_cached_event(grpc_completion_queue* cq) {
+  NextData* cqd = static_cast<NextData*> DATA_FROM_CQ(cq);
+  if (cqd->pending_events.FetchSub(1, grpc_core::MemoryOrder::ACQ_REL) == 1) {
+    GRPC_CQ_INTERNAL_REF(cq, "shutting_down");
+    gpr_mu_lock(cq->mu);
+    cq_finish_shutdown_next<NextData>(cq);
+    gpr_mu_unlock(cq->mu);
+    GRPC_CQ_INTERNAL_UNREF(cq, "shutting_down");
+  }
+}
+
 int grpc_completion_queue_thread_local_cache_flush(grpc_completion_queue* cq,
                                                    void** tag, int* ok) {
   grpc_cq_completion* storage =
@@ -446,13 +566,10 @@ int grpc_completion_queue_thread_local_cache_flush(grpc_completion_queue* cq,
     *ok = (storage->next & static_cast<uintptr_t>(1)) == 1;
     storage->done(storage->done_arg, storage);
     ret = 1;
-    cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
-    if (cqd->pending_events.FetchSub(1, grpc_core::MemoryOrder::ACQ_REL) == 1) {
-      GRPC_CQ_INTERNAL_REF(cq, "shutting_down");
-      gpr_mu_lock(cq->mu);
-      cq_finish_shutdown_next(cq);
-      gpr_mu_unlock(cq->mu);
-      GRPC_CQ_INTERNAL_UNREF(cq, "shutting_down");
+    if (cq->vtable->cq_completion_type == GRPC_CQ_NEXT_SHARDED) {
+      cq_release_cached_event<cq_sharded_next_data>(cq);
+    } else {
+      cq_release_cached_event<cq_next_data>(cq);
     }
   }
   gpr_tls_set(&g_cached_event, (intptr_t)0);
@@ -491,6 +608,21 @@ grpc_cq_completion* CqEventQueue::Pop() {
   return c;
 }
 
+grpc_cq_completion* ShardedCqEventQueue::Pop() {
+  size_t start = current_shard();
+  grpc_cq_completion* c = shards_[start].queue.Pop();
+  if (c != nullptr) return c;
+  /* Our own shard is empty (or contended): steal from the other shards,
+   * skipping the ones that look empty to avoid touching their locks */
+  for (size_t i = 1; i < num_shards_; i++) {
+    Shard& victim = shards_[(start + i) % num_shards_];
+    if (victim.queue.num_items() == 0) continue;
+    c = victim.queue.Pop();
+    if (c != nullptr) return c;
+  }
+  return nullptr;
+}
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
     grpc_experimental_completion_queue_functor* shutdown_callback) {
@@ -528,14 +660,16 @@ grpc_completion_queue* grpc_completion_queue_create_internal(
   return cq;
 }
 
+template <typename NextData>
 static void cq_init_next(
     void* data, grpc_experimental_completion_queue_functor* shutdown_callback) {
-  new (data) cq_next_data();
+  new (data) NextData();
 }
 
+template <typename NextData>
 static void cq_destroy_next(void* data) {
-  cq_next_data* cqd = static_cast<cq_next_data*>(data);
-  cqd->~cq_next_data();
+  NextData* cqd = static_cast<NextData*>(data);
+  cqd->~NextData();
 }
 
 static void cq_init_pluck(
@@ -633,8 +767,9 @@ static void cq_check_tag(grpc_completion_queue* cq, void* tag, bool lock_cq) {
 static void cq_check_tag(grpc_completion_queue* cq, void* tag, bool lock_cq) {}
 #endif
 
+template <typename NextData>
 static bool cq_begin_op_for_next(grpc_completion_queue* cq, void* tag) {
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+  NextData* cqd = static_cast<NextData*> DATA_FROM_CQ(cq);
   return cqd->pending_events.IncrementIfNonzero();
 }
 
@@ -665,7 +800,8 @@ bool grpc_cq_begin_op(grpc_completion_queue* cq, void* tag) {
 
 /* Queue a GRPC_OP_COMPLETED operation to a completion queue (with a
  * completion
- * type of GRPC_CQ_NEXT) */
+ * type of GRPC_CQ_NEXT or GRPC_CQ_NEXT_SHARDED) */
+template <typename NextData>
 static void cq_end_op_for_next(
     grpc_completion_queue* cq, void* tag, grpc_error* error,
     void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
@@ -685,7 +821,7 @@ static void cq_end_op_for_next(
       gpr_log(GPR_ERROR, "Operation failed: tag=%p, error=%s", tag, errmsg);
     }
   }
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+  NextData* cqd = static_cast<NextData*> DATA_FROM_CQ(cq);
   int is_success = (error == GRPC_ERROR_NONE);
 
   storage->tag = tag;
@@ -725,7 +861,7 @@ static void cq_end_op_for_next(
           1) {
         GRPC_CQ_INTERNAL_REF(cq, "shutting_down");
         gpr_mu_lock(cq->mu);
-        cq_finish_shutdown_next(cq);
+        cq_finish_shutdown_next<NextData>(cq);
         gpr_mu_unlock(cq->mu);
         GRPC_CQ_INTERNAL_UNREF(cq, "shutting_down");
       }
@@ -733,7 +869,7 @@ static void cq_end_op_for_next(
       GRPC_CQ_INTERNAL_REF(cq, "shutting_down");
       cqd->pending_events.Store(0, grpc_core::MemoryOrder::RELEASE);
       gpr_mu_lock(cq->mu);
-      cq_finish_shutdown_next(cq);
+      cq_finish_shutdown_next<NextData>(cq);
       gpr_mu_unlock(cq->mu);
       GRPC_CQ_INTERNAL_UNREF(cq, "shutting_down");
     }
@@ -851,7 +987,12 @@ static void cq_end_op_for_callback(
   }
 
   auto* functor = static_cast<grpc_experimental_completion_queue_functor*>(tag);
-  if (internal || grpc_iomgr_is_any_background_poller_thread()) {
+  // In inline mode, run the callback once the current thread leaves its
+  // outermost ApplicationCallbackExecCtx (and so holds no gRPC locks), if it
+  // has one, rather than taking a hop through the executor.
+  if (internal || grpc_iomgr_is_any_background_poller_thread() ||
+      (cqd->inline_callbacks &&
+       grpc_core::ApplicationCallbackExecCtx::Available())) {
     grpc_core::ApplicationCallbackExecCtx::Enqueue(functor,
                                                    (error == GRPC_ERROR_NONE));
     GRPC_ERROR_UNREF(error);
@@ -883,6 +1024,7 @@ typedef struct {
   bool first_loop;
 } cq_is_finished_arg;
 
+template <typename NextData>
 class ExecCtxNext : public grpc_core::ExecCtx {
  public:
   ExecCtxNext(void* arg) : ExecCtx(0), check_ready_to_finish_arg_(arg) {}
@@ -891,7 +1033,7 @@ class ExecCtxNext : public grpc_core::ExecCtx {
     cq_is_finished_arg* a =
         static_cast<cq_is_finished_arg*>(check_ready_to_finish_arg_);
     grpc_completion_queue* cq = a->cq;
-    cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+    NextData* cqd = static_cast<NextData*> DATA_FROM_CQ(cq);
     GPR_ASSERT(a->stolen_completion == nullptr);
 
     intptr_t current_last_seen_things_queued_ever =
@@ -942,12 +1084,14 @@ static void dump_pending_tags(grpc_completion_queue* cq) {
 static void dump_pending_tags(grpc_completion_queue* cq) {}
 #endif
 
+template <typename NextData>
 static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
                           void* reserved) {
   GPR_TIMER_SCOPE("grpc_completion_queue_next", 0);
+  PollingCqScope polling_cq_scope(cq);
 
   grpc_event ret;
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+  NextData* cqd = static_cast<NextData*> DATA_FROM_CQ(cq);
 
   GRPC_API_TRACE(
       "grpc_completion_queue_next("
@@ -972,7 +1116,7 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
       nullptr,
       nullptr,
       true};
-  ExecCtxNext exec_ctx(&is_finished_arg);
+  ExecCtxNext<NextData> exec_ctx(&is_finished_arg);
   for (;;) {
     grpc_millis iteration_deadline = deadline_millis;
 
@@ -1071,8 +1215,9 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
    - Must be called only once in completion queue's lifetime
    - grpc_completion_queue_shutdown() MUST have been called before calling
    this function */
+template <typename NextData>
 static void cq_finish_shutdown_next(grpc_completion_queue* cq) {
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+  NextData* cqd = static_cast<NextData*> DATA_FROM_CQ(cq);
 
   GPR_ASSERT(cqd->shutdown_called);
   GPR_ASSERT(cqd->pending_events.Load(grpc_core::MemoryOrder::RELAXED) == 0);
@@ -1080,8 +1225,9 @@ static void cq_finish_shutdown_next(grpc_completion_queue* cq) {
   cq->poller_vtable->shutdown(POLLSET_FROM_CQ(cq), &cq->pollset_shutdown_done);
 }
 
+template <typename NextData>
 static void cq_shutdown_next(grpc_completion_queue* cq) {
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+  NextData* cqd = static_cast<NextData*> DATA_FROM_CQ(cq);
 
   /* Need an extra ref for cq here because:
    * We call cq_finish_shutdown_next() below, that would call pollset shutdown.
@@ -1101,7 +1247,7 @@ static void cq_shutdown_next(grpc_completion_queue* cq) {
    * cq_begin_op_for_next and cq_end_op_for_next functions which read/write
    * on this counter without necessarily holding a lock on cq */
   if (cqd->pending_events.FetchSub(1, grpc_core::MemoryOrder::ACQ_REL) == 1) {
-    cq_finish_shutdown_next(cq);
+    cq_finish_shutdown_next<NextData>(cq);
   }
   gpr_mu_unlock(cq->mu);
   GRPC_CQ_INTERNAL_UNREF(cq, "shutting_down");
@@ -1184,6 +1330,7 @@ class ExecCtxPluck : public grpc_core::ExecCtx {
 static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
                            gpr_timespec deadline, void* reserved) {
   GPR_TIMER_SCOPE("grpc_completion_queue_pluck", 0);
+  PollingCqScope polling_cq_scope(cq);
 
   grpc_event ret;
   grpc_cq_completion* c;
@@ -1408,6 +1555,11 @@ void grpc_completion_queue_destroy(grpc_completion_queue* cq) {
   GRPC_CQ_INTERNAL_UNREF(cq, "destroy");
 }
 
+void grpc_cq_set_inline_callbacks(grpc_completion_queue* cq) {
+  GPR_ASSERT(cq->vtable->cq_completion_type == GRPC_CQ_CALLBACK);
+  static_cast<cq_callback_data*>(DATA_FROM_CQ(cq))->inline_callbacks = true;
+}
+
 grpc_pollset* grpc_cq_pollset(grpc_completion_queue* cq) {
   return cq->poller_vtable->can_get_pollset ? POLLSET_FROM_CQ(cq) : nullptr;
 }
@@ -82,6 +82,16 @@ void grpc_cq_end_op(grpc_completion_queue* cc, void* tag, grpc_error* error,
 
 grpc_pollset* grpc_cq_pollset(grpc_completion_queue* cc);
 
+/* Makes the callbacks of callback completion queue \a cc run on the thread
+   that completes their operation, when that thread can run them, instead of
+   on the executor. Only for callbacks that do not block. */
+void grpc_cq_set_inline_callbacks(grpc_completion_queue* cc);
+
+/* Returns the completion queue that the calling thread is polling in
+   grpc_completion_queue_next() or grpc_completion_queue_pluck(), or null if
+   it is not polling one */
+grpc_completion_queue* grpc_cq_polling_cq();
+
 bool grpc_cq_can_listen(grpc_completion_queue* cc);
 
 grpc_cq_completion_type grpc_get_cq_completion_type(grpc_completion_queue* cc);
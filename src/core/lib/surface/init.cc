@@ -26,14 +26,18 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
+#include "src/core/lib/channel/call_latency_breakdown.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channelz_registry.h"
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/channel/handshaker_registry.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/mu_contention.h"
 #include "src/core/lib/gprpp/fork.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/http/httpcli.h"
 #include "src/core/lib/http/parser.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/combiner.h"
@@ -135,9 +139,11 @@ void grpc_init(void) {
     grpc_fork_handlers_auto_register();
     grpc_stats_init();
     grpc_slice_intern_init();
+    grpc_slice_slab_allocator_init();
     grpc_mdctx_global_init();
     grpc_channel_init_init();
     grpc_core::channelz::ChannelzRegistry::Init();
+    grpc_core::CallLatencyBreakdown::Init();
     grpc_security_pre_init();
     grpc_core::ApplicationCallbackExecCtx::GlobalInit();
     grpc_core::ExecCtx::GlobalInit();
@@ -171,11 +177,13 @@ void grpc_shutdown_internal_locked(void) {
     {
       grpc_timer_manager_set_threading(false);  // shutdown timer_manager thread
       grpc_core::Executor::ShutdownAll();
+      grpc_security_shutdown();
       for (i = g_number_of_plugins; i >= 0; i--) {
         if (g_all_of_the_plugins[i].destroy != nullptr) {
           g_all_of_the_plugins[i].destroy();
         }
       }
+      grpc_httpcli_shutdown();
     }
     grpc_iomgr_shutdown();
     gpr_timers_global_destroy();
@@ -183,9 +191,12 @@ void grpc_shutdown_internal_locked(void) {
     grpc_mdctx_global_shutdown();
     grpc_core::HandshakerRegistry::Shutdown();
     grpc_slice_intern_shutdown();
+    grpc_slice_slab_allocator_shutdown();
     grpc_core::channelz::ChannelzRegistry::Shutdown();
     grpc_stats_shutdown();
+    grpc_msg_compress_shutdown();
     grpc_core::Fork::GlobalShutdown();
+    if (gpr_mu_contention_profiling_enabled()) gpr_mu_contention_dump(20);
   }
   grpc_core::ExecCtx::GlobalShutdown();
   grpc_core::ApplicationCallbackExecCtx::GlobalShutdown();
@@ -82,3 +82,7 @@ void grpc_security_init() {
   grpc_core::SecurityRegisterHandshakerFactories();
   grpc_control_plane_credentials_init();
 }
+
+void grpc_security_shutdown() {
+  grpc_core::SecurityHandshakerOffloadShutdown();
+}
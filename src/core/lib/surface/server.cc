@@ -21,6 +21,7 @@
 #include "src/core/lib/surface/server.h"
 
 #include <limits.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -91,10 +92,15 @@ struct requested_call {
   } data;
 };
 
+/* A slot in the server's registered method table.  The table is built once
+   by grpc_server_start and shared, read-only, by every channel. */
 struct channel_registered_method {
   registered_method* server_registered_method;
   uint32_t flags;
   bool has_host;
+  /* GRPC_MDSTR_KV_HASH of host (0 when !has_host) and method: compared
+     before the strings so that probing rarely touches them */
+  uint32_t hash;
   grpc_slice method;
   grpc_slice host;
 };
@@ -107,9 +113,6 @@ struct channel_data {
   /* linked list of all channels on a server */
   channel_data* next;
   channel_data* prev;
-  channel_registered_method* registered_methods;
-  uint32_t registered_method_slots;
-  uint32_t registered_method_max_probes;
   grpc_closure finish_destroy_channel_closure;
   grpc_closure channel_connectivity_changed;
   intptr_t channelz_socket_uuid;
@@ -191,14 +194,25 @@ struct call_data {
   grpc_closure publish;
 
   call_data* pending_next = nullptr;
+  /* when the call was added to its request matcher's pending list */
+  grpc_millis queued_at = 0;
   grpc_core::CallCombiner* call_combiner;
 };
 
 struct request_matcher {
   grpc_server* server;
+  /* guards the pending list. Each method has its own, so that calls to
+     different methods queue and match without contending for a lock. */
+  gpr_mu mu;
   call_data* pending_head;
   call_data* pending_tail;
   gpr_locked_mpscq* requests_per_cq;
+  /* CoDel state for shedding pending calls (see should_shed_pending_call),
+     guarded by mu */
+  grpc_millis first_above_time;
+  grpc_millis shed_next;
+  uint32_t shed_count;
+  bool shedding;
 };
 
 struct registered_method {
@@ -230,11 +244,14 @@ struct grpc_server {
 
   /* The two following mutexes control access to server-state
      mu_global controls access to non-call-related state (e.g., channel state)
-     mu_call controls access to call-related state (e.g., the call lists)
+     mu_call serializes the killing of pending calls and requests at shutdown;
+     the pending call lists themselves are guarded by their request matcher's
+     mu
 
      If they are ever required to be nested, you must lock mu_global
-     before mu_call. This is currently used in shutdown processing
-     (grpc_server_shutdown_and_notify and maybe_finish_shutdown) */
+     before mu_call, and mu_call before a request matcher's mu. This is
+     currently used in shutdown processing (grpc_server_shutdown_and_notify
+     and maybe_finish_shutdown) */
   gpr_mu mu_global; /* mutex for server and channel state */
   gpr_mu mu_call;   /* mutex for call-specific state */
 
@@ -244,6 +261,11 @@ struct grpc_server {
   gpr_cv starting_cv;
 
   registered_method* registered_methods;
+  /** open addressing table over registered_methods, built at start; its size
+      is a power of two */
+  channel_registered_method* registered_method_table;
+  uint32_t registered_method_slots;
+  uint32_t registered_method_max_probes;
   /** one request matcher for unregistered methods */
   request_matcher unregistered_request_matcher;
 
@@ -262,6 +284,11 @@ struct grpc_server {
   gpr_timespec last_shutdown_message_time;
 
   grpc_core::RefCountedPtr<grpc_core::channelz::ServerNode> channelz_server;
+
+  /* GRPC_ARG_SERVER_QUEUE_DELAY_TARGET_MS (0 disables shedding) and
+     GRPC_ARG_SERVER_QUEUE_DELAY_INTERVAL_MS */
+  grpc_millis queue_delay_target;
+  grpc_millis queue_delay_interval;
 };
 
 #define SERVER_FROM_CALL_ELEM(elem) \
@@ -349,7 +376,12 @@ static void channel_broadcaster_shutdown(channel_broadcaster* cb,
 
 static void request_matcher_init(request_matcher* rm, grpc_server* server) {
   rm->server = server;
+  gpr_mu_init(&rm->mu);
   rm->pending_head = rm->pending_tail = nullptr;
+  rm->first_above_time = 0;
+  rm->shed_next = 0;
+  rm->shed_count = 0;
+  rm->shedding = false;
   rm->requests_per_cq = static_cast<gpr_locked_mpscq*>(
       gpr_malloc(sizeof(*rm->requests_per_cq) * server->cq_count));
   for (size_t i = 0; i < server->cq_count; i++) {
@@ -363,6 +395,7 @@ static void request_matcher_destroy(request_matcher* rm) {
     gpr_locked_mpscq_destroy(&rm->requests_per_cq[i]);
   }
   gpr_free(rm->requests_per_cq);
+  gpr_mu_destroy(&rm->mu);
 }
 
 static void kill_zombie(void* elem, grpc_error* error) {
@@ -370,7 +403,66 @@ static void kill_zombie(void* elem, grpc_error* error) {
       grpc_call_from_top_element(static_cast<grpc_call_element*>(elem)));
 }
 
+/* Decides, following CoDel (RFC 8289), whether the call at the head of rm's
+   pending list, which is about to be matched after waiting since queued_at,
+   should be shed instead. Calls are shed once the wait has stayed above the
+   target for an interval, one per interval / sqrt(shed_count) while it stays
+   above, so that the wait of the accepted calls is brought back to the target.
+   Requires rm->mu. */
+static bool should_shed_pending_call(grpc_server* server, request_matcher* rm,
+                                     grpc_millis queued_at, grpc_millis now) {
+  const grpc_millis target = server->queue_delay_target;
+  const grpc_millis interval = server->queue_delay_interval;
+  if (target == 0) return false;
+  bool ok_to_shed = false;
+  if (now - queued_at < target) {
+    rm->first_above_time = 0;
+  } else if (rm->first_above_time == 0) {
+    rm->first_above_time = now + interval;
+  } else if (now >= rm->first_above_time) {
+    ok_to_shed = true;
+  }
+  if (rm->shedding) {
+    if (!ok_to_shed) {
+      rm->shedding = false;
+      return false;
+    }
+    if (now < rm->shed_next) return false;
+    rm->shed_count++;
+  } else {
+    if (!ok_to_shed) return false;
+    rm->shedding = true;
+    /* If shedding stopped only recently, resume near the rate it had reached
+       rather than starting over */
+    rm->shed_count =
+        rm->shed_count > 2 && now - rm->shed_next < 8 * interval
+            ? rm->shed_count - 2
+            : 1;
+    rm->shed_next = now;
+  }
+  const double spacing =
+      static_cast<double>(interval) / sqrt(static_cast<double>(rm->shed_count));
+  rm->shed_next += static_cast<grpc_millis>(spacing);
+  return true;
+}
+
+/* Fails a call taken off a pending list with RESOURCE_EXHAUSTED, and drops
+   the server's ref to it */
+static void shed_pending_call(call_data* calld) {
+  if (gpr_atm_full_cas(&calld->state, PENDING, ZOMBIED)) {
+    GRPC_STATS_INC_SERVER_REQUESTS_SHED();
+    grpc_call_cancel_with_status(calld->call, GRPC_STATUS_RESOURCE_EXHAUSTED,
+                                 "Server queueing delay too high", nullptr);
+  }
+  GRPC_CLOSURE_INIT(
+      &calld->kill_zombie_closure, kill_zombie,
+      grpc_call_stack_element(grpc_call_get_call_stack(calld->call), 0),
+      grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_SCHED(&calld->kill_zombie_closure, GRPC_ERROR_NONE);
+}
+
 static void request_matcher_zombify_all_pending_calls(request_matcher* rm) {
+  gpr_mu_lock(&rm->mu);
   while (rm->pending_head) {
     call_data* calld = rm->pending_head;
     rm->pending_head = calld->pending_next;
@@ -381,6 +473,7 @@ static void request_matcher_zombify_all_pending_calls(request_matcher* rm) {
         grpc_schedule_on_exec_ctx);
     GRPC_CLOSURE_SCHED(&calld->kill_zombie_closure, GRPC_ERROR_NONE);
   }
+  gpr_mu_unlock(&rm->mu);
 }
 
 static void request_matcher_kill_requests(grpc_server* server,
@@ -410,6 +503,7 @@ static void server_delete(grpc_server* server) {
   gpr_mu_destroy(&server->mu_global);
   gpr_mu_destroy(&server->mu_call);
   gpr_cv_destroy(&server->starting_cv);
+  gpr_free(server->registered_method_table);
   while ((rm = server->registered_methods) != nullptr) {
     server->registered_methods = rm->next;
     if (server->started) {
@@ -515,6 +609,30 @@ static void publish_call(grpc_server* server, call_data* calld, size_t cq_idx,
                  rc, &rc->completion, true);
 }
 
+/* Sets *cq_idx to the index of the completion queue polled by the calling
+   thread, if it is one of the server's; returns false otherwise. Calls are
+   matched with requests from that queue first, so that they are processed by
+   the thread (and on the core) that read them. */
+static bool get_polling_cq_idx(grpc_server* server, size_t* cq_idx) {
+  grpc_completion_queue* polling_cq = grpc_cq_polling_cq();
+  if (polling_cq == nullptr) return false;
+  for (size_t i = 0; i < server->cq_count; i++) {
+    if (server->cqs[i] == polling_cq) {
+      *cq_idx = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void count_match(bool polled, size_t polling_cq_idx, size_t cq_idx) {
+  if (polled && cq_idx == polling_cq_idx) {
+    GRPC_STATS_INC_SERVER_REQUESTS_MATCHED_LOCALLY();
+  } else {
+    GRPC_STATS_INC_SERVER_REQUESTS_MATCHED_REMOTELY();
+  }
+}
+
 static void publish_new_rpc(void* arg, grpc_error* error) {
   grpc_call_element* call_elem = static_cast<grpc_call_element*>(arg);
   call_data* calld = static_cast<call_data*>(call_elem->call_data);
@@ -532,14 +650,18 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
     return;
   }
 
+  size_t polling_cq_idx = 0;
+  const bool polled = get_polling_cq_idx(server, &polling_cq_idx);
+  const size_t start_cq_idx = polled ? polling_cq_idx : chand->cq_idx;
   for (size_t i = 0; i < server->cq_count; i++) {
-    size_t cq_idx = (chand->cq_idx + i) % server->cq_count;
+    size_t cq_idx = (start_cq_idx + i) % server->cq_count;
     requested_call* rc = reinterpret_cast<requested_call*>(
         gpr_locked_mpscq_try_pop(&rm->requests_per_cq[cq_idx]));
     if (rc == nullptr) {
       continue;
     } else {
       GRPC_STATS_INC_SERVER_CQS_CHECKED(i);
+      count_match(polled, polling_cq_idx, cq_idx);
       gpr_atm_no_barrier_store(&calld->state, ACTIVATED);
       publish_call(server, calld, cq_idx, rc);
       return; /* early out */
@@ -548,21 +670,22 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
 
   /* no cq to take the request found: queue it on the slow list */
   GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED();
-  gpr_mu_lock(&server->mu_call);
+  gpr_mu_lock(&rm->mu);
 
   // We need to ensure that all the queues are empty.  We do this under
-  // the server mu_call lock to ensure that if something is added to
+  // the request matcher's lock to ensure that if something is added to
   // an empty request queue, it will block until the call is actually
   // added to the pending list.
   for (size_t i = 0; i < server->cq_count; i++) {
-    size_t cq_idx = (chand->cq_idx + i) % server->cq_count;
+    size_t cq_idx = (start_cq_idx + i) % server->cq_count;
     requested_call* rc = reinterpret_cast<requested_call*>(
         gpr_locked_mpscq_pop(&rm->requests_per_cq[cq_idx]));
     if (rc == nullptr) {
       continue;
     } else {
-      gpr_mu_unlock(&server->mu_call);
+      gpr_mu_unlock(&rm->mu);
       GRPC_STATS_INC_SERVER_CQS_CHECKED(i + server->cq_count);
+      count_match(polled, polling_cq_idx, cq_idx);
       gpr_atm_no_barrier_store(&calld->state, ACTIVATED);
       publish_call(server, calld, cq_idx, rc);
       return; /* early out */
@@ -570,6 +693,7 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
   }
 
   gpr_atm_no_barrier_store(&calld->state, PENDING);
+  calld->queued_at = grpc_core::ExecCtx::Get()->Now();
   if (rm->pending_head == nullptr) {
     rm->pending_tail = rm->pending_head = calld;
   } else {
@@ -577,7 +701,7 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
     rm->pending_tail = calld;
   }
   calld->pending_next = nullptr;
-  gpr_mu_unlock(&server->mu_call);
+  gpr_mu_unlock(&rm->mu);
 }
 
 static void finish_start_new_rpc(
@@ -613,48 +737,49 @@ static void finish_start_new_rpc(
   }
 }
 
+/* Returns the entry registered for host (or for any host when !has_host) and
+   path, or nullptr. */
+static channel_registered_method* find_registered_method(
+    grpc_server* server, bool has_host, const grpc_slice& host,
+    const grpc_slice& path, uint32_t recv_initial_metadata_flags) {
+  const uint32_t hash =
+      GRPC_MDSTR_KV_HASH(has_host ? grpc_slice_hash_internal(host) : 0,
+                         grpc_slice_hash_internal(path));
+  const uint32_t mask = server->registered_method_slots - 1;
+  for (uint32_t i = 0; i <= server->registered_method_max_probes; i++) {
+    channel_registered_method* rm =
+        &server->registered_method_table[(hash + i) & mask];
+    /* entries are never removed, so an empty slot ends the probe sequence */
+    if (rm->server_registered_method == nullptr) break;
+    if (rm->hash != hash || rm->has_host != has_host) continue;
+    if (has_host && !grpc_slice_eq(rm->host, host)) continue;
+    if (!grpc_slice_eq(rm->method, path)) continue;
+    if ((rm->flags & GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST) &&
+        0 == (recv_initial_metadata_flags &
+              GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
+      continue;
+    }
+    return rm;
+  }
+  return nullptr;
+}
+
 static void start_new_rpc(grpc_call_element* elem) {
   channel_data* chand = static_cast<channel_data*>(elem->channel_data);
   call_data* calld = static_cast<call_data*>(elem->call_data);
   grpc_server* server = chand->server;
-  uint32_t i;
-  uint32_t hash;
-  channel_registered_method* rm;
-
-  if (chand->registered_methods && calld->path_set && calld->host_set) {
-    /* TODO(ctiller): unify these two searches */
-    /* check for an exact match with host */
-    hash = GRPC_MDSTR_KV_HASH(grpc_slice_hash_internal(calld->host),
-                              grpc_slice_hash_internal(calld->path));
-    for (i = 0; i <= chand->registered_method_max_probes; i++) {
-      rm = &chand->registered_methods[(hash + i) %
-                                      chand->registered_method_slots];
-      if (!rm) break;
-      if (!rm->has_host) continue;
-      if (!grpc_slice_eq(rm->host, calld->host)) continue;
-      if (!grpc_slice_eq(rm->method, calld->path)) continue;
-      if ((rm->flags & GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST) &&
-          0 == (calld->recv_initial_metadata_flags &
-                GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
-        continue;
-      }
-      finish_start_new_rpc(server, elem, &rm->server_registered_method->matcher,
-                           rm->server_registered_method->payload_handling);
-      return;
+
+  if (server->registered_method_table && calld->path_set && calld->host_set) {
+    /* check for an exact match with host, then for a wildcard method
+       definition (no host set) */
+    channel_registered_method* rm =
+        find_registered_method(server, true, calld->host, calld->path,
+                               calld->recv_initial_metadata_flags);
+    if (rm == nullptr) {
+      rm = find_registered_method(server, false, calld->host, calld->path,
+                                  calld->recv_initial_metadata_flags);
     }
-    /* check for a wildcard method definition (no host set) */
-    hash = GRPC_MDSTR_KV_HASH(0, grpc_slice_hash_internal(calld->path));
-    for (i = 0; i <= chand->registered_method_max_probes; i++) {
-      rm = &chand->registered_methods[(hash + i) %
-                                      chand->registered_method_slots];
-      if (!rm) break;
-      if (rm->has_host) continue;
-      if (!grpc_slice_eq(rm->method, calld->path)) continue;
-      if ((rm->flags & GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST) &&
-          0 == (calld->recv_initial_metadata_flags &
-                GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
-        continue;
-      }
+    if (rm != nullptr) {
       finish_start_new_rpc(server, elem, &rm->server_registered_method->matcher,
                            rm->server_registered_method->payload_handling);
       return;
@@ -930,7 +1055,6 @@ static grpc_error* init_channel_elem(grpc_channel_element* elem,
   chand->server = nullptr;
   chand->channel = nullptr;
   chand->next = chand->prev = chand;
-  chand->registered_methods = nullptr;
   chand->connectivity_state = GRPC_CHANNEL_IDLE;
   GRPC_CLOSURE_INIT(&chand->channel_connectivity_changed,
                     channel_connectivity_changed, chand,
@@ -939,17 +1063,7 @@ static grpc_error* init_channel_elem(grpc_channel_element* elem,
 }
 
 static void destroy_channel_elem(grpc_channel_element* elem) {
-  size_t i;
   channel_data* chand = static_cast<channel_data*>(elem->channel_data);
-  if (chand->registered_methods) {
-    for (i = 0; i < chand->registered_method_slots; i++) {
-      grpc_slice_unref_internal(chand->registered_methods[i].method);
-      if (chand->registered_methods[i].has_host) {
-        grpc_slice_unref_internal(chand->registered_methods[i].host);
-      }
-    }
-    gpr_free(chand->registered_methods);
-  }
   if (chand->server) {
     if (chand->server->channelz_server != nullptr &&
         chand->channelz_socket_uuid != 0) {
@@ -1004,7 +1118,8 @@ void grpc_server_register_completion_queue(grpc_server* server,
       (server, cq, reserved));
 
   auto cq_type = grpc_get_cq_completion_type(cq);
-  if (cq_type != GRPC_CQ_NEXT && cq_type != GRPC_CQ_CALLBACK) {
+  if (cq_type != GRPC_CQ_NEXT && cq_type != GRPC_CQ_NEXT_SHARDED &&
+      cq_type != GRPC_CQ_CALLBACK) {
     gpr_log(GPR_INFO,
             "Completion queue of type %d is being registered as a "
             "server-completion-queue",
@@ -1049,6 +1164,13 @@ grpc_server* grpc_server_create(const grpc_channel_args* args, void* reserved) {
         grpc_slice_from_static_string("Server created"));
   }
 
+  server->queue_delay_target = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args, GRPC_ARG_SERVER_QUEUE_DELAY_TARGET_MS),
+      {0, 0, INT_MAX});
+  server->queue_delay_interval = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args, GRPC_ARG_SERVER_QUEUE_DELAY_INTERVAL_MS),
+      {100, 1, INT_MAX});
+
   if (args != nullptr) {
     grpc_resource_quota* resource_quota =
         grpc_resource_quota_from_channel_args(args, false /* create */);
@@ -1104,6 +1226,51 @@ void* grpc_server_register_method(
   return m;
 }
 
+/* Builds the table start_new_rpc looks registered methods up in.  The
+   method and host slices point into the registered_method strings, which
+   outlive the table. */
+static void build_registered_method_table(grpc_server* server) {
+  size_t num_registered_methods = 0;
+  for (registered_method* rm = server->registered_methods; rm;
+       rm = rm->next) {
+    num_registered_methods++;
+  }
+  if (num_registered_methods == 0) return;
+  size_t slots = 1;
+  while (slots < 2 * num_registered_methods) slots *= 2;
+  GPR_ASSERT(slots <= UINT32_MAX);
+  const uint32_t mask = static_cast<uint32_t>(slots - 1);
+  server->registered_method_table = static_cast<channel_registered_method*>(
+      gpr_zalloc(sizeof(channel_registered_method) * slots));
+  uint32_t max_probes = 0;
+  for (registered_method* rm = server->registered_methods; rm;
+       rm = rm->next) {
+    const bool has_host = rm->host != nullptr;
+    grpc_slice host =
+        has_host ? grpc_slice_from_static_string(rm->host) : grpc_empty_slice();
+    grpc_slice method = grpc_slice_from_static_string(rm->method);
+    uint32_t hash =
+        GRPC_MDSTR_KV_HASH(has_host ? grpc_slice_hash_internal(host) : 0,
+                           grpc_slice_hash_internal(method));
+    uint32_t probes = 0;
+    while (server->registered_method_table[(hash + probes) & mask]
+               .server_registered_method != nullptr) {
+      probes++;
+    }
+    if (probes > max_probes) max_probes = probes;
+    channel_registered_method* crm =
+        &server->registered_method_table[(hash + probes) & mask];
+    crm->server_registered_method = rm;
+    crm->flags = rm->flags;
+    crm->has_host = has_host;
+    crm->hash = hash;
+    crm->host = host;
+    crm->method = method;
+  }
+  server->registered_method_slots = static_cast<uint32_t>(slots);
+  server->registered_method_max_probes = max_probes;
+}
+
 void grpc_server_start(grpc_server* server) {
   size_t i;
   grpc_core::ExecCtx exec_ctx;
@@ -1114,16 +1281,25 @@ void grpc_server_start(grpc_server* server) {
   server->pollset_count = 0;
   server->pollsets = static_cast<grpc_pollset**>(
       gpr_malloc(sizeof(grpc_pollset*) * server->cq_count));
+  const int busy_poll_us = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(server->channel_args,
+                             GRPC_ARG_SERVER_BUSY_POLL_US),
+      {0, 0, INT_MAX});
   for (i = 0; i < server->cq_count; i++) {
     if (grpc_cq_can_listen(server->cqs[i])) {
       server->pollsets[server->pollset_count++] =
           grpc_cq_pollset(server->cqs[i]);
     }
+    grpc_pollset* pollset = grpc_cq_pollset(server->cqs[i]);
+    if (busy_poll_us > 0 && pollset != nullptr) {
+      grpc_pollset_enable_busy_poll(pollset, busy_poll_us);
+    }
   }
   request_matcher_init(&server->unregistered_request_matcher, server);
   for (registered_method* rm = server->registered_methods; rm; rm = rm->next) {
     request_matcher_init(&rm->matcher, server);
   }
+  build_registered_method_table(server);
 
   gpr_mu_lock(&server->mu_global);
   server->starting = true;
@@ -1151,16 +1327,8 @@ void grpc_server_setup_transport(
     const grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode>&
         socket_node,
     grpc_resource_user* resource_user) {
-  size_t num_registered_methods;
-  size_t alloc;
-  registered_method* rm;
-  channel_registered_method* crm;
   grpc_channel* channel;
   channel_data* chand;
-  uint32_t hash;
-  size_t slots;
-  uint32_t probes;
-  uint32_t max_probes = 0;
   grpc_transport_op* op = nullptr;
 
   channel = grpc_channel_create(nullptr, args, GRPC_SERVER_CHANNEL, transport,
@@ -1188,49 +1356,6 @@ void grpc_server_setup_transport(
   }
   chand->cq_idx = cq_idx;
 
-  num_registered_methods = 0;
-  for (rm = s->registered_methods; rm; rm = rm->next) {
-    num_registered_methods++;
-  }
-  /* build a lookup table phrased in terms of mdstr's in this channels context
-     to quickly find registered methods */
-  if (num_registered_methods > 0) {
-    slots = 2 * num_registered_methods;
-    alloc = sizeof(channel_registered_method) * slots;
-    chand->registered_methods =
-        static_cast<channel_registered_method*>(gpr_zalloc(alloc));
-    for (rm = s->registered_methods; rm; rm = rm->next) {
-      grpc_slice host;
-      bool has_host;
-      grpc_slice method;
-      if (rm->host != nullptr) {
-        host = grpc_slice_from_static_string(rm->host);
-        has_host = true;
-      } else {
-        has_host = false;
-      }
-      method = grpc_slice_from_static_string(rm->method);
-      hash = GRPC_MDSTR_KV_HASH(has_host ? grpc_slice_hash_internal(host) : 0,
-                                grpc_slice_hash_internal(method));
-      for (probes = 0; chand->registered_methods[(hash + probes) % slots]
-                           .server_registered_method != nullptr;
-           probes++)
-        ;
-      if (probes > max_probes) max_probes = probes;
-      crm = &chand->registered_methods[(hash + probes) % slots];
-      crm->server_registered_method = rm;
-      crm->flags = rm->flags;
-      crm->has_host = has_host;
-      if (has_host) {
-        crm->host = host;
-      }
-      crm->method = method;
-    }
-    GPR_ASSERT(slots <= UINT32_MAX);
-    chand->registered_method_slots = static_cast<uint32_t>(slots);
-    chand->registered_method_max_probes = max_probes;
-  }
-
   gpr_mu_lock(&s->mu_global);
   chand->next = &s->root_channel_data;
   chand->prev = chand->next->prev;
@@ -1433,13 +1558,21 @@ static grpc_call_error queue_call_request(grpc_server* server, size_t cq_idx,
   if (gpr_locked_mpscq_push(&rm->requests_per_cq[cq_idx], &rc->request_link)) {
     /* this was the first queued request: we need to lock and start
        matching calls */
-    gpr_mu_lock(&server->mu_call);
+    gpr_mu_lock(&rm->mu);
     while ((calld = rm->pending_head) != nullptr) {
+      if (should_shed_pending_call(server, rm, calld->queued_at,
+                                   grpc_core::ExecCtx::Get()->Now())) {
+        rm->pending_head = calld->pending_next;
+        gpr_mu_unlock(&rm->mu);
+        shed_pending_call(calld);
+        gpr_mu_lock(&rm->mu);
+        continue;
+      }
       rc = reinterpret_cast<requested_call*>(
           gpr_locked_mpscq_pop(&rm->requests_per_cq[cq_idx]));
       if (rc == nullptr) break;
       rm->pending_head = calld->pending_next;
-      gpr_mu_unlock(&server->mu_call);
+      gpr_mu_unlock(&rm->mu);
       if (!gpr_atm_full_cas(&calld->state, PENDING, ACTIVATED)) {
         // Zombied Call
         GRPC_CLOSURE_INIT(
@@ -1450,9 +1583,9 @@ static grpc_call_error queue_call_request(grpc_server* server, size_t cq_idx,
       } else {
         publish_call(server, calld, cq_idx, rc);
       }
-      gpr_mu_lock(&server->mu_call);
+      gpr_mu_lock(&rm->mu);
     }
-    gpr_mu_unlock(&server->mu_call);
+    gpr_mu_unlock(&rm->mu);
   }
   return GRPC_CALL_OK;
 }
@@ -30,11 +30,45 @@
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/surface/validate_metadata.h"
 
+// Returns the interned slice's cached result of a check, or nullptr if slice is
+// not interned.
+static grpc_core::Atomic<bool>* validation_cache(
+    const grpc_slice& slice,
+    grpc_core::Atomic<bool> grpc_core::InternedSliceRefcount::*flag) {
+  if (slice.refcount == nullptr ||
+      slice.refcount->GetType() != grpc_slice_refcount::Type::INTERNED) {
+    return nullptr;
+  }
+  return &(reinterpret_cast<grpc_core::InternedSliceRefcount*>(slice.refcount)
+               ->*flag);
+}
+
+// Returns a pointer past the longest prefix of [p, e) made of printable
+// characters (' ' to '~'), checking eight bytes at a time.
+static const uint8_t* skip_printable(const uint8_t* p, const uint8_t* e) {
+  static const uint64_t kOnes = 0x0101010101010101;
+  static const uint64_t kHighBits = 0x8080808080808080;
+  while (e - p >= 8) {
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+    // the high bit of some byte is set if a byte of w is below ' ' or above
+    // '~'
+    if ((((w - kOnes * ' ') & ~w) | ((w + kOnes * (127 - '~')) | w)) &
+        kHighBits) {
+      break;
+    }
+    p += 8;
+  }
+  return p;
+}
+
 static grpc_error* conforms_to(const grpc_slice& slice,
                                const uint8_t* legal_bits,
-                               const char* err_desc) {
+                               const char* err_desc,
+                               bool printable_only = false) {
   const uint8_t* p = GRPC_SLICE_START_PTR(slice);
   const uint8_t* e = GRPC_SLICE_END_PTR(slice);
+  if (printable_only) p = skip_printable(p, e);
   for (; p != e; p++) {
     int idx = *p;
     int byte = idx / 8;
@@ -71,7 +105,17 @@ grpc_error* grpc_validate_header_key_is_legal(const grpc_slice& slice) {
     return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "Metadata keys cannot start with :");
   }
-  return conforms_to(slice, legal_header_bits, "Illegal header key");
+  grpc_core::Atomic<bool>* valid = validation_cache(
+      slice, &grpc_core::InternedSliceRefcount::valid_header_key);
+  if (valid != nullptr && valid->Load(grpc_core::MemoryOrder::RELAXED)) {
+    return GRPC_ERROR_NONE;
+  }
+  grpc_error* error =
+      conforms_to(slice, legal_header_bits, "Illegal header key");
+  if (valid != nullptr && error == GRPC_ERROR_NONE) {
+    valid->Store(true, grpc_core::MemoryOrder::RELAXED);
+  }
+  return error;
 }
 
 int grpc_header_key_is_legal(grpc_slice slice) {
@@ -84,7 +128,18 @@ grpc_error* grpc_validate_header_nonbin_value_is_legal(
       0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
       0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-  return conforms_to(slice, legal_header_bits, "Illegal header value");
+  grpc_core::Atomic<bool>* valid = validation_cache(
+      slice, &grpc_core::InternedSliceRefcount::valid_header_nonbin_value);
+  if (valid != nullptr && valid->Load(grpc_core::MemoryOrder::RELAXED)) {
+    return GRPC_ERROR_NONE;
+  }
+  // the legal bytes are exactly the printable ones
+  grpc_error* error = conforms_to(slice, legal_header_bits,
+                                  "Illegal header value", true);
+  if (valid != nullptr && error == GRPC_ERROR_NONE) {
+    valid->Store(true, grpc_core::MemoryOrder::RELAXED);
+  }
+  return error;
 }
 
 int grpc_header_nonbin_value_is_legal(grpc_slice slice) {
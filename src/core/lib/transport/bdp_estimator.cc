@@ -29,7 +29,20 @@ grpc_core::TraceFlag grpc_bdp_estimator_trace(false, "bdp_estimator");
 
 namespace grpc_core {
 
-BdpEstimator::BdpEstimator(const char* name)
+namespace {
+// Growth of the estimate per window limited ping while starting up; the same
+// 2/ln(2) gain BBR uses to at least double its delivery rate every round trip.
+constexpr double kStartupGain = 2.885;
+// Growth of the estimate per window limited ping once the path is full.
+constexpr double kProbeGain = 1.25;
+// The startup phase ends after this many pings without the delivery rate
+// growing by kProbeGain.
+constexpr int kFullBwRounds = 3;
+// How long a minimum round trip time sample is trusted for.
+constexpr int kMinRttExpirySeconds = 10;
+}  // namespace
+
+BdpEstimator::BdpEstimator(const char* name, bool delivery_rate_estimation)
     : ping_state_(PingState::UNSCHEDULED),
       accumulator_(0),
       estimate_(65536),
@@ -37,7 +50,61 @@ BdpEstimator::BdpEstimator(const char* name)
       inter_ping_delay_(100.0),  // start at 100ms
       stable_estimate_count_(0),
       bw_est_(0),
-      name_(name) {}
+      name_(name),
+      delivery_rate_estimation_(delivery_rate_estimation),
+      min_rtt_stamp_(gpr_time_0(GPR_CLOCK_MONOTONIC)) {}
+
+void BdpEstimator::AddRttSample(double rtt) {
+  if (!delivery_rate_estimation_ || rtt <= 0) return;
+  UpdateMinRtt(rtt, gpr_now(GPR_CLOCK_MONOTONIC));
+}
+
+void BdpEstimator::UpdateMinRtt(double rtt, gpr_timespec now) {
+  if (min_rtt_ == 0 || rtt <= min_rtt_ ||
+      gpr_time_cmp(gpr_time_sub(now, min_rtt_stamp_),
+                   gpr_time_from_seconds(kMinRttExpirySeconds,
+                                         GPR_TIMESPAN)) > 0) {
+    min_rtt_ = rtt;
+    min_rtt_stamp_ = now;
+  }
+}
+
+bool BdpEstimator::UpdateDeliveryRateEstimate(double dt, double bw,
+                                              gpr_timespec now) {
+  // The ping measured one round trip, and the bytes that arrived meanwhile
+  // one sample of the rate the path delivers at.
+  if (dt > 0) UpdateMinRtt(dt, now);
+  bw_samples_[bw_round_++ % kBwFilterRounds] = bw;
+  double max_bw = 0;
+  for (int i = 0; i < kBwFilterRounds; i++) {
+    max_bw = GPR_MAX(max_bw, bw_samples_[i]);
+  }
+  // Only pings that were limited by the window say whether the path is full;
+  // the rest were limited by how much the peer had to send.
+  const bool window_limited = accumulator_ > 2 * estimate_ / 3;
+  if (startup_ && window_limited) {
+    if (max_bw >= full_bw_ * kProbeGain) {
+      full_bw_ = max_bw;
+      full_bw_rounds_ = 0;
+    } else if (++full_bw_rounds_ >= kFullBwRounds) {
+      startup_ = false;
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
+        gpr_log(GPR_INFO, "bdp[%s]: startup done at bw=%lfMbs min_rtt=%lfs",
+                name_, max_bw / 125000.0, min_rtt_);
+      }
+    }
+  }
+  // If the peer used most of the window it was given, the path may well
+  // carry more than was measured: probe beyond the model.
+  double target = max_bw * min_rtt_;
+  if (window_limited) {
+    target = GPR_MAX(target, estimate_ * (startup_ ? kStartupGain : kProbeGain));
+  }
+  bw_est_ = GPR_MAX(bw_est_, max_bw);
+  if (target <= estimate_) return false;
+  estimate_ = static_cast<int64_t>(GPR_MIN(target, 1e15));
+  return true;
+}
 
 grpc_millis BdpEstimator::CompletePing() {
   gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
@@ -54,9 +121,17 @@ grpc_millis BdpEstimator::CompletePing() {
             bw_est_ / 125000.0);
   }
   GPR_ASSERT(ping_state_ == PingState::STARTED);
-  if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est_) {
-    estimate_ = GPR_MAX(accumulator_, estimate_ * 2);
-    bw_est_ = bw;
+  bool grew;
+  if (delivery_rate_estimation_) {
+    grew = UpdateDeliveryRateEstimate(dt, bw, now);
+  } else {
+    grew = accumulator_ > 2 * estimate_ / 3 && bw > bw_est_;
+    if (grew) {
+      estimate_ = GPR_MAX(accumulator_, estimate_ * 2);
+      bw_est_ = bw;
+    }
+  }
+  if (grew) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
       gpr_log(GPR_INFO, "bdp[%s]: estimate increased to %" PRId64, name_,
               estimate_);
@@ -81,6 +156,10 @@ grpc_millis BdpEstimator::CompletePing() {
   }
   ping_state_ = PingState::UNSCHEDULED;
   accumulator_ = 0;
+  if (delivery_rate_estimation_ && startup_) {
+    // every round trip is a sample: probe again straight away
+    return grpc_core::ExecCtx::Get()->Now();
+  }
   return grpc_core::ExecCtx::Get()->Now() + inter_ping_delay_;
 }
 
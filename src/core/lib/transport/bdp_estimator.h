@@ -37,11 +37,24 @@ namespace grpc_core {
 
 class BdpEstimator {
  public:
-  explicit BdpEstimator(const char* name);
+  // If \a delivery_rate_estimation is true, the estimate follows a model of
+  // the path (the highest recent delivery rate times the lowest recent round
+  // trip time) and grows aggressively until the delivery rate stops growing,
+  // rather than doubling at most once per probe.
+  explicit BdpEstimator(const char* name,
+                        bool delivery_rate_estimation = false);
   ~BdpEstimator() {}
 
   int64_t EstimateBdp() const { return estimate_; }
   double EstimateBandwidth() const { return bw_est_; }
+  bool delivery_rate_estimation() const { return delivery_rate_estimation_; }
+  // Lowest recent round trip time in seconds, or 0 if none is known yet. Only
+  // tracked in delivery rate estimation mode.
+  double MinRtt() const { return min_rtt_; }
+
+  // Feed a round trip time (in seconds) measured outside of the bdp pings,
+  // e.g. by the kernel's TCP stack. Only used in delivery rate estimation mode.
+  void AddRttSample(double rtt);
 
   void AddIncomingBytes(int64_t num_bytes) { accumulator_ += num_bytes; }
 
@@ -78,6 +91,14 @@ class BdpEstimator {
  private:
   enum class PingState { UNSCHEDULED, SCHEDULED, STARTED };
 
+  // Number of pings over which the highest delivery rate is remembered.
+  static constexpr int kBwFilterRounds = 10;
+
+  void UpdateMinRtt(double rtt, gpr_timespec now);
+  // Update estimate_ from the completed ping in delivery rate estimation mode;
+  // returns true if the estimate grew.
+  bool UpdateDeliveryRateEstimate(double dt, double bw, gpr_timespec now);
+
   PingState ping_state_;
   int64_t accumulator_;
   int64_t estimate_;
@@ -87,6 +108,19 @@ class BdpEstimator {
   int stable_estimate_count_;
   double bw_est_;
   const char* name_;
+
+  /* delivery rate estimation */
+  const bool delivery_rate_estimation_;
+  // still growing the estimate as fast as possible?
+  bool startup_ = true;
+  double min_rtt_ = 0;
+  gpr_timespec min_rtt_stamp_;
+  double bw_samples_[kBwFilterRounds] = {};
+  int bw_round_ = 0;
+  // delivery rate at which the startup phase last grew enough, and the number
+  // of pings since then
+  double full_bw_ = 0;
+  int full_bw_rounds_ = 0;
 };
 
 }  // namespace grpc_core
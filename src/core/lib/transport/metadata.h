@@ -26,7 +26,11 @@
 #include <grpc/grpc.h>
 #include <grpc/slice.h>
 
+#include <new>
+#include <utility>
+
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -328,6 +332,20 @@ class AllocatedMetadata : public RefcountedMdBase {
   UserData user_data_;
 };
 
+// Like New() and Delete(), for the metadata elements that gRPC allocates, out
+// of the memory of the metadata subsystem.
+template <typename T, typename... Args>
+inline T* NewMetadata(Args&&... args) {
+  void* p = gpr_subsystem_malloc(GPR_ALLOC_SUBSYSTEM_METADATA, sizeof(T));
+  return new (p) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+inline void DeleteMetadata(T* md) {
+  md->~T();
+  gpr_subsystem_free(GPR_ALLOC_SUBSYSTEM_METADATA, md, sizeof(T));
+}
+
 }  // namespace grpc_core
 
 #ifndef NDEBUG
@@ -426,24 +444,27 @@ inline grpc_mdelem grpc_mdelem_from_slices(
     const grpc_core::ManagedMemorySlice& key,
     const grpc_core::UnmanagedMemorySlice& value) {
   using grpc_core::AllocatedMetadata;
-  return GRPC_MAKE_MDELEM(grpc_core::New<AllocatedMetadata>(key, value),
-                          GRPC_MDELEM_STORAGE_ALLOCATED);
+  return GRPC_MAKE_MDELEM(
+      grpc_core::NewMetadata<AllocatedMetadata>(key, value),
+      GRPC_MDELEM_STORAGE_ALLOCATED);
 }
 
 inline grpc_mdelem grpc_mdelem_from_slices(
     const grpc_core::ExternallyManagedSlice& key,
     const grpc_core::UnmanagedMemorySlice& value) {
   using grpc_core::AllocatedMetadata;
-  return GRPC_MAKE_MDELEM(grpc_core::New<AllocatedMetadata>(key, value),
-                          GRPC_MDELEM_STORAGE_ALLOCATED);
+  return GRPC_MAKE_MDELEM(
+      grpc_core::NewMetadata<AllocatedMetadata>(key, value),
+      GRPC_MDELEM_STORAGE_ALLOCATED);
 }
 
 inline grpc_mdelem grpc_mdelem_from_slices(
     const grpc_core::StaticMetadataSlice& key,
     const grpc_core::UnmanagedMemorySlice& value) {
   using grpc_core::AllocatedMetadata;
-  return GRPC_MAKE_MDELEM(grpc_core::New<AllocatedMetadata>(key, value),
-                          GRPC_MDELEM_STORAGE_ALLOCATED);
+  return GRPC_MAKE_MDELEM(
+      grpc_core::NewMetadata<AllocatedMetadata>(key, value),
+      GRPC_MDELEM_STORAGE_ALLOCATED);
 }
 
 #endif /* GRPC_CORE_LIB_TRANSPORT_METADATA_H */
@@ -53,17 +53,29 @@ static void assert_valid_list(grpc_mdelem_list* list) {
 #endif /* NDEBUG */
 }
 
+static size_t custom_slot_of(const grpc_slice& key) {
+  return grpc_slice_hash_internal(key) & (GRPC_BATCH_CUSTOM_INDEX_SIZE - 1);
+}
+
 static void assert_valid_callouts(grpc_metadata_batch* batch) {
 #ifndef NDEBUG
+  size_t custom_count = 0;
+  size_t indexed_count = 0;
   for (grpc_linked_mdelem* l = batch->list.head; l != nullptr; l = l->next) {
     grpc_slice key_interned = grpc_slice_intern(GRPC_MDKEY(l->md));
     grpc_metadata_batch_callouts_index callout_idx =
         GRPC_BATCH_INDEX_OF(key_interned);
     if (callout_idx != GRPC_BATCH_CALLOUTS_COUNT) {
       GPR_ASSERT(batch->idx.array[callout_idx] == l);
+    } else {
+      custom_count++;
+      if (batch->custom_idx.slots[custom_slot_of(key_interned)] == l) {
+        indexed_count++;
+      }
     }
     grpc_slice_unref_internal(key_interned);
   }
+  GPR_ASSERT(custom_count == indexed_count + batch->custom_idx.unindexed);
 #endif
 }
 
@@ -114,11 +126,41 @@ static grpc_error* maybe_link_callout(grpc_metadata_batch* batch,
                                       grpc_linked_mdelem* storage)
     GRPC_MUST_USE_RESULT;
 
+static void link_custom(grpc_metadata_batch* batch,
+                        grpc_linked_mdelem* storage) {
+  // Hashing a key that is not interned would cost more than most lookups
+  // save, so such keys are left to the fallback search.
+  const grpc_slice& key = GRPC_MDKEY(storage->md);
+  if (grpc_slice_is_interned(key)) {
+    grpc_linked_mdelem** slot = &batch->custom_idx.slots[custom_slot_of(key)];
+    if (*slot == nullptr) {
+      *slot = storage;
+      return;
+    }
+  }
+  ++batch->custom_idx.unindexed;
+}
+
+static void unlink_custom(grpc_metadata_batch* batch,
+                          grpc_linked_mdelem* storage) {
+  // Checking every slot is cheaper than hashing the key again, and stays
+  // right if storage->md was replaced by an element with an equal key.
+  for (size_t i = 0; i < GRPC_BATCH_CUSTOM_INDEX_SIZE; i++) {
+    if (batch->custom_idx.slots[i] == storage) {
+      batch->custom_idx.slots[i] = nullptr;
+      return;
+    }
+  }
+  GPR_DEBUG_ASSERT(batch->custom_idx.unindexed > 0);
+  --batch->custom_idx.unindexed;
+}
+
 static grpc_error* maybe_link_callout(grpc_metadata_batch* batch,
                                       grpc_linked_mdelem* storage) {
   grpc_metadata_batch_callouts_index idx =
       GRPC_BATCH_INDEX_OF(GRPC_MDKEY(storage->md));
   if (idx == GRPC_BATCH_CALLOUTS_COUNT) {
+    link_custom(batch, storage);
     return GRPC_ERROR_NONE;
   }
   return link_callout(batch, storage, idx);
@@ -129,6 +171,7 @@ static void maybe_unlink_callout(grpc_metadata_batch* batch,
   grpc_metadata_batch_callouts_index idx =
       GRPC_BATCH_INDEX_OF(GRPC_MDKEY(storage->md));
   if (idx == GRPC_BATCH_CALLOUTS_COUNT) {
+    unlink_custom(batch, storage);
     return;
   }
   --batch->list.default_count;
@@ -281,6 +324,29 @@ void grpc_metadata_batch_remove(grpc_metadata_batch* batch,
   assert_valid_callouts(batch);
 }
 
+grpc_linked_mdelem* grpc_metadata_batch_find(grpc_metadata_batch* batch,
+                                             const grpc_slice& key) {
+  grpc_metadata_batch_callouts_index idx = GRPC_BATCH_INDEX_OF(key);
+  if (idx == GRPC_BATCH_CALLOUTS_COUNT && !grpc_slice_is_interned(key)) {
+    // The key may still spell out a callout.
+    bool is_static = false;
+    grpc_slice static_key = grpc_slice_maybe_static_intern(key, &is_static);
+    if (is_static) idx = GRPC_BATCH_INDEX_OF(static_key);
+  }
+  if (idx != GRPC_BATCH_CALLOUTS_COUNT) {
+    return batch->idx.array[idx];
+  }
+  grpc_linked_mdelem* indexed = batch->custom_idx.slots[custom_slot_of(key)];
+  if (indexed != nullptr && grpc_slice_eq(GRPC_MDKEY(indexed->md), key)) {
+    return indexed;
+  }
+  if (batch->custom_idx.unindexed == 0) return nullptr;
+  for (grpc_linked_mdelem* l = batch->list.head; l != nullptr; l = l->next) {
+    if (grpc_slice_eq(GRPC_MDKEY(l->md), key)) return l;
+  }
+  return nullptr;
+}
+
 void grpc_metadata_batch_set_value(grpc_linked_mdelem* storage,
                                    const grpc_slice& value) {
   grpc_mdelem old_mdelem = storage->md;
@@ -46,10 +46,23 @@ typedef struct grpc_mdelem_list {
   grpc_linked_mdelem* tail;
 } grpc_mdelem_list;
 
+/* Number of slots in the hashed index of custom keys, a power of two. */
+#define GRPC_BATCH_CUSTOM_INDEX_SIZE 8
+
+/* Index of the elements whose keys are not callouts: each element with an
+   interned key (whose hash is known without hashing its bytes) goes into the
+   slot for its key's hash, unless that slot is taken. */
+typedef struct grpc_metadata_batch_custom_index {
+  grpc_linked_mdelem* slots[GRPC_BATCH_CUSTOM_INDEX_SIZE];
+  /** Number of elements with custom keys that are not in a slot */
+  size_t unindexed;
+} grpc_metadata_batch_custom_index;
+
 typedef struct grpc_metadata_batch {
   /** Metadata elements in this batch */
   grpc_mdelem_list list;
   grpc_metadata_batch_callouts idx;
+  grpc_metadata_batch_custom_index custom_idx;
   /** Used to calculate grpc-timeout at the point of sending,
       or GRPC_MILLIS_INF_FUTURE if this batch does not need to send a
       grpc-timeout */
@@ -70,6 +83,14 @@ void grpc_metadata_batch_remove(grpc_metadata_batch* batch,
 void grpc_metadata_batch_remove(grpc_metadata_batch* batch,
                                 grpc_metadata_batch_callouts_index idx);
 
+/** Returns an element of \a batch with key \a key, or nullptr if there is
+    none. Callout keys are looked up directly, and most custom keys through a
+    hashed index; only if the index does not hold all the custom keys of the
+    batch are the remaining elements searched. If several elements have the
+    key, which one is returned is unspecified. */
+grpc_linked_mdelem* grpc_metadata_batch_find(grpc_metadata_batch* batch,
+                                             const grpc_slice& key);
+
 /** Substitute a new mdelem for an old value */
 grpc_error* grpc_metadata_batch_substitute(grpc_metadata_batch* batch,
                                            grpc_linked_mdelem* storage,
@@ -28,6 +28,8 @@
 
 #include "src/core/lib/transport/static_metadata.h"
 
+#include <string.h>
+
 #include "src/core/lib/slice/slice_internal.h"
 
 static uint8_t g_bytes[] = {
@@ -457,6 +459,321 @@ const grpc_core::StaticMetadataSlice
             &grpc_static_metadata_refcounts[107].base, 21, g_bytes + 1345),
 };
 
+int32_t grpc_static_slice_index_of(const void* buf, size_t len) {
+  const uint8_t* p = static_cast<const uint8_t*>(buf);
+  switch (len) {
+    case 0:
+      return 28;
+    case 1:
+      switch (p[0]) {
+        case '/':
+          return memcmp(p, g_bytes + 730, 1) == 0 ? 43 : -1;
+        case '0':
+          return memcmp(p, g_bytes + 1253, 1) == 0 ? 97 : -1;
+        case '1':
+          return memcmp(p, g_bytes + 342, 1) == 0 ? 24 : -1;
+        case '2':
+          return memcmp(p, g_bytes + 343, 1) == 0 ? 25 : -1;
+        case '3':
+          return memcmp(p, g_bytes + 344, 1) == 0 ? 26 : -1;
+        case '4':
+          return memcmp(p, g_bytes + 345, 1) == 0 ? 27 : -1;
+      }
+      return -1;
+    case 2:
+      return memcmp(p, g_bytes + 36, 2) == 0 ? 5 : -1;
+    case 3:
+      switch (p[0]) {
+        case '2':
+          switch (p[2]) {
+            case '0':
+              return memcmp(p, g_bytes + 751, 3) == 0 ? 47 : -1;
+            case '4':
+              return memcmp(p, g_bytes + 754, 3) == 0 ? 48 : -1;
+            case '6':
+              return memcmp(p, g_bytes + 757, 3) == 0 ? 49 : -1;
+          }
+          return -1;
+        case '3':
+          return memcmp(p, g_bytes + 760, 3) == 0 ? 50 : -1;
+        case '4':
+          switch (p[2]) {
+            case '0':
+              return memcmp(p, g_bytes + 763, 3) == 0 ? 51 : -1;
+            case '4':
+              return memcmp(p, g_bytes + 766, 3) == 0 ? 52 : -1;
+          }
+          return -1;
+        case '5':
+          return memcmp(p, g_bytes + 769, 3) == 0 ? 53 : -1;
+        case 'G':
+          return memcmp(p, g_bytes + 723, 3) == 0 ? 41 : -1;
+        case 'P':
+          return memcmp(p, g_bytes + 1290, 3) == 0 ? 102 : -1;
+        case 'a':
+          return memcmp(p, g_bytes + 860, 3) == 0 ? 60 : -1;
+        case 'v':
+          return memcmp(p, g_bytes + 1234, 3) == 0 ? 95 : -1;
+      }
+      return -1;
+    case 4:
+      switch (p[2]) {
+        case 'S':
+          return memcmp(p, g_bytes + 726, 4) == 0 ? 42 : -1;
+        case 'a':
+          return memcmp(p, g_bytes + 982, 4) == 0 ? 71 : -1;
+        case 'i':
+          return memcmp(p, g_bytes + 708, 4) == 0 ? 39 : -1;
+        case 'n':
+          return memcmp(p, g_bytes + 1081, 4) == 0 ? 81 : -1;
+        case 'o':
+          return memcmp(p, g_bytes + 999, 4) == 0 ? 74 : -1;
+        case 'p':
+          return memcmp(p, g_bytes + 1286, 4) == 0 ? 101 : -1;
+        case 'r':
+          return memcmp(p, g_bytes + 1230, 4) == 0 ? 94 : -1;
+        case 's':
+          return memcmp(p, g_bytes + 278, 4) == 0 ? 20 : -1;
+        case 't':
+          switch (p[0]) {
+            case 'd':
+              return memcmp(p, g_bytes + 978, 4) == 0 ? 70 : -1;
+            case 'h':
+              return memcmp(p, g_bytes + 742, 4) == 0 ? 45 : -1;
+          }
+          return -1;
+      }
+      return -1;
+    case 5:
+      switch (p[0]) {
+        case ':':
+          return memcmp(p, g_bytes + 0, 5) == 0 ? 0 : -1;
+        case 'a':
+          return memcmp(p, g_bytes + 863, 5) == 0 ? 61 : -1;
+        case 'h':
+          return memcmp(p, g_bytes + 746, 5) == 0 ? 46 : -1;
+        case 'r':
+          return memcmp(p, g_bytes + 1142, 5) == 0 ? 86 : -1;
+      }
+      return -1;
+    case 6:
+      switch (p[0]) {
+        case 'a':
+          return memcmp(p, g_bytes + 827, 6) == 0 ? 58 : -1;
+        case 'c':
+          return memcmp(p, g_bytes + 972, 6) == 0 ? 69 : -1;
+        case 'e':
+          return memcmp(p, g_bytes + 986, 6) == 0 ? 72 : -1;
+        case 's':
+          return memcmp(p, g_bytes + 1172, 6) == 0 ? 90 : -1;
+      }
+      return -1;
+    case 7:
+      switch (p[3]) {
+        case 'a':
+          return memcmp(p, g_bytes + 12, 7) == 0 ? 2 : -1;
+        case 'e':
+          return memcmp(p, g_bytes + 1147, 7) == 0 ? 87 : -1;
+        case 'h':
+          return memcmp(p, g_bytes + 29, 7) == 0 ? 4 : -1;
+        case 'i':
+          return memcmp(p, g_bytes + 992, 7) == 0 ? 73 : -1;
+        case 'l':
+          return memcmp(p, g_bytes + 701, 7) == 0 ? 38 : -1;
+        case 'r':
+          return memcmp(p, g_bytes + 1154, 7) == 0 ? 88 : -1;
+        case 't':
+          return memcmp(p, g_bytes + 5, 7) == 0 ? 1 : -1;
+      }
+      return -1;
+    case 8:
+      switch (p[3]) {
+        case 'a':
+          return memcmp(p, g_bytes + 1085, 8) == 0 ? 82 : -1;
+        case 'i':
+          return memcmp(p, g_bytes + 1262, 8) == 0 ? 99 : -1;
+        case 'm':
+          return memcmp(p, g_bytes + 1003, 8) == 0 ? 75 : -1;
+        case 'n':
+          return memcmp(p, g_bytes + 1254, 8) == 0 ? 98 : -1;
+        case 'r':
+          return memcmp(p, g_bytes + 1041, 8) == 0 ? 78 : -1;
+      }
+      return -1;
+    case 10:
+      switch (p[0]) {
+        case ':':
+          return memcmp(p, g_bytes + 19, 10) == 0 ? 3 : -1;
+        case 's':
+          return memcmp(p, g_bytes + 1178, 10) == 0 ? 91 : -1;
+        case 'u':
+          return memcmp(p, g_bytes + 268, 10) == 0 ? 19 : -1;
+      }
+      return -1;
+    case 11:
+      switch (p[0]) {
+        case '/':
+          return memcmp(p, g_bytes + 731, 11) == 0 ? 44 : -1;
+        case 'g':
+          return memcmp(p, g_bytes + 50, 11) == 0 ? 7 : -1;
+        case 'l':
+          return memcmp(p, g_bytes + 1293, 11) == 0 ? 103 : -1;
+        case 'r':
+          return memcmp(p, g_bytes + 1161, 11) == 0 ? 89 : -1;
+        case 's':
+          return memcmp(p, g_bytes + 712, 11) == 0 ? 40 : -1;
+      }
+      return -1;
+    case 12:
+      switch (p[4]) {
+        case '-':
+          switch (p[5]) {
+            case 'm':
+              return memcmp(p, g_bytes + 38, 12) == 0 ? 6 : -1;
+            case 't':
+              return memcmp(p, g_bytes + 330, 12) == 0 ? 23 : -1;
+          }
+          return -1;
+        case '.':
+          return memcmp(p, g_bytes + 365, 12) == 0 ? 30 : -1;
+        case 'a':
+          return memcmp(p, g_bytes + 1333, 12) == 0 ? 106 : -1;
+        case 'e':
+          return memcmp(p, g_bytes + 158, 12) == 0 ? 14 : -1;
+        case 'f':
+          return memcmp(p, g_bytes + 1093, 12) == 0 ? 83 : -1;
+      }
+      return -1;
+    case 13:
+      switch (p[6]) {
+        case '-':
+          return memcmp(p, g_bytes + 814, 13) == 0 ? 57 : -1;
+        case 'a':
+          return memcmp(p, g_bytes + 131, 13) == 0 ? 12 : -1;
+        case 'c':
+          return memcmp(p, g_bytes + 881, 13) == 0 ? 63 : -1;
+        case 'd':
+          return memcmp(p, g_bytes + 786, 13) == 0 ? 55 : -1;
+        case 'e':
+          return memcmp(p, g_bytes + 1028, 13) == 0 ? 77 : -1;
+        case 'i':
+          return memcmp(p, g_bytes + 868, 13) == 0 ? 62 : -1;
+        case 'n':
+          return memcmp(p, g_bytes + 77, 13) == 0 ? 9 : -1;
+        case 'o':
+          return memcmp(p, g_bytes + 1068, 13) == 0 ? 80 : -1;
+        case 't':
+          switch (p[0]) {
+            case 'c':
+              return memcmp(p, g_bytes + 959, 13) == 0 ? 68 : -1;
+            case 'i':
+              return memcmp(p, g_bytes + 1320, 13) == 0 ? 105 : -1;
+          }
+          return -1;
+      }
+      return -1;
+    case 14:
+      switch (p[0]) {
+        case 'a':
+          return memcmp(p, g_bytes + 772, 14) == 0 ? 54 : -1;
+        case 'c':
+          return memcmp(p, g_bytes + 929, 14) == 0 ? 66 : -1;
+        case 'g':
+          return memcmp(p, g_bytes + 144, 14) == 0 ? 13 : -1;
+      }
+      return -1;
+    case 15:
+      switch (p[7]) {
+        case 'e':
+          return memcmp(p, g_bytes + 186, 15) == 0 ? 16 : -1;
+        case 'l':
+          return memcmp(p, g_bytes + 799, 15) == 0 ? 56 : -1;
+      }
+      return -1;
+    case 16:
+      switch (p[11]) {
+        case '/':
+          return memcmp(p, g_bytes + 1270, 16) == 0 ? 100 : -1;
+        case 'a':
+          return memcmp(p, g_bytes + 943, 16) == 0 ? 67 : -1;
+        case 'd':
+          return memcmp(p, g_bytes + 61, 16) == 0 ? 8 : -1;
+        case 'f':
+          return memcmp(p, g_bytes + 1304, 16) == 0 ? 104 : -1;
+        case 'g':
+          return memcmp(p, g_bytes + 913, 16) == 0 ? 65 : -1;
+        case 'i':
+          return memcmp(p, g_bytes + 1237, 16) == 0 ? 96 : -1;
+        case 'o':
+          return memcmp(p, g_bytes + 170, 16) == 0 ? 15 : -1;
+      }
+      return -1;
+    case 17:
+      switch (p[0]) {
+        case 'i':
+          return memcmp(p, g_bytes + 1011, 17) == 0 ? 76 : -1;
+        case 't':
+          return memcmp(p, g_bytes + 1213, 17) == 0 ? 93 : -1;
+      }
+      return -1;
+    case 18:
+      return memcmp(p, g_bytes + 1105, 18) == 0 ? 84 : -1;
+    case 19:
+      switch (p[0]) {
+        case 'c':
+          return memcmp(p, g_bytes + 894, 19) == 0 ? 64 : -1;
+        case 'g':
+          return memcmp(p, g_bytes + 346, 19) == 0 ? 29 : -1;
+        case 'i':
+          return memcmp(p, g_bytes + 1049, 19) == 0 ? 79 : -1;
+        case 'p':
+          return memcmp(p, g_bytes + 1123, 19) == 0 ? 85 : -1;
+      }
+      return -1;
+    case 20:
+      return memcmp(p, g_bytes + 90, 20) == 0 ? 10 : -1;
+    case 21:
+      switch (p[0]) {
+        case 'g':
+          return memcmp(p, g_bytes + 110, 21) == 0 ? 11 : -1;
+        case 'i':
+          return memcmp(p, g_bytes + 1345, 21) == 0 ? 107 : -1;
+      }
+      return -1;
+    case 22:
+      return memcmp(p, g_bytes + 308, 22) == 0 ? 22 : -1;
+    case 25:
+      return memcmp(p, g_bytes + 1188, 25) == 0 ? 92 : -1;
+    case 26:
+      return memcmp(p, g_bytes + 282, 26) == 0 ? 21 : -1;
+    case 27:
+      return memcmp(p, g_bytes + 833, 27) == 0 ? 59 : -1;
+    case 28:
+      return memcmp(p, g_bytes + 593, 28) == 0 ? 36 : -1;
+    case 30:
+      switch (p[4]) {
+        case '-':
+          return memcmp(p, g_bytes + 201, 30) == 0 ? 17 : -1;
+        case '.':
+          return memcmp(p, g_bytes + 377, 30) == 0 ? 31 : -1;
+      }
+      return -1;
+    case 31:
+      return memcmp(p, g_bytes + 407, 31) == 0 ? 32 : -1;
+    case 36:
+      return memcmp(p, g_bytes + 438, 36) == 0 ? 33 : -1;
+    case 37:
+      return memcmp(p, g_bytes + 231, 37) == 0 ? 18 : -1;
+    case 54:
+      return memcmp(p, g_bytes + 539, 54) == 0 ? 35 : -1;
+    case 65:
+      return memcmp(p, g_bytes + 474, 65) == 0 ? 34 : -1;
+    case 80:
+      return memcmp(p, g_bytes + 621, 80) == 0 ? 37 : -1;
+  }
+  return -1;
+}
+
 /* Warning: the core static metadata currently operates under the soft
 constraint that the first GRPC_CHTTP2_LAST_STATIC_ENTRY (61) entries must
 contain metadata specified by the http2 hpack standard. The CHTTP2 transport
@@ -279,6 +279,10 @@ extern grpc_core::StaticSliceRefcount
   (reinterpret_cast<grpc_core::StaticSliceRefcount*>((static_slice).refcount) \
        ->index)
 
+/* Returns the index in grpc_static_slice_table of the static string equal to
+   the len bytes at buf, or -1 if there is none. */
+int32_t grpc_static_slice_index_of(const void* buf, size_t len);
+
 #define GRPC_STATIC_MDELEM_COUNT 85
 extern grpc_core::StaticMetadata
     grpc_static_mdelem_table[GRPC_STATIC_MDELEM_COUNT];
@@ -166,6 +166,11 @@ grpc_endpoint* grpc_transport_get_endpoint(grpc_transport* transport) {
   return transport->vtable->get_endpoint(transport);
 }
 
+int32_t grpc_transport_get_available_streams(grpc_transport* transport) {
+  if (transport->vtable->get_available_streams == nullptr) return INT32_MAX;
+  return transport->vtable->get_available_streams(transport);
+}
+
 // This comment should be sung to the tune of
 // "Supercalifragilisticexpialidocious":
 //
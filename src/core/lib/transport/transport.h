@@ -435,6 +435,12 @@ void grpc_transport_destroy(grpc_transport* transport);
 /* Get the endpoint used by \a transport */
 grpc_endpoint* grpc_transport_get_endpoint(grpc_transport* transport);
 
+/* Get how many more streams \a transport can start right now without queueing
+   them until the peer allows more concurrent streams, or INT32_MAX if it does
+   not limit them. May be called from any thread, so the value may be slightly
+   out of date. */
+int32_t grpc_transport_get_available_streams(grpc_transport* transport);
+
 /* Allocate a grpc_transport_op, and preconfigure the on_consumed closure to
    \a on_consumed and then delete the returned transport op */
 grpc_transport_op* grpc_make_transport_op(grpc_closure* on_consumed);
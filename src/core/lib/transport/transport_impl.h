@@ -60,6 +60,10 @@ typedef struct grpc_transport_vtable {
 
   /* implementation of grpc_transport_get_endpoint */
   grpc_endpoint* (*get_endpoint)(grpc_transport* self);
+
+  /* implementation of grpc_transport_get_available_streams; may be null for
+     transports that do not limit the number of concurrent streams */
+  int32_t (*get_available_streams)(grpc_transport* self);
 } grpc_transport_vtable;
 
 /* an instance of a grpc transport */
@@ -40,6 +40,14 @@ void grpc_lb_policy_pick_first_init(void);
 void grpc_lb_policy_pick_first_shutdown(void);
 void grpc_lb_policy_round_robin_init(void);
 void grpc_lb_policy_round_robin_shutdown(void);
+void grpc_lb_policy_least_request_init(void);
+void grpc_lb_policy_least_request_shutdown(void);
+void grpc_lb_policy_ring_hash_init(void);
+void grpc_lb_policy_ring_hash_shutdown(void);
+void grpc_lb_policy_weighted_round_robin_init(void);
+void grpc_lb_policy_weighted_round_robin_shutdown(void);
+void grpc_lb_policy_outlier_detection_init(void);
+void grpc_lb_policy_outlier_detection_shutdown(void);
 void grpc_resolver_dns_ares_init(void);
 void grpc_resolver_dns_ares_shutdown(void);
 void grpc_resolver_dns_native_init(void);
@@ -54,6 +62,12 @@ void grpc_max_age_filter_init(void);
 void grpc_max_age_filter_shutdown(void);
 void grpc_message_size_filter_init(void);
 void grpc_message_size_filter_shutdown(void);
+void grpc_concurrency_limit_filter_init(void);
+void grpc_concurrency_limit_filter_shutdown(void);
+void grpc_unary_coalescing_filter_init(void);
+void grpc_unary_coalescing_filter_shutdown(void);
+void grpc_response_cache_filter_init(void);
+void grpc_response_cache_filter_shutdown(void);
 void grpc_client_authority_filter_init(void);
 void grpc_client_authority_filter_shutdown(void);
 void grpc_workaround_cronet_compression_filter_init(void);
@@ -80,6 +94,14 @@ void grpc_register_built_in_plugins(void) {
                        grpc_lb_policy_pick_first_shutdown);
   grpc_register_plugin(grpc_lb_policy_round_robin_init,
                        grpc_lb_policy_round_robin_shutdown);
+  grpc_register_plugin(grpc_lb_policy_least_request_init,
+                       grpc_lb_policy_least_request_shutdown);
+  grpc_register_plugin(grpc_lb_policy_ring_hash_init,
+                       grpc_lb_policy_ring_hash_shutdown);
+  grpc_register_plugin(grpc_lb_policy_weighted_round_robin_init,
+                       grpc_lb_policy_weighted_round_robin_shutdown);
+  grpc_register_plugin(grpc_lb_policy_outlier_detection_init,
+                       grpc_lb_policy_outlier_detection_shutdown);
   grpc_register_plugin(grpc_resolver_dns_ares_init,
                        grpc_resolver_dns_ares_shutdown);
   grpc_register_plugin(grpc_resolver_dns_native_init,
@@ -94,6 +116,12 @@ void grpc_register_built_in_plugins(void) {
                        grpc_max_age_filter_shutdown);
   grpc_register_plugin(grpc_message_size_filter_init,
                        grpc_message_size_filter_shutdown);
+  grpc_register_plugin(grpc_concurrency_limit_filter_init,
+                       grpc_concurrency_limit_filter_shutdown);
+  grpc_register_plugin(grpc_unary_coalescing_filter_init,
+                       grpc_unary_coalescing_filter_shutdown);
+  grpc_register_plugin(grpc_response_cache_filter_init,
+                       grpc_response_cache_filter_shutdown);
   grpc_register_plugin(grpc_client_authority_filter_init,
                        grpc_client_authority_filter_shutdown);
   grpc_register_plugin(grpc_workaround_cronet_compression_filter_init,
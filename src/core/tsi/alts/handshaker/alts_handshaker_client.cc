@@ -24,6 +24,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/call.h"
 #include "src/core/lib/surface/channel.h"
@@ -33,8 +34,22 @@
 
 #define TSI_ALTS_INITIAL_BUFFER_SIZE 256
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_alts_max_concurrent_handshakes, 40,
+    "Maximum number of concurrent handshake RPCs to the ALTS handshaker "
+    "service, applied separately to client and server handshakes; the rest "
+    "wait for a slot. 0 for no limit");
+
 const int kHandshakerClientOpNum = 4;
 
+/* Where a handshaker client stands with respect to its handshake queue. */
+typedef enum {
+  HANDSHAKE_NOT_STARTED,
+  HANDSHAKE_QUEUED,
+  HANDSHAKE_RUNNING,
+  HANDSHAKE_DONE,
+} alts_handshake_queue_state;
+
 struct alts_handshaker_client {
   const alts_handshaker_client_vtable* vtable;
 };
@@ -81,8 +96,153 @@ typedef struct alts_grpc_handshaker_client {
   /* a buffer containing data to be sent to the grpc client or server's peer. */
   unsigned char* buffer;
   size_t buffer_size;
+  /* Fields owned by the handshake queue, under its lock. */
+  alts_handshake_queue_state queue_state;
+  struct alts_grpc_handshaker_client* next_queued;
 } alts_grpc_handshaker_client;
 
+static tsi_result continue_make_grpc_call(alts_grpc_handshaker_client* client,
+                                          bool is_start);
+
+namespace {
+
+/* Runs \a f within an ExecCtx, only creating one if the caller doesn't have
+ * one (as on the dedicated handshaker threads), so that nothing is flushed
+ * while the caller may be holding its locks. */
+template <typename F>
+void run_in_exec_ctx(F f) {
+  if (grpc_core::ExecCtx::Get() != nullptr) {
+    f();
+    return;
+  }
+  grpc_core::ExecCtx exec_ctx;
+  f();
+}
+
+/* Completes a handshake that never got to make its call, as though the
+ * call had failed with \a status. */
+void fail_queued_handshake(alts_grpc_handshaker_client* client,
+                           grpc_status_code status) {
+  client->status = status;
+  run_in_exec_ctx([client]() {
+    GRPC_CLOSURE_SCHED(&client->on_handshaker_service_resp_recv,
+                       GRPC_ERROR_NONE);
+  });
+}
+
+/* Bounds the number of handshake RPCs in flight to the handshaker service.
+ * During a reconnect storm, handshakes beyond the limit wait in FIFO order
+ * instead of all hitting the service at once, which keeps the latency of the
+ * ones being served low. Client and server handshakes have separate queues,
+ * so that a flood of incoming connections doesn't hold up outgoing ones. */
+class HandshakeQueue {
+ public:
+  explicit HandshakeQueue(size_t max_outstanding)
+      : max_outstanding_(max_outstanding) {
+    gpr_mu_init(&mu_);
+  }
+
+  /* Returns true if the handshake can start now; otherwise it is queued and
+   * continue_make_grpc_call() is invoked once a slot frees up. */
+  bool RequestHandshake(alts_grpc_handshaker_client* client) {
+    gpr_mu_lock(&mu_);
+    GPR_ASSERT(client->queue_state == HANDSHAKE_NOT_STARTED);
+    if (max_outstanding_ == 0 || outstanding_ < max_outstanding_) {
+      ++outstanding_;
+      client->queue_state = HANDSHAKE_RUNNING;
+      gpr_mu_unlock(&mu_);
+      return true;
+    }
+    client->queue_state = HANDSHAKE_QUEUED;
+    client->next_queued = nullptr;
+    if (tail_ == nullptr) {
+      head_ = client;
+    } else {
+      tail_->next_queued = client;
+    }
+    tail_ = client;
+    gpr_mu_unlock(&mu_);
+    return false;
+  }
+
+  /* Gives up the client's place, either its slot or its spot in the queue.
+   * Returns true if the client was still queued. Idempotent. */
+  bool HandshakeDone(alts_grpc_handshaker_client* client) {
+    alts_grpc_handshaker_client* next = nullptr;
+    bool was_queued = false;
+    gpr_mu_lock(&mu_);
+    if (client->queue_state == HANDSHAKE_QUEUED) {
+      RemoveLocked(client);
+      was_queued = true;
+    } else if (client->queue_state == HANDSHAKE_RUNNING) {
+      if (head_ != nullptr) {
+        // Hand the slot over directly.
+        next = head_;
+        RemoveLocked(next);
+        next->queue_state = HANDSHAKE_RUNNING;
+      } else {
+        --outstanding_;
+      }
+    }
+    client->queue_state = HANDSHAKE_DONE;
+    gpr_mu_unlock(&mu_);
+    if (next != nullptr) {
+      tsi_result result = TSI_OK;
+      run_in_exec_ctx(
+          [next, &result]() { result = continue_make_grpc_call(next, true); });
+      if (result != TSI_OK) {
+        gpr_log(GPR_ERROR, "Failed to start queued ALTS handshake");
+        fail_queued_handshake(next, GRPC_STATUS_INTERNAL);
+      }
+    }
+    return was_queued;
+  }
+
+ private:
+  void RemoveLocked(alts_grpc_handshaker_client* client) {
+    alts_grpc_handshaker_client* prev = nullptr;
+    for (alts_grpc_handshaker_client* c = head_; c != nullptr;
+         prev = c, c = c->next_queued) {
+      if (c != client) continue;
+      if (prev == nullptr) {
+        head_ = c->next_queued;
+      } else {
+        prev->next_queued = c->next_queued;
+      }
+      if (tail_ == c) tail_ = prev;
+      c->next_queued = nullptr;
+      return;
+    }
+  }
+
+  gpr_mu mu_;
+  const size_t max_outstanding_;
+  size_t outstanding_ = 0;
+  alts_grpc_handshaker_client* head_ = nullptr;
+  alts_grpc_handshaker_client* tail_ = nullptr;
+};
+
+gpr_once g_handshake_queue_init = GPR_ONCE_INIT;
+HandshakeQueue* g_client_handshake_queue;
+HandshakeQueue* g_server_handshake_queue;
+/* Set by tests to queue clients created without a call as well. */
+bool g_queue_clients_without_call = false;
+
+void init_handshake_queues() {
+  const size_t max_outstanding = static_cast<size_t>(
+      GPR_MAX(0, GPR_GLOBAL_CONFIG_GET(grpc_alts_max_concurrent_handshakes)));
+  g_client_handshake_queue = grpc_core::New<HandshakeQueue>(max_outstanding);
+  g_server_handshake_queue = grpc_core::New<HandshakeQueue>(max_outstanding);
+}
+
+HandshakeQueue* handshake_queue(alts_grpc_handshaker_client* client) {
+  gpr_once_init(&g_handshake_queue_init, init_handshake_queues);
+  return client->is_client ? g_client_handshake_queue
+                           : g_server_handshake_queue;
+}
+
+}  // namespace
+
 static void handshaker_client_send_buffer_destroy(
     alts_grpc_handshaker_client* client) {
   GPR_ASSERT(client != nullptr);
@@ -172,6 +332,7 @@ void alts_handshaker_client_handle_response(alts_handshaker_client* c,
   }
   tsi_handshaker_result* result = nullptr;
   if (is_handshake_finished_properly(resp)) {
+    handshake_queue(client)->HandshakeDone(client);
     alts_tsi_handshaker_result_create(resp, client->is_client, &result);
     alts_tsi_handshaker_result_set_unused_bytes(
         result, &client->recv_bytes,
@@ -196,10 +357,8 @@ void alts_handshaker_client_handle_response(alts_handshaker_client* c,
  * Populate grpc operation data with the fields of ALTS handshaker client and
  * make a grpc call.
  */
-static tsi_result make_grpc_call(alts_handshaker_client* c, bool is_start) {
-  GPR_ASSERT(c != nullptr);
-  alts_grpc_handshaker_client* client =
-      reinterpret_cast<alts_grpc_handshaker_client*>(c);
+static tsi_result continue_make_grpc_call(alts_grpc_handshaker_client* client,
+                                          bool is_start) {
   grpc_op ops[kHandshakerClientOpNum];
   memset(ops, 0, sizeof(ops));
   grpc_op* op = ops;
@@ -232,6 +391,23 @@ static tsi_result make_grpc_call(alts_handshaker_client* c, bool is_start) {
   return TSI_OK;
 }
 
+/**
+ * Make a grpc call, after waiting in the handshake queue if this starts a
+ * handshake with the handshaker service.
+ */
+static tsi_result make_grpc_call(alts_handshaker_client* c, bool is_start) {
+  GPR_ASSERT(c != nullptr);
+  alts_grpc_handshaker_client* client =
+      reinterpret_cast<alts_grpc_handshaker_client*>(c);
+  /* Clients without a call are only used in tests. */
+  if (is_start &&
+      (client->call != nullptr || g_queue_clients_without_call) &&
+      !handshake_queue(client)->RequestHandshake(client)) {
+    return TSI_OK;
+  }
+  return continue_make_grpc_call(client, is_start);
+}
+
 /* Serializes a grpc_gcp_HandshakerReq message into a buffer and returns newly
  * grpc_byte_buffer holding it. */
 static grpc_byte_buffer* get_serialized_handshaker_req(
@@ -410,6 +586,12 @@ static void handshaker_client_shutdown(alts_handshaker_client* c) {
   GPR_ASSERT(c != nullptr);
   alts_grpc_handshaker_client* client =
       reinterpret_cast<alts_grpc_handshaker_client*>(c);
+  /* A handshake still waiting for a slot has no call in progress to cancel,
+   * so complete it here. */
+  if (handshake_queue(client)->HandshakeDone(client)) {
+    fail_queued_handshake(client, GRPC_STATUS_CANCELLED);
+    return;
+  }
   if (client->call != nullptr) {
     grpc_call_cancel_internal(client->call);
   }
@@ -421,6 +603,7 @@ static void handshaker_client_destruct(alts_handshaker_client* c) {
   }
   alts_grpc_handshaker_client* client =
       reinterpret_cast<alts_grpc_handshaker_client*>(c);
+  handshake_queue(client)->HandshakeDone(client);
   if (client->call != nullptr) {
     grpc_call_unref(client->call);
   }
@@ -458,6 +641,8 @@ alts_handshaker_client* alts_grpc_handshaker_client_create(
   client->is_client = is_client;
   client->buffer_size = TSI_ALTS_INITIAL_BUFFER_SIZE;
   client->buffer = static_cast<unsigned char*>(gpr_zalloc(client->buffer_size));
+  client->queue_state = HANDSHAKE_NOT_STARTED;
+  client->next_queued = nullptr;
   grpc_slice slice = grpc_slice_from_copied_string(handshaker_service_url);
   client->call =
       strcmp(handshaker_service_url, ALTS_HANDSHAKER_SERVICE_URL_FOR_TESTING) ==
@@ -475,6 +660,14 @@ alts_handshaker_client* alts_grpc_handshaker_client_create(
   return &client->base;
 }
 
+alts_tsi_handshaker* alts_handshaker_client_get_handshaker(
+    alts_handshaker_client* c) {
+  GPR_ASSERT(c != nullptr);
+  alts_grpc_handshaker_client* client =
+      reinterpret_cast<alts_grpc_handshaker_client*>(c);
+  return client->handshaker;
+}
+
 namespace grpc_core {
 namespace internal {
 
@@ -580,6 +773,29 @@ grpc_closure* alts_handshaker_client_get_closure_for_testing(
   return &client->on_handshaker_service_resp_recv;
 }
 
+grpc_status_code alts_handshaker_client_get_status_for_testing(
+    alts_handshaker_client* c) {
+  GPR_ASSERT(c != nullptr);
+  alts_grpc_handshaker_client* client =
+      reinterpret_cast<alts_grpc_handshaker_client*>(c);
+  return client->status;
+}
+
+bool alts_handshaker_client_is_queued_for_testing(alts_handshaker_client* c) {
+  GPR_ASSERT(c != nullptr);
+  alts_grpc_handshaker_client* client =
+      reinterpret_cast<alts_grpc_handshaker_client*>(c);
+  return client->queue_state == HANDSHAKE_QUEUED;
+}
+
+void alts_handshaker_client_reset_handshake_queues_for_testing() {
+  gpr_once_init(&g_handshake_queue_init, init_handshake_queues);
+  grpc_core::Delete(g_client_handshake_queue);
+  grpc_core::Delete(g_server_handshake_queue);
+  init_handshake_queues();
+  g_queue_clients_without_call = true;
+}
+
 }  // namespace internal
 }  // namespace grpc_core
 
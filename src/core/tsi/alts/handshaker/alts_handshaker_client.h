@@ -28,6 +28,7 @@
 #include "src/core/tsi/alts/handshaker/alts_tsi_handshaker.h"
 #include "src/core/tsi/transport_security_interface.h"
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/pollset_set.h"
 
@@ -38,6 +39,8 @@
 
 const size_t kAltsAes128GcmRekeyKeyLength = 44;
 
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_alts_max_concurrent_handshakes);
+
 typedef struct alts_tsi_handshaker alts_tsi_handshaker;
 /**
  * A ALTS handshaker client interface. It is used to communicate with
@@ -143,6 +146,13 @@ alts_handshaker_client* alts_grpc_handshaker_client_create(
     void* user_data, alts_handshaker_client_vtable* vtable_for_testing,
     bool is_client);
 
+/**
+ * This method returns the ALTS TSI handshaker an ALTS handshaker client was
+ * created for.
+ */
+alts_tsi_handshaker* alts_handshaker_client_get_handshaker(
+    alts_handshaker_client* client);
+
 /**
  * This method handles handshaker response returned from ALTS handshaker
  * service. Note that the only reason the API is exposed is that it is used in
@@ -20,10 +20,21 @@
 
 #include "src/core/tsi/alts/handshaker/alts_shared_resource.h"
 
+#include <new>
+
+#include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_alts_handshaker_channels, 1,
+    "Number of channels to the ALTS handshaker service, each with its own "
+    "completion queue and thread, used by handshakes not driven by gRPC");
+
 static alts_shared_resource_dedicated g_alts_resource_dedicated;
 
 alts_shared_resource_dedicated* grpc_alts_get_shared_resource_dedicated(void) {
@@ -31,10 +42,11 @@ alts_shared_resource_dedicated* grpc_alts_get_shared_resource_dedicated(void) {
 }
 
 static void thread_worker(void* arg) {
+  alts_shared_resource_shard* shard =
+      static_cast<alts_shared_resource_shard*>(arg);
   while (true) {
-    grpc_event event =
-        grpc_completion_queue_next(g_alts_resource_dedicated.cq,
-                                   gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    grpc_event event = grpc_completion_queue_next(
+        shard->cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
     GPR_ASSERT(event.type != GRPC_QUEUE_TIMEOUT);
     if (event.type == GRPC_QUEUE_SHUTDOWN) {
       break;
@@ -47,37 +59,70 @@ static void thread_worker(void* arg) {
 }
 
 void grpc_alts_shared_resource_dedicated_init() {
-  g_alts_resource_dedicated.cq = nullptr;
+  g_alts_resource_dedicated.shards = nullptr;
+  g_alts_resource_dedicated.num_shards = 0;
+  gpr_atm_no_barrier_store(&g_alts_resource_dedicated.next_shard, 0);
   gpr_mu_init(&g_alts_resource_dedicated.mu);
 }
 
 void grpc_alts_shared_resource_dedicated_start(
     const char* handshaker_service_url) {
   gpr_mu_lock(&g_alts_resource_dedicated.mu);
-  if (g_alts_resource_dedicated.cq == nullptr) {
-    g_alts_resource_dedicated.channel =
-        grpc_insecure_channel_create(handshaker_service_url, nullptr, nullptr);
-    g_alts_resource_dedicated.cq =
-        grpc_completion_queue_create_for_next(nullptr);
-    g_alts_resource_dedicated.thread =
-        grpc_core::Thread("alts_tsi_handshaker", &thread_worker, nullptr);
-    g_alts_resource_dedicated.interested_parties = grpc_pollset_set_create();
-    grpc_pollset_set_add_pollset(g_alts_resource_dedicated.interested_parties,
-                                 grpc_cq_pollset(g_alts_resource_dedicated.cq));
-    g_alts_resource_dedicated.thread.Start();
+  if (g_alts_resource_dedicated.shards == nullptr) {
+    const size_t num_shards = static_cast<size_t>(
+        GPR_MAX(1, GPR_GLOBAL_CONFIG_GET(grpc_alts_handshaker_channels)));
+    // With a single channel, share the connection with any other channel to
+    // the handshaker service as before; otherwise each channel needs its own.
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), 1);
+    grpc_channel_args args = {1, &arg};
+    alts_shared_resource_shard* shards =
+        static_cast<alts_shared_resource_shard*>(
+            gpr_zalloc(num_shards * sizeof(*shards)));
+    for (size_t i = 0; i < num_shards; ++i) {
+      alts_shared_resource_shard* shard = &shards[i];
+      new (&shard->thread) grpc_core::Thread();
+      shard->channel = grpc_insecure_channel_create(
+          handshaker_service_url, num_shards > 1 ? &args : nullptr, nullptr);
+      shard->cq = grpc_completion_queue_create_for_next(nullptr);
+      shard->thread =
+          grpc_core::Thread("alts_tsi_handshaker", &thread_worker, shard);
+      shard->interested_parties = grpc_pollset_set_create();
+      grpc_pollset_set_add_pollset(shard->interested_parties,
+                                   grpc_cq_pollset(shard->cq));
+      shard->thread.Start();
+    }
+    g_alts_resource_dedicated.num_shards = num_shards;
+    g_alts_resource_dedicated.shards = shards;
   }
   gpr_mu_unlock(&g_alts_resource_dedicated.mu);
 }
 
+alts_shared_resource_shard* grpc_alts_shared_resource_dedicated_pick_shard(
+    void) {
+  GPR_ASSERT(g_alts_resource_dedicated.shards != nullptr);
+  const size_t index = static_cast<size_t>(
+      gpr_atm_no_barrier_fetch_add(&g_alts_resource_dedicated.next_shard, 1));
+  return &g_alts_resource_dedicated
+              .shards[index % g_alts_resource_dedicated.num_shards];
+}
+
 void grpc_alts_shared_resource_dedicated_shutdown() {
-  if (g_alts_resource_dedicated.cq != nullptr) {
-    grpc_pollset_set_del_pollset(g_alts_resource_dedicated.interested_parties,
-                                 grpc_cq_pollset(g_alts_resource_dedicated.cq));
-    grpc_completion_queue_shutdown(g_alts_resource_dedicated.cq);
-    g_alts_resource_dedicated.thread.Join();
-    grpc_pollset_set_destroy(g_alts_resource_dedicated.interested_parties);
-    grpc_completion_queue_destroy(g_alts_resource_dedicated.cq);
-    grpc_channel_destroy(g_alts_resource_dedicated.channel);
+  if (g_alts_resource_dedicated.shards != nullptr) {
+    for (size_t i = 0; i < g_alts_resource_dedicated.num_shards; ++i) {
+      alts_shared_resource_shard* shard = &g_alts_resource_dedicated.shards[i];
+      grpc_pollset_set_del_pollset(shard->interested_parties,
+                                   grpc_cq_pollset(shard->cq));
+      grpc_completion_queue_shutdown(shard->cq);
+      shard->thread.Join();
+      shard->thread.~Thread();
+      grpc_pollset_set_destroy(shard->interested_parties);
+      grpc_completion_queue_destroy(shard->cq);
+      grpc_channel_destroy(shard->channel);
+    }
+    gpr_free(g_alts_resource_dedicated.shards);
+    g_alts_resource_dedicated.shards = nullptr;
+    g_alts_resource_dedicated.num_shards = 0;
   }
   gpr_mu_destroy(&g_alts_resource_dedicated.mu);
 }
@@ -22,23 +22,38 @@
 #include <grpc/support/port_platform.h>
 
 #include <grpc/grpc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/surface/completion_queue.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_alts_handshaker_channels);
+
 /**
- * Main struct containing ALTS shared resources used when
- * employing the dedicated completion queue and thread.
+ * A channel to the handshaker service, together with the completion queue
+ * and thread driving the handshakes made on it.
  */
-typedef struct alts_shared_resource_dedicated {
+typedef struct alts_shared_resource_shard {
   grpc_core::Thread thread;
   grpc_completion_queue* cq;
   grpc_pollset_set* interested_parties;
-  grpc_cq_completion storage;
-  gpr_mu mu;
   grpc_channel* channel;
+} alts_shared_resource_shard;
+
+/**
+ * Main struct containing ALTS shared resources used when
+ * employing the dedicated completion queues and threads. Handshakes are
+ * spread round robin over the shards, whose number is set by the
+ * GRPC_ALTS_HANDSHAKER_CHANNELS environment variable.
+ */
+typedef struct alts_shared_resource_dedicated {
+  gpr_mu mu;
+  alts_shared_resource_shard* shards;
+  size_t num_shards;
+  gpr_atm next_shard;
 } alts_shared_resource_dedicated;
 
 /* This method returns the address of alts_shared_resource_dedicated
@@ -69,5 +84,12 @@ void grpc_alts_shared_resource_dedicated_init();
 void grpc_alts_shared_resource_dedicated_start(
     const char* handshaker_service_url);
 
+/**
+ * This method returns the shard a new TSI handshake should use. It must be
+ * invoked after grpc_alts_shared_resource_dedicated_start().
+ */
+alts_shared_resource_shard* grpc_alts_shared_resource_dedicated_pick_shard(
+    void);
+
 #endif /* GRPC_CORE_TSI_ALTS_HANDSHAKER_ALTS_SHARED_RESOURCE_H \
         */
@@ -52,6 +52,10 @@ struct alts_tsi_handshaker {
   grpc_alts_credentials_options* options;
   alts_handshaker_client_vtable* client_vtable_for_testing;
   grpc_channel* channel;
+  /* The shared channel, completion queue and thread used when there is no
+   * channel of our own, and the storage for completing on that queue. */
+  alts_shared_resource_shard* shard;
+  grpc_cq_completion cq_storage;
 };
 
 /* Main struct for ALTS TSI handshaker result. */
@@ -258,11 +262,11 @@ static void on_handshaker_service_resp_recv(void* arg, grpc_error* error) {
  * It serves to safely bring the control back to application. */
 static void on_handshaker_service_resp_recv_dedicated(void* arg,
                                                       grpc_error* error) {
-  alts_shared_resource_dedicated* resource =
-      grpc_alts_get_shared_resource_dedicated();
-  grpc_cq_end_op(resource->cq, arg, GRPC_ERROR_NONE,
+  alts_tsi_handshaker* handshaker = alts_handshaker_client_get_handshaker(
+      static_cast<alts_handshaker_client*>(arg));
+  grpc_cq_end_op(handshaker->shard->cq, arg, GRPC_ERROR_NONE,
                  [](void* done_arg, grpc_cq_completion* storage) {}, nullptr,
-                 &resource->storage);
+                 &handshaker->cq_storage);
 }
 
 static tsi_result handshaker_next(
@@ -285,17 +289,16 @@ static tsi_result handshaker_next(
     if (handshaker->channel == nullptr) {
       grpc_alts_shared_resource_dedicated_start(
           handshaker->handshaker_service_url);
-      handshaker->interested_parties =
-          grpc_alts_get_shared_resource_dedicated()->interested_parties;
+      handshaker->shard = grpc_alts_shared_resource_dedicated_pick_shard();
+      handshaker->interested_parties = handshaker->shard->interested_parties;
       GPR_ASSERT(handshaker->interested_parties != nullptr);
     }
     grpc_iomgr_cb_func grpc_cb = handshaker->channel == nullptr
                                      ? on_handshaker_service_resp_recv_dedicated
                                      : on_handshaker_service_resp_recv;
-    grpc_channel* channel =
-        handshaker->channel == nullptr
-            ? grpc_alts_get_shared_resource_dedicated()->channel
-            : handshaker->channel;
+    grpc_channel* channel = handshaker->channel == nullptr
+                                ? handshaker->shard->channel
+                                : handshaker->channel;
     handshaker->client = alts_grpc_handshaker_client_create(
         handshaker, channel, handshaker->handshaker_service_url,
         handshaker->interested_parties, handshaker->options,
@@ -309,8 +312,7 @@ static tsi_result handshaker_next(
   }
   if (handshaker->channel == nullptr &&
       handshaker->client_vtable_for_testing == nullptr) {
-    GPR_ASSERT(grpc_cq_begin_op(grpc_alts_get_shared_resource_dedicated()->cq,
-                                handshaker->client));
+    GPR_ASSERT(grpc_cq_begin_op(handshaker->shard->cq, handshaker->client));
   }
   grpc_slice slice = (received_bytes == nullptr || received_bytes_size == 0)
                          ? grpc_empty_slice()
@@ -77,6 +77,17 @@ void alts_handshaker_client_set_cb_for_testing(
 grpc_closure* alts_handshaker_client_get_closure_for_testing(
     alts_handshaker_client* client);
 
+grpc_status_code alts_handshaker_client_get_status_for_testing(
+    alts_handshaker_client* client);
+
+bool alts_handshaker_client_is_queued_for_testing(
+    alts_handshaker_client* client);
+
+/* Recreates the handshake queues with the current
+ * GRPC_ALTS_MAX_CONCURRENT_HANDSHAKES limit, and has clients created without
+ * a call wait in them too. No handshake may be in flight. */
+void alts_handshaker_client_reset_handshake_queues_for_testing();
+
 }  // namespace internal
 }  // namespace grpc_core
 
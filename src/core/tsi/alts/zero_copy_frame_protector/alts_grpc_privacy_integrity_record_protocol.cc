@@ -23,6 +23,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_grpc_record_protocol_common.h"
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_iovec_record_protocol.h"
@@ -69,6 +70,85 @@ static tsi_result alts_grpc_privacy_integrity_protect(
   return TSI_OK;
 }
 
+static tsi_result alts_grpc_privacy_integrity_protect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_frame_data_size,
+    grpc_slice_buffer* protected_slices) {
+  /* Input sanity check.  */
+  if (rp == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr) {
+    gpr_log(GPR_ERROR,
+            "Invalid nullptr arguments to alts_grpc_record_protocol protect.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  /* Allocates one buffer for all the output frames. There is always at least
+   * one frame, even for empty data.  */
+  size_t remaining = unprotected_slices->length;
+  size_t num_frames =
+      remaining <= max_unprotected_frame_data_size
+          ? 1
+          : (remaining + max_unprotected_frame_data_size - 1) /
+                max_unprotected_frame_data_size;
+  size_t frame_overhead =
+      rp->header_length +
+      alts_iovec_record_protocol_get_tag_length(rp->iovec_rp);
+  grpc_slice protected_slice =
+      GRPC_SLICE_MALLOC(remaining + num_frames * frame_overhead);
+  uint8_t* protected_frame = GRPC_SLICE_START_PTR(protected_slice);
+  /* Seals the frames one after the other. The iovec entries of each frame are
+   * a window into rp->iovec_buf: entries consumed by earlier frames are
+   * advanced past and the last entry of the window is cut to size for the
+   * duration of the call.  */
+  alts_grpc_record_protocol_convert_slice_buffer_to_iovec(rp,
+                                                          unprotected_slices);
+  iovec_t* vec = rp->iovec_buf;
+  size_t vec_length = unprotected_slices->count;
+  size_t first = 0;
+  for (size_t i = 0; i < num_frames; i++) {
+    size_t frame_data_size = GPR_MIN(remaining, max_unprotected_frame_data_size);
+    size_t frame_vec_length = 0;
+    size_t last = first;
+    iovec_t last_vec = {nullptr, 0};
+    size_t last_vec_used = 0;
+    if (frame_data_size > 0) {
+      size_t covered = 0;
+      while (covered + vec[last].iov_len < frame_data_size) {
+        covered += vec[last].iov_len;
+        last++;
+      }
+      GPR_ASSERT(last < vec_length);
+      last_vec = vec[last];
+      last_vec_used = frame_data_size - covered;
+      vec[last].iov_len = last_vec_used;
+      frame_vec_length = last - first + 1;
+    }
+    iovec_t protected_iovec = {protected_frame,
+                               frame_data_size + frame_overhead};
+    char* error_details = nullptr;
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_protect(
+            rp->iovec_rp, vec + first, frame_vec_length, protected_iovec,
+            &error_details);
+    if (status != GRPC_STATUS_OK) {
+      gpr_log(GPR_ERROR, "Failed to protect, %s", error_details);
+      gpr_free(error_details);
+      grpc_slice_unref_internal(protected_slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    if (frame_data_size > 0) {
+      vec[last].iov_base =
+          static_cast<uint8_t*>(last_vec.iov_base) + last_vec_used;
+      vec[last].iov_len = last_vec.iov_len - last_vec_used;
+      first = vec[last].iov_len == 0 ? last + 1 : last;
+    }
+    protected_frame += protected_iovec.iov_len;
+    remaining -= frame_data_size;
+  }
+  grpc_slice_buffer_add(protected_slices, protected_slice);
+  grpc_slice_buffer_reset_and_unref_internal(unprotected_slices);
+  return TSI_OK;
+}
+
 static tsi_result alts_grpc_privacy_integrity_unprotect(
     alts_grpc_record_protocol* rp, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices) {
@@ -118,7 +198,8 @@ static tsi_result alts_grpc_privacy_integrity_unprotect(
 static const alts_grpc_record_protocol_vtable
     alts_grpc_privacy_integrity_record_protocol_vtable = {
         alts_grpc_privacy_integrity_protect,
-        alts_grpc_privacy_integrity_unprotect, nullptr};
+        alts_grpc_privacy_integrity_unprotect, nullptr,
+        alts_grpc_privacy_integrity_protect_frames};
 
 tsi_result alts_grpc_privacy_integrity_record_protocol_create(
     gsec_aead_crypter* crypter, size_t overflow_size, bool is_client,
@@ -50,6 +50,30 @@ tsi_result alts_grpc_record_protocol_protect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
     grpc_slice_buffer* protected_slices);
 
+/**
+ * This method protects unprotected data as a sequence of frames carrying at
+ * most max_unprotected_frame_data_size bytes of data each, all but the last one
+ * full, and appends them to protected_slices. It produces the same frames as
+ * calling alts_grpc_record_protocol_protect on each chunk of data, but seals
+ * them all into one newly allocated buffer. The input unprotected data slice
+ * buffer will be cleared, although the actual unprotected data bytes are not
+ * modified.
+ *
+ * - self: an alts_grpc_record_protocol instance.
+ * - unprotected_slices: the unprotected data to be protected.
+ * - max_unprotected_frame_data_size: the maximum amount of data in a frame, as
+ *   returned by alts_grpc_record_protocol_max_unprotected_data_size.
+ * - protected_slices: slice buffer where the protected frames are appended.
+ *
+ * This method returns TSI_OK in case of success, TSI_UNIMPLEMENTED if the
+ * record protocol protects frames in place (integrity-only), or a specific
+ * error code in case of failure.
+ */
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_frame_data_size,
+    grpc_slice_buffer* protected_slices);
+
 /**
  * This methods performs unprotect operation on a full frame of protected data
  * and appends unprotected data to unprotected_slices. It is the caller's
@@ -134,6 +134,23 @@ tsi_result alts_grpc_record_protocol_protect(
   return self->vtable->protect(self, unprotected_slices, protected_slices);
 }
 
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_frame_data_size,
+    grpc_slice_buffer* protected_slices) {
+  if (grpc_core::ExecCtx::Get() == nullptr || self == nullptr ||
+      self->vtable == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_unprotected_frame_data_size == 0) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->protect_frames == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  return self->vtable->protect_frames(self, unprotected_slices,
+                                      max_unprotected_frame_data_size,
+                                      protected_slices);
+}
+
 tsi_result alts_grpc_record_protocol_unprotect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices) {
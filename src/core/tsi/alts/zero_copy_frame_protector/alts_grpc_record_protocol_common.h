@@ -39,6 +39,10 @@ typedef struct {
                           grpc_slice_buffer* protected_slices,
                           grpc_slice_buffer* unprotected_slices);
   void (*destruct)(alts_grpc_record_protocol* self);
+  tsi_result (*protect_frames)(alts_grpc_record_protocol* self,
+                               grpc_slice_buffer* unprotected_slices,
+                               size_t max_unprotected_frame_data_size,
+                               grpc_slice_buffer* protected_slices);
 } alts_grpc_record_protocol_vtable;
 
 /* Main struct for alts_grpc_record_protocol implementation, shared by both
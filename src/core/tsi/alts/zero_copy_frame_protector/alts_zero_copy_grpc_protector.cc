@@ -156,6 +156,13 @@ static tsi_result alts_zero_copy_grpc_protector_protect(
   }
   alts_zero_copy_grpc_protector* protector =
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
+  /* Seals all frames into one buffer if the record protocol can.  */
+  tsi_result result = alts_grpc_record_protocol_protect_frames(
+      protector->record_protocol, unprotected_slices,
+      protector->max_unprotected_data_size, protected_slices);
+  if (result != TSI_UNIMPLEMENTED) {
+    return result;
+  }
   /* Calls alts_grpc_record_protocol protect repeatly.  */
   while (unprotected_slices->length > protector->max_unprotected_data_size) {
     grpc_slice_buffer_move_first(unprotected_slices,
@@ -45,15 +45,20 @@ extern "C" {
 #include <openssl/bio.h>
 #include <openssl/crypto.h> /* For OPENSSL_free */
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
 }
 
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 
@@ -101,6 +106,7 @@ struct tsi_ssl_server_handshaker_factory {
   size_t ssl_context_count;
   unsigned char* alpn_protocol_list;
   size_t alpn_protocol_list_length;
+  tsi_ssl_session_ticket_keys* session_ticket_keys;
 };
 
 typedef struct {
@@ -130,6 +136,20 @@ typedef struct {
   size_t buffer_offset;
 } tsi_ssl_frame_protector;
 
+typedef struct {
+  tsi_zero_copy_grpc_protector base;
+  /* protect and unprotect may run concurrently but share the SSL object */
+  gpr_mu mu;
+  SSL* ssl;
+  BIO* network_io;
+  /* staging for data too small to be written as a record by itself */
+  unsigned char* buffer;
+  size_t buffer_size;
+  size_t buffer_offset;
+  /* unused tail of the slice that SSL_read decrypts into */
+  grpc_slice read_slice;
+} tsi_ssl_zero_copy_grpc_protector;
+
 /* --- Library Initialization. ---*/
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
@@ -808,6 +828,33 @@ tsi_ssl_root_certs_store* tsi_ssl_root_certs_store_create(
   return root_store;
 }
 
+tsi_ssl_root_certs_store* tsi_ssl_root_certs_store_create_from_hashed_dir(
+    const char* certs_dir) {
+  if (certs_dir == nullptr) {
+    gpr_log(GPR_ERROR, "The root certificates directory is empty.");
+    return nullptr;
+  }
+  tsi_ssl_root_certs_store* root_store = static_cast<tsi_ssl_root_certs_store*>(
+      gpr_zalloc(sizeof(tsi_ssl_root_certs_store)));
+  root_store->store = X509_STORE_new();
+  if (root_store->store == nullptr) {
+    gpr_log(GPR_ERROR, "Could not allocate buffer for X509_STORE.");
+    gpr_free(root_store);
+    return nullptr;
+  }
+  X509_LOOKUP* lookup =
+      X509_STORE_add_lookup(root_store->store, X509_LOOKUP_hash_dir());
+  if (lookup == nullptr ||
+      !X509_LOOKUP_add_dir(lookup, certs_dir, X509_FILETYPE_PEM)) {
+    gpr_log(GPR_ERROR, "Could not use root certificates directory %s.",
+            certs_dir);
+    X509_STORE_free(root_store->store);
+    gpr_free(root_store);
+    return nullptr;
+  }
+  return root_store;
+}
+
 void tsi_ssl_root_certs_store_destroy(tsi_ssl_root_certs_store* self) {
   if (self == nullptr) return;
   X509_STORE_free(self->store);
@@ -831,6 +878,119 @@ void tsi_ssl_session_cache_unref(tsi_ssl_session_cache* cache) {
   reinterpret_cast<tsi::SslSessionLRUCache*>(cache)->Unref();
 }
 
+/* --- tsi_ssl_session_ticket_keys methods implementation. ---*/
+
+#define TSI_SSL_SESSION_TICKET_KEY_NAME_SIZE 16
+#define TSI_SSL_SESSION_TICKET_HMAC_KEY_SIZE 16
+
+struct tsi_ssl_session_ticket_keys {
+  gpr_refcount refcount;
+  gpr_mu mu;
+  /* count keys of TSI_SSL_SESSION_TICKET_KEY_SIZE bytes, guarded by mu */
+  unsigned char* keys;
+  size_t count;
+};
+
+tsi_ssl_session_ticket_keys* tsi_ssl_session_ticket_keys_create(void) {
+  tsi_ssl_session_ticket_keys* keys =
+      static_cast<tsi_ssl_session_ticket_keys*>(gpr_zalloc(sizeof(*keys)));
+  gpr_ref_init(&keys->refcount, 1);
+  gpr_mu_init(&keys->mu);
+  return keys;
+}
+
+void tsi_ssl_session_ticket_keys_ref(tsi_ssl_session_ticket_keys* keys) {
+  gpr_ref(&keys->refcount);
+}
+
+void tsi_ssl_session_ticket_keys_unref(tsi_ssl_session_ticket_keys* keys) {
+  if (keys == nullptr || !gpr_unref(&keys->refcount)) return;
+  if (keys->keys != nullptr) {
+    OPENSSL_cleanse(keys->keys, keys->count * TSI_SSL_SESSION_TICKET_KEY_SIZE);
+    gpr_free(keys->keys);
+  }
+  gpr_mu_destroy(&keys->mu);
+  gpr_free(keys);
+}
+
+tsi_result tsi_ssl_session_ticket_keys_set(tsi_ssl_session_ticket_keys* keys,
+                                           const unsigned char* key_data,
+                                           size_t keys_size) {
+  if (keys == nullptr || key_data == nullptr || keys_size == 0 ||
+      keys_size % TSI_SSL_SESSION_TICKET_KEY_SIZE != 0) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  unsigned char* new_keys = static_cast<unsigned char*>(gpr_malloc(keys_size));
+  memcpy(new_keys, key_data, keys_size);
+  gpr_mu_lock(&keys->mu);
+  unsigned char* old_keys = keys->keys;
+  size_t old_count = keys->count;
+  keys->keys = new_keys;
+  keys->count = keys_size / TSI_SSL_SESSION_TICKET_KEY_SIZE;
+  gpr_mu_unlock(&keys->mu);
+  if (old_keys != nullptr) {
+    OPENSSL_cleanse(old_keys, old_count * TSI_SSL_SESSION_TICKET_KEY_SIZE);
+    gpr_free(old_keys);
+  }
+  return TSI_OK;
+}
+
+/* Sets up ctx and hmac_ctx to protect or unprotect a ticket with key. Returns
+   1 on success and -1 on failure. */
+static int ssl_session_ticket_init(const unsigned char* key,
+                                   unsigned char* iv, EVP_CIPHER_CTX* ctx,
+                                   HMAC_CTX* hmac_ctx, int encrypt) {
+  const unsigned char* hmac_key = key + TSI_SSL_SESSION_TICKET_KEY_NAME_SIZE;
+  const unsigned char* aes_key =
+      hmac_key + TSI_SSL_SESSION_TICKET_HMAC_KEY_SIZE;
+  if (!HMAC_Init_ex(hmac_ctx, hmac_key, TSI_SSL_SESSION_TICKET_HMAC_KEY_SIZE,
+                    EVP_sha256(), nullptr)) {
+    return -1;
+  }
+  int ok = encrypt ? EVP_EncryptInit_ex(ctx, EVP_aes_128_cbc(), nullptr,
+                                        aes_key, iv)
+                   : EVP_DecryptInit_ex(ctx, EVP_aes_128_cbc(), nullptr,
+                                        aes_key, iv);
+  return ok ? 1 : -1;
+}
+
+/* Protects tickets with the keys of a tsi_ssl_session_ticket_keys, see
+   SSL_CTX_set_tlsext_ticket_key_cb. Returns 0 when it has no key to issue a
+   ticket with or does not know the key of a received one, which makes the
+   session a full handshake. */
+static int ssl_session_ticket_keys_process(tsi_ssl_session_ticket_keys* keys,
+                                           unsigned char* key_name,
+                                           unsigned char* iv,
+                                           EVP_CIPHER_CTX* ctx,
+                                           HMAC_CTX* hmac_ctx, int encrypt) {
+  int result = 0;
+  gpr_mu_lock(&keys->mu);
+  if (encrypt) {
+    if (keys->count > 0) {
+      if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_128_cbc())) != 1) {
+        result = -1;
+      } else {
+        memcpy(key_name, keys->keys, TSI_SSL_SESSION_TICKET_KEY_NAME_SIZE);
+        result = ssl_session_ticket_init(keys->keys, iv, ctx, hmac_ctx, 1);
+      }
+    }
+  } else {
+    for (size_t i = 0; i < keys->count; i++) {
+      const unsigned char* key =
+          keys->keys + i * TSI_SSL_SESSION_TICKET_KEY_SIZE;
+      if (CRYPTO_memcmp(key, key_name, TSI_SSL_SESSION_TICKET_KEY_NAME_SIZE) ==
+          0) {
+        result = ssl_session_ticket_init(key, iv, ctx, hmac_ctx, 0);
+        /* 2 asks for a ticket issued with the current key. */
+        if (result == 1 && i > 0) result = 2;
+        break;
+      }
+    }
+  }
+  gpr_mu_unlock(&keys->mu);
+  return result;
+}
+
 /* --- tsi_frame_protector methods implementation. ---*/
 
 static tsi_result ssl_protector_protect(tsi_frame_protector* self,
@@ -982,6 +1142,239 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+/* Exports the write keys of ssl, see
+   tsi_ssl_frame_protector_export_write_keys(). */
+static tsi_result ssl_export_write_keys(SSL* ssl, BIO* network_io,
+                                        tsi_ssl_kernel_tls_keys* keys) {
+#ifdef OPENSSL_IS_BORINGSSL
+  if (BIO_pending(network_io) != 0) return TSI_FAILED_PRECONDITION;
+  if (SSL_version(ssl) != TLS1_2_VERSION) return TSI_UNIMPLEMENTED;
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) return TSI_FAILED_PRECONDITION;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      keys->key_size = 16;
+      break;
+    case NID_aes_256_gcm:
+      keys->key_size = 32;
+      break;
+    default:
+      return TSI_UNIMPLEMENTED;
+  }
+  /* With AEAD ciphers there are no MAC keys, so the key block is the client
+     and server write keys followed by the client and server write IVs (RFC
+     5246 section 6.3, RFC 5288 section 3). */
+  const size_t salt_size = sizeof(keys->salt);
+  uint8_t key_block[2 * (sizeof(keys->key) + sizeof(keys->salt))];
+  const size_t key_block_size = 2 * (keys->key_size + salt_size);
+  if (SSL_get_key_block_len(ssl) != key_block_size ||
+      !SSL_generate_key_block(ssl, key_block, key_block_size)) {
+    return TSI_INTERNAL_ERROR;
+  }
+  const bool is_server = SSL_is_server(ssl) != 0;
+  memcpy(keys->key, key_block + (is_server ? keys->key_size : 0),
+         keys->key_size);
+  memcpy(keys->salt,
+         key_block + 2 * keys->key_size + (is_server ? salt_size : 0),
+         salt_size);
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+  uint64_t seq = SSL_get_write_sequence(ssl);
+  for (size_t i = sizeof(keys->rec_seq); i > 0; i--) {
+    keys->rec_seq[i - 1] = static_cast<unsigned char>(seq & 0xff);
+    seq >>= 8;
+  }
+  return TSI_OK;
+#else
+  /* OpenSSL has no way to export the traffic keys of a session that reads and
+     writes through memory BIOs. */
+  return TSI_UNIMPLEMENTED;
+#endif
+}
+
+tsi_result tsi_ssl_frame_protector_export_write_keys(
+    tsi_frame_protector* self, tsi_ssl_kernel_tls_keys* keys) {
+  if (self == nullptr || keys == nullptr) return TSI_INVALID_ARGUMENT;
+  if (self->vtable != &frame_protector_vtable) return TSI_UNIMPLEMENTED;
+  tsi_ssl_frame_protector* impl =
+      reinterpret_cast<tsi_ssl_frame_protector*>(self);
+  if (impl->buffer_offset != 0) return TSI_FAILED_PRECONDITION;
+  return ssl_export_write_keys(impl->ssl, impl->network_io, keys);
+}
+
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+/* Slices unprotected data is decrypted into; the unused tail of one is kept
+   for the next read as long as it can hold a reasonable amount of data. */
+static const size_t kSslZeroCopyReadSliceSize = 16384;
+static const size_t kSslZeroCopyMinReadSliceSize = 1024;
+
+/* Moves all the protected bytes waiting in network_io to protected_slices. */
+static tsi_result ssl_drain_network_io(BIO* network_io,
+                                       grpc_slice_buffer* protected_slices) {
+  int pending;
+  while ((pending = static_cast<int>(BIO_pending(network_io))) > 0) {
+    grpc_slice slice = GRPC_SLICE_MALLOC(static_cast<size_t>(pending));
+    int read_from_bio =
+        BIO_read(network_io, GRPC_SLICE_START_PTR(slice), pending);
+    if (read_from_bio <= 0) {
+      gpr_log(GPR_ERROR,
+              "Could not read from BIO even though some data is pending");
+      grpc_slice_unref_internal(slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    grpc_slice_buffer_add(
+        protected_slices,
+        grpc_slice_sub_no_ref(slice, 0, static_cast<size_t>(read_from_bio)));
+  }
+  return TSI_OK;
+}
+
+/* Writes bytes as one record and moves it to protected_slices. */
+static tsi_result ssl_zero_copy_write_record(
+    tsi_ssl_zero_copy_grpc_protector* impl, unsigned char* bytes,
+    size_t bytes_size, grpc_slice_buffer* protected_slices) {
+  tsi_result result = do_ssl_write(impl->ssl, bytes, bytes_size);
+  if (result != TSI_OK) return result;
+  return ssl_drain_network_io(impl->network_io, protected_slices);
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  if (self == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr) {
+    gpr_log(GPR_ERROR, "Invalid nullptr arguments to zero-copy grpc protect.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_result result = TSI_OK;
+  gpr_mu_lock(&impl->mu);
+  for (size_t i = 0; i < unprotected_slices->count && result == TSI_OK; i++) {
+    unsigned char* bytes = GRPC_SLICE_START_PTR(unprotected_slices->slices[i]);
+    size_t bytes_size = GRPC_SLICE_LENGTH(unprotected_slices->slices[i]);
+    while (bytes_size > 0 && result == TSI_OK) {
+      if (impl->buffer_offset == 0 && bytes_size >= impl->buffer_size) {
+        /* A full record straight out of the slice. */
+        result = ssl_zero_copy_write_record(impl, bytes, impl->buffer_size,
+                                            protected_slices);
+        bytes += impl->buffer_size;
+        bytes_size -= impl->buffer_size;
+        continue;
+      }
+      size_t to_copy =
+          GPR_MIN(bytes_size, impl->buffer_size - impl->buffer_offset);
+      memcpy(impl->buffer + impl->buffer_offset, bytes, to_copy);
+      impl->buffer_offset += to_copy;
+      bytes += to_copy;
+      bytes_size -= to_copy;
+      if (impl->buffer_offset == impl->buffer_size) {
+        result = ssl_zero_copy_write_record(impl, impl->buffer,
+                                            impl->buffer_size, protected_slices);
+        impl->buffer_offset = 0;
+      }
+    }
+  }
+  if (result == TSI_OK && impl->buffer_offset > 0) {
+    result = ssl_zero_copy_write_record(impl, impl->buffer, impl->buffer_offset,
+                                        protected_slices);
+    impl->buffer_offset = 0;
+  }
+  gpr_mu_unlock(&impl->mu);
+  grpc_slice_buffer_reset_and_unref_internal(unprotected_slices);
+  return result;
+}
+
+/* Decrypts everything SSL can out of network_io into unprotected_slices. */
+static tsi_result ssl_zero_copy_read_records(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* unprotected_slices) {
+  for (;;) {
+    if (GRPC_SLICE_LENGTH(impl->read_slice) < kSslZeroCopyMinReadSliceSize) {
+      grpc_slice_unref_internal(impl->read_slice);
+      impl->read_slice = GRPC_SLICE_MALLOC(kSslZeroCopyReadSliceSize);
+    }
+    size_t read_size = GRPC_SLICE_LENGTH(impl->read_slice);
+    tsi_result result = do_ssl_read(
+        impl->ssl, GRPC_SLICE_START_PTR(impl->read_slice), &read_size);
+    if (result != TSI_OK || read_size == 0) return result;
+    grpc_slice_buffer_add(unprotected_slices,
+                          grpc_slice_split_head(&impl->read_slice, read_size));
+  }
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices) {
+  if (self == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr) {
+    gpr_log(GPR_ERROR,
+            "Invalid nullptr arguments to zero-copy grpc unprotect.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_result result = TSI_OK;
+  gpr_mu_lock(&impl->mu);
+  for (size_t i = 0; i < protected_slices->count && result == TSI_OK; i++) {
+    const unsigned char* bytes =
+        GRPC_SLICE_START_PTR(protected_slices->slices[i]);
+    size_t bytes_size = GRPC_SLICE_LENGTH(protected_slices->slices[i]);
+    while (bytes_size > 0 && result == TSI_OK) {
+      GPR_ASSERT(bytes_size <= INT_MAX);
+      int written_into_ssl = BIO_write(impl->network_io, bytes,
+                                       static_cast<int>(bytes_size));
+      if (written_into_ssl <= 0) {
+        /* The BIO pair buffer holds more than a full record, so reading
+           always frees up room unless something went wrong. */
+        gpr_log(GPR_ERROR, "Sending protected frame to ssl failed with %d",
+                written_into_ssl);
+        result = TSI_INTERNAL_ERROR;
+        break;
+      }
+      bytes += written_into_ssl;
+      bytes_size -= static_cast<size_t>(written_into_ssl);
+      result = ssl_zero_copy_read_records(impl, unprotected_slices);
+    }
+  }
+  gpr_mu_unlock(&impl->mu);
+  grpc_slice_buffer_reset_and_unref_internal(protected_slices);
+  return result;
+}
+
+static void ssl_zero_copy_grpc_protector_destroy(
+    tsi_zero_copy_grpc_protector* self) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  gpr_free(impl->buffer);
+  if (impl->ssl != nullptr) SSL_free(impl->ssl);
+  if (impl->network_io != nullptr) BIO_free(impl->network_io);
+  grpc_slice_unref_internal(impl->read_slice);
+  gpr_mu_destroy(&impl->mu);
+  gpr_free(self);
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_grpc_protector_protect,
+        ssl_zero_copy_grpc_protector_unprotect,
+        ssl_zero_copy_grpc_protector_destroy,
+};
+
+tsi_result tsi_ssl_zero_copy_grpc_protector_export_write_keys(
+    tsi_zero_copy_grpc_protector* self, tsi_ssl_kernel_tls_keys* keys) {
+  if (self == nullptr || keys == nullptr) return TSI_INVALID_ARGUMENT;
+  if (self->vtable != &zero_copy_grpc_protector_vtable) {
+    return TSI_UNIMPLEMENTED;
+  }
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  gpr_mu_lock(&impl->mu);
+  tsi_result result = ssl_export_write_keys(impl->ssl, impl->network_io, keys);
+  gpr_mu_unlock(&impl->mu);
+  return result;
+}
+
 /* --- tsi_server_handshaker_factory methods implementation. --- */
 
 static void tsi_ssl_handshaker_factory_destroy(
@@ -1076,18 +1469,12 @@ static tsi_result ssl_handshaker_result_extract_peer(
   return result;
 }
 
-static tsi_result ssl_handshaker_result_create_frame_protector(
-    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
-    tsi_frame_protector** protector) {
+/* Clamps the requested frame size, if any, and returns how much unprotected
+   data fits in one frame of that size. */
+static size_t ssl_protector_buffer_size(
+    size_t* max_output_protected_frame_size) {
   size_t actual_max_output_protected_frame_size =
       TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
-  tsi_ssl_handshaker_result* impl =
-      reinterpret_cast<tsi_ssl_handshaker_result*>(
-          const_cast<tsi_handshaker_result*>(self));
-  tsi_ssl_frame_protector* protector_impl =
-      static_cast<tsi_ssl_frame_protector*>(
-          gpr_zalloc(sizeof(*protector_impl)));
-
   if (max_output_protected_frame_size != nullptr) {
     if (*max_output_protected_frame_size >
         TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
@@ -1100,8 +1487,47 @@ static tsi_result ssl_handshaker_result_create_frame_protector(
     }
     actual_max_output_protected_frame_size = *max_output_protected_frame_size;
   }
+  return actual_max_output_protected_frame_size -
+         TSI_SSL_MAX_PROTECTION_OVERHEAD;
+}
+
+static tsi_result ssl_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  tsi_ssl_zero_copy_grpc_protector* protector_impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+  gpr_mu_init(&protector_impl->mu);
   protector_impl->buffer_size =
-      actual_max_output_protected_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
+      ssl_protector_buffer_size(max_output_protected_frame_size);
+  protector_impl->buffer =
+      static_cast<unsigned char*>(gpr_malloc(protector_impl->buffer_size));
+  protector_impl->read_slice = grpc_empty_slice();
+  /* Transfer ownership of ssl and network_io to the protector. */
+  protector_impl->ssl = impl->ssl;
+  impl->ssl = nullptr;
+  protector_impl->network_io = impl->network_io;
+  impl->network_io = nullptr;
+  protector_impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  *protector = &protector_impl->base;
+  return TSI_OK;
+}
+
+static tsi_result ssl_handshaker_result_create_frame_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_frame_protector** protector) {
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  tsi_ssl_frame_protector* protector_impl =
+      static_cast<tsi_ssl_frame_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+
+  protector_impl->buffer_size =
+      ssl_protector_buffer_size(max_output_protected_frame_size);
   protector_impl->buffer =
       static_cast<unsigned char*>(gpr_malloc(protector_impl->buffer_size));
   if (protector_impl->buffer == nullptr) {
@@ -1142,7 +1568,7 @@ static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
 
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_extract_peer,
-    nullptr, /* create_zero_copy_grpc_protector */
+    ssl_handshaker_result_create_zero_copy_grpc_protector,
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
@@ -1447,6 +1873,13 @@ tsi_result tsi_ssl_client_handshaker_factory_create_handshaker(
                                    &self->base, handshaker);
 }
 
+tsi_ssl_client_handshaker_factory* tsi_ssl_client_handshaker_factory_ref(
+    tsi_ssl_client_handshaker_factory* self) {
+  if (self == nullptr) return nullptr;
+  tsi_ssl_handshaker_factory_ref(&self->base);
+  return self;
+}
+
 void tsi_ssl_client_handshaker_factory_unref(
     tsi_ssl_client_handshaker_factory* self) {
   if (self == nullptr) return;
@@ -1487,6 +1920,13 @@ tsi_result tsi_ssl_server_handshaker_factory_create_handshaker(
                                    &self->base, handshaker);
 }
 
+tsi_ssl_server_handshaker_factory* tsi_ssl_server_handshaker_factory_ref(
+    tsi_ssl_server_handshaker_factory* self) {
+  if (self == nullptr) return nullptr;
+  tsi_ssl_handshaker_factory_ref(&self->base);
+  return self;
+}
+
 void tsi_ssl_server_handshaker_factory_unref(
     tsi_ssl_server_handshaker_factory* self) {
   if (self == nullptr) return;
@@ -1510,6 +1950,7 @@ static void tsi_ssl_server_handshaker_factory_destroy(
     gpr_free(self->ssl_context_x509_subject_names);
   }
   if (self->alpn_protocol_list != nullptr) gpr_free(self->alpn_protocol_list);
+  tsi_ssl_session_ticket_keys_unref(self->session_ticket_keys);
   gpr_free(self);
 }
 
@@ -1598,6 +2039,17 @@ static int server_handshaker_factory_npn_advertised_callback(
   return SSL_TLSEXT_ERR_OK;
 }
 
+static int server_handshaker_factory_session_ticket_key_callback(
+    SSL* ssl, unsigned char* key_name, unsigned char* iv, EVP_CIPHER_CTX* ctx,
+    HMAC_CTX* hmac_ctx, int encrypt) {
+  tsi_ssl_server_handshaker_factory* factory =
+      static_cast<tsi_ssl_server_handshaker_factory*>(SSL_CTX_get_ex_data(
+          SSL_get_SSL_CTX(ssl), g_ssl_ctx_ex_factory_index));
+  if (factory == nullptr || factory->session_ticket_keys == nullptr) return 0;
+  return ssl_session_ticket_keys_process(factory->session_ticket_keys,
+                                         key_name, iv, ctx, hmac_ctx, encrypt);
+}
+
 /// This callback is called when new \a session is established and ready to
 /// be cached. This session can be reused for new connections to similar
 /// servers at later point of time.
@@ -1804,6 +2256,10 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
     return TSI_OUT_OF_RESOURCES;
   }
   impl->ssl_context_count = options->num_key_cert_pairs;
+  if (options->session_ticket_keys != nullptr) {
+    tsi_ssl_session_ticket_keys_ref(options->session_ticket_keys);
+    impl->session_ticket_keys = options->session_ticket_keys;
+  }
 
   if (options->num_alpn_protocols > 0) {
     result = build_alpn_protocol_name_list(
@@ -1844,7 +2300,13 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
         break;
       }
 
-      if (options->session_ticket_key != nullptr) {
+      if (options->session_ticket_keys != nullptr) {
+        SSL_CTX_set_ex_data(impl->ssl_contexts[i], g_ssl_ctx_ex_factory_index,
+                            impl);
+        SSL_CTX_set_tlsext_ticket_key_cb(
+            impl->ssl_contexts[i],
+            server_handshaker_factory_session_ticket_key_callback);
+      } else if (options->session_ticket_key != nullptr) {
         if (SSL_CTX_set_tlsext_ticket_keys(
                 impl->ssl_contexts[i],
                 const_cast<char*>(options->session_ticket_key),
@@ -48,6 +48,13 @@ typedef struct tsi_ssl_root_certs_store tsi_ssl_root_certs_store;
 tsi_ssl_root_certs_store* tsi_ssl_root_certs_store_create(
     const char* pem_roots);
 
+/* Creates a tsi_ssl_root_certs_store object that loads root certificates from
+   the NULL-terminated path certs_dir, a directory in the hashed format of
+   OpenSSL's c_rehash, as handshakes need them (looking them up by subject
+   name hash) rather than parsing them all upfront. */
+tsi_ssl_root_certs_store* tsi_ssl_root_certs_store_create_from_hashed_dir(
+    const char* certs_dir);
+
 /* Destroys the tsi_ssl_root_certs_store object. */
 void tsi_ssl_root_certs_store_destroy(tsi_ssl_root_certs_store* self);
 
@@ -66,6 +73,40 @@ void tsi_ssl_session_cache_ref(tsi_ssl_session_cache* cache);
 /* Decrement reference counter of \a cache.  */
 void tsi_ssl_session_cache_unref(tsi_ssl_session_cache* cache);
 
+/* --- tsi_ssl_session_ticket_keys object ---
+
+   Keys a server encrypts and decrypts session tickets with. Servers sharing
+   the same keys, e.g. replicas behind a load balancer, can resume each
+   other's sessions. Every key is TSI_SSL_SESSION_TICKET_KEY_SIZE bytes: a 16
+   byte name, a 16 byte HMAC-SHA256 secret and a 16 byte AES-128 key. New
+   tickets are issued with the first key; tickets issued with any of the other
+   keys are still accepted, and replaced by one issued with the first key.
+   Keys are rotated by setting a new first key followed by the previous ones.
+   This object is thread safe and ref counted, so that several handshaker
+   factories can share it. */
+
+#define TSI_SSL_SESSION_TICKET_KEY_SIZE 48
+
+typedef struct tsi_ssl_session_ticket_keys tsi_ssl_session_ticket_keys;
+
+/* Creates a key set holding no key: tickets are not issued or accepted until
+   keys are set. */
+tsi_ssl_session_ticket_keys* tsi_ssl_session_ticket_keys_create(void);
+
+/* Increases reference count on the key set. */
+void tsi_ssl_session_ticket_keys_ref(tsi_ssl_session_ticket_keys* keys);
+
+/* Decreases reference count on the key set. */
+void tsi_ssl_session_ticket_keys_unref(tsi_ssl_session_ticket_keys* keys);
+
+/* Replaces all the keys with the keys_size / TSI_SSL_SESSION_TICKET_KEY_SIZE
+   keys stored back to back at key_data, the first of which issues tickets.
+   Returns TSI_INVALID_ARGUMENT, keeping the current keys, unless keys_size is
+   a non-zero multiple of TSI_SSL_SESSION_TICKET_KEY_SIZE. */
+tsi_result tsi_ssl_session_ticket_keys_set(tsi_ssl_session_ticket_keys* keys,
+                                           const unsigned char* key_data,
+                                           size_t keys_size);
+
 /* --- tsi_ssl_client_handshaker_factory object ---
 
    This object creates a client tsi_handshaker objects implemented in terms of
@@ -175,6 +216,12 @@ tsi_result tsi_ssl_client_handshaker_factory_create_handshaker(
     tsi_ssl_client_handshaker_factory* self, const char* server_name_indication,
     tsi_handshaker** handshaker);
 
+/* Increments reference count of the handshaker factory, so that it can be
+ * shared by several users, each of which unrefs it when done. Returns
+ * factory. */
+tsi_ssl_client_handshaker_factory* tsi_ssl_client_handshaker_factory_ref(
+    tsi_ssl_client_handshaker_factory* factory);
+
 /* Decrements reference count of the handshaker factory. Handshaker factory will
  * be destroyed once no references exist. */
 void tsi_ssl_client_handshaker_factory_unref(
@@ -265,6 +312,11 @@ struct tsi_ssl_server_handshaker_options {
   const char* session_ticket_key;
   /* session_ticket_key_size is a size of session ticket encryption key. */
   size_t session_ticket_key_size;
+  /* session_ticket_keys is an optional set of keys for session tickets. It is
+     used instead of session_ticket_key when both are set, and keeps being
+     consulted on every handshake, so that keys can be rotated without
+     recreating the factory. The factory takes a reference to it. */
+  tsi_ssl_session_ticket_keys* session_ticket_keys;
 
   tsi_ssl_server_handshaker_options()
       : pem_key_cert_pairs(nullptr),
@@ -275,7 +327,8 @@ struct tsi_ssl_server_handshaker_options {
         alpn_protocols(nullptr),
         num_alpn_protocols(0),
         session_ticket_key(nullptr),
-        session_ticket_key_size(0) {}
+        session_ticket_key_size(0),
+        session_ticket_keys(nullptr) {}
 };
 
 /* Creates a server handshaker factory.
@@ -297,6 +350,12 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
 tsi_result tsi_ssl_server_handshaker_factory_create_handshaker(
     tsi_ssl_server_handshaker_factory* self, tsi_handshaker** handshaker);
 
+/* Increments reference count of the handshaker factory, so that it can be
+ * shared by several users, each of which unrefs it when done. Returns
+ * factory. */
+tsi_ssl_server_handshaker_factory* tsi_ssl_server_handshaker_factory_ref(
+    tsi_ssl_server_handshaker_factory* factory);
+
 /* Decrements reference count of the handshaker factory. Handshaker factory will
  * be destroyed once no references exist. */
 void tsi_ssl_server_handshaker_factory_unref(
@@ -309,6 +368,37 @@ void tsi_ssl_server_handshaker_factory_unref(
    - handle public suffix wildchar more strictly (e.g. *.co.uk) */
 int tsi_ssl_peer_matches_name(const tsi_peer* peer, grpc_core::StringView name);
 
+/* --- Kernel TLS offload. --- */
+
+/* Key material protecting one direction of an established TLS 1.2 AES-GCM
+   session, in the form the kernel TLS (kTLS) socket options take it. */
+typedef struct {
+  /* 16 for AES-128-GCM, 32 for AES-256-GCM. */
+  size_t key_size;
+  unsigned char key[32];
+  /* The implicit part of the nonce (client_write_IV or server_write_IV). */
+  unsigned char salt[4];
+  /* Sequence number of the next record, big endian. It is also the explicit
+     part of the nonce of that record. */
+  unsigned char rec_seq[8];
+} tsi_ssl_kernel_tls_keys;
+
+/* Exports the keys that protect the data written through an SSL frame
+   protector, so that record encryption can be moved into the kernel. Once the
+   keys are in use, no more data may be protected with self: the records it
+   would produce would reuse sequence numbers.
+   Returns TSI_UNIMPLEMENTED if self is not an SSL frame protector, if the
+   session is not TLS 1.2 with an AES-GCM cipher, or if the SSL library does
+   not expose its keys; and TSI_FAILED_PRECONDITION if self still holds
+   protected data that was not flushed. */
+tsi_result tsi_ssl_frame_protector_export_write_keys(
+    tsi_frame_protector* self, tsi_ssl_kernel_tls_keys* keys);
+
+/* Same as tsi_ssl_frame_protector_export_write_keys, for the zero-copy grpc
+   protector of an SSL handshaker result. */
+tsi_result tsi_ssl_zero_copy_grpc_protector_export_write_keys(
+    tsi_zero_copy_grpc_protector* self, tsi_ssl_kernel_tls_keys* keys);
+
 /* --- Testing support. ---
 
    These functions and typedefs are not intended to be used outside of testing.
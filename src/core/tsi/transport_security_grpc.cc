@@ -64,3 +64,35 @@ void tsi_zero_copy_grpc_protector_destroy(tsi_zero_copy_grpc_protector* self) {
   if (self == nullptr) return;
   self->vtable->destroy(self);
 }
+
+/* --- tsi_crypto_offload_engine common implementation. --- */
+
+void tsi_crypto_offload_engine_protect(tsi_crypto_offload_engine* self,
+                                       tsi_zero_copy_grpc_protector* protector,
+                                       grpc_slice_buffer* unprotected_slices,
+                                       grpc_slice_buffer* protected_slices,
+                                       tsi_crypto_offload_done_cb cb,
+                                       void* user_data) {
+  if (self == nullptr || self->vtable == nullptr ||
+      self->vtable->protect == nullptr) {
+    cb(user_data, tsi_zero_copy_grpc_protector_protect(
+                      protector, unprotected_slices, protected_slices));
+    return;
+  }
+  self->vtable->protect(self, protector, unprotected_slices, protected_slices,
+                        cb, user_data);
+}
+
+void tsi_crypto_offload_engine_unprotect(
+    tsi_crypto_offload_engine* self, tsi_zero_copy_grpc_protector* protector,
+    grpc_slice_buffer* protected_slices, grpc_slice_buffer* unprotected_slices,
+    tsi_crypto_offload_done_cb cb, void* user_data) {
+  if (self == nullptr || self->vtable == nullptr ||
+      self->vtable->unprotect == nullptr) {
+    cb(user_data, tsi_zero_copy_grpc_protector_unprotect(
+                      protector, protected_slices, unprotected_slices));
+    return;
+  }
+  self->vtable->unprotect(self, protector, protected_slices,
+                          unprotected_slices, cb, user_data);
+}
@@ -71,4 +71,57 @@ struct tsi_zero_copy_grpc_protector {
   const tsi_zero_copy_grpc_protector_vtable* vtable;
 };
 
+/* -- tsi_crypto_offload_engine object --
+
+   An engine sealing and unsealing records for zero-copy grpc protectors
+   asynchronously, e.g. by driving a crypto accelerator, in place of the
+   protecting thread. It is handed the protector, whose keys and record state
+   it works with, and must produce exactly the output the protector's own
+   protect and unprotect would. A secure endpoint has at most one protect and
+   one unprotect in flight on an engine at a time.  */
+
+/* Called by the engine when an operation completes, from any thread and
+   possibly before the operation's call returns.  */
+typedef void (*tsi_crypto_offload_done_cb)(void* user_data, tsi_result result);
+
+typedef struct tsi_crypto_offload_engine tsi_crypto_offload_engine;
+
+/* Starts protecting unprotected_slices with protector into protected_slices,
+   as tsi_zero_copy_grpc_protector_protect does, calling cb with user_data
+   when done. The slice buffers and the protector stay alive until then.  */
+void tsi_crypto_offload_engine_protect(tsi_crypto_offload_engine* self,
+                                       tsi_zero_copy_grpc_protector* protector,
+                                       grpc_slice_buffer* unprotected_slices,
+                                       grpc_slice_buffer* protected_slices,
+                                       tsi_crypto_offload_done_cb cb,
+                                       void* user_data);
+
+/* Starts unprotecting protected_slices with protector into
+   unprotected_slices, as tsi_zero_copy_grpc_protector_unprotect does,
+   calling cb with user_data when done.  */
+void tsi_crypto_offload_engine_unprotect(
+    tsi_crypto_offload_engine* self, tsi_zero_copy_grpc_protector* protector,
+    grpc_slice_buffer* protected_slices, grpc_slice_buffer* unprotected_slices,
+    tsi_crypto_offload_done_cb cb, void* user_data);
+
+/* Base for tsi_crypto_offload_engine implementations. Engines are owned by
+   the application, which keeps them alive as long as any endpoint uses
+   them. An operation left NULL runs inline on the protector.  */
+typedef struct {
+  void (*protect)(tsi_crypto_offload_engine* self,
+                  tsi_zero_copy_grpc_protector* protector,
+                  grpc_slice_buffer* unprotected_slices,
+                  grpc_slice_buffer* protected_slices,
+                  tsi_crypto_offload_done_cb cb, void* user_data);
+  void (*unprotect)(tsi_crypto_offload_engine* self,
+                    tsi_zero_copy_grpc_protector* protector,
+                    grpc_slice_buffer* protected_slices,
+                    grpc_slice_buffer* unprotected_slices,
+                    tsi_crypto_offload_done_cb cb, void* user_data);
+} tsi_crypto_offload_engine_vtable;
+
+struct tsi_crypto_offload_engine {
+  const tsi_crypto_offload_engine_vtable* vtable;
+};
+
 #endif /* GRPC_CORE_TSI_TRANSPORT_SECURITY_GRPC_H */
@@ -17,11 +17,14 @@
  */
 
 #include <functional>
+#include <vector>
 
 #include <grpcpp/generic/generic_stub.h>
 #include <grpcpp/impl/rpc_method.h>
 #include <grpcpp/support/client_callback.h>
 
+#include "src/core/lib/surface/call.h"
+
 namespace grpc_impl {
 
 namespace {
@@ -91,4 +94,23 @@ void GenericStub::experimental_type::PrepareBidiStreamingCall(
                                 context, reactor);
 }
 
+void GenericStub::experimental_type::StartUnaryCalls(
+    size_t count, grpc::ClientContext* const* contexts,
+    const grpc::string& method, const grpc::ByteBuffer* requests,
+    grpc::ByteBuffer* responses, grpc::Status* statuses, CompletionQueue* cq,
+    void* const* tags) {
+  std::vector<std::unique_ptr<grpc::GenericClientAsyncResponseReader>> calls;
+  calls.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    calls.push_back(
+        stub_->PrepareUnaryCall(contexts[i], method, requests[i], cq));
+    calls.back()->StartCall();
+  }
+  // A unary call's send ops go out with its receive ops, in Finish.
+  grpc_core::CallBatchScope scope;
+  for (size_t i = 0; i < count; i++) {
+    calls[i]->Finish(&responses[i], &statuses[i], tags[i]);
+  }
+}
+
 }  // namespace grpc_impl
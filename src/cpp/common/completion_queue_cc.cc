@@ -18,9 +18,12 @@
 #include <grpcpp/completion_queue.h>
 
 #include <memory>
+#include <unordered_set>
 
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpcpp/impl/codegen/sync.h>
 #include <grpcpp/impl/grpc_library.h>
 #include <grpcpp/support/time.h>
 
@@ -90,4 +93,93 @@ bool CompletionQueue::CompletionQueueTLSCache::Flush(void** tag, bool* ok) {
   return false;
 }
 
+namespace {
+// The calling thread's queue for blocking calls, and whether a blocking call
+// on the thread is using it. The queue does not keep gRPC initialized: queues
+// still cached when gRPC shuts down are destroyed then, and the thread makes
+// a new one on its next blocking call.
+struct CachedBlockingCallQueue {
+  ~CachedBlockingCallQueue();
+
+  // Only cleared by DestroyCachedBlockingCallQueues(), which cannot run while
+  // the thread is in a blocking call, since the call's channel keeps gRPC
+  // initialized.
+  CompletionQueue* cq = nullptr;
+  // Whether this thread has added itself to g_cached_queues.
+  bool registered = false;
+  bool in_use = false;
+};
+
+thread_local CachedBlockingCallQueue g_blocking_call_queue;
+
+gpr_once g_cached_queues_once = GPR_ONCE_INIT;
+::grpc::internal::Mutex* g_cached_queues_mu;
+std::unordered_set<CachedBlockingCallQueue*>* g_cached_queues;
+
+void InitCachedQueues() {
+  g_cached_queues_mu = new ::grpc::internal::Mutex();
+  g_cached_queues = new std::unordered_set<CachedBlockingCallQueue*>();
+}
+
+CachedBlockingCallQueue::~CachedBlockingCallQueue() {
+  if (!registered) return;
+  ::grpc::internal::MutexLock lock(g_cached_queues_mu);
+  g_cached_queues->erase(this);
+  delete cq;
+}
+
+// Runs in grpc_shutdown(), once nothing can be using the queues.
+void DestroyCachedBlockingCallQueues() {
+  gpr_once_init(&g_cached_queues_once, InitCachedQueues);
+  ::grpc::internal::MutexLock lock(g_cached_queues_mu);
+  for (CachedBlockingCallQueue* cached : *g_cached_queues) {
+    delete cached->cq;
+    cached->cq = nullptr;
+  }
+}
+
+struct CachedQueuesPluginRegisterer {
+  CachedQueuesPluginRegisterer() {
+    grpc_register_plugin(nullptr, DestroyCachedBlockingCallQueues);
+  }
+} g_cached_queues_plugin_registerer;
+}  // namespace
+
+CompletionQueue::BlockingCallQueue::BlockingCallQueue() {
+  CachedBlockingCallQueue& cached = g_blocking_call_queue;
+  if (cached.in_use) {
+    cq_ = NewPluckQueue();
+    owned_ = true;
+    return;
+  }
+  if (cached.cq == nullptr) {
+    // Built on the core queue directly, so that it holds no grpc_init() ref.
+    cached.cq =
+        new CompletionQueue(grpc_completion_queue_create_for_pluck(nullptr));
+    if (!cached.registered) {
+      gpr_once_init(&g_cached_queues_once, InitCachedQueues);
+      ::grpc::internal::MutexLock lock(g_cached_queues_mu);
+      g_cached_queues->insert(&cached);
+      cached.registered = true;
+    }
+  }
+  cached.in_use = true;
+  cq_ = cached.cq;
+  owned_ = false;
+}
+
+CompletionQueue::BlockingCallQueue::~BlockingCallQueue() {
+  if (owned_) {
+    delete cq_;
+  } else {
+    g_blocking_call_queue.in_use = false;
+  }
+}
+
+CompletionQueue* CompletionQueue::BlockingCallQueue::NewPluckQueue() {
+  return new CompletionQueue(grpc_completion_queue_attributes{
+      GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
+      nullptr});
+}
+
 }  // namespace grpc_impl
@@ -0,0 +1,57 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <grpc/grpc.h>
+#include <grpcpp/support/core_stats.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/memory.h"
+
+namespace grpc {
+namespace experimental {
+CoreStats GetCoreStats() {
+  grpc_init();
+  // grpc_stats_data is too large for the stack.
+  grpc_core::UniquePtr<grpc_stats_data> data(
+      static_cast<grpc_stats_data*>(gpr_malloc(sizeof(grpc_stats_data))));
+  grpc_stats_collect(data.get());
+  grpc_shutdown();
+  CoreStats stats;
+  stats.counters.reserve(GRPC_STATS_COUNTER_COUNT);
+  for (int i = 0; i < GRPC_STATS_COUNTER_COUNT; i++) {
+    stats.counters.emplace_back(grpc_stats_counter_name[i],
+                                static_cast<uint64_t>(data->counters[i]));
+  }
+  stats.histograms.resize(GRPC_STATS_HISTOGRAM_COUNT);
+  for (int i = 0; i < GRPC_STATS_HISTOGRAM_COUNT; i++) {
+    CoreStatsHistogram* histogram = &stats.histograms[i];
+    histogram->name = grpc_stats_histogram_name[i];
+    histogram->bucket_boundaries.assign(
+        grpc_stats_histo_bucket_boundaries[i],
+        grpc_stats_histo_bucket_boundaries[i] + grpc_stats_histo_buckets[i]);
+    histogram->counts.reserve(grpc_stats_histo_buckets[i]);
+    for (int j = 0; j < grpc_stats_histo_buckets[i]; j++) {
+      histogram->counts.push_back(static_cast<uint64_t>(
+          data->histograms[grpc_stats_histo_start[i] + j]));
+    }
+  }
+  return stats;
+}
+}  // namespace experimental
+}  // namespace grpc
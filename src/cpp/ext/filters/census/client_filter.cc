@@ -26,6 +26,7 @@
 #include "src/core/lib/surface/call.h"
 #include "src/cpp/ext/filters/census/grpc_plugin.h"
 #include "src/cpp/ext/filters/census/measures.h"
+#include "src/cpp/ext/filters/census/stats_sampling.h"
 
 namespace grpc {
 
@@ -85,16 +86,24 @@ void CensusClientCallData::StartTransportStreamOpBatch(
     GenerateClientContext(
         qualified_method_, &context_,
         (ctxt == nullptr) ? nullptr : reinterpret_cast<CensusContext*>(ctxt));
-    size_t tracing_len = TraceContextSerialize(context_.Context(), tracing_buf_,
-                                               kMaxTraceContextLen);
+    // Serialize straight into the value's slice, and keep the element itself
+    // in the call data, so that only the slice is allocated.
+    tracing_slice_ = GRPC_SLICE_MALLOC(kMaxTraceContextLen);
+    size_t tracing_len = TraceContextSerialize(
+        context_.Context(),
+        reinterpret_cast<char*>(GRPC_SLICE_START_PTR(tracing_slice_)),
+        kMaxTraceContextLen);
     if (tracing_len > 0) {
+      GRPC_SLICE_SET_LENGTH(tracing_slice_, tracing_len);
+      tracing_md_.key = GRPC_MDSTR_GRPC_TRACE_BIN;
+      tracing_md_.value = tracing_slice_;
       GRPC_LOG_IF_ERROR(
           "census grpc_filter",
           grpc_metadata_batch_add_tail(
               op->send_initial_metadata()->batch(), &tracing_bin_,
-              grpc_mdelem_from_slices(
-                  GRPC_MDSTR_GRPC_TRACE_BIN,
-                  grpc_core::UnmanagedMemorySlice(tracing_buf_, tracing_len)),
+              grpc_mdelem_create(
+                  GRPC_MDSTR_GRPC_TRACE_BIN, tracing_slice_,
+                  reinterpret_cast<grpc_mdelem_data*>(&tracing_md_)),
               GRPC_BATCH_GRPC_TRACE_BIN));
     }
     grpc_slice tags = grpc_empty_slice();
@@ -133,7 +142,8 @@ void CensusClientCallData::StartTransportStreamOpBatch(
 grpc_error* CensusClientCallData::Init(grpc_call_element* elem,
                                        const grpc_call_element_args* args) {
   path_ = grpc_slice_ref_internal(args->path);
-  start_time_ = absl::Now();
+  sampled_ = SampleRpcStats();
+  if (sampled_) start_time_ = absl::Now();
   method_ = GetMethod(&path_);
   qualified_method_ = absl::StrCat("Sent.", method_);
   GRPC_CLOSURE_INIT(&on_done_recv_message_, OnDoneRecvMessageCb, elem,
@@ -147,6 +157,14 @@ grpc_error* CensusClientCallData::Init(grpc_call_element* elem,
 void CensusClientCallData::Destroy(grpc_call_element* elem,
                                    const grpc_call_final_info* final_info,
                                    grpc_closure* then_call_closure) {
+  if (!sampled_) {
+    CountUnsampledClientRpc(method_, final_info->final_status);
+    grpc_slice_unref_internal(path_);
+    grpc_slice_unref_internal(tracing_slice_);
+    context_.EndSpan();
+    return;
+  }
+  FlushUnsampledRpcs();
   const uint64_t request_size = GetOutgoingDataSize(final_info);
   const uint64_t response_size = GetIncomingDataSize(final_info);
   double latency_ms = absl::ToDoubleMilliseconds(absl::Now() - start_time_);
@@ -161,6 +179,7 @@ void CensusClientCallData::Destroy(grpc_call_element* elem,
       {{ClientMethodTagKey(), method_},
        {ClientStatusTagKey(), StatusCodeToString(final_info->final_status)}});
   grpc_slice_unref_internal(path_);
+  grpc_slice_unref_internal(tracing_slice_);
   context_.EndSpan();
 }
 
@@ -43,6 +43,7 @@ class CensusClientCallData : public CallData {
       : recv_trailing_metadata_(nullptr),
         initial_on_done_recv_trailing_metadata_(nullptr),
         initial_on_done_recv_message_(nullptr),
+        sampled_(true),
         elapsed_time_(0),
         recv_message_(nullptr),
         recv_message_count_(0),
@@ -50,6 +51,7 @@ class CensusClientCallData : public CallData {
     memset(&stats_bin_, 0, sizeof(grpc_linked_mdelem));
     memset(&tracing_bin_, 0, sizeof(grpc_linked_mdelem));
     memset(&path_, 0, sizeof(grpc_slice));
+    tracing_slice_ = grpc_empty_slice();
     memset(&on_done_recv_trailing_metadata_, 0, sizeof(grpc_closure));
     memset(&on_done_recv_message_, 0, sizeof(grpc_closure));
   }
@@ -85,7 +87,9 @@ class CensusClientCallData : public CallData {
   // recv message
   grpc_closure* initial_on_done_recv_message_;
   grpc_closure on_done_recv_message_;
-  // Start time (for measuring latency).
+  // Whether this RPC records its measures (see SampleRpcStats()).
+  bool sampled_;
+  // Start time (for measuring latency), if sampled.
   absl::Time start_time_;
   // Server elapsed time in nanoseconds.
   uint64_t elapsed_time_;
@@ -94,9 +98,10 @@ class CensusClientCallData : public CallData {
   // Number of messages in this RPC.
   uint64_t recv_message_count_;
   uint64_t sent_message_count_;
-  // Buffer needed for grpc_slice to reference when adding trace context
-  // metatdata to outgoing message.
-  char tracing_buf_[kMaxTraceContextLen];
+  // The trace context sent in metadata, and the backing store for its
+  // element (see grpc_mdelem_create()).
+  grpc_slice tracing_slice_;
+  grpc_metadata tracing_md_;
 };
 
 }  // namespace grpc
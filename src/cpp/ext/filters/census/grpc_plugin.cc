@@ -79,6 +79,9 @@ ABSL_CONST_INIT const absl::string_view kRpcClientRoundtripLatencyMeasureName =
 ABSL_CONST_INIT const absl::string_view kRpcClientServerLatencyMeasureName =
     "grpc.io/client/server_latency";
 
+ABSL_CONST_INIT const absl::string_view kRpcClientUnsampledRpcsMeasureName =
+    "grpc.io/client/unsampled_rpcs";
+
 // Server
 ABSL_CONST_INIT const absl::string_view
     kRpcServerSentMessagesPerRpcMeasureName =
@@ -97,6 +100,9 @@ ABSL_CONST_INIT const absl::string_view
 
 ABSL_CONST_INIT const absl::string_view kRpcServerServerLatencyMeasureName =
     "grpc.io/server/server_latency";
+
+ABSL_CONST_INIT const absl::string_view kRpcServerUnsampledRpcsMeasureName =
+    "grpc.io/server/unsampled_rpcs";
 }  // namespace grpc
 namespace grpc_impl {
 
@@ -118,12 +124,14 @@ void RegisterOpenCensusPlugin() {
   grpc::RpcClientServerLatency();
   grpc::RpcClientSentMessagesPerRpc();
   grpc::RpcClientReceivedMessagesPerRpc();
+  grpc::RpcClientUnsampledRpcs();
 
   grpc::RpcServerSentBytesPerRpc();
   grpc::RpcServerReceivedBytesPerRpc();
   grpc::RpcServerServerLatency();
   grpc::RpcServerSentMessagesPerRpc();
   grpc::RpcServerReceivedMessagesPerRpc();
+  grpc::RpcServerUnsampledRpcs();
 }
 
 ::opencensus::trace::Span GetSpanFromServerContext(
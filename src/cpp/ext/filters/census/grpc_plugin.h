@@ -45,12 +45,14 @@ extern const absl::string_view kRpcClientReceivedMessagesPerRpcMeasureName;
 extern const absl::string_view kRpcClientReceivedBytesPerRpcMeasureName;
 extern const absl::string_view kRpcClientRoundtripLatencyMeasureName;
 extern const absl::string_view kRpcClientServerLatencyMeasureName;
+extern const absl::string_view kRpcClientUnsampledRpcsMeasureName;
 
 extern const absl::string_view kRpcServerSentMessagesPerRpcMeasureName;
 extern const absl::string_view kRpcServerSentBytesPerRpcMeasureName;
 extern const absl::string_view kRpcServerReceivedMessagesPerRpcMeasureName;
 extern const absl::string_view kRpcServerReceivedBytesPerRpcMeasureName;
 extern const absl::string_view kRpcServerServerLatencyMeasureName;
+extern const absl::string_view kRpcServerUnsampledRpcsMeasureName;
 
 // Canonical gRPC view definitions.
 const ::opencensus::stats::ViewDescriptor& ClientSentMessagesPerRpcCumulative();
@@ -62,6 +64,7 @@ ClientReceivedBytesPerRpcCumulative();
 const ::opencensus::stats::ViewDescriptor& ClientRoundtripLatencyCumulative();
 const ::opencensus::stats::ViewDescriptor& ClientServerLatencyCumulative();
 const ::opencensus::stats::ViewDescriptor& ClientCompletedRpcsCumulative();
+const ::opencensus::stats::ViewDescriptor& ClientUnsampledRpcsCumulative();
 
 const ::opencensus::stats::ViewDescriptor& ServerSentBytesPerRpcCumulative();
 const ::opencensus::stats::ViewDescriptor&
@@ -69,6 +72,7 @@ ServerReceivedBytesPerRpcCumulative();
 const ::opencensus::stats::ViewDescriptor& ServerServerLatencyCumulative();
 const ::opencensus::stats::ViewDescriptor& ServerStartedCountCumulative();
 const ::opencensus::stats::ViewDescriptor& ServerCompletedRpcsCumulative();
+const ::opencensus::stats::ViewDescriptor& ServerUnsampledRpcsCumulative();
 const ::opencensus::stats::ViewDescriptor& ServerSentMessagesPerRpcCumulative();
 const ::opencensus::stats::ViewDescriptor&
 ServerReceivedMessagesPerRpcCumulative();
@@ -88,6 +88,13 @@ MeasureInt64 RpcClientReceivedMessagesPerRpc() {
   return measure;
 }
 
+MeasureInt64 RpcClientUnsampledRpcs() {
+  static const auto measure = MeasureInt64::Register(
+      kRpcClientUnsampledRpcsMeasureName,
+      "Number of RPCs whose other measures were not recorded", kCount);
+  return measure;
+}
+
 // Server
 MeasureDouble RpcServerSentBytesPerRpc() {
   static const auto measure = MeasureDouble::Register(
@@ -126,4 +133,11 @@ MeasureInt64 RpcServerReceivedMessagesPerRpc() {
   return measure;
 }
 
+MeasureInt64 RpcServerUnsampledRpcs() {
+  static const auto measure = MeasureInt64::Register(
+      kRpcServerUnsampledRpcsMeasureName,
+      "Number of RPCs whose other measures were not recorded", kCount);
+  return measure;
+}
+
 }  // namespace grpc
@@ -33,6 +33,7 @@ namespace grpc {
 ::opencensus::stats::MeasureDouble RpcClientRoundtripLatency();
 ::opencensus::stats::MeasureDouble RpcClientServerLatency();
 ::opencensus::stats::MeasureInt64 RpcClientCompletedRpcs();
+::opencensus::stats::MeasureInt64 RpcClientUnsampledRpcs();
 
 ::opencensus::stats::MeasureInt64 RpcServerSentMessagesPerRpc();
 ::opencensus::stats::MeasureDouble RpcServerSentBytesPerRpc();
@@ -40,6 +41,7 @@ namespace grpc {
 ::opencensus::stats::MeasureDouble RpcServerReceivedBytesPerRpc();
 ::opencensus::stats::MeasureDouble RpcServerServerLatency();
 ::opencensus::stats::MeasureInt64 RpcServerCompletedRpcs();
+::opencensus::stats::MeasureInt64 RpcServerUnsampledRpcs();
 
 }  // namespace grpc
 
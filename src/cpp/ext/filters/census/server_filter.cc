@@ -28,6 +28,7 @@
 #include "src/core/lib/surface/call.h"
 #include "src/cpp/ext/filters/census/grpc_plugin.h"
 #include "src/cpp/ext/filters/census/measures.h"
+#include "src/cpp/ext/filters/census/stats_sampling.h"
 
 namespace grpc {
 
@@ -35,28 +36,16 @@ constexpr uint32_t CensusServerCallData::kMaxServerStatsLen;
 
 namespace {
 
-// server metadata elements
-struct ServerMetadataElements {
-  grpc_slice path;
-  grpc_slice tracing_slice;
-  grpc_slice census_proto;
-};
-
-void FilterInitialMetadata(grpc_metadata_batch* b,
-                           ServerMetadataElements* sml) {
-  if (b->idx.named.path != nullptr) {
-    sml->path = grpc_slice_ref_internal(GRPC_MDVALUE(b->idx.named.path->md));
-  }
-  if (b->idx.named.grpc_trace_bin != nullptr) {
-    sml->tracing_slice =
-        grpc_slice_ref_internal(GRPC_MDVALUE(b->idx.named.grpc_trace_bin->md));
-    grpc_metadata_batch_remove(b, GRPC_BATCH_GRPC_TRACE_BIN);
-  }
-  if (b->idx.named.grpc_tags_bin != nullptr) {
-    sml->census_proto =
-        grpc_slice_ref_internal(GRPC_MDVALUE(b->idx.named.grpc_tags_bin->md));
-    grpc_metadata_batch_remove(b, GRPC_BATCH_GRPC_TAGS_BIN);
-  }
+// Returns the value of the element of b at idx, if any, as a string_view into
+// the element's own slice.
+absl::string_view MetadataValue(grpc_metadata_batch* b,
+                                grpc_metadata_batch_callouts_index idx) {
+  grpc_linked_mdelem* storage = b->idx.array[idx];
+  if (storage == nullptr) return absl::string_view();
+  const grpc_slice& value = GRPC_MDVALUE(storage->md);
+  return absl::string_view(
+      reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(value)),
+      GRPC_SLICE_LENGTH(value));
 }
 
 }  // namespace
@@ -86,38 +75,24 @@ void CensusServerCallData::OnDoneRecvInitialMetadataCb(void* user_data,
   if (error == GRPC_ERROR_NONE) {
     grpc_metadata_batch* initial_metadata = calld->recv_initial_metadata_;
     GPR_ASSERT(initial_metadata != nullptr);
-    ServerMetadataElements sml;
-    sml.path = grpc_empty_slice();
-    sml.tracing_slice = grpc_empty_slice();
-    sml.census_proto = grpc_empty_slice();
-    FilterInitialMetadata(initial_metadata, &sml);
-    calld->path_ = grpc_slice_ref_internal(sml.path);
+    if (initial_metadata->idx.named.path != nullptr) {
+      calld->path_ = grpc_slice_ref_internal(
+          GRPC_MDVALUE(initial_metadata->idx.named.path->md));
+    }
     calld->method_ = GetMethod(&calld->path_);
     calld->qualified_method_ = absl::StrCat("Recv.", calld->method_);
-    const char* tracing_str =
-        GRPC_SLICE_IS_EMPTY(sml.tracing_slice)
-            ? ""
-            : reinterpret_cast<const char*>(
-                  GRPC_SLICE_START_PTR(sml.tracing_slice));
-    size_t tracing_str_len = GRPC_SLICE_IS_EMPTY(sml.tracing_slice)
-                                 ? 0
-                                 : GRPC_SLICE_LENGTH(sml.tracing_slice);
-    const char* census_str = GRPC_SLICE_IS_EMPTY(sml.census_proto)
-                                 ? ""
-                                 : reinterpret_cast<const char*>(
-                                       GRPC_SLICE_START_PTR(sml.census_proto));
-    size_t census_str_len = GRPC_SLICE_IS_EMPTY(sml.census_proto)
-                                ? 0
-                                : GRPC_SLICE_LENGTH(sml.census_proto);
-
-    GenerateServerContext(absl::string_view(tracing_str, tracing_str_len),
-                          absl::string_view(census_str, census_str_len),
-                          /*primary_role*/ "", calld->qualified_method_,
-                          &calld->context_);
-
-    grpc_slice_unref_internal(sml.tracing_slice);
-    grpc_slice_unref_internal(sml.census_proto);
-    grpc_slice_unref_internal(sml.path);
+    // Decode the contexts from the received slices themselves, before their
+    // elements are removed.
+    GenerateServerContext(
+        MetadataValue(initial_metadata, GRPC_BATCH_GRPC_TRACE_BIN),
+        MetadataValue(initial_metadata, GRPC_BATCH_GRPC_TAGS_BIN),
+        /*primary_role*/ "", calld->qualified_method_, &calld->context_);
+    if (initial_metadata->idx.named.grpc_trace_bin != nullptr) {
+      grpc_metadata_batch_remove(initial_metadata, GRPC_BATCH_GRPC_TRACE_BIN);
+    }
+    if (initial_metadata->idx.named.grpc_tags_bin != nullptr) {
+      grpc_metadata_batch_remove(initial_metadata, GRPC_BATCH_GRPC_TAGS_BIN);
+    }
     grpc_census_call_set_context(
         calld->gc_, reinterpret_cast<census_context*>(&calld->context_));
   }
@@ -146,16 +121,24 @@ void CensusServerCallData::StartTransportStreamOpBatch(
   // completeness of the request.
   if (op->send_trailing_metadata() != nullptr) {
     elapsed_time_ = absl::Now() - start_time_;
-    size_t len = ServerStatsSerialize(absl::ToInt64Nanoseconds(elapsed_time_),
-                                      stats_buf_, kMaxServerStatsLen);
+    // The stats are small enough for their slice to be inlined, and the
+    // element is kept in the call data, so nothing is allocated.
+    grpc_slice stats = GRPC_SLICE_MALLOC(kMaxServerStatsLen);
+    size_t len = ServerStatsSerialize(
+        absl::ToInt64Nanoseconds(elapsed_time_),
+        reinterpret_cast<char*>(GRPC_SLICE_START_PTR(stats)),
+        kMaxServerStatsLen);
     if (len > 0) {
+      GRPC_SLICE_SET_LENGTH(stats, len);
+      census_md_.key = GRPC_MDSTR_GRPC_SERVER_STATS_BIN;
+      census_md_.value = stats;
       GRPC_LOG_IF_ERROR(
           "census grpc_filter",
           grpc_metadata_batch_add_tail(
               op->send_trailing_metadata()->batch(), &census_bin_,
-              grpc_mdelem_from_slices(
-                  GRPC_MDSTR_GRPC_SERVER_STATS_BIN,
-                  grpc_core::UnmanagedMemorySlice(stats_buf_, len)),
+              grpc_mdelem_create(
+                  GRPC_MDSTR_GRPC_SERVER_STATS_BIN, stats,
+                  reinterpret_cast<grpc_mdelem_data*>(&census_md_)),
               GRPC_BATCH_GRPC_SERVER_STATS_BIN));
     }
   }
@@ -180,10 +163,17 @@ grpc_error* CensusServerCallData::Init(grpc_call_element* elem,
 void CensusServerCallData::Destroy(grpc_call_element* elem,
                                    const grpc_call_final_info* final_info,
                                    grpc_closure* then_call_closure) {
+  grpc_auth_context_release(auth_context_);
+  if (!SampleRpcStats()) {
+    CountUnsampledServerRpc(method_, final_info->final_status);
+    grpc_slice_unref_internal(path_);
+    context_.EndSpan();
+    return;
+  }
+  FlushUnsampledRpcs();
   const uint64_t request_size = GetOutgoingDataSize(final_info);
   const uint64_t response_size = GetIncomingDataSize(final_info);
   double elapsed_time_ms = absl::ToDoubleMilliseconds(elapsed_time_);
-  grpc_auth_context_release(auth_context_);
   ::opencensus::stats::Record(
       {{RpcServerSentBytesPerRpc(), static_cast<double>(response_size)},
        {RpcServerReceivedBytesPerRpc(), static_cast<double>(request_size)},
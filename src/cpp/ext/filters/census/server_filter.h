@@ -38,6 +38,8 @@ class CensusServerCallData : public CallData {
  public:
   // Maximum size of server stats that are sent on the wire.
   static constexpr uint32_t kMaxServerStatsLen = 16;
+  static_assert(kMaxServerStatsLen <= GRPC_SLICE_INLINED_SIZE,
+                "server stats must fit in an inlined slice");
 
   CensusServerCallData()
       : gc_(nullptr),
@@ -91,9 +93,9 @@ class CensusServerCallData : public CallData {
   grpc_core::OrphanablePtr<grpc_core::ByteStream>* recv_message_;
   uint64_t recv_message_count_;
   uint64_t sent_message_count_;
-  // Buffer needed for grpc_slice to reference it when adding metatdata to
-  // response.
-  char stats_buf_[kMaxServerStatsLen];
+  // The backing store for the element holding the server stats (see
+  // grpc_mdelem_create()), whose value is inlined in its slice.
+  grpc_metadata census_md_;
 };
 
 }  // namespace grpc
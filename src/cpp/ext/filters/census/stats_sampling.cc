@@ -0,0 +1,135 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/cpp/ext/filters/census/stats_sampling.h"
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "opencensus/stats/stats.h"
+#include "src/cpp/ext/filters/census/context.h"
+#include "src/cpp/ext/filters/census/grpc_plugin.h"
+#include "src/cpp/ext/filters/census/measures.h"
+
+namespace grpc {
+
+namespace {
+
+// A thread records its counts once it has this many.
+constexpr int64_t kMaxUnsampledRpcs = 1024;
+
+std::atomic<uint32_t> g_sampling_rate{1};
+
+// The unsampled RPCs counted by one thread, by method and status.
+class UnsampledRpcCounts {
+ public:
+  ~UnsampledRpcCounts() { Flush(); }
+
+  bool Sample(uint32_t rate) { return ++rpcs_ % rate == 0; }
+
+  void Count(bool client, absl::string_view method, grpc_status_code status) {
+    Counter& counter = client ? client_ : server_;
+    // Threads mostly see the same method over and over, so look the method
+    // up only when it changes.
+    if (counter.last == nullptr || counter.last->first.first != method ||
+        counter.last->first.second != status) {
+      counter.last = &*counter.counts
+                           .emplace(std::make_pair(std::string(method), status),
+                                    0)
+                           .first;
+    }
+    ++counter.last->second;
+    if (++pending_ >= kMaxUnsampledRpcs) Flush();
+  }
+
+  void Flush() {
+    if (pending_ == 0) return;
+    pending_ = 0;
+    Flush(&client_, RpcClientUnsampledRpcs(), ClientMethodTagKey(),
+          ClientStatusTagKey());
+    Flush(&server_, RpcServerUnsampledRpcs(), ServerMethodTagKey(),
+          ServerStatusTagKey());
+  }
+
+ private:
+  typedef std::map<std::pair<std::string, grpc_status_code>, int64_t>
+      CountMap;
+
+  struct Counter {
+    CountMap counts;
+    CountMap::value_type* last = nullptr;
+  };
+
+  static void Flush(Counter* counter,
+                    ::opencensus::stats::MeasureInt64 measure,
+                    ::opencensus::stats::TagKey method_key,
+                    ::opencensus::stats::TagKey status_key) {
+    for (const auto& count : counter->counts) {
+      if (count.second == 0) continue;
+      ::opencensus::stats::Record(
+          {{measure, count.second}},
+          {{method_key, count.first.first},
+           {status_key, StatusCodeToString(count.first.second)}});
+    }
+    // Keep the methods seen, as the thread is likely to see them again.
+    for (auto& count : counter->counts) count.second = 0;
+  }
+
+  uint32_t rpcs_ = 0;
+  int64_t pending_ = 0;
+  Counter client_;
+  Counter server_;
+};
+
+UnsampledRpcCounts& ThreadCounts() {
+  static thread_local UnsampledRpcCounts counts;
+  return counts;
+}
+
+}  // namespace
+
+bool SampleRpcStats() {
+  const uint32_t rate = g_sampling_rate.load(std::memory_order_relaxed);
+  return rate <= 1 || ThreadCounts().Sample(rate);
+}
+
+void CountUnsampledClientRpc(absl::string_view method,
+                             grpc_status_code status) {
+  ThreadCounts().Count(true, method, status);
+}
+
+void CountUnsampledServerRpc(absl::string_view method,
+                             grpc_status_code status) {
+  ThreadCounts().Count(false, method, status);
+}
+
+void FlushUnsampledRpcs() { ThreadCounts().Flush(); }
+
+}  // namespace grpc
+
+namespace grpc_impl {
+
+void SetOpenCensusStatsSamplingRate(uint32_t one_in_n) {
+  grpc::g_sampling_rate.store(one_in_n, std::memory_order_relaxed);
+}
+
+}  // namespace grpc_impl
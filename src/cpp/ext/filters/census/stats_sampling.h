@@ -0,0 +1,48 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_INTERNAL_CPP_EXT_FILTERS_CENSUS_STATS_SAMPLING_H
+#define GRPC_INTERNAL_CPP_EXT_FILTERS_CENSUS_STATS_SAMPLING_H
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/impl/codegen/status.h>
+
+#include "absl/strings/string_view.h"
+
+namespace grpc {
+
+// Returns whether the RPC now starting should record its full set of
+// measures; one in the rate set by SetOpenCensusStatsSamplingRate() does.
+bool SampleRpcStats();
+
+// Counts a client (or server) RPC that was not sampled, in the
+// grpc.io/client/unsampled_rpcs (or server) measure. The counts are kept per
+// thread, by method and status, and recorded in one go once the thread has
+// counted a batch of them or next records a sampled RPC, and when it exits.
+void CountUnsampledClientRpc(absl::string_view method,
+                             grpc_status_code status);
+void CountUnsampledServerRpc(absl::string_view method,
+                             grpc_status_code status);
+
+// Records the counts kept by this thread so far.
+void FlushUnsampledRpcs();
+
+}  // namespace grpc
+
+#endif /* GRPC_INTERNAL_CPP_EXT_FILTERS_CENSUS_STATS_SAMPLING_H */
@@ -34,12 +34,14 @@ void RegisterOpenCensusViewsForExport() {
   grpc::ClientReceivedBytesPerRpcCumulative().RegisterForExport();
   grpc::ClientRoundtripLatencyCumulative().RegisterForExport();
   grpc::ClientServerLatencyCumulative().RegisterForExport();
+  grpc::ClientUnsampledRpcsCumulative().RegisterForExport();
 
   grpc::ServerSentMessagesPerRpcCumulative().RegisterForExport();
   grpc::ServerSentBytesPerRpcCumulative().RegisterForExport();
   grpc::ServerReceivedMessagesPerRpcCumulative().RegisterForExport();
   grpc::ServerReceivedBytesPerRpcCumulative().RegisterForExport();
   grpc::ServerServerLatencyCumulative().RegisterForExport();
+  grpc::ServerUnsampledRpcsCumulative().RegisterForExport();
 }
 }  // namespace grpc_impl
 namespace grpc {
@@ -140,6 +142,17 @@ const ViewDescriptor& ClientCompletedRpcsCumulative() {
   return descriptor;
 }
 
+const ViewDescriptor& ClientUnsampledRpcsCumulative() {
+  const static ViewDescriptor descriptor =
+      ViewDescriptor()
+          .set_name("grpc.io/client/unsampled_rpcs/cumulative")
+          .set_measure(kRpcClientUnsampledRpcsMeasureName)
+          .set_aggregation(Aggregation::Sum())
+          .add_column(ClientMethodTagKey())
+          .add_column(ClientStatusTagKey());
+  return descriptor;
+}
+
 const ViewDescriptor& ClientSentMessagesPerRpcCumulative() {
   const static ViewDescriptor descriptor =
       ViewDescriptor()
@@ -202,6 +215,17 @@ const ViewDescriptor& ServerCompletedRpcsCumulative() {
   return descriptor;
 }
 
+const ViewDescriptor& ServerUnsampledRpcsCumulative() {
+  const static ViewDescriptor descriptor =
+      ViewDescriptor()
+          .set_name("grpc.io/server/unsampled_rpcs/cumulative")
+          .set_measure(kRpcServerUnsampledRpcsMeasureName)
+          .set_aggregation(Aggregation::Sum())
+          .add_column(ServerMethodTagKey())
+          .add_column(ServerStatusTagKey());
+  return descriptor;
+}
+
 const ViewDescriptor& ServerSentMessagesPerRpcCumulative() {
   const static ViewDescriptor descriptor =
       ViewDescriptor()
@@ -42,6 +42,16 @@ ProtoServerReflection::ProtoServerReflection()
 void ProtoServerReflection::SetServiceList(
     const std::vector<grpc::string>* services) {
   services_ = services;
+  if (services_ == nullptr || descriptor_pool_ == nullptr) {
+    return;
+  }
+  for (const auto& service : *services_) {
+    const protobuf::ServiceDescriptor* service_desc =
+        descriptor_pool_->FindServiceByName(service);
+    if (service_desc != nullptr) {
+      GetFileDescriptorResponse(service_desc->file());
+    }
+  }
 }
 
 Status ProtoServerReflection::ServerReflectionInfo(
@@ -121,8 +131,7 @@ Status ProtoServerReflection::GetFileByName(
   if (file_desc == nullptr) {
     return Status(StatusCode::NOT_FOUND, "File not found.");
   }
-  std::unordered_set<grpc::string> seen_files;
-  FillFileDescriptorResponse(file_desc, response, &seen_files);
+  FillFileDescriptorResponse(file_desc, response);
   return Status::OK;
 }
 
@@ -138,8 +147,7 @@ Status ProtoServerReflection::GetFileContainingSymbol(
   if (file_desc == nullptr) {
     return Status(StatusCode::NOT_FOUND, "Symbol not found.");
   }
-  std::unordered_set<grpc::string> seen_files;
-  FillFileDescriptorResponse(file_desc, response, &seen_files);
+  FillFileDescriptorResponse(file_desc, response);
   return Status::OK;
 }
 
@@ -162,8 +170,7 @@ Status ProtoServerReflection::GetFileContainingExtension(
   if (field_desc == nullptr) {
     return Status(StatusCode::NOT_FOUND, "Extension not found.");
   }
-  std::unordered_set<grpc::string> seen_files;
-  FillFileDescriptorResponse(field_desc->file(), response, &seen_files);
+  FillFileDescriptorResponse(field_desc->file(), response);
   return Status::OK;
 }
 
@@ -191,7 +198,35 @@ Status ProtoServerReflection::GetAllExtensionNumbers(
 
 void ProtoServerReflection::FillFileDescriptorResponse(
     const protobuf::FileDescriptor* file_desc,
-    ServerReflectionResponse* response,
+    ServerReflectionResponse* response) {
+  *response->mutable_file_descriptor_response() =
+      *GetFileDescriptorResponse(file_desc);
+}
+
+std::shared_ptr<const FileDescriptorResponse>
+ProtoServerReflection::GetFileDescriptorResponse(
+    const protobuf::FileDescriptor* file_desc) {
+  {
+    grpc::internal::MutexLock lock(&cache_mu_);
+    auto it = file_response_cache_.find(file_desc);
+    if (it != file_response_cache_.end()) {
+      return it->second;
+    }
+  }
+  // Build outside the lock: a racing stream may build the same response,
+  // and whichever is inserted first wins.
+  std::shared_ptr<FileDescriptorResponse> file_response =
+      std::make_shared<FileDescriptorResponse>();
+  std::unordered_set<grpc::string> seen_files;
+  AddFileDescriptorClosure(file_desc, file_response.get(), &seen_files);
+  grpc::internal::MutexLock lock(&cache_mu_);
+  return file_response_cache_.emplace(file_desc, std::move(file_response))
+      .first->second;
+}
+
+void ProtoServerReflection::AddFileDescriptorClosure(
+    const protobuf::FileDescriptor* file_desc,
+    FileDescriptorResponse* response,
     std::unordered_set<grpc::string>* seen_files) {
   if (seen_files->find(file_desc->name()) != seen_files->end()) {
     return;
@@ -202,10 +237,10 @@ void ProtoServerReflection::FillFileDescriptorResponse(
   grpc::string data;
   file_desc->CopyTo(&file_desc_proto);
   file_desc_proto.SerializeToString(&data);
-  response->mutable_file_descriptor_response()->add_file_descriptor_proto(data);
+  response->add_file_descriptor_proto(data);
 
   for (int i = 0; i < file_desc->dependency_count(); ++i) {
-    FillFileDescriptorResponse(file_desc->dependency(i), response, seen_files);
+    AddFileDescriptorClosure(file_desc->dependency(i), response, seen_files);
   }
 }
 
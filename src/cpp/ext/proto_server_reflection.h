@@ -19,10 +19,13 @@
 #ifndef GRPC_INTERNAL_CPP_EXT_PROTO_SERVER_REFLECTION_H
 #define GRPC_INTERNAL_CPP_EXT_PROTO_SERVER_REFLECTION_H
 
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <grpcpp/grpcpp.h>
+#include <grpcpp/impl/codegen/sync.h>
 #include "src/proto/grpc/reflection/v1alpha/reflection.grpc.pb.h"
 
 namespace grpc {
@@ -32,7 +35,8 @@ class ProtoServerReflection final
  public:
   ProtoServerReflection();
 
-  // Add the full names of registered services
+  // Add the full names of registered services, and precompute the file
+  // descriptor responses for the files that define them
   void SetServiceList(const std::vector<grpc::string>* services);
 
   // implementation of ServerReflectionInfo(stream ServerReflectionRequest) rpc
@@ -63,9 +67,21 @@ class ProtoServerReflection final
       ServerContext* context, const grpc::string& type,
       reflection::v1alpha::ExtensionNumberResponse* response);
 
+  // Sets response's file_descriptor_response to file_desc and its transitive
+  // dependencies, from the cache when possible.
   void FillFileDescriptorResponse(
       const protobuf::FileDescriptor* file_desc,
-      reflection::v1alpha::ServerReflectionResponse* response,
+      reflection::v1alpha::ServerReflectionResponse* response);
+
+  // Returns the cached response for file_desc, building it on first use.
+  std::shared_ptr<const reflection::v1alpha::FileDescriptorResponse>
+  GetFileDescriptorResponse(const protobuf::FileDescriptor* file_desc);
+
+  // Appends the serialized file_desc and, depth first, its dependencies that
+  // are not in seen_files yet.
+  void AddFileDescriptorClosure(
+      const protobuf::FileDescriptor* file_desc,
+      reflection::v1alpha::FileDescriptorResponse* response,
       std::unordered_set<grpc::string>* seen_files);
 
   void FillErrorResponse(const Status& status,
@@ -73,6 +89,14 @@ class ProtoServerReflection final
 
   const protobuf::DescriptorPool* descriptor_pool_;
   const std::vector<string>* services_;
+
+  // Descriptors in the pool never change, so a file's response is built once
+  // and shared by every stream that asks for it.
+  grpc::internal::Mutex cache_mu_;
+  std::unordered_map<
+      const protobuf::FileDescriptor*,
+      std::shared_ptr<const reflection::v1alpha::FileDescriptorResponse>>
+      file_response_cache_;
 };
 
 }  // namespace grpc
@@ -224,6 +224,14 @@ class PerBalancerStore {
 
   void ClearLoadRecordMap() { load_record_map_.clear(); }
 
+  // Moves the load records out of this store, leaving it empty, so that the
+  // caller can turn them into a report without holding the store's lock.
+  LoadRecordMap TakeLoadRecordMap() {
+    LoadRecordMap taken;
+    taken.swap(load_record_map_);
+    return taken;
+  }
+
   // Getters.
   const grpc::string& lb_id() const { return lb_id_; }
   const grpc::string& load_key() const { return load_key_; }
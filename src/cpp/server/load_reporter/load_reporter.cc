@@ -290,59 +290,81 @@ LoadReporter::GenerateLoadBalancingFeedback() {
 ::google::protobuf::RepeatedPtrField<::grpc::lb::v1::Load>
 LoadReporter::GenerateLoads(const grpc::string& hostname,
                             const grpc::string& lb_id) {
-  grpc_core::MutexLock lock(&store_mu_);
-  auto assigned_stores = load_data_store_.GetAssignedStores(hostname, lb_id);
-  GPR_ASSERT(assigned_stores != nullptr);
-  GPR_ASSERT(!assigned_stores->empty());
+  // What each assigned store contributes to the report, taken out of the
+  // store under store_mu_ so that the protos can be built without it. The
+  // stores themselves are never destroyed, and their LB ID and load key never
+  // change, so they can be read after the lock is released.
+  struct StoreReport {
+    const PerBalancerStore* store;
+    PerBalancerStore::LoadRecordMap load_records;
+    bool report_num_calls_in_progress;
+    uint64_t num_calls_in_progress;
+  };
+  std::vector<StoreReport> store_reports;
+  {
+    grpc_core::MutexLock lock(&store_mu_);
+    auto assigned_stores = load_data_store_.GetAssignedStores(hostname, lb_id);
+    GPR_ASSERT(assigned_stores != nullptr);
+    GPR_ASSERT(!assigned_stores->empty());
+    store_reports.reserve(assigned_stores->size());
+    for (PerBalancerStore* per_balancer_store : *assigned_stores) {
+      GPR_ASSERT(!per_balancer_store->IsSuspended());
+      StoreReport report;
+      report.store = per_balancer_store;
+      report.load_records = per_balancer_store->TakeLoadRecordMap();
+      report.report_num_calls_in_progress =
+          per_balancer_store->IsNumCallsInProgressChangedSinceLastReport();
+      report.num_calls_in_progress =
+          report.report_num_calls_in_progress
+              ? per_balancer_store->GetNumCallsInProgressForReport()
+              : 0;
+      store_reports.push_back(std::move(report));
+    }
+  }
   ::google::protobuf::RepeatedPtrField<::grpc::lb::v1::Load> loads;
-  for (PerBalancerStore* per_balancer_store : *assigned_stores) {
-    GPR_ASSERT(!per_balancer_store->IsSuspended());
-    if (!per_balancer_store->load_record_map().empty()) {
-      for (const auto& p : per_balancer_store->load_record_map()) {
-        const auto& key = p.first;
-        const auto& value = p.second;
-        auto load = loads.Add();
-        load->set_load_balance_tag(key.lb_tag());
-        load->set_user_id(key.user_id());
-        load->set_client_ip_address(key.GetClientIpBytes());
-        load->set_num_calls_started(static_cast<int64_t>(value.start_count()));
-        load->set_num_calls_finished_without_error(
-            static_cast<int64_t>(value.ok_count()));
-        load->set_num_calls_finished_with_error(
-            static_cast<int64_t>(value.error_count()));
-        load->set_total_bytes_sent(static_cast<int64_t>(value.bytes_sent()));
-        load->set_total_bytes_received(
-            static_cast<int64_t>(value.bytes_recv()));
-        load->mutable_total_latency()->set_seconds(
-            static_cast<int64_t>(value.latency_ms() / 1000));
-        load->mutable_total_latency()->set_nanos(
-            (static_cast<int32_t>(value.latency_ms()) % 1000) * 1000000);
-        for (const auto& p : value.call_metrics()) {
-          const grpc::string& metric_name = p.first;
-          const CallMetricValue& metric_value = p.second;
-          auto call_metric_data = load->add_metric_data();
-          call_metric_data->set_metric_name(metric_name);
-          call_metric_data->set_num_calls_finished_with_metric(
-              metric_value.num_calls());
-          call_metric_data->set_total_metric_value(
-              metric_value.total_metric_value());
-        }
-        if (per_balancer_store->lb_id() != lb_id) {
-          // This per-balancer store is an orphan assigned to this receiving
-          // balancer.
-          AttachOrphanLoadId(load, *per_balancer_store);
-        }
+  for (const StoreReport& report : store_reports) {
+    const PerBalancerStore& per_balancer_store = *report.store;
+    for (const auto& p : report.load_records) {
+      const auto& key = p.first;
+      const auto& value = p.second;
+      auto load = loads.Add();
+      load->set_load_balance_tag(key.lb_tag());
+      load->set_user_id(key.user_id());
+      load->set_client_ip_address(key.GetClientIpBytes());
+      load->set_num_calls_started(static_cast<int64_t>(value.start_count()));
+      load->set_num_calls_finished_without_error(
+          static_cast<int64_t>(value.ok_count()));
+      load->set_num_calls_finished_with_error(
+          static_cast<int64_t>(value.error_count()));
+      load->set_total_bytes_sent(static_cast<int64_t>(value.bytes_sent()));
+      load->set_total_bytes_received(static_cast<int64_t>(value.bytes_recv()));
+      load->mutable_total_latency()->set_seconds(
+          static_cast<int64_t>(value.latency_ms() / 1000));
+      load->mutable_total_latency()->set_nanos(
+          (static_cast<int32_t>(value.latency_ms()) % 1000) * 1000000);
+      for (const auto& p : value.call_metrics()) {
+        const grpc::string& metric_name = p.first;
+        const CallMetricValue& metric_value = p.second;
+        auto call_metric_data = load->add_metric_data();
+        call_metric_data->set_metric_name(metric_name);
+        call_metric_data->set_num_calls_finished_with_metric(
+            metric_value.num_calls());
+        call_metric_data->set_total_metric_value(
+            metric_value.total_metric_value());
+      }
+      if (per_balancer_store.lb_id() != lb_id) {
+        // This per-balancer store is an orphan assigned to this receiving
+        // balancer.
+        AttachOrphanLoadId(load, per_balancer_store);
       }
-      per_balancer_store->ClearLoadRecordMap();
     }
-    if (per_balancer_store->IsNumCallsInProgressChangedSinceLastReport()) {
+    if (report.report_num_calls_in_progress) {
       auto load = loads.Add();
-      load->set_num_calls_in_progress(
-          per_balancer_store->GetNumCallsInProgressForReport());
-      if (per_balancer_store->lb_id() != lb_id) {
+      load->set_num_calls_in_progress(report.num_calls_in_progress);
+      if (per_balancer_store.lb_id() != lb_id) {
         // This per-balancer store is an orphan assigned to this receiving
         // balancer.
-        AttachOrphanLoadId(load, *per_balancer_store);
+        AttachOrphanLoadId(load, per_balancer_store);
       }
     }
   }
@@ -394,23 +416,30 @@ void LoadReporter::ReportStreamClosed(const grpc::string& hostname,
           hostname.c_str(), lb_id.c_str());
 }
 
+void LoadReporter::MergeRows(const std::vector<PendingRow>& rows) {
+  if (rows.empty()) return;
+  grpc_core::MutexLock lock(&store_mu_);
+  for (const PendingRow& row : rows) {
+    load_data_store_.MergeRow(*row.host, row.key, row.value);
+  }
+}
+
 void LoadReporter::ProcessViewDataCallStart(
     const CensusViewProvider::ViewDataMap& view_data_map) {
   auto it = view_data_map.find(kViewStartCount);
   if (it != view_data_map.end()) {
+    std::vector<PendingRow> rows;
+    rows.reserve(it->second.int_data().size());
     for (const auto& p : it->second.int_data()) {
       const std::vector<grpc::string>& tag_values = p.first;
       const uint64_t start_count = static_cast<uint64_t>(p.second);
       const grpc::string& client_ip_and_token = tag_values[0];
       const grpc::string& host = tag_values[1];
       const grpc::string& user_id = tag_values[2];
-      LoadRecordKey key(client_ip_and_token, user_id);
-      LoadRecordValue value = LoadRecordValue(start_count);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows.emplace_back(&host, LoadRecordKey(client_ip_and_token, user_id),
+                        LoadRecordValue(start_count));
     }
+    MergeRows(rows);
   }
 }
 
@@ -420,6 +449,8 @@ void LoadReporter::ProcessViewDataCallEnd(
   uint64_t total_error_count = 0;
   auto it = view_data_map.find(kViewEndCount);
   if (it != view_data_map.end()) {
+    std::vector<PendingRow> rows;
+    rows.reserve(it->second.int_data().size());
     for (const auto& p : it->second.int_data()) {
       const std::vector<grpc::string>& tag_values = p.first;
       const uint64_t end_count = static_cast<uint64_t>(p.second);
@@ -456,13 +487,11 @@ void LoadReporter::ProcessViewDataCallEnd(
         error_count = end_count;
         total_error_count += end_count;
       }
-      LoadRecordValue value = LoadRecordValue(
-          0, ok_count, error_count, bytes_sent, bytes_received, latency_ms);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows.emplace_back(&host, std::move(key),
+                        LoadRecordValue(0, ok_count, error_count, bytes_sent,
+                                        bytes_received, latency_ms));
     }
+    MergeRows(rows);
   }
   AppendNewFeedbackRecord(total_end_count, total_error_count);
 }
@@ -471,6 +500,8 @@ void LoadReporter::ProcessViewDataOtherCallMetrics(
     const CensusViewProvider::ViewDataMap& view_data_map) {
   auto it = view_data_map.find(kViewOtherCallMetricCount);
   if (it != view_data_map.end()) {
+    std::vector<PendingRow> rows;
+    rows.reserve(it->second.int_data().size());
     for (const auto& p : it->second.int_data()) {
       const std::vector<grpc::string>& tag_values = p.first;
       const int64_t num_calls = p.second;
@@ -483,13 +514,12 @@ void LoadReporter::ProcessViewDataOtherCallMetrics(
           CensusViewProvider::GetRelatedViewDataRowDouble(
               view_data_map, kViewOtherCallMetricValue,
               sizeof(kViewOtherCallMetricValue) - 1, tag_values);
-      LoadRecordValue value = LoadRecordValue(
-          metric_name, static_cast<uint64_t>(num_calls), total_metric_value);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows.emplace_back(&host, std::move(key),
+                        LoadRecordValue(metric_name,
+                                        static_cast<uint64_t>(num_calls),
+                                        total_metric_value));
     }
+    MergeRows(rows);
   }
 }
 
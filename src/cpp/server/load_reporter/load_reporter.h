@@ -186,6 +186,22 @@ class LoadReporter {
           cpu_limit(cpu_limit) {}
   };
 
+  // A load record read from Census and waiting to be merged into the store.
+  // host points into the view data the row was read from.
+  struct PendingRow {
+    const grpc::string* host;
+    LoadRecordKey key;
+    LoadRecordValue value;
+
+    PendingRow(const grpc::string* host, LoadRecordKey key,
+               LoadRecordValue value)
+        : host(host), key(std::move(key)), value(std::move(value)) {}
+  };
+
+  // Merges the rows into the load data store under a single acquisition of
+  // store_mu_.
+  void MergeRows(const std::vector<PendingRow>& rows);
+
   // Finds the view data about starting call from the view_data_map and merges
   // the data to the load data store.
   void ProcessViewDataCallStart(
@@ -215,8 +231,8 @@ class LoadReporter {
   const std::chrono::seconds feedback_sample_window_seconds_;
   grpc_core::Mutex feedback_mu_;
   std::deque<LoadBalancingFeedbackRecord> feedback_records_;
-  // TODO(juanlishen): Lock in finer grain. Locking the whole store may be
-  // too expensive.
+  // Held once per view when merging fetched data, and only long enough to take
+  // the load records out of the assigned stores when generating a report.
   grpc_core::Mutex store_mu_;
   LoadDataStore load_data_store_;
   std::unique_ptr<CensusViewProvider> census_view_provider_;
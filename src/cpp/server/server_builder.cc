@@ -79,6 +79,17 @@ std::unique_ptr<ServerCompletionQueue> ServerBuilder::AddCompletionQueue(
   return std::unique_ptr<ServerCompletionQueue>(cq);
 }
 
+std::unique_ptr<ServerCompletionQueue>
+ServerBuilder::experimental_type::AddShardedCompletionQueue(
+    bool is_frequently_polled) {
+  ServerCompletionQueue* cq = new ServerCompletionQueue(
+      GRPC_CQ_NEXT_SHARDED,
+      is_frequently_polled ? GRPC_CQ_DEFAULT_POLLING : GRPC_CQ_NON_LISTENING,
+      nullptr);
+  builder_->cqs_.push_back(cq);
+  return std::unique_ptr<ServerCompletionQueue>(cq);
+}
+
 ServerBuilder& ServerBuilder::RegisterService(grpc::Service* service) {
   services_.emplace_back(new NamedService(service));
   return *this;
@@ -150,6 +161,9 @@ ServerBuilder& ServerBuilder::SetSyncServerOption(
     case CQ_TIMEOUT_MSEC:
       sync_server_settings_.cq_timeout_msec = val;
       break;
+    case WARM_THREADS:
+      sync_server_settings_.warm_threads = val;
+      break;
   }
   return *this;
 }
@@ -188,6 +202,15 @@ ServerBuilder& ServerBuilder::SetResourceQuota(
   return *this;
 }
 
+ServerBuilder& ServerBuilder::SetReusePortListenerAffinity(bool enabled) {
+  return AddChannelArgument(GRPC_ARG_REUSEPORT_LISTENER_AFFINITY,
+                            enabled ? 1 : 0);
+}
+
+ServerBuilder& ServerBuilder::SetNumaThreadPlacement(bool enabled) {
+  return AddChannelArgument(GRPC_ARG_NUMA_THREAD_PLACEMENT, enabled ? 1 : 0);
+}
+
 ServerBuilder& ServerBuilder::AddListeningPort(
     const grpc::string& addr_uri,
     std::shared_ptr<grpc::ServerCredentials> creds, int* selected_port) {
@@ -308,10 +331,11 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
     // This is a Sync server
     gpr_log(GPR_INFO,
             "Synchronous server. Num CQs: %d, Min pollers: %d, Max Pollers: "
-            "%d, CQ timeout (msec): %d",
+            "%d, CQ timeout (msec): %d, Warm threads: %d",
             sync_server_settings_.num_cqs, sync_server_settings_.min_pollers,
             sync_server_settings_.max_pollers,
-            sync_server_settings_.cq_timeout_msec);
+            sync_server_settings_.cq_timeout_msec,
+            sync_server_settings_.warm_threads);
   }
 
   if (has_callback_methods) {
@@ -321,7 +345,8 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
   std::unique_ptr<grpc::Server> server(new grpc::Server(
       max_receive_message_size_, &args, sync_server_cqs,
       sync_server_settings_.min_pollers, sync_server_settings_.max_pollers,
-      sync_server_settings_.cq_timeout_msec, std::move(acceptors_),
+      sync_server_settings_.cq_timeout_msec,
+      sync_server_settings_.warm_threads, std::move(acceptors_),
       resource_quota_, std::move(interceptor_creators_)));
 
   grpc_impl::ServerInitializer* initializer = server->initializer();
@@ -18,6 +18,7 @@
 #include <grpcpp/server.h>
 
 #include <cstdlib>
+#include <memory>
 #include <sstream>
 #include <type_traits>
 #include <utility>
@@ -42,6 +43,9 @@
 #include <grpcpp/support/time.h>
 
 #include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/cpu.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/surface/call.h"
@@ -72,6 +76,12 @@ namespace {
 // soft maximum
 #define SOFT_MINIMUM_SPARE_CALLBACK_REQS_PER_METHOD 128
 
+// A finished request is recycled rather than freed while the method has fewer
+// unmatched requests than the larger of the soft minimum and the number of its
+// calls in progress. By Little's law that tracks the arrival rate times the
+// handler latency, so a method keeps enough spares to absorb the recent load
+// doubling without allocating, and gives back the rest as the load drops.
+
 class DefaultGlobalCallbacks final : public Server::GlobalCallbacks {
  public:
   ~DefaultGlobalCallbacks() override {}
@@ -82,6 +92,14 @@ class DefaultGlobalCallbacks final : public Server::GlobalCallbacks {
 std::shared_ptr<Server::GlobalCallbacks> g_callbacks = nullptr;
 gpr_once g_once_init_callbacks = GPR_ONCE_INIT;
 
+struct OperatorDelete {
+  void operator()(void* storage) const { ::operator delete(storage); }
+};
+
+// The storage of the last sync server CallData freed on this thread, handed
+// to the next one created on it.
+thread_local std::unique_ptr<void, OperatorDelete> g_free_sync_call_data;
+
 void InitGlobalCallbacks() {
   if (!g_callbacks) {
     g_callbacks.reset(new DefaultGlobalCallbacks());
@@ -437,6 +455,24 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
       }
     }
 
+    // A CallData is created by the SyncRequestThreadManager thread that picks
+    // its call up and usually deleted by the same thread when the handler
+    // returns, so a thread serving calls back to back reuses one block rather
+    // than going to the allocator for each call.
+    static void* operator new(std::size_t size) {
+      GPR_DEBUG_ASSERT(size == sizeof(CallData));
+      void* storage = grpc::g_free_sync_call_data.release();
+      return storage != nullptr ? storage : ::operator new(size);
+    }
+
+    static void operator delete(void* storage) {
+      if (grpc::g_free_sync_call_data == nullptr) {
+        grpc::g_free_sync_call_data.reset(storage);
+      } else {
+        ::operator delete(storage);
+      }
+    }
+
     void Run(const std::shared_ptr<GlobalCallbacks>& global_callbacks,
              bool resources) {
       global_callbacks_ = global_callbacks;
@@ -560,6 +596,7 @@ class Server::CallbackRequest final : public Server::CallbackRequestBase {
 
   ~CallbackRequest() {
     Clear();
+    delete call_details_;
 
     // The counter of outstanding requests must be decremented
     // under a lock in case it causes the server shutdown.
@@ -580,10 +617,11 @@ class Server::CallbackRequest final : public Server::CallbackRequestBase {
         return false;
       }
     } else {
+      // The call details are kept when the request is recycled.
       if (!call_details_) {
         call_details_ = new grpc_call_details;
-        grpc_call_details_init(call_details_);
       }
+      grpc_call_details_init(call_details_);
       if (grpc_server_request_call(server_->c_server(), &call_, call_details_,
                                    &request_metadata_, cq_->cq(), cq_->cq(),
                                    static_cast<void*>(&tag_)) != GRPC_CALL_OK) {
@@ -639,6 +677,8 @@ class Server::CallbackRequest final : public Server::CallbackRequestBase {
         delete req_;
         return;
       }
+      gpr_atm_no_barrier_fetch_add(
+          &req_->server_->callback_busy_reqs_count_[req_->method_index_], 1);
 
       // If this was the last request in the list or it is below the soft
       // minimum and there are spare requests available, set up a new one.
@@ -713,15 +753,23 @@ class Server::CallbackRequest final : public Server::CallbackRequestBase {
       handler->RunHandler(grpc::internal::MethodHandler::HandlerParameter(
           call_, &req_->ctx_, req_->request_, req_->request_status_,
           req_->handler_data_, [this] {
-            // Recycle this request if there aren't too many outstanding.
-            // Note that we don't have to worry about a case where there
-            // are no requests waiting to match for this method since that
-            // is already taken care of when binding a request to a call.
-            // TODO(vjpai): Also don't recycle this request if the dynamic
-            //              load no longer justifies it. Consider measuring
-            //              dynamic load and setting a target accordingly.
-            if (req_->server_->callback_reqs_outstanding_ <
-                SOFT_MAXIMUM_CALLBACK_REQS_OUTSTANDING) {
+            // Recycle this request if the method's load still justifies it
+            // and there aren't too many outstanding. Note that we don't have
+            // to worry about a case where there are no requests waiting to
+            // match for this method since that is already taken care of when
+            // binding a request to a call.
+            Server* server = req_->server_;
+            const size_t method_index = req_->method_index_;
+            const gpr_atm busy =
+                gpr_atm_no_barrier_fetch_add(
+                    &server->callback_busy_reqs_count_[method_index], -1) -
+                1;
+            const gpr_atm unmatched = gpr_atm_no_barrier_load(
+                &server->callback_unmatched_reqs_count_[method_index]);
+            if (unmatched < GPR_MAX(SOFT_MINIMUM_SPARE_CALLBACK_REQS_PER_METHOD,
+                                    busy) &&
+                server->callback_reqs_outstanding_ <
+                    SOFT_MAXIMUM_CALLBACK_REQS_OUTSTANDING) {
               req_->Clear();
               req_->Setup();
             } else {
@@ -738,10 +786,6 @@ class Server::CallbackRequest final : public Server::CallbackRequestBase {
   };
 
   void Clear() {
-    if (call_details_) {
-      delete call_details_;
-      call_details_ = nullptr;
-    }
     grpc_metadata_array_destroy(&request_metadata_);
     if (has_request_payload_ && request_payload_) {
       grpc_byte_buffer_destroy(request_payload_);
@@ -790,9 +834,15 @@ template <>
 bool Server::CallbackRequest<grpc::GenericServerContext>::FinalizeResult(
     void** tag, bool* status) {
   if (*status) {
-    // TODO(yangg) remove the copy here
-    ctx_.method_ = grpc::StringFromCopiedSlice(call_details_->method);
-    ctx_.host_ = grpc::StringFromCopiedSlice(call_details_->host);
+    // Assign in place so that a recycled request reuses the strings' buffers.
+    ctx_.method_.assign(
+        reinterpret_cast<const char*>(
+            GRPC_SLICE_START_PTR(call_details_->method)),
+        GRPC_SLICE_LENGTH(call_details_->method));
+    ctx_.host_.assign(
+        reinterpret_cast<const char*>(
+            GRPC_SLICE_START_PTR(call_details_->host)),
+        GRPC_SLICE_LENGTH(call_details_->host));
   }
   grpc_slice_unref(call_details_->method);
   grpc_slice_unref(call_details_->host);
@@ -818,8 +868,10 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
   SyncRequestThreadManager(Server* server, grpc::CompletionQueue* server_cq,
                            std::shared_ptr<GlobalCallbacks> global_callbacks,
                            grpc_resource_quota* rq, int min_pollers,
-                           int max_pollers, int cq_timeout_msec)
-      : ThreadManager("SyncServer", rq, min_pollers, max_pollers),
+                           int max_pollers, int cq_timeout_msec,
+                           int warm_threads)
+      : ThreadManager("SyncServer", rq, min_pollers, max_pollers,
+                      warm_threads),
         server_(server),
         server_cq_(server_cq),
         cq_timeout_msec_(cq_timeout_msec),
@@ -938,6 +990,7 @@ Server::Server(
     std::shared_ptr<std::vector<std::unique_ptr<grpc::ServerCompletionQueue>>>
         sync_server_cqs,
     int min_pollers, int max_pollers, int sync_cq_timeout_msec,
+    int warm_threads,
     std::vector<std::shared_ptr<grpc::internal::ExternalConnectionAcceptorImpl>>
         acceptors,
     grpc_resource_quota* server_rq,
@@ -971,7 +1024,7 @@ Server::Server(
     for (const auto& it : *sync_server_cqs_) {
       sync_req_mgrs_.emplace_back(new SyncRequestThreadManager(
           this, it.get(), global_callbacks_, server_rq, min_pollers,
-          max_pollers, sync_cq_timeout_msec));
+          max_pollers, sync_cq_timeout_msec, warm_threads));
     }
 
     if (default_rq_created) {
@@ -1000,6 +1053,21 @@ Server::Server(
     }
   }
 
+  if (grpc_channel_arg_get_bool(
+          grpc_channel_args_find(&channel_args, GRPC_ARG_NUMA_THREAD_PLACEMENT),
+          false)) {
+    // Spread the completion queues, and the threads polling each of them,
+    // across the NUMA nodes
+    for (size_t i = 0; i < sync_req_mgrs_.size(); i++) {
+      sync_req_mgrs_[i]->SetNumaNode(
+          static_cast<int>(i % gpr_cpu_num_numa_nodes()));
+    }
+  }
+
+  inline_callbacks_ = grpc_channel_arg_get_bool(
+      grpc_channel_args_find(&channel_args, GRPC_ARG_SERVER_INLINE_CALLBACKS),
+      false);
+
   server_ = grpc_server_create(&channel_args, nullptr);
 }
 
@@ -1109,6 +1177,7 @@ bool Server::RegisterService(const grpc::string* host, grpc::Service* service) {
     } else {
       // a callback method. Register at least some callback requests
       callback_unmatched_reqs_count_.push_back(0);
+      callback_busy_reqs_count_.push_back(0);
       auto method_index = callback_unmatched_reqs_count_.size() - 1;
       // TODO(vjpai): Register these dynamically based on need
       for (int i = 0; i < DEFAULT_CALLBACK_REQS_PER_METHOD; i++) {
@@ -1152,6 +1221,7 @@ void Server::RegisterCallbackGenericService(
   generic_handler_.reset(service->Handler());
 
   callback_unmatched_reqs_count_.push_back(0);
+  callback_busy_reqs_count_.push_back(0);
   auto method_index = callback_unmatched_reqs_count_.size() - 1;
   // TODO(vjpai): Register these dynamically based on need
   for (int i = 0; i < DEFAULT_CALLBACK_REQS_PER_METHOD; i++) {
@@ -1373,6 +1443,9 @@ grpc::CompletionQueue* Server::CallbackCQ() {
     callback_cq_ = new grpc::CompletionQueue(grpc_completion_queue_attributes{
         GRPC_CQ_CURRENT_VERSION, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING,
         shutdown_callback});
+    if (inline_callbacks_) {
+      grpc_cq_set_inline_callbacks(callback_cq_->cq());
+    }
 
     // Transfer ownership of the new cq to its own shutdown callback
     shutdown_callback->TakeCQ(callback_cq_);
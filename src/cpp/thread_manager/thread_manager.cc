@@ -27,19 +27,20 @@
 
 namespace grpc {
 
-ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
-    : thd_mgr_(thd_mgr) {
+ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr, bool parked)
+    : thd_mgr_(thd_mgr), parked_(parked) {
   // Make thread creation exclusive with respect to its join happening in
   // ~WorkerThread().
   thd_ = grpc_core::Thread(
       "grpcpp_sync_server",
       [](void* th) { static_cast<ThreadManager::WorkerThread*>(th)->Run(); },
-      this);
+      this, nullptr,
+      grpc_core::Thread::Options().set_numa_node(thd_mgr->numa_node_));
   thd_.Start();
 }
 
 void ThreadManager::WorkerThread::Run() {
-  thd_mgr_->MainWorkLoop();
+  thd_mgr_->MainWorkLoop(parked_);
   thd_mgr_->MarkAsCompleted(this);
 }
 
@@ -50,13 +51,18 @@ ThreadManager::WorkerThread::~WorkerThread() {
 
 ThreadManager::ThreadManager(const char* name,
                              grpc_resource_quota* resource_quota,
-                             int min_pollers, int max_pollers)
+                             int min_pollers, int max_pollers,
+                             int warm_threads)
     : shutdown_(false),
       num_pollers_(0),
       min_pollers_(min_pollers),
       max_pollers_(max_pollers == -1 ? INT_MAX : max_pollers),
       num_threads_(0),
-      max_active_threads_sofar_(0) {
+      warm_threads_(warm_threads),
+      num_parked_(0),
+      num_wakeups_(0),
+      max_active_threads_sofar_(0),
+      numa_node_(-1) {
   resource_user_ = grpc_resource_user_create(resource_quota, name);
 }
 
@@ -81,6 +87,7 @@ void ThreadManager::Wait() {
 void ThreadManager::Shutdown() {
   grpc_core::MutexLock lock(&mu_);
   shutdown_ = true;
+  park_cv_.Broadcast();
 }
 
 bool ThreadManager::IsShutdown() {
@@ -141,10 +148,60 @@ void ThreadManager::Initialize() {
   for (int i = 0; i < min_pollers_; i++) {
     new WorkerThread(this);
   }
+
+  if (warm_threads_ > 0) {
+    if (!grpc_resource_user_allocate_threads(resource_user_, warm_threads_)) {
+      gpr_log(GPR_INFO,
+              "No thread quota available to pre-create %d warm threads; "
+              "they will be kept as they become idle instead",
+              warm_threads_);
+      return;
+    }
+    {
+      grpc_core::MutexLock lock(&mu_);
+      num_threads_ += warm_threads_;
+      if (num_threads_ > max_active_threads_sofar_) {
+        max_active_threads_sofar_ = num_threads_;
+      }
+    }
+    for (int i = 0; i < warm_threads_; i++) {
+      new WorkerThread(this, true /* parked */);
+    }
+  }
+}
+
+bool ThreadManager::ParkLocked() {
+  if (shutdown_ || num_parked_ >= warm_threads_) return false;
+  num_parked_++;
+  while (!shutdown_ && num_wakeups_ == 0) {
+    park_cv_.Wait(&mu_);
+  }
+  if (num_wakeups_ > 0) {
+    // WakeParkedLocked() has already moved this thread from num_parked_ to
+    // num_pollers_.
+    num_wakeups_--;
+    return true;
+  }
+  num_parked_--;
+  return false;
+}
+
+bool ThreadManager::WakeParkedLocked() {
+  if (num_parked_ == 0) return false;
+  num_parked_--;
+  num_wakeups_++;
+  num_pollers_++;
+  park_cv_.Signal();
+  return true;
 }
 
-void ThreadManager::MainWorkLoop() {
-  while (true) {
+void ThreadManager::MainWorkLoop(bool parked) {
+  bool poll = true;
+  if (parked) {
+    grpc_core::MutexLock lock(&mu_);
+    poll = ParkLocked();
+  }
+  while (poll) {
     void* tag;
     bool ok;
     WorkStatus work_status = PollForWork(&tag, &ok);
@@ -156,8 +213,14 @@ void ThreadManager::MainWorkLoop() {
     switch (work_status) {
       case TIMEOUT:
         // If we timed out and we have more pollers than we need (or we are
-        // shutdown), finish this thread
-        if (shutdown_ || num_pollers_ > max_pollers_) done = true;
+        // shutdown), park or finish this thread
+        if (shutdown_) {
+          done = true;
+        } else if (num_pollers_ > max_pollers_) {
+          // Once woken up, the thread is already counted as a poller.
+          if (ParkLocked()) continue;
+          done = true;
+        }
         break;
       case SHUTDOWN:
         // If the thread manager is shutdown, finish this thread
@@ -168,7 +231,10 @@ void ThreadManager::MainWorkLoop() {
         // quota available to create a new thread, start a new poller thread
         bool resource_exhausted = false;
         if (!shutdown_ && num_pollers_ < min_pollers_) {
-          if (grpc_resource_user_allocate_threads(resource_user_, 1)) {
+          if (WakeParkedLocked()) {
+            // A warm thread takes over polling, without creating a thread
+            lock.Unlock();
+          } else if (grpc_resource_user_allocate_threads(resource_user_, 1)) {
             // We can allocate a new poller thread
             num_pollers_++;
             num_threads_++;
@@ -234,9 +300,13 @@ void ThreadManager::MainWorkLoop() {
     // pollset mutex) that makes DoWork() take longer to finish thereby causing
     // new poller threads to be created even faster. This results in a thread
     // avalanche.
+    //
+    // A thread that is not needed to poll is parked as a warm thread, if
+    // there is room for one, rather than finished: it holds no polling
+    // resources while parked, so it can't feed an avalanche either.
     if (num_pollers_ < max_pollers_) {
       num_pollers_++;
-    } else {
+    } else if (!ParkLocked()) {
       break;
     }
   };
@@ -34,8 +34,13 @@ namespace grpc {
 
 class ThreadManager {
  public:
+  // Besides its pollers, the ThreadManager keeps up to \a warm_threads idle
+  // threads parked, so that a burst of work can be met by waking them rather
+  // than by creating threads (and the burst's end by parking them rather than
+  // by tearing them down).
   explicit ThreadManager(const char* name, grpc_resource_quota* resource_quota,
-                         int min_pollers, int max_pollers);
+                         int min_pollers, int max_pollers,
+                         int warm_threads = 0);
   virtual ~ThreadManager();
 
   // Initializes and Starts the Rpc Manager threads
@@ -94,6 +99,11 @@ class ThreadManager {
   // to check if resource_quota is properly being enforced.
   int GetMaxActiveThreadsSoFar();
 
+  // Binds the threads created from now on to the CPUs of NUMA node \a node
+  // (-1, the default, lets them run anywhere). Must be called before
+  // Initialize() to apply to every thread.
+  void SetNumaNode(int node) { numa_node_ = node; }
+
  private:
   // Helper wrapper class around grpc_core::Thread. Takes a ThreadManager object
   // and starts a new grpc_core::Thread to calls the Run() function.
@@ -121,7 +131,8 @@ class ThreadManager {
   // not be called (and the need for this WorkerThread class is eliminated)
   class WorkerThread {
    public:
-    WorkerThread(ThreadManager* thd_mgr);
+    // A thread created \a parked waits to be woken before it starts polling.
+    WorkerThread(ThreadManager* thd_mgr, bool parked = false);
     ~WorkerThread();
 
    private:
@@ -130,11 +141,20 @@ class ThreadManager {
     void Run();
 
     ThreadManager* const thd_mgr_;
+    const bool parked_;
     grpc_core::Thread thd_;
   };
 
   // The main function in ThreadManager
-  void MainWorkLoop();
+  void MainWorkLoop(bool parked);
+
+  // Parks the calling thread, which holds mu_, if fewer than warm_threads_
+  // are parked. Returns true once the thread has been woken up to poll (and
+  // counted as a poller), or false if it should finish.
+  bool ParkLocked();
+
+  // Wakes up a parked thread to poll, if there is one. Requires mu_.
+  bool WakeParkedLocked();
 
   void MarkAsCompleted(WorkerThread* thd);
   void CleanupCompletedThreads();
@@ -165,11 +185,21 @@ class ThreadManager {
   // threads that are currently polling i.e num_pollers_)
   int num_threads_;
 
+  // The number of threads to keep parked, the number parked and the number
+  // woken up but yet to notice it. See ParkLocked()
+  int warm_threads_;
+  int num_parked_;
+  int num_wakeups_;
+  grpc_core::CondVar park_cv_;
+
   // See GetMaxActiveThreadsSoFar()'s description.
   // To be more specific, this variable tracks the max value num_threads_ was
   // ever set so far
   int max_active_threads_sofar_;
 
+  // The NUMA node new threads are bound to, or -1. See SetNumaNode()
+  int numa_node_;
+
   grpc_core::Mutex list_mu_;
   std::list<WorkerThread*> completed_threads_;
 };
@@ -43,4 +43,33 @@ Status ByteBuffer::Dump(std::vector<Slice>* slices) const {
   return Status::OK;
 }
 
+Status ByteBuffer::TrySingleSlice(Slice* slice) const {
+  if (!buffer_) {
+    return Status(StatusCode::FAILED_PRECONDITION, "Buffer not initialized");
+  }
+  if (buffer_->type != GRPC_BB_RAW ||
+      buffer_->data.raw.compression != GRPC_COMPRESS_NONE ||
+      buffer_->data.raw.slice_buffer.count != 1) {
+    return Status(StatusCode::FAILED_PRECONDITION,
+                  "Buffer isn't made up of an uncompressed single slice");
+  }
+  *slice = Slice(buffer_->data.raw.slice_buffer.slices[0], Slice::ADD_REF);
+  return Status::OK;
+}
+
+Status ByteBuffer::DumpToSingleSlice(Slice* slice) const {
+  if (!buffer_) {
+    return Status(StatusCode::FAILED_PRECONDITION, "Buffer not initialized");
+  }
+  grpc_byte_buffer_reader reader;
+  if (!grpc_byte_buffer_reader_init(&reader, buffer_)) {
+    return Status(StatusCode::INTERNAL,
+                  "Couldn't initialize byte buffer reader");
+  }
+  // readall hands back a lone slice as is and copies anything else once
+  *slice = Slice(grpc_byte_buffer_reader_readall(&reader), Slice::STEAL_REF);
+  grpc_byte_buffer_reader_destroy(&reader);
+  return Status::OK;
+}
+
 }  // namespace grpc
@@ -179,6 +179,27 @@ GPR_EXPORT const char* GPR_CALLTYPE grpcsharp_metadata_array_get_value(
   return (char*)GRPC_SLICE_START_PTR(array->metadata[index].value);
 }
 
+/*
+ * Largest receive metadata array whose storage a reset context keeps for its
+ * next use. Bigger ones are freed so that one call with unusually many
+ * metadata entries doesn't pin that memory in the context pool.
+ */
+#define GRPCSHARP_MAX_RETAINED_METADATA_CAPACITY 16
+
+/*
+ * Forgets the entries of a metadata array filled in by core (which doesn't
+ * hand out ownership of them), keeping array->metadata for reuse unless it
+ * is larger than GRPCSHARP_MAX_RETAINED_METADATA_CAPACITY.
+ */
+void grpcsharp_metadata_array_clear_metadata_only(grpc_metadata_array* array) {
+  if (array->capacity > GRPCSHARP_MAX_RETAINED_METADATA_CAPACITY) {
+    grpcsharp_metadata_array_destroy_metadata_only(array);
+    grpc_metadata_array_init(array);
+    return;
+  }
+  array->count = 0;
+}
+
 /* Move contents of metadata array */
 void grpcsharp_metadata_array_move(grpc_metadata_array* dest,
                                    grpc_metadata_array* src) {
@@ -198,8 +219,17 @@ void grpcsharp_metadata_array_move(grpc_metadata_array* dest,
   src->metadata = NULL;
 }
 
+/*
+ * Batch and request call contexts are pooled by the managed side and reset
+ * between uses. Resetting keeps the storage of the arrays core receives
+ * metadata into, so that a reused context usually needs no allocation for
+ * them.
+ */
 GPR_EXPORT void GPR_CALLTYPE
 grpcsharp_batch_context_reset(grpcsharp_batch_context* ctx) {
+  grpc_metadata_array recv_initial_metadata;
+  grpc_metadata_array recv_trailing_metadata;
+
   grpcsharp_metadata_array_destroy_metadata_including_entries(
       &(ctx->send_initial_metadata));
 
@@ -208,17 +238,22 @@ grpcsharp_batch_context_reset(grpcsharp_batch_context* ctx) {
   grpcsharp_metadata_array_destroy_metadata_including_entries(
       &(ctx->send_status_from_server.trailing_metadata));
 
-  grpcsharp_metadata_array_destroy_metadata_only(&(ctx->recv_initial_metadata));
+  grpcsharp_metadata_array_clear_metadata_only(&(ctx->recv_initial_metadata));
+  recv_initial_metadata = ctx->recv_initial_metadata;
 
   if (ctx->recv_message_reader) {
     grpc_byte_buffer_reader_destroy(ctx->recv_message_reader);
   }
   grpc_byte_buffer_destroy(ctx->recv_message);
 
-  grpcsharp_metadata_array_destroy_metadata_only(
+  grpcsharp_metadata_array_clear_metadata_only(
       &(ctx->recv_status_on_client.trailing_metadata));
+  recv_trailing_metadata = ctx->recv_status_on_client.trailing_metadata;
   grpc_slice_unref(ctx->recv_status_on_client.status_details);
   memset(ctx, 0, sizeof(grpcsharp_batch_context));
+
+  ctx->recv_initial_metadata = recv_initial_metadata;
+  ctx->recv_status_on_client.trailing_metadata = recv_trailing_metadata;
 }
 
 GPR_EXPORT void GPR_CALLTYPE
@@ -227,6 +262,9 @@ grpcsharp_batch_context_destroy(grpcsharp_batch_context* ctx) {
     return;
   }
   grpcsharp_batch_context_reset(ctx);
+  grpcsharp_metadata_array_destroy_metadata_only(&(ctx->recv_initial_metadata));
+  grpcsharp_metadata_array_destroy_metadata_only(
+      &(ctx->recv_status_on_client.trailing_metadata));
   gpr_free(ctx);
 }
 
@@ -236,9 +274,14 @@ grpcsharp_request_call_context_reset(grpcsharp_request_call_context* ctx) {
      supposed
      to take its ownership. */
 
+  grpc_metadata_array request_metadata;
+
   grpc_call_details_destroy(&(ctx->call_details));
-  grpcsharp_metadata_array_destroy_metadata_only(&(ctx->request_metadata));
+  grpcsharp_metadata_array_clear_metadata_only(&(ctx->request_metadata));
+  request_metadata = ctx->request_metadata;
   memset(ctx, 0, sizeof(grpcsharp_request_call_context));
+
+  ctx->request_metadata = request_metadata;
 }
 
 GPR_EXPORT void GPR_CALLTYPE
@@ -247,6 +290,7 @@ grpcsharp_request_call_context_destroy(grpcsharp_request_call_context* ctx) {
     return;
   }
   grpcsharp_request_call_context_reset(ctx);
+  grpcsharp_metadata_array_destroy_metadata_only(&(ctx->request_metadata));
   gpr_free(ctx);
 }
 
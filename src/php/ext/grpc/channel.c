@@ -230,6 +230,22 @@ void create_channel(
   efree(args.args);
 }
 
+/* With grpc.prewarm_persistent_channels set, asks a persistent channel to
+ * start connecting as soon as a Grpc\Channel is constructed for it, so that
+ * name resolution and the (TLS) handshake overlap with whatever the script
+ * does before its first call instead of delaying that call. On a channel
+ * reused from an earlier request this also wakes it up if it went idle. */
+void prewarm_persistent_channel(grpc_channel_wrapper *wrapper TSRMLS_DC) {
+  if (!GRPC_G(prewarm_persistent_channels)) {
+    return;
+  }
+  gpr_mu_lock(&wrapper->mu);
+  if (wrapper->wrapped != NULL) {
+    grpc_channel_check_connectivity_state(wrapper->wrapped, 1);
+  }
+  gpr_mu_unlock(&wrapper->mu);
+}
+
 void create_and_add_channel_to_persistent_list(
     wrapped_grpc_channel *channel,
     char *target,
@@ -275,6 +291,7 @@ void create_and_add_channel_to_persistent_list(
   // Persistent map refer to it.
   php_grpc_channel_ref(channel->wrapper);
   gpr_mu_unlock(&global_persistent_list_mu);
+  prewarm_persistent_channel(channel->wrapper TSRMLS_CC);
 }
 
 /**
@@ -292,6 +309,10 @@ void create_and_add_channel_to_persistent_list(
  * of "true", a new and separate underlying grpc_channel will be created
  * and returned. This will not affect existing channels.
  *
+ * If the grpc.prewarm_persistent_channels ini setting is on, a persistent
+ * underlying grpc_channel starts connecting right away instead of on its
+ * first call.
+ *
  * @param string $target The hostname to associate with this channel
  * @param array $args_array The arguments to pass to the Channel
  */
@@ -435,6 +456,7 @@ PHP_METHOD(Channel, __construct) {
       // One more Grpc\Channel object refer to it.
       php_grpc_channel_ref(channel->wrapper);
       update_and_get_target_upper_bound(target, target_upper_bound);
+      prewarm_persistent_channel(channel->wrapper TSRMLS_CC);
     }
   }
 }
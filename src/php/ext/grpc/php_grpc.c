@@ -74,6 +74,9 @@ ZEND_GET_MODULE(grpc)
                      enable_fork_support, zend_grpc_globals, grpc_globals)
    STD_PHP_INI_ENTRY("grpc.poll_strategy", NULL, PHP_INI_SYSTEM, OnUpdateString,
                      poll_strategy, zend_grpc_globals, grpc_globals)
+   STD_PHP_INI_ENTRY("grpc.prewarm_persistent_channels", "0", PHP_INI_SYSTEM,
+                     OnUpdateBool, prewarm_persistent_channels,
+                     zend_grpc_globals, grpc_globals)
    PHP_INI_END()
 /* }}} */
 
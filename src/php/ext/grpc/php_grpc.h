@@ -68,6 +68,7 @@ ZEND_BEGIN_MODULE_GLOBALS(grpc)
   zend_bool initialized;
   zend_bool enable_fork_support;
   char *poll_strategy;
+  zend_bool prewarm_persistent_channels;
 ZEND_END_MODULE_GLOBALS(grpc)
 
 ZEND_EXTERN_MODULE_GLOBALS(grpc);
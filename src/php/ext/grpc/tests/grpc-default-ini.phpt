@@ -10,6 +10,9 @@ if (ini_get('grpc.enable_fork_support')) {
 if (ini_get('grpc.poll_strategy') !== "") {
     die('grpc.poll_strategy not empty by default');
 }
+if (ini_get('grpc.prewarm_persistent_channels')) {
+    die('grpc.prewarm_persistent_channels not off by default');
+}
 echo 'ok';
 --EXPECT--
 ok
@@ -5,6 +5,7 @@ Ensure ini settings are handled
 --INI--
 grpc.enable_fork_support = 1
 grpc.poll_strategy = epoll1
+grpc.prewarm_persistent_channels = 1
 --FILE--
 <?php
 if (!ini_get('grpc.enable_fork_support')) {
@@ -19,6 +20,9 @@ if (ini_get('grpc.poll_strategy') !== 'epoll1') {
 if (getenv('GRPC_POLL_STRATEGY') !== 'epoll1') {
     die('env GRPC_POLL_STRATEGY not epoll1');
 }
+if (!ini_get('grpc.prewarm_persistent_channels')) {
+    die('grpc.prewarm_persistent_channels not set');
+}
 echo 'ok';
 --EXPECT--
 ok
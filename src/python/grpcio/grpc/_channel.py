@@ -576,21 +576,43 @@ class _UnaryUnaryMultiCallable(grpc.UnaryUnaryMultiCallable):
 
     def _blocking(self, request, timeout, metadata, credentials, wait_for_ready,
                   compression):
-        state, operations, deadline, rendezvous = self._prepare(
-            request, timeout, metadata, wait_for_ready, compression)
-        if state is None:
+        deadline, serialized_request, rendezvous = _start_unary_request(
+            request, timeout, self._request_serializer)
+        if serialized_request is None:
             raise rendezvous  # pylint: disable-msg=raising-bad-type
-        else:
-            call = self._channel.segregated_call(
-                cygrpc.PropagationConstants.GRPC_PROPAGATE_DEFAULTS,
-                self._method, None, _determine_deadline(deadline), metadata,
-                None if credentials is None else credentials._credentials, ((
-                    operations,
-                    None,
-                ),), self._context)
-            event = call.next_event()
-            _handle_event(event, state, self._response_deserializer)
-            return state, call
+        initial_metadata_flags = _InitialMetadataFlags().with_wait_for_ready(
+            wait_for_ready)
+        augmented_metadata = _compression.augment_metadata(
+            metadata, compression)
+        (initial_metadata, serialized_response, code, details,
+         trailing_metadata,
+         debug_error_string) = self._channel.unary_unary_call(
+             cygrpc.PropagationConstants.GRPC_PROPAGATE_DEFAULTS, self._method,
+             None, _determine_deadline(deadline), augmented_metadata,
+             initial_metadata_flags, serialized_request,
+             None if credentials is None else credentials._credentials,
+             self._context)
+        state = _RPCState((), initial_metadata, None, None, None)
+        if serialized_response is not None:
+            response = _common.deserialize(serialized_response,
+                                           self._response_deserializer)
+            if response is None:
+                _abort(state, grpc.StatusCode.INTERNAL,
+                       'Exception deserializing response!')
+            else:
+                state.response = response
+        state.trailing_metadata = trailing_metadata
+        if state.code is None:
+            status_code = _common.CYGRPC_STATUS_CODE_TO_STATUS_CODE.get(code)
+            if status_code is None:
+                state.code = grpc.StatusCode.UNKNOWN
+                state.details = _unknown_code_details(code, details)
+            else:
+                state.code = status_code
+                state.details = details
+                state.debug_error_string = debug_error_string
+        # The RPC is over, so the rendezvous never needs its call.
+        return state, None
 
     def __call__(self,
                  request,
@@ -13,6 +13,7 @@
 # limitations under the License.
 
 cimport cpython
+from libc cimport string
 
 import threading
 import time
@@ -178,6 +179,46 @@ cdef _next_call_event(
     return event
 
 
+cdef void _create_c_call(
+    _ChannelState channel_state, _CallState call_state,
+    grpc_completion_queue *c_completion_queue, int flags, method, host,
+    object deadline, CallCredentials credentials, object context) except *:
+  """Creates the core call of an RPC and assigns it to call_state.c_call.
+
+  Must be called with the channel_state condition held and the channel open.
+  Any error setting the credentials is raised, with no call assigned.
+  """
+  cdef grpc_slice method_slice
+  cdef grpc_slice host_slice
+  cdef grpc_slice *host_slice_ptr
+  cdef grpc_call_credentials *c_call_credentials
+  cdef grpc_call_error c_call_error
+  method_slice = _slice_from_bytes(method)
+  if host is None:
+    host_slice_ptr = NULL
+  else:
+    host_slice = _slice_from_bytes(host)
+    host_slice_ptr = &host_slice
+  call_state.c_call = grpc_channel_create_call(
+      channel_state.c_channel, NULL, flags,
+      c_completion_queue, method_slice, host_slice_ptr,
+      _timespec_from_time(deadline), NULL)
+  grpc_slice_unref(method_slice)
+  if host_slice_ptr:
+    grpc_slice_unref(host_slice)
+  if context is not None:
+    set_census_context_on_call(call_state, context)
+  if credentials is not None:
+    c_call_credentials = credentials.c()
+    c_call_error = grpc_call_set_credentials(
+        call_state.c_call, c_call_credentials)
+    grpc_call_credentials_release(c_call_credentials)
+    if c_call_error != GRPC_CALL_OK:
+      grpc_call_unref(call_state.c_call)
+      call_state.c_call = NULL
+      _raise_call_error_no_metadata(c_call_error)
+
+
 # TODO(https://github.com/grpc/grpc/issues/14569): This could be a lot simpler.
 cdef void _call(
     _ChannelState channel_state, _CallState call_state,
@@ -212,39 +253,14 @@ cdef void _call(
     metadata: The metadata for this call.
     context: Context object for distributed tracing.
   """
-  cdef grpc_slice method_slice
-  cdef grpc_slice host_slice
-  cdef grpc_slice *host_slice_ptr
-  cdef grpc_call_credentials *c_call_credentials
   cdef grpc_call_error c_call_error
   cdef tuple error_and_wrapper_tag
   cdef _BatchOperationTag wrapper_tag
   with channel_state.condition:
     if channel_state.open:
-      method_slice = _slice_from_bytes(method)
-      if host is None:
-        host_slice_ptr = NULL
-      else:
-        host_slice = _slice_from_bytes(host)
-        host_slice_ptr = &host_slice
-      call_state.c_call = grpc_channel_create_call(
-          channel_state.c_channel, NULL, flags,
-          c_completion_queue, method_slice, host_slice_ptr,
-          _timespec_from_time(deadline), NULL)
-      grpc_slice_unref(method_slice)
-      if host_slice_ptr:
-        grpc_slice_unref(host_slice)
-      if context is not None:
-        set_census_context_on_call(call_state, context)
-      if credentials is not None:
-        c_call_credentials = credentials.c()
-        c_call_error = grpc_call_set_credentials(
-            call_state.c_call, c_call_credentials)
-        grpc_call_credentials_release(c_call_credentials)
-        if c_call_error != GRPC_CALL_OK:
-          grpc_call_unref(call_state.c_call)
-          call_state.c_call = NULL
-          _raise_call_error_no_metadata(c_call_error)
+      _create_c_call(
+          channel_state, call_state, c_completion_queue, flags, method, host,
+          deadline, credentials, context)
       started_tags = set()
       for operations, user_tag in operationses_and_user_tags:
         c_call_error, tag = _operate(call_state.c_call, operations, user_tag)
@@ -372,6 +388,117 @@ cdef SegregatedCall _segregated_call(
   return segregated_call
 
 
+cdef tuple _unary_unary_call(
+    _ChannelState state, int flags, method, host, object deadline,
+    object metadata, int initial_metadata_flags, bytes request,
+    CallCredentials credentials, object context):
+  """Invokes a unary-unary RPC and blocks until it completes.
+
+  All six operations of the RPC are started as one batch on a completion
+  queue of the RPC's own, straight from C structures rather than Operation
+  and tag objects, and the GIL is released while waiting for the batch.
+
+  Returns:
+    A tuple of the initial metadata, the response bytes or None if there
+    were none, the status code, the details, the trailing metadata and the
+    debug error string.
+  """
+  cdef _CallState call_state = _CallState()
+  cdef grpc_completion_queue *c_completion_queue = NULL
+  cdef grpc_op c_ops[6]
+  cdef grpc_metadata *c_initial_metadata = NULL
+  cdef size_t c_initial_metadata_count = 0
+  cdef grpc_slice request_slice
+  cdef grpc_byte_buffer *c_request = NULL
+  cdef grpc_metadata_array c_received_initial_metadata
+  cdef grpc_byte_buffer *c_response = NULL
+  cdef grpc_metadata_array c_trailing_metadata
+  cdef grpc_status_code c_code
+  cdef grpc_slice c_details = grpc_empty_slice()
+  cdef const char *c_error_string = NULL
+  cdef grpc_call_error c_call_error
+  grpc_metadata_array_init(&c_received_initial_metadata)
+  grpc_metadata_array_init(&c_trailing_metadata)
+  try:
+    with state.condition:
+      if not state.open:
+        raise ValueError('Cannot invoke RPC: %s' % state.closed_reason)
+      c_completion_queue = grpc_completion_queue_create_for_next(NULL)
+      _create_c_call(
+          state, call_state, c_completion_queue, flags, method, host, deadline,
+          credentials, context)
+      _store_c_metadata(
+          metadata, &c_initial_metadata, &c_initial_metadata_count)
+      request_slice = grpc_slice_from_copied_buffer(request, len(request))
+      c_request = grpc_raw_byte_buffer_create(&request_slice, 1)
+      grpc_slice_unref(request_slice)
+      string.memset(c_ops, 0, sizeof(c_ops))
+      c_ops[0].type = GRPC_OP_SEND_INITIAL_METADATA
+      c_ops[0].flags = initial_metadata_flags
+      c_ops[0].data.send_initial_metadata.metadata = c_initial_metadata
+      c_ops[0].data.send_initial_metadata.count = c_initial_metadata_count
+      c_ops[1].type = GRPC_OP_SEND_MESSAGE
+      c_ops[1].data.send_message.send_message = c_request
+      c_ops[2].type = GRPC_OP_SEND_CLOSE_FROM_CLIENT
+      c_ops[3].type = GRPC_OP_RECV_INITIAL_METADATA
+      c_ops[3].data.receive_initial_metadata.receive_initial_metadata = (
+          &c_received_initial_metadata)
+      c_ops[4].type = GRPC_OP_RECV_MESSAGE
+      c_ops[4].data.receive_message.receive_message = &c_response
+      c_ops[5].type = GRPC_OP_RECV_STATUS_ON_CLIENT
+      c_ops[5].data.receive_status_on_client.trailing_metadata = (
+          &c_trailing_metadata)
+      c_ops[5].data.receive_status_on_client.status = &c_code
+      c_ops[5].data.receive_status_on_client.status_details = &c_details
+      c_ops[5].data.receive_status_on_client.error_string = (
+          <char **>&c_error_string)
+      with nogil:
+        c_call_error = grpc_call_start_batch(
+            call_state.c_call, c_ops, 6, <void *>call_state, NULL)
+      if c_call_error != GRPC_CALL_OK:
+        grpc_call_cancel(call_state.c_call, NULL)
+        _raise_call_error(c_call_error, metadata)
+      # So that closing the channel cancels the RPC and waits for it.
+      state.segregated_call_states.add(call_state)
+    try:
+      _next(c_completion_queue, None)
+    # NOTE: As in _next_call_event, a signal handler may raise here. The RPC
+    # is then cancelled and its batch awaited before its memory is released.
+    except:
+      with nogil:
+        grpc_call_cancel(call_state.c_call, NULL)
+        grpc_completion_queue_next(
+            c_completion_queue, gpr_inf_future(GPR_CLOCK_REALTIME), NULL)
+      raise
+    return (
+        _metadata(&c_received_initial_metadata),
+        _message_from_byte_buffer(c_response),
+        c_code,
+        _decode(_slice_bytes(c_details)),
+        _metadata(&c_trailing_metadata),
+        "" if c_error_string == NULL else _decode(c_error_string),
+    )
+  finally:
+    _release_c_metadata(c_initial_metadata, c_initial_metadata_count)
+    if c_request != NULL:
+      grpc_byte_buffer_destroy(c_request)
+    grpc_metadata_array_destroy(&c_received_initial_metadata)
+    grpc_metadata_array_destroy(&c_trailing_metadata)
+    if c_response != NULL:
+      grpc_byte_buffer_destroy(c_response)
+    grpc_slice_unref(c_details)
+    if c_error_string != NULL:
+      gpr_free(<void *>c_error_string)
+    with state.condition:
+      state.segregated_call_states.discard(call_state)
+      if call_state.c_call != NULL:
+        grpc_call_unref(call_state.c_call)
+        call_state.c_call = NULL
+      state.condition.notify_all()
+    if c_completion_queue != NULL:
+      _destroy_c_completion_queue(c_completion_queue)
+
+
 cdef object _watch_connectivity_state(
     _ChannelState state, grpc_connectivity_state last_observed_state,
     object deadline):
@@ -503,6 +630,14 @@ cdef class Channel:
         self._state, flags, method, host, deadline, metadata, credentials,
         operationses_and_tags, context)
 
+  def unary_unary_call(
+      self, int flags, method, host, object deadline, object metadata,
+      int initial_metadata_flags, bytes request, CallCredentials credentials,
+      object context = None):
+    return _unary_unary_call(
+        self._state, flags, method, host, deadline, metadata,
+        initial_metadata_flags, request, credentials, context)
+
   def check_connectivity_state(self, bint try_to_connect):
     with self._state.condition:
       if self._state.open:
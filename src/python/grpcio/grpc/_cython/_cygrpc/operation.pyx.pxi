@@ -139,6 +139,30 @@ cdef class ReceiveInitialMetadataOperation(Operation):
     return self._initial_metadata
 
 
+cdef object _message_from_byte_buffer(
+    grpc_byte_buffer *c_message_byte_buffer):
+  """Returns the bytes of a received message, or None if there was none."""
+  cdef grpc_byte_buffer_reader message_reader
+  cdef bint message_reader_status
+  cdef grpc_slice message_slice
+  cdef size_t message_slice_length
+  cdef void *message_slice_pointer
+  if c_message_byte_buffer == NULL:
+    return None
+  message_reader_status = grpc_byte_buffer_reader_init(
+      &message_reader, c_message_byte_buffer)
+  if not message_reader_status:
+    return None
+  message = bytearray()
+  while grpc_byte_buffer_reader_next(&message_reader, &message_slice):
+    message_slice_pointer = grpc_slice_start_ptr(message_slice)
+    message_slice_length = grpc_slice_length(message_slice)
+    message += (<char *>message_slice_pointer)[:message_slice_length]
+    grpc_slice_unref(message_slice)
+  grpc_byte_buffer_reader_destroy(&message_reader)
+  return bytes(message)
+
+
 cdef class ReceiveMessageOperation(Operation):
 
   def __cinit__(self, flags):
@@ -154,28 +178,9 @@ cdef class ReceiveMessageOperation(Operation):
         &self._c_message_byte_buffer)
 
   cdef void un_c(self) except *:
-    cdef grpc_byte_buffer_reader message_reader
-    cdef bint message_reader_status
-    cdef grpc_slice message_slice
-    cdef size_t message_slice_length
-    cdef void *message_slice_pointer
+    self._message = _message_from_byte_buffer(self._c_message_byte_buffer)
     if self._c_message_byte_buffer != NULL:
-      message_reader_status = grpc_byte_buffer_reader_init(
-          &message_reader, self._c_message_byte_buffer)
-      if message_reader_status:
-        message = bytearray()
-        while grpc_byte_buffer_reader_next(&message_reader, &message_slice):
-          message_slice_pointer = grpc_slice_start_ptr(message_slice)
-          message_slice_length = grpc_slice_length(message_slice)
-          message += (<char *>message_slice_pointer)[:message_slice_length]
-          grpc_slice_unref(message_slice)
-        grpc_byte_buffer_reader_destroy(&message_reader)
-        self._message = bytes(message)
-      else:
-        self._message = None
       grpc_byte_buffer_destroy(self._c_message_byte_buffer)
-    else:
-      self._message = None
 
   def message(self):
     return self._message
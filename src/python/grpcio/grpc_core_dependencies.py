@@ -33,6 +33,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/gpr/log_posix.cc',
     'src/core/lib/gpr/log_windows.cc',
     'src/core/lib/gpr/mpscq.cc',
+    'src/core/lib/gpr/mu_contention.cc',
     'src/core/lib/gpr/murmur_hash.cc',
     'src/core/lib/gpr/string.cc',
     'src/core/lib/gpr/string_posix.cc',
@@ -50,6 +51,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/gpr/tmpfile_posix.cc',
     'src/core/lib/gpr/tmpfile_windows.cc',
     'src/core/lib/gpr/wrap_memcpy.cc',
+    'src/core/lib/gpr/wyhash.cc',
     'src/core/lib/gprpp/arena.cc',
     'src/core/lib/gprpp/fork.cc',
     'src/core/lib/gprpp/global_config_env.cc',
@@ -60,7 +62,9 @@ CORE_SOURCE_FILES = [
     'src/core/lib/profiling/stap_timers.cc',
     'src/core/lib/surface/init.cc',
     'src/core/lib/avl/avl.cc',
+    'src/core/lib/avl/flat_map.cc',
     'src/core/lib/backoff/backoff.cc',
+    'src/core/lib/channel/call_latency_breakdown.cc',
     'src/core/lib/channel/channel_args.cc',
     'src/core/lib/channel/channel_stack.cc',
     'src/core/lib/channel/channel_stack_builder.cc',
@@ -71,6 +75,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/channel/handshaker.cc',
     'src/core/lib/channel/handshaker_registry.cc',
     'src/core/lib/channel/status_util.cc',
+    'src/core/lib/channel/unary_batch.cc',
     'src/core/lib/compression/compression.cc',
     'src/core/lib/compression/compression_args.cc',
     'src/core/lib/compression/compression_internal.cc',
@@ -92,12 +97,14 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/endpoint_pair_posix.cc',
     'src/core/lib/iomgr/endpoint_pair_uv.cc',
     'src/core/lib/iomgr/endpoint_pair_windows.cc',
+    'src/core/lib/iomgr/endpoint_shm_posix.cc',
     'src/core/lib/iomgr/error.cc',
     'src/core/lib/iomgr/error_cfstream.cc',
     'src/core/lib/iomgr/ev_epoll1_linux.cc',
     'src/core/lib/iomgr/ev_epollex_linux.cc',
     'src/core/lib/iomgr/ev_poll_posix.cc',
     'src/core/lib/iomgr/ev_posix.cc',
+    'src/core/lib/iomgr/ev_uring_linux.cc',
     'src/core/lib/iomgr/ev_windows.cc',
     'src/core/lib/iomgr/exec_ctx.cc',
     'src/core/lib/iomgr/executor.cc',
@@ -167,6 +174,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/timer_heap.cc',
     'src/core/lib/iomgr/timer_manager.cc',
     'src/core/lib/iomgr/timer_uv.cc',
+    'src/core/lib/iomgr/timer_wheel.cc',
     'src/core/lib/iomgr/udp_server.cc',
     'src/core/lib/iomgr/unix_sockets_posix.cc',
     'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -329,6 +337,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/client_channel_factory.cc',
     'src/core/ext/filters/client_channel/client_channel_plugin.cc',
     'src/core/ext/filters/client_channel/connector.cc',
+    'src/core/ext/filters/client_channel/direct_channel.cc',
     'src/core/ext/filters/client_channel/global_subchannel_pool.cc',
     'src/core/ext/filters/client_channel/health/health_check_client.cc',
     'src/core/ext/filters/client_channel/http_connect_handshaker.cc',
@@ -406,6 +415,10 @@ CORE_SOURCE_FILES = [
     'src/core/ext/upb-generated/validate/validate.upb.c',
     'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
     'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+    'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+    'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
+    'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
     'src/core/ext/filters/client_channel/resolver/dns/c_ares/dns_resolver_ares.cc',
     'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver.cc',
     'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver_libuv.cc',
@@ -422,9 +435,12 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/resolver/xds/xds_resolver.cc',
     'src/core/ext/filters/census/grpc_context.cc',
     'src/core/ext/filters/client_idle/client_idle_filter.cc',
+    'src/core/ext/filters/concurrency_limit/concurrency_limit_filter.cc',
     'src/core/ext/filters/max_age/max_age_filter.cc',
     'src/core/ext/filters/message_size/message_size_filter.cc',
     'src/core/ext/filters/http/client_authority_filter.cc',
+    'src/core/ext/filters/unary_coalescing/unary_coalescing_filter.cc',
+    'src/core/ext/filters/response_cache/response_cache_filter.cc',
     'src/core/ext/filters/workarounds/workaround_cronet_compression_filter.cc',
     'src/core/ext/filters/workarounds/workaround_utils.cc',
     'src/core/plugin_registry/grpc_plugin_registry.cc',
@@ -0,0 +1,199 @@
+# Copyright 2019 gRPC authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests the blocking unary-unary path, which runs as one native call."""
+
+import logging
+import threading
+import unittest
+
+import grpc
+
+from tests.unit import test_common
+from tests.unit.framework.common import test_constants
+
+_REQUEST = b'\x00\x01\x02'
+
+_ECHO = '/test/Echo'
+_FAIL = '/test/Fail'
+_BLOCK = '/test/Block'
+
+_INITIAL_METADATA = (('initial-md-key', 'initial-md-value'),
+                     ('initial-md-key-bin', b'\x00\x01'))
+_TRAILING_METADATA = (('trailing-md-key', 'trailing-md-value'),
+                      ('trailing-md-key-bin', b'\x02\x03'))
+_CLIENT_METADATA = (('client-md-key', 'client-md-value'),)
+
+_DETAILS = 'test details'
+
+
+def _metadata_contains(metadata, expected):
+    return set(expected).issubset(set(metadata))
+
+
+class _Servicer(object):
+
+    def __init__(self):
+        self.invocation_metadata = None
+        self.started = threading.Event()
+        self.release = threading.Event()
+
+    def echo(self, request, servicer_context):
+        self.invocation_metadata = servicer_context.invocation_metadata()
+        servicer_context.send_initial_metadata(_INITIAL_METADATA)
+        servicer_context.set_trailing_metadata(_TRAILING_METADATA)
+        return request
+
+    def fail(self, request, servicer_context):
+        servicer_context.send_initial_metadata(_INITIAL_METADATA)
+        servicer_context.set_trailing_metadata(_TRAILING_METADATA)
+        servicer_context.set_code(grpc.StatusCode.INVALID_ARGUMENT)
+        servicer_context.set_details(_DETAILS)
+        return None
+
+    def block(self, request, servicer_context):
+        self.started.set()
+        self.release.wait(test_constants.LONG_TIMEOUT)
+        return request
+
+
+class _GenericHandler(grpc.GenericRpcHandler):
+
+    def __init__(self, servicer):
+        self._handlers = {
+            _ECHO: grpc.unary_unary_rpc_method_handler(servicer.echo),
+            _FAIL: grpc.unary_unary_rpc_method_handler(servicer.fail),
+            _BLOCK: grpc.unary_unary_rpc_method_handler(servicer.block),
+        }
+
+    def service(self, handler_call_details):
+        return self._handlers.get(handler_call_details.method)
+
+
+class BlockingUnaryUnaryTest(unittest.TestCase):
+
+    def setUp(self):
+        self._servicer = _Servicer()
+        self._server = test_common.test_server()
+        self._server.add_generic_rpc_handlers(
+            (_GenericHandler(self._servicer),))
+        port = self._server.add_insecure_port('[::]:0')
+        self._server.start()
+        self._channel = grpc.insecure_channel('localhost:%d' % port)
+
+    def tearDown(self):
+        self._servicer.release.set()
+        self._server.stop(None)
+        self._channel.close()
+
+    def testResponse(self):
+        response = self._channel.unary_unary(_ECHO)(_REQUEST)
+        self.assertEqual(_REQUEST, response)
+
+    def testMetadata(self):
+        response, call = self._channel.unary_unary(_ECHO).with_call(
+            _REQUEST, metadata=_CLIENT_METADATA)
+        self.assertEqual(_REQUEST, response)
+        self.assertTrue(
+            _metadata_contains(self._servicer.invocation_metadata,
+                               _CLIENT_METADATA))
+        self.assertTrue(
+            _metadata_contains(call.initial_metadata(), _INITIAL_METADATA))
+        self.assertTrue(
+            _metadata_contains(call.trailing_metadata(), _TRAILING_METADATA))
+        self.assertIs(grpc.StatusCode.OK, call.code())
+        self.assertEqual('', call.details())
+
+    def testStatusAndDetails(self):
+        with self.assertRaises(grpc.RpcError) as exception_context:
+            self._channel.unary_unary(_FAIL)(_REQUEST)
+        rpc_error = exception_context.exception
+        self.assertIs(grpc.StatusCode.INVALID_ARGUMENT, rpc_error.code())
+        self.assertEqual(_DETAILS, rpc_error.details())
+        self.assertTrue(
+            _metadata_contains(rpc_error.initial_metadata(),
+                               _INITIAL_METADATA))
+        self.assertTrue(
+            _metadata_contains(rpc_error.trailing_metadata(),
+                               _TRAILING_METADATA))
+        self.assertIsNotNone(rpc_error.debug_error_string())
+
+    def testUnimplementedMethod(self):
+        with self.assertRaises(grpc.RpcError) as exception_context:
+            self._channel.unary_unary('/test/Unimplemented')(_REQUEST)
+        self.assertIs(grpc.StatusCode.UNIMPLEMENTED,
+                      exception_context.exception.code())
+
+    def testDeadlineExceeded(self):
+        with self.assertRaises(grpc.RpcError) as exception_context:
+            self._channel.unary_unary(_BLOCK)(
+                _REQUEST, timeout=test_constants.SHORT_TIMEOUT)
+        self.assertIs(grpc.StatusCode.DEADLINE_EXCEEDED,
+                      exception_context.exception.code())
+
+    def testResponseDeserializationFailure(self):
+
+        def deserializer(unused_serialized_response):
+            raise ValueError('deserialization failure')
+
+        multi_callable = self._channel.unary_unary(
+            _ECHO, response_deserializer=deserializer)
+        with self.assertRaises(grpc.RpcError) as exception_context:
+            multi_callable(_REQUEST)
+        rpc_error = exception_context.exception
+        self.assertIs(grpc.StatusCode.INTERNAL, rpc_error.code())
+        self.assertEqual('Exception deserializing response!',
+                         rpc_error.details())
+
+    def testRequestSerializationFailure(self):
+
+        def serializer(unused_request):
+            raise ValueError('serialization failure')
+
+        multi_callable = self._channel.unary_unary(
+            _ECHO, request_serializer=serializer)
+        with self.assertRaises(grpc.RpcError) as exception_context:
+            multi_callable(object())
+        self.assertIs(grpc.StatusCode.INTERNAL,
+                      exception_context.exception.code())
+
+    def testCallOnClosedChannel(self):
+        multi_callable = self._channel.unary_unary(_ECHO)
+        self._channel.close()
+        with self.assertRaises(ValueError):
+            multi_callable(_REQUEST)
+
+    def testChannelClosedDuringCall(self):
+        multi_callable = self._channel.unary_unary(_BLOCK)
+        errors = []
+
+        def invoke():
+            try:
+                multi_callable(_REQUEST)
+            except grpc.RpcError as rpc_error:
+                errors.append(rpc_error)
+
+        thread = threading.Thread(target=invoke)
+        thread.start()
+        self.assertTrue(
+            self._servicer.started.wait(test_constants.LONG_TIMEOUT))
+        # Closing the channel cancels the blocked call and waits for it.
+        self._channel.close()
+        thread.join()
+        self.assertEqual(1, len(errors))
+        self.assertIs(grpc.StatusCode.CANCELLED, errors[0].code())
+
+
+if __name__ == '__main__':
+    logging.basicConfig()
+    unittest.main(verbosity=2)
@@ -121,6 +121,30 @@ static const rb_data_type_t grpc_rb_md_ary_data_type = {
 #endif
 };
 
+/* Destroys received metadata that was never materialized as a hash. */
+static void grpc_rb_received_md_destroy(void* p) {
+  if (p == NULL) {
+    return;
+  }
+  grpc_rb_metadata_array_destroy_including_entries((grpc_metadata_array*)p);
+  xfree(p);
+}
+
+/* Describes received metadata held until it is first accessed; see
+   grpc_rb_received_md_wrap. */
+static const rb_data_type_t grpc_rb_received_md_data_type = {
+    "grpc_received_metadata",
+    {GRPC_RB_GC_NOT_MARKED,
+     grpc_rb_received_md_destroy,
+     GRPC_RB_MEMSIZE_UNAVAILABLE,
+     {NULL, NULL}},
+    NULL,
+    NULL,
+#ifdef RUBY_TYPED_FREE_IMMEDIATELY
+    RUBY_TYPED_FREE_IMMEDIATELY
+#endif
+};
+
 /* Describes grpc_call struct for RTypedData */
 static const rb_data_type_t grpc_call_data_type = {"grpc_call",
                                                    {GRPC_RB_GC_NOT_MARKED,
@@ -288,27 +312,87 @@ static VALUE grpc_rb_call_set_status(VALUE self, VALUE status) {
   return rb_ivar_set(self, id_status, status);
 }
 
+/* Takes the entries of a received metadata array, leaving it empty, and
+   returns an object that holds them until they are first accessed. Turning
+   metadata into a hash allocates a ruby string per key and value, which is
+   wasted on the many calls whose metadata is never looked at.
+
+   The entries are the call's slices, so they are ref'd to outlive it. */
+static VALUE grpc_rb_received_md_wrap(grpc_metadata_array* md_ary) {
+  grpc_metadata_array* held = ALLOC(grpc_metadata_array);
+  size_t i;
+  *held = *md_ary;
+  for (i = 0; i < held->count; i++) {
+    grpc_slice_ref(held->metadata[i].key);
+    grpc_slice_ref(held->metadata[i].value);
+  }
+  grpc_metadata_array_init(md_ary);
+  return TypedData_Wrap_Struct(grpc_rb_cMdAry, &grpc_rb_received_md_data_type,
+                               held);
+}
+
+/* Returns md as a hash if it is metadata held by grpc_rb_received_md_wrap,
+   and md unchanged otherwise. */
+static VALUE grpc_rb_received_md_to_h(VALUE md) {
+  grpc_metadata_array* held = NULL;
+  if (!rb_typeddata_is_kind_of(md, &grpc_rb_received_md_data_type)) {
+    return md;
+  }
+  TypedData_Get_Struct(md, grpc_metadata_array, &grpc_rb_received_md_data_type,
+                       held);
+  return grpc_rb_md_ary_to_h(held);
+}
+
+/* Gets the metadata member of a BatchResult or Status struct, turning held
+   metadata into a hash the first time. */
+static VALUE grpc_rb_struct_get_metadata(VALUE self) {
+  VALUE md = rb_struct_aref(self, sym_metadata);
+  VALUE md_hash = grpc_rb_received_md_to_h(md);
+  if (md_hash != md) {
+    rb_struct_aset(self, sym_metadata, md_hash);
+  }
+  return md_hash;
+}
+
+/* Gets the ivar id of a call, turning held metadata into a hash the first
+   time. */
+static VALUE grpc_rb_call_get_md_ivar(VALUE self, ID id) {
+  VALUE md = rb_ivar_get(self, id);
+  VALUE md_hash = grpc_rb_received_md_to_h(md);
+  if (md_hash != md) {
+    rb_ivar_set(self, id, md_hash);
+  }
+  return md_hash;
+}
+
+/* Checks that metadata being saved on a call is nil, a hash, or metadata
+   held from a batch result. */
+static void grpc_rb_call_check_md(VALUE metadata) {
+  if (!NIL_P(metadata) && TYPE(metadata) != T_HASH &&
+      !rb_typeddata_is_kind_of(metadata, &grpc_rb_received_md_data_type)) {
+    rb_raise(rb_eTypeError, "bad metadata: got:<%s> want: <Hash>",
+             rb_obj_classname(metadata));
+  }
+}
+
 /*
   call-seq:
   metadata = call.metadata
 
   Gets the metadata object saved the call.  */
 static VALUE grpc_rb_call_get_metadata(VALUE self) {
-  return rb_ivar_get(self, id_metadata);
+  return grpc_rb_call_get_md_ivar(self, id_metadata);
 }
 
 /*
   call-seq:
   call.metadata = metadata
 
-  Saves the metadata hash on the call.  */
+  Saves the metadata hash on the call. The metadata member of a batch
+  result, read with batch_result[:metadata], may be saved as well and is
+  only turned into a hash once call.metadata is read. */
 static VALUE grpc_rb_call_set_metadata(VALUE self, VALUE metadata) {
-  if (!NIL_P(metadata) && TYPE(metadata) != T_HASH) {
-    rb_raise(rb_eTypeError, "bad metadata: got:<%s> want: <Hash>",
-             rb_obj_classname(metadata));
-    return Qnil;
-  }
-
+  grpc_rb_call_check_md(metadata);
   return rb_ivar_set(self, id_metadata, metadata);
 }
 
@@ -318,21 +402,17 @@ static VALUE grpc_rb_call_set_metadata(VALUE self, VALUE metadata) {
 
   Gets the trailing metadata object saved on the call */
 static VALUE grpc_rb_call_get_trailing_metadata(VALUE self) {
-  return rb_ivar_get(self, id_trailing_metadata);
+  return grpc_rb_call_get_md_ivar(self, id_trailing_metadata);
 }
 
 /*
   call-seq:
   call.trailing_metadata = trailing_metadata
 
-  Saves the trailing metadata hash on the call. */
+  Saves the trailing metadata hash on the call. As with call.metadata=, held
+  metadata from a status, read with status[:metadata], may be saved too. */
 static VALUE grpc_rb_call_set_trailing_metadata(VALUE self, VALUE metadata) {
-  if (!NIL_P(metadata) && TYPE(metadata) != T_HASH) {
-    rb_raise(rb_eTypeError, "bad metadata: got:<%s> want: <Hash>",
-             rb_obj_classname(metadata));
-    return Qnil;
-  }
-
+  grpc_rb_call_check_md(metadata);
   return rb_ivar_set(self, id_trailing_metadata, metadata);
 }
 
@@ -767,7 +847,8 @@ static VALUE grpc_run_batch_stack_build_result(run_batch_stack* st) {
         break;
       case GRPC_OP_RECV_INITIAL_METADATA:
         rb_struct_aset(result, sym_metadata,
-                       grpc_rb_md_ary_to_h(&st->recv_metadata));
+                       grpc_rb_received_md_wrap(&st->recv_metadata));
+        break;
       case GRPC_OP_RECV_MESSAGE:
         rb_struct_aset(result, sym_message,
                        grpc_rb_byte_buffer_to_s(st->recv_message));
@@ -780,7 +861,7 @@ static VALUE grpc_run_batch_stack_build_result(run_batch_stack* st) {
                 (GRPC_SLICE_START_PTR(st->recv_status_details) == NULL
                      ? Qnil
                      : grpc_rb_slice_to_ruby_string(st->recv_status_details)),
-                grpc_rb_md_ary_to_h(&st->recv_trailing_metadata), NULL));
+                grpc_rb_received_md_wrap(&st->recv_trailing_metadata), NULL));
         break;
       case GRPC_OP_RECV_CLOSE_ON_SERVER:
         rb_struct_aset(result, sym_send_close, Qtrue);
@@ -1016,6 +1097,12 @@ void Init_grpc_call() {
       "BatchResult", "send_message", "send_metadata", "send_close",
       "send_status", "message", "metadata", "status", "cancelled", NULL);
 
+  /* Received metadata is held in these structs until it is first read. */
+  rb_define_method(grpc_rb_sBatchResult, "metadata",
+                   grpc_rb_struct_get_metadata, 0);
+  rb_define_method(grpc_rb_sStatus, "metadata", grpc_rb_struct_get_metadata,
+                   0);
+
   Init_grpc_error_codes();
   Init_grpc_op_codes();
   Init_grpc_write_flags();
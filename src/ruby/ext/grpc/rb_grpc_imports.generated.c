@@ -242,6 +242,8 @@ gpr_malloc_aligned_type gpr_malloc_aligned_import;
 gpr_free_aligned_type gpr_free_aligned_import;
 gpr_set_allocation_functions_type gpr_set_allocation_functions_import;
 gpr_get_allocation_functions_type gpr_get_allocation_functions_import;
+gpr_set_subsystem_allocation_functions_type gpr_set_subsystem_allocation_functions_import;
+gpr_subsystem_allocated_bytes_type gpr_subsystem_allocated_bytes_import;
 gpr_cpu_num_cores_type gpr_cpu_num_cores_import;
 gpr_cpu_current_cpu_type gpr_cpu_current_cpu_import;
 gpr_format_message_type gpr_format_message_import;
@@ -515,6 +517,8 @@ void grpc_rb_load_imports(HMODULE library) {
   gpr_free_aligned_import = (gpr_free_aligned_type) GetProcAddress(library, "gpr_free_aligned");
   gpr_set_allocation_functions_import = (gpr_set_allocation_functions_type) GetProcAddress(library, "gpr_set_allocation_functions");
   gpr_get_allocation_functions_import = (gpr_get_allocation_functions_type) GetProcAddress(library, "gpr_get_allocation_functions");
+  gpr_set_subsystem_allocation_functions_import = (gpr_set_subsystem_allocation_functions_type) GetProcAddress(library, "gpr_set_subsystem_allocation_functions");
+  gpr_subsystem_allocated_bytes_import = (gpr_subsystem_allocated_bytes_type) GetProcAddress(library, "gpr_subsystem_allocated_bytes");
   gpr_cpu_num_cores_import = (gpr_cpu_num_cores_type) GetProcAddress(library, "gpr_cpu_num_cores");
   gpr_cpu_current_cpu_import = (gpr_cpu_current_cpu_type) GetProcAddress(library, "gpr_cpu_current_cpu");
   gpr_format_message_import = (gpr_format_message_type) GetProcAddress(library, "gpr_format_message");
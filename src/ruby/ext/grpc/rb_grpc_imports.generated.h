@@ -701,6 +701,12 @@ extern gpr_set_allocation_functions_type gpr_set_allocation_functions_import;
 typedef gpr_allocation_functions(*gpr_get_allocation_functions_type)(void);
 extern gpr_get_allocation_functions_type gpr_get_allocation_functions_import;
 #define gpr_get_allocation_functions gpr_get_allocation_functions_import
+typedef void(*gpr_set_subsystem_allocation_functions_type)(gpr_alloc_subsystem subsystem, gpr_subsystem_allocation_functions functions);
+extern gpr_set_subsystem_allocation_functions_type gpr_set_subsystem_allocation_functions_import;
+#define gpr_set_subsystem_allocation_functions gpr_set_subsystem_allocation_functions_import
+typedef size_t(*gpr_subsystem_allocated_bytes_type)(gpr_alloc_subsystem subsystem);
+extern gpr_subsystem_allocated_bytes_type gpr_subsystem_allocated_bytes_import;
+#define gpr_subsystem_allocated_bytes gpr_subsystem_allocated_bytes_import
 typedef unsigned(*gpr_cpu_num_cores_type)(void);
 extern gpr_cpu_num_cores_type gpr_cpu_num_cores_import;
 #define gpr_cpu_num_cores gpr_cpu_num_cores_import
@@ -172,7 +172,8 @@ module GRPC
 
     def attach_status_results_and_complete_call(recv_status_batch_result)
       unless recv_status_batch_result.status.nil?
-        @call.trailing_metadata = recv_status_batch_result.status.metadata
+        # Saving the held metadata defers building its hash until it is read.
+        @call.trailing_metadata = recv_status_batch_result.status[:metadata]
       end
       @call.status = recv_status_batch_result.status
 
@@ -373,7 +374,7 @@ module GRPC
         set_output_stream_done
       end
 
-      @call.metadata = batch_result.metadata
+      @call.metadata = batch_result[:metadata]
       attach_status_results_and_complete_call(batch_result)
       get_message_from_batch_result(batch_result)
     end
@@ -536,6 +536,44 @@ shared_examples 'GRPC metadata delivery works OK' do
         expect(final_client_batch.status.code).to eq(0)
       end
     end
+
+    it 'saves received metadata on the call until it is read' do
+      md = @valid_metadata.first
+      recvd_rpc = nil
+      rcv_thread = Thread.new do
+        recvd_rpc = @server.request_call
+      end
+
+      call = new_client_call
+      client_ops = {
+        CallOps::SEND_INITIAL_METADATA => nil,
+        CallOps::SEND_CLOSE_FROM_CLIENT => nil
+      }
+      call.run_batch(client_ops)
+
+      rcv_thread.join
+      server_call = recvd_rpc.call
+      server_ops = {
+        CallOps::RECV_CLOSE_ON_SERVER => nil,
+        CallOps::SEND_INITIAL_METADATA => md,
+        CallOps::SEND_STATUS_FROM_SERVER => ok_status
+      }
+      server_call.run_batch(server_ops)
+
+      client_ops = {
+        CallOps::RECV_INITIAL_METADATA => nil,
+        CallOps::RECV_STATUS_ON_CLIENT => nil
+      }
+      final_client_batch = call.run_batch(client_ops)
+      call.metadata = final_client_batch[:metadata]
+      call.trailing_metadata = final_client_batch.status[:metadata]
+      # The held metadata outlives the call it was received on.
+      call.close
+      replace_symbols = Hash[md.each_pair.collect { |x, y| [x.to_s, y] }]
+      expect(call.metadata).to eq(replace_symbols)
+      expect(call.metadata).to be(call.metadata)
+      expect(call.trailing_metadata).to eq({})
+    end
   end
 end
 
@@ -0,0 +1,172 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/avl/flat_map.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "test/core/util/test_config.h"
+
+static int* box(int x) {
+  int* b = static_cast<int*>(gpr_malloc(sizeof(*b)));
+  *b = x;
+  return b;
+}
+
+static long int_compare(void* int1, void* int2, void* unused) {
+  return (*static_cast<int*>(int1)) - (*static_cast<int*>(int2));
+}
+static void* int_copy(void* p, void* unused) {
+  return box(*static_cast<int*>(p));
+}
+
+static void destroy(void* p, void* unused) { gpr_free(p); }
+
+static const grpc_avl_vtable int_int_vtable = {destroy, int_copy, int_compare,
+                                               destroy, int_copy};
+
+static void check_get(grpc_flat_map map, int key, int value) {
+  int* k = box(key);
+  GPR_ASSERT(*(int*)grpc_flat_map_get(map, k, nullptr) == value);
+  gpr_free(k);
+}
+
+static void check_negget(grpc_flat_map map, int key) {
+  int* k = box(key);
+  GPR_ASSERT(grpc_flat_map_get(map, k, nullptr) == nullptr);
+  gpr_free(k);
+}
+
+static grpc_flat_map remove_int(grpc_flat_map map, int key) {
+  int* k = box(key);
+  map = grpc_flat_map_remove(map, k, nullptr);
+  gpr_free(k);
+  return map;
+}
+
+static void test_get(void) {
+  grpc_flat_map map;
+  gpr_log(GPR_DEBUG, "test_get");
+  map = grpc_flat_map_create(&int_int_vtable);
+  GPR_ASSERT(grpc_flat_map_is_empty(map));
+  map = grpc_flat_map_add(map, box(1), box(11), nullptr);
+  map = grpc_flat_map_add(map, box(3), box(33), nullptr);
+  map = grpc_flat_map_add(map, box(2), box(22), nullptr);
+  GPR_ASSERT(!grpc_flat_map_is_empty(map));
+  check_get(map, 1, 11);
+  check_get(map, 2, 22);
+  check_get(map, 3, 33);
+  check_negget(map, 0);
+  check_negget(map, 4);
+  grpc_flat_map_unref(map, nullptr);
+}
+
+static void test_replace(void) {
+  grpc_flat_map map;
+  gpr_log(GPR_DEBUG, "test_replace");
+  map = grpc_flat_map_create(&int_int_vtable);
+  map = grpc_flat_map_add(map, box(1), box(1), nullptr);
+  map = grpc_flat_map_add(map, box(1), box(2), nullptr);
+  check_get(map, 1, 2);
+  GPR_ASSERT(map.data->count == 1);
+  grpc_flat_map_unref(map, nullptr);
+}
+
+static void test_remove(void) {
+  grpc_flat_map map;
+  gpr_log(GPR_DEBUG, "test_remove");
+  map = grpc_flat_map_create(&int_int_vtable);
+  map = grpc_flat_map_add(map, box(3), box(1), nullptr);
+  map = grpc_flat_map_add(map, box(4), box(2), nullptr);
+  map = grpc_flat_map_add(map, box(5), box(3), nullptr);
+  grpc_flat_map_data* data = map.data;
+  // Removing a missing key gives back the same map.
+  map = remove_int(map, 1);
+  GPR_ASSERT(map.data == data);
+  map = remove_int(map, 4);
+  check_get(map, 3, 1);
+  check_negget(map, 4);
+  check_get(map, 5, 3);
+  map = remove_int(map, 3);
+  map = remove_int(map, 5);
+  GPR_ASSERT(grpc_flat_map_is_empty(map));
+  grpc_flat_map_unref(map, nullptr);
+}
+
+static void test_snapshots(void) {
+  grpc_flat_map map1;
+  grpc_flat_map map2;
+  gpr_log(GPR_DEBUG, "test_snapshots");
+  map1 = grpc_flat_map_create(&int_int_vtable);
+  map1 = grpc_flat_map_add(map1, box(1), box(11), nullptr);
+  // Changes to a new reference leave the old one as it was.
+  map2 = grpc_flat_map_add(grpc_flat_map_ref(map1, nullptr), box(2), box(22),
+                           nullptr);
+  map2 = remove_int(map2, 1);
+  check_get(map1, 1, 11);
+  check_negget(map1, 2);
+  check_negget(map2, 1);
+  check_get(map2, 2, 22);
+  grpc_flat_map_unref(map1, nullptr);
+  grpc_flat_map_unref(map2, nullptr);
+}
+
+static void test_stress(int amount_of_stress) {
+  int added[1024];
+  int i, j;
+  grpc_flat_map map;
+  gpr_log(GPR_DEBUG, "test_stress amount=%d", amount_of_stress);
+  map = grpc_flat_map_create(&int_int_vtable);
+  memset(added, 0, sizeof(added));
+  for (i = 1; i <= amount_of_stress; i++) {
+    int idx = rand() % static_cast<int> GPR_ARRAY_SIZE(added);
+    if (rand() < RAND_MAX / 2) {
+      added[idx] = i;
+      map = grpc_flat_map_add(map, box(idx), box(i), nullptr);
+    } else {
+      added[idx] = 0;
+      map = remove_int(map, idx);
+    }
+    for (j = 0; j < static_cast<int> GPR_ARRAY_SIZE(added); j++) {
+      if (added[j] != 0) {
+        check_get(map, j, added[j]);
+      } else {
+        check_negget(map, j);
+      }
+    }
+  }
+  grpc_flat_map_unref(map, nullptr);
+}
+
+int main(int argc, char* argv[]) {
+  grpc::testing::TestEnvironment env(argc, argv);
+
+  test_get();
+  test_replace();
+  test_remove();
+  test_snapshots();
+  test_stress(1000);
+
+  return 0;
+}
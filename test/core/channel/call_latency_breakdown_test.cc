@@ -0,0 +1,123 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "src/core/lib/channel/call_latency_breakdown.h"
+
+#include <gtest/gtest.h>
+
+#include <grpc/support/time.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+int g_exported;
+bool g_last_exported_is_client;
+
+void CountExport(const CallLatencyBreakdown& breakdown) {
+  ++g_exported;
+  g_last_exported_is_client = breakdown.is_client();
+}
+
+class CallLatencyBreakdownTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    arena_ = Arena::Create(1024);
+    g_exported = 0;
+  }
+
+  void TearDown() override {
+    CallLatencyBreakdown::SetExporter(nullptr);
+    CallLatencyBreakdown::SetSampleInterval(0);
+    arena_->Destroy();
+  }
+
+  Arena* arena_;
+};
+
+TEST_F(CallLatencyBreakdownTest, NotSampledWithoutExporter) {
+  CallLatencyBreakdown::SetSampleInterval(1);
+  EXPECT_EQ(CallLatencyBreakdown::MaybeCreate(arena_, true), nullptr);
+}
+
+TEST_F(CallLatencyBreakdownTest, SamplesOneCallPerInterval) {
+  CallLatencyBreakdown::SetExporter(CountExport);
+  CallLatencyBreakdown::SetSampleInterval(4);
+  int sampled = 0;
+  for (int i = 0; i < 16; ++i) {
+    if (CallLatencyBreakdown::MaybeCreate(arena_, true) != nullptr) ++sampled;
+  }
+  EXPECT_EQ(sampled, 4);
+  CallLatencyBreakdown::SetSampleInterval(0);
+  EXPECT_EQ(CallLatencyBreakdown::MaybeCreate(arena_, true), nullptr);
+}
+
+TEST_F(CallLatencyBreakdownTest, RecordsEachStageOnce) {
+  CallLatencyBreakdown::SetExporter(CountExport);
+  CallLatencyBreakdown::SetSampleInterval(1);
+  CallLatencyBreakdown* breakdown =
+      CallLatencyBreakdown::MaybeCreate(arena_, false);
+  ASSERT_NE(breakdown, nullptr);
+  EXPECT_FALSE(breakdown->Recorded(CallLatencyStage::kCallCreated));
+  EXPECT_LT(breakdown->MicrosBetween(CallLatencyStage::kCallCreated,
+                                     CallLatencyStage::kFinalOpPosted),
+            0);
+  breakdown->Record(CallLatencyStage::kCallCreated);
+  breakdown->Record(CallLatencyStage::kFinalOpPosted);
+  const double micros = breakdown->MicrosBetween(
+      CallLatencyStage::kCallCreated, CallLatencyStage::kFinalOpPosted);
+  EXPECT_GE(micros, 0);
+  // Reaching a stage again keeps its first timestamp.
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  breakdown->Record(CallLatencyStage::kCallCreated);
+  EXPECT_EQ(breakdown->MicrosBetween(CallLatencyStage::kCallCreated,
+                                     CallLatencyStage::kFinalOpPosted),
+            micros);
+  breakdown->Export();
+  EXPECT_EQ(g_exported, 1);
+  EXPECT_FALSE(g_last_exported_is_client);
+}
+
+TEST_F(CallLatencyBreakdownTest, RecordsThroughTheCallContext) {
+  grpc_call_context_element context[GRPC_CONTEXT_COUNT] = {};
+  // Calls that are not sampled have no breakdown to record to.
+  CallLatencyRecord(context, CallLatencyStage::kWriteStarted);
+  CallLatencyRecord(nullptr, CallLatencyStage::kWriteStarted);
+  CallLatencyBreakdown::SetExporter(CountExport);
+  CallLatencyBreakdown::SetSampleInterval(1);
+  CallLatencyBreakdown* breakdown =
+      CallLatencyBreakdown::MaybeCreate(arena_, true);
+  ASSERT_NE(breakdown, nullptr);
+  context[GRPC_CONTEXT_LATENCY_BREAKDOWN].value = breakdown;
+  EXPECT_EQ(CallLatencyBreakdown::FromContext(context), breakdown);
+  CallLatencyRecord(context, CallLatencyStage::kWriteStarted);
+  EXPECT_TRUE(breakdown->Recorded(CallLatencyStage::kWriteStarted));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
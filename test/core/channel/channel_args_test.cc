@@ -81,6 +81,32 @@ static int fake_pointer_cmp(void* a, void* b) { return GPR_ICMP(a, b); }
 static const grpc_arg_pointer_vtable fake_pointer_arg_vtable = {
     fake_pointer_arg_copy, fake_pointer_arg_destroy, fake_pointer_cmp};
 
+static void test_hash(void) {
+  grpc_core::ExecCtx exec_ctx;
+  fake_class* fc = static_cast<fake_class*>(gpr_malloc(sizeof(fake_class)));
+  fc->foo = 42;
+  grpc_arg to_add[] = {
+      grpc_channel_arg_integer_create(const_cast<char*>("int_arg"), 123),
+      grpc_channel_arg_string_create(const_cast<char*>("str key"),
+                                     const_cast<char*>("str value")),
+      grpc_channel_arg_pointer_create(const_cast<char*>("ptr key"), fc,
+                                      &fake_pointer_arg_vtable)};
+  grpc_channel_args* a = grpc_channel_args_copy_and_add(nullptr, to_add, 3);
+  // Equal args, with a different copy of the pointer arg.
+  grpc_channel_args* b = grpc_channel_args_copy(a);
+  GPR_ASSERT(grpc_channel_args_hash(a) == grpc_channel_args_hash(b));
+  GPR_ASSERT(grpc_channel_args_compare(a, a) == 0);
+  // Unequal args.
+  to_add[0].value.integer = 124;
+  grpc_channel_args* c = grpc_channel_args_copy_and_add(nullptr, to_add, 3);
+  GPR_ASSERT(grpc_channel_args_hash(a) != grpc_channel_args_hash(c));
+  GPR_ASSERT(grpc_channel_args_hash(nullptr) == 0);
+  grpc_channel_args_destroy(a);
+  grpc_channel_args_destroy(b);
+  grpc_channel_args_destroy(c);
+  gpr_free(fc);
+}
+
 static void test_channel_create_with_args(void) {
   grpc_arg client_a[3];
 
@@ -144,6 +170,7 @@ int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_create();
+  test_hash();
   test_channel_create_with_args();
   test_server_create_with_args();
   grpc_shutdown();
@@ -146,10 +146,95 @@ static void test_create_channel_stack(void) {
   grpc_slice_unref_internal(path);
 }
 
+static grpc_error* skip_channel_init_func(grpc_channel_element* elem,
+                                          grpc_channel_element_args* args) {
+  return GRPC_ERROR_NONE;
+}
+
+static void counting_call_func(grpc_call_element* elem,
+                               grpc_transport_stream_op_batch* op) {
+  ++*static_cast<int*>(elem->call_data);
+  grpc_call_next_op(elem, op);
+}
+
+static void test_skip_filters(void) {
+  const grpc_channel_filter recv_message_filter = {
+      counting_call_func,
+      grpc_channel_next_op,
+      sizeof(int),
+      call_init_func,
+      grpc_call_stack_ignore_set_pollset_or_pollset_set,
+      call_destroy_func,
+      sizeof(int),
+      skip_channel_init_func,
+      channel_destroy_func,
+      grpc_channel_next_get_info,
+      "recv_message_filter",
+      GRPC_FILTER_BATCH_RECV_MESSAGE};
+  const grpc_channel_filter last_filter = {
+      call_func,
+      channel_func,
+      sizeof(int),
+      call_init_func,
+      grpc_call_stack_ignore_set_pollset_or_pollset_set,
+      call_destroy_func,
+      sizeof(int),
+      skip_channel_init_func,
+      channel_destroy_func,
+      grpc_channel_next_get_info,
+      "last_filter"};
+  const grpc_channel_filter* filters[] = {&recv_message_filter,
+                                          &recv_message_filter, &last_filter};
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice path = grpc_slice_from_static_string("/service/method");
+  grpc_channel_args chan_args = {0, nullptr};
+
+  grpc_channel_stack* channel_stack = static_cast<grpc_channel_stack*>(
+      gpr_malloc(grpc_channel_stack_size(filters, 3)));
+  grpc_channel_stack_init(1, free_channel, channel_stack, filters, 3,
+                          &chan_args, nullptr, "test", channel_stack);
+  grpc_call_stack* call_stack =
+      static_cast<grpc_call_stack*>(gpr_malloc(channel_stack->call_stack_size));
+  const grpc_call_element_args args = {
+      call_stack,                   /* call_stack */
+      nullptr,                      /* server_transport_data */
+      nullptr,                      /* context */
+      path,                         /* path */
+      gpr_now(GPR_CLOCK_MONOTONIC), /* start_time */
+      GRPC_MILLIS_INF_FUTURE,       /* deadline */
+      nullptr,                      /* arena */
+      nullptr,                      /* call_combiner */
+  };
+  grpc_error* error =
+      grpc_call_stack_init(channel_stack, 1, free_call, call_stack, &args);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  int* counts[3];
+  for (size_t i = 0; i < 3; ++i) {
+    counts[i] =
+        static_cast<int*>(grpc_call_stack_element(call_stack, i)->call_data);
+  }
+
+  // The top filter is always called; the second only sees the batch that
+  // receives a message.
+  grpc_transport_stream_op_batch batch;
+  batch.send_trailing_metadata = true;
+  counting_call_func(grpc_call_stack_element(call_stack, 0), &batch);
+  GPR_ASSERT(*counts[0] == 1 && *counts[1] == 0 && *counts[2] == 1);
+  batch.recv_message = true;
+  counting_call_func(grpc_call_stack_element(call_stack, 0), &batch);
+  GPR_ASSERT(*counts[0] == 2 && *counts[1] == 1 && *counts[2] == 2);
+
+  GRPC_CALL_STACK_UNREF(call_stack, "done");
+  grpc_core::ExecCtx::Get()->Flush();
+  GRPC_CHANNEL_STACK_UNREF(channel_stack, "done");
+  grpc_slice_unref_internal(path);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_create_channel_stack();
+  test_skip_filters();
   grpc_shutdown();
   return 0;
 }
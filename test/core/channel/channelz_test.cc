@@ -515,6 +515,91 @@ TEST(ChannelzServerTest, BasicServerAPIFunctionality) {
   ValidateServer(channelz_server, {3, 3, 3});
 }
 
+TEST(ChannelzSocketTest, FlowControlWindows) {
+  grpc_core::ExecCtx exec_ctx;
+  RefCountedPtr<SocketNode> socket = MakeRefCounted<SocketNode>(
+      UniquePtr<char>(), UniquePtr<char>(), UniquePtr<char>(gpr_strdup("s")));
+  grpc_json* json = socket->RenderJson();
+  grpc_json* data = GetJsonChild(json, "data");
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(GetJsonChild(data, "localFlowControlWindow"), nullptr);
+  EXPECT_EQ(GetJsonChild(data, "remoteFlowControlWindow"), nullptr);
+  grpc_json_destroy(json);
+  socket->RecordFlowControlWindows(65535, 16384);
+  json = socket->RenderJson();
+  data = GetJsonChild(json, "data");
+  ASSERT_NE(data, nullptr);
+  grpc_json* local = GetJsonChild(data, "localFlowControlWindow");
+  ASSERT_NE(local, nullptr);
+  EXPECT_STREQ(local->value, "65535");
+  grpc_json* remote = GetJsonChild(data, "remoteFlowControlWindow");
+  ASSERT_NE(remote, nullptr);
+  EXPECT_STREQ(remote->value, "16384");
+  grpc_json_destroy(json);
+}
+
+TEST(ChannelzSocketTest, TcpInfo) {
+  grpc_core::ExecCtx exec_ctx;
+  RefCountedPtr<SocketNode> socket = MakeRefCounted<SocketNode>(
+      UniquePtr<char>(), UniquePtr<char>(), UniquePtr<char>(gpr_strdup("s")));
+  grpc_json* json = socket->RenderJson();
+  EXPECT_EQ(GetJsonChild(GetJsonChild(json, "data"), "option"), nullptr);
+  grpc_json_destroy(json);
+  TcpInfoSample sample = {};
+  sample.rtt_usec = 1500;
+  sample.snd_cwnd = 10;
+  sample.total_retrans = 3;
+  sample.delivery_rate = 125000000;
+  socket->RecordTcpInfo(sample);
+  json = socket->RenderJson();
+  grpc_json* options = GetJsonChild(GetJsonChild(json, "data"), "option");
+  ASSERT_NE(options, nullptr);
+  grpc_json* option = options->child;
+  ASSERT_NE(option, nullptr);
+  EXPECT_STREQ(GetJsonChild(option, "name")->value, "TCP_INFO");
+  grpc_json* additional = GetJsonChild(option, "additional");
+  ASSERT_NE(additional, nullptr);
+  EXPECT_STREQ(GetJsonChild(additional, "@type")->value,
+               "type.googleapis.com/grpc.channelz.v1.SocketOptionTcpInfo");
+  EXPECT_STREQ(GetJsonChild(additional, "tcpiRtt")->value, "1500");
+  EXPECT_STREQ(GetJsonChild(additional, "tcpiSndCwnd")->value, "10");
+  option = option->next;
+  ASSERT_NE(option, nullptr);
+  EXPECT_STREQ(GetJsonChild(option, "name")->value, "grpc.tcp_total_retrans");
+  EXPECT_STREQ(GetJsonChild(option, "value")->value, "3");
+  option = option->next->next;
+  ASSERT_NE(option, nullptr);
+  EXPECT_STREQ(GetJsonChild(option, "name")->value, "grpc.tcp_delivery_rate");
+  EXPECT_STREQ(GetJsonChild(option, "value")->value, "125000000");
+  grpc_json_destroy(json);
+}
+
+TEST(ChannelzListenSocketTest, HandshakeAdmissionCounters) {
+  grpc_core::ExecCtx exec_ctx;
+  RefCountedPtr<ListenSocketNode> socket = MakeRefCounted<ListenSocketNode>(
+      UniquePtr<char>(), UniquePtr<char>(gpr_strdup("l")));
+  grpc_json* json = socket->RenderJson();
+  EXPECT_EQ(GetJsonChild(json, "data"), nullptr);
+  grpc_json_destroy(json);
+  socket->RecordHandshakeQueued();
+  socket->RecordHandshakeQueued();
+  socket->RecordHandshakeRejected();
+  json = socket->RenderJson();
+  grpc_json* data = GetJsonChild(json, "data");
+  ASSERT_NE(data, nullptr);
+  grpc_json* options = GetJsonChild(data, "option");
+  ASSERT_NE(options, nullptr);
+  grpc_json* option = options->child;
+  ASSERT_NE(option, nullptr);
+  EXPECT_STREQ(GetJsonChild(option, "name")->value, "grpc.handshakes_queued");
+  EXPECT_STREQ(GetJsonChild(option, "value")->value, "2");
+  option = option->next;
+  ASSERT_NE(option, nullptr);
+  EXPECT_STREQ(GetJsonChild(option, "name")->value, "grpc.handshakes_rejected");
+  EXPECT_STREQ(GetJsonChild(option, "value")->value, "1");
+  grpc_json_destroy(json);
+}
+
 TEST_F(ChannelzRegistryBasedTest, BasicGetServersTest) {
   grpc_core::ExecCtx exec_ctx;
   ServerFixture server;
@@ -0,0 +1,102 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/filters/concurrency_limit/concurrency_limiter.h"
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Starts as many calls as the limit allows, then completes them all after
+// rtt_seconds, which makes one window.
+void RunRound(ConcurrencyLimiter* limiter, double rtt_seconds,
+              bool overloaded = false) {
+  uint32_t started = 0;
+  while (limiter->TryAcquire()) ++started;
+  for (uint32_t i = 0; i < started; ++i) {
+    limiter->Release(rtt_seconds, overloaded);
+  }
+}
+
+TEST(ConcurrencyLimiterTest, AcquiresUpToTheLimit) {
+  ConcurrencyLimiter limiter(3, 1, 10);
+  EXPECT_TRUE(limiter.TryAcquire());
+  EXPECT_TRUE(limiter.TryAcquire());
+  EXPECT_TRUE(limiter.TryAcquire());
+  EXPECT_FALSE(limiter.TryAcquire());
+  EXPECT_EQ(limiter.in_flight(), 3u);
+  limiter.Release();
+  EXPECT_EQ(limiter.limit(), 3u);
+  EXPECT_TRUE(limiter.TryAcquire());
+}
+
+TEST(ConcurrencyLimiterTest, GrowsWhileLatencyHolds) {
+  ConcurrencyLimiter limiter(10, 1, 1000);
+  for (int i = 0; i < 10; ++i) RunRound(&limiter, 0.01);
+  EXPECT_GT(limiter.limit(), 10u);
+  EXPECT_EQ(limiter.in_flight(), 0u);
+}
+
+TEST(ConcurrencyLimiterTest, ShrinksWhenLatencyRises) {
+  ConcurrencyLimiter limiter(10, 1, 1000);
+  for (int i = 0; i < 20; ++i) RunRound(&limiter, 0.01);
+  const uint32_t peak = limiter.limit();
+  for (int i = 0; i < 5; ++i) RunRound(&limiter, 0.1);
+  EXPECT_LT(limiter.limit(), peak);
+}
+
+TEST(ConcurrencyLimiterTest, OverloadCutsTheLimit) {
+  ConcurrencyLimiter limiter(100, 1, 1000);
+  for (int i = 0; i < 100; ++i) ASSERT_TRUE(limiter.TryAcquire());
+  limiter.Release(0, true /* overloaded */);
+  // The limit is only revised at the end of the window.
+  EXPECT_EQ(limiter.limit(), 100u);
+  for (int i = 0; i < 99; ++i) limiter.Release(0.01, false /* overloaded */);
+  EXPECT_EQ(limiter.limit(), 90u);
+}
+
+TEST(ConcurrencyLimiterTest, StaysWithinBounds) {
+  ConcurrencyLimiter limiter(10, 5, 12);
+  for (int i = 0; i < 50; ++i) RunRound(&limiter, 0.01);
+  EXPECT_EQ(limiter.limit(), 12u);
+  for (int i = 0; i < 50; ++i) RunRound(&limiter, 0, true /* overloaded */);
+  EXPECT_EQ(limiter.limit(), 5u);
+}
+
+TEST(ConcurrencyLimiterTest, DoesNotGrowWhileUnderused) {
+  ConcurrencyLimiter limiter(20, 1, 1000);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(limiter.TryAcquire());
+    limiter.Release(0.01, false /* overloaded */);
+  }
+  EXPECT_EQ(limiter.limit(), 20u);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,214 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/filters/deadline/deadline_filter.h"
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+const grpc_millis kSlackMs = 100;
+
+// One call's registration, and what happened to its closure.
+class Deadline {
+ public:
+  Deadline() {
+    gpr_event_init(&done_);
+    gpr_atm_rel_store(&runs_, 0);
+    GRPC_CLOSURE_INIT(&closure_, OnDone, this, grpc_schedule_on_exec_ctx);
+  }
+
+  ~Deadline() { GRPC_ERROR_UNREF(error_); }
+
+  void Add(DeadlineCoalescer* coalescer, grpc_millis deadline) {
+    coalescer->Add(&entry_, deadline, &closure_);
+  }
+
+  void Cancel(DeadlineCoalescer* coalescer) { coalescer->Cancel(&entry_); }
+
+  bool WaitForDone() {
+    return gpr_event_wait(&done_, grpc_timeout_seconds_to_deadline(5)) !=
+           nullptr;
+  }
+
+  int runs() const { return static_cast<int>(gpr_atm_acq_load(&runs_)); }
+  grpc_error* error() const { return error_; }
+  grpc_millis fired_at() const { return fired_at_; }
+
+ private:
+  static void OnDone(void* arg, grpc_error* error) {
+    Deadline* self = static_cast<Deadline*>(arg);
+    if (gpr_atm_full_fetch_add(&self->runs_, 1) == 0) {
+      self->error_ = GRPC_ERROR_REF(error);
+      self->fired_at_ = ExecCtx::Get()->Now();
+      gpr_event_set(&self->done_, (void*)1);
+    }
+  }
+
+  DeadlineCoalescer::Entry entry_;
+  grpc_closure closure_;
+  gpr_event done_;
+  gpr_atm runs_;
+  grpc_error* error_ = GRPC_ERROR_NONE;
+  grpc_millis fired_at_ = 0;
+};
+
+grpc_millis Now() {
+  ExecCtx::Get()->InvalidateNow();
+  return ExecCtx::Get()->Now();
+}
+
+TEST(DeadlineCoalescerTest, FiresNoEarlierThanTheDeadline) {
+  ExecCtx exec_ctx;
+  auto coalescer = MakeRefCounted<DeadlineCoalescer>(kSlackMs);
+  Deadline deadlines[3];
+  const grpc_millis start = Now();
+  for (int i = 0; i < 3; ++i) {
+    deadlines[i].Add(coalescer.get(), start + 10 + i * kSlackMs);
+  }
+  ExecCtx::Get()->Flush();
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(deadlines[i].WaitForDone());
+    EXPECT_EQ(GRPC_ERROR_NONE, deadlines[i].error());
+    EXPECT_GE(deadlines[i].fired_at(), start + 10 + i * kSlackMs);
+  }
+  coalescer.reset();
+  ExecCtx::Get()->Flush();
+  for (int i = 0; i < 3; ++i) EXPECT_EQ(1, deadlines[i].runs());
+}
+
+TEST(DeadlineCoalescerTest, CancelRunsTheClosureWithCancelled) {
+  Deadline deadline;
+  auto coalescer = MakeRefCounted<DeadlineCoalescer>(kSlackMs);
+  {
+    ExecCtx exec_ctx;
+    deadline.Add(coalescer.get(), Now() + 60000);
+    deadline.Cancel(coalescer.get());
+  }
+  ASSERT_TRUE(deadline.WaitForDone());
+  EXPECT_EQ(GRPC_ERROR_CANCELLED, deadline.error());
+  {
+    // Cancelling again does not run the closure a second time.
+    ExecCtx exec_ctx;
+    deadline.Cancel(coalescer.get());
+  }
+  EXPECT_EQ(1, deadline.runs());
+}
+
+TEST(DeadlineCoalescerTest, CancelAfterFiringDoesNothing) {
+  Deadline deadline;
+  auto coalescer = MakeRefCounted<DeadlineCoalescer>(kSlackMs);
+  {
+    ExecCtx exec_ctx;
+    deadline.Add(coalescer.get(), Now() + 10);
+  }
+  ASSERT_TRUE(deadline.WaitForDone());
+  EXPECT_EQ(GRPC_ERROR_NONE, deadline.error());
+  {
+    ExecCtx exec_ctx;
+    deadline.Cancel(coalescer.get());
+  }
+  EXPECT_EQ(1, deadline.runs());
+}
+
+TEST(DeadlineCoalescerTest, CancellingOneCallLeavesTheRestOfItsBucket) {
+  Deadline cancelled;
+  Deadline fired[2];
+  auto coalescer = MakeRefCounted<DeadlineCoalescer>(kSlackMs);
+  {
+    ExecCtx exec_ctx;
+    const grpc_millis deadline = Now() + 10;
+    fired[0].Add(coalescer.get(), deadline);
+    cancelled.Add(coalescer.get(), deadline);
+    fired[1].Add(coalescer.get(), deadline);
+    cancelled.Cancel(coalescer.get());
+  }
+  ASSERT_TRUE(cancelled.WaitForDone());
+  EXPECT_EQ(GRPC_ERROR_CANCELLED, cancelled.error());
+  for (Deadline& d : fired) {
+    ASSERT_TRUE(d.WaitForDone());
+    EXPECT_EQ(GRPC_ERROR_NONE, d.error());
+    EXPECT_EQ(1, d.runs());
+  }
+  EXPECT_EQ(1, cancelled.runs());
+}
+
+TEST(DeadlineCoalescerTest, EmptiedBucketIsNotReused) {
+  Deadline cancelled;
+  Deadline later;
+  auto coalescer = MakeRefCounted<DeadlineCoalescer>(kSlackMs);
+  {
+    ExecCtx exec_ctx;
+    const grpc_millis deadline = Now() + 50;
+    cancelled.Add(coalescer.get(), deadline);
+    // Cancels the bucket's timer along with its last call...
+    cancelled.Cancel(coalescer.get());
+    // ...so a call joining afterwards gets a bucket with a live timer.
+    later.Add(coalescer.get(), deadline);
+  }
+  ASSERT_TRUE(later.WaitForDone());
+  EXPECT_EQ(GRPC_ERROR_NONE, later.error());
+  EXPECT_EQ(GRPC_ERROR_CANCELLED, cancelled.error());
+  EXPECT_EQ(1, later.runs());
+  EXPECT_EQ(1, cancelled.runs());
+}
+
+TEST(DeadlineCoalescerTest, EveryClosureRunsExactlyOnce) {
+  const int kNumCalls = 100;
+  Deadline deadlines[kNumCalls];
+  auto coalescer = MakeRefCounted<DeadlineCoalescer>(kSlackMs);
+  {
+    ExecCtx exec_ctx;
+    const grpc_millis start = Now();
+    for (int i = 0; i < kNumCalls; ++i) {
+      // Odd calls are cancelled well before their deadline.
+      deadlines[i].Add(coalescer.get(),
+                       i % 2 == 0 ? start + i * 5 : start + 60000 + i * 5);
+    }
+    for (int i = 1; i < kNumCalls; i += 2) {
+      deadlines[i].Cancel(coalescer.get());
+    }
+  }
+  for (int i = 0; i < kNumCalls; ++i) {
+    ASSERT_TRUE(deadlines[i].WaitForDone());
+    EXPECT_EQ(i % 2 == 0 ? GRPC_ERROR_NONE : GRPC_ERROR_CANCELLED,
+              deadlines[i].error());
+  }
+  for (int i = 0; i < kNumCalls; ++i) EXPECT_EQ(1, deadlines[i].runs());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
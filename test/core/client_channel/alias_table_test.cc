@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/filters/client_channel/lb_policy/xds/alias_table.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+typedef AliasTable<int> IntTable;
+
+// Picks at every (column, height) point of the table once, which picks each
+// item exactly num_items * weight times.
+std::vector<uint64_t> CountPicks(const IntTable& table, uint32_t total_weight) {
+  std::vector<uint64_t> counts(table.size());
+  for (uint32_t column = 0; column < table.size(); ++column) {
+    for (uint32_t height = 0; height < total_weight; ++height) {
+      ++counts[table.Pick(column, height)];
+    }
+  }
+  return counts;
+}
+
+TEST(AliasTableTest, SingleItem) {
+  IntTable::WeightedList items;
+  items.push_back(MakePair(3u, 0));
+  IntTable table(std::move(items));
+  EXPECT_EQ(table.Pick(0, 0), 0);
+  EXPECT_EQ(table.Pick(12345, 67890), 0);
+}
+
+TEST(AliasTableTest, PicksInProportionToWeights) {
+  const uint32_t weights[] = {1, 7, 2, 0, 5, 5, 13, 1};
+  const size_t num_items = GPR_ARRAY_SIZE(weights);
+  IntTable::WeightedList items;
+  uint32_t total_weight = 0;
+  for (size_t i = 0; i < num_items; ++i) {
+    items.push_back(MakePair(weights[i], static_cast<int>(i)));
+    total_weight += weights[i];
+  }
+  IntTable table(std::move(items));
+  std::vector<uint64_t> counts = CountPicks(table, total_weight);
+  for (size_t i = 0; i < num_items; ++i) {
+    EXPECT_EQ(counts[i], num_items * weights[i]) << "item " << i;
+  }
+}
+
+TEST(AliasTableTest, EqualWeights) {
+  IntTable::WeightedList items;
+  for (int i = 0; i < 100; ++i) {
+    items.push_back(MakePair(10u, i));
+  }
+  IntTable table(std::move(items));
+  for (uint32_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(table.Pick(i, i * 7), static_cast<int>(i));
+  }
+}
+
+TEST(AliasTableTest, ManyUnevenWeights) {
+  IntTable::WeightedList items;
+  uint32_t total_weight = 0;
+  std::vector<uint32_t> weights;
+  for (int i = 0; i < 150; ++i) {
+    weights.push_back(1 + (i * 37) % 11);
+    items.push_back(MakePair(weights[i], i));
+    total_weight += weights[i];
+  }
+  IntTable table(std::move(items));
+  std::vector<uint64_t> counts = CountPicks(table, total_weight);
+  for (int i = 0; i < 150; ++i) {
+    EXPECT_EQ(counts[i], 150 * weights[i]) << "item " << i;
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,6 +23,7 @@
 #include <grpc/grpc.h>
 #include "src/core/ext/filters/client_channel/resolver_result_parsing.h"
 #include "src/core/ext/filters/client_channel/service_config.h"
+#include "src/core/ext/filters/concurrency_limit/concurrency_limit_filter.h"
 #include "src/core/ext/filters/message_size/message_size_filter.h"
 #include "src/core/lib/gpr/string.h"
 #include "test/core/util/port.h"
@@ -274,6 +275,33 @@ TEST_F(ServiceConfigTest, Parser2BasicTest) {
   EXPECT_TRUE(static_cast<TestParsedConfig1*>(parsed_config)->value() == 5);
 }
 
+TEST_F(ServiceConfigTest, InternedPathLookupsAreMemoized) {
+  const char* test_json =
+      "{\"methodConfig\": [{\"name\":[{\"service\":\"TestServ\"}], "
+      "\"method_param\":5}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  grpc_slice path = grpc_slice_intern(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  grpc_slice other_path =
+      grpc_slice_intern(grpc_slice_from_static_string("/OtherServ/Method"));
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(path);
+  EXPECT_TRUE(vector_ptr != nullptr);
+  // Both the wildcard match and the miss are remembered, and give the same
+  // answers as the lookup of an uninterned path.
+  EXPECT_EQ(svc_cfg->GetMethodParsedConfigVector(path), vector_ptr);
+  EXPECT_EQ(svc_cfg->GetMethodParsedConfigVector(
+                grpc_slice_from_static_string("/TestServ/TestMethod")),
+            vector_ptr);
+  EXPECT_TRUE(svc_cfg->GetMethodParsedConfigVector(other_path) == nullptr);
+  EXPECT_TRUE(svc_cfg->GetMethodParsedConfigVector(other_path) == nullptr);
+  // The service config keeps its own refs to the paths.
+  grpc_slice_unref(path);
+  grpc_slice_unref(other_path);
+  svc_cfg.reset();
+}
+
 TEST_F(ServiceConfigTest, Parser2ErrorInvalidType) {
   const char* test_json =
       "{\"methodConfig\": [{\"name\":[{\"service\":\"TestServ\"}], "
@@ -391,6 +419,132 @@ TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigRoundRobin) {
   EXPECT_TRUE(strcmp(lb_config->name(), "round_robin") == 0);
 }
 
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigLeastRequest) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"least_request\":{\"choiceCount\":3}}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  auto parsed_config =
+      static_cast<grpc_core::internal::ClientChannelGlobalParsedConfig*>(
+          svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_TRUE(strcmp(lb_config->name(), "least_request") == 0);
+}
+
+TEST_F(ClientChannelParserTest, InvalidLeastRequestChoiceCount) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"least_request\":{\"choiceCount\":1}}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(
+      std::string("(Service config parsing "
+                  "error)(.*)(referenced_errors)(.*)(Global "
+                  "Params)(.*)(referenced_errors)(.*)(Client channel global "
+                  "parser)(.*)(referenced_errors)(.*)(LeastRequest "
+                  "Parser)(.*)(referenced_errors)(.*)(field:choiceCount "
+                  "error:should be a number of at least 2)"));
+  VerifyRegexMatch(error, e);
+}
+
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigRingHash) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"ring_hash\":{\"hashHeader\":"
+      "\"x-user-id\",\"minRingSize\":100}}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  auto parsed_config =
+      static_cast<grpc_core::internal::ClientChannelGlobalParsedConfig*>(
+          svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_TRUE(strcmp(lb_config->name(), "ring_hash") == 0);
+}
+
+TEST_F(ClientChannelParserTest, InvalidRingHashMinRingSize) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"ring_hash\":{\"minRingSize\":0}}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(
+      std::string("(Service config parsing "
+                  "error)(.*)(referenced_errors)(.*)(Global "
+                  "Params)(.*)(referenced_errors)(.*)(Client channel global "
+                  "parser)(.*)(referenced_errors)(.*)(RingHash "
+                  "Parser)(.*)(referenced_errors)(.*)(field:minRingSize "
+                  "error:should be a number between 1 and 8388608)"));
+  VerifyRegexMatch(error, e);
+}
+
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigWeightedRoundRobin) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin\":{\"costName\":"
+      "\"queue_length\"}}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  auto parsed_config =
+      static_cast<grpc_core::internal::ClientChannelGlobalParsedConfig*>(
+          svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_TRUE(strcmp(lb_config->name(), "weighted_round_robin") == 0);
+}
+
+TEST_F(ClientChannelParserTest, InvalidWeightedRoundRobinCostName) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin\":{\"costName\":"
+      "3}}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(
+      std::string("(Service config parsing "
+                  "error)(.*)(referenced_errors)(.*)(Global "
+                  "Params)(.*)(referenced_errors)(.*)(Client channel global "
+                  "parser)(.*)(referenced_errors)(.*)(WeightedRoundRobin "
+                  "Parser)(.*)(referenced_errors)(.*)(field:costName "
+                  "error:should be a non-empty string)"));
+  VerifyRegexMatch(error, e);
+}
+
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigOutlierDetection) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"outlier_detection\":{\"childPolicy\":"
+      "[{\"round_robin\":{}}],\"intervalMs\":1000,"
+      "\"successRateStdevFactor\":1.5}}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  auto parsed_config =
+      static_cast<grpc_core::internal::ClientChannelGlobalParsedConfig*>(
+          svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_TRUE(strcmp(lb_config->name(), "outlier_detection") == 0);
+}
+
+TEST_F(ClientChannelParserTest, InvalidOutlierDetectionMaxEjectionPercent) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"outlier_detection\":"
+      "{\"maxEjectionPercent\":200}}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(
+      std::string("(Service config parsing "
+                  "error)(.*)(referenced_errors)(.*)(Global "
+                  "Params)(.*)(referenced_errors)(.*)(Client channel global "
+                  "parser)(.*)(referenced_errors)(.*)(OutlierDetection "
+                  "Parser)(.*)(referenced_errors)(.*)(field:maxEjectionPercent "
+                  "error:should be a number between 0 and 100)"));
+  VerifyRegexMatch(error, e);
+}
+
 TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigGrpclb) {
   const char* test_json =
       "{\"loadBalancingConfig\": "
@@ -883,6 +1037,98 @@ TEST_F(ClientChannelParserTest, InvalidRetryPolicyRetryableStatusCodes) {
   VerifyRegexMatch(error, e);
 }
 
+TEST_F(ClientChannelParserTest, ValidHedgingPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0.5s\",\n"
+      "      \"nonFatalStatusCodes\": [ \"UNAVAILABLE\" ]\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  EXPECT_TRUE(vector_ptr != nullptr);
+  const auto* parsed_config =
+      static_cast<grpc_core::internal::ClientChannelMethodParsedConfig*>(
+          ((*vector_ptr)[0]).get());
+  ASSERT_TRUE(parsed_config->retry_policy() != nullptr);
+  EXPECT_EQ(parsed_config->retry_policy()->max_attempts, 3);
+  EXPECT_EQ(parsed_config->retry_policy()->hedging_delay, 500);
+  EXPECT_TRUE(parsed_config->retry_policy()->retryable_status_codes.Contains(
+      GRPC_STATUS_UNAVAILABLE));
+}
+
+TEST_F(ClientChannelParserTest, InvalidHedgingPolicyHedgingDelay) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(std::string(
+      "(Service config parsing "
+      "error)(.*)(referenced_errors)(.*)(Method "
+      "Params)(.*)(referenced_errors)(.*)(methodConfig)(.*)(referenced_errors)("
+      ".*)(Client channel "
+      "parser)(.*)(referenced_errors)(.*)(hedgingPolicy)(.*)(referenced_errors)"
+      "(.*)(field:hedgingDelay error:must be greater than 0)"));
+  VerifyRegexMatch(error, e);
+}
+
+TEST_F(ClientChannelParserTest, InvalidHedgingPolicyWithRetryPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"retryPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"initialBackoff\": \"1s\",\n"
+      "      \"maxBackoff\": \"120s\",\n"
+      "      \"backoffMultiplier\": 1.6,\n"
+      "      \"retryableStatusCodes\": [ \"ABORTED\" ]\n"
+      "    },\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0.5s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(std::string(
+      "(Service config parsing "
+      "error)(.*)(referenced_errors)(.*)(Method "
+      "Params)(.*)(referenced_errors)(.*)(methodConfig)(.*)(referenced_errors)("
+      ".*)(Client channel "
+      "parser)(.*)(referenced_errors)(.*)(field:hedgingPolicy error:cannot be "
+      "set with retryPolicy)"));
+  VerifyRegexMatch(error, e);
+}
+
 TEST_F(ClientChannelParserTest, ValidHealthCheck) {
   const char* test_json =
       "{\n"
@@ -1010,6 +1256,117 @@ TEST_F(MessageSizeParserTest, InvalidMaxResponseMessageBytes) {
   VerifyRegexMatch(error, e);
 }
 
+class ConcurrencyLimitParserTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ServiceConfig::Shutdown();
+    ServiceConfig::Init();
+    EXPECT_TRUE(ServiceConfig::RegisterParser(UniquePtr<ServiceConfig::Parser>(
+                    New<ConcurrencyLimitParser>())) == 0);
+  }
+};
+
+TEST_F(ConcurrencyLimitParserTest, Valid) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"concurrencyLimit\": {\n"
+      "      \"initialLimit\": 50,\n"
+      "      \"minLimit\": 10,\n"
+      "      \"maxLimit\": 200\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE) << grpc_error_string(error);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_TRUE(vector_ptr != nullptr);
+  auto parsed_config =
+      static_cast<ConcurrencyLimitParsedConfig*>(((*vector_ptr)[0]).get());
+  ASSERT_TRUE(parsed_config != nullptr);
+  EXPECT_EQ(parsed_config->initial_limit(), 50u);
+  EXPECT_EQ(parsed_config->min_limit(), 10u);
+  EXPECT_EQ(parsed_config->max_limit(), 200u);
+  EXPECT_EQ(parsed_config->limiter()->limit(), 50u);
+}
+
+TEST_F(ConcurrencyLimitParserTest, Defaults) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"concurrencyLimit\": {}\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE) << grpc_error_string(error);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_TRUE(vector_ptr != nullptr);
+  auto parsed_config =
+      static_cast<ConcurrencyLimitParsedConfig*>(((*vector_ptr)[0]).get());
+  ASSERT_TRUE(parsed_config != nullptr);
+  EXPECT_EQ(parsed_config->initial_limit(), 20u);
+  EXPECT_EQ(parsed_config->min_limit(), 1u);
+  EXPECT_EQ(parsed_config->max_limit(), 1000u);
+}
+
+TEST_F(ConcurrencyLimitParserTest, InvalidLimit) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"concurrencyLimit\": {\n"
+      "      \"minLimit\": 0\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(
+      std::string("(Service config parsing "
+                  "error)(.*)(referenced_errors)(.*)(Method "
+                  "Params)(.*)(referenced_errors)(.*)(methodConfig)(.*)("
+                  "referenced_errors)(.*)(Concurrency limit "
+                  "parser)(.*)(referenced_errors)(.*)(field:"
+                  "minLimit error:should be positive)"));
+  VerifyRegexMatch(error, e);
+}
+
+TEST_F(ConcurrencyLimitParserTest, InvalidBounds) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"concurrencyLimit\": {\n"
+      "      \"initialLimit\": 500,\n"
+      "      \"maxLimit\": 100\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(std::string(
+      "(Concurrency limit parser)(.*)(referenced_errors)(.*)(field:"
+      "concurrencyLimit error:should have minLimit <= initialLimit <= "
+      "maxLimit)"));
+  VerifyRegexMatch(error, e);
+}
+
 }  // namespace testing
 }  // namespace grpc_core
 
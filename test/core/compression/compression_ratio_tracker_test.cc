@@ -0,0 +1,79 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/filters/http/message_compress/compression_ratio_tracker.h"
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+TEST(CompressionRatioTrackerTest, CompressesWhileRatiosAreGood) {
+  CompressionRatioTracker tracker(0.9);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(tracker.ShouldCompress());
+    tracker.Record(1000, 300);
+  }
+  EXPECT_FALSE(tracker.disabled());
+}
+
+TEST(CompressionRatioTrackerTest, StopsAfterPoorRatios) {
+  CompressionRatioTracker tracker(0.9);
+  tracker.Record(1000, 300);
+  // The average takes a few poor messages to cross the threshold.
+  tracker.Record(1000, 1000);
+  EXPECT_FALSE(tracker.disabled());
+  for (int i = 0; i < 10; ++i) tracker.Record(1000, 1000);
+  EXPECT_TRUE(tracker.disabled());
+  // Only one message in kProbeInterval is compressed.
+  int compressed = 0;
+  for (uint32_t i = 0; i < 10 * CompressionRatioTracker::kProbeInterval; ++i) {
+    if (tracker.ShouldCompress()) ++compressed;
+  }
+  EXPECT_EQ(compressed, 10);
+}
+
+TEST(CompressionRatioTrackerTest, ResumesWhenProbesCompressWell) {
+  CompressionRatioTracker tracker(0.9);
+  tracker.Record(1000, 1000);
+  ASSERT_TRUE(tracker.disabled());
+  int probes = 0;
+  while (tracker.disabled()) {
+    for (uint32_t i = 1; i < CompressionRatioTracker::kProbeInterval; ++i) {
+      ASSERT_FALSE(tracker.ShouldCompress());
+    }
+    ASSERT_TRUE(tracker.ShouldCompress());
+    tracker.Record(1000, 200);
+    ++probes;
+  }
+  EXPECT_EQ(probes, 1);
+  EXPECT_TRUE(tracker.ShouldCompress());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -166,6 +166,62 @@ static void test_tiny_data_compress(void) {
   grpc_slice_buffer_destroy(&output);
 }
 
+static void test_compression_levels(void) {
+  const int levels[] = {1, 9, GRPC_MSG_COMPRESS_DEFAULT_LEVEL};
+  for (int i = 0; i < GRPC_MESSAGE_COMPRESS_ALGORITHMS_COUNT; i++) {
+    if (i == GRPC_MESSAGE_COMPRESS_NONE) continue;
+    for (size_t j = 0; j < GPR_ARRAY_SIZE(levels); j++) {
+      grpc_slice_buffer input;
+      grpc_slice_buffer compressed;
+      grpc_slice_buffer output;
+      grpc_slice_buffer_init(&input);
+      grpc_slice_buffer_init(&compressed);
+      grpc_slice_buffer_init(&output);
+      grpc_slice value = create_test_value(ONE_MB_A);
+      grpc_slice_buffer_add(&input, grpc_slice_ref(value));
+      grpc_core::ExecCtx exec_ctx;
+      const grpc_message_compression_algorithm algorithm =
+          static_cast<grpc_message_compression_algorithm>(i);
+      GPR_ASSERT(1 == grpc_msg_compress_with_level(algorithm, levels[j],
+                                                   &input, &compressed));
+      GPR_ASSERT(compressed.length < input.length);
+      GPR_ASSERT(1 == grpc_msg_decompress(algorithm, &compressed, &output));
+      grpc_slice final = grpc_slice_merge(output.slices, output.count);
+      GPR_ASSERT(grpc_slice_eq(value, final));
+      grpc_slice_unref(final);
+      grpc_slice_unref(value);
+      grpc_slice_buffer_destroy(&input);
+      grpc_slice_buffer_destroy(&compressed);
+      grpc_slice_buffer_destroy(&output);
+    }
+  }
+}
+
+/* Data that does not compress is passed through, however much of it there
+   is. */
+static void test_incompressible_data(void) {
+  grpc_slice_buffer input;
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&output);
+  grpc_slice value = grpc_slice_malloc(256 * 1024);
+  uint32_t x = 12345;
+  for (size_t i = 0; i < GRPC_SLICE_LENGTH(value); i++) {
+    x = x * 1103515245 + 12345;
+    GRPC_SLICE_START_PTR(value)[i] = static_cast<uint8_t>(x >> 24);
+  }
+  grpc_slice_buffer_add(&input, grpc_slice_ref(value));
+  grpc_core::ExecCtx exec_ctx;
+  GPR_ASSERT(0 == grpc_msg_compress(GRPC_MESSAGE_COMPRESS_GZIP, &input,
+                                    &output));
+  grpc_slice final = grpc_slice_merge(output.slices, output.count);
+  GPR_ASSERT(grpc_slice_eq(value, final));
+  grpc_slice_unref(final);
+  grpc_slice_unref(value);
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&output);
+}
+
 static void test_bad_decompression_data_crc(void) {
   grpc_slice_buffer input;
   grpc_slice_buffer corrupted;
@@ -234,6 +290,80 @@ static void test_bad_decompression_data_stream(void) {
   grpc_slice_buffer_destroy(&output);
 }
 
+/* The zlib streams reused across messages are reset properly, including
+   after a message that failed to decompress. */
+static void test_stream_reuse(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice value = create_test_value(ONE_KB_A);
+  for (int i = 0; i < 20; i++) {
+    const grpc_message_compression_algorithm algorithm =
+        i % 2 == 0 ? GRPC_MESSAGE_COMPRESS_GZIP : GRPC_MESSAGE_COMPRESS_DEFLATE;
+    grpc_slice_buffer input;
+    grpc_slice_buffer compressed;
+    grpc_slice_buffer garbage;
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&input);
+    grpc_slice_buffer_init(&compressed);
+    grpc_slice_buffer_init(&garbage);
+    grpc_slice_buffer_init(&output);
+    grpc_slice_buffer_add(&input, grpc_slice_ref(value));
+    grpc_slice_buffer_add(&garbage,
+                          grpc_slice_from_copied_buffer("\x78\xda\xff\xff", 4));
+    GPR_ASSERT(1 == grpc_msg_compress_with_level(algorithm, i % 3 + 1, &input,
+                                                 &compressed));
+    GPR_ASSERT(0 == grpc_msg_decompress(algorithm, &garbage, &output));
+    GPR_ASSERT(1 == grpc_msg_decompress(algorithm, &compressed, &output));
+    grpc_slice final = grpc_slice_merge(output.slices, output.count);
+    GPR_ASSERT(grpc_slice_eq(value, final));
+    grpc_slice_unref(final);
+    grpc_slice_buffer_destroy(&input);
+    grpc_slice_buffer_destroy(&compressed);
+    grpc_slice_buffer_destroy(&garbage);
+    grpc_slice_buffer_destroy(&output);
+  }
+  grpc_slice_unref(value);
+}
+
+/* Messages compressed with a persistent dictionary shrink once the earlier
+   ones have been seen, and decode in order through one decompressor. */
+static void test_persistent_dictionary(void) {
+  grpc_core::ExecCtx exec_ctx;
+  const char* message =
+      "{\"user\":\"someone@example.com\",\"event\":\"click\","
+      "\"target\":\"button\"}";
+  grpc_msg_persistent_compressor* compressor =
+      grpc_msg_persistent_compressor_create(GRPC_MSG_COMPRESS_DEFAULT_LEVEL);
+  grpc_msg_persistent_compressor* decompressor =
+      grpc_msg_persistent_decompressor_create();
+  size_t first_length = 0;
+  for (int i = 0; i < 10; i++) {
+    grpc_slice_buffer input;
+    grpc_slice_buffer compressed;
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&input);
+    grpc_slice_buffer_init(&compressed);
+    grpc_slice_buffer_init(&output);
+    grpc_slice_buffer_add(&input, grpc_slice_from_static_string(message));
+    GPR_ASSERT(1 ==
+               grpc_msg_persistent_compress(compressor, &input, &compressed));
+    if (i == 0) {
+      first_length = compressed.length;
+    } else {
+      GPR_ASSERT(compressed.length < first_length / 2);
+    }
+    GPR_ASSERT(1 == grpc_msg_persistent_decompress(decompressor, &compressed,
+                                                   &output));
+    grpc_slice final = grpc_slice_merge(output.slices, output.count);
+    GPR_ASSERT(0 == grpc_slice_str_cmp(final, message));
+    grpc_slice_unref(final);
+    grpc_slice_buffer_destroy(&input);
+    grpc_slice_buffer_destroy(&compressed);
+    grpc_slice_buffer_destroy(&output);
+  }
+  grpc_msg_persistent_compressor_destroy(compressor);
+  grpc_msg_persistent_compressor_destroy(decompressor);
+}
+
 static void test_bad_compression_algorithm(void) {
   grpc_slice_buffer input;
   grpc_slice_buffer output;
@@ -314,6 +444,10 @@ int main(int argc, char** argv) {
   }
 
   test_tiny_data_compress();
+  test_compression_levels();
+  test_incompressible_data();
+  test_stream_reuse();
+  test_persistent_dictionary();
   test_bad_decompression_data_crc();
   test_bad_decompression_data_stream();
   test_bad_decompression_data_trailing_garbage();
@@ -142,10 +142,8 @@ INSTANTIATE_TEST_CASE_P(HistogramTestCases, HistogramTest,
 }  // namespace grpc
 
 int main(int argc, char** argv) {
-/* Only run this test if GRPC_COLLECT_STATS is defined or if it is a debug
- * build.
- */
-#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+/* Only run this test if stats are collected. */
+#ifndef GRPC_DISABLE_STATS
   ::testing::InitGoogleTest(&argc, argv);
   grpc_init();
   int ret = RUN_ALL_TESTS();
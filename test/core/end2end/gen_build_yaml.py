@@ -75,6 +75,7 @@ END2END_FIXTURES = {
         ci_mac=False, tracing=True, large_writes=False, exclude_iomgrs=['uv']),
     'h2_ssl': default_secure_fixture_options,
     'h2_ssl_cred_reload': default_secure_fixture_options,
+    'h2_ssl_handshake_offload': default_secure_fixture_options,
     'h2_spiffe': default_secure_fixture_options,
     'h2_local_uds': local_fixture_options,
     'h2_local_ipv4': local_fixture_options,
@@ -88,6 +88,7 @@ END2END_FIXTURES = {
     ),
     "h2_ssl": _fixture_options(secure = True),
     "h2_ssl_cred_reload": _fixture_options(secure = True),
+    "h2_ssl_handshake_offload": _fixture_options(secure = True),
     "h2_spiffe": _fixture_options(secure = True),
     "h2_local_uds": _fixture_options(secure = True, dns_resolver = False, _platforms = ["linux", "mac", "posix"]),
     "h2_local_ipv4": _fixture_options(secure = True, dns_resolver = False, _platforms = ["linux", "mac", "posix"]),
@@ -152,6 +153,7 @@ END2END_NOSEC_FIXTURES = {
     ),
     "h2_ssl": _fixture_options(secure = False),
     "h2_ssl_cred_reload": _fixture_options(secure = False),
+    "h2_ssl_handshake_offload": _fixture_options(secure = False),
     "h2_ssl_proxy": _fixture_options(includes_proxy = True, secure = False),
     "h2_uds": _fixture_options(
         dns_resolver = False,
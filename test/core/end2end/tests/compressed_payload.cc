@@ -273,7 +273,7 @@ static void request_with_payload_template(
     grpc_compression_algorithm expected_algorithm_from_server,
     grpc_metadata* client_init_metadata, bool set_server_level,
     grpc_compression_level server_compression_level,
-    bool send_message_before_initial_metadata) {
+    bool send_message_before_initial_metadata, bool offload_decompression) {
   grpc_call* c;
   grpc_call* s;
   grpc_slice request_payload_slice;
@@ -312,6 +312,22 @@ static void request_with_payload_template(
       nullptr, default_client_channel_compression_algorithm);
   server_args = grpc_channel_args_set_channel_default_compression_algorithm(
       nullptr, default_server_channel_compression_algorithm);
+  if (offload_decompression) {
+    /* Messages then reach the application decompressed, by either side. */
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_COMPRESSION_CHANNEL_DECOMPRESS_OFFLOAD_THRESHOLD),
+        1);
+    grpc_core::ExecCtx exec_ctx;
+    grpc_channel_args* args =
+        grpc_channel_args_copy_and_add(client_args, &arg, 1);
+    grpc_channel_args_destroy(client_args);
+    client_args = args;
+    args = grpc_channel_args_copy_and_add(server_args, &arg, 1);
+    grpc_channel_args_destroy(server_args);
+    server_args = args;
+    expected_algorithm_from_client = GRPC_COMPRESS_NONE;
+    expected_algorithm_from_server = GRPC_COMPRESS_NONE;
+  }
 
   f = begin_test(config, test_name, client_args, server_args);
   cqv = cq_verifier_create(f.cq);
@@ -553,7 +569,7 @@ static void test_invoke_request_with_exceptionally_uncompressed_payload(
       config, "test_invoke_request_with_exceptionally_uncompressed_payload",
       GRPC_WRITE_NO_COMPRESS, GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_NONE, GRPC_COMPRESS_GZIP, nullptr, false,
-      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false);
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false, false);
 }
 
 static void test_invoke_request_with_uncompressed_payload(
@@ -562,7 +578,7 @@ static void test_invoke_request_with_uncompressed_payload(
       config, "test_invoke_request_with_uncompressed_payload", 0,
       GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_NONE, nullptr, false,
-      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false);
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false, false);
 }
 
 static void test_invoke_request_with_compressed_payload(
@@ -571,7 +587,16 @@ static void test_invoke_request_with_compressed_payload(
       config, "test_invoke_request_with_compressed_payload", 0,
       GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_GZIP, nullptr, false,
-      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false);
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false, false);
+}
+
+static void test_invoke_request_with_offloaded_decompression(
+    grpc_end2end_test_config config) {
+  request_with_payload_template(
+      config, "test_invoke_request_with_offloaded_decompression", 0,
+      GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP,
+      GRPC_COMPRESS_GZIP, nullptr, false,
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false, true);
 }
 
 static void test_invoke_request_with_send_message_before_initial_metadata(
@@ -580,7 +605,7 @@ static void test_invoke_request_with_send_message_before_initial_metadata(
       config, "test_invoke_request_with_compressed_payload", 0,
       GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_GZIP, nullptr, false,
-      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, true);
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, true, false);
 }
 
 static void test_invoke_request_with_server_level(
@@ -588,7 +613,7 @@ static void test_invoke_request_with_server_level(
   request_with_payload_template(
       config, "test_invoke_request_with_server_level", 0, GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE /* ignored */,
-      nullptr, true, GRPC_COMPRESS_LEVEL_HIGH, false);
+      nullptr, true, GRPC_COMPRESS_LEVEL_HIGH, false, false);
 }
 
 static void test_invoke_request_with_compressed_payload_md_override(
@@ -612,21 +637,21 @@ static void test_invoke_request_with_compressed_payload_md_override(
       config, "test_invoke_request_with_compressed_payload_md_override_1", 0,
       GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_NONE, &gzip_compression_override, false,
-      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false);
+      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false, false);
 
   /* Channel default DEFLATE, call override to GZIP */
   request_with_payload_template(
       config, "test_invoke_request_with_compressed_payload_md_override_2", 0,
       GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_NONE, &gzip_compression_override, false,
-      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false);
+      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false, false);
 
   /* Channel default DEFLATE, call override to NONE (aka IDENTITY) */
   request_with_payload_template(
       config, "test_invoke_request_with_compressed_payload_md_override_3", 0,
       GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_NONE, &identity_compression_override, false,
-      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false);
+      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false, false);
 }
 
 static void test_invoke_request_with_disabled_algorithm(
@@ -641,6 +666,7 @@ void compressed_payload(grpc_end2end_test_config config) {
   test_invoke_request_with_exceptionally_uncompressed_payload(config);
   test_invoke_request_with_uncompressed_payload(config);
   test_invoke_request_with_compressed_payload(config);
+  test_invoke_request_with_offloaded_decompression(config);
   test_invoke_request_with_send_message_before_initial_metadata(config);
   test_invoke_request_with_server_level(config);
   test_invoke_request_with_compressed_payload_md_override(config);
@@ -96,11 +96,12 @@ static void end_test(grpc_end2end_test_fixture* f) {
 // Tests that we don't make any further attempts after we exceed the
 // max buffer size.
 // - 1 retry allowed for ABORTED status
-// - buffer size set to 2 bytes
+// - buffer size set to 2 bytes, via \a buffer_size_arg (either the per-RPC
+//   or the channel-wide limit)
 // - client sends a 3-byte message
 // - first attempt gets ABORTED but is not retried
 static void test_retry_exceeds_buffer_size_in_initial_batch(
-    grpc_end2end_test_config config) {
+    grpc_end2end_test_config config, const char* buffer_size_arg) {
   grpc_call* c;
   grpc_call* s;
   grpc_op ops[6];
@@ -142,7 +143,7 @@ static void test_retry_exceeds_buffer_size_in_initial_batch(
       "  } ]\n"
       "}");
   args[1].type = GRPC_ARG_INTEGER;
-  args[1].key = const_cast<char*>(GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE);
+  args[1].key = const_cast<char*>(buffer_size_arg);
   args[1].value.integer = 2;
   grpc_channel_args client_args = {GPR_ARRAY_SIZE(args), args};
   grpc_end2end_test_fixture f =
@@ -256,7 +257,10 @@ static void test_retry_exceeds_buffer_size_in_initial_batch(
 void retry_exceeds_buffer_size_in_initial_batch(
     grpc_end2end_test_config config) {
   GPR_ASSERT(config.feature_mask & FEATURE_MASK_SUPPORTS_CLIENT_CHANNEL);
-  test_retry_exceeds_buffer_size_in_initial_batch(config);
+  test_retry_exceeds_buffer_size_in_initial_batch(
+      config, GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE);
+  test_retry_exceeds_buffer_size_in_initial_batch(
+      config, GRPC_ARG_CHANNEL_RETRY_BUFFER_SIZE);
 }
 
 void retry_exceeds_buffer_size_in_initial_batch_pre_init(void) {}
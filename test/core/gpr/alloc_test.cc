@@ -21,6 +21,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/alloc.h"
 #include "test/core/util/test_config.h"
 
 static void* fake_malloc(size_t size) { return (void*)size; }
@@ -63,9 +64,57 @@ static void test_malloc_aligned() {
   }
 }
 
+struct subsystem_counts {
+  size_t allocated;
+  size_t freed;
+};
+
+static void* counting_malloc(size_t size, void* user_data) {
+  static_cast<subsystem_counts*>(user_data)->allocated += size;
+  return malloc(size);
+}
+
+static void counting_free(void* ptr, size_t size, void* user_data) {
+  static_cast<subsystem_counts*>(user_data)->freed += size;
+  free(ptr);
+}
+
+static void test_subsystem_allocs() {
+  subsystem_counts counts = {0, 0};
+  gpr_subsystem_allocation_functions fns = {counting_malloc, counting_free,
+                                            &counts};
+  gpr_set_subsystem_allocation_functions(GPR_ALLOC_SUBSYSTEM_METADATA, fns);
+  const size_t slices_before =
+      gpr_subsystem_allocated_bytes(GPR_ALLOC_SUBSYSTEM_SLICES);
+
+  void* p = gpr_subsystem_malloc(GPR_ALLOC_SUBSYSTEM_METADATA, 100);
+  GPR_ASSERT(counts.allocated == 100);
+  GPR_ASSERT(gpr_subsystem_allocated_bytes(GPR_ALLOC_SUBSYSTEM_METADATA) ==
+             100);
+  void* aligned = gpr_subsystem_malloc_aligned(GPR_ALLOC_SUBSYSTEM_METADATA,
+                                               200, 64);
+  GPR_ASSERT(((intptr_t)aligned & 63) == 0);
+  memset(aligned, 0, 200);
+  GPR_ASSERT(counts.allocated > 300);
+  gpr_subsystem_free_aligned(GPR_ALLOC_SUBSYSTEM_METADATA, aligned);
+  GPR_ASSERT(counts.freed == counts.allocated - 100);
+  gpr_subsystem_free(GPR_ALLOC_SUBSYSTEM_METADATA, p, 100);
+  GPR_ASSERT(counts.freed == counts.allocated);
+  GPR_ASSERT(gpr_subsystem_allocated_bytes(GPR_ALLOC_SUBSYSTEM_METADATA) ==
+             0);
+
+  /* Other subsystems keep the default functions */
+  p = gpr_subsystem_malloc(GPR_ALLOC_SUBSYSTEM_SLICES, 50);
+  GPR_ASSERT(counts.allocated == counts.freed);
+  GPR_ASSERT(gpr_subsystem_allocated_bytes(GPR_ALLOC_SUBSYSTEM_SLICES) ==
+             slices_before + 50);
+  gpr_subsystem_free(GPR_ALLOC_SUBSYSTEM_SLICES, p, 50);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   test_custom_allocs();
   test_malloc_aligned();
+  test_subsystem_allocs();
   return 0;
 }
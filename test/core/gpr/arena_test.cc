@@ -32,6 +32,7 @@
 #include "test/core/util/test_config.h"
 
 using grpc_core::Arena;
+using grpc_core::ArenaPool;
 
 static void test_noop(void) { Arena::Create(1)->Destroy(); }
 
@@ -117,6 +118,82 @@ static void concurrent_test(void) {
   args.arena->Destroy();
 }
 
+static void test_pool_reuse(void) {
+  gpr_log(GPR_DEBUG, "test_pool_reuse");
+
+  ArenaPool pool(2);
+  Arena* a = pool.Create(1024);
+  memset(a->Alloc(1024), 1, 1024);
+  GPR_ASSERT(pool.Release(a) == 1024);
+  // The released arena comes back for a request it can satisfy...
+  Arena* b = pool.Create(1000);
+  GPR_ASSERT(b == a);
+  memset(b->Alloc(1024), 2, 1024);
+  // ...but not for one that outgrew it.
+  pool.Release(b);
+  Arena* c = pool.Create(4096);
+  GPR_ASSERT(c != a);
+  pool.Release(c);
+
+  // CreateWithAlloc() carves the first allocation out of the reused zone.
+  auto with_alloc = pool.CreateWithAlloc(4096, 100);
+  GPR_ASSERT(with_alloc.first == c);
+  memset(with_alloc.second, 3, 100);
+  GPR_ASSERT(pool.Release(with_alloc.first) == 100);
+}
+
+static void test_pool_limits(void) {
+  gpr_log(GPR_DEBUG, "test_pool_limits");
+
+  ArenaPool pool(2);
+  Arena* arenas[4];
+  for (auto& a : arenas) {
+    a = pool.Create(256);
+  }
+  // An arena that had to grow past its initial zone is not kept.
+  arenas[0]->Alloc(1024);
+  for (auto& a : arenas) {
+    pool.Release(a);
+  }
+  Arena* reused[3];
+  for (auto& a : reused) {
+    a = pool.Create(256);
+  }
+  GPR_ASSERT(reused[0] == arenas[2]);
+  GPR_ASSERT(reused[1] == arenas[1]);
+  for (auto& a : reused) {
+    pool.Release(a);
+  }
+
+  ArenaPool no_cache(0);
+  Arena* a = no_cache.Create(256);
+  no_cache.Release(a);
+}
+
+static void concurrent_pool_test_body(void* arg) {
+  ArenaPool* pool = static_cast<ArenaPool*>(arg);
+  for (size_t i = 0; i < concurrent_test_iterations() / 10; i++) {
+    Arena* a = pool->Create(64 + i % 128);
+    memset(a->Alloc(64), static_cast<int>(i), 64);
+    pool->Release(a);
+  }
+}
+
+static void concurrent_pool_test(void) {
+  gpr_log(GPR_DEBUG, "concurrent_pool_test");
+
+  ArenaPool pool;
+  grpc_core::Thread thds[CONCURRENT_TEST_THREADS];
+  for (int i = 0; i < CONCURRENT_TEST_THREADS; i++) {
+    thds[i] = grpc_core::Thread("grpc_concurrent_pool_test",
+                                concurrent_pool_test_body, &pool);
+    thds[i].Start();
+  }
+  for (auto& th : thds) {
+    th.Join();
+  }
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(argc, argv);
 
@@ -128,6 +205,9 @@ int main(int argc, char* argv[]) {
   TEST(1_inc, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
   TEST(6_123, 6, 1, 2, 3);
   concurrent_test();
+  test_pool_reuse();
+  test_pool_limits();
+  concurrent_pool_test();
 
   return 0;
 }
@@ -0,0 +1,86 @@
+/*
+ *
+ * Copyright 2015 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/gpr/mu_contention.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "test/core/util/test_config.h"
+
+static void test_enable(void) {
+  gpr_log(GPR_DEBUG, "test_enable");
+  gpr_mu_contention_profiling_enable(true);
+  GPR_ASSERT(gpr_mu_contention_profiling_enabled());
+  gpr_mu_contention_profiling_enable(false);
+  GPR_ASSERT(!gpr_mu_contention_profiling_enabled());
+}
+
+static void test_uncontended_lock_not_tracked(void) {
+  gpr_log(GPR_DEBUG, "test_uncontended_lock_not_tracked");
+  gpr_mu_contention_reset();
+  gpr_mu mu;
+  gpr_mu_init(&mu);
+  gpr_mu_contention_record_holder(&mu, "holder.cc", 1, nullptr);
+  char* report = gpr_mu_contention_report(10);
+  GPR_ASSERT(strcmp(report, "") == 0);
+  gpr_free(report);
+  gpr_mu_destroy(&mu);
+}
+
+static void test_report_is_ordered_by_wait(void) {
+  gpr_log(GPR_DEBUG, "test_report_is_ordered_by_wait");
+  gpr_mu_contention_reset();
+  gpr_mu a;
+  gpr_mu b;
+  gpr_mu_init(&a);
+  gpr_mu_init(&b);
+  gpr_mu_contention_record_wait(&a, 1000000, "waiter_a.cc", 10, nullptr);
+  gpr_mu_contention_record_holder(&a, "holder_a.cc", 11, nullptr);
+  gpr_mu_contention_record_wait(&a, 2000000, "waiter_a.cc", 12, nullptr);
+  gpr_mu_contention_record_holder(&a, "holder_a.cc", 12, nullptr);
+  gpr_mu_contention_record_wait(&b, 5000000, "waiter_b.cc", 20, nullptr);
+  char* report = gpr_mu_contention_report(10);
+  gpr_log(GPR_INFO, "report:\n%s", report);
+  const char* line_b = strstr(report, "1 contentions, 5.000ms waited");
+  const char* line_a =
+      strstr(report, "2 contentions, 3.000ms waited, max 2.000ms; last held "
+                     "at holder_a.cc:11 while waited for at waiter_a.cc:12");
+  GPR_ASSERT(line_b != nullptr);
+  GPR_ASSERT(line_a != nullptr);
+  GPR_ASSERT(line_b < line_a);
+  GPR_ASSERT(strstr(line_b, "last held at unknown") != nullptr);
+  gpr_free(report);
+  report = gpr_mu_contention_report(1);
+  GPR_ASSERT(strstr(report, "waiter_b.cc") != nullptr);
+  GPR_ASSERT(strstr(report, "waiter_a.cc") == nullptr);
+  gpr_free(report);
+  gpr_mu_destroy(&a);
+  gpr_mu_destroy(&b);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  test_enable();
+  test_uncontended_lock_not_tracked();
+  test_report_is_ordered_by_wait();
+  return 0;
+}
@@ -27,8 +27,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "src/core/lib/gpr/time_precise.h"
 #include "test/core/util/test_config.h"
 
+extern gpr_timespec (*gpr_now_impl)(gpr_clock_type clock_type);
+
 static void to_fp(void* arg, const char* buf, size_t len) {
   fwrite(buf, 1, len, static_cast<FILE*>(arg));
 }
@@ -253,6 +256,69 @@ static void test_cmp_extreme(void) {
   GPR_ASSERT(gpr_time_cmp(t1, t2) == 0);
 }
 
+static gpr_timespec frozen_now(gpr_clock_type clock_type) {
+  gpr_timespec ts = {1000, 0, clock_type};
+  return ts;
+}
+
+/* A clock that does not move cannot be used to tell whether the TSC is
+   usable, so the cycle counter must fall back to the monotonic clock. */
+static void test_precise_clock_fake_clock_fallback(void) {
+  gpr_timespec (*saved_now_impl)(gpr_clock_type) = gpr_now_impl;
+  gpr_now_impl = frozen_now;
+  gpr_precise_clock_init();
+#if GPR_CYCLE_COUNTER_RDTSC_64
+  GPR_ASSERT(!gpr_cycle_counter_is_tsc);
+  GPR_ASSERT(gpr_cycles_per_second() == GPR_NS_PER_SEC);
+  /* Cycles then come from the (frozen) monotonic clock. */
+  GPR_ASSERT(gpr_get_cycle_counter() == gpr_get_cycle_counter());
+#endif
+  gpr_now_impl = saved_now_impl;
+  gpr_precise_clock_init();
+}
+
+/* Without GRPC_TSC_CALIBRATION, the TSC is used only if the kernel says how
+   fast it runs; otherwise initialization must not busy-wait to measure it. */
+static void test_precise_clock_uncalibrated_fallback(void) {
+  GPR_GLOBAL_CONFIG_SET(grpc_tsc_calibration, false);
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_precise_clock_init();
+  gpr_timespec elapsed = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start);
+  GPR_ASSERT(gpr_cycles_per_second() > 0);
+#if GPR_CYCLE_COUNTER_RDTSC_64
+  if (gpr_cycle_counter_is_tsc) {
+    FILE* fp = fopen("/sys/devices/system/cpu/cpu0/tsc_freq_khz", "r");
+    GPR_ASSERT(fp != nullptr);
+    fclose(fp);
+  } else {
+    GPR_ASSERT(gpr_cycles_per_second() == GPR_NS_PER_SEC);
+    /* Calibration runs for at least 3ms. */
+    GPR_ASSERT(gpr_time_cmp(elapsed, gpr_time_from_millis(
+                                         3, GPR_TIMESPAN)) < 0);
+  }
+#else
+  (void)elapsed;
+#endif
+}
+
+/* Whichever source the cycle counter uses, it must agree with the monotonic
+   clock about how much time has passed. */
+static void test_precise_clock_tracks_monotonic_clock(void) {
+  gpr_precise_clock_init();
+  gpr_cycle_counter start_cycle = gpr_get_cycle_counter();
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_sleep_until(gpr_time_add(gpr_now(GPR_CLOCK_REALTIME),
+                               gpr_time_from_millis(50, GPR_TIMESPAN)));
+  gpr_cycle_counter end_cycle = gpr_get_cycle_counter();
+  gpr_timespec end = gpr_now(GPR_CLOCK_MONOTONIC);
+  double cycle_secs =
+      static_cast<double>(end_cycle - start_cycle) / gpr_cycles_per_second();
+  double clock_secs = gpr_timespec_to_micros(gpr_time_sub(end, start)) / 1e6;
+  GPR_ASSERT(cycle_secs > 0);
+  GPR_ASSERT(cycle_secs > clock_secs * 0.9 - 0.001);
+  GPR_ASSERT(cycle_secs < clock_secs * 1.1 + 0.001);
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(argc, argv);
 
@@ -263,5 +329,8 @@ int main(int argc, char* argv[]) {
   test_similar();
   test_convert_extreme();
   test_cmp_extreme();
+  test_precise_clock_fake_clock_fallback();
+  test_precise_clock_uncalibrated_fallback();
+  test_precise_clock_tracks_monotonic_clock();
   return 0;
 }
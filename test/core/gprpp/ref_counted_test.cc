@@ -70,6 +70,32 @@ TEST(RefCountedNonPolymorphic, ExtraRef) {
   foo->Unref();
 }
 
+class FooNonAtomic
+    : public RefCounted<FooNonAtomic, PolymorphicRefCount, NonAtomicRefCount> {
+};
+
+TEST(RefCountedNonAtomic, Basic) {
+  FooNonAtomic* foo = New<FooNonAtomic>();
+  foo->Unref();
+}
+
+TEST(RefCountedNonAtomic, ExtraRef) {
+  FooNonAtomic* foo = New<FooNonAtomic>();
+  RefCountedPtr<FooNonAtomic> foop = foo->Ref();
+  foop.release();
+  foo->Unref();
+  foo->Unref();
+}
+
+TEST(RefCountedNonAtomic, RefIfNonZero) {
+  NonAtomicRefCount refs(0);
+  EXPECT_FALSE(refs.RefIfNonZero());
+  refs.Ref();
+  EXPECT_TRUE(refs.RefIfNonZero());
+  EXPECT_FALSE(refs.Unref());
+  EXPECT_TRUE(refs.Unref());
+}
+
 // Note: We use DebugOnlyTraceFlag instead of TraceFlag to ensure that
 // things build properly in both debug and non-debug cases.
 DebugOnlyTraceFlag foo_tracer(true, "foo");
@@ -23,10 +23,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/cpu.h"
 #include "test/core/util/test_config.h"
 
 #define NUM_THREADS 100
@@ -91,11 +93,29 @@ static void test2(void) {
   }
 }
 
+static void thd_body3(void* v) {
+  *static_cast<unsigned*>(v) = gpr_cpu_numa_node_of_cpu(gpr_cpu_current_cpu());
+}
+
+/* Test that a thread bound to a NUMA node runs on a CPU of that node. */
+static void test3(void) {
+  for (unsigned node = 0; node < gpr_cpu_num_numa_nodes(); node++) {
+    unsigned ran_on = gpr_cpu_num_numa_nodes();
+    grpc_core::Thread th(
+        "grpc_thread_body3_test", &thd_body3, &ran_on, nullptr,
+        grpc_core::Thread::Options().set_numa_node(static_cast<int>(node)));
+    th.Start();
+    th.Join();
+    GPR_ASSERT(ran_on == node);
+  }
+}
+
 /* ------------------------------------------------- */
 
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(argc, argv);
   test1();
   test2();
+  test3();
   return 0;
 }
@@ -48,6 +48,28 @@ static void test_format_get_request(void) {
   grpc_slice_unref(slice);
 }
 
+static void test_format_get_request_keep_alive(void) {
+  grpc_httpcli_request req;
+  grpc_slice slice;
+
+  memset(&req, 0, sizeof(req));
+  req.host = const_cast<char*>("example.com");
+  req.http.path = const_cast<char*>("/index.html");
+  req.keep_alive = true;
+
+  slice = grpc_httpcli_format_get_request(&req);
+
+  GPR_ASSERT(0 == grpc_slice_str_cmp(slice,
+                                     "GET /index.html HTTP/1.0\r\n"
+                                     "Host: example.com\r\n"
+                                     "Connection: keep-alive\r\n"
+                                     "User-Agent: " GRPC_HTTPCLI_USER_AGENT
+                                     "\r\n"
+                                     "\r\n"));
+
+  grpc_slice_unref(slice);
+}
+
 static void test_format_post_request(void) {
   grpc_http_header hdr = {const_cast<char*>("x-yz"), const_cast<char*>("abc")};
   grpc_httpcli_request req;
@@ -142,6 +164,7 @@ int main(int argc, char** argv) {
   grpc_init();
 
   test_format_get_request();
+  test_format_get_request_keep_alive();
   test_format_post_request();
   test_format_post_request_no_body();
   test_format_post_request_content_type_override();
@@ -18,12 +18,15 @@
 
 #include "src/core/lib/iomgr/combiner.h"
 
+#include <string.h>
+
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "test/core/util/test_config.h"
 
 static void test_no_op(void) {
@@ -143,6 +146,71 @@ static void test_execute_finally(void) {
   GRPC_COMBINER_UNREF(lock, "test_execute_finally");
 }
 
+static void check_on_control_plane_executor(void* value, grpc_error* error) {
+  GPR_ASSERT(grpc_core::Executor::IsExecutorThread(
+      grpc_core::ExecutorType::CONTROL_PLANE));
+  gpr_event_set(static_cast<gpr_event*>(value), (void*)1);
+}
+
+static void test_execute_on_control_plane_executor(void) {
+  gpr_log(GPR_DEBUG, "test_execute_on_control_plane_executor");
+
+  grpc_combiner* lock = grpc_combiner_create_control_plane();
+  gpr_event done;
+  gpr_event_init(&done);
+  grpc_core::ExecCtx exec_ctx;
+  GRPC_CLOSURE_SCHED(GRPC_CLOSURE_CREATE(check_on_control_plane_executor,
+                                         &done, grpc_combiner_scheduler(lock)),
+                     GRPC_ERROR_NONE);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(gpr_event_wait(&done, grpc_timeout_seconds_to_deadline(5)) !=
+             nullptr);
+  GRPC_COMBINER_UNREF(lock, "test_execute_on_control_plane_executor");
+}
+
+typedef struct {
+  char* order;
+  char name;
+} priority_args;
+
+static void record_order(void* a, grpc_error* error) {
+  priority_args* args = static_cast<priority_args*>(a);
+  size_t len = strlen(args->order);
+  args->order[len] = args->name;
+  args->order[len + 1] = '\0';
+}
+
+static void test_execute_urgent(void) {
+  gpr_log(GPR_DEBUG, "test_execute_urgent");
+
+  grpc_combiner* lock = grpc_combiner_create();
+  char order[8] = "";
+  priority_args background = {order, 'b'};
+  priority_args normal = {order, 'n'};
+  priority_args urgent_combiner = {order, 'c'};
+  priority_args urgent = {order, 'u'};
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GRPC_CLOSURE_SCHED(
+        GRPC_CLOSURE_CREATE(record_order, &background,
+                            grpc_schedule_on_exec_ctx_background),
+        GRPC_ERROR_NONE);
+    GRPC_CLOSURE_SCHED(GRPC_CLOSURE_CREATE(record_order, &normal,
+                                           grpc_schedule_on_exec_ctx),
+                       GRPC_ERROR_NONE);
+    GRPC_CLOSURE_SCHED(
+        GRPC_CLOSURE_CREATE(record_order, &urgent_combiner,
+                            grpc_combiner_urgent_scheduler(lock)),
+        GRPC_ERROR_NONE);
+    GRPC_CLOSURE_SCHED(GRPC_CLOSURE_CREATE(record_order, &urgent,
+                                           grpc_schedule_on_exec_ctx_urgent),
+                       GRPC_ERROR_NONE);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  GPR_ASSERT(strcmp(order, "ucnb") == 0);
+  GRPC_COMBINER_UNREF(lock, "test_execute_urgent");
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -150,6 +218,8 @@ int main(int argc, char** argv) {
   test_execute_one();
   test_execute_finally();
   test_execute_many();
+  test_execute_on_control_plane_executor();
+  test_execute_urgent();
   grpc_shutdown();
 
   return 0;
@@ -104,6 +104,38 @@ static void test_copy_and_unref() {
   GRPC_ERROR_UNREF(error3);
 }
 
+static grpc_error* immortal_error() {
+  return GRPC_ERROR_IMMORTAL(
+      grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Immortal"),
+                         GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_ABORTED));
+}
+
+static void test_immortal() {
+  grpc_error* error1 = immortal_error();
+  // every use returns the same error, and unrefs never destroy it
+  grpc_error* error2 = immortal_error();
+  GPR_ASSERT(error1 == error2);
+  GRPC_ERROR_UNREF(error1);
+  GRPC_ERROR_UNREF(error2);
+  GRPC_ERROR_UNREF(GRPC_ERROR_REF(error1));
+  intptr_t i;
+  GPR_ASSERT(grpc_error_get_int(error1, GRPC_ERROR_INT_GRPC_STATUS, &i));
+  GPR_ASSERT(i == GRPC_STATUS_ABORTED);
+
+  // setting a property copies it, even though the caller holds the only ref
+  grpc_error* error3 =
+      grpc_error_set_int(immortal_error(), GRPC_ERROR_INT_OFFSET, 1);
+  GPR_ASSERT(error3 != error1);
+  GPR_ASSERT(grpc_error_get_int(error3, GRPC_ERROR_INT_GRPC_STATUS, &i));
+  GPR_ASSERT(i == GRPC_STATUS_ABORTED);
+  GPR_ASSERT(grpc_error_get_int(error3, GRPC_ERROR_INT_OFFSET, &i));
+  GPR_ASSERT(!grpc_error_get_int(error1, GRPC_ERROR_INT_OFFSET, &i));
+  GRPC_ERROR_UNREF(error3);
+
+  GPR_ASSERT(strstr(grpc_error_string(error1), "\"Immortal\"") != nullptr);
+  GPR_ASSERT(strstr(grpc_error_string(error1), "created") == nullptr);
+}
+
 static void test_create_referencing() {
   grpc_error* child = grpc_error_set_str(
       GRPC_ERROR_CREATE_FROM_STATIC_STRING("Child"),
@@ -220,6 +252,7 @@ int main(int argc, char** argv) {
   test_set_get_int();
   test_set_get_str();
   test_copy_and_unref();
+  test_immortal();
   print_error_string();
   print_error_string_reference();
   test_os_error();
@@ -0,0 +1,178 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Runs the default executor with GRPC_EXECUTOR_WORK_STEALING enabled. */
+
+#include "src/core/lib/iomgr/executor.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "test/core/util/test_config.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_executor_work_stealing);
+
+static grpc_closure_scheduler* short_scheduler(void) {
+  return grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::SHORT);
+}
+
+static gpr_atm get_steals(void) {
+  grpc_stats_data stats;
+  grpc_stats_collect(&stats);
+  return stats.counters[GRPC_STATS_COUNTER_EXECUTOR_STEALS];
+}
+
+typedef struct {
+  gpr_event started;
+  gpr_event release;
+  gpr_event finished;
+} blocker;
+
+static void block(void* arg, grpc_error* error) {
+  blocker* b = static_cast<blocker*>(arg);
+  gpr_event_set(&b->started, (void*)1);
+  GPR_ASSERT(gpr_event_wait(&b->release, grpc_timeout_seconds_to_deadline(
+                                             10)) != nullptr);
+  gpr_event_set(&b->finished, (void*)1);
+}
+
+typedef struct {
+  gpr_atm ran;
+  gpr_atm remaining;
+  gpr_event* done;
+} counted_closure;
+
+static void count_run(void* arg, grpc_error* error) {
+  counted_closure* c = static_cast<counted_closure*>(arg);
+  gpr_atm_no_barrier_fetch_add(&c->ran, 1);
+  if (gpr_atm_full_fetch_add(&c->remaining, -1) == 1) {
+    gpr_event_set(c->done, (void*)1);
+  }
+}
+
+/* Closures queued behind a thread stuck in a closure are picked up by the
+   thread that the queue depth starts, before the stuck one is released. */
+static void test_steals_from_busy_thread(void) {
+  gpr_log(GPR_DEBUG, "test_steals_from_busy_thread");
+  const gpr_atm steals_before = get_steals();
+  blocker b;
+  gpr_event_init(&b.started);
+  gpr_event_init(&b.release);
+  gpr_event_init(&b.finished);
+  grpc_closure block_closure;
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GRPC_CLOSURE_SCHED(
+        GRPC_CLOSURE_INIT(&block_closure, block, &b, short_scheduler()),
+        GRPC_ERROR_NONE);
+  }
+  GPR_ASSERT(gpr_event_wait(&b.started, grpc_timeout_seconds_to_deadline(5)) !=
+             nullptr);
+
+  const size_t kNumClosures = 3;
+  gpr_event done;
+  gpr_event_init(&done);
+  counted_closure counted;
+  gpr_atm_rel_store(&counted.ran, 0);
+  gpr_atm_rel_store(&counted.remaining, kNumClosures);
+  counted.done = &done;
+  grpc_closure closures[kNumClosures];
+  {
+    /* The only thread running so far is the one stuck in the blocker, so
+       every closure is queued behind it */
+    grpc_core::ExecCtx exec_ctx;
+    for (size_t i = 0; i < kNumClosures; i++) {
+      GRPC_CLOSURE_SCHED(GRPC_CLOSURE_INIT(&closures[i], count_run, &counted,
+                                           short_scheduler()),
+                         GRPC_ERROR_NONE);
+    }
+  }
+  GPR_ASSERT(gpr_event_wait(&done, grpc_timeout_seconds_to_deadline(5)) !=
+             nullptr);
+  GPR_ASSERT(gpr_atm_acq_load(&counted.ran) ==
+             static_cast<gpr_atm>(kNumClosures));
+  GPR_ASSERT(get_steals() - steals_before >=
+             static_cast<gpr_atm>(kNumClosures));
+  gpr_event_set(&b.release, (void*)1);
+  GPR_ASSERT(gpr_event_wait(&b.finished, grpc_timeout_seconds_to_deadline(
+                                             5)) != nullptr);
+}
+
+typedef struct {
+  counted_closure* counted;
+  grpc_closure closure;
+  grpc_closure child;
+} fan_out_arg;
+
+static void fan_out(void* arg, grpc_error* error) {
+  fan_out_arg* a = static_cast<fan_out_arg*>(arg);
+  /* Scheduled from an executor thread: queued on that thread first */
+  GRPC_CLOSURE_SCHED(
+      GRPC_CLOSURE_INIT(&a->child, count_run, a->counted, short_scheduler()),
+      GRPC_ERROR_NONE);
+}
+
+/* Each closure runs exactly once whether it is run by the thread it was
+   queued on or stolen by another one. */
+static void test_runs_each_closure_once(void) {
+  gpr_log(GPR_DEBUG, "test_runs_each_closure_once");
+  const size_t kNumClosures = 1000;
+  gpr_event done;
+  gpr_event_init(&done);
+  counted_closure counted;
+  gpr_atm_rel_store(&counted.ran, 0);
+  gpr_atm_rel_store(&counted.remaining, 2 * kNumClosures);
+  counted.done = &done;
+  grpc_closure* closures =
+      static_cast<grpc_closure*>(gpr_malloc(sizeof(*closures) * kNumClosures));
+  fan_out_arg* fan_out_args = static_cast<fan_out_arg*>(
+      gpr_malloc(sizeof(*fan_out_args) * kNumClosures));
+  {
+    grpc_core::ExecCtx exec_ctx;
+    for (size_t i = 0; i < kNumClosures; i++) {
+      GRPC_CLOSURE_SCHED(GRPC_CLOSURE_INIT(&closures[i], count_run, &counted,
+                                           short_scheduler()),
+                         GRPC_ERROR_NONE);
+      fan_out_args[i].counted = &counted;
+      GRPC_CLOSURE_SCHED(
+          GRPC_CLOSURE_INIT(&fan_out_args[i].closure, fan_out, &fan_out_args[i],
+                            short_scheduler()),
+          GRPC_ERROR_NONE);
+    }
+  }
+  GPR_ASSERT(gpr_event_wait(&done, grpc_timeout_seconds_to_deadline(10)) !=
+             nullptr);
+  GPR_ASSERT(gpr_atm_acq_load(&counted.ran) ==
+             static_cast<gpr_atm>(2 * kNumClosures));
+  gpr_free(fan_out_args);
+  gpr_free(closures);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_executor_work_stealing, true);
+  grpc_init();
+  test_steals_from_busy_thread();
+  test_runs_each_closure_once();
+  grpc_shutdown();
+  return 0;
+}
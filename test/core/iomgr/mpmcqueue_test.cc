@@ -38,7 +38,7 @@ struct WorkItem {
 // produced items on destructing.
 class ProducerThread {
  public:
-  ProducerThread(grpc_core::InfLenFIFOQueue* queue, int start_index,
+  ProducerThread(grpc_core::MPMCQueueInterface* queue, int start_index,
                  int num_items)
       : start_index_(start_index), num_items_(num_items), queue_(queue) {
     items_ = nullptr;
@@ -69,7 +69,7 @@ class ProducerThread {
 
   int start_index_;
   int num_items_;
-  grpc_core::InfLenFIFOQueue* queue_;
+  grpc_core::MPMCQueueInterface* queue_;
   grpc_core::Thread thd_;
   WorkItem** items_;
 };
@@ -77,7 +77,7 @@ class ProducerThread {
 // Thread to pull out items from queue
 class ConsumerThread {
  public:
-  ConsumerThread(grpc_core::InfLenFIFOQueue* queue) : queue_(queue) {
+  ConsumerThread(grpc_core::MPMCQueueInterface* queue) : queue_(queue) {
     thd_ = grpc_core::Thread(
         "mpmcq_test_consumer_thd",
         [](void* th) { static_cast<ConsumerThread*>(th)->Run(); }, this);
@@ -101,13 +101,14 @@ class ConsumerThread {
 
     gpr_log(GPR_DEBUG, "ConsumerThread: %d times of Get() called.", count);
   }
-  grpc_core::InfLenFIFOQueue* queue_;
+  grpc_core::MPMCQueueInterface* queue_;
   grpc_core::Thread thd_;
 };
 
-static void test_FIFO(void) {
-  gpr_log(GPR_INFO, "test_FIFO");
-  grpc_core::InfLenFIFOQueue large_queue;
+template <class Queue>
+static void test_FIFO(const char* queue_name) {
+  gpr_log(GPR_INFO, "test_FIFO %s", queue_name);
+  Queue large_queue;
   for (int i = 0; i < TEST_NUM_ITEMS; ++i) {
     large_queue.Put(static_cast<void*>(grpc_core::New<WorkItem>(i)));
   }
@@ -170,11 +171,51 @@ static void test_space_efficiency(void) {
   gpr_log(GPR_DEBUG, "Done.");
 }
 
-static void test_many_thread(void) {
-  gpr_log(GPR_INFO, "test_many_thread");
+// Test that LockFreeMPMCQueue keeps FIFO order and its count while elements
+// go through the overflow list (ring full) and back to the ring (drained).
+static void test_lock_free_overflow(void) {
+  gpr_log(GPR_INFO, "test_lock_free_overflow");
+  grpc_core::LockFreeMPMCQueue queue(16);
+  GPR_ASSERT(queue.ring_size() == 16);
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 100; ++i) {
+      queue.Put(static_cast<void*>(grpc_core::New<WorkItem>(i)));
+    }
+    GPR_ASSERT(queue.count() == 100);
+    for (int i = 0; i < 100; ++i) {
+      WorkItem* item = static_cast<WorkItem*>(queue.Get());
+      GPR_ASSERT(i == item->index);
+      grpc_core::Delete(item);
+    }
+    GPR_ASSERT(queue.count() == 0);
+  }
+  // Interleaved puts and gets around the ring boundary.
+  int next_put = 0;
+  int next_get = 0;
+  while (next_get < 1000) {
+    for (int i = 0; i < 20; ++i) {
+      queue.Put(static_cast<void*>(grpc_core::New<WorkItem>(next_put++)));
+    }
+    for (int i = 0; i < 17; ++i) {
+      WorkItem* item = static_cast<WorkItem*>(queue.Get());
+      GPR_ASSERT(next_get++ == item->index);
+      grpc_core::Delete(item);
+    }
+  }
+  while (next_get < next_put) {
+    WorkItem* item = static_cast<WorkItem*>(queue.Get());
+    GPR_ASSERT(next_get++ == item->index);
+    grpc_core::Delete(item);
+  }
+  GPR_ASSERT(queue.count() == 0);
+}
+
+template <class Queue>
+static void test_many_thread(const char* queue_name) {
+  gpr_log(GPR_INFO, "test_many_thread %s", queue_name);
   const int num_producer_threads = 10;
   const int num_consumer_threads = 20;
-  grpc_core::InfLenFIFOQueue queue;
+  Queue queue;
   ProducerThread** producer_threads = static_cast<ProducerThread**>(
       gpr_zalloc(num_producer_threads * sizeof(ProducerThread*)));
   ConsumerThread** consumer_threads = static_cast<ConsumerThread**>(
@@ -222,9 +263,12 @@ static void test_many_thread(void) {
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
-  test_FIFO();
+  test_FIFO<grpc_core::InfLenFIFOQueue>("InfLenFIFOQueue");
+  test_FIFO<grpc_core::LockFreeMPMCQueue>("LockFreeMPMCQueue");
   test_space_efficiency();
-  test_many_thread();
+  test_lock_free_overflow();
+  test_many_thread<grpc_core::InfLenFIFOQueue>("InfLenFIFOQueue");
+  test_many_thread<grpc_core::LockFreeMPMCQueue>("LockFreeMPMCQueue");
   grpc_shutdown();
   return 0;
 }
@@ -21,6 +21,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/test_config.h"
@@ -144,6 +145,29 @@ static void test_instant_alloc_free_pair(void) {
   destroy_user(usr);
 }
 
+static void test_safe_alloc_up_to_quota_size(void) {
+  gpr_log(GPR_INFO, "** test_safe_alloc_up_to_quota_size **");
+  grpc_resource_quota* q =
+      grpc_resource_quota_create("test_safe_alloc_up_to_quota_size");
+  grpc_resource_quota_resize(q, 1024 * 1024);
+  grpc_resource_user* usr = grpc_resource_user_create(q, "usr");
+  {
+    grpc_core::ExecCtx exec_ctx;
+    // leaves credit cached with sharded accounting
+    for (int i = 0; i < 16; i++) {
+      grpc_resource_user_alloc(usr, 1024, nullptr);
+    }
+    grpc_resource_user_free(usr, 16 * 1024);
+    GPR_ASSERT(grpc_resource_user_safe_alloc(usr, 1024 * 1024));
+    GPR_ASSERT(!grpc_resource_user_safe_alloc(usr, 1));
+    grpc_resource_user_free(usr, 1024 * 1024);
+    GPR_ASSERT(grpc_resource_user_safe_alloc(usr, 1));
+    grpc_resource_user_free(usr, 1);
+  }
+  grpc_resource_quota_unref(q);
+  destroy_user(usr);
+}
+
 static void test_simple_async_alloc(void) {
   gpr_log(GPR_INFO, "** test_simple_async_alloc **");
   grpc_resource_quota* q =
@@ -900,6 +924,7 @@ int main(int argc, char** argv) {
   test_resource_user_no_op();
   test_instant_alloc_then_free();
   test_instant_alloc_free_pair();
+  test_safe_alloc_up_to_quota_size();
   test_simple_async_alloc();
   test_async_alloc_blocked_by_size();
   test_scavenge();
@@ -924,6 +949,23 @@ int main(int argc, char** argv) {
   test_thread_limit();
   test_thread_maxquota_change();
 
+  grpc_shutdown();
+
+  // Memory accounting through per CPU credit caches
+  GPR_GLOBAL_CONFIG_SET(grpc_resource_quota_sharded_accounting, true);
+  grpc_init();
+  gpr_mu_init(&g_mu);
+  gpr_cv_init(&g_cv);
+  test_instant_alloc_then_free();
+  test_instant_alloc_free_pair();
+  test_safe_alloc_up_to_quota_size();
+  test_simple_async_alloc();
+  test_async_alloc_blocked_by_size();
+  test_scavenge();
+  test_one_slice();
+  test_negative_rq_free_pool();
+  gpr_mu_destroy(&g_mu);
+  gpr_cv_destroy(&g_cv);
   grpc_shutdown();
   return 0;
 }
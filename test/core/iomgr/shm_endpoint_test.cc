@@ -0,0 +1,137 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/port.h"
+
+// This test only works with eventfd
+#ifdef GRPC_LINUX_EVENTFD
+
+#include "src/core/lib/iomgr/endpoint_shm_posix.h"
+
+#include <string.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/shm_ring.h"
+#include "test/core/iomgr/endpoint_tests.h"
+#include "test/core/util/test_config.h"
+
+static gpr_mu* g_mu;
+static grpc_pollset* g_pollset;
+
+/* Data written and read in chunks that straddle the end of the ring comes out
+   in order, and the ring reports full and empty as it should. */
+static void test_ring_wraps_around(void) {
+  grpc_core::ShmRing::Header header;
+  memset(&header, 0, sizeof(header));
+  uint8_t data[64];
+  grpc_core::ShmRing ring(&header, data, sizeof(data));
+  uint8_t in[40];
+  uint8_t out[40];
+  uint8_t next_in = 0;
+  uint8_t next_out = 0;
+  for (int i = 0; i < 100; i++) {
+    for (size_t j = 0; j < sizeof(in); j++) in[j] = next_in + j;
+    next_in += ring.Write(in, sizeof(in));
+    GPR_ASSERT(ring.Writable() + ring.Readable() == sizeof(data));
+    size_t n = ring.Read(out, 13 + i % 20);
+    for (size_t j = 0; j < n; j++) GPR_ASSERT(out[j] == next_out++);
+  }
+  while (ring.Readable() > 0) {
+    size_t n = ring.Read(out, sizeof(out));
+    for (size_t j = 0; j < n; j++) GPR_ASSERT(out[j] == next_out++);
+  }
+  GPR_ASSERT(next_out == next_in);
+  GPR_ASSERT(ring.Write(in, 0) == 0);
+  GPR_ASSERT(ring.Read(out, sizeof(out)) == 0);
+}
+
+/* Waiting sides are woken exactly when the other side makes progress. */
+static void test_ring_wakeups(void) {
+  grpc_core::ShmRing::Header header;
+  memset(&header, 0, sizeof(header));
+  uint8_t data[16];
+  grpc_core::ShmRing ring(&header, data, sizeof(data));
+  uint8_t buf[16] = {};
+  GPR_ASSERT(!ring.TakeReaderWaiting());
+  GPR_ASSERT(ring.PrepareToWaitForData());
+  GPR_ASSERT(ring.Write(buf, sizeof(buf)) == sizeof(buf));
+  GPR_ASSERT(ring.TakeReaderWaiting());
+  GPR_ASSERT(!ring.TakeReaderWaiting());
+  GPR_ASSERT(ring.PrepareToWaitForSpace());
+  GPR_ASSERT(!ring.PrepareToWaitForData());
+  GPR_ASSERT(ring.Read(buf, 1) == 1);
+  GPR_ASSERT(ring.TakeWriterWaiting());
+  GPR_ASSERT(!ring.PrepareToWaitForSpace());
+  ring.Close();
+  GPR_ASSERT(ring.closed());
+  GPR_ASSERT(ring.Read(buf, sizeof(buf)) == sizeof(buf) - 1);
+  GPR_ASSERT(!ring.PrepareToWaitForData());
+}
+
+static void clean_up(void) {}
+
+/* A small ring, so that writes fill it and wait for the reader. */
+static grpc_endpoint_test_fixture create_fixture_shm_endpoint_pair(
+    size_t slice_size) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_endpoint_test_fixture f;
+  grpc_endpoint_pair p = grpc_shm_endpoint_pair_create("test", 4096, nullptr);
+  f.client_ep = p.client;
+  f.server_ep = p.server;
+  grpc_endpoint_add_to_pollset(f.client_ep, g_pollset);
+  grpc_endpoint_add_to_pollset(f.server_ep, g_pollset);
+  return f;
+}
+
+static grpc_endpoint_test_config configs[] = {
+    {"shm/shm_endpoint_pair", create_fixture_shm_endpoint_pair, clean_up},
+};
+
+static void destroy_pollset(void* p, grpc_error* error) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+int main(int argc, char** argv) {
+  grpc_closure destroyed;
+  grpc::testing::TestEnvironment env(argc, argv);
+  test_ring_wraps_around();
+  test_ring_wakeups();
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(g_pollset, &g_mu);
+    grpc_endpoint_tests(configs[0], g_pollset, g_mu);
+    GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                      grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(g_pollset, &destroyed);
+  }
+  grpc_shutdown();
+  gpr_free(g_pollset);
+
+  return 0;
+}
+
+#else /* GRPC_LINUX_EVENTFD */
+
+int main(int argc, char** argv) { return 0; }
+
+#endif /* GRPC_LINUX_EVENTFD */
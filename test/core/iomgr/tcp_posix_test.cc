@@ -151,6 +151,7 @@ struct read_socket_state {
   grpc_endpoint* ep;
   size_t read_bytes;
   size_t target_read_bytes;
+  size_t first_read_bytes;
   grpc_slice_buffer incoming;
   grpc_closure read_cb;
 };
@@ -183,6 +184,9 @@ static void read_cb(void* user_data, grpc_error* error) {
   current_data = state->read_bytes % 256;
   read_bytes = count_slices(state->incoming.slices, state->incoming.count,
                             &current_data);
+  if (state->read_bytes == 0) {
+    state->first_read_bytes = read_bytes;
+  }
   state->read_bytes += read_bytes;
   gpr_log(GPR_INFO, "Read %" PRIuPTR " bytes of %" PRIuPTR, read_bytes,
           state->target_read_bytes);
@@ -249,8 +253,9 @@ static void read_test(size_t num_bytes, size_t slice_size) {
 }
 
 /* Write to a socket until it fills up, then read from it using the grpc_tcp
-   API. */
-static void large_read_test(size_t slice_size) {
+   API. If read_hint is set, the endpoint is told that much is on its way
+   before the first read, which should then take more than slice_size. */
+static void large_read_test(size_t slice_size, bool read_hint) {
   int sv[2];
   grpc_endpoint* ep;
   struct read_socket_state state;
@@ -259,7 +264,8 @@ static void large_read_test(size_t slice_size) {
       grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
   grpc_core::ExecCtx exec_ctx;
 
-  gpr_log(GPR_INFO, "Start large read test, slice size %" PRIuPTR, slice_size);
+  gpr_log(GPR_INFO, "Start large read test, slice size %" PRIuPTR ", hint %d",
+          slice_size, read_hint);
 
   create_sockets(sv);
 
@@ -281,6 +287,9 @@ static void large_read_test(size_t slice_size) {
   grpc_slice_buffer_init(&state.incoming);
   GRPC_CLOSURE_INIT(&state.read_cb, read_cb, &state, grpc_schedule_on_exec_ctx);
 
+  if (read_hint) {
+    grpc_endpoint_set_read_hint(ep, state.target_read_bytes);
+  }
   grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false);
 
   gpr_mu_lock(g_mu);
@@ -293,6 +302,9 @@ static void large_read_test(size_t slice_size) {
     gpr_mu_lock(g_mu);
   }
   GPR_ASSERT(state.read_bytes == state.target_read_bytes);
+  if (read_hint) {
+    GPR_ASSERT(state.first_read_bytes > slice_size);
+  }
   gpr_mu_unlock(g_mu);
 
   grpc_slice_buffer_destroy_internal(&state.incoming);
@@ -395,9 +407,12 @@ void timestamps_verifier(void* arg, grpc_core::Timestamps* ts,
 /* Write to a socket using the grpc_tcp API, then drain it directly.
    Note that if the write does not complete immediately we need to drain the
    socket in parallel with the read. If collect_timestamps is true, it will
-   try to get timestamps for the write. */
+   try to get timestamps for the write. If zerocopy is true, the endpoint is
+   created with tx zerocopy enabled. If cork is true, it is created with
+   GRPC_ARG_TCP_CORK_WRITES. */
 static void write_test(size_t num_bytes, size_t slice_size,
-                       bool collect_timestamps) {
+                       bool collect_timestamps, bool zerocopy = false,
+                       bool cork = false) {
   int sv[2];
   grpc_endpoint* ep;
   struct write_socket_state state;
@@ -410,27 +425,39 @@ static void write_test(size_t num_bytes, size_t slice_size,
       grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
   grpc_core::ExecCtx exec_ctx;
 
-  if (collect_timestamps && !grpc_event_engine_can_track_errors()) {
+  if ((collect_timestamps || zerocopy) &&
+      !grpc_event_engine_can_track_errors()) {
     return;
   }
 
   gpr_log(GPR_INFO,
-          "Start write test with %" PRIuPTR " bytes, slice size %" PRIuPTR,
-          num_bytes, slice_size);
+          "Start write test with %" PRIuPTR " bytes, slice size %" PRIuPTR
+          ", zerocopy %d, cork %d",
+          num_bytes, slice_size, zerocopy, cork);
 
-  if (collect_timestamps) {
+  if (collect_timestamps || zerocopy || cork) {
     create_inet_sockets(sv);
   } else {
     create_sockets(sv);
   }
 
-  grpc_arg a[1];
+  grpc_arg a[4];
   a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
   a[0].type = GRPC_ARG_INTEGER,
   a[0].value.integer = static_cast<int>(slice_size);
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = zerocopy;
+  a[2].key = const_cast<char*>(GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD);
+  a[2].type = GRPC_ARG_INTEGER;
+  a[2].value.integer = 1024;
+  a[3].key = const_cast<char*>(GRPC_ARG_TCP_CORK_WRITES);
+  a[3].type = GRPC_ARG_INTEGER;
+  a[3].value.integer = cork;
   grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
-  ep = grpc_tcp_create(grpc_fd_create(sv[1], "write_test", collect_timestamps),
-                       &args, "test");
+  ep = grpc_tcp_create(
+      grpc_fd_create(sv[1], "write_test", collect_timestamps || zerocopy),
+      &args, "test");
   grpc_endpoint_add_to_pollset(ep, g_pollset);
 
   state.ep = ep;
@@ -564,8 +591,9 @@ void run_tests(void) {
   read_test(10000, 8192);
   read_test(10000, 137);
   read_test(10000, 1);
-  large_read_test(8192);
-  large_read_test(1);
+  large_read_test(8192, false);
+  large_read_test(1, false);
+  large_read_test(8192, true);
 
   write_test(100, 8192, false);
   write_test(100, 1, false);
@@ -579,6 +607,16 @@ void run_tests(void) {
   write_test(100000, 1, true);
   write_test(100, 137, true);
 
+  write_test(100, 8192, false, true);
+  write_test(100000, 8192, false, true);
+  write_test(100000, 1, false, true);
+  write_test(1000000, 65536, false, true);
+
+  /* more slices than fit in one sendmsg, so all but the last are corked */
+  write_test(100, 8192, false, false, true);
+  write_test(100000, 1, false, false, true);
+  write_test(100000, 137, false, false, true);
+
   for (i = 1; i < 1000; i = GPR_MAX(i + 1, i * 5 / 4)) {
     write_test(40320, i, false);
     write_test(40320, i, true);
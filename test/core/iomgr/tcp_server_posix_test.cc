@@ -432,6 +432,12 @@ int main(int argc, char** argv) {
   chan_args[0].key = const_cast<char*>(GRPC_ARG_EXPAND_WILDCARD_ADDRS);
   chan_args[0].value.integer = 1;
   const grpc_channel_args channel_args = {1, chan_args};
+  grpc_arg offload_chan_args[1];
+  offload_chan_args[0].type = GRPC_ARG_INTEGER;
+  offload_chan_args[0].key =
+      const_cast<char*>(GRPC_ARG_TCP_SERVER_OFFLOAD_ACCEPT);
+  offload_chan_args[0].value.integer = 1;
+  const grpc_channel_args offload_channel_args = {1, offload_chan_args};
   struct ifaddrs* ifa = nullptr;
   struct ifaddrs* ifa_it;
   // Zalloc dst_addrs to avoid oversized frames.
@@ -485,6 +491,8 @@ int main(int argc, char** argv) {
     /* Connect to same addresses as listeners. */
     test_connect(1, nullptr, nullptr, false);
     test_connect(10, nullptr, nullptr, false);
+    /* Same, with connections set up on the executor. */
+    test_connect(10, &offload_channel_args, nullptr, false);
 
     /* Set dst_addrs->addrs[i].len=0 for dst_addrs that are unreachable with a
        "::" listener. */
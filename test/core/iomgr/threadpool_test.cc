@@ -108,11 +108,12 @@ class WorkThread {
   grpc_core::Thread thd_;
 };
 
-static void test_multi_add(void) {
+static void test_multi_add(grpc_core::ThreadPool::QueueType queue_type) {
   gpr_log(GPR_INFO, "test_multi_add");
   const int num_work_thds = 10;
   grpc_core::ThreadPool* pool = grpc_core::New<grpc_core::ThreadPool>(
-      kLargeThreadPoolSize, "test_multi_add");
+      kLargeThreadPoolSize, "test_multi_add", grpc_core::Thread::Options(),
+      queue_type);
   SimpleFunctorForAdd* functor = grpc_core::New<SimpleFunctorForAdd>();
   WorkThread** work_thds = static_cast<WorkThread**>(
       gpr_zalloc(sizeof(WorkThread*) * num_work_thds));
@@ -157,11 +158,11 @@ class SimpleFunctorCheckForAdd
   int* count_;
 };
 
-static void test_one_thread_FIFO(void) {
+static void test_one_thread_FIFO(grpc_core::ThreadPool::QueueType queue_type) {
   gpr_log(GPR_INFO, "test_one_thread_FIFO");
   int counter = 0;
-  grpc_core::ThreadPool* pool =
-      grpc_core::New<grpc_core::ThreadPool>(1, "test_one_thread_FIFO");
+  grpc_core::ThreadPool* pool = grpc_core::New<grpc_core::ThreadPool>(
+      1, "test_one_thread_FIFO", grpc_core::Thread::Options(), queue_type);
   SimpleFunctorCheckForAdd** check_functors =
       static_cast<SimpleFunctorCheckForAdd**>(
           gpr_zalloc(sizeof(SimpleFunctorCheckForAdd*) * kThreadSmallIter));
@@ -185,8 +186,10 @@ int main(int argc, char** argv) {
   test_size_zero();
   test_constructor_option();
   test_add();
-  test_multi_add();
-  test_one_thread_FIFO();
+  test_multi_add(grpc_core::ThreadPool::QueueType::kInfLenFIFO);
+  test_multi_add(grpc_core::ThreadPool::QueueType::kLockFree);
+  test_one_thread_FIFO(grpc_core::ThreadPool::QueueType::kInfLenFIFO);
+  test_one_thread_FIFO(grpc_core::ThreadPool::QueueType::kLockFree);
   grpc_shutdown();
   return 0;
 }
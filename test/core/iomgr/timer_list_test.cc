@@ -29,6 +29,7 @@
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "test/core/util/test_config.h"
 #include "test/core/util/tracer_util.h"
 
@@ -36,6 +37,8 @@
 
 extern grpc_core::TraceFlag grpc_timer_trace;
 extern grpc_core::TraceFlag grpc_timer_check_trace;
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
 
 static int cb_called[MAX_CB][2];
 static const int64_t kMillisIn25Days = 2160000000;
@@ -218,42 +221,90 @@ void long_running_service_cleanup_test(void) {
   GPR_ASSERT(1 == cb_called[3][0]);
 }
 
+/* ExecCtx::Now() extrapolates from the cycle counter between reads of the
+   monotonic clock; it must never step back and must stay within a
+   millisecond of the clock. */
+static void now_test(void) {
+  gpr_log(GPR_INFO, "now_test");
+  grpc_core::ExecCtx exec_ctx;
+  grpc_millis last = 0;
+  int samples = 0;
+  int lagging = 0;
+  gpr_timespec end = gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                                  gpr_time_from_millis(200, GPR_TIMESPAN));
+  while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), end) < 0) {
+    grpc_millis before =
+        grpc_timespec_to_millis_round_down(gpr_now(GPR_CLOCK_MONOTONIC));
+    exec_ctx.InvalidateNow();
+    grpc_millis now = exec_ctx.Now();
+    grpc_millis after =
+        grpc_timespec_to_millis_round_down(gpr_now(GPR_CLOCK_MONOTONIC));
+    GPR_ASSERT(now >= last);
+    GPR_ASSERT(now >= before - 1);
+    GPR_ASSERT(now <= after + 1);
+    if (now < before) lagging++;
+    samples++;
+    last = now;
+  }
+  /* Only cycle counter drift may make Now() trail the clock; a lost
+     fraction of a millisecond would do so about half of the time. */
+  gpr_log(GPR_INFO, "%d of %d samples trailed the clock", lagging, samples);
+  GPR_ASSERT(samples > 0);
+  GPR_ASSERT(lagging * 10 < samples);
+}
+
 int main(int argc, char** argv) {
-  /* Tests with default g_start_time */
+  /* Measure the cycle counter if need be, so that Now() extrapolates */
   {
     grpc::testing::TestEnvironment env(argc, argv);
+    GPR_GLOBAL_CONFIG_SET(grpc_tsc_calibration, true);
+    gpr_precise_clock_init();
     grpc_core::ExecCtx::GlobalInit();
-    grpc_core::ExecCtx exec_ctx;
-    grpc_determine_iomgr_platform();
-    grpc_iomgr_platform_init();
-    gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
-    add_test();
-    destruction_test();
-    grpc_iomgr_platform_shutdown();
+    now_test();
+    grpc_core::ExecCtx::GlobalShutdown();
   }
-  grpc_core::ExecCtx::GlobalShutdown();
-
-  /* Begin long running service tests */
-  {
-    grpc::testing::TestEnvironment env(argc, argv);
-    /* Set g_start_time back 25 days. */
-    /* We set g_start_time here in case there are any initialization
-        dependencies that use g_start_time. */
-    gpr_timespec new_start =
-        gpr_time_sub(gpr_now(gpr_clock_type::GPR_CLOCK_MONOTONIC),
-                     gpr_time_from_hours(kHoursIn25Days,
-                                         gpr_clock_type::GPR_CLOCK_MONOTONIC));
-    grpc_core::ExecCtx::TestOnlyGlobalInit(new_start);
-    grpc_core::ExecCtx exec_ctx;
-    grpc_determine_iomgr_platform();
-    grpc_iomgr_platform_init();
-    gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
-    long_running_service_cleanup_test();
-    add_test();
-    destruction_test();
-    grpc_iomgr_platform_shutdown();
+  /* Both timer implementations must pass the same tests */
+  grpc_timer_vtable* impls[] = {&grpc_generic_timer_vtable,
+                                &grpc_wheel_timer_vtable};
+  for (grpc_timer_vtable* impl : impls) {
+    /* Tests with default g_start_time */
+    {
+      grpc::testing::TestEnvironment env(argc, argv);
+      grpc_core::ExecCtx::GlobalInit();
+      grpc_core::ExecCtx exec_ctx;
+      grpc_determine_iomgr_platform();
+      grpc_set_timer_impl(impl);
+      grpc_iomgr_platform_init();
+      gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
+      add_test();
+      destruction_test();
+      grpc_iomgr_platform_shutdown();
+    }
+    grpc_core::ExecCtx::GlobalShutdown();
+
+    /* Begin long running service tests */
+    {
+      grpc::testing::TestEnvironment env(argc, argv);
+      /* Set g_start_time back 25 days. */
+      /* We set g_start_time here in case there are any initialization
+          dependencies that use g_start_time. */
+      gpr_timespec new_start = gpr_time_sub(
+          gpr_now(gpr_clock_type::GPR_CLOCK_MONOTONIC),
+          gpr_time_from_hours(kHoursIn25Days,
+                              gpr_clock_type::GPR_CLOCK_MONOTONIC));
+      grpc_core::ExecCtx::TestOnlyGlobalInit(new_start);
+      grpc_core::ExecCtx exec_ctx;
+      grpc_determine_iomgr_platform();
+      grpc_set_timer_impl(impl);
+      grpc_iomgr_platform_init();
+      gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
+      long_running_service_cleanup_test();
+      add_test();
+      destruction_test();
+      grpc_iomgr_platform_shutdown();
+    }
+    grpc_core::ExecCtx::GlobalShutdown();
   }
-  grpc_core::ExecCtx::GlobalShutdown();
 
   return 0;
 }
@@ -24,6 +24,7 @@
 #include "src/core/lib/iomgr/udp_server.h"
 
 #include <netinet/in.h>
+#include <stdio.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -359,6 +360,70 @@ static void test_receive(int number_of_clients) {
   shutdown_and_destroy_pollset();
 }
 
+static void bind_loopback_udp(int* fd, grpc_resolved_address* resolved_addr) {
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr->addr);
+  memset(resolved_addr, 0, sizeof(*resolved_addr));
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  resolved_addr->len = static_cast<socklen_t>(sizeof(*addr));
+  *fd = socket(AF_INET, SOCK_DGRAM, 0);
+  GPR_ASSERT(*fd >= 0);
+  GPR_ASSERT(bind(*fd, reinterpret_cast<struct sockaddr*>(addr),
+                  resolved_addr->len) == 0);
+  GPR_ASSERT(getsockname(*fd, reinterpret_cast<struct sockaddr*>(addr),
+                         reinterpret_cast<socklen_t*>(&resolved_addr->len)) ==
+             0);
+}
+
+static void test_send_and_recv_batch(void) {
+  LOG_TEST("test_send_and_recv_batch");
+  const size_t kDatagrams = 100;
+  int svrfd, clifd;
+  grpc_resolved_address svr_addr, cli_addr;
+  bind_loopback_udp(&svrfd, &svr_addr);
+  bind_loopback_udp(&clifd, &cli_addr);
+
+  /* Nothing is pending yet. */
+  char buf[kDatagrams][16];
+  grpc_udp_datagram datagrams[kDatagrams];
+  memset(datagrams, 0, sizeof(datagrams));
+  datagrams[0].buf = buf[0];
+  datagrams[0].len = sizeof(buf[0]);
+  GPR_ASSERT(grpc_udp_recv_batch(svrfd, datagrams, 1) == 0);
+
+  /* Spans more than one kernel batch. */
+  for (size_t i = 0; i < kDatagrams; i++) {
+    snprintf(buf[i], sizeof(buf[i]), "datagram %zu", i);
+    datagrams[i].buf = buf[i];
+    datagrams[i].len = strlen(buf[i]);
+    datagrams[i].addr = svr_addr;
+  }
+  GPR_ASSERT(grpc_udp_send_batch(clifd, datagrams, kDatagrams) ==
+             static_cast<int>(kDatagrams));
+
+  memset(buf, 0, sizeof(buf));
+  memset(datagrams, 0, sizeof(datagrams));
+  for (size_t i = 0; i < kDatagrams; i++) {
+    datagrams[i].buf = buf[i];
+    datagrams[i].len = sizeof(buf[i]);
+  }
+  GPR_ASSERT(grpc_udp_recv_batch(svrfd, datagrams, kDatagrams) ==
+             static_cast<int>(kDatagrams));
+  for (size_t i = 0; i < kDatagrams; i++) {
+    char expected[16];
+    snprintf(expected, sizeof(expected), "datagram %zu", i);
+    GPR_ASSERT(datagrams[i].len == strlen(expected));
+    GPR_ASSERT(memcmp(datagrams[i].buf, expected, datagrams[i].len) == 0);
+    GPR_ASSERT(datagrams[i].segment_size == 0);
+    GPR_ASSERT(datagrams[i].addr.len == cli_addr.len);
+    GPR_ASSERT(memcmp(datagrams[i].addr.addr, cli_addr.addr,
+                      cli_addr.len) == 0);
+  }
+  close(clifd);
+  close(svrfd);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -376,6 +441,7 @@ int main(int argc, char** argv) {
     test_no_op_with_port_and_start();
     test_receive(1);
     test_receive(10);
+    test_send_and_recv_batch();
 
     gpr_free(g_pollset);
   }
@@ -26,7 +26,9 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/http/httpcli.h"
 #include "src/core/lib/security/credentials/jwt/json_token.h"
 #include "src/core/lib/slice/b64.h"
@@ -595,6 +597,93 @@ static void test_jwt_verifier_bad_format(void) {
   grpc_httpcli_set_override(nullptr, nullptr);
 }
 
+static char* google_email_issuer_jwt(gpr_timespec lifetime) {
+  char* key_str = json_key_str(json_key_str_part3_for_google_email_issuer);
+  grpc_auth_json_key key = grpc_auth_json_key_create_from_string(key_str);
+  gpr_free(key_str);
+  GPR_ASSERT(grpc_auth_json_key_is_valid(&key));
+  char* jwt =
+      grpc_jwt_encode_and_sign(&key, expected_audience, lifetime, nullptr);
+  grpc_auth_json_key_destruct(&key);
+  GPR_ASSERT(jwt != nullptr);
+  return jwt;
+}
+
+static void on_verification_bad_audience(void* user_data,
+                                         grpc_jwt_verifier_status status,
+                                         grpc_jwt_claims* claims) {
+  GPR_ASSERT(status == GRPC_JWT_VERIFIER_BAD_AUDIENCE);
+  GPR_ASSERT(claims == nullptr);
+  GPR_ASSERT(user_data == (void*)expected_user_data);
+}
+
+static void test_jwt_verifier_caches_keys_and_verified_tokens(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_jwt_verifier* verifier = grpc_jwt_verifier_create(nullptr, 0);
+  char* jwt = google_email_issuer_jwt(expected_lifetime);
+  /* A different expiry makes for a different JWT from the same issuer. */
+  char* other_jwt = google_email_issuer_jwt(
+      gpr_time_add(expected_lifetime, gpr_time_from_seconds(1, GPR_TIMESPAN)));
+  grpc_httpcli_set_override(httpcli_get_google_keys_for_email,
+                            httpcli_post_should_not_be_called);
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_success, (void*)expected_user_data);
+  grpc_core::ExecCtx::Get()->Flush();
+  /* Both the key set and the verified JWT are cached now. */
+  grpc_httpcli_set_override(httpcli_get_should_not_be_called,
+                            httpcli_post_should_not_be_called);
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_success, (void*)expected_user_data);
+  grpc_jwt_verifier_verify(verifier, nullptr, other_jwt, expected_audience,
+                           on_verification_success, (void*)expected_user_data);
+  /* Claims are still checked for verified JWTs. */
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, "https://bar.com",
+                           on_verification_bad_audience,
+                           (void*)expected_user_data);
+  grpc_jwt_verifier_destroy(verifier);
+  grpc_core::ExecCtx::Get()->Flush();
+  gpr_free(jwt);
+  gpr_free(other_jwt);
+  grpc_httpcli_set_override(nullptr, nullptr);
+}
+
+static gpr_atm g_batch_verifications_left;
+static gpr_event g_batch_done;
+
+static void on_batch_verification_success(void* user_data,
+                                          grpc_jwt_verifier_status status,
+                                          grpc_jwt_claims* claims) {
+  on_verification_success(user_data, status, claims);
+  if (gpr_atm_full_fetch_add(&g_batch_verifications_left, -1) == 1) {
+    gpr_event_set(&g_batch_done, (void*)1);
+  }
+}
+
+static void test_jwt_verifier_verify_batch(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_jwt_verifier* verifier = grpc_jwt_verifier_create(nullptr, 0);
+  char* jwts[3];
+  void* user_data[GPR_ARRAY_SIZE(jwts)];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(jwts); i++) {
+    jwts[i] = google_email_issuer_jwt(gpr_time_add(
+        expected_lifetime,
+        gpr_time_from_seconds(static_cast<int64_t>(i), GPR_TIMESPAN)));
+    user_data[i] = (void*)expected_user_data;
+  }
+  gpr_atm_rel_store(&g_batch_verifications_left, GPR_ARRAY_SIZE(jwts));
+  gpr_event_init(&g_batch_done);
+  grpc_httpcli_set_override(httpcli_get_google_keys_for_email,
+                            httpcli_post_should_not_be_called);
+  grpc_jwt_verifier_verify_batch(verifier, nullptr, jwts, GPR_ARRAY_SIZE(jwts),
+                                 expected_audience,
+                                 on_batch_verification_success, user_data);
+  grpc_jwt_verifier_destroy(verifier);
+  GPR_ASSERT(gpr_event_wait(&g_batch_done,
+                            grpc_timeout_seconds_to_deadline(10)) != nullptr);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(jwts); i++) gpr_free(jwts[i]);
+  grpc_httpcli_set_override(nullptr, nullptr);
+}
+
 /* find verification key: bad jks, cannot find key in jks */
 /* bad signature custom provided email*/
 /* bad key */
@@ -615,6 +704,8 @@ int main(int argc, char** argv) {
   test_jwt_verifier_bad_json_key();
   test_jwt_verifier_bad_signature();
   test_jwt_verifier_bad_format();
+  test_jwt_verifier_caches_keys_and_verified_tokens();
+  test_jwt_verifier_verify_batch();
   grpc_shutdown();
   return 0;
 }
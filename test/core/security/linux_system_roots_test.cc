@@ -26,6 +26,7 @@
 #include <grpc/support/string_util.h>
 #include <string.h>
 #include <sys/param.h>
+#include <unistd.h>
 
 #include "src/core/lib/gpr/env.h"
 #include "src/core/lib/gpr/tmpfile.h"
@@ -82,6 +83,37 @@ TEST(CreateRootCertsBundleTest, BundlesCorrectly) {
   grpc_slice_unref(result_slice);
 }
 
+TEST(MapRootCertsFileTest, MapsLikeLoadFile) {
+  grpc_slice roots_bundle = grpc_empty_slice();
+  GRPC_LOG_IF_ERROR(
+      "load_file",
+      grpc_load_file("test/core/security/etc/bundle.pem", 1, &roots_bundle));
+  grpc_slice mapped_bundle =
+      grpc_core::MapRootCertsFile("test/core/security/etc/bundle.pem");
+  EXPECT_TRUE(grpc_slice_eq(roots_bundle, mapped_bundle));
+  grpc_slice_unref(roots_bundle);
+  grpc_slice_unref(mapped_bundle);
+  mapped_bundle = grpc_core::MapRootCertsFile("does/not/exist");
+  EXPECT_TRUE(GRPC_SLICE_IS_EMPTY(mapped_bundle));
+}
+
+TEST(IsHashedCertsDirectoryTest, DetectsSubjectHashNames) {
+  EXPECT_FALSE(
+      grpc_core::IsHashedCertsDirectory("test/core/security/etc/test_roots"));
+  EXPECT_FALSE(grpc_core::IsHashedCertsDirectory("does/not/exist"));
+  char dir_template[] = "/tmp/hashed_roots_XXXXXX";
+  char* dir = mkdtemp(dir_template);
+  ASSERT_NE(dir, nullptr);
+  char path[MAXPATHLEN];
+  grpc_core::GetAbsoluteFilePath(dir, "5ed36f99.0", path);
+  FILE* cert = fopen(path, "w");
+  ASSERT_NE(cert, nullptr);
+  fclose(cert);
+  EXPECT_TRUE(grpc_core::IsHashedCertsDirectory(dir));
+  remove(path);
+  rmdir(dir);
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -25,11 +25,13 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/endpoint_pair.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/fake_transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 #include "test/core/util/test_config.h"
 
 static gpr_mu* g_mu;
@@ -151,6 +153,90 @@ secure_endpoint_create_fixture_tcp_socketpair_leftover_zero_copy(
   return secure_endpoint_create_fixture_tcp_socketpair(slice_size, &s, 1, true);
 }
 
+/* An offload engine running each operation on the executor, completing it
+   from there as an accelerator would from its own thread. */
+namespace {
+struct offload_op {
+  grpc_closure closure;
+  bool protect;
+  tsi_zero_copy_grpc_protector* protector;
+  grpc_slice_buffer* input;
+  grpc_slice_buffer* output;
+  tsi_crypto_offload_done_cb cb;
+  void* user_data;
+};
+}  // namespace
+
+static gpr_atm g_offloaded_ops;
+
+static void run_offload_op(void* arg, grpc_error* error) {
+  offload_op* op = static_cast<offload_op*>(arg);
+  tsi_result result =
+      op->protect ? tsi_zero_copy_grpc_protector_protect(
+                        op->protector, op->input, op->output)
+                  : tsi_zero_copy_grpc_protector_unprotect(
+                        op->protector, op->input, op->output);
+  gpr_atm_no_barrier_fetch_add(&g_offloaded_ops, 1);
+  op->cb(op->user_data, result);
+  gpr_free(op);
+}
+
+static void start_offload_op(bool protect,
+                             tsi_zero_copy_grpc_protector* protector,
+                             grpc_slice_buffer* input,
+                             grpc_slice_buffer* output,
+                             tsi_crypto_offload_done_cb cb, void* user_data) {
+  offload_op* op = static_cast<offload_op*>(gpr_malloc(sizeof(*op)));
+  op->protect = protect;
+  op->protector = protector;
+  op->input = input;
+  op->output = output;
+  op->cb = cb;
+  op->user_data = user_data;
+  GRPC_CLOSURE_SCHED(
+      GRPC_CLOSURE_INIT(
+          &op->closure, run_offload_op, op,
+          grpc_core::Executor::Scheduler(grpc_core::ExecutorJobType::SHORT)),
+      GRPC_ERROR_NONE);
+}
+
+static void executor_offload_protect(tsi_crypto_offload_engine* self,
+                                     tsi_zero_copy_grpc_protector* protector,
+                                     grpc_slice_buffer* unprotected_slices,
+                                     grpc_slice_buffer* protected_slices,
+                                     tsi_crypto_offload_done_cb cb,
+                                     void* user_data) {
+  start_offload_op(true, protector, unprotected_slices, protected_slices, cb,
+                   user_data);
+}
+
+static void executor_offload_unprotect(tsi_crypto_offload_engine* self,
+                                       tsi_zero_copy_grpc_protector* protector,
+                                       grpc_slice_buffer* protected_slices,
+                                       grpc_slice_buffer* unprotected_slices,
+                                       tsi_crypto_offload_done_cb cb,
+                                       void* user_data) {
+  start_offload_op(false, protector, protected_slices, unprotected_slices, cb,
+                   user_data);
+}
+
+static const tsi_crypto_offload_engine_vtable executor_offload_vtable = {
+    executor_offload_protect, executor_offload_unprotect};
+static tsi_crypto_offload_engine g_executor_offload_engine = {
+    &executor_offload_vtable};
+
+static grpc_endpoint_test_fixture
+secure_endpoint_create_fixture_tcp_socketpair_noleftover_offload(
+    size_t slice_size) {
+  grpc_endpoint_test_fixture f = secure_endpoint_create_fixture_tcp_socketpair(
+      slice_size, nullptr, 0, true);
+  grpc_secure_endpoint_set_crypto_offload_engine(f.client_ep,
+                                                 &g_executor_offload_engine);
+  grpc_secure_endpoint_set_crypto_offload_engine(f.server_ep,
+                                                 &g_executor_offload_engine);
+  return f;
+}
+
 static void clean_up(void) {}
 
 static grpc_endpoint_test_config configs[] = {
@@ -164,6 +250,9 @@ static grpc_endpoint_test_config configs[] = {
     {"secure_ep/tcp_socketpair_leftover_zero_copy",
      secure_endpoint_create_fixture_tcp_socketpair_leftover_zero_copy,
      clean_up},
+    {"secure_ep/tcp_socketpair_offload",
+     secure_endpoint_create_fixture_tcp_socketpair_noleftover_offload,
+     clean_up},
 };
 
 static void inc_call_ctr(void* arg, grpc_error* error) {
@@ -219,6 +308,8 @@ int main(int argc, char** argv) {
     grpc_endpoint_tests(configs[1], g_pollset, g_mu);
     test_leftover(configs[2], 1);
     test_leftover(configs[3], 1);
+    grpc_endpoint_tests(configs[4], g_pollset, g_mu);
+    GPR_ASSERT(gpr_atm_no_barrier_load(&g_offloaded_ops) > 0);
     GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
                       grpc_schedule_on_exec_ctx);
     grpc_pollset_shutdown(g_pollset, &destroyed);
@@ -33,6 +33,7 @@
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/tsi/ssl_transport_security.h"
 #include "src/core/tsi/transport_security.h"
+#include "test/core/end2end/data/ssl_test_data.h"
 #include "test/core/util/test_config.h"
 
 #ifndef TSI_OPENSSL_ALPN_SUPPORT
@@ -473,6 +474,40 @@ static void test_peer_alpn_check(void) {
 #endif
 }
 
+static void test_shared_client_handshaker_factory(void) {
+  tsi_ssl_client_handshaker_options options;
+  options.pem_root_certs = test_root_cert;
+  tsi_ssl_client_handshaker_factory* first = nullptr;
+  GPR_ASSERT(grpc_ssl_get_shared_client_handshaker_factory(
+                 &options, &first) == TSI_OK);
+  /* The same roots at another address share the factory. */
+  char* roots_copy = gpr_strdup(test_root_cert);
+  options.pem_root_certs = roots_copy;
+  tsi_ssl_client_handshaker_factory* second = nullptr;
+  GPR_ASSERT(grpc_ssl_get_shared_client_handshaker_factory(
+                 &options, &second) == TSI_OK);
+  GPR_ASSERT(second == first);
+  /* Other options do not. */
+  options.cipher_suites = "ECDHE-RSA-AES128-GCM-SHA256";
+  tsi_ssl_client_handshaker_factory* other = nullptr;
+  GPR_ASSERT(grpc_ssl_get_shared_client_handshaker_factory(
+                 &options, &other) == TSI_OK);
+  GPR_ASSERT(other != first);
+  /* Nor do factories using a session cache. */
+  options.cipher_suites = nullptr;
+  options.session_cache = tsi_ssl_session_cache_create_lru(1);
+  tsi_ssl_client_handshaker_factory* with_cache = nullptr;
+  GPR_ASSERT(grpc_ssl_get_shared_client_handshaker_factory(
+                 &options, &with_cache) == TSI_OK);
+  GPR_ASSERT(with_cache != first);
+  tsi_ssl_session_cache_unref(options.session_cache);
+  tsi_ssl_client_handshaker_factory_unref(first);
+  tsi_ssl_client_handshaker_factory_unref(second);
+  tsi_ssl_client_handshaker_factory_unref(other);
+  tsi_ssl_client_handshaker_factory_unref(with_cache);
+  gpr_free(roots_copy);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -485,6 +520,7 @@ int main(int argc, char** argv) {
   test_ipv6_address_san();
   test_default_ssl_roots();
   test_peer_alpn_check();
+  test_shared_client_handshaker_factory();
   grpc_shutdown();
   return 0;
 }
@@ -25,6 +25,8 @@
 #include <grpc/support/string_util.h>
 #include <gtest/gtest.h>
 
+#include "src/core/lib/channel/handshaker.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/security/security_connector/tls/spiffe_security_connector.h"
 #include "test/core/end2end/data/ssl_test_data.h"
 #include "test/core/util/test_config.h"
@@ -65,6 +67,14 @@ int CredReloadUnchanged(void* config_user_data,
   return 0;
 }
 
+gpr_atm g_reload_count;
+
+int CredReloadCounted(void* config_user_data,
+                      grpc_tls_credential_reload_arg* arg) {
+  gpr_atm_full_fetch_add(&g_reload_count, 1);
+  return CredReloadSuccess(config_user_data, arg);
+}
+
 int CredReloadAsync(void* config_user_data,
                     grpc_tls_credential_reload_arg* arg) {
   return 1;
@@ -262,6 +272,33 @@ TEST_F(SpiffeSecurityConnectorTest, CreateServerSecurityConnectorSuccess) {
   EXPECT_NE(connector, nullptr);
 }
 
+TEST_F(SpiffeSecurityConnectorTest, ServerCredentialReloadInBackground) {
+  gpr_atm_rel_store(&g_reload_count, 0);
+  grpc_tls_credentials_options_set_credential_reload_config(
+      options_.get(), grpc_tls_credential_reload_config_create(
+                          nullptr, CredReloadCounted, nullptr, nullptr));
+  auto cred = grpc_core::UniquePtr<grpc_server_credentials>(
+      grpc_tls_spiffe_server_credentials_create(options_.get()));
+  auto connector = cred->create_security_connector();
+  ASSERT_NE(connector, nullptr);
+  // The initial credentials are fetched when the connector is created.
+  EXPECT_EQ(gpr_atm_acq_load(&g_reload_count), 1);
+  // Handshakes do not wait for a reload: it happens on the executor, one at
+  // a time, and later handshakes use the factory it swapped in.
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (gpr_atm_acq_load(&g_reload_count) < 3 &&
+         gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+    auto handshake_mgr =
+        grpc_core::MakeRefCounted<grpc_core::HandshakeManager>();
+    {
+      grpc_core::ExecCtx exec_ctx;
+      connector->add_handshakers(nullptr, handshake_mgr.get());
+    }
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  }
+  EXPECT_GE(gpr_atm_acq_load(&g_reload_count), 3);
+}
+
 TEST_F(SpiffeSecurityConnectorTest, CreateServerSecurityConnectorFailInit) {
   SetOptions(FAIL);
   auto cred = grpc_core::UniquePtr<grpc_server_credentials>(
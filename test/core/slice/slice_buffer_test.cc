@@ -16,10 +16,13 @@
  *
  */
 
+#include <string.h>
+
 #include <grpc/grpc.h>
 #include <grpc/slice_buffer.h>
 #include <grpc/support/log.h>
 #include "src/core/lib/slice/slice_internal.h"
+#include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
 
 void test_slice_buffer_add() {
@@ -106,6 +109,52 @@ void test_slice_buffer_move_first() {
   GPR_ASSERT(dst.length == dst_len);
 }
 
+void test_slice_buffer_move_first_several() {
+  grpc_slice_buffer src;
+  grpc_slice_buffer dst;
+  grpc_slice_buffer_init(&src);
+  grpc_slice_buffer_init(&dst);
+  grpc_slice_buffer_add_indexed(&dst, grpc_slice_from_copied_string("x"));
+  grpc_slice_buffer_add_indexed(&src, grpc_slice_from_copied_string("aaa"));
+  grpc_slice_buffer_add_indexed(&src, grpc_slice_from_copied_string("bbbb"));
+  grpc_slice_buffer_add_indexed(&src, grpc_slice_from_copied_string("ccc"));
+
+  /* two whole slices and part of the third */
+  grpc_slice_buffer_move_first(&src, 8, &dst);
+  GPR_ASSERT(src.count == 1);
+  GPR_ASSERT(src.length == 2);
+  GPR_ASSERT(0 == grpc_slice_str_cmp(src.slices[0], "cc"));
+  GPR_ASSERT(dst.length == 9);
+  grpc_slice merged = grpc_slice_merge(dst.slices, dst.count);
+  GPR_ASSERT(0 == grpc_slice_str_cmp(merged, "xaaabbbbc"));
+  grpc_slice_unref(merged);
+
+  grpc_slice_buffer_destroy(&src);
+  grpc_slice_buffer_destroy(&dst);
+}
+
+void test_slice_buffer_queue() {
+  grpc_slice_buffer buf;
+  grpc_slice_buffer_init(&buf);
+  grpc_slice big = grpc_slice_malloc(100);
+  /* add at the back, take from the front: the slices keep their order and
+     the buffer does not grow past a small multiple of what it holds */
+  for (size_t i = 0; i < 1000; i++) {
+    grpc_slice_buffer_add_indexed(&buf,
+                                  grpc_slice_sub(big, i % 50, i % 50 + 50));
+    if (i >= 10) {
+      grpc_slice slice = grpc_slice_buffer_take_first(&buf);
+      GPR_ASSERT(GRPC_SLICE_START_PTR(slice) ==
+                 GRPC_SLICE_START_PTR(big) + (i - 10) % 50);
+      grpc_slice_unref(slice);
+    }
+  }
+  GPR_ASSERT(buf.count == 10);
+  GPR_ASSERT(buf.capacity <= 40);
+  grpc_slice_buffer_destroy(&buf);
+  grpc_slice_unref(big);
+}
+
 void test_slice_buffer_first() {
   grpc_slice slices[3];
   slices[0] = grpc_slice_from_copied_string("aaa");
@@ -147,13 +196,53 @@ void test_slice_buffer_first() {
   GPR_ASSERT(buf.length == 0);
 }
 
+void test_slice_buffer_coalesce_small_slices() {
+  grpc_slice_buffer buf;
+  grpc_slice_buffer_init(&buf);
+  grpc_slice big = grpc_slice_malloc(100);
+  memset(GRPC_SLICE_START_PTR(big), 'x', 100);
+
+  /* a, bb, ccc are merged; the lone d stays as it was */
+  grpc_slice_buffer_add_indexed(&buf, grpc_slice_from_copied_string("a"));
+  grpc_slice_buffer_add_indexed(&buf, grpc_slice_from_copied_string("bb"));
+  grpc_slice_buffer_add_indexed(&buf, grpc_slice_from_copied_string("ccc"));
+  grpc_slice_buffer_add_indexed(&buf, grpc_slice_ref(big));
+  grpc_slice_buffer_add_indexed(&buf, grpc_slice_from_copied_string("d"));
+  grpc_slice_buffer_add_indexed(&buf, grpc_slice_ref(big));
+  grpc_slice_buffer_add_indexed(&buf, grpc_slice_from_copied_string("ee"));
+  grpc_slice_buffer_add_indexed(&buf, grpc_slice_from_copied_string("f"));
+  GPR_ASSERT(buf.count == 8);
+  GPR_ASSERT(buf.length == 210);
+
+  grpc_slice_buffer_coalesce_small_slices(&buf, 10);
+  GPR_ASSERT(buf.count == 5);
+  GPR_ASSERT(buf.length == 210);
+  GPR_ASSERT(0 == grpc_slice_str_cmp(buf.slices[0], "abbccc"));
+  /* large slices are kept by reference */
+  GPR_ASSERT(GRPC_SLICE_START_PTR(buf.slices[1]) == GRPC_SLICE_START_PTR(big));
+  GPR_ASSERT(0 == grpc_slice_str_cmp(buf.slices[2], "d"));
+  GPR_ASSERT(GRPC_SLICE_START_PTR(buf.slices[3]) == GRPC_SLICE_START_PTR(big));
+  GPR_ASSERT(0 == grpc_slice_str_cmp(buf.slices[4], "eef"));
+
+  /* nothing left to merge */
+  grpc_slice_buffer_coalesce_small_slices(&buf, 10);
+  GPR_ASSERT(buf.count == 5);
+  GPR_ASSERT(buf.length == 210);
+
+  grpc_slice_buffer_destroy(&buf);
+  grpc_slice_unref(big);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
 
   test_slice_buffer_add();
   test_slice_buffer_move_first();
+  test_slice_buffer_move_first_several();
+  test_slice_buffer_queue();
   test_slice_buffer_first();
+  test_slice_buffer_coalesce_small_slices();
 
   grpc_shutdown();
   return 0;
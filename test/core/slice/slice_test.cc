@@ -23,6 +23,8 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <vector>
+
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -286,6 +288,29 @@ static void test_static_slice_copy_interning(void) {
   grpc_shutdown();
 }
 
+static void test_static_slice_index_of(void) {
+  LOG_TEST_NAME("test_static_slice_index_of");
+
+  for (size_t i = 0; i < GRPC_STATIC_MDSTR_COUNT; i++) {
+    const grpc_slice& s = grpc_static_slice_table[i];
+    GPR_ASSERT(grpc_static_slice_index_of(GRPC_SLICE_START_PTR(s),
+                                          GRPC_SLICE_LENGTH(s)) ==
+               static_cast<int32_t>(i));
+    if (GRPC_SLICE_LENGTH(s) == 0) continue;
+    // Static strings are ASCII, so flipping the top bit of any byte leaves
+    // a string that matches none of them
+    grpc_slice copy = grpc_slice_dup(s);
+    for (size_t j = 0; j < GRPC_SLICE_LENGTH(copy); j++) {
+      GRPC_SLICE_START_PTR(copy)[j] ^= 0x80;
+      GPR_ASSERT(grpc_static_slice_index_of(GRPC_SLICE_START_PTR(copy),
+                                            GRPC_SLICE_LENGTH(copy)) == -1);
+      GRPC_SLICE_START_PTR(copy)[j] ^= 0x80;
+    }
+    grpc_slice_unref(copy);
+  }
+  GPR_ASSERT(grpc_static_slice_index_of("x-not-static", 12) == -1);
+}
+
 static void test_moved_string_slice(void) {
   LOG_TEST_NAME("test_moved_string_slice");
 
@@ -324,6 +349,57 @@ static void test_moved_string_slice(void) {
   grpc_shutdown();
 }
 
+static void test_slice_memory_is_counted(void) {
+  LOG_TEST_NAME("test_slice_memory_is_counted");
+
+  const size_t before =
+      gpr_subsystem_allocated_bytes(GPR_ALLOC_SUBSYSTEM_SLICES);
+  grpc_slice slice = grpc_slice_malloc(10000);
+  GPR_ASSERT(gpr_subsystem_allocated_bytes(GPR_ALLOC_SUBSYSTEM_SLICES) >=
+             before + 10000);
+  grpc_slice_unref(slice);
+  GPR_ASSERT(gpr_subsystem_allocated_bytes(GPR_ALLOC_SUBSYSTEM_SLICES) <
+             before + 10000);
+}
+
+static void test_slab_allocator(void) {
+  LOG_TEST_NAME("test_slab_allocator");
+
+  GPR_GLOBAL_CONFIG_SET(grpc_slice_slab_allocator, true);
+  grpc_init();
+
+  // Hold many slices of every size class at once, so that blocks overflow the
+  // per CPU caches to the central list and come back from it.
+  std::vector<grpc_slice> slices;
+  for (int round = 0; round < 3; round++) {
+    for (size_t length = GRPC_SLICE_INLINED_SIZE + 1; length <= 8192;
+         length += 61) {
+      for (int i = 0; i < 16; i++) {
+        grpc_slice slice = grpc_slice_malloc(length);
+        GPR_ASSERT(GRPC_SLICE_LENGTH(slice) == length);
+        memset(GRPC_SLICE_START_PTR(slice), static_cast<int>(length & 0xff),
+               length);
+        slices.push_back(slice);
+      }
+    }
+    for (grpc_slice& slice : slices) {
+      const size_t length = GRPC_SLICE_LENGTH(slice);
+      for (size_t j = 0; j < length; j++) {
+        GPR_ASSERT(GRPC_SLICE_START_PTR(slice)[j] == (length & 0xff));
+      }
+      grpc_slice_unref(slice);
+    }
+    slices.clear();
+  }
+
+  // A slice that outlives the allocator is freed when it is unreffed.
+  grpc_slice survivor = grpc_slice_malloc(100);
+  grpc_shutdown_blocking();
+  grpc_slice_unref(survivor);
+
+  GPR_GLOBAL_CONFIG_SET(grpc_slice_slab_allocator, false);
+}
+
 int main(int argc, char** argv) {
   unsigned length;
   grpc::testing::TestEnvironment env(argc, argv);
@@ -341,7 +417,10 @@ int main(int argc, char** argv) {
   test_slice_interning();
   test_static_slice_interning();
   test_static_slice_copy_interning();
+  test_static_slice_index_of();
   test_moved_string_slice();
+  test_slice_memory_is_counted();
   grpc_shutdown();
+  test_slab_allocator();
   return 0;
 }
@@ -296,6 +296,31 @@ static void test_readall(void) {
   grpc_byte_buffer_destroy(buffer);
 }
 
+static void test_readall_one_slice(void) {
+  grpc_slice slice;
+  grpc_byte_buffer* buffer;
+  grpc_byte_buffer_reader reader;
+  grpc_slice slice_out;
+
+  LOG_TEST("test_readall_one_slice");
+
+  /* large enough to overflow inlining */
+  slice = grpc_slice_malloc(1024);
+  memset(GRPC_SLICE_START_PTR(slice), 'a', 1024);
+  buffer = grpc_raw_byte_buffer_create(&slice, 1);
+  GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, buffer) &&
+             "Couldn't init byte buffer reader");
+  slice_out = grpc_byte_buffer_reader_readall(&reader);
+
+  /* the single slice is shared rather than copied */
+  GPR_ASSERT(GRPC_SLICE_START_PTR(slice_out) == GRPC_SLICE_START_PTR(slice));
+  GPR_ASSERT(GRPC_SLICE_LENGTH(slice_out) == 1024);
+  grpc_slice_unref(slice_out);
+  grpc_slice_unref(slice);
+  grpc_byte_buffer_reader_destroy(&reader);
+  grpc_byte_buffer_destroy(buffer);
+}
+
 static void test_byte_buffer_copy(void) {
   char* lotsa_as[512];
   char* lotsa_bs[1024];
@@ -347,5 +372,6 @@ int main(int argc, char** argv) {
   test_byte_buffer_from_reader();
   test_byte_buffer_copy();
   test_readall();
+  test_readall_one_slice();
   return 0;
 }
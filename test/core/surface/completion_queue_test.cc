@@ -24,6 +24,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "test/core/util/test_config.h"
 
@@ -40,7 +41,8 @@ static void shutdown_and_destroy(grpc_completion_queue* cc) {
   grpc_completion_queue_shutdown(cc);
 
   switch (grpc_get_cq_completion_type(cc)) {
-    case GRPC_CQ_NEXT: {
+    case GRPC_CQ_NEXT:
+    case GRPC_CQ_NEXT_SHARDED: {
       ev = grpc_completion_queue_next(cc, gpr_inf_past(GPR_CLOCK_REALTIME),
                                       nullptr);
       GPR_ASSERT(ev.type == GRPC_QUEUE_SHUTDOWN);
@@ -68,7 +70,8 @@ static void shutdown_and_destroy(grpc_completion_queue* cc) {
 
 /* ensure we can create and destroy a completion channel */
 static void test_no_op(void) {
-  grpc_cq_completion_type completion_types[] = {GRPC_CQ_NEXT, GRPC_CQ_PLUCK};
+  grpc_cq_completion_type completion_types[] = {GRPC_CQ_NEXT, GRPC_CQ_PLUCK,
+                                                GRPC_CQ_NEXT_SHARDED};
   grpc_cq_polling_type polling_types[] = {
       GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
   grpc_completion_queue_attributes attr;
@@ -86,7 +89,8 @@ static void test_no_op(void) {
 }
 
 static void test_pollset_conversion(void) {
-  grpc_cq_completion_type completion_types[] = {GRPC_CQ_NEXT, GRPC_CQ_PLUCK};
+  grpc_cq_completion_type completion_types[] = {GRPC_CQ_NEXT, GRPC_CQ_PLUCK,
+                                                GRPC_CQ_NEXT_SHARDED};
   grpc_cq_polling_type polling_types[] = {GRPC_CQ_DEFAULT_POLLING,
                                           GRPC_CQ_NON_LISTENING};
   grpc_completion_queue* cq;
@@ -482,6 +486,73 @@ struct thread_state {
   void* tag;
 };
 
+#define SHARDED_PRODUCERS 4
+#define SHARDED_EVENTS_PER_PRODUCER 100
+
+typedef struct sharded_producer {
+  grpc_completion_queue* cc;
+  intptr_t first_tag;
+  grpc_cq_completion completions[SHARDED_EVENTS_PER_PRODUCER];
+} sharded_producer;
+
+static void sharded_producer_thread(void* arg) {
+  sharded_producer* p = static_cast<sharded_producer*>(arg);
+  grpc_core::ExecCtx exec_ctx;
+  for (intptr_t i = 0; i < SHARDED_EVENTS_PER_PRODUCER; i++) {
+    void* tag = reinterpret_cast<void*>(p->first_tag + i);
+    GPR_ASSERT(grpc_cq_begin_op(p->cc, tag));
+    grpc_cq_end_op(p->cc, tag, GRPC_ERROR_NONE, do_nothing_end_completion,
+                   nullptr, &p->completions[i]);
+  }
+}
+
+/* Events completed on several threads (and so, likely, on several shards)
+   must all be returned to a single consumer */
+static void test_sharded_next(void) {
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+  sharded_producer producers[SHARDED_PRODUCERS];
+  grpc_core::Thread threads[SHARDED_PRODUCERS];
+
+  LOG_TEST("test_sharded_next");
+
+  attr.version = 1;
+  attr.cq_completion_type = GRPC_CQ_NEXT_SHARDED;
+  for (size_t pidx = 0; pidx < GPR_ARRAY_SIZE(polling_types); pidx++) {
+    attr.cq_polling_type = polling_types[pidx];
+    grpc_completion_queue* cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+    intptr_t expected_sum = 0;
+    for (size_t i = 0; i < SHARDED_PRODUCERS; i++) {
+      producers[i].cc = cc;
+      producers[i].first_tag = 1 + i * SHARDED_EVENTS_PER_PRODUCER;
+      for (intptr_t j = 0; j < SHARDED_EVENTS_PER_PRODUCER; j++) {
+        expected_sum += producers[i].first_tag + j;
+      }
+      threads[i] = grpc_core::Thread("grpc_sharded_cq_producer",
+                                     sharded_producer_thread, &producers[i]);
+      threads[i].Start();
+    }
+
+    intptr_t sum = 0;
+    for (size_t i = 0; i < SHARDED_PRODUCERS * SHARDED_EVENTS_PER_PRODUCER;
+         i++) {
+      grpc_event ev = grpc_completion_queue_next(
+          cc, grpc_timeout_seconds_to_deadline(5), nullptr);
+      GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+      GPR_ASSERT(ev.success);
+      sum += reinterpret_cast<intptr_t>(ev.tag);
+    }
+    GPR_ASSERT(sum == expected_sum);
+
+    for (size_t i = 0; i < SHARDED_PRODUCERS; i++) {
+      threads[i].Join();
+    }
+    shutdown_and_destroy(cc);
+  }
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -496,6 +567,7 @@ int main(int argc, char** argv) {
   test_cq_tls_cache_full();
   test_cq_tls_cache_empty();
   test_callback();
+  test_sharded_next();
   grpc_shutdown();
   return 0;
 }
@@ -112,6 +112,53 @@ int64_t NextPow2(int64_t v) {
 }
 }  // namespace
 
+namespace {
+// Probe with a ping that takes one inc_time() to come back, during which
+// \a bytes arrive.
+void AddRoundTrip(BdpEstimator* estimator, int64_t bytes) {
+  grpc_core::ExecCtx exec_ctx;
+  estimator->SchedulePing();
+  estimator->StartPing();
+  estimator->AddIncomingBytes(bytes);
+  inc_time();
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  estimator->CompletePing();
+}
+}  // namespace
+
+TEST(BdpEstimatorTest, DeliveryRateEstimationGrowsFasterThanDoubling) {
+  BdpEstimator doubling("test");
+  BdpEstimator delivery_rate("test", true);
+  for (int i = 0; i < 4; i++) {
+    // the peer fills whatever window it is given
+    AddRoundTrip(&doubling, doubling.EstimateBdp());
+    AddRoundTrip(&delivery_rate, delivery_rate.EstimateBdp());
+  }
+  EXPECT_EQ(doubling.EstimateBdp(), 65536 * 16);
+  EXPECT_GT(delivery_rate.EstimateBdp(), 4 * doubling.EstimateBdp());
+}
+
+TEST(BdpEstimatorTest, DeliveryRateEstimationFollowsSteadyRate) {
+  BdpEstimator est("test", true);
+  const int64_t kBytesPerRoundTrip = 100000;
+  for (int i = 0; i < 20; i++) {
+    AddRoundTrip(&est, kBytesPerRoundTrip);
+  }
+  EXPECT_GE(est.EstimateBdp(), kBytesPerRoundTrip);
+  EXPECT_LE(est.EstimateBdp(), 3 * kBytesPerRoundTrip);
+  EXPECT_EQ(est.MinRtt(), 30);
+}
+
+TEST(BdpEstimatorTest, DeliveryRateEstimationTakesExternalRtt) {
+  BdpEstimator est("test", true);
+  est.AddRttSample(0.01);
+  est.AddRttSample(0.02);
+  EXPECT_EQ(est.MinRtt(), 0.01);
+  BdpEstimator doubling("test");
+  doubling.AddRttSample(0.01);
+  EXPECT_EQ(doubling.MinRtt(), 0);
+}
+
 class BdpEstimatorRandomTest : public ::testing::TestWithParam<size_t> {};
 
 TEST_P(BdpEstimatorRandomTest, GetEstimateRandomValues) {
@@ -26,6 +26,7 @@
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 
@@ -90,6 +91,37 @@ static void expect_combined_equiv(const char* s, size_t len, int line) {
 #define EXPECT_COMBINED_EQUIV(x) \
   expect_combined_equiv(x, sizeof(x) - 1, __LINE__)
 
+/* Encodes s one bit at a time, as a reference for the word-at-a-time encoder */
+static grpc_slice reference_huffman_compress(const grpc_slice& input) {
+  size_t nbits = 0;
+  for (size_t i = 0; i < GRPC_SLICE_LENGTH(input); i++) {
+    nbits += grpc_chttp2_huffsyms[GRPC_SLICE_START_PTR(input)[i]].length;
+  }
+  grpc_slice output = grpc_slice_malloc((nbits + 7) / 8);
+  uint8_t* out = GRPC_SLICE_START_PTR(output);
+  memset(out, 0xff, GRPC_SLICE_LENGTH(output));
+  size_t bit = 0;
+  for (size_t i = 0; i < GRPC_SLICE_LENGTH(input); i++) {
+    const grpc_chttp2_huffsym& sym =
+        grpc_chttp2_huffsyms[GRPC_SLICE_START_PTR(input)[i]];
+    for (unsigned j = sym.length; j > 0; j--, bit++) {
+      if (((sym.bits >> (j - 1)) & 1) == 0) {
+        out[bit / 8] = static_cast<uint8_t>(out[bit / 8] & ~(0x80u >> (bit % 8)));
+      }
+    }
+  }
+  return output;
+}
+
+static void expect_huffman_matches_reference(const char* s, size_t len,
+                                             int line) {
+  grpc_slice input = grpc_slice_from_copied_buffer(s, len);
+  expect_slice_eq(reference_huffman_compress(input),
+                  grpc_chttp2_huffman_compress(input), "reference huffman",
+                  line);
+  grpc_slice_unref(input);
+}
+
 static void expect_binary_header(const char* hdr, int binary) {
   if (grpc_is_binary_header(grpc_slice_from_static_string(hdr)) != binary) {
     gpr_log(GPR_ERROR, "FAILED: expected header '%s' to be %s", hdr,
@@ -134,6 +166,18 @@ int main(int argc, char** argv) {
       "\x9d\x29\xad\x17\x18\x63\xc7\x8f\x0b\x97\xc8\xe9\xae\x82\xae\x43\xd3",
       HUFF("https://www.example.com"));
 
+  /* Long (up to 30 bit) codes in every alignment */
+  char all_bytes[512];
+  for (size_t i = 0; i < 256; i++) {
+    all_bytes[i] = static_cast<char>(i);
+    all_bytes[511 - i] = static_cast<char>(i);
+  }
+  for (size_t i = 0; i < 32; i++) {
+    expect_huffman_matches_reference(all_bytes + i, sizeof(all_bytes) - i,
+                                     __LINE__);
+  }
+  expect_huffman_matches_reference("\n\r\n\r", 4, __LINE__);
+
   /* Various test vectors for combined encoding */
   EXPECT_COMBINED_EQUIV("");
   EXPECT_COMBINED_EQUIV("f");
@@ -0,0 +1,422 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <string.h>
+
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/completion_queue.h"
+#include "src/core/lib/surface/server.h"
+#include "src/core/lib/transport/http2_errors.h"
+#include "src/core/lib/transport/transport.h"
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace test {
+namespace {
+
+const uint8_t kFrameHeaders = 1;
+const uint8_t kFrameRstStream = 3;
+const uint8_t kFrameSettings = 4;
+const uint8_t kFramePing = 6;
+const uint8_t kFrameGoaway = 7;
+
+const uint8_t kFlagAck = 1;
+const uint8_t kFlagEndStream = 1;
+
+const uint32_t kMaxStreamId = (1u << 31) - 1;
+
+// The client connection preface followed by an empty SETTINGS frame.
+const char kPreface[] =
+    "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+    "\x00\x00\x00\x04\x00\x00\x00\x00\x00";
+
+// A HEADERS frame opening stream 1 with a POST to /foo/bar, as in
+// test/core/bad_client/tests/simple_request.cc.
+const char kRequestHeaders[] =
+    "\x00\x00\xc9\x01\x04\x00\x00\x00\x01"
+    "\x10\x05:path\x08/foo/bar"
+    "\x10\x07:scheme\x04http"
+    "\x10\x07:method\x04POST"
+    "\x10\x0a:authority\x09localhost"
+    "\x10\x0c"
+    "content-type\x10"
+    "application/grpc"
+    "\x10\x14grpc-accept-encoding\x15"
+    "deflate,identity,gzip"
+    "\x10\x02te\x08trailers"
+    "\x10\x0auser-agent\"bad-client grpc-c/0.12.0.0 (linux)";
+
+void* tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+uint32_t ReadUint32(const std::string& s, size_t offset) {
+  return (static_cast<uint32_t>(static_cast<uint8_t>(s[offset])) << 24) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(s[offset + 1])) << 16) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(s[offset + 2])) << 8) |
+         static_cast<uint32_t>(static_cast<uint8_t>(s[offset + 3]));
+}
+
+struct Frame {
+  uint8_t type = 0;
+  uint8_t flags = 0;
+  uint32_t stream_id = 0;
+  std::string payload;
+
+  uint32_t goaway_last_stream_id() const {
+    return payload.size() < 8 ? 0 : ReadUint32(payload, 0) & kMaxStreamId;
+  }
+  uint32_t goaway_error_code() const {
+    return payload.size() < 8 ? 0 : ReadUint32(payload, 4);
+  }
+};
+
+// Drives a chttp2 server transport over an endpoint pair, with the test
+// playing the client by reading and writing raw HTTP/2 frames.
+class GracefulGoawayTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    grpc_slice_buffer_init(&read_buffer_);
+    GRPC_CLOSURE_INIT(&on_read_done_, SetReadDone, this,
+                      grpc_schedule_on_exec_ctx);
+  }
+
+  void TearDown() override {
+    ExecCtx exec_ctx;
+    if (client_ != nullptr) {
+      grpc_endpoint_shutdown(client_,
+                             GRPC_ERROR_CREATE_FROM_STATIC_STRING("test done"));
+      grpc_endpoint_destroy(client_);
+      ExecCtx::Get()->Flush();
+    }
+    if (server_ != nullptr) {
+      grpc_server_shutdown_and_notify(server_, cq_, tag(1000));
+      WaitForTag(tag(1000));
+      grpc_server_destroy(server_);
+      grpc_completion_queue_shutdown(cq_);
+      while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                        nullptr)
+                 .type != GRPC_QUEUE_SHUTDOWN) {
+      }
+      grpc_completion_queue_destroy(cq_);
+    }
+    grpc_slice_buffer_destroy_internal(&read_buffer_);
+  }
+
+  // Starts a server with the given keepalive timeout, which bounds the wait
+  // for the ack of the ping sent with the first GOAWAY, and sends the client
+  // connection preface.
+  void StartServer(int keepalive_timeout_ms) {
+    ExecCtx exec_ctx;
+    grpc_endpoint_pair sfd = grpc_iomgr_create_endpoint_pair("fixture", nullptr);
+    client_ = sfd.client;
+    server_ = grpc_server_create(nullptr, nullptr);
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    grpc_server_start(server_);
+    grpc_arg arg;
+    arg.type = GRPC_ARG_INTEGER;
+    arg.key = const_cast<char*>(GRPC_ARG_KEEPALIVE_TIMEOUT_MS);
+    arg.value.integer = keepalive_timeout_ms;
+    grpc_channel_args args = {1, &arg};
+    transport_ = grpc_create_chttp2_transport(&args, sfd.server, false);
+    grpc_server_setup_transport(server_, transport_, nullptr,
+                                grpc_server_get_channel_args(server_), nullptr);
+    grpc_chttp2_transport_start_reading(transport_, nullptr, nullptr);
+    grpc_endpoint_add_to_pollset(sfd.client, grpc_cq_pollset(cq_));
+    grpc_endpoint_add_to_pollset(sfd.server, grpc_cq_pollset(cq_));
+    Write(std::string(kPreface, sizeof(kPreface) - 1));
+    Frame settings = ReadFrame();
+    ASSERT_EQ(kFrameSettings, settings.type);
+    WriteFrame(kFrameSettings, kFlagAck, 0, "");
+  }
+
+  // Has the transport shut down the way server shutdown and max connection
+  // age do.
+  void SendGoaway() {
+    ExecCtx exec_ctx;
+    grpc_transport_op* op = grpc_make_transport_op(nullptr);
+    op->goaway_error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("test"),
+                           GRPC_ERROR_INT_HTTP2_ERROR, GRPC_HTTP2_NO_ERROR);
+    grpc_transport_perform_op(transport_, op);
+  }
+
+  // Reads frames until the first GOAWAY and the ping sent with it have both
+  // arrived, and returns the ping's opaque data.
+  std::string ReadFirstGoaway() {
+    bool got_goaway = false;
+    std::string ping_data;
+    while ((!got_goaway || ping_data.empty()) && !HasFailure()) {
+      Frame frame = ReadFrame();
+      if (frame.type == kFrameGoaway) {
+        EXPECT_FALSE(got_goaway);
+        EXPECT_EQ(kMaxStreamId, frame.goaway_last_stream_id());
+        EXPECT_EQ(static_cast<uint32_t>(GRPC_HTTP2_NO_ERROR),
+                  frame.goaway_error_code());
+        got_goaway = true;
+      } else if (frame.type == kFramePing && !(frame.flags & kFlagAck)) {
+        EXPECT_EQ(8u, frame.payload.size());
+        ping_data = frame.payload;
+      }
+    }
+    return ping_data;
+  }
+
+  // Reads frames until a GOAWAY arrives, and returns it.
+  Frame ReadGoaway() {
+    Frame frame;
+    while (!HasFailure()) {
+      frame = ReadFrame();
+      if (frame.type == kFrameGoaway) break;
+    }
+    return frame;
+  }
+
+  Frame ReadFrame() {
+    Frame frame;
+    if (!ReadBytes(9)) {
+      ADD_FAILURE() << "connection closed while waiting for a frame";
+      return frame;
+    }
+    const size_t length = ReadUint32(pending_, 0) >> 8;
+    if (!ReadBytes(9 + length)) {
+      ADD_FAILURE() << "connection closed in the middle of a frame";
+      return frame;
+    }
+    frame.type = static_cast<uint8_t>(pending_[3]);
+    frame.flags = static_cast<uint8_t>(pending_[4]);
+    frame.stream_id = ReadUint32(pending_, 5) & kMaxStreamId;
+    frame.payload = pending_.substr(9, length);
+    pending_.erase(0, 9 + length);
+    gpr_log(GPR_INFO, "client got frame type=%d flags=%d stream=%d length=%d",
+            frame.type, frame.flags, frame.stream_id,
+            static_cast<int>(length));
+    return frame;
+  }
+
+  // Returns true if the server closed the connection within timeout_ms.
+  bool WaitForClose(int timeout_ms) {
+    gpr_timespec deadline = grpc_timeout_milliseconds_to_deadline(timeout_ms);
+    while (!closed_) {
+      if (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) > 0) {
+        return false;
+      }
+      pending_.clear();
+      ReadBytes(1);
+    }
+    return true;
+  }
+
+  void WriteFrame(uint8_t type, uint8_t flags, uint32_t stream_id,
+                  const std::string& payload) {
+    std::string frame;
+    const uint32_t length = static_cast<uint32_t>(payload.size());
+    frame.push_back(static_cast<char>(length >> 16));
+    frame.push_back(static_cast<char>(length >> 8));
+    frame.push_back(static_cast<char>(length));
+    frame.push_back(static_cast<char>(type));
+    frame.push_back(static_cast<char>(flags));
+    frame.push_back(static_cast<char>(stream_id >> 24));
+    frame.push_back(static_cast<char>(stream_id >> 16));
+    frame.push_back(static_cast<char>(stream_id >> 8));
+    frame.push_back(static_cast<char>(stream_id));
+    Write(frame + payload);
+  }
+
+  void Write(const std::string& bytes) {
+    ExecCtx exec_ctx;
+    gpr_event done;
+    gpr_event_init(&done);
+    grpc_closure on_done;
+    GRPC_CLOSURE_INIT(&on_done, SetEvent, &done, grpc_schedule_on_exec_ctx);
+    grpc_slice_buffer outgoing;
+    grpc_slice_buffer_init(&outgoing);
+    grpc_slice_buffer_add(&outgoing, grpc_slice_from_copied_buffer(
+                                         bytes.data(), bytes.size()));
+    grpc_endpoint_write(client_, &outgoing, &on_done, nullptr);
+    ExecCtx::Get()->Flush();
+    PollUntil(&done);
+    grpc_slice_buffer_destroy_internal(&outgoing);
+  }
+
+  // Polls until t completes on the server cq. Other completions are
+  // remembered, so that they can be waited for later.
+  void WaitForTag(void* t) {
+    gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+    while (completed_.erase(t) == 0) {
+      ASSERT_LT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline), 0);
+      Poll();
+    }
+  }
+
+  grpc_server* server_ = nullptr;
+  grpc_completion_queue* cq_ = nullptr;
+
+ private:
+  static void SetEvent(void* arg, grpc_error* error) {
+    gpr_event_set(static_cast<gpr_event*>(arg), reinterpret_cast<void*>(1));
+  }
+
+  // Both endpoints are polled through the server cq.
+  void Poll() {
+    grpc_event ev = grpc_completion_queue_next(
+        cq_, grpc_timeout_milliseconds_to_deadline(100), nullptr);
+    if (ev.type == GRPC_OP_COMPLETE) {
+      EXPECT_TRUE(ev.success);
+      completed_.insert(ev.tag);
+    }
+  }
+
+  void PollUntil(gpr_event* event) {
+    gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+    while (gpr_event_get(event) == nullptr) {
+      ASSERT_LT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline), 0);
+      Poll();
+    }
+  }
+
+  // Reads until pending_ holds at least n bytes. Returns false if the
+  // connection closes first.
+  bool ReadBytes(size_t n) {
+    while (pending_.size() < n && !closed_) {
+      ExecCtx exec_ctx;
+      gpr_event_init(&read_done_);
+      grpc_endpoint_read(client_, &read_buffer_, &on_read_done_,
+                         /*urgent=*/true);
+      ExecCtx::Get()->Flush();
+      PollUntil(&read_done_);
+      if (HasFailure()) return false;
+      for (size_t i = 0; i < read_buffer_.count; i++) {
+        pending_.append(
+            reinterpret_cast<const char*>(
+                GRPC_SLICE_START_PTR(read_buffer_.slices[i])),
+            GRPC_SLICE_LENGTH(read_buffer_.slices[i]));
+      }
+      grpc_slice_buffer_reset_and_unref_internal(&read_buffer_);
+    }
+    return pending_.size() >= n;
+  }
+
+  static void SetReadDone(void* arg, grpc_error* error) {
+    GracefulGoawayTest* self = static_cast<GracefulGoawayTest*>(arg);
+    if (error != GRPC_ERROR_NONE) self->closed_ = true;
+    gpr_event_set(&self->read_done_, reinterpret_cast<void*>(1));
+  }
+
+  grpc_endpoint* client_ = nullptr;
+  grpc_transport* transport_ = nullptr;
+  grpc_slice_buffer read_buffer_;
+  grpc_closure on_read_done_;
+  gpr_event read_done_;
+  std::string pending_;
+  bool closed_ = false;
+  std::set<void*> completed_;
+};
+
+TEST_F(GracefulGoawayTest, FinalGoawayFollowsPingAck) {
+  StartServer(20000);
+  SendGoaway();
+  std::string ping_data = ReadFirstGoaway();
+  WriteFrame(kFramePing, kFlagAck, 0, ping_data);
+  Frame goaway = ReadGoaway();
+  EXPECT_EQ(0u, goaway.goaway_last_stream_id());
+  EXPECT_EQ(static_cast<uint32_t>(GRPC_HTTP2_NO_ERROR),
+            goaway.goaway_error_code());
+  // With no streams open the connection goes away with the final GOAWAY.
+  EXPECT_TRUE(WaitForClose(5000));
+}
+
+TEST_F(GracefulGoawayTest, FinalGoawayFollowsTimeoutWithoutPingAck) {
+  const int kKeepaliveTimeoutMs = 500;
+  StartServer(kKeepaliveTimeoutMs);
+  SendGoaway();
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  ReadFirstGoaway();
+  Frame goaway = ReadGoaway();
+  EXPECT_GE(gpr_time_to_millis(
+                gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start)),
+            kKeepaliveTimeoutMs / 2);
+  EXPECT_EQ(0u, goaway.goaway_last_stream_id());
+  EXPECT_TRUE(WaitForClose(5000));
+}
+
+TEST_F(GracefulGoawayTest, StreamOpenedBeforePingAckIsServed) {
+  StartServer(20000);
+  SendGoaway();
+  std::string ping_data = ReadFirstGoaway();
+  // The client opens a stream before it has seen the GOAWAY, and acks the
+  // ping after that.
+  Write(std::string(kRequestHeaders, sizeof(kRequestHeaders) - 1));
+  WriteFrame(kFramePing, kFlagAck, 0, ping_data);
+  Frame goaway = ReadGoaway();
+  EXPECT_EQ(1u, goaway.goaway_last_stream_id());
+  // The server application gets the call and answers it.
+  grpc_call* call;
+  grpc_call_details call_details;
+  grpc_metadata_array request_metadata;
+  grpc_call_details_init(&call_details);
+  grpc_metadata_array_init(&request_metadata);
+  ASSERT_EQ(GRPC_CALL_OK,
+            grpc_server_request_call(server_, &call, &call_details,
+                                     &request_metadata, cq_, cq_, tag(101)));
+  WaitForTag(tag(101));
+  EXPECT_EQ(0, grpc_slice_str_cmp(call_details.method, "/foo/bar"));
+  grpc_op ops[2];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  ops[1].data.send_status_from_server.status = GRPC_STATUS_OK;
+  ASSERT_EQ(GRPC_CALL_OK,
+            grpc_call_start_batch(call, ops, 2, tag(102), nullptr));
+  // The client sees the stream finish rather than being reset.
+  while (!HasFailure()) {
+    Frame frame = ReadFrame();
+    ASSERT_FALSE(frame.type == kFrameRstStream && frame.stream_id == 1);
+    if (frame.type == kFrameHeaders && frame.stream_id == 1 &&
+        (frame.flags & kFlagEndStream)) {
+      break;
+    }
+  }
+  WaitForTag(tag(102));
+  grpc_call_unref(call);
+  grpc_call_details_destroy(&call_details);
+  grpc_metadata_array_destroy(&request_metadata);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  int result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
@@ -250,6 +250,45 @@ static void test_interned_key_indexed() {
   }
 }
 
+static void test_cached_blocks() {
+  verify_params params = {
+      false,
+      false,
+      false,
+  };
+  verify(params, "000005 0104 deadbeef 40 0161 0161", 1, "a", "a");
+  /* encoded from the table, and remembered as such */
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+  /* spliced from the cache */
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+  /* adding to the table moves a, so the cached bytes are stale */
+  verify(params, "000005 0104 deadbeef 40 0162 0162", 1, "b", "b");
+  verify(params, "000001 0104 deadbeef bf", 1, "a", "a");
+  verify(params, "000001 0104 deadbeef bf", 1, "a", "a");
+  verify(params, "000002 0104 deadbeef bf be", 2, "a", "a", "b", "b");
+  verify(params, "000002 0104 deadbeef bf be", 2, "a", "a", "b", "b");
+}
+
+static void test_release_idle() {
+  verify_params params = {
+      false,
+      false,
+      false,
+  };
+  verify(params, "000005 0104 deadbeef 40 0161 0161", 1, "a", "a");
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+  grpc_chttp2_hpack_compressor_release_idle(&g_compressor);
+  /* the decoder still has a at 62, but the compressor no longer knows it:
+     once b is added there, neither the table nor a stale cached block may
+     refer to a by that index, so it is sent and indexed again */
+  verify(params, "000005 0104 deadbeef 40 0162 0163", 1, "b", "c");
+  verify(params, "000005 0104 deadbeef 40 0161 0161", 1, "a", "a");
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+  verify(params, "000002 0104 deadbeef be bf", 2, "a", "a", "b", "c");
+}
+
 static void run_test(void (*test)(), const char* name) {
   gpr_log(GPR_INFO, "RUN TEST: %s", name);
   grpc_core::ExecCtx exec_ctx;
@@ -267,6 +306,8 @@ int main(int argc, char** argv) {
   TEST(test_decode_table_overflow);
   TEST(test_encode_header_size);
   TEST(test_interned_key_indexed);
+  TEST(test_cached_blocks);
+  TEST(test_release_idle);
   grpc_shutdown();
   for (i = 0; i < num_to_delete; i++) {
     gpr_free(to_delete[i]);
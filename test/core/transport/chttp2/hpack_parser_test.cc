@@ -209,6 +209,14 @@ static void test_vectors(grpc_slice_split_mode mode) {
               "set-cookie",
               "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1", NULL);
   grpc_chttp2_hpack_parser_destroy(&parser);
+
+  grpc_chttp2_hpack_parser_init(&parser);
+  /* huffman codes longer than the parser's fast decode table */
+  test_vector(&parser, mode,
+              "0088 25a8 49e9 5ba9 7d7f 921f ff7f ff7f"
+              "fbff fc3f fcff 9fff 3fef dfff f0",
+              "custom-key", "a~{}\\^|<>z\\", NULL);
+  grpc_chttp2_hpack_parser_destroy(&parser);
 }
 
 int main(int argc, char** argv) {
@@ -147,6 +147,131 @@ static void test_many_additions(void) {
   grpc_chttp2_hptbl_destroy(&tbl);
 }
 
+static void test_grow_and_shrink(void) {
+  grpc_chttp2_hptbl tbl;
+  int i;
+  char* key;
+  char* value;
+
+  LOG_TEST("test_grow_and_shrink");
+
+  grpc_core::ExecCtx exec_ctx;
+
+  /* nothing is allocated until something is added */
+  GPR_ASSERT(tbl.cap_entries == 0);
+  /* each entry is 32 + 4 + 4 bytes, so 102 fit in the default 4096 */
+  for (i = 0; i < 300; i++) {
+    grpc_mdelem elem;
+    gpr_asprintf(&key, "K%03d", i);
+    gpr_asprintf(&value, "V%03d", i);
+    elem = grpc_mdelem_from_slices(grpc_slice_from_copied_string(key),
+                                   grpc_slice_from_copied_string(value));
+    GPR_ASSERT(grpc_chttp2_hptbl_add(&tbl, elem) == GRPC_ERROR_NONE);
+    GRPC_MDELEM_UNREF(elem);
+    gpr_free(key);
+    gpr_free(value);
+    GPR_ASSERT(tbl.num_ents <= tbl.cap_entries);
+    GPR_ASSERT((tbl.cap_entries & (tbl.cap_entries - 1)) == 0);
+  }
+  GPR_ASSERT(tbl.num_ents == 102);
+  GPR_ASSERT(tbl.cap_entries == 128);
+  for (i = 0; i < 102; i++) {
+    gpr_asprintf(&key, "K%03d", 299 - i);
+    gpr_asprintf(&value, "V%03d", 299 - i);
+    assert_index(&tbl, 1 + GRPC_CHTTP2_LAST_STATIC_ENTRY + i, key, value);
+    gpr_free(key);
+    gpr_free(value);
+  }
+
+  /* shrinking the table evicts the oldest entries and the storage with them */
+  GPR_ASSERT(grpc_chttp2_hptbl_set_current_table_size(&tbl, 400) ==
+             GRPC_ERROR_NONE);
+  GPR_ASSERT(tbl.num_ents == 10);
+  GPR_ASSERT(tbl.cap_entries == grpc_chttp2_hptbl::kInitialCapacity);
+  for (i = 0; i < 10; i++) {
+    gpr_asprintf(&key, "K%03d", 299 - i);
+    gpr_asprintf(&value, "V%03d", 299 - i);
+    assert_index(&tbl, 1 + GRPC_CHTTP2_LAST_STATIC_ENTRY + i, key, value);
+    gpr_free(key);
+    gpr_free(value);
+  }
+  GPR_ASSERT(GRPC_MDISNULL(grpc_chttp2_hptbl_lookup(
+      &tbl, 11 + GRPC_CHTTP2_LAST_STATIC_ENTRY)));
+
+  grpc_chttp2_hptbl_destroy(&tbl);
+}
+
+static void add_entries(grpc_chttp2_hptbl* tbl, int first, int count) {
+  char* key;
+  char* value;
+  for (int i = first; i < first + count; i++) {
+    grpc_mdelem elem;
+    gpr_asprintf(&key, "K%03d", i);
+    gpr_asprintf(&value, "V%03d", i);
+    elem = grpc_mdelem_from_slices(grpc_slice_from_copied_string(key),
+                                   grpc_slice_from_copied_string(value));
+    GPR_ASSERT(grpc_chttp2_hptbl_add(tbl, elem) == GRPC_ERROR_NONE);
+    GRPC_MDELEM_UNREF(elem);
+    gpr_free(key);
+    gpr_free(value);
+  }
+}
+
+/* checks that the dynamic table holds exactly entries last - count + 1 to
+   last, newest first */
+static void assert_entries(const grpc_chttp2_hptbl* tbl, int last, int count) {
+  char* key;
+  char* value;
+  GPR_ASSERT(tbl->num_ents == static_cast<uint32_t>(count));
+  for (int i = 0; i < count; i++) {
+    gpr_asprintf(&key, "K%03d", last - i);
+    gpr_asprintf(&value, "V%03d", last - i);
+    assert_index(tbl, 1 + GRPC_CHTTP2_LAST_STATIC_ENTRY + i, key, value);
+    gpr_free(key);
+    gpr_free(value);
+  }
+  GPR_ASSERT(GRPC_MDISNULL(grpc_chttp2_hptbl_lookup(
+      tbl, 1 + GRPC_CHTTP2_LAST_STATIC_ENTRY + count)));
+}
+
+static void test_shrink_to_fit(void) {
+  grpc_chttp2_hptbl tbl;
+
+  LOG_TEST("test_shrink_to_fit");
+
+  grpc_core::ExecCtx exec_ctx;
+
+  add_entries(&tbl, 0, 300);
+  assert_entries(&tbl, 299, 102);
+  GPR_ASSERT(tbl.cap_entries == 128);
+
+  /* a smaller table that still needs more than a third of the storage keeps
+     it, until the connection goes idle */
+  GPR_ASSERT(grpc_chttp2_hptbl_set_current_table_size(&tbl, 2400) ==
+             GRPC_ERROR_NONE);
+  GPR_ASSERT(tbl.cap_entries == 128);
+  grpc_chttp2_hptbl_shrink_to_fit(&tbl);
+  GPR_ASSERT(tbl.cap_entries == 64);
+  assert_entries(&tbl, 299, 60);
+
+  /* an empty table gives up its storage entirely... */
+  GPR_ASSERT(grpc_chttp2_hptbl_set_current_table_size(&tbl, 0) ==
+             GRPC_ERROR_NONE);
+  grpc_chttp2_hptbl_shrink_to_fit(&tbl);
+  GPR_ASSERT(tbl.cap_entries == 0);
+  GPR_ASSERT(tbl.ents == nullptr);
+  assert_entries(&tbl, 0, 0);
+
+  /* ...and grows it back as entries arrive */
+  GPR_ASSERT(grpc_chttp2_hptbl_set_current_table_size(&tbl, 4096) ==
+             GRPC_ERROR_NONE);
+  add_entries(&tbl, 300, 20);
+  GPR_ASSERT(tbl.cap_entries == 32);
+  assert_entries(&tbl, 319, 20);
+
+  grpc_chttp2_hptbl_destroy(&tbl);
+}
+
 static grpc_chttp2_hptbl_find_result find_simple(grpc_chttp2_hptbl* tbl,
                                                  const char* key,
                                                  const char* value) {
@@ -268,6 +393,8 @@ int main(int argc, char** argv) {
   grpc_init();
   test_static_lookup();
   test_many_additions();
+  test_grow_and_shrink();
+  test_shrink_to_fit();
   test_find();
   grpc_shutdown();
   return 0;
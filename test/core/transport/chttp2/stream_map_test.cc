@@ -71,7 +71,13 @@ static void test_basic_add_find(uint32_t n) {
 static void verify_for_each(void* user_data, uint32_t stream_id, void* ptr) {
   uint32_t* for_each_check = static_cast<uint32_t*>(user_data);
   GPR_ASSERT(ptr);
+#ifdef GRPC_CHTTP2_HASH_STREAM_MAP
+  /* the hashed map visits streams in no particular order */
+  GPR_ASSERT(stream_id & 1);
+  GPR_ASSERT((uintptr_t)ptr == stream_id);
+#else
   GPR_ASSERT(*for_each_check == stream_id);
+#endif
   *for_each_check += 2;
 }
 
@@ -161,7 +167,12 @@ static void test_periodic_compaction(uint32_t n) {
                  grpc_chttp2_stream_map_delete(&map, del));
     }
   }
+#ifdef GRPC_CHTTP2_HASH_STREAM_MAP
+  /* nine live streams at a time fit in 32 slots at under half load */
+  GPR_ASSERT(map.capacity <= 32);
+#else
   GPR_ASSERT(map.capacity == 16);
+#endif
   grpc_chttp2_stream_map_destroy(&map);
 }
 
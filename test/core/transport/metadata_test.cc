@@ -18,6 +18,7 @@
 
 #include "src/core/lib/transport/metadata.h"
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -31,6 +32,7 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/static_metadata.h"
 #include "test/core/util/test_config.h"
 
@@ -391,6 +393,61 @@ static void test_copied_static_metadata(bool dup_key, bool dup_value) {
   grpc_shutdown();
 }
 
+static void test_metadata_batch_find(bool intern_keys) {
+  gpr_log(GPR_INFO, "test_metadata_batch_find: intern_keys=%d", intern_keys);
+  grpc_init();
+  grpc_core::ExecCtx exec_ctx;
+
+  /* more custom keys than the index has slots */
+  const size_t kNumCustom = 3 * GRPC_BATCH_CUSTOM_INDEX_SIZE;
+  grpc_linked_mdelem storage[kNumCustom + 1];
+  grpc_metadata_batch batch;
+  grpc_metadata_batch_init(&batch);
+  char key[32];
+  for (size_t i = 0; i < kNumCustom; i++) {
+    snprintf(key, sizeof(key), "key%" PRIuPTR, i);
+    GPR_ASSERT(grpc_metadata_batch_add_tail(
+                   &batch, &storage[i],
+                   grpc_mdelem_from_slices(
+                       maybe_intern(grpc_slice_from_copied_string(key),
+                                    intern_keys),
+                       grpc_slice_from_static_string("value"))) ==
+               GRPC_ERROR_NONE);
+  }
+  GPR_ASSERT(grpc_metadata_batch_add_tail(&batch, &storage[kNumCustom],
+                                          GRPC_MDELEM_GRPC_STATUS_0) ==
+             GRPC_ERROR_NONE);
+
+  for (size_t i = 0; i < kNumCustom; i++) {
+    snprintf(key, sizeof(key), "key%" PRIuPTR, i);
+    grpc_slice k = grpc_slice_from_copied_string(key);
+    GPR_ASSERT(grpc_metadata_batch_find(&batch, k) == &storage[i]);
+    grpc_slice_unref_internal(k);
+  }
+  grpc_slice status = grpc_slice_from_copied_string("grpc-status");
+  GPR_ASSERT(grpc_metadata_batch_find(&batch, status) == &storage[kNumCustom]);
+  grpc_slice_unref_internal(status);
+  GPR_ASSERT(grpc_metadata_batch_find(&batch, GRPC_MDSTR_GRPC_MESSAGE) ==
+             nullptr);
+  grpc_slice missing = grpc_slice_from_static_string("missing");
+  GPR_ASSERT(grpc_metadata_batch_find(&batch, missing) == nullptr);
+
+  /* removed elements are no longer found, the others still are */
+  for (size_t i = 0; i < kNumCustom; i += 2) {
+    grpc_metadata_batch_remove(&batch, &storage[i]);
+  }
+  for (size_t i = 0; i < kNumCustom; i++) {
+    snprintf(key, sizeof(key), "key%" PRIuPTR, i);
+    grpc_slice k = grpc_slice_from_copied_string(key);
+    GPR_ASSERT(grpc_metadata_batch_find(&batch, k) ==
+               (i % 2 == 0 ? nullptr : &storage[i]));
+    grpc_slice_unref_internal(k);
+  }
+
+  grpc_metadata_batch_destroy(&batch);
+  grpc_shutdown();
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -409,6 +466,8 @@ int main(int argc, char** argv) {
   test_things_stick_around();
   test_user_data_works();
   test_user_data_works_for_allocated_md();
+  test_metadata_batch_find(false);
+  test_metadata_batch_find(true);
   grpc_shutdown();
   return 0;
 }
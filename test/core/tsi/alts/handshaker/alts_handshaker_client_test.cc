@@ -18,6 +18,8 @@
 
 #include <grpc/grpc.h>
 
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
 #include "src/core/tsi/alts/handshaker/alts_shared_resource.h"
 #include "src/core/tsi/alts/handshaker/alts_tsi_handshaker.h"
@@ -30,6 +32,9 @@
 #define ALTS_HANDSHAKER_CLIENT_TEST_TARGET_NAME "bigtable.google.api.com"
 #define ALTS_HANDSHAKER_CLIENT_TEST_TARGET_SERVICE_ACCOUNT1 "A@google.com"
 #define ALTS_HANDSHAKER_CLIENT_TEST_TARGET_SERVICE_ACCOUNT2 "B@google.com"
+#define ALTS_HANDSHAKER_CLIENT_TEST_PEER_IDENTITY "C@google.com"
+#define ALTS_HANDSHAKER_CLIENT_TEST_KEY_DATA \
+  "ABCDEFGHIJKLMNOPABCDEFGHIJKLMNOPABCDEFGHIJKL"
 
 const size_t kHandshakerClientOpNum = 4;
 const size_t kMaxRpcVersionMajor = 3;
@@ -43,6 +48,11 @@ using grpc_core::internal::
 using grpc_core::internal::
     alts_handshaker_client_get_recv_buffer_addr_for_testing;
 using grpc_core::internal::alts_handshaker_client_get_send_buffer_for_testing;
+using grpc_core::internal::alts_handshaker_client_get_status_for_testing;
+using grpc_core::internal::alts_handshaker_client_is_queued_for_testing;
+using grpc_core::internal::
+    alts_handshaker_client_reset_handshake_queues_for_testing;
+using grpc_core::internal::alts_handshaker_client_set_fields_for_testing;
 using grpc_core::internal::alts_handshaker_client_set_grpc_caller_for_testing;
 
 typedef struct alts_handshaker_client_test_config {
@@ -397,6 +407,272 @@ static void schedule_request_grpc_call_failure_test() {
   destroy_config(config);
 }
 
+/* Clients whose handshake RPC has been made, in order. */
+static alts_handshaker_client* g_started_clients[8];
+static size_t g_num_started_clients;
+/* Clients whose response callback ran without a call being made. */
+static alts_handshaker_client* g_failed_clients[8];
+static size_t g_num_failed_clients;
+static size_t g_num_finished_handshakes;
+
+/* A mock grpc_caller recording that the handshake RPC was made. */
+static grpc_call_error record_started_client(grpc_call* call,
+                                             const grpc_op* op, size_t nops,
+                                             grpc_closure* closure) {
+  GPR_ASSERT(g_num_started_clients < GPR_ARRAY_SIZE(g_started_clients));
+  g_started_clients[g_num_started_clients++] =
+      static_cast<alts_handshaker_client*>(closure->cb_arg);
+  return GRPC_CALL_OK;
+}
+
+/* The grpc_cb of queued clients, recording handshakes completed by the
+ * queue itself. */
+static void record_failed_client(void* arg, grpc_error* error) {
+  GPR_ASSERT(g_num_failed_clients < GPR_ARRAY_SIZE(g_failed_clients));
+  g_failed_clients[g_num_failed_clients++] =
+      static_cast<alts_handshaker_client*>(arg);
+}
+
+static void on_handshake_finished(tsi_result status, void* user_data,
+                                  const unsigned char* bytes_to_send,
+                                  size_t bytes_to_send_size,
+                                  tsi_handshaker_result* result) {
+  GPR_ASSERT(status == TSI_OK);
+  GPR_ASSERT(result != nullptr);
+  tsi_handshaker_result_destroy(result);
+  g_num_finished_handshakes++;
+}
+
+static void reset_handshake_queues(int32_t max_concurrent_handshakes) {
+  GPR_GLOBAL_CONFIG_SET(grpc_alts_max_concurrent_handshakes,
+                        max_concurrent_handshakes);
+  alts_handshaker_client_reset_handshake_queues_for_testing();
+  g_num_started_clients = 0;
+  g_num_failed_clients = 0;
+  g_num_finished_handshakes = 0;
+}
+
+static alts_handshaker_client* create_queued_client(grpc_channel* channel,
+                                                    bool is_client) {
+  grpc_alts_credentials_options* options =
+      create_credentials_options(is_client);
+  alts_handshaker_client* client = alts_grpc_handshaker_client_create(
+      nullptr, channel, ALTS_HANDSHAKER_SERVICE_URL_FOR_TESTING, nullptr,
+      options,
+      grpc_slice_from_static_string(ALTS_HANDSHAKER_CLIENT_TEST_TARGET_NAME),
+      record_failed_client, nullptr, nullptr, nullptr, is_client);
+  GPR_ASSERT(client != nullptr);
+  grpc_alts_credentials_options_destroy(options);
+  alts_handshaker_client_set_grpc_caller_for_testing(client,
+                                                     record_started_client);
+  return client;
+}
+
+/* Serializes a handshaker response carrying a handshake result. */
+static grpc_byte_buffer* create_finished_response() {
+  upb::Arena arena;
+  grpc_gcp_HandshakerResp* resp = grpc_gcp_HandshakerResp_new(arena.ptr());
+  grpc_gcp_HandshakerStatus* status =
+      grpc_gcp_HandshakerResp_mutable_status(resp, arena.ptr());
+  grpc_gcp_HandshakerStatus_set_code(status, 0);
+  grpc_gcp_HandshakerResult* result =
+      grpc_gcp_HandshakerResp_mutable_result(resp, arena.ptr());
+  grpc_gcp_Identity* peer_identity =
+      grpc_gcp_HandshakerResult_mutable_peer_identity(result, arena.ptr());
+  grpc_gcp_Identity_set_service_account(
+      peer_identity,
+      upb_strview_makez(ALTS_HANDSHAKER_CLIENT_TEST_PEER_IDENTITY));
+  grpc_gcp_HandshakerResult_set_key_data(
+      result, upb_strview_makez(ALTS_HANDSHAKER_CLIENT_TEST_KEY_DATA));
+  GPR_ASSERT(grpc_gcp_handshaker_resp_set_peer_rpc_versions(
+      resp, arena.ptr(), kMaxRpcVersionMajor, kMaxRpcVersionMinor,
+      kMinRpcVersionMajor, kMinRpcVersionMinor));
+  size_t buf_len;
+  char* buf = grpc_gcp_HandshakerResp_serialize(resp, arena.ptr(), &buf_len);
+  grpc_slice slice = grpc_slice_from_copied_buffer(buf, buf_len);
+  grpc_byte_buffer* buffer = grpc_raw_byte_buffer_create(&slice, 1);
+  grpc_slice_unref(slice);
+  return buffer;
+}
+
+static void handshake_queue_limit_test() {
+  reset_handshake_queues(2);
+  grpc_channel* channel = grpc_insecure_channel_create(
+      ALTS_HANDSHAKER_SERVICE_URL_FOR_TESTING, nullptr, nullptr);
+  alts_handshaker_client* clients[4];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(clients); ++i) {
+    clients[i] = create_queued_client(channel, true /* is_client */);
+    GPR_ASSERT(alts_handshaker_client_start_client(clients[i]) == TSI_OK);
+  }
+  /* Only the first two handshakes were started; the rest wait. */
+  GPR_ASSERT(g_num_started_clients == 2);
+  GPR_ASSERT(g_started_clients[0] == clients[0]);
+  GPR_ASSERT(g_started_clients[1] == clients[1]);
+  GPR_ASSERT(!alts_handshaker_client_is_queued_for_testing(clients[1]));
+  GPR_ASSERT(alts_handshaker_client_is_queued_for_testing(clients[2]));
+  GPR_ASSERT(alts_handshaker_client_is_queued_for_testing(clients[3]));
+  /* Server handshakes have a queue of their own. */
+  alts_handshaker_client* server =
+      create_queued_client(channel, false /* is_client */);
+  grpc_slice out_frame =
+      grpc_slice_from_static_string(ALTS_HANDSHAKER_CLIENT_TEST_OUT_FRAME);
+  GPR_ASSERT(alts_handshaker_client_start_server(server, &out_frame) ==
+             TSI_OK);
+  GPR_ASSERT(g_num_started_clients == 3);
+  GPR_ASSERT(g_started_clients[2] == server);
+  /* Next requests of a running handshake don't wait. */
+  GPR_ASSERT(alts_handshaker_client_next(clients[0], &out_frame) == TSI_OK);
+  GPR_ASSERT(g_num_started_clients == 4);
+  GPR_ASSERT(g_started_clients[3] == clients[0]);
+  alts_handshaker_client_destroy(server);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(clients); ++i) {
+    alts_handshaker_client_destroy(clients[i]);
+  }
+  GPR_ASSERT(g_num_failed_clients == 0);
+  grpc_slice_unref(out_frame);
+  grpc_channel_destroy(channel);
+}
+
+static void handshake_queue_handoff_on_completion_test() {
+  reset_handshake_queues(1);
+  grpc_channel* channel = grpc_insecure_channel_create(
+      ALTS_HANDSHAKER_SERVICE_URL_FOR_TESTING, nullptr, nullptr);
+  alts_handshaker_client* running =
+      create_queued_client(channel, true /* is_client */);
+  alts_handshaker_client* queued =
+      create_queued_client(channel, true /* is_client */);
+  GPR_ASSERT(alts_handshaker_client_start_client(running) == TSI_OK);
+  GPR_ASSERT(alts_handshaker_client_start_client(queued) == TSI_OK);
+  GPR_ASSERT(g_num_started_clients == 1);
+  /* A response finishing the running handshake frees its slot. */
+  grpc_alts_credentials_options* options =
+      create_credentials_options(true /* is_client */);
+  tsi_handshaker* handshaker = nullptr;
+  GPR_ASSERT(alts_tsi_handshaker_create(
+                 options, ALTS_HANDSHAKER_CLIENT_TEST_TARGET_NAME,
+                 ALTS_HANDSHAKER_SERVICE_URL_FOR_TESTING, true /* is_client */,
+                 nullptr, &handshaker) == TSI_OK);
+  grpc_alts_credentials_options_destroy(options);
+  alts_handshaker_client_set_fields_for_testing(
+      running, reinterpret_cast<alts_tsi_handshaker*>(handshaker),
+      on_handshake_finished, nullptr, create_finished_response(),
+      GRPC_STATUS_OK);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    alts_handshaker_client_handle_response(running, true /* is_ok */);
+  }
+  GPR_ASSERT(g_num_finished_handshakes == 1);
+  GPR_ASSERT(g_num_started_clients == 2);
+  GPR_ASSERT(g_started_clients[1] == queued);
+  GPR_ASSERT(!alts_handshaker_client_is_queued_for_testing(queued));
+  /* Destroying the finished client must not free another slot. */
+  alts_handshaker_client_destroy(running);
+  alts_handshaker_client* next =
+      create_queued_client(channel, true /* is_client */);
+  GPR_ASSERT(alts_handshaker_client_start_client(next) == TSI_OK);
+  GPR_ASSERT(g_num_started_clients == 2);
+  GPR_ASSERT(alts_handshaker_client_is_queued_for_testing(next));
+  alts_handshaker_client_destroy(queued);
+  alts_handshaker_client_destroy(next);
+  GPR_ASSERT(g_num_failed_clients == 0);
+  tsi_handshaker_destroy(handshaker);
+  grpc_channel_destroy(channel);
+}
+
+static void handshake_queue_handoff_on_destroy_test() {
+  reset_handshake_queues(1);
+  grpc_channel* channel = grpc_insecure_channel_create(
+      ALTS_HANDSHAKER_SERVICE_URL_FOR_TESTING, nullptr, nullptr);
+  alts_handshaker_client* clients[3];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(clients); ++i) {
+    clients[i] = create_queued_client(channel, true /* is_client */);
+    GPR_ASSERT(alts_handshaker_client_start_client(clients[i]) == TSI_OK);
+  }
+  GPR_ASSERT(g_num_started_clients == 1);
+  /* The slot of a destroyed client goes to the queued clients in FIFO
+   * order. */
+  alts_handshaker_client_destroy(clients[0]);
+  GPR_ASSERT(g_num_started_clients == 2);
+  GPR_ASSERT(g_started_clients[1] == clients[1]);
+  GPR_ASSERT(alts_handshaker_client_is_queued_for_testing(clients[2]));
+  alts_handshaker_client_destroy(clients[1]);
+  GPR_ASSERT(g_num_started_clients == 3);
+  GPR_ASSERT(g_started_clients[2] == clients[2]);
+  alts_handshaker_client_destroy(clients[2]);
+  GPR_ASSERT(g_num_failed_clients == 0);
+  grpc_channel_destroy(channel);
+}
+
+static void handshake_queue_shutdown_test() {
+  reset_handshake_queues(1);
+  grpc_channel* channel = grpc_insecure_channel_create(
+      ALTS_HANDSHAKER_SERVICE_URL_FOR_TESTING, nullptr, nullptr);
+  alts_handshaker_client* running =
+      create_queued_client(channel, true /* is_client */);
+  alts_handshaker_client* queued =
+      create_queued_client(channel, true /* is_client */);
+  alts_handshaker_client* last =
+      create_queued_client(channel, true /* is_client */);
+  GPR_ASSERT(alts_handshaker_client_start_client(running) == TSI_OK);
+  GPR_ASSERT(alts_handshaker_client_start_client(queued) == TSI_OK);
+  GPR_ASSERT(alts_handshaker_client_start_client(last) == TSI_OK);
+  /* Shutting down a queued handshake completes it as cancelled without
+   * ever making its call. */
+  alts_handshaker_client_shutdown(queued);
+  GPR_ASSERT(g_num_failed_clients == 1);
+  GPR_ASSERT(g_failed_clients[0] == queued);
+  GPR_ASSERT(alts_handshaker_client_get_status_for_testing(queued) ==
+             GRPC_STATUS_CANCELLED);
+  GPR_ASSERT(!alts_handshaker_client_is_queued_for_testing(queued));
+  /* It also gave up its place: the next slot goes to the client behind it,
+   * and destroying it afterwards doesn't free a slot. */
+  alts_handshaker_client_destroy(queued);
+  GPR_ASSERT(g_num_started_clients == 1);
+  alts_handshaker_client_destroy(running);
+  GPR_ASSERT(g_num_started_clients == 2);
+  GPR_ASSERT(g_started_clients[1] == last);
+  alts_handshaker_client_destroy(last);
+  GPR_ASSERT(g_num_failed_clients == 1);
+  grpc_channel_destroy(channel);
+}
+
+static void shared_resource_shards_test() {
+  const int32_t kNumShards = 3;
+  /* Restart the shared resource with several shards. */
+  grpc_alts_shared_resource_dedicated_shutdown();
+  GPR_GLOBAL_CONFIG_SET(grpc_alts_handshaker_channels, kNumShards);
+  grpc_alts_shared_resource_dedicated_init();
+  grpc_alts_shared_resource_dedicated_start(
+      ALTS_HANDSHAKER_SERVICE_URL_FOR_TESTING);
+  alts_shared_resource_dedicated* resource =
+      grpc_alts_get_shared_resource_dedicated();
+  GPR_ASSERT(resource->num_shards == static_cast<size_t>(kNumShards));
+  /* Starting again doesn't create more shards. */
+  alts_shared_resource_shard* shards = resource->shards;
+  grpc_alts_shared_resource_dedicated_start(
+      ALTS_HANDSHAKER_SERVICE_URL_FOR_TESTING);
+  GPR_ASSERT(resource->shards == shards);
+  /* Each shard has its own channel and completion queue. */
+  for (int32_t i = 0; i < kNumShards; ++i) {
+    for (int32_t j = 0; j < i; ++j) {
+      GPR_ASSERT(shards[i].channel != shards[j].channel);
+      GPR_ASSERT(shards[i].cq != shards[j].cq);
+    }
+  }
+  /* Handshakes are spread round robin. */
+  alts_shared_resource_shard* first =
+      grpc_alts_shared_resource_dedicated_pick_shard();
+  const size_t first_index = static_cast<size_t>(first - shards);
+  GPR_ASSERT(first_index < static_cast<size_t>(kNumShards));
+  for (int32_t i = 1; i < 2 * kNumShards; ++i) {
+    GPR_ASSERT(grpc_alts_shared_resource_dedicated_pick_shard() ==
+               &shards[(first_index + i) % kNumShards]);
+  }
+  grpc_alts_shared_resource_dedicated_shutdown();
+  GPR_GLOBAL_CONFIG_SET(grpc_alts_handshaker_channels, 1);
+  grpc_alts_shared_resource_dedicated_init();
+}
+
 int main(int argc, char** argv) {
   /* Initialization. */
   grpc_init();
@@ -405,6 +681,11 @@ int main(int argc, char** argv) {
   schedule_request_invalid_arg_test();
   schedule_request_success_test();
   schedule_request_grpc_call_failure_test();
+  handshake_queue_limit_test();
+  handshake_queue_handoff_on_completion_test();
+  handshake_queue_handoff_on_destroy_test();
+  handshake_queue_shutdown_test();
+  shared_resource_shards_test();
   /* Cleanup. */
   grpc_alts_shared_resource_dedicated_shutdown();
   grpc_shutdown();
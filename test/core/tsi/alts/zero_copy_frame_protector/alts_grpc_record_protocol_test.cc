@@ -19,6 +19,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_grpc_integrity_only_record_protocol.h"
@@ -291,6 +292,52 @@ static void random_seal_unseal(alts_grpc_record_protocol* sender,
   grpc_core::ExecCtx::Get()->Flush();
 }
 
+static void multi_frame_seal_unseal(alts_grpc_record_protocol* sender,
+                                    alts_grpc_record_protocol* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  for (size_t i = 0; i < kSealRepeatTimes; i++) {
+    alts_grpc_record_protocol_test_var* var =
+        alts_grpc_record_protocol_test_var_create();
+    /* Seals into frames that end at random places within the slices.  */
+    size_t data_length = var->original_sb.length;
+    size_t max_frame_data_size =
+        gsec_test_bias_random_uint32(kMaxSliceLength) + 1;
+    tsi_result status = alts_grpc_record_protocol_protect_frames(
+        sender, &var->original_sb, max_frame_data_size, &var->protected_sb);
+    if (status == TSI_UNIMPLEMENTED) {
+      /* Integrity-only frames are protected in place, one at a time.  */
+      alts_grpc_record_protocol_test_var_destroy(var);
+      break;
+    }
+    GPR_ASSERT(status == TSI_OK);
+    GPR_ASSERT(var->original_sb.length == 0);
+    size_t num_frames =
+        (data_length + max_frame_data_size - 1) / max_frame_data_size;
+    GPR_ASSERT(var->protected_sb.length ==
+               data_length +
+                   num_frames * (var->header_length + var->tag_length));
+    /* Unseals the frames one by one.  */
+    grpc_slice_buffer frame_sb;
+    grpc_slice_buffer_init(&frame_sb);
+    while (data_length > 0) {
+      size_t frame_data_size = GPR_MIN(data_length, max_frame_data_size);
+      grpc_slice_buffer_move_first(
+          &var->protected_sb,
+          frame_data_size + var->header_length + var->tag_length, &frame_sb);
+      status = alts_grpc_record_protocol_unprotect(receiver, &frame_sb,
+                                                   &var->unprotected_sb);
+      GPR_ASSERT(status == TSI_OK);
+      data_length -= frame_data_size;
+    }
+    GPR_ASSERT(var->protected_sb.length == 0);
+    GPR_ASSERT(
+        are_slice_buffers_equal(&var->unprotected_sb, &var->duplicate_sb));
+    grpc_slice_buffer_destroy_internal(&frame_sb);
+    alts_grpc_record_protocol_test_var_destroy(var);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 static void empty_seal_unseal(alts_grpc_record_protocol* sender,
                               alts_grpc_record_protocol* receiver) {
   grpc_core::ExecCtx exec_ctx;
@@ -398,6 +445,12 @@ static void alts_grpc_record_protocol_random_seal_unseal_tests(
   random_seal_unseal(fixture->server_protect, fixture->client_unprotect);
 }
 
+static void alts_grpc_record_protocol_multi_frame_seal_unseal_tests(
+    alts_grpc_record_protocol_test_fixture* fixture) {
+  multi_frame_seal_unseal(fixture->client_protect, fixture->server_unprotect);
+  multi_frame_seal_unseal(fixture->server_protect, fixture->client_unprotect);
+}
+
 static void alts_grpc_record_protocol_empty_seal_unseal_tests(
     alts_grpc_record_protocol_test_fixture* fixture) {
   empty_seal_unseal(fixture->client_protect, fixture->server_unprotect);
@@ -442,6 +495,10 @@ static void alts_grpc_record_protocol_tests(
   auto* fixture_5 = fixture_create();
   alts_grpc_record_protocol_input_check_tests(fixture_5);
   alts_grpc_record_protocol_test_fixture_destroy(fixture_5);
+
+  auto* fixture_6 = fixture_create();
+  alts_grpc_record_protocol_multi_frame_seal_unseal_tests(fixture_6);
+  alts_grpc_record_protocol_test_fixture_destroy(fixture_6);
 }
 
 int main(int argc, char** argv) {
@@ -24,6 +24,7 @@
 #include "src/core/lib/security/security_connector/security_connector.h"
 #include "src/core/tsi/ssl_transport_security.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 #include "src/core/tsi/transport_security_interface.h"
 #include "test/core/tsi/transport_security_test_lib.h"
 #include "test/core/util/test_config.h"
@@ -35,6 +36,9 @@
 
 extern "C" {
 #include <openssl/crypto.h>
+#ifdef OPENSSL_IS_BORINGSSL
+#include <openssl/aead.h>
+#endif
 }
 
 #define SSL_TSI_TEST_ALPN1 "foo"
@@ -89,10 +93,12 @@ typedef struct ssl_tsi_test_fixture {
   ssl_alpn_lib* alpn_lib;
   bool force_client_auth;
   char* server_name_indication;
+  const char* cipher_suites;
   tsi_ssl_session_cache* session_cache;
   bool session_reused;
   const char* session_ticket_key;
   size_t session_ticket_key_size;
+  tsi_ssl_session_ticket_keys* session_ticket_keys;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory;
   tsi_ssl_client_handshaker_factory* client_handshaker_factory;
 } ssl_tsi_test_fixture;
@@ -108,6 +114,7 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
   /* Create client handshaker factory. */
   tsi_ssl_client_handshaker_options client_options;
   client_options.pem_root_certs = key_cert_lib->root_cert;
+  client_options.cipher_suites = ssl_fixture->cipher_suites;
   if (ssl_fixture->force_client_auth) {
     client_options.pem_key_cert_pair =
         key_cert_lib->use_bad_client_cert
@@ -148,6 +155,7 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
           ? key_cert_lib->bad_server_num_key_cert_pairs
           : key_cert_lib->server_num_key_cert_pairs;
   server_options.pem_client_root_certs = key_cert_lib->root_cert;
+  server_options.cipher_suites = ssl_fixture->cipher_suites;
   if (ssl_fixture->force_client_auth) {
     server_options.client_certificate_request =
         TSI_REQUEST_AND_REQUIRE_CLIENT_CERTIFICATE_AND_VERIFY;
@@ -157,6 +165,7 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
   }
   server_options.session_ticket_key = ssl_fixture->session_ticket_key;
   server_options.session_ticket_key_size = ssl_fixture->session_ticket_key_size;
+  server_options.session_ticket_keys = ssl_fixture->session_ticket_keys;
   GPR_ASSERT(tsi_create_ssl_server_handshaker_factory_with_options(
                  &server_options, &ssl_fixture->server_handshaker_factory) ==
              TSI_OK);
@@ -356,6 +365,7 @@ static void ssl_test_destruct(tsi_test_fixture* fixture) {
   gpr_free(key_cert_lib->root_cert);
   tsi_ssl_root_certs_store_destroy(key_cert_lib->root_store);
   gpr_free(key_cert_lib);
+  tsi_ssl_session_ticket_keys_unref(ssl_fixture->session_ticket_keys);
   if (ssl_fixture->session_cache != nullptr) {
     tsi_ssl_session_cache_unref(ssl_fixture->session_cache);
   }
@@ -627,6 +637,204 @@ void ssl_tsi_test_do_round_trip_odd_buffer_size() {
   }
 }
 
+/* Protects one large slice followed by many small ones with sender, and feeds
+   the result to receiver in pieces that do not line up with records. */
+static void ssl_test_zero_copy_send(tsi_zero_copy_grpc_protector* sender,
+                                    tsi_zero_copy_grpc_protector* receiver) {
+  const size_t large_size = 40000;
+  const size_t small_size = 7;
+  const size_t num_small = 100;
+  const size_t message_size = large_size + small_size * num_small;
+  uint8_t* message = static_cast<uint8_t*>(gpr_malloc(message_size));
+  for (size_t i = 0; i < message_size; i++) {
+    message[i] = static_cast<uint8_t>(i * 31);
+  }
+  grpc_slice_buffer unprotected;
+  grpc_slice_buffer protected_sb;
+  grpc_slice_buffer piece;
+  grpc_slice_buffer received;
+  grpc_slice_buffer_init(&unprotected);
+  grpc_slice_buffer_init(&protected_sb);
+  grpc_slice_buffer_init(&piece);
+  grpc_slice_buffer_init(&received);
+  grpc_slice_buffer_add(&unprotected, grpc_slice_from_copied_buffer(
+                                          reinterpret_cast<char*>(message),
+                                          large_size));
+  for (size_t i = 0; i < num_small; i++) {
+    grpc_slice_buffer_add(
+        &unprotected,
+        grpc_slice_from_copied_buffer(
+            reinterpret_cast<char*>(message + large_size + i * small_size),
+            small_size));
+  }
+  GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(sender, &unprotected,
+                                                  &protected_sb) == TSI_OK);
+  GPR_ASSERT(unprotected.length == 0);
+  GPR_ASSERT(protected_sb.length > message_size);
+  while (protected_sb.length > 0) {
+    grpc_slice_buffer_move_first(&protected_sb,
+                                 GPR_MIN(protected_sb.length, 1021), &piece);
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(receiver, &piece,
+                                                      &received) == TSI_OK);
+    GPR_ASSERT(piece.length == 0);
+  }
+  GPR_ASSERT(received.length == message_size);
+  uint8_t* received_bytes = static_cast<uint8_t*>(gpr_malloc(message_size));
+  grpc_slice_buffer_move_first_into_buffer(&received, message_size,
+                                           received_bytes);
+  GPR_ASSERT(memcmp(message, received_bytes, message_size) == 0);
+  gpr_free(received_bytes);
+  gpr_free(message);
+  grpc_slice_buffer_destroy(&unprotected);
+  grpc_slice_buffer_destroy(&protected_sb);
+  grpc_slice_buffer_destroy(&piece);
+  grpc_slice_buffer_destroy(&received);
+}
+
+void ssl_tsi_test_do_round_trip_zero_copy() {
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  tsi_test_do_handshake(fixture);
+  tsi_zero_copy_grpc_protector* client_protector = nullptr;
+  tsi_zero_copy_grpc_protector* server_protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 fixture->client_result, nullptr, &client_protector) == TSI_OK);
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 fixture->server_result, nullptr, &server_protector) == TSI_OK);
+  ssl_test_zero_copy_send(client_protector, server_protector);
+  ssl_test_zero_copy_send(server_protector, client_protector);
+  ssl_test_zero_copy_send(client_protector, server_protector);
+  tsi_zero_copy_grpc_protector_destroy(client_protector);
+  tsi_zero_copy_grpc_protector_destroy(server_protector);
+  tsi_test_fixture_destroy(fixture);
+}
+
+/* Unprotects the single record in frame with protector, and checks that it
+   carries expected. */
+static void ssl_test_unprotect_record(tsi_frame_protector* protector,
+                                      const uint8_t* frame, size_t frame_size,
+                                      const char* expected) {
+  uint8_t unprotected[1024];
+  size_t frame_bytes_consumed = frame_size;
+  size_t unprotected_size = sizeof(unprotected);
+  GPR_ASSERT(tsi_frame_protector_unprotect(protector, frame,
+                                           &frame_bytes_consumed, unprotected,
+                                           &unprotected_size) == TSI_OK);
+  GPR_ASSERT(frame_bytes_consumed == frame_size);
+  GPR_ASSERT(unprotected_size == strlen(expected));
+  GPR_ASSERT(memcmp(unprotected, expected, unprotected_size) == 0);
+}
+
+#ifdef OPENSSL_IS_BORINGSSL
+/* Seals plaintext into a TLS 1.2 application data record with keys, the way
+   the kernel does once they are handed to it (RFC 5246 section 6.2.3.3, RFC
+   5288 section 3). Returns the size of the record. */
+static size_t ssl_test_seal_record(const tsi_ssl_kernel_tls_keys* keys,
+                                   const char* plaintext, uint8_t* record,
+                                   size_t record_capacity) {
+  const size_t plaintext_size = strlen(plaintext);
+  const size_t header_size = 5;
+  const size_t explicit_nonce_size = sizeof(keys->rec_seq);
+  const EVP_AEAD* aead = keys->key_size == 16 ? EVP_aead_aes_128_gcm()
+                                              : EVP_aead_aes_256_gcm();
+  GPR_ASSERT(record_capacity >= header_size + explicit_nonce_size +
+                                    plaintext_size +
+                                    EVP_AEAD_max_overhead(aead));
+  uint8_t nonce[sizeof(keys->salt) + sizeof(keys->rec_seq)];
+  memcpy(nonce, keys->salt, sizeof(keys->salt));
+  memcpy(nonce + sizeof(keys->salt), keys->rec_seq, sizeof(keys->rec_seq));
+  /* The additional data is the sequence number and the record header with
+     the length of the plaintext. */
+  uint8_t ad[sizeof(keys->rec_seq) + header_size];
+  memcpy(ad, keys->rec_seq, sizeof(keys->rec_seq));
+  ad[8] = 23; /* application_data */
+  ad[9] = 3;
+  ad[10] = 3;
+  ad[11] = static_cast<uint8_t>(plaintext_size >> 8);
+  ad[12] = static_cast<uint8_t>(plaintext_size);
+  EVP_AEAD_CTX ctx;
+  GPR_ASSERT(EVP_AEAD_CTX_init(&ctx, aead, keys->key, keys->key_size,
+                               EVP_AEAD_DEFAULT_TAG_LENGTH, nullptr));
+  size_t sealed_size;
+  GPR_ASSERT(EVP_AEAD_CTX_seal(
+      &ctx, record + header_size + explicit_nonce_size, &sealed_size,
+      record_capacity - header_size - explicit_nonce_size, nonce,
+      sizeof(nonce), reinterpret_cast<const uint8_t*>(plaintext),
+      plaintext_size, ad, sizeof(ad)));
+  EVP_AEAD_CTX_cleanup(&ctx);
+  const size_t fragment_size = explicit_nonce_size + sealed_size;
+  memcpy(record, ad + sizeof(keys->rec_seq), 3);
+  record[3] = static_cast<uint8_t>(fragment_size >> 8);
+  record[4] = static_cast<uint8_t>(fragment_size);
+  memcpy(record + header_size, keys->rec_seq, explicit_nonce_size);
+  return header_size + fragment_size;
+}
+
+/* Exports the write keys of sender, seals a record with them and checks that
+   receiver accepts it. */
+static void ssl_test_export_write_keys_round_trip(
+    tsi_frame_protector* sender, tsi_frame_protector* receiver,
+    const char* message) {
+  tsi_ssl_kernel_tls_keys keys;
+  GPR_ASSERT(tsi_ssl_frame_protector_export_write_keys(sender, &keys) ==
+             TSI_OK);
+  GPR_ASSERT(keys.key_size == 16);
+  uint8_t record[1024];
+  const size_t record_size =
+      ssl_test_seal_record(&keys, message, record, sizeof(record));
+  ssl_test_unprotect_record(receiver, record, record_size, message);
+}
+#endif /* OPENSSL_IS_BORINGSSL */
+
+void ssl_tsi_test_export_write_keys() {
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  ssl_tsi_test_fixture* ssl_fixture =
+      reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+  ssl_fixture->cipher_suites = "ECDHE-RSA-AES128-GCM-SHA256";
+  tsi_test_do_handshake(fixture);
+  tsi_frame_protector* client_protector = nullptr;
+  tsi_frame_protector* server_protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                 fixture->client_result, nullptr, &client_protector) == TSI_OK);
+  GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                 fixture->server_result, nullptr, &server_protector) == TSI_OK);
+  tsi_ssl_kernel_tls_keys keys;
+  GPR_ASSERT(tsi_ssl_frame_protector_export_write_keys(nullptr, &keys) ==
+             TSI_INVALID_ARGUMENT);
+#ifdef OPENSSL_IS_BORINGSSL
+  /* Keys cannot be exported while the protector holds unflushed data. */
+  const char* buffered = "buffered";
+  size_t buffered_size = strlen(buffered);
+  uint8_t frame[1024];
+  size_t frame_size = sizeof(frame);
+  GPR_ASSERT(tsi_frame_protector_protect(
+                 client_protector, reinterpret_cast<const uint8_t*>(buffered),
+                 &buffered_size, frame, &frame_size) == TSI_OK);
+  GPR_ASSERT(buffered_size == strlen(buffered));
+  GPR_ASSERT(frame_size == 0);
+  GPR_ASSERT(tsi_ssl_frame_protector_export_write_keys(
+                 client_protector, &keys) == TSI_FAILED_PRECONDITION);
+  size_t still_pending_size;
+  frame_size = sizeof(frame);
+  GPR_ASSERT(tsi_frame_protector_protect_flush(client_protector, frame,
+                                               &frame_size,
+                                               &still_pending_size) == TSI_OK);
+  GPR_ASSERT(still_pending_size == 0);
+  ssl_test_unprotect_record(server_protector, frame, frame_size, buffered);
+  /* Records sealed with the exported keys continue the sequence the protector
+     left off at, in both directions. */
+  ssl_test_export_write_keys_round_trip(client_protector, server_protector,
+                                        "sealed by the client's keys");
+  ssl_test_export_write_keys_round_trip(server_protector, client_protector,
+                                        "sealed by the server's keys");
+#else
+  GPR_ASSERT(tsi_ssl_frame_protector_export_write_keys(
+                 client_protector, &keys) == TSI_UNIMPLEMENTED);
+#endif
+  tsi_frame_protector_destroy(client_protector);
+  tsi_frame_protector_destroy(server_protector);
+  tsi_test_fixture_destroy(fixture);
+}
+
 void ssl_tsi_test_do_handshake_session_cache() {
   tsi_ssl_session_cache* session_cache = tsi_ssl_session_cache_create_lru(16);
   char session_ticket_key[kSessionTicketEncryptionKeySize];
@@ -659,6 +867,58 @@ void ssl_tsi_test_do_handshake_session_cache() {
   tsi_ssl_session_cache_unref(session_cache);
 }
 
+void ssl_tsi_test_do_handshake_session_ticket_keys() {
+  tsi_ssl_session_cache* session_cache = tsi_ssl_session_cache_create_lru(16);
+  tsi_ssl_session_ticket_keys* keys = tsi_ssl_session_ticket_keys_create();
+  auto do_handshake = [keys, session_cache](bool session_reused) {
+    tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+    ssl_tsi_test_fixture* ssl_fixture =
+        reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+    ssl_fixture->server_name_indication =
+        const_cast<char*>("waterzooi.test.google.be");
+    tsi_ssl_session_ticket_keys_ref(keys);
+    ssl_fixture->session_ticket_keys = keys;
+    tsi_ssl_session_cache_ref(session_cache);
+    ssl_fixture->session_cache = session_cache;
+    ssl_fixture->session_reused = session_reused;
+    tsi_test_do_round_trip(&ssl_fixture->base);
+    tsi_test_fixture_destroy(fixture);
+  };
+  unsigned char key_data[2 * TSI_SSL_SESSION_TICKET_KEY_SIZE];
+  unsigned char* second_key = key_data + TSI_SSL_SESSION_TICKET_KEY_SIZE;
+  GPR_ASSERT(tsi_ssl_session_ticket_keys_set(keys, key_data,
+                                             sizeof(key_data) - 1) ==
+             TSI_INVALID_ARGUMENT);
+  // Without keys no ticket is issued.
+  do_handshake(false);
+  do_handshake(false);
+  memset(key_data, 'a', TSI_SSL_SESSION_TICKET_KEY_SIZE);
+  GPR_ASSERT(tsi_ssl_session_ticket_keys_set(
+                 keys, key_data, TSI_SSL_SESSION_TICKET_KEY_SIZE) == TSI_OK);
+  do_handshake(false);
+  do_handshake(true);
+  // A rotation keeps accepting tickets issued with the previous key, and
+  // every server sharing the keys resumes the session.
+  memcpy(second_key, key_data, TSI_SSL_SESSION_TICKET_KEY_SIZE);
+  memset(key_data, 'b', TSI_SSL_SESSION_TICKET_KEY_SIZE);
+  GPR_ASSERT(tsi_ssl_session_ticket_keys_set(keys, key_data,
+                                             sizeof(key_data)) == TSI_OK);
+  do_handshake(true);
+  do_handshake(true);
+  // Only 'b' is left, which the last tickets were issued with.
+  GPR_ASSERT(tsi_ssl_session_ticket_keys_set(
+                 keys, key_data, TSI_SSL_SESSION_TICKET_KEY_SIZE) == TSI_OK);
+  do_handshake(true);
+  // Once the key of a ticket is gone, the session cannot resume.
+  memset(key_data, 'c', TSI_SSL_SESSION_TICKET_KEY_SIZE);
+  GPR_ASSERT(tsi_ssl_session_ticket_keys_set(
+                 keys, key_data, TSI_SSL_SESSION_TICKET_KEY_SIZE) == TSI_OK);
+  do_handshake(false);
+  do_handshake(true);
+  tsi_ssl_session_ticket_keys_unref(keys);
+  tsi_ssl_session_cache_unref(session_cache);
+}
+
 static const tsi_ssl_handshaker_factory_vtable* original_vtable;
 static bool handshaker_factory_destructor_called;
 
@@ -846,8 +1106,11 @@ int main(int argc, char** argv) {
   ssl_tsi_test_do_handshake_alpn_server_no_client();
   ssl_tsi_test_do_handshake_alpn_client_server_ok();
   ssl_tsi_test_do_handshake_session_cache();
+  ssl_tsi_test_do_handshake_session_ticket_keys();
   ssl_tsi_test_do_round_trip_for_all_configs();
   ssl_tsi_test_do_round_trip_odd_buffer_size();
+  ssl_tsi_test_do_round_trip_zero_copy();
+  ssl_tsi_test_export_write_keys();
   ssl_tsi_test_handshaker_factory_internals();
   ssl_tsi_test_duplicate_root_certificates();
   ssl_tsi_test_extract_x509_subject_names();
@@ -106,6 +106,10 @@ static int me_get_fd(grpc_endpoint* ep) { return -1; }
 
 static bool me_can_track_err(grpc_endpoint* ep) { return false; }
 
+static void me_set_read_hint(grpc_endpoint* ep, size_t bytes) {}
+
+static void me_set_write_hint(grpc_endpoint* ep, bool more_writes_follow) {}
+
 static const grpc_endpoint_vtable vtable = {me_read,
                                             me_write,
                                             me_add_to_pollset,
@@ -116,7 +120,9 @@ static const grpc_endpoint_vtable vtable = {me_read,
                                             me_get_resource_user,
                                             me_get_peer,
                                             me_get_fd,
-                                            me_can_track_err};
+                                            me_can_track_err,
+                                            me_set_read_hint,
+                                            me_set_write_hint};
 
 grpc_endpoint* grpc_mock_endpoint_create(void (*on_write)(grpc_slice slice),
                                          grpc_resource_quota* resource_quota) {
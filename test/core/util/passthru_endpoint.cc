@@ -157,6 +157,10 @@ static int me_get_fd(grpc_endpoint* ep) { return -1; }
 
 static bool me_can_track_err(grpc_endpoint* ep) { return false; }
 
+static void me_set_read_hint(grpc_endpoint* ep, size_t bytes) {}
+
+static void me_set_write_hint(grpc_endpoint* ep, bool more_writes_follow) {}
+
 static grpc_resource_user* me_get_resource_user(grpc_endpoint* ep) {
   half* m = reinterpret_cast<half*>(ep);
   return m->resource_user;
@@ -174,6 +178,8 @@ static const grpc_endpoint_vtable vtable = {
     me_get_peer,
     me_get_fd,
     me_can_track_err,
+    me_set_read_hint,
+    me_set_write_hint,
 };
 
 static void half_init(half* m, passthru_endpoint* parent,
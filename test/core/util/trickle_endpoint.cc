@@ -133,6 +133,15 @@ static int te_get_fd(grpc_endpoint* ep) {
 
 static bool te_can_track_err(grpc_endpoint* ep) { return false; }
 
+static void te_set_read_hint(grpc_endpoint* ep, size_t bytes) {
+  trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
+  grpc_endpoint_set_read_hint(te->wrapped, bytes);
+}
+
+/* writes reach the wrapped endpoint at the trickle rate rather than when the
+   transport makes them, so its hints do not apply there */
+static void te_set_write_hint(grpc_endpoint* ep, bool more_writes_follow) {}
+
 static void te_finish_write(void* arg, grpc_error* error) {
   trickle_endpoint* te = static_cast<trickle_endpoint*>(arg);
   gpr_mu_lock(&te->mu);
@@ -151,7 +160,9 @@ static const grpc_endpoint_vtable vtable = {te_read,
                                             te_get_resource_user,
                                             te_get_peer,
                                             te_get_fd,
-                                            te_can_track_err};
+                                            te_can_track_err,
+                                            te_set_read_hint,
+                                            te_set_write_hint};
 
 grpc_endpoint* grpc_trickle_endpoint_create(grpc_endpoint* wrap,
                                             double bytes_per_second) {
@@ -16,6 +16,7 @@
  *
  */
 
+#include <google/protobuf/wrappers.pb.h>
 #include <grpc/impl/codegen/byte_buffer.h>
 #include <grpc/slice.h>
 #include <grpcpp/impl/codegen/grpc_library.h>
@@ -182,6 +183,39 @@ TEST_F(WriterTest, LargeBlockLargeBackup) {
   BufferWriterTest(4096, 8192, 4095);
 }
 
+// Serializes a message of size_hint bytes and returns the number of slices
+// it took, checking that it parses back.
+size_t SerializedSliceCount(size_t size_hint) {
+  ::google::protobuf::StringValue msg;
+  msg.set_value(grpc::string(size_hint, 'a'));
+  ByteBuffer bb;
+  bool own_buffer;
+  EXPECT_TRUE(
+      (SerializationTraits<::google::protobuf::StringValue>::Serialize(
+           msg, &bb, &own_buffer))
+          .ok());
+  EXPECT_EQ(bb.Length(), msg.ByteSizeLong());
+  GrpcByteBufferPeer peer(&bb);
+  size_t count = peer.c_buffer()->data.raw.slice_buffer.count;
+  ::google::protobuf::StringValue parsed;
+  EXPECT_TRUE(
+      (SerializationTraits<::google::protobuf::StringValue>::Deserialize(
+           &bb, &parsed))
+          .ok());
+  EXPECT_EQ(parsed.value(), msg.value());
+  return count;
+}
+
+TEST_F(WriterTest, MessagesUpToOneBlockTakeOneSlice) {
+  EXPECT_EQ(SerializedSliceCount(4), 1u);
+  EXPECT_EQ(SerializedSliceCount(4096), 1u);
+  EXPECT_EQ(SerializedSliceCount(kProtoBufferWriterMaxBufferLength - 16), 1u);
+}
+
+TEST_F(WriterTest, LargerMessagesTakeOneSlicePerBlock) {
+  EXPECT_EQ(SerializedSliceCount(kProtoBufferWriterMaxBufferLength + 16), 2u);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace grpc
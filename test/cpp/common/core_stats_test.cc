@@ -0,0 +1,69 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <grpcpp/support/core_stats.h>
+
+#include <grpc/grpc.h>
+#include <grpcpp/completion_queue.h>
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+uint64_t GetCounter(const experimental::CoreStats& stats, const char* name) {
+  for (const auto& counter : stats.counters) {
+    if (counter.first == name) return counter.second;
+  }
+  ADD_FAILURE() << "no counter " << name;
+  return 0;
+}
+
+TEST(CoreStatsTest, ListsCountersAndHistograms) {
+  experimental::CoreStats stats = experimental::GetCoreStats();
+  EXPECT_FALSE(stats.counters.empty());
+  ASSERT_FALSE(stats.histograms.empty());
+  for (const auto& histogram : stats.histograms) {
+    EXPECT_FALSE(histogram.name.empty());
+    EXPECT_EQ(histogram.bucket_boundaries.size(), histogram.counts.size());
+  }
+}
+
+#ifndef GRPC_DISABLE_STATS
+TEST(CoreStatsTest, CountsCompletionQueues) {
+  grpc_init();
+  uint64_t before = GetCounter(experimental::GetCoreStats(), "cqs_created");
+  { CompletionQueue cq; }
+  EXPECT_EQ(GetCounter(experimental::GetCoreStats(), "cqs_created"),
+            before + 1);
+  grpc_shutdown();
+}
+#endif
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
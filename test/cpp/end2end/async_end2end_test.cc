@@ -896,7 +896,14 @@ TEST_P(AsyncEnd2endTest, ClientInitialMetadataRpc) {
                         cq_.get(), tag(2));
   Verifier().Expect(2, true).Verify(cq_.get());
   EXPECT_EQ(send_request.message(), recv_request.message());
+  // Looked up before client_metadata() builds the multimap
+  grpc::string_ref found;
+  EXPECT_TRUE(srv_ctx.FindClientMetadata(meta2.first, &found));
+  EXPECT_EQ(meta2.second, ToString(found));
+  EXPECT_FALSE(srv_ctx.FindClientMetadata("key", &found));
   const auto& client_initial_metadata = srv_ctx.client_metadata();
+  EXPECT_TRUE(srv_ctx.FindClientMetadata(meta3.first, &found));
+  EXPECT_EQ(meta3.second, ToString(found));
   EXPECT_EQ(meta1.second,
             ToString(client_initial_metadata.find(meta1.first)->second));
   EXPECT_EQ(meta2.second,
@@ -0,0 +1,140 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+class EchoServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+// Starts a server, makes a blocking call to it from the calling thread and
+// tears both ends down again.
+void MakeBlockingCall() {
+  int port = grpc_pick_unused_port_or_die();
+  std::ostringstream server_address;
+  server_address << "127.0.0.1:" << port;
+  EchoServiceImpl service;
+  ServerBuilder builder;
+  builder.AddListeningPort(server_address.str(), InsecureServerCredentials());
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server = builder.BuildAndStart();
+  {
+    std::unique_ptr<EchoTestService::Stub> stub = EchoTestService::NewStub(
+        CreateChannel(server_address.str(), InsecureChannelCredentials()));
+    EchoRequest request;
+    request.set_message("hello");
+    EchoResponse response;
+    ClientContext context;
+    Status status = stub->Echo(&context, request, &response);
+    EXPECT_TRUE(status.ok()) << status.error_message();
+    EXPECT_EQ("hello", response.message());
+  }
+  server->Shutdown();
+  server.reset();
+  grpc_recycle_unused_port(port);
+}
+
+// The thread's cached queue for blocking calls must not keep gRPC
+// initialized, and must be replaced after gRPC is initialized again.
+TEST(BlockingCallShutdownTest, BlockingCallsDoNotKeepGrpcInitialized) {
+  for (int i = 0; i < 3; i++) {
+    grpc_init();
+    MakeBlockingCall();
+    MakeBlockingCall();
+    grpc_shutdown_blocking();
+    EXPECT_FALSE(grpc_is_initialized());
+  }
+}
+
+// A thread that made a blocking call may outlive gRPC, and exit after the
+// queue it cached was destroyed by grpc_shutdown().
+TEST(BlockingCallShutdownTest, ThreadExitsAfterShutdown) {
+  std::mutex mu;
+  std::condition_variable cv;
+  bool call_done = false;
+  bool shutdown_done = false;
+  grpc_init();
+  std::thread thread([&]() {
+    MakeBlockingCall();
+    std::unique_lock<std::mutex> lock(mu);
+    call_done = true;
+    cv.notify_all();
+    cv.wait(lock, [&]() { return shutdown_done; });
+  });
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    cv.wait(lock, [&]() { return call_done; });
+  }
+  grpc_shutdown_blocking();
+  EXPECT_FALSE(grpc_is_initialized());
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    shutdown_done = true;
+    cv.notify_all();
+  }
+  thread.join();
+}
+
+// A thread that exits while gRPC is still initialized destroys its queue
+// itself, and gRPC can then shut down.
+TEST(BlockingCallShutdownTest, ThreadExitsBeforeShutdown) {
+  grpc_init();
+  std::thread thread(MakeBlockingCall);
+  thread.join();
+  grpc_shutdown_blocking();
+  EXPECT_FALSE(grpc_is_initialized());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -834,6 +834,58 @@ TEST_P(ClientCallbackEnd2endTest, UnaryReactor) {
   }
 }
 
+TEST_P(ClientCallbackEnd2endTest, UnaryReactorReuse) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  // A single reactor re-armed from its own OnDone for each of the RPCs.
+  class UnaryClient : public grpc::experimental::ClientUnaryReactor {
+   public:
+    UnaryClient(grpc::testing::EchoTestService::Stub* stub, int num_rpcs)
+        : stub_(stub), rpcs_left_(num_rpcs) {
+      StartNext();
+    }
+    void OnDone(const Status& s) override {
+      EXPECT_TRUE(s.ok());
+      EXPECT_EQ(request_.message(), response_.message());
+      if (--rpcs_left_ > 0) {
+        StartNext();
+        return;
+      }
+      std::unique_lock<std::mutex> l(mu_);
+      done_ = true;
+      cv_.notify_one();
+    }
+    void Await() {
+      std::unique_lock<std::mutex> l(mu_);
+      while (!done_) {
+        cv_.wait(l);
+      }
+    }
+
+   private:
+    void StartNext() {
+      cli_ctx_.reset(new ClientContext);
+      request_.set_message("Hello reuse " + grpc::to_string(rpcs_left_));
+      response_.Clear();
+      stub_->experimental_async()->Echo(cli_ctx_.get(), &request_, &response_,
+                                        this);
+      StartCall();
+    }
+
+    grpc::testing::EchoTestService::Stub* const stub_;
+    int rpcs_left_;
+    EchoRequest request_;
+    EchoResponse response_;
+    std::unique_ptr<ClientContext> cli_ctx_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool done_{false};
+  };
+
+  UnaryClient test{stub_.get(), 10};
+  test.Await();
+}
+
 class ReadClient : public grpc::experimental::ClientReadReactor<EchoResponse> {
  public:
   ReadClient(grpc::testing::EchoTestService::Stub* stub,
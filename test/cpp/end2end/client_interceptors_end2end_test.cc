@@ -638,6 +638,41 @@ class LoggingInterceptorFactory
   }
 };
 
+// Only intercepts POST_RECV_STATUS, as an interceptor timing RPCs might.
+class StatusOnlyInterceptor : public experimental::Interceptor {
+ public:
+  StatusOnlyInterceptor(experimental::ClientRpcInfo* info) {}
+
+  bool InterceptsHookPoint(experimental::InterceptionHookPoints type) override {
+    return type == experimental::InterceptionHookPoints::POST_RECV_STATUS;
+  }
+
+  virtual void Intercept(experimental::InterceptorBatchMethods* methods) {
+    EXPECT_TRUE(methods->QueryInterceptionHookPoint(
+        experimental::InterceptionHookPoints::POST_RECV_STATUS));
+    num_times_run_++;
+    methods->Proceed();
+  }
+
+  static void Reset() { num_times_run_.store(0); }
+
+  static int GetNumTimesRun() { return num_times_run_.load(); }
+
+ private:
+  static std::atomic<int> num_times_run_;
+};
+
+std::atomic<int> StatusOnlyInterceptor::num_times_run_;
+
+class StatusOnlyInterceptorFactory
+    : public experimental::ClientInterceptorFactoryInterface {
+ public:
+  virtual experimental::Interceptor* CreateClientInterceptor(
+      experimental::ClientRpcInfo* info) override {
+    return new StatusOnlyInterceptor(info);
+  }
+};
+
 class ClientInterceptorsEnd2endTest : public ::testing::Test {
  protected:
   ClientInterceptorsEnd2endTest() {
@@ -801,6 +836,37 @@ TEST_F(ClientInterceptorsEnd2endTest,
   EXPECT_EQ(DummyInterceptor::GetNumTimesRun(), 20);
 }
 
+TEST_F(ClientInterceptorsEnd2endTest, ClientInterceptorHookPointsTest) {
+  ChannelArguments args;
+  StatusOnlyInterceptor::Reset();
+  std::vector<std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+      creators;
+  creators.push_back(std::unique_ptr<StatusOnlyInterceptorFactory>(
+      new StatusOnlyInterceptorFactory()));
+  creators.push_back(std::unique_ptr<LoggingInterceptorFactory>(
+      new LoggingInterceptorFactory()));
+  creators.push_back(std::unique_ptr<StatusOnlyInterceptorFactory>(
+      new StatusOnlyInterceptorFactory()));
+  auto channel = experimental::CreateCustomChannelWithInterceptors(
+      server_address_, InsecureChannelCredentials(), args, std::move(creators));
+  MakeCall(channel);
+  LoggingInterceptor::VerifyUnaryCall();
+  // Each status-only interceptor saw just the batch with the status.
+  EXPECT_EQ(StatusOnlyInterceptor::GetNumTimesRun(), 2);
+
+  // Without an interceptor wanting the other batches, they skip
+  // interception altogether.
+  StatusOnlyInterceptor::Reset();
+  creators.clear();
+  creators.push_back(std::unique_ptr<StatusOnlyInterceptorFactory>(
+      new StatusOnlyInterceptorFactory()));
+  channel = experimental::CreateCustomChannelWithInterceptors(
+      server_address_, InsecureChannelCredentials(), args, std::move(creators));
+  MakeCall(channel);
+  MakeCallbackCall(channel);
+  EXPECT_EQ(StatusOnlyInterceptor::GetNumTimesRun(), 2);
+}
+
 class ClientInterceptorsStreamingEnd2endTest : public ::testing::Test {
  protected:
   ClientInterceptorsStreamingEnd2endTest() {
@@ -24,6 +24,7 @@
 #include <thread>
 
 #include <grpc/grpc.h>
+#include <grpc/load_reporting.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
 #include <grpc/support/log.h>
@@ -46,6 +47,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/tcp_client.h"
 #include "src/core/lib/security/credentials/fake/fake_credentials.h"
 #include "src/cpp/client/secure_credentials.h"
@@ -60,6 +62,13 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#ifdef GRPC_POSIX_SOCKET
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 using grpc::testing::EchoRequest;
 using grpc::testing::EchoResponse;
 using std::chrono::system_clock;
@@ -98,14 +107,53 @@ class MyTestServiceImpl : public TestServiceImpl {
 
   Status Echo(ServerContext* context, const EchoRequest* request,
               EchoResponse* response) override {
+    double cpu_utilization;
+    bool fail_calls;
+    int response_delay_ms;
     {
       grpc::internal::MutexLock lock(&mu_);
       ++request_count_;
+      cpu_utilization = cpu_utilization_;
+      fail_calls = fail_calls_;
+      response_delay_ms = response_delay_ms_;
     }
     AddClient(context->peer());
+    if (response_delay_ms > 0) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(response_delay_ms));
+    }
+    if (fail_calls) return Status(StatusCode::UNAVAILABLE, "failing on demand");
+    if (cpu_utilization >= 0) {
+      // Encoded like AddLoadReportingCost() does.
+      const grpc::string cost_name = "cpu_utilization";
+      grpc::string cost(sizeof(cpu_utilization) + cost_name.size(), '\0');
+      memcpy(&cost[0], &cpu_utilization, sizeof(cpu_utilization));
+      memcpy(&cost[sizeof(cpu_utilization)], cost_name.data(),
+             cost_name.size());
+      context->AddTrailingMetadata(GRPC_LB_COST_MD_KEY, cost);
+    }
     return TestServiceImpl::Echo(context, request, response);
   }
 
+  // Reports \a cpu_utilization in the trailing metadata of every Echo call
+  // from now on; a negative value stops the reports.
+  void set_cpu_utilization(double cpu_utilization) {
+    grpc::internal::MutexLock lock(&mu_);
+    cpu_utilization_ = cpu_utilization;
+  }
+
+  // Fails every Echo call from now on with UNAVAILABLE, if \a fail_calls.
+  void set_fail_calls(bool fail_calls) {
+    grpc::internal::MutexLock lock(&mu_);
+    fail_calls_ = fail_calls;
+  }
+
+  // Delays the response to every Echo call by \a response_delay_ms from now
+  // on.
+  void set_response_delay_ms(int response_delay_ms) {
+    grpc::internal::MutexLock lock(&mu_);
+    response_delay_ms_ = response_delay_ms;
+  }
+
   int request_count() {
     grpc::internal::MutexLock lock(&mu_);
     return request_count_;
@@ -129,6 +177,9 @@ class MyTestServiceImpl : public TestServiceImpl {
 
   grpc::internal::Mutex mu_;
   int request_count_;
+  double cpu_utilization_ = -1;
+  bool fail_calls_ = false;
+  int response_delay_ms_ = 0;
   grpc::internal::Mutex clients_mu_;
   std::set<grpc::string> clients_;
 };
@@ -309,6 +360,8 @@ class ClientLbEnd2endTest : public ::testing::Test {
     std::unique_ptr<std::thread> thread_;
     bool server_ready_ = false;
     bool started_ = false;
+    // If positive, the server's limit on concurrent streams per connection.
+    int max_concurrent_streams_ = 0;
 
     explicit ServerData(int port = 0) {
       port_ = port > 0 ? port : grpc_pick_unused_port_or_die();
@@ -336,6 +389,10 @@ class ClientLbEnd2endTest : public ::testing::Test {
           grpc_fake_transport_security_server_credentials_create()));
       builder.AddListeningPort(server_address.str(), std::move(creds));
       builder.RegisterService(&service_);
+      if (max_concurrent_streams_ > 0) {
+        builder.AddChannelArgument(GRPC_ARG_MAX_CONCURRENT_STREAMS,
+                                   max_concurrent_streams_);
+      }
       server_ = builder.BuildAndStart();
       grpc::internal::MutexLock lock(mu);
       server_ready_ = true;
@@ -474,6 +531,46 @@ TEST_F(ClientLbEnd2endTest, PickFirst) {
   EXPECT_EQ("pick_first", channel->GetLoadBalancingPolicyName());
 }
 
+#ifdef GRPC_POSIX_SOCKET
+// A TCP listener that never accepts.  Connections to it are established by
+// the kernel but never get through the HTTP/2 handshake, so a subchannel to
+// it stays CONNECTING until the handshake times out.
+class HangingListener {
+ public:
+  explicit HangingListener(int port) : fd_(socket(AF_INET, SOCK_STREAM, 0)) {
+    GPR_ASSERT(fd_ >= 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    GPR_ASSERT(bind(fd_, reinterpret_cast<struct sockaddr*>(&addr),
+                    sizeof(addr)) == 0);
+    GPR_ASSERT(listen(fd_, 16) == 0);
+  }
+  ~HangingListener() { close(fd_); }
+
+ private:
+  const int fd_;
+};
+
+TEST_F(ClientLbEnd2endTest, PickFirstStaggeredAttemptsSkipHangingAddress) {
+  StartServers(1);
+  const int hanging_port = grpc_pick_unused_port_or_die();
+  HangingListener listener(hanging_port);
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_PICK_FIRST_CONNECTION_ATTEMPT_DELAY_MS, 100);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution({hanging_port, servers_[0]->port_});
+  // The attempt to the second address starts while the first one hangs, and
+  // connects well within the RPC deadline.
+  CheckRpcSendOk(stub, DEBUG_LOCATION, true /* wait_for_ready */);
+  EXPECT_EQ(1, servers_[0]->service_.request_count());
+}
+#endif  // GRPC_POSIX_SOCKET
+
 TEST_F(ClientLbEnd2endTest, PickFirstProcessPending) {
   StartServers(1);  // Single server
   auto response_generator = BuildResolverResponseGenerator();
@@ -1042,6 +1139,104 @@ TEST_F(ClientLbEnd2endTest, RoundRobin) {
   EXPECT_EQ("round_robin", channel->GetLoadBalancingPolicyName());
 }
 
+TEST_F(ClientLbEnd2endTest, RoundRobinConnectionsPerAddress) {
+  StartServers(1);  // Single server
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_CONNECTIONS_PER_ADDRESS, 3);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution({servers_[0]->port_});
+  // The calls end up spread over three connections (client ports) to the
+  // server once all of them are ready.
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (servers_[0]->service_.clients().size() < 3UL);
+  for (size_t i = 0; i < 30; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  EXPECT_EQ(3UL, servers_[0]->service_.clients().size());
+}
+
+TEST_F(ClientLbEnd2endTest, RoundRobinSkipsSaturatedConnection) {
+  // Server 0 only takes one call at a time per connection.
+  const size_t kNumServers = 2;
+  CreateServers(kNumServers);
+  servers_[0]->max_concurrent_streams_ = 1;
+  for (size_t i = 0; i < kNumServers; ++i) StartServer(i);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  ResetCounters();
+  // Keep one call in flight on each backend, which uses up the only stream
+  // server 0 allows.
+  auto send_slow_rpc = [&stub]() {
+    EchoRequest request;
+    EchoResponse response;
+    ClientContext context;
+    request.set_message("slow");
+    request.mutable_param()->set_server_sleep_us(3 * 1000 * 1000);
+    context.set_deadline(grpc_timeout_milliseconds_to_deadline(10000));
+    EXPECT_TRUE(stub->Echo(&context, request, &response).ok());
+  };
+  std::thread slow_rpc1(send_slow_rpc);
+  std::thread slow_rpc2(send_slow_rpc);
+  while (servers_[0]->service_.request_count() == 0 ||
+         servers_[1]->service_.request_count() == 0) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+  ResetCounters();
+  // The calls go to server 1 rather than wait for a stream on server 0,
+  // which would take longer than their deadline.
+  const int kNumRpcs = 10;
+  for (int i = 0; i < kNumRpcs; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  EXPECT_EQ(0, servers_[0]->service_.request_count());
+  EXPECT_EQ(kNumRpcs, servers_[1]->service_.request_count());
+  slow_rpc1.join();
+  slow_rpc2.join();
+}
+
+TEST_F(ClientLbEnd2endTest, HedgingMovesSlowCallsToAnotherBackend) {
+  const int kNumServers = 2;
+  StartServers(kNumServers);
+  ChannelArguments args;
+  args.SetServiceConfigJSON(
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"grpc.testing.EchoTestService\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 2,\n"
+      "      \"hedgingDelay\": \"0.2s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}");
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  ResetCounters();
+  // Server 0 answers after the RPC deadline of CheckRpcSendOk(), so the
+  // calls it gets only succeed if they are hedged to server 1.
+  servers_[0]->service_.set_response_delay_ms(1500);
+  const int kNumRpcs = 10;
+  for (int i = 0; i < kNumRpcs; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  EXPECT_GT(servers_[0]->service_.request_count(), 0);
+  EXPECT_EQ(kNumRpcs, servers_[1]->service_.request_count());
+}
+
 TEST_F(ClientLbEnd2endTest, RoundRobinProcessPending) {
   StartServers(1);  // Single server
   auto response_generator = BuildResolverResponseGenerator();
@@ -1142,6 +1337,111 @@ TEST_F(ClientLbEnd2endTest, RoundRobinUpdates) {
   EXPECT_EQ("round_robin", channel->GetLoadBalancingPolicyName());
 }
 
+TEST_F(ClientLbEnd2endTest, RoundRobinWarmsUpNewAddresses) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_ROUND_ROBIN_WARM_UP_TIMEOUT_MS, 5000);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution({servers_[0]->port_});
+  WaitForServer(stub, 0, DEBUG_LOCATION);
+  // Switch to the two other servers.  Calls keep going to server 0 until
+  // both new subchannels are READY, then they are spread over both.
+  response_generator.SetNextResolution(
+      {servers_[1]->port_, servers_[2]->port_});
+  while (servers_[1]->service_.request_count() == 0 &&
+         servers_[2]->service_.request_count() == 0) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  ResetCounters();
+  for (size_t i = 0; i < 2; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+  EXPECT_EQ(0, servers_[0]->service_.request_count());
+  EXPECT_EQ(1, servers_[1]->service_.request_count());
+  EXPECT_EQ(1, servers_[2]->service_.request_count());
+}
+
+TEST_F(ClientLbEnd2endTest, RoundRobinInPlaceUpdateAddsAddresses) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      {servers_[0]->port_, servers_[1]->port_});
+  WaitForServer(stub, 0, DEBUG_LOCATION);
+  WaitForServer(stub, 1, DEBUG_LOCATION);
+  // Adding an address keeps the existing subchannels, so calls keep going
+  // to them over the connections they already have.
+  response_generator.SetNextResolution(
+      {servers_[0]->port_, servers_[1]->port_, servers_[2]->port_});
+  WaitForServer(stub, 2, DEBUG_LOCATION);
+  ResetCounters();
+  for (size_t i = 0; i < 3 * kNumServers; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  for (size_t i = 0; i < kNumServers; ++i) {
+    EXPECT_EQ(3, servers_[i]->service_.request_count());
+    EXPECT_EQ(1UL, servers_[i]->service_.clients().size());
+  }
+  EXPECT_EQ(GRPC_CHANNEL_READY, channel->GetState(false));
+}
+
+TEST_F(ClientLbEnd2endTest, RoundRobinInPlaceUpdateRemovesAddresses) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  for (size_t i = 0; i < kNumServers; ++i) {
+    WaitForServer(stub, i, DEBUG_LOCATION);
+  }
+  response_generator.SetNextResolution(
+      {servers_[0]->port_, servers_[2]->port_});
+  // Wait for the update to be applied, as signaled by a round of calls that
+  // all miss the removed server.
+  do {
+    ResetCounters();
+    for (size_t i = 0; i < kNumServers; ++i) {
+      CheckRpcSendOk(stub, DEBUG_LOCATION);
+    }
+  } while (servers_[1]->service_.request_count() > 0);
+  ResetCounters();
+  for (size_t i = 0; i < 10; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+  EXPECT_EQ(5, servers_[0]->service_.request_count());
+  EXPECT_EQ(0, servers_[1]->service_.request_count());
+  EXPECT_EQ(5, servers_[2]->service_.request_count());
+  // The remaining servers were not reconnected to.
+  EXPECT_EQ(1UL, servers_[0]->service_.clients().size());
+  EXPECT_EQ(1UL, servers_[2]->service_.clients().size());
+}
+
+TEST_F(ClientLbEnd2endTest, RoundRobinIgnoresIdenticalUpdates) {
+  const int kNumServers = 2;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator);
+  auto stub = BuildStub(channel);
+  std::vector<int> ports = GetServersPorts();
+  response_generator.SetNextResolution(ports);
+  for (size_t i = 0; i < kNumServers; ++i) {
+    WaitForServer(stub, i, DEBUG_LOCATION);
+  }
+  // An identical update keeps the current picker, so calls keep alternating
+  // between the servers. A new picker would start at a random index.
+  ResetCounters();
+  for (size_t i = 0; i < 20; ++i) {
+    response_generator.SetNextResolution(ports);
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  EXPECT_EQ(10, servers_[0]->service_.request_count());
+  EXPECT_EQ(10, servers_[1]->service_.request_count());
+  EXPECT_EQ(1UL, servers_[0]->service_.clients().size());
+  EXPECT_EQ(1UL, servers_[1]->service_.clients().size());
+}
+
 TEST_F(ClientLbEnd2endTest, RoundRobinUpdateInError) {
   const int kNumServers = 3;
   StartServers(kNumServers);
@@ -1465,6 +1765,208 @@ TEST_F(ClientLbEnd2endTest, RoundRobinWithHealthCheckingServiceNamePerChannel) {
   EnableDefaultHealthCheckService(false);
 }
 
+TEST_F(ClientLbEnd2endTest, RoundRobinWithSharedHealthChecks) {
+  EnableDefaultHealthCheckService(true);
+  // Start server.
+  const int kNumServers = 1;
+  StartServers(kNumServers);
+  std::vector<int> ports = GetServersPorts();
+  // Create two channels sharing health checks.  The channels differ in an
+  // arg, so they get separate subchannels and connections.
+  ChannelArguments args1;
+  args1.SetServiceConfigJSON(
+      "{"healthCheckConfig": "
+      "{"serviceName": "health_check_service_name"}}");
+  args1.SetInt(GRPC_ARG_SHARE_HEALTH_CHECKS, 1);
+  ChannelArguments args2 = args1;
+  args1.SetString("grpc.testing.shard", "1");
+  args2.SetString("grpc.testing.shard", "2");
+  auto response_generator1 = BuildResolverResponseGenerator();
+  auto channel1 = BuildChannel("round_robin", response_generator1, args1);
+  auto stub1 = BuildStub(channel1);
+  response_generator1.SetNextResolution(ports);
+  auto response_generator2 = BuildResolverResponseGenerator();
+  auto channel2 = BuildChannel("round_robin", response_generator2, args2);
+  auto stub2 = BuildStub(channel2);
+  response_generator2.SetNextResolution(ports);
+  // Neither channel should become READY, because health checks should be
+  // failing.
+  EXPECT_FALSE(WaitForChannelReady(channel1.get(), 1));
+  EXPECT_FALSE(WaitForChannelReady(channel2.get(), 1));
+  // Both channels see the backend become healthy.
+  servers_[0]->SetServingStatus("health_check_service_name", true);
+  CheckRpcSendOk(stub1, DEBUG_LOCATION, true /* wait_for_ready */);
+  CheckRpcSendOk(stub2, DEBUG_LOCATION, true /* wait_for_ready */);
+  EXPECT_EQ(2UL, servers_[0]->service_.clients().size());
+  // Both channels see it become unhealthy again.
+  servers_[0]->SetServingStatus("health_check_service_name", false);
+  EXPECT_TRUE(WaitForChannelNotReady(channel1.get()));
+  EXPECT_TRUE(WaitForChannelNotReady(channel2.get()));
+  // After the first channel goes away, the second one still follows the
+  // backend's health.
+  stub1.reset();
+  channel1.reset();
+  servers_[0]->SetServingStatus("health_check_service_name", true);
+  CheckRpcSendOk(stub2, DEBUG_LOCATION, true /* wait_for_ready */);
+  // Clean up.
+  EnableDefaultHealthCheckService(false);
+}
+
+TEST_F(ClientLbEnd2endTest, LeastRequest) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("least_request", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // With no call in flight, picks are spread over all the backends.
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  // Check LB policy name for the channel.
+  EXPECT_EQ("least_request", channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(ClientLbEnd2endTest, LeastRequestAvoidsBusyBackend) {
+  StartServers(2);
+  ChannelArguments args;
+  // Sample so many subchannels that a pick only lands on the busy backend
+  // if every sample does (with probability 2^-10).
+  args.SetServiceConfigJSON(
+      "{\"loadBalancingConfig\": "
+      "[{\"least_request\": {\"choiceCount\": 10}}]}");
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  EXPECT_EQ("least_request", channel->GetLoadBalancingPolicyName());
+  ResetCounters();
+  // Keep a call in flight on one of the backends.
+  std::thread slow_rpc([&stub]() {
+    EchoRequest request;
+    EchoResponse response;
+    ClientContext context;
+    request.set_message("slow");
+    request.mutable_param()->set_server_sleep_us(3 * 1000 * 1000);
+    context.set_deadline(grpc_timeout_milliseconds_to_deadline(10000));
+    EXPECT_TRUE(stub->Echo(&context, request, &response).ok());
+  });
+  while (servers_[0]->service_.request_count() == 0 &&
+         servers_[1]->service_.request_count() == 0) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+  const size_t busy = servers_[0]->service_.request_count() > 0 ? 0 : 1;
+  ResetCounters();
+  const int kNumRpcs = 10;
+  for (int i = 0; i < kNumRpcs; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  // Allow for a couple of unlucky picks.
+  EXPECT_LE(servers_[busy]->service_.request_count(), 2);
+  EXPECT_GE(servers_[1 - busy]->service_.request_count(), kNumRpcs - 2);
+  slow_rpc.join();
+}
+
+TEST_F(ClientLbEnd2endTest, RingHashSendsSameKeyToSameBackend) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  ChannelArguments args;
+  args.SetServiceConfigJSON(
+      "{\"loadBalancingConfig\": "
+      "[{\"ring_hash\": {\"hashHeader\": \"X-Cache-Key\"}}]}");
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // Calls without the header are spread over all the backends.
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  EXPECT_EQ("ring_hash", channel->GetLoadBalancingPolicyName());
+  // All the calls carrying one key go to one backend.
+  const int kNumRpcsPerKey = 5;
+  for (int key = 0; key < 10; ++key) {
+    ResetCounters();
+    for (int i = 0; i < kNumRpcsPerKey; ++i) {
+      EchoRequest request;
+      EchoResponse response;
+      ClientContext context;
+      request.set_message(kRequestMessage_);
+      context.AddMetadata("x-cache-key", std::to_string(key));
+      context.set_deadline(grpc_timeout_milliseconds_to_deadline(2000));
+      EXPECT_TRUE(stub->Echo(&context, request, &response).ok());
+    }
+    int num_servers_used = 0;
+    for (const auto& server : servers_) {
+      const int count = server->service_.request_count();
+      if (count == 0) continue;
+      ++num_servers_used;
+      EXPECT_EQ(kNumRpcsPerKey, count) << "key " << key;
+    }
+    EXPECT_EQ(1, num_servers_used) << "key " << key;
+  }
+}
+
+TEST_F(ClientLbEnd2endTest, WeightedRoundRobinFollowsReportedLoad) {
+  StartServers(2);
+  servers_[0]->service_.set_cpu_utilization(0.8);
+  servers_[1]->service_.set_cpu_utilization(0.1);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("weighted_round_robin", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // Until the backends report, they are picked in turn.
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  EXPECT_EQ("weighted_round_robin", channel->GetLoadBalancingPolicyName());
+  // Let the weights be refreshed from the reports.
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1500));
+  ResetCounters();
+  // The backend reporting an eighth of the load of the other one gets eight
+  // times its calls.
+  const int kNumRpcs = 90;
+  for (int i = 0; i < kNumRpcs; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  EXPECT_LE(servers_[0]->service_.request_count(), 15);
+  EXPECT_GE(servers_[1]->service_.request_count(), 75);
+}
+
+TEST_F(ClientLbEnd2endTest, OutlierDetectionEjectsFailingBackend) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  ChannelArguments args;
+  args.SetServiceConfigJSON(
+      "{\"loadBalancingConfig\": [{\"outlier_detection\": {"
+      "\"childPolicy\": [{\"round_robin\": {}}],"
+      "\"intervalMs\": 100,"
+      "\"consecutiveFailures\": 3,"
+      "\"maxEjectionPercent\": 50}}]}");
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  EXPECT_EQ("outlier_detection", channel->GetLoadBalancingPolicyName());
+  // Make one backend fail its calls, even though it stays connected.
+  servers_[0]->service_.set_fail_calls(true);
+  for (int i = 0; i < 3 * kNumServers; ++i) SendRpc(stub);
+  // Let an ejection sweep run.
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(500));
+  // The failing backend gets no more calls.
+  ResetCounters();
+  for (int i = 0; i < 10; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  EXPECT_EQ(0, servers_[0]->service_.request_count());
+}
+
 TEST_F(ClientLbEnd2endTest, ChannelIdleness) {
   // Start server.
   const int kNumServers = 1;
@@ -0,0 +1,179 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// Several times the default max frame size, so the message is always split
+// across DATA frames.
+const size_t kMessageSize = 64 * 1024;
+const char kMethodName[] = "/grpc.testing.EchoTestService/Echo";
+
+void* tag(intptr_t i) { return reinterpret_cast<void*>(i); }
+
+class ContiguousRecvEnd2endTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    if (server_ == nullptr) return;
+    server_->Shutdown();
+    void* ignored_tag;
+    bool ignored_ok;
+    srv_cq_->Shutdown();
+    while (srv_cq_->Next(&ignored_tag, &ignored_ok)) {
+    }
+    cli_cq_.Shutdown();
+    while (cli_cq_.Next(&ignored_tag, &ignored_ok)) {
+    }
+    grpc_recycle_unused_port(port_);
+  }
+
+  void Start(int max_contiguous_recv_message_size) {
+    port_ = grpc_pick_unused_port_or_die();
+    server_address_ << "127.0.0.1:" << port_;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address_.str(),
+                             InsecureServerCredentials());
+    builder.RegisterAsyncGenericService(&generic_service_);
+    builder.AddChannelArgument(GRPC_ARG_HTTP2_MAX_CONTIGUOUS_RECV_MESSAGE_SIZE,
+                               max_contiguous_recv_message_size);
+    srv_cq_ = builder.AddCompletionQueue();
+    server_ = builder.BuildAndStart();
+    generic_stub_.reset(new GenericStub(
+        CreateChannel(server_address_.str(), InsecureChannelCredentials())));
+  }
+
+  void ExpectTag(CompletionQueue* cq, intptr_t i) {
+    void* got_tag;
+    bool ok;
+    EXPECT_TRUE(cq->Next(&got_tag, &ok));
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(tag(i), got_tag);
+  }
+
+  // Sends a kMessageSize message and returns the byte buffer the server
+  // received it in.
+  ByteBuffer SendMessage() {
+    const std::string message(kMessageSize, 'a');
+    Slice send_slice(message);
+    ByteBuffer send_buffer(&send_slice, 1);
+    ClientContext cli_ctx;
+    std::unique_ptr<GenericClientAsyncResponseReader> call =
+        generic_stub_->PrepareUnaryCall(&cli_ctx, kMethodName, send_buffer,
+                                        &cli_cq_);
+    call->StartCall();
+    ByteBuffer cli_recv_buffer;
+    Status recv_status;
+    call->Finish(&cli_recv_buffer, &recv_status, tag(1));
+    std::thread client_check([this] { ExpectTag(&cli_cq_, 1); });
+
+    GenericServerContext srv_ctx;
+    GenericServerAsyncReaderWriter stream(&srv_ctx);
+    generic_service_.RequestCall(&srv_ctx, &stream, srv_cq_.get(),
+                                 srv_cq_.get(), tag(2));
+    ExpectTag(srv_cq_.get(), 2);
+    ByteBuffer srv_recv_buffer;
+    stream.Read(&srv_recv_buffer, tag(3));
+    ExpectTag(srv_cq_.get(), 3);
+    stream.WriteAndFinish(srv_recv_buffer, WriteOptions(), Status::OK, tag(4));
+    ExpectTag(srv_cq_.get(), 4);
+
+    client_check.join();
+    EXPECT_TRUE(recv_status.ok()) << recv_status.error_message();
+    EXPECT_EQ(kMessageSize, cli_recv_buffer.Length());
+    return srv_recv_buffer;
+  }
+
+  int port_ = 0;
+  std::ostringstream server_address_;
+  AsyncGenericService generic_service_;
+  std::unique_ptr<ServerCompletionQueue> srv_cq_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<GenericStub> generic_stub_;
+  CompletionQueue cli_cq_;
+};
+
+TEST_F(ContiguousRecvEnd2endTest, GathersMessageIntoOneSlice) {
+  Start(kMessageSize);
+  ByteBuffer received = SendMessage();
+  std::vector<Slice> slices;
+  ASSERT_TRUE(received.Dump(&slices).ok());
+  ASSERT_EQ(1u, slices.size());
+  EXPECT_EQ(std::string(kMessageSize, 'a'),
+            std::string(reinterpret_cast<const char*>(slices[0].begin()),
+                        slices[0].size()));
+  // Reading it all back hands out the received slice rather than a copy.
+  Slice single;
+  ASSERT_TRUE(received.DumpToSingleSlice(&single).ok());
+  EXPECT_EQ(slices[0].begin(), single.begin());
+  EXPECT_EQ(kMessageSize, single.size());
+}
+
+TEST_F(ContiguousRecvEnd2endTest, LeavesLargerMessagesSplit) {
+  Start(kMessageSize - 1);
+  ByteBuffer received = SendMessage();
+  std::vector<Slice> slices;
+  ASSERT_TRUE(received.Dump(&slices).ok());
+  EXPECT_GT(slices.size(), 1u);
+  EXPECT_EQ(kMessageSize, received.Length());
+}
+
+TEST_F(ContiguousRecvEnd2endTest, LeavesMessagesSplitByDefault) {
+  Start(0);
+  ByteBuffer received = SendMessage();
+  std::vector<Slice> slices;
+  ASSERT_TRUE(received.Dump(&slices).ok());
+  EXPECT_GT(slices.size(), 1u);
+  EXPECT_EQ(kMessageSize, received.Length());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,238 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+class EchoServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+struct AsyncCall {
+  ClientContext context;
+  EchoResponse response;
+  Status status;
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> rpc;
+};
+
+class DirectChannelEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    port_ = grpc_pick_unused_port_or_die();
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_DIRECT_CHANNEL, 1);
+    // Keep reconnection attempts after a failure quick.
+    args.SetInt(GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS, 500);
+    args.SetInt(GRPC_ARG_MIN_RECONNECT_BACKOFF_MS, 500);
+    args.SetInt(GRPC_ARG_MAX_RECONNECT_BACKOFF_MS, 500);
+    std::ostringstream target;
+    target << "ipv4:127.0.0.1:" << port_;
+    channel_ =
+        CreateCustomChannel(target.str(), InsecureChannelCredentials(), args);
+    stub_ = EchoTestService::NewStub(channel_);
+  }
+
+  void TearDown() override {
+    StopServer();
+    cq_.Shutdown();
+    void* tag;
+    bool ok;
+    while (cq_.Next(&tag, &ok)) {
+    }
+    grpc_recycle_unused_port(port_);
+  }
+
+  void StartServer() {
+    std::ostringstream server_address;
+    server_address << "127.0.0.1:" << port_;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    ASSERT_NE(nullptr, server_);
+  }
+
+  void StopServer() {
+    if (server_ != nullptr) {
+      server_->Shutdown(grpc_timeout_milliseconds_to_deadline(0));
+      server_.reset();
+    }
+  }
+
+  Status SendRpc(bool wait_for_ready = false, int timeout_ms = 5000) {
+    EchoRequest request;
+    request.set_message("hello");
+    EchoResponse response;
+    ClientContext context;
+    context.set_wait_for_ready(wait_for_ready);
+    context.set_deadline(grpc_timeout_milliseconds_to_deadline(timeout_ms));
+    Status status = stub_->Echo(&context, request, &response);
+    if (status.ok()) EXPECT_EQ("hello", response.message());
+    return status;
+  }
+
+  std::unique_ptr<AsyncCall> StartCall(bool wait_for_ready = false,
+                                       int timeout_ms = 5000) {
+    std::unique_ptr<AsyncCall> call(new AsyncCall);
+    EchoRequest request;
+    request.set_message("hello");
+    call->context.set_wait_for_ready(wait_for_ready);
+    call->context.set_deadline(
+        grpc_timeout_milliseconds_to_deadline(timeout_ms));
+    call->rpc = stub_->AsyncEcho(&call->context, request, &cq_);
+    call->rpc->Finish(&call->response, &call->status, call.get());
+    return call;
+  }
+
+  void FinishCall(AsyncCall* call) {
+    void* tag;
+    bool ok;
+    ASSERT_TRUE(cq_.Next(&tag, &ok));
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(call, tag);
+  }
+
+  bool WaitForState(grpc_connectivity_state state) {
+    gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+    grpc_connectivity_state current;
+    while ((current = channel_->GetState(false)) != state) {
+      if (!channel_->WaitForStateChange(current, deadline)) return false;
+    }
+    return true;
+  }
+
+  int port_ = 0;
+  EchoServiceImpl service_;
+  std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+  CompletionQueue cq_;
+};
+
+TEST_F(DirectChannelEnd2endTest, ConnectsWhenAsked) {
+  StartServer();
+  EXPECT_EQ(GRPC_CHANNEL_IDLE, channel_->GetState(false));
+  EXPECT_TRUE(channel_->WaitForConnected(grpc_timeout_seconds_to_deadline(10)));
+  EXPECT_TRUE(SendRpc().ok());
+}
+
+TEST_F(DirectChannelEnd2endTest, CallsStartedBeforeReadyAreQueued) {
+  StartServer();
+  EXPECT_EQ(GRPC_CHANNEL_IDLE, channel_->GetState(false));
+  std::vector<std::unique_ptr<AsyncCall>> calls;
+  for (int i = 0; i < 5; i++) calls.push_back(StartCall());
+  for (size_t i = 0; i < calls.size(); i++) {
+    void* tag;
+    bool ok;
+    ASSERT_TRUE(cq_.Next(&tag, &ok));
+    EXPECT_TRUE(ok);
+  }
+  for (const auto& call : calls) {
+    EXPECT_TRUE(call->status.ok()) << call->status.error_message();
+    EXPECT_EQ("hello", call->response.message());
+  }
+  EXPECT_EQ(GRPC_CHANNEL_READY, channel_->GetState(false));
+}
+
+TEST_F(DirectChannelEnd2endTest, FailsFastInTransientFailure) {
+  // Nothing is listening on the port.
+  Status status = SendRpc();
+  EXPECT_EQ(StatusCode::UNAVAILABLE, status.error_code());
+  channel_->GetState(true);
+  EXPECT_TRUE(WaitForState(GRPC_CHANNEL_TRANSIENT_FAILURE));
+  EXPECT_EQ(StatusCode::UNAVAILABLE, SendRpc().error_code());
+}
+
+TEST_F(DirectChannelEnd2endTest, WaitForReadyCallWaitsForServer) {
+  auto call = StartCall(true /* wait_for_ready */, 10000);
+  channel_->GetState(true);
+  EXPECT_TRUE(WaitForState(GRPC_CHANNEL_TRANSIENT_FAILURE));
+  StartServer();
+  FinishCall(call.get());
+  EXPECT_TRUE(call->status.ok()) << call->status.error_message();
+}
+
+TEST_F(DirectChannelEnd2endTest, QueuedCallDeadlineExpires) {
+  auto call = StartCall(true /* wait_for_ready */, 500);
+  FinishCall(call.get());
+  EXPECT_EQ(StatusCode::DEADLINE_EXCEEDED, call->status.error_code());
+  // The channel is still usable.
+  StartServer();
+  EXPECT_TRUE(SendRpc(true /* wait_for_ready */).ok());
+}
+
+TEST_F(DirectChannelEnd2endTest, QueuedCallCanBeCancelled) {
+  auto call = StartCall(true /* wait_for_ready */, 10000);
+  call->context.TryCancel();
+  FinishCall(call.get());
+  EXPECT_EQ(StatusCode::CANCELLED, call->status.error_code());
+}
+
+TEST_F(DirectChannelEnd2endTest, ReconnectsAfterServerRestart) {
+  StartServer();
+  EXPECT_TRUE(SendRpc().ok());
+  StopServer();
+  // The channel reconnects on its own when the connection goes away, and
+  // queues wait_for_ready calls meanwhile.
+  EXPECT_TRUE(WaitForState(GRPC_CHANNEL_TRANSIENT_FAILURE));
+  auto call = StartCall(true /* wait_for_ready */, 10000);
+  StartServer();
+  FinishCall(call.get());
+  EXPECT_TRUE(call->status.ok()) << call->status.error_message();
+  EXPECT_TRUE(SendRpc().ok());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
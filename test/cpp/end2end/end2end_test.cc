@@ -18,6 +18,7 @@
 
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
@@ -907,6 +908,43 @@ TEST_P(End2endTest, RequestStreamTwoRequestsWithWriteThrough) {
   EXPECT_TRUE(s.ok());
 }
 
+TEST_P(End2endTest, RequestStreamWriteMany) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  EchoResponse response;
+  ClientContext context;
+
+  auto stream = stub_->RequestStream(&context, &response);
+  std::vector<EchoRequest> requests(3);
+  requests[0].set_message("a");
+  requests[1].set_message("b");
+  requests[2].set_message("c");
+  EXPECT_TRUE(stream->WriteMany(requests.begin(), requests.end()));
+  EXPECT_TRUE(stream->WriteMany(requests.end(), requests.end()));
+  stream->WritesDone();
+  Status s = stream->Finish();
+  EXPECT_EQ(response.message(), "abc");
+  EXPECT_TRUE(s.ok());
+}
+
+TEST_P(End2endTest, RequestStreamWriteManyWithLastMessage) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  EchoResponse response;
+  ClientContext context;
+
+  context.set_initial_metadata_corked(true);
+  auto stream = stub_->RequestStream(&context, &response);
+  std::vector<EchoRequest> requests(2);
+  requests[0].set_message("hello");
+  requests[1].set_message("world");
+  EXPECT_TRUE(stream->WriteMany(requests.begin(), requests.end(),
+                                WriteOptions().set_last_message()));
+  Status s = stream->Finish();
+  EXPECT_EQ(response.message(), "helloworld");
+  EXPECT_TRUE(s.ok());
+}
+
 TEST_P(End2endTest, RequestStreamTwoRequestsWithCoalescingApi) {
   MAYBE_SKIP_TEST;
   ResetStub();
@@ -17,6 +17,8 @@
  */
 
 #include <memory>
+#include <set>
+#include <string>
 #include <thread>
 
 #include <grpc/grpc.h>
@@ -312,6 +314,72 @@ TEST_F(GenericEnd2endTest, SequentialUnaryRpcs) {
   }
 }
 
+TEST_F(GenericEnd2endTest, StartUnaryCalls) {
+  ResetStub();
+  const int num_rpcs = 5;
+  const grpc::string kMethodName("/grpc.cpp.test.util.EchoTestService/Echo");
+  ClientContext cli_ctx[num_rpcs];
+  ClientContext* cli_ctx_ptrs[num_rpcs];
+  ByteBuffer cli_send_buffers[num_rpcs];
+  ByteBuffer cli_recv_buffers[num_rpcs];
+  Status recv_status[num_rpcs];
+  void* tags[num_rpcs];
+  for (int i = 0; i < num_rpcs; i++) {
+    EchoRequest send_request;
+    send_request.set_message("Hello world. Hello world. " + std::to_string(i));
+    cli_send_buffers[i] = *SerializeToByteBuffer(&send_request);
+    cli_ctx_ptrs[i] = &cli_ctx[i];
+    tags[i] = tag(i + 1);
+  }
+  generic_stub_->experimental().StartUnaryCalls(
+      num_rpcs, cli_ctx_ptrs, kMethodName, cli_send_buffers, cli_recv_buffers,
+      recv_status, &cli_cq_, tags);
+  std::thread client_check([this] {
+    std::set<void*> seen;
+    for (int i = 0; i < num_rpcs; i++) {
+      bool ok;
+      void* got_tag;
+      EXPECT_TRUE(cli_cq_.Next(&got_tag, &ok));
+      EXPECT_TRUE(ok);
+      EXPECT_TRUE(seen.insert(got_tag).second);
+    }
+  });
+
+  for (int i = 0; i < num_rpcs; i++) {
+    GenericServerContext srv_ctx;
+    GenericServerAsyncReaderWriter stream(&srv_ctx);
+    generic_service_.RequestCall(&srv_ctx, &stream, srv_cq_.get(),
+                                 srv_cq_.get(), tag(4));
+    server_ok(4);
+    EXPECT_EQ(kMethodName, srv_ctx.method());
+
+    ByteBuffer srv_recv_buffer;
+    stream.Read(&srv_recv_buffer, tag(5));
+    server_ok(5);
+    EchoRequest recv_request;
+    EXPECT_TRUE(ParseFromByteBuffer(&srv_recv_buffer, &recv_request));
+
+    EchoResponse send_response;
+    send_response.set_message(recv_request.message());
+    std::unique_ptr<ByteBuffer> srv_send_buffer =
+        SerializeToByteBuffer(&send_response);
+    stream.Write(*srv_send_buffer, tag(6));
+    server_ok(6);
+
+    stream.Finish(Status::OK, tag(7));
+    server_ok(7);
+  }
+
+  client_check.join();
+  for (int i = 0; i < num_rpcs; i++) {
+    EXPECT_TRUE(recv_status[i].ok());
+    EchoResponse recv_response;
+    EXPECT_TRUE(ParseFromByteBuffer(&cli_recv_buffers[i], &recv_response));
+    EXPECT_EQ("Hello world. Hello world. " + std::to_string(i),
+              recv_response.message());
+  }
+}
+
 // One ping, one pong.
 TEST_F(GenericEnd2endTest, SimpleBidiStreaming) {
   ResetStub();
@@ -36,6 +36,7 @@
 #include <grpcpp/server_context.h>
 #include <grpcpp/support/client_callback.h>
 #include <grpcpp/support/message_allocator.h>
+#include <grpcpp/support/proto_arena_message_allocator.h>
 
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
@@ -371,6 +372,23 @@ TEST_P(ArenaAllocatorTest, SimpleRpc) {
   EXPECT_EQ(kRpcCount, allocator->allocation_count);
 }
 
+class ProtoArenaAllocatorTest : public MessageAllocatorEnd2endTestBase {
+ public:
+  typedef experimental::ProtoArenaMessageAllocator<EchoRequest, EchoResponse>
+      ProtoArenaAllocator;
+};
+
+TEST_P(ProtoArenaAllocatorTest, SimpleRpc) {
+  MAYBE_SKIP_TEST;
+  const int kRpcCount = 10;
+  // Keeps a single arena, so that every rpc but the first reuses it.
+  std::unique_ptr<ProtoArenaAllocator> allocator(
+      new ProtoArenaAllocator(1024, 1));
+  CreateServer(allocator.get());
+  ResetStub();
+  SendRpcs(kRpcCount);
+}
+
 std::vector<TestScenario> CreateTestScenarios(bool test_insecure) {
   std::vector<TestScenario> scenarios;
   std::vector<grpc::string> credentials_types{
@@ -406,6 +424,8 @@ INSTANTIATE_TEST_CASE_P(SimpleAllocatorTest, SimpleAllocatorTest,
                         ::testing::ValuesIn(CreateTestScenarios(true)));
 INSTANTIATE_TEST_CASE_P(ArenaAllocatorTest, ArenaAllocatorTest,
                         ::testing::ValuesIn(CreateTestScenarios(true)));
+INSTANTIATE_TEST_CASE_P(ProtoArenaAllocatorTest, ProtoArenaAllocatorTest,
+                        ::testing::ValuesIn(CreateTestScenarios(true)));
 
 }  // namespace
 }  // namespace testing
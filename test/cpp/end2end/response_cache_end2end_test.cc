@@ -0,0 +1,223 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/util/string_ref_helper.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// Echoes the request and returns its message as the response's
+// cache-control directives, so that each test picks its own.
+class CacheControlServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    ++calls_;
+    if (request->has_param() && request->param().has_expected_error()) {
+      const ErrorStatus& error = request->param().expected_error();
+      return Status(static_cast<StatusCode>(error.code()),
+                    error.error_message());
+    }
+    context->AddTrailingMetadata("cache-control", request->message());
+    response->set_message(request->message());
+    return Status::OK;
+  }
+
+  int calls() const { return calls_.load(); }
+
+ private:
+  std::atomic<int> calls_{0};
+};
+
+class ResponseCacheEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    port_ = grpc_pick_unused_port_or_die();
+    server_address_ << "127.0.0.1:" << port_;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address_.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_UNARY_RESPONSE_CACHE_SIZE, 1024 * 1024);
+    channel_ = CreateCustomChannel(server_address_.str(),
+                                   InsecureChannelCredentials(), args);
+    stub_ = EchoTestService::NewStub(channel_);
+  }
+
+  void TearDown() override {
+    server_->Shutdown();
+    grpc_recycle_unused_port(port_);
+  }
+
+  // Sends a cacheable Echo whose response carries cache_control.
+  Status SendRpc(const grpc::string& cache_control,
+                 EchoResponse* response = nullptr,
+                 ClientContext* context = nullptr) {
+    EchoRequest request;
+    request.set_message(cache_control);
+    EchoResponse local_response;
+    if (response == nullptr) response = &local_response;
+    ClientContext local_context;
+    if (context == nullptr) context = &local_context;
+    context->set_cacheable(true);
+    return stub_->Echo(context, request, response);
+  }
+
+  int port_ = 0;
+  std::ostringstream server_address_;
+  CacheControlServiceImpl service_;
+  std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+TEST_F(ResponseCacheEnd2endTest, MaxAgeResponseIsServedFromCache) {
+  EchoResponse first;
+  EXPECT_TRUE(SendRpc("max-age=60", &first).ok());
+  EchoResponse second;
+  ClientContext context;
+  EXPECT_TRUE(SendRpc("max-age=60", &second, &context).ok());
+  EXPECT_EQ(1, service_.calls());
+  EXPECT_EQ(first.message(), second.message());
+  // The hit carries the trailing metadata of the cached response.
+  auto it = context.GetServerTrailingMetadata().find("cache-control");
+  ASSERT_NE(it, context.GetServerTrailingMetadata().end());
+  EXPECT_EQ("max-age=60", ToString(it->second));
+}
+
+TEST_F(ResponseCacheEnd2endTest, DifferentRequestsAreCachedSeparately) {
+  EXPECT_TRUE(SendRpc("max-age=60").ok());
+  EXPECT_TRUE(SendRpc("max-age=60, public").ok());
+  EXPECT_TRUE(SendRpc("max-age=60").ok());
+  EXPECT_TRUE(SendRpc("max-age=60, public").ok());
+  EXPECT_EQ(2, service_.calls());
+}
+
+TEST_F(ResponseCacheEnd2endTest, RequestsNotMarkedCacheableAreNotCached) {
+  EchoRequest request;
+  request.set_message("max-age=60");
+  for (int i = 0; i < 2; i++) {
+    EchoResponse response;
+    ClientContext context;
+    EXPECT_TRUE(stub_->Echo(&context, request, &response).ok());
+  }
+  EXPECT_EQ(2, service_.calls());
+}
+
+TEST_F(ResponseCacheEnd2endTest, ResponsesWithoutMaxAgeAreNotCached) {
+  EXPECT_TRUE(SendRpc("public").ok());
+  EXPECT_TRUE(SendRpc("public").ok());
+  EXPECT_EQ(2, service_.calls());
+}
+
+TEST_F(ResponseCacheEnd2endTest, NoStoreNoCacheAndPrivateAreHonored) {
+  const char* directives[] = {"max-age=60, no-store", "no-cache, max-age=60",
+                              "max-age=60,private"};
+  for (const char* directive : directives) {
+    EXPECT_TRUE(SendRpc(directive).ok());
+    EXPECT_TRUE(SendRpc(directive).ok());
+  }
+  EXPECT_EQ(6, service_.calls());
+}
+
+TEST_F(ResponseCacheEnd2endTest, FailedCallsAreNotCached) {
+  for (int i = 0; i < 2; i++) {
+    EchoRequest request;
+    request.set_message("max-age=60");
+    request.mutable_param()->mutable_expected_error()->set_code(
+        StatusCode::UNAVAILABLE);
+    EchoResponse response;
+    ClientContext context;
+    context.set_cacheable(true);
+    EXPECT_EQ(StatusCode::UNAVAILABLE,
+              stub_->Echo(&context, request, &response).error_code());
+  }
+  EXPECT_EQ(2, service_.calls());
+}
+
+TEST_F(ResponseCacheEnd2endTest, EntriesExpire) {
+  EXPECT_TRUE(SendRpc("max-age=1").ok());
+  EXPECT_TRUE(SendRpc("max-age=1").ok());
+  EXPECT_EQ(1, service_.calls());
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1500));
+  EXPECT_TRUE(SendRpc("max-age=1").ok());
+  EXPECT_EQ(2, service_.calls());
+}
+
+TEST_F(ResponseCacheEnd2endTest, CallsWithAuthorizationMetadataBypassCache) {
+  // Cache a response first, so that a lookup by the calls below would hit.
+  EXPECT_TRUE(SendRpc("max-age=60").ok());
+  for (int i = 0; i < 2; i++) {
+    ClientContext context;
+    context.AddMetadata("authorization", "Bearer token");
+    EXPECT_TRUE(SendRpc("max-age=60", nullptr, &context).ok());
+  }
+  EXPECT_EQ(3, service_.calls());
+}
+
+TEST_F(ResponseCacheEnd2endTest, CallsWithCookiesBypassCache) {
+  EXPECT_TRUE(SendRpc("max-age=60").ok());
+  ClientContext context;
+  context.AddMetadata("cookie", "session=1");
+  EXPECT_TRUE(SendRpc("max-age=60", nullptr, &context).ok());
+  EXPECT_EQ(2, service_.calls());
+}
+
+TEST_F(ResponseCacheEnd2endTest, CallsWithCallCredentialsBypassCache) {
+  EXPECT_TRUE(SendRpc("max-age=60").ok());
+  for (int i = 0; i < 2; i++) {
+    ClientContext context;
+    context.set_credentials(AccessTokenCredentials("token"));
+    EXPECT_TRUE(SendRpc("max-age=60", nullptr, &context).ok());
+  }
+  EXPECT_EQ(3, service_.calls());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
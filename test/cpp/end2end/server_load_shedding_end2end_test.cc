@@ -0,0 +1,223 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <memory>
+#include <sstream>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+const int kQueueDelayTargetMs = 50;
+const int kQueueDelayIntervalMs = 100;
+const int kNumOverloadCalls = 20;
+// How often the overloaded server gets around to requesting a call.
+const int kServePeriodMs = 40;
+
+void* tag(intptr_t i) { return reinterpret_cast<void*>(i); }
+
+struct ClientCall {
+  ClientContext context;
+  EchoRequest request;
+  EchoResponse response;
+  Status status;
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> reader;
+};
+
+struct ServerCall {
+  ServerCall() : responder(&context) {}
+  ServerContext context;
+  EchoRequest request;
+  ServerAsyncResponseWriter<EchoResponse> responder;
+};
+
+class ServerLoadSheddingEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    port_ = grpc_pick_unused_port_or_die();
+    server_address_ << "127.0.0.1:" << port_;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address_.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    builder.AddChannelArgument(GRPC_ARG_SERVER_QUEUE_DELAY_TARGET_MS,
+                               kQueueDelayTargetMs);
+    builder.AddChannelArgument(GRPC_ARG_SERVER_QUEUE_DELAY_INTERVAL_MS,
+                               kQueueDelayIntervalMs);
+    server_cq_ = builder.AddCompletionQueue();
+    server_ = builder.BuildAndStart();
+    stub_ = EchoTestService::NewStub(
+        CreateChannel(server_address_.str(), InsecureChannelCredentials()));
+  }
+
+  void TearDown() override {
+    server_->Shutdown();
+    void* ignored_tag;
+    bool ignored_ok;
+    server_cq_->Shutdown();
+    while (server_cq_->Next(&ignored_tag, &ignored_ok)) {
+    }
+    client_cq_.Shutdown();
+    while (client_cq_.Next(&ignored_tag, &ignored_ok)) {
+    }
+    grpc_recycle_unused_port(port_);
+  }
+
+  ClientCall* StartCall() {
+    ClientCall* call = new ClientCall;
+    call->request.set_message("hello");
+    call->reader = stub_->AsyncEcho(&call->context, call->request, &client_cq_);
+    call->reader->Finish(&call->response, &call->status, call);
+    return call;
+  }
+
+  void CountClientCall(void* got_tag, bool ok) {
+    EXPECT_TRUE(ok);
+    std::unique_ptr<ClientCall> call(static_cast<ClientCall*>(got_tag));
+    if (call->status.ok()) {
+      ++num_ok_;
+    } else {
+      EXPECT_EQ(StatusCode::RESOURCE_EXHAUSTED, call->status.error_code());
+      ++num_shed_;
+    }
+  }
+
+  // Counts the client calls completing within timeout_ms.
+  void CollectClientCalls(int timeout_ms) {
+    gpr_timespec deadline = grpc_timeout_milliseconds_to_deadline(timeout_ms);
+    void* got_tag;
+    bool ok;
+    while (client_cq_.AsyncNext(&got_tag, &ok, deadline) ==
+           CompletionQueue::GOT_EVENT) {
+      CountClientCall(got_tag, ok);
+    }
+  }
+
+  void WaitForClientCall() {
+    void* got_tag;
+    bool ok;
+    ASSERT_TRUE(client_cq_.Next(&got_tag, &ok));
+    CountClientCall(got_tag, ok);
+  }
+
+  // Requests a call, unless one is already requested, and serves it if it
+  // gets matched within timeout_ms. Calls the server sheds never show up
+  // here.
+  bool ServeOne(int timeout_ms) {
+    if (requested_ == nullptr) {
+      requested_.reset(new ServerCall);
+      service_.RequestEcho(&requested_->context, &requested_->request,
+                           &requested_->responder, server_cq_.get(),
+                           server_cq_.get(), tag(1));
+    }
+    void* got_tag;
+    bool ok;
+    if (server_cq_->AsyncNext(
+            &got_tag, &ok, grpc_timeout_milliseconds_to_deadline(timeout_ms)) !=
+        CompletionQueue::GOT_EVENT) {
+      return false;
+    }
+    EXPECT_EQ(tag(1), got_tag);
+    EXPECT_TRUE(ok);
+    EchoResponse response;
+    response.set_message(requested_->request.message());
+    requested_->responder.Finish(response, Status::OK, tag(2));
+    EXPECT_TRUE(server_cq_->Next(&got_tag, &ok));
+    EXPECT_EQ(tag(2), got_tag);
+    requested_.reset();
+    return true;
+  }
+
+  // Has a burst of calls wait well past the target, then serves them slower
+  // than the interval allows for, until all of them are done.
+  void Overload() {
+    for (int i = 0; i < kNumOverloadCalls; ++i) StartCall();
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(
+        kQueueDelayTargetMs + kQueueDelayIntervalMs));
+    const int total = num_ok_ + num_shed_ + kNumOverloadCalls;
+    while (num_ok_ + num_shed_ < total) {
+      ServeOne(kServePeriodMs);
+      CollectClientCalls(kServePeriodMs);
+    }
+  }
+
+  int port_ = 0;
+  std::ostringstream server_address_;
+  EchoTestService::AsyncService service_;
+  std::unique_ptr<ServerCompletionQueue> server_cq_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+  CompletionQueue client_cq_;
+  std::unique_ptr<ServerCall> requested_;
+  int num_ok_ = 0;
+  int num_shed_ = 0;
+};
+
+TEST_F(ServerLoadSheddingEnd2endTest, ShedsCallsKeptWaitingPastTheTarget) {
+  Overload();
+  EXPECT_EQ(kNumOverloadCalls, num_ok_ + num_shed_);
+  // Calls are served until the wait has stayed above the target for an
+  // interval, and only some of them are shed after that.
+  EXPECT_GE(num_ok_, kQueueDelayIntervalMs / kServePeriodMs);
+  EXPECT_GT(num_shed_, 0);
+}
+
+TEST_F(ServerLoadSheddingEnd2endTest, RecoversOnceQueueDrains) {
+  Overload();
+  ASSERT_GT(num_shed_, 0);
+  const int num_shed = num_shed_;
+  const int num_ok = num_ok_;
+  // Calls that wait less than the target again are all served.
+  const int kNumCalls = 5;
+  for (int i = 0; i < kNumCalls; ++i) {
+    StartCall();
+    gpr_sleep_until(
+        grpc_timeout_milliseconds_to_deadline(kQueueDelayTargetMs / 5));
+    EXPECT_TRUE(ServeOne(5000));
+    WaitForClientCall();
+    EXPECT_EQ(num_ok + i + 1, num_ok_);
+  }
+  EXPECT_EQ(num_shed, num_shed_);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,295 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/util/string_ref_helper.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// Echoes the request once the test opens the gate, with initial and
+// trailing metadata, so that followers can be checked to get copies of all
+// of the leader's results.
+class GatedEchoServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      ++calls_;
+      cv_.notify_all();
+      cv_.wait(lock, [this]() { return open_; });
+    }
+    context->AddInitialMetadata("initial-key", "initial-value");
+    context->AddTrailingMetadata("trailing-key", "trailing-value");
+    if (request->has_param() && request->param().has_expected_error()) {
+      const ErrorStatus& error = request->param().expected_error();
+      return Status(static_cast<StatusCode>(error.code()),
+                    error.error_message());
+    }
+    response->set_message(request->message());
+    return Status::OK;
+  }
+
+  void Open() {
+    std::lock_guard<std::mutex> lock(mu_);
+    open_ = true;
+    cv_.notify_all();
+  }
+
+  // Waits until the server has received at least n calls.
+  bool WaitForCalls(int n) {
+    std::unique_lock<std::mutex> lock(mu_);
+    return cv_.wait_for(lock, std::chrono::seconds(10),
+                        [this, n]() { return calls_ >= n; });
+  }
+
+  int calls() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return calls_;
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool open_ = false;
+  int calls_ = 0;
+};
+
+struct AsyncCall {
+  ClientContext context;
+  EchoResponse response;
+  Status status;
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> rpc;
+};
+
+class UnaryCoalescingEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    port_ = grpc_pick_unused_port_or_die();
+    server_address_ << "127.0.0.1:" << port_;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address_.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_COALESCE_UNARY_CALLS, 1);
+    channel_ = CreateCustomChannel(server_address_.str(),
+                                   InsecureChannelCredentials(), args);
+    stub_ = EchoTestService::NewStub(channel_);
+  }
+
+  void TearDown() override {
+    service_.Open();
+    server_->Shutdown();
+    cq_.Shutdown();
+    void* tag;
+    bool ok;
+    while (cq_.Next(&tag, &ok)) {
+    }
+    grpc_recycle_unused_port(port_);
+  }
+
+  // Starts an Echo of message whose whole batch is sent at once. The
+  // coalescing filter has seen the call by the time this returns.
+  std::unique_ptr<AsyncCall> StartCall(
+      const grpc::string& message, int timeout_ms = 10000,
+      StatusCode expected_error = StatusCode::OK) {
+    std::unique_ptr<AsyncCall> call(new AsyncCall);
+    EchoRequest request;
+    request.set_message(message);
+    if (expected_error != StatusCode::OK) {
+      request.mutable_param()->mutable_expected_error()->set_code(
+          expected_error);
+    }
+    call->context.set_deadline(
+        grpc_timeout_milliseconds_to_deadline(timeout_ms));
+    call->rpc = stub_->AsyncEcho(&call->context, request, &cq_);
+    call->rpc->Finish(&call->response, &call->status, call.get());
+    return call;
+  }
+
+  // Waits for each of calls to complete, in any order.
+  void FinishCalls(const std::vector<AsyncCall*>& calls) {
+    std::set<void*> pending(calls.begin(), calls.end());
+    while (!pending.empty()) {
+      void* tag;
+      bool ok;
+      ASSERT_TRUE(cq_.Next(&tag, &ok));
+      EXPECT_TRUE(ok);
+      EXPECT_EQ(1u, pending.erase(tag));
+    }
+  }
+
+  void ExpectEchoed(const AsyncCall& call, const grpc::string& message) {
+    EXPECT_TRUE(call.status.ok()) << call.status.error_message();
+    EXPECT_EQ(message, call.response.message());
+    auto initial = call.context.GetServerInitialMetadata().find("initial-key");
+    ASSERT_NE(initial, call.context.GetServerInitialMetadata().end());
+    EXPECT_EQ("initial-value", ToString(initial->second));
+    auto trailing =
+        call.context.GetServerTrailingMetadata().find("trailing-key");
+    ASSERT_NE(trailing, call.context.GetServerTrailingMetadata().end());
+    EXPECT_EQ("trailing-value", ToString(trailing->second));
+  }
+
+  int port_ = 0;
+  std::ostringstream server_address_;
+  GatedEchoServiceImpl service_;
+  std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+  CompletionQueue cq_;
+};
+
+TEST_F(UnaryCoalescingEnd2endTest, FollowersShareLeaderResults) {
+  auto leader = StartCall("hello");
+  ASSERT_TRUE(service_.WaitForCalls(1));
+  auto follower1 = StartCall("hello");
+  auto follower2 = StartCall("hello");
+  service_.Open();
+  FinishCalls({leader.get(), follower1.get(), follower2.get()});
+  ExpectEchoed(*leader, "hello");
+  ExpectEchoed(*follower1, "hello");
+  ExpectEchoed(*follower2, "hello");
+  EXPECT_EQ(1, service_.calls());
+}
+
+TEST_F(UnaryCoalescingEnd2endTest, DifferentRequestsAreNotCoalesced) {
+  auto first = StartCall("hello");
+  auto second = StartCall("world");
+  ASSERT_TRUE(service_.WaitForCalls(2));
+  service_.Open();
+  FinishCalls({first.get(), second.get()});
+  ExpectEchoed(*first, "hello");
+  ExpectEchoed(*second, "world");
+}
+
+TEST_F(UnaryCoalescingEnd2endTest, CallsAfterFlightClosesAreSent) {
+  service_.Open();
+  auto first = StartCall("hello");
+  FinishCalls({first.get()});
+  auto second = StartCall("hello");
+  FinishCalls({second.get()});
+  ExpectEchoed(*first, "hello");
+  ExpectEchoed(*second, "hello");
+  EXPECT_EQ(2, service_.calls());
+}
+
+TEST_F(UnaryCoalescingEnd2endTest, CancelledFollowerLeavesFlight) {
+  auto leader = StartCall("hello");
+  ASSERT_TRUE(service_.WaitForCalls(1));
+  auto cancelled = StartCall("hello");
+  auto follower = StartCall("hello");
+  cancelled->context.TryCancel();
+  FinishCalls({cancelled.get()});
+  EXPECT_EQ(StatusCode::CANCELLED, cancelled->status.error_code());
+  service_.Open();
+  FinishCalls({leader.get(), follower.get()});
+  ExpectEchoed(*leader, "hello");
+  ExpectEchoed(*follower, "hello");
+  EXPECT_EQ(1, service_.calls());
+}
+
+TEST_F(UnaryCoalescingEnd2endTest, ServerErrorIsShared) {
+  auto leader = StartCall("hello", 10000, StatusCode::FAILED_PRECONDITION);
+  ASSERT_TRUE(service_.WaitForCalls(1));
+  auto follower = StartCall("hello", 10000, StatusCode::FAILED_PRECONDITION);
+  service_.Open();
+  FinishCalls({leader.get(), follower.get()});
+  EXPECT_EQ(StatusCode::FAILED_PRECONDITION, leader->status.error_code());
+  EXPECT_EQ(StatusCode::FAILED_PRECONDITION, follower->status.error_code());
+  EXPECT_EQ(1, service_.calls());
+}
+
+TEST_F(UnaryCoalescingEnd2endTest, StatusThatMayBeLocalIsNotShared) {
+  // UNAVAILABLE could be the leader's own connection failing, so the
+  // follower sends its call itself even though the server sent it.
+  auto leader = StartCall("hello", 10000, StatusCode::UNAVAILABLE);
+  ASSERT_TRUE(service_.WaitForCalls(1));
+  auto follower = StartCall("hello", 10000, StatusCode::UNAVAILABLE);
+  service_.Open();
+  FinishCalls({leader.get(), follower.get()});
+  EXPECT_EQ(StatusCode::UNAVAILABLE, leader->status.error_code());
+  EXPECT_EQ(StatusCode::UNAVAILABLE, follower->status.error_code());
+  EXPECT_EQ(2, service_.calls());
+}
+
+TEST_F(UnaryCoalescingEnd2endTest, LocalLeaderFailureResumesFollowers) {
+  // The leader's deadline expires while the server holds it. That failure is
+  // the leader's own, so the follower sends its call itself.
+  auto leader = StartCall("hello", 500);
+  ASSERT_TRUE(service_.WaitForCalls(1));
+  auto follower = StartCall("hello");
+  FinishCalls({leader.get()});
+  EXPECT_EQ(StatusCode::DEADLINE_EXCEEDED, leader->status.error_code());
+  ASSERT_TRUE(service_.WaitForCalls(2));
+  service_.Open();
+  FinishCalls({follower.get()});
+  ExpectEchoed(*follower, "hello");
+}
+
+TEST_F(UnaryCoalescingEnd2endTest, FollowerDeadlineExpiresWhileWaiting) {
+  // Deadlines are not part of what makes calls identical, so a follower may
+  // have a shorter one than its leader. It fails alone when that expires.
+  auto leader = StartCall("hello");
+  ASSERT_TRUE(service_.WaitForCalls(1));
+  auto follower = StartCall("hello", 500);
+  FinishCalls({follower.get()});
+  EXPECT_EQ(StatusCode::DEADLINE_EXCEEDED, follower->status.error_code());
+  service_.Open();
+  FinishCalls({leader.get()});
+  ExpectEchoed(*leader, "hello");
+  EXPECT_EQ(1, service_.calls());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,144 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+const int kNumThreads = 8;
+const int kCallsPerThread = 50;
+
+class EchoServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* context, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+class WriteCoalescingEnd2endTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    if (server_ != nullptr) {
+      server_->Shutdown();
+      grpc_recycle_unused_port(port_);
+    }
+  }
+
+  // Starts a server and a channel that both hold writes for window_us.
+  void Start(int window_us) {
+    port_ = grpc_pick_unused_port_or_die();
+    server_address_ << "127.0.0.1:" << port_;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address_.str(),
+                             InsecureServerCredentials());
+    builder.AddChannelArgument(GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US,
+                               window_us);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US, window_us);
+    channel_ = CreateCustomChannel(server_address_.str(),
+                                   InsecureChannelCredentials(), args);
+    stub_ = EchoTestService::NewStub(channel_);
+  }
+
+  // Sends kCallsPerThread calls back to back from each of kNumThreads
+  // threads, so that writes of different streams follow each other closely.
+  void SendConcurrentRpcs() {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; i++) {
+      threads.emplace_back([this]() {
+        for (int j = 0; j < kCallsPerThread; j++) {
+          EchoRequest request;
+          request.set_message("hello");
+          EchoResponse response;
+          ClientContext context;
+          // A held write that is never released would stall the call.
+          context.set_deadline(grpc_timeout_seconds_to_deadline(10));
+          Status status = stub_->Echo(&context, request, &response);
+          EXPECT_TRUE(status.ok()) << status.error_message();
+          EXPECT_EQ("hello", response.message());
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+  }
+
+  static int64_t CoalescedWrites() {
+    grpc_stats_data stats;
+    grpc_stats_collect(&stats);
+    return stats.counters[GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED];
+  }
+
+  int port_ = 0;
+  std::ostringstream server_address_;
+  EchoServiceImpl service_;
+  std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+TEST_F(WriteCoalescingEnd2endTest, HeldWritesAreReleased) {
+  Start(5000);
+  const int64_t before = CoalescedWrites();
+  SendConcurrentRpcs();
+  EXPECT_GT(CoalescedWrites(), before);
+}
+
+TEST_F(WriteCoalescingEnd2endTest, NoWritesAreHeldWithoutWindow) {
+  Start(0);
+  const int64_t before = CoalescedWrites();
+  SendConcurrentRpcs();
+  EXPECT_EQ(before, CoalescedWrites());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -82,6 +82,8 @@ namespace {
 using std::chrono::system_clock;
 
 using ::envoy::api::v2::ClusterLoadAssignment;
+using ::envoy::api::v2::DeltaDiscoveryRequest;
+using ::envoy::api::v2::DeltaDiscoveryResponse;
 using ::envoy::api::v2::DiscoveryRequest;
 using ::envoy::api::v2::DiscoveryResponse;
 using ::envoy::api::v2::EndpointDiscoveryService;
@@ -262,6 +264,9 @@ class EdsServiceImpl : public EdsService {
  public:
   using Stream = ServerReaderWriter<DiscoveryResponse, DiscoveryRequest>;
   using ResponseDelayPair = std::pair<DiscoveryResponse, int>;
+  using DeltaStream =
+      ServerReaderWriter<DeltaDiscoveryResponse, DeltaDiscoveryRequest>;
+  using DeltaResponseDelayPair = std::pair<DeltaDiscoveryResponse, int>;
 
   Status StreamEndpoints(ServerContext* context, Stream* stream) override {
     gpr_log(GPR_INFO, "LB[%p]: EDS StreamEndpoints starts", this);
@@ -297,15 +302,65 @@ class EdsServiceImpl : public EdsService {
     return Status::OK;
   }
 
+  Status DeltaEndpoints(ServerContext* context, DeltaStream* stream) override {
+    gpr_log(GPR_INFO, "LB[%p]: EDS DeltaEndpoints starts", this);
+    [&]() {
+      {
+        grpc_core::MutexLock lock(&eds_mu_);
+        if (eds_done_) return;
+      }
+      // Balancer shouldn't receive the call credentials metadata.
+      EXPECT_EQ(context->client_metadata().find(g_kCallCredsMdKey),
+                context->client_metadata().end());
+      // Read the subscription.
+      if (!ReadDeltaRequest(stream)) return;
+      std::vector<DeltaResponseDelayPair> responses_and_delays;
+      {
+        grpc_core::MutexLock lock(&eds_mu_);
+        responses_and_delays = delta_responses_and_delays_;
+      }
+      // Send each response once the previous one was ACKed or NACKed.
+      for (const auto& response_and_delay : responses_and_delays) {
+        SendDeltaResponse(stream, response_and_delay.first,
+                          response_and_delay.second);
+        if (!ReadDeltaRequest(stream)) return;
+      }
+      // Wait until notified done.
+      grpc_core::MutexLock lock(&eds_mu_);
+      eds_cond_.WaitUntil(&eds_mu_, [this] { return eds_done_; });
+    }();
+    gpr_log(GPR_INFO, "LB[%p]: EDS DeltaEndpoints done", this);
+    return Status::OK;
+  }
+
   void add_response(const DiscoveryResponse& response, int send_after_ms) {
     grpc_core::MutexLock lock(&eds_mu_);
     responses_and_delays_.push_back(std::make_pair(response, send_after_ms));
   }
 
+  void add_delta_response(const DeltaDiscoveryResponse& response,
+                          int send_after_ms) {
+    grpc_core::MutexLock lock(&eds_mu_);
+    delta_responses_and_delays_.push_back(
+        std::make_pair(response, send_after_ms));
+  }
+
+  // Returns all the requests received on delta streams so far, across
+  // balancer restarts, once there are at least \a num_requests of them.
+  std::vector<DeltaDiscoveryRequest> WaitForDeltaRequests(
+      size_t num_requests) {
+    grpc_core::MutexLock lock(&delta_requests_mu_);
+    delta_requests_cond_.WaitUntil(&delta_requests_mu_, [&] {
+      return delta_requests_.size() >= num_requests;
+    });
+    return delta_requests_;
+  }
+
   void Start() {
     grpc_core::MutexLock lock(&eds_mu_);
     eds_done_ = false;
     responses_and_delays_.clear();
+    delta_responses_and_delays_.clear();
   }
 
   void Shutdown() {
@@ -313,6 +368,7 @@ class EdsServiceImpl : public EdsService {
       grpc_core::MutexLock lock(&eds_mu_);
       NotifyDoneWithEdsCallLocked();
       responses_and_delays_.clear();
+      delta_responses_and_delays_.clear();
     }
     gpr_log(GPR_INFO, "LB[%p]: shut down", this);
   }
@@ -366,6 +422,22 @@ class EdsServiceImpl : public EdsService {
     return response;
   }
 
+  // Builds a delta response carrying version \a version of the resource
+  // named \a resource_name.
+  static DeltaDiscoveryResponse BuildDeltaResponse(
+      const grpc::string& nonce, const grpc::string& resource_name,
+      const grpc::string& version,
+      const std::vector<std::vector<int>>& backend_ports) {
+    DeltaDiscoveryResponse response;
+    response.set_type_url(kEdsTypeUrl);
+    response.set_nonce(nonce);
+    auto* resource = response.add_resources();
+    resource->set_name(resource_name);
+    resource->set_version(version);
+    *resource->mutable_resource() = BuildResponse(backend_ports).resources(0);
+    return response;
+  }
+
   void NotifyDoneWithEdsCall() {
     grpc_core::MutexLock lock(&eds_mu_);
     NotifyDoneWithEdsCallLocked();
@@ -391,11 +463,41 @@ class EdsServiceImpl : public EdsService {
     stream->Write(response);
   }
 
+  void SendDeltaResponse(DeltaStream* stream,
+                         const DeltaDiscoveryResponse& response,
+                         int delay_ms) {
+    gpr_log(GPR_INFO, "LB[%p]: sleeping for %d ms...", this, delay_ms);
+    if (delay_ms > 0) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(delay_ms));
+    }
+    gpr_log(GPR_INFO, "LB[%p]: Woke up! Sending delta response '%s'", this,
+            response.DebugString().c_str());
+    IncreaseResponseCount();
+    stream->Write(response);
+  }
+
+  bool ReadDeltaRequest(DeltaStream* stream) {
+    DeltaDiscoveryRequest request;
+    if (!stream->Read(&request)) return false;
+    IncreaseRequestCount();
+    gpr_log(GPR_INFO, "LB[%p]: received delta request '%s'", this,
+            request.DebugString().c_str());
+    grpc_core::MutexLock lock(&delta_requests_mu_);
+    delta_requests_.push_back(std::move(request));
+    delta_requests_cond_.Broadcast();
+    return true;
+  }
+
   grpc_core::CondVar eds_cond_;
   // Protect the members below.
   grpc_core::Mutex eds_mu_;
   bool eds_done_ = false;
   std::vector<ResponseDelayPair> responses_and_delays_;
+  std::vector<DeltaResponseDelayPair> delta_responses_and_delays_;
+
+  grpc_core::CondVar delta_requests_cond_;
+  grpc_core::Mutex delta_requests_mu_;
+  std::vector<DeltaDiscoveryRequest> delta_requests_;
 };
 
 class LrsServiceImpl : public LrsService {
@@ -558,6 +660,7 @@ class XdsEnd2endTest : public ::testing::Test {
     if (fallback_timeout > 0) {
       args.SetInt(GRPC_ARG_XDS_FALLBACK_TIMEOUT_MS, fallback_timeout);
     }
+    if (delta_eds_) args.SetInt(GRPC_ARG_XDS_DELTA_EDS, 1);
     args.SetPointer(GRPC_ARG_FAKE_RESOLVER_RESPONSE_GENERATOR,
                     response_generator_.get());
     if (!expected_targets.empty()) {
@@ -896,6 +999,8 @@ class XdsEnd2endTest : public ::testing::Test {
   const size_t num_backends_;
   const size_t num_balancers_;
   const int client_load_reporting_interval_seconds_;
+  // Whether the channel fetches endpoints over delta EDS streams.
+  bool delta_eds_ = false;
   std::shared_ptr<Channel> channel_;
   std::unique_ptr<grpc::testing::EchoTestService::Stub> stub_;
   std::vector<std::unique_ptr<BackendServerThread>> backends_;
@@ -1720,6 +1825,155 @@ TEST_F(SingleBalancerTest, BackendsRestart) {
                  true /* wait_for_ready */);
 }
 
+class DeltaEdsTest : public XdsEnd2endTest {
+ public:
+  DeltaEdsTest() : XdsEnd2endTest(4, 1, 0) { delta_eds_ = true; }
+
+  EdsServiceImpl* eds_service() { return balancers_[0]->eds_service(); }
+};
+
+TEST_F(DeltaEdsTest, Vanilla) {
+  SetNextResolution({}, kDefaultServiceConfig_.c_str());
+  SetNextResolutionForLbChannelAllBalancers();
+  eds_service()->add_delta_response(
+      EdsServiceImpl::BuildDeltaResponse("A", kApplicationTargetName_, "1",
+                                         GetBackendPortsInGroups()),
+      0);
+  WaitForAllBackends();
+  CheckRpcSendOk(num_backends_);
+  std::vector<DeltaDiscoveryRequest> requests =
+      eds_service()->WaitForDeltaRequests(2);
+  ASSERT_EQ(2U, requests.size());
+  // The stream starts by subscribing to the resource, with nothing to
+  // resume from.
+  EXPECT_EQ(kEdsTypeUrl, requests[0].type_url());
+  EXPECT_TRUE(requests[0].has_node());
+  ASSERT_EQ(1, requests[0].resource_names_subscribe_size());
+  EXPECT_EQ(kApplicationTargetName_, requests[0].resource_names_subscribe(0));
+  EXPECT_TRUE(requests[0].initial_resource_versions().empty());
+  EXPECT_EQ("", requests[0].response_nonce());
+  // Then the response is ACKed.
+  EXPECT_EQ(kEdsTypeUrl, requests[1].type_url());
+  EXPECT_EQ("A", requests[1].response_nonce());
+  EXPECT_FALSE(requests[1].has_error_detail());
+  EXPECT_EQ(0, requests[1].resource_names_subscribe_size());
+  EXPECT_EQ("xds_experimental", channel_->GetLoadBalancingPolicyName());
+}
+
+TEST_F(DeltaEdsTest, NacksInvalidResponse) {
+  SetNextResolution({}, kDefaultServiceConfig_.c_str());
+  SetNextResolutionForLbChannelAllBalancers();
+  DeltaDiscoveryResponse invalid = EdsServiceImpl::BuildDeltaResponse(
+      "A", kApplicationTargetName_, "1", GetBackendPortsInGroups());
+  invalid.mutable_resources(0)->mutable_resource()->set_type_url(
+      "type.googleapis.com/envoy.api.v2.Cluster");
+  eds_service()->add_delta_response(invalid, 0);
+  eds_service()->add_delta_response(
+      EdsServiceImpl::BuildDeltaResponse("B", kApplicationTargetName_, "2",
+                                         GetBackendPortsInGroups()),
+      0);
+  // Only the second response is used.
+  WaitForAllBackends();
+  std::vector<DeltaDiscoveryRequest> requests =
+      eds_service()->WaitForDeltaRequests(3);
+  ASSERT_EQ(3U, requests.size());
+  EXPECT_EQ("A", requests[1].response_nonce());
+  ASSERT_TRUE(requests[1].has_error_detail());
+  EXPECT_EQ(GRPC_STATUS_INVALID_ARGUMENT, requests[1].error_detail().code());
+  EXPECT_FALSE(requests[1].error_detail().message().empty());
+  EXPECT_EQ("B", requests[2].response_nonce());
+  EXPECT_FALSE(requests[2].has_error_detail());
+}
+
+TEST_F(DeltaEdsTest, IgnoresOtherResources) {
+  SetNextResolution({}, kDefaultServiceConfig_.c_str());
+  SetNextResolutionForLbChannelAllBalancers();
+  eds_service()->add_delta_response(
+      EdsServiceImpl::BuildDeltaResponse("A", kApplicationTargetName_, "1",
+                                         GetBackendPortsInGroups(0, 2)),
+      0);
+  eds_service()->add_delta_response(
+      EdsServiceImpl::BuildDeltaResponse("B", "other_target_name", "1",
+                                         GetBackendPortsInGroups(2, 4)),
+      0);
+  WaitForAllBackends(1, 0, 2);
+  std::vector<DeltaDiscoveryRequest> requests =
+      eds_service()->WaitForDeltaRequests(3);
+  ASSERT_EQ(3U, requests.size());
+  // The response is still ACKed.
+  EXPECT_EQ("B", requests[2].response_nonce());
+  EXPECT_FALSE(requests[2].has_error_detail());
+  // But the backends of the other resource are never used.
+  CheckRpcSendOk(10);
+  EXPECT_EQ(0U, backends_[2]->backend_service()->request_count());
+  EXPECT_EQ(0U, backends_[3]->backend_service()->request_count());
+}
+
+TEST_F(DeltaEdsTest, KeepsLocalitiesWhenResourceIsRemoved) {
+  SetNextResolution({}, kDefaultServiceConfig_.c_str());
+  SetNextResolutionForLbChannelAllBalancers();
+  eds_service()->add_delta_response(
+      EdsServiceImpl::BuildDeltaResponse("A", kApplicationTargetName_, "1",
+                                         GetBackendPortsInGroups()),
+      0);
+  DeltaDiscoveryResponse removal;
+  removal.set_type_url(kEdsTypeUrl);
+  removal.set_nonce("B");
+  removal.add_removed_resources(kApplicationTargetName_);
+  eds_service()->add_delta_response(removal, 0);
+  WaitForAllBackends();
+  std::vector<DeltaDiscoveryRequest> requests =
+      eds_service()->WaitForDeltaRequests(3);
+  ASSERT_EQ(3U, requests.size());
+  EXPECT_EQ("B", requests[2].response_nonce());
+  EXPECT_FALSE(requests[2].has_error_detail());
+  // The removal doesn't leave the channel without backends.
+  CheckRpcSendOk(num_backends_);
+  // Nor is the removed version offered when the stream is restarted.
+  balancers_[0]->Shutdown();
+  balancers_[0]->Start(server_host_);
+  requests = eds_service()->WaitForDeltaRequests(4);
+  ASSERT_EQ(4U, requests.size());
+  ASSERT_EQ(1, requests[3].resource_names_subscribe_size());
+  EXPECT_TRUE(requests[3].initial_resource_versions().empty());
+}
+
+TEST_F(DeltaEdsTest, ResumesFromReceivedVersion) {
+  SetNextResolution({}, kDefaultServiceConfig_.c_str());
+  SetNextResolutionForLbChannelAllBalancers();
+  eds_service()->add_delta_response(
+      EdsServiceImpl::BuildDeltaResponse("A", kApplicationTargetName_, "1",
+                                         GetBackendPortsInGroups(0, 2)),
+      0);
+  WaitForAllBackends(1, 0, 2);
+  eds_service()->WaitForDeltaRequests(2);
+  // Restart the balancer, which restarts the stream.
+  balancers_[0]->Shutdown();
+  balancers_[0]->Start(server_host_);
+  eds_service()->add_delta_response(
+      EdsServiceImpl::BuildDeltaResponse("B", kApplicationTargetName_, "2",
+                                         GetBackendPortsInGroups(2, 4)),
+      0);
+  std::vector<DeltaDiscoveryRequest> requests =
+      eds_service()->WaitForDeltaRequests(3);
+  ASSERT_EQ(3U, requests.size());
+  // The new stream subscribes again, telling the balancer which version it
+  // already has.
+  EXPECT_TRUE(requests[2].has_node());
+  ASSERT_EQ(1, requests[2].resource_names_subscribe_size());
+  EXPECT_EQ(kApplicationTargetName_, requests[2].resource_names_subscribe(0));
+  EXPECT_EQ("", requests[2].response_nonce());
+  ASSERT_EQ(1U, requests[2].initial_resource_versions().size());
+  const auto it =
+      requests[2].initial_resource_versions().find(kApplicationTargetName_);
+  ASSERT_NE(it, requests[2].initial_resource_versions().end());
+  EXPECT_EQ("1", it->second);
+  // Updates on the new stream are applied.
+  WaitForAllBackends(1, 2, 4);
+  requests = eds_service()->WaitForDeltaRequests(4);
+  EXPECT_EQ("B", requests[3].response_nonce());
+}
+
 class UpdatesTest : public XdsEnd2endTest {
  public:
   UpdatesTest() : XdsEnd2endTest(4, 3, 0) {}
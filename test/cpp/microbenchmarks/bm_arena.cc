@@ -19,16 +19,21 @@
 /* Benchmark arenas */
 
 #include <benchmark/benchmark.h>
+#include <vector>
+
 #include "src/core/lib/gprpp/arena.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
 
 using grpc_core::Arena;
+using grpc_core::ArenaPool;
 
 static void BM_Arena_NoOp(benchmark::State& state) {
+  TrackCounters track_counters;
   while (state.KeepRunning()) {
     Arena::Create(state.range(0))->Destroy();
   }
+  track_counters.Finish(state);
 }
 BENCHMARK(BM_Arena_NoOp)->Range(1, 1024 * 1024);
 
@@ -36,6 +41,7 @@ static void BM_Arena_ManyAlloc(benchmark::State& state) {
   Arena* a = Arena::Create(state.range(0));
   const size_t realloc_after =
       1024 * 1024 * 1024 / ((state.range(1) + 15) & 0xffffff0u);
+  TrackCounters track_counters;
   while (state.KeepRunning()) {
     a->Alloc(state.range(1));
     // periodically recreate arena to avoid OOM
@@ -44,11 +50,13 @@ static void BM_Arena_ManyAlloc(benchmark::State& state) {
       a = Arena::Create(state.range(0));
     }
   }
+  track_counters.Finish(state);
   a->Destroy();
 }
 BENCHMARK(BM_Arena_ManyAlloc)->Ranges({{1, 1024 * 1024}, {1, 32 * 1024}});
 
 static void BM_Arena_Batch(benchmark::State& state) {
+  TrackCounters track_counters;
   while (state.KeepRunning()) {
     Arena* a = Arena::Create(state.range(0));
     for (int i = 0; i < state.range(1); i++) {
@@ -56,9 +64,55 @@ static void BM_Arena_Batch(benchmark::State& state) {
     }
     a->Destroy();
   }
+  track_counters.Finish(state);
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
+// Same as BM_Arena_NoOp and BM_Arena_Batch, with the arenas recycled through an
+// ArenaPool the way call arenas are.
+
+static void BM_ArenaPool_NoOp(benchmark::State& state) {
+  ArenaPool pool;
+  TrackCounters track_counters;
+  while (state.KeepRunning()) {
+    pool.Release(pool.Create(state.range(0)));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ArenaPool_NoOp)->Range(1, 1024 * 1024);
+
+static void BM_ArenaPool_Batch(benchmark::State& state) {
+  ArenaPool pool;
+  TrackCounters track_counters;
+  while (state.KeepRunning()) {
+    Arena* a = pool.Create(state.range(0));
+    for (int i = 0; i < state.range(1); i++) {
+      a->Alloc(state.range(2));
+    }
+    pool.Release(a);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ArenaPool_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
+
+// Several arenas live at once, as with concurrent calls on a channel.
+static void BM_ArenaPool_Concurrent(benchmark::State& state) {
+  ArenaPool pool;
+  std::vector<Arena*> arenas(state.range(0));
+  TrackCounters track_counters;
+  while (state.KeepRunning()) {
+    for (auto& a : arenas) {
+      a = pool.Create(1024);
+      a->Alloc(256);
+    }
+    for (auto* a : arenas) {
+      pool.Release(a);
+    }
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ArenaPool_Concurrent)->Range(1, 64);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -66,6 +120,7 @@ void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
 }  // namespace benchmark
 
 int main(int argc, char** argv) {
+  LibraryInitializer libInit;
   ::benchmark::Initialize(&argc, argv);
   ::grpc::testing::InitTest(&argc, &argv, false);
   benchmark::RunTheBenchmarksNamespaced();
@@ -19,8 +19,10 @@
 /* This benchmark exists to show that byte-buffer copy is size-independent */
 
 #include <memory>
+#include <string>
 
 #include <benchmark/benchmark.h>
+#include <grpc/slice_buffer.h>
 #include <grpcpp/impl/grpc_library.h>
 #include <grpcpp/support/byte_buffer.h>
 #include "test/cpp/microbenchmarks/helpers.h"
@@ -40,9 +42,11 @@ static void BM_ByteBuffer_Copy(benchmark::State& state) {
     slices.emplace_back(buf.get(), slice_size);
   }
   grpc::ByteBuffer bb(slices.data(), num_slices);
+  TrackCounters track_counters;
   while (state.KeepRunning()) {
     grpc::ByteBuffer cc(bb);
   }
+  track_counters.Finish(state);
 }
 BENCHMARK(BM_ByteBuffer_Copy)->Ranges({{1, 64}, {1, 1024 * 1024}});
 
@@ -60,6 +64,7 @@ static void BM_ByteBufferReader_Next(benchmark::State& state) {
   grpc_byte_buffer_reader reader;
   GPR_ASSERT(
       g_core_codegen_interface->grpc_byte_buffer_reader_init(&reader, bb));
+  TrackCounters track_counters;
   while (state.KeepRunning()) {
     grpc_slice* slice;
     if (GPR_UNLIKELY(!g_core_codegen_interface->grpc_byte_buffer_reader_peek(
@@ -70,6 +75,7 @@ static void BM_ByteBufferReader_Next(benchmark::State& state) {
       continue;
     }
   }
+  track_counters.Finish(state);
 
   g_core_codegen_interface->grpc_byte_buffer_reader_destroy(&reader);
   g_core_codegen_interface->grpc_byte_buffer_destroy(bb);
@@ -93,6 +99,7 @@ static void BM_ByteBufferReader_Peek(benchmark::State& state) {
   grpc_byte_buffer_reader reader;
   GPR_ASSERT(
       g_core_codegen_interface->grpc_byte_buffer_reader_init(&reader, bb));
+  TrackCounters track_counters;
   while (state.KeepRunning()) {
     grpc_slice* slice;
     if (GPR_UNLIKELY(!g_core_codegen_interface->grpc_byte_buffer_reader_peek(
@@ -103,6 +110,7 @@ static void BM_ByteBufferReader_Peek(benchmark::State& state) {
       continue;
     }
   }
+  track_counters.Finish(state);
 
   g_core_codegen_interface->grpc_byte_buffer_reader_destroy(&reader);
   g_core_codegen_interface->grpc_byte_buffer_destroy(bb);
@@ -112,6 +120,89 @@ static void BM_ByteBufferReader_Peek(benchmark::State& state) {
 }
 BENCHMARK(BM_ByteBufferReader_Peek)->Ranges({{64 * 1024, 1024 * 1024}});
 
+// Allocates and frees batches of slices of one size, as a transport does for
+// the messages it reads. Run with GRPC_SLICE_SLAB_ALLOCATOR=true to measure
+// the slab allocator instead of malloc.
+static void BM_SliceMallocUnref(benchmark::State& state) {
+  const size_t slice_size = state.range(0);
+  const int batch = state.range(1);
+  std::vector<grpc_slice> slices(batch);
+  TrackCounters track_counters;
+  while (state.KeepRunning()) {
+    for (auto& slice : slices) {
+      slice = g_core_codegen_interface->grpc_slice_malloc(slice_size);
+    }
+    for (auto& slice : slices) {
+      g_core_codegen_interface->grpc_slice_unref(slice);
+    }
+  }
+  track_counters.Finish(state);
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_SliceMallocUnref)->Ranges({{32, 4096}, {1, 256}});
+
+// Reads a message of state.range(0) slices of 1KB as one contiguous slice,
+// as a handler parsing JSON out of it would: one slice costs no copy
+static void BM_ByteBuffer_DumpToSingleSlice(benchmark::State& state) {
+  std::vector<grpc::Slice> slices;
+  std::string chunk(1024, 'x');
+  for (int64_t i = 0; i < state.range(0); i++) {
+    slices.emplace_back(chunk);
+  }
+  grpc::ByteBuffer bb(slices.data(), slices.size());
+  TrackCounters track_counters;
+  while (state.KeepRunning()) {
+    grpc::Slice slice;
+    GPR_ASSERT(bb.DumpToSingleSlice(&slice).ok());
+  }
+  track_counters.Finish(state);
+  state.SetBytesProcessed(state.iterations() * bb.Length());
+}
+BENCHMARK(BM_ByteBuffer_DumpToSingleSlice)->Range(1, 64);
+
+// Moves the first half of a buffer of state.range(0) slices into another and
+// back, as framing does when it cuts a frame off a write
+static void BM_SliceBufferMoveFirst(benchmark::State& state) {
+  const size_t kSliceSize = 1024;
+  grpc_slice_buffer src;
+  grpc_slice_buffer dst;
+  grpc_slice_buffer_init(&src);
+  grpc_slice_buffer_init(&dst);
+  for (int64_t i = 0; i < state.range(0); i++) {
+    grpc_slice_buffer_add(&src, grpc_slice_malloc(kSliceSize));
+  }
+  const size_t n = src.length / 2 + kSliceSize / 2;
+  TrackCounters track_counters;
+  while (state.KeepRunning()) {
+    grpc_slice_buffer_move_first(&src, n, &dst);
+    grpc_slice_buffer_move_into(&src, &dst);
+    grpc_slice_buffer_swap(&src, &dst);
+  }
+  track_counters.Finish(state);
+  grpc_slice_buffer_destroy(&src);
+  grpc_slice_buffer_destroy(&dst);
+}
+BENCHMARK(BM_SliceBufferMoveFirst)->Range(2, 256);
+
+// Keeps state.range(0) slices queued, adding at the back and taking from the
+// front, as an endpoint's pending writes do
+static void BM_SliceBufferQueue(benchmark::State& state) {
+  grpc_slice slice = grpc_slice_malloc(1024);
+  grpc_slice_buffer buf;
+  grpc_slice_buffer_init(&buf);
+  for (int64_t i = 0; i < state.range(0); i++) {
+    grpc_slice_buffer_add(&buf, grpc_slice_ref(slice));
+  }
+  TrackCounters track_counters;
+  while (state.KeepRunning()) {
+    grpc_slice_buffer_add(&buf, grpc_slice_buffer_take_first(&buf));
+  }
+  track_counters.Finish(state);
+  grpc_slice_buffer_destroy(&buf);
+  grpc_slice_unref(slice);
+}
+BENCHMARK(BM_SliceBufferQueue)->Range(2, 256);
+
 }  // namespace testing
 }  // namespace grpc
 
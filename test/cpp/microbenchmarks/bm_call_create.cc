@@ -22,6 +22,7 @@
 #include <benchmark/benchmark.h>
 #include <string.h>
 #include <sstream>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
@@ -30,6 +31,7 @@
 #include <grpcpp/support/channel_arguments.h>
 
 #include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/service_config.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 #include "src/core/ext/filters/http/client/http_client_filter.h"
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
@@ -39,6 +41,7 @@
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/transport/transport_impl.h"
 
@@ -438,7 +441,7 @@ static const grpc_transport_vtable dummy_transport_vtable = {
     0,          "dummy_http2", InitStream,
     SetPollset, SetPollsetSet, PerformStreamOp,
     PerformOp,  DestroyStream, Destroy,
-    GetEndpoint};
+    GetEndpoint, nullptr};
 
 static grpc_transport dummy_transport = {&dummy_transport_vtable};
 
@@ -601,6 +604,112 @@ BENCHMARK_TEMPLATE(BM_IsolatedFilter, MessageSizeFilter, SendEmptyMetadata);
 // BENCHMARK_TEMPLATE(BM_IsolatedFilter, LoadReportingFilter,
 // SendEmptyMetadata);
 
+// Keeps state.range(0) calls open at once through the client deadline filter,
+// all with the same relative deadline (far enough out never to fire), and
+// closes them again. state.range(1) is the deadline coalescing slack in ms,
+// with 0 arming a timer per call.
+static void BM_DeadlineFilterConcurrentCalls(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t num_calls = static_cast<size_t>(state.range(0));
+  constexpr grpc_millis kDeadline = 10 * 60 * 1000;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_DEADLINE_COALESCING_SLACK_MS),
+      static_cast<int>(state.range(1)));
+  grpc_channel_args channel_args = {1, &arg};
+  const grpc_channel_filter* filters[] = {&grpc_client_deadline_filter,
+                                          &dummy_filter::dummy_filter};
+
+  grpc_core::ExecCtx exec_ctx;
+  grpc_channel_stack* channel_stack = static_cast<grpc_channel_stack*>(
+      gpr_zalloc(grpc_channel_stack_size(filters, GPR_ARRAY_SIZE(filters))));
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "channel_stack_init",
+      grpc_channel_stack_init(1, FilterDestroy, channel_stack, filters,
+                              GPR_ARRAY_SIZE(filters), &channel_args, nullptr,
+                              "CHANNEL", channel_stack)));
+  grpc_core::ExecCtx::Get()->Flush();
+  std::vector<grpc_call_stack*> call_stacks(num_calls);
+  for (auto& call_stack : call_stacks) {
+    call_stack = static_cast<grpc_call_stack*>(
+        gpr_zalloc(channel_stack->call_stack_size));
+  }
+  std::vector<grpc_core::CallCombiner> call_combiners(num_calls);
+  gpr_timespec start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  grpc_slice method = grpc_slice_from_static_string("/foo/bar");
+  grpc_call_final_info final_info;
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    grpc_core::ExecCtx::Get()->InvalidateNow();
+    const grpc_millis deadline = grpc_core::ExecCtx::Get()->Now() + kDeadline;
+    for (size_t i = 0; i < num_calls; i++) {
+      grpc_call_element_args call_args{call_stacks[i],
+                                       nullptr,
+                                       nullptr,
+                                       method,
+                                       start_time,
+                                       deadline,
+                                       nullptr,
+                                       &call_combiners[i]};
+      GRPC_ERROR_UNREF(grpc_call_stack_init(channel_stack, 1, DoNothing,
+                                            nullptr, &call_args));
+    }
+    // Runs the closures that arm the deadlines.
+    grpc_core::ExecCtx::Get()->Flush();
+    for (grpc_call_stack* call_stack : call_stacks) {
+      grpc_call_stack_destroy(call_stack, &final_info, nullptr);
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  grpc_channel_stack_destroy(channel_stack);
+  grpc_core::ExecCtx::Get()->Flush();
+
+  for (grpc_call_stack* call_stack : call_stacks) {
+    gpr_free(call_stack);
+  }
+  state.SetItemsProcessed(state.iterations() * num_calls);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_DeadlineFilterConcurrentCalls)
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->Args({1024, 0})
+    ->Args({1024, 1});
+
+// The call combiner round trip every batch of a call pays: Start() on an idle
+// combiner, then Stop() from the closure with nothing queued behind it.
+// state.range(0) extra closures are queued while the first one holds the
+// combiner, to compare against the contended path.
+static void CallCombinerStop(void* arg, grpc_error* error) {
+  grpc_core::CallCombiner* call_combiner =
+      static_cast<grpc_core::CallCombiner*>(arg);
+  GRPC_CALL_COMBINER_STOP(call_combiner, "benchmark");
+}
+
+static void BM_CallCombinerStartStop(benchmark::State& state) {
+  TrackCounters track_counters;
+  const int num_queued = static_cast<int>(state.range(0));
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::CallCombiner call_combiner;
+  std::vector<grpc_closure> closures(num_queued + 1);
+  for (auto& closure : closures) {
+    GRPC_CLOSURE_INIT(&closure, CallCombinerStop, &call_combiner,
+                      grpc_schedule_on_exec_ctx);
+  }
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    for (auto& closure : closures) {
+      GRPC_CALL_COMBINER_START(&call_combiner, &closure, GRPC_ERROR_NONE,
+                               "benchmark");
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * closures.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_CallCombinerStartStop)->Arg(0)->Arg(1)->Arg(8);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Benchmarks isolating grpc_call
 
@@ -734,6 +843,30 @@ static void BM_IsolatedCall_NoOp(benchmark::State& state) {
 }
 BENCHMARK(BM_IsolatedCall_NoOp);
 
+// Keeps several calls alive at once, so that call creation draws on (and call
+// destruction refills) the channel's pool of recycled call arenas at depth.
+static void BM_IsolatedCall_NoOpBatch(benchmark::State& state) {
+  IsolatedCallFixture fixture;
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  void* method_hdl = grpc_channel_register_call(fixture.channel(), "/foo/bar",
+                                                nullptr, nullptr);
+  std::vector<grpc_call*> calls(state.range(0));
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    for (auto& call : calls) {
+      call = grpc_channel_create_registered_call(
+          fixture.channel(), nullptr, GRPC_PROPAGATE_DEFAULTS, fixture.cq(),
+          method_hdl, deadline, nullptr);
+    }
+    for (auto* call : calls) {
+      grpc_call_unref(call);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  fixture.Finish(state);
+}
+BENCHMARK(BM_IsolatedCall_NoOpBatch)->Range(1, 64);
+
 static void BM_IsolatedCall_Unary(benchmark::State& state) {
   IsolatedCallFixture fixture;
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
@@ -820,6 +953,35 @@ static void BM_IsolatedCall_StreamingSend(benchmark::State& state) {
 }
 BENCHMARK(BM_IsolatedCall_StreamingSend);
 
+// The per-call service config lookup done by the client channel, for a path
+// with a method config of its own (range(0) == 0) or one matching its
+// service's wildcard config (range(0) == 1), and for an interned path, as
+// registered calls have (range(1) == 1), or not.
+static void BM_ServiceConfigMethodLookup(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto service_config = grpc_core::ServiceConfig::Create(
+      "{\"methodConfig\": ["
+      "{\"name\": [{\"service\": \"foo\", \"method\": \"bar\"}], "
+      "\"timeout\": \"1s\"}, "
+      "{\"name\": [{\"service\": \"foo\"}], \"timeout\": \"2s\"}]}",
+      &error);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  grpc_slice path = grpc_slice_from_static_string(
+      state.range(0) == 0 ? "/foo/bar" : "/foo/baz");
+  if (state.range(1) == 1) path = grpc_slice_intern(path);
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    benchmark::DoNotOptimize(
+        service_config->GetMethodParsedConfigVector(path));
+  }
+  grpc_slice_unref_internal(path);
+  service_config.reset();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ServiceConfigMethodLookup)->Ranges({{0, 1}, {0, 1}});
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -62,10 +62,12 @@ static void BM_InsecureChannelCreateDestroy(benchmark::State& state) {
   for (int i = 0; i < state.range(0); i++) {
     initial_channels[i].Init();
   }
+  TrackCounters track_counters;
   while (state.KeepRunning()) {
     Fixture channel;
     channel.Init();
   }
+  track_counters.Finish(state);
 }
 BENCHMARK_TEMPLATE(BM_InsecureChannelCreateDestroy, InsecureChannelFixture)
     ->Range(0, 512);
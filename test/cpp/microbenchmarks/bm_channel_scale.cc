@@ -0,0 +1,207 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark creating and destroying many channels at once */
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include <stdio.h>
+#include <sstream>
+#include <vector>
+
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#ifdef GPR_LINUX
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Nothing listens on these: channels that leave idle resolve, create their
+// subchannels and fail to connect, which is all the setup we want timed.
+const char kTarget[] = "ipv4:127.0.0.1:1";
+
+// Each config creates channels to kTarget with the given service config
+// (none if nullptr). If connect is set, the channel is asked to leave idle,
+// so the resolver, LB policy and subchannels are created too.
+struct ChannelConfig {
+  const char* service_config;
+  bool connect;
+};
+
+struct Idle {
+  static constexpr ChannelConfig config() { return {nullptr, false}; }
+};
+struct PickFirst {
+  static constexpr ChannelConfig config() { return {nullptr, true}; }
+};
+struct RoundRobin {
+  static constexpr ChannelConfig config() {
+    return {"{\"loadBalancingConfig\":[{\"round_robin\":{}}]}", true};
+  }
+};
+struct Grpclb {
+  static constexpr ChannelConfig config() {
+    return {"{\"loadBalancingConfig\":[{\"grpclb\":{}}]}", true};
+  }
+};
+struct Xds {
+  static constexpr ChannelConfig config() {
+    return {"{\"loadBalancingConfig\":[{\"xds_experimental\":"
+            "{\"balancerName\":\"ipv4:127.0.0.1:2\"}}]}",
+            true};
+  }
+};
+
+grpc_channel* CreateChannel(const ChannelConfig& config) {
+  grpc_arg arg;
+  arg.type = GRPC_ARG_STRING;
+  arg.key = const_cast<char*>(GRPC_ARG_SERVICE_CONFIG);
+  arg.value.string = const_cast<char*>(config.service_config);
+  grpc_channel_args args = {config.service_config != nullptr ? 1u : 0u, &arg};
+  grpc_channel* channel = grpc_insecure_channel_create(kTarget, &args, nullptr);
+  if (config.connect) {
+    grpc_channel_check_connectivity_state(channel, 1);
+  }
+  return channel;
+}
+
+#ifdef GPR_LINUX
+// Resident set size of this process, in bytes
+long ResidentBytes() {
+  FILE* f = fopen("/proc/self/statm", "r");
+  if (f == nullptr) return 0;
+  long total = 0;
+  long resident = 0;
+  if (fscanf(f, "%ld %ld", &total, &resident) != 2) resident = 0;
+  fclose(f);
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+long ThreadCount() {
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr) return 0;
+  long threads = 0;
+  while (struct dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') threads++;
+  }
+  closedir(dir);
+  return threads;
+}
+#else
+long ResidentBytes() { return 0; }
+long ThreadCount() { return 0; }
+#endif
+
+}  // namespace
+
+// Every thread creates state.range(0) channels and then destroys them, so
+// state.threads * state.range(0) channels are alive at the peak. Items are
+// channels, so the reported rate is per created-and-destroyed channel.
+template <class Config>
+static void BM_ChannelCreateDestroyMany(benchmark::State& state) {
+  TrackCounters track_counters;
+  const ChannelConfig config = Config::config();
+  std::vector<grpc_channel*> channels(state.range(0));
+  while (state.KeepRunning()) {
+    for (grpc_channel*& channel : channels) {
+      channel = CreateChannel(config);
+    }
+    for (grpc_channel* channel : channels) {
+      grpc_channel_destroy(channel);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+static void SweepChannelCreateDestroyMany(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(8)->Range(1, 512)->ThreadRange(1, 8)->UseRealTime();
+}
+BENCHMARK_TEMPLATE(BM_ChannelCreateDestroyMany, Idle)
+    ->Apply(SweepChannelCreateDestroyMany);
+BENCHMARK_TEMPLATE(BM_ChannelCreateDestroyMany, PickFirst)
+    ->Apply(SweepChannelCreateDestroyMany);
+BENCHMARK_TEMPLATE(BM_ChannelCreateDestroyMany, RoundRobin)
+    ->Apply(SweepChannelCreateDestroyMany);
+BENCHMARK_TEMPLATE(BM_ChannelCreateDestroyMany, Grpclb)
+    ->Apply(SweepChannelCreateDestroyMany);
+BENCHMARK_TEMPLATE(BM_ChannelCreateDestroyMany, Xds)
+    ->Apply(SweepChannelCreateDestroyMany);
+
+// Holds state.range(0) channels open at once and reports what they cost
+// while alive: resident memory per channel and threads the process started
+// for them. Only their creation is timed; the footprint is sampled (on Linux
+// only) after the last one is created and before any is destroyed.
+template <class Config>
+static void BM_ChannelFootprint(benchmark::State& state) {
+  TrackCounters track_counters;
+  const ChannelConfig config = Config::config();
+  std::vector<grpc_channel*> channels(state.range(0));
+  long rss_delta = 0;
+  long threads_delta = 0;
+  while (state.KeepRunning()) {
+    const long rss_before = ResidentBytes();
+    const long threads_before = ThreadCount();
+    for (grpc_channel*& channel : channels) {
+      channel = CreateChannel(config);
+    }
+    state.PauseTiming();
+    rss_delta += ResidentBytes() - rss_before;
+    threads_delta += ThreadCount() - threads_before;
+    for (grpc_channel* channel : channels) {
+      grpc_channel_destroy(channel);
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  std::ostringstream label;
+  label << "rss_per_channel:"
+        << static_cast<double>(rss_delta) /
+               static_cast<double>(state.iterations() * state.range(0))
+        << " threads_created/iter:"
+        << static_cast<double>(threads_delta) /
+               static_cast<double>(state.iterations());
+  track_counters.AddLabel(label.str());
+  track_counters.Finish(state);
+}
+static void SweepChannelFootprint(benchmark::internal::Benchmark* b) {
+  b->Arg(1000)->Arg(10000);
+}
+BENCHMARK_TEMPLATE(BM_ChannelFootprint, Idle)->Apply(SweepChannelFootprint);
+BENCHMARK_TEMPLATE(BM_ChannelFootprint, PickFirst)
+    ->Apply(SweepChannelFootprint);
+BENCHMARK_TEMPLATE(BM_ChannelFootprint, Grpclb)->Apply(SweepChannelFootprint);
+BENCHMARK_TEMPLATE(BM_ChannelFootprint, Xds)->Apply(SweepChannelFootprint);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
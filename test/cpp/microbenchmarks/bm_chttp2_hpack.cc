@@ -21,13 +21,17 @@
 #include <benchmark/benchmark.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <stdio.h>
 #include <string.h>
 #include <memory>
 #include <sstream>
 
+#include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/incoming_metadata.h"
+#include "src/core/lib/slice/percent_encoding.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/static_metadata.h"
@@ -335,6 +339,18 @@ class RepresentativeServerTrailingMetadata {
   }
 };
 
+// The whole of representative_server_trailing_metadata.headers: once both
+// elements are in the table every further encode is spliced from the
+// compressor's cached blocks
+class RepresentativeServerTrailingMetadataWithMessage {
+ public:
+  static constexpr bool kEnableTrueBinary = true;
+  static std::vector<grpc_mdelem> GetElems() {
+    return {GRPC_MDELEM_GRPC_STATUS_0,
+            grpc_mdelem_from_slices(GRPC_MDSTR_GRPC_MESSAGE, GRPC_MDSTR_EMPTY)};
+  }
+};
+
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, EmptyBatch)->Args({0, 16384});
 // test with eof (shouldn't affect anything)
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, EmptyBatch)->Args({1, 16384});
@@ -406,6 +422,9 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    SingleNonInternedBinaryElem<100, true>)
     ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
+                   SingleNonInternedBinaryElem<1024, false>)
+    ->Args({0, 16384});
 // test with a tiny frame size, to highlight continuation costs
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleNonInternedElem)
     ->Args({0, 1});
@@ -422,9 +441,192 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    RepresentativeServerTrailingMetadata)
     ->Args({1, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
+                   RepresentativeServerTrailingMetadataWithMessage)
+    ->Args({1, 16384});
 
 }  // namespace hpack_encoder_fixtures
 
+// Encodes Fixture's elements plus a header whose value differs on every call,
+// as a request id would. Such headers should cost their literal bytes without
+// pushing Fixture's elements out of the table.
+template <class Fixture>
+static void BM_HpackEncoderEncodeHeaderWithUniqueValue(
+    benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+
+  std::vector<grpc_mdelem> elems = Fixture::GetElems();
+  std::vector<grpc_linked_mdelem> storage(elems.size() + 1);
+  const grpc_slice unique_key =
+      grpc_slice_intern(grpc_slice_from_static_string("x-request-id"));
+
+  std::unique_ptr<grpc_chttp2_hpack_compressor> c(
+      new grpc_chttp2_hpack_compressor);
+  grpc_chttp2_hpack_compressor_init(c.get());
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_slice_buffer outbuf;
+  grpc_slice_buffer_init(&outbuf);
+  while (state.KeepRunning()) {
+    grpc_metadata_batch b;
+    grpc_metadata_batch_init(&b);
+    for (size_t i = 0; i < elems.size(); i++) {
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "addmd", grpc_metadata_batch_add_tail(&b, &storage[i],
+                                                GRPC_MDELEM_REF(elems[i]))));
+    }
+    char value[32];
+    snprintf(value, sizeof(value), "%016" PRIx64,
+             static_cast<uint64_t>(state.iterations()));
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "addmd", grpc_metadata_batch_add_tail(
+                     &b, &storage[elems.size()],
+                     grpc_mdelem_from_slices(
+                         unique_key, grpc_slice_from_copied_string(value)))));
+    grpc_encode_header_options hopt = {
+        static_cast<uint32_t>(state.iterations()),
+        false,
+        Fixture::kEnableTrueBinary,
+        16384,
+        &stats,
+    };
+    grpc_chttp2_encode_header(c.get(), nullptr, 0, &b, &hopt, &outbuf);
+    grpc_metadata_batch_destroy(&b);
+    grpc_slice_buffer_reset_and_unref_internal(&outbuf);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  for (size_t i = 0; i < elems.size(); i++) {
+    GRPC_MDELEM_UNREF(elems[i]);
+  }
+  grpc_slice_unref_internal(unique_key);
+  grpc_chttp2_hpack_compressor_destroy(c.get());
+  grpc_slice_buffer_destroy_internal(&outbuf);
+
+  std::ostringstream label;
+  label << "framing_bytes/iter:"
+        << (static_cast<double>(stats.framing_bytes) /
+            static_cast<double>(state.iterations()))
+        << " header_bytes/iter:"
+        << (static_cast<double>(stats.header_bytes) /
+            static_cast<double>(state.iterations()));
+  track_counters.AddLabel(label.str());
+  track_counters.Finish(state);
+}
+BENCHMARK_TEMPLATE(
+    BM_HpackEncoderEncodeHeaderWithUniqueValue,
+    hpack_encoder_fixtures::MoreRepresentativeClientInitialMetadata);
+
+////////////////////////////////////////////////////////////////////////////////
+// HPACK string encoding
+//
+
+static grpc_slice MakeRandomSlice(size_t length) {
+  std::vector<uint8_t> bytes;
+  bytes.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    bytes.push_back(static_cast<uint8_t>(rand()));
+  }
+  return MakeSlice(bytes);
+}
+
+// Printable bytes, as found in auth tokens and trace context headers
+static grpc_slice MakeTokenSlice(size_t length) {
+  static const char kTokenChars[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~";
+  std::vector<uint8_t> bytes;
+  bytes.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    bytes.push_back(static_cast<uint8_t>(
+        kTokenChars[rand() % (sizeof(kTokenChars) - 1)]));
+  }
+  return MakeSlice(bytes);
+}
+
+static void BM_HpackHuffmanCompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice input = MakeTokenSlice(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_chttp2_huffman_compress(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_HpackHuffmanCompress)->Arg(8)->Arg(64)->Arg(512)->Arg(4096);
+
+static void BM_HpackBase64EncodeAndHuffmanCompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice input = MakeRandomSlice(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_chttp2_base64_encode_and_huffman_compress(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_HpackBase64EncodeAndHuffmanCompress)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(512)
+    ->Arg(4096);
+
+static void BM_Base64Encode(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice input = MakeRandomSlice(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_chttp2_base64_encode(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64Encode)->Arg(8)->Arg(64)->Arg(512)->Arg(4096);
+
+static void BM_Base64Decode(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice raw = MakeRandomSlice(state.range(0));
+  grpc_slice input = grpc_chttp2_base64_encode(raw);
+  grpc_slice_unref(raw);
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_chttp2_base64_decode(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64Decode)->Arg(8)->Arg(64)->Arg(512)->Arg(4096);
+
+// grpc-message values are percent-encoded with the compatible set; printable
+// messages need no encoding at all, which is the common case
+static void BM_PercentEncodeMessage(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice input = MakeTokenSlice(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_percent_encode_slice(
+        input, grpc_compatible_percent_encoding_unreserved_bytes));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_PercentEncodeMessage)->Arg(8)->Arg(64)->Arg(512)->Arg(4096);
+
+static void BM_PercentDecodeMessage(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice input = MakeTokenSlice(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_slice output;
+    GPR_ASSERT(grpc_strict_percent_decode_slice(
+        input, grpc_compatible_percent_encoding_unreserved_bytes, &output));
+    grpc_slice_unref(output);
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_PercentDecodeMessage)->Arg(8)->Arg(64)->Arg(512)->Arg(4096);
+
 ////////////////////////////////////////////////////////////////////////////////
 // HPACK parser
 //
@@ -479,6 +681,10 @@ static void BM_HpackParserParseHeader(benchmark::State& state) {
       p.on_header_user_data = grpc_core::Arena::Create(kArenaSize);
     }
   }
+  // Memory the connection's dynamic table holds onto
+  std::ostringstream label;
+  label << "table_bytes:" << p.table.cap_entries * sizeof(*p.table.ents);
+  track_counters.AddLabel(label.str());
   // Clean up
   static_cast<grpc_core::Arena*>(p.on_header_user_data)->Destroy();
   for (auto slice : init_slices) grpc_slice_unref(slice);
@@ -557,6 +763,31 @@ class KeyIndexedSingleInternedElem {
   }
 };
 
+// Fills the table with kCount entries, then references every one of them
+template <int kCount>
+class IndexedManyInternedElems {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() {
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < kCount; i++) {
+      const uint8_t hi = static_cast<uint8_t>('a' + i / 26);
+      const uint8_t lo = static_cast<uint8_t>('a' + i % 26);
+      bytes.insert(bytes.end(), {0x40, 0x03, 'k', hi, lo, 0x01, 'v'});
+    }
+    return {MakeSlice(bytes)};
+  }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    static_assert(GRPC_CHTTP2_LAST_STATIC_ENTRY + kCount < 127,
+                  "indices must fit in one byte");
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < kCount; i++) {
+      bytes.push_back(
+          static_cast<uint8_t>(0x80 | (GRPC_CHTTP2_LAST_STATIC_ENTRY + 1 + i)));
+    }
+    return {MakeSlice(bytes)};
+  }
+};
+
 class NonIndexedElem {
  public:
   static std::vector<grpc_slice> GetInitSlices() { return {}; }
@@ -778,6 +1009,45 @@ class RepresentativeServerTrailingMetadata {
   }
 };
 
+// The same headers as RepresentativeServerInitialMetadata and
+// RepresentativeClientInitialMetadata, but sent as huffman encoded literals
+// without indexing (as peers that don't index huffman compress everything), so
+// that every iteration exercises huffman decoding.
+class HuffmanRepresentativeServerInitialMetadata {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    return {MakeSlice(
+        {0x00, 0x85, 0xb8, 0x84, 0x8d, 0x36, 0xa3, 0x82, 0x10, 0x01, 0x00, 0x89,
+         0x21, 0xea, 0x49, 0x6a, 0x4a, 0xc9, 0xf5, 0x59, 0x7f, 0x8b, 0x1d, 0x75,
+         0xd0, 0x62, 0x0d, 0x26, 0x3d, 0x4c, 0x4d, 0x65, 0x64, 0x00, 0x8e, 0x9a,
+         0xca, 0xc8, 0xb0, 0xc8, 0x42, 0xd6, 0x95, 0x8b, 0x51, 0x0f, 0x21, 0xaa,
+         0x9b, 0x90, 0x34, 0x85, 0xa9, 0x26, 0x4f, 0xaf, 0xa9, 0x0b, 0x2d, 0x03,
+         0x49, 0x7e, 0xa6, 0xf6, 0x6a, 0xff})};
+  }
+};
+
+class HuffmanRepresentativeClientInitialMetadata {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    return {MakeSlice(
+        {0x00, 0x84, 0xb9, 0x58, 0xd3, 0x3f, 0x86, 0x62, 0x53, 0x9d, 0x88, 0xc7,
+         0x67, 0x00, 0x85, 0xb8, 0x82, 0x4e, 0x5a, 0x4b, 0x83, 0x9d, 0x29, 0xaf,
+         0x00, 0x85, 0xb9, 0x49, 0x53, 0x39, 0xe4, 0x84, 0xd7, 0xab, 0x76, 0xff,
+         0x00, 0x88, 0xb8, 0x3b, 0x53, 0x39, 0xec, 0x32, 0x7d, 0x7f, 0x86, 0xa0,
+         0xe4, 0x1d, 0x13, 0x9d, 0x09, 0x00, 0x89, 0x21, 0xea, 0x49, 0x6a, 0x4a,
+         0xc9, 0xf5, 0x59, 0x7f, 0x8b, 0x1d, 0x75, 0xd0, 0x62, 0x0d, 0x26, 0x3d,
+         0x4c, 0x4d, 0x65, 0x64, 0x00, 0x8e, 0x9a, 0xca, 0xc8, 0xb0, 0xc8, 0x42,
+         0xd6, 0x95, 0x8b, 0x51, 0x0f, 0x21, 0xaa, 0x9b, 0x90, 0x34, 0x85, 0xa9,
+         0x26, 0x4f, 0xaf, 0xa9, 0x0b, 0x2d, 0x03, 0x49, 0x7e, 0xa6, 0xf6, 0x6a,
+         0xff, 0x00, 0x82, 0x49, 0x7f, 0x86, 0x4d, 0x83, 0x35, 0x05, 0xb1, 0x1f,
+         0x00, 0x87, 0xb5, 0x05, 0xb1, 0x61, 0xcc, 0x5a, 0x93, 0x99, 0x8c, 0x72,
+         0x2c, 0x4a, 0x0c, 0x5a, 0x92, 0xa4, 0xd6, 0x56, 0x45, 0x88, 0xc0, 0x17,
+         0x08, 0x97, 0x02, 0xe0, 0x53, 0xfa, 0xa0, 0xd5, 0x5b, 0xe7, 0xfb})};
+  }
+};
+
 static void free_timeout(void* p) { gpr_free(p); }
 
 // Benchmark the current on_initial_header implementation
@@ -887,6 +1157,10 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, AddIndexedSingleInternedElem,
                    UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, KeyIndexedSingleInternedElem,
                    UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, IndexedManyInternedElems<4>,
+                   UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, IndexedManyInternedElems<64>,
+                   UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedElem, UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<1, false>,
                    UnrefHeader);
@@ -916,6 +1190,10 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeServerInitialMetadata, UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeServerTrailingMetadata, UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
+                   HuffmanRepresentativeClientInitialMetadata, UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
+                   HuffmanRepresentativeServerInitialMetadata, UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeClientInitialMetadata, OnInitialHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
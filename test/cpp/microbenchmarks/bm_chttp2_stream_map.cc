@@ -0,0 +1,124 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks around the chttp2 stream map under stream churn. The
+   implementation is chosen at build time: build with
+   -DGRPC_CHTTP2_HASH_STREAM_MAP to measure the hash table instead of the
+   sorted array, and compare the two runs. */
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <random>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+static void* StreamValue(uint32_t id) {
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(id));
+}
+
+// Populates map with n client streams (odd ids, like a server sees), returning
+// the live ids and the next id to use.
+static uint32_t FillStreamMap(grpc_chttp2_stream_map* map, size_t n,
+                              std::vector<uint32_t>* live) {
+  uint32_t next_id = 1;
+  for (size_t i = 0; i < n; i++) {
+    grpc_chttp2_stream_map_add(map, next_id, StreamValue(next_id));
+    live->push_back(next_id);
+    next_id += 2;
+  }
+  return next_id;
+}
+
+// Each iteration closes a random live stream, opens a new one and looks up a
+// few others: the pattern of a long-lived connection with many concurrent
+// streams of varied lifetimes.
+static void BM_StreamMapChurn(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t n = static_cast<size_t>(state.range(0));
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  std::vector<uint32_t> live;
+  uint32_t next_id = FillStreamMap(&map, n, &live);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> pick(0, n - 1);
+  while (state.KeepRunning()) {
+    size_t victim = pick(rng);
+    GPR_ASSERT(grpc_chttp2_stream_map_delete(&map, live[victim]) != nullptr);
+    grpc_chttp2_stream_map_add(&map, next_id, StreamValue(next_id));
+    live[victim] = next_id;
+    next_id += 2;
+    for (int i = 0; i < 4; i++) {
+      benchmark::DoNotOptimize(
+          grpc_chttp2_stream_map_find(&map, live[pick(rng)]));
+    }
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapChurn)->Range(16, 16384);
+
+// Lookups only, on a map that has seen churn (so the sorted array has holes
+// and the hash table has tombstones).
+static void BM_StreamMapFind(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t n = static_cast<size_t>(state.range(0));
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  std::vector<uint32_t> live;
+  uint32_t next_id = FillStreamMap(&map, n, &live);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> pick(0, n - 1);
+  for (size_t i = 0; i < n; i++) {
+    size_t victim = pick(rng);
+    grpc_chttp2_stream_map_delete(&map, live[victim]);
+    grpc_chttp2_stream_map_add(&map, next_id, StreamValue(next_id));
+    live[victim] = next_id;
+    next_id += 2;
+  }
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_find(&map, live[pick(rng)]));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapFind)->Range(16, 16384);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
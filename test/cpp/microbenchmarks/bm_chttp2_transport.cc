@@ -53,7 +53,9 @@ class DummyEndpoint : public grpc_endpoint {
                                                    get_resource_user,
                                                    get_peer,
                                                    get_fd,
-                                                   can_track_err};
+                                                   can_track_err,
+                                                   set_read_hint,
+                                                   set_write_hint};
     grpc_endpoint::vtable = &my_vtable;
     ru_ = grpc_resource_user_create(LibraryInitializer::get().rq(),
                                     "dummy_endpoint");
@@ -124,6 +126,8 @@ class DummyEndpoint : public grpc_endpoint {
   static char* get_peer(grpc_endpoint* ep) { return gpr_strdup("test"); }
   static int get_fd(grpc_endpoint* ep) { return 0; }
   static bool can_track_err(grpc_endpoint* ep) { return false; }
+  static void set_read_hint(grpc_endpoint* ep, size_t bytes) {}
+  static void set_write_hint(grpc_endpoint* ep, bool more_writes_follow) {}
 };
 
 class Fixture {
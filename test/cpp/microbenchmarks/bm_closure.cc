@@ -20,7 +20,10 @@
 
 #include <benchmark/benchmark.h>
 #include <grpc/grpc.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd_id.h>
 #include <sstream>
+#include <vector>
 
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/iomgr/closure.h"
@@ -351,6 +354,82 @@ static void BM_ClosureSched4OnTwoCombiners(benchmark::State& state) {
 }
 BENCHMARK(BM_ClosureSched4OnTwoCombiners);
 
+// Closure run on a contended combiner: remembers which thread it ran on and
+// signals the benchmark thread once the last closure of a batch has run
+struct ContendedClosure {
+  grpc_closure closure;
+  gpr_thd_id benchmark_thread;
+  gpr_atm* offloaded;
+  gpr_event* done;
+
+  static void Run(void* arg, grpc_error* error) {
+    ContendedClosure* self = static_cast<ContendedClosure*>(arg);
+    if (gpr_thd_currentid() != self->benchmark_thread) {
+      gpr_atm_no_barrier_fetch_add(self->offloaded, 1);
+    }
+    if (self->done != nullptr) {
+      gpr_event_set(self->done, reinterpret_cast<void*>(1));
+    }
+  }
+};
+
+// Schedules state.range(0) closures on a combiner that looks contended to an
+// exec_ctx that is ready to finish, with an offload budget of state.range(1)
+// closures: reports how many of the closures were handed off to the executor
+// and the latency of running the batch.
+static void BM_ClosureSchedOnContendedCombiner(benchmark::State& state) {
+  TrackCounters track_counters;
+  const int num_closures = static_cast<int>(state.range(0));
+  grpc_combiner_set_offload_budget(static_cast<size_t>(state.range(1)), 0);
+  grpc_combiner* combiner = grpc_combiner_create();
+  std::vector<ContendedClosure> closures(num_closures);
+  gpr_atm offloaded = 0;
+  for (auto& c : closures) {
+    GRPC_CLOSURE_INIT(&c.closure, ContendedClosure::Run, &c,
+                      grpc_combiner_scheduler(combiner));
+    c.benchmark_thread = gpr_thd_currentid();
+    c.offloaded = &offloaded;
+    c.done = nullptr;
+  }
+  while (state.KeepRunning()) {
+    gpr_event done;
+    gpr_event_init(&done);
+    closures.back().done = &done;
+    {
+      grpc_core::ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_FINISHED);
+      GRPC_CLOSURE_SCHED(&closures[0].closure, GRPC_ERROR_NONE);
+      {
+        // queueing from a second exec_ctx marks the combiner as contended
+        grpc_core::ExecCtx other_exec_ctx;
+        for (int i = 1; i < num_closures; i++) {
+          GRPC_CLOSURE_SCHED(&closures[i].closure, GRPC_ERROR_NONE);
+        }
+      }
+    }
+    GPR_ASSERT(gpr_event_wait(&done, gpr_inf_future(GPR_CLOCK_REALTIME)));
+  }
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GRPC_COMBINER_UNREF(combiner, "finished");
+  }
+  grpc_combiner_set_offload_budget(0, 0);
+
+  std::ostringstream label;
+  label << "offloaded_closures/iter:"
+        << static_cast<double>(gpr_atm_no_barrier_load(&offloaded)) /
+               static_cast<double>(state.iterations());
+  track_counters.AddLabel(label.str());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ClosureSchedOnContendedCombiner)
+    ->Args({2, 0})
+    ->Args({16, 0})
+    ->Args({16, 4})
+    ->Args({16, 16})
+    ->Args({128, 0})
+    ->Args({128, 16})
+    ->Args({128, 128});
+
 // Helper that continuously reschedules the same closure against something until
 // the benchmark is complete
 class Rescheduler {
@@ -62,6 +62,17 @@ static void BM_ErrorCreateAndSetStatus(benchmark::State& state) {
 }
 BENCHMARK(BM_ErrorCreateAndSetStatus);
 
+static void BM_ErrorCreateImmortal(benchmark::State& state) {
+  TrackCounters track_counters;
+  while (state.KeepRunning()) {
+    GRPC_ERROR_UNREF(GRPC_ERROR_IMMORTAL(
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Error"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_ABORTED)));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ErrorCreateImmortal);
+
 static void BM_ErrorCreateAndSetIntAndStr(benchmark::State& state) {
   TrackCounters track_counters;
   while (state.KeepRunning()) {
@@ -111,6 +122,17 @@ static void BM_ErrorRefUnref(benchmark::State& state) {
 }
 BENCHMARK(BM_ErrorRefUnref);
 
+static void BM_ErrorRefUnrefImmortal(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_error* error =
+      GRPC_ERROR_IMMORTAL(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Error"));
+  while (state.KeepRunning()) {
+    GRPC_ERROR_UNREF(GRPC_ERROR_REF(error));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ErrorRefUnrefImmortal);
+
 static void BM_ErrorUnrefNone(benchmark::State& state) {
   TrackCounters track_counters;
   while (state.KeepRunning()) {
@@ -194,6 +216,18 @@ class ErrorWithGrpcStatus {
       GRPC_STATUS_UNIMPLEMENTED)};
 };
 
+class ImmortalErrorWithGrpcStatus {
+ public:
+  grpc_millis deadline() const { return deadline_; }
+  grpc_error* error() const { return error_.get(); }
+
+ private:
+  const grpc_millis deadline_ = GRPC_MILLIS_INF_FUTURE;
+  ErrorPtr error_{GRPC_ERROR_IMMORTAL(grpc_error_set_int(
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Error"), GRPC_ERROR_INT_GRPC_STATUS,
+      GRPC_STATUS_UNIMPLEMENTED))};
+};
+
 class ErrorWithHttpError {
  public:
   grpc_millis deadline() const { return deadline_; }
@@ -306,6 +340,7 @@ BENCHMARK_SUITE(ErrorNone);
 BENCHMARK_SUITE(ErrorCancelled);
 BENCHMARK_SUITE(SimpleError);
 BENCHMARK_SUITE(ErrorWithGrpcStatus);
+BENCHMARK_SUITE(ImmortalErrorWithGrpcStatus);
 BENCHMARK_SUITE(ErrorWithHttpError);
 BENCHMARK_SUITE(ErrorWithNestedGrpcStatus);
 
@@ -0,0 +1,128 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks of the immutable maps: grpc_flat_map against grpc_avl,
+   looking keys up and adding them, for maps of various sizes. Keys and
+   values are plain integers, so only the maps themselves are measured. */
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/avl/avl.h"
+#include "src/core/lib/avl/flat_map.h"
+
+namespace grpc {
+namespace testing {
+
+static void NoopDestroy(void* p, void* user_data) {}
+static void* NoopCopy(void* p, void* user_data) { return p; }
+static long IntCompare(void* a, void* b, void* user_data) {
+  intptr_t x = reinterpret_cast<intptr_t>(a);
+  intptr_t y = reinterpret_cast<intptr_t>(b);
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+static const grpc_avl_vtable kIntVtable = {NoopDestroy, NoopCopy, IntCompare,
+                                           NoopDestroy, NoopCopy};
+
+static void* Key(int64_t i) { return reinterpret_cast<void*>(i * 2 + 1); }
+
+static void BM_AvlGet(benchmark::State& state) {
+  const int64_t size = state.range(0);
+  grpc_avl avl = grpc_avl_create(&kIntVtable);
+  for (int64_t i = 0; i < size; ++i) {
+    avl = grpc_avl_add(avl, Key(i), Key(i), nullptr);
+  }
+  int64_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(grpc_avl_get(avl, Key(i), nullptr));
+    if (++i == size) i = 0;
+  }
+  grpc_avl_unref(avl, nullptr);
+}
+BENCHMARK(BM_AvlGet)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_FlatMapGet(benchmark::State& state) {
+  const int64_t size = state.range(0);
+  grpc_flat_map map = grpc_flat_map_create(&kIntVtable);
+  for (int64_t i = 0; i < size; ++i) {
+    map = grpc_flat_map_add(map, Key(i), Key(i), nullptr);
+  }
+  int64_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(grpc_flat_map_get(map, Key(i), nullptr));
+    if (++i == size) i = 0;
+  }
+  grpc_flat_map_unref(map, nullptr);
+}
+BENCHMARK(BM_FlatMapGet)->RangeMultiplier(4)->Range(16, 4096);
+
+/* Adding to a shared map and dropping the result, as the copy-on-write
+   updates of the subchannel pool do. */
+static void BM_AvlAdd(benchmark::State& state) {
+  const int64_t size = state.range(0);
+  grpc_avl avl = grpc_avl_create(&kIntVtable);
+  for (int64_t i = 0; i < size; ++i) {
+    avl = grpc_avl_add(avl, Key(i), Key(i), nullptr);
+  }
+  int64_t i = 0;
+  while (state.KeepRunning()) {
+    grpc_avl new_avl = grpc_avl_add(grpc_avl_ref(avl, nullptr), Key(-1 - i),
+                                    Key(i), nullptr);
+    grpc_avl_unref(new_avl, nullptr);
+    if (++i == size) i = 0;
+  }
+  grpc_avl_unref(avl, nullptr);
+}
+BENCHMARK(BM_AvlAdd)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_FlatMapAdd(benchmark::State& state) {
+  const int64_t size = state.range(0);
+  grpc_flat_map map = grpc_flat_map_create(&kIntVtable);
+  for (int64_t i = 0; i < size; ++i) {
+    map = grpc_flat_map_add(map, Key(i), Key(i), nullptr);
+  }
+  int64_t i = 0;
+  while (state.KeepRunning()) {
+    grpc_flat_map new_map = grpc_flat_map_add(
+        grpc_flat_map_ref(map, nullptr), Key(-1 - i), Key(i), nullptr);
+    grpc_flat_map_unref(new_map, nullptr);
+    if (++i == size) i = 0;
+  }
+  grpc_flat_map_unref(map, nullptr);
+}
+BENCHMARK(BM_FlatMapAdd)->RangeMultiplier(4)->Range(16, 4096);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc_init();
+  ::benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
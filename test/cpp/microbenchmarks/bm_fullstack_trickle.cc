@@ -76,13 +76,26 @@ static void write_csv(std::ostream* out, A0&& a0, Arg&&... arg) {
   write_csv(out, std::forward<Arg>(arg)...);
 }
 
+class DeliveryRateEstimationConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_HTTP2_BDP_DELIVERY_RATE_ESTIMATION, 1);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_HTTP2_BDP_DELIVERY_RATE_ESTIMATION, 1);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
 class TrickledCHTTP2 : public EndpointPairFixture {
  public:
   TrickledCHTTP2(Service* service, bool streaming, size_t req_size,
                  size_t resp_size, size_t kilobits_per_second,
-                 grpc_passthru_endpoint_stats* stats)
+                 grpc_passthru_endpoint_stats* stats,
+                 const FixtureConfiguration& config = FixtureConfiguration())
       : EndpointPairFixture(service, MakeEndpoints(kilobits_per_second, stats),
-                            FixtureConfiguration()),
+                            config),
         stats_(stats) {
     if (FLAGS_log) {
       std::ostringstream fn;
@@ -253,12 +266,13 @@ static void TrickleCQNext(TrickledCHTTP2* fixture, void** t, bool* ok,
   }
 }
 
-static void BM_PumpStreamServerToClient_Trickle(benchmark::State& state) {
+static void PumpStreamServerToClient_Trickle(
+    benchmark::State& state, const FixtureConfiguration& config) {
   EchoTestService::AsyncService service;
   std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
       &service, true, state.range(0) /* req_size */,
       state.range(0) /* resp_size */, state.range(1) /* bw in kbit/s */,
-      grpc_passthru_endpoint_stats_create()));
+      grpc_passthru_endpoint_stats_create(), config));
   {
     EchoResponse send_response;
     EchoResponse recv_response;
@@ -345,8 +359,22 @@ static void StreamingTrickleArgs(benchmark::internal::Benchmark* b) {
     }
   }
 }
+
+static void BM_PumpStreamServerToClient_Trickle(benchmark::State& state) {
+  PumpStreamServerToClient_Trickle(state, FixtureConfiguration());
+}
 BENCHMARK(BM_PumpStreamServerToClient_Trickle)->Apply(StreamingTrickleArgs);
 
+// As above, with the bdp estimated from delivery rate and round trip time
+// samples (GRPC_ARG_HTTP2_BDP_DELIVERY_RATE_ESTIMATION).
+static void BM_PumpStreamServerToClient_TrickleDeliveryRate(
+    benchmark::State& state) {
+  PumpStreamServerToClient_Trickle(state,
+                                   DeliveryRateEstimationConfiguration());
+}
+BENCHMARK(BM_PumpStreamServerToClient_TrickleDeliveryRate)
+    ->Apply(StreamingTrickleArgs);
+
 static void BM_PumpUnbalancedUnary_Trickle(benchmark::State& state) {
   EchoTestService::AsyncService service;
   std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
@@ -44,9 +44,19 @@ BENCHMARK_TEMPLATE(BM_UnaryPingPong, TCP, NoOpMutator, NoOpMutator)
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinTCP, NoOpMutator, NoOpMutator)
     ->Apply(SweepSizesArgs);
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, UDS, NoOpMutator, NoOpMutator)
-    ->Args({0, 0});
+    ->Apply(SweepSizesArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, LargeBufferUDS, NoOpMutator, NoOpMutator)
+    ->Apply(SweepSizesArgs);
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinUDS, NoOpMutator, NoOpMutator)
     ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, DirectUDS, NoOpMutator, NoOpMutator)
+    ->Args({0, 0});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, BusyPollTCP, NoOpMutator, NoOpMutator)
+    ->Args({0, 0})
+    ->Args({1024, 1024});
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, BusyPollUDS, NoOpMutator, NoOpMutator)
+    ->Args({0, 0})
+    ->Args({1024, 1024});
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcess, NoOpMutator, NoOpMutator)
     ->Apply(SweepSizesArgs);
 BENCHMARK_TEMPLATE(BM_UnaryPingPong, MinInProcess, NoOpMutator, NoOpMutator)
@@ -161,6 +171,25 @@ BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcess, NoOpMutator,
                    Server_AddInitialMetadata<RandomAsciiMetadata<10>, 100>)
     ->Args({0, 0});
 
+static void ConcurrencyArgs(benchmark::internal::Benchmark* b) {
+  for (int i = 1; i <= 256; i *= 4) {
+    b->Args({0, 0, i});
+    b->Args({1024, 1024, i});
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_UnaryPingPongConcurrent, TCP, NoOpMutator, NoOpMutator)
+    ->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPongConcurrent, CoalescingTCP, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPongConcurrent, InProcessCHTTP2, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPongConcurrent, CoalescingInProcessCHTTP2,
+                   NoOpMutator, NoOpMutator)
+    ->Apply(ConcurrencyArgs);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,59 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the cost of bringing the library up and down */
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+
+#include "test/cpp/util/test_config.h"
+
+// Neither benchmark holds a LibraryInitializer: every iteration pays for a
+// full grpc_init()/grpc_shutdown_blocking() cycle.
+
+static void BM_InitShutdown(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    grpc_init();
+    grpc_shutdown_blocking();
+  }
+}
+BENCHMARK(BM_InitShutdown);
+
+static void BM_InitCreateChannelShutdown(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    grpc_init();
+    grpc_channel* channel =
+        grpc_insecure_channel_create("localhost:1234", nullptr, nullptr);
+    grpc_channel_destroy(channel);
+    grpc_shutdown_blocking();
+  }
+}
+BENCHMARK(BM_InitCreateChannelShutdown);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
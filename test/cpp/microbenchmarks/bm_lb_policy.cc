@@ -0,0 +1,443 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks of LB policy picks, driven the way the client channel drives
+   them but with fake subchannels that need no connection: picks from several
+   threads under one data plane lock, picks while resolver updates swap the
+   picker, the cost of an update itself, and retrying the picks queued while
+   the policy was connecting once a subchannel becomes ready. */
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+
+#include <functional>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/parse_address.h"
+#include "src/core/ext/filters/client_channel/server_address.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc {
+namespace testing {
+
+using grpc_core::LoadBalancingPolicy;
+
+// A subchannel that is READY, or CONNECTING until SetReady(), without ever
+// connecting anywhere.
+class FakeSubchannel : public grpc_core::SubchannelInterface {
+ public:
+  FakeSubchannel(const grpc_channel_args& args, bool ready)
+      : args_(grpc_channel_args_copy(&args)),
+        state_(ready ? GRPC_CHANNEL_READY : GRPC_CHANNEL_CONNECTING) {}
+
+  ~FakeSubchannel() { grpc_channel_args_destroy(args_); }
+
+  grpc_connectivity_state CheckConnectivityState() override { return state_; }
+
+  void WatchConnectivityState(
+      grpc_connectivity_state initial_state,
+      grpc_core::UniquePtr<ConnectivityStateWatcherInterface> watcher)
+      override {
+    watcher_ = std::move(watcher);
+  }
+
+  void CancelConnectivityStateWatch(
+      ConnectivityStateWatcherInterface* watcher) override {
+    if (watcher_.get() == watcher) watcher_.reset();
+  }
+
+  void AttemptToConnect() override {}
+  void ResetBackoff() override {}
+  const grpc_channel_args* channel_args() override { return args_; }
+
+  // Must be called in the policy's combiner.
+  void SetReady() {
+    state_ = GRPC_CHANNEL_READY;
+    if (watcher_ != nullptr) watcher_->OnConnectivityStateChange(state_);
+  }
+
+ private:
+  grpc_channel_args* args_;
+  grpc_connectivity_state state_;
+  grpc_core::UniquePtr<ConnectivityStateWatcherInterface> watcher_;
+};
+
+// Calls with no initial metadata.
+class FakeMetadata : public LoadBalancingPolicy::MetadataInterface {
+ public:
+  void Add(grpc_core::StringView key, grpc_core::StringView value) override {}
+  Iterator Begin() const override { return 0; }
+  bool IsEnd(Iterator it) const override { return true; }
+  void Next(Iterator* it) const override {}
+  grpc_core::StringView Key(Iterator it) const override {
+    return grpc_core::StringView();
+  }
+  grpc_core::StringView Value(Iterator it) const override {
+    return grpc_core::StringView();
+  }
+  void Erase(Iterator* it) override {}
+};
+
+// Per-call memory for a single pick, which is all the policies allocate.
+class FakeCallState : public LoadBalancingPolicy::CallState {
+ public:
+  void* Alloc(size_t size) override {
+    size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(size);
+    GPR_ASSERT(used_ + size <= sizeof(buffer_));
+    void* p = buffer_ + used_;
+    used_ += size;
+    return p;
+  }
+
+ private:
+  alignas(GPR_MAX_ALIGNMENT) char buffer_[256];
+  size_t used_ = 0;
+};
+
+// An LB policy with the client channel's side of it: the combiner the policy
+// runs in, and the picker it last returned, used under a data plane lock.
+// Picks the picker queues are counted, and retried whenever the policy
+// returns a new picker.
+class LbPolicyFixture {
+ public:
+  LbPolicyFixture(const char* policy_name, bool subchannels_ready)
+      : subchannels_ready_(subchannels_ready) {
+    gpr_mu_init(&mu_);
+    combiner_ = grpc_combiner_create();
+    LoadBalancingPolicy::Args args;
+    args.combiner = combiner_;
+    args.channel_control_helper =
+        grpc_core::UniquePtr<LoadBalancingPolicy::ChannelControlHelper>(
+            grpc_core::New<Helper>(this));
+    args.args = &kNoArgs;
+    policy_ = grpc_core::LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
+        policy_name, std::move(args));
+    GPR_ASSERT(policy_ != nullptr);
+  }
+
+  ~LbPolicyFixture() {
+    RunInCombiner([this]() {
+      policy_.reset();
+      picker_.reset();
+      subchannels_.clear();
+    });
+    GRPC_COMBINER_UNREF(combiner_, "LbPolicyFixture");
+    gpr_mu_destroy(&mu_);
+  }
+
+  // Sends the policy a resolver update with num_addresses backends on
+  // consecutive ports from first_port.
+  void Update(size_t num_addresses, int first_port) {
+    LoadBalancingPolicy::UpdateArgs args;
+    for (size_t i = 0; i < num_addresses; ++i) {
+      char* hostport;
+      gpr_asprintf(&hostport, "127.0.0.1:%d",
+                   first_port + static_cast<int>(i));
+      grpc_resolved_address address;
+      GPR_ASSERT(grpc_parse_ipv4_hostport(hostport, &address, true));
+      gpr_free(hostport);
+      args.addresses.emplace_back(address, nullptr);
+    }
+    args.args = grpc_channel_args_copy(&kNoArgs);
+    RunInCombiner([this, &args]() {
+      subchannels_.clear();
+      policy_->UpdateLocked(std::move(args));
+    });
+  }
+
+  // Makes the first subchannel of the last update READY.
+  void SetFirstSubchannelReady() {
+    RunInCombiner([this]() { subchannels_[0]->SetReady(); });
+  }
+
+  // Returns whether the pick completed, or else queues it.
+  bool Pick() {
+    gpr_mu_lock(&mu_);
+    const bool complete = PickLocked();
+    if (!complete) ++num_queued_picks_;
+    gpr_mu_unlock(&mu_);
+    return complete;
+  }
+
+  size_t num_queued_picks() {
+    gpr_mu_lock(&mu_);
+    const size_t num_queued_picks = num_queued_picks_;
+    gpr_mu_unlock(&mu_);
+    return num_queued_picks;
+  }
+
+ private:
+  class Helper : public LoadBalancingPolicy::ChannelControlHelper {
+   public:
+    explicit Helper(LbPolicyFixture* fixture) : fixture_(fixture) {}
+
+    grpc_core::RefCountedPtr<grpc_core::SubchannelInterface> CreateSubchannel(
+        const grpc_channel_args& args) override {
+      grpc_core::RefCountedPtr<FakeSubchannel> subchannel =
+          grpc_core::MakeRefCounted<FakeSubchannel>(
+              args, fixture_->subchannels_ready_);
+      fixture_->subchannels_.push_back(subchannel);
+      return subchannel;
+    }
+
+    grpc_channel* CreateChannel(const char* target,
+                                const grpc_channel_args& args) override {
+      // Only the policies that talk to a balancer need this.
+      GPR_ASSERT(false);
+      return nullptr;
+    }
+
+    void UpdateState(grpc_connectivity_state state,
+                     grpc_core::UniquePtr<LoadBalancingPolicy::SubchannelPicker>
+                         picker) override {
+      fixture_->SetPicker(std::move(picker));
+    }
+
+    void RequestReresolution() override {}
+    void AddTraceEvent(TraceSeverity severity, const char* message) override {}
+
+   private:
+    LbPolicyFixture* fixture_;
+  };
+
+  static void RunClosure(void* arg, grpc_error* error) {
+    (*static_cast<std::function<void()>*>(arg))();
+  }
+
+  // Runs fn in the combiner and waits for it. Needs the caller's ExecCtx, so
+  // that flushing it also runs whatever picks have scheduled in the combiner.
+  void RunInCombiner(std::function<void()> fn) {
+    gpr_event done;
+    gpr_event_init(&done);
+    std::function<void()> fn_then_signal = [&fn, &done]() {
+      fn();
+      gpr_event_set(&done, reinterpret_cast<void*>(1));
+    };
+    grpc_closure closure;
+    GRPC_CLOSURE_SCHED(GRPC_CLOSURE_INIT(&closure, RunClosure, &fn_then_signal,
+                                         grpc_combiner_scheduler(combiner_)),
+                       GRPC_ERROR_NONE);
+    grpc_core::ExecCtx::Get()->Flush();
+    // A timer of the policy may have been holding the combiner.
+    GPR_ASSERT(gpr_event_wait(&done, gpr_inf_future(GPR_CLOCK_REALTIME)));
+  }
+
+  void SetPicker(
+      grpc_core::UniquePtr<LoadBalancingPolicy::SubchannelPicker> picker) {
+    gpr_mu_lock(&mu_);
+    picker_.swap(picker);
+    const size_t num_queued_picks = num_queued_picks_;
+    num_queued_picks_ = 0;
+    for (size_t i = 0; i < num_queued_picks; ++i) {
+      if (!PickLocked()) ++num_queued_picks_;
+    }
+    gpr_mu_unlock(&mu_);
+    // The old picker is destroyed outside the lock, as the client channel
+    // does.
+  }
+
+  bool PickLocked() {
+    if (picker_ == nullptr) return false;
+    FakeMetadata metadata;
+    FakeCallState call_state;
+    LoadBalancingPolicy::PickArgs args;
+    args.initial_metadata = &metadata;
+    args.call_state = &call_state;
+    LoadBalancingPolicy::PickResult result = picker_->Pick(args);
+    switch (result.type) {
+      case LoadBalancingPolicy::PickResult::PICK_QUEUE:
+        return false;
+      case LoadBalancingPolicy::PickResult::PICK_TRANSIENT_FAILURE:
+        GRPC_ERROR_UNREF(result.error);
+        return true;
+      case LoadBalancingPolicy::PickResult::PICK_COMPLETE:
+        // End the call at once, for the policies that track outstanding
+        // calls.
+        if (result.recv_trailing_metadata_ready != nullptr) {
+          result.recv_trailing_metadata_ready(
+              result.recv_trailing_metadata_ready_user_data, GRPC_ERROR_NONE,
+              &metadata, &call_state);
+        }
+        return true;
+    }
+    return true;
+  }
+
+  static const grpc_channel_args kNoArgs;
+
+  const bool subchannels_ready_;
+  grpc_combiner* combiner_;
+  grpc_core::OrphanablePtr<LoadBalancingPolicy> policy_;
+  // Created by the last update. Accessed in the combiner.
+  std::vector<grpc_core::RefCountedPtr<FakeSubchannel>> subchannels_;
+  // The data plane lock.
+  gpr_mu mu_;
+  grpc_core::UniquePtr<LoadBalancingPolicy::SubchannelPicker> picker_;
+  size_t num_queued_picks_ = 0;
+};
+
+const grpc_channel_args LbPolicyFixture::kNoArgs = {0, nullptr};
+
+struct PickFirst {
+  static const char* Name() { return "pick_first"; }
+};
+struct RoundRobin {
+  static const char* Name() { return "round_robin"; }
+};
+struct LeastRequest {
+  static const char* Name() { return "least_request"; }
+};
+struct RingHash {
+  static const char* Name() { return "ring_hash"; }
+};
+
+constexpr int kFirstPort = 1000;
+constexpr int kOtherFirstPort = 20000;
+
+// Shared by the threads of a benchmark; set up and torn down by thread 0.
+static LbPolicyFixture* g_fixture;
+
+// Picks from each thread, with range(0) READY subchannels.
+template <class Policy>
+static void BM_Pick(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  if (state.thread_index == 0) {
+    g_fixture = grpc_core::New<LbPolicyFixture>(Policy::Name(), true);
+    g_fixture->Update(state.range(0), kFirstPort);
+  }
+  while (state.KeepRunning()) {
+    GPR_ASSERT(g_fixture->Pick());
+  }
+  if (state.thread_index == 0) grpc_core::Delete(g_fixture);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Pick, PickFirst)->Arg(10)->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Pick, RoundRobin)->Arg(10)->Arg(1000)
+    ->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Pick, LeastRequest)->Arg(10)->Arg(1000)
+    ->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Pick, RingHash)->Arg(10)->Arg(1000)
+    ->ThreadRange(1, 16)->UseRealTime();
+
+// As BM_Pick, but thread 0 also sends a resolver update moving all range(0)
+// backends to other ports every kPicksPerUpdate picks, so that the others
+// contend with the picker swaps.
+template <class Policy>
+static void BM_PickDuringUpdates(benchmark::State& state) {
+  constexpr size_t kPicksPerUpdate = 1000;
+  grpc_core::ExecCtx exec_ctx;
+  if (state.thread_index == 0) {
+    g_fixture = grpc_core::New<LbPolicyFixture>(Policy::Name(), true);
+    g_fixture->Update(state.range(0), kFirstPort);
+  }
+  size_t picks = 0;
+  bool other_ports = false;
+  while (state.KeepRunning()) {
+    GPR_ASSERT(g_fixture->Pick());
+    if (state.thread_index == 0 && ++picks % kPicksPerUpdate == 0) {
+      other_ports = !other_ports;
+      g_fixture->Update(state.range(0),
+                        other_ports ? kOtherFirstPort : kFirstPort);
+    }
+  }
+  if (state.thread_index == 0) grpc_core::Delete(g_fixture);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_PickDuringUpdates, RoundRobin)->Arg(10)->Arg(100)
+    ->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PickDuringUpdates, LeastRequest)->Arg(10)->Arg(100)
+    ->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PickDuringUpdates, RingHash)->Arg(10)->Arg(100)
+    ->ThreadRange(1, 16)->UseRealTime();
+
+// A resolver update replacing all range(0) READY backends, up to the new
+// picker being swapped in.
+template <class Policy>
+static void BM_Update(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  LbPolicyFixture fixture(Policy::Name(), true);
+  fixture.Update(state.range(0), kFirstPort);
+  bool other_ports = false;
+  while (state.KeepRunning()) {
+    other_ports = !other_ports;
+    fixture.Update(state.range(0), other_ports ? kOtherFirstPort : kFirstPort);
+  }
+}
+BENCHMARK_TEMPLATE(BM_Update, PickFirst)->Arg(10)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_Update, RoundRobin)->Arg(10)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_Update, LeastRequest)->Arg(10)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_Update, RingHash)->Arg(10)->Arg(1000);
+
+// Retrying range(0) picks queued while all backends were connecting, once the
+// first of them becomes READY.
+template <class Policy>
+static void BM_QueuedPickDrain(benchmark::State& state) {
+  constexpr size_t kNumBackends = 10;
+  grpc_core::ExecCtx exec_ctx;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    LbPolicyFixture* fixture =
+        grpc_core::New<LbPolicyFixture>(Policy::Name(), false);
+    fixture->Update(kNumBackends, kFirstPort);
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      GPR_ASSERT(!fixture->Pick());
+    }
+    state.ResumeTiming();
+    fixture->SetFirstSubchannelReady();
+    state.PauseTiming();
+    GPR_ASSERT(fixture->num_queued_picks() == 0);
+    grpc_core::Delete(fixture);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_QueuedPickDrain, PickFirst)->Arg(1)->Arg(100)
+    ->Arg(10000);
+BENCHMARK_TEMPLATE(BM_QueuedPickDrain, RoundRobin)->Arg(1)->Arg(100)
+    ->Arg(10000);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc_init();
+  ::benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
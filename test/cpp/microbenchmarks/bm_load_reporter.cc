@@ -0,0 +1,127 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark merging Census view data into the server load reporter while
+   reports are generated from it */
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include <memory>
+#include <vector>
+
+#include "src/core/ext/filters/load_reporting/registered_opencensus_objects.h"
+#include "src/cpp/server/load_reporter/constants.h"
+#include "src/cpp/server/load_reporter/load_reporter.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#include "opencensus/stats/stats.h"
+
+namespace {
+
+using ::grpc::load_reporter::CensusViewProvider;
+using ::grpc::load_reporter::CensusViewProviderDefaultImpl;
+using ::grpc::load_reporter::LoadReporter;
+
+const char kHostname[] = "kHostname1";
+// Pad to the length of a valid LB ID.
+const char kLbId[] = "kLbId111";
+const char kLoadKey[] = "kLoadKey1";
+const char kClientIpAndToken[] = "00kLbId111kLbTag1";
+
+// Records one finished call for each user, the way the server load reporting
+// filter does.
+void RecordCalls(const std::vector<grpc::string>& users) {
+  for (const grpc::string& user : users) {
+    ::opencensus::stats::Record(
+        {{::grpc::load_reporter::MeasureStartCount(), 1}},
+        {{::grpc::load_reporter::TagKeyToken(), kClientIpAndToken},
+         {::grpc::load_reporter::TagKeyHost(), kHostname},
+         {::grpc::load_reporter::TagKeyUserId(), user}});
+    ::opencensus::stats::Record(
+        {{::grpc::load_reporter::MeasureEndCount(), 1},
+         {::grpc::load_reporter::MeasureEndBytesSent(), 100},
+         {::grpc::load_reporter::MeasureEndBytesReceived(), 100},
+         {::grpc::load_reporter::MeasureEndLatencyMs(), 1}},
+        {{::grpc::load_reporter::TagKeyToken(), kClientIpAndToken},
+         {::grpc::load_reporter::TagKeyHost(), kHostname},
+         {::grpc::load_reporter::TagKeyUserId(), user},
+         {::grpc::load_reporter::TagKeyStatus(),
+          ::grpc::load_reporter::kCallStatusOk}});
+  }
+}
+
+LoadReporter* g_load_reporter;
+
+}  // namespace
+
+// Thread 0 records a call for each of state.range(0) users and then fetches
+// and merges them, as the fetch timer does; only the fetch is timed. Every
+// other thread generates reports, as the report streams do, contending with
+// it for the load data store.
+static void BM_FetchAndGenerateLoads(benchmark::State& state) {
+  std::vector<grpc::string> users;
+  if (state.thread_index == 0) {
+    for (int64_t i = 0; i < state.range(0); i++) {
+      users.push_back("user" + std::to_string(i));
+    }
+    g_load_reporter = new LoadReporter(
+        10,
+        std::unique_ptr<CensusViewProvider>(
+            new CensusViewProviderDefaultImpl()),
+        nullptr);
+    g_load_reporter->ReportStreamCreated(kHostname, kLbId, kLoadKey);
+  }
+  int64_t loads = 0;
+  while (state.KeepRunning()) {
+    if (state.thread_index == 0) {
+      state.PauseTiming();
+      RecordCalls(users);
+      state.ResumeTiming();
+      g_load_reporter->FetchAndSample();
+    } else {
+      loads += g_load_reporter->GenerateLoads(kHostname, kLbId).size();
+    }
+  }
+  if (state.thread_index == 0) {
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    delete g_load_reporter;
+    g_load_reporter = nullptr;
+  }
+  benchmark::DoNotOptimize(loads);
+}
+BENCHMARK(BM_FetchAndGenerateLoads)
+    ->RangeMultiplier(8)
+    ->Range(8, 512)
+    ->ThreadRange(1, 4);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -20,10 +20,15 @@
 
 #include <benchmark/benchmark.h>
 #include <grpc/grpc.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <vector>
 
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/metadata.h"
+#include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/static_metadata.h"
+#include "src/core/lib/transport/timeout_encoding.h"
 
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -46,6 +51,29 @@ static void BM_SliceFromCopied(benchmark::State& state) {
 }
 BENCHMARK(BM_SliceFromCopied);
 
+// Both hashes slices can be built with (see GRPC_SLICE_BYTES_HASH), over
+// strings of state.range(0) bytes.
+template <uint32_t (*kHash)(const void*, size_t, uint32_t)>
+static void BM_SliceBytesHash(benchmark::State& state) {
+  TrackCounters track_counters;
+  std::vector<uint8_t> bytes(state.range(0), 'a');
+  uint32_t seed = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(seed = kHash(bytes.data(), bytes.size(), seed));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK_TEMPLATE(BM_SliceBytesHash, gpr_murmur_hash3)
+    ->Arg(4)
+    ->Arg(12)
+    ->Arg(36)
+    ->Arg(256);
+BENCHMARK_TEMPLATE(BM_SliceBytesHash, gpr_wyhash)
+    ->Arg(4)
+    ->Arg(12)
+    ->Arg(36)
+    ->Arg(256);
+
 static void BM_SliceIntern(benchmark::State& state) {
   TrackCounters track_counters;
   grpc_core::ExternallyManagedSlice slice("abc");
@@ -67,6 +95,60 @@ static void BM_SliceReIntern(benchmark::State& state) {
 }
 BENCHMARK(BM_SliceReIntern);
 
+// Interns slices round robin. The strings are kept interned throughout (as the
+// HPACK tables keep header strings interned), so that the loop measures table
+// lookups rather than allocation.
+static void InternRoundRobin(benchmark::State& state,
+                             const std::vector<grpc_slice>& slices) {
+  std::vector<grpc_slice> interned;
+  for (const auto& slice : slices) {
+    interned.push_back(grpc_slice_intern(slice));
+  }
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    grpc_slice_unref(
+        grpc_core::ManagedMemorySlice(&slices[i++ % slices.size()]));
+  }
+  for (auto& slice : interned) {
+    grpc_slice_unref(slice);
+  }
+}
+
+// Threads interning a shared set of header-like strings (as server threads
+// parsing the same headers do) and each interning strings of their own, to
+// show how the intern table scales under contention.
+static void BM_SliceInternSharedMultithreaded(benchmark::State& state) {
+  TrackCounters track_counters;
+  char buf[32];
+  std::vector<grpc_slice> slices;
+  for (int i = 0; i < 16; i++) {
+    snprintf(buf, sizeof(buf), "x-shared-header-%d", i);
+    slices.push_back(grpc_slice_from_copied_string(buf));
+  }
+  InternRoundRobin(state, slices);
+  for (auto& slice : slices) {
+    grpc_slice_unref(slice);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SliceInternSharedMultithreaded)->ThreadRange(1, 64);
+
+static void BM_SliceInternDistinctMultithreaded(benchmark::State& state) {
+  TrackCounters track_counters;
+  char buf[32];
+  std::vector<grpc_slice> slices;
+  for (int i = 0; i < 16; i++) {
+    snprintf(buf, sizeof(buf), "x-thread-%d-header-%d", state.thread_index, i);
+    slices.push_back(grpc_slice_from_copied_string(buf));
+  }
+  InternRoundRobin(state, slices);
+  for (auto& slice : slices) {
+    grpc_slice_unref(slice);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SliceInternDistinctMultithreaded)->ThreadRange(1, 64);
+
 static void BM_SliceInternStaticMetadata(benchmark::State& state) {
   TrackCounters track_counters;
   while (state.KeepRunning()) {
@@ -86,6 +168,28 @@ static void BM_SliceInternEqualToStaticMetadata(benchmark::State& state) {
 }
 BENCHMARK(BM_SliceInternEqualToStaticMetadata);
 
+// Recognizes header keys as the HPACK parser does for literal keys it does not
+// index: the common request keys, then a key that is not static.
+static void BM_SliceMaybeStaticIntern(benchmark::State& state) {
+  TrackCounters track_counters;
+  const std::vector<grpc_core::ExternallyManagedSlice> keys = {
+      grpc_core::ExternallyManagedSlice(":path"),
+      grpc_core::ExternallyManagedSlice("content-type"),
+      grpc_core::ExternallyManagedSlice("grpc-timeout"),
+      grpc_core::ExternallyManagedSlice("grpc-accept-encoding"),
+      grpc_core::ExternallyManagedSlice("user-agent"),
+      grpc_core::ExternallyManagedSlice("x-custom-request-id")};
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    bool is_static;
+    benchmark::DoNotOptimize(
+        grpc_slice_maybe_static_intern(keys[i], &is_static));
+    if (++i == keys.size()) i = 0;
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SliceMaybeStaticIntern);
+
 static void BM_MetadataFromNonInternedSlices(benchmark::State& state) {
   TrackCounters track_counters;
   grpc_core::ExternallyManagedSlice k("key");
@@ -287,6 +391,112 @@ static void BM_MetadataRefUnrefStatic(benchmark::State& state) {
 }
 BENCHMARK(BM_MetadataRefUnrefStatic);
 
+namespace {
+// A batch holding \a n elements with distinct interned custom keys.
+class CustomKeyBatch {
+ public:
+  explicit CustomKeyBatch(int64_t n) : storage_(n) {
+    grpc_metadata_batch_init(&batch_);
+    for (int64_t i = 0; i < n; i++) {
+      char key[32];
+      snprintf(key, sizeof(key), "x-custom-key-%" PRId64, i);
+      keys_.push_back(grpc_slice_from_copied_string(key));
+      GPR_ASSERT(grpc_metadata_batch_add_tail(
+                     &batch_, &storage_[i],
+                     grpc_mdelem_from_slices(
+                         grpc_slice_intern(keys_.back()),
+                         grpc_slice_from_static_string("value"))) ==
+                 GRPC_ERROR_NONE);
+    }
+  }
+  ~CustomKeyBatch() {
+    grpc_metadata_batch_destroy(&batch_);
+    for (auto& key : keys_) grpc_slice_unref(key);
+  }
+
+  grpc_metadata_batch* batch() { return &batch_; }
+  const grpc_slice& last_key() const { return keys_.back(); }
+
+ private:
+  grpc_metadata_batch batch_;
+  std::vector<grpc_linked_mdelem> storage_;
+  std::vector<grpc_slice> keys_;
+};
+}  // namespace
+
+static void BM_MetadataBatchFindCustomKey(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  CustomKeyBatch b(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(grpc_metadata_batch_find(b.batch(), b.last_key()));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_MetadataBatchFindCustomKey)->Range(1, 64);
+
+// The list walk grpc_metadata_batch_find saves, for comparison.
+static void BM_MetadataBatchScanCustomKey(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  CustomKeyBatch b(state.range(0));
+  while (state.KeepRunning()) {
+    grpc_linked_mdelem* l = b.batch()->list.head;
+    while (l != nullptr && !grpc_slice_eq(GRPC_MDKEY(l->md), b.last_key())) {
+      l = l->next;
+    }
+    benchmark::DoNotOptimize(l);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_MetadataBatchScanCustomKey)->Range(1, 64);
+
+static void BM_MetadataBatchLinkUnlinkCustom(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  CustomKeyBatch b(state.range(0));
+  grpc_core::ManagedMemorySlice key("x-extra-key");
+  grpc_mdelem md = grpc_mdelem_from_slices(
+      key, grpc_slice_from_static_string("value"));
+  grpc_linked_mdelem storage;
+  while (state.KeepRunning()) {
+    GPR_ASSERT(grpc_metadata_batch_add_tail(b.batch(), &storage,
+                                            GRPC_MDELEM_REF(md)) ==
+               GRPC_ERROR_NONE);
+    grpc_metadata_batch_remove(b.batch(), &storage);
+  }
+  GRPC_MDELEM_UNREF(md);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_MetadataBatchLinkUnlinkCustom)->Range(1, 64);
+
+// grpc-timeout values for a deadline state.range(0) milliseconds away
+static void BM_EncodeTimeout(benchmark::State& state) {
+  TrackCounters track_counters;
+  char buffer[GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE];
+  while (state.KeepRunning()) {
+    grpc_http2_encode_timeout(state.range(0), buffer);
+    benchmark::DoNotOptimize(buffer);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_EncodeTimeout)->Arg(0)->Arg(999)->Arg(12345)->Arg(3600000);
+
+static void BM_DecodeTimeout(benchmark::State& state) {
+  TrackCounters track_counters;
+  char buffer[GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE];
+  grpc_http2_encode_timeout(state.range(0), buffer);
+  grpc_slice text = grpc_slice_from_copied_string(buffer);
+  grpc_millis timeout;
+  while (state.KeepRunning()) {
+    GPR_ASSERT(grpc_http2_decode_timeout(text, &timeout));
+    benchmark::DoNotOptimize(timeout);
+  }
+  grpc_slice_unref(text);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_DecodeTimeout)->Arg(0)->Arg(999)->Arg(12345)->Arg(3600000);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -119,4 +119,24 @@ static void BM_E2eLatencyCensusEnabled(benchmark::State& state) {
 }
 BENCHMARK(BM_E2eLatencyCensusEnabled);
 
+static void BM_E2eLatencyCensusSampled(benchmark::State& state) {
+  RegisterOnce();
+  RegisterOpenCensusViewsForExport();
+  grpc::SetOpenCensusStatsSamplingRate(state.range(0));
+
+  EchoServerThread server;
+  std::unique_ptr<grpc::testing::EchoTestService::Stub> stub =
+      grpc::testing::EchoTestService::NewStub(grpc::CreateChannel(
+          server.address(), grpc::InsecureChannelCredentials()));
+
+  grpc::testing::EchoResponse response;
+  for (auto _ : state) {
+    grpc::testing::EchoRequest request;
+    grpc::ClientContext context;
+    grpc::Status status = stub->Echo(&context, request, &response);
+  }
+  grpc::SetOpenCensusStatsSamplingRate(1);
+}
+BENCHMARK(BM_E2eLatencyCensusSampled)->Arg(10)->Arg(100)->Arg(1000);
+
 BENCHMARK_MAIN();
@@ -33,6 +33,7 @@
 #include "test/cpp/util/test_config.h"
 
 #include <string.h>
+#include <vector>
 
 #ifdef GRPC_LINUX_MULTIPOLL_WITH_EPOLL
 #include <sys/epoll.h>
@@ -255,6 +256,74 @@ static void BM_SingleThreadPollOneFd(benchmark::State& state) {
 }
 BENCHMARK(BM_SingleThreadPollOneFd);
 
+// Like BM_SingleThreadPollOneFd, but makes state.range(0) fds readable at once
+// so that each poll returns many events. Each iteration is one round of all
+// the fds becoming readable and having their closures run.
+static void BM_SingleThreadPollManyFds(benchmark::State& state) {
+  TrackCounters track_counters;
+  const int num_fds = static_cast<int>(state.range(0));
+  size_t ps_sz = grpc_pollset_size();
+  grpc_pollset* ps = static_cast<grpc_pollset*>(gpr_zalloc(ps_sz));
+  gpr_mu* mu;
+  grpc_pollset_init(ps, &mu);
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<grpc_wakeup_fd> wakeup_fds(num_fds);
+  std::vector<grpc_fd*> wakeups;
+  std::vector<Closure*> closures;
+  int pending = 0;
+  for (int i = 0; i < num_fds; i++) {
+    grpc_error* error = grpc_wakeup_fd_init(&wakeup_fds[i]);
+    if (error != GRPC_ERROR_NONE) {
+      GRPC_ERROR_UNREF(error);
+      state.SkipWithError("Could not create enough wakeup fds");
+      break;
+    }
+    grpc_fd* wakeup =
+        grpc_fd_create(wakeup_fds[i].read_fd, "wakeup_read", false);
+    grpc_pollset_add_fd(ps, wakeup);
+    wakeups.push_back(wakeup);
+    grpc_wakeup_fd* wakeup_fd = &wakeup_fds[i];
+    closures.push_back(MakeClosure(
+        [wakeup_fd, &pending]() {
+          GRPC_ERROR_UNREF(grpc_wakeup_fd_consume_wakeup(wakeup_fd));
+          pending--;
+        },
+        grpc_schedule_on_exec_ctx));
+  }
+  gpr_mu_lock(mu);
+  if (static_cast<int>(wakeups.size()) == num_fds) {
+    while (state.KeepRunning()) {
+      for (int i = 0; i < num_fds; i++) {
+        GRPC_ERROR_UNREF(grpc_wakeup_fd_wakeup(&wakeup_fds[i]));
+        grpc_fd_notify_on_read(wakeups[i], closures[i]);
+      }
+      pending = num_fds;
+      while (pending > 0) {
+        GRPC_ERROR_UNREF(
+            grpc_pollset_work(ps, nullptr, GRPC_MILLIS_INF_FUTURE));
+      }
+    }
+  }
+  for (size_t i = 0; i < wakeups.size(); i++) {
+    grpc_fd_orphan(wakeups[i], nullptr, nullptr, "done");
+    wakeup_fds[i].read_fd = 0;
+  }
+  grpc_closure shutdown_ps_closure;
+  GRPC_CLOSURE_INIT(&shutdown_ps_closure, shutdown_ps, ps,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(ps, &shutdown_ps_closure);
+  gpr_mu_unlock(mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  for (size_t i = 0; i < wakeups.size(); i++) {
+    grpc_wakeup_fd_destroy(&wakeup_fds[i]);
+    delete closures[i];
+  }
+  gpr_free(ps);
+  state.SetItemsProcessed(state.iterations() * num_fds);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SingleThreadPollManyFds)->RangeMultiplier(4)->Range(1, 4096);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -0,0 +1,94 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark atomic and non-atomic ref-counting */
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+template <typename RefCountT>
+class Counted
+    : public grpc_core::RefCounted<Counted<RefCountT>,
+                                   grpc_core::NonPolymorphicRefCount,
+                                   RefCountT> {};
+
+}  // namespace
+
+template <typename RefCountT>
+static void BM_RefUnref(benchmark::State& state) {
+  RefCountT refs;
+  while (state.KeepRunning()) {
+    refs.Ref();
+    benchmark::DoNotOptimize(refs.Unref());
+  }
+}
+BENCHMARK_TEMPLATE(BM_RefUnref, grpc_core::RefCount);
+BENCHMARK_TEMPLATE(BM_RefUnref, grpc_core::NonAtomicRefCount);
+
+// Hands a ref down a chain of state.range(0) owners, as a batch handed from
+// closure to closure does, by copying it (a ref and an unref per hop).
+template <typename RefCountT>
+static void BM_RefCountedPtrCopyChain(benchmark::State& state) {
+  auto obj = grpc_core::MakeRefCounted<Counted<RefCountT>>();
+  while (state.KeepRunning()) {
+    grpc_core::RefCountedPtr<Counted<RefCountT>> owner = obj;
+    for (int64_t i = 0; i < state.range(0); i++) {
+      grpc_core::RefCountedPtr<Counted<RefCountT>> next = owner;
+      owner.reset();
+      owner = next;
+      benchmark::DoNotOptimize(owner.get());
+    }
+  }
+}
+BENCHMARK_TEMPLATE(BM_RefCountedPtrCopyChain, grpc_core::RefCount)->Arg(8);
+BENCHMARK_TEMPLATE(BM_RefCountedPtrCopyChain, grpc_core::NonAtomicRefCount)
+    ->Arg(8);
+
+// As above, moving the ref instead: no ref-count traffic per hop
+template <typename RefCountT>
+static void BM_RefCountedPtrMoveChain(benchmark::State& state) {
+  auto obj = grpc_core::MakeRefCounted<Counted<RefCountT>>();
+  while (state.KeepRunning()) {
+    grpc_core::RefCountedPtr<Counted<RefCountT>> owner = obj;
+    for (int64_t i = 0; i < state.range(0); i++) {
+      grpc_core::RefCountedPtr<Counted<RefCountT>> next = std::move(owner);
+      owner = std::move(next);
+      benchmark::DoNotOptimize(owner.get());
+    }
+  }
+}
+BENCHMARK_TEMPLATE(BM_RefCountedPtrMoveChain, grpc_core::RefCount)->Arg(8);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks of parsing large service configs, of the kind resolvers
+   return for services with thousands of methods: the JSON parse alone, and
+   the full ServiceConfig::Create with the registered parsers. */
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/service_config.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+
+namespace grpc {
+namespace testing {
+
+// Returns a service config of about size bytes, with one methodConfig entry
+// per method.
+static std::string MakeServiceConfig(size_t size) {
+  std::string config =
+      "{\"loadBalancingPolicy\":\"round_robin\",\"methodConfig\":[";
+  char entry[512];
+  for (int i = 0; config.size() < size; ++i) {
+    snprintf(entry, sizeof(entry),
+             "%s{\"name\":[{\"service\":\"pkg.Service%d\",\"method\":"
+             "\"Method%d\"}],\"waitForReady\":true,\"timeout\":\"1.5s\","
+             "\"maxRequestMessageBytes\":1024,"
+             "\"maxResponseMessageBytes\":4096}",
+             i == 0 ? "" : ",", i / 10, i);
+    config += entry;
+  }
+  config += "]}";
+  return config;
+}
+
+static void BM_JsonParse(benchmark::State& state) {
+  const std::string config = MakeServiceConfig(state.range(0));
+  while (state.KeepRunning()) {
+    // The parser uses its input as scratch space.
+    char* input = gpr_strdup(config.c_str());
+    grpc_json* json = grpc_json_parse_string(input);
+    GPR_ASSERT(json != nullptr);
+    grpc_json_destroy(json);
+    gpr_free(input);
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+}
+BENCHMARK(BM_JsonParse)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+static void BM_ServiceConfigCreate(benchmark::State& state) {
+  const std::string config = MakeServiceConfig(state.range(0));
+  grpc_core::ExecCtx exec_ctx;
+  while (state.KeepRunning()) {
+    grpc_error* error = GRPC_ERROR_NONE;
+    grpc_core::RefCountedPtr<grpc_core::ServiceConfig> service_config =
+        grpc_core::ServiceConfig::Create(config.c_str(), &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    GPR_ASSERT(service_config != nullptr);
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+}
+BENCHMARK(BM_ServiceConfigCreate)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc_init();
+  ::benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks of the global subchannel pool: many threads creating the
+   subchannels of 10k channels to an overlapping set of backends at once, as
+   when a process starts up, and releasing them again. */
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc {
+namespace testing {
+
+/* The subchannels are never connected. */
+static void NoopConnectorRef(grpc_connector* connector) {}
+static void NoopConnectorUnref(grpc_connector* connector) {}
+static void NoopConnectorShutdown(grpc_connector* connector, grpc_error* why) {
+  GRPC_ERROR_UNREF(why);
+}
+static void NoopConnectorConnect(grpc_connector* connector,
+                                 const grpc_connect_in_args* in_args,
+                                 grpc_connect_out_args* out_args,
+                                 grpc_closure* notify) {}
+static const grpc_connector_vtable kNoopConnectorVtable = {
+    NoopConnectorRef, NoopConnectorUnref, NoopConnectorShutdown,
+    NoopConnectorConnect};
+static grpc_connector g_noop_connector = {&kNoopConnectorVtable};
+
+const int kNumChannels = 10000;
+const int kNumBackends = 1000;
+
+/* Each thread creates its share of the subchannels, each channel using the
+   backend after the previous one, then releases them all. */
+static void BM_SubchannelPoolCreate(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  const int num_subchannels = kNumChannels / state.threads;
+  std::vector<grpc_channel_args*> args;
+  for (int i = 0; i < kNumBackends; ++i) {
+    char address[32];
+    snprintf(address, sizeof(address), "ipv4:127.0.0.1:%d", 10000 + i);
+    grpc_arg args_to_add[] = {
+        grpc_channel_arg_string_create(
+            const_cast<char*>(GRPC_ARG_SUBCHANNEL_ADDRESS), address),
+        grpc_core::SubchannelPoolInterface::CreateChannelArg(
+            grpc_core::GlobalSubchannelPool::instance().get())};
+    args.push_back(grpc_channel_args_copy_and_add(
+        nullptr, args_to_add, GPR_ARRAY_SIZE(args_to_add)));
+  }
+  std::vector<grpc_core::Subchannel*> subchannels;
+  subchannels.reserve(num_subchannels);
+  while (state.KeepRunning()) {
+    for (int i = 0; i < num_subchannels; ++i) {
+      subchannels.push_back(grpc_core::Subchannel::Create(
+          &g_noop_connector,
+          args[(state.thread_index * num_subchannels + i) % kNumBackends]));
+      GPR_ASSERT(subchannels.back() != nullptr);
+    }
+    for (grpc_core::Subchannel* subchannel : subchannels) {
+      GRPC_SUBCHANNEL_UNREF(subchannel, "bm_subchannel_pool");
+    }
+    subchannels.clear();
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * num_subchannels);
+  for (grpc_channel_args* a : args) grpc_channel_args_destroy(a);
+}
+BENCHMARK(BM_SubchannelPoolCreate)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc_init();
+  ::benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
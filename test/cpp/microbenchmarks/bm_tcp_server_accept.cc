@@ -0,0 +1,195 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark how fast a tcp server accepts bursts of connections */
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/port.h"
+#include "src/core/lib/iomgr/sockaddr.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/iomgr/tcp_server.h"
+
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#include <string.h>
+#include <vector>
+
+#ifdef GRPC_POSIX_SOCKET_TCP_SERVER
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+struct AcceptState {
+  gpr_mu* mu;
+  grpc_pollset* pollset;
+  int accepted = 0;
+};
+
+void OnAccept(void* arg, grpc_endpoint* tcp, grpc_pollset* accepting_pollset,
+              grpc_tcp_server_acceptor* acceptor) {
+  AcceptState* accept_state = static_cast<AcceptState*>(arg);
+  grpc_endpoint_shutdown(tcp,
+                         GRPC_ERROR_CREATE_FROM_STATIC_STRING("Accepted"));
+  grpc_endpoint_destroy(tcp);
+  gpr_free(acceptor);
+  gpr_mu_lock(accept_state->mu);
+  accept_state->accepted++;
+  GRPC_LOG_IF_ERROR("pollset_kick",
+                    grpc_pollset_kick(accept_state->pollset, nullptr));
+  gpr_mu_unlock(accept_state->mu);
+}
+
+void OnServerShutdown(void* arg, grpc_error* error) {
+  gpr_atm_rel_store(static_cast<gpr_atm*>(arg), 1);
+}
+
+void ShutdownPollset(void* ps, grpc_error* error) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(ps));
+}
+
+// Polls until accept_state->accepted reaches target
+void WaitForAccepts(AcceptState* accept_state, int target) {
+  gpr_mu_lock(accept_state->mu);
+  while (accept_state->accepted < target) {
+    grpc_pollset_worker* worker = nullptr;
+    GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(accept_state->pollset, &worker,
+                          grpc_core::ExecCtx::Get()->Now() + 100));
+    gpr_mu_unlock(accept_state->mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(accept_state->mu);
+  }
+  gpr_mu_unlock(accept_state->mu);
+}
+
+}  // namespace
+
+// Each iteration opens state.range(1) connections to the server and waits
+// until all of them have been handed to the accept callback. state.range(0)
+// sets GRPC_ARG_TCP_SERVER_OFFLOAD_ACCEPT.
+static void BM_AcceptBurst(benchmark::State& state) {
+  TrackCounters track_counters;
+  const int burst = static_cast<int>(state.range(1));
+  grpc_core::ExecCtx exec_ctx;
+  grpc_pollset* ps =
+      static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+  AcceptState accept_state;
+  grpc_pollset_init(ps, &accept_state.mu);
+  accept_state.pollset = ps;
+
+  grpc_arg arg;
+  arg.type = GRPC_ARG_INTEGER;
+  arg.key = const_cast<char*>(GRPC_ARG_TCP_SERVER_OFFLOAD_ACCEPT);
+  arg.value.integer = static_cast<int>(state.range(0));
+  grpc_channel_args args = {1, &arg};
+  gpr_atm server_shutdown = 0;
+  grpc_closure server_shutdown_closure;
+  GRPC_CLOSURE_INIT(&server_shutdown_closure, OnServerShutdown,
+                    &server_shutdown, grpc_schedule_on_exec_ctx);
+  grpc_tcp_server* server;
+  GPR_ASSERT(GRPC_ERROR_NONE ==
+             grpc_tcp_server_create(&server_shutdown_closure, &args, &server));
+  grpc_resolved_address resolved_addr;
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr.addr);
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  resolved_addr.len = static_cast<socklen_t>(sizeof(*addr));
+  int port;
+  GPR_ASSERT(GRPC_ERROR_NONE ==
+             grpc_tcp_server_add_port(server, &resolved_addr, &port));
+  GPR_ASSERT(port > 0);
+  addr->sin_port = htons(static_cast<uint16_t>(port));
+  grpc_tcp_server_start(server, &ps, 1, OnAccept, &accept_state);
+
+  std::vector<int> clients(burst);
+  int target = 0;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < burst; i++) {
+      clients[i] = socket(AF_INET, SOCK_STREAM, 0);
+      GPR_ASSERT(clients[i] >= 0);
+      GPR_ASSERT(0 == connect(clients[i],
+                              reinterpret_cast<struct sockaddr*>(addr),
+                              resolved_addr.len));
+    }
+    target += burst;
+    WaitForAccepts(&accept_state, target);
+    for (int i = 0; i < burst; i++) {
+      close(clients[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * burst);
+
+  grpc_tcp_server_unref(server);
+  grpc_core::ExecCtx::Get()->Flush();
+  while (!gpr_atm_acq_load(&server_shutdown)) {
+    gpr_mu_lock(accept_state.mu);
+    grpc_pollset_worker* worker = nullptr;
+    GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(ps, &worker, grpc_core::ExecCtx::Get()->Now() + 100));
+    gpr_mu_unlock(accept_state.mu);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  grpc_closure shutdown_ps_closure;
+  GRPC_CLOSURE_INIT(&shutdown_ps_closure, ShutdownPollset, ps,
+                    grpc_schedule_on_exec_ctx);
+  gpr_mu_lock(accept_state.mu);
+  grpc_pollset_shutdown(ps, &shutdown_ps_closure);
+  gpr_mu_unlock(accept_state.mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  gpr_free(ps);
+  track_counters.Finish(state);
+}
+static void SweepAcceptBurst(benchmark::internal::Benchmark* b) {
+  for (int offload = 0; offload <= 1; offload++) {
+    for (int burst : {1, 16, 64}) {
+      b->Args({offload, burst});
+    }
+  }
+}
+BENCHMARK(BM_AcceptBurst)->Apply(SweepAcceptBurst);
+
+#endif  // GRPC_POSIX_SOCKET_TCP_SERVER
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -21,7 +21,10 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <thread>
+#include <vector>
 
+#include "src/core/lib/iomgr/executor/mpmcqueue.h"
 #include "src/core/lib/iomgr/executor/threadpool.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -97,6 +100,7 @@ static void ThreadPoolAddAnother(benchmark::State& state) {
   // Number of adds done by each closure.
   const int num_add = num_iterations / kConcurrentFunctor;
   grpc_core::ThreadPool pool(num_threads);
+  TrackCounters track_counters;
   while (state.KeepRunningBatch(num_iterations)) {
     BlockingCounter counter(kConcurrentFunctor);
     for (int i = 0; i < kConcurrentFunctor; ++i) {
@@ -104,6 +108,7 @@ static void ThreadPoolAddAnother(benchmark::State& state) {
     }
     counter.Wait();
   }
+  track_counters.Finish(state);
   state.SetItemsProcessed(state.iterations());
 }
 
@@ -154,6 +159,7 @@ static void BM_ThreadPoolExternalAdd(benchmark::State& state) {
     external_add_pool = grpc_core::New<grpc_core::ThreadPool>(num_threads);
   }
   const int num_iterations = state.range(0) / state.threads;
+  TrackCounters track_counters;
   while (state.KeepRunningBatch(num_iterations)) {
     BlockingCounter counter(num_iterations);
     for (int i = 0; i < num_iterations; ++i) {
@@ -161,6 +167,7 @@ static void BM_ThreadPoolExternalAdd(benchmark::State& state) {
     }
     counter.Wait();
   }
+  track_counters.Finish(state);
 
   // Teardown at the end of each test run.
   if (state.thread_index == 0) {
@@ -174,6 +181,90 @@ BENCHMARK(BM_ThreadPoolExternalAdd)
     ->RangePair(524288, 524288, 1, 1024)
     ->ThreadRange(1, 256);  // Concurrent external thread(s) up to 256
 
+// Same as BM_ThreadPoolExternalAdd, with the pool using LockFreeMPMCQueue.
+static void BM_ThreadPoolExternalAddLockFreeQueue(benchmark::State& state) {
+  static grpc_core::ThreadPool* external_add_pool = nullptr;
+  // Setup for each run of test.
+  if (state.thread_index == 0) {
+    const int num_threads = state.range(1);
+    external_add_pool = grpc_core::New<grpc_core::ThreadPool>(
+        num_threads, "ThreadPoolWorker", grpc_core::Thread::Options(),
+        grpc_core::ThreadPool::QueueType::kLockFree);
+  }
+  const int num_iterations = state.range(0) / state.threads;
+  TrackCounters track_counters;
+  while (state.KeepRunningBatch(num_iterations)) {
+    BlockingCounter counter(num_iterations);
+    for (int i = 0; i < num_iterations; ++i) {
+      external_add_pool->Add(new SuicideFunctorForAdd(&counter));
+    }
+    counter.Wait();
+  }
+  track_counters.Finish(state);
+
+  // Teardown at the end of each test run.
+  if (state.thread_index == 0) {
+    state.SetItemsProcessed(state.range(0));
+    grpc_core::Delete(external_add_pool);
+  }
+}
+BENCHMARK(BM_ThreadPoolExternalAddLockFreeQueue)
+    // First pair is range for number of iterations (num_iterations).
+    // Second pair is range for thread pool size (num_threads).
+    ->RangePair(524288, 524288, 1, 1024)
+    ->ThreadRange(1, 256);  // Concurrent external thread(s) up to 256
+
+// Measures raw queue throughput with several producer threads putting and
+// several consumer threads getting at once, without the thread pool around it.
+// First argument is the number of producers, second the number of consumers.
+template <class Queue>
+static void BM_MPMCQueueThroughput(benchmark::State& state) {
+  const int num_producers = state.range(0);
+  const int num_consumers = state.range(1);
+  const int kItemsPerProducer = 16384;
+  const int num_items = kItemsPerProducer * num_producers;
+  // Any non-null element will do: null tells consumers to exit.
+  static char elem;
+  Queue queue;
+  std::vector<std::thread> consumers;
+  for (int i = 0; i < num_consumers; ++i) {
+    consumers.emplace_back([&queue] {
+      while (queue.Get() != nullptr) {
+      }
+    });
+  }
+  TrackCounters track_counters;
+  while (state.KeepRunningBatch(num_items)) {
+    std::vector<std::thread> producers;
+    for (int i = 0; i < num_producers; ++i) {
+      producers.emplace_back([&queue] {
+        for (int j = 0; j < kItemsPerProducer; ++j) {
+          queue.Put(&elem);
+        }
+      });
+    }
+    for (auto& producer : producers) producer.join();
+    // Wait for consumers to catch up before the next batch.
+    while (queue.count() > 0) {
+      std::this_thread::yield();
+    }
+  }
+  track_counters.Finish(state);
+  for (int i = 0; i < num_consumers; ++i) {
+    queue.Put(nullptr);
+  }
+  for (auto& consumer : consumers) consumer.join();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_MPMCQueueThroughput, grpc_core::InfLenFIFOQueue)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 16}, {1, 16}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MPMCQueueThroughput, grpc_core::LockFreeMPMCQueue)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 16}, {1, 16}})
+    ->UseRealTime();
+
 // Functor (closure) that adds itself into pool repeatedly. By adding self, the
 // overhead would be low and can measure the time of add more accurately.
 class AddSelfFunctor : public grpc_experimental_completion_queue_functor {
@@ -211,6 +302,7 @@ static void ThreadPoolAddSelf(benchmark::State& state) {
   // Number of adds done by each closure.
   const int num_add = num_iterations / kConcurrentFunctor;
   grpc_core::ThreadPool pool(num_threads);
+  TrackCounters track_counters;
   while (state.KeepRunningBatch(num_iterations)) {
     BlockingCounter counter(kConcurrentFunctor);
     for (int i = 0; i < kConcurrentFunctor; ++i) {
@@ -218,6 +310,7 @@ static void ThreadPoolAddSelf(benchmark::State& state) {
     }
     counter.Wait();
   }
+  track_counters.Finish(state);
   state.SetItemsProcessed(state.iterations());
 }
 
@@ -292,6 +385,7 @@ static void BM_SpikyLoad(benchmark::State& state) {
   const int batch_size = 3 * num_threads;
   std::vector<ShortWorkFunctorForAdd> work_vector(batch_size);
   grpc_core::ThreadPool pool(num_threads);
+  TrackCounters track_counters;
   while (state.KeepRunningBatch(kNumSpikes * batch_size)) {
     for (int i = 0; i != kNumSpikes; ++i) {
       BlockingCounter counter(batch_size);
@@ -302,6 +396,7 @@ static void BM_SpikyLoad(benchmark::State& state) {
       counter.Wait();
     }
   }
+  track_counters.Finish(state);
   state.SetItemsProcessed(state.iterations() * batch_size);
 }
 BENCHMARK(BM_SpikyLoad)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
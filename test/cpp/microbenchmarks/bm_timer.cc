@@ -19,6 +19,7 @@
 #include <benchmark/benchmark.h>
 #include <string.h>
 #include <atomic>
+#include <random>
 #include <vector>
 
 #include <grpc/grpc.h>
@@ -28,6 +29,7 @@
 #include "test/cpp/util/test_config.h"
 
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/timer_manager.h"
 
 namespace grpc {
 namespace testing {
@@ -99,6 +101,50 @@ BENCHMARK(BM_TimerBatch)
     ->Args({/*check=*/true, /*reverse=*/true})
     ->ThreadRange(1, 128);
 
+// Keeps state.range(0) timers set, with deadlines spread over the next ten
+// minutes, and each iteration cancels one of them and sets it again: the
+// pattern of per-call deadlines and keepalive timers on a busy server. Time
+// advances by a millisecond every 64 iterations, firing the timers that come
+// due. Run with GRPC_TIMER_WHEEL=1 to measure the timing wheel instead of the
+// generic implementation.
+static void BM_TimerChurn(benchmark::State& state) {
+  const size_t timer_count = static_cast<size_t>(state.range(0));
+  constexpr grpc_millis kMaxDelay = 10 * 60 * 1000;
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<TimerClosure> timer_closures(timer_count);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<grpc_millis> delay(1, kMaxDelay);
+  std::uniform_int_distribution<size_t> pick(0, timer_count - 1);
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  for (TimerClosure& timer_closure : timer_closures) {
+    GRPC_CLOSURE_INIT(&timer_closure.closure,
+                      [](void* /*args*/, grpc_error* /*err*/) {}, nullptr,
+                      grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&timer_closure.timer, now + delay(rng),
+                    &timer_closure.closure);
+  }
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    TimerClosure* timer_closure = &timer_closures[pick(rng)];
+    grpc_timer_cancel(&timer_closure->timer);
+    exec_ctx.Flush();
+    grpc_timer_init(&timer_closure->timer, now + delay(rng),
+                    &timer_closure->closure);
+    if (++i % 64 == 0) {
+      exec_ctx.TestOnlySetNow(++now);
+      grpc_timer_check(nullptr);
+      exec_ctx.Flush();
+    }
+  }
+  for (TimerClosure& timer_closure : timer_closures) {
+    grpc_timer_cancel(&timer_closure.timer);
+  }
+  exec_ctx.Flush();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TimerChurn)->RangeMultiplier(32)->Range(1024, 1 << 20);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -112,6 +158,8 @@ int main(int argc, char** argv) {
   LibraryInitializer libInit;
   ::benchmark::Initialize(&argc, argv);
   ::grpc::testing::InitTest(&argc, &argv, false);
+  // BM_TimerChurn drives time and timer checks itself
+  grpc_timer_manager_set_threading(false);
   benchmark::RunTheBenchmarksNamespaced();
   return 0;
 }
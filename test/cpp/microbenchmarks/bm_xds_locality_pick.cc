@@ -0,0 +1,89 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks of the xds policy's weighted choice of locality: the alias
+   table its picker uses against a binary search over cumulative weights, for
+   various numbers of localities with uneven weights. */
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/xds/alias_table.h"
+
+namespace grpc {
+namespace testing {
+
+static uint32_t LocalityWeight(int64_t i) { return 1 + i % 7; }
+
+static void BM_AliasTablePick(benchmark::State& state) {
+  grpc_core::AliasTable<int64_t>::WeightedList localities;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    localities.push_back(grpc_core::MakePair(LocalityWeight(i), i));
+  }
+  grpc_core::AliasTable<int64_t> table(std::move(localities));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(table.Pick(rand(), rand()));
+  }
+}
+BENCHMARK(BM_AliasTablePick)->RangeMultiplier(4)->Range(4, 1024);
+
+/* How the picker chose before, for comparison. */
+static void BM_CumulativeWeightPick(benchmark::State& state) {
+  grpc_core::InlinedVector<uint32_t, 1> ends;
+  uint32_t end = 0;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    end += LocalityWeight(i);
+    ends.push_back(end);
+  }
+  while (state.KeepRunning()) {
+    const uint32_t key = rand() % end;
+    size_t start_index = 0;
+    size_t end_index = ends.size() - 1;
+    while (end_index > start_index) {
+      const size_t mid = (start_index + end_index) / 2;
+      if (ends[mid] > key) {
+        end_index = mid;
+      } else {
+        start_index = mid + 1;
+      }
+    }
+    benchmark::DoNotOptimize(start_index);
+  }
+}
+BENCHMARK(BM_CumulativeWeightPick)->RangeMultiplier(4)->Range(4, 1024);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc_init();
+  ::benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
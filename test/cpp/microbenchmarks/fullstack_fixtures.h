@@ -342,6 +342,115 @@ typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
 
+////////////////////////////////////////////////////////////////////////////////
+// HTTP2 write coalescing fixtures
+
+class WriteCoalescingConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US, 50);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_HTTP2_WRITE_COALESCING_WINDOW_US, 50);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base>
+class WriteCoalescize : public Base {
+ public:
+  WriteCoalescize(Service* service)
+      : Base(service, WriteCoalescingConfiguration()) {}
+};
+
+typedef WriteCoalescize<TCP> CoalescingTCP;
+typedef WriteCoalescize<InProcessCHTTP2> CoalescingInProcessCHTTP2;
+
+////////////////////////////////////////////////////////////////////////////////
+// TCP corked write fixtures
+
+class CorkWritesConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_TCP_CORK_WRITES, 1);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_TCP_CORK_WRITES, 1);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base>
+class CorkWritize : public Base {
+ public:
+  CorkWritize(Service* service) : Base(service, CorkWritesConfiguration()) {}
+};
+
+typedef CorkWritize<TCP> CorkedTCP;
+
+////////////////////////////////////////////////////////////////////////////////
+// Busy polling server fixtures
+
+class BusyPollConfiguration : public FixtureConfiguration {
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_SERVER_BUSY_POLL_US, 50);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base>
+class BusyPollize : public Base {
+ public:
+  BusyPollize(Service* service) : Base(service, BusyPollConfiguration()) {}
+};
+
+typedef BusyPollize<TCP> BusyPollTCP;
+typedef BusyPollize<UDS> BusyPollUDS;
+
+////////////////////////////////////////////////////////////////////////////////
+// Unix socket fixtures with large socket buffers
+
+class LargeSocketBufferConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_UNIX_SOCKET_BUFFER_SIZE, 1024 * 1024);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_UNIX_SOCKET_BUFFER_SIZE, 1024 * 1024);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base>
+class LargeSocketBufferize : public Base {
+ public:
+  LargeSocketBufferize(Service* service)
+      : Base(service, LargeSocketBufferConfiguration()) {}
+};
+
+typedef LargeSocketBufferize<UDS> LargeBufferUDS;
+
+////////////////////////////////////////////////////////////////////////////////
+// Direct channel fixtures (UDS only: the TCP fixture's target needs resolving)
+
+class DirectChannelConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_DIRECT_CHANNEL, 1);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+};
+
+template <class Base>
+class Directize : public Base {
+ public:
+  Directize(Service* service) : Base(service, DirectChannelConfiguration()) {}
+};
+
+typedef Directize<UDS> DirectUDS;
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -23,6 +23,7 @@
 
 #include <benchmark/benchmark.h>
 #include <sstream>
+#include <vector>
 #include "src/core/lib/profiling/timers.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/cpp/microbenchmarks/fullstack_context_mutators.h"
@@ -109,6 +110,105 @@ static void BM_UnaryPingPong(benchmark::State& state) {
   state.SetBytesProcessed(state.range(0) * state.iterations() +
                           state.range(1) * state.iterations());
 }
+
+// Like BM_UnaryPingPong, but keeps state.range(2) calls in flight on the one
+// channel, so that the transport has frames from many streams to write at
+// once. Each iteration is one completed call.
+template <class Fixture, class ClientContextMutator, class ServerContextMutator>
+static void BM_UnaryPingPongConcurrent(benchmark::State& state) {
+  EchoTestService::AsyncService service;
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  EchoRequest send_request;
+  EchoResponse send_response;
+  if (state.range(0) > 0) {
+    send_request.set_message(std::string(state.range(0), 'a'));
+  }
+  if (state.range(1) > 0) {
+    send_response.set_message(std::string(state.range(1), 'a'));
+  }
+  const int concurrency = static_cast<int>(state.range(2));
+  struct ServerEnv {
+    ServerContext ctx;
+    EchoRequest recv_request;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer;
+    ServerEnv() : response_writer(&ctx) {}
+  };
+  struct ClientEnv {
+    ClientContext ctx;
+    EchoResponse recv_response;
+    Status recv_status;
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader;
+  };
+  // tags carry the slot of the call and which of these events completed
+  enum { kServerRequest, kServerFinish, kClientFinish };
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  std::vector<std::unique_ptr<ServerEnv>> server_env(concurrency);
+  std::vector<std::unique_ptr<ClientEnv>> client_env(concurrency);
+  auto request_echo = [&](int slot) {
+    ServerEnv* senv = new ServerEnv;
+    server_env[slot].reset(senv);
+    service.RequestEcho(&senv->ctx, &senv->recv_request, &senv->response_writer,
+                        fixture->cq(), fixture->cq(),
+                        tag(slot << 2 | kServerRequest));
+  };
+  auto start_call = [&](int slot) {
+    ClientEnv* cenv = new ClientEnv;
+    client_env[slot].reset(cenv);
+    ClientContextMutator cli_ctx_mut(&cenv->ctx);
+    cenv->response_reader =
+        stub->AsyncEcho(&cenv->ctx, send_request, fixture->cq());
+    cenv->response_reader->Finish(&cenv->recv_response, &cenv->recv_status,
+                                  tag(slot << 2 | kClientFinish));
+  };
+  int server_finishing = 0;
+  // Waits for the next event, handling it if it is a server one; returns the
+  // slot of the client call if it was a client call completing, else -1.
+  auto next_event = [&]() -> int {
+    void* t;
+    bool ok;
+    GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+    GPR_ASSERT(ok);
+    intptr_t v = reinterpret_cast<intptr_t>(t);
+    int slot = static_cast<int>(v >> 2);
+    switch (v & 3) {
+      case kServerRequest: {
+        ServerEnv* senv = server_env[slot].get();
+        ServerContextMutator svr_ctx_mut(&senv->ctx);
+        senv->response_writer.Finish(send_response, Status::OK,
+                                     tag(slot << 2 | kServerFinish));
+        server_finishing++;
+        return -1;
+      }
+      case kServerFinish:
+        server_finishing--;
+        request_echo(slot);
+        return -1;
+      case kClientFinish:
+        GPR_ASSERT(client_env[slot]->recv_status.ok());
+        return slot;
+    }
+    GPR_UNREACHABLE_CODE(return -1);
+  };
+  for (int i = 0; i < concurrency; i++) {
+    request_echo(i);
+    start_call(i);
+  }
+  while (state.KeepRunning()) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    int slot;
+    while ((slot = next_event()) < 0) {
+    }
+    start_call(slot);
+  }
+  for (int in_flight = concurrency; in_flight > 0 || server_finishing > 0;) {
+    if (next_event() >= 0) in_flight--;
+  }
+  fixture->Finish(state);
+  fixture.reset();
+  state.SetBytesProcessed(state.range(0) * state.iterations() +
+                          state.range(1) * state.iterations());
+}
 }  // namespace testing
 }  // namespace grpc
 
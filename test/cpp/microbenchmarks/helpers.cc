@@ -28,9 +28,9 @@ LibraryInitializer::LibraryInitializer() {
   g_libraryInitializer = this;
 
   g_gli_initializer.summon();
-#ifdef GPR_LOW_LEVEL_COUNTERS
+  // Count allocations in every configuration, for allocs/iter and
+  // alloc_bytes/iter.
   grpc_memory_counters_init();
-#endif
   init_lib_.init();
   rq_ = grpc_resource_quota_create("bm");
 }
@@ -81,8 +81,16 @@ void TrackCounters::AddToLabel(std::ostream& out, benchmark::State& state) {
         << grpc_stats_histo_percentile(&stats, (grpc_stats_histograms)i, 99.0);
   }
 #endif
-#ifdef GPR_LOW_LEVEL_COUNTERS
   grpc_memory_counters counters_at_end = grpc_memory_counters_snapshot();
+  out << " allocs/iter:"
+      << (static_cast<double>(counters_at_end.total_allocs_absolute -
+                              counters_at_start_.total_allocs_absolute) /
+          static_cast<double>(state.iterations()))
+      << " alloc_bytes/iter:"
+      << (static_cast<double>(counters_at_end.total_size_absolute -
+                              counters_at_start_.total_size_absolute) /
+          static_cast<double>(state.iterations()));
+#ifdef GPR_LOW_LEVEL_COUNTERS
   out << " locks/iter:"
       << ((double)(gpr_atm_no_barrier_load(&gpr_mu_locks) -
                    mu_locks_at_start_) /
@@ -98,10 +106,6 @@ void TrackCounters::AddToLabel(std::ostream& out, benchmark::State& state) {
       << " nows/iter:"
       << ((double)(gpr_atm_no_barrier_load(&gpr_now_call_count) -
                    now_calls_at_start_) /
-          (double)state.iterations())
-      << " allocs/iter:"
-      << ((double)(counters_at_end.total_allocs_absolute -
-                   counters_at_start_.total_allocs_absolute) /
           (double)state.iterations());
 #endif
 }
@@ -61,6 +61,7 @@ class TrackCounters {
  private:
   grpc_stats_data stats_begin_;
   std::vector<grpc::string> labels_;
+  grpc_memory_counters counters_at_start_ = grpc_memory_counters_snapshot();
 #ifdef GPR_LOW_LEVEL_COUNTERS
   const size_t mu_locks_at_start_ = gpr_atm_no_barrier_load(&gpr_mu_locks);
   const size_t atm_cas_at_start_ =
@@ -69,7 +70,6 @@ class TrackCounters {
       gpr_atm_no_barrier_load(&gpr_counter_atm_add);
   const size_t now_calls_at_start_ =
       gpr_atm_no_barrier_load(&gpr_now_call_count);
-  grpc_memory_counters counters_at_start_ = grpc_memory_counters_snapshot();
 #endif
 };
 
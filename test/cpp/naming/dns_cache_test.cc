@@ -0,0 +1,482 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_wrapper.h"
+#include "src/core/ext/filters/client_channel/resolver/dns/dns_resolver_selection.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// A DNS server on 127.0.0.1 answering A queries for any name with the
+// address set by SetAddress(), and AAAA queries with no records. Answers can
+// be held back to keep lookups in flight.
+class FakeDnsServer {
+ public:
+  explicit FakeDnsServer(int port) {
+    socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+    GPR_ASSERT(socket_ >= 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    GPR_ASSERT(bind(socket_, reinterpret_cast<const sockaddr*>(&addr),
+                    sizeof(addr)) == 0);
+    SetAddress("10.0.0.1");
+    thread_ = std::thread(&FakeDnsServer::Serve, this);
+  }
+
+  ~FakeDnsServer() {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      shutdown_ = true;
+    }
+    thread_.join();
+    close(socket_);
+  }
+
+  void SetAddress(const char* ipv4_address) {
+    std::lock_guard<std::mutex> lock(mu_);
+    GPR_ASSERT(inet_pton(AF_INET, ipv4_address, &address_) == 1);
+  }
+
+  void HoldAnswers() {
+    std::lock_guard<std::mutex> lock(mu_);
+    holding_ = true;
+  }
+
+  void ReleaseAnswers() {
+    std::lock_guard<std::mutex> lock(mu_);
+    holding_ = false;
+    for (const Answer& answer : held_) SendLocked(answer);
+    held_.clear();
+  }
+
+  // The number of A queries received, one per lookup made.
+  int num_lookups() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return num_lookups_;
+  }
+
+ private:
+  struct Answer {
+    sockaddr_storage to;
+    socklen_t to_len;
+    std::string data;
+  };
+
+  void Serve() {
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (shutdown_) return;
+      }
+      pollfd pfd;
+      pfd.fd = socket_;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (poll(&pfd, 1, 10 /* timeout_ms */) <= 0) continue;
+      char query[512];
+      Answer answer;
+      answer.to_len = sizeof(answer.to);
+      ssize_t len = recvfrom(socket_, query, sizeof(query), 0,
+                             reinterpret_cast<sockaddr*>(&answer.to),
+                             &answer.to_len);
+      if (len <= 0) continue;
+      std::lock_guard<std::mutex> lock(mu_);
+      if (!BuildAnswerLocked(query, static_cast<size_t>(len), &answer.data)) {
+        continue;
+      }
+      if (holding_) {
+        held_.push_back(answer);
+      } else {
+        SendLocked(answer);
+      }
+    }
+  }
+
+  static void SetUint16(std::string* s, size_t pos, uint16_t value) {
+    (*s)[pos] = static_cast<char>(value >> 8);
+    (*s)[pos + 1] = static_cast<char>(value & 0xff);
+  }
+
+  bool BuildAnswerLocked(const char* query, size_t len, std::string* answer) {
+    const size_t kHeaderLength = 12;
+    // Skip over the name of the question.
+    size_t pos = kHeaderLength;
+    while (pos < len && query[pos] != 0) {
+      pos += 1 + static_cast<uint8_t>(query[pos]);
+    }
+    pos += 1;
+    if (pos + 4 > len) return false;
+    const uint16_t qtype = static_cast<uint16_t>(
+        static_cast<uint8_t>(query[pos]) << 8 |
+        static_cast<uint8_t>(query[pos + 1]));
+    pos += 4;
+    const bool is_a = qtype == 1;
+    if (is_a) ++num_lookups_;
+    // Echo the header and question, as a response with recursion available.
+    answer->assign(query, pos);
+    (*answer)[2] = static_cast<char>(0x81);
+    (*answer)[3] = static_cast<char>(0x80);
+    SetUint16(answer, 4, 1);
+    SetUint16(answer, 6, is_a ? 1 : 0);
+    SetUint16(answer, 8, 0);
+    SetUint16(answer, 10, 0);
+    if (is_a) {
+      // A pointer to the question's name, type A, class IN, TTL of 60s.
+      const char kRecord[] = {'\xc0', '\x0c', 0, 1, 0, 1, 0, 0, 0, 60, 0, 4};
+      answer->append(kRecord, sizeof(kRecord));
+      answer->append(reinterpret_cast<const char*>(&address_),
+                     sizeof(address_));
+    }
+    return true;
+  }
+
+  void SendLocked(const Answer& answer) {
+    sendto(socket_, answer.data.data(), answer.data.size(), 0,
+           reinterpret_cast<const sockaddr*>(&answer.to), answer.to_len);
+  }
+
+  int socket_;
+  std::thread thread_;
+  std::mutex mu_;
+  bool shutdown_ = false;
+  in_addr address_;
+  bool holding_ = false;
+  std::vector<Answer> held_;
+  int num_lookups_ = 0;
+};
+
+class DnsCacheTest;
+
+// A grpc_dns_lookup_ares_locked() call, made under the test's combiner.
+struct Lookup {
+  Lookup(DnsCacheTest* test, const char* name) : test(test), name(name) {}
+  ~Lookup() {
+    GRPC_ERROR_UNREF(error);
+    gpr_free(request);
+  }
+
+  // The single address looked up, or "" if the lookup failed.
+  std::string address() const {
+    if (addresses == nullptr || addresses->size() != 1) return "";
+    char* str;
+    grpc_sockaddr_to_string(&str, &(*addresses)[0].address(),
+                            false /* normalize */);
+    std::string result(str);
+    gpr_free(str);
+    return result;
+  }
+
+  DnsCacheTest* test;
+  std::string name;
+  grpc_closure on_start;
+  grpc_closure on_cancel;
+  grpc_closure on_done;
+  grpc_ares_request* request = nullptr;
+  grpc_core::UniquePtr<grpc_core::ServerAddressList> addresses;
+  grpc_error* error = GRPC_ERROR_NONE;
+  std::atomic<bool> done{false};
+};
+
+class DnsCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    GPR_GLOBAL_CONFIG_SET(grpc_dns_resolver, "ares");
+    const int port = grpc_pick_unused_port_or_die();
+    server_.reset(new FakeDnsServer(port));
+    char* dns_server;
+    gpr_asprintf(&dns_server, "127.0.0.1:%d", port);
+    dns_server_ = dns_server;
+    gpr_free(dns_server);
+  }
+
+  void TearDown() override {
+    if (pollset_ != nullptr) ShutdownGrpc();
+    GPR_GLOBAL_CONFIG_SET(grpc_dns_cache_ttl_ms, 0);
+    GPR_GLOBAL_CONFIG_SET(grpc_dns_cache_stale_ms, 0);
+    server_.reset();
+  }
+
+  // The cache settings are read when gRPC is initialized.
+  void InitGrpc(int32_t ttl_ms, int32_t stale_ms) {
+    GPR_GLOBAL_CONFIG_SET(grpc_dns_cache_ttl_ms, ttl_ms);
+    GPR_GLOBAL_CONFIG_SET(grpc_dns_cache_stale_ms, stale_ms);
+    grpc_init();
+    grpc_core::ExecCtx exec_ctx;
+    pollset_ = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(pollset_, &mu_);
+    pollset_set_ = grpc_pollset_set_create();
+    grpc_pollset_set_add_pollset(pollset_set_, pollset_);
+    combiner_ = grpc_combiner_create();
+  }
+
+  void ShutdownGrpc() {
+    {
+      grpc_core::ExecCtx exec_ctx;
+      grpc_pollset_set_del_pollset(pollset_set_, pollset_);
+      grpc_pollset_set_destroy(pollset_set_);
+      grpc_closure on_shutdown;
+      GRPC_CLOSURE_INIT(&on_shutdown, [](void*, grpc_error*) {}, nullptr,
+                        grpc_schedule_on_exec_ctx);
+      grpc_pollset_shutdown(pollset_, &on_shutdown);
+      grpc_core::ExecCtx::Get()->Flush();
+      grpc_pollset_destroy(pollset_);
+      gpr_free(pollset_);
+      pollset_ = nullptr;
+      GRPC_COMBINER_UNREF(combiner_, "test");
+    }
+    grpc_shutdown_blocking();
+  }
+
+  std::unique_ptr<Lookup> StartLookup(const char* name) {
+    std::unique_ptr<Lookup> lookup(new Lookup(this, name));
+    grpc_core::ExecCtx exec_ctx;
+    GRPC_CLOSURE_SCHED(
+        GRPC_CLOSURE_INIT(&lookup->on_start, StartLocked, lookup.get(),
+                          grpc_combiner_scheduler(combiner_)),
+        GRPC_ERROR_NONE);
+    return lookup;
+  }
+
+  void CancelLookup(Lookup* lookup) {
+    grpc_core::ExecCtx exec_ctx;
+    GRPC_CLOSURE_SCHED(
+        GRPC_CLOSURE_INIT(&lookup->on_cancel, CancelLocked, lookup,
+                          grpc_combiner_scheduler(combiner_)),
+        GRPC_ERROR_NONE);
+  }
+
+  // Polls until done() returns true, for up to five seconds.
+  bool PollUntil(const std::function<bool()>& done) {
+    const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(5);
+    while (!done()) {
+      if (gpr_time_cmp(gpr_now(deadline.clock_type), deadline) > 0) {
+        return false;
+      }
+      grpc_core::ExecCtx exec_ctx;
+      grpc_pollset_worker* worker = nullptr;
+      gpr_mu_lock(mu_);
+      GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(pollset_, &worker,
+                            grpc_core::ExecCtx::Get()->Now() + 10));
+      gpr_mu_unlock(mu_);
+    }
+    return true;
+  }
+
+  bool WaitForLookup(Lookup* lookup) {
+    return PollUntil([lookup]() { return lookup->done.load(); });
+  }
+
+  bool WaitForServerLookups(int n) {
+    return PollUntil([this, n]() { return server_->num_lookups() >= n; });
+  }
+
+  // Polls for a while, to let lookups that shouldn't happen reach the
+  // server.
+  void PollFor(int ms) {
+    const gpr_timespec deadline = grpc_timeout_milliseconds_to_deadline(ms);
+    PollUntil([deadline]() {
+      return gpr_time_cmp(gpr_now(deadline.clock_type), deadline) > 0;
+    });
+  }
+
+  std::unique_ptr<FakeDnsServer> server_;
+  std::string dns_server_;
+
+ private:
+  static void StartLocked(void* arg, grpc_error* error) {
+    Lookup* lookup = static_cast<Lookup*>(arg);
+    DnsCacheTest* test = lookup->test;
+    GRPC_CLOSURE_INIT(&lookup->on_done, OnDone, lookup,
+                      grpc_schedule_on_exec_ctx);
+    lookup->request = grpc_dns_lookup_ares_locked(
+        test->dns_server_.c_str(), lookup->name.c_str(), "443",
+        test->pollset_set_, &lookup->on_done, &lookup->addresses,
+        false /* check_grpclb */, nullptr /* service_config_json */,
+        GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS, test->combiner_);
+  }
+
+  static void CancelLocked(void* arg, grpc_error* error) {
+    Lookup* lookup = static_cast<Lookup*>(arg);
+    grpc_cancel_ares_request_locked(lookup->request);
+  }
+
+  static void OnDone(void* arg, grpc_error* error) {
+    Lookup* lookup = static_cast<Lookup*>(arg);
+    DnsCacheTest* test = lookup->test;
+    lookup->error = GRPC_ERROR_REF(error);
+    lookup->done.store(true);
+    gpr_mu_lock(test->mu_);
+    GRPC_LOG_IF_ERROR("pollset_kick",
+                      grpc_pollset_kick(test->pollset_, nullptr));
+    gpr_mu_unlock(test->mu_);
+  }
+
+  gpr_mu* mu_ = nullptr;
+  grpc_pollset* pollset_ = nullptr;
+  grpc_pollset_set* pollset_set_ = nullptr;
+  grpc_combiner* combiner_ = nullptr;
+};
+
+TEST_F(DnsCacheTest, ConcurrentLookupsShareOneQuery) {
+  InitGrpc(60000 /* ttl_ms */, 0 /* stale_ms */);
+  server_->HoldAnswers();
+  std::unique_ptr<Lookup> lookups[3];
+  for (auto& lookup : lookups) lookup = StartLookup("single.flight.test");
+  ASSERT_TRUE(WaitForServerLookups(1));
+  PollFor(200);
+  EXPECT_EQ(1, server_->num_lookups());
+  server_->ReleaseAnswers();
+  for (auto& lookup : lookups) {
+    ASSERT_TRUE(WaitForLookup(lookup.get()));
+    EXPECT_EQ(GRPC_ERROR_NONE, lookup->error);
+    EXPECT_EQ("10.0.0.1:443", lookup->address());
+  }
+  // Later lookups are answered from the cache.
+  std::unique_ptr<Lookup> cached = StartLookup("single.flight.test");
+  ASSERT_TRUE(WaitForLookup(cached.get()));
+  EXPECT_EQ("10.0.0.1:443", cached->address());
+  EXPECT_EQ(1, server_->num_lookups());
+  // Other names are looked up separately.
+  std::unique_ptr<Lookup> other = StartLookup("other.name.test");
+  ASSERT_TRUE(WaitForLookup(other.get()));
+  EXPECT_EQ("10.0.0.1:443", other->address());
+  EXPECT_EQ(2, server_->num_lookups());
+}
+
+TEST_F(DnsCacheTest, StaleResultIsReturnedWhileRefreshed) {
+  const int kTtlMs = 100;
+  InitGrpc(kTtlMs, 60000 /* stale_ms */);
+  std::unique_ptr<Lookup> first = StartLookup("stale.result.test");
+  ASSERT_TRUE(WaitForLookup(first.get()));
+  EXPECT_EQ("10.0.0.1:443", first->address());
+  EXPECT_EQ(1, server_->num_lookups());
+  server_->SetAddress("10.0.0.2");
+  server_->HoldAnswers();
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(2 * kTtlMs));
+  // Past the TTL, the old result is returned right away, and refreshed in
+  // the background.
+  std::unique_ptr<Lookup> stale = StartLookup("stale.result.test");
+  ASSERT_TRUE(WaitForLookup(stale.get()));
+  EXPECT_EQ(GRPC_ERROR_NONE, stale->error);
+  EXPECT_EQ("10.0.0.1:443", stale->address());
+  ASSERT_TRUE(WaitForServerLookups(2));
+  // Lookups during the refresh don't start another one.
+  std::unique_ptr<Lookup> during_refresh = StartLookup("stale.result.test");
+  ASSERT_TRUE(WaitForLookup(during_refresh.get()));
+  EXPECT_EQ("10.0.0.1:443", during_refresh->address());
+  server_->ReleaseAnswers();
+  // Once the refresh completes, its result is returned.
+  std::string address;
+  ASSERT_TRUE(PollUntil([this, &address]() {
+    std::unique_ptr<Lookup> lookup = StartLookup("stale.result.test");
+    if (!WaitForLookup(lookup.get())) return false;
+    address = lookup->address();
+    return address == "10.0.0.2:443";
+  }));
+  EXPECT_EQ(2, server_->num_lookups());
+}
+
+TEST_F(DnsCacheTest, CancelledWaiterIsFailedAndOthersKeepWaiting) {
+  InitGrpc(60000 /* ttl_ms */, 0 /* stale_ms */);
+  server_->HoldAnswers();
+  std::unique_ptr<Lookup> cancelled = StartLookup("cancel.waiter.test");
+  std::unique_ptr<Lookup> waiting = StartLookup("cancel.waiter.test");
+  ASSERT_TRUE(WaitForServerLookups(1));
+  CancelLookup(cancelled.get());
+  ASSERT_TRUE(WaitForLookup(cancelled.get()));
+  EXPECT_NE(GRPC_ERROR_NONE, cancelled->error);
+  EXPECT_EQ(nullptr, cancelled->addresses.get());
+  EXPECT_FALSE(waiting->done.load());
+  // The lookup itself carries on for the other request.
+  server_->ReleaseAnswers();
+  ASSERT_TRUE(WaitForLookup(waiting.get()));
+  EXPECT_EQ(GRPC_ERROR_NONE, waiting->error);
+  EXPECT_EQ("10.0.0.1:443", waiting->address());
+  EXPECT_EQ(1, server_->num_lookups());
+}
+
+TEST_F(DnsCacheTest, ShutdownWithLookupInFlight) {
+  InitGrpc(60000 /* ttl_ms */, 0 /* stale_ms */);
+  std::unique_ptr<Lookup> cached = StartLookup("shutdown.test");
+  ASSERT_TRUE(WaitForLookup(cached.get()));
+  EXPECT_EQ(1, server_->num_lookups());
+  server_->HoldAnswers();
+  std::unique_ptr<Lookup> in_flight = StartLookup("shutdown.in.flight.test");
+  ASSERT_TRUE(WaitForServerLookups(2));
+  // Resolvers cancel their requests before gRPC is shut down; the cache's
+  // own lookup is cancelled by the shutdown.
+  CancelLookup(in_flight.get());
+  ASSERT_TRUE(WaitForLookup(in_flight.get()));
+  cached.reset();
+  in_flight.reset();
+  ShutdownGrpc();
+  // The cache starts out empty again.
+  server_->ReleaseAnswers();
+  InitGrpc(60000 /* ttl_ms */, 0 /* stale_ms */);
+  std::unique_ptr<Lookup> after_restart = StartLookup("shutdown.test");
+  ASSERT_TRUE(WaitForLookup(after_restart.get()));
+  EXPECT_EQ("10.0.0.1:443", after_restart->address());
+  EXPECT_EQ(3, server_->num_lookups());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
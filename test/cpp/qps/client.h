@@ -129,6 +129,23 @@ class HistogramEntry final {
   int status_;
 };
 
+// Returns the time an open-loop client scheduled an RPC to be issued at, on
+// the UsageTimer::Now() clock.
+inline double IssueTimeToUsageTime(const gpr_timespec& issue_time) {
+  const gpr_timespec t = gpr_convert_clock_type(issue_time, GPR_CLOCK_REALTIME);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+// Returns the time to measure an RPC's latency from. Open-loop clients
+// measure from when the RPC was scheduled to be issued rather than from when
+// it was: a client that falls behind its schedule issues RPCs late, and not
+// charging that delay to them would hide it from the latency distribution
+// (coordinated omission).
+inline double RpcStartTime(bool open_loop, double scheduled_start) {
+  const double now = UsageTimer::Now();
+  return open_loop && scheduled_start < now ? scheduled_start : now;
+}
+
 typedef std::unordered_map<int, int64_t> StatusHistogram;
 
 inline void MergeStatusHistogram(const StatusHistogram& from,
@@ -145,7 +162,8 @@ class Client {
       : timer_(new UsageTimer),
         interarrival_timer_(),
         started_requests_(false),
-        last_reset_poll_count_(0) {
+        last_reset_poll_count_(0),
+        initial_memory_bytes_(UsageTimer::ResidentMemoryBytes()) {
     gpr_event_init(&start_requests_);
   }
   virtual ~Client() {}
@@ -211,6 +229,10 @@ class Client {
     stats.set_time_user(timer_result.user);
     stats.set_cq_poll_count(poll_count);
     CoreStatsToProto(core_stats, stats.mutable_core_stats());
+    const unsigned long long memory_bytes = UsageTimer::ResidentMemoryBytes();
+    stats.set_memory_growth_bytes(memory_bytes > initial_memory_bytes_
+                                      ? memory_bytes - initial_memory_bytes_
+                                      : 0);
     return stats;
   }
 
@@ -403,6 +425,7 @@ class Client {
   bool started_requests_;
 
   int last_reset_poll_count_;
+  const unsigned long long initial_memory_bytes_;
 
   void MaybeStartRequests() {
     if (!started_requests_) {
@@ -432,6 +455,11 @@ class ClientImpl : public Client {
           config.server_targets(i % config.server_targets_size()), config,
           create_stub_, i);
     }
+    for (int i = 0; i < config.idle_client_channels(); i++) {
+      idle_channels_.emplace_back(
+          config.server_targets(i % config.server_targets_size()), config,
+          create_stub_, config.client_channels() + i);
+    }
     WaitForChannelsToConnect();
     median_latency_collection_interval_seconds_ =
         config.median_latency_collection_interval_millis() / 1e3;
@@ -461,16 +489,18 @@ class ClientImpl : public Client {
         gpr_time_from_seconds(connect_deadline_seconds, GPR_TIMESPAN));
     CompletionQueue cq;
     size_t num_remaining = 0;
-    for (auto& c : channels_) {
-      if (!c.is_inproc()) {
-        Channel* channel = c.get_channel();
-        grpc_connectivity_state last_observed = channel->GetState(true);
-        if (last_observed == GRPC_CHANNEL_READY) {
-          gpr_log(GPR_INFO, "Channel %p connected!", channel);
-        } else {
-          num_remaining++;
-          channel->NotifyOnStateChange(last_observed, connect_deadline, &cq,
-                                       channel);
+    for (auto* channels : {&channels_, &idle_channels_}) {
+      for (auto& c : *channels) {
+        if (!c.is_inproc()) {
+          Channel* channel = c.get_channel();
+          grpc_connectivity_state last_observed = channel->GetState(true);
+          if (last_observed == GRPC_CHANNEL_READY) {
+            gpr_log(GPR_INFO, "Channel %p connected!", channel);
+          } else {
+            num_remaining++;
+            channel->NotifyOnStateChange(last_observed, connect_deadline, &cq,
+                                         channel);
+          }
         }
       }
     }
@@ -558,6 +588,8 @@ class ClientImpl : public Client {
     bool is_inproc_;
   };
   std::vector<ClientChannelInfo> channels_;
+  // Channels that are connected but not used, see idle_client_channels.
+  std::vector<ClientChannelInfo> idle_channels_;
   std::function<std::unique_ptr<StubType>(const std::shared_ptr<Channel>&)>
       create_stub_;
 };
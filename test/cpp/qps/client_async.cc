@@ -89,7 +89,8 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   bool RunNextState(bool ok, HistogramEntry* entry) override {
     switch (next_state_) {
       case State::READY:
-        start_ = UsageTimer::Now();
+        start_ =
+            RpcStartTime(static_cast<bool>(next_issue_), scheduled_start_);
         response_reader_ = prepare_req_(stub_, &context_, req_, cq_);
         response_reader_->StartCall();
         next_state_ = State::RESP_DONE;
@@ -132,6 +133,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  double scheduled_start_ = 0;
   std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>
       response_reader_;
 
@@ -141,7 +143,9 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       RunNextState(true, nullptr);
     } else {  // wait for the issue time
       alarm_.reset(new Alarm);
-      alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+      const gpr_timespec issue_time = next_issue_();
+      scheduled_start_ = IssueTimeToUsageTime(issue_time);
+      alarm_->Set(cq_, issue_time, ClientRpcContext::tag(this));
     }
   }
 };
@@ -367,16 +371,20 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
             next_state_ = State::WAIT;
           }
           break;  // loop around, don't return
-        case State::WAIT:
+        case State::WAIT: {
           next_state_ = State::READY_TO_WRITE;
           alarm_.reset(new Alarm);
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          const gpr_timespec issue_time = next_issue_();
+          scheduled_start_ = IssueTimeToUsageTime(issue_time);
+          alarm_->Set(cq_, issue_time, ClientRpcContext::tag(this));
           return true;
+        }
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          start_ =
+              RpcStartTime(static_cast<bool>(next_issue_), scheduled_start_);
           next_state_ = State::WRITE_DONE;
           if (coalesce_ && messages_issued_ == messages_per_stream_ - 1) {
             stream_->WriteLast(req_, WriteOptions(),
@@ -456,6 +464,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  double scheduled_start_ = 0;
   std::unique_ptr<grpc::ClientAsyncReaderWriter<RequestType, ResponseType>>
       stream_;
 
@@ -552,16 +561,20 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
             next_state_ = State::WAIT;
           }
           break;  // loop around, don't return
-        case State::WAIT:
+        case State::WAIT: {
           alarm_.reset(new Alarm);
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          const gpr_timespec issue_time = next_issue_();
+          scheduled_start_ = IssueTimeToUsageTime(issue_time);
+          alarm_->Set(cq_, issue_time, ClientRpcContext::tag(this));
           next_state_ = State::READY_TO_WRITE;
           return true;
+        }
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          start_ =
+              RpcStartTime(static_cast<bool>(next_issue_), scheduled_start_);
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -608,6 +621,7 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  double scheduled_start_ = 0;
   std::unique_ptr<grpc::ClientAsyncWriter<RequestType>> stream_;
 
   void StartInternal(CompletionQueue* cq) {
@@ -797,16 +811,20 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
             next_state_ = State::WAIT;
           }
           break;  // loop around, don't return
-        case State::WAIT:
+        case State::WAIT: {
           next_state_ = State::READY_TO_WRITE;
           alarm_.reset(new Alarm);
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          const gpr_timespec issue_time = next_issue_();
+          scheduled_start_ = IssueTimeToUsageTime(issue_time);
+          alarm_->Set(cq_, issue_time, ClientRpcContext::tag(this));
           return true;
+        }
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          start_ =
+              RpcStartTime(static_cast<bool>(next_issue_), scheduled_start_);
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -876,6 +894,7 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
       prepare_req_;
   grpc::Status status_;
   double start_;
+  double scheduled_start_ = 0;
   std::unique_ptr<grpc::GenericClientAsyncReaderWriter> stream_;
 
   // Allow a limit on number of messages in a stream
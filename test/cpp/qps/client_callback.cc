@@ -173,18 +173,20 @@ class CallbackUnaryClient final : public CallbackClient {
       if (ctx_[vector_idx]->alarm_ == nullptr) {
         ctx_[vector_idx]->alarm_.reset(new Alarm);
       }
+      const double scheduled_start = IssueTimeToUsageTime(next_issue_time);
       ctx_[vector_idx]->alarm_->experimental().Set(
-          next_issue_time, [this, t, vector_idx](bool ok) {
-            IssueUnaryCallbackRpc(t, vector_idx);
+          next_issue_time, [this, t, vector_idx, scheduled_start](bool ok) {
+            IssueUnaryCallbackRpc(t, vector_idx, scheduled_start);
           });
     } else {
-      IssueUnaryCallbackRpc(t, vector_idx);
+      IssueUnaryCallbackRpc(t, vector_idx, 0);
     }
   }
 
-  void IssueUnaryCallbackRpc(Thread* t, size_t vector_idx) {
+  void IssueUnaryCallbackRpc(Thread* t, size_t vector_idx,
+                             double scheduled_start) {
     GPR_TIMER_SCOPE("CallbackUnaryClient::ThreadFunc", 0);
-    double start = UsageTimer::Now();
+    double start = RpcStartTime(!closed_loop_, scheduled_start);
     ctx_[vector_idx]->stub_->experimental_async()->UnaryCall(
         (&ctx_[vector_idx]->context_), &request_, &ctx_[vector_idx]->response_,
         [this, t, start, vector_idx](grpc::Status s) {
@@ -293,10 +295,12 @@ class CallbackStreamingPingPongReactor final
       gpr_timespec next_issue_time = client_->NextRPCIssueTime();
       // Start an alarm callback to run the internal callback after
       // next_issue_time
-      ctx_->alarm_->experimental().Set(next_issue_time, [this](bool ok) {
-        write_time_ = UsageTimer::Now();
-        StartWrite(client_->request());
-      });
+      const double scheduled_start = IssueTimeToUsageTime(next_issue_time);
+      ctx_->alarm_->experimental().Set(
+          next_issue_time, [this, scheduled_start](bool ok) {
+            write_time_ = RpcStartTime(true, scheduled_start);
+            StartWrite(client_->request());
+          });
     } else {
       write_time_ = UsageTimer::Now();
       StartWrite(client_->request());
@@ -80,10 +80,15 @@ class SynchronousClient
   }
 
  protected:
-  // WaitToIssue returns false if we realize that we need to break out
-  bool WaitToIssue(int thread_idx) {
+  // WaitToIssue returns false if we realize that we need to break out. In
+  // open-loop mode it sets scheduled_start, if not null, to when the RPC was
+  // due (see RpcStartTime).
+  bool WaitToIssue(int thread_idx, double* scheduled_start = nullptr) {
     if (!closed_loop_) {
       const gpr_timespec next_issue_time = NextIssueTime(thread_idx);
+      if (scheduled_start != nullptr) {
+        *scheduled_start = IssueTimeToUsageTime(next_issue_time);
+      }
       // Avoid sleeping for too long continuously because we might
       // need to terminate before then. This is an issue since
       // exponential distribution can occasionally produce bad outliers
@@ -120,11 +125,12 @@ class SynchronousUnaryClient final : public SynchronousClient {
   bool InitThreadFuncImpl(size_t thread_idx) override { return true; }
 
   bool ThreadFuncImpl(HistogramEntry* entry, size_t thread_idx) override {
-    if (!WaitToIssue(thread_idx)) {
+    double scheduled_start = 0;
+    if (!WaitToIssue(thread_idx, &scheduled_start)) {
       return true;
     }
     auto* stub = channels_[thread_idx % channels_.size()].get_stub();
-    double start = UsageTimer::Now();
+    double start = RpcStartTime(!closed_loop_, scheduled_start);
     GPR_TIMER_SCOPE("SynchronousUnaryClient::ThreadFunc", 0);
     grpc::ClientContext context;
     grpc::Status s =
@@ -240,11 +246,12 @@ class SynchronousStreamingPingPongClient final
   }
 
   bool ThreadFuncImpl(HistogramEntry* entry, size_t thread_idx) override {
-    if (!WaitToIssue(thread_idx)) {
+    double scheduled_start = 0;
+    if (!WaitToIssue(thread_idx, &scheduled_start)) {
       return true;
     }
     GPR_TIMER_SCOPE("SynchronousStreamingPingPongClient::ThreadFunc", 0);
-    double start = UsageTimer::Now();
+    double start = RpcStartTime(!closed_loop_, scheduled_start);
     if (stream_[thread_idx]->Write(request_) &&
         stream_[thread_idx]->Read(&responses_[thread_idx])) {
       entry->set_value((UsageTimer::Now() - start) * 1e9);
@@ -116,10 +116,18 @@ static double ServerTotalCpuTime(const ServerStats& s) {
 static double ServerIdleCpuTime(const ServerStats& s) {
   return s.idle_cpu_time();
 }
+static double ServerMemoryGrowth(const ServerStats& s) {
+  return s.memory_growth_bytes();
+}
+static double ClientMemoryGrowth(const ClientStats& s) {
+  return s.memory_growth_bytes();
+}
 static int Cores(int n) { return n; }
 
-// Postprocess ScenarioResult and populate result summary.
-static void postprocess_scenario_result(ScenarioResult* result) {
+// Postprocess ScenarioResult and populate result summary. num_connections is
+// the number of channels, active and idle, of all clients.
+static void postprocess_scenario_result(ScenarioResult* result,
+                                        int num_connections) {
   Histogram histogram;
   histogram.MergeProto(result->latencies());
 
@@ -134,6 +142,7 @@ static void postprocess_scenario_result(ScenarioResult* result) {
   result->mutable_summary()->set_latency_95(histogram.Percentile(95));
   result->mutable_summary()->set_latency_99(histogram.Percentile(99));
   result->mutable_summary()->set_latency_999(histogram.Percentile(99.9));
+  result->mutable_summary()->set_latency_9999(histogram.Percentile(99.99));
 
   auto server_system_time = 100.0 *
                             sum(result->server_stats(), ServerSystemTime) /
@@ -195,6 +204,13 @@ static void postprocess_scenario_result(ScenarioResult* result) {
       server_queries_per_cpu_sec);
   result->mutable_summary()->set_client_queries_per_cpu_sec(
       client_queries_per_cpu_sec);
+
+  if (num_connections > 0) {
+    result->mutable_summary()->set_server_memory_bytes_per_connection(
+        sum(result->server_stats(), ServerMemoryGrowth) / num_connections);
+    result->mutable_summary()->set_client_memory_bytes_per_connection(
+        sum(result->client_stats(), ClientMemoryGrowth) / num_connections);
+  }
 }
 
 std::vector<grpc::testing::Server*>* g_inproc_servers = nullptr;
@@ -338,6 +354,7 @@ std::unique_ptr<ScenarioResult> RunScenario(
   };
   std::vector<ClientData> clients(num_clients);
   size_t channels_allocated = 0;
+  size_t idle_channels_allocated = 0;
   for (size_t i = 0; i < num_clients; i++) {
     const auto& worker = workers[i + num_servers];
     gpr_log(GPR_INFO, "Starting client on %s (worker #%" PRIuPTR ")",
@@ -367,6 +384,12 @@ std::unique_ptr<ScenarioResult> RunScenario(
     gpr_log(GPR_DEBUG, "Client %" PRIdPTR " gets %" PRIdPTR " channels", i,
             num_channels);
     per_client_config.set_client_channels(num_channels);
+    // Idle channels are split the same way.
+    size_t num_idle_channels =
+        (client_config.idle_client_channels() - idle_channels_allocated) /
+        (num_clients - i);
+    idle_channels_allocated += num_idle_channels;
+    per_client_config.set_idle_client_channels(num_idle_channels);
 
     ClientArgs args;
     *args.mutable_setup() = per_client_config;
@@ -535,7 +558,9 @@ std::unique_ptr<ScenarioResult> RunScenario(
   if (g_inproc_servers != nullptr) {
     delete g_inproc_servers;
   }
-  postprocess_scenario_result(result.get());
+  postprocess_scenario_result(
+      result.get(),
+      client_config.client_channels() + client_config.idle_client_channels());
   return result;
 }
 
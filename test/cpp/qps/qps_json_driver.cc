@@ -144,6 +144,7 @@ static std::unique_ptr<ScenarioResult> RunAndReport(
   GetReporter()->ReportCpuUsage(*result);
   GetReporter()->ReportPollCount(*result);
   GetReporter()->ReportQueriesPerCpuSec(*result);
+  GetReporter()->ReportMemoryPerConnection(*result);
 
   for (int i = 0; *success && i < result->client_success_size(); i++) {
     *success = result->client_success(i);
@@ -78,6 +78,13 @@ void CompositeReporter::ReportQueriesPerCpuSec(const ScenarioResult& result) {
   }
 }
 
+void CompositeReporter::ReportMemoryPerConnection(
+    const ScenarioResult& result) {
+  for (size_t i = 0; i < reporters_.size(); ++i) {
+    reporters_[i]->ReportMemoryPerConnection(result);
+  }
+}
+
 void GprLogReporter::ReportQPS(const ScenarioResult& result) {
   gpr_log(GPR_INFO, "QPS: %.1f", result.summary().qps());
   if (result.summary().failed_requests_per_second() > 0) {
@@ -125,12 +132,14 @@ void GprLogReporter::ReportQPSPerCore(const ScenarioResult& result) {
 
 void GprLogReporter::ReportLatency(const ScenarioResult& result) {
   gpr_log(GPR_INFO,
-          "Latencies (50/90/95/99/99.9%%-ile): %.1f/%.1f/%.1f/%.1f/%.1f us",
+          "Latencies (50/90/95/99/99.9/99.99%%-ile): "
+          "%.1f/%.1f/%.1f/%.1f/%.1f/%.1f us",
           result.summary().latency_50() / 1000,
           result.summary().latency_90() / 1000,
           result.summary().latency_95() / 1000,
           result.summary().latency_99() / 1000,
-          result.summary().latency_999() / 1000);
+          result.summary().latency_999() / 1000,
+          result.summary().latency_9999() / 1000);
 }
 
 void GprLogReporter::ReportTimes(const ScenarioResult& result) {
@@ -163,6 +172,13 @@ void GprLogReporter::ReportQueriesPerCpuSec(const ScenarioResult& result) {
           result.summary().client_queries_per_cpu_sec());
 }
 
+void GprLogReporter::ReportMemoryPerConnection(const ScenarioResult& result) {
+  gpr_log(GPR_INFO, "Server memory per connection: %.0f bytes",
+          result.summary().server_memory_bytes_per_connection());
+  gpr_log(GPR_INFO, "Client memory per connection: %.0f bytes",
+          result.summary().client_memory_bytes_per_connection());
+}
+
 void JsonReporter::ReportQPS(const ScenarioResult& result) {
   grpc::string json_string =
       SerializeJson(result, "type.googleapis.com/grpc.testing.ScenarioResult");
@@ -195,6 +211,10 @@ void JsonReporter::ReportQueriesPerCpuSec(const ScenarioResult& result) {
   // NOP - all reporting is handled by ReportQPS.
 }
 
+void JsonReporter::ReportMemoryPerConnection(const ScenarioResult& result) {
+  // NOP - all reporting is handled by ReportQPS.
+}
+
 void RpcReporter::ReportQPS(const ScenarioResult& result) {
   grpc::ClientContext context;
   grpc::Status status;
@@ -235,5 +255,9 @@ void RpcReporter::ReportQueriesPerCpuSec(const ScenarioResult& result) {
   // NOP - all reporting is handled by ReportQPS.
 }
 
+void RpcReporter::ReportMemoryPerConnection(const ScenarioResult& result) {
+  // NOP - all reporting is handled by ReportQPS.
+}
+
 }  // namespace testing
 }  // namespace grpc
@@ -41,7 +41,9 @@ namespace testing {
 class Server {
  public:
   explicit Server(const ServerConfig& config)
-      : timer_(new UsageTimer), last_reset_poll_count_(0) {
+      : timer_(new UsageTimer),
+        last_reset_poll_count_(0),
+        initial_memory_bytes_(UsageTimer::ResidentMemoryBytes()) {
     cores_ = gpr_cpu_num_cores();
     if (config.port()) {  // positive for a fixed port, negative for inproc
       port_ = config.port();
@@ -75,6 +77,10 @@ class Server {
     stats.set_idle_cpu_time(timer_result.idle_cpu_time);
     stats.set_cq_poll_count(poll_count);
     CoreStatsToProto(core_stats, stats.mutable_core_stats());
+    const unsigned long long memory_bytes = UsageTimer::ResidentMemoryBytes();
+    stats.set_memory_growth_bytes(memory_bytes > initial_memory_bytes_
+                                      ? memory_bytes - initial_memory_bytes_
+                                      : 0);
     return stats;
   }
 
@@ -148,6 +154,7 @@ class Server {
   int cores_;
   std::unique_ptr<UsageTimer> timer_;
   int last_reset_poll_count_;
+  const unsigned long long initial_memory_bytes_;
 };
 
 std::unique_ptr<Server> CreateSynchronousServer(const ServerConfig& config);
@@ -27,6 +27,7 @@
 #ifdef __linux__
 #include <sys/resource.h>
 #include <sys/time.h>
+#include <unistd.h>
 
 static double time_double(struct timeval* tv) {
   return tv->tv_sec + 1e-6 * tv->tv_usec;
@@ -40,6 +41,19 @@ double UsageTimer::Now() {
   return ts.tv_sec + 1e-9 * ts.tv_nsec;
 }
 
+unsigned long long UsageTimer::ResidentMemoryBytes() {
+#ifdef __linux__
+  std::ifstream proc_statm("/proc/self/statm");
+  unsigned long long size_pages = 0;
+  unsigned long long resident_pages = 0;
+  if (!(proc_statm >> size_pages >> resident_pages)) return 0;
+  return resident_pages *
+         static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
+#else
+  return 0;
+#endif
+}
+
 static void get_resource_usage(double* utime, double* stime) {
 #ifdef __linux__
   struct rusage usage;
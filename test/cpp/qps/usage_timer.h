@@ -35,6 +35,9 @@ class UsageTimer {
 
   static double Now();
 
+  // Returns the resident memory of the process, or 0 if unknown.
+  static unsigned long long ResidentMemoryBytes();
+
  private:
   static Result Sample();
 
@@ -17,6 +17,9 @@
  */
 
 #include <signal.h>
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
 
 #include <chrono>
 #include <thread>
@@ -24,6 +27,7 @@
 
 #include <gflags/gflags.h>
 #include <grpc/grpc.h>
+#include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
 #include "test/cpp/qps/qps_worker.h"
@@ -44,6 +48,23 @@ namespace testing {
 
 std::vector<grpc::testing::Server*>* g_inproc_servers = nullptr;
 
+// Scenarios with many idle channels need a file descriptor per connection,
+// often more than the default soft limit, so raise it as far as allowed.
+static void RaiseOpenFileLimit() {
+#ifdef __linux__
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) != 0 ||
+      limit.rlim_cur >= limit.rlim_max) {
+    return;
+  }
+  limit.rlim_cur = limit.rlim_max;
+  if (setrlimit(RLIMIT_NOFILE, &limit) == 0) {
+    gpr_log(GPR_INFO, "Raised the open file limit to %llu",
+            static_cast<unsigned long long>(limit.rlim_cur));
+  }
+#endif
+}
+
 static void RunServer() {
   QpsWorker worker(FLAGS_driver_port, FLAGS_server_port, FLAGS_credential_type);
 
@@ -61,6 +82,7 @@ int main(int argc, char** argv) {
 
   signal(SIGINT, sigint_handler);
 
+  grpc::testing::RaiseOpenFileLimit();
   grpc::testing::RunServer();
 
   return 0;
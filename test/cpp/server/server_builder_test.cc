@@ -83,6 +83,26 @@ TEST_F(ServerBuilderTest, CreateServerRepeatedPortWithDisallowedReusePort) {
             nullptr);
 }
 
+TEST_F(ServerBuilderTest, CreateServerWithReusePortListenerAffinity) {
+  ServerBuilder()
+      .RegisterService(&g_service)
+      .AddListeningPort(GetPort(), InsecureServerCredentials())
+      .SetSyncServerOption(ServerBuilder::SyncServerOption::NUM_CQS, 4)
+      .SetReusePortListenerAffinity(true)
+      .BuildAndStart()
+      ->Shutdown();
+}
+
+TEST_F(ServerBuilderTest, CreateServerWithNumaThreadPlacement) {
+  ServerBuilder()
+      .RegisterService(&g_service)
+      .AddListeningPort(GetPort(), InsecureServerCredentials())
+      .SetSyncServerOption(ServerBuilder::SyncServerOption::NUM_CQS, 4)
+      .SetNumaThreadPlacement(true)
+      .BuildAndStart()
+      ->Shutdown();
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -42,13 +42,16 @@ struct ThreadManagerTestSettings {
   int work_duration_ms;
   // Max number of times PollForWork() is called before shutting down
   int max_poll_calls;
+  // The number of idle threads to keep parked
+  int warm_threads;
 };
 
 class ThreadManagerTest final : public grpc::ThreadManager {
  public:
   ThreadManagerTest(const char* name, grpc_resource_quota* rq,
                     const ThreadManagerTestSettings& settings)
-      : ThreadManager(name, rq, settings.min_pollers, settings.max_pollers),
+      : ThreadManager(name, rq, settings.min_pollers, settings.max_pollers,
+                      settings.warm_threads),
         settings_(settings),
         num_do_work_(0),
         num_poll_for_work_(0),
@@ -186,6 +189,26 @@ static void TestThreadQuota() {
   GPR_ASSERT(max1 <= kMaxNumThreads && max2 <= kMaxNumThreads);
 }
 
+// Test that warm threads are created up front, take over polling when work
+// keeps the pollers busy, and finish when the thread manager shuts down
+static void TestWarmThreads() {
+  grpc_resource_quota* rq = grpc_resource_quota_create("Test-warm-threads");
+  grpc::ThreadManagerTestSettings settings = {
+      1 /* min_pollers */,      1 /* max_pollers */, 1 /* poll_duration_ms */,
+      10 /* work_duration_ms */, 50 /* max_poll_calls */, 3 /* warm_threads */};
+
+  grpc::ThreadManagerTest test_thread_mgr("TestThreadManager", rq, settings);
+  grpc_resource_quota_unref(rq);
+
+  test_thread_mgr.Initialize();
+  test_thread_mgr.Wait();
+
+  GPR_ASSERT(test_thread_mgr.GetNumDoWork() ==
+             test_thread_mgr.GetNumWorkFound());
+  GPR_ASSERT(test_thread_mgr.GetMaxActiveThreadsSoFar() >=
+             settings.min_pollers + settings.warm_threads);
+}
+
 int main(int argc, char** argv) {
   std::srand(std::time(nullptr));
   grpc::testing::InitTest(&argc, &argv, true);
@@ -193,6 +216,7 @@ int main(int argc, char** argv) {
 
   TestPollAndWork();
   TestThreadQuota();
+  TestWarmThreads();
 
   grpc_shutdown();
   return 0;
@@ -20,6 +20,7 @@
 #include <grpcpp/impl/grpc_library.h>
 
 #include <cstring>
+#include <string>
 #include <vector>
 
 #include <grpc/grpc.h>
@@ -104,6 +105,42 @@ TEST_F(ByteBufferTest, Dump) {
   EXPECT_TRUE(SliceEqual(slices[1], world));
 }
 
+TEST_F(ByteBufferTest, TrySingleSlice) {
+  grpc_slice hello = grpc_slice_from_copied_string(kContent1);
+  grpc_slice world = grpc_slice_from_copied_string(kContent2);
+  Slice slice;
+  ByteBuffer empty;
+  EXPECT_FALSE(empty.TrySingleSlice(&slice).ok());
+  Slice hello_slice(hello, Slice::STEAL_REF);
+  ByteBuffer single(&hello_slice, 1);
+  EXPECT_TRUE(single.TrySingleSlice(&slice).ok());
+  EXPECT_EQ(slice.begin(), hello_slice.begin());
+  std::vector<Slice> slices;
+  slices.push_back(hello_slice);
+  slices.push_back(Slice(world, Slice::STEAL_REF));
+  ByteBuffer multiple(&slices[0], 2);
+  EXPECT_FALSE(multiple.TrySingleSlice(&slice).ok());
+}
+
+TEST_F(ByteBufferTest, DumpToSingleSlice) {
+  grpc_slice hello = grpc_slice_from_copied_string(kContent1);
+  grpc_slice world = grpc_slice_from_copied_string(kContent2);
+  Slice hello_slice(hello, Slice::STEAL_REF);
+  Slice slice;
+  // a single slice is handed back without a copy
+  ByteBuffer single(&hello_slice, 1);
+  EXPECT_TRUE(single.DumpToSingleSlice(&slice).ok());
+  EXPECT_EQ(slice.begin(), hello_slice.begin());
+  std::vector<Slice> slices;
+  slices.push_back(hello_slice);
+  slices.push_back(Slice(world, Slice::STEAL_REF));
+  ByteBuffer multiple(&slices[0], 2);
+  EXPECT_TRUE(multiple.DumpToSingleSlice(&slice).ok());
+  EXPECT_EQ(std::string(kContent1) + kContent2,
+            std::string(reinterpret_cast<const char*>(slice.begin()),
+                        slice.size()));
+}
+
 TEST_F(ByteBufferTest, SerializationMakesCopy) {
   grpc_slice hello = grpc_slice_from_copied_string(kContent1);
   grpc_slice world = grpc_slice_from_copied_string(kContent2);
@@ -0,0 +1,268 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/grpc.h>
+#include <grpc/support/string_util.h>
+#include <grpcpp/impl/codegen/config.h>
+#include <gtest/gtest.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/xds/xds_load_balancer_api.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/proto/grpc/lb/v2/eds_for_test.pb.h"  // C++ version
+
+namespace grpc {
+namespace {
+
+using ::envoy::api::v2::ClusterLoadAssignment;
+using ::envoy::api::v2::DeltaDiscoveryRequest;
+using ::envoy::api::v2::DeltaDiscoveryResponse;
+
+constexpr char kEdsTypeUrl[] =
+    "type.googleapis.com/envoy.api.v2.ClusterLoadAssignment";
+constexpr char kServiceName[] = "service name";
+
+class XdsDeltaEdsTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() { grpc_init(); }
+
+  static void TearDownTestCase() { grpc_shutdown(); }
+
+  static DeltaDiscoveryRequest ParseRequest(grpc_slice slice) {
+    DeltaDiscoveryRequest request;
+    EXPECT_TRUE(request.ParseFromArray(GRPC_SLICE_START_PTR(slice),
+                                       GRPC_SLICE_LENGTH(slice)));
+    grpc_slice_unref(slice);
+    return request;
+  }
+
+  // Returns an assignment with one locality per entry of \a ports.
+  static ClusterLoadAssignment BuildAssignment(const std::vector<int>& ports) {
+    ClusterLoadAssignment assignment;
+    assignment.set_cluster_name(kServiceName);
+    for (size_t i = 0; i < ports.size(); ++i) {
+      auto* endpoints = assignment.add_endpoints();
+      endpoints->mutable_load_balancing_weight()->set_value(1);
+      endpoints->mutable_locality()->set_region("region");
+      endpoints->mutable_locality()->set_zone("zone");
+      endpoints->mutable_locality()->set_sub_zone("sub_zone_" +
+                                                  std::to_string(i));
+      auto* socket_address = endpoints->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address("127.0.0.1");
+      socket_address->set_port_value(ports[i]);
+    }
+    return assignment;
+  }
+
+  static grpc_error* Parse(const DeltaDiscoveryResponse& response,
+                           grpc_core::XdsDeltaResponse* delta_response,
+                           grpc_core::XdsUpdate* update) {
+    const grpc::string encoded = response.SerializeAsString();
+    grpc_slice slice =
+        grpc_slice_from_copied_buffer(encoded.data(), encoded.size());
+    grpc_error* error = grpc_core::XdsEdsDeltaResponseDecodeAndParse(
+        slice, kServiceName, delta_response, update);
+    grpc_slice_unref(slice);
+    return error;
+  }
+};
+
+TEST_F(XdsDeltaEdsTest, CreateInitialRequest) {
+  grpc_core::XdsResourceNameList subscribe;
+  subscribe.push_back(kServiceName);
+  grpc_core::XdsResourceNameList unsubscribe;
+  unsubscribe.push_back("old service name");
+  grpc_core::XdsResourceVersionMap versions;
+  versions[grpc_core::UniquePtr<char>(gpr_strdup(kServiceName))] =
+      grpc_core::UniquePtr<char>(gpr_strdup("version 1"));
+  DeltaDiscoveryRequest request =
+      ParseRequest(grpc_core::XdsEdsDeltaRequestCreateAndEncode(
+          subscribe, unsubscribe, &versions, /*response_nonce=*/nullptr,
+          GRPC_ERROR_NONE));
+  EXPECT_EQ(kEdsTypeUrl, request.type_url());
+  EXPECT_TRUE(request.has_node());
+  ASSERT_EQ(1, request.resource_names_subscribe_size());
+  EXPECT_EQ(kServiceName, request.resource_names_subscribe(0));
+  ASSERT_EQ(1, request.resource_names_unsubscribe_size());
+  EXPECT_EQ("old service name", request.resource_names_unsubscribe(0));
+  ASSERT_EQ(1u, request.initial_resource_versions().size());
+  EXPECT_EQ("version 1", request.initial_resource_versions().at(kServiceName));
+  EXPECT_EQ("", request.response_nonce());
+  EXPECT_FALSE(request.has_error_detail());
+}
+
+TEST_F(XdsDeltaEdsTest, CreateInitialRequestWithoutVersions) {
+  grpc_core::XdsResourceNameList subscribe;
+  subscribe.push_back(kServiceName);
+  DeltaDiscoveryRequest request =
+      ParseRequest(grpc_core::XdsEdsDeltaRequestCreateAndEncode(
+          subscribe, grpc_core::XdsResourceNameList(),
+          /*initial_versions=*/nullptr, /*response_nonce=*/nullptr,
+          GRPC_ERROR_NONE));
+  EXPECT_TRUE(request.has_node());
+  EXPECT_EQ(1, request.resource_names_subscribe_size());
+  EXPECT_EQ(0, request.resource_names_unsubscribe_size());
+  EXPECT_TRUE(request.initial_resource_versions().empty());
+}
+
+TEST_F(XdsDeltaEdsTest, CreateAck) {
+  DeltaDiscoveryRequest request =
+      ParseRequest(grpc_core::XdsEdsDeltaRequestCreateAndEncode(
+          grpc_core::XdsResourceNameList(), grpc_core::XdsResourceNameList(),
+          /*initial_versions=*/nullptr, "nonce 1", GRPC_ERROR_NONE));
+  EXPECT_EQ(kEdsTypeUrl, request.type_url());
+  EXPECT_EQ("nonce 1", request.response_nonce());
+  // Only the first request of a stream identifies the node.
+  EXPECT_FALSE(request.has_node());
+  EXPECT_EQ(0, request.resource_names_subscribe_size());
+  EXPECT_FALSE(request.has_error_detail());
+}
+
+TEST_F(XdsDeltaEdsTest, CreateNack) {
+  grpc_error* error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("bad response");
+  DeltaDiscoveryRequest request =
+      ParseRequest(grpc_core::XdsEdsDeltaRequestCreateAndEncode(
+          grpc_core::XdsResourceNameList(), grpc_core::XdsResourceNameList(),
+          /*initial_versions=*/nullptr, "nonce 2", error));
+  GRPC_ERROR_UNREF(error);
+  EXPECT_EQ("nonce 2", request.response_nonce());
+  ASSERT_TRUE(request.has_error_detail());
+  EXPECT_EQ(GRPC_STATUS_INVALID_ARGUMENT, request.error_detail().code());
+  EXPECT_NE(grpc::string::npos,
+            request.error_detail().message().find("bad response"));
+}
+
+TEST_F(XdsDeltaEdsTest, ParseResponseWithWatchedResource) {
+  DeltaDiscoveryResponse response;
+  response.set_type_url(kEdsTypeUrl);
+  response.set_nonce("nonce 1");
+  // A resource we don't watch comes first and must be skipped.
+  auto* other = response.add_resources();
+  other->set_name("other service name");
+  other->set_version("other version");
+  other->mutable_resource()->set_type_url("not even EDS");
+  auto* resource = response.add_resources();
+  resource->set_name(kServiceName);
+  resource->set_version("version 1");
+  resource->mutable_resource()->PackFrom(BuildAssignment({1000, 1001}));
+  grpc_core::XdsDeltaResponse delta_response;
+  grpc_core::XdsUpdate update;
+  grpc_error* error = Parse(response, &delta_response, &update);
+  ASSERT_EQ(GRPC_ERROR_NONE, error) << grpc_error_string(error);
+  ASSERT_NE(nullptr, delta_response.nonce);
+  EXPECT_STREQ("nonce 1", delta_response.nonce.get());
+  ASSERT_NE(nullptr, delta_response.version);
+  EXPECT_STREQ("version 1", delta_response.version.get());
+  EXPECT_FALSE(delta_response.removed);
+  ASSERT_EQ(2u, update.locality_list.size());
+  EXPECT_STREQ("sub_zone_0",
+               update.locality_list[0].locality_name->sub_zone());
+  EXPECT_EQ(1u, update.locality_list[0].serverlist.size());
+  EXPECT_STREQ("sub_zone_1",
+               update.locality_list[1].locality_name->sub_zone());
+  EXPECT_FALSE(update.drop_all);
+}
+
+TEST_F(XdsDeltaEdsTest, ParseResponseWithoutWatchedResource) {
+  DeltaDiscoveryResponse response;
+  response.set_type_url(kEdsTypeUrl);
+  response.set_nonce("nonce 1");
+  auto* other = response.add_resources();
+  other->set_name("other service name");
+  other->set_version("other version");
+  other->mutable_resource()->PackFrom(BuildAssignment({1000}));
+  response.add_removed_resources("another service name");
+  grpc_core::XdsDeltaResponse delta_response;
+  grpc_core::XdsUpdate update;
+  grpc_error* error = Parse(response, &delta_response, &update);
+  ASSERT_EQ(GRPC_ERROR_NONE, error) << grpc_error_string(error);
+  EXPECT_STREQ("nonce 1", delta_response.nonce.get());
+  // Nothing changed for the watched resource.
+  EXPECT_EQ(nullptr, delta_response.version);
+  EXPECT_FALSE(delta_response.removed);
+  EXPECT_TRUE(update.locality_list.empty());
+}
+
+TEST_F(XdsDeltaEdsTest, ParseResponseRemovingWatchedResource) {
+  DeltaDiscoveryResponse response;
+  response.set_type_url(kEdsTypeUrl);
+  response.set_nonce("nonce 3");
+  response.add_removed_resources("other service name");
+  response.add_removed_resources(kServiceName);
+  grpc_core::XdsDeltaResponse delta_response;
+  grpc_core::XdsUpdate update;
+  grpc_error* error = Parse(response, &delta_response, &update);
+  ASSERT_EQ(GRPC_ERROR_NONE, error) << grpc_error_string(error);
+  EXPECT_STREQ("nonce 3", delta_response.nonce.get());
+  EXPECT_EQ(nullptr, delta_response.version);
+  EXPECT_TRUE(delta_response.removed);
+}
+
+TEST_F(XdsDeltaEdsTest, ParseResponseWithWrongTypeUrl) {
+  DeltaDiscoveryResponse response;
+  response.set_type_url("type.googleapis.com/envoy.api.v2.Cluster");
+  response.set_nonce("nonce 1");
+  grpc_core::XdsDeltaResponse delta_response;
+  grpc_core::XdsUpdate update;
+  grpc_error* error = Parse(response, &delta_response, &update);
+  EXPECT_NE(GRPC_ERROR_NONE, error);
+  GRPC_ERROR_UNREF(error);
+  // The nonce is still available to NACK the response with.
+  EXPECT_STREQ("nonce 1", delta_response.nonce.get());
+}
+
+TEST_F(XdsDeltaEdsTest, ParseResponseWithInvalidWatchedResource) {
+  DeltaDiscoveryResponse response;
+  response.set_type_url(kEdsTypeUrl);
+  response.set_nonce("nonce 2");
+  auto* resource = response.add_resources();
+  resource->set_name(kServiceName);
+  resource->set_version("version 2");
+  resource->mutable_resource()->set_type_url(
+      "type.googleapis.com/envoy.api.v2.Cluster");
+  grpc_core::XdsDeltaResponse delta_response;
+  grpc_core::XdsUpdate update;
+  grpc_error* error = Parse(response, &delta_response, &update);
+  EXPECT_NE(GRPC_ERROR_NONE, error);
+  GRPC_ERROR_UNREF(error);
+  EXPECT_STREQ("nonce 2", delta_response.nonce.get());
+  // A rejected version must not be recorded.
+  EXPECT_EQ(nullptr, delta_response.version);
+}
+
+TEST_F(XdsDeltaEdsTest, ParseUndecodableResponse) {
+  grpc_slice slice = grpc_slice_from_static_string("\xff\xff\xff");
+  grpc_core::XdsDeltaResponse delta_response;
+  grpc_core::XdsUpdate update;
+  grpc_error* error = grpc_core::XdsEdsDeltaResponseDecodeAndParse(
+      slice, kServiceName, &delta_response, &update);
+  EXPECT_NE(GRPC_ERROR_NONE, error);
+  GRPC_ERROR_UNREF(error);
+  EXPECT_EQ(nullptr, delta_response.nonce);
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  int ret = RUN_ALL_TESTS();
+  return ret;
+}
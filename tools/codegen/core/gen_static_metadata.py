@@ -383,6 +383,8 @@ print >> C, '#include <grpc/support/port_platform.h>'
 print >> C
 print >> C, '#include "src/core/lib/transport/static_metadata.h"'
 print >> C
+print >> C, '#include <string.h>'
+print >> C
 print >> C, '#include "src/core/lib/slice/slice_internal.h"'
 print >> C
 
@@ -439,9 +441,70 @@ for i, elem in enumerate(all_strs):
     print >> C, slice_def(i) + ','
 print >> C, '};'
 print >> C
+
+
+def c_char(c):
+    if c.isalnum() or c in '-_:/.+ ':
+        return "'%s'" % c
+    return '%d' % ord(c)
+
+
+def static_str_index_code():
+    """Returns the body of grpc_static_slice_index_of(): a switch on the length
+    of the string, then on the bytes that tell the static strings of that
+    length apart, then a single comparison."""
+    by_len = collections.defaultdict(list)
+    for i, s in enumerate(all_strs):
+        by_len[len(s)].append(i)
+
+    def compare(i):
+        return ('memcmp(p, g_bytes + %d, %d) == 0' % (id2strofs[i],
+                                                      len(all_strs[i])))
+
+    def cases(idxs, indent):
+        """The returns for candidates idxs, all of the same length"""
+        if len(idxs) == 1:
+            i = idxs[0]
+            if not all_strs[i]:
+                return ['%sreturn %d;' % (indent, i)]
+            return ['%sreturn %s ? %d : -1;' % (indent, compare(i), i)]
+        length = len(all_strs[idxs[0]])
+        pos = max(
+            range(length),
+            key=lambda k: (len(set(all_strs[i][k] for i in idxs)), -k))
+        by_char = collections.OrderedDict()
+        for i in sorted(idxs, key=lambda i: all_strs[i][pos]):
+            by_char.setdefault(all_strs[i][pos], []).append(i)
+        lines = ['%sswitch (p[%d]) {' % (indent, pos)]
+        for c, group in by_char.items():
+            lines.append('%s  case %s:' % (indent, c_char(c)))
+            lines += cases(group, indent + '    ')
+        lines.append('%s}' % indent)
+        lines.append('%sreturn -1;' % indent)
+        return lines
+
+    lines = ['  switch (len) {']
+    for length in sorted(by_len.keys()):
+        lines.append('    case %d:' % length)
+        lines += cases(by_len[length], '      ')
+    lines.append('  }')
+    lines.append('  return -1;')
+    return lines
+
+
 print >> H, '#define GRPC_STATIC_METADATA_INDEX(static_slice) \\'
 print >> H, '(reinterpret_cast<grpc_core::StaticSliceRefcount*>((static_slice).refcount)->index)'
 print >> H
+print >> H, ('/* Returns the index in grpc_static_slice_table of the static string '
+             'equal to\n   the len bytes at buf, or -1 if there is none. */')
+print >> H, 'int32_t grpc_static_slice_index_of(const void* buf, size_t len);'
+print >> H
+print >> C, 'int32_t grpc_static_slice_index_of(const void* buf, size_t len) {'
+print >> C, '  const uint8_t* p = static_cast<const uint8_t*>(buf);'
+for line in static_str_index_code():
+    print >> C, line
+print >> C, '}'
+print >> C
 
 print >> D, '# hpack fuzzing dictionary'
 for i, elem in enumerate(all_strs):
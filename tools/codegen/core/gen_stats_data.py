@@ -265,7 +265,7 @@ with open('src/core/lib/debug/stats_data.h', 'w') as H:
     print >> H, "  GRPC_STATS_HISTOGRAM_BUCKETS = %d" % first_slot
     print >> H, "} grpc_stats_histogram_constants;"
 
-    print >> H, "#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)"
+    print >> H, "#ifndef GRPC_DISABLE_STATS"
     for ctr in inst_map['Counter']:
         print >> H, ("#define GRPC_STATS_INC_%s() " +
                      "GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_%s)") % (
@@ -281,7 +281,7 @@ with open('src/core/lib/debug/stats_data.h', 'w') as H:
     for histogram in inst_map['Histogram']:
         print >> H, "#define GRPC_STATS_INC_%s(value)" % (
             histogram.name.upper())
-    print >> H, "#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */"
+    print >> H, "#endif /* GRPC_DISABLE_STATS */"
 
     for i, tbl in enumerate(static_tables):
         print >> H, "extern const %s grpc_stats_table_%d[%d];" % (tbl[0], i,
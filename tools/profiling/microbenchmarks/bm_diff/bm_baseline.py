@@ -0,0 +1,314 @@
+#!/usr/bin/env python2.7
+#
+# Copyright 2019 gRPC authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+""" Saves benchmark runs as baselines, and fails on regressions against them """
+
+import bm_constants
+import bm_build
+import bm_run
+import bm_speedup
+
+import sys
+import os
+
+sys.path.append(os.path.join(os.path.dirname(sys.argv[0]), '..'))
+import bm_json
+
+sys.path.append(
+    os.path.join(
+        os.path.dirname(sys.argv[0]), '..', '..', '..', 'run_tests',
+        'python_utils'))
+import jobset
+
+sys.path.append(
+    os.path.join(
+        os.path.dirname(sys.argv[0]), '..', '..', '..', 'run_tests',
+        'performance'))
+import scenario_config
+
+import argparse
+import collections
+import json
+import multiprocessing
+import re
+import shutil
+import subprocess
+import tabulate
+import time
+
+
+def _args():
+    argp = argparse.ArgumentParser(
+        description=
+        'Run benchmarks, then save them as a baseline or check them against one'
+    )
+    argp.add_argument(
+        'command',
+        choices=['save', 'check'],
+        help='Save the run as the baseline, or check it against the baseline')
+    argp.add_argument(
+        '-b',
+        '--benchmarks',
+        nargs='+',
+        choices=bm_constants._AVAILABLE_BENCHMARK_TESTS,
+        default=bm_constants._AVAILABLE_BENCHMARK_TESTS,
+        help='Which microbenchmarks to run')
+    argp.add_argument(
+        '-r',
+        '--regex',
+        type=str,
+        default="",
+        help='Regex to filter microbenchmarks run')
+    argp.add_argument(
+        '-q',
+        '--qps_regex',
+        type=str,
+        help=
+        'Regex of the in-process C++ qps scenarios to run too. None are run by default'
+    )
+    argp.add_argument(
+        '-l',
+        '--loops',
+        type=int,
+        default=10,
+        help=
+        'Number of times to run each benchmark and scenario. Fewer than 3 gives no statistical power'
+    )
+    argp.add_argument(
+        '-j',
+        '--jobs',
+        type=int,
+        default=1,
+        help=
+        'Number of benchmarks to run at once. Keep this at most the number of --cpus'
+    )
+    argp.add_argument(
+        '--cpus',
+        type=str,
+        help='CPUs to pin the benchmarks to, in taskset -c format')
+    argp.add_argument(
+        '-n',
+        '--name',
+        type=str,
+        default='new',
+        help='Name of the build, as passed to bm_build.py')
+    argp.add_argument(
+        '--no_build',
+        action='store_true',
+        help='Use the binaries of a previous build with the same name')
+    argp.add_argument(
+        '-s',
+        '--store',
+        type=str,
+        default='bm_baselines',
+        help='Directory the baselines are kept in')
+    argp.add_argument(
+        '--baseline',
+        type=str,
+        default='master',
+        help='Name of the baseline to save or check against')
+    argp.add_argument(
+        '-t',
+        '--track',
+        choices=sorted(bm_constants._INTERESTING),
+        nargs='+',
+        default=sorted(bm_constants._GATED.keys()),
+        help='Which microbenchmark metrics to gate on')
+    argp.add_argument(
+        '--max_regression',
+        type=int,
+        default=3,
+        help='Largest tolerated regression, in percent')
+    argp.add_argument('--counters', dest='counters', action='store_true')
+    argp.add_argument('--no-counters', dest='counters', action='store_false')
+    argp.set_defaults(counters=True)
+    args = argp.parse_args()
+    if args.loops < 3:
+        print "WARNING: Checks of fewer than 3 loops will not flag anything."
+    return args
+
+
+def _scenarios(regex):
+    """The in-process C++ scenarios matching regex, which need no workers"""
+    if not regex:
+        return []
+    scenarios = []
+    for scenario in scenario_config.CXXLanguage().scenarios():
+        if scenario_config.INPROC not in scenario.get('CATEGORIES', []):
+            continue
+        if not re.search(regex, scenario['name']):
+            continue
+        scenarios.append(scenario_config.remove_nonproto_fields(scenario))
+    return scenarios
+
+
+def _qps_result_file(scenario_name, name, loop):
+    return 'qps.%s.%s.%d.json' % (scenario_name, name, loop)
+
+
+def _create_qps_jobs(name, scenarios, loops, cpus):
+    jobs_list = []
+    for loop in range(0, loops):
+        for scenario in scenarios:
+            cmd = bm_run.pinned([
+                'bm_diff_%s/opt/qps_json_driver' % name, '--run_inproc',
+                '--scenarios_json=%s' % json.dumps({
+                    'scenarios': [scenario]
+                }),
+                '--scenario_result_file=%s' % _qps_result_file(
+                    scenario['name'], name, loop)
+            ], cpus)
+            jobs_list.append(
+                jobset.JobSpec(
+                    cmd,
+                    shortname='%s %s %d/%d' % (scenario['name'], name, loop + 1,
+                                               loops),
+                    verbose_success=True,
+                    timeout_seconds=60 * 60))
+    return jobs_list
+
+
+def _build(args, scenarios):
+    bm_build.build(args.name, args.benchmarks, multiprocessing.cpu_count(),
+                   args.counters)
+    if scenarios:
+        subprocess.check_call([
+            'make', 'qps_json_driver', 'CONFIG=opt', '-j',
+            '%d' % multiprocessing.cpu_count()
+        ])
+        shutil.move('bins/opt/qps_json_driver',
+                    'bm_diff_%s/opt/qps_json_driver' % args.name)
+
+
+def _read_json(filename):
+    try:
+        with open(filename) as f:
+            return json.loads(f.read())
+    except (IOError, ValueError):
+        # A crash or timeout; the run just has fewer samples.
+        return None
+
+
+def _collect(args, scenarios):
+    """Returns the samples of each tracked metric of each benchmark, and of
+    each gated summary field of each scenario"""
+    benchmarks = collections.defaultdict(lambda: collections.defaultdict(list))
+    for bm in args.benchmarks:
+        for line in subprocess.check_output([
+                'bm_diff_%s/opt/%s' % (args.name, bm), '--benchmark_list_tests',
+                '--benchmark_filter=%s' % args.regex
+        ]).splitlines():
+            stripped_line = line.strip().replace("/", "_").replace(
+                "<", "_").replace(">", "_").replace(", ", "_")
+            for loop in range(0, args.loops):
+                js_opt = _read_json('%s.%s.opt.%s.%d.json' %
+                                    (bm, stripped_line, args.name, loop))
+                js_ctr = _read_json('%s.%s.counters.%s.%d.json' %
+                                    (bm, stripped_line, args.name,
+                                     loop)) if args.counters else None
+                for row in bm_json.expand_json(js_ctr, js_opt):
+                    samples = benchmarks['%s/%s' % (bm, row['cpp_name'])]
+                    for f in args.track:
+                        if f in row:
+                            samples[f].append(float(row[f]))
+    results = collections.defaultdict(lambda: collections.defaultdict(list))
+    for scenario in scenarios:
+        for loop in range(0, args.loops):
+            js = _read_json(
+                _qps_result_file(scenario['name'], args.name, loop))
+            if not js:
+                continue
+            samples = results[scenario['name']]
+            for f in bm_constants._GATED_SCENARIO_METRICS:
+                if f in js['summary']:
+                    samples[f].append(float(js['summary'][f]))
+    return benchmarks, results
+
+
+def _baseline_file(args):
+    return os.path.join(args.store, '%s.json' % args.baseline)
+
+
+def _save(args, benchmarks, results):
+    if not os.path.isdir(args.store):
+        os.makedirs(args.store)
+    baseline = {
+        'commit':
+        subprocess.check_output(['git', 'rev-parse', 'HEAD']).strip(),
+        'created': time.strftime('%Y-%m-%dT%H:%M:%SZ', time.gmtime()),
+        'cpus': args.cpus,
+        'loops': args.loops,
+        'benchmarks': benchmarks,
+        'scenarios': results,
+    }
+    with open(_baseline_file(args), 'w') as f:
+        json.dump(baseline, f, indent=2, sort_keys=True)
+    print 'Saved baseline %s' % _baseline_file(args)
+
+
+def _regression(new, old, larger_is_better):
+    """Returns how many percent worse new is than old, if significantly"""
+    if len(new) < 3 or len(old) < 3:
+        return 0
+    s = bm_speedup.speedup(new, old, 1e-5)
+    return -s if larger_is_better else s
+
+
+def _check(args, benchmarks, results):
+    with open(_baseline_file(args)) as f:
+        baseline = json.loads(f.read())
+    rows = []
+    for kind, new_samples, old_samples, gated in [
+        ('benchmark', benchmarks, baseline['benchmarks'], bm_constants._GATED),
+        ('scenario', results, baseline['scenarios'],
+         bm_constants._GATED_SCENARIO_METRICS)
+    ]:
+        for name in sorted(new_samples.keys()):
+            if name not in old_samples:
+                continue
+            for f in sorted(new_samples[name].keys()):
+                if f not in old_samples[name]:
+                    continue
+                new = new_samples[name][f]
+                old = old_samples[name][f]
+                pct = _regression(new, old, gated.get(f, False))
+                if pct > args.max_regression:
+                    rows.append([kind, name, f, '%+d%%' % pct])
+    print 'Baseline %s from commit %s' % (args.baseline, baseline['commit'])
+    if rows:
+        print 'Regressions:\n%s' % tabulate.tabulate(
+            rows, headers=['Kind', 'Name', 'Metric', 'Regression'])
+        return 1
+    print 'No regressions'
+    return 0
+
+
+def main(args):
+    scenarios = _scenarios(args.qps_regex)
+    if not args.no_build:
+        _build(args, scenarios)
+    jobs_list = bm_run.create_jobs(args.name, args.benchmarks, args.loops,
+                                   args.regex, args.counters, args.cpus)
+    jobs_list += _create_qps_jobs(args.name, scenarios, args.loops, args.cpus)
+    jobset.run(jobs_list, maxjobs=args.jobs)
+    benchmarks, results = _collect(args, scenarios)
+    if args.command == 'save':
+        _save(args, benchmarks, results)
+        return 0
+    return _check(args, benchmarks, results)
+
+
+if __name__ == '__main__':
+    sys.exit(main(_args()))
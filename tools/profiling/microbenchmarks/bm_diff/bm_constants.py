@@ -23,10 +23,26 @@ _AVAILABLE_BENCHMARK_TESTS = [
 ]
 
 _INTERESTING = ('cpu_time', 'real_time', 'locks_per_iteration',
-                'allocs_per_iteration', 'writes_per_iteration',
-                'atm_cas_per_iteration', 'atm_add_per_iteration',
-                'nows_per_iteration', 'cli_transport_stalls_per_iteration',
+                'allocs_per_iteration', 'alloc_bytes_per_iteration',
+                'writes_per_iteration', 'atm_cas_per_iteration',
+                'atm_add_per_iteration', 'nows_per_iteration',
+                'cli_transport_stalls_per_iteration',
                 'cli_stream_stalls_per_iteration',
                 'svr_transport_stalls_per_iteration',
                 'svr_stream_stalls_per_iteration',
                 'http2_pings_sent_per_iteration')
+
+# Metrics bm_baseline.py gates on by default, by whether larger is better.
+_GATED = {
+    'cpu_time': False,
+    'real_time': False,
+    'allocs_per_iteration': False,
+    'alloc_bytes_per_iteration': False,
+}
+
+# Summary fields of qps scenario results bm_baseline.py gates on, by whether
+# larger is better.
+_GATED_SCENARIO_METRICS = {
+    'qps': True,
+    'latency99': False,
+}
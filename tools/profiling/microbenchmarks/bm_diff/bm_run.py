@@ -68,6 +68,12 @@ def _args():
         help=
         'Number of times to loops the benchmarks. More loops cuts down on noise'
     )
+    argp.add_argument(
+        '--cpus',
+        type=str,
+        help=
+        'CPUs to pin the benchmarks to, in taskset -c format. Pinning cuts down on noise from migrations'
+    )
     argp.add_argument('--counters', dest='counters', action='store_true')
     argp.add_argument('--no-counters', dest='counters', action='store_false')
     argp.set_defaults(counters=True)
@@ -78,7 +84,12 @@ def _args():
     return args
 
 
-def _collect_bm_data(bm, cfg, name, regex, idx, loops):
+def pinned(cmd, cpus):
+    """Prefixes cmd to run on cpus, if set"""
+    return ['taskset', '-c', cpus] + cmd if cpus else cmd
+
+
+def _collect_bm_data(bm, cfg, name, regex, idx, loops, cpus):
     jobs_list = []
     for line in subprocess.check_output([
             'bm_diff_%s/%s/%s' % (name, cfg, bm), '--benchmark_list_tests',
@@ -87,13 +98,13 @@ def _collect_bm_data(bm, cfg, name, regex, idx, loops):
         stripped_line = line.strip().replace("/",
                                              "_").replace("<", "_").replace(
                                                  ">", "_").replace(", ", "_")
-        cmd = [
+        cmd = pinned([
             'bm_diff_%s/%s/%s' % (name, cfg, bm),
             '--benchmark_filter=^%s$' % line,
             '--benchmark_out=%s.%s.%s.%s.%d.json' % (bm, stripped_line, cfg,
                                                      name, idx),
             '--benchmark_out_format=json',
-        ]
+        ], cpus)
         jobs_list.append(
             jobset.JobSpec(
                 cmd,
@@ -105,14 +116,15 @@ def _collect_bm_data(bm, cfg, name, regex, idx, loops):
     return jobs_list
 
 
-def create_jobs(name, benchmarks, loops, regex, counters):
+def create_jobs(name, benchmarks, loops, regex, counters, cpus=None):
     jobs_list = []
     for loop in range(0, loops):
         for bm in benchmarks:
-            jobs_list += _collect_bm_data(bm, 'opt', name, regex, loop, loops)
+            jobs_list += _collect_bm_data(bm, 'opt', name, regex, loop, loops,
+                                          cpus)
             if counters:
                 jobs_list += _collect_bm_data(bm, 'counters', name, regex, loop,
-                                              loops)
+                                              loops, cpus)
     random.shuffle(jobs_list, random.SystemRandom().random)
     return jobs_list
 
@@ -120,5 +132,5 @@ def create_jobs(name, benchmarks, loops, regex, counters):
 if __name__ == '__main__':
     args = _args()
     jobs_list = create_jobs(args.name, args.benchmarks, args.loops, args.regex,
-                            args.counters)
+                            args.counters, args.cpus)
     jobset.run(jobs_list, maxjobs=args.jobs)
@@ -45,6 +45,10 @@ def massage_qps_stats(scenario_result):
                 core_stats, "syscall_poll")
             stats["core_syscall_wait"] = massage_qps_stats_helpers.counter(
                 core_stats, "syscall_wait")
+            stats["core_busy_poll_hits"] = massage_qps_stats_helpers.counter(
+                core_stats, "busy_poll_hits")
+            stats["core_busy_poll_misses"] = massage_qps_stats_helpers.counter(
+                core_stats, "busy_poll_misses")
             stats["core_pollset_kick"] = massage_qps_stats_helpers.counter(
                 core_stats, "pollset_kick")
             stats[
@@ -116,6 +120,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_writes_continued"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_writes_continued")
+            stats[
+                "core_http2_writes_coalesced"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_writes_coalesced")
             stats[
                 "core_http2_partial_writes"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_partial_writes")
@@ -272,6 +279,15 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_combiner_locks_offloaded"] = massage_qps_stats_helpers.counter(
                     core_stats, "combiner_locks_offloaded")
+            stats[
+                "core_combiner_locks_offload_deferred"] = massage_qps_stats_helpers.counter(
+                    core_stats, "combiner_locks_offload_deferred")
+            stats[
+                "core_control_plane_combiner_handoffs"] = massage_qps_stats_helpers.counter(
+                    core_stats, "control_plane_combiner_handoffs")
+            stats[
+                "core_control_plane_combiner_run_time_us"] = massage_qps_stats_helpers.counter(
+                    core_stats, "control_plane_combiner_run_time_us")
             stats[
                 "core_call_combiner_locks_initiated"] = massage_qps_stats_helpers.counter(
                     core_stats, "call_combiner_locks_initiated")
@@ -302,12 +318,37 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_executor_push_retries"] = massage_qps_stats_helpers.counter(
                     core_stats, "executor_push_retries")
+            stats["core_executor_steals"] = massage_qps_stats_helpers.counter(
+                core_stats, "executor_steals")
+            stats["core_resolver_lookups"] = massage_qps_stats_helpers.counter(
+                core_stats, "resolver_lookups")
+            stats[
+                "core_resolver_lookups_shared"] = massage_qps_stats_helpers.counter(
+                    core_stats, "resolver_lookups_shared")
+            stats[
+                "core_handshaker_next_offloaded"] = massage_qps_stats_helpers.counter(
+                    core_stats, "handshaker_next_offloaded")
+            stats[
+                "core_handshaker_next_offload_queue_full"] = massage_qps_stats_helpers.counter(
+                    core_stats, "handshaker_next_offload_queue_full")
             stats[
                 "core_server_requested_calls"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_requested_calls")
             stats[
                 "core_server_slowpath_requests_queued"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_slowpath_requests_queued")
+            stats[
+                "core_server_requests_matched_locally"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_requests_matched_locally")
+            stats[
+                "core_server_requests_matched_remotely"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_requests_matched_remotely")
+            stats[
+                "core_server_requests_shed"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_requests_shed")
+            stats[
+                "core_messages_decompressed_offloaded"] = massage_qps_stats_helpers.counter(
+                    core_stats, "messages_decompressed_offloaded")
             stats[
                 "core_cq_ev_queue_trylock_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_trylock_failures")
@@ -347,6 +388,21 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_poll_events_returned_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "poll_events_processed")
+            stats["core_poll_events_processed"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_poll_events_processed_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_poll_events_processed_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_poll_events_processed_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_poll_events_processed_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "tcp_write_size")
             stats["core_tcp_write_size"] = ",".join("%f" % x for x in h.buckets)
@@ -494,6 +550,51 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_send_flowctl_per_write_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "http2_frames_per_write")
+            stats["core_http2_frames_per_write"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_http2_frames_per_write_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_http2_frames_per_write_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_http2_frames_per_write_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_http2_frames_per_write_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "executor_queue_depth")
+            stats["core_executor_queue_depth"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_executor_queue_depth_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_executor_queue_depth_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_executor_queue_depth_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_executor_queue_depth_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "handshaker_offload_queue_depth")
+            stats["core_handshaker_offload_queue_depth"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_handshaker_offload_queue_depth_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_handshaker_offload_queue_depth_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_handshaker_offload_queue_depth_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_handshaker_offload_queue_depth_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "server_cqs_checked")
             stats["core_server_cqs_checked"] = ",".join(
@@ -124,6 +124,7 @@ def _ping_pong_scenario(name,
                         warmup_seconds=WARMUP_SECONDS,
                         categories=DEFAULT_CATEGORIES,
                         channels=None,
+                        idle_channels=None,
                         outstanding=None,
                         num_clients=None,
                         resource_quota_size=None,
@@ -211,6 +212,9 @@ def _ping_pong_scenario(name,
 
     if messages_per_stream:
         scenario['client_config']['messages_per_stream'] = messages_per_stream
+    if idle_channels:
+        # split across all clients, like client_channels
+        scenario['client_config']['idle_client_channels'] = idle_channels
     if client_language:
         # the CLIENT_LANGUAGE field is recognized by run_performance_tests.py
         scenario['CLIENT_LANGUAGE'] = client_language
@@ -282,6 +286,46 @@ class CXXLanguage:
             server_threads_per_cq=1,
             categories=[SCALABLE])
 
+        reuseport_affinity_scenario = _ping_pong_scenario(
+            'cpp_protobuf_async_unary_qps_unconstrained_insecure_reuseport_affinity',
+            rpc_type='UNARY',
+            client_type='ASYNC_CLIENT',
+            server_type='ASYNC_SERVER',
+            unconstrained_client='async',
+            secure=False,
+            async_server_threads=16,
+            server_threads_per_cq=1,
+            categories=[SCALABLE])
+        _add_channel_arg(reuseport_affinity_scenario['server_config'],
+                         'grpc.so_reuseport_listener_affinity', 1)
+        yield reuseport_affinity_scenario
+
+        # Servers carrying many mostly idle connections: latency and
+        # throughput of a busy subset of channels while the rest stay
+        # connected. A client can only open as many connections to one server
+        # port as it has ephemeral ports, so the 100k scenario spreads its idle
+        # channels over all available clients.
+        yield _ping_pong_scenario(
+            'cpp_protobuf_async_unary_ping_pong_insecure_10000idle_channels',
+            rpc_type='UNARY',
+            client_type='ASYNC_CLIENT',
+            server_type='ASYNC_SERVER',
+            idle_channels=10000,
+            secure=False,
+            categories=[SWEEP])
+
+        for idle_channels in [10000, 100000]:
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_unary_qps_unconstrained_insecure_%didle_channels'
+                % idle_channels,
+                rpc_type='UNARY',
+                client_type='ASYNC_CLIENT',
+                server_type='ASYNC_SERVER',
+                unconstrained_client='async',
+                idle_channels=idle_channels,
+                secure=False,
+                categories=[SWEEP])
+
         for secure in [True, False]:
             secstr = 'secure' if secure else 'insecure'
             smoketest_categories = ([SMOKETEST] if secure else [])